@@ -0,0 +1,186 @@
+#ifndef included_fiddle_benchmarks_benchmarks_h
+#define included_fiddle_benchmarks_benchmarks_h
+
+#include <deal.II/base/mpi.h>
+
+#include <tbox/Database.h>
+#include <tbox/Pointer.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Utilities shared by the benchmarks. Every benchmark writes a single JSON
+// file containing one record per measurement so that results from different
+// versions of fiddle can be compared by other tools.
+
+// Key-value pairs describing a measurement. Values must already be valid JSON
+// (i.e., strings must be quoted with to_json()).
+using BenchmarkParameters = std::vector<std::pair<std::string, std::string>>;
+
+inline std::string
+to_json(const std::string &value)
+{
+  std::string result = "\"";
+  for (const char c : value)
+    {
+      if (c == '"' || c == '\\')
+        result += '\\';
+      result += c;
+    }
+  return result + '"';
+}
+
+inline std::string
+to_json(const char *value)
+{
+  return to_json(std::string(value));
+}
+
+inline std::string
+to_json(const bool value)
+{
+  return value ? "true" : "false";
+}
+
+template <typename Number>
+std::string
+to_json(const Number value)
+{
+  std::ostringstream out;
+  out << std::setprecision(8) << value;
+  return out.str();
+}
+
+// Values in SAMRAI databases are always arrays, possibly of length 1: read
+// one into a std::vector.
+inline std::vector<int>
+get_integer_array(SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> db,
+                  const std::string                            &key)
+{
+  std::vector<int> values(db->getArraySize(key));
+  db->getIntegerArray(key, values.data(), static_cast<int>(values.size()));
+  return values;
+}
+
+inline std::vector<std::string>
+get_string_array(SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> db,
+                 const std::string                            &key)
+{
+  std::vector<std::string> values(db->getArraySize(key));
+  db->getStringArray(key, values.data(), static_cast<int>(values.size()));
+  return values;
+}
+
+// Call @p f once to warm up caches and then @p n_repetitions more times, each
+// of which is timed. Processors are synchronized before each call and each
+// time is the maximum over all processors.
+template <typename F>
+std::vector<double>
+time_repetitions(const unsigned int n_repetitions,
+                 const MPI_Comm     comm,
+                 const F           &f)
+{
+  f();
+  std::vector<double> times;
+  for (unsigned int i = 0; i < n_repetitions; ++i)
+    {
+      const int ierr = MPI_Barrier(comm);
+      AssertThrowMPI(ierr);
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      const auto stop = std::chrono::steady_clock::now();
+      times.push_back(dealii::Utilities::MPI::max(
+        std::chrono::duration<double>(stop - start).count(), comm));
+    }
+  return times;
+}
+
+// Collection of measurements, written to disk by the first processor.
+class BenchmarkLog
+{
+public:
+  BenchmarkLog(const std::string &benchmark_name,
+               const int          dimension,
+               const MPI_Comm     comm)
+    : comm(comm)
+  {
+    header.emplace_back("benchmark", to_json(benchmark_name));
+    header.emplace_back("fiddle_version", to_json(FDL_VERSION));
+    header.emplace_back("dimension", to_json(dimension));
+    header.emplace_back("n_processes",
+                        to_json(dealii::Utilities::MPI::n_mpi_processes(comm)));
+  }
+
+  // Add a measurement. @p n_items is the total number of things (e.g.,
+  // quadrature points) processed in each repetition, summed over all
+  // processors, and is used to compute a normalized time. If @p n_bytes (the
+  // number of bytes read and written in each repetition, summed over all
+  // processors) is positive then the achieved bandwidth is also recorded.
+  void
+  add(const BenchmarkParameters &parameters,
+      const std::vector<double> &times,
+      const double               n_items,
+      const double               n_bytes = 0.0)
+  {
+    BenchmarkParameters record = parameters;
+    const double        min_time =
+      times.empty() ? 0.0 : *std::min_element(times.begin(), times.end());
+    const double mean_time =
+      times.empty() ?
+        0.0 :
+        std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    record.emplace_back("n_repetitions", to_json(times.size()));
+    record.emplace_back("min_time", to_json(min_time));
+    record.emplace_back("mean_time", to_json(mean_time));
+    record.emplace_back("n_items", to_json(n_items));
+    record.emplace_back("ns_per_item",
+                        to_json(n_items > 0.0 ? 1e9 * min_time / n_items :
+                                                0.0));
+    if (n_bytes > 0.0)
+      record.emplace_back("GB_per_second",
+                          to_json(min_time > 0.0 ? 1e-9 * n_bytes / min_time :
+                                                   0.0));
+    records.push_back(std::move(record));
+  }
+
+  void
+  write(const std::string &filename) const
+  {
+    if (dealii::Utilities::MPI::this_mpi_process(comm) != 0)
+      return;
+
+    std::ofstream out(filename);
+    out << "{\n";
+    for (const auto &entry : header)
+      out << "  " << to_json(entry.first) << ": " << entry.second << ",\n";
+    out << "  \"results\": [\n";
+    for (std::size_t i = 0; i < records.size(); ++i)
+      {
+        out << "    {\n";
+        for (std::size_t j = 0; j < records[i].size(); ++j)
+          out << "      " << to_json(records[i][j].first) << ": "
+              << records[i][j].second
+              << (j + 1 == records[i].size() ? "\n" : ",\n");
+        out << (i + 1 == records.size() ? "    }\n" : "    },\n");
+      }
+    out << "  ]\n}\n";
+  }
+
+protected:
+  MPI_Comm comm;
+
+  BenchmarkParameters header;
+
+  std::vector<BenchmarkParameters> records;
+};
+
+#endif
@@ -0,0 +1,285 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/intersection_predicate.h>
+#include <fiddle/grid/nodal_patch_map.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <CartesianPatchGeometry.h>
+
+#include <string>
+#include <vector>
+
+#include "../tests/tests.h"
+#include "benchmarks.h"
+
+// Benchmark the core interaction functions (projection, spreading, nodal
+// interpolation and spreading, and counting quadrature points) on a synthetic
+// mesh for a range of element orders, kernels, and quadrature densities. The
+// patch size is set by the GriddingAlgorithm database, so sweeping it requires
+// running with several input files.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+run(tbox::Pointer<IBTK::AppInitializer> app_initializer, BenchmarkLog &log)
+{
+  auto       input_db     = app_initializer->getInputDatabase();
+  auto       benchmark_db = input_db->getDatabase("benchmark");
+  const auto mpi_comm     = MPI_COMM_WORLD;
+
+  AssertThrow(get_n_f_components(input_db) == spacedim,
+              ExcMessage("The Eulerian field should have spacedim "
+                         "components."));
+  const unsigned int n_repetitions =
+    benchmark_db->getIntegerWithDefault("n_repetitions", 10);
+  const std::vector<int> fe_degrees =
+    get_integer_array(benchmark_db, "fe_degrees");
+  const std::vector<int> n_points_1d =
+    get_integer_array(benchmark_db, "n_quadrature_points_1d");
+  const std::vector<std::string> kernels =
+    get_string_array(benchmark_db, "kernels");
+  const int largest_patch_size =
+    get_integer_array(input_db->getDatabase("GriddingAlgorithm")
+                        ->getDatabase("largest_patch_size"),
+                      "level_0")[0];
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_shell(native_tria, Point<spacedim>(), 0.125, 0.25);
+  native_tria.refine_global(
+    benchmark_db->getIntegerWithDefault("n_global_refinements", 4));
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+  auto g_idx           = std::get<6>(tuple);
+
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<dim, spacedim> tria_pred(patch_bboxes);
+
+  fdl::OverlapTriangulation<dim, spacedim> overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+  const MappingQ<dim, spacedim> mapping(1);
+  const double                  n_cells =
+    Utilities::MPI::sum(double(overlap_tria.n_active_cells()), mpi_comm);
+
+  auto parameters = [&](const std::string &function,
+                        const std::string &kernel,
+                        const int          fe_degree,
+                        const int          n_q_points_1d)
+  {
+    return BenchmarkParameters{{"function", to_json(function)},
+                               {"kernel", to_json(kernel)},
+                               {"fe_degree", to_json(fe_degree)},
+                               {"n_quadrature_points_1d",
+                                to_json(n_q_points_1d)},
+                               {"largest_patch_size",
+                                to_json(largest_patch_size)},
+                               {"n_cells", to_json(n_cells)}};
+  };
+
+  for (const int fe_degree : fe_degrees)
+    {
+      FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(fe_degree), spacedim);
+
+      // Elemental interaction:
+      DoFHandler<dim, spacedim> dof_handler(overlap_tria);
+      dof_handler.distribute_dofs(fe);
+      Vector<double> rhs(dof_handler.n_dofs());
+      Vector<double> solution(dof_handler.n_dofs());
+      solution = 1.0;
+
+      for (const int n_q_points : n_points_1d)
+        {
+          const std::vector<Quadrature<dim>> quadratures{
+            QGauss<dim>(n_q_points)};
+          const std::vector<unsigned char> quadrature_indices(
+            overlap_tria.n_active_cells());
+          const double n_points = n_cells * quadratures[0].size();
+
+          const auto count_times = time_repetitions(
+            n_repetitions,
+            mpi_comm,
+            [&]()
+            {
+              fdl::count_quadrature_points(g_idx,
+                                           patch_map,
+                                           mapping,
+                                           quadrature_indices,
+                                           quadratures);
+            });
+          log.add(parameters("count_quadrature_points",
+                             "",
+                             fe_degree,
+                             n_q_points),
+                  count_times,
+                  n_points);
+
+          for (const std::string &kernel : kernels)
+            {
+              const auto rhs_times = time_repetitions(
+                n_repetitions,
+                mpi_comm,
+                [&]()
+                {
+                  rhs = 0.0;
+                  fdl::compute_projection_rhs(kernel,
+                                              f_idx,
+                                              patch_map,
+                                              mapping,
+                                              quadrature_indices,
+                                              quadratures,
+                                              dof_handler,
+                                              mapping,
+                                              rhs);
+                });
+              log.add(parameters("compute_projection_rhs",
+                                 kernel,
+                                 fe_degree,
+                                 n_q_points),
+                      rhs_times,
+                      n_points);
+
+              const auto spread_times = time_repetitions(
+                n_repetitions,
+                mpi_comm,
+                [&]()
+                {
+                  fdl::compute_spread(kernel,
+                                      f_idx,
+                                      patch_map,
+                                      mapping,
+                                      quadrature_indices,
+                                      quadratures,
+                                      dof_handler,
+                                      mapping,
+                                      solution);
+                });
+              log.add(
+                parameters("compute_spread", kernel, fe_degree, n_q_points),
+                spread_times,
+                n_points);
+            }
+        }
+
+      // Nodal interaction, which does not use quadrature:
+      DoFHandler<dim, spacedim> nodal_dof_handler(native_tria);
+      nodal_dof_handler.distribute_dofs(fe);
+      DoFRenumbering::support_point_wise(nodal_dof_handler);
+      Vector<double> position(nodal_dof_handler.n_dofs());
+      VectorTools::interpolate(mapping,
+                               nodal_dof_handler,
+                               Functions::IdentityFunction<spacedim>(),
+                               position);
+      Vector<double> nodal_values(nodal_dof_handler.n_dofs());
+
+      std::vector<std::vector<BoundingBox<spacedim>>> bboxes;
+      for (const auto &patch : patches)
+        {
+          const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>>
+                              geometry = patch->getPatchGeometry();
+          const double *const patch_dx = geometry->getDx();
+          bboxes.emplace_back();
+          bboxes.back().push_back(
+            fdl::box_to_bbox(patch->getBox(),
+                             patch_hierarchy->getPatchLevel(
+                               patch_hierarchy->getFinestLevelNumber())));
+          bboxes.back().back().extend(1.0 * patch_dx[0]);
+        }
+      fdl::NodalPatchMap<dim, spacedim> nodal_patch_map(patches,
+                                                        bboxes,
+                                                        position);
+      // The Triangulation is shared so every processor has every node
+      const double n_nodes = nodal_dof_handler.n_dofs() / spacedim;
+
+      for (const std::string &kernel : kernels)
+        {
+          const auto interpolation_times = time_repetitions(
+            n_repetitions,
+            mpi_comm,
+            [&]()
+            {
+              fdl::compute_nodal_interpolation(
+                kernel, f_idx, nodal_patch_map, position, nodal_values);
+            });
+          log.add(
+            parameters("compute_nodal_interpolation", kernel, fe_degree, 0),
+            interpolation_times,
+            n_nodes);
+
+          const auto spread_times = time_repetitions(
+            n_repetitions,
+            mpi_comm,
+            [&]()
+            {
+              fdl::compute_nodal_spread(
+                kernel, f_idx, nodal_patch_map, position, nodal_values);
+            });
+          log.add(parameters("compute_nodal_spread", kernel, fe_degree, 0),
+                  spread_times,
+                  n_nodes);
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "interaction.log");
+
+  BenchmarkLog log("interaction", NDIM, MPI_COMM_WORLD);
+  run<NDIM>(app_initializer, log);
+  log.write(app_initializer->getInputDatabase()
+              ->getDatabase("benchmark")
+              ->getStringWithDefault("output_file", "interaction.json"));
+}
@@ -0,0 +1,318 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+#include <fiddle/mechanics/mechanics_values.h>
+#include <fiddle/mechanics/reference_values_cache.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.h"
+
+// Benchmark the evaluation of the elastic forces (i.e., compute_load_vector())
+// for each type of ForceContribution and the evaluation of MechanicsValues for
+// each MechanicsUpdateFlags value on hypercube and simplex meshes. The
+// bandwidth estimates only count the finite element vectors (i.e., they are a
+// lower bound on the actual memory traffic).
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// A smooth, invertible, nontrivial deformation of the unit cube.
+template <int spacedim>
+class Deformation : public Function<spacedim>
+{
+public:
+  Deformation()
+    : Function<spacedim>(spacedim)
+  {}
+
+  virtual double
+  value(const Point<spacedim> &p, const unsigned int component) const override
+  {
+    return p[component] +
+           0.1 * std::sin(numbers::PI * p[(component + 1) % spacedim]);
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+run_mesh(tbox::Pointer<tbox::Database> benchmark_db,
+         const std::string            &cell_type,
+         const int                     fe_degree,
+         BenchmarkLog                 &log)
+{
+  const auto         mpi_comm = MPI_COMM_WORLD;
+  const unsigned int n_repetitions =
+    benchmark_db->getIntegerWithDefault("n_repetitions", 10);
+  const unsigned int n_threads =
+    benchmark_db->getIntegerWithDefault("n_threads", 1);
+  const unsigned int n_subdivisions =
+    benchmark_db->getIntegerWithDefault("n_subdivisions", 16);
+
+  // setup deal.II stuff:
+  parallel::shared::Triangulation<dim, spacedim> tria(mpi_comm);
+  std::unique_ptr<FiniteElement<dim, spacedim>>  fe;
+  std::unique_ptr<Mapping<dim, spacedim>>        mapping;
+  std::unique_ptr<Quadrature<dim>>               quadrature;
+  if (cell_type == "HEX")
+    {
+      GridGenerator::subdivided_hyper_cube(tria, n_subdivisions);
+      fe = std::make_unique<FESystem<dim, spacedim>>(
+        FE_Q<dim, spacedim>(fe_degree), spacedim);
+      mapping    = std::make_unique<MappingQ<dim, spacedim>>(1);
+      quadrature = std::make_unique<QGauss<dim>>(fe_degree + 1);
+    }
+  else if (cell_type == "SIMPLEX")
+    {
+      GridGenerator::subdivided_hyper_cube_with_simplices(tria,
+                                                          n_subdivisions);
+      fe = std::make_unique<FESystem<dim, spacedim>>(
+        FE_SimplexP<dim, spacedim>(fe_degree), spacedim);
+      mapping = std::make_unique<MappingFE<dim, spacedim>>(
+        FE_SimplexP<dim, spacedim>(1));
+      quadrature = std::make_unique<QGaussSimplex<dim>>(fe_degree + 1);
+    }
+  else
+    AssertThrow(false, ExcMessage("unknown cell type " + cell_type));
+
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(*fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, mpi_comm);
+  LinearAlgebra::distributed::Vector<double> position(partitioner),
+    velocity(partitioner), reference_position(partitioner),
+    force_rhs(partitioner);
+  VectorTools::interpolate(*mapping,
+                           dof_handler,
+                           Deformation<spacedim>(),
+                           position);
+  VectorTools::interpolate(*mapping,
+                           dof_handler,
+                           Functions::IdentityFunction<spacedim>(),
+                           reference_position);
+  position.update_ghost_values();
+  velocity.update_ghost_values();
+  reference_position.update_ghost_values();
+
+  // The Triangulation is shared so every processor has every cell
+  const double n_points = double(tria.n_active_cells()) * quadrature->size();
+  const double vector_bytes = double(dof_handler.n_dofs()) * sizeof(double);
+
+  auto parameters = [&](const std::string &function,
+                        const std::string &name,
+                        const bool         use_cache)
+  {
+    return BenchmarkParameters{{"function", to_json(function)},
+                               {"name", to_json(name)},
+                               {"cell_type", to_json(cell_type)},
+                               {"fe_degree", to_json(fe_degree)},
+                               {"n_quadrature_points",
+                                to_json(quadrature->size())},
+                               {"n_threads", to_json(n_threads)},
+                               {"reference_values_cache", to_json(use_cache)},
+                               {"n_cells", to_json(tria.n_active_cells())}};
+  };
+
+  // setup forces:
+  Tensor<1, spacedim> f, s;
+  f[0] = 1.0;
+  s[1] = 1.0;
+  const std::vector<std::vector<Tensor<1, spacedim>>> fibers{
+    std::vector<Tensor<1, spacedim>>(tria.n_active_cells(), f),
+    std::vector<Tensor<1, spacedim>>(tria.n_active_cells(), s)};
+  const auto fiber_network =
+    std::make_shared<fdl::FiberNetwork<dim, spacedim>>(tria, fibers);
+
+  using ForcePointer = std::unique_ptr<fdl::ForceContribution<dim, spacedim>>;
+  std::vector<std::pair<std::string, ForcePointer>> forces;
+  forces.emplace_back(
+    "ModifiedNeoHookeanStress",
+    std::make_unique<fdl::ModifiedNeoHookeanStress<dim, spacedim>>(*quadrature,
+                                                                   1.0));
+  forces.emplace_back(
+    "JLogJVolumetricEnergyStress",
+    std::make_unique<fdl::JLogJVolumetricEnergyStress<dim, spacedim>>(
+      *quadrature, 10.0));
+  forces.emplace_back(
+    "HolzapfelOgdenStress",
+    std::make_unique<fdl::HolzapfelOgdenStress<dim, spacedim>>(*quadrature,
+                                                               1.0, // a
+                                                               1.0, // b
+                                                               1.0, // a_f
+                                                               1.0, // b_f
+                                                               0.0, // kappa_f
+                                                               0,   // index_f
+                                                               1.0, // a_s
+                                                               1.0, // b_s
+                                                               0.0, // kappa_s
+                                                               1,   // index_s
+                                                               1.0, // a_fs
+                                                               1.0, // b_fs
+                                                               fiber_network));
+  forces.emplace_back("SpringForce",
+                      std::make_unique<fdl::SpringForce<dim, spacedim>>(
+                        *quadrature, 1.0, dof_handler, reference_position));
+
+  fdl::ReferenceValuesCache<dim, spacedim> cache(
+    dof_handler,
+    *mapping,
+    benchmark_db->getIntegerWithDefault("cache_megabytes", 1024) * 1024ull *
+      1024ull);
+  const bool is_cached = cache.add_quadrature(*quadrature);
+
+  // compute_load_vector() reads the position and velocity and writes the
+  // right-hand side
+  for (const auto &pair : forces)
+    for (const bool use_cache : {false, true})
+      {
+        if (use_cache && !is_cached)
+          continue;
+        const auto times = time_repetitions(
+          n_repetitions,
+          mpi_comm,
+          [&]()
+          {
+            fdl::compute_load_vector(dof_handler,
+                                     *mapping,
+                                     {pair.second.get()},
+                                     {},
+                                     0.0,
+                                     position,
+                                     velocity,
+                                     force_rhs,
+                                     n_threads,
+                                     use_cache ? &cache : nullptr);
+          });
+        log.add(parameters("compute_load_vector", pair.first, use_cache),
+                times,
+                n_points,
+                3.0 * vector_bytes);
+      }
+
+  // MechanicsValues::reinit() for each flag by itself and for the flags of
+  // each force. update_nothing measures the cost of FEValues::reinit() alone.
+  std::vector<std::pair<std::string, fdl::MechanicsUpdateFlags>> me_flags{
+    {"update_nothing", fdl::update_nothing},
+    {"update_FF", fdl::update_FF},
+    {"update_FF_inv_T", fdl::update_FF_inv_T},
+    {"update_det_FF", fdl::update_det_FF},
+    {"update_n23_det_FF", fdl::update_n23_det_FF},
+    {"update_log_det_FF", fdl::update_log_det_FF},
+    {"update_position_values", fdl::update_position_values},
+    {"update_velocity_values", fdl::update_velocity_values},
+    {"update_right_cauchy_green", fdl::update_right_cauchy_green},
+    {"update_green", fdl::update_green},
+    {"update_first_invariant", fdl::update_first_invariant},
+    {"update_modified_first_invariant", fdl::update_modified_first_invariant},
+    {"update_second_invariant", fdl::update_second_invariant},
+    {"update_modified_second_invariant",
+     fdl::update_modified_second_invariant},
+    {"update_third_invariant", fdl::update_third_invariant},
+    {"update_first_invariant_dFF", fdl::update_first_invariant_dFF},
+    {"update_modified_first_invariant_dFF",
+     fdl::update_modified_first_invariant_dFF}};
+  std::vector<std::tuple<std::string, fdl::MechanicsUpdateFlags, UpdateFlags>>
+    flags;
+  for (const auto &pair : me_flags)
+    flags.emplace_back(pair.first,
+                       pair.second,
+                       fdl::compute_flag_dependencies(pair.second));
+  for (const auto &pair : forces)
+    flags.emplace_back(pair.first,
+                       pair.second->get_mechanics_update_flags(),
+                       pair.second->get_update_flags());
+
+  for (const auto &entry : flags)
+    {
+      FEValues<dim, spacedim> fe_values(*mapping,
+                                        *fe,
+                                        *quadrature,
+                                        std::get<2>(entry));
+      fdl::MechanicsValues<dim, spacedim> me_values(fe_values,
+                                                    position,
+                                                    velocity,
+                                                    std::get<1>(entry));
+      const auto times = time_repetitions(
+        n_repetitions,
+        mpi_comm,
+        [&]()
+        {
+          for (const auto &cell : dof_handler.active_cell_iterators())
+            if (cell->is_locally_owned())
+              {
+                fe_values.reinit(cell);
+                me_values.reinit(cell);
+              }
+        });
+      log.add(parameters("MechanicsValues::reinit", std::get<0>(entry), false),
+              times,
+              n_points,
+              2.0 * vector_bytes);
+    }
+}
+
+template <int dim, int spacedim = dim>
+void
+run(tbox::Pointer<IBTK::AppInitializer> app_initializer, BenchmarkLog &log)
+{
+  auto benchmark_db = app_initializer->getInputDatabase()->getDatabase(
+    "benchmark");
+  const std::vector<std::string> cell_types =
+    get_string_array(benchmark_db, "cell_types");
+  const std::vector<int> fe_degrees =
+    get_integer_array(benchmark_db, "fe_degrees");
+
+  for (const std::string &cell_type : cell_types)
+    for (const int fe_degree : fe_degrees)
+      run_mesh<dim, spacedim>(benchmark_db, cell_type, fe_degree, log);
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "mechanics.log");
+
+  BenchmarkLog log("mechanics", NDIM, MPI_COMM_WORLD);
+  run<NDIM>(app_initializer, log);
+  log.write(app_initializer->getInputDatabase()
+              ->getDatabase("benchmark")
+              ->getStringWithDefault("output_file", "mechanics.json"));
+}
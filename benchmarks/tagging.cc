@@ -0,0 +1,87 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <vector>
+
+#include "../tests/tests.h"
+#include "benchmarks.h"
+
+// Benchmark cell tagging (i.e., fdl::tag_cells()) on each level of the patch
+// hierarchy with a large mesh (by default, one million elements in 2D). The
+// correctness of tag_cells() is checked by tests/grid/tag_cells_02 with a
+// much smaller mesh.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+void
+run(tbox::Pointer<IBTK::AppInitializer> app_initializer, BenchmarkLog &log)
+{
+  auto       input_db     = app_initializer->getInputDatabase();
+  auto       benchmark_db = input_db->getDatabase("benchmark");
+  const auto mpi_comm     = MPI_COMM_WORLD;
+
+  const unsigned int n_repetitions =
+    benchmark_db->getIntegerWithDefault("n_repetitions", 10);
+  const auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  const auto patch_hierarchy = std::get<0>(tuple);
+  const int  tag_idx         = std::get<6>(tuple);
+
+  Triangulation<spacedim> tria;
+  GridGenerator::hyper_cube(tria, -0.5, 0.5);
+  tria.refine_global(benchmark_db->getInteger("n_global_refinements"));
+
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  cell_bboxes.reserve(tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        patch_hierarchy->getPatchLevel(ln);
+      const auto patches = fdl::extract_patches(level);
+      const auto tag_times =
+        time_repetitions(n_repetitions,
+                         mpi_comm,
+                         [&]()
+                         {
+                           for (auto &patch : patches)
+                             fdl::fill_all(patch->getPatchData(tag_idx), 0);
+                           fdl::tag_cells(cell_bboxes, tag_idx, level);
+                         });
+      log.add({{"function", to_json("tag_cells")},
+               {"level_number", to_json(ln)},
+               {"n_elements", to_json(tria.n_active_cells())}},
+              tag_times,
+              tria.n_active_cells());
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "tagging.log");
+
+  BenchmarkLog log("tagging", NDIM, MPI_COMM_WORLD);
+  run<NDIM>(app_initializer, log);
+  log.write(app_initializer->getInputDatabase()
+              ->getDatabase("benchmark")
+              ->getStringWithDefault("output_file", "tagging.json"));
+}
@@ -1,10 +1,14 @@
 // Based on the Turek-Hron IBFE benchmark
 
+#include <fiddle/base/phase_timings.h>
+
 #include <fiddle/interaction/ifed_method.h>
 
 #include <fiddle/mechanics/force_contribution.h>
 #include <fiddle/mechanics/force_contribution_lib.h>
 
+#include <fiddle/postprocess/part_output.h>
+
 #include <deal.II/distributed/shared_tria.h>
 
 #include <deal.II/dofs/dof_handler.h>
@@ -12,15 +16,12 @@
 
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_system.h>
-#include <deal.II/fe/mapping_fe_field.h>
 
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/manifold_lib.h>
 #include <deal.II/grid/tria.h>
 
-#include <deal.II/numerics/data_out.h>
-
 #include <ibamr/IBExplicitHierarchyIntegrator.h>
 #include <ibamr/INSStaggeredHierarchyIntegrator.h>
 
@@ -35,6 +36,9 @@
 #include <LoadBalancer.h>
 #include <StandardTagAndInitialize.h>
 
+#include <memory>
+#include <string>
+
 std::pair<dealii::Triangulation<2>, dealii::Triangulation<2>>
 make_turek_hron_grid(
   const dealii::Point<2> &cylinder_center         = dealii::Point<2>(0.2, 0.2),
@@ -129,18 +133,38 @@ main(int argc, char *argv[])
     new IBTK::AppInitializer(argc, argv, "IB.log");
   tbox::Pointer<tbox::Database> input_db = app_initializer->getInputDatabase();
 
+  // In benchmark mode we run a fixed number of steps, write no output, and
+  // record the time spent in each phase of the computation. The timers have
+  // to be activated before any of the objects owning them are created.
+  tbox::Pointer<tbox::Database> benchmark_db =
+    input_db->keyExists("Benchmark") ? input_db->getDatabase("Benchmark") :
+                                       tbox::Pointer<tbox::Database>();
+  const bool benchmark_mode =
+    !benchmark_db.isNull() && benchmark_db->getBoolWithDefault("enable", false);
+  const int n_warmup_steps =
+    benchmark_mode ? benchmark_db->getIntegerWithDefault("n_warmup_steps", 2) :
+                     0;
+  const int n_benchmark_steps =
+    benchmark_mode ? benchmark_db->getIntegerWithDefault("n_steps", 20) : 0;
+  std::unique_ptr<fdl::PhaseTimings> phase_timings;
+  if (benchmark_mode)
+    phase_timings = std::make_unique<fdl::PhaseTimings>(
+      fdl::PhaseTimings::default_phases(), IBTK::IBTK_MPI::getCommunicator());
+
   // Get various standard options set in the input file.
-  const bool dump_viz_data     = app_initializer->dumpVizData();
+  const bool dump_viz_data = !benchmark_mode && app_initializer->dumpVizData();
   const int  viz_dump_interval = app_initializer->getVizDumpInterval();
   const bool uses_visit =
     dump_viz_data && app_initializer->getVisItDataWriter();
 
-  const bool dump_restart_data     = app_initializer->dumpRestartData();
+  const bool dump_restart_data =
+    !benchmark_mode && app_initializer->dumpRestartData();
   const int  restart_dump_interval = app_initializer->getRestartDumpInterval();
   const std::string restart_dump_dirname =
     app_initializer->getRestartDumpDirectory();
 
-  const bool dump_postproc_data = app_initializer->dumpPostProcessingData();
+  const bool dump_postproc_data =
+    !benchmark_mode && app_initializer->dumpPostProcessingData();
   const int  postproc_data_dump_interval =
     app_initializer->getPostProcessingDataDumpInterval();
   const std::string postproc_data_dump_dirname =
@@ -151,7 +175,8 @@ main(int argc, char *argv[])
       tbox::Utilities::recursiveMkdir(postproc_data_dump_dirname);
     }
 
-  const bool dump_timer_data     = app_initializer->dumpTimerData();
+  const bool dump_timer_data =
+    !benchmark_mode && app_initializer->dumpTimerData();
   const int  timer_dump_interval = app_initializer->getTimerDumpInterval();
 
   const double beam_shear_modulus = input_db->getDouble("beam_shear_modulus");
@@ -372,6 +397,21 @@ main(int argc, char *argv[])
   tbox::plog << "Input database:\n";
   input_db->printClassData(tbox::plog);
 
+  // Write the parts from a background thread so that the time loop does not
+  // wait for the files
+  fdl::PartOutput<1, 2> surface_part_output(
+    app_initializer->getVizDumpDirectory(), "penalty");
+  fdl::PartOutput<2> part_output(app_initializer->getVizDumpDirectory(),
+                                 "part");
+  auto write_fe_output = [&](const int output_n, const double output_time)
+  {
+    if (ib_method_ops->n_surface_parts() > 0)
+      surface_part_output.write(ib_method_ops->get_surface_part(0),
+                                output_n,
+                                output_time);
+    part_output.write(ib_method_ops->get_part(0), output_n, output_time);
+  };
+
   // Write out initial visualization data.
   int    iteration_num = time_integrator->getIntegratorStep();
   double loop_time     = time_integrator->getIntegratorTime();
@@ -386,38 +426,7 @@ main(int argc, char *argv[])
                                            loop_time);
         }
 
-      if (ib_method_ops->n_surface_parts() > 0)
-        {
-          const auto   &part = ib_method_ops->get_surface_part(0);
-          DataOut<1, 2> data_out;
-          data_out.attach_dof_handler(part.get_dof_handler());
-          data_out.add_data_vector(part.get_velocity(), "U");
-
-          MappingFEField<1, 2, LinearAlgebra::distributed::Vector<double>>
-            position_mapping(part.get_dof_handler(), part.get_position());
-          data_out.build_patches(position_mapping);
-          data_out.write_vtu_with_pvtu_record(
-            app_initializer->getVizDumpDirectory() + "/",
-            "penalty",
-            iteration_num,
-            IBTK::IBTK_MPI::getCommunicator(),
-            8);
-        }
-
-      const auto &part = ib_method_ops->get_part(0);
-      DataOut<2>  data_out;
-      data_out.attach_dof_handler(part.get_dof_handler());
-      data_out.add_data_vector(part.get_velocity(), "U");
-
-      MappingFEField<2, 2, LinearAlgebra::distributed::Vector<double>>
-        position_mapping(part.get_dof_handler(), part.get_position());
-      data_out.build_patches(position_mapping);
-      data_out.write_vtu_with_pvtu_record(
-        app_initializer->getVizDumpDirectory() + "/",
-        "part",
-        iteration_num,
-        IBTK::IBTK_MPI::getCommunicator(),
-        8);
+      write_fe_output(iteration_num, loop_time);
     }
 
   // Open streams to save lift and drag coefficients.
@@ -431,12 +440,19 @@ main(int argc, char *argv[])
                            std::ios_base::out | std::ios_base::trunc);
     }
 
+  int       n_steps_taken = 0;
+  const int n_total_steps = n_warmup_steps + n_benchmark_steps;
+
   // Main time step loop.
   double loop_time_end = time_integrator->getEndTime();
   double dt            = 0.0;
   while (!tbox::MathUtilities<double>::equalEps(loop_time, loop_time_end) &&
-         time_integrator->stepsRemaining())
+         time_integrator->stepsRemaining() &&
+         (!benchmark_mode || n_steps_taken < n_total_steps))
     {
+      if (benchmark_mode && n_steps_taken == n_warmup_steps)
+        phase_timings->start();
+      ++n_steps_taken;
       iteration_num = time_integrator->getIntegratorStep();
       loop_time     = time_integrator->getIntegratorTime();
 
@@ -473,38 +489,7 @@ main(int argc, char *argv[])
             }
 
 
-          if (ib_method_ops->n_surface_parts() > 0)
-            {
-              const auto   &part = ib_method_ops->get_surface_part(0);
-              DataOut<1, 2> data_out;
-              data_out.attach_dof_handler(part.get_dof_handler());
-              data_out.add_data_vector(part.get_velocity(), "U");
-
-              MappingFEField<1, 2, LinearAlgebra::distributed::Vector<double>>
-                position_mapping(part.get_dof_handler(), part.get_position());
-              data_out.build_patches(position_mapping);
-              data_out.write_vtu_with_pvtu_record(
-                app_initializer->getVizDumpDirectory() + "/",
-                "penalty",
-                iteration_num,
-                IBTK::IBTK_MPI::getCommunicator(),
-                8);
-            }
-
-          const auto &part = ib_method_ops->get_part(0);
-          DataOut<2>  data_out;
-          data_out.attach_dof_handler(part.get_dof_handler());
-          data_out.add_data_vector(part.get_velocity(), "U");
-
-          MappingFEField<2, 2, LinearAlgebra::distributed::Vector<double>>
-            position_mapping(part.get_dof_handler(), part.get_position());
-          data_out.build_patches(position_mapping);
-          data_out.write_vtu_with_pvtu_record(
-            app_initializer->getVizDumpDirectory() + "/",
-            "part",
-            iteration_num,
-            IBTK::IBTK_MPI::getCommunicator(),
-            8);
+          write_fe_output(iteration_num, loop_time);
         }
       if (dump_restart_data &&
           (iteration_num % restart_dump_interval == 0 || last_step))
@@ -527,6 +512,29 @@ main(int argc, char *argv[])
         }
     }
 
+  if (benchmark_mode)
+    {
+      AssertThrow(n_steps_taken == n_total_steps,
+                  ExcMessage("The simulation ended before the benchmark "
+                             "finished: increase END_TIME."));
+      phase_timings->stop(n_benchmark_steps);
+      for (unsigned int part_n = 0; part_n < ib_method_ops->n_parts(); ++part_n)
+        phase_timings->add_value(
+          "n_lagrangian_cells_part_" + std::to_string(part_n),
+          ib_method_ops->get_part(part_n)
+            .get_triangulation()
+            .n_locally_owned_active_cells());
+      phase_timings->add_hierarchy_values(
+        patch_hierarchy,
+        ib_method_ops->get_lagrangian_workload_current_index());
+      phase_timings->write(benchmark_db->getStringWithDefault(
+        "output_prefix", "turek-hron-benchmark"));
+    }
+
+  // Summarize the per-phase imbalance without any barriers
+  if (ib_method_ops->has_performance_counters())
+    ib_method_ops->get_performance_counters().write_summary(tbox::plog);
+
   // Close the logging streams.
   if (tbox::SAMRAI_MPI::getRank() == 0)
     {
@@ -0,0 +1,117 @@
+#ifndef included_fiddle_base_hardware_counters_h
+#define included_fiddle_base_hardware_counters_h
+
+#include <fiddle/base/config.h>
+
+#ifdef FDL_ENABLE_HW_COUNTERS
+// likwid-marker.h only defines the marker macros if this is set
+#  ifndef LIKWID_PERFMON
+#    define LIKWID_PERFMON
+#  endif
+#  include <likwid-marker.h>
+#endif
+
+namespace fdl
+{
+  /**
+   * Scope guard which measures hardware counters (e.g., FLOPs, memory
+   * bandwidth, and cache misses) in a named region of code with the LIKWID
+   * marker API. For example,
+   *
+   * @code
+   * {
+   *   HardwareCounterRegion region("fdl::compute_spread()");
+   *   // hot loop
+   * }
+   * @endcode
+   *
+   * Region names follow the names of the corresponding timers. The counters
+   * are printed by <code>likwid-perfctr -m</code>, e.g.,
+   *
+   * @code
+   * likwid-mpirun -np 4 -g FLOPS_DP -m ./main2d input2d
+   * @endcode
+   *
+   * This class does nothing (and has no cost) unless fiddle is configured with
+   * <code>-DFDL_ENABLE_HW_COUNTERS=ON</code>.
+   *
+   * @note LIKWID records counters per thread, so regions in code using
+   * threads (e.g., compute_spread() with more than one thread) should be
+   * created by each thread.
+   */
+  class HardwareCounterRegion
+  {
+  public:
+    /**
+     * Constructor. Starts measuring.
+     */
+    HardwareCounterRegion(const char *name);
+
+    /**
+     * Destructor. Stops measuring.
+     */
+    ~HardwareCounterRegion();
+
+    HardwareCounterRegion(const HardwareCounterRegion &) = delete;
+
+    HardwareCounterRegion &
+    operator=(const HardwareCounterRegion &) = delete;
+
+#ifdef FDL_ENABLE_HW_COUNTERS
+  protected:
+    /**
+     * Initialize the marker API the first time a region is created and write
+     * the results (via LIKWID_MARKER_CLOSE) when the program exits.
+     */
+    static void
+    initialize();
+
+    const char *name;
+#endif
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+#ifdef FDL_ENABLE_HW_COUNTERS
+  inline void
+  HardwareCounterRegion::initialize()
+  {
+    struct MarkerAPI
+    {
+      MarkerAPI()
+      {
+        LIKWID_MARKER_INIT;
+      }
+
+      ~MarkerAPI()
+      {
+        LIKWID_MARKER_CLOSE;
+      }
+    };
+    // thread-safe since C++11
+    static MarkerAPI marker_api;
+  }
+
+  inline HardwareCounterRegion::HardwareCounterRegion(const char *name)
+    : name(name)
+  {
+    initialize();
+    LIKWID_MARKER_START(name);
+  }
+
+  inline HardwareCounterRegion::~HardwareCounterRegion()
+  {
+    LIKWID_MARKER_STOP(name);
+  }
+#else
+  inline HardwareCounterRegion::HardwareCounterRegion(const char *)
+  {}
+
+  inline HardwareCounterRegion::~HardwareCounterRegion()
+  {}
+#endif
+} // namespace fdl
+
+#endif
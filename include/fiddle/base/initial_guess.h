@@ -10,19 +10,86 @@ IBTK_DISABLE_EXTRA_WARNINGS
 IBTK_ENABLE_EXTRA_WARNINGS
 
 #include <deque>
+#include <vector>
 
 namespace fdl
 {
+  /**
+   * Algorithm used by InitialGuess to compute guesses.
+   */
+  enum class InitialGuessType
+  {
+    /**
+     * Project onto the previous solutions by solving a least-squares problem
+     * with the correlation matrix of the previous right-hand sides via an SVD.
+     * This is the most robust choice, but each guess costs O(k^3) for k stored
+     * vectors.
+     */
+    Projection,
+
+    /**
+     * Same as Projection, but keep a Cholesky factor of the correlation
+     * matrix which is updated in each call to InitialGuess::submit(), so that
+     * each submission and guess costs O(k^2) (in addition to the inner
+     * products). Right-hand sides which are (nearly) linearly dependent on the
+     * stored ones are not stored.
+     */
+    IncrementalProjection,
+
+    /**
+     * Extrapolate linearly (in the step index) from the last two solutions,
+     * ignoring the right-hand side.
+     */
+    LinearExtrapolation,
+
+    /**
+     * Extrapolate quadratically (in the step index) from the last three
+     * solutions, ignoring the right-hand side.
+     */
+    QuadraticExtrapolation,
+
+    /**
+     * Same as Projection, but, for periodic problems (e.g., the cardiac
+     * cycle), also archive one solution and right-hand side for each of a
+     * fixed number of phase intervals of the period. Each guess is then
+     * computed by projecting onto the stored vectors and the archived vector
+     * from the same phase interval of a previous period, which is typically
+     * much closer to the current solution than any of the recent ones. Use
+     * InitialGuess::set_time() to set the time of the next guess. This
+     * stores two additional vectors per phase interval.
+     */
+    PeriodicProjection
+  };
+
   /**
    * Class for computing initial guesses - essentially the same as
-   * IBTK::InitialGuess. Uses the 'Fischer-3' algorithm (same as PETSc) to
-   * compute guesses via projection.
+   * IBTK::InitialGuess. By default, uses the 'Fischer-3' algorithm (same as
+   * PETSc) to compute guesses via projection. See InitialGuessType for the
+   * other available algorithms.
    */
   template <typename VectorType>
   class InitialGuess
   {
   public:
-    explicit InitialGuess(const unsigned int n_vectors = 5);
+    /**
+     * Constructor.
+     *
+     * @param[in] n_vectors Maximum number of vectors to store. The
+     * extrapolation algorithms store at most two (linear) or three (quadratic)
+     * vectors and fall back to lower order extrapolation if fewer are stored.
+     *
+     * @param[in] period Length of the period. Only used with
+     * InitialGuessType::PeriodicProjection.
+     *
+     * @param[in] n_phases Number of phase intervals into which the period is
+     * divided, i.e., the number of archived vectors. Only used with
+     * InitialGuessType::PeriodicProjection.
+     */
+    explicit InitialGuess(
+      const unsigned int     n_vectors  = 5,
+      const InitialGuessType guess_type = InitialGuessType::Projection,
+      const double           period     = 0.0,
+      const unsigned int     n_phases   = 0);
 
     void
     submit(const VectorType &solution, const VectorType &rhs);
@@ -30,19 +97,103 @@ namespace fdl
     void
     guess(VectorType &solution, const VectorType &rhs);
 
+    /**
+     * Set the time of the next calls to guess() and submit(). Only used with
+     * InitialGuessType::PeriodicProjection.
+     */
+    void
+    set_time(const double time);
+
+    InitialGuessType
+    get_type() const;
+
   protected:
+    void
+    submit_projection(const VectorType &solution, const VectorType &rhs);
+
+    void
+    guess_projection(VectorType &solution, const VectorType &rhs);
+
+    void
+    submit_incremental_projection(const VectorType &solution,
+                                  const VectorType &rhs);
+
+    void
+    guess_incremental_projection(VectorType &solution, const VectorType &rhs);
+
+    /**
+     * Remove the oldest stored vector and its row and column from the
+     * Cholesky factor via a rank-one update.
+     */
+    void
+    remove_oldest_cholesky_vector();
+
+    void
+    submit_extrapolation(const VectorType &solution);
+
+    void
+    guess_extrapolation(VectorType &solution);
+
+    void
+    submit_periodic_projection(const VectorType &solution,
+                               const VectorType &rhs);
+
+    void
+    guess_periodic_projection(VectorType &solution, const VectorType &rhs);
+
+    InitialGuessType type;
+
     unsigned int n_max_vectors;
     unsigned int n_stored_vectors;
 
     // IBAMR always has Eigen, deal.II only optionally has LAPACK
     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> correlation_matrix;
 
+    /**
+     * Lower-triangular Cholesky factor of the correlation matrix. Only used
+     * with InitialGuessType::IncrementalProjection.
+     */
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> cholesky_factor;
+
     Eigen::VectorXd projection_coefficients;
 
     const VectorType *last_rhs;
 
     std::deque<VectorType> solutions;
     std::deque<VectorType> right_hand_sides;
+
+    /**
+     * Period and phase information. Only used with
+     * InitialGuessType::PeriodicProjection.
+     */
+    double       period_length;
+    unsigned int n_phase_intervals;
+    double       current_time;
+
+    /**
+     * Archived solution and right-hand side for one phase interval.
+     */
+    struct PhaseEntry
+    {
+      /**
+       * Index of the period in which the vectors were archived, or -1 if none
+       * have been.
+       */
+      long int   period_index = -1;
+      VectorType solution;
+      VectorType rhs;
+    };
+
+    std::vector<PhaseEntry> phase_entries;
   };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <typename VectorType>
+  inline InitialGuessType
+  InitialGuess<VectorType>::get_type() const
+  {
+    return type;
+  }
 } // namespace fdl
 #endif
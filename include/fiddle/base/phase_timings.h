@@ -0,0 +1,140 @@
+#ifndef included_fiddle_base_phase_timings_h
+#define included_fiddle_base_phase_timings_h
+
+#include <fiddle/base/config.h>
+
+#include <tbox/Pointer.h>
+#include <tbox/Timer.h>
+
+#include <mpi.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// forward declarations
+namespace SAMRAI
+{
+  namespace hier
+  {
+    template <int>
+    class PatchHierarchy;
+  }
+} // namespace SAMRAI
+
+namespace fdl
+{
+  using namespace SAMRAI;
+
+  /**
+   * Class which measures the time each processor spends in each phase of a
+   * simulation (e.g., spreading or the fluid solve) over some number of time
+   * steps, along with per-processor workload quantities (e.g., the number of
+   * Cartesian grid cells), and writes the results and their load imbalance to
+   * CSV and JSON files.
+   *
+   * Each phase is the sum of one or more SAMRAI timers. Since SAMRAI only
+   * records times for timers which are active, this class activates each
+   * timer when it is constructed. SAMRAI cannot activate a timer after it has
+   * been created, so this object must be set up before the objects owning the
+   * timers (e.g., IFEDMethod and the hierarchy integrators).
+   *
+   * This class is intended for scaling studies: see the benchmark mode of the
+   * Turek-Hron example for an example.
+   */
+  class PhaseTimings
+  {
+  public:
+    /**
+     * Names of the phases and the SAMRAI timers which comprise them.
+     */
+    using Phases =
+      std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+    /**
+     * Default phases of an IFEDMethod simulation: interpolate, spread, pk1,
+     * structure_solve (the Lagrangian L2 projections), fluid_solve, regrid, and
+     * step (i.e., the total time spent advancing the hierarchy). Since the
+     * interpolation and force computation timers include their L2
+     * projections, some phases overlap.
+     */
+    static Phases
+    default_phases();
+
+    /**
+     * Constructor. This call is collective.
+     */
+    PhaseTimings(const Phases &phases, const MPI_Comm &communicator);
+
+    /**
+     * Start measuring, i.e., record the current values of all timers. Any
+     * previously measured times are discarded.
+     */
+    void
+    start();
+
+    /**
+     * Stop measuring after @p n_steps time steps.
+     */
+    void
+    stop(const unsigned int n_steps);
+
+    /**
+     * Record a per-processor quantity, e.g., the number of locally owned
+     * elements. Every processor must add the same quantities in the same
+     * order.
+     */
+    void
+    add_value(const std::string &name, const double value);
+
+    /**
+     * Record, for each level of @p patch_hierarchy, the number of locally
+     * owned cells and (if @p workload_index is not -1) the sum of the workload
+     * data in those cells.
+     */
+    template <int spacedim>
+    void
+    add_hierarchy_values(
+      tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+      const int                                     workload_index = -1);
+
+    /**
+     * Write the results to <code>prefix.csv</code> (one row per processor)
+     * and <code>prefix.json</code> (per-processor values and, for each
+     * quantity, its minimum, mean, maximum, and imbalance, i.e., the maximum
+     * divided by the mean). All phase times are per time step. This call is
+     * collective.
+     */
+    void
+    write(const std::string &prefix) const;
+
+  protected:
+    MPI_Comm communicator;
+
+    Phases phases;
+
+    /**
+     * Timers comprising each phase.
+     */
+    std::vector<std::vector<tbox::Pointer<tbox::Timer>>> timers;
+
+    /**
+     * Wall clock time of each phase when start() was called.
+     */
+    std::vector<double> start_times;
+
+    /**
+     * Wall clock time of each phase per step, computed by stop().
+     */
+    std::vector<double> step_times;
+
+    unsigned int n_steps;
+
+    /**
+     * Names and values of the per-processor quantities.
+     */
+    std::vector<std::pair<std::string, double>> values;
+  };
+} // namespace fdl
+
+#endif
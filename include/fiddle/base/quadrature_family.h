@@ -7,6 +7,7 @@
 
 #include <deal.II/base/quadrature.h>
 
+#include <array>
 #include <deque>
 
 namespace fdl
@@ -57,6 +58,19 @@ namespace fdl
     virtual unsigned char
     get_index(const double eulerian_length,
               const double lagrangian_length) const = 0;
+
+    /**
+     * Eagerly compute every quadrature rule up to and including the one
+     * returned by get_index(eulerian_length, lagrangian_length). Families
+     * which compute rules on demand should, after this function is called,
+     * no longer modify themselves in operator[]() or get_index(), so that
+     * those functions may be called concurrently from multiple threads.
+     *
+     * This function may be called several times to extend the table. The
+     * default implementation does nothing.
+     */
+    virtual void
+    precompute(const double eulerian_length, const double lagrangian_length);
   };
 
   /**
@@ -110,6 +124,16 @@ namespace fdl
     get_index(const double eulerian_length,
               const double lagrangian_length) const override;
 
+    /**
+     * Compute all quadrature rules up to the one needed for the given lengths.
+     * Afterwards, operator[]() and get_index() only read the precomputed
+     * table (using a binary search in the latter) and it is an error to ask
+     * them for rules past the end of it.
+     */
+    virtual void
+    precompute(const double eulerian_length,
+               const double lagrangian_length) override;
+
     /**
      * Get the vector of maximum point distances. This is only public for
      * benchmarking and testing purposes - it should not be necessary to call
@@ -146,6 +170,18 @@ namespace fdl
      * density than the worst-case distance.
      */
     mutable std::vector<double> mean_point_distances;
+
+    /**
+     * Whether or not precompute() has been called, i.e., whether or not the
+     * table of quadratures is fixed.
+     */
+    bool is_precomputed;
+
+    /**
+     * Running minimum of mean_point_distances, which is nonincreasing and can
+     * therefore be searched with a binary search. Only set up by precompute().
+     */
+    std::vector<double> min_mean_point_distances;
   };
 
   /**
@@ -178,6 +214,16 @@ namespace fdl
     get_index(const double eulerian_length,
               const double lagrangian_length) const override;
 
+    /**
+     * Compute all quadrature rules up to the one needed for the given lengths.
+     * Afterwards, operator[]() and get_index() only read the precomputed
+     * table (using a binary search in the latter) and it is an error to ask
+     * them for rules past the end of it.
+     */
+    virtual void
+    precompute(const double eulerian_length,
+               const double lagrangian_length) override;
+
     /**
      * Get the vector of maximum point distances. This is only public for
      * benchmarking and testing purposes - it should not be necessary to call
@@ -214,10 +260,80 @@ namespace fdl
      * density than the worst-case distance.
      */
     mutable std::vector<double> mean_point_distances;
+
+    /**
+     * Whether or not precompute() has been called, i.e., whether or not the
+     * table of quadratures is fixed.
+     */
+    bool is_precomputed;
+
+    /**
+     * Running minimum of mean_point_distances, which is nonincreasing and can
+     * therefore be searched with a binary search. Only set up by precompute().
+     */
+    std::vector<double> min_mean_point_distances;
+  };
+
+  /**
+   * Family of tensor-product quadratures with possibly different numbers of
+   * points in each coordinate direction, built from iterated QGauss rules.
+   *
+   * QGaussFamily picks the same number of points in every coordinate
+   * direction from a single length (typically the longest edge) of each
+   * element, so thin, stretched elements get many more points in their short
+   * directions than needed. This family instead picks the number of points in
+   * each reference coordinate direction independently from the length of the
+   * element in that direction (see compute_reference_direction_lengths()),
+   * using the same density criterion as QGaussFamily: the mean distance
+   * between points, i.e., one over the number of points in a direction, must
+   * be at most the Eulerian length divided by point_density times the
+   * Lagrangian length.
+   *
+   * Since the number of possible rules is large, this class does not store
+   * any: get_quadrature() computes them. It only makes sense for
+   * quadrilaterals and hexahedra.
+   */
+  template <int dim>
+  class QGaussAnisotropicFamily
+  {
+  public:
+    /**
+     * Constructor. Like QGaussFamily, each generated rule has at least
+     * @p min_points_1D points in each coordinate direction.
+     */
+    QGaussAnisotropicFamily(const unsigned int min_points_1D,
+                            const double       point_density = 1.0);
+
+    /**
+     * Determine the number of points in each coordinate direction for an
+     * element whose length in each reference coordinate direction is given
+     * by @p lagrangian_lengths.
+     */
+    std::array<unsigned char, dim>
+    get_n_points(const double                   eulerian_length,
+                 const std::array<double, dim> &lagrangian_lengths) const;
+
+    /**
+     * Return the tensor product of iterated QGauss rules with at least
+     * <code>n_points[d]</code> points in coordinate direction <code>d</code>.
+     */
+    Quadrature<dim>
+    get_quadrature(const std::array<unsigned char, dim> &n_points) const;
+
+  protected:
+    unsigned int min_points_1D;
+
+    double point_density;
   };
 
 
   // Inline functions
+  template <int dim>
+  inline void
+  QuadratureFamily<dim>::precompute(const double /*eulerian_length*/,
+                                    const double /*lagrangian_length*/)
+  {}
+
   template <int dim>
   const std::vector<double> &
   QGaussFamily<dim>::get_max_point_distances() const
@@ -3,6 +3,8 @@
 
 #include <fiddle/base/config.h>
 
+#include <mpi.h>
+
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +17,8 @@ namespace SAMRAI
     template <int>
     class BasePatchLevel;
     template <int>
+    class IntVector;
+    template <int>
     class Patch;
     template <int>
     class PatchData;
@@ -110,6 +114,34 @@ namespace fdl
   int
   extract_depth(const tbox::Pointer<hier::PatchData<spacedim>> &p);
 
+  /**
+   * The combined results of extract_types() and extract_depth().
+   */
+  struct PatchDataTypeInfo
+  {
+    SAMRAIPatchType patch_type;
+    SAMRAIFieldType field_type;
+    int             depth;
+  };
+
+  /**
+   * Get the type information of the patch data of @p patch corresponding to
+   * @p data_index.
+   *
+   * Both extract_types() and extract_depth() try each possible derived class
+   * in turn. Since the type of the data only depends on the data index's
+   * PatchDataFactory (which, in practice, is shared by every patch of every
+   * hierarchy) this function only does that once per data index and
+   * afterwards looks the information up in a cache, which is keyed on the
+   * factory and hence remains correct if the data index is reassigned to a
+   * different variable. This function may be called by multiple threads at
+   * once.
+   */
+  template <int spacedim>
+  PatchDataTypeInfo
+  get_patch_data_type_info(const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                           const int data_index);
+
   /**
    * Like depth, each class inheriting from PatchData implements fillAll and is
    * templated on type, but none of this information is available without
@@ -138,6 +170,27 @@ namespace fdl
            const field_type                              value         = 0,
            const bool                                    interior_only = false);
 
+  /**
+   * Same as above, but for several data indices at once: i.e., this function
+   * loops over each level's patches once and sets every data index on each
+   * patch, rather than once per data index.
+   *
+   * If @p ghosts_only is true then only the ghost regions are set and the
+   * interior values are left unchanged. This is useful when the interior is
+   * about to be overwritten (e.g., by a copy from another hierarchy).
+   *
+   * @note If needed, this function will allocate patch data for each entry of
+   * @p data_indices.
+   */
+  template <int spacedim, typename field_type = int>
+  void
+  fill_all(tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+           const std::vector<int>                       &data_indices,
+           const int                                     coarsest_level_number,
+           const int                                     finest_level_number,
+           const field_type                              value       = 0,
+           const bool                                    ghosts_only = false);
+
   /**
    * Like elsewhere, SAMRAI doesn't provide any way to actually subtract two
    * sets of data in a generic way, so we need to implement our own lookup code.
@@ -148,6 +201,120 @@ namespace fdl
     const tbox::Pointer<hier::Variable<spacedim>> p,
     tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy);
 
+  /**
+   * Return whether or not two patch levels (which may belong to different
+   * hierarchies) consist of the same boxes assigned to the same processors,
+   * i.e., whether or not the <code>i</code>th patch of each level covers the
+   * same cells on the same processor. Since SAMRAI stores every box on every
+   * processor this function does not communicate and returns the same value
+   * on every processor.
+   */
+  template <int spacedim>
+  bool
+  have_same_layout(tbox::Pointer<hier::PatchLevel<spacedim>> level_1,
+                   tbox::Pointer<hier::PatchLevel<spacedim>> level_2);
+
+  /**
+   * Make each patch of @p dst_level use the patch data for @p data_index of
+   * the corresponding patch of @p src_level, i.e., share the data instead of
+   * copying it. The levels must have the same layout (see have_same_layout())
+   * and the data must have the same ghost width on both levels, which is the
+   * case when both hierarchies use the same variable database. Any data
+   * previously allocated on @p dst_level for @p data_index is released.
+   */
+  template <int spacedim>
+  void
+  alias_patch_data(tbox::Pointer<hier::PatchLevel<spacedim>> dst_level,
+                   tbox::Pointer<hier::PatchLevel<spacedim>> src_level,
+                   const int                                 data_index);
+
+  /**
+   * Same as above, but @p src_level only contains some of the patches of
+   * @p dst_level (e.g., it was created by make_patch_level_subset()): patch
+   * <code>i</code> of @p src_level has the same box and processor as patch
+   * <code>patch_numbers[i]</code> of @p dst_level. The data of the other
+   * patches of @p dst_level is not modified.
+   */
+  template <int spacedim>
+  void
+  alias_patch_data(tbox::Pointer<hier::PatchLevel<spacedim>> dst_level,
+                   tbox::Pointer<hier::PatchLevel<spacedim>> src_level,
+                   const std::vector<int>                   &patch_numbers,
+                   const int                                 data_index);
+
+  /**
+   * Create a new patch level, which is not part of any hierarchy, consisting
+   * of the patches of @p level whose numbers are in @p patch_numbers (in that
+   * order) on the same processors. The new level has the same level number,
+   * ratio, grid geometry, and patch descriptor as @p level but no allocated
+   * data. This is useful for filling data on only part of a level, e.g.,
+   * with a RefineSchedule whose destination is the new level. Since SAMRAI
+   * stores every box on every processor this function does not communicate,
+   * but it must be called with the same @p patch_numbers on every processor.
+   */
+  template <int spacedim>
+  tbox::Pointer<hier::PatchLevel<spacedim>>
+  make_patch_level_subset(tbox::Pointer<hier::PatchLevel<spacedim>> level,
+                          const std::vector<int> &patch_numbers);
+
+  /**
+   * Add the interior values of @p src to those of @p dst, i.e., set
+   * <code>dst += src</code> on the patch box of @p dst. Like
+   * extract_hierarchy_data_ops(), this only supports double-precision data.
+   */
+  template <int spacedim>
+  void
+  add_patch_data(tbox::Pointer<hier::PatchData<spacedim>>       dst,
+                 const tbox::Pointer<hier::PatchData<spacedim>> src);
+
+  /**
+   * Add the nonzero interior values of the data @p data_index on
+   * @p src_level to the corresponding cells of @p dst_level, which may have a
+   * completely different layout (e.g., the levels of the secondary and
+   * primary hierarchies with the same level number). Only the nonzero values
+   * are sent, each along with its cell index, directly to the processor
+   * owning the patch of @p dst_level containing it. This is much cheaper than
+   * a complete transfer schedule when most values are zero (e.g., a
+   * workload concentrated near a structure). This call is collective.
+   *
+   * @note Only cell-centered double precision data is supported.
+   */
+  template <int spacedim>
+  void
+  add_nonzero_cell_data(tbox::Pointer<hier::PatchLevel<spacedim>> dst_level,
+                        tbox::Pointer<hier::PatchLevel<spacedim>> src_level,
+                        const int                                 data_index,
+                        const MPI_Comm                            communicator);
+
+  /**
+   * Add the values of the data @p data_index in the ghost regions of each
+   * patch on levels @p coarsest_level_number through @p finest_level_number
+   * of @p patch_hierarchy to the interior values of the patches (on the same
+   * level, including periodic images) containing them. This is the same
+   * operation done by IBTK::SAMRAIGhostDataAccumulator, e.g., after spreading
+   * forces, but only the overlaps between ghost regions and patches which
+   * contain at least one nonzero value are sent (along with their boxes)
+   * directly to the owning processors. Since structures typically only cover
+   * a small part of the domain most overlaps are zero, so this is much
+   * cheaper than a complete transfer schedule. This call is collective.
+   *
+   * @param[in] ghost_width Width of the ghost region to accumulate, which
+   * must not be larger than the ghost width of the data.
+   *
+   * @note Only cell- and side-centered double precision data is supported.
+   * Values on sides shared by two patches are treated like all other values,
+   * i.e., each patch adds the value of the other one.
+   */
+  template <int spacedim>
+  void
+  accumulate_nonzero_ghost_data(
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const int                                     data_index,
+    const hier::IntVector<spacedim>              &ghost_width,
+    const int                                     coarsest_level_number,
+    const int                                     finest_level_number,
+    const MPI_Comm                                communicator);
+
   /**
    * Copy the contents of the database into a new database.
    */
@@ -0,0 +1,116 @@
+#ifndef included_fiddle_base_tracer_h
+#define included_fiddle_base_tracer_h
+
+#include <fiddle/base/config.h>
+
+#include <mpi.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fdl
+{
+  /**
+   * Class which records a timeline of events (e.g., the stages of each
+   * transaction run by a TransactionScheduler, MPI waits, and CG solves) on
+   * each processor and writes it in the Chrome trace event format, which can
+   * be viewed with, e.g., <code>chrome://tracing</code> or
+   * <code>ui.perfetto.dev</code>.
+   *
+   * In the trace each processor is a process and each lane (e.g., "part 0")
+   * is a thread, so the overlap of the computations and communication of
+   * different parts is visible. Timestamps are measured with MPI_Wtime()
+   * relative to the time at which this object was constructed. Since the
+   * constructor synchronizes all processors, these times are comparable
+   * between processors (up to clock drift).
+   *
+   * Events may be added by multiple threads at once.
+   */
+  class Tracer
+  {
+  public:
+    /**
+     * Constructor. This call is collective.
+     */
+    Tracer(const MPI_Comm &communicator);
+
+    /**
+     * Record an event named @p name in the lane @p lane which started at
+     * @p start_time and ended at @p end_time (both measured with
+     * MPI_Wtime()). The event's category @p category (e.g., "compute" or
+     * "mpi") may be used to filter events in the viewer.
+     */
+    void
+    add_event(const std::string &lane,
+              const std::string &name,
+              const std::string &category,
+              const double       start_time,
+              const double       end_time);
+
+    /**
+     * Return the time (measured with MPI_Wtime()) at which this object was
+     * constructed.
+     */
+    double
+    get_start_time() const;
+
+    /**
+     * Return the number of events recorded on the current processor.
+     */
+    std::size_t
+    n_events() const;
+
+    /**
+     * Write all events recorded on all processors to @p filename. This call
+     * is collective.
+     */
+    void
+    write(const std::string &filename) const;
+
+    /**
+     * Discard all recorded events.
+     */
+    void
+    clear();
+
+  protected:
+    /**
+     * A single event.
+     */
+    struct Event
+    {
+      unsigned int lane_n;
+      std::string  name;
+      std::string  category;
+      double       start_time;
+      double       end_time;
+    };
+
+    MPI_Comm communicator;
+
+    double start_time;
+
+    mutable std::mutex mutex;
+
+    /**
+     * Numbers of the lanes, in order of first use.
+     */
+    std::map<std::string, unsigned int> lanes;
+
+    std::vector<Event> events;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  inline double
+  Tracer::get_start_time() const
+  {
+    return start_time;
+  }
+} // namespace fdl
+
+#endif
@@ -33,6 +33,8 @@ namespace fdl
   /**
    * Decode arbitrary data from base64 back to binary. The output type is a
    * string so that this can be easily read from with std::istringstream.
+   * Throws an exception if the input contains characters which are not part
+   * of the base64 alphabet.
    */
   std::string
   decode_base64(const char *begin, const char *end);
@@ -4,9 +4,21 @@
 #include <fiddle/base/config.h>
 
 FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/bounding_box.h>
+
+#include <deal.II/grid/cell_id.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
 #include <vector>
 
 // forward declarations
@@ -14,8 +26,12 @@ namespace dealii
 {
   template <int, int>
   class Mapping;
+  template <int>
+  class Quadrature;
   template <int, int>
   class DoFHandler;
+  template <int, int>
+  class Triangulation;
 
   namespace parallel
   {
@@ -60,6 +76,55 @@ namespace fdl
   intersects(const BoundingBox<spacedim, Number1> &a,
              const BoundingBox<spacedim, Number2> &b);
 
+  /**
+   * A set of bounding boxes stored as arrays of coordinates (i.e., the lower
+   * bounds of every box in the first coordinate direction are contiguous, and
+   * so on) so that one box can be checked against all of them at once with
+   * SIMD instructions.
+   *
+   * If @p Number is less precise than the coordinates of the original boxes
+   * then the coordinates are rounded outwards, so each stored box contains
+   * the original one.
+   */
+  template <int spacedim, typename Number = float>
+  class BoundingBoxBatch
+  {
+  public:
+    BoundingBoxBatch() = default;
+
+    template <typename Number2>
+    BoundingBoxBatch(const std::vector<BoundingBox<spacedim, Number2>> &bboxes);
+
+    template <typename Number2>
+    void
+    reinit(const std::vector<BoundingBox<spacedim, Number2>> &bboxes);
+
+    std::size_t
+    size() const;
+
+    std::array<std::vector<Number>, spacedim> lower_bounds;
+    std::array<std::vector<Number>, spacedim> upper_bounds;
+  };
+
+  /**
+   * Check @p a against every box in @p bboxes: i.e., set the <code>i</code>th
+   * entry of @p result to 1 if @p a intersects the <code>i</code>th box and 0
+   * otherwise. @p result is resized if necessary.
+   */
+  template <int spacedim, typename Number1, typename Number2>
+  void
+  intersects(const BoundingBox<spacedim, Number1>      &a,
+             const BoundingBoxBatch<spacedim, Number2> &bboxes,
+             std::vector<unsigned char>                &result);
+
+  /**
+   * Return whether or not @p a intersects any box in @p bboxes.
+   */
+  template <int spacedim, typename Number1, typename Number2>
+  bool
+  intersects_any(const BoundingBox<spacedim, Number1>      &a,
+                 const BoundingBoxBatch<spacedim, Number2> &bboxes);
+
   /**
    * Compute the bounding boxes for a set of SAMRAI patches. In addition, if
    * necessary, expand each bounding box by @p extra_ghost_cell_fraction times
@@ -92,6 +157,92 @@ namespace fdl
   compute_cell_bboxes(const DoFHandler<dim, spacedim> &dof_handler,
                       const Mapping<dim, spacedim>    &mapping);
 
+  /**
+   * Compute, in a single pass over the locally owned active cells, both the
+   * bounding box (like compute_cell_bboxes()) and an estimate of the longest
+   * edge length (like compute_longest_edge_lengths()) of each cell.
+   *
+   * The mapping is only evaluated at the unit support points of the finite
+   * element and the vertices of the reference cell. The length of each edge
+   * is estimated as the length of the polyline connecting the mapped points
+   * which lie on that edge, which is exact for straight edges.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping);
+
+  /**
+   * Like compute_cell_bboxes_and_longest_edge_lengths(), but read the
+   * positions of the support points directly from @p position (which must
+   * have its ghost values updated) instead of evaluating a MappingFEField.
+   * This is a single pass over the DoF values of each cell, which is much
+   * cheaper than setting up and reinitializing FEValues.
+   *
+   * Unlike compute_cell_bboxes_and_longest_edge_lengths() the bounding boxes
+   * are conservative: since the shape functions of a Lagrange element sum to
+   * one, each coordinate in a cell lies within the range of its nodal values
+   * expanded, on both sides, by the width of that range times the largest
+   * sum of the negative parts of the shape functions. That sum is zero for
+   * multilinear elements (so their boxes are exact) and is computed once per
+   * finite element by sampling on a fine lattice.
+   *
+   * @note Only Lagrange elements on hypercube cells, with one component per
+   * spatial dimension and support points at the vertices, are supported.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_nodal_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim>                  &dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position);
+
+  /**
+   * Like compute_cell_bboxes_and_longest_edge_lengths(), but compute each
+   * bounding box from the mapped points of @p quadrature (i.e., the points at
+   * which the cell interacts with the fluid) instead of the support points.
+   *
+   * For large, curved elements (e.g., of a thin shell) the bounding box of
+   * the support points is much larger than the element itself, so
+   * intersecting it with patches selects many cells which never interact
+   * with them. The bounding box of the points is much tighter. Since the
+   * interaction quadrature may be finer than @p quadrature, the box is
+   * expanded by <code>dim * s * h</code>, where <code>s</code> is the
+   * smallest distance (in reference coordinates) between a point of
+   * @p quadrature and the boundary of the reference cell and <code>h</code>
+   * is the cell's longest edge length, and then intersected with the
+   * bounding box of the support points. Hence the result is never larger
+   * than the output of compute_cell_bboxes_and_longest_edge_lengths() and,
+   * for cells with straight edges, still contains the whole cell.
+   *
+   * Since these bounding boxes are used both to set up the
+   * OverlapTriangulation and the PatchMap, using them reduces both the size
+   * of the overlap triangulations and the amount of data scattered to them.
+   *
+   * @note Only hypercube cells are supported.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping,
+    const Quadrature<dim>           &quadrature);
+
+  /**
+   * Like the other overload, but start from already computed bounding boxes
+   * and longest edge lengths of the locally owned active cells (e.g., the
+   * output of compute_cell_nodal_bboxes_and_longest_edge_lengths()) instead
+   * of those of compute_cell_bboxes_and_longest_edge_lengths().
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping,
+    const Quadrature<dim>           &quadrature,
+    std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+      support_point_geometry);
+
   /**
    * Collect all bounding boxes on all processors.
    */
@@ -101,6 +252,102 @@ namespace fdl
     const parallel::shared::Triangulation<dim, spacedim> &tria,
     const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes);
 
+  /**
+   * Like collect_all_active_cell_bboxes() and collect_longest_edge_lengths()
+   * but collect both bounding boxes and edge lengths with a single
+   * all-gather.
+   */
+  template <int dim, int spacedim = dim>
+  std::pair<std::vector<BoundingBox<spacedim, float>>, std::vector<float>>
+  collect_all_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, float>> &local_active_cell_bboxes,
+    const std::vector<float> &local_active_edge_lengths);
+
+  /**
+   * Like collect_all_active_cell_bboxes_and_lengths(), but store the results
+   * in memory shared by all processors on the same node (see
+   * AlignedVector::replicate_across_communicator()). The data is gathered on
+   * the first processor and then broadcast to one processor per node, so no
+   * other processor ever stores its own copy of the global arrays.
+   *
+   * The returned arrays must not be modified.
+   */
+  template <int dim, int spacedim = dim>
+  std::pair<AlignedVector<BoundingBox<spacedim, float>>, AlignedVector<float>>
+  collect_shared_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, float>> &local_active_cell_bboxes,
+    const std::vector<float> &local_active_edge_lengths);
+
+  /**
+   * Ways to encode bounding boxes in update_all_active_cell_bboxes().
+   */
+  enum class BoundingBoxEncoding
+  {
+    /**
+     * Send each coordinate with full precision.
+     */
+    Full,
+    /**
+     * Send each coordinate as a 16-bit fixed-point offset relative to an
+     * origin computed on each processor. The offsets are rounded outwards so
+     * that each received bounding box contains the original one.
+     */
+    Compressed
+  };
+
+  /**
+   * Like collect_all_active_cell_bboxes(), but update
+   * @p global_active_cell_bboxes (which should be the output of a previous
+   * call to collect_all_active_cell_bboxes() or this function) in place and
+   * only communicate the bounding boxes which have changed.
+   *
+   * A bounding box is only sent when either the new box is no longer contained
+   * in the stored one or the stored one is more than <code>2 *
+   * tolerance</code> bigger than the new one in some coordinate direction.
+   * When a box is sent it is first padded by @p tolerance so that small
+   * movements do not require sending it again. Hence, each entry of
+   * @p global_active_cell_bboxes always contains the corresponding cell's
+   * bounding box, but may be slightly larger.
+   *
+   * If @p global_active_cell_bboxes does not have one entry per active cell
+   * then this function falls back to collect_all_active_cell_bboxes().
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  void
+  update_all_active_cell_bboxes(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    std::vector<BoundingBox<spacedim, Number>>       &global_active_cell_bboxes,
+    const double                                      tolerance = 0.0,
+    const BoundingBoxEncoding encoding = BoundingBoxEncoding::Full);
+
+  /**
+   * Find the bounding boxes of all active cells, owned by any processor, which
+   * intersect at least one of @p local_patch_bboxes without replicating the
+   * bounding boxes of every cell on every processor.
+   *
+   * The patch bounding boxes (of which there are far fewer than cells) are
+   * gathered on every processor. Each processor then sends the bounding box of
+   * each of its locally owned cells only to the processors owning a patch it
+   * intersects. Since only locally owned cells are accessed this function
+   * does not assume that @p tria is a parallel::shared::Triangulation.
+   *
+   * @param[in] local_active_cell_bboxes Bounding boxes of the locally owned
+   * active cells, in the same order as the output of compute_cell_bboxes().
+   *
+   * @return The CellId and bounding box of each intersecting cell, sorted by
+   * CellId.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::vector<std::pair<CellId, BoundingBox<spacedim, Number>>>
+  exchange_intersecting_active_cell_bboxes(
+    const Triangulation<dim, spacedim>               &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim>>         &local_patch_bboxes,
+    const MPI_Comm                                    communicator);
+
   /**
    * Convert a Box (in SAMRAI's index space) to a BoundingBox (in real space).
    */
@@ -109,6 +356,80 @@ namespace fdl
   box_to_bbox(const hier::Box<spacedim>                           &box,
               const tbox::Pointer<hier::BasePatchLevel<spacedim>> &patch_level);
 
+  /**
+   * Extend each face of each box in @p bboxes which lies on the boundary of
+   * the physical domain of @p patch_level outward by @p width. Since the
+   * boxes of a patch level do not cover points on the upper boundary of the
+   * domain when treated as half-open (see contains()), this is useful for
+   * assigning every point in the domain to exactly one box.
+   */
+  template <int spacedim>
+  void
+  extend_boundary_bboxes(
+    std::vector<BoundingBox<spacedim>>                  &bboxes,
+    const tbox::Pointer<hier::BasePatchLevel<spacedim>> &patch_level,
+    const double                                         width);
+
+  /**
+   * Compute the index of the cell containing each point in @p points, i.e.,
+   * the same values as IBTK::IndexUtilities::getCellIndex(), for many points
+   * at once. The points are stored as consecutive coordinates (e.g., a nodal
+   * position vector) and the indices are stored in the same way in
+   * @p indices, which is resized if necessary. Unlike calling getCellIndex()
+   * for each point, the loop over points does not branch and can be
+   * vectorized.
+   *
+   * @param[in] x_lower Coordinates of the lower corner of @p box.
+   *
+   * @param[in] x_upper Coordinates of the upper corner of @p box.
+   *
+   * @param[in] dx Cell widths.
+   */
+  template <int spacedim>
+  void
+  compute_cell_indices(const ArrayView<const double> &points,
+                       const double *const            x_lower,
+                       const double *const            x_upper,
+                       const double *const            dx,
+                       const hier::Box<spacedim>     &box,
+                       std::vector<int>              &indices);
+
+  /**
+   * Same as above, but for the cells of @p patch.
+   */
+  template <int spacedim>
+  void
+  compute_cell_indices(const ArrayView<const double>              &points,
+                       const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                       std::vector<int>                           &indices);
+
+  /**
+   * Set the <code>i</code>th entry of @p result to 1 if the <code>i</code>th
+   * cell index in @p indices (stored as in compute_cell_indices()) is in
+   * @p box and 0 otherwise. @p result is resized if necessary.
+   */
+  template <int spacedim>
+  void
+  contains(const hier::Box<spacedim>  &box,
+           const std::vector<int>     &indices,
+           std::vector<unsigned char> &result);
+
+  /**
+   * Set the <code>i</code>th entry of @p result to 1 if the <code>i</code>th
+   * point in @p points (stored as in compute_cell_indices()) is in @p bbox
+   * and 0 otherwise. @p result is resized if necessary.
+   *
+   * @param[in] half_open If true, points on the upper boundary of @p bbox
+   * are not in @p bbox. This is useful for assigning each point to exactly
+   * one of several adjacent boxes.
+   */
+  template <int spacedim>
+  void
+  contains(const BoundingBox<spacedim>   &bbox,
+           const ArrayView<const double> &points,
+           std::vector<unsigned char>    &result,
+           const bool                     half_open = false);
+
 
   // --------------------------- inline functions --------------------------- //
 
@@ -119,29 +440,131 @@ namespace fdl
              const BoundingBox<spacedim, Number2> &b)
   {
     // Since boxes are tensor products of line intervals it suffices to check
-    // that the line segments for each coordinate axis overlap.
+    // that the line segments for each coordinate axis overlap, i.e., that
+    // neither segment lies entirely below the other. Avoid branches so that
+    // this can be inlined into (and vectorized with) the calling loop.
+    bool result = true;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      result &= (a.lower_bound(d) <= b.upper_bound(d)) &
+                (b.lower_bound(d) <= a.upper_bound(d));
+    return result;
+  }
+
+  namespace internal
+  {
+    /**
+     * Convert @p value to @p Number, rounding down if it cannot be
+     * represented exactly.
+     */
+    template <typename Number, typename Number2>
+    inline Number
+    round_down(const Number2 value)
+    {
+      const Number result = static_cast<Number>(value);
+      return result > value ?
+               std::nextafter(result, -std::numeric_limits<Number>::max()) :
+               result;
+    }
+
+    /**
+     * Convert @p value to @p Number, rounding up if it cannot be represented
+     * exactly.
+     */
+    template <typename Number, typename Number2>
+    inline Number
+    round_up(const Number2 value)
+    {
+      const Number result = static_cast<Number>(value);
+      return result < value ?
+               std::nextafter(result, std::numeric_limits<Number>::max()) :
+               result;
+    }
+  } // namespace internal
+
+  template <int spacedim, typename Number>
+  template <typename Number2>
+  inline BoundingBoxBatch<spacedim, Number>::BoundingBoxBatch(
+    const std::vector<BoundingBox<spacedim, Number2>> &bboxes)
+  {
+    reinit(bboxes);
+  }
+
+  template <int spacedim, typename Number>
+  template <typename Number2>
+  inline void
+  BoundingBoxBatch<spacedim, Number>::reinit(
+    const std::vector<BoundingBox<spacedim, Number2>> &bboxes)
+  {
     for (unsigned int d = 0; d < spacedim; ++d)
       {
-        // Line segments can intersect in two ways:
-        // 1. They can overlap.
-        // 2. One can be inside the other.
-        //
-        // In the first case we want to see if either end point of the second
-        // line segment lies within the first. In the second case we can simply
-        // check that one end point of the first line segment lies in the second
-        // line segment. Note that we don't need, in the second case, to do two
-        // checks since that case is already covered by the first.
-        if (!((a.lower_bound(d) <= b.lower_bound(d) &&
-               b.lower_bound(d) <= a.upper_bound(d)) ||
-              (a.lower_bound(d) <= b.upper_bound(d) &&
-               b.upper_bound(d) <= a.upper_bound(d))) &&
-            !((b.lower_bound(d) <= a.lower_bound(d) &&
-               a.lower_bound(d) <= b.upper_bound(d))))
+        lower_bounds[d].resize(bboxes.size());
+        upper_bounds[d].resize(bboxes.size());
+        for (std::size_t i = 0; i < bboxes.size(); ++i)
           {
-            return false;
+            lower_bounds[d][i] =
+              internal::round_down<Number>(bboxes[i].lower_bound(d));
+            upper_bounds[d][i] =
+              internal::round_up<Number>(bboxes[i].upper_bound(d));
           }
       }
-    return true;
+  }
+
+  template <int spacedim, typename Number>
+  inline std::size_t
+  BoundingBoxBatch<spacedim, Number>::size() const
+  {
+    return lower_bounds[0].size();
+  }
+
+  template <int spacedim, typename Number1, typename Number2>
+  inline void
+  intersects(const BoundingBox<spacedim, Number1>      &a,
+             const BoundingBoxBatch<spacedim, Number2> &bboxes,
+             std::vector<unsigned char>                &result)
+  {
+    const std::size_t n_bboxes = bboxes.size();
+    result.assign(n_bboxes, 1);
+    unsigned char *const hits = result.data();
+    // Compare in the precision of the stored boxes, rounding outwards so that
+    // we never miss an intersection
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        const Number2 *const lower_bounds = bboxes.lower_bounds[d].data();
+        const Number2 *const upper_bounds = bboxes.upper_bounds[d].data();
+
+        const Number2 lower = internal::round_down<Number2>(a.lower_bound(d));
+        const Number2 upper = internal::round_up<Number2>(a.upper_bound(d));
+        DEAL_II_OPENMP_SIMD_PRAGMA
+        for (std::size_t i = 0; i < n_bboxes; ++i)
+          hits[i] &= (lower <= upper_bounds[i]) & (lower_bounds[i] <= upper);
+      }
+  }
+
+  template <int spacedim, typename Number1, typename Number2>
+  inline bool
+  intersects_any(const BoundingBox<spacedim, Number1>      &a,
+                 const BoundingBoxBatch<spacedim, Number2> &bboxes)
+  {
+    std::array<Number2, spacedim> lower;
+    std::array<Number2, spacedim> upper;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        lower[d] = internal::round_down<Number2>(a.lower_bound(d));
+        upper[d] = internal::round_up<Number2>(a.upper_bound(d));
+      }
+    // Check all boxes (instead of returning early) so that the loop has no
+    // branches and may be vectorized
+    const std::size_t n_bboxes = bboxes.size();
+    bool              found    = false;
+    for (std::size_t i = 0; i < n_bboxes; ++i)
+      {
+        bool hit = true;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          hit &= (lower[d] <= bboxes.upper_bounds[d][i]) &
+                 (bboxes.lower_bounds[d][i] <= upper[d]);
+        found |= hit;
+      }
+    return found;
   }
 } // namespace fdl
 
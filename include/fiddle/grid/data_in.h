@@ -3,7 +3,14 @@
 
 #include <fiddle/base/config.h>
 
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <future>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 // forward declarations
 namespace dealii
@@ -14,10 +21,71 @@ namespace dealii
   class DoFHandler;
 } // namespace dealii
 
+namespace fdl
+{
+  namespace internal
+  {
+    struct NodePermutation;
+  }
+} // namespace fdl
+
 namespace fdl
 {
   using namespace dealii;
 
+  /**
+   * Data read from an ExodusII file by read_exodusii_mesh() in addition to
+   * the mesh itself.
+   */
+  template <int spacedim>
+  struct ExodusIIMeshData
+  {
+    /**
+     * Sideset ids corresponding to each boundary (or manifold) id - see
+     * GridIn::ExodusIIData.
+     */
+    std::vector<std::vector<int>> id_to_sideset_ids;
+
+    /**
+     * Node numbers and spatial coordinates of each requested nodeset, in the
+     * same format as the output of extract_nodeset().
+     */
+    std::vector<
+      std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>>
+      nodesets;
+  };
+
+  /**
+   * @brief Read a mesh, its sidesets, and some of its nodesets from an
+   * ExodusII file.
+   *
+   * This is equivalent to calling GridIn::read_exodusii() on every processor
+   * followed by calling extract_nodeset() once for each entry of
+   * @p nodeset_ids, but the file is only opened and read on the root
+   * processor of the Triangulation's communicator. The root processor then
+   * broadcasts the vertices, cells, and boundary and manifold ids as two flat
+   * arrays and every processor creates the coarse mesh from memory. Hence,
+   * unlike GridIn, the cost of loading a replicated mesh (e.g., in a
+   * parallel::shared::Triangulation) does not grow with the number of
+   * processors reading the same file. This call is collective.
+   *
+   * @param[in] tria Empty Triangulation.
+   *
+   * @param[in] nodeset_ids Ids of the nodesets to extract.
+   *
+   * @param[in] apply_all_indicators_to_manifolds Same as the argument of
+   * GridIn::read_exodusii().
+   *
+   * This function is only available if deal.II is configured with Trilinos
+   * with SEACAS.
+   */
+  template <int dim, int spacedim>
+  ExodusIIMeshData<spacedim>
+  read_exodusii_mesh(const std::string            &filename,
+                     Triangulation<dim, spacedim> &tria,
+                     const std::vector<int>       &nodeset_ids = {},
+                     const bool apply_all_indicators_to_manifolds = false);
+
   /**
    * @brief Read elemental data from an ExodusII file.
    *
@@ -26,6 +94,10 @@ namespace fdl
    * cells of the Triangulation provided as an argument. @p cell_vector can be
    * ghosted or unghosted.
    *
+   * To avoid having every processor read the same file, the file is only
+   * opened and read on the root processor of the Triangulation's communicator,
+   * which then broadcasts the values. Hence this function is collective.
+   *
    * This function is only available if deal.II is configured with Trilinos
    * with SEACAS.
    */
@@ -49,6 +121,18 @@ namespace fdl
    * DoFHandler provided as an argument. @p cell_vector can be ghosted or
    * unghosted.
    *
+   * Like read_elemental_data(), the file is only read on the root processor
+   * and this function is collective.
+   *
+   * @param[in] cache_filename If nonempty, the name of a binary file used to
+   * cache the values read from @p filename. If the file exists and was
+   * created for the same mesh, finite element, variables, and time step then
+   * the values are read from it (by mapping it into memory and only reading
+   * the entries of locally owned cells) instead of parsing the ExodusII file.
+   * Otherwise, the values are read from @p filename and the cache file is
+   * (re)written. The cached values are stored per cell, so the same file can
+   * be used with any number of processors.
+   *
    * This function is only available if deal.II is configured with Trilinos
    * with SEACAS.
    */
@@ -58,7 +142,203 @@ namespace fdl
                 const DoFHandler<dim, spacedim> &dof_handler,
                 const int                        time_step_n,
                 const std::vector<std::string>  &variable_names,
-                VectorType                      &dof_vector);
+                VectorType                      &dof_vector,
+                const std::string               &cache_filename = "");
+
+  /**
+   * @brief Read DoF data at several time steps from an ExodusII file.
+   *
+   * This is equivalent to calling the previous function once for each entry
+   * of @p time_step_ns but only opens the file once and only computes the
+   * relationship between ExodusII and deal.II node numbers once. See
+   * DoFDataReader.
+   */
+  template <int dim, int spacedim, typename VectorType>
+  void
+  read_dof_data(const std::string               &filename,
+                const DoFHandler<dim, spacedim> &dof_handler,
+                const std::vector<int>          &time_step_ns,
+                const std::vector<std::string>  &variable_names,
+                std::vector<VectorType>         &dof_vectors);
+
+  /**
+   * Class for reading DoF data from an ExodusII file at many time steps, e.g.,
+   * for loading a prescribed activation over a cardiac cycle during a
+   * simulation.
+   *
+   * Like read_dof_data(), the file is only opened and read on the root
+   * processor. This class keeps the file open and computes the permutation
+   * from ExodusII node numbers to deal.II node numbers once so that, after
+   * setup, reading a time step only requires reading the variables
+   * themselves. Additionally, prefetch() can be used to start reading a time
+   * step in the background (e.g., while the fluid is being solved) so that
+   * the next call to read() only needs to distribute the values.
+   *
+   * This class is only available if deal.II is configured with Trilinos with
+   * SEACAS.
+   */
+  template <int dim, int spacedim = dim>
+  class DoFDataReader
+  {
+  public:
+    /**
+     * Constructor. Opens the file. This call is collective.
+     *
+     * @param[in] variable_names Names of the variables corresponding to each
+     * component of the DoFHandler - see read_dof_data().
+     */
+    DoFDataReader(const std::string               &filename,
+                  const DoFHandler<dim, spacedim> &dof_handler,
+                  const std::vector<std::string>  &variable_names);
+
+    /**
+     * Destructor. Waits for any pending prefetch and closes the file.
+     */
+    ~DoFDataReader();
+
+    /**
+     * Start reading the given time step in the background. This call is not
+     * collective.
+     */
+    void
+    prefetch(const int time_step_n);
+
+    /**
+     * Read the given time step into @p dof_vector. If that time step was
+     * previously prefetched then the prefetched values are used. This call is
+     * collective.
+     */
+    template <typename VectorType>
+    void
+    read(const int time_step_n, VectorType &dof_vector);
+
+  protected:
+    /**
+     * Read the given time step on the root processor. Returns the array of
+     * DoF values on each cell and whether or not the cell centers matched.
+     */
+    std::pair<std::vector<double>, bool>
+    read_on_root(const int time_step_n);
+
+    /**
+     * Pointer to the DoFHandler.
+     */
+    SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
+
+    /**
+     * Variable names.
+     */
+    std::vector<std::string> variable_names;
+
+    /**
+     * Whether or not this processor is the one which reads the file.
+     */
+    bool is_root;
+
+    /**
+     * ExodusII file id (only valid on the root processor).
+     */
+    int ex_id;
+
+    /**
+     * Relationship between ExodusII and deal.II node numbers (only computed on
+     * the root processor).
+     */
+    std::unique_ptr<internal::NodePermutation> node_permutation;
+
+    /**
+     * Time step which is being prefetched, or -1 if there is no pending
+     * prefetch.
+     */
+    int prefetched_time_step_n;
+
+    /**
+     * Values being prefetched.
+     */
+    std::future<std::pair<std::vector<double>, bool>> prefetched_values;
+  };
+
+  /**
+   * Class for reading elemental data from an ExodusII file at many time steps.
+   * This is the equivalent of DoFDataReader for read_elemental_data(): the
+   * file is kept open on the root processor and prefetch() can be used to
+   * read a time step in the background.
+   *
+   * This class is only available if deal.II is configured with Trilinos with
+   * SEACAS.
+   */
+  template <int dim, int spacedim = dim>
+  class ElementalDataReader
+  {
+  public:
+    /**
+     * Constructor. Opens the file. This call is collective.
+     */
+    ElementalDataReader(const std::string                  &filename,
+                        const Triangulation<dim, spacedim> &tria,
+                        const std::string                  &variable_name);
+
+    /**
+     * Destructor. Waits for any pending prefetch and closes the file.
+     */
+    ~ElementalDataReader();
+
+    /**
+     * Start reading the given time step in the background. This call is not
+     * collective.
+     */
+    void
+    prefetch(const int time_step_n);
+
+    /**
+     * Read the given time step into @p cell_vector, which is indexed by active
+     * cell index - see read_elemental_data(). If that time step was previously
+     * prefetched then the prefetched values are used. This call is
+     * collective.
+     */
+    template <typename VectorType>
+    void
+    read(const int time_step_n, VectorType &cell_vector);
+
+  protected:
+    /**
+     * Read the given time step on the root processor. Returns the array of
+     * values on each cell and whether or not the cell centers matched.
+     */
+    std::pair<std::vector<double>, bool>
+    read_on_root(const int time_step_n);
+
+    /**
+     * Pointer to the Triangulation.
+     */
+    SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+    /**
+     * Variable name.
+     */
+    std::string variable_name;
+
+    /**
+     * Whether or not this processor is the one which reads the file.
+     */
+    bool is_root;
+
+    /**
+     * ExodusII file id (only valid on the root processor).
+     */
+    int ex_id;
+
+    /**
+     * Time step which is being prefetched, or -1 if there is no pending
+     * prefetch.
+     */
+    int prefetched_time_step_n;
+
+    /**
+     * Values being prefetched.
+     */
+    std::future<std::pair<std::vector<double>, bool>> prefetched_values;
+  };
 } // namespace fdl
 
 #endif
@@ -3,8 +3,10 @@
 
 #include <fiddle/base/config.h>
 
+#include <deal.II/base/bounding_box.h>
 #include <deal.II/base/point.h>
 
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -42,6 +44,23 @@ namespace fdl
                                const Mapping<dim, spacedim>       &mapping,
                                const Quadrature<1> &line_quadrature);
 
+  /**
+   * Compute, for each locally owned cell, the length of the cell in each
+   * reference coordinate direction (subject to the provided mapping): i.e.,
+   * the largest norm of the corresponding column of the Jacobian of the
+   * mapping over the points of @p quadrature. These lengths can be used to
+   * select anisotropic quadrature rules (see QGaussAnisotropicFamily) and
+   * each entry can be gathered onto every processor with
+   * collect_longest_edge_lengths().
+   *
+   * @note This function only supports quadrilaterals and hexahedra.
+   */
+  template <int dim, int spacedim = dim>
+  std::array<std::vector<float>, dim>
+  compute_reference_direction_lengths(const Triangulation<dim, spacedim> &tria,
+                                      const Mapping<dim, spacedim> &mapping,
+                                      const Quadrature<dim> &quadrature);
+
   /**
    * Collect the edge lengths per element onto each processor.
    */
@@ -51,6 +70,84 @@ namespace fdl
     const parallel::shared::Triangulation<dim, spacedim> &tria,
     const std::vector<float> &local_active_edge_lengths);
 
+  /**
+   * Compute, for each active cell of @p tria, the processor which owns the
+   * patches (typically computed from the patch hierarchy at the last regrid
+   * with compute_patch_bboxes()) which intersect the largest part of that
+   * cell's bounding box. Cells which do not intersect any patch keep their
+   * present owner. This call is collective.
+   *
+   * Assigning each cell to the owner of its patches (e.g., with
+   * repartition_triangulation()) makes most of the data movement between the
+   * native and overlap partitionings of the interaction classes local. Since
+   * this ignores the number of cells per processor, it is only useful when
+   * the Eulerian partitioning already accounts for the Lagrangian workload
+   * (see count_quadrature_points()).
+   *
+   * @param[in] global_active_cell_bboxes Bounding boxes of all active cells,
+   * in active cell index order (i.e., the output of
+   * collect_all_active_cell_bboxes()).
+   *
+   * @param[in] local_patch_bboxes Bounding boxes of the patches owned by the
+   * current processor.
+   *
+   * @return The new owner of each active cell, in active cell index order.
+   * The result is the same on every processor.
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<types::subdomain_id>
+  compute_patch_owners(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, float>> &global_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim>>        &local_patch_bboxes);
+
+  /**
+   * Compute, for each active cell of @p tria, a new owner such that the sums
+   * of @p cell_weights (in active cell index order, e.g., the output of
+   * Part::compute_cell_weights()) over the cells of each processor are
+   * approximately equal. This call is not collective but, since it only
+   * depends on its arguments, returns the same value on every processor.
+   *
+   * If deal.II was compiled with METIS then the cells are partitioned like
+   * parallel::shared::Triangulation's default partitioner does, i.e., by
+   * partitioning the graph of cells which share a face with METIS, but with
+   * weighted vertices. Otherwise each processor is assigned a contiguous
+   * range of cells in active cell index order.
+   *
+   * @param[in] cell_weights Positive weights of the cells.
+   *
+   * @return The new owner of each active cell, which may be passed to
+   * repartition_triangulation().
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<types::subdomain_id>
+  compute_weighted_owners(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<unsigned int>                      &cell_weights);
+
+  /**
+   * Change the owners of the active cells of @p tria to @p new_owners (in
+   * active cell index order, e.g., the output of compute_patch_owners()).
+   * This call is collective.
+   *
+   * This is implemented by doing a refinement cycle with no refinement or
+   * coarsening flags set, during which the new subdomain ids are assigned.
+   * Hence @p tria must use
+   * parallel::shared::Triangulation::Settings::partition_custom_signal and
+   * should not have any other function connected to
+   * <code>signals.post_refinement</code> which sets subdomain ids.
+   *
+   * Afterwards the DoFs of every DoFHandler on @p tria need to be distributed
+   * again. Since the cells themselves do not change, the old DoF numbering
+   * remains available until then: e.g., Part::reinit_dofs() uses it to
+   * transfer the position and velocity to the new partitioning.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  repartition_triangulation(
+    parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<types::subdomain_id>         &new_owners);
+
   /**
    * Extract a nodeset from an ExodusII file.
    *
@@ -58,6 +155,10 @@ namespace fdl
    *
    * @note If the mesh has duplicated or unused nodes then the node numbers may
    * no longer be meaningful.
+   *
+   * @note This function opens the file every time it is called and should
+   * only be called on one processor. read_exodusii_mesh() reads the mesh and
+   * any number of nodesets at once on the root processor instead.
    */
   template <int spacedim>
   std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>
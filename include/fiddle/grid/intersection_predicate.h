@@ -3,10 +3,14 @@
 
 #include <fiddle/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/bounding_box.h>
 
+#include <deal.II/grid/cell_id.h>
 #include <deal.II/grid/tria.h>
 
+#include <deal.II/numerics/rtree.h>
+
 #include <vector>
 
 namespace fdl
@@ -52,6 +56,12 @@ namespace fdl
       const override;
 
     const std::vector<BoundingBox<spacedim>> patch_boxes;
+
+    /**
+     * Tree of patch_boxes, so that checking a cell does not require looping
+     * over every patch.
+     */
+    const RTree<BoundingBox<spacedim>> patch_rtree;
   };
 
   /**
@@ -62,13 +72,20 @@ namespace fdl
    * present on all processors. This is useful for creating an
    * OverlapTriangulation on each processor with bounding boxes intersecting an
    * arbitrary part of the Triangulation.
+   *
+   * Since every cell of a parallel::shared::Triangulation is available on
+   * every processor, the constructor computes the result for every cell (from
+   * the finest level to the coarsest, so that each coarse cell's result is
+   * computed from those of its children) and operator() just looks it up.
+   * Hence the bounding boxes of the active cells are only needed by the
+   * constructor and are not copied.
    */
   template <int dim, int spacedim = dim>
   class BoxIntersectionPredicate : public IntersectionPredicate<dim, spacedim>
   {
   public:
     BoxIntersectionPredicate(
-      const std::vector<BoundingBox<spacedim, float>>      &a_cell_bboxes,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
       const std::vector<BoundingBox<spacedim>>             &p_bboxes,
       const parallel::shared::Triangulation<dim, spacedim> &tria);
 
@@ -77,8 +94,80 @@ namespace fdl
       const override;
 
     const SmartPointer<const Triangulation<dim, spacedim>> tria;
-    const std::vector<BoundingBox<spacedim, float>>        active_cell_bboxes;
     const std::vector<BoundingBox<spacedim>>               patch_bboxes;
+
+    /**
+     * Tree of patch_bboxes, so that checking a cell does not require looping
+     * over every patch (e.g., when the secondary hierarchy is partitioned
+     * into many small patches).
+     */
+    const RTree<BoundingBox<spacedim>> patch_rtree;
+
+  protected:
+    /**
+     * Whether or not each cell intersects a patch, indexed by level and then
+     * by cell index.
+     */
+    std::vector<std::vector<bool>> intersecting_cells;
+  };
+
+  /**
+   * Intersection predicate based on a list of active cells which are already
+   * known to intersect something, e.g., the output of
+   * exchange_intersecting_active_cell_bboxes(). Unlike
+   * BoxIntersectionPredicate this class does not require a bounding box for
+   * every active cell in the Triangulation.
+   */
+  template <int dim, int spacedim = dim>
+  class CellIdIntersectionPredicate
+    : public IntersectionPredicate<dim, spacedim>
+  {
+  public:
+    CellIdIntersectionPredicate(const std::vector<CellId>          &cell_ids,
+                                const Triangulation<dim, spacedim> &tria);
+
+    virtual bool
+    operator()(const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+      const override;
+
+    const SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+    /**
+     * Sorted CellIds of the intersecting active cells.
+     */
+    std::vector<CellId> active_cell_ids;
+  };
+
+  /**
+   * Intersection predicate which restricts another predicate to a subset of
+   * the active cells: i.e., an active cell intersects if it is selected and
+   * also satisfies the other predicate, and any other cell intersects if one
+   * of its descendants does.
+   *
+   * The original predicate is not copied, so it must outlive this object.
+   */
+  template <int dim, int spacedim = dim>
+  class SubsetIntersectionPredicate
+    : public IntersectionPredicate<dim, spacedim>
+  {
+  public:
+    SubsetIntersectionPredicate(
+      const IntersectionPredicate<dim, spacedim> &predicate,
+      const std::vector<bool>                    &selected_active_cells,
+      const Triangulation<dim, spacedim>         &tria);
+
+    virtual bool
+    operator()(const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+      const override;
+
+    const IntersectionPredicate<dim, spacedim> *const      predicate;
+    const SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+    /**
+     * Whether or not each active cell, indexed by active cell index, is
+     * selected.
+     */
+    const std::vector<bool> selected_active_cells;
   };
 } // namespace fdl
 
@@ -58,11 +58,30 @@ namespace fdl
      * The hier::Patch objects in @p patches may come from multiple patch
      * levels. If a node is present on multiple levels then it will be assigned
      * to the finest one.
+     *
+     * If @p pack_nodes is true then this class also stores the list of nodes
+     * of each patch, which enables pack() and unpack(). If the DoF numbering
+     * is not spatially coherent then the IndexSet of a patch may consist of
+     * many small intervals: with packing, kernels can copy all the data of a
+     * patch into contiguous buffers and then do a single interaction call
+     * per patch instead of one per interval.
+     *
+     * If @p owner_bboxes is not empty then it contains, for each patch,
+     * bounding boxes which are disjoint from those of every other patch on
+     * every processor (e.g., the boxes computed by
+     * compute_nonoverlapping_patch_boxes() without any ghost region). In that
+     * case each node is also assigned to the patch (if any) owning it, i.e.,
+     * the patch with an owner box containing the node. Since boxes share
+     * faces they are treated as half-open. Hence each node is owned by at
+     * most one patch on one processor, which permits interpolating each node
+     * exactly once (see get_owned_dofs()).
      */
     NodalPatchMap(
       const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
       const std::vector<std::vector<BoundingBox<spacedim>>>   &patch_bboxes,
-      const Vector<double> &nodal_coordinates);
+      const Vector<double> &nodal_coordinates,
+      const bool            pack_nodes = false,
+      const std::vector<std::vector<BoundingBox<spacedim>>> &owner_bboxes = {});
 
     /**
      * Same as the constructor.
@@ -70,7 +89,10 @@ namespace fdl
     void
     reinit(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
            const std::vector<std::vector<BoundingBox<spacedim>>> &patch_bboxes,
-           const Vector<double> &nodal_coordinates);
+           const Vector<double> &nodal_coordinates,
+           const bool            pack_nodes = false,
+           const std::vector<std::vector<BoundingBox<spacedim>>> &owner_bboxes =
+             {});
 
     /**
      * Return the number of patches.
@@ -91,6 +113,66 @@ namespace fdl
     std::pair<const IndexSet &, const tbox::Pointer<hier::Patch<spacedim>>>
     operator[](const std::size_t i) const;
 
+    /**
+     * Return whether or not this object was set up with packing enabled.
+     */
+    bool
+    packs_nodes() const;
+
+    /**
+     * Return whether or not this object was set up with owner boxes.
+     */
+    bool
+    has_owners() const;
+
+    /**
+     * Return an IndexSet containing the DoFs of the nodes owned by patch
+     * @p i. This is a subset of the DoFs returned by operator[]().
+     */
+    const IndexSet &
+    get_owned_dofs(const std::size_t i) const;
+
+    /**
+     * Return the number of nodes (on this processor) which are owned by a
+     * patch but which, with the coordinates @p nodal_coordinates, are no
+     * longer inside that patch or its first layer of ghost cells. This
+     * happens when nodes move more than one cell between regrids. Values at
+     * such nodes cannot be interpolated by their owning patch.
+     */
+    std::size_t
+    count_nodes_outside_owners(const Vector<double> &nodal_coordinates) const;
+
+    /**
+     * Copy the values of @p values at the nodes of patch @p patch_n into
+     * @p buffer, which is resized to the correct length. Here @p values may
+     * have any number of components per node (e.g., positions and
+     * interpolated or spread values), with the same layout as the nodal
+     * coordinates vector. If @p owned_nodes_only is true then only the nodes
+     * owned by the patch are copied.
+     */
+    void
+    pack(const std::size_t     patch_n,
+         const Vector<double> &values,
+         std::vector<double>  &buffer,
+         const bool            owned_nodes_only = false) const;
+
+    /**
+     * Reverse of pack(): copy the entries of @p buffer into the values of
+     * @p values at the nodes of patch @p patch_n.
+     */
+    void
+    unpack(const std::size_t          patch_n,
+           const std::vector<double> &buffer,
+           Vector<double>            &values,
+           const bool                 owned_nodes_only = false) const;
+
+    /**
+     * Return an estimate of the number of bytes used by this object. The
+     * patches themselves are owned by SAMRAI and are not included.
+     */
+    std::size_t
+    memory_consumption() const;
+
   protected:
     // Patches.
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
@@ -98,6 +180,21 @@ namespace fdl
     // For each patch, store the DoF indices which intersect (including the
     // extra ghost cell fraction) that patch.
     std::vector<IndexSet> patch_dof_indices;
+
+    // Total number of nodes.
+    std::size_t n_nodes = 0;
+
+    // For each patch, the nodes (i.e., DoF indices divided by spacedim) in
+    // that patch. Only set up if packing is enabled.
+    std::vector<std::vector<types::global_dof_index>> patch_nodes;
+
+    // For each patch, the DoF indices of the nodes owned by that patch. Only
+    // set up if owner boxes are provided.
+    std::vector<IndexSet> patch_owned_dof_indices;
+
+    // For each patch, the nodes owned by that patch. Only set up if both
+    // packing is enabled and owner boxes are provided.
+    std::vector<std::vector<types::global_dof_index>> patch_owned_nodes;
   };
 
 
@@ -126,6 +223,30 @@ namespace fdl
     AssertIndexRange(i, size());
     return {patch_dof_indices[i], patches[i]};
   }
+
+  template <int dim, int spacedim>
+  inline bool
+  NodalPatchMap<dim, spacedim>::packs_nodes() const
+  {
+    return patch_nodes.size() == patches.size() && patches.size() > 0;
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  NodalPatchMap<dim, spacedim>::has_owners() const
+  {
+    return patch_owned_dof_indices.size() == patches.size() &&
+           patches.size() > 0;
+  }
+
+  template <int dim, int spacedim>
+  inline const IndexSet &
+  NodalPatchMap<dim, spacedim>::get_owned_dofs(const std::size_t i) const
+  {
+    Assert(has_owners(), ExcMessage("Owner boxes were not provided."));
+    AssertIndexRange(i, size());
+    return patch_owned_dof_indices[i];
+  }
 } // namespace fdl
 
 #endif
@@ -13,6 +13,8 @@
 
 #include <deal.II/grid/tria.h>
 
+#include <boost/signals2/connection.hpp>
+
 #include <vector>
 
 namespace fdl
@@ -49,10 +51,41 @@ namespace fdl
     virtual types::subdomain_id
     locally_owned_subdomain() const;
 
-    void
+    /**
+     * Set up the overlap triangulation from the cells of @p shared_tria
+     * satisfying @p predicate. This is equivalent to calling select_cells()
+     * and then, if necessary, rebuild().
+     *
+     * @return Whether or not the triangulation was rebuilt.
+     */
+    bool
     reinit(const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
            const IntersectionPredicate<dim, spacedim>           &predicate);
 
+    /**
+     * Determine which cells of @p shared_tria satisfy @p predicate without
+     * setting up the triangulation.
+     *
+     * @return Whether or not the triangulation needs to be rebuilt, i.e.,
+     * whether the selected cells or @p shared_tria itself changed since the
+     * triangulation was last built. If so, rebuild() must be called before
+     * this object is used again. Otherwise, objects which depend on the
+     * current triangulation (like DoFHandlers) remain valid, so they do not
+     * need to be set up again. Triangulation::clear() requires that there are
+     * no such objects, so they should be destroyed before calling rebuild().
+     */
+    bool
+    select_cells(
+      const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
+      const IntersectionPredicate<dim, spacedim>           &predicate);
+
+    /**
+     * Rebuild the triangulation. @p predicate should be the same predicate
+     * most recently given to select_cells().
+     */
+    void
+    rebuild(const IntersectionPredicate<dim, spacedim> &predicate);
+
     const parallel::shared::Triangulation<dim, spacedim> &
     get_native_triangulation() const;
 
@@ -115,6 +148,29 @@ namespace fdl
      * corresponding native cell. Useful for doing data transfer.
      */
     std::vector<active_cell_iterator> cell_iterators_in_active_native_order;
+
+    /**
+     * Whether or not each active cell of native_tria was selected by the last
+     * call to select_cells(), indexed by active cell index.
+     */
+    std::vector<bool> selected_native_active_cells;
+
+    /**
+     * Whether or not the triangulation needs to be rebuilt.
+     */
+    bool needs_rebuild = true;
+
+    /**
+     * Whether or not native_tria changed since the triangulation was last
+     * built.
+     */
+    bool native_tria_changed = true;
+
+    /**
+     * Connection to native_tria's any_change signal, which sets
+     * native_tria_changed.
+     */
+    boost::signals2::scoped_connection native_tria_connection;
   };
 
 
@@ -5,13 +5,18 @@
 
 #include <fiddle/base/exceptions.h>
 
+#include <deal.II/base/array_view.h>
+
 #include <deal.II/dofs/dof_handler.h>
 
 FDL_DISABLE_EXTRA_DIAGNOSTICS
 #include <Patch.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <cstdint>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 namespace fdl
 {
@@ -22,6 +27,25 @@ namespace fdl
    * Mapping between patches and elements. Assumes that the Triangulation
    * associated with the position DoFHandler already intersects the patches in
    * some meaningful way.
+   *
+   * The cells of each patch are stored in a flat array so that iterating over
+   * them does not require searching. By default the cells are stored in the
+   * order of the Triangulation (i.e., by level and then by index). They may
+   * optionally be sorted by the Morton (Z-order) key of the centers of their
+   * bounding boxes instead: since spatially nearby cells then interact with
+   * nearby parts of the patch, this improves the cache behavior of
+   * interpolation and spreading at the cost of changing the order in which
+   * values are accumulated (i.e., results may differ by roundoff).
+   *
+   * When the structure moves but neither the patches nor the Triangulation
+   * change (i.e., between regrids) the mapping can be updated in place with
+   * update(), which only searches for new patches for cells which moved a
+   * significant distance.
+   *
+   * Since the DoFs of a DoFHandler on the Triangulation also do not change
+   * between regrids, this class can also store the DoF indices of each cell
+   * (see cache_dof_indices()) so that the interaction functions do not need
+   * to look them up through cell iterators on every call.
    */
   template <int dim, int spacedim = dim>
   class PatchMap
@@ -39,7 +63,8 @@ namespace fdl
     PatchMap(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
              const double                        extra_ghost_cell_fraction,
              const Triangulation<dim, spacedim> &tria,
-             const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes);
+             const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+             const bool sort_cells = false);
 
     /**
      * Same as the constructor.
@@ -49,7 +74,30 @@ namespace fdl
     reinit(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
            const double                        extra_ghost_cell_fraction,
            const Triangulation<dim, spacedim> &tria,
-           const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes);
+           const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+           const bool sort_cells = false);
+
+    /**
+     * Update the mapping with new bounding boxes of the cells (e.g., after
+     * the structure moves). This is equivalent to calling reinit() with the
+     * same patches, Triangulation, and ghost cell fraction but is
+     * considerably cheaper when most cells do not move far: each cell only
+     * searches for new patches once it leaves a box around the bounding box
+     * it had the last time it searched, and only the cell lists of patches
+     * which gained or lost cells are recomputed.
+     *
+     * If the cells are sorted then the keys computed by the last call to
+     * reinit() are reused, so cells may become less well-ordered as the
+     * structure deforms.
+     *
+     * @note This function may only be used if neither the patches nor the
+     * Triangulation changed since the last call to reinit().
+     *
+     * @return The number of cells whose set of patches changed.
+     */
+    template <typename Number>
+    std::size_t
+    update(const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes);
 
     /**
      * Return the number of patches.
@@ -126,15 +174,13 @@ namespace fdl
 
     protected:
       // only let a PatchMap construct these iterators directly
-      iterator(const std::ptrdiff_t             index,
-               const DoFHandler<dim, spacedim> &dof_handler,
-               const std::vector<IndexSet>     &patch_level_cells,
-               const std::vector<std::size_t>  &patch_cummulative_n_cells);
+      iterator(const std::ptrdiff_t                    index,
+               const DoFHandler<dim, spacedim>        &dof_handler,
+               const std::vector<std::pair<int, int>> &patch_cells);
 
       const DoFHandler<dim, spacedim> *dh;
 
-      const std::vector<IndexSet>    *level_cells;
-      const std::vector<std::size_t> *cummulative_n_cells;
+      const std::vector<std::pair<int, int>> *cells;
 
       std::ptrdiff_t index;
 
@@ -161,19 +207,98 @@ namespace fdl
     iterator
     end(const std::size_t patch_n, const DoFHandler<dim, spacedim> &dh) const;
 
+    /**
+     * Return the number of cells stored for patch @p patch_n.
+     */
+    std::size_t
+    n_cells(const std::size_t patch_n) const;
+
+    /**
+     * Return the <code>i</code>th cell (in iteration order) of patch
+     * @p patch_n as a Triangulation iterator. This is useful when no
+     * DoFHandler is needed, e.g., when only the quadrature points of each
+     * cell are computed.
+     */
+    typename Triangulation<dim, spacedim>::active_cell_iterator
+    get_cell(const std::size_t patch_n, const std::size_t i) const;
+
+    /**
+     * Store the DoF indices of every active cell of @p dof_handler, which
+     * must use the stored Triangulation. The table is cleared by reinit() but
+     * not by update().
+     */
+    void
+    cache_dof_indices(const DoFHandler<dim, spacedim> &dof_handler);
+
+    /**
+     * Return the DoF indices of all active cells of @p dof_handler stored by
+     * cache_dof_indices(), or an empty array if they are not stored. The
+     * indices of the cell with active cell index <code>i</code> are the
+     * <code>dofs_per_cell</code> entries starting at
+     * <code>i * dofs_per_cell</code>. Entries of artificial cells are
+     * numbers::invalid_dof_index.
+     */
+    ArrayView<const types::global_dof_index>
+    get_dof_index_table(const DoFHandler<dim, spacedim> &dof_handler) const;
+
+    /**
+     * Return an estimate of the number of bytes used by this object. The
+     * patches themselves are owned by SAMRAI and are not included.
+     */
+    std::size_t
+    memory_consumption() const;
+
   protected:
     SmartPointer<const Triangulation<dim, spacedim>> tria;
 
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
 
-    // Compressed representation of cells, indexed by patch and then level
-    // number. The entries in the IndexSet are the cell indices.
-    std::vector<std::vector<IndexSet>> patch_level_cells;
+    double extra_ghost_cell_fraction = 0.0;
+
+    // Cells of each patch, stored as (level, index) pairs in iteration order.
+    std::vector<std::vector<std::pair<int, int>>> patch_cells;
 
-    // Cumulative number of cells on each level: e.g., the first entry is the
-    // number of cells on level 0, the second is the sum of level 0 and 1, etc.
-    // The last entry is the total number of cells. Used by the iterators.
-    std::vector<std::vector<std::size_t>> cummulative_n_cells;
+    // Active cell indices of the cells of each patch.
+    std::vector<std::vector<unsigned int>> patch_active_cells;
+
+    // (level, index) pairs of each active cell.
+    std::vector<std::pair<int, int>> active_cell_levels_and_indices;
+
+    // Whether or not each active cell is artificial, in which case it never
+    // intersects any patch.
+    std::vector<bool> artificial_cells;
+
+    // Sort keys of each active cell.
+    std::vector<std::uint64_t> cell_keys;
+
+    // Patches each active cell currently intersects.
+    std::vector<std::vector<unsigned int>> cell_patches;
+
+    // Boxes each active cell may move around in without searching for new
+    // patches and the patches intersecting those boxes.
+    std::vector<BoundingBox<spacedim>>     reference_cell_bboxes;
+    std::vector<std::vector<unsigned int>> reference_cell_patches;
+
+    // DoF indices of each active cell, indexed by DoFHandler.
+    std::vector<std::pair<const DoFHandler<dim, spacedim> *,
+                          std::vector<types::global_dof_index>>>
+      dof_index_tables;
+
+    /**
+     * Set up the reference box of a cell and find the patches intersecting it.
+     */
+    template <typename Number, typename RTree>
+    void
+    find_reference_patches(const unsigned int active_cell_index,
+                           const BoundingBox<spacedim, Number> &cell_bbox,
+                           const RTree                         &rtree);
+
+    /**
+     * Sort the cells of a patch and set up the corresponding entry of
+     * patch_cells.
+     */
+    void
+    setup_patch_cells(const std::size_t patch_n);
   };
 
 
@@ -200,13 +325,11 @@ namespace fdl
 
   template <int dim, int spacedim>
   PatchMap<dim, spacedim>::iterator::iterator(
-    const std::ptrdiff_t             index,
-    const DoFHandler<dim, spacedim> &dof_handler,
-    const std::vector<IndexSet>     &patch_level_cells,
-    const std::vector<std::size_t>  &patch_cummulative_n_cells)
+    const std::ptrdiff_t                    index,
+    const DoFHandler<dim, spacedim>        &dof_handler,
+    const std::vector<std::pair<int, int>> &patch_cells)
     : dh(&dof_handler)
-    , level_cells(&patch_level_cells)
-    , cummulative_n_cells(&patch_cummulative_n_cells)
+    , cells(&patch_cells)
     , index(index)
   {}
 
@@ -240,10 +363,7 @@ namespace fdl
     AssertIndexRange(patch_n, size());
     Assert(&dh.get_triangulation() == &*tria,
            ExcMessage("must use same Triangulation"));
-    return iterator(0,
-                    dh,
-                    patch_level_cells[patch_n],
-                    cummulative_n_cells[patch_n]);
+    return iterator(0, dh, patch_cells[patch_n]);
   }
 
 
@@ -256,10 +376,30 @@ namespace fdl
     AssertIndexRange(patch_n, size());
     Assert(&dh.get_triangulation() == &*tria,
            ExcMessage("must use same Triangulation"));
-    return iterator(cummulative_n_cells[patch_n].back(),
-                    dh,
-                    patch_level_cells[patch_n],
-                    cummulative_n_cells[patch_n]);
+    return iterator(patch_cells[patch_n].size(), dh, patch_cells[patch_n]);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  PatchMap<dim, spacedim>::n_cells(const std::size_t patch_n) const
+  {
+    AssertIndexRange(patch_n, size());
+    return patch_cells[patch_n].size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  typename Triangulation<dim, spacedim>::active_cell_iterator
+  PatchMap<dim, spacedim>::get_cell(const std::size_t patch_n,
+                                    const std::size_t i) const
+  {
+    AssertIndexRange(i, n_cells(patch_n));
+    const std::pair<int, int> &cell = patch_cells[patch_n][i];
+    return typename Triangulation<dim, spacedim>::active_cell_iterator(
+      &*tria, cell.first, cell.second);
   }
 
 
@@ -269,20 +409,15 @@ namespace fdl
   PatchMap<dim, spacedim>::iterator::operator*() const
   {
     Assert(0 <= index, ExcMessage("invalid iterator"));
-    const auto it = std::upper_bound(cummulative_n_cells->begin(),
-                                     cummulative_n_cells->end(),
-                                     index);
-    if (it == cummulative_n_cells->end())
+    if (index >= std::ptrdiff_t(cells->size()))
       {
-        Assert(index <= std::ptrdiff_t(cummulative_n_cells->back()),
+        Assert(index == std::ptrdiff_t(cells->size()),
                ExcMessage("invalid iterator"));
         return dh->end();
       }
-    const unsigned int cell_level = it - cummulative_n_cells->begin();
-    const unsigned int cell_index = (*level_cells)[cell_level].nth_index_in_set(
-      index - (cell_level == 0 ? 0 : (*cummulative_n_cells)[cell_level - 1]));
+    const std::pair<int, int> &cell = (*cells)[index];
     return typename DoFHandler<dim, spacedim>::active_cell_iterator(
-      &dh->get_triangulation(), cell_level, cell_index, dh);
+      &dh->get_triangulation(), cell.first, cell.second, dh);
   }
 
 
@@ -372,7 +507,7 @@ namespace fdl
   typename PatchMap<dim, spacedim>::iterator::difference_type
   PatchMap<dim, spacedim>::iterator::operator-(const iterator &other) const
   {
-    Assert(other.dh == this->dh && other.level_cells == this->level_cells,
+    Assert(other.dh == this->dh && other.cells == this->cells,
            ExcMessage(
              "only iterators pointing to the same container can be compared."));
     return index - other.index;
@@ -384,7 +519,7 @@ namespace fdl
   bool
   PatchMap<dim, spacedim>::iterator::operator<(const iterator &other) const
   {
-    Assert(other.dh == this->dh && other.level_cells == this->level_cells,
+    Assert(other.dh == this->dh && other.cells == this->cells,
            ExcMessage(
              "only iterators pointing to the same container can be compared."));
     return this->index < other.index;
@@ -396,7 +531,7 @@ namespace fdl
   bool
   PatchMap<dim, spacedim>::iterator::operator==(const iterator &other) const
   {
-    Assert(other.dh == this->dh && other.level_cells == this->level_cells,
+    Assert(other.dh == this->dh && other.cells == this->cells,
            ExcMessage(
              "only iterators pointing to the same container can be compared."));
     return this->index == other.index;
@@ -408,7 +543,7 @@ namespace fdl
   bool
   PatchMap<dim, spacedim>::iterator::operator!=(const iterator &other) const
   {
-    Assert(other.dh == this->dh && other.level_cells == this->level_cells,
+    Assert(other.dh == this->dh && other.cells == this->cells,
            ExcMessage(
              "only iterators pointing to the same container can be compared."));
     return this->index != other.index;
@@ -32,6 +32,21 @@ namespace fdl
       const double                                time,
       LinearAlgebra::distributed::Vector<double> &position) const = 0;
 
+    /**
+     * Return a pointer to a vector containing the position of the structure
+     * (from the point of view of the mechanics solver) at the specified time
+     * if such a vector is already stored by the present object (e.g., the
+     * mechanics solver's own solution vector when @p time is the time at
+     * which it was computed), and nullptr otherwise. The vector must have
+     * up-to-date ghost values.
+     *
+     * This permits DLMForce to use the position without copying it. The
+     * default implementation returns nullptr, in which case DLMForce calls
+     * get_mechanics_position() instead.
+     */
+    virtual const LinearAlgebra::distributed::Vector<double> *
+    get_mechanics_position_view(const double time) const;
+
     /**
      * Get a reference to the current position (from the point of view of the
      * mechanics solver), whereever it may be. Useful for initializing other
@@ -43,6 +58,19 @@ namespace fdl
 
   /**
    * Force contribution based on a DLMMethod.
+   *
+   * Since the penalty force is linear in the positions, setup_force() computes
+   * the nodal values of the force, i.e., k (X_ref - X), in a single fused loop
+   * over the locally owned and ghost entries of the position vector, and
+   * compute_volume_force() then only needs to interpolate those values. This
+   * requires that the mechanics position and the position of the Part use
+   * compatible vector partitioners (which is the case if they are set up with
+   * the same DoFHandler): otherwise this class falls back to the
+   * implementation provided by SpringForce.
+   *
+   * If the mechanics position is available via
+   * DLMMethodBase::get_mechanics_position_view() then it is used without
+   * being copied.
    */
   template <int dim, int spacedim = dim>
   class DLMForce : public SpringForce<dim, spacedim>
@@ -64,8 +92,42 @@ namespace fdl
       const LinearAlgebra::distributed::Vector<double> &position,
       const LinearAlgebra::distributed::Vector<double> &velocity) override;
 
+    virtual void
+    finish_force(const double time) override;
+
+    virtual void
+    compute_volume_force(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<1, spacedim>> &forces) const override;
+
+    /**
+     * Return the nodal values of the penalty force, i.e., k (X_ref - X),
+     * computed by the last call to setup_force(), or nullptr if they could not
+     * be computed (see the class documentation).
+     *
+     * If the mechanics and Part meshes are identical then these are the values
+     * of the force projected onto the finite element space with a lumped mass
+     * matrix, so they may be used directly (i.e., as nodal coupling) instead
+     * of assembling a load vector and solving a mass matrix system.
+     */
+    const LinearAlgebra::distributed::Vector<double> *
+    get_nodal_force() const;
+
   protected:
     SmartPointer<DLMMethodBase<dim, spacedim>> dlm;
+
+    /**
+     * Whether or not nodal_force is up to date.
+     */
+    bool has_nodal_force;
+
+    /**
+     * Nodal values of the penalty force. Uses the same partitioner as the
+     * current position.
+     */
+    LinearAlgebra::distributed::Vector<double> nodal_force;
   };
 } // namespace fdl
 
@@ -8,10 +8,14 @@
 #include <fiddle/grid/patch_map.h>
 
 #include <fiddle/interaction/interaction_base.h>
+#include <fiddle/interaction/interaction_utilities.h>
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/quadrature.h>
 
+#include <boost/signals2/connection.hpp>
+
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -51,6 +55,102 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  /**
+   * Interaction implementation which uses quadrature rules on each element.
+   *
+   * <h2>Options read from the input database</h2>
+   * <ul>
+   *   <li>ghost_cell_fraction: fraction of the ghost region of each patch
+   *     which should be considered when associating elements to patches.
+   *     Defaults to 1.0.</li>
+   *   <li>sort_patch_cells: whether or not to visit the elements of each patch
+   *     in the Morton order of their bounding boxes (instead of the order of
+   *     the Triangulation) to improve locality. Results may differ by
+   *     roundoff. Defaults to FALSE. See PatchMap for more information.</li>
+   *   <li>sort_spread_points: whether or not to sort the quadrature points of
+   *     each patch by the Eulerian cell containing them before spreading to
+   *     improve the locality of the writes into the patch data. Results may
+   *     differ by roundoff. Defaults to FALSE. See compute_spread() for more
+   *     information.</li>
+   *   <li>spread_cutoff: if positive, quadrature points at which the
+   *     magnitude of the spread force density times JxW is less than this
+   *     value times the largest such value on the current processor are not
+   *     spread. The number and magnitude of the skipped points are recorded
+   *     (see get_spread_cutoff_statistics()). Must be in [0, 1). Defaults to
+   *     0.0 (spread at every point). See compute_spread() for more
+   *     information.</li>
+   *   <li>use_interaction_plan: whether or not to precompute quadrature point
+   *     locations for each patch (see InteractionPlan) and reuse them in
+   *     subsequent interpolation and spreading operations. Defaults to
+   *     TRUE.</li>
+   *   <li>interaction_plan_tolerance: the largest change in any entry of the
+   *     position vector for which a previously computed plan is reused. The
+   *     default value of 0.0 reuses a plan only when the position is unchanged,
+   *     so the results are identical to not using a plan.</li>
+   *   <li>interaction_plan_compression: if positive, the relative width of
+   *     the regions of each Eulerian cell whose quadrature points are merged
+   *     into one point by compress_interaction_plan(). Useful when the
+   *     elements are much smaller than the Eulerian cells. Only has an effect
+   *     if use_interaction_plan is TRUE. Results differ by an amount
+   *     proportional to this value. Defaults to 0.0 (no compression).</li>
+   *   <li>n_spread_threads: number of threads used to spread into patches
+   *     owned by the current processor. The results do not depend on this
+   *     value. Has no effect unless fiddle is compiled with OpenMP. Defaults to
+   *     1.</li>
+   *   <li>n_interpolation_threads: number of threads used to interpolate from
+   *     patches owned by the current processor when use_interaction_plan is
+   *     FALSE (see compute_projection_rhs()). The results do not depend on
+   *     this value. Has no effect unless fiddle is compiled with OpenMP.
+   *     Defaults to 1.</li>
+   *   <li>n_cached_interaction_plans: number of interaction plans (i.e.,
+   *     plans for different positions) to keep. Time integrators typically
+   *     interact at several positions in each time step (e.g., the current,
+   *     half, and new positions) and the last of those is usually the first
+   *     one used in the next time step, so keeping more than one plan avoids
+   *     recomputing quadrature point locations for it. Defaults to 1.</li>
+   *   <li>store_plan_weights: whether or not the interaction plan should also
+   *     store the JxW values of the interacting fields' mapping (which, in
+   *     IFEDMethod, is the mapping of the reference configuration and
+   *     therefore does not change between time steps) so that interpolation
+   *     and spreading evaluate shape functions from a table computed once on
+   *     the reference cell instead of reinitializing FEValues on every
+   *     element. This is mostly useful for codimension-one parts, whose
+   *     elements are small and numerous. Only has an effect if
+   *     use_interaction_plan is TRUE. Results may differ by roundoff.
+   *     Defaults to FALSE.</li>
+   *   <li>quadrature_hysteresis: relative change in the length of an element
+   *     (see compute_longest_edge_lengths()) below which the quadrature rule
+   *     chosen for that element at a previous reinitialization is reused.
+   *     This keeps elements whose lengths are near the boundary between two
+   *     rules from alternating between them at each regrid. The default value
+   *     of 0.0 only reuses rules of elements whose lengths did not change, so
+   *     the results are identical to always computing the rules.</li>
+   *   <li>anisotropic_quadrature: whether or not to choose the number of
+   *     quadrature points in each reference coordinate direction of each
+   *     element independently (see QGaussAnisotropicFamily) from the lengths
+   *     provided to set_reference_direction_lengths() instead of using the
+   *     same number in every direction. This reduces the number of points on
+   *     stretched elements. Only supported for quadrilaterals and hexahedra.
+   *     quadrature_hysteresis has no effect when this is enabled. Defaults to
+   *     FALSE.</li>
+   *   <li>spread_weak_force: whether or not to spread the force computed by
+   *     IFEDMethod in its weak form, i.e., to convert the load vector (the
+   *     integrals of the stresses and body forces against each basis function)
+   *     into a nodal force with the lumped mass matrix instead of solving the
+   *     consistent mass system. This is the same as IFEDMethod's
+   *     mass_matrix_type = LUMPED but only for the current part and removes one
+   *     CG solve per part per force evaluation. Defaults to FALSE.</li>
+   *   <li>use_interaction_operator: whether or not to assemble the
+   *     interpolation operator (see InteractionOperator) of each field and
+   *     data index and then project and spread by multiplying with it (or its
+   *     transpose). This is useful for parts which barely move between
+   *     regrids. Requires use_interaction_plan to be TRUE. Multi-field
+   *     transactions do not use operators. Defaults to FALSE.</li>
+   *   <li>interaction_operator_tolerance: like interaction_plan_tolerance,
+   *     but for reusing an assembled interaction operator. Defaults to
+   *     0.0.</li>
+   * </ul>
+   */
   template <int dim, int spacedim = dim>
   class ElementalInteraction : public InteractionBase<dim, spacedim>
   {
@@ -68,8 +168,8 @@ namespace fdl
     ElementalInteraction(
       const tbox::Pointer<tbox::Database>                  &input_db,
       const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-      const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
-      const std::vector<float>                             &active_cell_lengths,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
+      const ArrayView<const float>                         &active_cell_lengths,
       tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
       const std::pair<int, int>                            &level_numbers,
       const unsigned int                                    min_n_points_1D,
@@ -81,12 +181,33 @@ namespace fdl
      * point_density, and density_kind are unchanged.
      */
     virtual void
-    reinit(const tbox::Pointer<tbox::Database>                  &input_db,
-           const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-           const std::vector<BoundingBox<spacedim, float>> &active_cell_bboxes,
-           const std::vector<float>                        &active_cell_lengths,
-           tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
-           const std::pair<int, int> &level_numbers) override;
+    reinit(
+      const tbox::Pointer<tbox::Database>                  &input_db,
+      const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
+      const ArrayView<const float>                         &active_cell_lengths,
+      tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
+      const std::pair<int, int> &level_numbers) override;
+
+    /**
+     * Same as the base class, but also stores the DoF indices of the cells of
+     * the overlap DoFHandler in the PatchMap (see
+     * PatchMap::cache_dof_indices()).
+     */
+    virtual void
+    add_dof_handler(
+      const DoFHandler<dim, spacedim> &native_dof_handler) override;
+
+    /**
+     * Set the length of each active cell of the native triangulation in each
+     * reference coordinate direction (e.g., the output of
+     * compute_reference_direction_lengths() gathered with
+     * collect_longest_edge_lengths()). These are only used, by the next call
+     * to reinit(), if the anisotropic_quadrature option is enabled.
+     */
+    void
+    set_reference_direction_lengths(
+      std::array<std::vector<float>, dim> lengths);
 
     /**
      * Projection really is projection for this method so this always returns
@@ -95,9 +216,32 @@ namespace fdl
     virtual bool
     projection_is_interpolation() const override;
 
+    /**
+     * Return the value of the spread_weak_force input option.
+     */
+    virtual bool
+    spreads_weak_force() const override;
+
+    /**
+     * This class can compute multiple projections, or spread multiple
+     * fields, at once, so this always returns true.
+     */
+    virtual bool
+    supports_multiple_fields() const override;
+
+    /**
+     * This class can store overlap right-hand sides and solutions in single
+     * precision, so this always returns true.
+     */
+    virtual bool
+    supports_single_precision() const override;
+
     /**
      * Middle part of velocity interpolation - performs the actual
      * computations and does not communicate.
+     *
+     * @note Multi-field transactions always use an InteractionPlan, regardless
+     * of the value of use_interaction_plan.
      */
     virtual std::unique_ptr<TransactionBase>
     compute_projection_rhs_intermediate(
@@ -117,10 +261,60 @@ namespace fdl
     virtual std::unique_ptr<TransactionBase>
     add_workload_intermediate(std::unique_ptr<TransactionBase> t_ptr) override;
 
+    /**
+     * Count the interaction points and elements on the local patches.
+     */
+    virtual std::pair<double, double>
+    count_local_interaction_work() override;
+
+    virtual std::size_t
+    memory_consumption() const override;
+
+    /**
+     * Return the statistics of the points skipped by spreading (see the
+     * spread_cutoff option) since the last call to
+     * clear_spread_cutoff_statistics().
+     */
+    const SpreadCutoffStatistics &
+    get_spread_cutoff_statistics() const;
+
+    /**
+     * Reset the values returned by get_spread_cutoff_statistics() to zero.
+     */
+    void
+    clear_spread_cutoff_statistics();
+
   protected:
     virtual VectorOperation::values
     get_rhs_scatter_type() const override;
 
+    /**
+     * Get the interaction plan corresponding to the current position,
+     * recomputing it if necessary. If store_plan_weights is true and
+     * @p overlap_dof_handler and @p mapping are provided then the plan's JxW
+     * values are also computed for @p mapping.
+     */
+    const InteractionPlan<dim, spacedim> &
+    get_interaction_plan(
+      const DoFHandler<dim, spacedim> &overlap_position_dof_handler,
+      const Vector<double>            &overlap_position,
+      const DoFHandler<dim, spacedim> *overlap_dof_handler = nullptr,
+      const Mapping<dim, spacedim>    *mapping             = nullptr) const;
+
+    /**
+     * Get the interaction operator corresponding to the given field, data
+     * index, and current position, recomputing it (and, if necessary, the
+     * interaction plan) if necessary.
+     */
+    const InteractionOperator<dim, spacedim> &
+    get_interaction_operator(
+      const std::string               &kernel_name,
+      const int                        data_index,
+      const DoFHandler<dim, spacedim> &overlap_position_dof_handler,
+      const Vector<double>            &overlap_position,
+      const DoFHandler<dim, spacedim> &overlap_dof_handler,
+      const Mapping<dim, spacedim>    &mapping) const;
+
     /**
      * Minimum number of points to use in each coordinate direction.
      */
@@ -157,6 +351,145 @@ namespace fdl
      * Vector of quadratures we will actually use for interaction.
      */
     std::vector<Quadrature<dim>> quadratures;
+
+    /**
+     * Relative change in element length permitted before the quadrature rule
+     * of a cell is recomputed.
+     */
+    double quadrature_hysteresis;
+
+    /**
+     * Cache of previously chosen quadrature rules, used to implement
+     * quadrature_hysteresis. Both vectors are indexed by native active cell
+     * index: the lengths are the element lengths the rules were chosen for
+     * (or negative, if no rule has been chosen yet) and the indices are the
+     * corresponding quadrature indices. The cache is cleared whenever the
+     * native triangulation or the Eulerian cell length changes.
+     * @{
+     */
+    std::vector<float>         cached_quadrature_cell_lengths;
+    std::vector<unsigned char> cached_quadrature_indices;
+    double                     cached_eulerian_length;
+    /**
+     * @}
+     */
+
+    /**
+     * Pointer to the native triangulation the cache was computed for.
+     */
+    const void *cached_native_tria;
+
+    /**
+     * Connection to the native triangulation's any_change signal, which clears
+     * the cache.
+     */
+    boost::signals2::scoped_connection native_tria_connection;
+
+    /**
+     * Whether or not the number of quadrature points is chosen independently
+     * in each reference coordinate direction.
+     */
+    bool anisotropic_quadrature;
+
+    /**
+     * Lengths of each native active cell in each reference coordinate
+     * direction, indexed by active cell index.
+     */
+    std::array<std::vector<float>, dim> reference_direction_lengths;
+
+    /**
+     * Whether or not we should use an InteractionPlan.
+     */
+    bool use_interaction_plan;
+
+    /**
+     * Tolerance for reusing an InteractionPlan.
+     */
+    double interaction_plan_tolerance;
+
+    /**
+     * Relative sub-cell width used to compress InteractionPlans, or zero if
+     * they are not compressed.
+     */
+    double interaction_plan_compression;
+
+    /**
+     * Number of threads used when spreading.
+     */
+    unsigned int n_spread_threads;
+
+    /**
+     * Whether or not quadrature points are sorted by Eulerian cell before
+     * spreading.
+     */
+    bool sort_spread_points;
+
+    /**
+     * Relative cutoff below which quadrature points are not spread.
+     */
+    double spread_cutoff;
+
+    /**
+     * Statistics of the points skipped because of spread_cutoff.
+     */
+    SpreadCutoffStatistics spread_cutoff_statistics;
+
+    /**
+     * Number of threads used when interpolating without a plan.
+     */
+    unsigned int n_interpolation_threads;
+
+    /**
+     * Whether or not the interaction plan also stores JxW values.
+     */
+    bool store_plan_weights;
+
+    /**
+     * Whether or not the force should be spread in its weak form.
+     */
+    bool spread_weak_force;
+
+    /**
+     * Most recently used interaction plans, ordered from most to least
+     * recently used. This is a cache so it is mutable.
+     */
+    mutable std::vector<InteractionPlan<dim, spacedim>> interaction_plans;
+
+    /**
+     * Whether or not we should use an InteractionOperator.
+     */
+    bool use_interaction_operator;
+
+    /**
+     * Tolerance for reusing an InteractionOperator.
+     */
+    double interaction_operator_tolerance;
+
+    /**
+     * Interaction operators, one for each combination of kernel, data index,
+     * and field which has been used since the last reinitialization. Like
+     * interaction_plans, these are a cache so they are mutable.
+     */
+    mutable std::vector<InteractionOperator<dim, spacedim>>
+      interaction_operators;
   };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  inline const SpreadCutoffStatistics &
+  ElementalInteraction<dim, spacedim>::get_spread_cutoff_statistics() const
+  {
+    return spread_cutoff_statistics;
+  }
+
+  template <int dim, int spacedim>
+  inline void
+  ElementalInteraction<dim, spacedim>::clear_spread_cutoff_statistics()
+  {
+    spread_cutoff_statistics = SpreadCutoffStatistics();
+  }
 } // namespace fdl
 #endif
@@ -0,0 +1,167 @@
+#ifndef included_fiddle_interaction_ib_kernels_h
+#define included_fiddle_interaction_ib_kernels_h
+
+#include <fiddle/base/config.h>
+
+#include <string>
+#include <vector>
+
+// forward declarations
+namespace SAMRAI
+{
+  namespace hier
+  {
+    template <int>
+    class Box;
+    template <int>
+    class Patch;
+  } // namespace hier
+
+  namespace tbox
+  {
+    template <typename>
+    class Pointer;
+  } // namespace tbox
+} // namespace SAMRAI
+
+namespace fdl
+{
+  using namespace SAMRAI;
+
+  /**
+   * Regularized delta function kernels implemented by fiddle. The names
+   * match the ones used by IBTK::LEInteractor.
+   */
+  enum class IBKernel
+  {
+    /**
+     * PIECEWISE_LINEAR: the two-point hat function.
+     */
+    PiecewiseLinear,
+
+    /**
+     * IB_3: Roma, Peskin, and Berger's three-point kernel.
+     */
+    IB_3,
+
+    /**
+     * IB_4: Peskin's four-point kernel.
+     */
+    IB_4,
+
+    /**
+     * BSPLINE_3: the three-point (quadratic) B-spline.
+     */
+    BSpline_3,
+
+    /**
+     * BSPLINE_4: the four-point (cubic) B-spline.
+     */
+    BSpline_4,
+
+    /**
+     * Any kernel not implemented by fiddle.
+     */
+    Unknown
+  };
+
+  /**
+   * Get the IBKernel corresponding to a kernel name (e.g., "IB_4"). Returns
+   * IBKernel::Unknown if fiddle does not implement that kernel.
+   */
+  IBKernel
+  get_ib_kernel(const std::string &kernel_name);
+
+  /**
+   * Get the number of points in each coordinate direction of the stencil of
+   * a kernel.
+   */
+  int
+  get_ib_kernel_width(const IBKernel kernel);
+
+  /**
+   * Interpolate patch data at a set of points with a regularized delta
+   * function kernel. The arguments are the same as (and are in the same order
+   * as) IBTK::LEInteractor::interpolate(): values are only computed at points
+   * which lie inside @p box and are left unmodified at all other points.
+   *
+   * fiddle provides its own implementation of the kernels listed in IBKernel
+   * for cell-centered and side-centered data: these are specialized at
+   * compile time on the kernel and spatial dimension so that the
+   * tensor-product loops over the stencil have fixed lengths and can be
+   * vectorized by the compiler. In all other cases (including patches which
+   * touch a periodic boundary, since points may need to be periodically
+   * shifted) this function calls IBTK::LEInteractor::interpolate().
+   *
+   * @tparam patch_type One of SAMRAI's EdgeData, CellData, NodeData, or
+   * SideData classes with <code>double</code> values.
+   */
+  template <int spacedim, typename patch_type>
+  void
+  ib_interpolate(double                                     *values,
+                 const int                                   values_size,
+                 const int                                   values_depth,
+                 const double                               *positions,
+                 const int                                   positions_size,
+                 const int                                   positions_depth,
+                 const tbox::Pointer<patch_type>            &patch_data,
+                 const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                 const hier::Box<spacedim>                  &box,
+                 const std::string                          &kernel_name);
+
+  /**
+   * Spread values at a set of points into patch data with a regularized delta
+   * function kernel. The arguments are the same as (and are in the same order
+   * as) IBTK::LEInteractor::spread(): only points which lie inside @p box are
+   * spread.
+   *
+   * Like ib_interpolate(), this function uses fiddle's own kernels when
+   * possible and otherwise calls IBTK::LEInteractor::spread().
+   */
+  template <int spacedim, typename patch_type>
+  void
+  ib_spread(const tbox::Pointer<patch_type>            &patch_data,
+            const double                               *values,
+            const int                                   values_size,
+            const int                                   values_depth,
+            const double                               *positions,
+            const int                                   positions_size,
+            const int                                   positions_depth,
+            const tbox::Pointer<hier::Patch<spacedim>> &patch,
+            const hier::Box<spacedim>                  &box,
+            const std::string                          &kernel_name);
+
+  /**
+   * Compute the weights with which ib_interpolate() combines the values of
+   * @p patch_data at each point, i.e., the rows of the (sparse) interpolation
+   * operator. The arguments are the same as those of ib_interpolate(). For
+   * each point <code>point_n</code> and component <code>c</code>, in that
+   * order, the entries of row <code>point_n * values_depth + c</code> are
+   * appended to @p columns and @p weights and the new number of entries is
+   * appended to @p row_offsets, which must be nonempty. Each column is an
+   * offset relative to the start of the array of that component (i.e.,
+   * <code>getPointer(c)</code> for cell-centered data and
+   * <code>getPointer(c, 0)</code> for side-centered data). Rows of points
+   * outside @p box are empty.
+   *
+   * Spreading is the transpose of this operator divided by the volume of an
+   * Eulerian cell.
+   *
+   * This is only implemented in the cases for which fiddle uses its own
+   * kernels: otherwise nothing is appended and this function returns false.
+   */
+  template <int spacedim, typename patch_type>
+  bool
+  ib_compute_weights(const double                               *positions,
+                     const int                                   positions_size,
+                     const int                                   values_depth,
+                     const tbox::Pointer<patch_type>            &patch_data,
+                     const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                     const hier::Box<spacedim>                  &box,
+                     const std::string                          &kernel_name,
+                     std::vector<unsigned int>                  &row_offsets,
+                     std::vector<int>                           &columns,
+                     std::vector<double>                        &weights);
+} // namespace fdl
+
+#endif
@@ -8,10 +8,17 @@
 
 #include <fiddle/interaction/ifed_method_base.h>
 #include <fiddle/interaction/interaction_base.h>
+#include <fiddle/interaction/marker_point_interaction.h>
+#include <fiddle/interaction/regrid_policy.h>
+#include <fiddle/interaction/workload_calibration.h>
 
 #include <ibtk/SAMRAIGhostDataAccumulator.h>
 #include <ibtk/SecondaryHierarchy.h>
 
+#include <PatchLevel.h>
+#include <RefineSchedule.h>
+
+#include <memory>
 #include <vector>
 
 namespace fdl
@@ -27,19 +34,462 @@ namespace fdl
    * library, since template parameters are preferrable to macros, while the two
    * are equal we use spacedim whenever possible.
    *
+   * @note Each part's mass solves, force assembly, and bounding box collection
+   * only communicate over the communicator of that part's Triangulation. That
+   * communicator must contain every processor (i.e., be a duplicate of the one
+   * used by SAMRAI) since every processor owning patches takes part in each
+   * part's interaction, but giving each part its own duplicate keeps the
+   * collective operations of different parts independent of each other.
+   *
    * <h2>Options read from the input database</h2>
    * <ul>
+   *   <li>performance_profile: either DEFAULT or THROUGHPUT. The latter sets
+   *     the defaults of the options below which speed up typical simulations
+   *     without affecting their results by more than roundoff or the solver
+   *     tolerance: use_matrix_free_stresses, sort_patch_cells,
+   *     sort_spread_points, store_plan_weights, sparse_workload_transfer, and
+   *     sparse_ghost_accumulation are TRUE, initial_guess_type is
+   *     INCREMENTAL_PROJECTION, and scatter_backend is PERSISTENT. Options
+   *     given explicitly always take precedence. Options which change the
+   *     discretization (e.g., single_precision_overlap or spread_cutoff) or
+   *     which have additional requirements (e.g., threaded_mass_solves or
+   *     nodal_bboxes) are not enabled. The tests in tests/interaction whose
+   *     names contain <code>throughput</code> check that outputs computed
+   *     with this profile match the default ones. Defaults to DEFAULT.</li>
    *   <li>solver_iterations: Maximum number of iterations to use in linear solvers.</li>
    *   <li>solver_relative_tolerance: Relative tolerance (i.e., the solver
    *     tolerance will be set to this times the L2 norm of the RHS vector) to
    *     use in linear solvers.</li>
+   *   <li>solver_type: which Krylov method is used for the consistent mass
+   *     matrix solves: either CG (deal.II's SolverCG, which does two blocking
+   *     reductions per iteration) or PIPELINED_CG (the pipelined method of
+   *     Ghysels and Vanroose, which does one nonblocking reduction per
+   *     iteration overlapped with the application of the mass operator and
+   *     preconditioner). The latter is faster when the solves are
+   *     latency-bound, e.g., for small parts on many processors. Defaults to
+   *     CG.</li>
+   *   <li>solver_precision: either DOUBLE or MIXED. In the latter case the
+   *     consistent mass matrix solves are done by iterative refinement: the
+   *     residual is computed in double precision and the corrections are
+   *     computed with a single precision mass operator (and a single
+   *     precision version of the preconditioner set by
+   *     Part::set_mass_preconditioner()), which halves the memory traffic of
+   *     the inner iterations. Parts for which
+   *     Part::supports_single_precision_mass_operator() is false (e.g.,
+   *     parts with simplex elements or surface parts) are solved in double
+   *     precision instead, which is logged when this object is created. Not
+   *     used by batched_mass_solves. Defaults to DOUBLE.</li>
+   *   <li>mass_matrix_type: either CONSISTENT (solve with the mass matrix) or
+   *     LUMPED (scale by the inverse of the row-summed mass matrix instead of
+   *     solving, which is much cheaper but less accurate). Defaults to
+   *     CONSISTENT.</li>
+   *   <li>initial_guess_type: how initial guesses for the mass matrix solves
+   *     are computed from previous solutions. Possible values are PROJECTION
+   *     (least-squares projection via an SVD), INCREMENTAL_PROJECTION (the same
+   *     projection with an incrementally updated Cholesky factor, which is
+   *     cheaper), LINEAR_EXTRAPOLATION, QUADRATIC_EXTRAPOLATION
+   *     (extrapolate in time from the last two or three solutions), and
+   *     PERIODIC_PROJECTION (the least-squares projection, which also uses the
+   *     solution archived at the same phase of the previous period). Defaults
+   *     to PROJECTION. See InitialGuessType for more information.</li>
+   *   <li>IB_point_density: density of the quadrature points used by
+   *     elemental interaction relative to the cells of the Eulerian grid (see
+   *     QuadratureFamily), given either once for all parts or once per part.
+   *     Defaults to 2.0.</li>
+   *   <li>interaction_n_points_1D: number of points per dimension of the
+   *     Gauss rule which elemental interaction iterates on each element to
+   *     reach IB_point_density, given either once for all parts or once per
+   *     part. Defaults to 0, i.e., the degree of the part's finite element
+   *     plus one.</li>
+   *   <li>n_guess_vectors: maximum number of previous solutions used to compute
+   *     initial guesses. Defaults to 3.</li>
+   *   <li>guess_period: length of the period (e.g., of the cardiac cycle).
+   *     Required if initial_guess_type is PERIODIC_PROJECTION.</li>
+   *   <li>n_guess_phases: number of phase intervals of the period for which a
+   *     solution is archived, i.e., the number of additional vectors stored
+   *     for each mass solve. Defaults to 20.</li>
+   *   <li>use_matrix_free_stresses: whether or not to compute stresses with
+   *     each part's MatrixFree object (i.e., with sum factorization) when
+   *     possible. See Part::get_matrix_free_quadrature_index() for the
+   *     requirements. Defaults to FALSE.</li>
+   *   <li>n_force_threads: number of threads used to compute each part's
+   *     stresses and volume forces. Defaults to 1. See compute_load_vector()
+   *     for more information.</li>
+   *   <li>reference_values_cache_size: maximum size, in megabytes, of the
+   *     reference configuration shape function gradients stored by each part
+   *     to speed up the computation of its stresses. Defaults to 0 (i.e., no
+   *     cache). See Part::setup_reference_values_cache() for more
+   *     information.</li>
    *   <li>enable_logging: whether or not to log things like the workload.
    *     Defaults to FALSE.</li>
    *   <li>log_solver_iterations: whether or not to log number of iterations
    *     required for finite element solvers. Defaults to FALSE.</li>
+   *   <li>threaded_mass_solves: whether or not to run the mass matrix solves
+   *     of different parts on separate threads. This requires that MPI was
+   *     initialized with MPI_THREAD_MULTIPLE and that each part uses its own
+   *     communicator. Otherwise, each solve runs (in order) as soon as its
+   *     right-hand side is available. Defaults to FALSE.</li>
+   *   <li>batched_mass_solves: whether or not to solve the consistent mass
+   *     systems of all parts (and, separately, all surface parts) with a
+   *     single CG solver on a block vector. Each CG iteration then does one
+   *     set of reductions for all parts instead of one per part, which helps
+   *     when there are many small parts and the solves are latency-bound.
+   *     The solver tolerance is relative to the norm of all right-hand sides
+   *     together. Requires that all parts use the same communicator and
+   *     cannot be combined with threaded_mass_solves. Defaults to FALSE.</li>
+   *   <li>log_transaction_times: whether or not to log how long each part's
+   *     interaction transaction spent waiting for communication and computing
+   *     in interpolateVelocity(), spreadForce(), and
+   *     beginDataRedistribution(). Defaults to FALSE.</li>
    *   <li>skip_initial_workload: whether to skip printing the initial workload,
    *     to work around an issue with SAMRAI. This is typically not necessary to
    *     set inside user codes. Defaults to FALSE.</li>
+   *   <li>interaction: how each part interacts with the Eulerian grid: either
+   *     ELEMENTAL (at quadrature points) or NODAL (at the nodes of the finite
+   *     element space), given either once for all parts or once per part.
+   *     Nodal interaction is much cheaper but requires the part to be fine
+   *     relative to the grid. Defaults to ELEMENTAL.</li>
+   *   <li>surface_interaction: same as interaction, but for surface parts.
+   *     Only NODAL is presently supported. Defaults to the value of
+   *     interaction if it is given once and ELEMENTAL otherwise.</li>
+   *   <li>use_interaction_plan: whether or not elemental interactions should
+   *     precompute and reuse quadrature point locations. Defaults to TRUE. See
+   *     ElementalInteraction for more information.</li>
+   *   <li>sort_patch_cells: whether or not elemental interactions should visit
+   *     the elements of each patch in a spatially local (Morton) order.
+   *     Defaults to FALSE. See ElementalInteraction for more information.</li>
+   *   <li>sort_spread_points: whether or not elemental interactions should
+   *     sort quadrature points by Eulerian cell before spreading. Defaults to
+   *     FALSE. See ElementalInteraction for more information.</li>
+   *   <li>interaction_plan_tolerance: largest change in the position for which
+   *     elemental interactions reuse quadrature point locations. Defaults to
+   *     0.0 (i.e., only reuse them when the position does not change).</li>
+   *   <li>interaction_plan_compression: relative width of the regions of each
+   *     Eulerian cell in which elemental interactions merge quadrature points.
+   *     Defaults to 0.0 (i.e., no compression). See ElementalInteraction for
+   *     more information.</li>
+   *   <li>n_cached_interaction_plans: number of interaction plans (i.e.,
+   *     quadrature point locations for a given position) each elemental
+   *     interaction keeps. Setting this to 2 or 3 lets the plans for the
+   *     positions at the end of one time step be reused at the start of the
+   *     next one. Defaults to 1. See ElementalInteraction for more
+   *     information.</li>
+   *   <li>store_plan_weights: whether or not elemental interactions store the
+   *     JxW values of the reference configuration in their interaction plans
+   *     to avoid reinitializing FEValues on every element in each
+   *     interpolation and spreading operation. Recommended for surface parts.
+   *     Defaults to FALSE. See ElementalInteraction for more
+   *     information.</li>
+   *   <li>spread_weak_force: whether or not elemental interactions spread the
+   *     force computed from the lumped mass matrix instead of solving with the
+   *     consistent one, i.e., mass_matrix_type = LUMPED for the spreading of
+   *     the elemental parts only. Defaults to FALSE. See ElementalInteraction
+   *     for more information.</li>
+   *   <li>quadrature_hysteresis: relative change in element length below
+   *     which elemental interactions keep the quadrature rule chosen for that
+   *     element at a previous regrid. Defaults to 0.0 (i.e., always use the
+   *     rule matching the current length). See ElementalInteraction for more
+   *     information.</li>
+   *   <li>anisotropic_quadrature: whether or not elemental interactions
+   *     choose the number of quadrature points in each reference coordinate
+   *     direction of each element independently, based on the current
+   *     lengths of the element in those directions. Only supported for
+   *     quadrilaterals and hexahedra. Defaults to FALSE. See
+   *     ElementalInteraction for more information.</li>
+   *   <li>n_spread_threads: number of threads elemental interactions use to
+   *     spread. Defaults to 1. See ElementalInteraction for more
+   *     information.</li>
+   *   <li>spread_cutoff: relative force magnitude below which elemental
+   *     interactions skip quadrature points when spreading. If
+   *     performance_counters is enabled then the number of points considered
+   *     and skipped (spread_cutoff_points and spread_cutoff_skipped_points,
+   *     whose ratio is the skipped fraction) and the summed magnitudes of all
+   *     and of the skipped spread forces (spread_cutoff_total_force and
+   *     spread_cutoff_skipped_force, the latter of which bounds the change in
+   *     the total spread force) are recorded in each time step. Defaults to
+   *     0.0 (i.e., no cutoff). See ElementalInteraction for more
+   *     information.</li>
+   *   <li>n_interpolation_threads: number of threads interactions use to
+   *     interpolate. Defaults to 1. See ElementalInteraction and
+   *     NodalInteraction for more information.</li>
+   *   <li>scatter_backend: how data is moved between the native and overlap
+   *     partitionings. Possible values are POINT_TO_POINT, PERSISTENT (reuse
+   *     persistent MPI requests), and NEIGHBOR_COLLECTIVE (use neighborhood
+   *     collectives). Defaults to POINT_TO_POINT. See ScatterBackend for more
+   *     information.</li>
+   *   <li>single_precision_overlap: whether or not elemental interactions
+   *     communicate and store overlap-partitioned force and velocity data in
+   *     single precision. Native vectors are still stored in double precision.
+   *     Defaults to FALSE. See InteractionBase for more information.</li>
+   *   <li>reuse_overlap_position: whether or not interpolation and spreading
+   *     at the same position (e.g., at the half time step with the midpoint
+   *     rule) share the overlap-partitioned position instead of each
+   *     scattering it. Defaults to TRUE. See
+   *     InteractionBase::set_position_state() for more information.</li>
+   *   <li>distributed_bbox_exchange: whether or not interactions receive the
+   *     bounding boxes of the elements intersecting their patches from the
+   *     owning processors instead of reading them from the replicated global
+   *     array. Defaults to FALSE. See InteractionBase for more
+   *     information.</li>
+   *   <li>pack_nodes: whether or not nodal interactions copy the nodes of
+   *     each patch into contiguous buffers so that each patch needs a single
+   *     interpolation or spreading call. Useful when the DoF numbering is not
+   *     spatially coherent. Defaults to FALSE. See NodalPatchMap for more
+   *     information.</li>
+   *   <li>interaction_cells: which cells of each part interact with the
+   *     fluid: ALL, BOUNDARY, or MATERIAL_IDS. In the last case the material
+   *     ids are read from the integer array interaction_material_ids. Forces
+   *     are only spread from, and velocities only projected onto, the
+   *     selected cells, but the projection's mass matrix solve is still done
+   *     on the whole part. Only supported by elemental interactions. Defaults
+   *     to ALL. See InteractionBase for more information.</li>
+   *   <li>ghost_cell_fraction: amount, in multiples of the cell size, by which
+   *     patches are expanded when associating elements or nodes to them.
+   *     Values larger than 1.0 also increase the required ghost width by the
+   *     same (rounded up) number of cells: interpolateVelocity() and
+   *     spreadForce() throw an exception if their data has fewer ghost cells.
+   *     Defaults to 1.0. See ElementalInteraction for more information.</li>
+   *   <li>use_displacement_regrid_policy: whether or not to regrid based on
+   *     the ghost region set by ghost_cell_fraction. If TRUE then
+   *     getMaxPointDisplacement() returns the fraction of the displacement
+   *     budget (see DisplacementRegridPolicy) used since the last regrid
+   *     instead of the displacement itself, so setting
+   *     <code>regrid_structure_cfl_interval = 1.0</code> in
+   *     IBHierarchyIntegrator regrids only when elements may have left the
+   *     patches they were associated with. Defaults to FALSE.</li>
+   *   <li>log_regrid_displacement: whether or not to log, next to the
+   *     workload, how far the structure moved between the last two regrids
+   *     and what fraction of the ghost region that is. Useful for tuning
+   *     ghost_cell_fraction against the number of regrids. Defaults to
+   *     FALSE.</li>
+   *   <li>reuse_secondary_hierarchy: whether or not to keep the secondary
+   *     hierarchy (i.e., its partitioning and transfer schedules) and the
+   *     ghost data accumulator when a regrid does not change the patch
+   *     levels of the primary hierarchy on which the parts interact, even if
+   *     the structure moved. This makes such regrids much cheaper but skips
+   *     rebalancing the Lagrangian workload. Regrids which change neither the
+   *     levels nor the structure's position always reuse everything
+   *     (including each part's interaction object). Defaults to FALSE.</li>
+   *   <li>interpolate_from_primary_hierarchy: whether or not levels of the
+   *     secondary hierarchy with the same layout as the corresponding level
+   *     of the primary hierarchy (e.g., in small runs or when the structure
+   *     adds little work) should share the primary hierarchy's velocity
+   *     instead of copying it in interpolateVelocity(). The ghost values are
+   *     then filled by the ghost filling schedules provided by
+   *     IBHierarchyIntegrator, which saves one copy and one communication
+   *     schedule per level. Defaults to TRUE.</li>
+   *   <li>restrict_velocity_fill: whether or not interpolateVelocity() should
+   *     only fill the velocity (including ghost values) on the patches of the
+   *     secondary hierarchy which may interact with a part, i.e., whose boxes
+   *     grown by ghost_cell_fraction intersect the bounding box of one of the
+   *     part's cells. The schedules are set up once per regrid. When the
+   *     structure only covers a small part of the finest level this avoids
+   *     most of the communication needed to fill the velocity. Takes
+   *     precedence over interpolate_from_primary_hierarchy. Defaults to
+   *     FALSE.</li>
+   *   <li>sparse_workload_transfer: whether or not beginDataRedistribution()
+   *     should send only the nonzero values of the Lagrangian workload
+   *     (along with their cell indices) directly to the processors owning
+   *     the corresponding cells of the primary hierarchy instead of using a
+   *     transfer schedule. Since the workload is zero away from the structure
+   *     this is usually much cheaper. Defaults to FALSE.</li>
+   *   <li>sparse_ghost_accumulation: whether or not spreadForce() should add
+   *     the forces spread into ghost regions to the patches containing them
+   *     with accumulate_nonzero_ghost_data(), which only sends the overlaps
+   *     between ghost regions and patches containing nonzero forces, instead
+   *     of with IBTK::SAMRAIGhostDataAccumulator, which sends every ghost
+   *     region. This saves most of the communication done after spreading
+   *     when structures are small or sparse. Defaults to FALSE.</li>
+   *   <li>log_memory_consumption: whether or not to log, after each regrid,
+   *     the memory used by the parts, the part vectors, and the interaction
+   *     objects (i.e., overlap triangulations and DoFHandlers, patch maps,
+   *     and Scatter buffers) on each processor along with the minimum and
+   *     maximum over all processors. Defaults to FALSE.</li>
+   *   <li>regrid_safety_factor: fraction of the ghost region which may be used
+   *     up before regridding when use_displacement_regrid_policy is TRUE.
+   *     Defaults to 1.0.</li>
+   *   <li>workload_cost_model: how the workload used to partition the
+   *     Eulerian data is estimated. Possible values are COUNT (each quadrature
+   *     point or node adds one) and KERNEL (each point adds the number of
+   *     kernel evaluations needed to interpolate or spread a vector-valued
+   *     field, i.e., <code>spacedim * width^spacedim</code> where
+   *     <code>width</code> is the width of the part's IB kernel). Defaults to
+   *     COUNT.</li>
+   *   <li>workload_point_weight: workload added for each quadrature point or
+   *     node, which, if present, overrides the value chosen by
+   *     workload_cost_model. This is useful for supplying measured
+   *     costs.</li>
+   *   <li>workload_cell_weight: workload added (in the same units as the point
+   *     weight) for each element to account for the cost of computing forces
+   *     on it. Ignored by nodal interactions. Defaults to 0.0.</li>
+   *   <li>calibrate_workload: whether or not to fit the workload weights to
+   *     the measured time each processor spends on interaction computations
+   *     between regrids (see WorkloadCalibration). Once a fit is available it
+   *     replaces the weights set by workload_cost_model, workload_point_weight,
+   *     and workload_cell_weight for every part. Defaults to FALSE.</li>
+   *   <li>workload_calibration_min_steps: minimum number of time steps between
+   *     two regrids for the measured times to be used in the fit. Defaults to
+   *     10.</li>
+   *   <li>incremental_bbox_update: whether or not to only communicate the
+   *     element bounding boxes which changed when recomputing them after the
+   *     structure moves. Defaults to FALSE. See
+   *     update_all_active_cell_bboxes() for more information.</li>
+   *   <li>bbox_update_tolerance: padding added to bounding boxes when they are
+   *     communicated incrementally, so that smaller movements do not require
+   *     sending them again. Defaults to 0.0.</li>
+   *   <li>compress_bboxes: whether or not to send incrementally updated
+   *     bounding boxes with a compressed 16-bit encoding. Defaults to
+   *     FALSE.</li>
+   *   <li>node_shared_geometry: whether or not to store the element bounding
+   *     boxes and edge lengths of all cells once per node (in MPI-3 shared
+   *     memory) instead of once per processor. Cannot be combined with
+   *     incremental_bbox_update. Defaults to FALSE.</li>
+   *   <li>n_bbox_points_1d: if positive, compute the element bounding boxes
+   *     (which determine both the overlap triangulations and the cells
+   *     assigned to each patch) from a Gauss quadrature with this many points
+   *     per dimension instead of from the support points. This gives much
+   *     tighter boxes for large, curved elements. See
+   *     compute_cell_point_bboxes_and_longest_edge_lengths() for more
+   *     information. Defaults to 0.</li>
+   *   <li>nodal_bboxes: whether or not to compute the element bounding boxes
+   *     directly from the nodal values of the position (padded so that they
+   *     contain curved elements) instead of by evaluating the position at
+   *     each element's support points. This is much cheaper and may be
+   *     combined with n_bbox_points_1d. Requires Lagrange elements. See
+   *     compute_cell_nodal_bboxes_and_longest_edge_lengths() for more
+   *     information. Defaults to FALSE.</li>
+   *   <li>restart_file_directory: if set, each processor writes the position
+   *     and velocity of its parts to its own binary file in this directory
+   *     when restart data is written and only the file name is stored in the
+   *     restart database. Unless portable_restart_files is TRUE, restarting
+   *     from these files requires the same number of processors. Defaults to
+   *     the empty string, i.e., the parts are stored in the restart
+   *     database.</li>
+   *   <li>asynchronous_restart_files: whether or not to write the files
+   *     requested by restart_file_directory from a background thread so that
+   *     time stepping only waits for a copy of each part's state. Defaults to
+   *     FALSE.</li>
+   *   <li>checkpoint_setup_data: whether or not to also write the data of
+   *     each part which is expensive to set up (see Part::write_setup_data())
+   *     next to the files requested by restart_file_directory. When
+   *     restarting with the same mesh, finite elements, and number of
+   *     processors this data is read instead of recomputed. Defaults to
+   *     FALSE.</li>
+   *   <li>portable_restart_files: whether or not the files requested by
+   *     restart_file_directory store a partition-independent index of each
+   *     value (see Part::write_portable_state()). Restarting from these files
+   *     works with any number of processors: the files of the previous run
+   *     are distributed among the current processors and each value is then
+   *     sent to its owner with one all-to-all exchange per part. Defaults to
+   *     FALSE.</li>
+   *   <li>delta_restart_files: whether or not each file requested by
+   *     restart_file_directory stores only the compressed difference to the
+   *     previous one written by the same processor. Successive states of,
+   *     e.g., a periodic simulation differ little, so this makes the files
+   *     much smaller. Restarting from a delta-encoded file requires every
+   *     file written since the previous keyframe. Defaults to FALSE.</li>
+   *   <li>restart_keyframe_interval: maximum number of delta-encoded restart
+   *     files between two files which store the full (compressed) state.
+   *     Defaults to 10.</li>
+   *   <li>performance_counters: whether or not to record, for each time
+   *     step, per-processor counters like the time spent in, the time spent
+   *     waiting for MPI requests in (which measures load imbalance without
+   *     requiring FDL_ENABLE_TIMER_BARRIERS), and the number of interaction
+   *     points processed by each interaction phase, the number of
+   *     CG iterations of each part, the number of bytes moved by Scatter
+   *     objects, and the number of regrids. These are available from
+   *     get_performance_counters(). Defaults to FALSE.</li>
+   *   <li>performance_counters_file: if set, the minimum, maximum, and sum
+   *     over all processors of each counter are appended as one line of JSON
+   *     to this file after each time step. Defaults to the empty string, i.e.,
+   *     no file is written.</li>
+   *   <li>log_throughput: whether or not to log, after each call to
+   *     interpolateVelocity() and spreadForce(), the number of interaction
+   *     points processed per second, the achieved memory bandwidth (estimated
+   *     from the number of kernel evaluations, each of which reads or, when
+   *     spreading, reads and writes one double of Eulerian data), the network
+   *     bandwidth of the Scatter objects, and the fraction of the time lost to
+   *     load imbalance. Whichever is closest to its limit is logged as the
+   *     likely bottleneck. Defaults to FALSE.</li>
+   *   <li>peak_memory_bandwidth: peak memory bandwidth, in bytes per second,
+   *     of one processor, against which log_throughput compares the achieved
+   *     memory bandwidth. Defaults to 0.0, i.e., no comparison.</li>
+   *   <li>peak_network_bandwidth: same as peak_memory_bandwidth, but for the
+   *     network bandwidth. Defaults to 0.0.</li>
+   *   <li>trace_file: If nonempty, record a timeline of the stages of each
+   *     transaction (per part), MPI waits, CG solves, and regrids and write it
+   *     to this file in the Chrome trace event format (viewable with
+   *     <code>chrome://tracing</code> or <code>ui.perfetto.dev</code>). See
+   *     Tracer. Defaults to the empty string.</li>
+   *   <li>trace_n_steps: Number of time steps to record before writing
+   *     trace_file. Tracing stops afterwards. Defaults to 5.</li>
+   *   <li>level_number: number of the patch level with which each part
+   *     interacts, given either once for all parts or once per part. Cells
+   *     intersecting a part are only tagged for refinement on coarser levels,
+   *     so parts which do not need the finest resolution (e.g., large vessels)
+   *     can use a coarser level. Forces spread onto coarser levels are
+   *     prolonged onto the finer levels covering them. Negative values and
+   *     values larger than the finest level number mean the finest level.
+   *     Defaults to -1.</li>
+   *   <li>surface_level_number: same as level_number, but for surface
+   *     parts.</li>
+   *   <li>tag_buffer: number of additional cells, on the level being tagged,
+   *     by which the region tagged for refinement around each part is grown.
+   *     Given either once for all parts or once per part. Defaults to 0.</li>
+   *   <li>surface_tag_buffer: same as tag_buffer, but for surface parts.</li>
+   *   <li>n_force_subcycles: number of times the force of each part is
+   *     evaluated in each time step, given either once for all parts or once
+   *     per part. When computing the force at the midpoint of the time step,
+   *     the load vector is instead averaged over this many substeps (i.e.,
+   *     the midpoint rule on a finer partition of the time step) at which the
+   *     position is interpolated linearly between the start and end of the
+   *     time step. The velocity is still interpolated once per time step and
+   *     only one mass solve is needed. Useful for stiff parts whose forces
+   *     need to be sampled more finely than the fluid time step. Defaults to
+   *     1.</li>
+   *   <li>surface_n_force_subcycles: same as n_force_subcycles, but for
+   *     surface parts.</li>
+   *   <li>activation_windows_i: times at which part i is active, given as
+   *     consecutive pairs of start and end times (see
+   *     Part::set_activation_windows()). Whether or not a part is active is
+   *     determined at the start of each time step: inactive parts are not
+   *     interpolated to, do not spread force, are not included in the
+   *     workload estimate or regridding, and do not move. Defaults to
+   *     always being active.</li>
+   *   <li>surface_activation_windows_i: same as activation_windows_i, but
+   *     for surface part i.</li>
+   *   <li>tag_with_quadrature_points: whether or not to tag the cells
+   *     containing each part's quadrature points instead of the cells
+   *     intersecting each element's bounding box. This tags far fewer cells
+   *     for large, curved elements, but requires that the points are no
+   *     farther apart than the cells of the finest level (or a tag buffer
+   *     which fills the gaps). Defaults to FALSE.</li>
+   *   <li>n_tag_points_1d: number of quadrature points per dimension used by
+   *     tag_with_quadrature_points. Defaults to 0, i.e., the degree of the
+   *     part's finite element plus one.</li>
+   *   <li>secondary_largest_patch_size: largest patch size (one entry per
+   *     coordinate direction) of the internal GriddingAlgorithm, which
+   *     overrides <code>largest_patch_size</code> in its database. This
+   *     controls how finely the Lagrangian work is partitioned independently
+   *     of the Navier-Stokes integrator's patches. Defaults to the value
+   *     given in the GriddingAlgorithm database.</li>
+   *   <li>forward_euler_step_type: method used by forwardEulerStep() to
+   *     update the position: either FORWARD_EULER or AB2, i.e., the
+   *     second-order Adams-Bashforth method, which reuses the velocity of the
+   *     previous time step instead of requiring additional interpolations.
+   *     The first time step (and the first one after a restart) always uses
+   *     forward Euler. Defaults to FORWARD_EULER.</li>
+   *   <li>structure_cfl_target: largest number of cells of the finest level
+   *     which the structure may move in one time step of the size returned by
+   *     suggest_dt(). Defaults to 0.5.</li>
+   *   <li>max_dt_growth: largest factor by which suggest_dt() increases the
+   *     time step size. Defaults to 1.1.</li>
+   *   <li>marker_point_IB_kernel: IB kernel used by each set of marker points
+   *     (or a single kernel used by all of them), which is required if there
+   *     are any marker points. Marker points interact with the finest level
+   *     (so every coarser level is refined around them), compute their
+   *     forces from their springs in computeLagrangianForce(), and always
+   *     use forward Euler in forwardEulerStep().</li>
    *   <li>GriddingAlgorithm: Database for setting up the internal
    *     GriddingAlgorithm object.</li>
    *   <li>LoadBalancer: Database for setting up the internal LoadBalancer
@@ -68,8 +518,25 @@ namespace fdl
    *     0.01. Since the patches tend to have highly variable amounts of work
    *     per cell we typically want to do a lot of box chopping. The 'floor'
    *     here is controlled by the minimum patch size set above.</li>
+   *   <li>Set <code>secondary_largest_patch_size</code> to a few times the
+   *     smallest patch size. Since the secondary hierarchy is only used for
+   *     interaction, it can contain many more, smaller patches than the
+   *     primary hierarchy without slowing down the fluid solver, which lets
+   *     the load balancer split up regions with many interaction points.</li>
    * </ol>
    *
+   * The cost of computing stresses is proportional to the number of elements
+   * (and mechanics quadrature points) of each part, whereas the accuracy of
+   * the interaction depends on the density of the interaction points relative
+   * to the Eulerian grid. Elemental interaction chooses the interaction
+   * quadrature of each element from its current size, independently of the
+   * quadrature rules of the part's force contributions, and evaluates the
+   * part's finite element fields directly at those points. Hence a part may
+   * use a coarse mesh with high-order elements (and therefore far fewer
+   * mechanics quadrature points in total) while IB_point_density and
+   * interaction_n_points_1D keep the interaction as accurate as on a fine
+   * mesh.
+   *
    * In general, getting good load balancing requires some problem-dependent
    * tuning that balances using a lot of small patches (which enables better
    * load balancing) to using few large patches (which enables more efficient
@@ -103,6 +570,19 @@ namespace fdl
                std::vector<Part<dim, spacedim>>     &&input_parts,
                const bool register_for_restart = true);
 
+    /**
+     * Constructor. Assumes ownership of the provided parts, surface parts,
+     * and sets of marker points (see MarkerPoints), which interact with the
+     * Eulerian grid through MarkerPointInteraction instead of a
+     * finite element interaction.
+     */
+    IFEDMethod(const std::string                     &object_name,
+               tbox::Pointer<tbox::Database>          input_db,
+               std::vector<Part<dim - 1, spacedim>> &&input_surface_parts,
+               std::vector<Part<dim, spacedim>>     &&input_parts,
+               std::vector<MarkerPoints<spacedim>>  &&input_marker_points,
+               const bool register_for_restart = true);
+
     /**
      * @}
      */
@@ -154,6 +634,14 @@ namespace fdl
 
     virtual void
     computeLagrangianForce(double data_time) override;
+
+    /**
+     * Return the maximum displacement since the last regrid. If
+     * use_displacement_regrid_policy is set in the input database, this is
+     * normalized by the displacement budget of the regrid policy.
+     */
+    virtual double
+    getMaxPointDisplacement() const override;
     /**
      * @}
      */
@@ -200,6 +688,59 @@ namespace fdl
     virtual void
     reinit_interactions();
 
+    /**
+     * Finish spreading forces into the secondary hierarchy's scratch data
+     * @p f_scratch_data_index: fold values spread outside the physical domain
+     * back into it with @p f_phys_bdry_op (if provided) and then accumulate
+     * values spread into ghost regions into the patches which own them.
+     */
+    void
+    accumulate_spread_ghost_data(
+      const tbox::Pointer<hier::Variable<spacedim>> &f_var,
+      const int                                      f_scratch_data_index,
+      IBTK::RobinPhysBdryPatchStrategy              *f_phys_bdry_op,
+      const double                                   data_time);
+
+    /**
+     * Data needed to fill the velocity on only the patches of a level of the
+     * secondary hierarchy which may interact with a part.
+     */
+    struct RestrictedVelocityFill
+    {
+      int level_number;
+
+      int data_index;
+
+      /**
+       * Numbers of the patches of the secondary hierarchy's level which are
+       * filled.
+       */
+      std::vector<int> patch_numbers;
+
+      /**
+       * Level consisting only of those patches (see
+       * make_patch_level_subset()).
+       */
+      tbox::Pointer<hier::PatchLevel<spacedim>> level;
+
+      /**
+       * Schedule filling @p level (including ghost regions) from the primary
+       * hierarchy. Null if there are no patches.
+       */
+      tbox::Pointer<xfer::RefineSchedule<spacedim>> schedule;
+    };
+
+    /**
+     * Get (and, if necessary, set up) the RestrictedVelocityFill for level
+     * @p level_number and data index @p u_data_index. A patch is filled if
+     * its box, grown by ghost_cell_fraction cells, intersects the bounding
+     * box of an active cell of a part interacting on that level. This call
+     * is collective.
+     */
+    const RestrictedVelocityFill &
+    get_restricted_velocity_fill(const int level_number,
+                                 const int u_data_index);
+
     /**
      * Book-keeping
      * @{
@@ -210,6 +751,43 @@ namespace fdl
 
     std::vector<std::string> surface_ib_kernels;
 
+    std::vector<std::string> marker_point_ib_kernels;
+
+    bool use_displacement_regrid_policy;
+
+    DisplacementRegridPolicy regrid_policy;
+
+    /**
+     * Maximum displacement (in multiples of the finest cell size) between the
+     * last two regrids, or NaN before the first regrid.
+     */
+    double regrid_displacement;
+
+    /**
+     * Levels of the primary hierarchy before the current regrid. Used to
+     * check whether or not regridding changed them.
+     */
+    std::vector<tbox::Pointer<hier::PatchLevel<spacedim>>> previous_levels;
+
+    /**
+     * Whether or not the workload weights changed during the current regrid.
+     */
+    bool updated_workload_weights = false;
+
+    /**
+     * Calibration of the workload weights. Only set up if requested in the
+     * input database.
+     */
+    std::unique_ptr<WorkloadCalibration> workload_calibration;
+
+    /**
+     * Number of interaction points and elements owned by the current
+     * processor of each part and then each surface part, computed in
+     * reinit_interactions(). Only set up if it is needed by the workload
+     * calibration or the performance counters.
+     */
+    std::vector<std::pair<double, double>> interaction_work;
+
     /**
      * @}
      */
@@ -227,6 +805,12 @@ namespace fdl
       surface_force_guesses;
     std::vector<InitialGuess<LinearAlgebra::distributed::Vector<double>>>
       surface_velocity_guesses;
+
+    /**
+     * Force of each set of marker points computed by the last call to
+     * computeLagrangianForce().
+     */
+    std::vector<Vector<double>> marker_point_forces;
     /**
      * @}
      */
@@ -235,10 +819,35 @@ namespace fdl
      * Finite difference data structures
      * @{
      */
+    /**
+     * Ghost width required by IBAMR, i.e., the maximum of
+     * interpolation_ghosts and spreading_ghosts.
+     */
     SAMRAI::hier::IntVector<spacedim> ghosts;
 
+    /**
+     * Ghost widths required by the kernels of all parts (including
+     * ghost_cell_fraction) when interpolating and spreading, respectively.
+     * Only the spreading ghost region is accumulated after spreading.
+     */
+    SAMRAI::hier::IntVector<spacedim> interpolation_ghosts;
+    SAMRAI::hier::IntVector<spacedim> spreading_ghosts;
+
     IBTK::SecondaryHierarchy secondary_hierarchy;
 
+    /**
+     * Whether or not each level of the secondary hierarchy has the same
+     * layout (i.e., the same patches on the same processors) as the
+     * corresponding level of the primary hierarchy, indexed by level number.
+     * Computed whenever the secondary hierarchy is reinitialized.
+     */
+    std::vector<bool> secondary_level_matches_primary;
+
+    /**
+     * Restricted velocity fills, which are reset by reinit_interactions().
+     */
+    std::vector<RestrictedVelocityFill> restricted_velocity_fills;
+
     int lagrangian_workload_plot_index = IBTK::invalid_index;
 
     int lagrangian_workload_current_index = IBTK::invalid_index;
@@ -260,6 +869,8 @@ namespace fdl
 
     std::vector<std::unique_ptr<InteractionBase<dim - 1, spacedim>>>
       surface_interactions;
+
+    std::vector<MarkerPointInteraction<spacedim>> marker_point_interactions;
     /**
      * @}
      */
@@ -2,10 +2,22 @@
 #define included_fiddle_interaction_ifed_method_base_h
 
 #include <fiddle/base/config.h>
+#include <fiddle/base/tracer.h>
 
+#include <fiddle/grid/box_utilities.h>
+
+#include <fiddle/interaction/performance_counters.h>
+
+#include <fiddle/mechanics/marker_points.h>
 #include <fiddle/mechanics/part.h>
 #include <fiddle/mechanics/part_vectors.h>
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/bounding_box.h>
+
+#include <deal.II/lac/vector.h>
+
 #include <ibamr/IBStrategy.h>
 
 #include <ibtk/SAMRAIDataCache.h>
@@ -13,6 +25,10 @@
 #include <BasePatchHierarchy.h>
 #include <tbox/Pointer.h>
 
+#include <array>
+#include <future>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace fdl
@@ -33,6 +49,16 @@ namespace fdl
                    std::vector<Part<dim, spacedim>>     &&input_parts,
                    const bool register_for_restart = true);
 
+    /**
+     * Same as above, but also with sets of marker points (see MarkerPoints),
+     * which always interact with the finest level.
+     */
+    IFEDMethodBase(const std::string                     &object_name,
+                   std::vector<Part<dim - 1, spacedim>> &&input_surface_parts,
+                   std::vector<Part<dim, spacedim>>     &&input_parts,
+                   std::vector<MarkerPoints<spacedim>>  &&input_marker_points,
+                   const bool register_for_restart = true);
+
     /**
      * Destructor.
      */
@@ -42,9 +68,39 @@ namespace fdl
      * @name fluid-structure interaction.
      * @{
      */
+    /**
+     * Return the maximum displacement of the structure since the last regrid
+     * relative to the cell size of the finest level. This also computes, in
+     * the same reduction, the maximum velocity of the structure used by
+     * get_structure_cfl_number() and suggest_dt().
+     */
     virtual double
     getMaxPointDisplacement() const override;
 
+    /**
+     * Return the number of cells of the finest level which the fastest point
+     * of the structure moves in a time step of size @p dt, i.e.,
+     * max |U| dt / dx, in which |U| is the maximum norm of the velocity of
+     * every part and set of marker points at the last call to
+     * getMaxPointDisplacement().
+     */
+    double
+    get_structure_cfl_number(const double dt) const;
+
+    /**
+     * Suggest the size of the next time step based on the velocity of the
+     * structure at the last call to getMaxPointDisplacement(): the time step
+     * shrinks so that get_structure_cfl_number() does not exceed
+     * structure_cfl_target and otherwise grows by at most a factor of
+     * max_dt_growth. Returns @p current_dt if no velocity is available yet.
+     *
+     * IBAMR does not ask IBStrategy objects for time step sizes so this
+     * should be called by the application (e.g., combined with the time step
+     * size of the Navier-Stokes integrator) after each time step.
+     */
+    double
+    suggest_dt(const double current_dt) const;
+
     /**
      * Tag cells in @p hierarchy that intersect with the structure.
      */
@@ -153,11 +209,192 @@ namespace fdl
 
     const Part<dim - 1, spacedim> &
     get_surface_part(const unsigned int surface_part_n) const;
+
+    std::size_t
+    n_marker_point_sets() const;
+
+    const MarkerPoints<spacedim> &
+    get_marker_points(const unsigned int marker_points_n) const;
+
+    /**
+     * Set whether or not part @p part_n is active (see Part::set_active()).
+     * Inactive parts are skipped by interaction, force computations, mass
+     * solves, cell tagging, and the workload estimate, and their positions do
+     * not change. Whether or not each part is active (which also depends on
+     * its activation windows) is determined at the start of each time step,
+     * so this takes effect in the next time step.
+     */
+    void
+    set_part_active(const unsigned int part_n, const bool active);
+
+    /**
+     * Same as set_part_active(), but for surface parts.
+     */
+    void
+    set_surface_part_active(const unsigned int surface_part_n,
+                            const bool         active);
+
+    /**
+     * Return whether or not performance counters are being recorded.
+     */
+    bool
+    has_performance_counters() const;
+
+    /**
+     * Get the performance counters (e.g., the number of interaction points or
+     * CG iterations) of the last time step. Only available if the
+     * performance_counters option is enabled.
+     */
+    const PerformanceCounters &
+    get_performance_counters() const;
     /**
      * @}
      */
 
   protected:
+    /**
+     * Write the locally owned state of every part to a file with the current
+     * processor's rank in restart_file_directory and store its name in @p db.
+     * This call is collective. If asynchronous_restart_files is true then the
+     * file may still be incomplete when this function returns.
+     */
+    void
+    write_restart_file(tbox::Pointer<tbox::Database> db);
+
+    /**
+     * Read the state of every part from the file referenced by @p db, as well
+     * as the setup data of each part if it was written.
+     */
+    void
+    read_restart_file(tbox::Pointer<tbox::Database> db);
+
+    /**
+     * @name Geometric data shared by everything done in a regrid.
+     * @{
+     */
+
+    /**
+     * Get the bounding boxes of all active cells (i.e., on all processors) of
+     * part @p part_n. These are computed from the current position when they
+     * are first requested and then stored until the position changes. If
+     * node_shared_geometry is true then they are stored in memory shared by
+     * all processors on the same node.
+     *
+     * @note This function is collective over the part's MPI communicator.
+     */
+    ArrayView<const BoundingBox<spacedim, float>>
+    get_global_active_cell_bboxes(const unsigned int part_n);
+
+    /**
+     * Same as get_global_active_cell_bboxes(), but for surface parts.
+     */
+    ArrayView<const BoundingBox<spacedim, float>>
+    get_surface_global_active_cell_bboxes(const unsigned int surface_part_n);
+
+    /**
+     * Get the longest edge length of each active cell (i.e., on all
+     * processors) of part @p part_n. Like the bounding boxes, these are
+     * computed on demand and stored until the position changes. Unless
+     * incremental bounding box updates are enabled, the bounding boxes and
+     * edge lengths are always computed and communicated together.
+     */
+    ArrayView<const float>
+    get_global_longest_edge_lengths(const unsigned int part_n);
+
+    /**
+     * Same as get_global_longest_edge_lengths(), but for surface parts.
+     */
+    ArrayView<const float>
+    get_surface_global_longest_edge_lengths(const unsigned int surface_part_n);
+
+    /**
+     * Get the bounding boxes used to tag cells for refinement around part
+     * @p part_n: either the bounding boxes of its active cells or, if
+     * tag_with_quadrature_points is true, degenerate bounding boxes of its
+     * quadrature points. Like the bounding boxes, these are computed on demand
+     * and stored until the position changes.
+     *
+     * @note This function is collective over the part's MPI communicator.
+     */
+    ArrayView<const BoundingBox<spacedim, float>>
+    get_global_tag_bboxes(const unsigned int part_n);
+
+    /**
+     * Same as get_global_tag_bboxes(), but for surface parts.
+     */
+    ArrayView<const BoundingBox<spacedim, float>>
+    get_surface_global_tag_bboxes(const unsigned int surface_part_n);
+
+    /**
+     * Invalidate all stored geometric data. This must be called whenever the
+     * position of any part changes. Unless incremental_bbox_update is true, in
+     * which case the bounding boxes are kept so that they can be updated in
+     * place, this also frees the memory.
+     */
+    void
+    clear_geometry_cache();
+
+    /**
+     * Return the number of the level on which part @p part_n (where surface
+     * parts are numbered after parts) interacts with the Eulerian grid, i.e.,
+     * the corresponding entry of interaction_level_numbers or the finest level
+     * number, whichever is smaller.
+     */
+    int
+    get_interaction_level_number(const unsigned int part_n) const;
+
+    /**
+     * Return the sorted numbers of all levels on which at least one part
+     * interacts with the Eulerian grid (or just the finest level number, if
+     * there are no parts).
+     */
+    std::vector<int>
+    get_interaction_level_numbers() const;
+    /**
+     * @}
+     */
+
+    /**
+     * Get degenerate bounding boxes (i.e., points) of the current positions
+     * of marker point set @p marker_points_n, e.g., for tagging cells.
+     */
+    std::vector<BoundingBox<spacedim>>
+    get_marker_point_bboxes(const unsigned int marker_points_n) const;
+
+    /**
+     * Get the position of marker point set @p marker_points_n at @p time,
+     * which must be the current, half, or new time. Like PartVectors, the
+     * position at the half time is the average of the current and new
+     * positions.
+     */
+    const Vector<double> &
+    get_marker_point_position(const unsigned int marker_points_n,
+                              const double       time);
+
+    /**
+     * Set the velocity of marker point set @p marker_points_n at @p time,
+     * which must be the current, half, or new time.
+     */
+    void
+    set_marker_point_velocity(const unsigned int marker_points_n,
+                              const double       time,
+                              Vector<double>   &&velocity);
+
+    /**
+     * Determine which parts are active at time @p time and store the result
+     * in active_parts.
+     */
+    void
+    update_active_parts(const double time);
+
+    /**
+     * Return whether or not part @p part_n (numbered in the same way as
+     * interaction_level_numbers, i.e., parts and then surface parts) was
+     * active at the last call to update_active_parts().
+     */
+    bool
+    part_is_active(const unsigned int part_n) const;
+
     /**
      * Book-keeping
      * @{
@@ -166,11 +403,106 @@ namespace fdl
 
     bool register_for_restart;
 
+    /**
+     * Directory in which each processor writes the state of its parts to its
+     * own binary file when restart data is requested. If empty, the parts are
+     * instead serialized into the restart database.
+     */
+    std::string restart_file_directory;
+
+    /**
+     * Number of restart files written so far, used to give each set of
+     * restart files a unique name.
+     */
+    int n_restart_files_written;
+
+    /**
+     * Whether or not to write restart files from a background thread. If
+     * true, write_restart_file() copies the state of each part into one of
+     * two staging buffers and returns immediately: the next call only waits
+     * if the previous file has not been written yet.
+     */
+    bool asynchronous_restart_files;
+
+    /**
+     * Whether or not write_restart_file() should also write the setup data
+     * of each part (see Part::write_setup_data()) so that, when restarting
+     * in the same way, it does not need to be recomputed. The setup data is
+     * always written synchronously.
+     */
+    bool checkpoint_setup_data;
+
+    /**
+     * Whether or not restart files store the difference (i.e., the bitwise
+     * XOR, compressed with zlib) to the previous restart file written by the
+     * same processor instead of the state itself. Every
+     * restart_keyframe_interval + 1st file is a keyframe, which stores the
+     * (compressed) state, so restarting reads at most that many files.
+     */
+    bool delta_restart_files;
+
+    /**
+     * Maximum number of delta-encoded restart files between two keyframes.
+     */
+    unsigned int restart_keyframe_interval;
+
+    /**
+     * Whether or not restart files store the states of the parts with
+     * Part::write_portable_state() so that they can be read with a different
+     * number of processors.
+     */
+    bool portable_restart_files;
+
+    /**
+     * Number of delta-encoded restart files written since the last keyframe.
+     */
+    unsigned int n_restart_deltas;
+
+    /**
+     * State (in the format of Part::write_state()) and name of the last
+     * delta-encoded restart file. The state is empty if no file has been
+     * written yet, in which case the next file is a keyframe.
+     */
+    std::vector<char> previous_restart_state;
+    std::string       previous_restart_filename;
+
+    /**
+     * Staging buffers for asynchronous restart files.
+     */
+    std::array<std::vector<char>, 2> restart_buffers;
+
+    /**
+     * Pending asynchronous write, if any.
+     */
+    std::future<void> restart_write;
+
     bool started_time_integration;
 
     double current_time;
     double half_time;
     double new_time;
+
+    /**
+     * Per-step performance counters. Null unless the performance_counters
+     * option is enabled.
+     */
+    std::unique_ptr<PerformanceCounters> performance_counters;
+
+    /**
+     * Time at which the current regrid started, used for the regrid_time
+     * counter.
+     */
+    double regrid_start_time;
+
+    /**
+     * Optional tracer, which records the first trace_n_steps time steps and
+     * then writes them to trace_file. Null if tracing is disabled or
+     * finished.
+     */
+    std::unique_ptr<Tracer> tracer;
+    std::string             trace_file;
+    unsigned int            trace_n_steps;
+    unsigned int            n_traced_steps;
     /**
      * @}
      */
@@ -182,6 +514,50 @@ namespace fdl
     tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy;
 
     std::shared_ptr<IBTK::SAMRAIDataCache> eulerian_data_cache;
+
+    /**
+     * Requested number of the level on which each part and then each surface
+     * part interacts with the Eulerian grid. Cells are only tagged for
+     * refinement on coarser levels, so the structure is covered by (at most)
+     * this level. Defaults to the largest possible level number, i.e., every
+     * part interacts with the finest level.
+     */
+    std::vector<int> interaction_level_numbers;
+
+    /**
+     * Number of additional cells, on the level being tagged, by which the
+     * tagged region of each part and then each surface part is grown.
+     * Defaults to zero.
+     */
+    std::vector<int> tag_buffers;
+
+    /**
+     * Number of substeps at which the force of each part and then each
+     * surface part is evaluated when computing the force at the midpoint of
+     * a time step. Defaults to one.
+     */
+    std::vector<int> n_force_subcycles;
+
+    /**
+     * Whether or not each part and then each surface part is active in the
+     * current time step. Set by update_active_parts().
+     */
+    std::vector<bool> active_parts;
+
+    /**
+     * Whether or not to tag the cells containing quadrature points of each
+     * part instead of the cells intersecting each element's bounding box. The
+     * bounding boxes of large, curved elements are much larger than the
+     * elements themselves.
+     */
+    bool tag_with_quadrature_points;
+
+    /**
+     * Number of quadrature points per dimension used when
+     * tag_with_quadrature_points is true. Zero means the degree of each part's
+     * finite element plus one.
+     */
+    unsigned int n_tag_points_1d;
     /**
      * @}
      */
@@ -203,6 +579,149 @@ namespace fdl
 
     std::deque<LinearAlgebra::distributed::Vector<double>>
       surface_positions_at_last_regrid;
+
+    /**
+     * Sets of marker points. Every processor stores every point.
+     */
+    std::vector<MarkerPoints<spacedim>> marker_points;
+
+    /**
+     * Positions of each set of marker points at the new and half times and
+     * velocities at the half and new times. Like PartVectors, these are only
+     * available in the time step in which they were set.
+     */
+    std::vector<Vector<double>> marker_point_new_positions;
+
+    std::vector<Vector<double>> marker_point_half_positions;
+
+    std::vector<Vector<double>> marker_point_half_velocities;
+
+    std::vector<Vector<double>> marker_point_new_velocities;
+
+    std::vector<Vector<double>> marker_point_positions_at_last_regrid;
+
+    /**
+     * Whether or not forwardEulerStep() uses the (variable step size)
+     * second-order Adams-Bashforth method, which reuses the velocity of the
+     * previous time step, instead of the forward Euler method.
+     */
+    bool use_ab2_step;
+
+    /**
+     * Velocities of the parts and surface parts at the start of the previous
+     * time step, used by the Adams-Bashforth method. Empty before the first
+     * time step (and after a restart), in which case forwardEulerStep() takes
+     * a forward Euler step.
+     */
+    std::vector<LinearAlgebra::distributed::Vector<double>> previous_velocities;
+
+    std::vector<LinearAlgebra::distributed::Vector<double>>
+      surface_previous_velocities;
+
+    /**
+     * Size of the previous time step.
+     */
+    double previous_time_step_size;
+
+    /**
+     * Largest value of get_structure_cfl_number() permitted by suggest_dt().
+     */
+    double structure_cfl_target;
+
+    /**
+     * Largest factor by which suggest_dt() increases the time step size.
+     */
+    double max_dt_growth;
+
+    /**
+     * Maximum velocity of the structure divided by the cell size of the
+     * finest level, computed by getMaxPointDisplacement(). Negative if not
+     * yet computed.
+     */
+    mutable double max_velocity_over_dx;
+    /**
+     * @}
+     */
+
+    /**
+     * Stored geometric data
+     * @{
+     */
+    /**
+     * Geometric data, computed from the position, of a single part.
+     */
+    struct GeometryCache
+    {
+      bool bboxes_valid = false;
+
+      std::vector<BoundingBox<spacedim, float>> global_active_cell_bboxes;
+
+      bool edge_lengths_valid = false;
+
+      std::vector<float> global_longest_edge_lengths;
+
+      /**
+       * Same as global_active_cell_bboxes and global_longest_edge_lengths,
+       * but stored in memory shared by all processors on the same node. Only
+       * used if node_shared_geometry is true.
+       */
+      AlignedVector<BoundingBox<spacedim, float>> shared_active_cell_bboxes;
+
+      AlignedVector<float> shared_longest_edge_lengths;
+
+      bool tag_points_valid = false;
+
+      /**
+       * Degenerate bounding boxes (i.e., points) of all quadrature points
+       * used for tagging.
+       */
+      std::vector<BoundingBox<spacedim, float>> global_tag_points;
+    };
+
+    std::vector<GeometryCache> geometry_cache;
+
+    std::vector<GeometryCache> surface_geometry_cache;
+
+    /**
+     * Whether or not to update the global bounding boxes with
+     * update_all_active_cell_bboxes(), which only communicates the boxes
+     * which changed, instead of collecting all of them again.
+     */
+    bool incremental_bbox_update;
+
+    /**
+     * Tolerance passed to update_all_active_cell_bboxes().
+     */
+    double bbox_update_tolerance;
+
+    /**
+     * Encoding passed to update_all_active_cell_bboxes().
+     */
+    BoundingBoxEncoding bbox_encoding;
+
+    /**
+     * Whether or not to store the global bounding boxes and edge lengths in
+     * memory shared by all processors on the same node (see
+     * collect_shared_active_cell_bboxes_and_lengths()) instead of on each
+     * processor. Incompatible with incremental_bbox_update.
+     */
+    bool node_shared_geometry;
+
+    /**
+     * Number of points per dimension of the Gauss quadrature used to compute
+     * the bounding boxes of each cell (see
+     * compute_cell_point_bboxes_and_longest_edge_lengths()). Zero means the
+     * bounding boxes of the support points are used instead.
+     */
+    unsigned int n_bbox_points_1d;
+
+    /**
+     * Whether or not to compute the bounding boxes of the support points
+     * directly from the position DoFs (see
+     * compute_cell_nodal_bboxes_and_longest_edge_lengths()) instead of with
+     * a MappingFEField.
+     */
+    bool nodal_bboxes;
     /**
      * @}
      */
@@ -242,6 +761,66 @@ namespace fdl
     AssertIndexRange(surface_part_n, n_surface_parts());
     return surface_parts[surface_part_n];
   }
+
+  template <int dim, int spacedim>
+  inline std::size_t
+  IFEDMethodBase<dim, spacedim>::n_marker_point_sets() const
+  {
+    return marker_points.size();
+  }
+
+  template <int dim, int spacedim>
+  inline const MarkerPoints<spacedim> &
+  IFEDMethodBase<dim, spacedim>::get_marker_points(
+    const unsigned int marker_points_n) const
+  {
+    AssertIndexRange(marker_points_n, n_marker_point_sets());
+    return marker_points[marker_points_n];
+  }
+
+  template <int dim, int spacedim>
+  inline void
+  IFEDMethodBase<dim, spacedim>::set_part_active(const unsigned int part_n,
+                                                 const bool         active)
+  {
+    AssertIndexRange(part_n, n_parts());
+    parts[part_n].set_active(active);
+  }
+
+  template <int dim, int spacedim>
+  inline void
+  IFEDMethodBase<dim, spacedim>::set_surface_part_active(
+    const unsigned int surface_part_n,
+    const bool         active)
+  {
+    AssertIndexRange(surface_part_n, n_surface_parts());
+    surface_parts[surface_part_n].set_active(active);
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  IFEDMethodBase<dim, spacedim>::part_is_active(
+    const unsigned int part_n) const
+  {
+    AssertIndexRange(part_n, active_parts.size());
+    return active_parts[part_n];
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  IFEDMethodBase<dim, spacedim>::has_performance_counters() const
+  {
+    return performance_counters != nullptr;
+  }
+
+  template <int dim, int spacedim>
+  inline const PerformanceCounters &
+  IFEDMethodBase<dim, spacedim>::get_performance_counters() const
+  {
+    AssertThrow(performance_counters,
+                ExcMessage("Performance counters are not enabled."));
+    return *performance_counters;
+  }
 } // namespace fdl
 
 #endif
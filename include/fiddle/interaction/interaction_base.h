@@ -5,8 +5,10 @@
 
 #include <fiddle/grid/overlap_tria.h>
 
+#include <fiddle/transfer/overlap_partitioning_tools.h>
 #include <fiddle/transfer/scatter.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/bounding_box.h>
 
 #include <deal.II/distributed/shared_tria.h>
@@ -19,6 +21,7 @@
 
 #include <tbox/Pointer.h>
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -96,6 +99,13 @@ namespace fdl
     /// Overlap-partitioned position.
     Vector<double> overlap_position;
 
+    /// State of the position: see InteractionBase::set_position_state().
+    std::uint64_t position_state;
+
+    /// Whether or not overlap_position was copied from an earlier transaction
+    /// instead of being scattered.
+    bool position_is_cached;
+
     /// Native DoFHandler.
     SmartPointer<const DoFHandler<dim, spacedim>> native_dof_handler;
 
@@ -108,6 +118,15 @@ namespace fdl
     /// The operation used in the scatter.
     VectorOperation::values rhs_scatter_back_op;
 
+    /// Number of nodes which are no longer within one cell of their owning
+    /// patches on this processor and, once owner_check_request completes, on
+    /// all processors. Only used by NodalInteraction.
+    unsigned long long n_local_nodes_outside_owners;
+    unsigned long long n_nodes_outside_owners;
+
+    /// Request for the reduction of n_local_nodes_outside_owners.
+    MPI_Request owner_check_request = MPI_REQUEST_NULL;
+
     /// Mapping to use for the provided finite element field.
     SmartPointer<const Mapping<dim, spacedim>> mapping;
 
@@ -124,6 +143,27 @@ namespace fdl
     /// Overlap-partitioned vector used for spreading.
     Vector<double> overlap_solution;
 
+    /// Whether or not the rhs or solution is stored in single precision in
+    /// the overlap partitioning. If true then the single-precision equivalents
+    /// of the scatters and vectors above are used instead.
+    bool single_precision;
+
+    /// Single-precision scatter used for spreading.
+    Scatter<float> float_solution_scatter;
+
+    /// Single-precision scatter used for assembly.
+    Scatter<float> float_rhs_scatter;
+
+    /// Single-precision copy of the native solution (for spreading) or
+    /// temporary native rhs (for assembly).
+    LinearAlgebra::distributed::Vector<float> float_native_vector;
+
+    /// Single-precision overlap-partitioned vector used for assembly.
+    Vector<float> float_overlap_rhs;
+
+    /// Single-precision overlap-partitioned vector used for spreading.
+    Vector<float> float_overlap_solution;
+
     /// Possible states for a transaction.
     enum class State
     {
@@ -196,6 +236,93 @@ namespace fdl
     delegate_outstanding_requests() override;
   };
 
+  /**
+   * Transaction class used for computing the right-hand sides of several
+   * projections (e.g., velocity and a few scalar fields) or spreading several
+   * fields (e.g., a force and a few sources) at once. The position is only
+   * scattered once and all fields are computed in the same traversal of the
+   * Eulerian data.
+   *
+   * @note Several of the arrays owned by this class will be asynchronously
+   * written into by MPI - moving or resizing these arrays can result in program
+   * crashes. It should normally not be necessary for objects that do not set up
+   * a transaction to modify it.
+   */
+  template <int dim, int spacedim = dim>
+  struct MultiFieldTransaction : public TransactionBase
+  {
+    /// Name of the IB kernel we should use.
+    std::string kernel_name;
+
+    /// Patch indices - one per field.
+    std::vector<int> data_indices;
+
+    /// Native position DoFHandler.
+    SmartPointer<const DoFHandler<dim, spacedim>> native_position_dof_handler;
+
+    /// position scatter.
+    Scatter<double> position_scatter;
+
+    /// Native-partitioned position.
+    SmartPointer<const LinearAlgebra::distributed::Vector<double>>
+      native_position;
+
+    /// Overlap-partitioned position.
+    Vector<double> overlap_position;
+
+    /// State of the position: see InteractionBase::set_position_state().
+    std::uint64_t position_state;
+
+    /// Whether or not overlap_position was copied from an earlier transaction
+    /// instead of being scattered.
+    bool position_is_cached;
+
+    /// Native DoFHandlers - one per field.
+    std::vector<SmartPointer<const DoFHandler<dim, spacedim>>>
+      native_dof_handlers;
+
+    /// Mappings to use for the provided finite element fields.
+    std::vector<SmartPointer<const Mapping<dim, spacedim>>> mappings;
+
+    /// Scatters used for assembly - one per field.
+    std::vector<Scatter<double>> rhs_scatters;
+
+    /// The operation used in the scatters.
+    VectorOperation::values rhs_scatter_back_op;
+
+    /// Native-partitioned vectors used for assembly.
+    std::vector<SmartPointer<LinearAlgebra::distributed::Vector<double>>>
+      native_rhs;
+
+    /// Overlap-partitioned vectors used for assembly.
+    std::vector<Vector<double>> overlap_rhs;
+
+    /// Scatters used for spreading - one per field.
+    std::vector<Scatter<double>> solution_scatters;
+
+    /// Native-partitioned vectors used for spreading.
+    std::vector<SmartPointer<const LinearAlgebra::distributed::Vector<double>>>
+      native_solutions;
+
+    /// Overlap-partitioned vectors used for spreading.
+    std::vector<Vector<double>> overlap_solutions;
+
+    /// Possible states for a transaction.
+    using State = typename Transaction<dim, spacedim>::State;
+
+    /// Next state. Used for consistency checking.
+    State next_state;
+
+    /// Possible operations.
+    using Operation = typename Transaction<dim, spacedim>::Operation;
+
+    /// Operation of the current transaction. Used for consistency checking.
+    Operation operation;
+
+    virtual std::vector<MPI_Request>
+    delegate_outstanding_requests() override;
+  };
+
   /**
    * Base class managing interaction between SAMRAI and deal.II data structures,
    * by interpolation and spreading, where the position of the structure is
@@ -231,12 +358,43 @@ namespace fdl
     /**
      * Constructor. This call is collective.
      *
-     * @param[in] input_db Input database. The only value read from the database
-     *            is ghost_cell_fraction, which controls the fraction of ghost
+     * @param[in] input_db Input database. The values read from the database
+     *            are ghost_cell_fraction, which controls the fraction of ghost
      *            cells added to each patch boundary box for the purposes of
-     *            associating nodes or elements with a given patch. The default
+     *            associating nodes or elements with a given patch (the default
      *            value is 1.0, which is typically the correct value for
-     *            problems with moving meshes.
+     *            problems with moving meshes) and scatter_backend, which
+     *            controls how the Scatter objects used to move data between
+     *            the native and overlap partitionings communicate (one of
+     *            POINT_TO_POINT, PERSISTENT, or NEIGHBOR_COLLECTIVE - the
+     *            default is POINT_TO_POINT, see ScatterBackend for more
+     *            information), and single_precision_overlap, which controls
+     *            whether or not single-field right-hand sides and solutions are
+     *            communicated and stored in single precision in the overlap
+     *            partitioning (the default is false). Native vectors are
+     *            always stored in double precision and the contribution of
+     *            each cell is always computed in double precision. This option
+     *            has no effect unless supports_single_precision() returns
+     *            true. Finally, workload_point_weight and workload_cell_weight
+     *            (defaults 1.0 and 0.0) are the relative costs of each
+     *            interaction point and each element used by
+     *            add_workload_start(): see count_quadrature_points() for more
+     *            information. Nodal interactions ignore the element cost.
+     *            If distributed_bbox_exchange is true (the default is false)
+     *            then the overlap triangulation is computed from bounding
+     *            boxes sent by their owners with
+     *            exchange_intersecting_active_cell_bboxes() instead of from
+     *            @p global_active_cell_bboxes, which is then only accessed for
+     *            locally owned cells. interaction_cells restricts the
+     *            interaction to a subset of the cells: one of ALL (the
+     *            default), BOUNDARY (cells with at least one face on the
+     *            boundary), or MATERIAL_IDS (cells whose material id is listed
+     *            in the integer array interaction_material_ids). Only the
+     *            selected cells are added to the overlap triangulation, so
+     *            projections and spreading only use those cells. Solving the
+     *            resulting projection with the mass matrix of the whole part
+     *            is still consistent. At the present time only
+     *            ElementalInteraction supports this option.
      *
      * @param[in] native_tria The Triangulation used to define the finite
      *            element fields. This class will use the same MPI communicator
@@ -264,8 +422,8 @@ namespace fdl
     InteractionBase(
       const tbox::Pointer<tbox::Database>                  &input_db,
       const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-      const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
-      const std::vector<float>                             &active_cell_lengths,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
+      const ArrayView<const float>                         &active_cell_lengths,
       tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
       const std::pair<int, int>                            &level_numbers);
 
@@ -273,12 +431,13 @@ namespace fdl
      * Reinitialize the object. Same as the constructor.
      */
     virtual void
-    reinit(const tbox::Pointer<tbox::Database>                  &input_db,
-           const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-           const std::vector<BoundingBox<spacedim, float>> &active_cell_bboxes,
-           const std::vector<float>                        &active_cell_lengths,
-           tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
-           const std::pair<int, int>                       &level_number);
+    reinit(
+      const tbox::Pointer<tbox::Database>                  &input_db,
+      const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
+      const ArrayView<const float>                         &active_cell_lengths,
+      tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
+      const std::pair<int, int>                            &level_number);
 
     /**
      * Destructor.
@@ -289,6 +448,18 @@ namespace fdl
      * Store a pointer to @p native_dof_handler and also compute the
      * equivalent DoFHandler on the overlapping partitioning.
      *
+     * If the overlap triangulation was not rebuilt by the last call to
+     * reinit() and @p native_dof_handler was also registered before that call
+     * then the previous overlap DoFHandler, DoF translation, and Scatter
+     * objects are reused. Since this class cannot detect DoF renumbering this
+     * assumes that the DoFs of @p native_dof_handler are not redistributed
+     * while it is registered.
+     *
+     * Similarly, if @p native_dof_handler uses the same FE and assigns the
+     * same DoFs to each cell as an already registered DoFHandler then both
+     * share the same overlap DoFHandler, DoF translation, and Scatter
+     * objects.
+     *
      * This call is collective over the communicator used by this class.
      */
     virtual void
@@ -302,6 +473,15 @@ namespace fdl
     virtual bool
     projection_is_interpolation() const;
 
+    /**
+     * Whether or not the force should be spread in its weak form, i.e., the
+     * load vector should be converted to a nodal force with the lumped mass
+     * matrix instead of solving the consistent mass system. Defaults to
+     * returning false.
+     */
+    virtual bool
+    spreads_weak_force() const;
+
     /**
      * Start the computation of the RHS vector corresponding to projecting @p
      * data_idx onto the finite element space specified by @p dof_handler. Since
@@ -361,6 +541,50 @@ namespace fdl
     compute_projection_rhs_accumulate_finish(
       std::unique_ptr<TransactionBase> transaction);
 
+    /**
+     * Start the computation of the RHS vectors corresponding to projecting each
+     * entry of @p data_indices onto the finite element space specified by the
+     * corresponding entry of @p dof_handlers. The returned transaction is
+     * advanced with the same functions (e.g.,
+     * compute_projection_rhs_scatter_finish()) as a single-field transaction.
+     *
+     * This is more efficient than setting up one transaction per field since
+     * the position is only communicated once and inheriting classes may
+     * compute all right-hand sides in one pass over the Eulerian data.
+     *
+     * @note Not every inheriting class supports this: see
+     * supports_multiple_fields().
+     *
+     * @warning The Transaction returned by this method stores pointers to all
+     * of the input arguments. Those pointers must remain valid until after
+     * compute_projection_rhs_accumulate_finish() is called.
+     */
+    virtual std::unique_ptr<TransactionBase>
+    compute_projection_rhs_scatter_start(
+      const std::string                                &kernel_name,
+      const std::vector<int>                           &data_indices,
+      const DoFHandler<dim, spacedim>                  &position_dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+      const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &rhs);
+
+    /**
+     * Whether or not this class can compute multiple projections, or spread
+     * multiple fields, with a single transaction. Defaults to returning false.
+     */
+    virtual bool
+    supports_multiple_fields() const;
+
+    /**
+     * Whether or not this class can store overlap-partitioned right-hand sides
+     * and solutions in single precision (i.e., whether or not the
+     * single_precision_overlap input database option has any effect). Defaults
+     * to returning false.
+     */
+    virtual bool
+    supports_single_precision() const;
+
     /**
      * Start spreading from the provided finite element field @p solution by
      * adding them onto the SAMRAI data index @p data_idx.
@@ -386,6 +610,35 @@ namespace fdl
       const DoFHandler<dim, spacedim>                  &dof_handler,
       const LinearAlgebra::distributed::Vector<double> &solution);
 
+    /**
+     * Start spreading each entry of @p solutions, which is defined by the
+     * corresponding entries of @p dof_handlers and @p mappings, into the
+     * corresponding entry of @p data_indices. The returned transaction is
+     * advanced with the same functions (e.g., compute_spread_scatter_finish())
+     * as a single-field transaction.
+     *
+     * This is more efficient than setting up one transaction per field since
+     * the position is only communicated once and inheriting classes may
+     * spread all fields in one pass over the Eulerian data.
+     *
+     * @note Not every inheriting class supports this: see
+     * supports_multiple_fields().
+     *
+     * @warning The Transaction returned by this method stores pointers to all
+     * of the input arguments. Those pointers must remain valid until after
+     * compute_spread_finish() is called.
+     */
+    virtual std::unique_ptr<TransactionBase>
+    compute_spread_scatter_start(
+      const std::string                                &kernel_name,
+      const std::vector<int>                           &data_indices,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const DoFHandler<dim, spacedim>                  &position_dof_handler,
+      const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+      const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &solutions);
+
     /**
      * Finish the scatter to the overlap representation for spreading.
      */
@@ -432,6 +685,51 @@ namespace fdl
     virtual void
     add_workload_finish(std::unique_ptr<TransactionBase> t_ptr);
 
+    /**
+     * Return the number of interaction points and the number of elements on
+     * the patches owned by the current processor, e.g., for calibrating the
+     * workload estimate (see WorkloadCalibration). Points and elements on
+     * more than one patch are counted once per patch. Has a default
+     * implementation which returns zeros.
+     */
+    virtual std::pair<double, double>
+    count_local_interaction_work();
+
+    /**
+     * Set the workload weights (i.e., override the values of
+     * workload_point_weight and workload_cell_weight read from the input
+     * database).
+     */
+    void
+    set_workload_weights(const double point_weight, const double cell_weight);
+
+    /**
+     * Return an estimate of the number of bytes used by this object, i.e., the
+     * overlap triangulation, the overlap DoFHandlers and their translations to
+     * native DoFs, Scatter objects, and cached vectors. Inheriting classes
+     * should override this function to add their own data (e.g., PatchMap
+     * objects).
+     */
+    virtual std::size_t
+    memory_consumption() const;
+
+    /**
+     * Identify the position passed to the next interpolation or spreading
+     * transaction. If @p position_state is nonzero and equal to the state of
+     * the position used by the last transaction then, rather than scattering
+     * the position again, that transaction's overlap-partitioned position is
+     * reused. For example, for the midpoint rule, the force is spread and the
+     * velocity is interpolated at the same position, so the position only
+     * needs to be scattered once per time step.
+     *
+     * The state only applies to the next transaction. Since skipping the
+     * scatter is only valid if every processor skips it, @p position_state
+     * must be the same on every processor and must change whenever the
+     * position does (see, e.g., PartVectors::get_position_state()).
+     */
+    void
+    set_position_state(const std::uint64_t position_state);
+
   protected:
     /**
      * One difficulty with the way communication is implemented in deal.II is
@@ -450,6 +748,37 @@ namespace fdl
      */
     MPI_Comm communicator;
 
+    /**
+     * If possible, move the DoF data of @p native_dof_handler from before the
+     * last call to reinit() back into the current DoF data: see
+     * add_dof_handler().
+     *
+     * @return Whether or not the previous data was reused.
+     */
+    bool
+    reuse_previous_dof_handler(
+      const DoFHandler<dim, spacedim> &native_dof_handler);
+
+    /**
+     * If @p native_dof_handler has the same DoFs as an already registered
+     * DoFHandler, register it with the same overlap DoF data: see
+     * add_dof_handler(). This function is collective.
+     *
+     * @return Whether or not existing data is shared.
+     */
+    bool
+    share_overlap_dof_handler(
+      const DoFHandler<dim, spacedim> &native_dof_handler);
+
+    /**
+     * Return the OverlapCellExchange of overlap_tria, which is computed the
+     * first time this function is called after the overlap triangulation
+     * changes and then shared by all DoFHandlers. This function is
+     * collective in that case.
+     */
+    const OverlapCellExchange &
+    get_overlap_cell_exchange();
+
     /**
      * Return a reference to the overlap dof handler corresponding to the
      * provided native dof handler.
@@ -489,6 +818,56 @@ namespace fdl
     return_scatter(const DoFHandler<dim, spacedim> &native_dof_handler,
                    Scatter<double>                &&scatter);
 
+    /**
+     * Same as get_scatter(), but for single-precision vectors.
+     */
+    Scatter<float>
+    get_float_scatter(const DoFHandler<dim, spacedim> &native_dof_handler);
+
+    /**
+     * Re-cache a single-precision Scatter object.
+     */
+    void
+    return_scatter(const DoFHandler<dim, spacedim> &native_dof_handler,
+                   Scatter<float>                 &&scatter);
+
+    /**
+     * Return a new Transaction, reusing one returned by return_transaction()
+     * (and hence the storage of its vectors) if possible.
+     */
+    std::unique_ptr<Transaction<dim, spacedim>>
+    get_transaction();
+
+    /**
+     * Re-cache a finished transaction so that get_transaction() can reuse
+     * it. Transactions which are not Transaction objects are destroyed.
+     */
+    void
+    return_transaction(std::unique_ptr<TransactionBase> t_ptr);
+
+    /**
+     * Whether or not new transactions should store overlap-partitioned
+     * right-hand sides and solutions in single precision.
+     */
+    bool
+    use_single_precision() const;
+
+    /**
+     * Start scattering the position of @p transaction to the overlap
+     * partitioning or, if possible, copy the cached overlap position instead.
+     */
+    template <typename TransactionType>
+    void
+    start_position_scatter(TransactionType &transaction);
+
+    /**
+     * Finish the scatter started by start_position_scatter() and cache the
+     * result.
+     */
+    template <typename TransactionType>
+    void
+    finish_position_scatter(TransactionType &transaction) const;
+
     /**
      * @name Geometric data.
      * @{
@@ -506,6 +885,18 @@ namespace fdl
      */
     OverlapTriangulation<dim, spacedim> overlap_tria;
 
+    /**
+     * Bounding boxes of the active cells of overlap_tria, in active cell
+     * order. Only computed (and otherwise empty) when the
+     * distributed_bbox_exchange input database option is true.
+     */
+    std::vector<BoundingBox<spacedim, float>> overlap_active_cell_bboxes;
+
+    /**
+     * Native cells needed by overlap_tria: see get_overlap_cell_exchange().
+     */
+    std::unique_ptr<OverlapCellExchange> overlap_cell_exchange;
+
     /**
      * Pointer to the patch hierarchy.
      */
@@ -532,6 +923,14 @@ namespace fdl
     std::vector<SmartPointer<const DoFHandler<dim, spacedim>>>
       native_dof_handlers;
 
+    /**
+     * Index into overlap_dof_handlers, overlap_to_native_dof_translations,
+     * scatters, and float_scatters of the data used by each entry of
+     * native_dof_handlers. Native DoFHandlers with the same DoFs share the
+     * same data.
+     */
+    std::vector<std::size_t> overlap_dof_indices;
+
     /**
      * DoFHandlers defined on the overlap tria, which are equivalent to those
      * stored by @p native_dof_handlers.
@@ -547,9 +946,88 @@ namespace fdl
 
     /**
      * Scatter objects for moving vectors between native and overlap
-     * representations. Indexed first by the number of the dof handler.
+     * representations. Indexed first by the number of the overlap dof
+     * handler.
      */
     std::vector<std::vector<Scatter<double>>> scatters;
+
+    /**
+     * Same as scatters, but for single-precision vectors.
+     */
+    std::vector<std::vector<Scatter<float>>> float_scatters;
+
+    /**
+     * Finished transactions whose overlap and single-precision vectors are
+     * reused by new transactions, since allocating them in every time step
+     * is expensive. Cleared by reinit().
+     */
+    std::vector<std::unique_ptr<Transaction<dim, spacedim>>> transactions;
+
+    /**
+     * DoF data from before the last call to reinit(), which is either reused
+     * by add_dof_handler() or destroyed if the overlap triangulation is
+     * rebuilt.
+     * @{
+     */
+    std::vector<SmartPointer<const DoFHandler<dim, spacedim>>>
+      previous_native_dof_handlers;
+
+    std::vector<std::size_t> previous_overlap_dof_indices;
+
+    std::vector<std::unique_ptr<DoFHandler<dim, spacedim>>>
+      previous_overlap_dof_handlers;
+
+    std::vector<std::vector<types::global_dof_index>>
+      previous_overlap_to_native_dof_translations;
+
+    std::vector<std::vector<Scatter<double>>> previous_scatters;
+
+    std::vector<std::vector<Scatter<float>>> previous_float_scatters;
+    /**
+     * @}
+     */
+
+    /**
+     * Communication backend used by new Scatter objects.
+     */
+    ScatterBackend scatter_backend;
+
+    /**
+     * Whether or not overlap-partitioned right-hand sides and solutions should
+     * be stored in single precision, if supported by the inheriting class.
+     */
+    bool single_precision_overlap;
+
+    /**
+     * Workload added for each interaction point.
+     */
+    double workload_point_weight;
+
+    /**
+     * Workload added for each element.
+     */
+    double workload_cell_weight;
+    /**
+     * @}
+     */
+
+    /**
+     * State of the position used by the next transaction: see
+     * set_position_state().
+     */
+    std::uint64_t next_position_state;
+
+    /**
+     * Overlap-partitioned position (and its state and native DoFHandler) of
+     * the last transaction started with a nonzero position state. Cleared by
+     * reinit().
+     * @{
+     */
+    mutable std::uint64_t cached_position_state;
+
+    mutable const DoFHandler<dim, spacedim> *cached_position_dof_handler;
+
+    mutable Vector<double> cached_overlap_position;
     /**
      * @}
      */
@@ -3,11 +3,17 @@
 
 #include <fiddle/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/bounding_box.h>
+#include <deal.II/base/point.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/std_cxx17/optional.h>
 
+#include <deal.II/lac/vector.h>
+
+#include <array>
 #include <memory>
+#include <string>
 #include <vector>
 
 // forward declarations
@@ -17,6 +23,12 @@ namespace fdl
   class NodalPatchMap;
   template <int, int>
   class PatchMap;
+
+  namespace internal
+  {
+    template <int>
+    struct PatchSingleIntersections;
+  }
 } // namespace fdl
 
 namespace dealii
@@ -25,17 +37,17 @@ namespace dealii
   class DoFHandler;
   template <int, int>
   class Mapping;
-  template <typename>
-  class Vector;
 } // namespace dealii
 
 namespace SAMRAI
 {
   namespace hier
   {
+    template <int>
+    class Patch;
     template <int>
     class PatchLevel;
-  }
+  } // namespace hier
 
   namespace tbox
   {
@@ -53,15 +65,406 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  /**
+   * Precomputed description of where the quadrature points of each cell
+   * stored by a PatchMap are located in the current configuration.
+   *
+   * Computing quadrature points requires evaluating a MappingFEField on each
+   * cell, and without this information the interaction functions call
+   * ib_interpolate() or ib_spread() once per cell, which repeats the same
+   * patch-level setup (box lookups, ghost region checks, etc.) for every
+   * element. With an InteractionPlan both of these happen once per patch: the
+   * points are computed once by compute_interaction_plan() and then passed to
+   * ib_interpolate() or ib_spread() in a single call per patch.
+   *
+   * A plan is only valid for the PatchMap, quadrature indices, and position
+   * vector with which it was computed.
+   */
+  template <int dim, int spacedim = dim>
+  struct InteractionPlan
+  {
+    /**
+     * Quadrature points, in the current configuration, of all cells on each
+     * patch. Cells are stored in the same order as the PatchMap iterators.
+     */
+    std::vector<std::vector<Point<spacedim>>> patch_q_points;
+
+    /**
+     * Offsets into patch_q_points: the quadrature points of the ith cell on
+     * patch p are in the range [patch_cell_offsets[p][i],
+     * patch_cell_offsets[p][i + 1]).
+     */
+    std::vector<std::vector<unsigned int>> patch_cell_offsets;
+
+    /**
+     * Position vector with which the plan was computed.
+     */
+    Vector<double> position;
+
+    /**
+     * Optional JxW values of all quadrature points on each patch, stored in
+     * the same order as patch_q_points and computed by
+     * compute_interaction_plan_weights() with the mapping of the interacting
+     * field.
+     *
+     * That mapping typically describes the reference configuration, so,
+     * unlike the quadrature points, these values do not depend on the
+     * position and are kept when compute_interaction_plan() is called again.
+     * If they are available (and were computed with the same mapping) then
+     * the plan-based interaction functions use them, along with the values of
+     * the shape functions on the reference cell, instead of reinitializing an
+     * FEValues object on each cell. This is particularly useful for
+     * codimension-one parts, whose elements are typically much smaller than
+     * the Eulerian cells and therefore have very few quadrature points each.
+     */
+    std::vector<std::vector<double>> patch_JxW;
+
+    /**
+     * Mapping with which patch_JxW was computed.
+     */
+    const Mapping<dim, spacedim> *weights_mapping = nullptr;
+
+    /**
+     * Optional compressed quadrature points of each patch, computed by
+     * compress_interaction_plan(): each compressed point represents all
+     * quadrature points of the patch in one small region of an Eulerian cell.
+     * Unlike patch_JxW, these depend on the position and are discarded when
+     * compute_interaction_plan() is called again.
+     */
+    std::vector<std::vector<Point<spacedim>>> patch_compressed_q_points;
+
+    /**
+     * Index into patch_compressed_q_points of the point representing each
+     * quadrature point, stored in the same order as patch_q_points.
+     */
+    std::vector<std::vector<unsigned int>> patch_q_point_representatives;
+
+    /**
+     * Return whether or not the plan has been computed.
+     */
+    bool
+    empty() const;
+
+    /**
+     * Return whether or not the plan contains compressed quadrature points.
+     */
+    bool
+    is_compressed() const;
+
+    /**
+     * Return whether or not the plan contains JxW values computed with
+     * @p mapping.
+     */
+    bool
+    has_weights_for(const Mapping<dim, spacedim> &mapping) const;
+
+    /**
+     * Return whether or not the plan can be used with the given position: i.e.,
+     * whether or not no entry of @p new_position differs from the stored
+     * position by more than @p tolerance.
+     *
+     * @note A tolerance of zero means that the plan is only reused when the
+     * position is unchanged, in which case using the plan is exact.
+     */
+    bool
+    is_valid_for(const Vector<double> &new_position,
+                 const double          tolerance) const;
+
+    /**
+     * Clear all stored data.
+     */
+    void
+    clear();
+
+    /**
+     * Return the number of bytes used by the plan.
+     */
+    std::size_t
+    memory_consumption() const;
+  };
+
+  /**
+   * Compute an InteractionPlan.
+   *
+   * @param[in] patch_map The mapping between SAMRAI patches and deal.II cells.
+   *
+   * @param[in] position_dof_handler DoFHandler for the position field.
+   *
+   * @param[in] position Finite element field describing the current
+   * configuration of the mesh.
+   *
+   * @param[in] quadrature_indices This vector is indexed by the active cell
+   * index - the value is the index into @p quadratures corresponding to the
+   * correct quadrature rule on that cell.
+   *
+   * @param[in] quadratures The vector of quadratures we use for interaction.
+   *
+   * @param[out] plan The computed plan.
+   *
+   * @note If the position finite element is primitive (which is the usual
+   * case, e.g., FESystem(FE_Q(1), spacedim)) then the quadrature points are
+   * computed directly from @p position and the values of the shape functions
+   * on the reference cell, i.e., as a product of a precomputed (number of
+   * quadrature points) by (number of DoFs per cell) matrix with the position
+   * DoFs of each cell, instead of with FEValues.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_interaction_plan(
+    const PatchMap<dim, spacedim>      &patch_map,
+    const DoFHandler<dim, spacedim>    &position_dof_handler,
+    const Vector<double>               &position,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    InteractionPlan<dim, spacedim>     &plan);
+
+  /**
+   * Compute the JxW values stored in an InteractionPlan (see
+   * InteractionPlan::patch_JxW).
+   *
+   * @param[in] dof_handler DoFHandler of a field defined on the same
+   * Triangulation as @p patch_map.
+   *
+   * @param[in] mapping Mapping with which the field is integrated. Only the
+   * address of this object is stored, so it must outlive the plan.
+   *
+   * @note The plan-based functions only use these values for primitive finite
+   * elements (e.g., FE_Q, FE_SimplexP, or FESystems of them), whose shape
+   * function values do not depend on the mapping.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_interaction_plan_weights(
+    const PatchMap<dim, spacedim>      &patch_map,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    InteractionPlan<dim, spacedim>     &plan);
+
+  /**
+   * Compress the quadrature points stored in an InteractionPlan (see
+   * InteractionPlan::patch_compressed_q_points). This is useful when the
+   * Lagrangian mesh is much finer than the Eulerian grid, in which case the
+   * cost of interaction is dominated by the IB kernel evaluations at hundreds
+   * of quadrature points per Eulerian cell.
+   *
+   * Each Eulerian cell of each patch is divided into sub-cells whose width in
+   * each coordinate direction is @p tolerance times the grid spacing, and all
+   * quadrature points in the same sub-cell are replaced by their centroid.
+   * The plan-based compute_spread() then spreads the sum of the values at
+   * those points from the centroid and the plan-based
+   * compute_projection_rhs() uses the value interpolated at the centroid for
+   * each of them. Since the kernels are smooth, the error in each kernel
+   * weight is proportional to @p tolerance. The total spread force is
+   * preserved exactly.
+   *
+   * @param[in] tolerance Width of the sub-cells relative to the Eulerian grid
+   * spacing, which must be in (0, 1].
+   *
+   * @param[inout] plan A plan computed by compute_interaction_plan() with
+   * @p patch_map.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compress_interaction_plan(const PatchMap<dim, spacedim>  &patch_map,
+                            const double                    tolerance,
+                            InteractionPlan<dim, spacedim> &plan);
+
+  /**
+   * Assembled interpolation operator: i.e., the matrix which maps the values
+   * of a SAMRAI variable on the patches stored by a PatchMap to the
+   * right-hand side computed by compute_projection_rhs(). Spreading is, up to
+   * the inverse of the volume of an Eulerian cell, multiplication by the
+   * transpose of this matrix.
+   *
+   * Assembling the operator costs about as much as a single projection, since
+   * it requires the kernel weights, shape function values, and JxW values at
+   * every quadrature point, but afterwards each projection or spreading
+   * operation is just a sparse matrix-vector product. This is useful for
+   * parts which barely move (e.g., stiff walls or tethered parts): with a
+   * nonzero tolerance (see is_valid_for()) an operator can be reused for many
+   * time steps.
+   *
+   * The matrix is stored in blocks: the block of the ith cell of a patch (in
+   * the order of the PatchMap iterators) and component c is a dense matrix
+   * which maps the values of component c at the Eulerian DoFs which interact
+   * with that cell to the cell's DoFs of component c.
+   *
+   * An operator is only valid for the PatchMap, quadrature indices, position,
+   * kernel, patch data index, DoFHandler, and Mapping with which it was
+   * computed.
+   */
+  template <int dim, int spacedim = dim>
+  struct InteractionOperator
+  {
+    /**
+     * Offsets into patch_columns: the columns of block <code>b = i *
+     * n_components + c</code> on patch p are in the range
+     * [patch_column_offsets[p][b], patch_column_offsets[p][b + 1]).
+     */
+    std::vector<std::vector<unsigned int>> patch_column_offsets;
+
+    /**
+     * Columns of each block, i.e., offsets relative to the start of the
+     * array of the corresponding component (see ib_compute_weights()).
+     */
+    std::vector<std::vector<int>> patch_columns;
+
+    /**
+     * Offsets into patch_values, indexed in the same way as
+     * patch_column_offsets.
+     */
+    std::vector<std::vector<std::size_t>> patch_value_offsets;
+
+    /**
+     * Entries of each block, stored in row-major order. The rows of a block
+     * of component c correspond to the cell DoFs component_dofs[c].
+     */
+    std::vector<std::vector<double>> patch_values;
+
+    /**
+     * Cell DoFs of each component of the finite element.
+     */
+    std::vector<std::vector<unsigned int>> component_dofs;
+
+    /**
+     * Kernel, patch data index, DoFHandler, and Mapping with which the
+     * operator was computed.
+     * @{
+     */
+    std::string                      kernel_name;
+    int                              data_index  = -1;
+    const DoFHandler<dim, spacedim> *dof_handler = nullptr;
+    const Mapping<dim, spacedim>    *mapping     = nullptr;
+    /**
+     * @}
+     */
+
+    /**
+     * Position vector with which the operator was computed.
+     */
+    Vector<double> position;
+
+    /**
+     * Return whether or not the operator has been computed.
+     */
+    bool
+    empty() const;
+
+    /**
+     * Return whether or not the operator was computed with the given kernel,
+     * patch data index, DoFHandler, and Mapping.
+     */
+    bool
+    is_for(const std::string               &kernel_name,
+           const int                        data_index,
+           const DoFHandler<dim, spacedim> &dof_handler,
+           const Mapping<dim, spacedim>    &mapping) const;
+
+    /**
+     * Return whether or not the operator can be used with the given position.
+     * This is the same check as InteractionPlan::is_valid_for().
+     */
+    bool
+    is_valid_for(const Vector<double> &new_position,
+                 const double          tolerance) const;
+
+    /**
+     * Clear all stored data.
+     */
+    void
+    clear();
+
+    /**
+     * Return the number of bytes used by the operator.
+     */
+    std::size_t
+    memory_consumption() const;
+  };
+
+  /**
+   * Statistics describing the points skipped by compute_spread() when it is
+   * called with a positive spread cutoff. In addition to the number of
+   * points, these record the sums of the magnitudes of the spread values
+   * (i.e., the norms of the forces times the JxW values). Since spreading
+   * conserves the total force, skipped_magnitude bounds the magnitude of the
+   * change in the total force caused by the cutoff.
+   *
+   * compute_spread() adds to these values, so the statistics of several calls
+   * can be accumulated in one object.
+   */
+  struct SpreadCutoffStatistics
+  {
+    /**
+     * Number of points considered.
+     */
+    std::size_t n_points = 0;
+
+    /**
+     * Number of points which were not spread.
+     */
+    std::size_t n_skipped_points = 0;
+
+    /**
+     * Sum of the magnitudes of the values at all points considered.
+     */
+    double total_magnitude = 0.0;
+
+    /**
+     * Sum of the magnitudes of the values at the points which were not
+     * spread.
+     */
+    double skipped_magnitude = 0.0;
+  };
+
+  /**
+   * Compute an InteractionOperator from the quadrature points stored in
+   * @p plan. The other arguments are the same as those of
+   * compute_projection_rhs().
+   *
+   * @note This function requires a primitive finite element with one or
+   * spacedim components and cell-centered or side-centered data which can be
+   * interpolated by fiddle's own kernels (see ib_compute_weights()). In
+   * particular, patches may not touch periodic boundaries.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_interaction_operator(
+    const std::string                    &kernel_name,
+    const int                             data_index,
+    const PatchMap<dim, spacedim>        &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    InteractionOperator<dim, spacedim>   &op);
+
   /**
    * Tag cells in the patch hierarchy that intersect the provided bounding
    * boxes.
+   *
+   * @param[in] buffer Number of cells (on @p patch_level) by which each
+   * bounding box is grown before tagging.
    */
   template <int spacedim, typename Number>
   void
   tag_cells(const std::vector<BoundingBox<spacedim, Number>> &bboxes,
             const int                                         tag_index,
-            tbox::Pointer<hier::PatchLevel<spacedim>>        &patch_level);
+            tbox::Pointer<hier::PatchLevel<spacedim>>        &patch_level,
+            const int                                         buffer = 0);
+
+  /**
+   * Same as above, but for bounding boxes in an ArrayView (e.g., ones stored
+   * in memory shared between processors).
+   */
+  template <int spacedim, typename Number>
+  void
+  tag_cells(const ArrayView<const BoundingBox<spacedim, Number>> &bboxes,
+            const int                                             tag_index,
+            tbox::Pointer<hier::PatchLevel<spacedim>>            &patch_level,
+            const int                                             buffer = 0);
 
   /**
    * Add the number of quadrature points.
@@ -85,6 +488,18 @@ namespace fdl
    *
    * @param[in] quadratures The vector of quadratures we use for interaction.
    *
+   * @param[in] point_weight Amount added for each quadrature point (e.g., the
+   * relative cost of interpolating to or spreading from it).
+   *
+   * @param[in] cell_weight Amount added for each element (e.g., the relative
+   * cost of computing its stresses). This is split evenly between the
+   * element's quadrature points, so each point adds
+   * <code>point_weight + cell_weight / n_q_points</code> to the cell it lies
+   * in.
+   *
+   * @note Non-integer weights require that the variable corresponding to
+   * @p qp_data_index has floating-point type.
+   *
    * @note This is a purely local operation since we always assume a PatchMap
    * stores every element that intersects with the interior of a patch.
    */
@@ -94,7 +509,22 @@ namespace fdl
                           PatchMap<dim, spacedim>          &patch_map,
                           const Mapping<dim, spacedim>     &position_mapping,
                           const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<dim>> &quadratures);
+                          const std::vector<Quadrature<dim>> &quadratures,
+                          const double point_weight = 1.0,
+                          const double cell_weight  = 0.0);
+
+  /**
+   * Same as the other count_quadrature_points() function, but uses quadrature
+   * points precomputed by compute_interaction_plan() instead of computing
+   * them from a position mapping.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  count_quadrature_points(const int                             qp_data_index,
+                          PatchMap<dim, spacedim>              &patch_map,
+                          const InteractionPlan<dim, spacedim> &plan,
+                          const double point_weight = 1.0,
+                          const double cell_weight  = 0.0);
 
   /**
    * Count the number of nodes in each patch.
@@ -105,12 +535,17 @@ namespace fdl
    * @param[in] nodal_patch_map Mapping between patches and DoFs.
    *
    * @param[in] position Nodal coordinates in node-first ordering.
+   *
+   * @param[in] node_weight Amount added for each node. Like
+   * count_quadrature_points(), non-integer weights require floating-point
+   * data.
    */
   template <int dim, int spacedim>
   void
   count_nodes(const int                     node_count_data_index,
               NodalPatchMap<dim, spacedim> &nodal_patch_map,
-              const Vector<double>         &position);
+              const Vector<double>         &position,
+              const double                  node_weight = 1.0);
 
   /**
    * Compute the right-hand side used to project the velocity from Eulerian to
@@ -138,14 +573,27 @@ namespace fdl
    * @param[in] mapping Mapping for computing values of the finite element
    * field on the reference configuration.
    *
-   * @param[out] rhs The load vector populated by this operation.
+   * @param[out] rhs The load vector populated by this operation. This may be
+   * stored in single precision: the contribution of each cell is always
+   * computed in double precision before it is added to @p rhs.
+   *
+   * @param[in] n_threads Number of threads used to interpolate. Since the
+   * cost of different patches may differ by orders of magnitude, the finite
+   * element computations on the cells of each patch are split into small
+   * chunks which are handed out to threads dynamically. Each patch's values
+   * are interpolated by one thread with a single kernel call, starting with
+   * the patches with the most quadrature points. The contributions of the
+   * cells are stored and added to @p rhs in the same order as with one
+   * thread, so the result is bitwise identical for any number of threads.
+   * This parameter has no effect unless fiddle is compiled with OpenMP
+   * support.
    *
    * @note In general, an OverlappingTriangulation has no knowledge of whether
    * or not DoFs on its boundaries should be constrained. Hence information must
    * first be communicated between processes and then constraints should be
    * applied.
    */
-  template <int dim, int spacedim = dim>
+  template <int dim, int spacedim = dim, typename Number = double>
   void
   compute_projection_rhs(const std::string                  &kernel_name,
                          const int                           data_index,
@@ -155,7 +603,60 @@ namespace fdl
                          const std::vector<Quadrature<dim>> &quadratures,
                          const DoFHandler<dim, spacedim>    &dof_handler,
                          const Mapping<dim, spacedim>       &mapping,
-                         Vector<double>                     &rhs);
+                         Vector<Number>                     &rhs,
+                         const unsigned int                  n_threads = 1);
+
+  /**
+   * Same as the other compute_projection_rhs() function, but uses quadrature
+   * points precomputed by compute_interaction_plan() instead of computing them
+   * from a position mapping.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  void
+  compute_projection_rhs(const std::string                    &kernel_name,
+                         const int                             data_index,
+                         const PatchMap<dim, spacedim>        &patch_map,
+                         const InteractionPlan<dim, spacedim> &plan,
+                         const std::vector<unsigned char> &quadrature_indices,
+                         const std::vector<Quadrature<dim>> &quadratures,
+                         const DoFHandler<dim, spacedim>    &dof_handler,
+                         const Mapping<dim, spacedim>       &mapping,
+                         Vector<Number>                     &rhs);
+
+  /**
+   * Same as the previous function, but computes the right-hand sides of
+   * several fields at once: i.e., the ith entry of @p rhs is computed by
+   * interpolating @p data_indices[i] onto the finite element space defined by
+   * @p dof_handlers[i] and @p mappings[i].
+   *
+   * Since every field is computed during the same traversal of the PatchMap,
+   * work which only depends on the patch or cell (like looking up patches or
+   * evaluating finite element shape functions for fields which use the same
+   * FiniteElement and Mapping) is only done once.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_projection_rhs(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    const PatchMap<dim, spacedim>                        &patch_map,
+    const InteractionPlan<dim, spacedim>                 &plan,
+    const std::vector<unsigned char>                     &quadrature_indices,
+    const std::vector<Quadrature<dim>>                   &quadratures,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<Vector<double> *>                  &rhs);
+
+  /**
+   * Same as the other compute_projection_rhs() functions, but multiplies the
+   * Eulerian data by an InteractionOperator: the kernel, patch data index,
+   * and DoFHandler are the ones with which @p op was computed.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  void
+  compute_projection_rhs(const InteractionOperator<dim, spacedim> &op,
+                         const PatchMap<dim, spacedim>            &patch_map,
+                         Vector<Number>                           &rhs);
 
   /**
    * Interpolate Eulerian data at specified Lagrangian points.
@@ -173,6 +674,21 @@ namespace fdl
    * vector and `spacedim`.
    *
    * @param[out] interpolated_values Vector of values interpolated at each node.
+   * If owners are used (see @p use_owners) then each node is only
+   * interpolated by its owning patch and all other values are zero. Otherwise
+   * values which are not interpolated are -DBL_MAX.
+   *
+   * @param[in] n_threads Number of threads used to interpolate. Patches are
+   * handed out to threads dynamically. Threads are only used if @p patch_map
+   * has owners, since only then is each node interpolated by exactly one
+   * patch, and the result does not depend on the number of threads. This
+   * parameter has no effect unless fiddle is compiled with OpenMP support.
+   *
+   * @param[in] use_owners If true and @p patch_map has owners (see
+   * NodalPatchMap::get_owned_dofs()) then only interpolate each node on its
+   * owning patch. Owned nodes which have moved more than one cell outside of
+   * their patch (see NodalPatchMap::count_nodes_outside_owners()) are not
+   * interpolated, so callers should set this to false when there are any.
    *
    * @note While this function does not directly use any finite element data
    * structures (such as a DoFHandler or FiniteElement), it does assume that we
@@ -186,7 +702,9 @@ namespace fdl
                               const int                           data_index,
                               const NodalPatchMap<dim, spacedim> &patch_map,
                               const Vector<double>               &position,
-                              Vector<double> &interpolated_values);
+                              Vector<double>     &interpolated_values,
+                              const unsigned int n_threads  = 1,
+                              const bool         use_owners = true);
 
   /**
    * Compute (by adding into the patch index @p data_index) the forces on the
@@ -216,9 +734,36 @@ namespace fdl
    * @param[in] mapping Mapping for computing values of the finite element
    * field on the reference configuration.
    *
-   * @param[in] solution The finite element field we are spreading from.
+   * @param[in] solution The finite element field we are spreading from. This
+   * may be stored in single precision: values are converted to double
+   * precision on each cell.
+   *
+   * @param[in] n_threads Number of threads used to spread. Patches do not
+   * share patch data so each thread spreads into a disjoint set of patches.
+   * Since every patch is always processed by a single thread, in the same
+   * order, the result is bitwise identical for any number of threads. This
+   * parameter has no effect unless fiddle is compiled with OpenMP support.
+   *
+   * @param[in] sort_points If true, all quadrature points on each patch are
+   * first binned by the Eulerian cell containing them (with a counting sort)
+   * and then spread with a single kernel call in that order, which improves
+   * the locality of the writes into the patch data. Since the values are then
+   * summed in a different order the result differs from the unsorted one by
+   * roundoff, but it is still deterministic.
+   *
+   * @param[in] spread_cutoff If positive, quadrature points at which the
+   * magnitude of the value times JxW is less than @p spread_cutoff times the
+   * largest such value are not spread. This avoids evaluating the kernel at
+   * points which carry negligible force (e.g., on passive tissue). To avoid
+   * communication the largest value is taken over the points spread by the
+   * current processor, so the result depends on the partitioning. All values
+   * are computed before anything is spread. Must be in [0, 1).
+   *
+   * @param[out] statistics If not null, the number and magnitude of the
+   * skipped points are added to this object. Nothing is recorded if
+   * @p spread_cutoff is zero.
    */
-  template <int dim, int spacedim>
+  template <int dim, int spacedim, typename Number = double>
   void
   compute_spread(const std::string                  &kernel_name,
                  const int                           data_index,
@@ -228,7 +773,82 @@ namespace fdl
                  const std::vector<Quadrature<dim>> &quadratures,
                  const DoFHandler<dim, spacedim>    &dof_handler,
                  const Mapping<dim, spacedim>       &mapping,
-                 const Vector<double>               &solution);
+                 const Vector<Number>               &solution,
+                 const unsigned int                  n_threads     = 1,
+                 const bool                          sort_points   = false,
+                 const double                        spread_cutoff = 0.0,
+                 SpreadCutoffStatistics             *statistics    = nullptr);
+
+  /**
+   * Same as the other compute_spread() function, but uses quadrature points
+   * precomputed by compute_interaction_plan() instead of computing them from a
+   * position mapping. Since the plan already stores the quadrature points of
+   * each patch contiguously, @p sort_points only adds the counting sort. If
+   * the plan is compressed then @p spread_cutoff applies to the summed values
+   * of the compressed points.
+   *
+   * @todo Add a device (e.g., Kokkos) implementation of this function and of
+   * the plan-based compute_projection_rhs(). The packed per-patch quadrature
+   * points and JxW values stored by the plan are already in a suitable
+   * layout, but the IB kernels are evaluated by ib_spread() and
+   * ib_interpolate() (see ib_kernels.h), whose specialized loops run on the
+   * host and which fall back to IBTK::LEInteractor for other kernels and
+   * patch data, and the patch data is allocated by SAMRAI in host memory.
+   */
+  template <int dim, int spacedim, typename Number = double>
+  void
+  compute_spread(const std::string                    &kernel_name,
+                 const int                             data_index,
+                 PatchMap<dim, spacedim>              &patch_map,
+                 const InteractionPlan<dim, spacedim> &plan,
+                 const std::vector<unsigned char>     &quadrature_indices,
+                 const std::vector<Quadrature<dim>>   &quadratures,
+                 const DoFHandler<dim, spacedim>      &dof_handler,
+                 const Mapping<dim, spacedim>         &mapping,
+                 const Vector<Number>                 &solution,
+                 const unsigned int                    n_threads     = 1,
+                 const bool                            sort_points   = false,
+                 const double                          spread_cutoff = 0.0,
+                 SpreadCutoffStatistics               *statistics    = nullptr);
+
+  /**
+   * Same as the previous function, but spreads several fields at once: i.e.,
+   * @p solutions[i], which is defined by @p dof_handlers[i] and
+   * @p mappings[i], is spread into @p data_indices[i]. The fields may have
+   * different numbers of components and be spread into different kinds of
+   * patch data (e.g., a side-centered force and a cell-centered source).
+   *
+   * Like the multi-field compute_projection_rhs(), every field is computed
+   * during the same traversal of the PatchMap: the quadrature points of each
+   * patch are only read once and fields which use the same FiniteElement and
+   * Mapping share their FEValues objects. The result is the same as calling
+   * the single-field version (with one thread, no sorting, and no cutoff)
+   * once per field.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_spread(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    PatchMap<dim, spacedim>                              &patch_map,
+    const InteractionPlan<dim, spacedim>                 &plan,
+    const std::vector<unsigned char>                     &quadrature_indices,
+    const std::vector<Quadrature<dim>>                   &quadratures,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<const Vector<double> *>            &solutions);
+
+  /**
+   * Same as the other compute_spread() functions, but multiplies
+   * @p solution by the transpose of an InteractionOperator. Like
+   * compute_projection_rhs(), everything else is determined by @p op.
+   */
+  template <int dim, int spacedim, typename Number = double>
+  void
+  compute_spread(const InteractionOperator<dim, spacedim> &op,
+                 PatchMap<dim, spacedim>                  &patch_map,
+                 const Vector<Number>                     &solution,
+                 const unsigned int                        n_threads = 1);
 
   /**
    * Spread Lagrangian data at specified Lagrangian points.
@@ -364,5 +984,51 @@ namespace fdl
     const double                                        &stencil_width,
     const unsigned int                                   stencil_axis);
 
+  /**
+   * Compute all intersections between a simplex and the lines connecting
+   * adjacent cell centers of a patch (i.e., every FD stencil of the patch
+   * along every coordinate axis) at once.
+   *
+   * This is the batched equivalent of calling
+   * intersect_stencil_with_simplex() for every stencil of the patch. Rather
+   * than testing each stencil separately, this function
+   *
+   * 1. only considers the lines whose transverse coordinates lie within the
+   *    bounding box of the simplex (and returns immediately if that bounding
+   *    box does not intersect the patch), and
+   *
+   * 2. hoists the Möller-Trumbore setup out of the loop over lines: for a
+   *    fixed axis the barycentric coordinates of the intersection and the
+   *    position of the intersection along the line are affine functions of
+   *    the line's transverse coordinates, so each line only costs a few
+   *    fused multiply-adds and comparisons. The innermost loop is written so
+   *    that it can be vectorized.
+   *
+   * Each intersection is appended to @p intersections as the lower cell
+   * index, the axis, and the convex combination coefficient between the
+   * lower and upper cell centers (i.e., unlike
+   * intersect_stencil_with_simplex(), the coefficient is always between 0
+   * and 1). @p cell_level and @p cell_index are the level and index of the
+   * deal.II cell corresponding to @p simplex and are stored alongside each
+   * intersection. The grid spacing and origin of @p intersections are set
+   * from the patch geometry, so every call with the same @p intersections
+   * object should use the same patch.
+   *
+   * @param[in] simplex an array containing Eulerian location of
+   * vertices of the given element.
+   *
+   * @note Like intersect_stencil_with_simplex(), a line which passes through
+   * a vertex or an edge shared by several elements will intersect each of
+   * them. Simplices which are parallel to a coordinate axis do not intersect
+   * any lines along that axis.
+   */
+  template <int spacedim>
+  void
+  intersect_patch_with_simplex(
+    const std::array<Point<spacedim>, spacedim>  &simplex,
+    const tbox::Pointer<hier::Patch<spacedim>>   &patch,
+    const unsigned char                           cell_level,
+    const int                                     cell_index,
+    internal::PatchSingleIntersections<spacedim> &intersections);
 } // namespace fdl
 #endif
@@ -0,0 +1,161 @@
+#ifndef included_fiddle_interaction_marker_point_interaction_h
+#define included_fiddle_interaction_marker_point_interaction_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/grid/nodal_patch_map.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <mpi.h>
+
+#include <string>
+
+// forward declarations
+namespace SAMRAI
+{
+  namespace hier
+  {
+    template <int>
+    class PatchHierarchy;
+  }
+
+  namespace tbox
+  {
+    class Database;
+
+    template <typename>
+    class Pointer;
+  } // namespace tbox
+} // namespace SAMRAI
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  /**
+   * Interaction between the Eulerian grid and a set of points (e.g.,
+   * MarkerPoints) whose positions are known on every processor.
+   *
+   * This is a much simpler version of NodalInteraction: since every
+   * processor already has every point there is no overlap triangulation,
+   * DoFHandler, or Scatter. Instead, each processor sets up a NodalPatchMap
+   * for its own patches on a single level. Each point is interpolated only by
+   * the patch owning it and the results are summed over all processors,
+   * after which every processor has every interpolated value. If any point
+   * moved more than one cell away from its owning patch then, like
+   * NodalInteraction, every patch interpolates the points near it and the
+   * results are combined with a max reduction instead. Spreading
+   * only needs the forces of the points near each processor's patches, so
+   * it does not communicate at all.
+   */
+  template <int spacedim>
+  class MarkerPointInteraction
+  {
+  public:
+    /**
+     * Default constructor. Sets up an empty object.
+     */
+    MarkerPointInteraction();
+
+    /**
+     * Constructor.
+     *
+     * @param[in] input_db Database from which ghost_cell_fraction (which
+     * must be positive, defaults to 1.0) and
+     * n_interpolation_threads (defaults to 1) are read.
+     *
+     * @param[in] communicator Communicator over which interpolated values
+     * are summed, i.e., the communicator of @p patch_hierarchy.
+     *
+     * @param[in] patch_hierarchy Patch hierarchy with which the points
+     * interact.
+     *
+     * @param[in] level_number Number of the level with which the points
+     * interact.
+     *
+     * @param[in] position Positions of the points in node-first order.
+     */
+    MarkerPointInteraction(
+      const tbox::Pointer<tbox::Database>          &input_db,
+      const MPI_Comm                                communicator,
+      tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+      const int                                     level_number,
+      const Vector<double>                         &position);
+
+    /**
+     * Reinitialize the object. Same as the constructor.
+     */
+    void
+    reinit(const tbox::Pointer<tbox::Database>          &input_db,
+           const MPI_Comm                                communicator,
+           tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+           const int                                     level_number,
+           const Vector<double>                         &position);
+
+    /**
+     * Interpolate the data @p data_index, which must have depth
+     * <code>spacedim</code> (e.g., the velocity), at the points, which are
+     * at @p position. @p values is resized to hold spacedim values per point
+     * in node-first order. Points outside of the level set up in reinit()
+     * have a value of zero. This call is collective.
+     *
+     * @note @p position should not differ from the position provided to
+     * reinit() by more than the ghost cell fraction.
+     */
+    void
+    interpolate(const std::string    &kernel_name,
+                const int             data_index,
+                const Vector<double> &position,
+                Vector<double>       &values) const;
+
+    /**
+     * Spread @p values, at the points at @p position, into the data
+     * @p data_index (including ghost regions) of the local patches. Like
+     * other spreading functions, this does not accumulate ghost data.
+     */
+    void
+    spread(const std::string    &kernel_name,
+           const int             data_index,
+           const Vector<double> &position,
+           const Vector<double> &values);
+
+    /**
+     * Add @p point_weight to the cells of @p workload_index containing each
+     * point.
+     */
+    void
+    add_workload(const int             workload_index,
+                 const Vector<double> &position,
+                 const double          point_weight);
+
+    /**
+     * Return the number of points in the local patches.
+     */
+    std::size_t
+    n_local_points() const;
+
+    /**
+     * Return an estimate of the number of bytes used by this object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    MPI_Comm communicator;
+
+    /**
+     * Number of threads used when interpolating.
+     */
+    unsigned int n_interpolation_threads;
+
+    /**
+     * Mapping between the points and the local patches. Each point is owned
+     * by at most one patch.
+     */
+    NodalPatchMap<spacedim, spacedim> nodal_patch_map;
+  };
+} // namespace fdl
+
+#endif
@@ -63,11 +63,29 @@ namespace fdl
 
     /**
      * Constructor.
+     *
+     * In addition to the values read by InteractionBase, this class reads
+     * pack_nodes from @p input_db: if true, then the NodalPatchMaps pack the
+     * data of patches whose nodes do not have contiguous DoF indices into
+     * contiguous buffers so that each patch requires a single interpolation or
+     * spreading call (see NodalPatchMap). Defaults to false.
+     *
+     * This class also reads interpolate_from_owners: if true, then each node
+     * is assigned to the single patch (on any processor) whose box contained
+     * it at the last regrid and is only interpolated by that patch. In that
+     * case interpolated values are scattered with an add reduction, rather
+     * than by initializing every value to -DBL_MAX and scattering with a max
+     * reduction to resolve duplicates. This requires that nodes move at most
+     * one cell between regrids: if any node moved further, then that
+     * interpolation falls back to the max reduction. Defaults to false.
+     *
+     * Finally, this class reads n_interpolation_threads: the number of threads
+     * used to interpolate (see compute_nodal_interpolation()). Defaults to 1.
      */
     NodalInteraction(
       const tbox::Pointer<tbox::Database>                  &input_db,
       const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-      const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
       tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
       const std::pair<int, int>                            &level_numbers,
       const DoFHandler<dim, spacedim>                  &position_dof_handler,
@@ -80,24 +98,26 @@ namespace fdl
      * called.
      */
     virtual void
-    reinit(const tbox::Pointer<tbox::Database>                  &input_db,
-           const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-           const std::vector<BoundingBox<spacedim, float>> &active_cell_bboxes,
-           const std::vector<float>                        &active_cell_lengths,
-           tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
-           const std::pair<int, int> &level_numbers) override;
+    reinit(
+      const tbox::Pointer<tbox::Database>                  &input_db,
+      const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
+      const ArrayView<const float>                         &active_cell_lengths,
+      tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
+      const std::pair<int, int> &level_numbers) override;
 
     /**
      * Reinitialize the object. Same as the constructor.
      */
     virtual void
-    reinit(const tbox::Pointer<tbox::Database>                  &input_db,
-           const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-           const std::vector<BoundingBox<spacedim, float>> &active_cell_bboxes,
-           tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
-           const std::pair<int, int>                       &level_numbers,
-           const DoFHandler<dim, spacedim> &position_dof_handler,
-           const LinearAlgebra::distributed::Vector<double> &position);
+    reinit(
+      const tbox::Pointer<tbox::Database>                  &input_db,
+      const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+      const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
+      tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
+      const std::pair<int, int>                            &level_numbers,
+      const DoFHandler<dim, spacedim>                  &position_dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &position);
 
     /**
      * Same as base class but also sets up some necessary internal data
@@ -113,9 +133,43 @@ namespace fdl
     virtual bool
     projection_is_interpolation() const override;
 
+    /**
+     * Same as the base class, but when interpolating from owners this
+     * function also finishes the position scatter and starts checking
+     * (with a nonblocking reduction) whether every node is still within one
+     * cell of its owning patch. The reduction is started here, rather than in
+     * compute_projection_rhs_intermediate(), since collective operations must
+     * be started in the same order on every processor while
+     * TransactionScheduler advances transactions in the order in which their
+     * requests complete. Its request is returned by
+     * Transaction::delegate_outstanding_requests().
+     */
+    virtual std::unique_ptr<TransactionBase>
+    compute_projection_rhs_scatter_start(
+      const std::string                                &kernel_name,
+      const int                                         data_idx,
+      const DoFHandler<dim, spacedim>                  &position_dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const DoFHandler<dim, spacedim>                  &dof_handler,
+      const Mapping<dim, spacedim>                     &mapping,
+      LinearAlgebra::distributed::Vector<double>       &rhs) override;
+
+    /**
+     * Same as the base class, except that the position scatter may have
+     * already been finished by compute_projection_rhs_scatter_start().
+     */
+    virtual std::unique_ptr<TransactionBase>
+    compute_projection_rhs_scatter_finish(
+      std::unique_ptr<TransactionBase> transaction) const override;
+
     /**
      * Do the actual work associated with nodal interpolation by, if necessary,
      * computing nodes and then calling compute_nodal_interpolation().
+     *
+     * When interpolating from owners, this function first waits for the check
+     * started by compute_projection_rhs_scatter_start() and, if any node is
+     * no longer within one cell of its owning patch, interpolates with a max
+     * reduction instead.
      */
     virtual std::unique_ptr<TransactionBase>
     compute_projection_rhs_intermediate(
@@ -123,7 +177,8 @@ namespace fdl
 
     /**
      * Finish nodal interaction. Unlike the base class method this method sets
-     * velocities of nodes outside the domain to zero.
+     * velocities of nodes outside the domain to zero (which, when
+     * interpolating from owners, is already the case).
      */
     virtual void
     compute_projection_rhs_accumulate_finish(
@@ -156,6 +211,15 @@ namespace fdl
     virtual std::unique_ptr<TransactionBase>
     add_workload_intermediate(std::unique_ptr<TransactionBase> t_ptr) override;
 
+    /**
+     * Count the interaction points and elements on the local patches.
+     */
+    virtual std::pair<double, double>
+    count_local_interaction_work() override;
+
+    virtual std::size_t
+    memory_consumption() const override;
+
   protected:
     virtual VectorOperation::values
     get_rhs_scatter_type() const override;
@@ -164,6 +228,16 @@ namespace fdl
     get_nodal_patch_map(
       const DoFHandler<dim, spacedim> &native_dof_handler) const;
 
+    /**
+     * Return the nodes of the DoFHandler of @p trans, i.e., either the
+     * overlap position or, if the DoFHandler uses a different element than
+     * the position, its nodes computed from the position and stored in
+     * @p nodal_coordinates.
+     */
+    const Vector<double> &
+    get_nodes(const Transaction<dim, spacedim> &trans,
+              Vector<double>                   &nodal_coordinates) const;
+
     /**
      * For convenience, store an explicit pointer to the natively partitioned
      * position DoFHandler (the base class also stores a pointer).
@@ -186,6 +260,28 @@ namespace fdl
      */
     std::vector<std::vector<BoundingBox<spacedim>>> bboxes;
 
+    /**
+     * Bounding boxes for each patch without any ghost region (except on the
+     * boundary of the domain). Each node inside one of these boxes is owned by
+     * the corresponding patch. Empty unless interpolate_from_owners is true.
+     */
+    std::vector<std::vector<BoundingBox<spacedim>>> owner_bboxes;
+
+    /**
+     * Whether or not to set up the NodalPatchMaps with packing.
+     */
+    bool pack_nodes;
+
+    /**
+     * Whether or not each node is only interpolated by the patch owning it.
+     */
+    bool interpolate_from_owners;
+
+    /**
+     * Number of threads used when interpolating.
+     */
+    unsigned int n_interpolation_threads;
+
     /**
      * Mappings between support points (nodes) and patches. Indexed by the
      * number of the DoFHandler.
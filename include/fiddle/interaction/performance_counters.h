@@ -0,0 +1,136 @@
+#ifndef included_fiddle_interaction_performance_counters_h
+#define included_fiddle_interaction_performance_counters_h
+
+#include <fiddle/base/config.h>
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace fdl
+{
+  /**
+   * Class which accumulates named per-processor counters (e.g., the number of
+   * interaction points or CG iterations) over each time step.
+   *
+   * Values are added to the current step with add(). finish_step() ends the
+   * step: it also records the number of bytes sent and received by every
+   * Scatter object (see get_total_scatter_bytes_sent()) during the step,
+   * makes the values of the step available through get() and
+   * get_step_counters(), adds them to the totals, and, if a file name was
+   * provided, appends one line of JSON containing the minimum, maximum, and
+   * sum over all processors of each counter to that file.
+   *
+   * Since finish_step() reduces over all processors, every processor must
+   * add the same counters.
+   */
+  class PerformanceCounters
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] communicator MPI communicator over which counters are
+     * reduced.
+     *
+     * @param[in] filename Name of the file to which the first processor
+     * appends the counters of each time step. No file is written if this is
+     * empty.
+     */
+    PerformanceCounters(const MPI_Comm    &communicator,
+                        const std::string &filename = "");
+
+    /**
+     * Add @p value to the counter @p name of the current time step.
+     */
+    void
+    add(const std::string &name, const double value);
+
+    /**
+     * Finish the current time step, which ended at @p time. This call is
+     * collective.
+     */
+    void
+    finish_step(const double time);
+
+    /**
+     * Return the number of finished time steps.
+     */
+    unsigned int
+    n_steps() const;
+
+    /**
+     * Return the value of counter @p name in the last finished time step, or
+     * zero if it was not set.
+     */
+    double
+    get(const std::string &name) const;
+
+    /**
+     * Return all counters of the last finished time step.
+     */
+    const std::map<std::string, double> &
+    get_step_counters() const;
+
+    /**
+     * Return all counters summed over all finished time steps.
+     */
+    const std::map<std::string, double> &
+    get_total_counters() const;
+
+    /**
+     * Write, for each counter summed over all finished time steps, its
+     * minimum, mean, and maximum over all processors and its imbalance (i.e.,
+     * the maximum divided by the mean) to @p out on the first processor. For
+     * the time and MPI wait time counters of each phase this shows how much of
+     * the phase is spent waiting for other processors without requiring any
+     * barriers. This call is collective.
+     */
+    void
+    write_summary(std::ostream &out) const;
+
+  protected:
+    MPI_Comm communicator;
+
+    std::string filename;
+
+    unsigned int step_n;
+
+    std::uint64_t n_bytes_sent_at_step_start;
+
+    std::uint64_t n_bytes_received_at_step_start;
+
+    std::map<std::string, double> current_counters;
+
+    std::map<std::string, double> step_counters;
+
+    std::map<std::string, double> total_counters;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  inline unsigned int
+  PerformanceCounters::n_steps() const
+  {
+    return step_n;
+  }
+
+  inline const std::map<std::string, double> &
+  PerformanceCounters::get_step_counters() const
+  {
+    return step_counters;
+  }
+
+  inline const std::map<std::string, double> &
+  PerformanceCounters::get_total_counters() const
+  {
+    return total_counters;
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef included_fiddle_interaction_regrid_policy_h
+#define included_fiddle_interaction_regrid_policy_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which decides when to regrid from how far the structure moved since
+   * the last regrid.
+   *
+   * The interaction objects associate elements with patches by intersecting
+   * the element bounding boxes with the patch boxes expanded by
+   * <code>ghost_cell_fraction</code> times the size of a cell (see
+   * compute_patch_bboxes()). Those associations stay correct until some
+   * point of the structure moves farther than that, so the distance can be
+   * used as a displacement budget: regridding once the budget is used up
+   * (instead of at a fixed interval) avoids regrids which are not yet
+   * necessary. Larger ghost regions make interactions more expensive but
+   * require fewer regrids.
+   *
+   * All displacements are measured in multiples of the cell size of the
+   * finest level, i.e., in the same units as
+   * IFEDMethodBase::getMaxPointDisplacement().
+   */
+  class DisplacementRegridPolicy
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] ghost_cell_fraction The amount, in multiples of the cell size,
+     * by which patches are expanded when associating elements to them.
+     *
+     * @param[in] safety_factor Fraction of the ghost region which may be used
+     * up before a regrid is required.
+     */
+    DisplacementRegridPolicy(const double ghost_cell_fraction = 1.0,
+                             const double safety_factor       = 1.0);
+
+    /**
+     * Return the largest displacement permitted between two regrids.
+     */
+    double
+    get_displacement_budget() const;
+
+    /**
+     * Return the fraction of the displacement budget used by
+     * @p max_displacement.
+     */
+    double
+    get_budget_fraction(const double max_displacement) const;
+
+    /**
+     * Return whether or not a regrid should be done after the structure moved
+     * by @p max_displacement.
+     */
+    bool
+    regrid_needed(const double max_displacement) const;
+
+  protected:
+    double displacement_budget;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  inline DisplacementRegridPolicy::DisplacementRegridPolicy(
+    const double ghost_cell_fraction,
+    const double safety_factor)
+    : displacement_budget(ghost_cell_fraction * safety_factor)
+  {
+    AssertThrow(ghost_cell_fraction > 0.0,
+                ExcMessage("The ghost cell fraction should be positive."));
+    AssertThrow(0.0 < safety_factor && safety_factor <= 1.0,
+                ExcMessage("The safety factor should be in (0, 1]."));
+  }
+
+  inline double
+  DisplacementRegridPolicy::get_displacement_budget() const
+  {
+    return displacement_budget;
+  }
+
+  inline double
+  DisplacementRegridPolicy::get_budget_fraction(
+    const double max_displacement) const
+  {
+    return max_displacement / displacement_budget;
+  }
+
+  inline bool
+  DisplacementRegridPolicy::regrid_needed(const double max_displacement) const
+  {
+    return get_budget_fraction(max_displacement) >= 1.0;
+  }
+} // namespace fdl
+
+#endif
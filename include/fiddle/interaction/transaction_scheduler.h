@@ -0,0 +1,212 @@
+#ifndef included_fiddle_interaction_transaction_scheduler_h
+#define included_fiddle_interaction_transaction_scheduler_h
+
+#include <fiddle/base/config.h>
+#include <fiddle/base/tracer.h>
+
+#include <fiddle/interaction/interaction_base.h>
+
+#include <mpi.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fdl
+{
+  /**
+   * Class which drives several independent transactions (i.e., the state
+   * between the *_start(), *_intermediate(), and *_finish() calls of
+   * InteractionBase) to completion.
+   *
+   * Each transaction is advanced to its next stage as soon as its own MPI
+   * requests complete (instead of waiting for every transaction's requests at
+   * once), so the communication of each transaction is overlapped with the
+   * computations of the others.
+   *
+   * This class also records, for each transaction, how long it spent waiting
+   * for communication (i.e., the time between a stage ending and all of the
+   * requests it started completing) and how long it spent computing (i.e.,
+   * the total time spent in its stages). Since the other transactions may
+   * compute while one waits, the wait times of different transactions
+   * overlap: the time the current processor was actually blocked in MPI for
+   * the delegated requests is available from get_mpi_wait_time().
+   *
+   * If a Tracer is provided with set_tracer() then each stage and wait of each
+   * transaction and each call to MPI_Waitsome() is also recorded as an event.
+   */
+  class TransactionScheduler
+  {
+  public:
+    /**
+     * A single stage of a transaction: it takes ownership of the transaction
+     * (after all of its outstanding requests complete), advances it, and
+     * returns it. The last stage of a transaction typically calls some
+     * *_finish() function and should return nullptr.
+     */
+    using Stage = std::function<std::unique_ptr<TransactionBase>(
+      std::unique_ptr<TransactionBase>)>;
+
+    /**
+     * Add a transaction, which should have just been returned by some
+     * *_start() function (e.g., InteractionBase::add_workload_start()).
+     *
+     * @param[in] stages Functions which advance the transaction, in order.
+     * Each stage is called once all of the requests started by the previous
+     * stage (or, for the first stage, by the *_start() function) complete.
+     *
+     * @param[in] stage_names Optional names of the stages, which are only
+     * used when tracing.
+     *
+     * @return The index of the transaction.
+     */
+    std::size_t
+    add_transaction(std::unique_ptr<TransactionBase> transaction,
+                    std::vector<Stage>               stages,
+                    std::vector<std::string>         stage_names = {});
+
+    /**
+     * Add a transaction returned by
+     * InteractionBase::compute_projection_rhs_scatter_start().
+     *
+     * @param[in] finished Optional function called right after the right-hand
+     * side is finished (i.e., right after
+     * InteractionBase::compute_projection_rhs_accumulate_finish() is called).
+     */
+    template <int dim, int spacedim>
+    std::size_t
+    add_projection_rhs_transaction(
+      InteractionBase<dim, spacedim>  &interaction,
+      std::unique_ptr<TransactionBase> transaction,
+      const std::function<void()>     &finished = {});
+
+    /**
+     * Add a transaction returned by
+     * InteractionBase::compute_spread_scatter_start().
+     */
+    template <int dim, int spacedim>
+    std::size_t
+    add_spread_transaction(InteractionBase<dim, spacedim>  &interaction,
+                           std::unique_ptr<TransactionBase> transaction);
+
+    /**
+     * Add a transaction returned by InteractionBase::add_workload_start().
+     */
+    template <int dim, int spacedim>
+    std::size_t
+    add_workload_transaction(InteractionBase<dim, spacedim>  &interaction,
+                             std::unique_ptr<TransactionBase> transaction);
+
+    /**
+     * Record the stages and waits of every transaction in @p tracer when
+     * run() is called. Transaction @p n is recorded in the lane
+     * <code>transaction_names[n]</code> (or "transaction n", if
+     * @p transaction_names is too short).
+     */
+    void
+    set_tracer(Tracer                         &tracer,
+               const std::vector<std::string> &transaction_names = {});
+
+    /**
+     * Run every transaction to completion.
+     */
+    void
+    run();
+
+    /**
+     * Return the number of transactions.
+     */
+    std::size_t
+    n_transactions() const;
+
+    /**
+     * Return the total time (in seconds) transaction @p n spent waiting for
+     * its requests to complete.
+     */
+    double
+    get_wait_time(const std::size_t n) const;
+
+    /**
+     * Return the total time (in seconds) transaction @p n spent in its
+     * stages.
+     */
+    double
+    get_compute_time(const std::size_t n) const;
+
+    /**
+     * Return the total time (in seconds) spent in MPI_Waitsome(), i.e., the
+     * time the current processor waited for communication while no
+     * transaction could be advanced.
+     */
+    double
+    get_mpi_wait_time() const;
+
+  protected:
+    /**
+     * Transactions.
+     */
+    std::vector<std::unique_ptr<TransactionBase>> transactions;
+
+    /**
+     * Stages of each transaction.
+     */
+    std::vector<std::vector<Stage>> stages;
+
+    /**
+     * Names of the stages of each transaction.
+     */
+    std::vector<std::vector<std::string>> stage_names;
+
+    /**
+     * Optional tracer and the names of the transactions in it.
+     */
+    Tracer                  *tracer = nullptr;
+    std::vector<std::string> transaction_names;
+
+    /**
+     * Time each transaction spent waiting.
+     */
+    std::vector<double> wait_times;
+
+    /**
+     * Time each transaction spent computing.
+     */
+    std::vector<double> compute_times;
+
+    /**
+     * Time spent in MPI_Waitsome().
+     */
+    double mpi_wait_time = 0.0;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  inline std::size_t
+  TransactionScheduler::n_transactions() const
+  {
+    return transactions.size();
+  }
+
+  inline double
+  TransactionScheduler::get_wait_time(const std::size_t n) const
+  {
+    AssertIndexRange(n, wait_times.size());
+    return wait_times[n];
+  }
+
+  inline double
+  TransactionScheduler::get_compute_time(const std::size_t n) const
+  {
+    AssertIndexRange(n, compute_times.size());
+    return compute_times[n];
+  }
+
+  inline double
+  TransactionScheduler::get_mpi_wait_time() const
+  {
+    return mpi_wait_time;
+  }
+} // namespace fdl
+
+#endif
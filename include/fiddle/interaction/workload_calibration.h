@@ -0,0 +1,164 @@
+#ifndef included_fiddle_interaction_workload_calibration_h
+#define included_fiddle_interaction_workload_calibration_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <mpi.h>
+
+#include <array>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which fits the coefficients of the workload model used to partition
+   * the Eulerian data (see count_quadrature_points()) to measured times.
+   *
+   * Each processor records, over a window of time steps (typically the steps
+   * between two regrids), the time it spends on interaction computations
+   * as well as the number of interaction points and elements on its patches.
+   * At the end of each window the per-processor average times are regressed
+   * against those counts, i.e., we find the coefficients $c_p$ and $c_c$ which
+   * minimize
+   * @f[
+   *   \sum_{w} \sum_{r} (T_{w, r} - c_p P_{w, r} - c_c C_{w, r})^2
+   * @f]
+   * where $T_{w, r}$, $P_{w, r}$, and $C_{w, r}$ are the average time per
+   * step, number of points, and number of elements on processor $r$ in window
+   * $w$. Since only the ratio of the coefficients matters for load balancing,
+   * the point weight is always one and the element weight is $c_c / c_p$.
+   *
+   * Samples from all previous windows are kept, so the fit improves as the
+   * structure (and therefore the distribution of points and elements between
+   * processors) changes.
+   */
+  class WorkloadCalibration
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] communicator MPI communicator over which samples are
+     * collected.
+     *
+     * @param[in] min_n_steps Minimum number of time steps a window needs to
+     * contain to be used in the fit. Shorter windows are discarded since their
+     * times are typically dominated by noise.
+     */
+    WorkloadCalibration(const MPI_Comm     &communicator,
+                        const unsigned int  min_n_steps = 1);
+
+    /**
+     * Start a new window with the given local numbers of interaction points
+     * and elements.
+     */
+    void
+    start_window(const double n_points, const double n_cells);
+
+    /**
+     * Add time spent computing on the current processor to the current step.
+     */
+    void
+    add_time(const double time);
+
+    /**
+     * Finish the current time step.
+     */
+    void
+    finish_step();
+
+    /**
+     * Finish the current window and, if it is long enough, add it to the
+     * samples and recompute the coefficients. This function is collective.
+     *
+     * @return Whether or not the coefficients changed.
+     */
+    bool
+    finish_window();
+
+    /**
+     * Return whether or not any coefficients have been computed.
+     */
+    bool
+    has_coefficients() const;
+
+    /**
+     * Return the workload of each interaction point, which is, by convention,
+     * always one.
+     */
+    double
+    get_point_weight() const;
+
+    /**
+     * Return the workload of each element relative to the workload of each
+     * point.
+     */
+    double
+    get_cell_weight() const;
+
+  protected:
+    MPI_Comm communicator;
+
+    unsigned int min_n_steps;
+
+    /**
+     * Local data of the current window.
+     * @{
+     */
+    double window_n_points;
+    double window_n_cells;
+    double window_time;
+
+    unsigned int window_n_steps;
+    /**
+     * @}
+     */
+
+    /**
+     * Global sums of products in the normal equations, in the order P * P,
+     * P * C, C * C, P * T, and C * T.
+     */
+    std::array<double, 5> sums;
+
+    bool has_fit;
+
+    double cell_weight;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  inline void
+  WorkloadCalibration::add_time(const double time)
+  {
+    window_time += time;
+  }
+
+  inline void
+  WorkloadCalibration::finish_step()
+  {
+    ++window_n_steps;
+  }
+
+  inline bool
+  WorkloadCalibration::has_coefficients() const
+  {
+    return has_fit;
+  }
+
+  inline double
+  WorkloadCalibration::get_point_weight() const
+  {
+    return 1.0;
+  }
+
+  inline double
+  WorkloadCalibration::get_cell_weight() const
+  {
+    return cell_weight;
+  }
+} // namespace fdl
+
+#endif
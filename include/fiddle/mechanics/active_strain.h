@@ -6,10 +6,12 @@
 #include <fiddle/base/exceptions.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/tensor.h>
 
 #include <deal.II/grid/tria.h>
 
 #include <algorithm>
+#include <vector>
 
 namespace fdl
 {
@@ -22,6 +24,16 @@ namespace fdl
    * deformation gradients specified to ForceContribution objects. These
    * modification operations are definde by push_deformation_gradient_forward()
    * and pull_stress_back().
+   *
+   * Many active strains (e.g., ones which only depend on a per-cell activation
+   * and the fiber directions) are defined by a single tensor FF_A on each
+   * cell. Derived classes describing such strains should override
+   * compute_cellwise_FF_A() and call setup_cellwise_strain() at the end of
+   * setup_strain(). This computes and stores FF_A^-1 and det(FF_A) on every
+   * relevant cell once per call to setup_strain() and the assembly routines
+   * (see, e.g., MechanicsValues::reinit() and compute_load_vector()) then
+   * apply the active strain inline instead of calling the virtual functions
+   * push_deformation_gradient_forward() and pull_stress_back() on each cell.
    */
   template <int dim, int spacedim = dim, typename Number = double>
   class ActiveStrain
@@ -57,12 +69,15 @@ namespace fdl
      *
      * in which FF is the deformation gradient and FF_A is the active stress
      * tensor defined by this class.
+     *
+     * The default implementation uses the values computed by
+     * setup_cellwise_strain().
      */
     virtual void
     push_deformation_gradient_forward(
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       const ArrayView<Tensor<2, spacedim, Number>>                      &FF,
-      ArrayView<Tensor<2, spacedim, Number>> &push_forward_FF) const = 0;
+      ArrayView<Tensor<2, spacedim, Number>> &push_forward_FF) const;
 
     /**
      * Pull the first Piola-Kirchoff stress tensors back by the formula
@@ -72,12 +87,38 @@ namespace fdl
      * in which PP_E is the first Piola-Kirchoff stress tensor (which is
      * computed with FF_E) and FF_A is the active stress tensor defined by
      * this class.
+     *
+     * The default implementation uses the values computed by
+     * setup_cellwise_strain().
      */
     virtual void
     pull_stress_back(
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       const ArrayView<Tensor<2, spacedim, Number>> &push_forward_stress,
-      ArrayView<Tensor<2, spacedim, Number>>       &stress) const = 0;
+      ArrayView<Tensor<2, spacedim, Number>>       &stress) const;
+
+    /**
+     * Return whether or not the present object is defined by a single tensor
+     * FF_A on each cell which has been precomputed by setup_cellwise_strain().
+     */
+    bool
+    has_cellwise_strain() const;
+
+    /**
+     * Return the precomputed value of FF_A^-1 on @p cell.
+     */
+    const Tensor<2, spacedim, Number> &
+    get_cellwise_FF_A_inv(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Return the precomputed value of det(FF_A) on @p cell.
+     */
+    Number
+    get_cellwise_det_FF_A(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
 
     /**
      * Return the material ids over which the present object is defined.
@@ -85,8 +126,36 @@ namespace fdl
     const std::vector<types::material_id> &
     get_material_ids() const;
 
+  protected:
+    /**
+     * Compute FF_A on @p cell. This function is only called by
+     * setup_cellwise_strain() and must be overridden by derived classes which
+     * use it.
+     */
+    virtual Tensor<2, spacedim, Number>
+    compute_cellwise_FF_A(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Compute and store FF_A^-1 and det(FF_A) with compute_cellwise_FF_A() on
+     * each locally owned cell of @p tria whose material id is one of
+     * get_material_ids(). These values are used until the next call to this
+     * function. Derived classes should call this function in setup_strain()
+     * after updating whatever FF_A depends on (e.g., the activation).
+     */
+    void
+    setup_cellwise_strain(const Triangulation<dim, spacedim> &tria);
+
   private:
     std::vector<types::material_id> material_ids;
+
+    /**
+     * Values of FF_A^-1 and det(FF_A), indexed by active cell index.
+     */
+    std::vector<Tensor<2, spacedim, Number>> cellwise_FF_A_inv;
+
+    std::vector<Number> cellwise_det_FF_A;
   };
 
   // --------------------------- inline functions --------------------------- //
@@ -116,6 +185,66 @@ namespace fdl
     (void)time;
   }
 
+  template <int dim, int spacedim, typename Number>
+  void
+  ActiveStrain<dim, spacedim, Number>::push_deformation_gradient_forward(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim, Number>>                      &FF,
+    ArrayView<Tensor<2, spacedim, Number>> &push_forward_FF) const
+  {
+    AssertDimension(FF.size(), push_forward_FF.size());
+    const Tensor<2, spacedim, Number> &FF_A_inv = get_cellwise_FF_A_inv(cell);
+    for (unsigned int q = 0; q < FF.size(); ++q)
+      push_forward_FF[q] = FF[q] * FF_A_inv;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ActiveStrain<dim, spacedim, Number>::pull_stress_back(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim, Number>> &push_forward_stress,
+    ArrayView<Tensor<2, spacedim, Number>>       &stress) const
+  {
+    AssertDimension(push_forward_stress.size(), stress.size());
+    const Tensor<2, spacedim, Number> FF_A_inv_T =
+      transpose(get_cellwise_FF_A_inv(cell));
+
+    const Number det_FF_A = get_cellwise_det_FF_A(cell);
+    for (unsigned int q = 0; q < stress.size(); ++q)
+      stress[q] = det_FF_A * push_forward_stress[q] * FF_A_inv_T;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ActiveStrain<dim, spacedim, Number>::has_cellwise_strain() const
+  {
+    return cellwise_FF_A_inv.size() > 0;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  const Tensor<2, spacedim, Number> &
+  ActiveStrain<dim, spacedim, Number>::get_cellwise_FF_A_inv(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    Assert(has_cellwise_strain(),
+           ExcMessage("setup_cellwise_strain() must be called first."));
+    AssertIndexRange(cell->active_cell_index(), cellwise_FF_A_inv.size());
+    return cellwise_FF_A_inv[cell->active_cell_index()];
+  }
+
+  template <int dim, int spacedim, typename Number>
+  Number
+  ActiveStrain<dim, spacedim, Number>::get_cellwise_det_FF_A(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    Assert(has_cellwise_strain(),
+           ExcMessage("setup_cellwise_strain() must be called first."));
+    AssertIndexRange(cell->active_cell_index(), cellwise_det_FF_A.size());
+    return cellwise_det_FF_A[cell->active_cell_index()];
+  }
+
   template <int dim, int spacedim, typename Number>
   const std::vector<types::material_id> &
   ActiveStrain<dim, spacedim, Number>::get_material_ids() const
@@ -123,6 +252,39 @@ namespace fdl
     return material_ids;
   }
 
+  template <int dim, int spacedim, typename Number>
+  Tensor<2, spacedim, Number>
+  ActiveStrain<dim, spacedim, Number>::compute_cellwise_FF_A(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    (void)cell;
+    AssertThrow(false,
+                ExcMessage("Derived classes which call "
+                           "setup_cellwise_strain() must override "
+                           "compute_cellwise_FF_A()."));
+    return Tensor<2, spacedim, Number>();
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ActiveStrain<dim, spacedim, Number>::setup_cellwise_strain(
+    const Triangulation<dim, spacedim> &tria)
+  {
+    cellwise_FF_A_inv.resize(tria.n_active_cells());
+    cellwise_det_FF_A.resize(tria.n_active_cells());
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned() &&
+          std::binary_search(material_ids.begin(),
+                             material_ids.end(),
+                             cell->material_id()))
+        {
+          const Tensor<2, spacedim, Number> FF_A = compute_cellwise_FF_A(cell);
+          cellwise_FF_A_inv[cell->active_cell_index()] = invert(FF_A);
+          cellwise_det_FF_A[cell->active_cell_index()] = determinant(FF_A);
+        }
+  }
+
 } // namespace fdl
 
 #endif
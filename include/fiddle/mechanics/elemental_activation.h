@@ -0,0 +1,187 @@
+#ifndef included_fiddle_mechanics_elemental_activation_h
+#define included_fiddle_mechanics_elemental_activation_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/grid/data_in.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/table.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <string>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Cellwise activation (e.g., for an ActiveStrain or an active stress)
+   * loaded from the snapshots of an elemental variable stored in an ExodusII
+   * file and interpolated linearly in time.
+   *
+   * A small ring buffer of snapshots is kept in memory: reinit() only reads
+   * from the file when the simulation time passes a new snapshot and, after
+   * doing so, starts reading the following snapshot in the background (see
+   * ElementalDataReader::prefetch()). reinit() also computes the interpolated
+   * activation of every locally owned cell, so get_activation() is just an
+   * array read. Like FiberNetwork, the values are stored densely and indexed
+   * by the global active cell index minus the current processor's offset.
+   *
+   * This class is typically owned by an ActiveStrain: e.g., the strain's
+   * setup_strain() calls reinit() and then
+   * ActiveStrain::setup_cellwise_strain(), whose compute_cellwise_FF_A() calls
+   * get_activation().
+   */
+  template <int dim, int spacedim = dim>
+  class ElementalActivation
+  {
+  public:
+    /**
+     * Constructor. This call is collective.
+     *
+     * @param[in] filename Name of the ExodusII file.
+     *
+     * @param[in] tria The Triangulation over which the activation is defined -
+     * see read_elemental_data().
+     *
+     * @param[in] variable_name Name of the elemental variable.
+     *
+     * @param[in] snapshot_times Times corresponding to each time step stored
+     * in the file, which must be increasing. Time step <code>i</code> (with
+     * ExodusII's one-based numbering) corresponds to
+     * <code>snapshot_times[i - 1]</code>.
+     *
+     * @param[in] period If positive, the activation is periodic in time with
+     * this period: i.e., times are taken modulo @p period and the activation
+     * between the last and first snapshots is interpolated between them.
+     * Otherwise the first and last snapshots are used outside of the range of
+     * @p snapshot_times.
+     *
+     * @param[in] n_buffers Number of snapshots kept in memory, which must be
+     * at least two. More buffers avoid rereading snapshots if the time
+     * decreases (e.g., when a time step is repeated).
+     *
+     * @param[in] use_single_precision Whether or not to store the buffered
+     * snapshots in single precision, which halves the memory they use. The
+     * interpolated activations are always computed and stored in double
+     * precision.
+     */
+    ElementalActivation(const std::string                  &filename,
+                        const Triangulation<dim, spacedim> &tria,
+                        const std::string                  &variable_name,
+                        const std::vector<double>          &snapshot_times,
+                        const double                        period    = 0.0,
+                        const unsigned int                  n_buffers = 2,
+                        const bool use_single_precision = false);
+
+    /**
+     * Compute the activation at time @p time. This call is collective.
+     */
+    void
+    reinit(const double time);
+
+    /**
+     * Get the activation on @p cell at the time provided to the last call to
+     * reinit().
+     */
+    double
+    get_activation(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Get the activation of all locally owned cells, indexed in the way
+     * described in the class documentation.
+     */
+    ArrayView<const double>
+    get_activations() const;
+
+  protected:
+    /**
+     * Return the row of the ring buffer containing snapshot @p snapshot_n
+     * (indexed from zero), reading it if necessary. The row containing
+     * @p protected_snapshot_n is not overwritten.
+     */
+    unsigned int
+    load_snapshot(const unsigned int snapshot_n,
+                  const unsigned int protected_snapshot_n);
+
+    const SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+    ElementalDataReader<dim, spacedim> reader;
+
+    std::vector<double> snapshot_times;
+
+    double period;
+
+    types::global_cell_index local_processor_min_cell_index;
+
+    /**
+     * Whether or not the snapshots are stored in single_buffered_snapshots
+     * instead of buffered_snapshots.
+     */
+    bool single_precision;
+
+    /**
+     * Ring buffer of snapshots: each row contains the values of one snapshot
+     * on each locally owned cell.
+     */
+    Table<2, double> buffered_snapshots;
+
+    /**
+     * The same ring buffer, used when the snapshots are stored in single
+     * precision.
+     */
+    Table<2, float> single_buffered_snapshots;
+
+    /**
+     * Snapshot number stored in each row of the buffer, or
+     * numbers::invalid_unsigned_int for empty rows.
+     */
+    std::vector<unsigned int> buffered_snapshot_ns;
+
+    /**
+     * Row of the buffer which will be overwritten next.
+     */
+    unsigned int next_row;
+
+    /**
+     * Snapshot number which is being prefetched, or
+     * numbers::invalid_unsigned_int if there is no pending prefetch.
+     */
+    unsigned int prefetched_snapshot_n;
+
+    /**
+     * Interpolated activation on each locally owned cell.
+     */
+    std::vector<double> activations;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  inline double
+  ElementalActivation<dim, spacedim>::get_activation(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    const auto cell_index =
+      cell->global_active_cell_index() - local_processor_min_cell_index;
+    AssertIndexRange(cell_index, activations.size());
+    return activations[cell_index];
+  }
+
+  template <int dim, int spacedim>
+  inline ArrayView<const double>
+  ElementalActivation<dim, spacedim>::get_activations() const
+  {
+    return make_array_view(activations);
+  }
+} // namespace fdl
+
+#endif
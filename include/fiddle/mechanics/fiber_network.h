@@ -4,6 +4,7 @@
 #include <fiddle/base/config.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/table.h>
 
 #include <deal.II/grid/tria.h>
@@ -13,8 +14,14 @@ namespace fdl
   using namespace dealii;
 
   /**
-   * Reads cell-centered fiber field(s) stored in a vector
-   * and stores the data in a Table.
+   * Reads cell-centered (or quadrature point) fiber field(s) stored in a
+   * vector and stores the data in a Table.
+   *
+   * Since the fibers are unit vectors which are typically only known to a few
+   * digits, they may optionally be stored in single precision, which halves
+   * the memory used by this class. In that case they are converted to double
+   * precision by get_fiber() and get_structure_tensor() and get_fibers() may
+   * not be used.
    */
   template <int dim, int spacedim = dim>
   class FiberNetwork
@@ -33,20 +40,142 @@ namespace fdl
      * cell data vectors by setting up an FESystem<dim>(FE_SimplexP<dim>,
      * dim), using the mechanism for loading FE data, and then converting that
      * data vector into a vector of tensors.
+     *
+     * @param use_single_precision Whether or not to store the fibers (and
+     * structure tensors) in single precision.
      */
     FiberNetwork(const Triangulation<dim, spacedim>                  &tria,
-                 const std::vector<std::vector<Tensor<1, spacedim>>> &fibers);
+                 const std::vector<std::vector<Tensor<1, spacedim>>> &fibers,
+                 const bool use_single_precision = false);
+
+    /**
+     * Constructor for fibers which vary inside each cell.
+     *
+     * @param tria The Triangulation over which fiber data is defined.
+     * @param n_quadrature_points The number of quadrature points per cell at
+     * which the fibers are defined. This should match the size of the cell
+     * quadrature used by the force contributions which use this fiber
+     * network.
+     * @param fibers The vectors of fibers. Each vector is indexed like the
+     * one provided to the other constructor except that each cell has @p
+     * n_quadrature_points consecutive entries.
+     *
+     * @param use_single_precision Whether or not to store the fibers (and
+     * structure tensors) in single precision.
+     */
+    FiberNetwork(
+      const Triangulation<dim, spacedim>                  &tria,
+      const unsigned int                                   n_quadrature_points,
+      const std::vector<std::vector<Tensor<1, spacedim>>> &fibers,
+      const bool use_single_precision = false);
+
+    /**
+     * Number of quadrature points per cell at which fibers are stored. This is
+     * 1 when the fibers are constant on each cell.
+     */
+    unsigned int
+    n_quadrature_points() const;
+
+    /**
+     * Number of fiber fields.
+     */
+    unsigned int
+    n_fiber_fields() const;
+
+    /**
+     * Whether or not the fibers are stored in single precision.
+     */
+    bool
+    uses_single_precision() const;
 
     /**
      * Get a view into the stored fibers on a given cell.
+     *
+     * @note This function may only be called when the fibers are constant on
+     * each cell and stored in double precision.
      */
     ArrayView<const Tensor<1, spacedim>>
     get_fibers(const typename Triangulation<dim, spacedim>::active_cell_iterator
                  &cell) const;
 
+    /**
+     * Get a view into the stored fibers at quadrature point @p qp_n of a
+     * given cell. If the fibers are constant on each cell then @p qp_n is
+     * ignored.
+     *
+     * @note This function may only be called when the fibers are stored in
+     * double precision.
+     */
+    ArrayView<const Tensor<1, spacedim>>
+    get_fibers(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int qp_n) const;
+
+    /**
+     * Get fiber @p fiber_n at quadrature point @p qp_n of a given cell,
+     * converted to double precision if necessary. If the fibers are constant
+     * on each cell then @p qp_n is ignored.
+     */
+    Tensor<1, spacedim>
+    get_fiber(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int qp_n,
+      const unsigned int fiber_n) const;
+
+    /**
+     * Compute and store the structure tensors of all pairs of fibers, i.e.,
+     * $sym(f_i \otimes f_j)$ for $i \leq j$, so that they do not need to be
+     * recomputed by every stress evaluation.
+     */
+    void
+    setup_structure_tensors();
+
+    /**
+     * Get the structure tensor $sym(f_i \otimes f_j)$ at quadrature point @p
+     * qp_n of a given cell. Requires that setup_structure_tensors() was
+     * called.
+     */
+    SymmetricTensor<2, spacedim>
+    get_structure_tensor(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int                                                 i,
+      const unsigned int                                                 j,
+      const unsigned int qp_n = 0) const;
+
+    /**
+     * Return the number of bytes used by the stored fibers and structure
+     * tensors.
+     */
+    std::size_t
+    memory_consumption() const;
+
   private:
+    /**
+     * Get the row of the tables corresponding to quadrature point @p qp_n of
+     * @p cell.
+     */
+    std::size_t
+    get_row(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int qp_n) const;
+
+    /**
+     * Get the column of the structure tensor tables corresponding to fibers
+     * @p i and @p j.
+     */
+    unsigned int
+    get_pair_index(const unsigned int i, const unsigned int j) const;
+
     const SmartPointer<const Triangulation<dim, spacedim>> tria;
-    Table<2, Tensor<1, spacedim>>                          fibers;
+    unsigned int                                           n_q_points;
+    unsigned int                                           n_fields;
+    bool                                                   single_precision;
+
+    // Only one of each pair of tables is used, depending on single_precision.
+    Table<2, Tensor<1, spacedim>>                 fibers;
+    Table<2, Tensor<1, spacedim, float>>          single_fibers;
+    Table<2, SymmetricTensor<2, spacedim>>        structure_tensors;
+    Table<2, SymmetricTensor<2, spacedim, float>> single_structure_tensors;
     types::global_cell_index local_processor_min_cell_index;
   };
 
@@ -54,16 +183,115 @@ namespace fdl
   // --------------------------- inline functions --------------------------- //
 
 
+  template <int dim, int spacedim>
+  inline unsigned int
+  FiberNetwork<dim, spacedim>::n_quadrature_points() const
+  {
+    return n_q_points;
+  }
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  FiberNetwork<dim, spacedim>::n_fiber_fields() const
+  {
+    return n_fields;
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  FiberNetwork<dim, spacedim>::uses_single_precision() const
+  {
+    return single_precision;
+  }
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  FiberNetwork<dim, spacedim>::get_pair_index(const unsigned int i,
+                                              const unsigned int j) const
+  {
+    AssertIndexRange(i, n_fiber_fields());
+    AssertIndexRange(j, n_fiber_fields());
+    // pairs are stored in the order (0, 0), (0, 1), ..., (1, 1), ...
+    const unsigned int first  = std::min(i, j);
+    const unsigned int second = std::max(i, j);
+    return first * n_fiber_fields() - first * (first - 1) / 2 +
+           (second - first);
+  }
+
+  template <int dim, int spacedim>
+  inline std::size_t
+  FiberNetwork<dim, spacedim>::get_row(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int                                                 qp_n)
+    const
+  {
+    const auto cell_index =
+      cell->global_active_cell_index() - local_processor_min_cell_index;
+    if (n_q_points == 1)
+      return cell_index;
+
+    AssertIndexRange(qp_n, n_q_points);
+    return cell_index * n_q_points + qp_n;
+  }
+
   template <int dim, int spacedim>
   inline ArrayView<const Tensor<1, spacedim>>
   FiberNetwork<dim, spacedim>::get_fibers(
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
     const
   {
-    auto cell_index =
-      cell->global_active_cell_index() - local_processor_min_cell_index;
+    Assert(n_q_points == 1,
+           ExcMessage("This function requires cellwise constant fibers."));
+    return get_fibers(cell, 0);
+  }
 
-    return make_array_view(fibers, cell_index, 0, fibers.size(1));
+  template <int dim, int spacedim>
+  inline ArrayView<const Tensor<1, spacedim>>
+  FiberNetwork<dim, spacedim>::get_fibers(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int                                                 qp_n)
+    const
+  {
+    Assert(!single_precision,
+           ExcMessage("This function requires fibers stored in double "
+                      "precision - use get_fiber() instead."));
+    return make_array_view(fibers, get_row(cell, qp_n), 0, n_fields);
+  }
+
+  template <int dim, int spacedim>
+  inline Tensor<1, spacedim>
+  FiberNetwork<dim, spacedim>::get_fiber(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int                                                 qp_n,
+    const unsigned int fiber_n) const
+  {
+    AssertIndexRange(fiber_n, n_fiber_fields());
+    const std::size_t row = get_row(cell, qp_n);
+    if (single_precision)
+      return Tensor<1, spacedim>(single_fibers(row, fiber_n));
+    return fibers(row, fiber_n);
+  }
+
+  template <int dim, int spacedim>
+  inline SymmetricTensor<2, spacedim>
+  FiberNetwork<dim, spacedim>::get_structure_tensor(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int                                                 i,
+    const unsigned int                                                 j,
+    const unsigned int qp_n) const
+  {
+    const std::size_t  row    = get_row(cell, qp_n);
+    const unsigned int pair_n = get_pair_index(i, j);
+    if (single_precision)
+      {
+        Assert(single_structure_tensors.size(0) == single_fibers.size(0),
+               ExcMessage("setup_structure_tensors() must be called first."));
+        return SymmetricTensor<2, spacedim>(
+          single_structure_tensors(row, pair_n));
+      }
+    Assert(structure_tensors.size(0) == fibers.size(0),
+           ExcMessage("setup_structure_tensors() must be called first."));
+    return structure_tensors(row, pair_n);
   }
 } // namespace fdl
 
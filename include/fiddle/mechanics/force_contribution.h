@@ -7,12 +7,17 @@
 
 #include <fiddle/mechanics/mechanics_values.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe_update_flags.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <utility>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
@@ -30,6 +35,7 @@ namespace fdl
     ForceContribution(const Quadrature<dim> &quad)
       : is_volumetric(true)
       , cell_quadrature(quad)
+      , cost(1.0)
     {}
 
     /**
@@ -38,6 +44,7 @@ namespace fdl
     ForceContribution(const Quadrature<dim - 1> &quad)
       : is_volumetric(false)
       , face_quadrature(quad)
+      , cost(1.0)
     {}
 
     /**
@@ -106,6 +113,86 @@ namespace fdl
       return false;
     }
 
+    /**
+     * Whether or not this force contribution is nonzero on @p cell (e.g.,
+     * because it is only applied to cells with certain material ids).
+     * compute_load_vector() does not evaluate force contributions on cells on
+     * which they are not active and skips cells on which no force
+     * contribution is active. Defaults to true.
+     */
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const
+    {
+      (void)cell;
+      return true;
+    }
+
+    /**
+     * Return the locally owned boundary faces, as (cell, face number) pairs in
+     * cell order, on which this boundary force may be active, or nullptr if
+     * they are not known in advance. compute_load_vector() only visits these
+     * faces (instead of every boundary face) if every boundary force using the
+     * same quadrature rule returns a list. Defaults to nullptr.
+     */
+    virtual const std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                unsigned int>> *
+    get_active_boundary_faces() const
+    {
+      return nullptr;
+    }
+
+    /**
+     * Return the (sorted) boundary ids of the faces on which this boundary
+     * force may be active, where an empty vector means every boundary face,
+     * or nullptr if they are not known in advance. Unlike
+     * get_active_boundary_faces(), this does not depend on the parallel
+     * partitioning, so Part uses it to set up lists of faces for boundary
+     * forces which do not store their own. Defaults to nullptr.
+     */
+    virtual const std::vector<types::boundary_id> *
+    get_active_boundary_ids() const
+    {
+      return nullptr;
+    }
+
+    /**
+     * Whether or not the compute functions of this class may be called
+     * concurrently from several threads (see compute_load_vector()). Defaults
+     * to false since force contributions may, e.g., store mutable scratch
+     * data.
+     */
+    virtual bool
+    is_thread_safe() const
+    {
+      return false;
+    }
+
+    /**
+     * Return the cost of evaluating this force contribution at one quadrature
+     * point relative to that of other force contributions. This is used by
+     * Part::compute_cell_weights() to balance the work of computing forces
+     * between processors. Defaults to one.
+     */
+    double
+    get_cost() const
+    {
+      return cost;
+    }
+
+    /**
+     * Set the relative cost returned by get_cost(), e.g., to a value measured
+     * by timing the computation of load vectors with only this force
+     * contribution.
+     */
+    void
+    set_cost(const double cost)
+    {
+      AssertThrow(cost >= 0.0, ExcMessage("The cost must not be negative."));
+      this->cost = cost;
+    }
+
     /**
      * Some forces that are not defined in a straightforward way (e.g., pressure
      * fields) require additional setup before their force contribution is
@@ -199,12 +286,117 @@ namespace fdl
       Assert(false, ExcFDLInternalError());
     }
 
+    /**
+     * Add the stress computed by compute_stress() to @p stresses. This lets
+     * compute_load_vector() accumulate every stress which uses the same
+     * quadrature rule into a single array in one pass.
+     *
+     * The default implementation computes the stress in @p scratch (which has
+     * the same size as @p stresses) and then adds it to @p stresses: derived
+     * classes should override this function to add their stress directly.
+     */
+    virtual void
+    add_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &scratch,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+    {
+      AssertDimension(scratch.size(), stresses.size());
+      for (auto &stress : scratch)
+        stress = 0.0;
+      compute_stress(time, me_values, cell, scratch);
+      for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+        stresses[qp_n] += scratch[qp_n];
+    }
+
+    /**
+     * Whether or not this force contribution implements
+     * compute_vectorized_stress(). Defaults to false.
+     *
+     * compute_stress() requires a MechanicsValues object (and therefore an
+     * FEValues object) so compute_vectorized_stress() cannot simply forward to
+     * it: instead, callers should check this function and use compute_stress()
+     * (e.g., via the FEValues-based compute_volumetric_pk1_load_vector()) for
+     * force contributions which return false.
+     */
+    virtual bool
+    has_vectorized_stress() const
+    {
+      return false;
+    }
+
+    /**
+     * Vectorized version of compute_stress() which computes stresses on
+     * several cells at once: lane @p v of each argument corresponds to
+     * <code>cells[v]</code>. Lanes past the end of @p cells do not correspond
+     * to any cell and should be filled with zeros.
+     *
+     * Unlike compute_stress(), stresses are always computed in double
+     * precision.
+     */
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                              &cells,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+    {
+      (void)time;
+      (void)me_values;
+      (void)cells;
+      (void)stresses;
+      Assert(false, ExcFDLInternalError());
+    }
+
+    /**
+     * Whether or not this force contribution implements
+     * compute_vectorized_stress_derivative(). Defaults to false.
+     */
+    virtual bool
+    has_stress_derivative() const
+    {
+      return false;
+    }
+
+    /**
+     * Compute the directional derivative of the stress computed by
+     * compute_vectorized_stress() with respect to the deformation gradient,
+     * i.e., dPP/dFF : dFF, in which the deformation gradient is given by
+     * @p me_values and the direction by @p dFF. This is used to apply the
+     * tangent stiffness of a Part (see TangentStiffnessOperator) without
+     * assembling a matrix. Like compute_vectorized_stress(), lanes past the
+     * end of @p cells should be filled with zeros.
+     */
+    virtual void
+    compute_vectorized_stress_derivative(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                                    &cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &d_stresses) const
+    {
+      (void)time;
+      (void)me_values;
+      (void)cells;
+      (void)dFF;
+      (void)d_stresses;
+      Assert(false, ExcFDLInternalError());
+    }
+
   private:
     bool is_volumetric;
 
     Quadrature<dim> cell_quadrature;
 
     Quadrature<dim - 1> face_quadrature;
+
+    double cost;
   };
 } // namespace fdl
 
@@ -9,6 +9,7 @@
 #include <fiddle/mechanics/force_contribution.h>
 
 #include <deal.II/base/function.h>
+#include <deal.II/base/thread_local_storage.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
@@ -59,6 +60,16 @@ namespace fdl
     set_reference_position(
       const LinearAlgebra::distributed::Vector<double> &reference_position);
 
+    /**
+     * Set whether or not the reference position is stored in single
+     * precision. Since the reference position does not change during a
+     * simulation this halves the memory used by this class at the cost of
+     * rounding the reference position to about seven digits. The default is
+     * to store it in double precision.
+     */
+    void
+    set_single_precision_reference_position(const bool use_single_precision);
+
     /**
      * Get the update flags this force contribution requires for MechanicsValues
      * objects.
@@ -73,6 +84,22 @@ namespace fdl
     virtual UpdateFlags
     get_update_flags() const override;
 
+    /**
+     * The scratch data used by the derived classes is thread-local, so this
+     * returns true.
+     */
+    virtual bool
+    is_thread_safe() const override;
+
+    /**
+     * Return the faces set up by setup_active_boundary_faces(), if it was
+     * called, and otherwise nullptr.
+     */
+    virtual const std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                unsigned int>> *
+    get_active_boundary_faces() const override;
+
     virtual void
     setup_force(
       const double                                      time,
@@ -83,6 +110,47 @@ namespace fdl
     finish_force(const double time) override;
 
   protected:
+    /**
+     * Scratch arrays used to evaluate the spring force on a single cell.
+     */
+    struct Scratch
+    {
+      std::vector<types::global_dof_index> cell_dofs;
+      std::vector<double>                  dof_values;
+      std::vector<Tensor<1, spacedim>>     qp_values;
+    };
+
+    /**
+     * Find the locally owned boundary faces with one of the given boundary
+     * ids (or all boundary faces, if @p boundary_ids is empty) and store them
+     * and the DoF indices of their cells. Boundary spring forces are typically
+     * applied to a small part of the boundary, so this permits computing
+     * their load vectors without visiting every boundary face.
+     *
+     * Requires that a DoFHandler was provided.
+     */
+    void
+    setup_active_boundary_faces(
+      const std::vector<types::boundary_id> &boundary_ids);
+
+    /**
+     * Return the DoF indices of the cell adjacent to @p face. These are
+     * precomputed for the faces set up by setup_active_boundary_faces() and
+     * are otherwise computed in @p scratch.
+     */
+    ArrayView<const types::global_dof_index>
+    get_boundary_face_dofs(
+      const FEValuesBase<dim, spacedim> &fe_values,
+      const typename Triangulation<dim, spacedim>::active_face_iterator &face,
+      Scratch &scratch) const;
+
+    /**
+     * Get the value of the reference position corresponding to the (locally
+     * relevant) DoF @p dof, converted to double precision if necessary.
+     */
+    double
+    get_reference_value(const types::global_dof_index dof) const;
+
     double spring_constant;
 
     SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
@@ -91,9 +159,39 @@ namespace fdl
                                                current_position;
     LinearAlgebra::distributed::Vector<double> reference_position;
 
-    mutable std::vector<types::global_dof_index> scratch_cell_dofs;
-    mutable std::vector<double>                  scratch_dof_values;
-    mutable std::vector<Tensor<1, spacedim>>     scratch_qp_values;
+    /**
+     * Whether or not the reference position is stored in
+     * single_reference_position instead of reference_position.
+     */
+    bool single_precision_reference;
+
+    LinearAlgebra::distributed::Vector<float> single_reference_position;
+
+    mutable Threads::ThreadLocalStorage<Scratch> scratch;
+
+    /**
+     * Whether or not setup_active_boundary_faces() was called.
+     */
+    bool has_active_boundary_faces;
+
+    /**
+     * Boundary faces on which the force is active.
+     */
+    std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                unsigned int>>
+      active_boundary_faces;
+
+    /**
+     * Pairs of face indices (i.e., face->index()) and indices into
+     * active_boundary_faces, sorted by the former.
+     */
+    std::vector<std::pair<int, unsigned int>> active_boundary_face_indices;
+
+    /**
+     * DoF indices of the cells adjacent to each of the active_boundary_faces.
+     */
+    std::vector<types::global_dof_index> active_boundary_face_dofs;
   };
 
   /**
@@ -146,6 +244,10 @@ namespace fdl
     virtual bool
     is_volume_force() const override;
 
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const override;
+
     virtual void
     compute_volume_force(
       const double                          time,
@@ -210,6 +312,12 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    /**
+     * Return the boundary ids provided to the constructor.
+     */
+    virtual const std::vector<types::boundary_id> *
+    get_active_boundary_ids() const override;
+
     virtual void
     compute_boundary_force(
       const double                          time,
@@ -248,6 +356,13 @@ namespace fdl
     virtual bool
     is_volume_force() const override;
 
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const override;
+
+    virtual bool
+    is_thread_safe() const override;
+
     virtual void
     compute_volume_force(
       const double                          time,
@@ -302,6 +417,12 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    /**
+     * Return the boundary ids provided to the constructor.
+     */
+    virtual const std::vector<types::boundary_id> *
+    get_active_boundary_ids() const override;
+
     /**
      * Compute the boundary force.
      */
@@ -382,6 +503,12 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    /**
+     * Return the boundary ids provided to the constructor.
+     */
+    virtual const std::vector<types::boundary_id> *
+    get_active_boundary_ids() const override;
+
     virtual void
     compute_boundary_force(
       const double                          time,
@@ -436,6 +563,13 @@ namespace fdl
     virtual bool
     is_stress() const override;
 
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const override;
+
+    virtual bool
+    is_thread_safe() const override;
+
     virtual void
     compute_stress(
       const double                          time,
@@ -443,6 +577,41 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    virtual void
+    add_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &scratch,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
+
+    virtual bool
+    has_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                              &cells,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    virtual bool
+    has_stress_derivative() const override;
+
+    virtual void
+    compute_vectorized_stress_derivative(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                                    &cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &d_stresses)
+      const override;
+
   protected:
     double shear_modulus;
 
@@ -493,6 +662,13 @@ namespace fdl
     virtual bool
     is_stress() const override;
 
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const override;
+
+    virtual bool
+    is_thread_safe() const override;
+
     virtual void
     compute_stress(
       const double                          time,
@@ -500,6 +676,27 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    virtual void
+    add_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &scratch,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
+
+    virtual bool
+    has_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                              &cells,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
   protected:
     double material_constant_1;
 
@@ -549,6 +746,13 @@ namespace fdl
     virtual bool
     is_stress() const override;
 
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const override;
+
+    virtual bool
+    is_thread_safe() const override;
+
     virtual void
     compute_stress(
       const double                          time,
@@ -556,6 +760,41 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    virtual void
+    add_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &scratch,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
+
+    virtual bool
+    has_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                              &cells,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    virtual bool
+    has_stress_derivative() const override;
+
+    virtual void
+    compute_vectorized_stress_derivative(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                                    &cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &d_stresses)
+      const override;
+
   protected:
     double bulk_modulus;
 
@@ -603,6 +842,13 @@ namespace fdl
     virtual bool
     is_stress() const override;
 
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const override;
+
+    virtual bool
+    is_thread_safe() const override;
+
     virtual void
     compute_stress(
       const double                          time,
@@ -610,6 +856,41 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    virtual void
+    add_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &scratch,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
+
+    virtual bool
+    has_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                              &cells,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    virtual bool
+    has_stress_derivative() const override;
+
+    virtual void
+    compute_vectorized_stress_derivative(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                                    &cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &d_stresses)
+      const override;
+
   protected:
     double bulk_modulus;
 
@@ -620,7 +901,7 @@ namespace fdl
    * I4_i for one quadrature point
    */
   template <int spacedim, typename Number = double>
-  double
+  Number
   I4_i(const SymmetricTensor<2, spacedim, Number> CC,
        const Tensor<1, spacedim, Number>          fiber_i);
 
@@ -636,7 +917,7 @@ namespace fdl
    * I8_ij for one quadrature point
    */
   template <int spacedim, typename Number = double>
-  double
+  Number
   I8_ij(const SymmetricTensor<2, spacedim, Number> CC,
         const Tensor<1, spacedim, Number>          fiber_i,
         const Tensor<1, spacedim, Number>          fiber_j);
@@ -667,6 +948,9 @@ namespace fdl
      *
      * @note if @p material_ids is empty then the force will be applied on
      * every cell.
+     *
+     * @note If @p fiber_network stores fibers at quadrature points then it
+     * must use the same number of quadrature points as @p quad.
      */
     HolzapfelOgdenStress(
       const Quadrature<dim>                             &quad,
@@ -698,6 +982,13 @@ namespace fdl
     virtual bool
     is_stress() const override;
 
+    virtual bool
+    is_active(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                &cell) const override;
+
+    virtual bool
+    is_thread_safe() const override;
+
     virtual void
     compute_stress(
       const double                          time,
@@ -705,6 +996,27 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    virtual void
+    add_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &scratch,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
+
+    virtual bool
+    has_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                              &cells,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
   protected:
     double       a;       // I1_bar parameter
     double       b;       // I1_bar parameter
@@ -725,8 +1037,18 @@ namespace fdl
 
   // --------------------------- inline functions --------------------------- //
 
-  template <int spacedim, typename Number>
+  template <int dim, int spacedim, typename Number>
   inline double
+  SpringForceBase<dim, spacedim, Number>::get_reference_value(
+    const types::global_dof_index dof) const
+  {
+    if (single_precision_reference)
+      return single_reference_position[dof];
+    return reference_position[dof];
+  }
+
+  template <int spacedim, typename Number>
+  inline Number
   I4_i(const SymmetricTensor<2, spacedim, Number> CC,
        const Tensor<1, spacedim, Number>          fiber_i)
   {
@@ -742,7 +1064,7 @@ namespace fdl
   }
 
   template <int spacedim, typename Number>
-  inline double
+  inline Number
   I8_ij(const SymmetricTensor<2, spacedim, Number> CC,
         const Tensor<1, spacedim, Number>          fiber_i,
         const Tensor<1, spacedim, Number>          fiber_j)
@@ -0,0 +1,166 @@
+#ifndef included_fiddle_mechanics_implicit_structure_solver_h
+#define included_fiddle_mechanics_implicit_structure_solver_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/tangent_stiffness_operator.h>
+
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <memory>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Newton-Krylov solver for implicit (backward Euler) time steps of the
+   * elastic response of a Part. Given the position X^n and velocity V^n at
+   * the start of the step and a load vector G of other (explicitly treated)
+   * forces, e.g., the coupling force of a distributed Lagrange multiplier
+   * method (see DLMMethodBase), this class computes the position X^{n+1} which
+   * solves
+   *
+   *     rho/dt^2 M (X^{n+1} - X^n - dt V^n) = F(X^{n+1}) + G
+   *
+   * in which M is the mass matrix, rho is the density, and F is the load
+   * vector of the stresses of the Part. With rho = 0 this is a quasi-static
+   * solve. The velocity at the end of the step is then (X^{n+1} - X^n) / dt.
+   *
+   * Each Newton step solves with the Jacobian rho/dt^2 M + K, in which K is
+   * the TangentStiffnessOperator of the stresses, with GMRES. Neither matrix
+   * is assembled. Unlike explicit updates, the step size is not limited by
+   * the stiffness of the stresses, so stiff parts may take the same time step
+   * as the fluid.
+   *
+   * All stresses of the Part must be evaluable with its MatrixFree object
+   * (see Part::get_matrix_free_quadrature_index()) and implement
+   * ForceContribution::compute_vectorized_stress_derivative(). Other forces
+   * are ignored: they should be added to G instead.
+   */
+  template <int dim>
+  class ImplicitStructureSolver
+  {
+  public:
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+    /**
+     * Solver parameters.
+     */
+    struct AdditionalData
+    {
+      /**
+       * Maximum number of Newton iterations.
+       */
+      unsigned int max_newton_iterations = 20;
+
+      /**
+       * Newton iterations stop once the norm of the residual is below this
+       * value times the norm of the initial residual.
+       */
+      double relative_tolerance = 1e-8;
+
+      /**
+       * Newton iterations stop once the norm of the residual is below this
+       * value.
+       */
+      double absolute_tolerance = 1e-12;
+
+      /**
+       * Maximum number of GMRES iterations per Newton iteration.
+       */
+      unsigned int max_krylov_iterations = 200;
+
+      /**
+       * Tolerance, relative to the norm of the current residual, of each
+       * (inexact) linear solve.
+       */
+      double krylov_relative_tolerance = 1e-4;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param[in] density Density of the structure. Must not be negative.
+     */
+    ImplicitStructureSolver(const Part<dim>      &part,
+                            const double          density,
+                            const AdditionalData &additional_data = {});
+
+    /**
+     * Take a time step, i.e., compute the position at time @p new_time.
+     *
+     * @param[in] dt Size of the time step.
+     *
+     * @param[in] old_position Position X^n at time new_time - dt.
+     *
+     * @param[in] old_velocity Velocity V^n at time new_time - dt.
+     *
+     * @param[in] load_vector Load vector G of the explicitly treated forces.
+     *
+     * @param[out] new_position Position X^{n+1} at time @p new_time.
+     *
+     * @return The number of Newton iterations.
+     */
+    unsigned int
+    step(const double      new_time,
+         const double      dt,
+         const VectorType &old_position,
+         const VectorType &old_velocity,
+         const VectorType &load_vector,
+         VectorType       &new_position);
+
+    /**
+     * Return the total number of GMRES iterations done by the last call to
+     * step().
+     */
+    unsigned int
+    get_n_krylov_iterations() const;
+
+  protected:
+    /**
+     * Compute the residual of the equation solved by step() (with the sign
+     * chosen so that the Jacobian is positive definite).
+     */
+    void
+    compute_residual(const double      time,
+                     const double      mass_scale,
+                     const VectorType &position,
+                     const VectorType &predicted_position,
+                     const VectorType &load_vector,
+                     VectorType       &residual) const;
+
+    SmartPointer<const Part<dim>> part;
+
+    double density;
+
+    AdditionalData additional_data;
+
+    /**
+     * Stresses and their quadrature indices, grouped by quadrature index.
+     */
+    std::vector<unsigned int> quadrature_indices;
+
+    std::vector<std::vector<ForceContribution<dim, dim> *>> stresses;
+
+    std::vector<std::unique_ptr<TangentStiffnessOperator<dim>>>
+      tangent_operators;
+
+    unsigned int n_krylov_iterations;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim>
+  inline unsigned int
+  ImplicitStructureSolver<dim>::get_n_krylov_iterations() const
+  {
+    return n_krylov_iterations;
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef included_fiddle_mechanics_marker_points_h
+#define included_fiddle_mechanics_marker_points_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <deal.II/base/point.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <array>
+#include <iosfwd>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * A cloud of marker points connected by linear springs, e.g., a network of
+   * chordae tendineae or reinforcing fibers.
+   *
+   * Unlike Part, this class has no Triangulation, DoFHandler, or mass matrix:
+   * the position and velocity of each point are stored directly in
+   * node-first order (i.e., {x0, y0, z0, x1, ...}), which is the layout used
+   * by NodalPatchMap, and the force at each point is the sum of the forces of
+   * the springs (edges) connected to it. Points may also be tethered to their
+   * initial positions by additional springs, which is useful for anchoring a
+   * network to a structure which is not modeled.
+   *
+   * Since such networks are small compared to the Eulerian grid, every
+   * processor stores every point: interaction with the Eulerian grid is done
+   * by MarkerPointInteraction.
+   */
+  template <int spacedim>
+  class MarkerPoints
+  {
+  public:
+    static constexpr int space_dimension = spacedim;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] points Initial positions of the points.
+     *
+     * @param[in] edges Pairs of point indices connected by a spring.
+     *
+     * @param[in] stiffnesses Stiffness of each spring, or a single value used
+     * for every spring.
+     *
+     * @param[in] rest_lengths Rest length of each spring. If empty, the rest
+     * length of each spring is its initial length.
+     */
+    MarkerPoints(const std::vector<Point<spacedim>>             &points,
+                 const std::vector<std::array<unsigned int, 2>> &edges,
+                 const std::vector<double>                      &stiffnesses,
+                 const std::vector<double> &rest_lengths = {});
+
+    /**
+     * Tether each point in @p point_ns to its initial position by a spring
+     * with the corresponding stiffness in @p stiffnesses (or a single value
+     * used for every point). Replaces any previously set tethers.
+     */
+    void
+    set_tethers(const std::vector<unsigned int> &point_ns,
+                const std::vector<double>       &stiffnesses);
+
+    /**
+     * Return the number of points.
+     */
+    std::size_t
+    n_points() const;
+
+    /**
+     * Return the number of springs.
+     */
+    std::size_t
+    n_edges() const;
+
+    /**
+     * Get the current position of every point.
+     */
+    const Vector<double> &
+    get_position() const;
+
+    /**
+     * Get the current velocity of every point.
+     */
+    const Vector<double> &
+    get_velocity() const;
+
+    /**
+     * Set the current position of every point.
+     */
+    void
+    set_position(Vector<double> &&new_position);
+
+    /**
+     * Set the current velocity of every point.
+     */
+    void
+    set_velocity(Vector<double> &&new_velocity);
+
+    /**
+     * Compute the force at each point when the points are at @p position.
+     * @p force is resized if necessary.
+     */
+    void
+    compute_force(const Vector<double> &position, Vector<double> &force) const;
+
+    /**
+     * Write the position and velocity to @p out.
+     */
+    void
+    write_state(std::ostream &out) const;
+
+    /**
+     * Read the position and velocity previously written by write_state().
+     */
+    void
+    read_state(std::istream &in);
+
+    /**
+     * Return an estimate of the number of bytes used by this object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    std::vector<std::array<unsigned int, 2>> edges;
+
+    std::vector<double> stiffnesses;
+
+    std::vector<double> rest_lengths;
+
+    std::vector<unsigned int> tether_point_ns;
+
+    std::vector<double> tether_stiffnesses;
+
+    /**
+     * Initial position, to which tethered points are pulled.
+     */
+    Vector<double> initial_position;
+
+    Vector<double> position;
+
+    Vector<double> velocity;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int spacedim>
+  inline std::size_t
+  MarkerPoints<spacedim>::n_points() const
+  {
+    return position.size() / spacedim;
+  }
+
+  template <int spacedim>
+  inline std::size_t
+  MarkerPoints<spacedim>::n_edges() const
+  {
+    return edges.size();
+  }
+
+  template <int spacedim>
+  inline const Vector<double> &
+  MarkerPoints<spacedim>::get_position() const
+  {
+    return position;
+  }
+
+  template <int spacedim>
+  inline const Vector<double> &
+  MarkerPoints<spacedim>::get_velocity() const
+  {
+    return velocity;
+  }
+
+  template <int spacedim>
+  inline void
+  MarkerPoints<spacedim>::set_position(Vector<double> &&new_position)
+  {
+    AssertDimension(new_position.size(), position.size());
+    position.swap(new_position);
+  }
+
+  template <int spacedim>
+  inline void
+  MarkerPoints<spacedim>::set_velocity(Vector<double> &&new_velocity)
+  {
+    AssertDimension(new_velocity.size(), velocity.size());
+    velocity.swap(new_velocity);
+  }
+} // namespace fdl
+
+#endif
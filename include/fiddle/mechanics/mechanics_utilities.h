@@ -5,9 +5,17 @@
 
 #include <fiddle/mechanics/active_strain.h>
 #include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/reference_values_cache.h>
+
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/fe_values.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <memory>
+#include <utility>
 #include <vector>
 
 // forward declarations
@@ -23,6 +31,79 @@ namespace fdl
 {
   using namespace dealii;
 
+  /**
+   * Force contributions which use the same quadrature rule and are hence
+   * evaluated together by compute_load_vector() or
+   * compute_boundary_force_load_vector(), along with the union of the flags
+   * they need and an FEValues object (or, for boundary forces, an
+   * FEFaceValues object) set up with those flags.
+   *
+   * Setting up FEValues evaluates every shape function at every quadrature
+   * point, so objects which compute load vectors repeatedly (like Part) should
+   * set up the groups once with group_force_contributions() and reuse them.
+   * Since the FEValues objects are reinitialized on each cell, a set of
+   * groups may only be used by one call at a time.
+   */
+  template <int dim, int spacedim = dim>
+  struct ForceContributionGroup
+  {
+    /**
+     * Stresses and volume forces with the same cell quadrature rule or
+     * boundary forces with the same face quadrature rule.
+     */
+    std::vector<ForceContribution<dim, spacedim> *> forces;
+
+    MechanicsUpdateFlags me_flags;
+
+    /**
+     * Flags of the FEValues object, which include everything needed by the
+     * forces and by the assembly of the load vector.
+     */
+    UpdateFlags update_flags;
+
+    /**
+     * FEValues object for stresses and volume forces, or nullptr for
+     * boundary forces.
+     */
+    std::unique_ptr<FEValues<dim, spacedim>> fe_values;
+
+    /**
+     * FEFaceValues object for boundary forces, or nullptr for stresses and
+     * volume forces.
+     */
+    std::unique_ptr<FEFaceValues<dim, spacedim>> fe_face_values;
+
+    /**
+     * Whether or not boundary_faces contains every face on which the boundary
+     * forces may be active. Set to false by group_force_contributions().
+     */
+    bool has_boundary_faces;
+
+    /**
+     * Locally owned boundary faces, as (cell, face number) pairs in cell
+     * order, on which at least one of the boundary forces may be active. If
+     * has_boundary_faces is true then compute_boundary_force_load_vector()
+     * only visits these faces.
+     */
+    std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                unsigned int>>
+      boundary_faces;
+  };
+
+  /**
+   * Group @p force_contributions by the quadrature rules they use. The groups
+   * are in the order in which their first force contribution appears in
+   * @p force_contributions and, within a group, the forces are also in that
+   * order.
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<ForceContributionGroup<dim, spacedim>>
+  group_force_contributions(
+    const Mapping<dim, spacedim>                          &mapping,
+    const FiniteElement<dim, spacedim>                    &fe,
+    const std::vector<ForceContribution<dim, spacedim> *> &force_contributions);
+
   /**
    * Compute the volumetric component of the PK1 stress and add it into the
    * given load vector.
@@ -39,6 +120,43 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
     LinearAlgebra::distributed::Vector<double>            &force_rhs);
 
+  /**
+   * Matrix-free version of the last function. Computes the deformation
+   * gradient with FEEvaluation, evaluates the stresses on each cell batch with
+   * ForceContribution::compute_vectorized_stress(), and integrates with sum
+   * factorization.
+   *
+   * Every stress must implement compute_vectorized_stress() and use the
+   * quadrature rule with index @p quadrature_index in @p matrix_free (see
+   * Part::get_matrix_free_quadrature_index()). Active strains are not
+   * supported.
+   *
+   * The cells are visited with MatrixFree::cell_loop(), which overlaps
+   * communication with computation: if @p current_position does not have
+   * up-to-date ghost values then they are updated while the cells without
+   * ghost DoFs are assembled, and @p force_rhs is compressed while the last
+   * cells are assembled. Hence, unlike the other functions in this file,
+   * this function calls <code>compress(VectorOperation::add)</code> on
+   * @p force_rhs. Both vectors must use the partitioner of @p matrix_free.
+   *
+   * @todo Add a device implementation based on Portable::MatrixFree. The
+   * stresses would need device versions of compute_vectorized_stress() which
+   * do not take cell iterators (e.g., with material parameters stored per
+   * quadrature point). It is only worth doing once the position and force
+   * vectors of a Part can stay on the device: today they are always copied
+   * to host-resident SAMRAI patch data by the interaction code (see the notes
+   * on Scatter and compute_spread()).
+   */
+  template <int dim>
+  void
+  compute_volumetric_pk1_load_vector(
+    const MatrixFree<dim, double>                    &matrix_free,
+    const unsigned int                                quadrature_index,
+    const std::vector<ForceContribution<dim, dim> *> &stress_contributions,
+    const double                                      time,
+    const LinearAlgebra::distributed::Vector<double> &current_position,
+    LinearAlgebra::distributed::Vector<double>       &force_rhs);
+
   /**
    * Compute the contribution of volumetric forces and add them to the given
    * load vector.
@@ -69,8 +187,37 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
     LinearAlgebra::distributed::Vector<double>            &force_rhs);
 
+  /**
+   * Same as above, but for precomputed groups of force contributions. Groups
+   * which do not contain boundary forces are ignored.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_boundary_force_load_vector(
+    const DoFHandler<dim, spacedim>                    &dof_handler,
+    std::vector<ForceContributionGroup<dim, spacedim>> &force_groups,
+    const double                                        time,
+    const LinearAlgebra::distributed::Vector<double>   &current_position,
+    const LinearAlgebra::distributed::Vector<double>   &current_velocity,
+    LinearAlgebra::distributed::Vector<double>         &force_rhs);
+
   /**
    * Combined function that calls all of the previous functions.
+   *
+   * @param[in] n_threads Number of threads used to compute the contributions
+   * of stresses and volume forces (if fiddle was compiled with OpenMP). Forces
+   * which are not ForceContribution::is_thread_safe() are always computed on
+   * one thread. The result does not depend on the number of threads.
+   *
+   * @note If @p n_threads is larger than one then the functions of
+   * @p active_strains may also be called concurrently.
+   *
+   * @param[in] cache Optional cache of shape function gradients. Stresses
+   * whose quadrature rule is cached are evaluated without FEValues, provided
+   * that there are no active strains and that the stresses only need
+   * quantities derived from the deformation gradient (i.e., no positions,
+   * velocities, normal vectors, or additional UpdateFlags). Otherwise the
+   * usual (uncached) code path is used.
    */
   template <int dim, int spacedim = dim>
   void
@@ -82,7 +229,26 @@ namespace fdl
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
-    LinearAlgebra::distributed::Vector<double>            &force_rhs);
+    LinearAlgebra::distributed::Vector<double>            &force_rhs,
+    const unsigned int                                     n_threads = 1,
+    const ReferenceValuesCache<dim, spacedim>             *cache = nullptr);
+
+  /**
+   * Same as above, but for precomputed groups of force contributions (see
+   * group_force_contributions()).
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_load_vector(
+    const DoFHandler<dim, spacedim>                    &dof_handler,
+    std::vector<ForceContributionGroup<dim, spacedim>> &force_groups,
+    const std::vector<ActiveStrain<dim, spacedim> *>   &active_strains,
+    const double                                        time,
+    const LinearAlgebra::distributed::Vector<double>   &current_position,
+    const LinearAlgebra::distributed::Vector<double>   &current_velocity,
+    LinearAlgebra::distributed::Vector<double>         &force_rhs,
+    const unsigned int                                  n_threads = 1,
+    const ReferenceValuesCache<dim, spacedim>          *cache     = nullptr);
 } // namespace fdl
 
 #endif
@@ -8,6 +8,7 @@
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe_values.h>
 
@@ -354,6 +355,127 @@ namespace fdl
     std::vector<double> scratch_velocity_values;
   };
 
+  /**
+   * Vectorized version of MechanicsValues which computes values for several
+   * cells at once, i.e., each quantity is stored as a tensor of
+   * VectorizedArray objects whose lanes correspond to distinct cells. This
+   * matches the cell batches used by MatrixFree and FEEvaluation.
+   *
+   * Like the second constructor of MechanicsValues, this class only computes
+   * values from provided deformation gradients and hence cannot compute
+   * positions, velocities, or deformed normal vectors.
+   */
+  template <int dim, int spacedim = dim>
+  class VectorizedMechanicsValues
+  {
+  public:
+    using VectorizedArrayType = VectorizedArray<double>;
+
+    /**
+     * Constructor.
+     */
+    VectorizedMechanicsValues(const MechanicsUpdateFlags flags);
+
+    /**
+     * Reinitialization function which updates values from a specified set of
+     * deformation gradients, one per quadrature point.
+     *
+     * @note Every lane of @p provided_FF must contain a valid deformation
+     * gradient, even lanes which do not correspond to a cell (e.g., use the
+     * identity in those lanes), since each quantity is computed on every
+     * lane.
+     */
+    void
+    reinit(const std::vector<Tensor<2, spacedim, VectorizedArrayType>>
+             &provided_FF);
+
+    const std::vector<Tensor<2, spacedim, VectorizedArrayType>> &
+    get_FF() const;
+
+    const std::vector<Tensor<2, spacedim, VectorizedArrayType>> &
+    get_FF_inv_T() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_det_FF() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_n23_det_FF() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_log_det_FF() const;
+
+    const std::vector<SymmetricTensor<2, spacedim, VectorizedArrayType>> &
+    get_right_cauchy_green() const;
+
+    const std::vector<SymmetricTensor<2, spacedim, VectorizedArrayType>> &
+    get_green() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_first_invariant() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_modified_first_invariant() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_second_invariant() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_modified_second_invariant() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_third_invariant() const;
+
+    const std::vector<Tensor<2, spacedim, VectorizedArrayType>> &
+    get_first_invariant_dFF() const;
+
+    const std::vector<Tensor<2, spacedim, VectorizedArrayType>> &
+    get_modified_first_invariant_dFF() const;
+
+  protected:
+    /**
+     * Resize all arrays.
+     */
+    void
+    resize(std::size_t size);
+
+    /**
+     * Reinitialize all values dependent on FF (the deformation gradient).
+     */
+    void
+    reinit_from_FF();
+
+    MechanicsUpdateFlags update_flags;
+
+    std::vector<Tensor<2, spacedim, VectorizedArrayType>> FF;
+
+    std::vector<Tensor<2, spacedim, VectorizedArrayType>> FF_inv_T;
+
+    std::vector<VectorizedArrayType> det_FF;
+
+    std::vector<VectorizedArrayType> n23_det_FF;
+
+    std::vector<VectorizedArrayType> log_det_FF;
+
+    std::vector<SymmetricTensor<2, spacedim, VectorizedArrayType>>
+      right_cauchy_green;
+
+    std::vector<SymmetricTensor<2, spacedim, VectorizedArrayType>> green;
+
+    std::vector<VectorizedArrayType> first_invariant;
+
+    std::vector<VectorizedArrayType> modified_first_invariant;
+
+    std::vector<VectorizedArrayType> second_invariant;
+
+    std::vector<VectorizedArrayType> modified_second_invariant;
+
+    std::vector<VectorizedArrayType> third_invariant;
+
+    std::vector<Tensor<2, spacedim, VectorizedArrayType>> first_invariant_dFF;
+
+    std::vector<Tensor<2, spacedim, VectorizedArrayType>>
+      modified_first_invariant_dFF;
+  };
 
   // --------------------------- inline functions --------------------------- //
 
@@ -519,6 +641,134 @@ namespace fdl
            ExcMessage("Needs update_modified_first_invariant_dFF"));
     return modified_first_invariant_dFF;
   }
+
+  // VectorizedMechanicsValues access functions
+
+  template <int dim, int spacedim>
+  inline const std::vector<Tensor<2, spacedim, VectorizedArray<double>>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_FF() const
+  {
+    Assert(update_flags & update_FF, ExcMessage("Needs update_FF"));
+    return FF;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<Tensor<2, spacedim, VectorizedArray<double>>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_FF_inv_T() const
+  {
+    Assert(update_flags & update_FF_inv_T, ExcMessage("Needs update_FF_inv_T"));
+    return FF_inv_T;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_det_FF() const
+  {
+    Assert(update_flags & update_det_FF, ExcMessage("Needs update_det_FF"));
+    return det_FF;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_n23_det_FF() const
+  {
+    Assert(update_flags & update_n23_det_FF,
+           ExcMessage("Needs update_n23_det_FF"));
+    return n23_det_FF;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_log_det_FF() const
+  {
+    Assert(update_flags & update_log_det_FF,
+           ExcMessage("Needs update_log_det_FF"));
+    return log_det_FF;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<
+    SymmetricTensor<2, spacedim, VectorizedArray<double>>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_right_cauchy_green() const
+  {
+    Assert(update_flags & update_right_cauchy_green,
+           ExcMessage("Needs update_right_cauchy_green"));
+    return right_cauchy_green;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<
+    SymmetricTensor<2, spacedim, VectorizedArray<double>>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_green() const
+  {
+    Assert(update_flags & update_green, ExcMessage("Needs update_green"));
+    return green;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_first_invariant() const
+  {
+    Assert(update_flags & update_first_invariant,
+           ExcMessage("Needs update_first_invariant"));
+    return first_invariant;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_modified_first_invariant() const
+  {
+    Assert(update_flags & update_modified_first_invariant,
+           ExcMessage("Needs update_modified_first_invariant"));
+    return modified_first_invariant;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_second_invariant() const
+  {
+    Assert(update_flags & update_second_invariant,
+           ExcMessage("Needs update_second_invariant"));
+    return second_invariant;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_modified_second_invariant()
+    const
+  {
+    Assert(update_flags & update_modified_second_invariant,
+           ExcMessage("Needs update_modified_second_invariant"));
+    return modified_second_invariant;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<VectorizedArray<double>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_third_invariant() const
+  {
+    Assert(update_flags & update_third_invariant,
+           ExcMessage("Needs update_third_invariant"));
+    return third_invariant;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<Tensor<2, spacedim, VectorizedArray<double>>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_first_invariant_dFF() const
+  {
+    Assert(update_flags & update_first_invariant_dFF,
+           ExcMessage("Needs update_first_invariant_dFF"));
+    return first_invariant_dFF;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<Tensor<2, spacedim, VectorizedArray<double>>> &
+  VectorizedMechanicsValues<dim, spacedim>::get_modified_first_invariant_dFF()
+    const
+  {
+    Assert(update_flags & update_modified_first_invariant_dFF,
+           ExcMessage("Needs update_modified_first_invariant_dFF"));
+    return modified_first_invariant_dFF;
+  }
 } // namespace fdl
 
 #endif
@@ -7,7 +7,9 @@
 
 #include <fiddle/mechanics/active_strain.h>
 #include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
 #include <fiddle/mechanics/mechanics_values.h>
+#include <fiddle/mechanics/reference_values_cache.h>
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/function.h>
@@ -30,13 +32,125 @@ FDL_ENABLE_EXTRA_DIAGNOSTICS
 
 #include <mpi.h>
 
+#include <functional>
+#include <iosfwd>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace fdl
 {
   using namespace dealii;
 
+  /**
+   * Preconditioners available for the mass matrix solves of a Part.
+   *
+   * - Jacobi: scale by the inverse of the (lumped) diagonal. This is the
+   *   default.
+   * - Chebyshev: apply a Chebyshev polynomial of the Jacobi-preconditioned
+   *   mass operator. This is more expensive per iteration but requires far
+   *   fewer iterations on distorted or high-order meshes.
+   */
+  enum class MassPreconditionerType
+  {
+    Jacobi,
+    Chebyshev
+  };
+
+  /**
+   * Renumberings of the DoFs of a Part, applied after the DoFs are
+   * distributed and before the MatrixFree object is set up.
+   *
+   * The DoFs set up by DoFHandler::distribute_dofs() follow the order of the
+   * cells (and therefore the order of the elements in the mesh file), so
+   * consecutive DoFs may be far apart in space. This hurts the cache behavior
+   * of gathering DoF values cell by cell and fragments the DoF ranges used by
+   * NodalPatchMap.
+   *
+   * - None: keep the numbering set up by DoFHandler::distribute_dofs(). This
+   *   is the default.
+   * - CuthillMcKee: use DoFRenumbering::Cuthill_McKee(), which minimizes the
+   *   bandwidth of the DoF connectivity.
+   * - Hilbert: number the DoFs cell by cell, with the locally owned cells
+   *   ordered along a Hilbert curve through their centers in the reference
+   *   configuration.
+   *
+   * All renumberings are deterministic, so two Parts set up in the same way
+   * (e.g., before and after a restart) have the same DoF numbering.
+   */
+  enum class DoFRenumberingType
+  {
+    None,
+    CuthillMcKee,
+    Hilbert
+  };
+
+  /**
+   * Preconditioner for the mass operator of a Part which dispatches to one of
+   * the preconditioners described by MassPreconditionerType. @p Number is the
+   * precision of the mass operator (e.g., float for the inner iterations of a
+   * mixed precision solve).
+   */
+  template <int dim, typename Number = double>
+  class MassPreconditioner
+  {
+  public:
+    using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+    using OperatorType = MatrixFreeOperators::Base<dim, VectorType>;
+
+    /**
+     * Constructor. Sets the type to MassPreconditionerType::Jacobi.
+     */
+    MassPreconditioner();
+
+    /**
+     * Set up the preconditioner. The diagonal of @p mass_operator must
+     * already be computed.
+     *
+     * @param[in] degree Degree of the Chebyshev polynomial. Ignored by the
+     * Jacobi preconditioner.
+     */
+    void
+    initialize(
+      const OperatorType          &mass_operator,
+      const MassPreconditionerType type   = MassPreconditionerType::Jacobi,
+      const unsigned int           degree = 3);
+
+    /**
+     * Same as above, but use @p inverse_diagonal (e.g., one loaded from a
+     * checkpoint) instead of the diagonal of @p mass_operator, which then
+     * does not need to be computed.
+     */
+    void
+    initialize(
+      const OperatorType                                &mass_operator,
+      const std::shared_ptr<DiagonalMatrix<VectorType>> &inverse_diagonal,
+      const MassPreconditionerType type   = MassPreconditionerType::Jacobi,
+      const unsigned int           degree = 3);
+
+    /**
+     * Get the type of preconditioner.
+     */
+    MassPreconditionerType
+    get_type() const;
+
+    /**
+     * Apply the preconditioner.
+     */
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+  protected:
+    MassPreconditionerType type;
+
+    // Jacobi preconditioner (also used by the Chebyshev preconditioner).
+    std::shared_ptr<DiagonalMatrix<VectorType>> inverse_diagonal;
+
+    PreconditionChebyshev<OperatorType, VectorType, DiagonalMatrix<VectorType>>
+      chebyshev;
+  };
+
   /**
    * Class encapsulating a single structure - essentially a wrapper that stores
    * the current position and velocity and can also compute the interior force
@@ -100,6 +214,9 @@ namespace fdl
 
     /**
      * Constructor.
+     *
+     * @param[in] renumbering Renumbering applied to the DoFs. See
+     * DoFRenumberingType.
      */
     Part(const Triangulation<dim, spacedim> &tria,
          const FiniteElement<dim, spacedim> &fe,
@@ -108,7 +225,8 @@ namespace fdl
          const Function<spacedim> &initial_position =
            Functions::IdentityFunction<spacedim>(),
          const Function<spacedim> &initial_velocity =
-           Functions::ZeroFunction<spacedim>(spacedim));
+           Functions::ZeroFunction<spacedim>(spacedim),
+         const DoFRenumberingType  renumbering = DoFRenumberingType::None);
 
     /**
      * Constructor, which uses an externally managed DoFHandler.
@@ -119,7 +237,8 @@ namespace fdl
          const Function<spacedim> &initial_position =
            Functions::IdentityFunction<spacedim>(),
          const Function<spacedim> &initial_velocity =
-           Functions::ZeroFunction<spacedim>(spacedim));
+           Functions::ZeroFunction<spacedim>(spacedim),
+         const DoFRenumberingType  renumbering = DoFRenumberingType::None);
 
     /**
      * Constructor including an active strain term.
@@ -133,7 +252,8 @@ namespace fdl
       const Function<spacedim> &initial_position =
         Functions::IdentityFunction<spacedim>(),
       const Function<spacedim> &initial_velocity =
-        Functions::ZeroFunction<spacedim>(spacedim));
+        Functions::ZeroFunction<spacedim>(spacedim),
+      const DoFRenumberingType  renumbering = DoFRenumberingType::None);
 
     /**
      * Constructor with an externally managed DoFHandler and active strain
@@ -147,8 +267,54 @@ namespace fdl
       const Function<spacedim> &initial_position =
         Functions::IdentityFunction<spacedim>(),
       const Function<spacedim> &initial_velocity =
-        Functions::ZeroFunction<spacedim>(spacedim));
+        Functions::ZeroFunction<spacedim>(spacedim),
+      const DoFRenumberingType  renumbering = DoFRenumberingType::None);
+
+
+    /**
+     * Distribute the DoFs again and set up everything which depends on them
+     * (e.g., the mass operator) after the owners of the cells of the
+     * Triangulation changed, e.g., with repartition_triangulation(). The
+     * position and velocity are transferred to the new partitioning, so that
+     * their values at every node do not change. This call is collective.
+     *
+     * Since the cells do not change, this function uses the old DoF numbering
+     * (which the DoFHandler keeps until its DoFs are distributed again) to
+     * find the old values. Hence the DoFHandler must not be modified between
+     * repartitioning the Triangulation and calling this function.
+     *
+     * @note Any vectors set up with the old value of get_partitioner() and
+     * any objects which store pointers to the old MatrixFree object or the
+     * old mass operator are invalid after calling this function.
+     */
+    void
+    reinit_dofs();
 
+    /**
+     * Estimate the cost of computing the forces on each active cell, e.g., to
+     * balance that work between processors with compute_weighted_owners()
+     * and repartition_triangulation() (followed by reinit_dofs()). Since the
+     * weights only depend on the Triangulation and the force contributions,
+     * this may be done at any time, e.g., at a regrid or after a restart.
+     *
+     * The cost of a cell is @p cell_cost plus, for each force contribution
+     * which is active on that cell, ForceContribution::get_cost() times the
+     * number of quadrature points. Stresses on cells with an active strain
+     * cost an additional @p active_strain_cost per quadrature point. Boundary
+     * forces which implement ForceContribution::get_active_boundary_ids()
+     * contribute on each face with a matching boundary id. The relative costs
+     * of the force contributions default to one but should typically be set
+     * to measured values (e.g., a Holzapfel-Ogden stress is several times as
+     * expensive to evaluate as a spring force).
+     *
+     * @return Positive integer weights of all active cells (which, for a
+     * parallel::shared::Triangulation, are available on every processor) in
+     * active cell index order, scaled so that the largest weight is 100.
+     * Artificial cells have weight one.
+     */
+    std::vector<unsigned int>
+    compute_cell_weights(const double cell_cost          = 1.0,
+                         const double active_strain_cost = 1.0) const;
 
     /**
      * Save the current state of the object to an archive.
@@ -165,7 +331,8 @@ namespace fdl
      *
      * This function only makes sense if the Part has been set up in the same
      * way as the one in the archive - in particular, they must use the same
-     * parallel data distribution and finite element spaces.
+     * parallel data distribution, finite element spaces, and
+     * DoFRenumberingType.
      *
      * @note at the present time no information from the force contributions is
      * loaded. This may change in the future.
@@ -173,6 +340,66 @@ namespace fdl
     void
     load(boost::archive::binary_iarchive &archive, const unsigned int version);
 
+    /**
+     * Write the locally owned values of the position and velocity to @p out.
+     * Unlike save(), this writes the raw values directly from the vectors
+     * (i.e., without an intermediate archive or copy).
+     */
+    void
+    write_state(std::ostream &out) const;
+
+    /**
+     * Read values previously written by write_state(). The same restrictions
+     * as for load() apply: in particular, the parallel data distribution must
+     * be the same.
+     */
+    void
+    read_state(std::istream &in);
+
+    /**
+     * Same as write_state(), but also write a partition-independent index
+     * (the order in which each DoF first appears when looping over all active
+     * cells) of each value, so that the state can be read with a different
+     * parallel data distribution (e.g., with a different number of
+     * processors) or DoF numbering.
+     */
+    void
+    write_portable_state(std::ostream &out) const;
+
+    /**
+     * Read values previously written by write_portable_state(), possibly
+     * with a different parallel data distribution. Each processor may read
+     * any number of streams (e.g., the files written by several processors
+     * of a previous run, or none at all): each value is then sent to the
+     * processor owning it with a single all-to-all exchange. Together, the
+     * streams of all processors must contain every DoF. Each stream is left
+     * at the end of the state of this part, so the states of several parts
+     * may be read from the same streams in order. This call is collective.
+     */
+    void
+    read_portable_state(const std::vector<std::istream *> &inputs);
+
+    /**
+     * Write the data which is deterministic but expensive to set up (at the
+     * moment, the inverse diagonal of the mass operator, if it has been
+     * computed) to @p out. The data is tagged with a key computed from the
+     * mesh, the finite element, the DoF numbering, and the parallel data
+     * distribution.
+     */
+    void
+    write_setup_data(std::ostream &out) const;
+
+    /**
+     * Read data previously written by write_setup_data(), which is only used
+     * if its key matches that of the current Part on every processor: e.g.,
+     * after restarting with the same number of processors. Otherwise the data
+     * is skipped and recomputed when it is needed. This call is collective.
+     *
+     * @return Whether or not the data was used.
+     */
+    bool
+    read_setup_data(std::istream &in);
+
     /**
      * Move constructor.
      */
@@ -234,6 +461,52 @@ namespace fdl
     std::shared_ptr<const MatrixFree<dim, double>>
     get_matrix_free() const;
 
+    /**
+     * Return the index of the quadrature rule in get_matrix_free() which can
+     * be used to compute the stress of force contribution @p force_n with the
+     * matrix-free version of compute_volumetric_pk1_load_vector(), or
+     * numbers::invalid_unsigned_int if that function cannot be used for this
+     * force contribution.
+     *
+     * This is only possible for stresses added in the constructor which
+     * implement ForceContribution::compute_vectorized_stress() and use a
+     * QGauss quadrature rule on parts without active strains.
+     */
+    unsigned int
+    get_matrix_free_quadrature_index(const unsigned int force_n) const;
+
+    /**
+     * Set up a ReferenceValuesCache for the cell quadrature rules of the
+     * current stresses. Rules which do not fit in @p max_bytes are not
+     * cached. Stresses added after calling this function are only cached if
+     * it is called again.
+     */
+    void
+    setup_reference_values_cache(const std::size_t max_bytes);
+
+    /**
+     * Return the ReferenceValuesCache set up by
+     * setup_reference_values_cache() or nullptr if there is none.
+     */
+    const ReferenceValuesCache<dim, spacedim> *
+    get_reference_values_cache() const;
+
+    /**
+     * Return the force contributions grouped by their quadrature rules (see
+     * group_force_contributions()). The groups are set up whenever the force
+     * contributions or DoFs change, so computing a load vector with them does
+     * not set up any FEValues objects or visit every boundary face (provided
+     * that the boundary forces implement
+     * ForceContribution::get_active_boundary_ids()). If @p exclude_matrix_free
+     * is true then the stresses for which get_matrix_free_quadrature_index()
+     * is valid are not included.
+     *
+     * @note Since the groups contain FEValues objects, the groups of a Part
+     * may only be used by one call to compute_load_vector() at a time.
+     */
+    std::vector<ForceContributionGroup<dim, spacedim>> &
+    get_force_contribution_groups(const bool exclude_matrix_free) const;
+
     /**
      * Return a reference to the quadrature used to set up the mass operator.
      */
@@ -248,16 +521,117 @@ namespace fdl
 
     /**
      * Get the mass operator.
+     *
+     * @note The diagonal of the mass operator is computed by the first call
+     * to get_mass_preconditioner() unless it was read by read_setup_data(),
+     * in which case it is not available from this object.
      */
     const MatrixFreeOperators::Base<dim> &
     get_mass_operator() const;
 
     /**
      * Get the preconditioner associated with the mass operator.
+     *
+     * Computing the diagonal of the mass operator requires a full pass over
+     * the mesh, so it and the preconditioner are only set up by the first
+     * call to this function after the DoFs or the preconditioner change:
+     * e.g., parts which only use the lumped mass matrix never compute them.
+     * That call is collective.
      */
-    const PreconditionJacobi<MatrixFreeOperators::Base<dim>> &
+    const MassPreconditioner<dim> &
     get_mass_preconditioner() const;
 
+    /**
+     * Whether or not get_single_precision_mass_operator() is implemented for
+     * this Part, i.e., whether dim == spacedim and the Part uses
+     * tensor-product elements of degree at most five.
+     */
+    bool
+    supports_single_precision_mass_operator() const;
+
+    /**
+     * Get a single precision version of the mass operator, e.g., for the
+     * inner iterations of a mixed precision solve. Its diagonal is computed
+     * so that it can be used with a Jacobi preconditioner. Like the diagonal
+     * of the double precision mass operator, this operator (which needs its
+     * own MatrixFree object) is only set up by the first call to this
+     * function after the DoFs change. That call is collective.
+     *
+     * @note This is only implemented if
+     * supports_single_precision_mass_operator() is true.
+     */
+    const MatrixFreeOperators::Base<dim,
+                                    LinearAlgebra::distributed::Vector<float>> &
+    get_single_precision_mass_operator() const;
+
+    /**
+     * Get the preconditioner associated with the single precision mass
+     * operator. This is the same type of preconditioner as the one returned
+     * by get_mass_preconditioner() and is set up by the first call to this
+     * function after the DoFs or the preconditioner change. That call is
+     * collective.
+     */
+    const MassPreconditioner<dim, float> &
+    get_single_precision_mass_preconditioner() const;
+
+    /**
+     * Change the preconditioner associated with the mass operator. By default,
+     * Part uses a Jacobi preconditioner. Like the default preconditioner, the
+     * new one is set up by the next call to get_mass_preconditioner().
+     *
+     * @param[in] degree Degree of the Chebyshev polynomial. Ignored by the
+     * Jacobi preconditioner.
+     */
+    void
+    set_mass_preconditioner(const MassPreconditionerType type,
+                            const unsigned int           degree = 3);
+
+    /**
+     * Get the inverse of the lumped (i.e., row-summed) mass matrix, stored as a
+     * vector. Scaling a right-hand side by this vector is a much cheaper (but
+     * less accurate) replacement for solving with the mass operator.
+     *
+     * @note Row-sum lumping is only well-defined when every row sum is
+     * positive (which is not the case, e.g., for quadratic simplex elements).
+     * This function throws an exception if that is not the case.
+     */
+    const LinearAlgebra::distributed::Vector<double> &
+    get_lumped_mass_inverse() const;
+
+    /**
+     * Solve the mass system for several right-hand sides at once with a
+     * Jacobi-preconditioned conjugate gradient method.
+     *
+     * Each system is solved independently (and stops iterating once it
+     * converges), but the reductions of all systems are done in a single
+     * collective operation per step. Hence this function is cheaper than
+     * solving one system at a time (e.g., with SolverCG), since the number of
+     * global reductions does not depend on the number of right-hand sides.
+     *
+     * @param[inout] solutions The solution vectors. Their values on input are
+     * used as initial guesses.
+     *
+     * @param[in] right_hand_sides The right-hand side vectors.
+     *
+     * @param[in] max_steps Maximum number of iterations. An exception of type
+     * SolverControl::NoConvergence is thrown if any system does not converge
+     * in this many iterations.
+     *
+     * @param[in] relative_tolerance Relative tolerance: i.e., the solve for
+     * right-hand side @p b is done when the l2 norm of its residual is less
+     * than this times the l2 norm of @p b.
+     *
+     * @return The number of iterations used by each system.
+     */
+    std::vector<unsigned int>
+    solve_mass_systems(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *>
+        &solutions,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                        &right_hand_sides,
+      const unsigned int max_steps,
+      const double       relative_tolerance) const;
+
     /**
      * Get the current position of the structure.
      */
@@ -294,6 +668,41 @@ namespace fdl
     void
     set_velocity(LinearAlgebra::distributed::Vector<double> &&position);
 
+    /**
+     * Set whether or not the part is active. Inactive parts do not interact
+     * with the fluid, do not compute their forces, and do not move: e.g.,
+     * IFEDMethod skips them when interpolating, spreading, computing forces,
+     * tagging cells, and estimating the workload. Parts are active by
+     * default.
+     */
+    void
+    set_active(const bool active);
+
+    /**
+     * Set the time intervals <code>[start, end)</code> in which the part is
+     * active. If there are no windows (the default) then the part is active
+     * at all times.
+     */
+    void
+    set_activation_windows(
+      const std::vector<std::pair<double, double>> &windows);
+
+    /**
+     * Return whether or not the part is active at time @p time, i.e., whether
+     * or not set_active() was not called with <code>false</code> and
+     * @p time is in one of the activation windows (if there are any).
+     */
+    bool
+    is_active(const double time) const;
+
+    /**
+     * Return an estimate of the number of bytes used by this object, i.e., its
+     * DoFHandler, MatrixFree object, mass operator, vectors, and caches. The
+     * Triangulation is owned by the caller and is not included.
+     */
+    std::size_t
+    memory_consumption() const;
+
   protected:
     /**
      * Actual archive function. Separate for now from load and save.
@@ -302,6 +711,21 @@ namespace fdl
     void
     serialize(Archive &ar, const unsigned int version);
 
+    /**
+     * Distribute the DoFs and set up the partitioner, MatrixFree object, and
+     * mass operator.
+     */
+    void
+    setup_dofs();
+
+    /**
+     * Group the force contributions by their quadrature rules and find the
+     * locally owned boundary faces on which each group of boundary forces may
+     * be active. Called by setup_dofs() and add_force_contribution().
+     */
+    void
+    setup_force_contribution_groups();
+
     /**
      * Triangulation of the part.
      */
@@ -344,8 +768,49 @@ namespace fdl
     // Mass operator. Used for L2 projections.
     std::unique_ptr<MatrixFreeOperators::Base<dim>> mass_operator;
 
-    // Preconditioner.
-    PreconditionJacobi<MatrixFreeOperators::Base<dim>> mass_preconditioner;
+    // Renumbering applied to the DoFs.
+    DoFRenumberingType renumbering;
+
+    // Preconditioner. Set up by get_mass_preconditioner().
+    mutable MassPreconditioner<dim> mass_preconditioner;
+
+    // Degree of the preconditioner, if it is a Chebyshev preconditioner.
+    unsigned int mass_preconditioner_degree;
+
+    // Type of the preconditioner.
+    MassPreconditionerType mass_preconditioner_type;
+
+    // Whether or not the diagonal of the mass operator has been computed and
+    // the preconditioner has been set up.
+    mutable bool mass_preconditioner_is_initialized;
+
+    // Inverse diagonal of the mass operator, if it has been computed or read
+    // by read_setup_data().
+    mutable std::shared_ptr<
+      DiagonalMatrix<LinearAlgebra::distributed::Vector<double>>>
+      mass_diagonal_inverse;
+
+    // Single precision MatrixFree object and mass operator. Set up by
+    // get_single_precision_mass_operator().
+    mutable std::shared_ptr<MatrixFree<dim, float>>
+      single_precision_matrix_free;
+
+    mutable std::unique_ptr<
+      MatrixFreeOperators::Base<dim, LinearAlgebra::distributed::Vector<float>>>
+      single_precision_mass_operator;
+
+    // Preconditioner for the single precision mass operator. Set up by
+    // get_single_precision_mass_preconditioner().
+    mutable MassPreconditioner<dim, float> single_precision_mass_preconditioner;
+
+    // Whether or not the single precision preconditioner has been set up.
+    mutable bool single_precision_mass_preconditioner_is_initialized;
+
+    // Inverse of the lumped mass matrix.
+    LinearAlgebra::distributed::Vector<double> lumped_mass_inverse;
+
+    // Whether or not all entries of the lumped mass matrix are positive.
+    bool lumped_mass_is_positive;
 
     // Position.
     LinearAlgebra::distributed::Vector<double> position;
@@ -357,14 +822,70 @@ namespace fdl
     std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
       force_contributions;
 
+    // Indices of the MatrixFree quadrature rules of each force contribution.
+    std::vector<unsigned int> matrix_free_quadrature_indices;
+
+    // Optional cache of reference configuration values.
+    std::unique_ptr<ReferenceValuesCache<dim, spacedim>> reference_values_cache;
+
+    // Size limit of the cache, or zero if there is no cache.
+    std::size_t reference_values_cache_max_bytes;
+
+    // Force contributions grouped by their quadrature rules. The FEValues
+    // objects in the groups are scratch data, so these are mutable.
+    mutable std::vector<ForceContributionGroup<dim, spacedim>>
+      force_contribution_groups;
+
+    // Same, but without the stresses which use the MatrixFree object.
+    mutable std::vector<ForceContributionGroup<dim, spacedim>>
+      non_matrix_free_force_contribution_groups;
+
     // Active strains.
     std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains;
+
+    // Whether or not the part is active (subject to activation_windows).
+    bool active;
+
+    // Time intervals in which the part is active. Empty means always.
+    std::vector<std::pair<double, double>> activation_windows;
   };
 
+  /**
+   * Set up several parts by calling each of @p part_factories (which should
+   * typically construct and return a Part). Setting up a Part (distributing
+   * DoFs, setting up the MatrixFree object and mass operator, interpolating
+   * the initial position and velocity, etc.) is expensive, so this function
+   * can set up independent parts concurrently.
+   *
+   * @param[in] use_threads Whether or not to call the factories concurrently
+   * with deal.II's task system. Since constructing a Part is collective, this
+   * requires that MPI was initialized with MPI_THREAD_MULTIPLE and that each
+   * part uses its own communicator (as with IFEDMethod's
+   * threaded_mass_solves). Otherwise the factories are called in order.
+   *
+   * @param[out] setup_times If not nullptr, set to the wall time (measured
+   * with MPI_Wtime()) spent setting up each part on the current processor.
+   *
+   * @return The parts, in the same order as @p part_factories.
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<Part<dim, spacedim>>
+  setup_parts(
+    const std::vector<std::function<Part<dim, spacedim>()>> &part_factories,
+    const bool                                               use_threads,
+    std::vector<double> *setup_times = nullptr);
+
 
   // --------------------------- inline functions --------------------------- //
 
 
+  template <int dim, typename Number>
+  inline MassPreconditionerType
+  MassPreconditioner<dim, Number>::get_type() const
+  {
+    return type;
+  }
+
   // Functions for getting basic objects owned by the Part
 
   template <int dim, int spacedim>
@@ -404,6 +925,31 @@ namespace fdl
     return matrix_free;
   }
 
+  template <int dim, int spacedim>
+  unsigned int
+  Part<dim, spacedim>::get_matrix_free_quadrature_index(
+    const unsigned int force_n) const
+  {
+    AssertIndexRange(force_n, matrix_free_quadrature_indices.size());
+    return matrix_free_quadrature_indices[force_n];
+  }
+
+  template <int dim, int spacedim>
+  const ReferenceValuesCache<dim, spacedim> *
+  Part<dim, spacedim>::get_reference_values_cache() const
+  {
+    return reference_values_cache.get();
+  }
+
+  template <int dim, int spacedim>
+  std::vector<ForceContributionGroup<dim, spacedim>> &
+  Part<dim, spacedim>::get_force_contribution_groups(
+    const bool exclude_matrix_free) const
+  {
+    return exclude_matrix_free ? non_matrix_free_force_contribution_groups :
+                                 force_contribution_groups;
+  }
+
   template <int dim, int spacedim>
   const Quadrature<dim> &
   Part<dim, spacedim>::get_quadrature() const
@@ -427,11 +973,15 @@ namespace fdl
   }
 
   template <int dim, int spacedim>
-  const PreconditionJacobi<MatrixFreeOperators::Base<dim>> &
-  Part<dim, spacedim>::get_mass_preconditioner() const
+  const LinearAlgebra::distributed::Vector<double> &
+  Part<dim, spacedim>::get_lumped_mass_inverse() const
   {
     AssertThrow(dim == spacedim, ExcFDLNotImplemented());
-    return mass_preconditioner;
+    AssertThrow(lumped_mass_is_positive,
+                ExcMessage("The lumped mass matrix should only have positive "
+                           "entries: row-sum lumping does not work with this "
+                           "finite element."));
+    return lumped_mass_inverse;
   }
 
   // Functions for getting and setting state vectors
@@ -489,6 +1039,29 @@ namespace fdl
            ExcMessage("The partitioners must be compatible"));
     velocity.swap(vel);
   }
+
+  // Functions for activation
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::set_active(const bool act)
+  {
+    active = act;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  Part<dim, spacedim>::is_active(const double time) const
+  {
+    if (!active)
+      return false;
+    if (activation_windows.empty())
+      return true;
+    for (const std::pair<double, double> &window : activation_windows)
+      if (window.first <= time && time < window.second)
+        return true;
+    return false;
+  }
 } // namespace fdl
 
 #endif
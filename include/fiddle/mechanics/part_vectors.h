@@ -9,6 +9,7 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace fdl
@@ -70,6 +71,12 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> &
     get_force(const unsigned int part_n, const double time) const;
 
+    // Get a nonzero number identifying the position at the given time. It is
+    // the same on every processor and changes whenever the position does: see
+    // InteractionBase::set_position_state().
+    std::uint64_t
+    get_position_state(const unsigned int part_n, const double time) const;
+
     // Set the position. Only valid for time != current_time.
     void
     set_position(const unsigned int                         part_n,
@@ -88,6 +95,19 @@ namespace fdl
               const double                               time,
               LinearAlgebra::distributed::Vector<double> force);
 
+    // Get a vector with the same partitioner as the given part's position,
+    // reusing the storage of a vector given to recycle_vector() if possible.
+    // The values of the returned vector are unspecified.
+    LinearAlgebra::distributed::Vector<double>
+    get_temporary_vector(const unsigned int part_n) const;
+
+    // Give a vector which is no longer needed (e.g., a temporary or a vector
+    // replaced in a Part) back to this object so that get_temporary_vector()
+    // can reuse its storage.
+    void
+    recycle_vector(const unsigned int                           part_n,
+                   LinearAlgebra::distributed::Vector<double> &&vector);
+
     // Get all new position vectors by moving them out of this object. Intended
     // to be called at the end of the time step.
     std::vector<LinearAlgebra::distributed::Vector<double>>
@@ -98,6 +118,12 @@ namespace fdl
     std::vector<LinearAlgebra::distributed::Vector<double>>
     get_all_new_velocities();
 
+    /**
+     * Return the number of bytes used by the stored vectors.
+     */
+    std::size_t
+    memory_consumption() const;
+
     DeclExceptionMsg(ExcVectorNotAvailable,
                      "The requested vector is not available. This usually "
                      "occurs when this function is called with the wrong time "
@@ -117,6 +143,11 @@ namespace fdl
     TimeStep
     get_time_step(const double time) const;
 
+    // Compute the position at the half time (which is not available until it
+    // is requested) as the average of the current and new positions.
+    void
+    compute_half_position(const unsigned int part_n) const;
+
     double current_time;
     double half_time;
     double new_time;
@@ -125,11 +156,29 @@ namespace fdl
     std::vector<LinearAlgebra::distributed::Vector<double>> half_forces;
     std::vector<LinearAlgebra::distributed::Vector<double>> new_forces;
 
-    std::vector<LinearAlgebra::distributed::Vector<double>> half_positions;
+    // Half positions are computed when they are first requested, so they are
+    // mutable.
+    mutable std::vector<LinearAlgebra::distributed::Vector<double>>
+      half_positions;
+
     std::vector<LinearAlgebra::distributed::Vector<double>> new_positions;
 
+    mutable std::uint64_t last_position_state;
+
+    std::vector<std::uint64_t>         current_position_states;
+    mutable std::vector<std::uint64_t> half_position_states;
+    std::vector<std::uint64_t>         new_position_states;
+
+    // Whether or not each half position was computed by
+    // compute_half_position() (rather than set).
+    mutable std::vector<bool> computed_half_positions;
+
     std::vector<LinearAlgebra::distributed::Vector<double>> half_velocities;
     std::vector<LinearAlgebra::distributed::Vector<double>> new_velocities;
+
+    // Vectors (for each part) whose storage may be reused.
+    mutable std::vector<std::vector<LinearAlgebra::distributed::Vector<double>>>
+      spare_vectors;
   };
 } // namespace fdl
 
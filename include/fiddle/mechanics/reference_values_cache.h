@@ -0,0 +1,181 @@
+#ifndef included_fiddle_mechanics_reference_values_cache_h
+#define included_fiddle_mechanics_reference_values_cache_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Cache of the shape function gradients and JxW values, in the reference
+   * configuration, of a Lagrangian part on each locally owned cell. These
+   * never change (unless the DoFHandler does) so this class lets
+   * compute_load_vector() skip FEValues entirely for stresses and only gather
+   * the position gradients each time step.
+   *
+   * Since the cache scales like the number of cells times the number of
+   * quadrature points times the number of DoFs per cell, this class stores at
+   * most a user-specified number of bytes: quadrature rules which do not fit
+   * are not cached and are evaluated with FEValues as usual.
+   *
+   * This class requires a primitive vector-valued finite element with spacedim
+   * components.
+   */
+  template <int dim, int spacedim = dim>
+  class ReferenceValuesCache
+  {
+  public:
+    using active_cell_iterator =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] max_bytes Maximum number of bytes to use for the cached
+     * values.
+     */
+    ReferenceValuesCache(const DoFHandler<dim, spacedim> &dof_handler,
+                         const Mapping<dim, spacedim>    &mapping,
+                         const std::size_t                max_bytes);
+
+    /**
+     * Cache the values for a quadrature rule. Does nothing if it is already
+     * cached.
+     *
+     * @return Whether or not the values are cached, i.e., whether or not
+     * they fit in the remaining memory.
+     */
+    bool
+    add_quadrature(const Quadrature<dim> &quadrature);
+
+    /**
+     * Return the index of @p quadrature in the cache or
+     * numbers::invalid_unsigned_int if it is not cached.
+     */
+    unsigned int
+    get_quadrature_index(const Quadrature<dim> &quadrature) const;
+
+    /**
+     * Return the locally owned cells, in the order the cached values are
+     * stored.
+     */
+    const std::vector<active_cell_iterator> &
+    get_cells() const;
+
+    /**
+     * Return the vector component of each shape function.
+     */
+    const std::vector<unsigned int> &
+    get_components() const;
+
+    /**
+     * Return the JxW values of cell @p cell_n (i.e., the index into
+     * get_cells()) for the quadrature rule with index @p quadrature_index.
+     */
+    ArrayView<const double>
+    get_JxW_values(const unsigned int quadrature_index,
+                   const std::size_t  cell_n) const;
+
+    /**
+     * Return the gradients of the nonzero components of the shape functions of
+     * cell @p cell_n for the quadrature rule with index @p quadrature_index.
+     * These are stored with the quadrature point index running fastest.
+     */
+    ArrayView<const Tensor<1, spacedim>>
+    get_shape_gradients(const unsigned int quadrature_index,
+                        const std::size_t  cell_n) const;
+
+    /**
+     * Return the number of bytes used by the cached values.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    /**
+     * Values for a single quadrature rule.
+     */
+    struct Entry
+    {
+      Quadrature<dim> quadrature;
+
+      std::vector<double> JxW_values;
+
+      std::vector<Tensor<1, spacedim>> shape_gradients;
+    };
+
+    SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
+
+    SmartPointer<const Mapping<dim, spacedim>> mapping;
+
+    std::size_t max_bytes;
+
+    std::vector<active_cell_iterator> cells;
+
+    std::vector<unsigned int> components;
+
+    std::vector<Entry> entries;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim, int spacedim>
+  inline const std::vector<
+    typename ReferenceValuesCache<dim, spacedim>::active_cell_iterator> &
+  ReferenceValuesCache<dim, spacedim>::get_cells() const
+  {
+    return cells;
+  }
+
+  template <int dim, int spacedim>
+  inline const std::vector<unsigned int> &
+  ReferenceValuesCache<dim, spacedim>::get_components() const
+  {
+    return components;
+  }
+
+  template <int dim, int spacedim>
+  inline ArrayView<const double>
+  ReferenceValuesCache<dim, spacedim>::get_JxW_values(
+    const unsigned int quadrature_index,
+    const std::size_t  cell_n) const
+  {
+    AssertIndexRange(quadrature_index, entries.size());
+    AssertIndexRange(cell_n, cells.size());
+    const Entry       &entry      = entries[quadrature_index];
+    const std::size_t n_q_points = entry.quadrature.size();
+    return make_array_view(entry.JxW_values.data() + cell_n * n_q_points,
+                           entry.JxW_values.data() +
+                             (cell_n + 1) * n_q_points);
+  }
+
+  template <int dim, int spacedim>
+  inline ArrayView<const Tensor<1, spacedim>>
+  ReferenceValuesCache<dim, spacedim>::get_shape_gradients(
+    const unsigned int quadrature_index,
+    const std::size_t  cell_n) const
+  {
+    AssertIndexRange(quadrature_index, entries.size());
+    AssertIndexRange(cell_n, cells.size());
+    const Entry      &entry = entries[quadrature_index];
+    const std::size_t n_values =
+      entry.quadrature.size() * dof_handler->get_fe().dofs_per_cell;
+    return make_array_view(entry.shape_gradients.data() + cell_n * n_values,
+                           entry.shape_gradients.data() +
+                             (cell_n + 1) * n_values);
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef included_fiddle_mechanics_tangent_stiffness_operator_h
+#define included_fiddle_mechanics_tangent_stiffness_operator_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <memory>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Matrix-free tangent stiffness operator of a set of stresses, i.e., the
+   * linearization of the load vector computed by the matrix-free version of
+   * compute_volumetric_pk1_load_vector() about some position. More exactly,
+   * if that load vector is
+   *
+   *     F(X)_i = -(PP(FF(X)), grad phi_i)
+   *
+   * then this operator computes
+   *
+   *     (K dX)_i = -(dF(X)/dX dX)_i = (dPP/dFF : grad dX, grad phi_i)
+   *
+   * in which the directional derivative of each stress is computed by
+   * ForceContribution::compute_vectorized_stress_derivative(). The operator
+   * is symmetric since the stresses are derived from strain energies. It is
+   * singular (e.g., rigid translations are in its kernel), so it is usually
+   * combined with a mass matrix or boundary conditions.
+   *
+   * Like the load vector, the deformation gradient is computed with
+   * FEEvaluation: reinit() stores it at every quadrature point, so each call
+   * to vmult() only needs one pass over the cells to compute the gradient of
+   * the direction and the stress derivatives.
+   */
+  template <int dim>
+  class TangentStiffnessOperator
+  {
+  public:
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] stresses Stresses which implement
+     * ForceContribution::compute_vectorized_stress_derivative() and use the
+     * quadrature rule with index @p quadrature_index in @p matrix_free (see
+     * Part::get_matrix_free_quadrature_index()).
+     */
+    TangentStiffnessOperator(
+      std::shared_ptr<const MatrixFree<dim, double>>    matrix_free,
+      const unsigned int                                quadrature_index,
+      const std::vector<ForceContribution<dim, dim> *> &stresses);
+
+    /**
+     * Linearize the stresses about @p position at time @p time.
+     */
+    void
+    reinit(const double time, const VectorType &position);
+
+    /**
+     * Compute dst = K src.
+     */
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Compute dst += K src.
+     */
+    void
+    vmult_add(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Set up a vector with the partitioner of the MatrixFree object.
+     */
+    void
+    initialize_dof_vector(VectorType &vector) const;
+
+    /**
+     * Return the memory consumption of this object in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    void
+    apply(VectorType       &result,
+          const VectorType &direction,
+          const bool        zero_result) const;
+
+    std::shared_ptr<const MatrixFree<dim, double>> matrix_free;
+
+    unsigned int quadrature_index;
+
+    std::vector<ForceContribution<dim, dim> *> stresses;
+
+    MechanicsUpdateFlags me_flags;
+
+    double time;
+
+    unsigned int n_quadrature_points;
+
+    /**
+     * Deformation gradient at each quadrature point of each cell batch.
+     */
+    AlignedVector<Tensor<2, dim, VectorizedArray<double>>> FF;
+  };
+} // namespace fdl
+
+#endif
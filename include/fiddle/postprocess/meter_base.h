@@ -14,11 +14,14 @@
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/la_parallel_vector.h>
 
 #include <tbox/Pointer.h>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace SAMRAI
 {
@@ -106,6 +109,14 @@ namespace fdl
     virtual Point<spacedim>
     get_centroid() const;
 
+    /**
+     * Return the cell containing the centroid (see get_centroid()) and the
+     * coordinates of the centroid on that cell's reference cell.
+     */
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>
+    get_centroid_cell() const;
+
     /** @} */
 
     /* @name FSI
@@ -147,10 +158,22 @@ namespace fdl
     /**
      * Return whether or not all vertices of the Triangulation are actually
      * inside the domain defined by the PatchHierarchy.
+     *
+     * If every vertex was inside the domain at the last call then the result
+     * is reused (without locating any vertices) as long as no vertex has
+     * since moved further than the smallest distance from a vertex to the
+     * boundary of the domain.
      */
     bool
     compute_vertices_inside_domain() const;
 
+    /**
+     * Return an estimate of the number of bytes used by this object, including
+     * its Triangulation, DoFHandlers, and NodalInteraction.
+     */
+    std::size_t
+    memory_consumption() const;
+
     /** @} */
 
   protected:
@@ -160,6 +183,16 @@ namespace fdl
     void
     reinit_dofs();
 
+    /**
+     * Reinitialize the cached quadrature data (shape function values, JxW
+     * values, and the measure of the meter). This avoids setting up FEValues
+     * objects every time a value is computed.
+     *
+     * @note This function should typically be called after reinit_dofs().
+     */
+    void
+    reinit_quadrature_data();
+
     /**
      * Reinitialize centroid data.
      */
@@ -175,8 +208,8 @@ namespace fdl
     reinit_interaction();
 
     /**
-     * Helper function which calls the previous three functions in the correct
-     * order (dofs, centroid, then interaction).
+     * Helper function which calls the previous four functions in the correct
+     * order (dofs, quadrature data, centroid, then interaction).
      *
      * Since inheriting classes set up meter_tria in a variety of different
      * ways, they should typically set up that object themselves first and then
@@ -221,6 +254,24 @@ namespace fdl
      */
     Quadrature<dim> meter_quadrature;
 
+    /**
+     * Values of the scalar shape functions at the quadrature points, indexed
+     * by quadrature point and then by shape function. Since scalar_fe is a
+     * nodal Lagrange element these values do not depend on the mapping.
+     */
+    FullMatrix<double> shape_values;
+
+    /**
+     * JxW values on each locally owned cell, stored contiguously in the order
+     * in which the cells are traversed.
+     */
+    std::vector<double> JxW_values;
+
+    /**
+     * Measure (i.e., length, area, or volume) of the meter.
+     */
+    double measure;
+
     /**
      * Scalar FiniteElement used on meter_tria
      */
@@ -255,6 +306,19 @@ namespace fdl
      * Interaction object.
      */
     std::unique_ptr<NodalInteraction<dim, spacedim>> nodal_interaction;
+
+    /**
+     * Vertex coordinates at the last call to compute_vertices_inside_domain()
+     * which located the vertices.
+     */
+    mutable std::vector<double> checked_vertex_coordinates;
+
+    /**
+     * Smallest distance from one of those vertices to the boundary of the
+     * domain, or zero if that distance is not known (e.g., if a vertex was
+     * outside the domain).
+     */
+    mutable double checked_vertex_margin;
   };
 
 
@@ -295,6 +359,14 @@ namespace fdl
   {
     return centroid;
   }
+
+  template <int dim, int spacedim>
+  inline std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                   Point<dim>>
+  MeterBase<dim, spacedim>::get_centroid_cell() const
+  {
+    return std::make_pair(centroid_cell, ref_centroid);
+  }
 } // namespace fdl
 
 #endif
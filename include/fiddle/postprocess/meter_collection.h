@@ -0,0 +1,358 @@
+#ifndef included_fiddle_postprocess_meter_collection_h
+#define included_fiddle_postprocess_meter_collection_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/postprocess/meter_base.h>
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <tbox/Pointer.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SAMRAI
+{
+  namespace hier
+  {
+    template <int>
+    class PatchHierarchy;
+  }
+} // namespace SAMRAI
+
+namespace fdl
+{
+  template <int, int>
+  class NodalInteraction;
+}
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  /**
+   * Class which evaluates many meters at once.
+   *
+   * Each meter owns its own NodalInteraction, so computing, e.g., the flux
+   * through each of several dozen meters requires several dozen complete
+   * interpolations (each of which communicates) followed by several dozen
+   * reductions. This class instead copies the meshes of all meters into a
+   * single Triangulation (in which the material id of each cell is the index
+   * of the meter it came from) and uses one NodalInteraction for all of them.
+   * Hence each field is interpolated once and all results are reduced in a
+   * single call to MPI_Allreduce().
+   *
+   * Like the meters themselves, the mesh of this class is in absolute
+   * coordinates: if any meter moves then reinit() must be called.
+   *
+   * The values may also be computed asynchronously with compute_values_start()
+   * and compute_values_finish(). In that case only the interpolation, which
+   * requires the current Cartesian-grid data, is done immediately: the
+   * integration over the meter meshes is done by a background task and the
+   * results are reduced when they are requested. For example, each time step
+   * can first call compute_values_finish() to get the values of the previous
+   * time step and then compute_values_start() for the current one, so that
+   * logging values (e.g., flows and pressures) does not stall the time loop.
+   *
+   * @note All meters must use the same finite element (i.e., their meshes
+   * must either all be simplex or all be hypercube meshes).
+   */
+  template <int dim, int spacedim = dim>
+  class MeterCollection
+  {
+  public:
+    /**
+     * Values computed by compute_values(). Each vector has one entry per
+     * meter (or is empty, if the corresponding value was not requested).
+     */
+    struct Values
+    {
+      /**
+       * Flux of the vector field through each meter.
+       */
+      std::vector<double> fluxes;
+
+      /**
+       * Mean value of the scalar field on each meter.
+       */
+      std::vector<double> mean_values;
+
+      /**
+       * Value of the scalar field at the centroid of each meter.
+       */
+      std::vector<double> centroid_values;
+    };
+
+    /**
+     * Constructor. This call is collective.
+     *
+     * @warning This class stores pointers to the meters, which must remain
+     * valid until this object is destroyed.
+     */
+    MeterCollection(
+      const std::vector<const MeterBase<dim, spacedim> *> &meters,
+      tbox::Pointer<hier::PatchHierarchy<spacedim>>        patch_hierarchy);
+
+    /**
+     * Destructor. See the note in ~MeterBase().
+     */
+    ~MeterCollection();
+
+    /**
+     * Copy the current meshes of the meters and reinitialize all data
+     * structures. This call is collective.
+     *
+     * @note This function may not be called while an asynchronous computation
+     * (see compute_values_start()) is in progress.
+     */
+    void
+    reinit();
+
+    /**
+     * Return the number of meters.
+     */
+    std::size_t
+    size() const;
+
+    /**
+     * Return the Triangulation containing the meshes of all meters.
+     */
+    const Triangulation<dim, spacedim> &
+    get_triangulation() const;
+
+    /**
+     * Compute all quantities which depend on the scalar field
+     * @p scalar_data_idx (mean and centroid values) and the vector field
+     * @p vector_data_idx (fluxes). Each field is interpolated once and all
+     * values are reduced together.
+     *
+     * @param[in] scalar_data_idx Data index of a scalar field on the Cartesian
+     * grid, or -1 to skip the mean and centroid values.
+     *
+     * @param[in] vector_data_idx Data index of a vector field on the
+     * Cartesian grid, or -1 to skip the fluxes. Fluxes can only be computed
+     * for codimension one meters.
+     */
+    Values
+    compute_values(const int          scalar_data_idx,
+                   const int          vector_data_idx,
+                   const std::string &kernel_name) const;
+
+    /**
+     * Start computing the same values as compute_values(). This function
+     * interpolates the fields (and hence communicates) and then integrates
+     * them in a background task, so the Cartesian-grid data may be modified
+     * or deallocated as soon as this function returns. This call is
+     * collective.
+     *
+     * @note At most one computation may be in progress at a time.
+     */
+    void
+    compute_values_start(const int          scalar_data_idx,
+                         const int          vector_data_idx,
+                         const std::string &kernel_name) const;
+
+    /**
+     * Finish the computation started by compute_values_start() and return the
+     * same values as compute_values(). This call is collective.
+     */
+    Values
+    compute_values_finish() const;
+
+    /**
+     * Return whether or not compute_values_start() was called without a
+     * matching call to compute_values_finish().
+     */
+    bool
+    has_pending_values() const;
+
+    /**
+     * Compute the flux of a vector field through each meter. Equivalent to
+     * calling SurfaceMeter::compute_flux() for each meter.
+     */
+    std::vector<double>
+    compute_fluxes(const int data_idx, const std::string &kernel_name) const;
+
+    /**
+     * Compute the mean value of a scalar field on each meter. Equivalent to
+     * calling MeterBase::compute_mean_value() for each meter.
+     */
+    std::vector<double>
+    compute_mean_values(const int          data_idx,
+                        const std::string &kernel_name) const;
+
+    /**
+     * Compute the value of a scalar field at the centroid of each meter.
+     * Equivalent to calling MeterBase::compute_centroid_value() for each
+     * meter.
+     */
+    std::vector<double>
+    compute_centroid_values(const int          data_idx,
+                            const std::string &kernel_name) const;
+
+  protected:
+    /**
+     * Interpolate a field onto collection_tria.
+     */
+    LinearAlgebra::distributed::Vector<double>
+    interpolate(const int                        data_idx,
+                const std::string               &kernel_name,
+                const DoFHandler<dim, spacedim> &dof_handler) const;
+
+    /**
+     * Compute the local contributions to the fluxes, integrals, and centroid
+     * values (in that order) from interpolated fields. Empty vectors are
+     * skipped. This function does not communicate.
+     */
+    std::vector<double>
+    compute_local_values(
+      const LinearAlgebra::distributed::Vector<double> &scalar_data,
+      const LinearAlgebra::distributed::Vector<double> &vector_data) const;
+
+    /**
+     * Convert the sums of the values computed by compute_local_values() into
+     * a Values object.
+     */
+    Values
+    make_values(const std::vector<double> &values,
+                const bool                 has_scalar_values,
+                const bool                 has_vector_values) const;
+
+    /**
+     * Pointers to the meters.
+     */
+    std::vector<const MeterBase<dim, spacedim> *> meters;
+
+    /**
+     * Cartesian-grid data.
+     */
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy;
+
+    /**
+     * Triangulation containing the cells of all meters, in order.
+     */
+    parallel::shared::Triangulation<dim, spacedim> collection_tria;
+
+    /**
+     * Mapping on collection_tria.
+     */
+    std::unique_ptr<Mapping<dim, spacedim>> collection_mapping;
+
+    /**
+     * Quadrature used on collection_tria. This is the same as the quadrature
+     * used by the meters.
+     */
+    Quadrature<dim> collection_quadrature;
+
+    /**
+     * Scalar FiniteElement used on collection_tria.
+     */
+    std::unique_ptr<FiniteElement<dim, spacedim>> scalar_fe;
+
+    /**
+     * Vector FiniteElement used on collection_tria.
+     */
+    std::unique_ptr<FiniteElement<dim, spacedim>> vector_fe;
+
+    /**
+     * DoFHandler for scalar quantities defined on collection_tria.
+     */
+    DoFHandler<dim, spacedim> scalar_dof_handler;
+
+    /**
+     * DoFHandler for vector-valued quantities defined on collection_tria.
+     */
+    DoFHandler<dim, spacedim> vector_dof_handler;
+
+    std::shared_ptr<Utilities::MPI::Partitioner> vector_partitioner;
+
+    std::shared_ptr<Utilities::MPI::Partitioner> scalar_partitioner;
+
+    /**
+     * Positions of the mesh DoFs - always the identity function.
+     */
+    LinearAlgebra::distributed::Vector<double> identity_position;
+
+    /**
+     * Measure of each meter.
+     */
+    std::vector<double> measures;
+
+    /**
+     * Cell of collection_tria containing the centroid of each meter and the
+     * centroid in reference cell coordinates.
+     * @{
+     */
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      centroid_cells;
+
+    std::vector<Point<dim>> ref_centroids;
+    /**
+     * @}
+     */
+
+    /**
+     * Interaction object.
+     */
+    std::unique_ptr<NodalInteraction<dim, spacedim>> nodal_interaction;
+
+    /**
+     * Data for the asynchronous computation of values. The interpolated
+     * fields are kept alive until the background task finishes.
+     * @{
+     */
+    mutable LinearAlgebra::distributed::Vector<double> pending_scalar_data;
+
+    mutable LinearAlgebra::distributed::Vector<double> pending_vector_data;
+
+    mutable bool pending_has_scalar_values;
+
+    mutable bool pending_has_vector_values;
+
+    mutable std::future<std::vector<double>> pending_local_values;
+    /**
+     * @}
+     */
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  inline std::size_t
+  MeterCollection<dim, spacedim>::size() const
+  {
+    return meters.size();
+  }
+
+  template <int dim, int spacedim>
+  inline const Triangulation<dim, spacedim> &
+  MeterCollection<dim, spacedim>::get_triangulation() const
+  {
+    return collection_tria;
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  MeterCollection<dim, spacedim>::has_pending_values() const
+  {
+    return pending_local_values.valid();
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef included_fiddle_postprocess_part_output_h
+#define included_fiddle_postprocess_part_output_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/data_out_base.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which writes the fields of a Part to VTU files from a background
+   * thread.
+   *
+   * Writing output with DataOut::write_vtu_with_pvtu_record() from the time
+   * loop stalls every processor until the slowest one has built its patches,
+   * compressed them, and written them to disk. This class instead only
+   * copies the position, velocity, and any additional vectors (e.g., a force
+   * from PartVectors) of the Part in write(): everything else, i.e., building
+   * the patches in the current configuration, compressing them with zlib,
+   * and writing one file per processor (and, on the first processor, the
+   * .pvtu and .pvd records), is done by a background task which does not
+   * communicate.
+   *
+   * At most one write is in progress at a time: if the previous one has not
+   * finished then write() waits for it after copying the vectors, so at most
+   * two copies of the fields are stored. Hence output frequency only affects
+   * the wall time when the files cannot be written as fast as they are
+   * requested.
+   *
+   * @warning The background task reads the Triangulation and DoFHandler of
+   * the Part: call wait() before modifying either (e.g., with
+   * Part::reinit_dofs()) or destroying the Part.
+   */
+  template <int dim, int spacedim = dim>
+  class PartOutput
+  {
+  public:
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] directory Directory in which the files are written.
+     *
+     * @param[in] name Prefix of each file.
+     *
+     * @param[in] n_subdivisions Number of subdivisions of each cell used to
+     * represent curved (e.g., high-order) cells. Zero means the degree of the
+     * Part's finite element.
+     *
+     * @param[in] compression_level zlib compression level of the VTU files.
+     */
+    PartOutput(const std::string                  &directory,
+               const std::string                  &name,
+               const unsigned int                  n_subdivisions = 0,
+               const DataOutBase::CompressionLevel compression_level =
+                 DataOutBase::CompressionLevel::best_speed);
+
+    /**
+     * Destructor. Waits for the current write to finish.
+     */
+    ~PartOutput();
+
+    /**
+     * Write the velocity (with name U) of @p part and the given additional
+     * vectors, which must use the partitioner of @p part, in the
+     * configuration given by the position of @p part. This call is
+     * collective over the communicator of @p part.
+     *
+     * @param[in] output_n Number of the output, which is part of each file
+     * name.
+     *
+     * @param[in] time Time stored in the files and the .pvd record.
+     */
+    void
+    write(const Part<dim, spacedim>                                   &part,
+          const unsigned int                                           output_n,
+          const double                                                 time,
+          const std::vector<std::pair<std::string, const VectorType *>>
+            &additional_vectors = {});
+
+    /**
+     * Wait for the current write, if any, to finish. Exceptions thrown while
+     * writing are rethrown here.
+     */
+    void
+    wait();
+
+    /**
+     * Return whether or not a write is in progress.
+     */
+    bool
+    has_pending_write() const;
+
+  protected:
+    std::string directory;
+
+    std::string name;
+
+    unsigned int n_subdivisions;
+
+    DataOutBase::CompressionLevel compression_level;
+
+    /**
+     * Times and names of the .pvtu records written so far, used for the .pvd
+     * record. Only used on the first processor.
+     */
+    std::vector<std::pair<double, std::string>> pvd_records;
+
+    /**
+     * Current write, if any.
+     */
+    std::future<void> pending_write;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim, int spacedim>
+  inline bool
+  PartOutput<dim, spacedim>::has_pending_write() const
+  {
+    return pending_write.valid();
+  }
+} // namespace fdl
+
+#endif
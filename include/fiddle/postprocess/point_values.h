@@ -26,6 +26,12 @@ namespace fdl
    * Convenience class for computing values of a finite element field at a set
    * of known points over time. Sets up some internal data structures that make
    * repeated calls to evaluate() much faster.
+   *
+   * In particular, the points are only located on the Triangulation once:
+   * the search is redone if the Triangulation changes or if reinit() is
+   * called. Since the mapping and evaluation points are typically in
+   * reference coordinates (see the constructor) the search remains valid as
+   * the structure moves.
    */
   template <int n_components, int dim, int spacedim = dim>
   class PointValues
@@ -42,6 +48,20 @@ namespace fdl
                 const DoFHandler<dim, spacedim>    &dof_handler,
                 const std::vector<Point<spacedim>> &evaluation_points);
 
+    /**
+     * Locate the evaluation points on the Triangulation again, e.g., because
+     * the mapping changed. This call is collective.
+     */
+    void
+    reinit();
+
+    /**
+     * Set new evaluation points and locate them on the Triangulation. This
+     * call is collective.
+     */
+    void
+    reinit(const std::vector<Point<spacedim>> &evaluation_points);
+
     /**
      * Evaluate the finite element field specified by @p vector at the stored
      * evaluation points. For example - to get the displacement of a point over
@@ -50,6 +70,15 @@ namespace fdl
     std::vector<Tensor<1, n_components>>
     evaluate(const LinearAlgebra::distributed::Vector<double> &vector) const;
 
+    /**
+     * Same as the other evaluate() function, but evaluates several finite
+     * element fields (all defined with the stored DoFHandler) at once.
+     */
+    std::vector<std::vector<Tensor<1, n_components>>>
+    evaluate(
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &vectors) const;
+
     /**
      * Return a reference to the evaluation points originally used to set up
      * this object.
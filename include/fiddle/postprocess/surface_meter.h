@@ -13,10 +13,14 @@
 
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/grid/tria.h>
+
 #include <deal.II/lac/la_parallel_vector.h>
 
 #include <tbox/Pointer.h>
 
+#include <mpi.h>
+
 #include <memory>
 #include <utility>
 #include <vector>
@@ -133,6 +137,28 @@ namespace fdl
     bool
     uses_codim_zero_mesh() const;
 
+    /**
+     * Set whether or not reinitialization with new boundary points should
+     * move the vertices of the current meter mesh (via fit_boundary_vertices())
+     * instead of triangulating the boundary again. Typically the boundary of a
+     * meter moves every time step but its topology does not change, so this
+     * is much less expensive.
+     *
+     * The mesh is only created again, from scratch, if the number of boundary
+     * points changes or if the quality of some cell drops below
+     * @p min_cell_quality. Here the quality of a triangle is its area divided
+     * by the area of an equilateral triangle with the same sum of squared edge
+     * lengths, i.e., it is one for an equilateral triangle and zero for a
+     * degenerate one.
+     *
+     * @note This only affects meters in 3D which do not place additional
+     * boundary vertices. In 2D the meter mesh is inexpensive to create and is
+     * always created again.
+     */
+    void
+    set_incremental_reinit(const bool   use_incremental_reinit,
+                           const double min_cell_quality = 0.3);
+
     /**
      * Reinitialize the meter mesh to have its coordinates specified by @p
      * position and velocity by @p velocity.
@@ -144,6 +170,29 @@ namespace fdl
     reinit(const LinearAlgebra::distributed::Vector<double> &position,
            const LinearAlgebra::distributed::Vector<double> &velocity);
 
+    /**
+     * Reinitialize several meters at once. This is equivalent to calling
+     * reinit(positions[i], *velocities[i]) on each meter, except that the
+     * meters which need a new mesh (i.e., those whose meshes cannot be moved
+     * - see set_incremental_reinit()) are triangulated on different
+     * processors: the <code>k</code>th such meter is triangulated on
+     * processor <code>k % n_procs</code>, which then sends the new mesh to
+     * all other processors. Hence, with many meters, each processor only
+     * triangulates a few of them instead of all of them. Since every
+     * processor then uses the same mesh, the meshes also no longer depend on
+     * the (slightly different) boundary points computed on each processor.
+     *
+     * All meters must have been set up with finite element data. This call
+     * is collective.
+     */
+    static void
+    reinit(
+      const std::vector<SurfaceMeter<dim, spacedim> *> &meters,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &positions,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &velocities);
+
     /**
      * Alternative reinitialization function which (like the alternative
      * constructor) uses purely nodal data.
@@ -192,9 +241,31 @@ namespace fdl
     virtual std::pair<double, Tensor<1, spacedim>>
     compute_flux(const int data_idx, const std::string &kernel_name) const;
 
+    /**
+     * Start computing the flux through the meter. This function interpolates
+     * the field and computes the local contribution to the flux and then
+     * starts a nonblocking reduction, so that other work (e.g., the next fluid
+     * solve) can be done before calling compute_flux_finish().
+     *
+     * @note At most one flux computation may be in progress at a time.
+     */
+    void
+    compute_flux_start(const int          data_idx,
+                       const std::string &kernel_name) const;
+
+    /**
+     * Finish the reduction started by compute_flux_start() and return the same
+     * values as compute_flux().
+     */
+    std::pair<double, Tensor<1, spacedim>>
+    compute_flux_finish() const;
+
     /**
      * Compute the mean normal vector. This is useful for checking the
      * orientation of the mesh.
+     *
+     * @note This value is computed when the meter is reinitialized, so this
+     * function does not communicate.
      */
     virtual Tensor<1, spacedim>
     compute_mean_normal_vector() const;
@@ -216,6 +287,35 @@ namespace fdl
     reinit_tria(const std::vector<Point<spacedim>> &boundary_points,
                 const bool place_additional_boundary_vertices);
 
+    /**
+     * Create a sequential meter mesh from @p boundary_points with cells whose
+     * edges are approximately @p dx long. Unlike reinit_tria() this does not
+     * communicate or modify this object.
+     */
+    void
+    create_serial_tria(const std::vector<Point<spacedim>> &boundary_points,
+                       const bool   place_additional_boundary_vertices,
+                       const double dx,
+                       Triangulation<dim - 1, spacedim> &serial_tria) const;
+
+    /**
+     * Set up the stored Triangulation as a copy of @p serial_tria, which was
+     * created by create_serial_tria() from @p n_boundary_points points.
+     */
+    void
+    set_tria(const Triangulation<dim - 1, spacedim> &serial_tria,
+             const std::size_t                       n_boundary_points,
+             const bool place_additional_boundary_vertices);
+
+    /**
+     * Try to reinitialize the stored Triangulation by moving its vertices.
+     * Returns whether or not this succeeded - if it did not then
+     * reinit_tria() should be called instead.
+     */
+    bool
+    move_tria(const std::vector<Point<spacedim>> &boundary_points,
+              const bool place_additional_boundary_vertices);
+
     /**
      * Reinitialize the mean velocity of the meter itself from values of the
      * velocity specified at the boundary nodes. This function assumes that the
@@ -228,6 +328,15 @@ namespace fdl
     reinit_mean_velocity(
       const std::vector<Tensor<1, spacedim>> &velocity_values);
 
+    /**
+     * Reinitialize the normal vectors (scaled by the JxW values) at each
+     * quadrature point and the mean normal vector.
+     *
+     * @note This should be called after MeterBase::reinit_quadrature_data().
+     */
+    void
+    reinit_normal_data();
+
     /**
      * Internal reinitialization function which updates all data structures to
      * account for possible meter movement. Call the other protected reinit_*()
@@ -258,6 +367,51 @@ namespace fdl
      * Mean meter velocity.
      */
     Tensor<1, spacedim> mean_velocity;
+
+    /**
+     * Normal vectors multiplied by JxW values on each locally owned cell,
+     * stored in the same order as MeterBase::JxW_values.
+     */
+    std::vector<Tensor<1, spacedim>> normal_JxW_values;
+
+    /**
+     * Mean normal vector.
+     */
+    Tensor<1, spacedim> mean_normal;
+
+    /**
+     * Data for the nonblocking flux reduction.
+     * @{
+     */
+    mutable MPI_Request flux_request;
+
+    mutable double local_flux;
+
+    mutable double global_flux;
+    /**
+     * @}
+     */
+
+    /**
+     * Whether or not move_tria() should be used.
+     */
+    bool use_incremental_reinit;
+
+    /**
+     * Minimum cell quality used by move_tria().
+     */
+    double min_cell_quality;
+
+    /**
+     * Number of boundary points used to create the current meter mesh.
+     */
+    std::size_t n_boundary_points;
+
+    /**
+     * Sequential copy of meter_tria, whose vertices are moved by move_tria().
+     * Empty unless incremental reinitialization is enabled.
+     */
+    Triangulation<dim - 1, spacedim> serial_meter_tria;
   };
 
 
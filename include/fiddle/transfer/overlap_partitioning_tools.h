@@ -9,10 +9,50 @@
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <map>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
 
+  /**
+   * Description of which native cells are needed by which overlap
+   * triangulations. Since this only depends on the OverlapTriangulation it
+   * can be computed once and then used to compute the DoF translations of
+   * every DoFHandler on that triangulation.
+   *
+   * Cells are described by their level and index on the native triangulation
+   * (stored consecutively) since, unlike CellIds, these can be converted to
+   * iterators in constant time.
+   */
+  struct OverlapCellExchange
+  {
+    /**
+     * Levels and indices of the native cells equivalent to the locally owned
+     * active cells of the overlap triangulation, grouped by the rank owning
+     * the native cell and in the order of the overlap active cells.
+     */
+    std::map<types::subdomain_id, std::vector<int>> native_cells_on_overlap;
+
+    /**
+     * Levels and indices of locally owned native cells requested by other
+     * processors, grouped by the requesting rank.
+     */
+    std::map<types::subdomain_id, std::vector<int>> requested_native_cells;
+  };
+
+  /**
+   * Compute the OverlapCellExchange for @p overlap_tria.
+   *
+   * @note This function is collective over the communicator used by the
+   * native triangulation.
+   */
+  template <int dim, int spacedim = dim>
+  OverlapCellExchange
+  compute_overlap_cell_exchange(
+    const fdl::OverlapTriangulation<dim, spacedim> &overlap_tria);
+
   /**
    * Compute the dof translation between degrees of freedom assigned to the
    * OverlapTriangulation and the equivalent degrees of freedom assigned to
@@ -32,6 +72,19 @@ namespace fdl
     const fdl::OverlapTriangulation<dim, spacedim> &overlap_tria,
     const DoFHandler<dim, spacedim>                &overlap_dof_handler,
     const DoFHandler<dim, spacedim>                &native_dof_handler);
+
+  /**
+   * Same as the other version of this function, but use a precomputed
+   * @p cell_exchange, i.e., the output of compute_overlap_cell_exchange() for
+   * @p overlap_tria.
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<types::global_dof_index>
+  compute_overlap_to_native_dof_translation(
+    const fdl::OverlapTriangulation<dim, spacedim> &overlap_tria,
+    const OverlapCellExchange                      &cell_exchange,
+    const DoFHandler<dim, spacedim>                &overlap_dof_handler,
+    const DoFHandler<dim, spacedim>                &native_dof_handler);
 } // namespace fdl
 
 #endif
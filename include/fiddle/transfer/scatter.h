@@ -11,10 +11,41 @@
 
 #include <mpi.h>
 
+#include <cstdint>
+#include <map>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
 
+  template <typename T>
+  class ScatterGroup;
+
+  /**
+   * Enumeration describing the way in which Scatter communicates.
+   */
+  enum class ScatterBackend
+  {
+    /**
+     * Post new nonblocking sends and receives for every scatter (i.e., do the
+     * same thing as dealii::MPI::Partitioner).
+     */
+    PointToPoint,
+
+    /**
+     * Use persistent requests which are set up once per channel and then
+     * reused.
+     */
+    Persistent,
+
+    /**
+     * Use nonblocking neighborhood collectives on a distributed graph
+     * communicator connecting each processor to its partners.
+     */
+    NeighborCollective
+  };
+
   /**
    * dealii::MPI::Partitioner-based replacement for PETSc's VecScatter. Moves
    * data back-and-forth from the standard 'global' partitioning to the overlap
@@ -26,8 +57,30 @@ namespace fdl
    * at a time: i.e., after each start the corresponding finish function must be
    * called.
    *
+   * By default, like dealii::MPI::Partitioner, each scatter posts new
+   * nonblocking sends and receives. Since the communication pattern never
+   * changes, this class can instead set up persistent MPI requests (with
+   * MPI_Send_init() and MPI_Recv_init()) the first time a scatter is done on a
+   * given channel and then reuse them (with MPI_Startall()) in every
+   * subsequent scatter on that channel. This avoids the request setup cost,
+   * which dominates when messages are small.
+   *
+   * Alternatively, this class can set up distributed graph communicators
+   * (with MPI_Dist_graph_create_adjacent()) connecting each processor to the
+   * processors it exchanges data with and then do each scatter with a single
+   * call to MPI_Ineighbor_alltoallv(), which lets the MPI implementation
+   * schedule all messages at once. Since the neighborhood collectives are
+   * collective over the entire communicator, every processor must call
+   * the start and finish functions. The channel argument is ignored by this
+   * backend since collectives are matched in the order in which they are
+   * started.
+   *
    * @todo Add a constructor taking a dealii::MPI::Partitioner object to share
    * communication data between instances.
+   *
+   * @todo Support vectors stored in device memory. This is not useful yet
+   * since all interaction calculations read from and write to host-resident
+   * SAMRAI patch data, so every overlap vector must be on the host anyway.
    */
   template <typename T>
   class Scatter
@@ -51,10 +104,19 @@ namespace fdl
 
     /**
      * Constructor.
+     *
+     * @param[in] backend The way in which this object communicates. Any
+     * persistent requests or graph communicators are freed by the destructor.
      */
     Scatter(const std::vector<types::global_dof_index> &overlap_dofs,
             const IndexSet                             &local,
-            const MPI_Comm                             &communicator);
+            const MPI_Comm                             &communicator,
+            const ScatterBackend backend = ScatterBackend::PointToPoint);
+
+    /**
+     * Destructor. Frees any persistent MPI requests and graph communicators.
+     */
+    ~Scatter();
 
     /**
      * Scatter a sequential vector indexed by the specified overlap dofs into
@@ -108,7 +170,55 @@ namespace fdl
     std::vector<MPI_Request>
     delegate_outstanding_requests();
 
+    /**
+     * Return the total number of bytes this object has sent to other
+     * processors (i.e., summed over all scatters it has started).
+     */
+    std::uint64_t
+    get_n_bytes_sent() const;
+
+    /**
+     * Return the total number of bytes this object has received from other
+     * processors.
+     */
+    std::uint64_t
+    get_n_bytes_received() const;
+
+    /**
+     * Return the total time (in seconds) this object has spent waiting for
+     * its MPI requests in overlap_to_global_finish() and
+     * global_to_overlap_finish(). Requests delegated with
+     * delegate_outstanding_requests() are not waited for here and are
+     * instead accounted for by whoever completes them (e.g.,
+     * TransactionScheduler). For ScatterBackend::PointToPoint this also
+     * includes copying the received data out of the buffers.
+     */
+    double
+    get_wait_time() const;
+
+    /**
+     * Return an estimate of the number of bytes used by this object, i.e., its
+     * partitioner, index arrays, and communication buffers.
+     */
+    std::size_t
+    memory_consumption() const;
+
   protected:
+    /**
+     * Copy the locally owned entries of @p input needed by other processors
+     * into import_buffer.
+     */
+    void
+    pack_import_buffer(const LinearAlgebra::distributed::Vector<T> &input);
+
+    /**
+     * Copy the received ghost values in ghost_buffer and the locally owned
+     * values of @p input into @p output.
+     */
+    void
+    unpack_ghost_buffer(const LinearAlgebra::distributed::Vector<T> &input,
+                        Vector<T>                                   &output);
+
     std::shared_ptr<Utilities::MPI::Partitioner> partitioner;
 
     /**
@@ -117,42 +227,303 @@ namespace fdl
     std::size_t n_overlap_dofs;
 
     /**
-     * Indices of overlap_dofs which correspond to entries in the ghost buffer.
-     * These are sorted so that the first entry is an index into an
-     * overlap-partitioned vector corresponding to the in the first entry of the
-     * ghost buffer (i.e., they are contiguous in the ghost buffer and not in
-     * the overlap-partitioned vector).
+     * A contiguous range of entries in an overlap-partitioned vector which
+     * corresponds to a contiguous range of entries in some other array.
+     */
+    struct IndexRun
+    {
+      /**
+       * Index of the first entry in the overlap-partitioned vector.
+       */
+      unsigned int overlap_start;
+
+      /**
+       * Index of the first entry in the other array.
+       */
+      unsigned int other_start;
+
+      /**
+       * Number of entries in the run.
+       */
+      unsigned int length;
+    };
+
+    /**
+     * Runs of overlap dofs which correspond to entries in the ghost buffer,
+     * sorted by their position in the ghost buffer. Overlap dofs typically
+     * come in long contiguous runs, so packing and unpacking copies whole
+     * runs instead of individual entries.
      */
-    std::vector<unsigned int> overlap_ghost_indices;
+    std::vector<IndexRun> ghost_runs;
 
     /**
-     * Indices of overlap_dofs which correspond to local (i.e, computed with
+     * Runs of overlap dofs which correspond to local (i.e, computed with
      * Partitioner::global_to_local()) locally-owned (i.e., not in the ghost
-     * region) indices of the global vector. The first entry in the pair is an
-     * index into an overlap-partitioned vector and the second is the local
-     * index of a global vector.
+     * region) indices of the global vector, sorted by their position in the
+     * overlap-partitioned vector.
      */
-    std::vector<std::pair<unsigned int, unsigned int>> overlap_local_indices;
+    std::vector<IndexRun> local_runs;
 
     AlignedVector<T>         ghost_buffer;
     AlignedVector<T>         import_buffer;
     std::vector<MPI_Request> requests;
+
+    /**
+     * Communication statistics returned by get_n_bytes_sent(),
+     * get_n_bytes_received(), and get_wait_time().
+     */
+    std::uint64_t n_bytes_sent;
+    std::uint64_t n_bytes_received;
+    double        wait_time;
+
+    /**
+     * The way in which this object communicates.
+     */
+    ScatterBackend backend;
+
+    /**
+     * Persistent requests for global to overlap scatters, indexed by channel.
+     */
+    std::map<unsigned int, std::vector<MPI_Request>> export_requests;
+
+    /**
+     * Persistent requests for overlap to global scatters, indexed by channel.
+     */
+    std::map<unsigned int, std::vector<MPI_Request>> import_requests;
+
+    /**
+     * Get (and, if necessary, create) the persistent requests for global to
+     * overlap scatters using channel @p channel.
+     */
+    std::vector<MPI_Request> &
+    get_export_requests(const unsigned int channel);
+
+    /**
+     * Get (and, if necessary, create) the persistent requests for overlap to
+     * global scatters using channel @p channel.
+     */
+    std::vector<MPI_Request> &
+    get_import_requests(const unsigned int channel);
+
+    /**
+     * Free all persistent requests.
+     */
+    void
+    free_persistent_requests();
+
+    /**
+     * Graph communicator used by global to overlap scatters: the sources are
+     * the owners of our ghost dofs and the destinations are the processors
+     * which have our locally owned dofs as ghosts.
+     */
+    MPI_Comm export_graph_communicator;
+
+    /**
+     * Graph communicator used by overlap to global scatters: the reverse of
+     * export_graph_communicator.
+     */
+    MPI_Comm import_graph_communicator;
+
+    /**
+     * Number of entries and offsets into ghost_buffer for each ghost target,
+     * in the order required by MPI_Ineighbor_alltoallv().
+     */
+    std::vector<int> ghost_counts;
+    std::vector<int> ghost_offsets;
+
+    /**
+     * Number of entries and offsets into import_buffer for each import
+     * target, in the order required by MPI_Ineighbor_alltoallv().
+     */
+    std::vector<int> import_counts;
+    std::vector<int> import_offsets;
+
+    /**
+     * Set up the graph communicators and counts used by the neighborhood
+     * collective backend.
+     */
+    void
+    setup_graph_communicators();
+
+    /**
+     * Free the graph communicators.
+     */
+    void
+    free_graph_communicators();
+
+    friend class ScatterGroup<T>;
+  };
+
+  /**
+   * Class which does the global to overlap scatters of several Scatter
+   * objects (e.g., the position scatters of every part) at once. Instead of
+   * sending one message per Scatter to each partner, this class concatenates
+   * all data sent to the same processor into a single message, so, e.g.,
+   * twenty parts with small messages to the same neighbor send one message
+   * instead of twenty.
+   *
+   * The Scatters must be provided in the same order on every processor: the
+   * message sent to a given processor contains each Scatter's data in
+   * order. The Scatters may use different (but congruent) communicators -
+   * this class communicates on its own duplicate of the communicator
+   * provided to the constructor, so its messages never match those of the
+   * underlying Scatters.
+   *
+   * Like Scatter, this class can only handle one scatter at a time. The
+   * Scatter objects must not be used for other scatters, moved, or destroyed
+   * while this object exists.
+   */
+  template <typename T>
+  class ScatterGroup
+  {
+  public:
+    /**
+     * Constructor. This call is collective over @p communicator, since it
+     * duplicates the communicator.
+     */
+    ScatterGroup(const MPI_Comm                   &communicator,
+                 const std::vector<Scatter<T> *> &scatters);
+
+    ScatterGroup(const ScatterGroup<T> &) = delete;
+
+    ScatterGroup<T> &
+    operator=(const ScatterGroup<T> &) = delete;
+
+    /**
+     * Destructor. Frees the duplicated communicator.
+     */
+    ~ScatterGroup();
+
+    /**
+     * Start the global to overlap scatter of each Scatter: i.e., this is
+     * equivalent to calling <code>scatters[i]->global_to_overlap_start()</code>
+     * with <code>*inputs[i]</code> for each i.
+     */
+    void
+    global_to_overlap_start(
+      const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs);
+
+    /**
+     * Finish the global to overlap scatter. @p inputs must be the vectors
+     * provided to global_to_overlap_start().
+     */
+    void
+    global_to_overlap_finish(
+      const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs,
+      const std::vector<Vector<T> *> &outputs);
+
+    /**
+     * Return the number of messages the current processor sends in each
+     * scatter.
+     */
+    std::size_t
+    n_messages_sent() const;
+
+  protected:
+    /**
+     * A contiguous part of a message which corresponds to a contiguous range
+     * of one Scatter's import_buffer or ghost_buffer.
+     */
+    struct Segment
+    {
+      unsigned int scatter_n;
+      unsigned int buffer_start;
+      unsigned int length;
+    };
+
+    /**
+     * Messages to or from other processors. The segments of message i are
+     * <code>segments[segment_offsets[i]]</code> through
+     * <code>segments[segment_offsets[i + 1] - 1]</code> and its data is
+     * stored in <code>buffer[buffer_offsets[i]]</code> through
+     * <code>buffer[buffer_offsets[i + 1] - 1]</code>.
+     */
+    struct Messages
+    {
+      std::vector<int>         ranks;
+      std::vector<Segment>     segments;
+      std::vector<std::size_t> segment_offsets;
+      std::vector<std::size_t> buffer_offsets;
+      AlignedVector<T>         buffer;
+    };
+
+    std::vector<Scatter<T> *> scatters;
+
+    MPI_Comm communicator;
+
+    /**
+     * Messages containing ghost values from their owners.
+     */
+    Messages receives;
+
+    /**
+     * Messages containing locally owned values needed by other processors.
+     */
+    Messages sends;
+
+    std::vector<MPI_Request> requests;
+
+    std::uint64_t n_bytes_sent;
+    std::uint64_t n_bytes_received;
+    double        wait_time;
   };
 
+  /**
+   * Return the total number of bytes sent to other processors by all Scatter
+   * objects on the current processor.
+   */
+  std::uint64_t
+  get_total_scatter_bytes_sent();
+
+  /**
+   * Return the total number of bytes received from other processors by all
+   * Scatter objects on the current processor.
+   */
+  std::uint64_t
+  get_total_scatter_bytes_received();
+
+  /**
+   * Return the total time (in seconds) all Scatter objects on the current
+   * processor have spent waiting for MPI requests: see
+   * Scatter::get_wait_time().
+   */
+  double
+  get_total_scatter_wait_time();
+
 
   // --------------------------- inline functions --------------------------- //
 
 
   template <typename T>
   inline Scatter<T>::Scatter(Scatter<T> &&t)
+    : n_overlap_dofs(0)
+    , n_bytes_sent(0)
+    , n_bytes_received(0)
+    , wait_time(0.0)
+    , backend(ScatterBackend::PointToPoint)
+    , export_graph_communicator(MPI_COMM_NULL)
+    , import_graph_communicator(MPI_COMM_NULL)
   {
     partitioner.swap(t.partitioner);
     std::swap(n_overlap_dofs, t.n_overlap_dofs);
-    overlap_ghost_indices.swap(t.overlap_ghost_indices);
-    overlap_local_indices.swap(t.overlap_local_indices);
+    ghost_runs.swap(t.ghost_runs);
+    local_runs.swap(t.local_runs);
     ghost_buffer.swap(t.ghost_buffer);
     import_buffer.swap(t.import_buffer);
     requests.swap(t.requests);
+    std::swap(n_bytes_sent, t.n_bytes_sent);
+    std::swap(n_bytes_received, t.n_bytes_received);
+    std::swap(wait_time, t.wait_time);
+    // persistent requests point into the buffers, which we now own
+    std::swap(backend, t.backend);
+    export_requests.swap(t.export_requests);
+    import_requests.swap(t.import_requests);
+    std::swap(export_graph_communicator, t.export_graph_communicator);
+    std::swap(import_graph_communicator, t.import_graph_communicator);
+    ghost_counts.swap(t.ghost_counts);
+    ghost_offsets.swap(t.ghost_offsets);
+    import_counts.swap(t.import_counts);
+    import_offsets.swap(t.import_offsets);
   }
 
   template <typename T>
@@ -161,12 +532,52 @@ namespace fdl
   {
     partitioner.swap(t.partitioner);
     std::swap(n_overlap_dofs, t.n_overlap_dofs);
-    overlap_ghost_indices.swap(t.overlap_ghost_indices);
-    overlap_local_indices.swap(t.overlap_local_indices);
+    ghost_runs.swap(t.ghost_runs);
+    local_runs.swap(t.local_runs);
     ghost_buffer.swap(t.ghost_buffer);
     import_buffer.swap(t.import_buffer);
     requests.swap(t.requests);
+    std::swap(n_bytes_sent, t.n_bytes_sent);
+    std::swap(n_bytes_received, t.n_bytes_received);
+    std::swap(wait_time, t.wait_time);
+    std::swap(backend, t.backend);
+    export_requests.swap(t.export_requests);
+    import_requests.swap(t.import_requests);
+    std::swap(export_graph_communicator, t.export_graph_communicator);
+    std::swap(import_graph_communicator, t.import_graph_communicator);
+    ghost_counts.swap(t.ghost_counts);
+    ghost_offsets.swap(t.ghost_offsets);
+    import_counts.swap(t.import_counts);
+    import_offsets.swap(t.import_offsets);
     return *this;
   }
+
+  template <typename T>
+  inline std::uint64_t
+  Scatter<T>::get_n_bytes_sent() const
+  {
+    return n_bytes_sent;
+  }
+
+  template <typename T>
+  inline std::uint64_t
+  Scatter<T>::get_n_bytes_received() const
+  {
+    return n_bytes_received;
+  }
+
+  template <typename T>
+  inline double
+  Scatter<T>::get_wait_time() const
+  {
+    return wait_time;
+  }
+
+  template <typename T>
+  inline std::size_t
+  ScatterGroup<T>::n_messages_sent() const
+  {
+    return sends.ranks.size();
+  }
 } // namespace fdl
 #endif
@@ -1,26 +1,231 @@
 #include <fiddle/base/exceptions.h>
 #include <fiddle/base/initial_guess.h>
 
+#include <deal.II/base/mpi.h>
+
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
 #include <Eigen/Dense>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
 
+  namespace
+  {
+    template <typename Number>
+    std::size_t
+    n_local_elements(const Vector<Number> &vector)
+    {
+      return vector.size();
+    }
+
+    template <typename Number>
+    std::size_t
+    n_local_elements(const LinearAlgebra::distributed::Vector<Number> &vector)
+    {
+      return vector.locally_owned_size();
+    }
+
+    template <typename Number>
+    void
+    sum_inner_products(const Vector<Number> &, Eigen::VectorXd &)
+    {
+      // nothing to do for serial vectors
+    }
+
+    template <typename Number>
+    void
+    sum_inner_products(const LinearAlgebra::distributed::Vector<Number> &vector,
+                       Eigen::VectorXd &inner_products)
+    {
+      const ArrayView<double> view(inner_products.data(),
+                                   inner_products.size());
+      Utilities::MPI::sum(ArrayView<const double>(view.data(), view.size()),
+                          vector.get_mpi_communicator(),
+                          view);
+    }
+
+    /**
+     * Compute the inner products of @p vector with each entry of @p vectors
+     * and, if @p include_self is true, with itself (stored last). Unlike
+     * computing each inner product separately, this does a single pass over
+     * the local entries and (for distributed vectors) a single reduction.
+     */
+    template <typename VectorType>
+    Eigen::VectorXd
+    compute_inner_products(const std::vector<const VectorType *> &vectors,
+                           const VectorType                      &vector,
+                           const bool                             include_self)
+    {
+      using Number                 = typename VectorType::value_type;
+      const unsigned int n_vectors = vectors.size();
+      Eigen::VectorXd    inner_products =
+        Eigen::VectorXd::Zero(n_vectors + (include_self ? 1 : 0));
+
+      std::vector<const Number *> pointers;
+      for (unsigned int j = 0; j < n_vectors; ++j)
+        {
+          AssertDimension(n_local_elements(*vectors[j]),
+                          n_local_elements(vector));
+          pointers.push_back(vectors[j]->begin());
+        }
+      const Number *const vector_pointer = vector.begin();
+      double *const       sums           = inner_products.data();
+      const std::size_t   n_elements     = n_local_elements(vector);
+      for (std::size_t i = 0; i < n_elements; ++i)
+        {
+          const double value = vector_pointer[i];
+          for (unsigned int j = 0; j < n_vectors; ++j)
+            sums[j] += value * pointers[j][i];
+          if (include_self)
+            sums[n_vectors] += value * value;
+        }
+      sum_inner_products(vector, inner_products);
+
+      return inner_products;
+    }
+
+    /**
+     * Same as above, but with the first @p n_vectors entries of @p vectors.
+     */
+    template <typename VectorType>
+    Eigen::VectorXd
+    compute_inner_products(const std::deque<VectorType> &vectors,
+                           const unsigned int            n_vectors,
+                           const VectorType             &vector,
+                           const bool                    include_self)
+    {
+      Assert(n_vectors <= vectors.size(), ExcFDLInternalError());
+      std::vector<const VectorType *> pointers;
+      for (unsigned int j = 0; j < n_vectors; ++j)
+        pointers.push_back(&vectors[j]);
+      return compute_inner_products(pointers, vector, include_self);
+    }
+
+    /**
+     * Compute the index of the period containing @p time and the index of
+     * the phase interval, in that period, containing @p time.
+     */
+    std::pair<long int, unsigned int>
+    get_phase(const double       time,
+              const double       period,
+              const unsigned int n_phases)
+    {
+      const double   scaled_time  = time / period;
+      const long int period_index = std::floor(scaled_time);
+      const double   phase        = scaled_time - period_index;
+      // phase may round to one
+      const unsigned int phase_index =
+        std::min(static_cast<unsigned int>(phase * n_phases), n_phases - 1);
+      return std::make_pair(period_index, phase_index);
+    }
+  } // namespace
+
   template <typename VectorType>
-  InitialGuess<VectorType>::InitialGuess(const unsigned int n_vectors)
-    : n_max_vectors(n_vectors)
+  InitialGuess<VectorType>::InitialGuess(const unsigned int     n_vectors,
+                                         const InitialGuessType guess_type,
+                                         const double           period,
+                                         const unsigned int     n_phases)
+    : type(guess_type)
+    , n_max_vectors(n_vectors)
     , n_stored_vectors(0)
     , last_rhs(nullptr)
-  {}
+    , period_length(period)
+    , n_phase_intervals(n_phases)
+    , current_time(0.0)
+  {
+    switch (type)
+      {
+        case InitialGuessType::Projection:
+          break;
+        case InitialGuessType::IncrementalProjection:
+          cholesky_factor.setZero(n_max_vectors, n_max_vectors);
+          break;
+        case InitialGuessType::LinearExtrapolation:
+          n_max_vectors = std::min(n_max_vectors, 2u);
+          break;
+        case InitialGuessType::QuadraticExtrapolation:
+          n_max_vectors = std::min(n_max_vectors, 3u);
+          break;
+        case InitialGuessType::PeriodicProjection:
+          AssertThrow(period > 0.0,
+                      ExcMessage("The period must be positive."));
+          AssertThrow(n_phases > 0,
+                      ExcMessage("The number of phases must be positive."));
+          phase_entries.resize(n_phases);
+          break;
+        default:
+          AssertThrow(false, ExcFDLNotImplemented());
+      }
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::set_time(const double time)
+  {
+    current_time = time;
+  }
 
   template <typename VectorType>
   void
   InitialGuess<VectorType>::submit(const VectorType &solution,
                                    const VectorType &rhs)
+  {
+    switch (type)
+      {
+        case InitialGuessType::Projection:
+          submit_projection(solution, rhs);
+          break;
+        case InitialGuessType::IncrementalProjection:
+          submit_incremental_projection(solution, rhs);
+          break;
+        case InitialGuessType::LinearExtrapolation:
+        case InitialGuessType::QuadraticExtrapolation:
+          submit_extrapolation(solution);
+          break;
+        case InitialGuessType::PeriodicProjection:
+          submit_periodic_projection(solution, rhs);
+          break;
+        default:
+          Assert(false, ExcFDLInternalError());
+      }
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::guess(VectorType &solution, const VectorType &rhs)
+  {
+    switch (type)
+      {
+        case InitialGuessType::Projection:
+          guess_projection(solution, rhs);
+          break;
+        case InitialGuessType::IncrementalProjection:
+          guess_incremental_projection(solution, rhs);
+          break;
+        case InitialGuessType::LinearExtrapolation:
+        case InitialGuessType::QuadraticExtrapolation:
+          guess_extrapolation(solution);
+          break;
+        case InitialGuessType::PeriodicProjection:
+          guess_periodic_projection(solution, rhs);
+          break;
+        default:
+          Assert(false, ExcFDLInternalError());
+      }
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::submit_projection(const VectorType &solution,
+                                              const VectorType &rhs)
   {
     if (n_max_vectors == 0)
       return;
@@ -54,14 +259,19 @@ namespace fdl
                   projection_coefficients[i + 1];
                 correlation_matrix(i, n_max_vectors - 1) =
                   projection_coefficients[i + 1];
+              }
 #ifdef DEBUG
-                const auto new_inner = right_hand_sides[i] * rhs;
-                Assert(std::abs(new_inner - projection_coefficients[i + 1]) <=
-                         1e-14 * std::abs(projection_coefficients[i + 1]),
-                       ExcMessage("This class assumes that the RHS vectors are "
-                                  "not modified between calls."));
+            const Eigen::VectorXd new_inner =
+              compute_inner_products(right_hand_sides,
+                                     n_max_vectors - 1,
+                                     rhs,
+                                     false);
+            for (unsigned int i = 0; i < n_max_vectors - 1; ++i)
+              Assert(std::abs(new_inner[i] - projection_coefficients[i + 1]) <=
+                       1e-14 * std::abs(projection_coefficients[i + 1]),
+                     ExcMessage("This class assumes that the RHS vectors are "
+                                "not modified between calls."));
 #endif
-              }
             correlation_matrix(n_max_vectors - 1, n_max_vectors - 1) =
               rhs * rhs;
             return;
@@ -95,14 +305,19 @@ namespace fdl
                   projection_coefficients[i];
                 correlation_matrix(i, n_stored_vectors - 1) =
                   projection_coefficients[i];
+              }
 #ifdef DEBUG
-                const auto new_inner = right_hand_sides[i] * rhs;
-                Assert(std::abs(new_inner - projection_coefficients[i]) <=
-                         1e-14 * std::abs(projection_coefficients[i]),
-                       ExcMessage("This class assumes that the RHS vectors are "
-                                  "not modified between calls."));
+            const Eigen::VectorXd new_inner =
+              compute_inner_products(right_hand_sides,
+                                     n_stored_vectors - 1,
+                                     rhs,
+                                     false);
+            for (unsigned int i = 0; i < n_stored_vectors - 1; ++i)
+              Assert(std::abs(new_inner[i] - projection_coefficients[i]) <=
+                       1e-14 * std::abs(projection_coefficients[i]),
+                     ExcMessage("This class assumes that the RHS vectors are "
+                                "not modified between calls."));
 #endif
-              }
             correlation_matrix(n_stored_vectors - 1, n_stored_vectors - 1) =
               rhs * rhs;
             return;
@@ -111,28 +326,30 @@ namespace fdl
 
     Assert(last_rhs == nullptr, ExcFDLInternalError());
     // Compute the last row and then copy it into the last column.
+    const Eigen::VectorXd inner_products =
+      compute_inner_products(right_hand_sides,
+                             n_stored_vectors - 1,
+                             right_hand_sides.back(),
+                             true);
     for (unsigned int j = 0; j < n_stored_vectors; ++j)
       {
-        const double inner = right_hand_sides.back() * right_hand_sides[j];
-        correlation_matrix(n_stored_vectors - 1, j) = inner;
-        correlation_matrix(j, n_stored_vectors - 1) = inner;
+        correlation_matrix(n_stored_vectors - 1, j) = inner_products[j];
+        correlation_matrix(j, n_stored_vectors - 1) = inner_products[j];
       }
   }
 
   template <typename VectorType>
   void
-  InitialGuess<VectorType>::guess(VectorType &solution, const VectorType &rhs)
+  InitialGuess<VectorType>::guess_projection(VectorType       &solution,
+                                             const VectorType &rhs)
   {
     if (n_stored_vectors == 0)
       {
         return;
       }
 
-    projection_coefficients.resize(n_stored_vectors, 1);
-    for (unsigned int i = 0; i < n_stored_vectors; ++i)
-      {
-        projection_coefficients[i] = right_hand_sides[i] * rhs;
-      }
+    projection_coefficients =
+      compute_inner_products(right_hand_sides, n_stored_vectors, rhs, false);
     last_rhs = &rhs;
 
     Eigen::VectorXd coefs(n_stored_vectors);
@@ -162,6 +379,282 @@ namespace fdl
       }
   }
 
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::submit_incremental_projection(
+    const VectorType &solution,
+    const VectorType &rhs)
+  {
+    if (n_max_vectors == 0)
+      return;
+
+    // Recycle dot products computed by guess() if we can
+    const bool recycle = &rhs == last_rhs;
+    last_rhs           = nullptr;
+    // Compute all of the inner products with a single reduction
+    const Eigen::VectorXd all_inner_products =
+      compute_inner_products(right_hand_sides,
+                             recycle ? 0 : n_stored_vectors,
+                             rhs,
+                             true);
+    Eigen::VectorXd inner_products(n_stored_vectors);
+    if (recycle)
+      {
+        inner_products = projection_coefficients;
+#ifdef DEBUG
+        const Eigen::VectorXd new_inner = compute_inner_products(
+          right_hand_sides, n_stored_vectors, rhs, false);
+        for (unsigned int i = 0; i < n_stored_vectors; ++i)
+          Assert(std::abs(new_inner[i] - projection_coefficients[i]) <=
+                   1e-14 * std::abs(projection_coefficients[i]),
+                 ExcMessage("This class assumes that the RHS vectors are "
+                            "not modified between calls."));
+#endif
+      }
+    else
+      inner_products = all_inner_products.head(n_stored_vectors);
+    const double rhs_norm_squared =
+      all_inner_products[all_inner_products.size() - 1];
+
+    // Compute the new row of the Cholesky factor, i.e., solve L l = b where b
+    // contains the inner products of the new RHS with the stored ones. The
+    // remaining diagonal entry is zero if the new RHS is in the span of the
+    // stored ones.
+    auto compute_new_row = [&](const Eigen::VectorXd &b)
+    {
+      const unsigned int k = n_stored_vectors;
+      if (k == 0)
+        return Eigen::VectorXd();
+      return Eigen::VectorXd(cholesky_factor.topLeftCorner(k, k)
+                               .template triangularView<Eigen::Lower>()
+                               .solve(b));
+    };
+    Eigen::VectorXd new_row = compute_new_row(inner_products);
+
+    // A (nearly) linearly dependent RHS does not improve the guess and would
+    // make the factor singular, so skip it. This also skips zero and
+    // non-finite vectors.
+    const double dependence_tolerance = 1e-12;
+    if (!(rhs_norm_squared - new_row.squaredNorm() >
+          dependence_tolerance * rhs_norm_squared))
+      return;
+
+    if (n_stored_vectors == n_max_vectors)
+      {
+        remove_oldest_cholesky_vector();
+        // the indices are offset by one since we removed the oldest vector
+        const Eigen::VectorXd remaining_inner_products =
+          inner_products.tail(n_stored_vectors);
+        new_row = compute_new_row(remaining_inner_products);
+      }
+
+    const unsigned int k             = n_stored_vectors;
+    const double       diagonal_part = rhs_norm_squared - new_row.squaredNorm();
+    // removing a vector can only make the new RHS less dependent on the rest
+    Assert(diagonal_part > 0.0, ExcFDLInternalError());
+    cholesky_factor.row(k).head(k) = new_row.transpose();
+    cholesky_factor(k, k)          = std::sqrt(diagonal_part);
+
+    ++n_stored_vectors;
+    solutions.push_back(solution);
+    right_hand_sides.push_back(rhs);
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::remove_oldest_cholesky_vector()
+  {
+    const unsigned int k = n_stored_vectors;
+    Assert(k > 0, ExcFDLInternalError());
+    // If L = [l_11 0; l_21 L_22] then the correlation matrix of the remaining
+    // vectors is L_22 L_22^T + l_21 l_21^T, i.e., a rank-one update of L_22.
+    Eigen::VectorXd update = cholesky_factor.col(0).segment(1, k - 1);
+    for (unsigned int i = 1; i < k; ++i)
+      for (unsigned int j = 1; j <= i; ++j)
+        cholesky_factor(i - 1, j - 1) = cholesky_factor(i, j);
+    cholesky_factor.row(k - 1).setZero();
+    cholesky_factor.col(k - 1).setZero();
+
+    for (unsigned int i = 0; i < k - 1; ++i)
+      {
+        const double radius = std::hypot(cholesky_factor(i, i), update[i]);
+        const double c      = radius / cholesky_factor(i, i);
+        const double s      = update[i] / cholesky_factor(i, i);
+        cholesky_factor(i, i) = radius;
+        for (unsigned int j = i + 1; j < k - 1; ++j)
+          {
+            cholesky_factor(j, i) = (cholesky_factor(j, i) + s * update[j]) / c;
+            update[j]             = c * update[j] - s * cholesky_factor(j, i);
+          }
+      }
+
+    --n_stored_vectors;
+    solutions.pop_front();
+    right_hand_sides.pop_front();
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::guess_incremental_projection(
+    VectorType       &solution,
+    const VectorType &rhs)
+  {
+    const unsigned int k = n_stored_vectors;
+    if (k == 0)
+      return;
+
+    projection_coefficients =
+      compute_inner_products(right_hand_sides, k, rhs, false);
+    last_rhs = &rhs;
+
+    // Solve L L^T c = b
+    const auto      factor = cholesky_factor.topLeftCorner(k, k);
+    Eigen::VectorXd coefs =
+      factor.template triangularView<Eigen::Lower>().solve(
+        projection_coefficients);
+    factor.transpose().template triangularView<Eigen::Upper>().solveInPlace(
+      coefs);
+    // Like the SVD version, fall back to the last solution with bad input
+    if (!coefs.allFinite())
+      {
+        coefs.fill(0.0);
+        coefs(k - 1) = 1.0;
+      }
+
+    solution = 0.0;
+    for (unsigned int i = 0; i < k; ++i)
+      solution.add(coefs[i], solutions[i]);
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::submit_extrapolation(const VectorType &solution)
+  {
+    if (n_max_vectors == 0)
+      return;
+    if (n_stored_vectors == n_max_vectors)
+      solutions.pop_front();
+    else
+      ++n_stored_vectors;
+    solutions.push_back(solution);
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::guess_extrapolation(VectorType &solution)
+  {
+    // Coefficients of the extrapolating polynomial (in the step index)
+    // evaluated at the next step, with the oldest solution first
+    switch (n_stored_vectors)
+      {
+        case 0:
+          return;
+        case 1:
+          solution = solutions[0];
+          break;
+        case 2:
+          solution = 0.0;
+          solution.add(-1.0, solutions[0], 2.0, solutions[1]);
+          break;
+        case 3:
+          solution = 0.0;
+          solution.add(1.0, solutions[0], -3.0, solutions[1]);
+          solution.add(3.0, solutions[2]);
+          break;
+        default:
+          Assert(false, ExcFDLInternalError());
+      }
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::submit_periodic_projection(
+    const VectorType &solution,
+    const VectorType &rhs)
+  {
+    submit_projection(solution, rhs);
+
+    // Only archive the first submission in each phase interval so that the
+    // guess for the same phase in the next period uses a vector from
+    // (roughly) the same point in that interval
+    const auto [period_index, phase_index] =
+      get_phase(current_time, period_length, n_phase_intervals);
+    PhaseEntry &entry = phase_entries[phase_index];
+    if (entry.period_index != period_index)
+      {
+        entry.period_index = period_index;
+        entry.solution     = solution;
+        entry.rhs          = rhs;
+      }
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::guess_periodic_projection(
+    VectorType       &solution,
+    const VectorType &rhs)
+  {
+    const auto [period_index, phase_index] =
+      get_phase(current_time, period_length, n_phase_intervals);
+    const PhaseEntry &entry = phase_entries[phase_index];
+    // Nothing was archived in a previous period so use the normal projection
+    if (entry.period_index == -1 || entry.period_index >= period_index)
+      {
+        guess_projection(solution, rhs);
+        return;
+      }
+
+    // Compute the inner products of the RHS with the stored and archived
+    // RHSs in one reduction, and those of the archived RHS with the stored
+    // ones (and itself) in a second one
+    const unsigned int              k = n_stored_vectors;
+    std::vector<const VectorType *> pointers;
+    for (unsigned int j = 0; j < k; ++j)
+      pointers.push_back(&right_hand_sides[j]);
+    pointers.push_back(&entry.rhs);
+    const Eigen::VectorXd rhs_inner_products =
+      compute_inner_products(pointers, rhs, false);
+    pointers.pop_back();
+    const Eigen::VectorXd entry_inner_products =
+      compute_inner_products(pointers, entry.rhs, true);
+
+    // Keep the inner products with the stored RHSs so that submit() can
+    // recycle them
+    projection_coefficients = rhs_inner_products.head(k);
+    last_rhs                = &rhs;
+
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> matrix(k + 1, k + 1);
+    if (k > 0)
+      matrix.topLeftCorner(k, k) = correlation_matrix;
+    matrix.row(k)                = entry_inner_products.transpose();
+    matrix.col(k)                = entry_inner_products;
+
+    Eigen::VectorXd coefs(k + 1);
+    // Like guess_projection(), fall back to the archived solution with bad
+    // input
+    try
+      {
+        if (!matrix.allFinite())
+          throw int();
+        if (!rhs_inner_products.allFinite())
+          throw int();
+        Eigen::JacobiSVD<decltype(matrix)> svd(matrix,
+                                               Eigen::ComputeThinU |
+                                                 Eigen::ComputeThinV);
+        coefs = svd.solve(rhs_inner_products);
+      }
+    catch (...)
+      {
+        coefs.fill(0.0);
+        coefs(k) = 1.0;
+      }
+
+    solution = 0.0;
+    for (unsigned int i = 0; i < k; ++i)
+      solution.add(coefs[i], solutions[i]);
+    solution.add(coefs[k], entry.solution);
+  }
+
   template class InitialGuess<Vector<float>>;
   template class InitialGuess<Vector<double>>;
 
@@ -0,0 +1,206 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/phase_timings.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <CellData.h>
+#include <CellIterator.h>
+#include <Patch.h>
+#include <PatchHierarchy.h>
+#include <PatchLevel.h>
+#include <tbox/TimerManager.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  PhaseTimings::Phases
+  PhaseTimings::default_phases()
+  {
+    return {{"interpolate", {"fdl::IFEDMethod::interpolateVelocity()"}},
+            {"spread", {"fdl::IFEDMethod::spreadForce()"}},
+            {"pk1", {"fdl::IFEDMethod::computeLagrangianForce()[pk1]"}},
+            {"structure_solve",
+             {"fdl::IFEDMethod::interpolateVelocity()[solve]",
+              "fdl::IFEDMethod::computeLagrangianForce()[solve]"}},
+            {"fluid_solve",
+             {"IBAMR::INSStaggeredHierarchyIntegrator::integrateHierarchy()"}},
+            {"regrid", {"IBAMR::HierarchyIntegrator::regridHierarchy()"}},
+            {"step", {"IBAMR::HierarchyIntegrator::advanceHierarchy()"}}};
+  }
+
+
+
+  PhaseTimings::PhaseTimings(const Phases &phases, const MPI_Comm &communicator)
+    : communicator(communicator)
+    , phases(phases)
+    , start_times(phases.size())
+    , step_times(phases.size())
+    , n_steps(0)
+  {
+    for (const auto &phase : phases)
+      {
+        timers.emplace_back();
+        for (const std::string &name : phase.second)
+          // The second argument activates the timer regardless of the
+          // TimerManager input database
+          timers.back().push_back(
+            tbox::TimerManager::getManager()->getTimer(name, true));
+      }
+  }
+
+
+
+  void
+  PhaseTimings::start()
+  {
+    for (unsigned int i = 0; i < timers.size(); ++i)
+      {
+        start_times[i] = 0.0;
+        for (const auto &timer : timers[i])
+          start_times[i] += timer->getTotalWallclockTime();
+      }
+    std::fill(step_times.begin(), step_times.end(), 0.0);
+    n_steps = 0;
+  }
+
+
+
+  void
+  PhaseTimings::stop(const unsigned int n_steps)
+  {
+    AssertThrow(n_steps > 0, ExcMessage("At least one step is required."));
+    this->n_steps = n_steps;
+    for (unsigned int i = 0; i < timers.size(); ++i)
+      {
+        double time = 0.0;
+        for (const auto &timer : timers[i])
+          time += timer->getTotalWallclockTime();
+        step_times[i] = (time - start_times[i]) / n_steps;
+      }
+  }
+
+
+
+  void
+  PhaseTimings::add_value(const std::string &name, const double value)
+  {
+    values.emplace_back(name, value);
+  }
+
+
+
+  template <int spacedim>
+  void
+  PhaseTimings::add_hierarchy_values(
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const int                                     workload_index)
+  {
+    for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+      {
+        tbox::Pointer<hier::PatchLevel<spacedim>> level =
+          patch_hierarchy->getPatchLevel(ln);
+        double n_cells  = 0.0;
+        double workload = 0.0;
+        for (typename hier::PatchLevel<spacedim>::Iterator p(level); p; p++)
+          {
+            const tbox::Pointer<hier::Patch<spacedim>> patch =
+              level->getPatch(p());
+            n_cells += patch->getBox().size();
+            if (workload_index != -1)
+              {
+                tbox::Pointer<pdat::CellData<spacedim, double>> data =
+                  patch->getPatchData(workload_index);
+                for (pdat::CellIterator<spacedim> i(patch->getBox()); i; i++)
+                  workload += (*data)(i());
+              }
+          }
+
+        const std::string suffix = "_level_" + std::to_string(ln);
+        add_value("n_eulerian_cells" + suffix, n_cells);
+        if (workload_index != -1)
+          add_value("eulerian_workload" + suffix, workload);
+      }
+  }
+
+
+
+  void
+  PhaseTimings::write(const std::string &prefix) const
+  {
+    std::vector<std::string> names;
+    std::vector<double>      local_data;
+    for (unsigned int i = 0; i < phases.size(); ++i)
+      {
+        names.push_back(phases[i].first);
+        local_data.push_back(step_times[i]);
+      }
+    for (const auto &pair : values)
+      {
+        names.push_back(pair.first);
+        local_data.push_back(pair.second);
+      }
+
+    const std::vector<std::vector<double>> data =
+      Utilities::MPI::gather(communicator, local_data);
+    if (Utilities::MPI::this_mpi_process(communicator) != 0)
+      return;
+
+    const unsigned int n_procs = data.size();
+    for (const auto &rank_data : data)
+      AssertThrow(rank_data.size() == names.size(),
+                  ExcMessage("Every processor must add the same values."));
+
+    std::ofstream csv(prefix + ".csv");
+    csv << std::setprecision(8) << "rank";
+    for (const std::string &name : names)
+      csv << ',' << name;
+    csv << '\n';
+    for (unsigned int r = 0; r < n_procs; ++r)
+      {
+        csv << r;
+        for (const double value : data[r])
+          csv << ',' << value;
+        csv << '\n';
+      }
+
+    std::ofstream json(prefix + ".json");
+    json << std::setprecision(8) << "{\n"
+         << "  \"n_processes\": " << n_procs << ",\n"
+         << "  \"n_steps\": " << n_steps << ",\n"
+         << "  \"quantities\": {\n";
+    for (unsigned int i = 0; i < names.size(); ++i)
+      {
+        std::vector<double> column;
+        for (unsigned int r = 0; r < n_procs; ++r)
+          column.push_back(data[r][i]);
+        const double min = *std::min_element(column.begin(), column.end());
+        const double max = *std::max_element(column.begin(), column.end());
+        const double mean =
+          std::accumulate(column.begin(), column.end(), 0.0) / n_procs;
+
+        json << "    \"" << names[i] << "\": {\n"
+             << "      \"min\": " << min << ",\n"
+             << "      \"mean\": " << mean << ",\n"
+             << "      \"max\": " << max << ",\n"
+             << "      \"imbalance\": " << (mean > 0.0 ? max / mean : 1.0)
+             << ",\n"
+             << "      \"per_rank\": [";
+        for (unsigned int r = 0; r < n_procs; ++r)
+          json << (r == 0 ? "" : ", ") << column[r];
+        json << "]\n"
+             << (i + 1 == names.size() ? "    }\n" : "    },\n");
+      }
+    json << "  }\n}\n";
+  }
+
+  template void
+  PhaseTimings::add_hierarchy_values(
+    tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy,
+    const int                                 workload_index);
+} // namespace fdl
@@ -3,10 +3,84 @@
 
 #include <deal.II/base/quadrature_lib.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace fdl
 {
+  namespace
+  {
+    /**
+     * Compute the running minimum of @p values.
+     */
+    void
+    set_running_minimum(const std::vector<double> &values,
+                        std::vector<double>       &running_minimum)
+    {
+      running_minimum.resize(values.size());
+      double minimum = std::numeric_limits<double>::max();
+      for (std::size_t i = 0; i < values.size(); ++i)
+        {
+          minimum            = std::min(minimum, values[i]);
+          running_minimum[i] = minimum;
+        }
+    }
+
+    /**
+     * Find the first index whose mean point distance is at most
+     * @p min_point_distance. This gives the same answer as the linear search
+     * done in the get_index() functions but does not modify anything.
+     */
+    unsigned char
+    find_precomputed_index(const std::vector<double> &min_mean_point_distances,
+                           const double               min_point_distance)
+    {
+      const auto it =
+        std::partition_point(min_mean_point_distances.begin(),
+                             min_mean_point_distances.end(),
+                             [&](const double distance)
+                             { return distance > min_point_distance; });
+      AssertThrow(it != min_mean_point_distances.end(),
+                  ExcMessage("This quadrature family has been precomputed "
+                             "but does not contain a sufficiently fine rule. "
+                             "Call precompute() with larger lengths to "
+                             "extend it."));
+      return static_cast<unsigned char>(it - min_mean_point_distances.begin());
+    }
+
+    /**
+     * The maximum point distance of a quadrature rule only depends on the
+     * rule itself, so store it for every quadrature family to use. Here
+     * @p key uniquely identifies the rule and @p compute computes the
+     * distance if it is not yet known.
+     */
+    template <typename Key, typename Function>
+    double
+    get_cached_point_distance(const Key &key, const Function &compute)
+    {
+      static std::mutex            mutex;
+      static std::map<Key, double> cache;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto                  it = cache.find(key);
+        if (it != cache.end())
+          return it->second;
+      }
+
+      const double                distance = compute();
+      std::lock_guard<std::mutex> lock(mutex);
+      cache.emplace(key, distance);
+      return distance;
+    }
+  } // namespace
+
   template <int dim>
   SingleQuadrature<dim>::SingleQuadrature(const Quadrature<dim> &quad)
     : single_quad(quad)
@@ -40,6 +114,7 @@ namespace fdl
     : min_points_1D(min_points_1D)
     , point_density(point_density)
     , density_factor(density_kind == DensityKind::Minimum ? 1.0 : 1.5)
+    , is_precomputed(false)
   {}
 
   template <int dim>
@@ -53,6 +128,10 @@ namespace fdl
       point_density * lagrangian_length / eulerian_length;
     const double min_point_distance = 1.0 / n_evenly_spaced_points;
 
+    if (is_precomputed)
+      return find_precomputed_index(min_mean_point_distances,
+                                    min_point_distance);
+
     // TODO: use binary search instead if mean_point_distances.back() <
     // min_point_distance
     unsigned char i = 0;
@@ -78,6 +157,18 @@ namespace fdl
     return std::numeric_limits<unsigned char>::max();
   }
 
+  template <int dim>
+  void
+  QGaussFamily<dim>::precompute(const double eulerian_length,
+                                const double lagrangian_length)
+  {
+    // Growing the table is only done in the lazy code path
+    is_precomputed = false;
+    get_index(eulerian_length, lagrangian_length);
+    set_running_minimum(mean_point_distances, min_mean_point_distances);
+    is_precomputed = true;
+  }
+
   template <int dim>
   const Quadrature<dim> &
   QGaussFamily<dim>::operator[](const unsigned char n_points_1D) const
@@ -88,6 +179,11 @@ namespace fdl
       }
     else
       {
+        AssertThrow(!is_precomputed,
+                    ExcMessage("This quadrature family has been precomputed "
+                               "and cannot compute new quadratures. Call "
+                               "precompute() with larger lengths to extend "
+                               "it."));
         const double shrink_factor = 0.05;
         const double target_point_distance =
           max_point_distances.size() == 0 ?
@@ -150,12 +246,16 @@ namespace fdl
                     const QIterated<dim> new_quad(QGauss<1>(pairs[i].first),
                                                   pairs[i].second);
                     Assert(new_quad.size() == n_points, ExcFDLInternalError());
-                    const double point_distance =
-                      new_quad.size() < 2 ?
-                        1.0 :
-                        compute_largest_nonintersecting_sphere(
-                          new_quad.get_points())
-                          .second;
+                    const double point_distance = get_cached_point_distance(
+                      std::make_tuple(dim, pairs[i].first, pairs[i].second),
+                      [&]()
+                      {
+                        return new_quad.size() < 2 ?
+                                 1.0 :
+                                 compute_largest_nonintersecting_sphere(
+                                   new_quad.get_points())
+                                   .second;
+                      });
 
                     // If we have the same number of points, pick the rule with
                     // better spacing
@@ -218,6 +318,7 @@ namespace fdl
     , point_density(point_density)
     // TODO: these factors are determined empirically and could be improved
     , density_factor(density_kind == DensityKind::Minimum ? 1.5 : 2.2)
+    , is_precomputed(false)
   {}
 
   template <int dim>
@@ -262,6 +363,10 @@ namespace fdl
       point_density * lagrangian_length / eulerian_length;
     const double min_point_distance = 1.0 / n_evenly_spaced_points;
 
+    if (is_precomputed)
+      return find_precomputed_index(min_mean_point_distances,
+                                    min_point_distance);
+
     // TODO: use binary search instead if mean_point_distances.back() <
     // min_point_distance
     unsigned char i = 0;
@@ -287,6 +392,19 @@ namespace fdl
     return std::numeric_limits<unsigned char>::max();
   }
 
+  template <int dim>
+  void
+  QWitherdenVincentSimplexFamily<dim>::precompute(
+    const double eulerian_length,
+    const double lagrangian_length)
+  {
+    // Growing the table is only done in the lazy code path
+    is_precomputed = false;
+    get_index(eulerian_length, lagrangian_length);
+    set_running_minimum(mean_point_distances, min_mean_point_distances);
+    is_precomputed = true;
+  }
+
   // Similarly, this is more-or-less copy and paste code but with a few key
   // things changed (we can only do powers of 2 for iterated simplex rules)
   template <int dim>
@@ -300,6 +418,11 @@ namespace fdl
       }
     else
       {
+        AssertThrow(!is_precomputed,
+                    ExcMessage("This quadrature family has been precomputed "
+                               "and cannot compute new quadratures. Call "
+                               "precompute() with larger lengths to extend "
+                               "it."));
         Assert(dim == 2 || dim == 3, ExcNotImplemented());
         const double shrink_factor = 0.05;
         const double target_point_distance =
@@ -406,14 +529,17 @@ namespace fdl
                       std::get<2>(tuples[i]));
                     Assert(new_quad.size() == n_points, ExcFDLInternalError());
 
-                    double point_distance = 1.0;
-                    if (new_quad.size() > 1)
+                    const double point_distance = get_cached_point_distance(
+                      std::tuple_cat(std::make_tuple(dim), tuples[i]),
+                      [&]()
                       {
+                        if (new_quad.size() < 2)
+                          return 1.0;
                         const auto points =
                           map_to_equilateral_simplex(new_quad.get_points());
-                        point_distance =
-                          compute_largest_nonintersecting_sphere(points).second;
-                      }
+                        return compute_largest_nonintersecting_sphere(points)
+                          .second;
+                      });
 
                     // If we have the same number of points, pick the rule with
                     // better spacing
@@ -459,6 +585,68 @@ namespace fdl
       }
   }
 
+  template <int dim>
+  QGaussAnisotropicFamily<dim>::QGaussAnisotropicFamily(
+    const unsigned int min_points_1D,
+    const double       point_density)
+    : min_points_1D(min_points_1D)
+    , point_density(point_density)
+  {
+    AssertThrow(min_points_1D > 0,
+                ExcMessage("Each rule needs at least one point."));
+    AssertThrow(point_density > 0.0,
+                ExcMessage("The point density should be positive."));
+  }
+
+  template <int dim>
+  std::array<unsigned char, dim>
+  QGaussAnisotropicFamily<dim>::get_n_points(
+    const double                   eulerian_length,
+    const std::array<double, dim> &lagrangian_lengths) const
+  {
+    std::array<unsigned char, dim> n_points;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        const double n_evenly_spaced_points =
+          point_density * lagrangian_lengths[d] / eulerian_length;
+        const double n_points_d =
+          std::max<double>(min_points_1D, std::ceil(n_evenly_spaced_points));
+        AssertThrow(n_points_d <= std::numeric_limits<unsigned char>::max(),
+                    ExcMessage("The requested number of points is too "
+                               "large."));
+        n_points[d] = static_cast<unsigned char>(n_points_d);
+      }
+    return n_points;
+  }
+
+  template <int dim>
+  Quadrature<dim>
+  QGaussAnisotropicFamily<dim>::get_quadrature(
+    const std::array<unsigned char, dim> &n_points) const
+  {
+    std::array<Quadrature<1>, dim> rules;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        // Use as many copies of the lowest-order rule as possible and then
+        // increase the order to reach the requested number of points
+        const unsigned int n = std::max<unsigned int>(n_points[d], 1);
+        const unsigned int n_iterations =
+          std::max<unsigned int>(1, n / min_points_1D);
+        const unsigned int order =
+          std::max(min_points_1D, (n + n_iterations - 1) / n_iterations);
+        rules[d] = QIterated<1>(QGauss<1>(order), n_iterations);
+      }
+
+    // Quadrature's tensor product constructor puts the last coordinate
+    // direction outermost, so the first direction runs fastest
+    if constexpr (dim == 1)
+      return rules[0];
+    else if constexpr (dim == 2)
+      return Quadrature<2>(rules[0], rules[1]);
+    else
+      return Quadrature<3>(Quadrature<2>(rules[0], rules[1]), rules[2]);
+  }
+
   template class SingleQuadrature<NDIM - 1>;
   template class SingleQuadrature<NDIM>;
 
@@ -467,4 +655,7 @@ namespace fdl
 
   template class QWitherdenVincentSimplexFamily<NDIM - 1>;
   template class QWitherdenVincentSimplexFamily<NDIM>;
+
+  template class QGaussAnisotropicFamily<NDIM - 1>;
+  template class QGaussAnisotropicFamily<NDIM>;
 } // namespace fdl
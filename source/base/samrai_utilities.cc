@@ -2,29 +2,52 @@
 #include <fiddle/base/samrai_utilities.h>
 #include <fiddle/base/utilities.h>
 
+#include <deal.II/base/mpi.h>
+
 FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <ArrayData.h>
 #include <BasePatchLevel.h>
+#include <Box.h>
+#include <BoxArray.h>
+#include <BoxList.h>
 #include <CellData.h>
+#include <CellIterator.h>
 #include <CellVariable.h>
 #include <EdgeData.h>
 #include <EdgeVariable.h>
+#include <GridGeometry.h>
 #include <HierarchyCellDataOpsReal.h>
 #include <HierarchyDataOpsReal.h>
 #include <HierarchyEdgeDataOpsReal.h>
 #include <HierarchyNodeDataOpsReal.h>
 #include <HierarchySideDataOpsReal.h>
+#include <IntVector.h>
 #include <NodeData.h>
 #include <NodeVariable.h>
+#include <PatchCellDataOpsReal.h>
 #include <PatchData.h>
+#include <PatchDataFactory.h>
+#include <PatchDescriptor.h>
+#include <PatchEdgeDataOpsReal.h>
 #include <PatchHierarchy.h>
 #include <PatchLevel.h>
+#include <PatchNodeDataOpsReal.h>
+#include <PatchSideDataOpsReal.h>
+#include <ProcessorMapping.h>
 #include <SideData.h>
+#include <SideGeometry.h>
 #include <SideVariable.h>
 #include <Variable.h>
 #include <tbox/Database.h>
 #include <tbox/MemoryDatabase.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 namespace fdl
 {
   using namespace SAMRAI;
@@ -155,77 +178,147 @@ namespace fdl
     return {};
   }
 
-  template <int spacedim, typename field_type>
-  void
-  fill_all(tbox::Pointer<hier::PatchData<spacedim>> p, const field_type value)
+  template <int spacedim>
+  PatchDataTypeInfo
+  get_patch_data_type_info(const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                           const int data_index)
   {
-    Assert(
-      p, ExcMessage("The provided pointer should not be null at this point."));
-    if (auto p2 = tbox::Pointer<pdat::EdgeData<spacedim, int>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::EdgeData<spacedim, float>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::EdgeData<spacedim, double>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
+    static std::mutex mutex;
+    // Factory and type information of each data index.
+    static std::vector<std::pair<const void *, PatchDataTypeInfo>> cache;
+
+    Assert(data_index >= 0, ExcMessage("The data index should be valid."));
+    const tbox::Pointer<hier::PatchDataFactory<spacedim>> factory =
+      patch->getPatchDescriptor()->getPatchDataFactory(data_index);
+    const void *const key = factory.getPointer();
+    Assert(key, ExcMessage("The data index should be registered."));
+    const tbox::Pointer<hier::PatchData<spacedim>> data =
+      patch->getPatchData(data_index);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (std::size_t(data_index) < cache.size() &&
+          cache[data_index].first == key)
+        {
+          const PatchDataTypeInfo &info = cache[data_index].second;
+          (void)data;
+          Assert(extract_types(data) ==
+                     std::make_pair(info.patch_type, info.field_type) &&
+                   extract_depth(data) == info.depth,
+                 ExcFDLInternalError());
+          return info;
+        }
+    }
 
-    if (auto p2 = tbox::Pointer<pdat::CellData<spacedim, int>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::CellData<spacedim, float>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::CellData<spacedim, double>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
+    const auto              types = extract_types(data);
+    const PatchDataTypeInfo info{types.first,
+                                 types.second,
+                                 extract_depth(data)};
 
-    if (auto p2 = tbox::Pointer<pdat::NodeData<spacedim, int>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::NodeData<spacedim, float>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::NodeData<spacedim, double>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cache.size() <= std::size_t(data_index))
+      cache.resize(data_index + 1, std::make_pair(nullptr, info));
+    cache[data_index] = std::make_pair(key, info);
+    return info;
+  }
 
-    if (auto p2 = tbox::Pointer<pdat::SideData<spacedim, int>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::SideData<spacedim, float>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
-    if (auto p2 = tbox::Pointer<pdat::SideData<spacedim, double>>(p))
-      {
-        p2->fillAll(value);
-        return;
-      }
+  namespace
+  {
+    /**
+     * Set the values of @p data to @p value. Unlike ArrayData::fillAll(),
+     * which iterates over the (ghost) box, this writes the array as a single
+     * contiguous range so that, for large arrays, the compiler and C library
+     * may use vectorized and non-temporal stores.
+     *
+     * If @p ghosts_only is true then only the values outside the interior
+     * (i.e., the array's box shrunk by @p ghost_width) are set.
+     */
+    template <int spacedim, typename T, typename field_type>
+    void
+    fill_array_data(pdat::ArrayData<spacedim, T>    &data,
+                    const hier::IntVector<spacedim> &ghost_width,
+                    const field_type                 value,
+                    const bool                       ghosts_only)
+    {
+      if (ghosts_only)
+        {
+          hier::Box<spacedim> interior = data.getBox();
+          interior.grow(-ghost_width);
+          hier::BoxList<spacedim> ghost_boxes(data.getBox());
+          ghost_boxes.removeIntersections(interior);
+          for (typename hier::BoxList<spacedim>::Iterator b(ghost_boxes); b;
+               b++)
+            data.fill(static_cast<T>(value), b());
+        }
+      else
+        {
+          T *const          begin = data.getPointer();
+          const std::size_t n_values =
+            std::size_t(data.getDepth()) * data.getBox().size();
+          std::fill(begin, begin + n_values, static_cast<T>(value));
+        }
+    }
 
-    AssertThrow(false, ExcFDLNotImplemented());
+    /**
+     * Set the values of @p p to @p value if it stores values of type T.
+     *
+     * @return Whether or not @p p stores values of type T.
+     */
+    template <int spacedim, typename T, typename field_type>
+    bool
+    fill_typed_patch_data(tbox::Pointer<hier::PatchData<spacedim>> p,
+                          const field_type                         value,
+                          const bool                               ghosts_only)
+    {
+      const hier::IntVector<spacedim> &ghost_width = p->getGhostCellWidth();
+      if (auto p2 = tbox::Pointer<pdat::EdgeData<spacedim, T>>(p))
+        {
+          for (int axis = 0; axis < spacedim; ++axis)
+            fill_array_data(
+              p2->getArrayData(axis), ghost_width, value, ghosts_only);
+          return true;
+        }
+      if (auto p2 = tbox::Pointer<pdat::CellData<spacedim, T>>(p))
+        {
+          fill_array_data(p2->getArrayData(), ghost_width, value, ghosts_only);
+          return true;
+        }
+      if (auto p2 = tbox::Pointer<pdat::NodeData<spacedim, T>>(p))
+        {
+          fill_array_data(p2->getArrayData(), ghost_width, value, ghosts_only);
+          return true;
+        }
+      if (auto p2 = tbox::Pointer<pdat::SideData<spacedim, T>>(p))
+        {
+          for (int axis = 0; axis < spacedim; ++axis)
+            if (p2->getDirectionVector()(axis))
+              fill_array_data(
+                p2->getArrayData(axis), ghost_width, value, ghosts_only);
+          return true;
+        }
+      return false;
+    }
+
+    template <int spacedim, typename field_type>
+    void
+    fill_patch_data(tbox::Pointer<hier::PatchData<spacedim>> p,
+                    const field_type                         value,
+                    const bool                               ghosts_only)
+    {
+      Assert(p,
+             ExcMessage("The provided pointer should not be null at this "
+                        "point."));
+      if (!fill_typed_patch_data<spacedim, int>(p, value, ghosts_only) &&
+          !fill_typed_patch_data<spacedim, float>(p, value, ghosts_only) &&
+          !fill_typed_patch_data<spacedim, double>(p, value, ghosts_only))
+        AssertThrow(false, ExcFDLNotImplemented());
+    }
+  } // namespace
+
+  template <int spacedim, typename field_type>
+  void
+  fill_all(tbox::Pointer<hier::PatchData<spacedim>> p, const field_type value)
+  {
+    fill_patch_data(p, value, false);
   }
 
   template <int spacedim, typename field_type>
@@ -239,20 +332,36 @@ namespace fdl
   {
     Assert(interior_only == false, ExcFDLNotImplemented());
     (void)interior_only;
+    fill_all(patch_hierarchy,
+             std::vector<int>{data_index},
+             coarsest_level_number,
+             finest_level_number,
+             value);
+  }
+
+  template <int spacedim, typename field_type>
+  void
+  fill_all(tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+           const std::vector<int>                       &data_indices,
+           const int                                     coarsest_level_number,
+           const int                                     finest_level_number,
+           const field_type                              value,
+           const bool                                    ghosts_only)
+  {
     for (int ln = coarsest_level_number; ln <= finest_level_number; ++ln)
       {
         tbox::Pointer<hier::PatchLevel<spacedim>> level =
           patch_hierarchy->getPatchLevel(ln);
         AssertThrow(level, ExcFDLInternalError());
-        if (!level->checkAllocated(data_index))
-          level->allocatePatchData(data_index);
-
-        auto patches = extract_patches(level);
-
-        for (auto &patch : patches)
-          {
-            fill_all(patch->getPatchData(data_index), value);
-          }
+        for (const int data_index : data_indices)
+          if (!level->checkAllocated(data_index))
+            level->allocatePatchData(data_index);
+
+        for (auto &patch : extract_patches(level))
+          for (const int data_index : data_indices)
+            fill_patch_data(patch->getPatchData(data_index),
+                            value,
+                            ghosts_only);
       }
   }
 
@@ -278,6 +387,396 @@ namespace fdl
     AssertThrow(false, ExcFDLNotImplemented());
   }
 
+  template <int spacedim>
+  bool
+  have_same_layout(tbox::Pointer<hier::PatchLevel<spacedim>> level_1,
+                   tbox::Pointer<hier::PatchLevel<spacedim>> level_2)
+  {
+    Assert(level_1 && level_2,
+           ExcMessage("The provided levels should not be null."));
+    if (level_1->getRatio() != level_2->getRatio())
+      return false;
+    const hier::BoxArray<spacedim> &boxes_1 = level_1->getBoxes();
+    const hier::BoxArray<spacedim> &boxes_2 = level_2->getBoxes();
+    if (boxes_1.getNumberOfBoxes() != boxes_2.getNumberOfBoxes())
+      return false;
+    const hier::ProcessorMapping &mapping_1 = level_1->getProcessorMapping();
+    const hier::ProcessorMapping &mapping_2 = level_2->getProcessorMapping();
+    for (int i = 0; i < boxes_1.getNumberOfBoxes(); ++i)
+      if (boxes_1[i] != boxes_2[i] ||
+          mapping_1.getProcessorAssignment(i) !=
+            mapping_2.getProcessorAssignment(i))
+        return false;
+    return true;
+  }
+
+  template <int spacedim>
+  void
+  alias_patch_data(tbox::Pointer<hier::PatchLevel<spacedim>> dst_level,
+                   tbox::Pointer<hier::PatchLevel<spacedim>> src_level,
+                   const int                                 data_index)
+  {
+    Assert(have_same_layout(dst_level, src_level),
+           ExcMessage("The levels should have the same layout."));
+    for (typename hier::PatchLevel<spacedim>::Iterator p(src_level); p; p++)
+      {
+        tbox::Pointer<hier::PatchData<spacedim>> data =
+          src_level->getPatch(p())->getPatchData(data_index);
+        AssertThrow(data,
+                    ExcMessage("The patch data should be allocated on the "
+                               "source level."));
+        dst_level->getPatch(p())->setPatchData(data_index, data);
+      }
+  }
+
+  template <int spacedim>
+  void
+  alias_patch_data(tbox::Pointer<hier::PatchLevel<spacedim>> dst_level,
+                   tbox::Pointer<hier::PatchLevel<spacedim>> src_level,
+                   const std::vector<int>                   &patch_numbers,
+                   const int                                 data_index)
+  {
+    AssertThrow(src_level->getNumberOfPatches() ==
+                  static_cast<int>(patch_numbers.size()),
+                ExcMessage("There should be one patch number for each patch "
+                           "of the source level."));
+    for (typename hier::PatchLevel<spacedim>::Iterator p(src_level); p; p++)
+      {
+        const int dst_patch_n = patch_numbers[p()];
+        AssertIndexRange(dst_patch_n, dst_level->getNumberOfPatches());
+        Assert(dst_level->getBoxes()[dst_patch_n] ==
+                 src_level->getBoxes()[p()],
+               ExcMessage("The patches should have the same boxes."));
+        tbox::Pointer<hier::PatchData<spacedim>> data =
+          src_level->getPatch(p())->getPatchData(data_index);
+        AssertThrow(data,
+                    ExcMessage("The patch data should be allocated on the "
+                               "source level."));
+        dst_level->getPatch(dst_patch_n)->setPatchData(data_index, data);
+      }
+  }
+
+  template <int spacedim>
+  tbox::Pointer<hier::PatchLevel<spacedim>>
+  make_patch_level_subset(tbox::Pointer<hier::PatchLevel<spacedim>> level,
+                          const std::vector<int> &patch_numbers)
+  {
+    const hier::BoxArray<spacedim> &boxes   = level->getBoxes();
+    const hier::ProcessorMapping   &mapping = level->getProcessorMapping();
+    const int n_patches = static_cast<int>(patch_numbers.size());
+
+    hier::BoxArray<spacedim> subset_boxes(n_patches);
+    hier::ProcessorMapping   subset_mapping(n_patches);
+    for (int i = 0; i < n_patches; ++i)
+      {
+        AssertIndexRange(patch_numbers[i], boxes.getNumberOfBoxes());
+        subset_boxes[i] = boxes[patch_numbers[i]];
+        subset_mapping.setProcessorAssignment(
+          i, mapping.getProcessorAssignment(patch_numbers[i]));
+      }
+
+    tbox::Pointer<hier::PatchLevel<spacedim>> subset_level =
+      new hier::PatchLevel<spacedim>(subset_boxes,
+                                     subset_mapping,
+                                     level->getRatio(),
+                                     level->getGridGeometry(),
+                                     level->getPatchDescriptor());
+    subset_level->setLevelNumber(level->getLevelNumber());
+    subset_level->setNextCoarserHierarchyLevelNumber(
+      level->getNextCoarserHierarchyLevelNumber());
+    return subset_level;
+  }
+
+  template <int spacedim>
+  void
+  add_nonzero_cell_data(tbox::Pointer<hier::PatchLevel<spacedim>> dst_level,
+                        tbox::Pointer<hier::PatchLevel<spacedim>> src_level,
+                        const int                                 data_index,
+                        const MPI_Comm                            communicator)
+  {
+    using namespace dealii;
+    const hier::BoxArray<spacedim> &dst_boxes = dst_level->getBoxes();
+    const hier::ProcessorMapping   &dst_mapping =
+      dst_level->getProcessorMapping();
+
+    // Each entry contains the destination patch number and cell index in the
+    // first array and the value in the second
+    std::map<unsigned int, std::pair<std::vector<int>, std::vector<double>>>
+      values_to_send;
+    for (typename hier::PatchLevel<spacedim>::Iterator p(src_level); p; p++)
+      {
+        const tbox::Pointer<hier::Patch<spacedim>> patch =
+          src_level->getPatch(p());
+        const tbox::Pointer<pdat::CellData<spacedim, double>> data =
+          patch->getPatchData(data_index);
+        AssertThrow(data, ExcFDLNotImplemented());
+        const hier::Box<spacedim> &box = patch->getBox();
+        // There are far fewer local patches than patches, so it is cheap
+        // enough to check every pair
+        for (int dst_patch_n = 0; dst_patch_n < dst_boxes.getNumberOfBoxes();
+             ++dst_patch_n)
+          {
+            const hier::Box<spacedim> overlap = box * dst_boxes[dst_patch_n];
+            if (overlap.empty())
+              continue;
+            auto &values = values_to_send[dst_mapping.getProcessorAssignment(
+              dst_patch_n)];
+            for (pdat::CellIterator<spacedim> it(overlap); it; it++)
+              {
+                const double value = (*data)(it(), 0);
+                if (value == 0.0)
+                  continue;
+                values.first.push_back(dst_patch_n);
+                for (int d = 0; d < spacedim; ++d)
+                  values.first.push_back(it()(d));
+                values.second.push_back(value);
+              }
+          }
+      }
+    // Don't send empty messages
+    for (auto it = values_to_send.begin(); it != values_to_send.end();)
+      if (it->second.second.empty())
+        it = values_to_send.erase(it);
+      else
+        ++it;
+
+    const auto received_values =
+      Utilities::MPI::some_to_some(communicator, values_to_send);
+    for (const auto &pair : received_values)
+      {
+        const std::vector<int>    &indices = pair.second.first;
+        const std::vector<double> &values  = pair.second.second;
+        AssertThrow(indices.size() == values.size() * (spacedim + 1),
+                    ExcFDLInternalError());
+        for (std::size_t i = 0; i < values.size(); ++i)
+          {
+            const int *const entry = indices.data() + i * (spacedim + 1);
+            const tbox::Pointer<pdat::CellData<spacedim, double>> data =
+              dst_level->getPatch(entry[0])->getPatchData(data_index);
+            AssertThrow(data, ExcFDLNotImplemented());
+            pdat::CellIndex<spacedim> index;
+            for (int d = 0; d < spacedim; ++d)
+              index(d) = entry[d + 1];
+            (*data)(index, 0) += values[i];
+          }
+      }
+  }
+
+  template <int spacedim>
+  void
+  add_patch_data(tbox::Pointer<hier::PatchData<spacedim>>       dst,
+                 const tbox::Pointer<hier::PatchData<spacedim>> src)
+  {
+    Assert(dst && src,
+           ExcMessage("The provided pointers should not be null."));
+    const hier::Box<spacedim> &box = dst->getBox();
+    if (auto d = tbox::Pointer<pdat::EdgeData<spacedim, double>>(dst))
+      {
+        tbox::Pointer<pdat::EdgeData<spacedim, double>> s = src;
+        AssertThrow(s, ExcMessage("The patch data types should match."));
+        math::PatchEdgeDataOpsReal<spacedim, double>().add(d, d, s, box);
+        return;
+      }
+    if (auto d = tbox::Pointer<pdat::CellData<spacedim, double>>(dst))
+      {
+        tbox::Pointer<pdat::CellData<spacedim, double>> s = src;
+        AssertThrow(s, ExcMessage("The patch data types should match."));
+        math::PatchCellDataOpsReal<spacedim, double>().add(d, d, s, box);
+        return;
+      }
+    if (auto d = tbox::Pointer<pdat::NodeData<spacedim, double>>(dst))
+      {
+        tbox::Pointer<pdat::NodeData<spacedim, double>> s = src;
+        AssertThrow(s, ExcMessage("The patch data types should match."));
+        math::PatchNodeDataOpsReal<spacedim, double>().add(d, d, s, box);
+        return;
+      }
+    if (auto d = tbox::Pointer<pdat::SideData<spacedim, double>>(dst))
+      {
+        tbox::Pointer<pdat::SideData<spacedim, double>> s = src;
+        AssertThrow(s, ExcMessage("The patch data types should match."));
+        math::PatchSideDataOpsReal<spacedim, double>().add(d, d, s, box);
+        return;
+      }
+
+    AssertThrow(false, ExcFDLNotImplemented());
+  }
+
+  template <int spacedim>
+  void
+  accumulate_nonzero_ghost_data(
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const int                                     data_index,
+    const hier::IntVector<spacedim>              &ghost_width,
+    const int                                     coarsest_level_number,
+    const int                                     finest_level_number,
+    const MPI_Comm                                communicator)
+  {
+    using namespace dealii;
+    // Cell data has one array and side data has one array for each axis
+    const auto get_arrays =
+      [](const tbox::Pointer<hier::PatchData<spacedim>> &data)
+    {
+      std::vector<pdat::ArrayData<spacedim, double> *> arrays;
+      if (auto cell_data =
+            tbox::Pointer<pdat::CellData<spacedim, double>>(data))
+        arrays.push_back(&cell_data->getArrayData());
+      else if (auto side_data =
+                 tbox::Pointer<pdat::SideData<spacedim, double>>(data))
+        for (int axis = 0; axis < spacedim; ++axis)
+          arrays.push_back(&side_data->getArrayData(axis));
+      else
+        AssertThrow(false, ExcFDLNotImplemented());
+      return arrays;
+    };
+    const auto to_data_box = [](const hier::Box<spacedim> &box,
+                                const std::size_t          n_arrays,
+                                const int                  axis)
+    {
+      return n_arrays == 1 ? box :
+                             pdat::SideGeometry<spacedim>::toSideBox(box, axis);
+    };
+
+    // Each overlap is described, in the first array, by the level number,
+    // the destination patch number, the axis, and the bounds of its box in
+    // the index space of the destination patch. The second array contains
+    // the values.
+    constexpr std::size_t n_header_entries = 3 + 2 * spacedim;
+    std::map<unsigned int, std::pair<std::vector<int>, std::vector<double>>>
+                        values_to_send;
+    std::vector<double> values;
+    for (int ln = coarsest_level_number; ln <= finest_level_number; ++ln)
+      {
+        const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+          patch_hierarchy->getPatchLevel(ln);
+        const hier::BoxArray<spacedim> &boxes   = level->getBoxes();
+        const hier::ProcessorMapping   &mapping = level->getProcessorMapping();
+
+        // Shifts to all periodic images of the domain, starting with zero
+        const hier::IntVector<spacedim> period =
+          level->getGridGeometry()->getPeriodicShift(level->getRatio());
+        std::vector<hier::IntVector<spacedim>> shifts(
+          1, hier::IntVector<spacedim>(0));
+        for (int d = 0; d < spacedim; ++d)
+          if (period[d] != 0)
+            {
+              const std::size_t n_shifts = shifts.size();
+              for (std::size_t i = 0; i < n_shifts; ++i)
+                for (const int sign : {-1, 1})
+                  {
+                    hier::IntVector<spacedim> shift = shifts[i];
+                    shift[d]                        = sign * period[d];
+                    shifts.push_back(shift);
+                  }
+            }
+
+        for (typename hier::PatchLevel<spacedim>::Iterator p(level); p; p++)
+          {
+            const tbox::Pointer<hier::Patch<spacedim>> patch =
+              level->getPatch(p());
+            const auto arrays = get_arrays(patch->getPatchData(data_index));
+            hier::Box<spacedim> ghost_box = patch->getBox();
+            ghost_box.grow(ghost_width);
+            // Side boxes are one index larger, so use a slightly larger box
+            // to quickly skip patches which cannot overlap
+            hier::Box<spacedim> search_box = ghost_box;
+            search_box.grow(hier::IntVector<spacedim>(1));
+
+            // As in add_nonzero_cell_data(), it is cheap enough to check
+            // every pair
+            for (int dst_patch_n = 0;
+                 dst_patch_n < boxes.getNumberOfBoxes();
+                 ++dst_patch_n)
+              for (std::size_t shift_n = 0; shift_n < shifts.size(); ++shift_n)
+                {
+                  // Skip the interior of the current patch
+                  if (dst_patch_n == p() && shift_n == 0)
+                    continue;
+                  const hier::IntVector<spacedim> &shift = shifts[shift_n];
+                  hier::Box<spacedim> dst_box = boxes[dst_patch_n];
+                  dst_box.shift(shift);
+                  if ((search_box * dst_box).empty())
+                    continue;
+
+                  for (std::size_t axis = 0; axis < arrays.size(); ++axis)
+                    {
+                      const hier::Box<spacedim> overlap =
+                        to_data_box(ghost_box, arrays.size(), axis) *
+                        to_data_box(dst_box, arrays.size(), axis);
+                      if (overlap.empty())
+                        continue;
+                      const auto &array = *arrays[axis];
+                      const int   depth = array.getDepth();
+                      values.clear();
+                      bool has_nonzero = false;
+                      for (pdat::CellIterator<spacedim> it(overlap); it; it++)
+                        for (int c = 0; c < depth; ++c)
+                          {
+                            const double value = array(it(), c);
+                            has_nonzero        = has_nonzero || value != 0.0;
+                            values.push_back(value);
+                          }
+                      if (!has_nonzero)
+                        continue;
+
+                      auto &entry =
+                        values_to_send[mapping.getProcessorAssignment(
+                          dst_patch_n)];
+                      entry.first.push_back(ln);
+                      entry.first.push_back(dst_patch_n);
+                      entry.first.push_back(axis);
+                      for (int d = 0; d < spacedim; ++d)
+                        entry.first.push_back(overlap.lower()(d) - shift[d]);
+                      for (int d = 0; d < spacedim; ++d)
+                        entry.first.push_back(overlap.upper()(d) - shift[d]);
+                      entry.second.insert(entry.second.end(),
+                                          values.begin(),
+                                          values.end());
+                    }
+                }
+          }
+      }
+
+    // Every overlap has to be packed before any interior values change
+    const auto received_values =
+      Utilities::MPI::some_to_some(communicator, values_to_send);
+    for (const auto &pair : received_values)
+      {
+        const std::vector<int>    &header = pair.second.first;
+        const std::vector<double> &values = pair.second.second;
+        AssertThrow(header.size() % n_header_entries == 0,
+                    ExcFDLInternalError());
+        std::size_t value_n = 0;
+        for (std::size_t i = 0; i < header.size(); i += n_header_entries)
+          {
+            const int *const entry = header.data() + i;
+            const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+              patch_hierarchy->getPatchLevel(entry[0]);
+            const auto arrays =
+              get_arrays(level->getPatch(entry[1])->getPatchData(data_index));
+            AssertIndexRange(entry[2], arrays.size());
+            auto     &array = *arrays[entry[2]];
+            const int depth = array.getDepth();
+
+            hier::Index<spacedim> lower;
+            hier::Index<spacedim> upper;
+            for (int d = 0; d < spacedim; ++d)
+              {
+                lower(d) = entry[3 + d];
+                upper(d) = entry[3 + spacedim + d];
+              }
+            const hier::Box<spacedim> overlap(lower, upper);
+            AssertThrow(value_n + std::size_t(overlap.size() * depth) <=
+                          values.size(),
+                        ExcFDLInternalError());
+            for (pdat::CellIterator<spacedim> it(overlap); it; it++)
+              for (int c = 0; c < depth; ++c)
+                array(it(), c) += values[value_n++];
+          }
+        AssertThrow(value_n == values.size(), ExcFDLInternalError());
+      }
+  }
+
   namespace
   {
     void
@@ -381,6 +880,10 @@ namespace fdl
   template int
   extract_depth(const tbox::Pointer<hier::PatchData<NDIM>> &p);
 
+  template PatchDataTypeInfo
+  get_patch_data_type_info(const tbox::Pointer<hier::Patch<NDIM>> &patch,
+                           const int                               data_index);
+
   template void
   fill_all(tbox::Pointer<hier::PatchData<NDIM>> p, const int value);
 
@@ -398,6 +901,14 @@ namespace fdl
            const int                                 value,
            const bool                                interior_only);
 
+  template void
+  fill_all(tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy,
+           const std::vector<int>                   &data_indices,
+           const int                                 coarsest_level_number,
+           const int                                 finest_level_number,
+           const int                                 value,
+           const bool                                ghosts_only);
+
   template void
   fill_all(tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy,
            const int                                 data_index,
@@ -406,6 +917,14 @@ namespace fdl
            const double                              value,
            const bool                                interior_only);
 
+  template void
+  fill_all(tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy,
+           const std::vector<int>                   &data_indices,
+           const int                                 coarsest_level_number,
+           const int                                 finest_level_number,
+           const double                              value,
+           const bool                                ghosts_only);
+
   template void
   fill_all(tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy,
            const int                                 data_index,
@@ -414,8 +933,54 @@ namespace fdl
            const float                               value,
            const bool                                interior_only);
 
+  template void
+  fill_all(tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy,
+           const std::vector<int>                   &data_indices,
+           const int                                 coarsest_level_number,
+           const int                                 finest_level_number,
+           const float                               value,
+           const bool                                ghosts_only);
+
   template tbox::Pointer<math::HierarchyDataOpsReal<NDIM, double>>
   extract_hierarchy_data_ops(
     const tbox::Pointer<hier::Variable<NDIM>> p,
     tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy);
+
+  template bool
+  have_same_layout(tbox::Pointer<hier::PatchLevel<NDIM>> level_1,
+                   tbox::Pointer<hier::PatchLevel<NDIM>> level_2);
+
+  template void
+  alias_patch_data(tbox::Pointer<hier::PatchLevel<NDIM>> dst_level,
+                   tbox::Pointer<hier::PatchLevel<NDIM>> src_level,
+                   const int                             data_index);
+
+  template void
+  alias_patch_data(tbox::Pointer<hier::PatchLevel<NDIM>> dst_level,
+                   tbox::Pointer<hier::PatchLevel<NDIM>> src_level,
+                   const std::vector<int>               &patch_numbers,
+                   const int                             data_index);
+
+  template void
+  add_nonzero_cell_data(tbox::Pointer<hier::PatchLevel<NDIM>> dst_level,
+                        tbox::Pointer<hier::PatchLevel<NDIM>> src_level,
+                        const int                             data_index,
+                        const MPI_Comm                        communicator);
+
+  template void
+  accumulate_nonzero_ghost_data(
+    tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy,
+    const int                                 data_index,
+    const hier::IntVector<NDIM>              &ghost_width,
+    const int                                 coarsest_level_number,
+    const int                                 finest_level_number,
+    const MPI_Comm                            communicator);
+
+  template tbox::Pointer<hier::PatchLevel<NDIM>>
+  make_patch_level_subset(tbox::Pointer<hier::PatchLevel<NDIM>> level,
+                          const std::vector<int>               &patch_numbers);
+
+  template void
+  add_patch_data(tbox::Pointer<hier::PatchData<NDIM>>       dst,
+                 const tbox::Pointer<hier::PatchData<NDIM>> src);
 } // namespace fdl
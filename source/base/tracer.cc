@@ -0,0 +1,114 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/tracer.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  namespace
+  {
+    /**
+     * Quote @p string as a JSON string.
+     */
+    std::string
+    quote(const std::string &string)
+    {
+      std::string result = "\"";
+      for (const char c : string)
+        {
+          if (c == '"' || c == '\\')
+            result += '\\';
+          result += c;
+        }
+      return result + '"';
+    }
+  } // namespace
+
+  Tracer::Tracer(const MPI_Comm &communicator)
+    : communicator(communicator)
+  {
+    const int ierr = MPI_Barrier(communicator);
+    AssertThrowMPI(ierr);
+    start_time = MPI_Wtime();
+  }
+
+
+
+  void
+  Tracer::add_event(const std::string &lane,
+                    const std::string &name,
+                    const std::string &category,
+                    const double       event_start_time,
+                    const double       event_end_time)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const unsigned int          lane_n =
+      lanes.emplace(lane, static_cast<unsigned int>(lanes.size()))
+        .first->second;
+    events.push_back(
+      {lane_n, name, category, event_start_time, event_end_time});
+  }
+
+
+
+  std::size_t
+  Tracer::n_events() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+  }
+
+
+
+  void
+  Tracer::write(const std::string &filename) const
+  {
+    const unsigned int rank = Utilities::MPI::this_mpi_process(communicator);
+    std::ostringstream out;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      // times are in microseconds
+      out << std::fixed << std::setprecision(3);
+      out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << rank
+          << ", \"args\": {\"name\": \"processor " << rank << "\"}}";
+      for (const auto &pair : lanes)
+        out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": "
+            << rank << ", \"tid\": " << pair.second
+            << ", \"args\": {\"name\": " << quote(pair.first) << "}}";
+      for (const Event &event : events)
+        out << ",\n{\"name\": " << quote(event.name)
+            << ", \"cat\": " << quote(event.category)
+            << ", \"ph\": \"X\", \"pid\": " << rank
+            << ", \"tid\": " << event.lane_n
+            << ", \"ts\": " << 1e6 * (event.start_time - start_time)
+            << ", \"dur\": " << 1e6 * (event.end_time - event.start_time)
+            << "}";
+    }
+
+    const std::vector<std::string> all_events =
+      Utilities::MPI::gather(communicator, out.str());
+    if (rank == 0)
+      {
+        std::ofstream file(filename);
+        file << "{\"traceEvents\": [\n";
+        for (unsigned int r = 0; r < all_events.size(); ++r)
+          file << (r == 0 ? "" : ",\n") << all_events[r];
+        file << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+      }
+  }
+
+
+
+  void
+  Tracer::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+  }
+} // namespace fdl
@@ -1,14 +1,95 @@
 #include <fiddle/base/exceptions.h>
 #include <fiddle/base/utilities.h>
 
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
+#include <deal.II/base/bounding_box.h>
 
+#include <deal.II/numerics/rtree.h>
+
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#ifdef __SSSE3__
+#  include <tmmintrin.h>
+#endif
 
 namespace fdl
 {
+  namespace
+  {
+    /**
+     * A cone of directions: i.e., all unit vectors whose angle with the axis
+     * is at most some value.
+     */
+    template <int spacedim>
+    struct Cone
+    {
+      Tensor<1, spacedim> axis;
+      double              cos_angle;
+      double              sin_angle;
+    };
+
+    /**
+     * Cover all directions with cones by projecting each direction onto the
+     * surface of the cube [-1, 1]^spacedim and splitting each face of that
+     * cube into n_bins^(spacedim - 1) squares.
+     */
+    template <int spacedim>
+    std::vector<Cone<spacedim>>
+    make_cones(const unsigned int n_bins)
+    {
+      unsigned int n_squares = 1;
+      for (unsigned int d = 0; d < spacedim - 1; ++d)
+        n_squares *= n_bins;
+
+      std::vector<Cone<spacedim>> cones;
+      for (unsigned int axis = 0; axis < spacedim; ++axis)
+        for (const double sign : {-1.0, 1.0})
+          for (unsigned int square_n = 0; square_n < n_squares; ++square_n)
+            {
+              Tensor<1, spacedim> lower;
+              Tensor<1, spacedim> upper;
+              unsigned int        index = square_n;
+              for (unsigned int d = 0; d < spacedim; ++d)
+                if (d == axis)
+                  lower[d] = upper[d] = sign;
+                else
+                  {
+                    const unsigned int bin = index % n_bins;
+                    index /= n_bins;
+                    lower[d] = -1.0 + 2.0 * bin / n_bins;
+                    upper[d] = -1.0 + 2.0 * (bin + 1) / n_bins;
+                  }
+
+              Cone<spacedim> cone;
+              cone.axis = (lower + upper) / 2.0;
+              cone.axis /= cone.axis.norm();
+              // Since the set of directions within an angle of the axis is
+              // convex on the face, the largest angle is at a corner.
+              cone.cos_angle = 1.0;
+              for (unsigned int corner_n = 0; corner_n < (1u << spacedim);
+                   ++corner_n)
+                {
+                  Tensor<1, spacedim> corner;
+                  for (unsigned int d = 0; d < spacedim; ++d)
+                    corner[d] = (corner_n >> d) & 1u ? upper[d] : lower[d];
+                  cone.cos_angle =
+                    std::min(cone.cos_angle,
+                             (corner * cone.axis) / corner.norm());
+                }
+              // Round outwards
+              cone.cos_angle -= 1e-12;
+              cone.sin_angle =
+                std::sqrt(1.0 - cone.cos_angle * cone.cos_angle);
+              cones.push_back(cone);
+            }
+
+      return cones;
+    }
+  } // namespace
+
   template <int spacedim>
   std::pair<Point<spacedim>, double>
   compute_largest_nonintersecting_sphere(
@@ -16,20 +97,13 @@ namespace fdl
   {
     Assert(points.size() > 1,
            ExcMessage("Need at least two points to compute a distance"));
+    namespace bgi = boost::geometry::index;
     Point<spacedim> best_center;
     double          best_diameter = 0.0;
 
-    // Speed up the bounding check by only examining points whose x coordinate
-    // is near that of the sphere
-    auto x_less = [](const Point<spacedim> &a, const Point<spacedim> &b)
-    { return a[0] < b[0]; };
-
-    std::vector<Point<spacedim>> points_copy(points);
-    std::sort(points_copy.begin(), points_copy.end(), x_less);
+    const auto                  rtree = pack_rtree_of_indices(points);
+    const BoundingBox<spacedim> bbox(points);
 
-    // This is the brute-force version. We don't normally have more than a
-    // hundred quadrature points per cell, so N^2 algorithms aren't
-    // completely deadly yet.
     auto sphere_contains_nontangent_point =
       [&](const Point<spacedim> &center,
           const unsigned int    &tangent_point_n,
@@ -38,79 +112,285 @@ namespace fdl
       const double magnitude =
         std::max(center.norm(), points[tangent_point_n].norm());
 
-      Point<spacedim> left  = center;
-      Point<spacedim> right = center;
-      left[0] -= diameter / 2.0;
-      right[0] += diameter / 2.0;
-
-      // Only check points that are in the correct x pencil.
-      auto upper_bound =
-        std::lower_bound(points_copy.begin(), points_copy.end(), right, x_less);
-      auto lower_bound =
-        std::lower_bound(points_copy.begin(), points_copy.end(), left, x_less);
-      if (lower_bound != points_copy.begin())
-        --lower_bound;
-
-      for (auto it = lower_bound; it < upper_bound; ++it)
-        if ((it->distance(center) - diameter / 2.0) < -magnitude * 1e-14)
-          return true;
-
-      return false;
+      BoundingBox<spacedim> sphere_bbox(std::make_pair(center, center));
+      sphere_bbox.extend(diameter / 2.0);
+      const auto is_inside = [&](const std::size_t point_n)
+      {
+        return (points[point_n].distance(center) - diameter / 2.0) <
+               -magnitude * 1e-14;
+      };
+      return rtree.qbegin(bgi::intersects(sphere_bbox) &&
+                          bgi::satisfies(is_inside)) != rtree.qend();
     };
 
-    // points tend to be clustered at endpoints. Try to find one in the middle
-    // to start with:
+    // Checking every pair of points is O(N^3), so only check the pairs
+    // containing nearby points. For points i and j, the sphere whose diameter
+    // is (i, j) contains k if (k - i) * (j - k) > 0, i.e., if j is a distance
+    // t from i in the direction v and t v * w > 1 for w = (k - i) / |k - i|^2.
+    // Hence, if every direction in a cone has a dot product of at least c with
+    // some such w, then no point farther than 1 / c from i in that cone can
+    // form an empty sphere with i. Since the bounding box contains every point
+    // we can treat its faces in the same way. We encounter points in order of
+    // increasing distance, so stop once every cone is covered.
+    const std::vector<Cone<spacedim>> cones = make_cones<spacedim>(4);
+    std::vector<double>               coverages(cones.size());
+    const auto add_coverage = [&](const Tensor<1, spacedim> &direction,
+                                  const double               magnitude)
     {
-      const unsigned int i      = points.size() / 2;
-      const auto        &point1 = points[i];
-      for (unsigned int j = i + 1; j < points.size(); ++j)
+      for (unsigned int cone_n = 0; cone_n < cones.size(); ++cone_n)
         {
-          const auto           &point2             = points[j];
-          const Point<spacedim> tentative_center   = (point1 + point2) / 2.0;
-          const double          tentative_diameter = point1.distance(point2);
-
-          if ((tentative_diameter > best_diameter) &&
-              !sphere_contains_nontangent_point(tentative_center,
-                                                i,
-                                                tentative_diameter))
-            {
-              best_center   = tentative_center;
-              best_diameter = tentative_diameter;
-            }
+          const Cone<spacedim> &cone      = cones[cone_n];
+          const double          cos_theta = direction * cone.axis;
+          const double          sin_theta =
+            std::sqrt(std::max(0.0, 1.0 - cos_theta * cos_theta));
+          // lower bound on the dot product with any direction in the cone
+          const double cos_sum =
+            cos_theta * cone.cos_angle - sin_theta * cone.sin_angle;
+          if (cos_sum > 0.0)
+            coverages[cone_n] =
+              std::max(coverages[cone_n], magnitude * cos_sum);
         }
-    }
+    };
 
     for (unsigned int i = 0; i < points.size(); ++i)
       {
         const auto &point1 = points[i];
-        for (unsigned int j = i + 1; j < points.size(); ++j)
+        std::fill(coverages.begin(), coverages.end(), 0.0);
+        for (unsigned int d = 0; d < spacedim; ++d)
+          for (const double sign : {-1.0, 1.0})
+            {
+              const double width = sign < 0.0 ?
+                                     point1[d] - bbox.lower_bound(d) :
+                                     bbox.upper_bound(d) - point1[d];
+              Tensor<1, spacedim> direction;
+              direction[d] = sign;
+              add_coverage(direction,
+                           width > 0.0 ? 1.0 / width :
+                                         std::numeric_limits<double>::max());
+            }
+
+        for (auto it = rtree.qbegin(bgi::nearest(point1, points.size()));
+             it != rtree.qend();
+             ++it)
           {
-            const auto           &point2             = points[j];
-            const Point<spacedim> tentative_center   = (point1 + point2) / 2.0;
-            const double          tentative_diameter = point1.distance(point2);
-
-            if ((tentative_diameter > best_diameter) &&
-                !sphere_contains_nontangent_point(tentative_center,
-                                                  i,
-                                                  tentative_diameter))
+            const unsigned int j        = *it;
+            const auto        &point2   = points[j];
+            const double       distance = point1.distance(point2);
+            const double       coverage =
+              *std::min_element(coverages.begin(), coverages.end());
+            if (distance * coverage > 1.0 + 1e-6)
+              break;
+            // skip the point itself and any duplicates
+            if (distance == 0.0)
+              continue;
+
+            // Each pair only needs to be checked once
+            if (j > i && distance > best_diameter)
               {
-                best_center   = tentative_center;
-                best_diameter = tentative_diameter;
+                const Point<spacedim> tentative_center =
+                  (point1 + point2) / 2.0;
+                if (!sphere_contains_nontangent_point(tentative_center,
+                                                      i,
+                                                      distance))
+                  {
+                    best_center   = tentative_center;
+                    best_diameter = distance;
+                  }
               }
+            add_coverage((point2 - point1) / distance, 1.0 / distance);
           }
       }
 
     return std::make_pair(best_center, best_diameter);
   }
+
+  namespace
+  {
+    constexpr char base64_alphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Map from characters to sextets. Invalid characters map to 0xff.
+    constexpr std::array<unsigned char, 256>
+    make_base64_decode_table()
+    {
+      std::array<unsigned char, 256> table{};
+      for (auto &entry : table)
+        entry = 0xff;
+      for (unsigned char i = 0; i < 64; ++i)
+        table[static_cast<unsigned char>(base64_alphabet[i])] = i;
+      return table;
+    }
+
+    constexpr std::array<unsigned char, 256> base64_decode_table =
+      make_base64_decode_table();
+
+#ifdef __SSSE3__
+    // Convert twelve bytes (stored in the first twelve bytes of @p input) to
+    // sixteen base64 characters. This is the algorithm described in
+    // W. Mula and D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2
+    // Instructions", ACM Transactions on the Web, 2018.
+    inline __m128i
+    encode_base64_block(__m128i input)
+    {
+      // Put each group of three bytes into its own 32-bit lane (in a
+      // convenient order) and then shift each sextet into its own byte.
+      input = _mm_shuffle_epi8(
+        input,
+        _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+      const __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+      const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+      const __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+      const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+      const __m128i indices = _mm_or_si128(t1, t3);
+
+      // Compute the offset from each sextet to its character: 0 - 25 map to
+      // shift_table[13], 26 - 51 to shift_table[0], and 52 - 63 to
+      // shift_table[1 - 12].
+      __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+      const __m128i less_than_26 =
+        _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+      reduced =
+        _mm_or_si128(reduced, _mm_and_si128(less_than_26, _mm_set1_epi8(13)));
+      const __m128i shift_table = _mm_setr_epi8('a' - 26,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '0' - 52,
+                                                '+' - 62,
+                                                '/' - 63,
+                                                'A',
+                                                0,
+                                                0);
+      return _mm_add_epi8(_mm_shuffle_epi8(shift_table, reduced), indices);
+    }
+
+    // Convert sixteen base64 characters to twelve bytes (stored in the first
+    // twelve bytes of @p output). Returns false if any character is invalid.
+    // Uses the same reference as encode_base64_block().
+    inline bool
+    decode_base64_block(const __m128i input, __m128i &output)
+    {
+      const __m128i upper_nibbles =
+        _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+      const __m128i lower_nibbles = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+
+      // Check validity: each upper nibble corresponds to a bit and each lower
+      // nibble to a mask of the upper nibbles which form valid characters.
+      const __m128i mask_table = _mm_setr_epi8(char(0xa8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf8),
+                                               char(0xf0),
+                                               char(0x54),
+                                               char(0x50),
+                                               char(0x50),
+                                               char(0x50),
+                                               char(0x54));
+      const __m128i bit_table = _mm_setr_epi8(0x01,
+                                              0x02,
+                                              0x04,
+                                              0x08,
+                                              0x10,
+                                              0x20,
+                                              0x40,
+                                              char(0x80),
+                                              0,
+                                              0,
+                                              0,
+                                              0,
+                                              0,
+                                              0,
+                                              0,
+                                              0);
+      const __m128i masks = _mm_shuffle_epi8(mask_table, lower_nibbles);
+      const __m128i bits  = _mm_shuffle_epi8(bit_table, upper_nibbles);
+      const __m128i invalid =
+        _mm_cmpeq_epi8(_mm_and_si128(masks, bits), _mm_setzero_si128());
+      if (_mm_movemask_epi8(invalid) != 0)
+        return false;
+
+      // The offset from each character to its sextet only depends on the upper
+      // nibble, except for '/', which shares its upper nibble with '+'.
+      const __m128i shift_table =
+        _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      __m128i shifts = _mm_shuffle_epi8(shift_table, upper_nibbles);
+      const __m128i is_slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+      shifts = _mm_add_epi8(shifts, _mm_and_si128(is_slash, _mm_set1_epi8(-3)));
+      const __m128i sextets = _mm_add_epi8(input, shifts);
+
+      // Combine pairs of sextets, then pairs of those, and finally move the
+      // bytes into order.
+      const __m128i pairs =
+        _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+      const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+      output               = _mm_shuffle_epi8(
+        groups,
+        _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+      return true;
+    }
+#endif
+  } // namespace
+
   std::string
   encode_base64(const char *begin, const char *end)
   {
-    using namespace boost::archive::iterators;
-    using iterator = base64_from_binary<transform_width<const char *, 6, 8>>;
-    std::string base64{iterator(begin), iterator(end)};
+    const std::size_t n_bytes = end - begin;
+    std::string       base64(4 * ((n_bytes + 2) / 3), '\0');
+
+    const auto *in   = reinterpret_cast<const unsigned char *>(begin);
+    const auto *stop = reinterpret_cast<const unsigned char *>(end);
+    char       *out  = &base64[0];
+#ifdef __SSSE3__
+    // Each block reads sixteen bytes but only uses twelve
+    while (stop - in >= 16)
+      {
+        const __m128i block = encode_base64_block(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), block);
+        in += 12;
+        out += 16;
+      }
+#endif
+    while (stop - in >= 3)
+      {
+        const std::uint32_t group = (std::uint32_t(in[0]) << 16) |
+                                    (std::uint32_t(in[1]) << 8) |
+                                    std::uint32_t(in[2]);
+        out[0] = base64_alphabet[(group >> 18) & 0x3f];
+        out[1] = base64_alphabet[(group >> 12) & 0x3f];
+        out[2] = base64_alphabet[(group >> 6) & 0x3f];
+        out[3] = base64_alphabet[group & 0x3f];
+        in += 3;
+        out += 4;
+      }
+
     // Add padding.
-    std::array<std::string, 3> paddings{"", "==", "="};
-    base64.append(paddings[(end - begin) % 3]);
+    if (stop - in == 1)
+      {
+        out[0] = base64_alphabet[in[0] >> 2];
+        out[1] = base64_alphabet[(in[0] & 0x03) << 4];
+        out[2] = '=';
+        out[3] = '=';
+      }
+    else if (stop - in == 2)
+      {
+        out[0] = base64_alphabet[in[0] >> 2];
+        out[1] = base64_alphabet[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+        out[2] = base64_alphabet[(in[1] & 0x0f) << 2];
+        out[3] = '=';
+      }
 
     return base64;
   }
@@ -118,23 +398,67 @@ namespace fdl
   std::string
   decode_base64(const char *begin, const char *end)
   {
-    using namespace boost::archive::iterators;
-    using iterator = transform_width<binary_from_base64<const char *>, 8, 6>;
-    std::string binary{iterator(begin), iterator(end)};
-
-    // We have three possibilities for padding, based on how boost decodes it:
-    // input ends in "==": remove two NULs at the end
-    // input ends in "=": remove one NUL at the end
-    // otherwise: no padding, nothing to remove
-    if (begin != end)
+    // Padding carries no information so we can skip it
+    while (end != begin && *(end - 1) == '=')
+      --end;
+
+    const std::size_t n_chars = end - begin;
+    AssertThrow(n_chars % 4 != 1,
+                ExcMessage("The input is not a valid base64 string."));
+    // Each group of four characters is three bytes and a remainder of two or
+    // three characters is one or two bytes.
+    const std::size_t n_remainder = n_chars % 4 == 0 ? 0 : n_chars % 4 - 1;
+    std::string       binary(3 * (n_chars / 4) + n_remainder, '\0');
+
+    const auto *in   = reinterpret_cast<const unsigned char *>(begin);
+    const auto *stop = reinterpret_cast<const unsigned char *>(end);
+    char       *out  = &binary[0];
+#ifdef __SSSE3__
+    // Each block writes sixteen bytes but only the first twelve are valid, so
+    // we need at least four more bytes of output: i.e., at least six more
+    // characters of input.
+    while (stop - in >= 22)
       {
-        const char *input = end - 1;
-        while (input >= begin && *input == '=')
-          {
-            binary.pop_back();
-            --input;
-          }
+        __m128i    block;
+        const bool valid = decode_base64_block(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), block);
+        AssertThrow(valid,
+                    ExcMessage("The input is not a valid base64 string."));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), block);
+        in += 16;
+        out += 12;
       }
+#endif
+    auto get_sextet = [](const unsigned char c) -> std::uint32_t
+    {
+      const unsigned char sextet = base64_decode_table[c];
+      AssertThrow(sextet != 0xff,
+                  ExcMessage("The input is not a valid base64 string."));
+      return sextet;
+    };
+    while (stop - in >= 4)
+      {
+        const std::uint32_t group =
+          (get_sextet(in[0]) << 18) | (get_sextet(in[1]) << 12) |
+          (get_sextet(in[2]) << 6) | get_sextet(in[3]);
+        out[0] = char(group >> 16);
+        out[1] = char(group >> 8);
+        out[2] = char(group);
+        in += 4;
+        out += 3;
+      }
+
+    if (stop - in >= 2)
+      {
+        std::uint32_t group =
+          (get_sextet(in[0]) << 18) | (get_sextet(in[1]) << 12);
+        if (stop - in == 3)
+          group |= get_sextet(in[2]) << 6;
+        out[0] = char(group >> 16);
+        if (stop - in == 3)
+          out[1] = char(group >> 8);
+      }
+
     return binary;
   }
 
@@ -3,12 +3,20 @@
 #include <fiddle/grid/box_utilities.h>
 
 #include <deal.II/base/bounding_box.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/quadrature_lib.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
 #include <deal.II/fe/fe_values.h>
 
+#include <deal.II/grid/reference_cell.h>
+
+#include <deal.II/numerics/rtree.h>
+
+#include <boost/iterator/function_output_iterator.hpp>
+
 #include <CartesianGridGeometry.h>
 #include <CartesianPatchGeometry.h>
 #include <MultiblockPatchLevel.h>
@@ -16,6 +24,15 @@
 #include <PatchLevel.h>
 #include <tbox/SAMRAI_MPI.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <tuple>
 #include <vector>
 
 namespace fdl
@@ -147,6 +164,300 @@ namespace fdl
     return bboxes;
   }
 
+  namespace
+  {
+    /**
+     * Compute the distinct points among the vertices of the reference cell
+     * of @p fe and its unit support points (vertices first) and, for each
+     * line of the reference cell, the indices of the points which lie on it
+     * in order.
+     */
+    template <int dim, int spacedim>
+    std::pair<std::vector<Point<dim>>, std::vector<std::vector<unsigned int>>>
+    compute_unit_line_points(const FiniteElement<dim, spacedim> &fe)
+    {
+      const ReferenceCell reference_cell = fe.reference_cell();
+      constexpr double    tolerance      = 1e-10;
+
+      std::vector<Point<dim>> unit_points;
+      const auto              add_point = [&](const Point<dim> &point)
+      {
+        for (const Point<dim> &p : unit_points)
+          if (p.distance(point) < tolerance)
+            return;
+        unit_points.push_back(point);
+      };
+      for (const unsigned int vertex_n : reference_cell.vertex_indices())
+        add_point(reference_cell.template vertex<dim>(vertex_n));
+      for (const Point<dim> &point : fe.get_unit_support_points())
+        add_point(point);
+
+      std::vector<std::vector<unsigned int>> line_points(
+        reference_cell.n_lines());
+      for (const unsigned int line_n : reference_cell.line_indices())
+        {
+          const Point<dim> p0 = reference_cell.template vertex<dim>(
+            reference_cell.line_to_cell_vertices(line_n, 0));
+          const Point<dim> p1 = reference_cell.template vertex<dim>(
+            reference_cell.line_to_cell_vertices(line_n, 1));
+          const Tensor<1, dim> direction = p1 - p0;
+
+          std::vector<std::pair<double, unsigned int>> parameters;
+          for (unsigned int i = 0; i < unit_points.size(); ++i)
+            {
+              const double t =
+                ((unit_points[i] - p0) * direction) / direction.norm_square();
+              if (-tolerance <= t && t <= 1.0 + tolerance &&
+                  (p0 + t * direction).distance(unit_points[i]) < tolerance)
+                parameters.emplace_back(t, i);
+            }
+          std::sort(parameters.begin(), parameters.end());
+          for (const auto &pair : parameters)
+            line_points[line_n].push_back(pair.second);
+        }
+
+      return std::make_pair(std::move(unit_points), std::move(line_points));
+    }
+
+    /**
+     * Compute the length of the longest polyline connecting the points which
+     * lie on each line.
+     */
+    template <int spacedim>
+    double
+    compute_longest_line_length(
+      const std::vector<Point<spacedim>>           &points,
+      const std::vector<std::vector<unsigned int>> &line_points)
+    {
+      double longest_edge_length = 0.0;
+      for (const std::vector<unsigned int> &line : line_points)
+        {
+          double length = 0.0;
+          for (unsigned int i = 1; i < line.size(); ++i)
+            length += points[line[i - 1]].distance(points[line[i]]);
+          longest_edge_length = std::max(longest_edge_length, length);
+        }
+      return longest_edge_length;
+    }
+  } // namespace
+
+  template <int dim, int spacedim, typename Number>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping)
+  {
+    // TODO: support multiple FEs
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+
+    // Evaluate the mapping at each distinct support point and at the vertices
+    // (so that each line contains at least its two end points):
+    std::vector<Point<dim>>                unit_points;
+    std::vector<std::vector<unsigned int>> line_points;
+    std::tie(unit_points, line_points) = compute_unit_line_points(fe);
+
+    FEValues<dim, spacedim> fe_values(mapping,
+                                      fe,
+                                      Quadrature<dim>(unit_points),
+                                      update_quadrature_points);
+
+    std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+      result;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          const std::vector<Point<spacedim>> &points =
+            fe_values.get_quadrature_points();
+          const BoundingBox<spacedim> dbox(points);
+          // we have to do a conversion if Number != double
+          BoundingBox<spacedim, Number> fbox;
+          fbox.get_boundary_points() = dbox.get_boundary_points();
+          result.first.push_back(fbox);
+          result.second.push_back(static_cast<float>(
+            compute_longest_line_length(points, line_points)));
+        }
+    return result;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_nodal_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim>                  &dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position)
+  {
+    std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+      result;
+    if (dof_handler.get_triangulation().n_active_cells() == 0)
+      return result;
+    // TODO: support multiple FEs
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.reference_cell() == ReferenceCells::get_hypercube<dim>(),
+                ExcFDLNotImplemented());
+    AssertThrow(fe.n_components() == spacedim && fe.is_primitive() &&
+                  fe.has_support_points(),
+                ExcMessage("The position should be a Lagrange finite element "
+                           "field with one component per spatial "
+                           "dimension."));
+    constexpr double tolerance = 1e-10;
+
+    // Determine which point and component each DoF corresponds to. Every
+    // point (including the vertices) must have one DoF per component.
+    std::vector<Point<dim>>                unit_points;
+    std::vector<std::vector<unsigned int>> line_points;
+    std::tie(unit_points, line_points) = compute_unit_line_points(fe);
+    std::vector<unsigned int> dof_points(fe.n_dofs_per_cell());
+    std::vector<unsigned int> dof_components(fe.n_dofs_per_cell());
+    std::vector<unsigned int> n_point_dofs(unit_points.size());
+    for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+      {
+        const Point<dim> &support_point = fe.unit_support_point(i);
+        const auto        it =
+          std::find_if(unit_points.begin(),
+                       unit_points.end(),
+                       [&](const Point<dim> &p)
+                       { return p.distance(support_point) < tolerance; });
+        Assert(it != unit_points.end(), ExcFDLInternalError());
+        dof_points[i]     = it - unit_points.begin();
+        dof_components[i] = fe.system_to_component_index(i).first;
+        ++n_point_dofs[dof_points[i]];
+      }
+    for (const unsigned int n_dofs : n_point_dofs)
+      AssertThrow(n_dofs == spacedim,
+                  ExcMessage("Each vertex should be a support point of every "
+                             "component of the position."));
+
+    // Since the shape functions of each component sum to one, each component
+    // of the position at a point in the cell is at most the largest nodal
+    // value plus the width of the nodal values times the sum of the negative
+    // parts of that component's shape functions at that point (and similarly
+    // for the smallest value). Estimate the largest such sum by sampling.
+    std::vector<double> negative_parts(spacedim);
+    const QIterated<dim> samples(QTrapezoid<1>(),
+                                 8 * std::max(1u, fe.tensor_degree()));
+    for (const Point<dim> &point : samples.get_points())
+      {
+        std::vector<double> point_negative_parts(spacedim);
+        for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+          point_negative_parts[dof_components[i]] +=
+            std::max(0.0, -fe.shape_value(i, point));
+        for (unsigned int d = 0; d < spacedim; ++d)
+          negative_parts[d] =
+            std::max(negative_parts[d], point_negative_parts[d]);
+      }
+
+    std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+    std::vector<Point<spacedim>>         points(unit_points.size());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cell->get_dof_indices(dof_indices);
+          for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+            points[dof_points[i]][dof_components[i]] =
+              position(dof_indices[i]);
+
+          const BoundingBox<spacedim>   dbox(points);
+          BoundingBox<spacedim, Number> fbox;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              const double padding =
+                negative_parts[d] * (dbox.upper_bound(d) - dbox.lower_bound(d));
+              fbox.get_boundary_points().first[d] =
+                dbox.lower_bound(d) - padding;
+              fbox.get_boundary_points().second[d] =
+                dbox.upper_bound(d) + padding;
+            }
+          result.first.push_back(fbox);
+          result.second.push_back(static_cast<float>(
+            compute_longest_line_length(points, line_points)));
+        }
+    return result;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping,
+    const Quadrature<dim>           &quadrature)
+  {
+    return compute_cell_point_bboxes_and_longest_edge_lengths<dim,
+                                                              spacedim,
+                                                              Number>(
+      dof_handler,
+      mapping,
+      quadrature,
+      compute_cell_bboxes_and_longest_edge_lengths<dim, spacedim, Number>(
+        dof_handler, mapping));
+  }
+
+  template <int dim, int spacedim, typename Number>
+  std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping,
+    const Quadrature<dim>           &quadrature,
+    std::pair<std::vector<BoundingBox<spacedim, Number>>, std::vector<float>>
+      support_point_geometry)
+  {
+    auto result = std::move(support_point_geometry);
+    if (dof_handler.get_triangulation().n_active_cells() == 0)
+      return result;
+    // TODO: support multiple FEs
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.reference_cell() == ReferenceCells::get_hypercube<dim>(),
+                ExcFDLNotImplemented());
+    AssertThrow(quadrature.size() > 0,
+                ExcMessage("The quadrature should contain at least one "
+                           "point."));
+
+    // Distance, in reference coordinates, between the points and the
+    // boundary of the reference cell
+    double boundary_distance = 0.5;
+    for (const Point<dim> &point : quadrature.get_points())
+      for (unsigned int d = 0; d < dim; ++d)
+        boundary_distance =
+          std::min({boundary_distance, point[d], 1.0 - point[d]});
+    boundary_distance = std::max(boundary_distance, 0.0);
+
+    FEValues<dim, spacedim> fe_values(mapping,
+                                      fe,
+                                      quadrature,
+                                      update_quadrature_points);
+    std::size_t local_cell_n = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          AssertIndexRange(local_cell_n, result.first.size());
+          fe_values.reinit(cell);
+          BoundingBox<spacedim> point_bbox(fe_values.get_quadrature_points());
+          point_bbox.extend(dim * boundary_distance *
+                            result.second[local_cell_n]);
+
+          // Never use a larger box than the one of the support points. The
+          // support points of a curved cell may not quite contain all of its
+          // quadrature points, so keep the original bounds if the boxes do
+          // not overlap.
+          auto &bbox = result.first[local_cell_n];
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              const double lower =
+                std::max<double>(bbox.lower_bound(d),
+                                 point_bbox.lower_bound(d));
+              const double upper =
+                std::min<double>(bbox.upper_bound(d),
+                                 point_bbox.upper_bound(d));
+              if (lower <= upper)
+                {
+                  bbox.get_boundary_points().first[d]  = lower;
+                  bbox.get_boundary_points().second[d] = upper;
+                }
+            }
+          ++local_cell_n;
+        }
+    return result;
+  }
+
   template <int dim, int spacedim, typename Number>
   std::vector<BoundingBox<spacedim, Number>>
   collect_all_active_cell_bboxes(
@@ -252,6 +563,530 @@ namespace fdl
     return global_bboxes;
   }
 
+  template <int dim, int spacedim>
+  std::pair<std::vector<BoundingBox<spacedim, float>>, std::vector<float>>
+  collect_all_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, float>> &local_active_cell_bboxes,
+    const std::vector<float> &local_active_edge_lengths)
+  {
+    Assert(
+      tria.n_locally_owned_active_cells() == local_active_cell_bboxes.size(),
+      ExcMessage("There should be a local bbox for each local active cell"));
+    Assert(
+      tria.n_locally_owned_active_cells() == local_active_edge_lengths.size(),
+      ExcMessage("There should be an edge length for each local active cell"));
+
+    // Pack each cell's bbox and edge length together:
+    constexpr int      n_nums_per_cell = spacedim * 2 + 1;
+    std::vector<float> local_data;
+    local_data.reserve(n_nums_per_cell * local_active_cell_bboxes.size());
+    for (unsigned int i = 0; i < local_active_cell_bboxes.size(); ++i)
+      {
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            local_data.push_back(local_active_cell_bboxes[i].lower_bound(d));
+            local_data.push_back(local_active_cell_bboxes[i].upper_bound(d));
+          }
+        local_data.push_back(local_active_edge_lengths[i]);
+      }
+
+    MPI_Comm comm = tria.get_communicator();
+    // Exchange number of cells:
+    const int        n_procs = Utilities::MPI::n_mpi_processes(comm);
+    std::vector<int> entries_per_proc(n_procs);
+    const int        entries_on_this_proc = local_data.size();
+
+    int ierr = MPI_Allgather(&entries_on_this_proc,
+                             1,
+                             MPI_INT,
+                             &entries_per_proc[0],
+                             1,
+                             MPI_INT,
+                             comm);
+    AssertThrowMPI(ierr);
+    Assert(std::accumulate(entries_per_proc.begin(),
+                           entries_per_proc.end(),
+                           0u) == (tria.n_active_cells() * n_nums_per_cell),
+           ExcMessage("Should be a partition"));
+
+    // Determine indices into temporary array:
+    std::vector<int> offsets(n_procs);
+    offsets[0] = 0;
+    std::partial_sum(entries_per_proc.begin(),
+                     entries_per_proc.end() - 1,
+                     offsets.begin() + 1);
+    // Communicate everything at once:
+    std::vector<float> temp_data(tria.n_active_cells() * n_nums_per_cell);
+    ierr = MPI_Allgatherv(local_data.data(),
+                          entries_on_this_proc,
+                          MPI_FLOAT,
+                          temp_data.data(),
+                          entries_per_proc.data(),
+                          offsets.data(),
+                          MPI_FLOAT,
+                          comm);
+    AssertThrowMPI(ierr);
+
+    // Copy to the correct ordering. Keep track of how many cells we have copied
+    // from each processor:
+    std::pair<std::vector<BoundingBox<spacedim, float>>, std::vector<float>>
+      result;
+    result.first.resize(tria.n_active_cells());
+    result.second.resize(tria.n_active_cells());
+    std::vector<int> current_proc_cell_n(n_procs);
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        const unsigned int        active_cell_index = cell->active_cell_index();
+        const types::subdomain_id this_cell_proc_n =
+          tria.get_true_subdomain_ids_of_cells()[active_cell_index];
+        const float *ptr = temp_data.data() + offsets[this_cell_proc_n] +
+                           n_nums_per_cell *
+                             current_proc_cell_n[this_cell_proc_n];
+        auto &bbox = result.first[active_cell_index];
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            bbox.get_boundary_points().first[d]  = *ptr++;
+            bbox.get_boundary_points().second[d] = *ptr++;
+          }
+        result.second[active_cell_index] = *ptr;
+        ++current_proc_cell_n[this_cell_proc_n];
+      }
+
+#ifdef DEBUG
+    for (const float &length : result.second)
+      Assert(length > 0, ExcMessage("max length should not be zero"));
+#endif
+    return result;
+  }
+
+  template <int dim, int spacedim>
+  std::pair<AlignedVector<BoundingBox<spacedim, float>>, AlignedVector<float>>
+  collect_shared_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, float>> &local_active_cell_bboxes,
+    const std::vector<float> &local_active_edge_lengths)
+  {
+    Assert(
+      tria.n_locally_owned_active_cells() == local_active_cell_bboxes.size(),
+      ExcMessage("There should be a local bbox for each local active cell"));
+    Assert(
+      tria.n_locally_owned_active_cells() == local_active_edge_lengths.size(),
+      ExcMessage("There should be an edge length for each local active cell"));
+
+    // Pack each cell's bbox and edge length together:
+    constexpr int      n_nums_per_cell = spacedim * 2 + 1;
+    std::vector<float> local_data;
+    local_data.reserve(n_nums_per_cell * local_active_cell_bboxes.size());
+    for (unsigned int i = 0; i < local_active_cell_bboxes.size(); ++i)
+      {
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            local_data.push_back(local_active_cell_bboxes[i].lower_bound(d));
+            local_data.push_back(local_active_cell_bboxes[i].upper_bound(d));
+          }
+        local_data.push_back(local_active_edge_lengths[i]);
+      }
+
+    // Gather everything on the root processor:
+    MPI_Comm           comm    = tria.get_communicator();
+    const unsigned int rank    = Utilities::MPI::this_mpi_process(comm);
+    const int          n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+    const int        entries_on_this_proc = local_data.size();
+    std::vector<int> entries_per_proc(rank == 0 ? n_procs : 0);
+
+    int ierr = MPI_Gather(&entries_on_this_proc,
+                          1,
+                          MPI_INT,
+                          entries_per_proc.data(),
+                          1,
+                          MPI_INT,
+                          0,
+                          comm);
+    AssertThrowMPI(ierr);
+
+    std::vector<int> offsets(entries_per_proc.size());
+    if (rank == 0)
+      {
+        Assert(std::accumulate(entries_per_proc.begin(),
+                               entries_per_proc.end(),
+                               0u) == (tria.n_active_cells() * n_nums_per_cell),
+               ExcMessage("Should be a partition"));
+        offsets[0] = 0;
+        std::partial_sum(entries_per_proc.begin(),
+                         entries_per_proc.end() - 1,
+                         offsets.begin() + 1);
+      }
+    std::vector<float> temp_data(
+      rank == 0 ? tria.n_active_cells() * n_nums_per_cell : 0);
+    ierr = MPI_Gatherv(local_data.data(),
+                       entries_on_this_proc,
+                       MPI_FLOAT,
+                       temp_data.data(),
+                       entries_per_proc.data(),
+                       offsets.data(),
+                       MPI_FLOAT,
+                       0,
+                       comm);
+    AssertThrowMPI(ierr);
+
+    // Copy to the correct ordering, like in
+    // collect_all_active_cell_bboxes_and_lengths():
+    std::pair<AlignedVector<BoundingBox<spacedim, float>>, AlignedVector<float>>
+      result;
+    if (rank == 0)
+      {
+        result.first.resize(tria.n_active_cells());
+        result.second.resize(tria.n_active_cells());
+        std::vector<int> current_proc_cell_n(n_procs);
+        for (const auto &cell : tria.active_cell_iterators())
+          {
+            const unsigned int active_cell_index = cell->active_cell_index();
+            const types::subdomain_id this_cell_proc_n =
+              tria.get_true_subdomain_ids_of_cells()[active_cell_index];
+            const float *ptr = temp_data.data() + offsets[this_cell_proc_n] +
+                               n_nums_per_cell *
+                                 current_proc_cell_n[this_cell_proc_n];
+            auto &bbox = result.first[active_cell_index];
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                bbox.get_boundary_points().first[d]  = *ptr++;
+                bbox.get_boundary_points().second[d] = *ptr++;
+              }
+            result.second[active_cell_index] = *ptr;
+            ++current_proc_cell_n[this_cell_proc_n];
+          }
+      }
+    std::vector<float>().swap(temp_data);
+
+    result.first.replicate_across_communicator(comm, 0);
+    result.second.replicate_across_communicator(comm, 0);
+    return result;
+  }
+
+  namespace
+  {
+    // Fixed-point encoding of a single coordinate relative to an origin. The
+    // same arithmetic is used for encoding and decoding so that the sender can
+    // verify that it rounded outwards.
+    template <typename Number>
+    struct FixedPointCoordinate
+    {
+      static constexpr double max_value =
+        std::numeric_limits<std::uint16_t>::max();
+
+      double origin;
+      double spacing;
+
+      Number
+      decode(const std::uint16_t q) const
+      {
+        return Number(origin + spacing * double(q));
+      }
+
+      std::uint16_t
+      encode_lower(const Number x) const
+      {
+        if (spacing == 0.0)
+          return 0;
+        const double q = std::floor((double(x) - origin) / spacing);
+        auto         result =
+          static_cast<std::uint16_t>(std::max(0.0, std::min(q, max_value)));
+        while (result > 0 && decode(result) > x)
+          --result;
+        return result;
+      }
+
+      std::uint16_t
+      encode_upper(const Number x) const
+      {
+        if (spacing == 0.0)
+          return 0;
+        const double q = std::ceil((double(x) - origin) / spacing);
+        auto         result =
+          static_cast<std::uint16_t>(std::max(0.0, std::min(q, max_value)));
+        while (result < max_value && decode(result) < x)
+          ++result;
+        return result;
+      }
+    };
+
+    template <typename T>
+    void
+    pack(std::vector<char> &buffer, const T &value)
+    {
+      const auto *ptr = reinterpret_cast<const char *>(&value);
+      buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+    }
+
+    template <typename T>
+    T
+    unpack(const char *&ptr)
+    {
+      T value;
+      std::memcpy(&value, ptr, sizeof(T));
+      ptr += sizeof(T);
+      return value;
+    }
+  } // namespace
+
+  template <int dim, int spacedim, typename Number>
+  void
+  update_all_active_cell_bboxes(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    std::vector<BoundingBox<spacedim, Number>>       &global_active_cell_bboxes,
+    const double                                      tolerance,
+    const BoundingBoxEncoding                         encoding)
+  {
+    Assert(
+      tria.n_locally_owned_active_cells() == local_active_cell_bboxes.size(),
+      ExcMessage("There should be a local bbox for each local active cell"));
+    AssertThrow(tolerance >= 0.0,
+                ExcMessage("The tolerance should be nonnegative."));
+    // The global array is replicated so this is the same on all processors
+    if (global_active_cell_bboxes.size() != tria.n_active_cells())
+      {
+        global_active_cell_bboxes =
+          collect_all_active_cell_bboxes(tria, local_active_cell_bboxes);
+        return;
+      }
+
+    MPI_Comm   comm      = tria.get_communicator();
+    const auto this_proc = Utilities::MPI::this_mpi_process(comm);
+    const bool compress  = encoding == BoundingBoxEncoding::Compressed;
+
+    // Set up the fixed-point encoding relative to the (padded) bounding box of
+    // all boxes on this processor:
+    std::array<FixedPointCoordinate<Number>, spacedim> coordinates;
+    if (compress)
+      {
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            Number lower = std::numeric_limits<Number>::max();
+            Number upper = std::numeric_limits<Number>::lowest();
+            for (const auto &bbox : local_active_cell_bboxes)
+              {
+                lower = std::min(lower, bbox.lower_bound(d));
+                upper = std::max(upper, bbox.upper_bound(d));
+              }
+            if (local_active_cell_bboxes.size() == 0)
+              lower = upper = Number(0);
+
+            // Make the origin exactly representable so that the smallest
+            // offset decodes to a value no larger than any lower bound
+            const double origin       = double(lower) - tolerance;
+            Number       origin_value = Number(origin);
+            if (double(origin_value) > origin)
+              origin_value =
+                std::nextafter(origin_value,
+                               std::numeric_limits<Number>::lowest());
+            coordinates[d].origin = double(origin_value);
+
+            const double max_upper = double(upper) + tolerance;
+            coordinates[d].spacing =
+              (max_upper - coordinates[d].origin) /
+              FixedPointCoordinate<Number>::max_value;
+            while (coordinates[d].decode(std::uint16_t(
+                     FixedPointCoordinate<Number>::max_value)) < max_upper)
+              coordinates[d].spacing =
+                std::nextafter(coordinates[d].spacing,
+                               std::numeric_limits<double>::max());
+          }
+      }
+
+    // Determine which boxes need to be sent and pack them:
+    std::vector<char> send_buffer;
+    if (compress)
+      for (const auto &coordinate : coordinates)
+        {
+          pack(send_buffer, coordinate.origin);
+          pack(send_buffer, coordinate.spacing);
+        }
+
+    const auto  &subdomain_ids = tria.get_true_subdomain_ids_of_cells();
+    unsigned int local_cell_n  = 0;
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        const auto cell_index = cell->active_cell_index();
+        if (subdomain_ids[cell_index] != this_proc)
+          continue;
+
+        AssertIndexRange(local_cell_n, local_active_cell_bboxes.size());
+        const auto &new_bbox = local_active_cell_bboxes[local_cell_n++];
+        const auto &old_bbox = global_active_cell_bboxes[cell_index];
+        bool        changed  = false;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            const double allowed_padding =
+              2.0 * (tolerance + (compress ? coordinates[d].spacing : 0.0));
+            changed =
+              changed || new_bbox.lower_bound(d) < old_bbox.lower_bound(d) ||
+              new_bbox.upper_bound(d) > old_bbox.upper_bound(d) ||
+              double(new_bbox.lower_bound(d)) -
+                  double(old_bbox.lower_bound(d)) >
+                allowed_padding ||
+              double(old_bbox.upper_bound(d)) -
+                  double(new_bbox.upper_bound(d)) >
+                allowed_padding;
+          }
+        if (!changed)
+          continue;
+
+        pack(send_buffer, static_cast<unsigned int>(cell_index));
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            const Number lower =
+              Number(double(new_bbox.lower_bound(d)) - tolerance);
+            const Number upper =
+              Number(double(new_bbox.upper_bound(d)) + tolerance);
+            if (compress)
+              {
+                pack(send_buffer, coordinates[d].encode_lower(lower));
+                pack(send_buffer, coordinates[d].encode_upper(upper));
+              }
+            else
+              {
+                pack(send_buffer, lower);
+                pack(send_buffer, upper);
+              }
+          }
+      }
+
+    // Exchange:
+    const int        n_procs = Utilities::MPI::n_mpi_processes(comm);
+    const int        n_bytes = static_cast<int>(send_buffer.size());
+    std::vector<int> bytes_per_proc(n_procs);
+
+    int ierr = MPI_Allgather(&n_bytes,
+                             1,
+                             MPI_INT,
+                             bytes_per_proc.data(),
+                             1,
+                             MPI_INT,
+                             comm);
+    AssertThrowMPI(ierr);
+
+    std::vector<int> offsets(n_procs + 1);
+    std::partial_sum(bytes_per_proc.begin(),
+                     bytes_per_proc.end(),
+                     offsets.begin() + 1);
+    std::vector<char> recv_buffer(offsets.back());
+    ierr = MPI_Allgatherv(send_buffer.data(),
+                          n_bytes,
+                          MPI_CHAR,
+                          recv_buffer.data(),
+                          bytes_per_proc.data(),
+                          offsets.data(),
+                          MPI_CHAR,
+                          comm);
+    AssertThrowMPI(ierr);
+
+    // Patch the global array:
+    for (int proc_n = 0; proc_n < n_procs; ++proc_n)
+      {
+        const char *ptr = recv_buffer.data() + offsets[proc_n];
+        const char *end = recv_buffer.data() + offsets[proc_n + 1];
+        std::array<FixedPointCoordinate<Number>, spacedim> proc_coordinates;
+        if (compress)
+          for (auto &coordinate : proc_coordinates)
+            {
+              coordinate.origin  = unpack<double>(ptr);
+              coordinate.spacing = unpack<double>(ptr);
+            }
+
+        while (ptr < end)
+          {
+            const auto cell_index = unpack<unsigned int>(ptr);
+            AssertIndexRange(cell_index, global_active_cell_bboxes.size());
+            auto &bbox = global_active_cell_bboxes[cell_index];
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                if (compress)
+                  {
+                    const auto &coordinate = proc_coordinates[d];
+                    bbox.get_boundary_points().first[d] =
+                      coordinate.decode(unpack<std::uint16_t>(ptr));
+                    bbox.get_boundary_points().second[d] =
+                      coordinate.decode(unpack<std::uint16_t>(ptr));
+                  }
+                else
+                  {
+                    bbox.get_boundary_points().first[d] = unpack<Number>(ptr);
+                    bbox.get_boundary_points().second[d] = unpack<Number>(ptr);
+                  }
+              }
+          }
+        Assert(ptr == end, ExcFDLInternalError());
+      }
+  }
+
+  template <int dim, int spacedim, typename Number>
+  std::vector<std::pair<CellId, BoundingBox<spacedim, Number>>>
+  exchange_intersecting_active_cell_bboxes(
+    const Triangulation<dim, spacedim>               &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim>>         &local_patch_bboxes,
+    const MPI_Comm                                    communicator)
+  {
+    namespace bgi = boost::geometry::index;
+
+    // 1. Tell every processor where every patch is:
+    const std::vector<std::vector<BoundingBox<spacedim>>> all_patch_bboxes =
+      Utilities::MPI::all_gather(communicator, local_patch_bboxes);
+    std::vector<std::pair<BoundingBox<spacedim>, unsigned int>>
+      patch_bboxes_and_ranks;
+    for (unsigned int rank = 0; rank < all_patch_bboxes.size(); ++rank)
+      for (const auto &bbox : all_patch_bboxes[rank])
+        patch_bboxes_and_ranks.emplace_back(bbox, rank);
+    const auto rtree = pack_rtree(patch_bboxes_and_ranks);
+
+    // 2. Send each locally owned cell's bbox to the owners of the patches it
+    // intersects:
+    std::map<unsigned int,
+             std::vector<std::pair<CellId, BoundingBox<spacedim, Number>>>>
+                              bboxes_to_send;
+    std::vector<unsigned int> ranks;
+    const auto                add_rank =
+      [&](const std::pair<BoundingBox<spacedim>, unsigned int> &pair)
+    { ranks.push_back(pair.second); };
+    std::size_t local_cell_n = 0;
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          AssertIndexRange(local_cell_n, local_active_cell_bboxes.size());
+          const auto &cell_bbox = local_active_cell_bboxes[local_cell_n];
+          ++local_cell_n;
+          // Number may be float, so convert before querying
+          BoundingBox<spacedim> query_bbox;
+          query_bbox.get_boundary_points() = cell_bbox.get_boundary_points();
+
+          ranks.clear();
+          rtree.query(bgi::intersects(query_bbox),
+                      boost::make_function_output_iterator(add_rank));
+          std::sort(ranks.begin(), ranks.end());
+          ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+          for (const auto rank : ranks)
+            bboxes_to_send[rank].emplace_back(cell->id(), cell_bbox);
+        }
+    Assert(local_cell_n == local_active_cell_bboxes.size(),
+           ExcMessage("There should be a local bbox for each local active "
+                      "cell"));
+
+    // 3. Collect what we received:
+    const auto received_bboxes =
+      Utilities::MPI::some_to_some(communicator, bboxes_to_send);
+    std::vector<std::pair<CellId, BoundingBox<spacedim, Number>>> result;
+    for (const auto &pair : received_bboxes)
+      result.insert(result.end(), pair.second.begin(), pair.second.end());
+    std::sort(result.begin(),
+              result.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    return result;
+  }
+
   template <int spacedim>
   BoundingBox<spacedim>
   box_to_bbox(
@@ -279,6 +1114,143 @@ namespace fdl
     return BoundingBox<spacedim>(result);
   }
 
+  template <int spacedim>
+  void
+  extend_boundary_bboxes(
+    std::vector<BoundingBox<spacedim>>                  &bboxes,
+    const tbox::Pointer<hier::BasePatchLevel<spacedim>> &base_patch_level,
+    const double                                         width)
+  {
+    const tbox::Pointer<hier::PatchLevel<spacedim>> patch_level =
+      base_patch_level;
+    AssertThrow(patch_level, ExcFDLNotImplemented());
+    const tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geom =
+      patch_level->getGridGeometry();
+    AssertThrow(grid_geom, ExcFDLNotImplemented());
+
+    const auto ratio = patch_level->getRatio();
+    for (auto &bbox : bboxes)
+      {
+        auto &points = bbox.get_boundary_points();
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            // Faces on the boundary are only equal to it up to roundoff
+            const double tolerance = 0.5 * grid_geom->getDx()[d] / ratio(d);
+            if (points.first[d] <= grid_geom->getXLower()[d] + tolerance)
+              points.first[d] -= width;
+            if (points.second[d] >= grid_geom->getXUpper()[d] - tolerance)
+              points.second[d] += width;
+          }
+      }
+  }
+
+  template <int spacedim>
+  void
+  compute_cell_indices(const ArrayView<const double> &points,
+                       const double *const            x_lower,
+                       const double *const            x_upper,
+                       const double *const            dx,
+                       const hier::Box<spacedim>     &box,
+                       std::vector<int>              &indices)
+  {
+    Assert(points.size() % spacedim == 0,
+           ExcMessage("There should be N * spacedim coordinates."));
+    const std::size_t n_points = points.size() / spacedim;
+    indices.resize(points.size());
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        // Like IBTK, compute the index relative to the closer corner to
+        // minimize roundoff errors
+        const double x_l         = x_lower[d];
+        const double x_u         = x_upper[d];
+        const double h           = dx[d];
+        const int    index_lower = box.lower()(d);
+        const int    index_upper = box.upper()(d) + 1;
+        for (std::size_t point_n = 0; point_n < n_points; ++point_n)
+          {
+            const double x        = points[point_n * spacedim + d];
+            const double dx_lower = x - x_l;
+            const double dx_upper = x - x_u;
+            const int    from_lower =
+              index_lower + int(std::floor(dx_lower / h));
+            const int from_upper =
+              index_upper + int(std::floor(dx_upper / h));
+            indices[point_n * spacedim + d] =
+              std::abs(dx_lower) <= std::abs(dx_upper) ? from_lower :
+                                                         from_upper;
+          }
+      }
+  }
+
+  template <int spacedim>
+  void
+  compute_cell_indices(const ArrayView<const double>              &points,
+                       const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                       std::vector<int>                           &indices)
+  {
+    const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+      patch->getPatchGeometry();
+    Assert(pgeom, ExcFDLInternalError());
+    compute_cell_indices(points,
+                         pgeom->getXLower(),
+                         pgeom->getXUpper(),
+                         pgeom->getDx(),
+                         patch->getBox(),
+                         indices);
+  }
+
+  template <int spacedim>
+  void
+  contains(const hier::Box<spacedim>  &box,
+           const std::vector<int>     &indices,
+           std::vector<unsigned char> &result)
+  {
+    Assert(indices.size() % spacedim == 0,
+           ExcMessage("There should be N * spacedim indices."));
+    const std::size_t n_points = indices.size() / spacedim;
+    result.assign(n_points, 1);
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        const int lower = box.lower()(d);
+        const int upper = box.upper()(d);
+        for (std::size_t point_n = 0; point_n < n_points; ++point_n)
+          {
+            const int index = indices[point_n * spacedim + d];
+            result[point_n] &= (lower <= index) & (index <= upper);
+          }
+      }
+  }
+
+  template <int spacedim>
+  void
+  contains(const BoundingBox<spacedim>   &bbox,
+           const ArrayView<const double> &points,
+           std::vector<unsigned char>    &result,
+           const bool                     half_open)
+  {
+    Assert(points.size() % spacedim == 0,
+           ExcMessage("There should be N * spacedim coordinates."));
+    const std::size_t n_points = points.size() / spacedim;
+    result.assign(n_points, 1);
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        const double lower = bbox.lower_bound(d);
+        const double upper = bbox.upper_bound(d);
+        if (half_open)
+          for (std::size_t point_n = 0; point_n < n_points; ++point_n)
+            {
+              const double x = points[point_n * spacedim + d];
+              result[point_n] &= (lower <= x) & (x < upper);
+            }
+        else
+          for (std::size_t point_n = 0; point_n < n_points; ++point_n)
+            {
+              const double x = points[point_n * spacedim + d];
+              result[point_n] &= (lower <= x) & (x <= upper);
+            }
+      }
+  }
+
   // these depend on SAMRAI types, and SAMRAI only has 2D and 3D libraries, so
   // use whatever IBTK is using
 
@@ -318,6 +1290,105 @@ namespace fdl
   compute_cell_bboxes(const DoFHandler<NDIM, NDIM> &dof_handler,
                       const Mapping<NDIM, NDIM>    &mapping);
 
+  // compute_cell_bboxes_and_longest_edge_lengths:
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+    const Mapping<NDIM - 1, NDIM>    &mapping);
+
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM> &dof_handler,
+    const Mapping<NDIM, NDIM>    &mapping);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+    const Mapping<NDIM - 1, NDIM>    &mapping);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM> &dof_handler,
+    const Mapping<NDIM, NDIM>    &mapping);
+
+  // compute_cell_point_bboxes_and_longest_edge_lengths:
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+    const Mapping<NDIM - 1, NDIM>    &mapping,
+    const Quadrature<NDIM - 1>       &quadrature);
+
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM> &dof_handler,
+    const Mapping<NDIM, NDIM>    &mapping,
+    const Quadrature<NDIM>       &quadrature);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+    const Mapping<NDIM - 1, NDIM>    &mapping,
+    const Quadrature<NDIM - 1>       &quadrature);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM> &dof_handler,
+    const Mapping<NDIM, NDIM>    &mapping,
+    const Quadrature<NDIM>       &quadrature);
+
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+    const Mapping<NDIM - 1, NDIM>    &mapping,
+    const Quadrature<NDIM - 1>       &quadrature,
+    std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+      support_point_geometry);
+
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM> &dof_handler,
+    const Mapping<NDIM, NDIM>    &mapping,
+    const Quadrature<NDIM>       &quadrature,
+    std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+      support_point_geometry);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+    const Mapping<NDIM - 1, NDIM>    &mapping,
+    const Quadrature<NDIM - 1>       &quadrature,
+    std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+      support_point_geometry);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_point_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM> &dof_handler,
+    const Mapping<NDIM, NDIM>    &mapping,
+    const Quadrature<NDIM>       &quadrature,
+    std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+      support_point_geometry);
+
+  // compute_cell_nodal_bboxes_and_longest_edge_lengths:
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_nodal_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM>                 &dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position);
+
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  compute_cell_nodal_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM>                     &dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_nodal_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM - 1, NDIM>                 &dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position);
+
+  template std::pair<std::vector<BoundingBox<NDIM, double>>, std::vector<float>>
+  compute_cell_nodal_bboxes_and_longest_edge_lengths(
+    const DoFHandler<NDIM, NDIM>                     &dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position);
+
   // collect_all_active_cell_bboxes:
   template std::vector<BoundingBox<NDIM, float>>
   collect_all_active_cell_bboxes(
@@ -339,7 +1410,127 @@ namespace fdl
     const parallel::shared::Triangulation<NDIM, NDIM> &tria,
     const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes);
 
+  // collect_all_active_cell_bboxes_and_lengths:
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  collect_all_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<float>                    &local_active_edge_lengths);
+
+  template std::pair<std::vector<BoundingBox<NDIM, float>>, std::vector<float>>
+  collect_all_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<float>                    &local_active_edge_lengths);
+
+  // collect_shared_active_cell_bboxes_and_lengths:
+  template std::pair<AlignedVector<BoundingBox<NDIM, float>>,
+                     AlignedVector<float>>
+  collect_shared_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<float>                    &local_active_edge_lengths);
+
+  template std::pair<AlignedVector<BoundingBox<NDIM, float>>,
+                     AlignedVector<float>>
+  collect_shared_active_cell_bboxes_and_lengths(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<float>                    &local_active_edge_lengths);
+
+  // update_all_active_cell_bboxes:
+  template void
+  update_all_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    std::vector<BoundingBox<NDIM, float>>       &global_active_cell_bboxes,
+    const double                                  tolerance,
+    const BoundingBoxEncoding                     encoding);
+
+  template void
+  update_all_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    std::vector<BoundingBox<NDIM, float>>       &global_active_cell_bboxes,
+    const double                                  tolerance,
+    const BoundingBoxEncoding                     encoding);
+
+  template void
+  update_all_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    std::vector<BoundingBox<NDIM, double>>       &global_active_cell_bboxes,
+    const double                                  tolerance,
+    const BoundingBoxEncoding                     encoding);
+
+  template void
+  update_all_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    std::vector<BoundingBox<NDIM, double>>       &global_active_cell_bboxes,
+    const double                                  tolerance,
+    const BoundingBoxEncoding                     encoding);
+
+  // exchange_intersecting_active_cell_bboxes:
+  template std::vector<std::pair<CellId, BoundingBox<NDIM, float>>>
+  exchange_intersecting_active_cell_bboxes(
+    const Triangulation<NDIM - 1, NDIM>         &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM>>        &local_patch_bboxes,
+    const MPI_Comm                               communicator);
+
+  template std::vector<std::pair<CellId, BoundingBox<NDIM, float>>>
+  exchange_intersecting_active_cell_bboxes(
+    const Triangulation<NDIM, NDIM>             &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM>>        &local_patch_bboxes,
+    const MPI_Comm                               communicator);
+
+  template std::vector<std::pair<CellId, BoundingBox<NDIM, double>>>
+  exchange_intersecting_active_cell_bboxes(
+    const Triangulation<NDIM - 1, NDIM>          &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM>>         &local_patch_bboxes,
+    const MPI_Comm                                communicator);
+
+  template std::vector<std::pair<CellId, BoundingBox<NDIM, double>>>
+  exchange_intersecting_active_cell_bboxes(
+    const Triangulation<NDIM, NDIM>              &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM>>         &local_patch_bboxes,
+    const MPI_Comm                                communicator);
+
   template BoundingBox<NDIM>
   box_to_bbox(const hier::Box<NDIM>                           &box,
               const tbox::Pointer<hier::BasePatchLevel<NDIM>> &patch_level);
+
+  template void
+  extend_boundary_bboxes(
+    std::vector<BoundingBox<NDIM>>                  &bboxes,
+    const tbox::Pointer<hier::BasePatchLevel<NDIM>> &patch_level,
+    const double                                     width);
+
+  template void
+  compute_cell_indices(const ArrayView<const double> &points,
+                       const double *const            x_lower,
+                       const double *const            x_upper,
+                       const double *const            dx,
+                       const hier::Box<NDIM>         &box,
+                       std::vector<int>              &indices);
+
+  template void
+  compute_cell_indices(const ArrayView<const double>          &points,
+                       const tbox::Pointer<hier::Patch<NDIM>> &patch,
+                       std::vector<int>                       &indices);
+
+  template void
+  contains(const hier::Box<NDIM>      &box,
+           const std::vector<int>     &indices,
+           std::vector<unsigned char> &result);
+
+  template void
+  contains(const BoundingBox<NDIM>       &bbox,
+           const ArrayView<const double> &points,
+           std::vector<unsigned char>    &result,
+           const bool                     half_open);
 } // namespace fdl
@@ -2,11 +2,15 @@
 
 #include <fiddle/grid/data_in.h>
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/point.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
 
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/la_parallel_block_vector.h>
@@ -17,13 +21,61 @@
 #  include <exodusII.h>
 #endif
 
+#include <fcntl.h>
+#include <mpi.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
 namespace fdl
 {
   using namespace dealii;
 
+  namespace internal
+  {
+    /**
+     * Node numbers and permutations of all cells, computed by
+     * compute_node_permutation().
+     */
+    struct NodePermutation
+    {
+      /**
+       * Offsets into the following two arrays for each cell.
+       */
+      std::vector<std::size_t> cell_offsets;
+
+      /**
+       * ExodusII node numbers (indexed from zero) of each cell.
+       */
+      std::vector<unsigned int> cell_nodes;
+
+      /**
+       * Permutation from ExodusII node numbers to deal.II node numbers on each
+       * cell.
+       */
+      std::vector<unsigned int> cell_permutations;
+
+      /**
+       * Type of each cell.
+       */
+      std::vector<ReferenceCell> cell_types;
+    };
+  } // namespace internal
+
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
   namespace
   {
+    using internal::NodePermutation;
+
     ReferenceCell
     exodusii_name_to_type(const std::string &type_name,
                           const int          n_nodes_per_element)
@@ -290,14 +342,81 @@ namespace fdl
         }
     }
 
-    template <int dim, int spacedim, typename VectorType>
+    /**
+     * Broadcast an array from the root processor to all other processors.
+     */
+    template <typename T>
     void
-    read_nodal_components(const int                        ex_id,
-                          const std::vector<std::string>  &variable_names,
-                          const int                        time_step_n,
-                          const DoFHandler<dim, spacedim> &dof_handler,
-                          const std::vector<unsigned int> &components,
-                          VectorType                      &dof_vector)
+    broadcast_array(std::vector<T> &array, const MPI_Comm &comm)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "The array is sent as bytes");
+      std::uint64_t size = array.size();
+      int           ierr = MPI_Bcast(&size, 1, MPI_UINT64_T, 0, comm);
+      AssertThrowMPI(ierr);
+      array.resize(size);
+
+      // MPI uses int for counts so send large arrays in pieces
+      const std::size_t max_chunk_size = std::numeric_limits<int>::max();
+      const std::size_t n_bytes        = size * sizeof(T);
+      char             *bytes          = reinterpret_cast<char *>(array.data());
+      for (std::size_t offset = 0; offset < n_bytes; offset += max_chunk_size)
+        {
+          const std::size_t chunk_size =
+            std::min(max_chunk_size, n_bytes - offset);
+          ierr = MPI_Bcast(bytes + offset, int(chunk_size), MPI_BYTE, 0, comm);
+          AssertThrowMPI(ierr);
+        }
+    }
+
+    /**
+     * Open an ExodusII file on the root processor of @p comm. Returns the
+     * ExodusII id on the root processor and -1 on all other processors.
+     *
+     * Even on a small number of processors, having every processor open the
+     * same file puts a lot of load on the file system, so we read all data on
+     * the root processor and then broadcast it.
+     */
+    int
+    open_exodus_file(const std::string &filename, const MPI_Comm &comm)
+    {
+      int ex_id = -1;
+      if (Utilities::MPI::this_mpi_process(comm) == 0)
+        {
+          // deal.II always uses double precision numbers for geometry
+          int component_word_size = sizeof(double);
+          // setting to zero uses the stored word size
+          int   floating_point_word_size = 0;
+          float ex_version               = 0.0;
+
+          ex_id = ex_open(filename.c_str(),
+                          EX_READ,
+                          &component_word_size,
+                          &floating_point_word_size,
+                          &ex_version);
+          AssertThrow(ex_id <= 0 ||
+                        floating_point_word_size == component_word_size,
+                      ExcFDLNotImplemented());
+        }
+      // Check on all processors to avoid deadlocks
+      const int opened = Utilities::MPI::max(int(ex_id > 0), comm);
+      AssertThrow(opened == 1,
+                  ExcMessage(
+                    "ExodusII failed to open the specified input file."));
+
+      return ex_id;
+    }
+
+    /**
+     * Compute, for every cell, the ExodusII node numbers and the permutation
+     * from ExodusII node numbers to deal.II node numbers. This is independent
+     * of the variable being read, so it can be reused for every nodal
+     * variable and time step.
+     */
+    template <int dim, int spacedim>
+    NodePermutation
+    compute_node_permutation(const int                           ex_id,
+                             const Triangulation<dim, spacedim> &tria)
     {
       // Read basic mesh information:
       std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
@@ -324,233 +443,220 @@ namespace fdl
       ierr = ex_get_ids(ex_id, EX_ELEM_BLOCK, element_block_ids.data());
       AssertThrowExodusII(ierr);
 
-
-      for (unsigned int component_n = 0; component_n < components.size();
-           ++component_n)
+      NodePermutation permutation;
+      permutation.cell_offsets.push_back(0);
+      auto cell = tria.begin_active();
+      for (const int element_block_id : element_block_ids)
         {
-          // Permit writing into unghosted vectors by doing a check first
-          const IndexSet index_set = dof_vector.locally_owned_elements();
+          std::fill(cell_kind_name.begin(), cell_kind_name.end(), '\0');
+          int n_block_elements         = 0;
+          int n_nodes_per_element      = 0;
+          int n_edges_per_element      = 0;
+          int n_faces_per_element      = 0;
+          int n_attributes_per_element = 0;
+
+          // Extract element data:
+          ierr = ex_get_block(ex_id,
+                              EX_ELEM_BLOCK,
+                              element_block_id,
+                              cell_kind_name.data(),
+                              &n_block_elements,
+                              &n_nodes_per_element,
+                              &n_edges_per_element,
+                              &n_faces_per_element,
+                              &n_attributes_per_element);
+          AssertThrowExodusII(ierr);
 
-          const int var_index =
-            get_variable_index(ex_id, EX_NODAL, variable_names[component_n]);
-          // This array could potentially be massive. Try to minimize total
-          // memory usage by not loading each component nodal value array at
-          // once.
-          std::vector<double> nodal_values(n_nodes);
-          ierr = ex_get_var(ex_id,
-                            time_step_n,
-                            EX_NODAL,
-                            var_index,
-                            1,
-                            n_nodes,
-                            nodal_values.data());
+          const ReferenceCell type =
+            exodusii_name_to_type(cell_kind_name.data(), n_nodes_per_element);
+
+          const std::size_t connection_size =
+            n_nodes_per_element * n_block_elements;
+          // TODO we can support 64-bit indices here - use
+          //
+          // k = ex_inquire_int(ex_id, EX_INQ_DB_MAX_USED_NAME_LENGTH); and
+          // ex_set_max_name_length(ex_id, k);
+          std::vector<int> connection(connection_size);
+          ierr = ex_get_conn(ex_id,
+                             EX_ELEM_BLOCK,
+                             element_block_id,
+                             connection.data(),
+                             nullptr,
+                             nullptr);
           AssertThrowExodusII(ierr);
 
-          auto cell = dof_handler.begin_active();
-          for (const int element_block_id : element_block_ids)
+          for (std::size_t node_n = 0; node_n < connection_size;
+               node_n += n_nodes_per_element)
             {
-              std::fill(cell_kind_name.begin(), cell_kind_name.end(), '\0');
-              int n_block_elements         = 0;
-              int n_nodes_per_element      = 0;
-              int n_edges_per_element      = 0;
-              int n_faces_per_element      = 0;
-              int n_attributes_per_element = 0;
-
-              // Extract element data:
-              ierr = ex_get_block(ex_id,
-                                  EX_ELEM_BLOCK,
-                                  element_block_id,
-                                  cell_kind_name.data(),
-                                  &n_block_elements,
-                                  &n_nodes_per_element,
-                                  &n_edges_per_element,
-                                  &n_faces_per_element,
-                                  &n_attributes_per_element);
-              AssertThrowExodusII(ierr);
-
-              const ReferenceCell type =
-                exodusii_name_to_type(cell_kind_name.data(),
-                                      n_nodes_per_element);
-              AssertThrowExodusII(ierr);
-
-              const std::size_t connection_size =
-                n_nodes_per_element * n_block_elements;
-              // TODO we can support 64-bit indices here - use
-              //
-              // k = ex_inquire_int(ex_id, EX_INQ_DB_MAX_USED_NAME_LENGTH); and
-              // ex_set_max_name_length(ex_id, k);
-              std::vector<int> connection(connection_size);
-              ierr = ex_get_conn(ex_id,
-                                 EX_ELEM_BLOCK,
-                                 element_block_id,
-                                 connection.data(),
-                                 nullptr,
-                                 nullptr);
-              AssertThrowExodusII(ierr);
-
-              std::vector<types::global_dof_index> cell_dofs;
-              std::vector<double>       cell_values(n_nodes_per_element);
-              std::vector<unsigned int> exodus_cell_node_ns(
-                n_nodes_per_element);
-              std::vector<unsigned int> local_exodus_to_deal(
-                n_nodes_per_element);
-              for (std::size_t node_n = 0; node_n < connection_size;
-                   node_n += n_nodes_per_element)
-                {
-                  if (cell->is_locally_owned())
-                    {
-                      const FiniteElement<dim, spacedim> &fe = cell->get_fe();
-                      cell_dofs.resize(fe.n_dofs_per_cell());
-                      cell->get_dof_indices(cell_dofs);
-                      std::copy_n(connection.begin() + node_n,
-                                  n_nodes_per_element,
-                                  exodus_cell_node_ns.begin());
-                      for (auto &node_n : exodus_cell_node_ns)
-                        node_n -= 1;
-                      std::fill(local_exodus_to_deal.begin(),
-                                local_exodus_to_deal.end(),
-                                numbers::invalid_unsigned_int);
-                      for (int i = 0; i < n_nodes_per_element; ++i)
-                        cell_values[i] = nodal_values[exodus_cell_node_ns[i]];
-
-                      // At this point (due to renumbering, reorientation, etc)
-                      // we are not guaranteed that the node numbers match the
-                      // vertex numbers. Hence we reestablish the numbering
-                      // based on vertex equality.
-                      for (const auto i : type.vertex_indices())
-                        for (const auto j : type.vertex_indices())
-                          if (vertices[exodus_cell_node_ns[i]] ==
-                              cell->vertex(j))
-                            local_exodus_to_deal[i] = j;
-
-                      permute_values(type,
-                                     n_nodes_per_element,
-                                     local_exodus_to_deal,
-                                     cell_values);
-
-                      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
-                        {
-                          const auto pair = fe.system_to_component_index(i);
-                          if (pair.first == component_n &&
-                              index_set.is_element(cell_dofs[i]))
-                            dof_vector[cell_dofs[i]] = cell_values[pair.second];
-                        }
-                    }
-                  ++cell;
-                }
+              const std::size_t offset = permutation.cell_offsets.back();
+              for (int i = 0; i < n_nodes_per_element; ++i)
+                permutation.cell_nodes.push_back(connection[node_n + i] - 1);
+              permutation.cell_permutations.resize(
+                offset + n_nodes_per_element, numbers::invalid_unsigned_int);
+
+              // At this point (due to renumbering, reorientation, etc) we are
+              // not guaranteed that the node numbers match the vertex numbers.
+              // Hence we reestablish the numbering based on vertex equality.
+              for (const auto i : type.vertex_indices())
+                for (const auto j : type.vertex_indices())
+                  if (vertices[permutation.cell_nodes[offset + i]] ==
+                      cell->vertex(j))
+                    permutation.cell_permutations[offset + i] = j;
+
+              permutation.cell_offsets.push_back(offset + n_nodes_per_element);
+              permutation.cell_types.push_back(type);
+              ++cell;
             }
         }
+      AssertDimension(permutation.cell_types.size(), tria.n_active_cells());
+
+      return permutation;
     }
-  } // namespace
-#endif
 
-  template <int dim, int spacedim, typename VectorType>
-  void
-  read_elemental_data(const std::string                  &filename,
-                      const Triangulation<dim, spacedim> &tria,
-                      const int                           time_step_n,
-                      const std::string                  &variable_name,
-                      VectorType                         &cell_vector)
-  {
-    AssertDimension(cell_vector.size(), tria.n_active_cells());
-    Assert(tria.n_levels() == 1,
-           ExcMessage("This function can only be called on unrefined grids."));
-    // According to circa line 2400 of tria.cc, the cells of a Triangulation
-    // have the same order of the input file - hence we can just load data
-    // into a serial vector and copy that straight over to a parallel deal.II
-    // vector.
-#ifdef DEAL_II_TRILINOS_WITH_SEACAS
-    // deal.II always uses double precision numbers for geometry
-    int component_word_size = sizeof(double);
-    // setting to zero uses the stored word size
-    int   floating_point_word_size = 0;
-    float ex_version               = 0.0;
-
-    const int ex_id = ex_open(filename.c_str(),
-                              EX_READ,
-                              &component_word_size,
-                              &floating_point_word_size,
-                              &ex_version);
-    AssertThrow(floating_point_word_size == component_word_size,
-                ExcFDLNotImplemented());
-    AssertThrow(ex_id > 0,
-                ExcMessage(
-                  "ExodusII failed to open the specified input file."));
-
-    // Read basic mesh information:
-    std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
-    int               mesh_dimension   = 0;
-    int               n_nodes          = 0;
-    int               n_elements       = 0;
-    int               n_element_blocks = 0;
-    int               n_node_sets      = 0;
-    int               n_side_sets      = 0;
-
-    int ierr = ex_get_init(ex_id,
-                           cell_kind_name.data(),
-                           &mesh_dimension,
-                           &n_nodes,
-                           &n_elements,
-                           &n_element_blocks,
-                           &n_node_sets,
-                           &n_side_sets);
-    AssertThrowExodusII(ierr);
-    AssertDimension(mesh_dimension, spacedim);
+    /**
+     * Read the values of a nodal variable at the nodes of each cell, in
+     * deal.II order. The result is indexed in the same way as
+     * NodePermutation::cell_nodes.
+     */
+    std::vector<double>
+    read_nodal_cell_values(const int              ex_id,
+                           const NodePermutation &permutation,
+                           const std::string     &variable_name,
+                           const int              time_step_n)
+    {
+      const int var_index = get_variable_index(ex_id, EX_NODAL, variable_name);
+      const int n_nodes = ex_inquire_int(ex_id, EX_INQ_NODES);
+      // This array could potentially be massive. Try to minimize total memory
+      // usage by not loading each component nodal value array at once.
+      std::vector<double> nodal_values(n_nodes);
+      const int ierr = ex_get_var(ex_id,
+                                  time_step_n,
+                                  EX_NODAL,
+                                  var_index,
+                                  1,
+                                  n_nodes,
+                                  nodal_values.data());
+      AssertThrowExodusII(ierr);
+
+      std::vector<double>       all_cell_values(permutation.cell_nodes.size());
+      std::vector<double>       cell_values;
+      std::vector<unsigned int> local_exodus_to_deal;
+      for (std::size_t cell_n = 0; cell_n < permutation.cell_types.size();
+           ++cell_n)
+        {
+          const std::size_t begin = permutation.cell_offsets[cell_n];
+          const std::size_t end   = permutation.cell_offsets[cell_n + 1];
+          cell_values.resize(end - begin);
+          for (std::size_t i = begin; i < end; ++i)
+            cell_values[i - begin] = nodal_values[permutation.cell_nodes[i]];
+          // permute_values() overwrites the permutation
+          local_exodus_to_deal.assign(
+            permutation.cell_permutations.begin() + begin,
+            permutation.cell_permutations.begin() + end);
+          permute_values(permutation.cell_types[cell_n],
+                         int(end - begin),
+                         local_exodus_to_deal,
+                         cell_values);
+          std::copy(cell_values.begin(),
+                    cell_values.end(),
+                    all_cell_values.begin() + begin);
+        }
+
+      return all_cell_values;
+    }
+
+    /**
+     * Read the values of an elemental variable on each cell. Sets
+     * @p centers_match to false if the cell centers computed by ExodusII and
+     * deal.II do not match.
+     */
+    template <int dim, int spacedim>
+    std::vector<double>
+    read_element_values(const int                           ex_id,
+                        const Triangulation<dim, spacedim> &tria,
+                        const int                           time_step_n,
+                        const std::string                  &variable_name,
+                        bool                               &centers_match)
+    {
+      // Read basic mesh information:
+      std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
+      int               mesh_dimension   = 0;
+      int               n_nodes          = 0;
+      int               n_elements       = 0;
+      int               n_element_blocks = 0;
+      int               n_node_sets      = 0;
+      int               n_side_sets      = 0;
+
+      int ierr = ex_get_init(ex_id,
+                             cell_kind_name.data(),
+                             &mesh_dimension,
+                             &n_nodes,
+                             &n_elements,
+                             &n_element_blocks,
+                             &n_node_sets,
+                             &n_side_sets);
+      AssertThrowExodusII(ierr);
+      AssertDimension(mesh_dimension, spacedim);
 
 #  define CHECK_CENTERS 1
 #  ifdef CHECK_CENTERS
-    const auto vertices = read_vertices<spacedim>(ex_id, n_nodes);
+      const auto vertices = read_vertices<spacedim>(ex_id, n_nodes);
 #  endif
 
-    std::vector<int> element_block_ids(n_element_blocks);
-    ierr = ex_get_ids(ex_id, EX_ELEM_BLOCK, element_block_ids.data());
-    AssertThrowExodusII(ierr);
+      std::vector<int> element_block_ids(n_element_blocks);
+      ierr = ex_get_ids(ex_id, EX_ELEM_BLOCK, element_block_ids.data());
+      AssertThrowExodusII(ierr);
+
+      std::vector<double> element_values;
+      element_values.reserve(tria.n_active_cells());
+      auto deal_cell = tria.begin_active();
+      for (const int element_block_id : element_block_ids)
+        {
+          std::fill(cell_kind_name.begin(), cell_kind_name.end(), '\0');
+          int n_block_elements         = 0;
+          int n_nodes_per_element      = 0;
+          int n_edges_per_element      = 0;
+          int n_faces_per_element      = 0;
+          int n_attributes_per_element = 0;
+
+          // Extract element data:
+          ierr = ex_get_block(ex_id,
+                              EX_ELEM_BLOCK,
+                              element_block_id,
+                              cell_kind_name.data(),
+                              &n_block_elements,
+                              &n_nodes_per_element,
+                              &n_edges_per_element,
+                              &n_faces_per_element,
+                              &n_attributes_per_element);
+          AssertThrowExodusII(ierr);
 
-    auto deal_cell = tria.begin_active();
-    for (const int element_block_id : element_block_ids)
-      {
-        std::fill(cell_kind_name.begin(), cell_kind_name.end(), '\0');
-        int n_block_elements         = 0;
-        int n_nodes_per_element      = 0;
-        int n_edges_per_element      = 0;
-        int n_faces_per_element      = 0;
-        int n_attributes_per_element = 0;
-
-        // Extract element data:
-        ierr = ex_get_block(ex_id,
+          const ReferenceCell type =
+            exodusii_name_to_type(cell_kind_name.data(), n_nodes_per_element);
+          // The number of nodes per element may be larger than what we want
+          // to read - for example, if the Exodus file contains a QUAD9
+          // element, we only want to read the first four values and ignore
+          // the rest.
+          Assert(int(type.n_vertices()) <= n_nodes_per_element,
+                 ExcInternalError());
+
+          const int var_index =
+            get_variable_index(ex_id, EX_ELEM_BLOCK, variable_name);
+
+          // Extract elementwise data:
+          std::vector<double> block_element_values(n_block_elements);
+          ierr = ex_get_var(ex_id,
+                            time_step_n,
                             EX_ELEM_BLOCK,
+                            var_index,
                             element_block_id,
-                            cell_kind_name.data(),
-                            &n_block_elements,
-                            &n_nodes_per_element,
-                            &n_edges_per_element,
-                            &n_faces_per_element,
-                            &n_attributes_per_element);
-        AssertThrowExodusII(ierr);
-
-        const ReferenceCell type =
-          exodusii_name_to_type(cell_kind_name.data(), n_nodes_per_element);
-        // The number of nodes per element may be larger than what we want to
-        // read - for example, if the Exodus file contains a QUAD9 element, we
-        // only want to read the first four values and ignore the rest.
-        Assert(int(type.n_vertices()) <= n_nodes_per_element,
-               ExcInternalError());
-
-        const int var_index =
-          get_variable_index(ex_id, EX_ELEM_BLOCK, variable_name);
-
-        // Extract elementwise data:
-        std::vector<double> block_element_values(n_block_elements);
-        ierr = ex_get_var(ex_id,
-                          time_step_n,
-                          EX_ELEM_BLOCK,
-                          var_index,
-                          element_block_id,
-                          n_block_elements,
-                          block_element_values.data());
-        AssertThrowExodusII(ierr);
+                            n_block_elements,
+                            block_element_values.data());
+          AssertThrowExodusII(ierr);
+          element_values.insert(element_values.end(),
+                                block_element_values.begin(),
+                                block_element_values.end());
 
-        {
           const std::size_t connection_size =
             n_nodes_per_element * n_block_elements;
 #  if CHECK_CENTERS
@@ -564,48 +670,445 @@ namespace fdl
           AssertThrowExodusII(ierr);
 #  endif
 
+          // Since the Triangulation is not refined every processor stores
+          // every cell, so we can check all of them here
           for (std::size_t node_n = 0; node_n < connection_size;
                node_n += n_nodes_per_element)
             {
-              if (deal_cell->is_locally_owned())
-                {
 #  if CHECK_CENTERS
-                  CellData<dim> exodus_cell(type.n_vertices());
-                  for (unsigned int i : type.vertex_indices())
-                    exodus_cell
-                      .vertices[type.exodusii_vertex_to_deal_vertex(i)] =
-                      connection[node_n + i] - 1;
-
-                  Point<spacedim> exodus_center;
-                  for (const auto index : exodus_cell.vertices)
-                    exodus_center += vertices[index];
-                  exodus_center /= type.n_vertices();
-
-                  const Point<spacedim> deal_center = deal_cell->center();
-                  AssertThrow(
-                    (deal_center - exodus_center).norm() < 1e-10,
-                    ExcMessage(
-                      "The deal.II and ExodusII centers should be the same."));
+              CellData<dim> exodus_cell(type.n_vertices());
+              for (unsigned int i : type.vertex_indices())
+                exodus_cell.vertices[type.exodusii_vertex_to_deal_vertex(i)] =
+                  connection[node_n + i] - 1;
+
+              Point<spacedim> exodus_center;
+              for (const auto index : exodus_cell.vertices)
+                exodus_center += vertices[index];
+              exodus_center /= type.n_vertices();
+
+              const Point<spacedim> deal_center = deal_cell->center();
+              if ((deal_center - exodus_center).norm() >= 1e-10)
+                centers_match = false;
 #  endif
-                  cell_vector[deal_cell->active_cell_index()] =
-                    block_element_values[node_n / n_nodes_per_element];
-                }
               ++deal_cell;
             }
         }
+
+      return element_values;
+    }
+
+    /**
+     * Read the values of all DoFs on every cell, in the order given by the
+     * DoFHandler, into a single array. Here @p variable_names contains the
+     * name of the variable for each component. If necessary, @p permutation
+     * is computed (if it is empty) and then used for all nodal components.
+     */
+    template <int dim, int spacedim>
+    std::vector<double>
+    read_cell_dof_values(const int                        ex_id,
+                         const DoFHandler<dim, spacedim> &dof_handler,
+                         const int                        time_step_n,
+                         const std::vector<std::string>  &variable_names,
+                         NodePermutation                 &permutation,
+                         bool                            &centers_match)
+    {
+      const auto &tria = dof_handler.get_triangulation();
+      // Partition FEs into elemental and nodal parts. ExodusII does not
+      // support variables which have both elemental and nodal parts so we
+      // ignore that case. Hence we can examine just the first FE to set up the
+      // partitioning on all components.
+      const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+      AssertDimension(variable_names.size(), fe.n_components());
+      std::vector<bool>                is_elemental(fe.n_components());
+      std::vector<std::vector<double>> component_values(fe.n_components());
+      for (unsigned int component = 0; component < fe.n_components();
+           ++component)
+        {
+          const FiniteElement<dim, spacedim> &sub_fe =
+            fe.get_sub_fe(component, 1);
+          is_elemental[component] = sub_fe.tensor_degree() == 0;
+          if (is_elemental[component])
+            component_values[component] =
+              read_element_values(ex_id,
+                                  tria,
+                                  time_step_n,
+                                  variable_names[component],
+                                  centers_match);
+          else
+            {
+              if (permutation.cell_types.size() == 0)
+                permutation = compute_node_permutation(ex_id, tria);
+              component_values[component] =
+                read_nodal_cell_values(ex_id,
+                                       permutation,
+                                       variable_names[component],
+                                       time_step_n);
+            }
+        }
+
+      const unsigned int  n_dofs_per_cell = fe.n_dofs_per_cell();
+      std::vector<double> cell_dof_values(tria.n_active_cells() *
+                                          n_dofs_per_cell);
+      for (unsigned int cell_n = 0; cell_n < tria.n_active_cells(); ++cell_n)
+        for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+          {
+            const auto  pair   = fe.system_to_component_index(i);
+            const auto &values = component_values[pair.first];
+            cell_dof_values[cell_n * n_dofs_per_cell + i] =
+              is_elemental[pair.first] ?
+                values[cell_n] :
+                values[permutation.cell_offsets[cell_n] + pair.second];
+          }
+
+      return cell_dof_values;
+    }
+
+    /**
+     * Copy values computed by read_cell_dof_values() into a vector.
+     */
+    template <int dim, int spacedim, typename VectorType>
+    void
+    set_dof_values(const DoFHandler<dim, spacedim> &dof_handler,
+                   const double                    *cell_dof_values,
+                   VectorType                      &dof_vector)
+    {
+      // Permit writing into unghosted vectors by doing a check first
+      const IndexSet     index_set = dof_vector.locally_owned_elements();
+      const unsigned int n_dofs_per_cell =
+        dof_handler.get_fe().n_dofs_per_cell();
+      std::vector<types::global_dof_index> cell_dofs(n_dofs_per_cell);
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            cell->get_dof_indices(cell_dofs);
+            const double *values =
+              cell_dof_values + cell->active_cell_index() * n_dofs_per_cell;
+            for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+              if (index_set.is_element(cell_dofs[i]))
+                dof_vector[cell_dofs[i]] = values[i];
+          }
+    }
+
+    /**
+     * Header of a cached DoF data file. The header is followed by the values
+     * of each DoF on each cell, i.e., the array computed by
+     * read_cell_dof_values().
+     */
+    struct CacheHeader
+    {
+      char          magic[8];
+      std::uint64_t version;
+      std::uint64_t key;
+      std::uint64_t n_cells;
+      std::uint64_t n_dofs_per_cell;
+    };
+
+    constexpr char cache_magic[8] = {'F', 'D', 'L', 'D', 'O', 'F', 'S', '\0'};
+
+    constexpr std::uint64_t cache_version = 1;
+
+    /**
+     * FNV-1a hash of some bytes.
+     */
+    std::uint64_t
+    hash_bytes(const void *data, const std::size_t n_bytes, std::uint64_t hash)
+    {
+      const unsigned char *bytes = static_cast<const unsigned char *>(data);
+      for (std::size_t i = 0; i < n_bytes; ++i)
+        {
+          hash ^= bytes[i];
+          hash *= 1099511628211ull;
+        }
+      return hash;
+    }
+
+    /**
+     * Compute the key of a cache file. Since the values are stored per cell
+     * this only depends on the mesh, the finite element, and the data: it
+     * does not depend on the partitioning or the DoF numbering.
+     */
+    template <int dim, int spacedim>
+    std::uint64_t
+    compute_cache_key(const DoFHandler<dim, spacedim> &dof_handler,
+                      const int                        time_step_n,
+                      const std::vector<std::string>  &variable_names)
+    {
+      std::uint64_t hash = 14695981039346656037ull;
+      for (const auto &vertex : dof_handler.get_triangulation().get_vertices())
+        for (unsigned int d = 0; d < spacedim; ++d)
+          hash = hash_bytes(&vertex[d], sizeof(double), hash);
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        for (const auto v : cell->vertex_indices())
+          {
+            const unsigned int vertex_index = cell->vertex_index(v);
+            hash = hash_bytes(&vertex_index, sizeof(vertex_index), hash);
+          }
+      const std::string fe_name = dof_handler.get_fe().get_name();
+      hash = hash_bytes(fe_name.data(), fe_name.size() + 1, hash);
+      for (const std::string &name : variable_names)
+        hash = hash_bytes(name.data(), name.size() + 1, hash);
+      hash = hash_bytes(&time_step_n, sizeof(time_step_n), hash);
+
+      return hash;
+    }
+
+    /**
+     * Try to read DoF values from a cache file. Returns whether or not this
+     * succeeded. Only the entries of the locally owned cells are read from
+     * the mapped file.
+     */
+    template <int dim, int spacedim, typename VectorType>
+    bool
+    read_cache(const std::string               &cache_filename,
+               const std::uint64_t              key,
+               const DoFHandler<dim, spacedim> &dof_handler,
+               VectorType                      &dof_vector)
+    {
+      const int fd = open(cache_filename.c_str(), O_RDONLY);
+      if (fd < 0)
+        return false;
+
+      struct stat file_stat;
+      bool        success = fstat(fd, &file_stat) == 0 &&
+                     std::size_t(file_stat.st_size) >= sizeof(CacheHeader);
+      void *data = MAP_FAILED;
+      if (success)
+        data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      success = success && data != MAP_FAILED;
+      if (success)
+        {
+          CacheHeader header;
+          std::memcpy(&header, data, sizeof(header));
+          const std::uint64_t n_cells =
+            dof_handler.get_triangulation().n_active_cells();
+          const std::uint64_t n_dofs_per_cell =
+            dof_handler.get_fe().n_dofs_per_cell();
+          success =
+            std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) == 0 &&
+            header.version == cache_version && header.key == key &&
+            header.n_cells == n_cells &&
+            header.n_dofs_per_cell == n_dofs_per_cell &&
+            std::size_t(file_stat.st_size) ==
+              sizeof(CacheHeader) + n_cells * n_dofs_per_cell * sizeof(double);
+          if (success)
+            set_dof_values(dof_handler,
+                           reinterpret_cast<const double *>(
+                             static_cast<const char *>(data) +
+                             sizeof(CacheHeader)),
+                           dof_vector);
+          munmap(data, file_stat.st_size);
+        }
+      close(fd);
+
+      return success;
+    }
+
+    /**
+     * Write a cache file. To avoid leaving partially written files, the data
+     * is first written to a temporary file which is then renamed.
+     */
+    void
+    write_cache(const std::string         &cache_filename,
+                const std::uint64_t        key,
+                const std::uint64_t        n_cells,
+                const std::uint64_t        n_dofs_per_cell,
+                const std::vector<double> &cell_dof_values)
+    {
+      AssertDimension(cell_dof_values.size(), n_cells * n_dofs_per_cell);
+      CacheHeader header;
+      std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+      header.version         = cache_version;
+      header.key             = key;
+      header.n_cells         = n_cells;
+      header.n_dofs_per_cell = n_dofs_per_cell;
+
+      const std::string temporary_filename = cache_filename + ".tmp";
+      {
+        std::ofstream out(temporary_filename, std::ios::binary);
+        AssertThrow(out, ExcFileNotOpen(temporary_filename));
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(cell_dof_values.data()),
+                  cell_dof_values.size() * sizeof(double));
+        AssertThrow(out, ExcIO());
       }
+      const int ierr =
+        std::rename(temporary_filename.c_str(), cache_filename.c_str());
+      AssertThrow(ierr == 0, ExcIO());
+    }
+
+    /**
+     * Append @p cells to @p data as the number of cells followed by, for each
+     * cell, the number of vertices, the vertices, the material (or boundary)
+     * id, and the manifold id.
+     */
+    template <int structdim>
+    void
+    pack_cell_data(const std::vector<CellData<structdim>> &cells,
+                   std::vector<unsigned int>              &data)
+    {
+      data.push_back(cells.size());
+      for (const CellData<structdim> &cell : cells)
+        {
+          data.push_back(cell.vertices.size());
+          data.insert(data.end(), cell.vertices.begin(), cell.vertices.end());
+          data.push_back(cell.material_id);
+          data.push_back(cell.manifold_id);
+        }
+    }
+
+    /**
+     * Inverse of pack_cell_data(), starting at @p offset. Afterwards
+     * @p offset is the index of the first entry after the cells.
+     */
+    template <int structdim>
+    std::vector<CellData<structdim>>
+    unpack_cell_data(const std::vector<unsigned int> &data, std::size_t &offset)
+    {
+      std::vector<CellData<structdim>> cells(data[offset++]);
+      for (CellData<structdim> &cell : cells)
+        {
+          cell.vertices.resize(data[offset++]);
+          for (unsigned int &vertex : cell.vertices)
+            vertex = data[offset++];
+          cell.material_id = data[offset++];
+          cell.manifold_id = data[offset++];
+        }
+      return cells;
+    }
+  } // namespace
+#endif
+
+  template <int dim, int spacedim>
+  ExodusIIMeshData<spacedim>
+  read_exodusii_mesh(const std::string            &filename,
+                     Triangulation<dim, spacedim> &tria,
+                     const std::vector<int>       &nodeset_ids,
+                     const bool apply_all_indicators_to_manifolds)
+  {
+    ExodusIIMeshData<spacedim> result;
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    AssertThrow(tria.n_cells() == 0,
+                ExcMessage("The triangulation should be empty."));
+    const MPI_Comm comm    = tria.get_communicator();
+    const bool     is_root = Utilities::MPI::this_mpi_process(comm) == 0;
+
+    // Everything is sent as one array of coordinates and one array of
+    // integers: vertices, cells, boundary lines, boundary quads, sideset ids,
+    // and then nodesets.
+    std::vector<double>       vertex_coordinates;
+    std::vector<unsigned int> integer_data;
+    const int                 ex_id = open_exodus_file(filename, comm);
+    if (is_root)
+      {
+        Triangulation<dim, spacedim> serial_tria;
+        GridIn<dim, spacedim>        grid_in(serial_tria);
+        const auto                   exodusii_data =
+          grid_in.read_exodusii(filename, apply_all_indicators_to_manifolds);
+        const auto description =
+          GridTools::get_coarse_mesh_description(serial_tria);
+
+        for (const Point<spacedim> &vertex : std::get<0>(description))
+          for (unsigned int d = 0; d < spacedim; ++d)
+            vertex_coordinates.push_back(vertex[d]);
+        pack_cell_data(std::get<1>(description), integer_data);
+        pack_cell_data(std::get<2>(description).boundary_lines, integer_data);
+        pack_cell_data(std::get<2>(description).boundary_quads, integer_data);
+
+        integer_data.push_back(exodusii_data.id_to_sideset_ids.size());
+        for (const std::vector<int> &sideset_ids :
+             exodusii_data.id_to_sideset_ids)
+          {
+            integer_data.push_back(sideset_ids.size());
+            integer_data.insert(integer_data.end(),
+                                sideset_ids.begin(),
+                                sideset_ids.end());
+          }
 
-    ierr = ex_close(ex_id);
-    AssertThrowExodusII(ierr);
+        // Nodesets are stored as vertex numbers: their coordinates are
+        // already known
+        for (const int nodeset_id : nodeset_ids)
+          {
+            int n_nodeset_nodes = 0;
+            int n_dist_fact     = 0; // not used
+            int ierr            = ex_get_set_param(
+              ex_id, EX_NODE_SET, nodeset_id, &n_nodeset_nodes, &n_dist_fact);
+            AssertThrowExodusII(ierr);
+
+            std::vector<int> node_ids(n_nodeset_nodes);
+            ierr = ex_get_set(
+              ex_id, EX_NODE_SET, nodeset_id, node_ids.data(), nullptr);
+            AssertThrowExodusII(ierr);
+            integer_data.push_back(node_ids.size());
+            for (const int node_id : node_ids)
+              {
+                Assert(node_id > 0 && std::size_t(node_id) <=
+                                        vertex_coordinates.size() / spacedim,
+                       ExcFDLInternalError());
+                integer_data.push_back(node_id - 1);
+              }
+          }
 
+        const int ierr = ex_close(ex_id);
+        AssertThrowExodusII(ierr);
+      }
+    broadcast_array(vertex_coordinates, comm);
+    broadcast_array(integer_data, comm);
+
+    std::vector<Point<spacedim>> vertices(vertex_coordinates.size() /
+                                          spacedim);
+    for (std::size_t vertex_n = 0; vertex_n < vertices.size(); ++vertex_n)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        vertices[vertex_n][d] = vertex_coordinates[vertex_n * spacedim + d];
+
+    std::size_t offset = 0;
+    const auto  cells  = unpack_cell_data<dim>(integer_data, offset);
+    SubCellData subcell_data;
+    subcell_data.boundary_lines = unpack_cell_data<1>(integer_data, offset);
+    subcell_data.boundary_quads = unpack_cell_data<2>(integer_data, offset);
+    tria.create_triangulation(vertices, cells, subcell_data);
+
+    result.id_to_sideset_ids.resize(integer_data[offset++]);
+    for (std::vector<int> &sideset_ids : result.id_to_sideset_ids)
+      {
+        sideset_ids.resize(integer_data[offset++]);
+        for (int &sideset_id : sideset_ids)
+          sideset_id = integer_data[offset++];
+      }
+
+    for (unsigned int i = 0; i < nodeset_ids.size(); ++i)
+      {
+        result.nodesets.emplace_back();
+        auto &nodeset = result.nodesets.back();
+        nodeset.first.resize(integer_data[offset++]);
+        for (unsigned int &vertex_n : nodeset.first)
+          {
+            vertex_n = integer_data[offset++];
+            nodeset.second.push_back(vertices[vertex_n]);
+          }
+      }
+    AssertDimension(offset, integer_data.size());
 #else
     (void)filename;
     (void)tria;
-    (void)time_step_n;
-    (void)variable_name;
-    (void)cell_vector;
+    (void)nodeset_ids;
+    (void)apply_all_indicators_to_manifolds;
     AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
 #endif
+    return result;
+  }
+
+
+
+  template <int dim, int spacedim, typename VectorType>
+  void
+  read_elemental_data(const std::string                  &filename,
+                      const Triangulation<dim, spacedim> &tria,
+                      const int                           time_step_n,
+                      const std::string                  &variable_name,
+                      VectorType                         &cell_vector)
+  {
+    ElementalDataReader<dim, spacedim> reader(filename, tria, variable_name);
+    reader.read(time_step_n, cell_vector);
   }
 
 
@@ -616,100 +1119,317 @@ namespace fdl
                 const DoFHandler<dim, spacedim> &dof_handler,
                 const int                        time_step_n,
                 const std::vector<std::string>  &variable_names,
-                VectorType                      &dof_vector)
+                VectorType                      &dof_vector,
+                const std::string               &cache_filename)
   // TODO - make this work with a ComponentMask
   {
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
     Assert(dof_handler.get_triangulation().n_levels() == 1,
            ExcMessage("This function can only be called on unrefined grids."));
+    AssertThrow(dof_handler.get_fe_collection().size() == 1,
+                ExcFDLNotImplemented());
     AssertDimension(dof_handler.n_dofs(), dof_vector.size());
     AssertDimension(dof_handler.n_locally_owned_dofs(),
                     dof_vector.locally_owned_size());
+    const MPI_Comm comm    = dof_handler.get_communicator();
+    const bool     is_root = Utilities::MPI::this_mpi_process(comm) == 0;
 
-    // Partition FEs into elemental and nodal parts. ExodusII does not support
-    // variables which have both elemental and nodal parts so we ignore that
-    // case. Hence we can examine just the first FE to set up the partitioning
-    // on all components.
-    std::vector<unsigned int>           elemental_components;
-    std::vector<unsigned int>           nodal_components;
-    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
-    for (unsigned int component = 0; component < fe.n_components(); ++component)
+    std::uint64_t key = 0;
+    if (cache_filename != "")
       {
-        const FiniteElement<dim, spacedim> &sub_fe =
-          fe.get_sub_fe(component, 1);
-        if (sub_fe.tensor_degree() == 0)
-          elemental_components.push_back(component);
-        else
-          nodal_components.push_back(component);
+        key = compute_cache_key(dof_handler, time_step_n, variable_names);
+        const bool cache_read =
+          read_cache(cache_filename, key, dof_handler, dof_vector);
+        // If any processor failed then read the ExodusII file instead
+        if (Utilities::MPI::min(int(cache_read), comm) == 1)
+          return;
       }
 
-    // elemental data:
-    for (const unsigned int component : elemental_components)
+    const int           ex_id = open_exodus_file(filename, comm);
+    std::vector<double> cell_dof_values;
+    bool                centers_match = true;
+    if (is_root)
       {
-        Vector<typename VectorType::value_type> component_values(
-          dof_handler.get_triangulation().n_active_cells());
-
-        read_elemental_data(filename,
-                            dof_handler.get_triangulation(),
-                            time_step_n,
-                            variable_names[component],
-                            component_values);
-
-        std::vector<types::global_dof_index> cell_dofs;
-        for (const auto &cell : dof_handler.active_cell_iterators())
-          if (cell->is_locally_owned())
-            {
-              cell_dofs.resize(cell->get_fe().n_dofs_per_cell());
-              cell->get_dof_indices(cell_dofs);
-              for (unsigned int i = 0; i < cell_dofs.size(); ++i)
-                {
-                  const auto pair = fe.system_to_component_index(i);
-                  if (pair.first == component)
-                    dof_vector[cell_dofs[i]] =
-                      component_values[cell->active_cell_index()];
-                }
-            }
+        NodePermutation permutation;
+        cell_dof_values = read_cell_dof_values(ex_id,
+                                               dof_handler,
+                                               time_step_n,
+                                               variable_names,
+                                               permutation,
+                                               centers_match);
+        const int ierr = ex_close(ex_id);
+        AssertThrowExodusII(ierr);
       }
+    AssertThrow(Utilities::MPI::broadcast(comm, centers_match, 0),
+                ExcMessage(
+                  "The deal.II and ExodusII centers should be the same."));
 
-    // nodal data:
-    {
-      // deal.II always uses double precision numbers for geometry
-      int component_word_size = sizeof(double);
-      // setting to zero uses the stored word size
-      int   floating_point_word_size = 0;
-      float ex_version               = 0.0;
-
-      const int ex_id = ex_open(filename.c_str(),
-                                EX_READ,
-                                &component_word_size,
-                                &floating_point_word_size,
-                                &ex_version);
-      AssertThrow(ex_id > 0,
-                  ExcMessage(
-                    "ExodusII failed to open the specified input file."));
-
-      std::vector<unsigned int> components(dof_handler.get_fe().n_components());
-      std::iota(components.begin(), components.end(), 0u);
-      read_nodal_components(ex_id,
-                            variable_names,
-                            time_step_n,
-                            dof_handler,
-                            nodal_components,
-                            dof_vector);
+    if (is_root && cache_filename != "")
+      write_cache(cache_filename,
+                  key,
+                  dof_handler.get_triangulation().n_active_cells(),
+                  dof_handler.get_fe().n_dofs_per_cell(),
+                  cell_dof_values);
 
-      const int ierr = ex_close(ex_id);
-      AssertThrowExodusII(ierr);
-    }
+    broadcast_array(cell_dof_values, comm);
+    set_dof_values(dof_handler, cell_dof_values.data(), dof_vector);
 #else
     (void)filename;
     (void)dof_handler;
     (void)time_step_n;
     (void)variable_names;
     (void)dof_vector;
+    (void)cache_filename;
+    AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
+#endif
+  }
+
+  template <int dim, int spacedim, typename VectorType>
+  void
+  read_dof_data(const std::string               &filename,
+                const DoFHandler<dim, spacedim> &dof_handler,
+                const std::vector<int>          &time_step_ns,
+                const std::vector<std::string>  &variable_names,
+                std::vector<VectorType>         &dof_vectors)
+  {
+    AssertDimension(time_step_ns.size(), dof_vectors.size());
+    DoFDataReader<dim, spacedim> reader(filename, dof_handler, variable_names);
+    for (std::size_t i = 0; i < time_step_ns.size(); ++i)
+      reader.read(time_step_ns[i], dof_vectors[i]);
+  }
+
+
+
+  template <int dim, int spacedim>
+  DoFDataReader<dim, spacedim>::DoFDataReader(
+    const std::string               &filename,
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const std::vector<std::string>  &variable_names)
+    : dof_handler(&dof_handler)
+    , variable_names(variable_names)
+    , is_root(Utilities::MPI::this_mpi_process(
+                dof_handler.get_communicator()) == 0)
+    , ex_id(-1)
+    , node_permutation(std::make_unique<internal::NodePermutation>())
+    , prefetched_time_step_n(-1)
+  {
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    Assert(dof_handler.get_triangulation().n_levels() == 1,
+           ExcMessage("This function can only be called on unrefined grids."));
+    AssertThrow(dof_handler.get_fe_collection().size() == 1,
+                ExcFDLNotImplemented());
+    AssertDimension(variable_names.size(), dof_handler.get_fe().n_components());
+    ex_id = open_exodus_file(filename, dof_handler.get_communicator());
+#else
+    (void)filename;
+    AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
+#endif
+  }
+
+  template <int dim, int spacedim>
+  DoFDataReader<dim, spacedim>::~DoFDataReader()
+  {
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    if (prefetched_values.valid())
+      prefetched_values.wait();
+    // Don't throw in a destructor
+    if (is_root && ex_id > 0)
+      ex_close(ex_id);
+#endif
+  }
+
+  template <int dim, int spacedim>
+  void
+  DoFDataReader<dim, spacedim>::prefetch(const int time_step_n)
+  {
+    AssertThrow(prefetched_time_step_n == -1,
+                ExcMessage("Only one time step may be prefetched at a time."));
+    prefetched_time_step_n = time_step_n;
+    if (is_root)
+      prefetched_values =
+        std::async(std::launch::async,
+                   [this, time_step_n]() { return read_on_root(time_step_n); });
+  }
+
+  template <int dim, int spacedim>
+  std::pair<std::vector<double>, bool>
+  DoFDataReader<dim, spacedim>::read_on_root(const int time_step_n)
+  {
+    std::pair<std::vector<double>, bool> result{{}, true};
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    Assert(is_root, ExcFDLInternalError());
+    result.first = read_cell_dof_values(ex_id,
+                                        *dof_handler,
+                                        time_step_n,
+                                        variable_names,
+                                        *node_permutation,
+                                        result.second);
+#else
+    (void)time_step_n;
+#endif
+    return result;
+  }
+
+  template <int dim, int spacedim>
+  template <typename VectorType>
+  void
+  DoFDataReader<dim, spacedim>::read(const int   time_step_n,
+                                     VectorType &dof_vector)
+  {
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    AssertDimension(dof_handler->n_dofs(), dof_vector.size());
+    AssertDimension(dof_handler->n_locally_owned_dofs(),
+                    dof_vector.locally_owned_size());
+    const MPI_Comm comm = dof_handler->get_communicator();
+
+    std::pair<std::vector<double>, bool> values{{}, true};
+    if (is_root)
+      {
+        // Always finish the prefetch, even if we don't use it, since only one
+        // thread may use the file at a time
+        if (prefetched_values.valid())
+          {
+            auto prefetched = prefetched_values.get();
+            if (prefetched_time_step_n == time_step_n)
+              values = std::move(prefetched);
+          }
+        if (prefetched_time_step_n != time_step_n)
+          values = read_on_root(time_step_n);
+      }
+    prefetched_time_step_n = -1;
+
+    AssertThrow(Utilities::MPI::broadcast(comm, values.second, 0),
+                ExcMessage(
+                  "The deal.II and ExodusII centers should be the same."));
+    broadcast_array(values.first, comm);
+    set_dof_values(*dof_handler, values.first.data(), dof_vector);
+#else
+    (void)time_step_n;
+    (void)dof_vector;
+    AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
+#endif
+  }
+
+  template <int dim, int spacedim>
+  ElementalDataReader<dim, spacedim>::ElementalDataReader(
+    const std::string                  &filename,
+    const Triangulation<dim, spacedim> &tria,
+    const std::string                  &variable_name)
+    : tria(&tria)
+    , variable_name(variable_name)
+    , is_root(Utilities::MPI::this_mpi_process(tria.get_communicator()) == 0)
+    , ex_id(-1)
+    , prefetched_time_step_n(-1)
+  {
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    // According to circa line 2400 of tria.cc, the cells of a Triangulation
+    // have the same order of the input file - hence we can just load data
+    // into a serial vector and copy that straight over to a parallel deal.II
+    // vector.
+    Assert(tria.n_levels() == 1,
+           ExcMessage("This function can only be called on unrefined grids."));
+    ex_id = open_exodus_file(filename, tria.get_communicator());
+#else
+    (void)filename;
+    AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
+#endif
+  }
+
+  template <int dim, int spacedim>
+  ElementalDataReader<dim, spacedim>::~ElementalDataReader()
+  {
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    if (prefetched_values.valid())
+      prefetched_values.wait();
+    // Don't throw in a destructor
+    if (is_root && ex_id > 0)
+      ex_close(ex_id);
+#endif
+  }
+
+  template <int dim, int spacedim>
+  void
+  ElementalDataReader<dim, spacedim>::prefetch(const int time_step_n)
+  {
+    AssertThrow(prefetched_time_step_n == -1,
+                ExcMessage("Only one time step may be prefetched at a time."));
+    prefetched_time_step_n = time_step_n;
+    if (is_root)
+      prefetched_values =
+        std::async(std::launch::async,
+                   [this, time_step_n]() { return read_on_root(time_step_n); });
+  }
+
+  template <int dim, int spacedim>
+  std::pair<std::vector<double>, bool>
+  ElementalDataReader<dim, spacedim>::read_on_root(const int time_step_n)
+  {
+    std::pair<std::vector<double>, bool> result{{}, true};
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    Assert(is_root, ExcFDLInternalError());
+    result.first = read_element_values(
+      ex_id, *tria, time_step_n, variable_name, result.second);
+#else
+    (void)time_step_n;
+#endif
+    return result;
+  }
+
+  template <int dim, int spacedim>
+  template <typename VectorType>
+  void
+  ElementalDataReader<dim, spacedim>::read(const int   time_step_n,
+                                           VectorType &cell_vector)
+  {
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    AssertDimension(cell_vector.size(), tria->n_active_cells());
+    const MPI_Comm comm = tria->get_communicator();
+
+    std::pair<std::vector<double>, bool> values{{}, true};
+    if (is_root)
+      {
+        // Always finish the prefetch, even if we don't use it, since only one
+        // thread may use the file at a time
+        if (prefetched_values.valid())
+          {
+            auto prefetched = prefetched_values.get();
+            if (prefetched_time_step_n == time_step_n)
+              values = std::move(prefetched);
+          }
+        if (prefetched_time_step_n != time_step_n)
+          values = read_on_root(time_step_n);
+      }
+    prefetched_time_step_n = -1;
+
+    AssertThrow(Utilities::MPI::broadcast(comm, values.second, 0),
+                ExcMessage(
+                  "The deal.II and ExodusII centers should be the same."));
+    broadcast_array(values.first, comm);
+    AssertDimension(values.first.size(), tria->n_active_cells());
+
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->is_locally_owned())
+        cell_vector[cell->active_cell_index()] =
+          values.first[cell->active_cell_index()];
+#else
+    (void)time_step_n;
+    (void)cell_vector;
     AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
 #endif
   }
 
+  template ExodusIIMeshData<NDIM>
+  read_exodusii_mesh(const std::string             &filename,
+                     Triangulation<NDIM - 1, NDIM> &tria,
+                     const std::vector<int>        &nodeset_ids,
+                     const bool apply_all_indicators_to_manifolds);
+
+  template ExodusIIMeshData<NDIM>
+  read_exodusii_mesh(const std::string         &filename,
+                     Triangulation<NDIM, NDIM> &tria,
+                     const std::vector<int>    &nodeset_ids,
+                     const bool apply_all_indicators_to_manifolds);
+
   template void
   read_elemental_data(const std::string                   &filename,
                       const Triangulation<NDIM - 1, NDIM> &tria,
@@ -743,54 +1463,181 @@ namespace fdl
                 const DoFHandler<NDIM - 1, NDIM> &dof_handler,
                 const int                         time_step_n,
                 const std::vector<std::string>   &var_names,
-                Vector<double>                   &dof_vector);
+                Vector<double>                   &dof_vector,
+                const std::string                &cache_filename);
 
   template void
   read_dof_data(const std::string              &filename,
                 const DoFHandler<NDIM, NDIM>   &dof_handler,
                 const int                       time_step_n,
                 const std::vector<std::string> &var_names,
-                Vector<double>                 &dof_vector);
+                Vector<double>                 &dof_vector,
+                const std::string              &cache_filename);
 
   template void
   read_dof_data(const std::string                          &filename,
                 const DoFHandler<NDIM - 1, NDIM>           &dof_handler,
                 const int                                   time_step_n,
                 const std::vector<std::string>             &var_names,
-                LinearAlgebra::distributed::Vector<double> &dof_vector);
+                LinearAlgebra::distributed::Vector<double> &dof_vector,
+                const std::string                          &cache_filename);
 
   template void
   read_dof_data(const std::string                          &filename,
                 const DoFHandler<NDIM, NDIM>               &dof_handler,
                 const int                                   time_step_n,
                 const std::vector<std::string>             &var_names,
-                LinearAlgebra::distributed::Vector<double> &dof_vector);
+                LinearAlgebra::distributed::Vector<double> &dof_vector,
+                const std::string                          &cache_filename);
 
   template void
   read_dof_data(const std::string                &filename,
                 const DoFHandler<NDIM - 1, NDIM> &dof_handler,
                 const int                         time_step_n,
                 const std::vector<std::string>   &var_names,
-                BlockVector<double>              &dof_vector);
+                BlockVector<double>              &dof_vector,
+                const std::string                &cache_filename);
 
   template void
   read_dof_data(const std::string              &filename,
                 const DoFHandler<NDIM, NDIM>   &dof_handler,
                 const int                       time_step_n,
                 const std::vector<std::string> &var_names,
-                BlockVector<double>            &dof_vector);
+                BlockVector<double>            &dof_vector,
+                const std::string              &cache_filename);
 
   template void
   read_dof_data(const std::string                               &filename,
                 const DoFHandler<NDIM - 1, NDIM>                &dof_handler,
                 const int                                        time_step_n,
                 const std::vector<std::string>                  &var_names,
-                LinearAlgebra::distributed::BlockVector<double> &dof_vector);
+                LinearAlgebra::distributed::BlockVector<double> &dof_vector,
+                const std::string                               &cache_file);
 
   template void
   read_dof_data(const std::string                               &filename,
                 const DoFHandler<NDIM, NDIM>                    &dof_handler,
                 const int                                        time_step_n,
                 const std::vector<std::string>                  &var_names,
-                LinearAlgebra::distributed::BlockVector<double> &dof_vector);
+                LinearAlgebra::distributed::BlockVector<double> &dof_vector,
+                const std::string                               &cache_file);
+  template class DoFDataReader<NDIM - 1, NDIM>;
+  template class DoFDataReader<NDIM, NDIM>;
+
+  template class ElementalDataReader<NDIM - 1, NDIM>;
+  template class ElementalDataReader<NDIM, NDIM>;
+
+  template void
+  ElementalDataReader<NDIM - 1, NDIM>::read(const int      time_step_n,
+                                            Vector<double> &cell_vector);
+
+  template void
+  ElementalDataReader<NDIM, NDIM>::read(const int      time_step_n,
+                                        Vector<double> &cell_vector);
+
+  template void
+  ElementalDataReader<NDIM - 1, NDIM>::read(
+    const int                                   time_step_n,
+    LinearAlgebra::distributed::Vector<double> &cell_vector);
+
+  template void
+  ElementalDataReader<NDIM, NDIM>::read(
+    const int                                   time_step_n,
+    LinearAlgebra::distributed::Vector<double> &cell_vector);
+
+  template void
+  DoFDataReader<NDIM - 1, NDIM>::read(const int      time_step_n,
+                                      Vector<double> &dof_vector);
+
+  template void
+  DoFDataReader<NDIM, NDIM>::read(const int      time_step_n,
+                                  Vector<double> &dof_vector);
+
+  template void
+  DoFDataReader<NDIM - 1, NDIM>::read(
+    const int                                  time_step_n,
+    LinearAlgebra::distributed::Vector<double> &dof_vector);
+
+  template void
+  DoFDataReader<NDIM, NDIM>::read(
+    const int                                  time_step_n,
+    LinearAlgebra::distributed::Vector<double> &dof_vector);
+
+  template void
+  DoFDataReader<NDIM - 1, NDIM>::read(const int           time_step_n,
+                                      BlockVector<double> &dof_vector);
+
+  template void
+  DoFDataReader<NDIM, NDIM>::read(const int           time_step_n,
+                                  BlockVector<double> &dof_vector);
+
+  template void
+  DoFDataReader<NDIM - 1, NDIM>::read(
+    const int                                       time_step_n,
+    LinearAlgebra::distributed::BlockVector<double> &dof_vector);
+
+  template void
+  DoFDataReader<NDIM, NDIM>::read(
+    const int                                       time_step_n,
+    LinearAlgebra::distributed::BlockVector<double> &dof_vector);
+
+  template void
+  read_dof_data(const std::string                &filename,
+                const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+                const std::vector<int>           &time_step_ns,
+                const std::vector<std::string>   &var_names,
+                std::vector<Vector<double>>      &dof_vectors);
+
+  template void
+  read_dof_data(const std::string              &filename,
+                const DoFHandler<NDIM, NDIM>   &dof_handler,
+                const std::vector<int>         &time_step_ns,
+                const std::vector<std::string> &var_names,
+                std::vector<Vector<double>>    &dof_vectors);
+
+  template void
+  read_dof_data(
+    const std::string                                       &filename,
+    const DoFHandler<NDIM - 1, NDIM>                        &dof_handler,
+    const std::vector<int>                                  &time_step_ns,
+    const std::vector<std::string>                          &var_names,
+    std::vector<LinearAlgebra::distributed::Vector<double>> &dof_vectors);
+
+  template void
+  read_dof_data(
+    const std::string                                       &filename,
+    const DoFHandler<NDIM, NDIM>                            &dof_handler,
+    const std::vector<int>                                  &time_step_ns,
+    const std::vector<std::string>                          &var_names,
+    std::vector<LinearAlgebra::distributed::Vector<double>> &dof_vectors);
+
+  template void
+  read_dof_data(const std::string                &filename,
+                const DoFHandler<NDIM - 1, NDIM> &dof_handler,
+                const std::vector<int>           &time_step_ns,
+                const std::vector<std::string>   &var_names,
+                std::vector<BlockVector<double>> &dof_vectors);
+
+  template void
+  read_dof_data(const std::string                &filename,
+                const DoFHandler<NDIM, NDIM>     &dof_handler,
+                const std::vector<int>           &time_step_ns,
+                const std::vector<std::string>   &var_names,
+                std::vector<BlockVector<double>> &dof_vectors);
+
+  template void
+  read_dof_data(
+    const std::string                                            &filename,
+    const DoFHandler<NDIM - 1, NDIM>                             &dof_handler,
+    const std::vector<int>                                       &time_step_ns,
+    const std::vector<std::string>                               &var_names,
+    std::vector<LinearAlgebra::distributed::BlockVector<double>> &dof_vectors);
+
+  template void
+  read_dof_data(
+    const std::string                                            &filename,
+    const DoFHandler<NDIM, NDIM>                                 &dof_handler,
+    const std::vector<int>                                       &time_step_ns,
+    const std::vector<std::string>                               &var_names,
+    std::vector<LinearAlgebra::distributed::BlockVector<double>> &dof_vectors);
 } // namespace fdl
@@ -1,5 +1,7 @@
 #include <fiddle/base/exceptions.h>
 
+#include <fiddle/grid/grid_utilities.h>
+
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature_lib.h>
@@ -13,9 +15,23 @@
 #include <deal.II/fe/mapping_fe_field.h>
 #include <deal.II/fe/mapping_q.h>
 
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
 #include <deal.II/lac/vector.h>
 
+#include <deal.II/numerics/rtree.h>
+
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numeric>
 #include <vector>
 
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
@@ -194,6 +210,51 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::array<std::vector<float>, dim>
+  compute_reference_direction_lengths(const Triangulation<dim, spacedim> &tria,
+                                      const Mapping<dim, spacedim> &mapping,
+                                      const Quadrature<dim> &quadrature)
+  {
+    std::array<std::vector<float>, dim> result;
+    if (tria.n_active_cells() == 0)
+      return result;
+    AssertThrow(tria.all_reference_cells_are_hyper_cube(),
+                ExcMessage("This function only supports quadrilaterals and "
+                           "hexahedra."));
+
+    FE_Nothing<dim, spacedim> fe_nothing(ReferenceCells::get_hypercube<dim>());
+    FEValues<dim, spacedim>   fe_values(mapping,
+                                        fe_nothing,
+                                        quadrature,
+                                        update_jacobians);
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          for (unsigned int d = 0; d < dim; ++d)
+            result[d].push_back(0.0f);
+          for (unsigned int q = 0; q < quadrature.size(); ++q)
+            {
+              const DerivativeForm<1, dim, spacedim> &jacobian =
+                fe_values.jacobian(q);
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  double column_norm_square = 0.0;
+                  for (unsigned int i = 0; i < spacedim; ++i)
+                    column_norm_square += jacobian[i][d] * jacobian[i][d];
+                  result[d].back() =
+                    std::max<float>(result[d].back(),
+                                    std::sqrt(column_norm_square));
+                }
+            }
+        }
+
+    return result;
+  }
+
+
+
   template <int dim, int spacedim = dim>
   std::vector<float>
   collect_longest_edge_lengths(
@@ -265,6 +326,163 @@ namespace fdl
     return global_active_edge_lengths;
   }
 
+  template <int dim, int spacedim>
+  std::vector<types::subdomain_id>
+  compute_patch_owners(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, float>> &global_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim>>        &local_patch_bboxes)
+  {
+    namespace bgi = boost::geometry::index;
+    AssertThrow(global_active_cell_bboxes.size() == tria.n_active_cells(),
+                ExcMessage("There should be one bounding box for each active "
+                           "cell"));
+
+    const std::vector<std::vector<BoundingBox<spacedim>>> all_patch_bboxes =
+      Utilities::MPI::all_gather(tria.get_communicator(), local_patch_bboxes);
+    std::vector<std::pair<BoundingBox<spacedim>, unsigned int>>
+      patch_bboxes_and_ranks;
+    for (unsigned int rank = 0; rank < all_patch_bboxes.size(); ++rank)
+      for (const auto &bbox : all_patch_bboxes[rank])
+        patch_bboxes_and_ranks.emplace_back(bbox, rank);
+    const auto rtree = pack_rtree(patch_bboxes_and_ranks);
+
+    // Every processor has the same data so every processor computes the same
+    // owners. Break ties in favor of the lowest rank to keep it that way.
+    std::vector<types::subdomain_id> owners(tria.n_active_cells());
+    std::map<unsigned int, double>   rank_volumes;
+    BoundingBox<spacedim>            cell_bbox;
+    const auto                       add_volume =
+      [&](const std::pair<BoundingBox<spacedim>, unsigned int> &pair)
+    {
+      double volume = 1.0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        volume *= std::max(
+          0.0,
+          std::min(cell_bbox.get_boundary_points().second[d],
+                   pair.first.get_boundary_points().second[d]) -
+            std::max(cell_bbox.get_boundary_points().first[d],
+                     pair.first.get_boundary_points().first[d]));
+      rank_volumes[pair.second] += volume;
+    };
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        const unsigned int index = cell->active_cell_index();
+        cell_bbox.get_boundary_points() =
+          global_active_cell_bboxes[index].get_boundary_points();
+
+        rank_volumes.clear();
+        rtree.query(bgi::intersects(cell_bbox),
+                    boost::make_function_output_iterator(add_volume));
+        owners[index] = cell->subdomain_id();
+        double max_volume = -1.0;
+        for (const auto &pair : rank_volumes)
+          if (pair.second > max_volume)
+            {
+              owners[index] = pair.first;
+              max_volume    = pair.second;
+            }
+      }
+
+    return owners;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<types::subdomain_id>
+  compute_weighted_owners(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<unsigned int>                      &cell_weights)
+  {
+    AssertThrow(cell_weights.size() == tria.n_active_cells(),
+                ExcMessage("There should be one weight for each active cell"));
+    AssertThrow(std::all_of(cell_weights.begin(),
+                            cell_weights.end(),
+                            [](const unsigned int weight)
+                            { return weight > 0; }),
+                ExcMessage("The cell weights must be positive"));
+    const unsigned int n_procs =
+      Utilities::MPI::n_mpi_processes(tria.get_communicator());
+    std::vector<types::subdomain_id> new_owners(tria.n_active_cells(), 0);
+    if (n_procs == 1)
+      return new_owners;
+
+#ifdef DEAL_II_WITH_METIS
+    // METIS is deterministic, so every processor computes the same partition
+    DynamicSparsityPattern connectivity;
+    GridTools::get_face_connectivity_of_cells(tria, connectivity);
+    SparsityPattern sparsity;
+    sparsity.copy_from(connectivity);
+    std::vector<unsigned int> partition_indices(tria.n_active_cells());
+    SparsityTools::partition(sparsity,
+                             cell_weights,
+                             n_procs,
+                             partition_indices,
+                             SparsityTools::Partitioner::metis);
+    std::copy(partition_indices.begin(),
+              partition_indices.end(),
+              new_owners.begin());
+#else
+    // Assign each cell to the processor whose share of the total weight
+    // contains the middle of that cell's weight
+    const double total_weight =
+      std::accumulate(cell_weights.begin(), cell_weights.end(), 0.0);
+    double partial_weight = 0.0;
+    for (std::size_t i = 0; i < cell_weights.size(); ++i)
+      {
+        const double middle = partial_weight + 0.5 * cell_weights[i];
+        new_owners[i]       = std::min<types::subdomain_id>(
+          n_procs - 1,
+          static_cast<types::subdomain_id>(n_procs * middle / total_weight));
+        partial_weight += cell_weights[i];
+      }
+#endif
+
+    return new_owners;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  repartition_triangulation(
+    parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<types::subdomain_id>         &new_owners)
+  {
+    AssertThrow(new_owners.size() == tria.n_active_cells(),
+                ExcMessage("There should be one owner for each active cell"));
+    const unsigned int n_procs =
+      Utilities::MPI::n_mpi_processes(tria.get_communicator());
+    for (const types::subdomain_id owner : new_owners)
+      AssertThrow(owner < n_procs, ExcMessage("Invalid owner"));
+
+    // Only assign the new owners during the (empty) refinement cycle started
+    // below
+    {
+      boost::signals2::scoped_connection connection =
+        tria.signals.post_refinement.connect(
+          [&]()
+          {
+            for (const auto &cell : tria.active_cell_iterators())
+              cell->set_subdomain_id(new_owners[cell->active_cell_index()]);
+          });
+      tria.execute_coarsening_and_refinement();
+    }
+
+    bool same_owners = true;
+    for (const auto &cell : tria.active_cell_iterators())
+      same_owners =
+        same_owners &&
+        cell->subdomain_id() == new_owners[cell->active_cell_index()];
+    AssertThrow(same_owners,
+                ExcMessage("The triangulation did not keep the new subdomain "
+                           "ids: it should be set up with "
+                           "Settings::partition_custom_signal."));
+  }
+
+
+
   template <int spacedim>
   std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>
   extract_nodeset(const std::string &filename, const int nodeset_id)
@@ -453,6 +671,15 @@ namespace fdl
                                const Mapping<NDIM, NDIM> &,
                                const Quadrature<1> &);
 
+  template std::array<std::vector<float>, NDIM - 1>
+  compute_reference_direction_lengths(const Triangulation<NDIM - 1, NDIM> &,
+                                      const Mapping<NDIM - 1, NDIM> &,
+                                      const Quadrature<NDIM - 1> &);
+  template std::array<std::vector<float>, NDIM>
+  compute_reference_direction_lengths(const Triangulation<NDIM, NDIM> &,
+                                      const Mapping<NDIM, NDIM> &,
+                                      const Quadrature<NDIM> &);
+
   template std::vector<float>
   collect_longest_edge_lengths(
     const parallel::shared::Triangulation<NDIM - 1, NDIM> &,
@@ -463,6 +690,33 @@ namespace fdl
     const parallel::shared::Triangulation<NDIM, NDIM> &,
     const std::vector<float> &);
 
+  template std::vector<types::subdomain_id>
+  compute_patch_owners(const parallel::shared::Triangulation<NDIM - 1, NDIM> &,
+                       const std::vector<BoundingBox<NDIM, float>> &,
+                       const std::vector<BoundingBox<NDIM>> &);
+
+  template std::vector<types::subdomain_id>
+  compute_patch_owners(const parallel::shared::Triangulation<NDIM, NDIM> &,
+                       const std::vector<BoundingBox<NDIM, float>> &,
+                       const std::vector<BoundingBox<NDIM>> &);
+
+  template std::vector<types::subdomain_id>
+  compute_weighted_owners(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &,
+    const std::vector<unsigned int> &);
+
+  template std::vector<types::subdomain_id>
+  compute_weighted_owners(const parallel::shared::Triangulation<NDIM, NDIM> &,
+                          const std::vector<unsigned int> &);
+
+  template void
+  repartition_triangulation(parallel::shared::Triangulation<NDIM - 1, NDIM> &,
+                            const std::vector<types::subdomain_id> &);
+
+  template void
+  repartition_triangulation(parallel::shared::Triangulation<NDIM, NDIM> &,
+                            const std::vector<types::subdomain_id> &);
+
   template std::pair<std::vector<unsigned int>, std::vector<Point<NDIM>>>
   extract_nodeset<NDIM>(const std::string &filename, const int nodeset_id);
 
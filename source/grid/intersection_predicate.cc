@@ -5,6 +5,8 @@
 
 #include <deal.II/distributed/shared_tria.h>
 
+#include <algorithm>
+
 namespace fdl
 {
   using namespace dealii;
@@ -13,6 +15,7 @@ namespace fdl
   TriaIntersectionPredicate<dim, spacedim>::TriaIntersectionPredicate(
     const std::vector<BoundingBox<spacedim>> &bboxes)
     : patch_boxes(bboxes)
+    , patch_rtree(pack_rtree(bboxes))
   {}
 
   template <int dim, int spacedim>
@@ -20,22 +23,66 @@ namespace fdl
   TriaIntersectionPredicate<dim, spacedim>::operator()(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
   {
+    namespace bgi = boost::geometry::index;
+
     const auto cell_bbox = cell->bounding_box();
-    for (const auto &bbox : patch_boxes)
-      if (intersects(cell_bbox, bbox))
-        return true;
-    return false;
+    return patch_rtree.qbegin(bgi::intersects(cell_bbox)) != patch_rtree.qend();
   }
 
   template <int dim, int spacedim>
   BoxIntersectionPredicate<dim, spacedim>::BoxIntersectionPredicate(
-    const std::vector<BoundingBox<spacedim, float>>      &a_cell_bboxes,
+    const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
     const std::vector<BoundingBox<spacedim>>             &p_bboxes,
     const parallel::shared::Triangulation<dim, spacedim> &tria)
     : tria(&tria)
-    , active_cell_bboxes(a_cell_bboxes)
     , patch_bboxes(p_bboxes)
-  {}
+    , patch_rtree(pack_rtree(p_bboxes))
+  {
+    AssertDimension(active_cell_bboxes.size(), tria.n_active_cells());
+    namespace bgi = boost::geometry::index;
+
+    // With only a few patches it is faster to check each cell against all of
+    // them at once than it is to traverse the tree.
+    const bool use_batch = patch_bboxes.size() <= 64;
+
+    const BoundingBoxBatch<spacedim, float> patch_bbox_batch(
+      use_batch ? patch_bboxes : std::vector<BoundingBox<spacedim>>());
+
+    intersecting_cells.resize(tria.n_levels());
+    for (unsigned int level_n = tria.n_levels(); level_n-- > 0;)
+      {
+        std::vector<bool> &level_cells = intersecting_cells[level_n];
+        level_cells.resize(tria.n_raw_cells(level_n), false);
+        for (const auto &cell : tria.cell_iterators_on_level(level_n))
+          {
+            bool cell_intersects = false;
+            if (cell->is_active())
+              {
+                const auto &cell_bbox =
+                  active_cell_bboxes[cell->active_cell_index()];
+                cell_intersects =
+                  use_batch ?
+                    intersects_any(cell_bbox, patch_bbox_batch) :
+                    patch_rtree.qbegin(bgi::intersects(cell_bbox)) !=
+                      patch_rtree.qend();
+              }
+            // Otherwise see if it has a child that intersects. Since we go
+            // from fine to coarse these have already been computed.
+            else
+              {
+                const auto n_children = cell->n_children();
+                for (unsigned int child_n = 0; child_n < n_children; ++child_n)
+                  if (intersecting_cells[level_n + 1]
+                                        [cell->child(child_n)->index()])
+                    {
+                      cell_intersects = true;
+                      break;
+                    }
+              }
+            level_cells[cell->index()] = cell_intersects;
+          }
+      }
+  }
 
   template <int dim, int spacedim>
   bool
@@ -45,30 +92,82 @@ namespace fdl
     Assert(&cell->get_triangulation() == tria,
            ExcMessage("only valid for inputs constructed from the originally "
                       "provided Triangulation"));
-    // If the cell is active check its bbox:
+    AssertIndexRange(cell->level(), intersecting_cells.size());
+    AssertIndexRange(cell->index(), intersecting_cells[cell->level()].size());
+    return intersecting_cells[cell->level()][cell->index()];
+  }
+
+  template <int dim, int spacedim>
+  CellIdIntersectionPredicate<dim, spacedim>::CellIdIntersectionPredicate(
+    const std::vector<CellId>          &cell_ids,
+    const Triangulation<dim, spacedim> &tria)
+    : tria(&tria)
+    , active_cell_ids(cell_ids)
+  {
+    std::sort(active_cell_ids.begin(), active_cell_ids.end());
+  }
+
+  template <int dim, int spacedim>
+  bool
+  CellIdIntersectionPredicate<dim, spacedim>::operator()(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+  {
+    Assert(&cell->get_triangulation() == tria,
+           ExcMessage("only valid for inputs constructed from the originally "
+                      "provided Triangulation"));
     if (cell->is_active())
+      return std::binary_search(active_cell_ids.begin(),
+                                active_cell_ids.end(),
+                                cell->id());
+    // Otherwise see if it has a descendant that intersects:
+    else if (cell->has_children())
       {
-        const auto &cell_bbox = active_cell_bboxes[cell->active_cell_index()];
-        for (const auto &bbox : patch_bboxes)
-          if (intersects(cell_bbox, bbox))
+        const auto n_children = cell->n_children();
+        for (unsigned int child_n = 0; child_n < n_children; ++child_n)
+          if ((*this)(cell->child(child_n)))
             return true;
         return false;
       }
+    else
+      {
+        Assert(false, ExcNotImplemented());
+      }
+
+    Assert(false, ExcFDLInternalError());
+    return false;
+  }
+
+  template <int dim, int spacedim>
+  SubsetIntersectionPredicate<dim, spacedim>::SubsetIntersectionPredicate(
+    const IntersectionPredicate<dim, spacedim> &predicate,
+    const std::vector<bool>                    &selected_active_cells,
+    const Triangulation<dim, spacedim>         &tria)
+    : predicate(&predicate)
+    , tria(&tria)
+    , selected_active_cells(selected_active_cells)
+  {
+    AssertDimension(selected_active_cells.size(), tria.n_active_cells());
+  }
+
+  template <int dim, int spacedim>
+  bool
+  SubsetIntersectionPredicate<dim, spacedim>::operator()(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+  {
+    Assert(&cell->get_triangulation() == tria,
+           ExcMessage("only valid for inputs constructed from the originally "
+                      "provided Triangulation"));
+    if (cell->is_active())
+      return selected_active_cells[cell->active_cell_index()] &&
+             (*predicate)(cell);
     // Otherwise see if it has a descendant that intersects:
     else if (cell->has_children())
       {
-        const auto n_children             = cell->n_children();
-        bool       has_intersecting_child = false;
+        const auto n_children = cell->n_children();
         for (unsigned int child_n = 0; child_n < n_children; ++child_n)
-          {
-            const bool child_intersects = (*this)(cell->child(child_n));
-            if (child_intersects)
-              {
-                has_intersecting_child = true;
-                break;
-              }
-          }
-        return has_intersecting_child;
+          if ((*this)(cell->child(child_n)))
+            return true;
+        return false;
       }
     else
       {
@@ -92,4 +191,18 @@ namespace fdl
   template class BoxIntersectionPredicate<2, 2>;
   template class BoxIntersectionPredicate<2, 3>;
   template class BoxIntersectionPredicate<3, 3>;
+
+  template class CellIdIntersectionPredicate<1, 1>;
+  template class CellIdIntersectionPredicate<1, 2>;
+  template class CellIdIntersectionPredicate<1, 3>;
+  template class CellIdIntersectionPredicate<2, 2>;
+  template class CellIdIntersectionPredicate<2, 3>;
+  template class CellIdIntersectionPredicate<3, 3>;
+
+  template class SubsetIntersectionPredicate<1, 1>;
+  template class SubsetIntersectionPredicate<1, 2>;
+  template class SubsetIntersectionPredicate<1, 3>;
+  template class SubsetIntersectionPredicate<2, 2>;
+  template class SubsetIntersectionPredicate<2, 3>;
+  template class SubsetIntersectionPredicate<3, 3>;
 } // namespace fdl
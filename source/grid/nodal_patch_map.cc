@@ -1,7 +1,8 @@
 #include <fiddle/grid/box_utilities.h>
 #include <fiddle/grid/nodal_patch_map.h>
 
-#include <deal.II/numerics/rtree.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/memory_consumption.h>
 
 #include <algorithm>
 
@@ -14,9 +15,11 @@ namespace fdl
   NodalPatchMap<dim, spacedim>::NodalPatchMap(
     const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
     const std::vector<std::vector<BoundingBox<spacedim>>>   &patch_bboxes,
-    const Vector<double>                                    &nodal_coordinates)
+    const Vector<double>                                    &nodal_coordinates,
+    const bool                                               pack_nodes,
+    const std::vector<std::vector<BoundingBox<spacedim>>>   &owner_bboxes)
   {
-    reinit(patches, patch_bboxes, nodal_coordinates);
+    reinit(patches, patch_bboxes, nodal_coordinates, pack_nodes, owner_bboxes);
   }
 
 
@@ -26,16 +29,21 @@ namespace fdl
   NodalPatchMap<dim, spacedim>::reinit(
     const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
     const std::vector<std::vector<BoundingBox<spacedim>>>   &patch_bboxes,
-    const Vector<double>                                    &nodal_coordinates)
+    const Vector<double>                                    &nodal_coordinates,
+    const bool                                               pack_nodes,
+    const std::vector<std::vector<BoundingBox<spacedim>>>   &owner_bboxes)
   {
     AssertDimension(patches.size(), patch_bboxes.size());
+    patch_nodes.clear();
+    patch_owned_dof_indices.clear();
+    patch_owned_nodes.clear();
     if (patches.size() == 0)
       return;
 
     Assert(nodal_coordinates.size() % spacedim == 0,
            ExcMessage(
              "There should be N * spacedim entries in nodal_coordinates"));
-    const std::size_t n_nodes = nodal_coordinates.size() / spacedim;
+    n_nodes = nodal_coordinates.size() / spacedim;
 
     this->patches = patches;
     patch_dof_indices.resize(0);
@@ -43,52 +51,184 @@ namespace fdl
       patch_dof_indices.emplace_back(
         static_cast<types::global_dof_index>(nodal_coordinates.size()));
 
-    std::vector<int> patch_levels;
-    for (auto &patch : patches)
-      patch_levels.push_back(patch->getPatchLevelNumber());
-
-    const int min_ln =
-      *std::min_element(patch_levels.begin(), patch_levels.end());
-    const int max_ln =
-      *std::max_element(patch_levels.begin(), patch_levels.end());
+    // Add each contiguous range of nodes in a mask to an IndexSet
+    const auto add_nodes = [](const std::vector<unsigned char> &inside,
+                              IndexSet                         &dofs) {
+      std::size_t node_n = 0;
+      while (node_n < inside.size())
+        {
+          if (!inside[node_n])
+            {
+              ++node_n;
+              continue;
+            }
+          const std::size_t first_node_n = node_n;
+          while (node_n < inside.size() && inside[node_n])
+            ++node_n;
+          dofs.add_range(spacedim * first_node_n, spacedim * node_n);
+        }
+    };
+
+    // Check all nodes against one box at a time: this vectorizes and there
+    // are usually only a few locally owned patches
+    const ArrayView<const double> nodes(nodal_coordinates.begin(),
+                                        nodal_coordinates.size());
+    std::vector<unsigned char>    inside;
+    for (std::size_t i = 0; i < patches.size(); ++i)
+      {
+        for (const auto &bbox : patch_bboxes[i])
+          {
+            contains(bbox, nodes, inside);
+            add_nodes(inside, patch_dof_indices[i]);
+          }
+        patch_dof_indices[i].compress();
+      }
 
-    for (int ln = max_ln; ln >= min_ln; --ln)
+    if (owner_bboxes.size() > 0)
       {
-        std::vector<std::size_t>           level_patch_indices;
-        std::vector<BoundingBox<spacedim>> level_patch_bboxes;
+        AssertDimension(owner_bboxes.size(), patches.size());
         for (std::size_t i = 0; i < patches.size(); ++i)
-          if (patch_levels[i] == ln)
-            for (const auto &bbox : patch_bboxes[i])
+          patch_owned_dof_indices.emplace_back(
+            static_cast<types::global_dof_index>(nodal_coordinates.size()));
+
+        // Treat boxes as half-open and use the first one which contains each
+        // node.
+        std::vector<unsigned char> owned(n_nodes, 0);
+        for (std::size_t i = 0; i < patches.size(); ++i)
+          {
+            for (const auto &bbox : owner_bboxes[i])
               {
-                level_patch_indices.push_back(i);
-                level_patch_bboxes.push_back(bbox);
+                contains(bbox, nodes, inside, true);
+                for (std::size_t node_n = 0; node_n < n_nodes; ++node_n)
+                  {
+                    inside[node_n] &= !owned[node_n];
+                    owned[node_n] |= inside[node_n];
+                  }
+                add_nodes(inside, patch_owned_dof_indices[i]);
               }
+            patch_owned_dof_indices[i].compress();
+          }
+      }
 
-        // no need to continue if there are no locally owned boxes on this level
-        if (level_patch_bboxes.size() == 0)
-          continue;
-        const auto rtree = pack_rtree_of_indices(level_patch_bboxes);
-        for (std::size_t node_n = 0; node_n < n_nodes; ++node_n)
+    const auto setup_nodes =
+      [](const std::vector<IndexSet>                       &dof_indices,
+         std::vector<std::vector<types::global_dof_index>> &nodes) {
+        for (const IndexSet &index_set : dof_indices)
           {
-            Point<spacedim> node;
-            for (unsigned int d = 0; d < spacedim; ++d)
-              node[d] = nodal_coordinates[spacedim * node_n + d];
+            nodes.emplace_back();
+            nodes.back().reserve(index_set.n_elements() / spacedim);
+            for (auto it = index_set.begin_intervals();
+                 it != index_set.end_intervals();
+                 ++it)
+              for (auto dof = *it->begin(); dof < it->end(); dof += spacedim)
+                nodes.back().push_back(dof / spacedim);
+          }
+      };
+    if (pack_nodes)
+      {
+        setup_nodes(patch_dof_indices, patch_nodes);
+        setup_nodes(patch_owned_dof_indices, patch_owned_nodes);
+      }
+  }
 
-            namespace bgi = boost::geometry::index;
-            for (const std::size_t level_patch_n :
-                 rtree | bgi::adaptors::queried(bgi::intersects(node)))
-              {
-                AssertIndexRange(level_patch_n, level_patch_indices.size());
-                const auto patch_n = level_patch_indices[level_patch_n];
-                patch_dof_indices[patch_n].add_range(spacedim * node_n,
-                                                     spacedim * node_n +
-                                                       spacedim);
-              }
+
+
+  template <int dim, int spacedim>
+  void
+  NodalPatchMap<dim, spacedim>::pack(const std::size_t     patch_n,
+                                     const Vector<double> &values,
+                                     std::vector<double>  &buffer,
+                                     const bool owned_nodes_only) const
+  {
+    Assert(packs_nodes(), ExcMessage("Packing is not enabled."));
+    Assert(!owned_nodes_only || has_owners(),
+           ExcMessage("Owner boxes were not provided."));
+    AssertIndexRange(patch_n, size());
+    Assert(n_nodes > 0 && values.size() % n_nodes == 0,
+           ExcMessage("There should be a fixed number of values per node"));
+    const std::size_t n_components = values.size() / n_nodes;
+    const auto       &nodes =
+      owned_nodes_only ? patch_owned_nodes[patch_n] : patch_nodes[patch_n];
+
+    buffer.resize(nodes.size() * n_components);
+    auto out = buffer.begin();
+    for (const types::global_dof_index node : nodes)
+      out =
+        std::copy_n(values.begin() + node * n_components, n_components, out);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NodalPatchMap<dim, spacedim>::unpack(const std::size_t          patch_n,
+                                       const std::vector<double> &buffer,
+                                       Vector<double>            &values,
+                                       const bool owned_nodes_only) const
+  {
+    Assert(packs_nodes(), ExcMessage("Packing is not enabled."));
+    Assert(!owned_nodes_only || has_owners(),
+           ExcMessage("Owner boxes were not provided."));
+    AssertIndexRange(patch_n, size());
+    Assert(n_nodes > 0 && values.size() % n_nodes == 0,
+           ExcMessage("There should be a fixed number of values per node"));
+    const std::size_t n_components = values.size() / n_nodes;
+    const auto       &nodes =
+      owned_nodes_only ? patch_owned_nodes[patch_n] : patch_nodes[patch_n];
+    AssertDimension(buffer.size(), nodes.size() * n_components);
+
+    auto in = buffer.begin();
+    for (const types::global_dof_index node : nodes)
+      {
+        std::copy_n(in, n_components, values.begin() + node * n_components);
+        in += n_components;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  NodalPatchMap<dim, spacedim>::count_nodes_outside_owners(
+    const Vector<double> &nodal_coordinates) const
+  {
+    Assert(has_owners(), ExcMessage("Owner boxes were not provided."));
+    AssertDimension(nodal_coordinates.size(), n_nodes * spacedim);
+
+    std::size_t                n_outside = 0;
+    std::vector<int>           indices;
+    std::vector<unsigned char> inside;
+    for (std::size_t i = 0; i < patches.size(); ++i)
+      {
+        hier::Box<spacedim> box = patches[i]->getBox();
+        box.grow(hier::IntVector<spacedim>(1));
+        const IndexSet &dofs = patch_owned_dof_indices[i];
+        for (auto it = dofs.begin_intervals(); it != dofs.end_intervals();
+             ++it)
+          {
+            const ArrayView<const double> nodes(nodal_coordinates.begin() +
+                                                  *it->begin(),
+                                                it->end() - *it->begin());
+            compute_cell_indices(nodes, patches[i], indices);
+            contains(box, indices, inside);
+            n_outside += std::count(inside.begin(), inside.end(), 0);
           }
       }
 
-    for (IndexSet &index_set : patch_dof_indices)
-      index_set.compress();
+    return n_outside;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  NodalPatchMap<dim, spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) + patches.capacity() * sizeof(patches[0]) +
+           MemoryConsumption::memory_consumption(patch_dof_indices) +
+           MemoryConsumption::memory_consumption(patch_nodes) +
+           MemoryConsumption::memory_consumption(patch_owned_dof_indices) +
+           MemoryConsumption::memory_consumption(patch_owned_nodes);
   }
 
 
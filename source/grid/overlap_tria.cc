@@ -3,6 +3,7 @@
 #include <deal.II/grid/tria_description.h>
 
 #include <algorithm>
+#include <utility>
 
 namespace fdl
 {
@@ -28,15 +29,57 @@ namespace fdl
 
 
   template <int dim, int spacedim>
-  void
+  bool
   OverlapTriangulation<dim, spacedim>::reinit(
     const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
     const IntersectionPredicate<dim, spacedim>           &predicate)
   {
-    // todo - clear signals, etc. if there is a new shared tria
-    native_tria = &shared_tria;
+    const bool rebuild_needed = select_cells(shared_tria, predicate);
+    if (rebuild_needed)
+      rebuild(predicate);
+    return rebuild_needed;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  OverlapTriangulation<dim, spacedim>::select_cells(
+    const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
+    const IntersectionPredicate<dim, spacedim>           &predicate)
+  {
+    if (native_tria != &shared_tria)
+      {
+        native_tria = &shared_tria;
+        native_tria_connection = shared_tria.signals.any_change.connect(
+          [this]() { native_tria_changed = true; });
+        native_tria_changed = true;
+      }
 
+    std::vector<bool> selected(shared_tria.n_active_cells());
+    for (const auto &cell : shared_tria.active_cell_iterators())
+      selected[cell->active_cell_index()] = predicate(cell);
+
+    needs_rebuild = needs_rebuild || native_tria_changed ||
+                    selected != selected_native_active_cells;
+    selected_native_active_cells = std::move(selected);
+
+    return needs_rebuild;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  OverlapTriangulation<dim, spacedim>::rebuild(
+    const IntersectionPredicate<dim, spacedim> &predicate)
+  {
+    Assert(native_tria,
+           ExcMessage("select_cells() must be called before rebuild()"));
     reinit_overlapping_tria(predicate);
+
+    needs_rebuild       = false;
+    native_tria_changed = false;
   }
 
 
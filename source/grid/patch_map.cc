@@ -1,22 +1,166 @@
 #include <fiddle/grid/box_utilities.h>
 #include <fiddle/grid/patch_map.h>
 
+#include <deal.II/base/memory_consumption.h>
+
 #include <deal.II/numerics/rtree.h>
 
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
 namespace fdl
 {
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    /**
+     * Compute the Morton (Z-order) key of the center of each bounding box,
+     * relative to the bounding box of all the centers.
+     */
+    template <int spacedim, typename Number>
+    std::vector<std::uint64_t>
+    compute_morton_keys(
+      const std::vector<BoundingBox<spacedim, Number>> &bboxes)
+    {
+      std::vector<Point<spacedim>> centers(bboxes.size());
+      Point<spacedim>              lower, upper;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          lower[d] = std::numeric_limits<double>::max();
+          upper[d] = std::numeric_limits<double>::lowest();
+        }
+      for (std::size_t i = 0; i < bboxes.size(); ++i)
+        {
+          const auto &points = bboxes[i].get_boundary_points();
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              centers[i][d] =
+                0.5 * (double(points.first[d]) + double(points.second[d]));
+              lower[d]      = std::min(lower[d], centers[i][d]);
+              upper[d]      = std::max(upper[d], centers[i][d]);
+            }
+        }
+
+      // Use as many bits per coordinate as fit in the key
+      constexpr unsigned int n_bits = 64 / spacedim;
+      const double max_coordinate   = double((std::uint64_t(1) << n_bits) - 1);
+      std::vector<std::uint64_t> keys(bboxes.size());
+      for (std::size_t i = 0; i < bboxes.size(); ++i)
+        {
+          std::array<std::uint64_t, spacedim> coordinates;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            coordinates[d] =
+              upper[d] > lower[d] ?
+                static_cast<std::uint64_t>((centers[i][d] - lower[d]) /
+                                           (upper[d] - lower[d]) *
+                                           max_coordinate) :
+                0;
+
+          std::uint64_t key = 0;
+          for (unsigned int b = n_bits; b-- > 0;)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              key = (key << 1) | ((coordinates[d] >> b) & 1u);
+          keys[i] = key;
+        }
+
+      return keys;
+    }
+
+    /**
+     * Convert a bounding box to a different precision.
+     */
+    template <typename Number2, int spacedim, typename Number1>
+    BoundingBox<spacedim, Number2>
+    convert(const BoundingBox<spacedim, Number1> &bbox)
+    {
+      const auto              &points = bbox.get_boundary_points();
+      Point<spacedim, Number2> lower, upper;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          lower[d] = points.first[d];
+          upper[d] = points.second[d];
+        }
+      return BoundingBox<spacedim, Number2>(std::make_pair(lower, upper));
+    }
+
+    /**
+     * Compute the box a cell may move around in without needing to search for
+     * new patches: i.e., the cell's bounding box expanded by half of its
+     * length in each coordinate direction.
+     */
+    template <int spacedim, typename Number>
+    BoundingBox<spacedim>
+    compute_reference_bbox(const BoundingBox<spacedim, Number> &bbox)
+    {
+      const auto     &points = bbox.get_boundary_points();
+      Point<spacedim> lower, upper;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          const double length = double(points.second[d]) - points.first[d];
+          lower[d]            = points.first[d] - 0.5 * length;
+          upper[d]            = points.second[d] + 0.5 * length;
+        }
+      return BoundingBox<spacedim>(std::make_pair(lower, upper));
+    }
+
+    /**
+     * Return whether or not @p inner is a subset of @p outer.
+     */
+    template <int spacedim>
+    bool
+    contains(const BoundingBox<spacedim> &outer,
+             const BoundingBox<spacedim> &inner)
+    {
+      for (unsigned int d = 0; d < spacedim; ++d)
+        if (inner.lower_bound(d) < outer.lower_bound(d) ||
+            outer.upper_bound(d) < inner.upper_bound(d))
+          return false;
+      return true;
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  template <typename Number, typename RTree>
+  void
+  PatchMap<dim, spacedim>::find_reference_patches(
+    const unsigned int                   active_cell_index,
+    const BoundingBox<spacedim, Number> &cell_bbox,
+    const RTree                         &rtree)
+  {
+    reference_cell_bboxes[active_cell_index] =
+      compute_reference_bbox(cell_bbox);
+    auto &reference_patches = reference_cell_patches[active_cell_index];
+    reference_patches.clear();
+
+    namespace bgi = boost::geometry::index;
+    const auto add_patch = [&](const std::size_t patch_n) {
+      AssertIndexRange(patch_n, patches.size());
+      reference_patches.push_back(patch_n);
+    };
+    rtree.query(bgi::intersects(
+                  convert<Number>(reference_cell_bboxes[active_cell_index])),
+                boost::make_function_output_iterator(add_patch));
+    std::sort(reference_patches.begin(), reference_patches.end());
+  }
+
+
+
   template <int dim, int spacedim>
   template <typename Number>
   PatchMap<dim, spacedim>::PatchMap(
     const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
     const double                                      extra_ghost_cell_fraction,
     const Triangulation<dim, spacedim>               &tria,
-    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes)
+    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+    const bool                                        sort_cells)
   {
-    reinit(patches, extra_ghost_cell_fraction, tria, cell_bboxes);
+    reinit(patches, extra_ghost_cell_fraction, tria, cell_bboxes, sort_cells);
   }
 
   template <int dim, int spacedim>
@@ -26,60 +170,229 @@ namespace fdl
     const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
     const double                                      extra_ghost_cell_fraction,
     const Triangulation<dim, spacedim>               &tria,
-    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes)
+    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+    const bool                                        sort_cells)
   {
     this->tria    = &tria;
     this->patches = patches;
+    this->extra_ghost_cell_fraction = extra_ghost_cell_fraction;
+    dof_index_tables.clear();
     Assert(cell_bboxes.size() == tria.n_active_cells(),
            ExcMessage("each active cell should have a bounding box."));
 
     const std::vector<BoundingBox<spacedim, Number>> patch_bboxes =
       compute_patch_bboxes<spacedim, Number>(patches,
                                              extra_ghost_cell_fraction);
-    patch_level_cells.clear();
-    patch_level_cells.resize(patches.size());
-    for (unsigned int patch_n = 0; patch_n < patches.size(); ++patch_n)
-      {
-        patch_level_cells[patch_n].resize(tria.n_levels());
-        for (unsigned int level_n = 0; level_n < tria.n_levels(); ++level_n)
-          patch_level_cells[patch_n][level_n].set_size(tria.n_cells(level_n));
-      }
-
+    patch_active_cells.clear();
+    patch_active_cells.resize(patches.size());
+    active_cell_levels_and_indices.resize(tria.n_active_cells());
+    artificial_cells.assign(tria.n_active_cells(), false);
+    reference_cell_bboxes.resize(tria.n_active_cells());
+    reference_cell_patches.clear();
+    reference_cell_patches.resize(tria.n_active_cells());
+    cell_patches.clear();
+    cell_patches.resize(tria.n_active_cells());
     // Speed up intersection by putting the patch bboxes in an rtree
     const auto rtree = pack_rtree_of_indices(patch_bboxes);
     for (const auto &cell : tria.active_cell_iterators())
       {
-        const BoundingBox<spacedim, Number> &cell_bbox =
-          cell_bboxes[cell->active_cell_index()];
-
-        namespace bgi = boost::geometry::index;
-        for (const std::size_t patch_n :
-             rtree | bgi::adaptors::queried(bgi::intersects(cell_bbox)))
-          {
-            AssertIndexRange(patch_n, patches.size());
-            AssertIndexRange(cell->level(), patch_level_cells[patch_n].size());
-            patch_level_cells[patch_n][cell->level()].add_index(cell->index());
-          }
+        const unsigned int active_cell_index = cell->active_cell_index();
+        active_cell_levels_and_indices[active_cell_index] = {cell->level(),
+                                                             cell->index()};
+        // Artificial cells (e.g., of an OverlapTriangulation) are only
+        // present to complete the mesh and should never interact
+        artificial_cells[active_cell_index] = cell->is_artificial();
+        if (artificial_cells[active_cell_index])
+          continue;
+        find_reference_patches(active_cell_index,
+                               cell_bboxes[active_cell_index],
+                               rtree);
+        for (const unsigned int patch_n :
+             reference_cell_patches[active_cell_index])
+          if (intersects(patch_bboxes[patch_n],
+                         cell_bboxes[active_cell_index]))
+            {
+              patch_active_cells[patch_n].push_back(active_cell_index);
+              cell_patches[active_cell_index].push_back(patch_n);
+            }
       }
 
-    for (auto &level_cells : patch_level_cells)
-      for (auto &cell_indices : level_cells)
-        cell_indices.compress();
+    // Cells are stored in the order of these keys, with ties broken by the
+    // active cell index
+    if (sort_cells)
+      cell_keys = compute_morton_keys(cell_bboxes);
+    else
+      {
+        cell_keys.resize(tria.n_active_cells());
+        for (unsigned int i = 0; i < cell_keys.size(); ++i)
+          cell_keys[i] = i;
+      }
 
-    // update cummulative number of cells
-    cummulative_n_cells.clear();
-    cummulative_n_cells.resize(patches.size());
+    patch_cells.clear();
+    patch_cells.resize(patches.size());
     for (unsigned int patch_n = 0; patch_n < patches.size(); ++patch_n)
+      setup_patch_cells(patch_n);
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename Number>
+  std::size_t
+  PatchMap<dim, spacedim>::update(
+    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes)
+  {
+    Assert(tria, ExcMessage("This object has not been initialized."));
+    AssertThrow(cell_bboxes.size() == tria->n_active_cells(),
+                ExcMessage("each active cell should have a bounding box."));
+
+    const std::vector<BoundingBox<spacedim, Number>> patch_bboxes =
+      compute_patch_bboxes<spacedim, Number>(patches,
+                                             extra_ghost_cell_fraction);
+    const auto rtree = pack_rtree_of_indices(patch_bboxes);
+
+    std::vector<std::vector<unsigned int>> removed_cells(patches.size());
+    std::vector<std::vector<unsigned int>> added_cells(patches.size());
+    std::vector<unsigned int>              new_patches;
+    std::size_t                            n_changed_cells = 0;
+    for (unsigned int i = 0; i < cell_bboxes.size(); ++i)
       {
-        for (unsigned int level_n = 0; level_n < tria.n_levels(); ++level_n)
+        if (artificial_cells[i])
+          continue;
+        // A cell can only intersect the patches which intersect a box
+        // containing it, so we only need to query the rtree when the cell
+        // leaves its reference box
+        if (!contains(reference_cell_bboxes[i],
+                      convert<double>(cell_bboxes[i])))
+          find_reference_patches(i, cell_bboxes[i], rtree);
+
+        new_patches.clear();
+        for (const unsigned int patch_n : reference_cell_patches[i])
+          if (intersects(patch_bboxes[patch_n], cell_bboxes[i]))
+            new_patches.push_back(patch_n);
+
+        if (new_patches != cell_patches[i])
           {
-            cummulative_n_cells[patch_n].push_back(
-              patch_level_cells[patch_n][level_n].n_elements());
-            if (level_n != 0)
-              cummulative_n_cells[patch_n].back() +=
-                cummulative_n_cells[patch_n][level_n - 1];
+            ++n_changed_cells;
+            for (const unsigned int patch_n : cell_patches[i])
+              if (!std::binary_search(new_patches.begin(),
+                                      new_patches.end(),
+                                      patch_n))
+                removed_cells[patch_n].push_back(i);
+            for (const unsigned int patch_n : new_patches)
+              if (!std::binary_search(cell_patches[i].begin(),
+                                      cell_patches[i].end(),
+                                      patch_n))
+                added_cells[patch_n].push_back(i);
+            cell_patches[i] = new_patches;
           }
       }
+
+    for (unsigned int patch_n = 0; patch_n < patches.size(); ++patch_n)
+      if (removed_cells[patch_n].size() > 0 || added_cells[patch_n].size() > 0)
+        {
+          // removed_cells is already sorted
+          auto &active_cells = patch_active_cells[patch_n];
+          active_cells.erase(
+            std::remove_if(active_cells.begin(),
+                           active_cells.end(),
+                           [&](const unsigned int i)
+                           {
+                             return std::binary_search(
+                               removed_cells[patch_n].begin(),
+                               removed_cells[patch_n].end(),
+                               i);
+                           }),
+            active_cells.end());
+          active_cells.insert(active_cells.end(),
+                              added_cells[patch_n].begin(),
+                              added_cells[patch_n].end());
+          setup_patch_cells(patch_n);
+        }
+
+    return n_changed_cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::setup_patch_cells(const std::size_t patch_n)
+  {
+    auto &active_cells = patch_active_cells[patch_n];
+    std::sort(active_cells.begin(),
+              active_cells.end(),
+              [&](const unsigned int a, const unsigned int b)
+              {
+                return std::make_pair(cell_keys[a], a) <
+                       std::make_pair(cell_keys[b], b);
+              });
+    patch_cells[patch_n].clear();
+    patch_cells[patch_n].reserve(active_cells.size());
+    for (const unsigned int active_cell_index : active_cells)
+      patch_cells[patch_n].push_back(
+        active_cell_levels_and_indices[active_cell_index]);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::cache_dof_indices(
+    const DoFHandler<dim, spacedim> &dof_handler)
+  {
+    Assert(tria, ExcMessage("This object has not been initialized."));
+    Assert(&dof_handler.get_triangulation() == &*tria,
+           ExcMessage("must use same Triangulation"));
+    if (get_dof_index_table(dof_handler).size() > 0)
+      return;
+
+    const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+    std::vector<types::global_dof_index> table(tria->n_active_cells() *
+                                                 dofs_per_cell,
+                                               numbers::invalid_dof_index);
+    std::vector<types::global_dof_index> cell_dofs(dofs_per_cell);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (!artificial_cells[cell->active_cell_index()])
+        {
+          cell->get_dof_indices(cell_dofs);
+          std::copy(cell_dofs.begin(),
+                    cell_dofs.end(),
+                    table.begin() + cell->active_cell_index() * dofs_per_cell);
+        }
+    dof_index_tables.emplace_back(&dof_handler, std::move(table));
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const types::global_dof_index>
+  PatchMap<dim, spacedim>::get_dof_index_table(
+    const DoFHandler<dim, spacedim> &dof_handler) const
+  {
+    for (const auto &pair : dof_index_tables)
+      if (pair.first == &dof_handler)
+        return make_array_view(pair.second);
+    return {};
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  PatchMap<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t n_bytes = 0;
+    for (const auto &pair : dof_index_tables)
+      n_bytes += MemoryConsumption::memory_consumption(pair.second);
+    return n_bytes + sizeof(*this) + patches.capacity() * sizeof(patches[0]) +
+           MemoryConsumption::memory_consumption(patch_cells) +
+           MemoryConsumption::memory_consumption(patch_active_cells) +
+           MemoryConsumption::memory_consumption(
+             active_cell_levels_and_indices) +
+           MemoryConsumption::memory_consumption(artificial_cells) +
+           MemoryConsumption::memory_consumption(cell_keys) +
+           MemoryConsumption::memory_consumption(cell_patches) +
+           reference_cell_bboxes.capacity() * sizeof(BoundingBox<spacedim>) +
+           MemoryConsumption::memory_consumption(reference_cell_patches);
   }
 
   // Since we depend on SAMRAI types (and SAMRAI uses 2D or 3D libraries) we
@@ -91,12 +404,22 @@ namespace fdl
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM - 1, NDIM> &,
-    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes);
+    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes,
+    const bool);
 
   template PatchMap<NDIM - 1, NDIM>::PatchMap(
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM - 1, NDIM> &,
+    const std::vector<BoundingBox<NDIM, double>> &cell_bboxes,
+    const bool);
+
+  template std::size_t
+  PatchMap<NDIM - 1, NDIM>::update(
+    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes);
+
+  template std::size_t
+  PatchMap<NDIM - 1, NDIM>::update(
     const std::vector<BoundingBox<NDIM, double>> &cell_bboxes);
 
   template class PatchMap<NDIM, NDIM>;
@@ -105,12 +428,21 @@ namespace fdl
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM, NDIM> &,
-    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes);
+    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes,
+    const bool);
 
   template PatchMap<NDIM, NDIM>::PatchMap(
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM, NDIM> &,
-    const std::vector<BoundingBox<NDIM, double>> &cell_bboxes);
+    const std::vector<BoundingBox<NDIM, double>> &cell_bboxes,
+    const bool);
 
+  template std::size_t
+  PatchMap<NDIM, NDIM>::update(
+    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes);
+
+  template std::size_t
+  PatchMap<NDIM, NDIM>::update(
+    const std::vector<BoundingBox<NDIM, double>> &cell_bboxes);
 } // namespace fdl
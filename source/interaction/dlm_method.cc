@@ -1,7 +1,23 @@
 #include <fiddle/interaction/dlm_method.h>
 
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/fe/fe_values.h>
+
+#include <algorithm>
+
 namespace fdl
 {
+  template <int dim, int spacedim>
+  const LinearAlgebra::distributed::Vector<double> *
+  DLMMethodBase<dim, spacedim>::get_mechanics_position_view(
+    const double /*time*/) const
+  {
+    return nullptr;
+  }
+
+
+
   template <int dim, int spacedim>
   DLMForce<dim, spacedim>::DLMForce(
     const Quadrature<dim>           &quad,
@@ -13,6 +29,7 @@ namespace fdl
                                  dof_handler,
                                  dlm.get_current_mechanics_position())
     , dlm(&dlm)
+    , has_nodal_force(false)
   {}
 
   template <int dim, int spacedim>
@@ -23,10 +40,100 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> & /*velocity*/)
   {
     this->current_position = &position;
-    dlm->get_mechanics_position(time, this->reference_position);
+
+    const LinearAlgebra::distributed::Vector<double> *mechanics_position =
+      dlm->get_mechanics_position_view(time);
+    if (mechanics_position == nullptr)
+      {
+        dlm->get_mechanics_position(time, this->reference_position);
+        mechanics_position = &this->reference_position;
+      }
+
+    // Both vectors have the same layout of locally owned and ghost entries
+    // so we can compute the penalty with local indices.
+    has_nodal_force = mechanics_position->partitioners_are_compatible(
+      *position.get_partitioner());
+    if (has_nodal_force)
+      {
+        if (nodal_force.get_partitioner() != position.get_partitioner())
+          nodal_force.reinit(position.get_partitioner());
+        const unsigned int n_local_elements =
+          position.locally_owned_size() + position.n_ghost_entries();
+
+        const double *const reference_values = mechanics_position->begin();
+        const double *const position_values  = position.begin();
+        double *const       force_values     = nodal_force.begin();
+        const double        spring_constant  = this->spring_constant;
+        DEAL_II_OPENMP_SIMD_PRAGMA
+        for (unsigned int i = 0; i < n_local_elements; ++i)
+          force_values[i] =
+            spring_constant * (reference_values[i] - position_values[i]);
+      }
+    else if (mechanics_position != &this->reference_position)
+      this->reference_position = *mechanics_position;
   }
 
+  template <int dim, int spacedim>
+  void
+  DLMForce<dim, spacedim>::finish_force(const double time)
+  {
+    SpringForce<dim, spacedim>::finish_force(time);
+    has_nodal_force = false;
+  }
+
+  template <int dim, int spacedim>
+  void
+  DLMForce<dim, spacedim>::compute_volume_force(
+    const double                                                       time,
+    const MechanicsValues<dim, spacedim>                              &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<1, spacedim>> &forces) const
+  {
+    if (!has_nodal_force)
+      {
+        SpringForce<dim, spacedim>::compute_volume_force(time,
+                                                         m_values,
+                                                         cell,
+                                                         forces);
+        return;
+      }
+
+    const FEValuesBase<dim, spacedim> &fe_values = m_values.get_fe_values();
+
+    const auto dof_cell =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator(
+        &this->dof_handler->get_triangulation(),
+        cell->level(),
+        cell->index(),
+        &*this->dof_handler);
+
+    auto &scratch = this->scratch.get();
+    scratch.cell_dofs.resize(fe_values.dofs_per_cell);
+    dof_cell->get_dof_indices(scratch.cell_dofs);
+    scratch.dof_values.resize(fe_values.dofs_per_cell);
+    scratch.qp_values.resize(fe_values.n_quadrature_points);
+    for (unsigned int i = 0; i < scratch.cell_dofs.size(); ++i)
+      scratch.dof_values[i] = nodal_force[scratch.cell_dofs[i]];
+
+    fe_values[FEValuesExtractors::Vector(0)]
+      .get_function_values_from_local_dof_values(scratch.dof_values,
+                                                 scratch.qp_values);
+    std::copy(scratch.qp_values.begin(),
+              scratch.qp_values.end(),
+              forces.begin());
+  }
+
+  template <int dim, int spacedim>
+  const LinearAlgebra::distributed::Vector<double> *
+  DLMForce<dim, spacedim>::get_nodal_force() const
+  {
+    return has_nodal_force ? &nodal_force : nullptr;
+  }
+
+
 
+  template class DLMMethodBase<NDIM - 1, NDIM>;
+  template class DLMMethodBase<NDIM, NDIM>;
 
   template class DLMForce<NDIM - 1, NDIM>;
   template class DLMForce<NDIM, NDIM>;
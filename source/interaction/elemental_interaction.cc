@@ -4,10 +4,13 @@
 #include <fiddle/interaction/interaction_utilities.h>
 
 FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/utilities.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <deal.II/dofs/dof_handler.h>
+
 #include <deal.II/fe/mapping_fe_field.h>
 
 #include <deal.II/grid/grid_tools.h>
@@ -15,7 +18,10 @@ FDL_ENABLE_EXTRA_DIAGNOSTICS
 #include <CartesianPatchGeometry.h>
 #include <PatchHierarchy.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <map>
 #include <numeric>
 
 namespace fdl
@@ -32,14 +38,30 @@ namespace fdl
     , min_n_points_1D(min_n_points_1D)
     , point_density(point_density)
     , density_kind(density_kind)
+    , quadrature_hysteresis(0.0)
+    , cached_eulerian_length(0.0)
+    , cached_native_tria(nullptr)
+    , anisotropic_quadrature(false)
+    , use_interaction_plan(true)
+    , interaction_plan_tolerance(0.0)
+    , interaction_plan_compression(0.0)
+    , n_spread_threads(1)
+    , sort_spread_points(false)
+    , spread_cutoff(0.0)
+    , n_interpolation_threads(1)
+    , store_plan_weights(false)
+    , spread_weak_force(false)
+    , interaction_plans(1)
+    , use_interaction_operator(false)
+    , interaction_operator_tolerance(0.0)
   {}
 
   template <int dim, int spacedim>
   ElementalInteraction<dim, spacedim>::ElementalInteraction(
     const tbox::Pointer<tbox::Database>                  &input_db,
     const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-    const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
-    const std::vector<float>                             &active_cell_lengths,
+    const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
+    const ArrayView<const float>                         &active_cell_lengths,
     tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
     const std::pair<int, int>                            &level_numbers,
     const unsigned int                                    min_n_points_1D,
@@ -62,10 +84,11 @@ namespace fdl
   ElementalInteraction<dim, spacedim>::reinit(
     const tbox::Pointer<tbox::Database>                  &input_db,
     const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-    const std::vector<BoundingBox<spacedim, float>> &global_active_cell_bboxes,
-    const std::vector<float>                        &active_cell_lengths,
-    tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
-    const std::pair<int, int>                       &level_numbers)
+    const ArrayView<const BoundingBox<spacedim, float>>
+      &global_active_cell_bboxes,
+    const ArrayView<const float>                  &active_cell_lengths,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>>  patch_hierarchy,
+    const std::pair<int, int>                     &level_numbers)
   {
     InteractionBase<dim, spacedim>::reinit(input_db,
                                            native_tria,
@@ -75,6 +98,61 @@ namespace fdl
                                            level_numbers);
     Assert(level_numbers.first == level_numbers.second, ExcFDLNotImplemented());
 
+    // The plans depend on the PatchMap we are about to recompute
+    const int n_plans =
+      input_db->getIntegerWithDefault("n_cached_interaction_plans", 1);
+    AssertThrow(n_plans > 0,
+                ExcMessage("At least one interaction plan should be "
+                           "cached."));
+    interaction_plans.clear();
+    interaction_plans.resize(n_plans);
+    use_interaction_plan =
+      input_db->getBoolWithDefault("use_interaction_plan", true);
+    interaction_plan_tolerance =
+      input_db->getDoubleWithDefault("interaction_plan_tolerance", 0.0);
+    AssertThrow(interaction_plan_tolerance >= 0.0,
+                ExcMessage("The interaction plan tolerance should be "
+                           "nonnegative."));
+    interaction_plan_compression =
+      input_db->getDoubleWithDefault("interaction_plan_compression", 0.0);
+    AssertThrow(0.0 <= interaction_plan_compression &&
+                  interaction_plan_compression <= 1.0,
+                ExcMessage("The interaction plan compression should be in "
+                           "[0, 1]."));
+    const int n_threads =
+      input_db->getIntegerWithDefault("n_spread_threads", 1);
+    AssertThrow(n_threads > 0,
+                ExcMessage("The number of spreading threads should be "
+                           "positive."));
+    n_spread_threads = n_threads;
+    sort_spread_points =
+      input_db->getBoolWithDefault("sort_spread_points", false);
+    spread_cutoff = input_db->getDoubleWithDefault("spread_cutoff", 0.0);
+    AssertThrow(0.0 <= spread_cutoff && spread_cutoff < 1.0,
+                ExcMessage("The spread cutoff should be in [0, 1)."));
+    const int n_interp_threads =
+      input_db->getIntegerWithDefault("n_interpolation_threads", 1);
+    AssertThrow(n_interp_threads > 0,
+                ExcMessage("The number of interpolation threads should be "
+                           "positive."));
+    n_interpolation_threads = n_interp_threads;
+    store_plan_weights =
+      input_db->getBoolWithDefault("store_plan_weights", false);
+    spread_weak_force =
+      input_db->getBoolWithDefault("spread_weak_force", false);
+    // Like the plans, the operators depend on the PatchMap
+    interaction_operators.clear();
+    use_interaction_operator =
+      input_db->getBoolWithDefault("use_interaction_operator", false);
+    interaction_operator_tolerance =
+      input_db->getDoubleWithDefault("interaction_operator_tolerance", 0.0);
+    AssertThrow(!use_interaction_operator || use_interaction_plan,
+                ExcMessage("Interaction operators require interaction "
+                           "plans."));
+    AssertThrow(interaction_operator_tolerance >= 0.0,
+                ExcMessage("The interaction operator tolerance should be "
+                           "nonnegative."));
+
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
     for (int ln = level_numbers.first; ln <= level_numbers.second; ++ln)
       {
@@ -94,67 +172,80 @@ namespace fdl
       //
       // TODO - we should refactor this into a more general function so we can
       // test it
-      std::vector<CellId> bbox_cellids;
-      for (const auto &cell : this->overlap_tria.active_cell_iterators())
-        bbox_cellids.push_back(this->overlap_tria.get_native_cell_id(cell));
-
-      // 1. Figure out who owns the bounding boxes we need:
-      std::vector<types::subdomain_id> ranks =
-        GridTools::get_subdomain_association(*this->native_tria, bbox_cellids);
-
-      // 2. Send each processor the list of bboxes we need:
-      std::map<types::subdomain_id,
-               std::vector<std::pair<unsigned int, CellId>>>
-        corresponding_requested_cellids;
-      // Keep the overlap active cell index along for the ride
-      for (unsigned int i = 0; i < ranks.size(); ++i)
-        corresponding_requested_cellids[ranks[i]].emplace_back(i,
-                                                               bbox_cellids[i]);
-
-      const std::map<types::subdomain_id,
-                     std::vector<std::pair<unsigned int, CellId>>>
-        corresponding_cellids_to_send =
-          Utilities::MPI::some_to_some(this->communicator,
-                                       corresponding_requested_cellids);
-
-      // 3. Send each processor the actual bboxes:
-      std::map<
-        types::subdomain_id,
-        std::vector<std::pair<unsigned int, BoundingBox<spacedim, float>>>>
-        requested_bboxes;
-      for (const auto &pair : corresponding_cellids_to_send)
+      //
+      // If we already received the bboxes when setting up the overlap
+      // triangulation then there is nothing to do. This check has to be
+      // consistent across processors since the alternative is collective.
+      std::vector<BoundingBox<spacedim, float>> overlap_bboxes =
+        this->overlap_active_cell_bboxes;
+      if (!input_db->getBoolWithDefault("distributed_bbox_exchange", false))
         {
-          const auto  rank                = pair.first;
-          const auto &indices_and_cellids = pair.second;
-
-          auto &bboxes = requested_bboxes[rank];
-          for (const auto &index_and_cellid : indices_and_cellids)
+          std::vector<CellId> bbox_cellids;
+          for (const auto &cell : this->overlap_tria.active_cell_iterators())
+            bbox_cellids.push_back(
+              this->overlap_tria.get_native_cell_id(cell));
+
+          // 1. Figure out who owns the bounding boxes we need:
+          std::vector<types::subdomain_id> ranks =
+            GridTools::get_subdomain_association(*this->native_tria,
+                                                 bbox_cellids);
+
+          // 2. Send each processor the list of bboxes we need:
+          std::map<types::subdomain_id,
+                   std::vector<std::pair<unsigned int, CellId>>>
+            corresponding_requested_cellids;
+          // Keep the overlap active cell index along for the ride
+          for (unsigned int i = 0; i < ranks.size(); ++i)
+            corresponding_requested_cellids[ranks[i]].emplace_back(
+              i, bbox_cellids[i]);
+
+          const std::map<types::subdomain_id,
+                         std::vector<std::pair<unsigned int, CellId>>>
+            corresponding_cellids_to_send =
+              Utilities::MPI::some_to_some(this->communicator,
+                                           corresponding_requested_cellids);
+
+          // 3. Send each processor the actual bboxes:
+          std::map<types::subdomain_id,
+                   std::vector<
+                     std::pair<unsigned int, BoundingBox<spacedim, float>>>>
+            requested_bboxes;
+          for (const auto &pair : corresponding_cellids_to_send)
             {
-              auto it = this->native_tria->create_cell_iterator(
-                index_and_cellid.second);
-              bboxes.emplace_back(
-                index_and_cellid.first,
-                global_active_cell_bboxes[it->active_cell_index()]);
+              const auto  rank                = pair.first;
+              const auto &indices_and_cellids = pair.second;
+
+              auto &bboxes = requested_bboxes[rank];
+              for (const auto &index_and_cellid : indices_and_cellids)
+                {
+                  auto it = this->native_tria->create_cell_iterator(
+                    index_and_cellid.second);
+                  bboxes.emplace_back(
+                    index_and_cellid.first,
+                    global_active_cell_bboxes[it->active_cell_index()]);
+                }
             }
-        }
-
-      const auto received_bboxes =
-        Utilities::MPI::some_to_some(this->communicator, requested_bboxes);
 
-      std::vector<BoundingBox<spacedim, float>> overlap_bboxes(
-        this->overlap_tria.n_active_cells());
-      for (const auto &pair : received_bboxes)
-        for (const auto &index_and_bbox : pair.second)
-          {
-            AssertIndexRange(index_and_bbox.first, overlap_bboxes.size());
-            overlap_bboxes[index_and_bbox.first] = index_and_bbox.second;
-          }
+          const auto received_bboxes =
+            Utilities::MPI::some_to_some(this->communicator,
+                                         requested_bboxes);
+
+          overlap_bboxes.resize(this->overlap_tria.n_active_cells());
+          for (const auto &pair : received_bboxes)
+            for (const auto &index_and_bbox : pair.second)
+              {
+                AssertIndexRange(index_and_bbox.first, overlap_bboxes.size());
+                overlap_bboxes[index_and_bbox.first] = index_and_bbox.second;
+              }
+        }
 
       patch_map.reinit(patches,
                        input_db->getDoubleWithDefault("ghost_cell_fraction",
                                                       1.0),
                        this->overlap_tria,
-                       overlap_bboxes);
+                       overlap_bboxes,
+                       input_db->getBoolWithDefault("sort_patch_cells",
+                                                    false));
     }
 
     // We need to implement some more quadrature families
@@ -183,25 +274,141 @@ namespace fdl
     const double eulerian_length =
       Utilities::MPI::min(patch_dx_min, this->communicator);
 
+    // Set up the cache of quadrature indices:
+    quadrature_hysteresis =
+      input_db->getDoubleWithDefault("quadrature_hysteresis", 0.0);
+    AssertThrow(quadrature_hysteresis >= 0.0,
+                ExcMessage("The quadrature hysteresis should be "
+                           "nonnegative."));
+    if (cached_native_tria != &native_tria)
+      {
+        cached_native_tria     = &native_tria;
+        native_tria_connection = native_tria.signals.any_change.connect(
+          [this]() { cached_quadrature_cell_lengths.clear(); });
+        cached_quadrature_cell_lengths.clear();
+      }
+    if (cached_eulerian_length != eulerian_length ||
+        cached_quadrature_cell_lengths.size() != native_tria.n_active_cells())
+      {
+        cached_eulerian_length = eulerian_length;
+        cached_quadrature_cell_lengths.assign(native_tria.n_active_cells(),
+                                              -1.0f);
+        cached_quadrature_indices.assign(native_tria.n_active_cells(), 0);
+      }
+
+    anisotropic_quadrature =
+      input_db->getBoolWithDefault("anisotropic_quadrature", false);
+    if (anisotropic_quadrature)
+      {
+        AssertThrow(reference_cells.front() ==
+                      ReferenceCells::get_hypercube<dim>(),
+                    ExcMessage("Anisotropic quadrature is only supported for "
+                               "quadrilaterals and hexahedra."));
+        for (unsigned int d = 0; d < dim; ++d)
+          AssertThrow(reference_direction_lengths[d].size() ==
+                        native_tria.n_active_cells(),
+                      ExcMessage("set_reference_direction_lengths() must be "
+                                 "called before reinit() with a length for "
+                                 "each active cell."));
+
+        // The quadrature indices number the distinct rules in order of first
+        // appearance, so they still fit in the rest of the interaction code
+        const QGaussAnisotropicFamily<dim> family(min_n_points_1D,
+                                                  point_density);
+        std::map<std::array<unsigned char, dim>, unsigned char> rule_indices;
+        quadrature_indices.resize(0);
+        quadratures.clear();
+        for (const auto &cell : this->overlap_tria.active_cell_iterators())
+          {
+            const auto native_index =
+              this->overlap_tria.get_native_cell(cell)->active_cell_index();
+            std::array<double, dim> lagrangian_lengths;
+            for (unsigned int d = 0; d < dim; ++d)
+              lagrangian_lengths[d] =
+                reference_direction_lengths[d][native_index];
+            const std::array<unsigned char, dim> n_points =
+              family.get_n_points(eulerian_length, lagrangian_lengths);
+            const auto it = rule_indices.find(n_points);
+            if (it == rule_indices.end())
+              {
+                AssertThrow(quadratures.size() <=
+                              std::numeric_limits<unsigned char>::max(),
+                            ExcMessage("There are too many distinct "
+                                       "anisotropic quadrature rules."));
+                const auto index =
+                  static_cast<unsigned char>(quadratures.size());
+                rule_indices[n_points] = index;
+                quadratures.push_back(family.get_quadrature(n_points));
+                quadrature_indices.push_back(index);
+              }
+            else
+              quadrature_indices.push_back(it->second);
+          }
+        return;
+      }
+
+    // Compute every rule we could need up front so that the lookups below
+    // (and any later ones) do not modify the family:
+    float max_lagrangian_length = 0.0f;
+    for (const auto &cell : this->overlap_tria.active_cell_iterators())
+      max_lagrangian_length = std::max(
+        max_lagrangian_length,
+        active_cell_lengths
+          [this->overlap_tria.get_native_cell(cell)->active_cell_index()]);
+    if (max_lagrangian_length > 0.0f)
+      quadrature_family->precompute(eulerian_length, max_lagrangian_length);
+
     // Determine which quadrature rule we should use on each cell:
     quadrature_indices.resize(0);
     for (const auto &cell : this->overlap_tria.active_cell_iterators())
       {
-        const auto   native_cell = this->overlap_tria.get_native_cell(cell);
-        const double lagrangian_length =
-          active_cell_lengths[native_cell->active_cell_index()];
-        quadrature_indices.push_back(
-          quadrature_family->get_index(eulerian_length, lagrangian_length));
+        const auto native_index =
+          this->overlap_tria.get_native_cell(cell)->active_cell_index();
+        const float lagrangian_length = active_cell_lengths[native_index];
+        const float cached_length =
+          cached_quadrature_cell_lengths[native_index];
+        if (cached_length < 0.0f ||
+            std::abs(lagrangian_length - cached_length) >
+              quadrature_hysteresis * cached_length)
+          {
+            cached_quadrature_indices[native_index] =
+              quadrature_family->get_index(eulerian_length, lagrangian_length);
+            cached_quadrature_cell_lengths[native_index] = lagrangian_length;
+          }
+        quadrature_indices.push_back(cached_quadrature_indices[native_index]);
       }
 
-    // Store quadratures in a vector:
+    // Store quadratures in a vector. With hysteresis the set of rules
+    // typically does not change between regrids, so only copy new ones:
     unsigned char max_quadrature_index = 0;
     if (quadrature_indices.size() > 0)
       max_quadrature_index =
         *std::max_element(quadrature_indices.begin(), quadrature_indices.end());
-    quadratures.resize(0);
-    for (unsigned char i = 0; i <= max_quadrature_index; ++i)
-      quadratures.push_back((*quadrature_family)[i]);
+    quadratures.resize(
+      std::min<std::size_t>(quadratures.size(), max_quadrature_index + 1));
+    for (std::size_t i = quadratures.size(); i <= max_quadrature_index; ++i)
+      quadratures.push_back(
+        (*quadrature_family)[static_cast<unsigned char>(i)]);
+  }
+
+  template <int dim, int spacedim>
+  void
+  ElementalInteraction<dim, spacedim>::set_reference_direction_lengths(
+    std::array<std::vector<float>, dim> lengths)
+  {
+    reference_direction_lengths = std::move(lengths);
+  }
+
+  template <int dim, int spacedim>
+  void
+  ElementalInteraction<dim, spacedim>::add_dof_handler(
+    const DoFHandler<dim, spacedim> &native_dof_handler)
+  {
+    InteractionBase<dim, spacedim>::add_dof_handler(native_dof_handler);
+    // The overlap DoFs only change when this object is reinitialized, so we
+    // can look up the DoF indices of every cell once here
+    patch_map.cache_dof_indices(
+      this->get_overlap_dof_handler(native_dof_handler));
   }
 
   template <int dim, int spacedim>
@@ -211,11 +418,76 @@ namespace fdl
     return false;
   }
 
+  template <int dim, int spacedim>
+  bool
+  ElementalInteraction<dim, spacedim>::spreads_weak_force() const
+  {
+    return spread_weak_force;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  ElementalInteraction<dim, spacedim>::supports_multiple_fields() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  ElementalInteraction<dim, spacedim>::supports_single_precision() const
+  {
+    return true;
+  }
+
   template <int dim, int spacedim>
   std::unique_ptr<TransactionBase>
   ElementalInteraction<dim, spacedim>::compute_projection_rhs_intermediate(
     std::unique_ptr<TransactionBase> t_ptr) const
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Interpolation),
+               ExcMessage("Transaction operation should be Interpolation"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::Intermediate),
+               ExcMessage("Transaction state should be Intermediate"));
+
+        std::vector<const DoFHandler<dim, spacedim> *> dof_handlers;
+        std::vector<const Mapping<dim, spacedim> *>    mappings;
+        std::vector<Vector<double> *>                  rhs;
+        for (std::size_t field_n = 0;
+             field_n < multi_trans->data_indices.size();
+             ++field_n)
+          {
+            dof_handlers.push_back(&this->get_overlap_dof_handler(
+              *multi_trans->native_dof_handlers[field_n]));
+            mappings.push_back(multi_trans->mappings[field_n]);
+            rhs.push_back(&multi_trans->overlap_rhs[field_n]);
+          }
+
+        compute_projection_rhs(multi_trans->kernel_name,
+                               multi_trans->data_indices,
+                               patch_map,
+                               get_interaction_plan(
+                                 this->get_overlap_dof_handler(
+                                   *multi_trans->native_position_dof_handler),
+                                 multi_trans->overlap_position,
+                                 dof_handlers.size() > 0 ? dof_handlers[0] :
+                                                           nullptr,
+                                 mappings.size() > 0 ? mappings[0] : nullptr),
+                               quadrature_indices,
+                               quadratures,
+                               dof_handlers,
+                               mappings,
+                               rhs);
+
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::AccumulateStart;
+        return t_ptr;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Interpolation),
@@ -224,21 +496,60 @@ namespace fdl
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-      trans.overlap_position);
-
+    const DoFHandler<dim, spacedim> &overlap_position_dof_handler =
+      this->get_overlap_dof_handler(*trans.native_position_dof_handler);
     // Actually do the interpolation:
-    compute_projection_rhs(trans.kernel_name,
-                           trans.current_data_idx,
-                           patch_map,
-                           position_mapping,
-                           quadrature_indices,
-                           quadratures,
-                           this->get_overlap_dof_handler(
-                             *trans.native_dof_handler),
-                           *trans.mapping,
-                           trans.overlap_rhs);
+    auto do_projection = [&](auto &overlap_rhs)
+    {
+      if (use_interaction_operator)
+        compute_projection_rhs(get_interaction_operator(
+                                 trans.kernel_name,
+                                 trans.current_data_idx,
+                                 overlap_position_dof_handler,
+                                 trans.overlap_position,
+                                 this->get_overlap_dof_handler(
+                                   *trans.native_dof_handler),
+                                 *trans.mapping),
+                               patch_map,
+                               overlap_rhs);
+      else if (use_interaction_plan)
+        compute_projection_rhs(trans.kernel_name,
+                               trans.current_data_idx,
+                               patch_map,
+                               get_interaction_plan(
+                                 overlap_position_dof_handler,
+                                 trans.overlap_position,
+                                 &this->get_overlap_dof_handler(
+                                   *trans.native_dof_handler),
+                                 trans.mapping),
+                               quadrature_indices,
+                               quadratures,
+                               this->get_overlap_dof_handler(
+                                 *trans.native_dof_handler),
+                               *trans.mapping,
+                               overlap_rhs);
+      else
+        {
+          MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+            overlap_position_dof_handler, trans.overlap_position);
+
+          compute_projection_rhs(trans.kernel_name,
+                                 trans.current_data_idx,
+                                 patch_map,
+                                 position_mapping,
+                                 quadrature_indices,
+                                 quadratures,
+                                 this->get_overlap_dof_handler(
+                                   *trans.native_dof_handler),
+                                 *trans.mapping,
+                                 overlap_rhs,
+                                 n_interpolation_threads);
+        }
+    };
+    if (trans.single_precision)
+      do_projection(trans.float_overlap_rhs);
+    else
+      do_projection(trans.overlap_rhs);
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateStart;
 
@@ -250,6 +561,49 @@ namespace fdl
   ElementalInteraction<dim, spacedim>::compute_spread_intermediate(
     std::unique_ptr<TransactionBase> t_ptr)
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Spreading),
+               ExcMessage("Transaction operation should be Spreading"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::Intermediate),
+               ExcMessage("Transaction state should be Intermediate"));
+
+        std::vector<const DoFHandler<dim, spacedim> *> dof_handlers;
+        std::vector<const Mapping<dim, spacedim> *>    mappings;
+        std::vector<const Vector<double> *>            solutions;
+        for (std::size_t field_n = 0;
+             field_n < multi_trans->data_indices.size();
+             ++field_n)
+          {
+            dof_handlers.push_back(&this->get_overlap_dof_handler(
+              *multi_trans->native_dof_handlers[field_n]));
+            mappings.push_back(multi_trans->mappings[field_n]);
+            solutions.push_back(&multi_trans->overlap_solutions[field_n]);
+          }
+
+        compute_spread(multi_trans->kernel_name,
+                       multi_trans->data_indices,
+                       patch_map,
+                       get_interaction_plan(
+                         this->get_overlap_dof_handler(
+                           *multi_trans->native_position_dof_handler),
+                         multi_trans->overlap_position,
+                         dof_handlers[0],
+                         mappings[0]),
+                       quadrature_indices,
+                       quadratures,
+                       dof_handlers,
+                       mappings,
+                       solutions);
+
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::AccumulateFinish;
+        return t_ptr;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Spreading),
@@ -258,20 +612,67 @@ namespace fdl
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-      trans.overlap_position);
-
+    const DoFHandler<dim, spacedim> &overlap_position_dof_handler =
+      this->get_overlap_dof_handler(*trans.native_position_dof_handler);
     // Actually do the spreading:
-    compute_spread(trans.kernel_name,
-                   trans.current_data_idx,
-                   patch_map,
-                   position_mapping,
-                   quadrature_indices,
-                   quadratures,
-                   this->get_overlap_dof_handler(*trans.native_dof_handler),
-                   *trans.mapping,
-                   trans.overlap_solution);
+    auto do_spread = [&](const auto &overlap_solution)
+    {
+      if (use_interaction_operator)
+        compute_spread(get_interaction_operator(
+                         trans.kernel_name,
+                         trans.current_data_idx,
+                         overlap_position_dof_handler,
+                         trans.overlap_position,
+                         this->get_overlap_dof_handler(
+                           *trans.native_dof_handler),
+                         *trans.mapping),
+                       patch_map,
+                       overlap_solution,
+                       n_spread_threads);
+      else if (use_interaction_plan)
+        compute_spread(trans.kernel_name,
+                       trans.current_data_idx,
+                       patch_map,
+                       get_interaction_plan(overlap_position_dof_handler,
+                                            trans.overlap_position,
+                                            &this->get_overlap_dof_handler(
+                                              *trans.native_dof_handler),
+                                            trans.mapping),
+                       quadrature_indices,
+                       quadratures,
+                       this->get_overlap_dof_handler(
+                         *trans.native_dof_handler),
+                       *trans.mapping,
+                       overlap_solution,
+                       n_spread_threads,
+                       sort_spread_points,
+                       spread_cutoff,
+                       &spread_cutoff_statistics);
+      else
+        {
+          MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+            overlap_position_dof_handler, trans.overlap_position);
+
+          compute_spread(trans.kernel_name,
+                         trans.current_data_idx,
+                         patch_map,
+                         position_mapping,
+                         quadrature_indices,
+                         quadratures,
+                         this->get_overlap_dof_handler(
+                           *trans.native_dof_handler),
+                         *trans.mapping,
+                         overlap_solution,
+                         n_spread_threads,
+                         sort_spread_points,
+                         spread_cutoff,
+                         &spread_cutoff_statistics);
+        }
+    };
+    if (trans.single_precision)
+      do_spread(trans.float_overlap_solution);
+    else
+      do_spread(trans.overlap_solution);
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateFinish;
 
@@ -292,15 +693,30 @@ namespace fdl
     trans.position_scatter.global_to_overlap_finish(*trans.native_position,
                                                     trans.overlap_position);
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-      trans.overlap_position);
-
-    count_quadrature_points(trans.workload_index,
-                            patch_map,
-                            position_mapping,
-                            quadrature_indices,
-                            quadratures);
+    const DoFHandler<dim, spacedim> &overlap_position_dof_handler =
+      this->get_overlap_dof_handler(*trans.native_position_dof_handler);
+    // The plan's quadrature points are typically reused by the next
+    // interpolation, which is at the same position
+    if (use_interaction_plan)
+      count_quadrature_points(trans.workload_index,
+                              patch_map,
+                              get_interaction_plan(overlap_position_dof_handler,
+                                                   trans.overlap_position),
+                              this->workload_point_weight,
+                              this->workload_cell_weight);
+    else
+      {
+        MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+          overlap_position_dof_handler, trans.overlap_position);
+
+        count_quadrature_points(trans.workload_index,
+                                patch_map,
+                                position_mapping,
+                                quadrature_indices,
+                                quadratures,
+                                this->workload_point_weight,
+                                this->workload_cell_weight);
+      }
 
     trans.next_state =
       WorkloadTransaction<dim, spacedim>::State::AccumulateFinish;
@@ -310,6 +726,27 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::pair<double, double>
+  ElementalInteraction<dim, spacedim>::count_local_interaction_work()
+  {
+    double n_points = 0.0;
+    double n_cells  = 0.0;
+    for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      for (std::size_t cell_n = 0; cell_n < patch_map.n_cells(patch_n);
+           ++cell_n)
+        {
+          const auto cell = patch_map.get_cell(patch_n, cell_n);
+          n_points +=
+            quadratures[quadrature_indices[cell->active_cell_index()]].size();
+          n_cells += 1.0;
+        }
+
+    return {n_points, n_cells};
+  }
+
+
+
   template <int dim, int spacedim>
   VectorOperation::values
   ElementalInteraction<dim, spacedim>::get_rhs_scatter_type() const
@@ -319,6 +756,128 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  const InteractionPlan<dim, spacedim> &
+  ElementalInteraction<dim, spacedim>::get_interaction_plan(
+    const DoFHandler<dim, spacedim> &overlap_position_dof_handler,
+    const Vector<double>            &overlap_position,
+    const DoFHandler<dim, spacedim> *overlap_dof_handler,
+    const Mapping<dim, spacedim>    *mapping) const
+  {
+    Assert(interaction_plans.size() > 0, ExcFDLInternalError());
+    // Move the plan we are about to use (either a valid one or the least
+    // recently used one, which we will recompute) to the front:
+    auto plan_it = std::find_if(interaction_plans.begin(),
+                                interaction_plans.end(),
+                                [&](const InteractionPlan<dim, spacedim> &plan)
+                                {
+                                  return plan.is_valid_for(
+                                    overlap_position,
+                                    interaction_plan_tolerance);
+                                });
+    const bool plan_is_valid = plan_it != interaction_plans.end();
+    if (!plan_is_valid)
+      plan_it = interaction_plans.end() - 1;
+    std::rotate(interaction_plans.begin(), plan_it, plan_it + 1);
+    InteractionPlan<dim, spacedim> &interaction_plan = interaction_plans[0];
+
+    // The JxW values (since they only depend on the PatchMap) of a recycled
+    // plan are still valid
+    if (!plan_is_valid)
+      compute_interaction_plan(patch_map,
+                               overlap_position_dof_handler,
+                               overlap_position,
+                               quadrature_indices,
+                               quadratures,
+                               interaction_plan);
+    if (interaction_plan_compression > 0.0 && !interaction_plan.is_compressed())
+      compress_interaction_plan(patch_map,
+                                interaction_plan_compression,
+                                interaction_plan);
+    // The weights do not depend on the position so they are only recomputed
+    // when the mapping changes
+    if (store_plan_weights && overlap_dof_handler && mapping &&
+        !interaction_plan.has_weights_for(*mapping))
+      compute_interaction_plan_weights(patch_map,
+                                       *overlap_dof_handler,
+                                       *mapping,
+                                       quadrature_indices,
+                                       quadratures,
+                                       interaction_plan);
+
+    return interaction_plan;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const InteractionOperator<dim, spacedim> &
+  ElementalInteraction<dim, spacedim>::get_interaction_operator(
+    const std::string               &kernel_name,
+    const int                        data_index,
+    const DoFHandler<dim, spacedim> &overlap_position_dof_handler,
+    const Vector<double>            &overlap_position,
+    const DoFHandler<dim, spacedim> &overlap_dof_handler,
+    const Mapping<dim, spacedim>    &mapping) const
+  {
+    auto op_it =
+      std::find_if(interaction_operators.begin(),
+                   interaction_operators.end(),
+                   [&](const InteractionOperator<dim, spacedim> &op)
+                   {
+                     return op.is_for(kernel_name,
+                                      data_index,
+                                      overlap_dof_handler,
+                                      mapping);
+                   });
+    if (op_it == interaction_operators.end())
+      {
+        interaction_operators.emplace_back();
+        op_it = interaction_operators.end() - 1;
+      }
+
+    if (!op_it->is_valid_for(overlap_position, interaction_operator_tolerance))
+      compute_interaction_operator(kernel_name,
+                                   data_index,
+                                   patch_map,
+                                   get_interaction_plan(
+                                     overlap_position_dof_handler,
+                                     overlap_position,
+                                     &overlap_dof_handler,
+                                     &mapping),
+                                   quadrature_indices,
+                                   quadratures,
+                                   overlap_dof_handler,
+                                   mapping,
+                                   *op_it);
+
+    return *op_it;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  ElementalInteraction<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t n_bytes =
+      InteractionBase<dim, spacedim>::memory_consumption() +
+      patch_map.memory_consumption() +
+      MemoryConsumption::memory_consumption(quadrature_indices) +
+      MemoryConsumption::memory_consumption(quadratures) +
+      MemoryConsumption::memory_consumption(cached_quadrature_cell_lengths) +
+      MemoryConsumption::memory_consumption(cached_quadrature_indices) +
+      MemoryConsumption::memory_consumption(reference_direction_lengths);
+    for (const InteractionPlan<dim, spacedim> &plan : interaction_plans)
+      n_bytes += plan.memory_consumption();
+    for (const InteractionOperator<dim, spacedim> &op : interaction_operators)
+      n_bytes += op.memory_consumption();
+
+    return n_bytes;
+  }
+
+
+
   // instantiations
   template class ElementalInteraction<NDIM - 1, NDIM>;
   template class ElementalInteraction<NDIM, NDIM>;
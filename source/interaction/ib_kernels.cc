@@ -0,0 +1,1032 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/ib_kernels.h>
+
+#include <ibtk/IndexUtilities.h>
+#include <ibtk/LEInteractor.h>
+
+#include <ArrayData.h>
+#include <Box.h>
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <EdgeData.h>
+#include <NodeData.h>
+#include <Patch.h>
+#include <SideData.h>
+#include <tbox/Pointer.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  namespace
+  {
+    //
+    // Kernels. Each one provides its width (the number of points in the
+    // stencil in each coordinate direction) and its value as a function of the
+    // distance, in units of the grid spacing, to the point.
+    //
+
+    struct PiecewiseLinearKernel
+    {
+      static constexpr int width = 2;
+
+      static double
+      value(const double r)
+      {
+        const double a = std::abs(r);
+        return a < 1.0 ? 1.0 - a : 0.0;
+      }
+    };
+
+    struct IB3Kernel
+    {
+      static constexpr int width = 3;
+
+      static double
+      value(const double r)
+      {
+        const double a = std::abs(r);
+        if (a < 0.5)
+          return (1.0 + std::sqrt(1.0 - 3.0 * a * a)) / 3.0;
+        else if (a < 1.5)
+          return (5.0 - 3.0 * a -
+                  std::sqrt(std::max(0.0,
+                                     1.0 - 3.0 * (1.0 - a) * (1.0 - a)))) /
+                 6.0;
+        return 0.0;
+      }
+    };
+
+    struct IB4Kernel
+    {
+      static constexpr int width = 4;
+
+      static double
+      value(const double r)
+      {
+        const double a = std::abs(r);
+        if (a < 1.0)
+          return (3.0 - 2.0 * a + std::sqrt(1.0 + 4.0 * a - 4.0 * a * a)) /
+                 8.0;
+        else if (a < 2.0)
+          return (5.0 - 2.0 * a -
+                  std::sqrt(std::max(0.0, -7.0 + 12.0 * a - 4.0 * a * a))) /
+                 8.0;
+        return 0.0;
+      }
+    };
+
+    struct BSpline3Kernel
+    {
+      static constexpr int width = 3;
+
+      static double
+      value(const double r)
+      {
+        const double a = std::abs(r);
+        if (a < 0.5)
+          return 0.75 - a * a;
+        else if (a < 1.5)
+          return 0.5 * (1.5 - a) * (1.5 - a);
+        return 0.0;
+      }
+    };
+
+    struct BSpline4Kernel
+    {
+      static constexpr int width = 4;
+
+      static double
+      value(const double r)
+      {
+        const double a = std::abs(r);
+        if (a < 1.0)
+          return 2.0 / 3.0 - a * a + 0.5 * a * a * a;
+        else if (a < 2.0)
+          return (2.0 - a) * (2.0 - a) * (2.0 - a) / 6.0;
+        return 0.0;
+      }
+    };
+
+    /**
+     * Stencil of a kernel around a single point in a single array.
+     */
+    template <typename Kernel, int spacedim>
+    struct Stencil
+    {
+      /**
+       * Offset of the first entry of the stencil in the array. Only valid
+       * when the stencil is completely contained in the array.
+       */
+      int offset;
+
+      /**
+       * Whether or not the stencil is completely contained in the array.
+       */
+      bool contained;
+
+      /**
+       * First index of the stencil in each coordinate direction, relative to
+       * the lower corner of the array.
+       */
+      std::array<int, spacedim> first;
+
+      /**
+       * Weights in each coordinate direction.
+       */
+      double weights[spacedim][Kernel::width];
+    };
+
+    /**
+     * Information about a SAMRAI array we need to compute stencils.
+     */
+    template <int spacedim>
+    struct ArrayInfo
+    {
+      ArrayInfo(const pdat::ArrayData<spacedim, double> &array,
+                const hier::Box<spacedim>               &patch_box,
+                const double *const                      x_lower,
+                const double *const                      dx,
+                const int                                side_axis)
+      {
+        const hier::Box<spacedim> &array_box = array.getBox();
+        int                        stride    = 1;
+        for (int d = 0; d < spacedim; ++d)
+          {
+            strides[d] = stride;
+            sizes[d]   = array_box.upper(d) - array_box.lower(d) + 1;
+            stride *= sizes[d];
+            // index i is located at x_lower + (i - ilower + shift) * dx, where
+            // shift is 0.5 for cell centers and 0 for sides, so we can convert
+            // a coordinate into a position in index space relative to the
+            // array's lower corner
+            lower[d]       = x_lower[d];
+            inverse_dx[d]  = 1.0 / dx[d];
+            index_shift[d] = double(patch_box.lower(d) - array_box.lower(d)) -
+                             (d == side_axis ? 0.0 : 0.5);
+          }
+      }
+
+      std::array<int, spacedim>    strides;
+      std::array<int, spacedim>    sizes;
+      std::array<double, spacedim> lower;
+      std::array<double, spacedim> inverse_dx;
+      std::array<double, spacedim> index_shift;
+    };
+
+    // Compute the first index and the weights of a stencil in coordinate
+    // direction @p d.
+    template <typename Kernel, int spacedim>
+    void
+    compute_stencil_1d(const ArrayInfo<spacedim> &info,
+                       const double *const        X,
+                       const int                  d,
+                       int                       &first,
+                       double *const              weights)
+    {
+      constexpr int width = Kernel::width;
+      const double  s =
+        (X[d] - info.lower[d]) * info.inverse_dx[d] + info.index_shift[d];
+      // Even-width stencils use the width / 2 points on either side of X.
+      // Odd-width stencils are centered on the nearest point.
+      first = width % 2 == 0 ? int(std::floor(s)) - width / 2 + 1 :
+                               int(std::floor(s + 0.5)) - width / 2;
+      for (int k = 0; k < width; ++k)
+        weights[k] = Kernel::value(double(first + k) - s);
+    }
+
+    // Compute the offset of a stencil whose first indices are already known.
+    template <typename Kernel, int spacedim>
+    void
+    compute_stencil_offset(const ArrayInfo<spacedim> &info,
+                           Stencil<Kernel, spacedim> &stencil)
+    {
+      constexpr int width = Kernel::width;
+      stencil.offset      = 0;
+      stencil.contained   = true;
+      for (int d = 0; d < spacedim; ++d)
+        {
+          const int first = stencil.first[d];
+          stencil.offset += first * info.strides[d];
+          stencil.contained = stencil.contained && first >= 0 &&
+                              first + width <= info.sizes[d];
+        }
+    }
+
+    template <typename Kernel, int spacedim>
+    void
+    compute_stencil(const ArrayInfo<spacedim> &info,
+                    const double *const        X,
+                    Stencil<Kernel, spacedim> &stencil)
+    {
+      for (int d = 0; d < spacedim; ++d)
+        compute_stencil_1d<Kernel>(
+          info, X, d, stencil.first[d], stencil.weights[d]);
+      compute_stencil_offset(info, stencil);
+    }
+
+    // Compute the sum of the stencil weights times the array values.
+    template <typename Kernel, int spacedim>
+    double
+    apply_stencil(const ArrayInfo<spacedim>       &info,
+                  const Stencil<Kernel, spacedim> &stencil,
+                  const double *const              data)
+    {
+      constexpr int width  = Kernel::width;
+      double        result = 0.0;
+      if (stencil.contained)
+        {
+          // Fast path: the stencil has a fixed size so these loops can be
+          // completely unrolled and vectorized.
+          const double *const base = data + stencil.offset;
+          if (spacedim == 2)
+            {
+              for (int j = 0; j < width; ++j)
+                {
+                  const double *const row = base + j * info.strides[1];
+                  double              sum = 0.0;
+                  for (int i = 0; i < width; ++i)
+                    sum += stencil.weights[0][i] * row[i];
+                  result += stencil.weights[1][j] * sum;
+                }
+            }
+          else
+            {
+              for (int k = 0; k < width; ++k)
+                {
+                  double slice_sum = 0.0;
+                  for (int j = 0; j < width; ++j)
+                    {
+                      const double *const row = base +
+                                                j * info.strides[1] +
+                                                k * info.strides[spacedim - 1];
+                      double sum = 0.0;
+                      for (int i = 0; i < width; ++i)
+                        sum += stencil.weights[0][i] * row[i];
+                      slice_sum += stencil.weights[1][j] * sum;
+                    }
+                  result += stencil.weights[spacedim - 1][k] * slice_sum;
+                }
+            }
+        }
+      else
+        {
+          // Slow path: skip the parts of the stencil outside of the array.
+          const int n_k = spacedim == 2 ? 1 : width;
+          for (int k = 0; k < n_k; ++k)
+            {
+              const int index_2 =
+                spacedim == 2 ? 0 : stencil.first[spacedim - 1] + k;
+              const double weight_2 =
+                spacedim == 2 ? 1.0 : stencil.weights[spacedim - 1][k];
+              if (spacedim == 3 &&
+                  (index_2 < 0 || index_2 >= info.sizes[spacedim - 1]))
+                continue;
+              double slice_sum = 0.0;
+              for (int j = 0; j < width; ++j)
+                {
+                  const int index_1 = stencil.first[1] + j;
+                  if (index_1 < 0 || index_1 >= info.sizes[1])
+                    continue;
+                  double sum = 0.0;
+                  for (int i = 0; i < width; ++i)
+                    {
+                      const int index_0 = stencil.first[0] + i;
+                      if (index_0 < 0 || index_0 >= info.sizes[0])
+                        continue;
+                      sum += stencil.weights[0][i] *
+                             data[index_0 + index_1 * info.strides[1] +
+                                  index_2 * info.strides[spacedim - 1]];
+                    }
+                  slice_sum += stencil.weights[1][j] * sum;
+                }
+              result += weight_2 * slice_sum;
+            }
+        }
+      return result;
+    }
+
+    // Add the stencil weights times @p value to the array values.
+    template <typename Kernel, int spacedim>
+    void
+    apply_stencil_transpose(const ArrayInfo<spacedim>       &info,
+                            const Stencil<Kernel, spacedim> &stencil,
+                            const double                     value,
+                            double *const                    data)
+    {
+      constexpr int width = Kernel::width;
+      if (stencil.contained)
+        {
+          double *const base = data + stencil.offset;
+          if (spacedim == 2)
+            {
+              for (int j = 0; j < width; ++j)
+                {
+                  double *const row = base + j * info.strides[1];
+                  const double  w_j = stencil.weights[1][j] * value;
+                  for (int i = 0; i < width; ++i)
+                    row[i] += stencil.weights[0][i] * w_j;
+                }
+            }
+          else
+            {
+              for (int k = 0; k < width; ++k)
+                {
+                  const double w_k = stencil.weights[spacedim - 1][k] * value;
+                  for (int j = 0; j < width; ++j)
+                    {
+                      double *const row = base + j * info.strides[1] +
+                                          k * info.strides[spacedim - 1];
+                      const double w_jk = stencil.weights[1][j] * w_k;
+                      for (int i = 0; i < width; ++i)
+                        row[i] += stencil.weights[0][i] * w_jk;
+                    }
+                }
+            }
+        }
+      else
+        {
+          const int n_k = spacedim == 2 ? 1 : width;
+          for (int k = 0; k < n_k; ++k)
+            {
+              const int index_2 =
+                spacedim == 2 ? 0 : stencil.first[spacedim - 1] + k;
+              const double w_k =
+                (spacedim == 2 ? 1.0 : stencil.weights[spacedim - 1][k]) *
+                value;
+              if (spacedim == 3 &&
+                  (index_2 < 0 || index_2 >= info.sizes[spacedim - 1]))
+                continue;
+              for (int j = 0; j < width; ++j)
+                {
+                  const int index_1 = stencil.first[1] + j;
+                  if (index_1 < 0 || index_1 >= info.sizes[1])
+                    continue;
+                  const double w_jk = stencil.weights[1][j] * w_k;
+                  for (int i = 0; i < width; ++i)
+                    {
+                      const int index_0 = stencil.first[0] + i;
+                      if (index_0 < 0 || index_0 >= info.sizes[0])
+                        continue;
+                      data[index_0 + index_1 * info.strides[1] +
+                           index_2 * info.strides[spacedim - 1]] +=
+                        stencil.weights[0][i] * w_jk;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Each component of a value is associated with a single SAMRAI array: for
+     * cell-centered data component c corresponds to depth c and for
+     * side-centered data component c corresponds to axis c.
+     */
+    template <int spacedim>
+    std::vector<pdat::ArrayData<spacedim, double> *>
+    get_arrays(const tbox::Pointer<pdat::CellData<spacedim, double>> &data)
+    {
+      std::vector<pdat::ArrayData<spacedim, double> *> result(
+        data->getDepth(), &data->getArrayData());
+      return result;
+    }
+
+    template <int spacedim>
+    std::vector<pdat::ArrayData<spacedim, double> *>
+    get_arrays(const tbox::Pointer<pdat::SideData<spacedim, double>> &data)
+    {
+      std::vector<pdat::ArrayData<spacedim, double> *> result;
+      for (int axis = 0; axis < spacedim; ++axis)
+        result.push_back(&data->getArrayData(axis));
+      return result;
+    }
+
+    template <int spacedim>
+    double *
+    get_component_pointer(
+      const tbox::Pointer<pdat::CellData<spacedim, double>> &data,
+      const int                                              component)
+    {
+      return data->getPointer(component);
+    }
+
+    template <int spacedim>
+    double *
+    get_component_pointer(
+      const tbox::Pointer<pdat::SideData<spacedim, double>> &data,
+      const int                                              component)
+    {
+      return data->getPointer(component, 0);
+    }
+
+    /**
+     * Evaluate the kernel at each point inside the box. @p operation is
+     * called on each component of each point with the array information, the
+     * stencil, and the index of the value. For side-centered data, the
+     * one-dimensional weights on the side and cell grids are computed once per
+     * point and shared by all components.
+     */
+    template <typename Kernel,
+              int spacedim,
+              typename patch_type,
+              typename Operation>
+    void
+    for_each_stencil(const tbox::Pointer<patch_type>            &patch_data,
+                     const double                               *positions,
+                     const int                                   n_points,
+                     const int                                   values_depth,
+                     const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                     const hier::Box<spacedim>                  &box,
+                     const Operation                            &operation)
+    {
+      constexpr bool is_side =
+        std::is_same<patch_type, pdat::SideData<spacedim, double>>::value;
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+        patch->getPatchGeometry();
+      const hier::Box<spacedim> &patch_box = patch->getBox();
+      const auto                 arrays    = get_arrays(patch_data);
+      AssertThrow(int(arrays.size()) == values_depth,
+                  ExcMessage("The depth of the values should equal the "
+                             "number of SAMRAI arrays."));
+
+      std::vector<ArrayInfo<spacedim>> infos;
+      for (int c = 0; c < values_depth; ++c)
+        infos.emplace_back(*arrays[c],
+                           patch_box,
+                           pgeom->getXLower(),
+                           pgeom->getDx(),
+                           is_side ? c : -1);
+#ifdef DEBUG
+      // The side-centered fast path below assumes that every axis' array has
+      // the same lower corner
+      if (is_side)
+        for (int c = 0; c < values_depth; ++c)
+          for (int d = 0; d < spacedim; ++d)
+            Assert(infos[c].index_shift[d] + (d == c ? 0.5 : 0.0) ==
+                     infos[0].index_shift[d] + (d == 0 ? 0.5 : 0.0),
+                   ExcFDLInternalError());
+#endif
+
+      Stencil<Kernel, spacedim> stencil;
+      Stencil<Kernel, spacedim> side_stencil;
+      Stencil<Kernel, spacedim> cell_stencil;
+      for (int point_n = 0; point_n < n_points; ++point_n)
+        {
+          const double *const X = positions + point_n * spacedim;
+          // Like LEInteractor, only consider points inside the box:
+          const hier::Index<spacedim> i =
+            IBTK::IndexUtilities::getCellIndex(X, pgeom, patch_box);
+          if (!box.contains(i))
+            continue;
+
+          if (is_side)
+            {
+              // In direction d, component d is stored on the sides (i.e.,
+              // without a half-cell shift) and every other component is
+              // stored at cell centers. Since every array has the same lower
+              // corner we only need to compute the weights on each of these
+              // two grids once per direction and can then assemble the
+              // stencil of each component from them.
+              for (int d = 0; d < spacedim; ++d)
+                {
+                  compute_stencil_1d<Kernel>(infos[d],
+                                             X,
+                                             d,
+                                             side_stencil.first[d],
+                                             side_stencil.weights[d]);
+                  compute_stencil_1d<Kernel>(infos[(d + 1) % spacedim],
+                                             X,
+                                             d,
+                                             cell_stencil.first[d],
+                                             cell_stencil.weights[d]);
+                }
+
+              for (int c = 0; c < values_depth; ++c)
+                {
+                  for (int d = 0; d < spacedim; ++d)
+                    {
+                      const Stencil<Kernel, spacedim> &source =
+                        d == c ? side_stencil : cell_stencil;
+                      stencil.first[d] = source.first[d];
+                      std::copy_n(source.weights[d],
+                                  Kernel::width,
+                                  stencil.weights[d]);
+                    }
+                  compute_stencil_offset(infos[c], stencil);
+                  operation(infos[c], stencil, point_n * values_depth + c, c);
+                }
+            }
+          else
+            {
+              // cell-centered data uses the same stencil for every component
+              compute_stencil(infos[0], X, stencil);
+              for (int c = 0; c < values_depth; ++c)
+                operation(infos[c], stencil, point_n * values_depth + c, c);
+            }
+        }
+    }
+
+    template <int spacedim>
+    bool
+    touches_periodic_boundary(const tbox::Pointer<hier::Patch<spacedim>> &patch)
+    {
+      const tbox::Pointer<hier::PatchGeometry<spacedim>> pgeom =
+        patch->getPatchGeometry();
+      for (int d = 0; d < spacedim; ++d)
+        for (const int upperlower : {0, 1})
+          if (pgeom->getTouchesPeriodicBoundary(d, upperlower))
+            return true;
+      return false;
+    }
+
+    template <typename Kernel, int spacedim, typename patch_type>
+    void
+    native_interpolate(double                                     *values,
+                       const int                                   n_points,
+                       const int                                   values_depth,
+                       const double                               *positions,
+                       const tbox::Pointer<patch_type>            &patch_data,
+                       const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                       const hier::Box<spacedim>                  &box)
+    {
+      std::vector<const double *> pointers(values_depth);
+      for (int c = 0; c < values_depth; ++c)
+        pointers[c] = get_component_pointer(patch_data, c);
+
+      for_each_stencil<Kernel>(
+        patch_data,
+        positions,
+        n_points,
+        values_depth,
+        patch,
+        box,
+        [&](const ArrayInfo<spacedim>       &info,
+            const Stencil<Kernel, spacedim> &stencil,
+            const int                        value_n,
+            const int                        c) {
+          values[value_n] = apply_stencil(info, stencil, pointers[c]);
+        });
+    }
+
+    template <typename Kernel, int spacedim, typename patch_type>
+    void
+    native_spread(const tbox::Pointer<patch_type>            &patch_data,
+                  const double                               *values,
+                  const int                                   n_points,
+                  const int                                   values_depth,
+                  const double                               *positions,
+                  const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                  const hier::Box<spacedim>                  &box)
+    {
+      std::vector<double *> pointers(values_depth);
+      for (int c = 0; c < values_depth; ++c)
+        pointers[c] = get_component_pointer(patch_data, c);
+
+      // Spreading preserves integrals, so we divide by the cell volume:
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+        patch->getPatchGeometry();
+      double cell_volume = 1.0;
+      for (int d = 0; d < spacedim; ++d)
+        cell_volume *= pgeom->getDx()[d];
+      const double inverse_cell_volume = 1.0 / cell_volume;
+
+      for_each_stencil<Kernel>(
+        patch_data,
+        positions,
+        n_points,
+        values_depth,
+        patch,
+        box,
+        [&](const ArrayInfo<spacedim>       &info,
+            const Stencil<Kernel, spacedim> &stencil,
+            const int                        value_n,
+            const int                        c) {
+          apply_stencil_transpose(info,
+                                  stencil,
+                                  values[value_n] * inverse_cell_volume,
+                                  pointers[c]);
+        });
+    }
+
+    template <typename Kernel, int spacedim, typename patch_type>
+    void
+    native_compute_weights(
+      const int                                   n_points,
+      const int                                   values_depth,
+      const double                               *positions,
+      const tbox::Pointer<patch_type>            &patch_data,
+      const tbox::Pointer<hier::Patch<spacedim>> &patch,
+      const hier::Box<spacedim>                  &box,
+      std::vector<unsigned int>                  &row_offsets,
+      std::vector<int>                           &columns,
+      std::vector<double>                        &weights)
+    {
+      constexpr int width = Kernel::width;
+      // for_each_stencil() skips points outside the box, whose rows are empty
+      int  n_rows     = 0;
+      auto close_rows = [&](const int end)
+      {
+        for (; n_rows < end; ++n_rows)
+          row_offsets.push_back(columns.size());
+      };
+
+      for_each_stencil<Kernel>(
+        patch_data,
+        positions,
+        n_points,
+        values_depth,
+        patch,
+        box,
+        [&](const ArrayInfo<spacedim>       &info,
+            const Stencil<Kernel, spacedim> &stencil,
+            const int                        value_n,
+            const int /*c*/) {
+          close_rows(value_n);
+          // Like the slow path of apply_stencil(), skip the parts of the
+          // stencil outside of the array.
+          const int n_k = spacedim == 2 ? 1 : width;
+          for (int k = 0; k < n_k; ++k)
+            {
+              const int index_2 =
+                spacedim == 2 ? 0 : stencil.first[spacedim - 1] + k;
+              const double weight_2 =
+                spacedim == 2 ? 1.0 : stencil.weights[spacedim - 1][k];
+              if (spacedim == 3 &&
+                  (index_2 < 0 || index_2 >= info.sizes[spacedim - 1]))
+                continue;
+              for (int j = 0; j < width; ++j)
+                {
+                  const int index_1 = stencil.first[1] + j;
+                  if (index_1 < 0 || index_1 >= info.sizes[1])
+                    continue;
+                  const double weight_12 = stencil.weights[1][j] * weight_2;
+                  for (int i = 0; i < width; ++i)
+                    {
+                      const int index_0 = stencil.first[0] + i;
+                      if (index_0 < 0 || index_0 >= info.sizes[0])
+                        continue;
+                      columns.push_back(index_0 + index_1 * info.strides[1] +
+                                        index_2 * info.strides[spacedim - 1]);
+                      weights.push_back(stencil.weights[0][i] * weight_12);
+                    }
+                }
+            }
+          row_offsets.push_back(columns.size());
+          ++n_rows;
+        });
+      close_rows(n_points * values_depth);
+    }
+
+    template <typename patch_type, int spacedim>
+    struct has_native_implementation
+    {
+      static constexpr bool value =
+        std::is_same<patch_type, pdat::CellData<spacedim, double>>::value ||
+        std::is_same<patch_type, pdat::SideData<spacedim, double>>::value;
+    };
+
+    // Call @p f with a kernel object corresponding to @p kernel.
+    template <typename F>
+    void
+    dispatch_kernel(const IBKernel kernel, const F &f)
+    {
+      switch (kernel)
+        {
+          case IBKernel::PiecewiseLinear:
+            f(PiecewiseLinearKernel());
+            break;
+          case IBKernel::IB_3:
+            f(IB3Kernel());
+            break;
+          case IBKernel::IB_4:
+            f(IB4Kernel());
+            break;
+          case IBKernel::BSpline_3:
+            f(BSpline3Kernel());
+            break;
+          case IBKernel::BSpline_4:
+            f(BSpline4Kernel());
+            break;
+          default:
+            Assert(false, ExcFDLInternalError());
+        }
+    }
+  } // namespace
+
+
+
+  IBKernel
+  get_ib_kernel(const std::string &kernel_name)
+  {
+    if (kernel_name == "PIECEWISE_LINEAR")
+      return IBKernel::PiecewiseLinear;
+    else if (kernel_name == "IB_3")
+      return IBKernel::IB_3;
+    else if (kernel_name == "IB_4")
+      return IBKernel::IB_4;
+    else if (kernel_name == "BSPLINE_3")
+      return IBKernel::BSpline_3;
+    else if (kernel_name == "BSPLINE_4")
+      return IBKernel::BSpline_4;
+    return IBKernel::Unknown;
+  }
+
+
+
+  int
+  get_ib_kernel_width(const IBKernel kernel)
+  {
+    switch (kernel)
+      {
+        case IBKernel::PiecewiseLinear:
+          return PiecewiseLinearKernel::width;
+        case IBKernel::IB_3:
+          return IB3Kernel::width;
+        case IBKernel::IB_4:
+          return IB4Kernel::width;
+        case IBKernel::BSpline_3:
+          return BSpline3Kernel::width;
+        case IBKernel::BSpline_4:
+          return BSpline4Kernel::width;
+        default:
+          AssertThrow(false, ExcFDLNotImplemented());
+      }
+    return 0;
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  void
+  ib_interpolate(double                                     *values,
+                 const int                                   values_size,
+                 const int                                   values_depth,
+                 const double                               *positions,
+                 const int                                   positions_size,
+                 const int                                   positions_depth,
+                 const tbox::Pointer<patch_type>            &patch_data,
+                 const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                 const hier::Box<spacedim>                  &box,
+                 const std::string                          &kernel_name)
+  {
+    if constexpr (has_native_implementation<patch_type, spacedim>::value)
+      {
+        const IBKernel kernel = get_ib_kernel(kernel_name);
+        if (kernel != IBKernel::Unknown && !touches_periodic_boundary(patch))
+          {
+            AssertThrow(positions_depth == spacedim, ExcFDLNotImplemented());
+            const int n_points = positions_size / spacedim;
+            AssertThrow(values_size == n_points * values_depth,
+                        ExcMessage("There should be one value per point."));
+            dispatch_kernel(kernel, [&](const auto k) {
+              native_interpolate<std::decay_t<decltype(k)>>(values,
+                                                            n_points,
+                                                            values_depth,
+                                                            positions,
+                                                            patch_data,
+                                                            patch,
+                                                            box);
+            });
+            return;
+          }
+      }
+
+    IBTK::LEInteractor::interpolate(values,
+                                    values_size,
+                                    values_depth,
+                                    positions,
+                                    positions_size,
+                                    positions_depth,
+                                    patch_data,
+                                    patch,
+                                    box,
+                                    kernel_name);
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  void
+  ib_spread(const tbox::Pointer<patch_type>            &patch_data,
+            const double                               *values,
+            const int                                   values_size,
+            const int                                   values_depth,
+            const double                               *positions,
+            const int                                   positions_size,
+            const int                                   positions_depth,
+            const tbox::Pointer<hier::Patch<spacedim>> &patch,
+            const hier::Box<spacedim>                  &box,
+            const std::string                          &kernel_name)
+  {
+    if constexpr (has_native_implementation<patch_type, spacedim>::value)
+      {
+        const IBKernel kernel = get_ib_kernel(kernel_name);
+        if (kernel != IBKernel::Unknown && !touches_periodic_boundary(patch))
+          {
+            AssertThrow(positions_depth == spacedim, ExcFDLNotImplemented());
+            const int n_points = positions_size / spacedim;
+            AssertThrow(values_size == n_points * values_depth,
+                        ExcMessage("There should be one value per point."));
+            dispatch_kernel(kernel, [&](const auto k) {
+              native_spread<std::decay_t<decltype(k)>>(patch_data,
+                                                       values,
+                                                       n_points,
+                                                       values_depth,
+                                                       positions,
+                                                       patch,
+                                                       box);
+            });
+            return;
+          }
+      }
+
+    IBTK::LEInteractor::spread(patch_data,
+                               values,
+                               values_size,
+                               values_depth,
+                               positions,
+                               positions_size,
+                               positions_depth,
+                               patch,
+                               box,
+                               kernel_name);
+  }
+
+  template <int spacedim, typename patch_type>
+  bool
+  ib_compute_weights(const double                               *positions,
+                     const int                                   positions_size,
+                     const int                                   values_depth,
+                     const tbox::Pointer<patch_type>            &patch_data,
+                     const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                     const hier::Box<spacedim>                  &box,
+                     const std::string                          &kernel_name,
+                     std::vector<unsigned int>                  &row_offsets,
+                     std::vector<int>                           &columns,
+                     std::vector<double>                        &weights)
+  {
+    if constexpr (has_native_implementation<patch_type, spacedim>::value)
+      {
+        const IBKernel kernel = get_ib_kernel(kernel_name);
+        if (kernel != IBKernel::Unknown && !touches_periodic_boundary(patch))
+          {
+            Assert(row_offsets.size() > 0 &&
+                     row_offsets.back() == columns.size(),
+                   ExcMessage("The last row offset should be the number of "
+                              "columns."));
+            AssertDimension(columns.size(), weights.size());
+            const int n_points = positions_size / spacedim;
+            dispatch_kernel(kernel, [&](const auto k) {
+              native_compute_weights<std::decay_t<decltype(k)>>(n_points,
+                                                                values_depth,
+                                                                positions,
+                                                                patch_data,
+                                                                patch,
+                                                                box,
+                                                                row_offsets,
+                                                                columns,
+                                                                weights);
+            });
+            return true;
+          }
+      }
+
+    return false;
+  }
+
+  // instantiations
+
+  template void
+  ib_interpolate(
+    double                                            *values,
+    const int                                          values_size,
+    const int                                          values_depth,
+    const double                                      *positions,
+    const int                                          positions_size,
+    const int                                          positions_depth,
+    const tbox::Pointer<pdat::EdgeData<NDIM, double>> &patch_data,
+    const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+    const hier::Box<NDIM>                             &box,
+    const std::string                                 &kernel_name);
+
+  template void
+  ib_spread(const tbox::Pointer<pdat::EdgeData<NDIM, double>> &patch_data,
+            const double                                      *values,
+            const int                                          values_size,
+            const int                                          values_depth,
+            const double                                      *positions,
+            const int                                          positions_size,
+            const int                                          positions_depth,
+            const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+            const hier::Box<NDIM>                             &box,
+            const std::string                                 &kernel_name);
+
+  template bool
+  ib_compute_weights(
+    const double                                      *positions,
+    const int                                          positions_size,
+    const int                                          values_depth,
+    const tbox::Pointer<pdat::CellData<NDIM, double>> &patch_data,
+    const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+    const hier::Box<NDIM>                             &box,
+    const std::string                                 &kernel_name,
+    std::vector<unsigned int>                         &row_offsets,
+    std::vector<int>                                  &columns,
+    std::vector<double>                               &weights);
+
+  template bool
+  ib_compute_weights(
+    const double                                      *positions,
+    const int                                          positions_size,
+    const int                                          values_depth,
+    const tbox::Pointer<pdat::SideData<NDIM, double>> &patch_data,
+    const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+    const hier::Box<NDIM>                             &box,
+    const std::string                                 &kernel_name,
+    std::vector<unsigned int>                         &row_offsets,
+    std::vector<int>                                  &columns,
+    std::vector<double>                               &weights);
+
+  template void
+  ib_interpolate(
+    double                                            *values,
+    const int                                          values_size,
+    const int                                          values_depth,
+    const double                                      *positions,
+    const int                                          positions_size,
+    const int                                          positions_depth,
+    const tbox::Pointer<pdat::CellData<NDIM, double>> &patch_data,
+    const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+    const hier::Box<NDIM>                             &box,
+    const std::string                                 &kernel_name);
+
+  template void
+  ib_spread(const tbox::Pointer<pdat::CellData<NDIM, double>> &patch_data,
+            const double                                      *values,
+            const int                                          values_size,
+            const int                                          values_depth,
+            const double                                      *positions,
+            const int                                          positions_size,
+            const int                                          positions_depth,
+            const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+            const hier::Box<NDIM>                             &box,
+            const std::string                                 &kernel_name);
+
+  template void
+  ib_interpolate(
+    double                                            *values,
+    const int                                          values_size,
+    const int                                          values_depth,
+    const double                                      *positions,
+    const int                                          positions_size,
+    const int                                          positions_depth,
+    const tbox::Pointer<pdat::NodeData<NDIM, double>> &patch_data,
+    const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+    const hier::Box<NDIM>                             &box,
+    const std::string                                 &kernel_name);
+
+  template void
+  ib_spread(const tbox::Pointer<pdat::NodeData<NDIM, double>> &patch_data,
+            const double                                      *values,
+            const int                                          values_size,
+            const int                                          values_depth,
+            const double                                      *positions,
+            const int                                          positions_size,
+            const int                                          positions_depth,
+            const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+            const hier::Box<NDIM>                             &box,
+            const std::string                                 &kernel_name);
+
+  template void
+  ib_interpolate(
+    double                                            *values,
+    const int                                          values_size,
+    const int                                          values_depth,
+    const double                                      *positions,
+    const int                                          positions_size,
+    const int                                          positions_depth,
+    const tbox::Pointer<pdat::SideData<NDIM, double>> &patch_data,
+    const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+    const hier::Box<NDIM>                             &box,
+    const std::string                                 &kernel_name);
+
+  template void
+  ib_spread(const tbox::Pointer<pdat::SideData<NDIM, double>> &patch_data,
+            const double                                      *values,
+            const int                                          values_size,
+            const int                                          values_depth,
+            const double                                      *positions,
+            const int                                          positions_size,
+            const int                                          positions_depth,
+            const tbox::Pointer<hier::Patch<NDIM>>            &patch,
+            const hier::Box<NDIM>                             &box,
+            const std::string                                 &kernel_name);
+} // namespace fdl
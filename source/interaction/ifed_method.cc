@@ -5,21 +5,30 @@
 #include <fiddle/grid/grid_utilities.h>
 
 #include <fiddle/interaction/elemental_interaction.h>
+#include <fiddle/interaction/ib_kernels.h>
 #include <fiddle/interaction/ifed_method.h>
 #include <fiddle/interaction/interaction_utilities.h>
 #include <fiddle/interaction/nodal_interaction.h>
+#include <fiddle/interaction/transaction_scheduler.h>
 
 #include <fiddle/mechanics/mechanics_utilities.h>
 
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
 #include <deal.II/fe/mapping_fe_field.h>
 
+#include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/solver_cg.h>
 
+#include <deal.II/numerics/rtree.h>
+
+#include <boost/iterator/function_output_iterator.hpp>
+
 #include <ibamr/IBHierarchyIntegrator.h>
 #include <ibamr/ibamr_utilities.h>
 
@@ -29,12 +38,25 @@
 #include <ibtk/ibtk_utilities.h>
 
 #include <CellVariable.h>
+#include <CoarsenSchedule.h>
 #include <HierarchyDataOpsManager.h>
+#include <GridGeometry.h>
 #include <IntVector.h>
+#include <PatchGeometry.h>
+#include <RefineAlgorithm.h>
+#include <RefineSchedule.h>
 #include <VariableDatabase.h>
 #include <tbox/TimerManager.h>
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
 #include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
 
 namespace
 {
@@ -53,6 +75,7 @@ namespace
   static tbox::Timer *t_compute_lagrangian_force_solve;
   static tbox::Timer *t_spread_force;
   static tbox::Timer *t_spread_force_start_barrier;
+  static tbox::Timer *t_spread_force_accumulate;
   static tbox::Timer *t_compute_lagrangian_fluid_source;
   static tbox::Timer *t_spread_fluid_source;
   static tbox::Timer *t_add_workload_estimate;
@@ -68,6 +91,1103 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    /**
+     * Settings for mass matrix solves.
+     */
+    struct MassSolverSettings
+    {
+      /**
+       * Maximum number of CG iterations.
+       */
+      unsigned int max_steps;
+
+      /**
+       * Relative tolerance (i.e., the solver tolerance is this times the L2
+       * norm of the right-hand side).
+       */
+      double relative_tolerance;
+
+      /**
+       * Whether or not to use the lumped mass matrix instead of solving.
+       */
+      bool lumped;
+
+      /**
+       * Whether or not to use pipelined CG (see solve_pipelined_cg()) instead
+       * of SolverCG.
+       */
+      bool pipelined;
+
+      /**
+       * Whether or not to solve in mixed precision (see
+       * solve_mass_system_mixed_precision()).
+       */
+      bool mixed_precision;
+    };
+
+    /**
+     * Read the mass solver settings from the input database.
+     */
+    MassSolverSettings
+    get_mass_solver_settings(const tbox::Pointer<tbox::Database> &input_db)
+    {
+      MassSolverSettings settings;
+      settings.max_steps =
+        input_db->getIntegerWithDefault("solver_iterations", 100);
+      settings.relative_tolerance =
+        input_db->getDoubleWithDefault("solver_relative_tolerance", 1e-6);
+
+      std::string mass_matrix_type =
+        input_db->getStringWithDefault("mass_matrix_type", "CONSISTENT");
+      std::transform(mass_matrix_type.begin(),
+                     mass_matrix_type.end(),
+                     mass_matrix_type.begin(),
+                     [](const unsigned char c) { return std::tolower(c); });
+      if (mass_matrix_type == "consistent")
+        settings.lumped = false;
+      else if (mass_matrix_type == "lumped")
+        settings.lumped = true;
+      else
+        AssertThrow(false, ExcFDLNotImplemented());
+
+      std::string solver_type =
+        input_db->getStringWithDefault("solver_type", "CG");
+      std::transform(solver_type.begin(),
+                     solver_type.end(),
+                     solver_type.begin(),
+                     [](const unsigned char c) { return std::tolower(c); });
+      if (solver_type == "cg")
+        settings.pipelined = false;
+      else if (solver_type == "pipelined_cg")
+        settings.pipelined = true;
+      else
+        AssertThrow(false, ExcFDLNotImplemented());
+
+      std::string solver_precision =
+        input_db->getStringWithDefault("solver_precision", "DOUBLE");
+      std::transform(solver_precision.begin(),
+                     solver_precision.end(),
+                     solver_precision.begin(),
+                     [](const unsigned char c) { return std::tolower(c); });
+      if (solver_precision == "double")
+        settings.mixed_precision = false;
+      else if (solver_precision == "mixed")
+        settings.mixed_precision = true;
+      else
+        AssertThrow(false, ExcFDLNotImplemented());
+
+      return settings;
+    }
+
+    /**
+     * Compute the local parts of the dot products (r, u), (w, u), and (r, r)
+     * in one pass.
+     */
+    template <typename Number>
+    std::array<double, 3>
+    local_cg_dot_products(const LinearAlgebra::distributed::Vector<Number> &r,
+                          const LinearAlgebra::distributed::Vector<Number> &u,
+                          const LinearAlgebra::distributed::Vector<Number> &w)
+    {
+      // Always accumulate in double precision
+      std::array<double, 3> dots{{0.0, 0.0, 0.0}};
+      const Number *const   r_ptr = r.begin();
+      const Number *const   u_ptr = u.begin();
+      const Number *const   w_ptr = w.begin();
+      for (unsigned int i = 0; i < r.locally_owned_size(); ++i)
+        {
+          dots[0] += double(r_ptr[i]) * u_ptr[i];
+          dots[1] += double(w_ptr[i]) * u_ptr[i];
+          dots[2] += double(r_ptr[i]) * r_ptr[i];
+        }
+      return dots;
+    }
+
+    std::array<double, 3>
+    local_cg_dot_products(
+      const LinearAlgebra::distributed::BlockVector<double> &r,
+      const LinearAlgebra::distributed::BlockVector<double> &u,
+      const LinearAlgebra::distributed::BlockVector<double> &w)
+    {
+      std::array<double, 3> dots{{0.0, 0.0, 0.0}};
+      for (unsigned int b = 0; b < r.n_blocks(); ++b)
+        {
+          const std::array<double, 3> block_dots =
+            local_cg_dot_products(r.block(b), u.block(b), w.block(b));
+          for (unsigned int i = 0; i < dots.size(); ++i)
+            dots[i] += block_dots[i];
+        }
+      return dots;
+    }
+
+    /**
+     * Solve a symmetric positive definite system with the preconditioned
+     * pipelined conjugate gradient method of Ghysels and Vanroose. Unlike
+     * SolverCG, which does two blocking reductions per iteration, this
+     * algorithm does a single nonblocking reduction per iteration which
+     * overlaps with the application of the preconditioner and the operator.
+     * Hence it is faster when the solve is latency-bound (e.g., for small
+     * parts on many processors) at the cost of a few more vector updates and
+     * slightly worse stability.
+     *
+     * Like SolverCG, this function uses the (unpreconditioned) residual norm
+     * to decide convergence and throws SolverControl::NoConvergence if
+     * @p control does not indicate success.
+     */
+    template <typename VectorType, typename Operator, typename Preconditioner>
+    void
+    solve_pipelined_cg(SolverControl        &control,
+                       const Operator       &A,
+                       VectorType           &x,
+                       const VectorType     &b,
+                       const Preconditioner &M)
+    {
+      VectorType r, u, w, m, n, p, s, q, z;
+      for (VectorType *vector : {&r, &u, &w, &m, &n, &p, &s, &q, &z})
+        vector->reinit(x);
+
+      A.vmult(r, x);
+      r.sadd(-1.0, 1.0, b);
+      M.vmult(u, r);
+      A.vmult(w, u);
+
+      const MPI_Comm       comm  = x.get_mpi_communicator();
+      double               gamma = 0.0, alpha = 0.0;
+      SolverControl::State state = SolverControl::iterate;
+      for (unsigned int step = 0; state == SolverControl::iterate; ++step)
+        {
+          const std::array<double, 3> local_dots =
+            local_cg_dot_products(r, u, w);
+          std::array<double, 3> dots;
+          MPI_Request           request;
+          int ierr = MPI_Iallreduce(local_dots.data(),
+                                    dots.data(),
+                                    int(dots.size()),
+                                    MPI_DOUBLE,
+                                    MPI_SUM,
+                                    comm,
+                                    &request);
+          AssertThrowMPI(ierr);
+          // Overlap the reduction with the preconditioner and operator
+          M.vmult(m, w);
+          A.vmult(n, m);
+          ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+
+          state = control.check(step, std::sqrt(dots[2]));
+          if (state != SolverControl::iterate)
+            break;
+
+          const double old_gamma = gamma;
+          gamma                  = dots[0];
+          const double delta     = dots[1];
+          const double beta      = step == 0 ? 0.0 : gamma / old_gamma;
+          alpha                  = step == 0 ?
+                                     gamma / delta :
+                                     gamma / (delta - beta * gamma / alpha);
+
+          z.sadd(beta, 1.0, n);
+          q.sadd(beta, 1.0, m);
+          s.sadd(beta, 1.0, w);
+          p.sadd(beta, 1.0, u);
+          x.add(alpha, p);
+          r.add(-alpha, s);
+          u.add(-alpha, q);
+          w.add(-alpha, z);
+        }
+
+      AssertThrow(state == SolverControl::success,
+                  SolverControl::NoConvergence(control.last_step(),
+                                               control.last_value()));
+    }
+
+    /**
+     * Solve the mass system of @p part by iterative refinement: each
+     * correction is computed by CG in single precision (with a single
+     * precision version of the preconditioner of @p part) and each residual
+     * is computed in double precision.
+     * Since the mass matrix is well-conditioned this converges to the
+     * requested tolerance in a few outer iterations while the inner
+     * iterations move half as much data.
+     *
+     * @return The total number of inner CG iterations.
+     */
+    template <int dim, int spacedim>
+    unsigned int
+    solve_mass_system_mixed_precision(
+      const Part<dim, spacedim>                        &part,
+      const MassSolverSettings                         &settings,
+      LinearAlgebra::distributed::Vector<double>       &solution,
+      const LinearAlgebra::distributed::Vector<double> &rhs)
+    {
+      using FloatVectorType = LinearAlgebra::distributed::Vector<float>;
+      const auto &float_operator = part.get_single_precision_mass_operator();
+      const auto &float_preconditioner =
+        part.get_single_precision_mass_preconditioner();
+      // Single precision cannot reduce the residual much further than this in
+      // one outer iteration
+      const double inner_reduction = 1e-4;
+      const double tolerance =
+        settings.relative_tolerance * rhs.l2_norm();
+
+      LinearAlgebra::distributed::Vector<double> residual(
+        part.get_partitioner());
+      FloatVectorType float_residual, float_correction;
+      float_operator.initialize_dof_vector(float_residual);
+      float_operator.initialize_dof_vector(float_correction);
+      // Both MatrixFree objects use the same DoFHandler, so the locally owned
+      // DoFs are the same, but the ghost DoFs may differ
+      const unsigned int n_local_dofs = residual.locally_owned_size();
+      AssertDimension(float_residual.locally_owned_size(), n_local_dofs);
+
+      unsigned int n_steps = 0;
+      while (true)
+        {
+          part.get_mass_operator().vmult(residual, solution);
+          residual.sadd(-1.0, 1.0, rhs);
+          const double residual_norm = residual.l2_norm();
+          if (residual_norm <= tolerance)
+            break;
+          AssertThrow(n_steps < settings.max_steps,
+                      SolverControl::NoConvergence(n_steps, residual_norm));
+
+          for (unsigned int i = 0; i < n_local_dofs; ++i)
+            float_residual.local_element(i) = residual.local_element(i);
+          float_correction = 0.0f;
+          ReductionControl control(settings.max_steps - n_steps,
+                                   0.5 * tolerance,
+                                   inner_reduction);
+          if (settings.pipelined)
+            solve_pipelined_cg(control,
+                               float_operator,
+                               float_correction,
+                               float_residual,
+                               float_preconditioner);
+          else
+            {
+              SolverCG<FloatVectorType> cg(control);
+              cg.solve(float_operator,
+                       float_correction,
+                       float_residual,
+                       float_preconditioner);
+            }
+          // Always count at least one step so that this loop terminates
+          n_steps += std::max(control.last_step(), 1u);
+          for (unsigned int i = 0; i < n_local_dofs; ++i)
+            solution.local_element(i) += float_correction.local_element(i);
+        }
+
+      return n_steps;
+    }
+
+    /**
+     * Solve the mass system of @p part and return the number of CG iterations
+     * (or zero, if the lumped mass matrix is used). Parts which do not support
+     * single precision mass operators are solved in double precision even if
+     * mixed precision is requested.
+     */
+    template <int dim, int spacedim>
+    unsigned int
+    solve_mass_system(
+      const Part<dim, spacedim>                                &part,
+      const MassSolverSettings                                 &settings,
+      InitialGuess<LinearAlgebra::distributed::Vector<double>> &guess,
+      LinearAlgebra::distributed::Vector<double>               &solution,
+      const LinearAlgebra::distributed::Vector<double>         &rhs)
+    {
+      if (settings.lumped)
+        {
+          solution.equ(1.0, rhs);
+          solution.scale(part.get_lumped_mass_inverse());
+          return 0;
+        }
+
+      // If we mess up the matrix-free implementation will fix our
+      // partitioner: make sure we catch that case here
+      Assert(solution.get_partitioner() == part.get_partitioner(),
+             ExcFDLInternalError());
+      guess.guess(solution, rhs);
+      if (settings.mixed_precision &&
+          part.supports_single_precision_mass_operator())
+        {
+          const unsigned int n_steps =
+            solve_mass_system_mixed_precision(part, settings, solution, rhs);
+          guess.submit(solution, rhs);
+          return n_steps;
+        }
+
+      SolverControl control(settings.max_steps,
+                            settings.relative_tolerance * rhs.l2_norm());
+      if (settings.pipelined)
+        solve_pipelined_cg(control,
+                           part.get_mass_operator(),
+                           solution,
+                           rhs,
+                           part.get_mass_preconditioner());
+      else
+        {
+          SolverCG<LinearAlgebra::distributed::Vector<double>> cg(control);
+          cg.solve(part.get_mass_operator(),
+                   solution,
+                   rhs,
+                   part.get_mass_preconditioner());
+        }
+      guess.submit(solution, rhs);
+      // Same
+      Assert(solution.get_partitioner() == part.get_partitioner(),
+             ExcFDLInternalError());
+
+      return control.last_step();
+    }
+
+    /**
+     * Class which runs the (independent) mass solves of several parts as soon
+     * as their right-hand sides are ready.
+     *
+     * Since each solve does collective communication, the solves must start
+     * in the same order on every processor: hence, unless the solves run on
+     * separate threads (which requires a distinct communicator per part),
+     * solve n only runs once solves 0, ..., n - 1 have run.
+     */
+    class MassSolves
+    {
+    public:
+      MassSolves(const std::size_t n_solves, const bool use_threads)
+        : use_threads(use_threads)
+        , n_run(0)
+        , pending(n_solves)
+      {}
+
+      /**
+       * Run (or queue) solve @p n.
+       */
+      void
+      add(const std::size_t n, const std::function<void()> &solve)
+      {
+        AssertIndexRange(n, pending.size());
+        if (use_threads)
+          tasks += Threads::new_task(solve);
+        else
+          {
+            pending[n] = solve;
+            while (n_run < pending.size() && pending[n_run])
+              pending[n_run++]();
+          }
+      }
+
+      /**
+       * Wait for all solves to finish.
+       */
+      void
+      wait()
+      {
+        tasks.join_all();
+        AssertThrow(use_threads || n_run == pending.size(),
+                    ExcFDLInternalError());
+      }
+
+    private:
+      bool use_threads;
+
+      std::size_t n_run;
+
+      std::vector<std::function<void()>> pending;
+
+      Threads::TaskGroup<void> tasks;
+    };
+
+    /**
+     * Check that the communicator of each part is congruent to the one used
+     * by SAMRAI. Each part's mass solves, force assembly, and bounding box
+     * collection only use that part's communicator, so parts with duplicated
+     * communicators do not synchronize with each other, but every processor
+     * owning patches has to participate in each part's interaction.
+     */
+    template <typename Collection, typename SurfaceCollection>
+    void
+    check_part_communicators(const Collection        &collection,
+                             const SurfaceCollection &surface_collection)
+    {
+      auto check = [](const auto &parts)
+      {
+        for (const auto &part : parts)
+          {
+            int       result = 0;
+            const int ierr =
+              MPI_Comm_compare(part.get_communicator(),
+                               IBTK::IBTK_MPI::getCommunicator(),
+                               &result);
+            AssertThrowMPI(ierr);
+            AssertThrow(result == MPI_IDENT || result == MPI_CONGRUENT,
+                        ExcMessage("Each part should use the same "
+                                   "communicator as SAMRAI or a duplicate of "
+                                   "it: parts on a subset of the processors "
+                                   "are not supported."));
+          }
+      };
+      check(collection);
+      check(surface_collection);
+    }
+
+    /**
+     * Check that the mass solves of several parts can run on separate threads,
+     * i.e., that MPI supports concurrent calls and no two parts share a
+     * communicator.
+     */
+    template <typename Collection, typename SurfaceCollection>
+    void
+    check_threaded_mass_solves(const Collection        &collection,
+                               const SurfaceCollection &surface_collection)
+    {
+      int       provided = 0;
+      const int ierr     = MPI_Query_thread(&provided);
+      AssertThrowMPI(ierr);
+      AssertThrow(provided == MPI_THREAD_MULTIPLE,
+                  ExcMessage("threaded_mass_solves requires MPI to be "
+                             "initialized with MPI_THREAD_MULTIPLE."));
+
+      std::vector<MPI_Comm> comms;
+      for (const auto &part : collection)
+        comms.push_back(part.get_partitioner()->get_mpi_communicator());
+      for (const auto &part : surface_collection)
+        comms.push_back(part.get_partitioner()->get_mpi_communicator());
+      for (std::size_t i = 0; i < comms.size(); ++i)
+        for (std::size_t j = i + 1; j < comms.size(); ++j)
+          {
+            int       result = 0;
+            const int ierr   = MPI_Comm_compare(comms[i], comms[j], &result);
+            AssertThrowMPI(ierr);
+            AssertThrow(result != MPI_IDENT,
+                        ExcMessage("threaded_mass_solves requires each part "
+                                   "to use a different communicator."));
+          }
+    }
+
+    /**
+     * Check that the mass solves of the parts in each collection can be
+     * batched by solve_mass_systems(), i.e., that the parts in each collection
+     * share a communicator and the solves do not run on separate threads.
+     */
+    template <typename Collection, typename SurfaceCollection>
+    void
+    check_batched_mass_solves(const Collection        &collection,
+                              const SurfaceCollection &surface_collection,
+                              const bool               use_threads)
+    {
+      AssertThrow(!use_threads,
+                  ExcMessage("batched_mass_solves and threaded_mass_solves "
+                             "cannot both be enabled."));
+      auto check = [](const auto &parts)
+      {
+        for (std::size_t i = 1; i < parts.size(); ++i)
+          {
+            int       result = 0;
+            const int ierr   = MPI_Comm_compare(parts[0].get_communicator(),
+                                                parts[i].get_communicator(),
+                                                &result);
+            AssertThrowMPI(ierr);
+            AssertThrow(result == MPI_IDENT || result == MPI_CONGRUENT,
+                        ExcMessage("batched_mass_solves requires all parts "
+                                   "to use the same communicator."));
+          }
+      };
+      check(collection);
+      check(surface_collection);
+    }
+
+    /**
+     * Solve the mass systems of the parts of @p collection given by
+     * @p indices at once with a single CG solver on a block vector. This
+     * requires the same number of iterations as the slowest individual solve
+     * but each iteration does one set of reductions for all parts rather than
+     * one per part. The tolerance is relative to the norm of all right-hand
+     * sides together.
+     *
+     * @return The number of CG iterations.
+     */
+    template <typename Collection, typename Guesses, typename Vectors>
+    unsigned int
+    solve_mass_systems(const Collection                &collection,
+                       const std::vector<unsigned int> &indices,
+                       const MassSolverSettings        &settings,
+                       Guesses                         &guesses,
+                       Vectors                         &solutions,
+                       Vectors                         &right_hand_sides,
+                       Tracer *const                    tracer)
+    {
+      if (indices.empty())
+        return 0;
+      const double start = MPI_Wtime();
+
+      using BlockVectorType = LinearAlgebra::distributed::BlockVector<double>;
+      // Block diagonal mass operator (or preconditioner)
+      struct BlockOperator
+      {
+        const Collection                &collection;
+        const std::vector<unsigned int> &indices;
+        const bool                       precondition;
+
+        void
+        vmult(BlockVectorType &dst, const BlockVectorType &src) const
+        {
+          for (unsigned int b = 0; b < indices.size(); ++b)
+            {
+              const auto &part = collection[indices[b]];
+              if (precondition)
+                part.get_mass_preconditioner().vmult(dst.block(b),
+                                                     src.block(b));
+              else
+                part.get_mass_operator().vmult(dst.block(b), src.block(b));
+            }
+        }
+      };
+
+      // Swap the vectors into blocks (and back again afterwards) to avoid
+      // copying them
+      const unsigned int n_blocks = indices.size();
+      BlockVectorType    solution(n_blocks);
+      BlockVectorType    rhs(n_blocks);
+      for (unsigned int b = 0; b < n_blocks; ++b)
+        {
+          solution.block(b).swap(solutions[indices[b]]);
+          rhs.block(b).swap(right_hand_sides[indices[b]]);
+        }
+      solution.collect_sizes();
+      rhs.collect_sizes();
+
+      for (unsigned int b = 0; b < n_blocks; ++b)
+        guesses[indices[b]].guess(solution.block(b), rhs.block(b));
+      SolverControl control(settings.max_steps,
+                            settings.relative_tolerance * rhs.l2_norm());
+      if (settings.pipelined)
+        solve_pipelined_cg(control,
+                           BlockOperator{collection, indices, false},
+                           solution,
+                           rhs,
+                           BlockOperator{collection, indices, true});
+      else
+        {
+          SolverCG<BlockVectorType> cg(control);
+          cg.solve(BlockOperator{collection, indices, false},
+                   solution,
+                   rhs,
+                   BlockOperator{collection, indices, true});
+        }
+
+      for (unsigned int b = 0; b < n_blocks; ++b)
+        {
+          guesses[indices[b]].submit(solution.block(b), rhs.block(b));
+          solution.block(b).swap(solutions[indices[b]]);
+          rhs.block(b).swap(right_hand_sides[indices[b]]);
+          // Same as solve_mass_system()
+          Assert(solutions[indices[b]].get_partitioner() ==
+                   collection[indices[b]].get_partitioner(),
+                 ExcFDLInternalError());
+        }
+      if (tracer)
+        tracer->add_event(
+          "IFEDMethod", "batched CG solve", "compute", start, MPI_Wtime());
+
+      return control.last_step();
+    }
+
+    /**
+     * Return the names of the lanes of the parts and surface parts in a trace,
+     * in the same order as the transactions (i.e., parts first).
+     */
+    std::vector<std::string>
+    get_lane_names(const std::size_t n_parts, const std::size_t n_surface_parts)
+    {
+      std::vector<std::string> names;
+      for (std::size_t i = 0; i < n_parts; ++i)
+        names.push_back("part " + std::to_string(i));
+      for (std::size_t i = 0; i < n_surface_parts; ++i)
+        names.push_back("surface part " + std::to_string(i));
+      return names;
+    }
+
+    /**
+     * Return the entries of @p lane_names (see get_lane_names()) of the parts
+     * for which @p active is true, i.e., the names of the transactions added
+     * when inactive parts are skipped.
+     */
+    std::vector<std::string>
+    get_active_lane_names(const std::vector<std::string> &lane_names,
+                          const std::vector<bool>        &active)
+    {
+      AssertThrow(lane_names.size() == active.size(), ExcFDLInternalError());
+      std::vector<std::string> names;
+      for (std::size_t i = 0; i < lane_names.size(); ++i)
+        if (active[i])
+          names.push_back(lane_names[i]);
+      return names;
+    }
+
+    /**
+     * Print how long each transaction run by @p scheduler spent waiting and
+     * computing. Transaction <code>i</code> is named
+     * <code>transaction_names[i]</code>.
+     */
+    void
+    log_transaction_times(const std::string              &function_name,
+                          const TransactionScheduler     &scheduler,
+                          const std::vector<std::string> &transaction_names)
+    {
+      AssertThrow(transaction_names.size() == scheduler.n_transactions(),
+                  ExcFDLInternalError());
+      for (std::size_t i = 0; i < scheduler.n_transactions(); ++i)
+        {
+          tbox::plog << "IFEDMethod::" << function_name
+                     << "(): " << transaction_names[i];
+          tbox::plog << " waited " << scheduler.get_wait_time(i)
+                     << " s and computed " << scheduler.get_compute_time(i)
+                     << " s." << std::endl;
+        }
+    }
+
+    /**
+     * Print the number of bytes used by each category in @p names on each
+     * processor followed by the minimum and maximum over all processors.
+     */
+    void
+    log_memory_consumption(const std::string              &function_name,
+                           const std::vector<std::string> &names,
+                           const std::vector<double>      &n_bytes)
+    {
+      const MPI_Comm comm = IBTK::IBTK_MPI::getCommunicator();
+      const std::vector<std::vector<double>> all_n_bytes =
+        Utilities::MPI::gather(comm, n_bytes);
+      const std::vector<Utilities::MPI::MinMaxAvg> reduced =
+        Utilities::MPI::min_max_avg(n_bytes, comm);
+      if (Utilities::MPI::this_mpi_process(comm) != 0)
+        return;
+
+      const double n_bytes_per_mb = 1024.0 * 1024.0;
+      for (std::size_t rank = 0; rank < all_n_bytes.size(); ++rank)
+        {
+          tbox::plog << "IFEDMethod::" << function_name
+                     << "(): memory consumption on processor " << rank << ":";
+          for (std::size_t i = 0; i < names.size(); ++i)
+            tbox::plog << (i == 0 ? " " : ", ") << names[i] << " = "
+                       << all_n_bytes[rank][i] / n_bytes_per_mb << " MB";
+          tbox::plog << '\n';
+        }
+      for (std::size_t i = 0; i < names.size(); ++i)
+        tbox::plog << "IFEDMethod::" << function_name << "(): " << names[i]
+                   << " memory consumption: min = "
+                   << reduced[i].min / n_bytes_per_mb << " MB (processor "
+                   << reduced[i].min_index
+                   << "), max = " << reduced[i].max / n_bytes_per_mb
+                   << " MB (processor " << reduced[i].max_index << ")"
+                   << std::endl;
+    }
+
+    /**
+     * Return the total time all transactions run by @p scheduler spent
+     * computing.
+     */
+    double
+    get_total_compute_time(const TransactionScheduler &scheduler)
+    {
+      double time = 0.0;
+      for (std::size_t i = 0; i < scheduler.n_transactions(); ++i)
+        time += scheduler.get_compute_time(i);
+      return time;
+    }
+
+    /**
+     * Add the wall clock time since @p start_time, the time spent waiting for
+     * MPI requests @p wait_time, the number of interaction points of each part
+     * in @p work, and the number of solver iterations of each part in
+     * @p n_steps to @p counters, with names starting with @p phase. As in
+     * log_transaction_times(), the parts come before the surface parts.
+     */
+    void
+    add_phase_counters(PerformanceCounters                          &counters,
+                       const std::string                            &phase,
+                       const double                                  start_time,
+                       const double                                  wait_time,
+                       const std::vector<std::pair<double, double>> &work,
+                       const std::vector<unsigned int>              &n_steps,
+                       const std::size_t                             n_parts)
+    {
+      auto part_name = [&](const std::size_t i)
+      {
+        return i < n_parts ? "part_" + std::to_string(i) :
+                             "surface_part_" + std::to_string(i - n_parts);
+      };
+
+      counters.add(phase + "_time", MPI_Wtime() - start_time);
+      counters.add(phase + "_mpi_wait_time", wait_time);
+      for (std::size_t i = 0; i < work.size(); ++i)
+        {
+          counters.add(phase + "_points", work[i].first);
+          counters.add(phase + "_points_" + part_name(i), work[i].first);
+        }
+      for (std::size_t i = 0; i < n_steps.size(); ++i)
+        counters.add(phase + "_cg_iterations_" + part_name(i), n_steps[i]);
+    }
+
+    /**
+     * Compute the load vector of a part. If @p use_matrix_free is true then
+     * the stresses which can be evaluated with the part's MatrixFree object
+     * (see Part::get_matrix_free_quadrature_index()) are computed that way
+     * and the remaining forces are computed with compute_load_vector().
+     *
+     * Return whether or not @p force_rhs was compressed, which is the case
+     * when every force was computed with the matrix-free version of
+     * compute_volumetric_pk1_load_vector().
+     */
+    template <int dim, int spacedim>
+    bool
+    compute_part_load_vector(
+      const Part<dim, spacedim>                        &part,
+      const bool                                        use_matrix_free,
+      const unsigned int                                n_threads,
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const LinearAlgebra::distributed::Vector<double> &velocity,
+      LinearAlgebra::distributed::Vector<double>       &force_rhs)
+    {
+      const auto forces = part.get_force_contributions();
+      // group stresses by their quadrature rules
+      std::map<unsigned int, std::vector<ForceContribution<dim, spacedim> *>>
+        matrix_free_stresses;
+      for (unsigned int i = 0; i < forces.size(); ++i)
+        {
+          const unsigned int index = part.get_matrix_free_quadrature_index(i);
+          if (use_matrix_free && index != numbers::invalid_unsigned_int)
+            matrix_free_stresses[index].push_back(forces[i]);
+        }
+      // and get the (precomputed) groups of the remaining forces
+      std::vector<ForceContributionGroup<dim, spacedim>> &remaining_groups =
+        part.get_force_contribution_groups(use_matrix_free);
+
+      if constexpr (dim == spacedim)
+        for (const auto &pair : matrix_free_stresses)
+          compute_volumetric_pk1_load_vector(*part.get_matrix_free(),
+                                             pair.first,
+                                             pair.second,
+                                             time,
+                                             position,
+                                             force_rhs);
+      else
+        Assert(matrix_free_stresses.size() == 0, ExcFDLInternalError());
+
+      if (remaining_groups.size() > 0)
+        compute_load_vector(part.get_dof_handler(),
+                            remaining_groups,
+                            part.get_active_strains(),
+                            time,
+                            position,
+                            velocity,
+                            force_rhs,
+                            n_threads,
+                            part.get_reference_values_cache());
+
+      return remaining_groups.size() == 0 && matrix_free_stresses.size() > 0;
+    }
+
+    /**
+     * Get the number of kernel evaluations required to interpolate or spread
+     * a vector-valued field at one point with the kernel @p kernel_name, i.e.,
+     * one per stencil point and component.
+     */
+    template <int spacedim>
+    double
+    get_n_kernel_evaluations(const std::string &kernel_name)
+    {
+      const IBKernel kernel = get_ib_kernel(kernel_name);
+      const int      width =
+        kernel == IBKernel::Unknown ?
+               IBTK::LEInteractor::getStencilSize(kernel_name) :
+               get_ib_kernel_width(kernel);
+      return spacedim * std::pow(double(width), spacedim);
+    }
+
+    /**
+     * Get the ghost width required to interpolate or spread with the kernel
+     * @p kernel_name at interaction points which lie at most
+     * @p ghost_cell_fraction cells outside of their patches.
+     *
+     * LEInteractor::getMinimumGhostWidth() includes one extra cell for points
+     * at the edge of a patch (and for the staggering of side-centered data),
+     * which also covers points up to one cell outside of it. Points farther
+     * away need correspondingly more ghost cells.
+     */
+    int
+    get_kernel_ghost_width(const std::string &kernel_name,
+                           const double       ghost_cell_fraction)
+    {
+      const int extra_width =
+        std::max(0, int(std::ceil(ghost_cell_fraction)) - 1);
+      return IBTK::LEInteractor::getMinimumGhostWidth(kernel_name) +
+             extra_width;
+    }
+
+    /**
+     * Check that the patch data with index @p data_index has at least
+     * @p required_ghosts ghost cells in each direction. The kernels would
+     * otherwise read or write past the end of each patch's data.
+     */
+    template <int spacedim>
+    void
+    check_ghost_width(const int                        data_index,
+                      const hier::IntVector<spacedim> &required_ghosts,
+                      const std::string               &function_name)
+    {
+      auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+      const hier::IntVector<spacedim> data_ghosts =
+        var_db->getPatchDescriptor()
+          ->getPatchDataFactory(data_index)
+          ->getGhostCellWidth();
+      for (int d = 0; d < spacedim; ++d)
+        AssertThrow(data_ghosts[d] >= required_ghosts[d],
+                    ExcMessage("IFEDMethod::" + function_name +
+                               "(): the data has " +
+                               std::to_string(data_ghosts[d]) +
+                               " ghost cells in direction " +
+                               std::to_string(d) + " but the kernels and "
+                               "ghost_cell_fraction require " +
+                               std::to_string(required_ghosts[d]) + "."));
+    }
+
+    /**
+     * Get the workload added for each interaction point of a part which uses
+     * the kernel @p kernel_name, according to the workload cost model
+     * specified in @p input_db.
+     */
+    template <int spacedim>
+    double
+    get_workload_point_weight(const tbox::Pointer<tbox::Database> &input_db,
+                              const std::string                   &kernel_name)
+    {
+      if (input_db->keyExists("workload_point_weight"))
+        return input_db->getDouble("workload_point_weight");
+
+      std::string model =
+        input_db->getStringWithDefault("workload_cost_model", "COUNT");
+      std::transform(model.begin(),
+                     model.end(),
+                     model.begin(),
+                     [](const unsigned char c) { return std::toupper(c); });
+      if (model == "COUNT")
+        return 1.0;
+      else if (model == "KERNEL")
+        return get_n_kernel_evaluations<spacedim>(kernel_name);
+      else
+        AssertThrow(false,
+                    ExcMessage("Unknown workload cost model " + model +
+                               ": valid values are COUNT and KERNEL."));
+      return 1.0;
+    }
+
+    /**
+     * Return the total number of bytes sent and received by Scatter objects.
+     */
+    double
+    get_total_scatter_bytes()
+    {
+      return double(get_total_scatter_bytes_sent()) +
+             double(get_total_scatter_bytes_received());
+    }
+
+    /**
+     * Log the throughput of an interpolation or spreading operation which
+     * started at @p start_time, spent @p wait_time waiting for MPI requests,
+     * and sent and received @p n_network_bytes with Scatter objects. Here
+     * @p work contains the number of interaction points of the parts (which
+     * use the kernels @p kernel_names) followed by those of the surface parts
+     * (which use @p surface_kernel_names). Each kernel evaluation reads (and,
+     * if @p n_accesses is 2, writes) one double of Eulerian data.
+     *
+     * The achieved memory bandwidth is computed from the time each processor
+     * spends not waiting and the network bandwidth from the total time: both
+     * are compared to the per-processor peaks peak_memory_bandwidth and
+     * peak_network_bandwidth in @p input_db. The fraction of the time lost to
+     * load imbalance is the difference between the maximum and mean
+     * computation times divided by the total time. The largest of these three
+     * fractions is reported as the likely limit.
+     */
+    template <int spacedim>
+    void
+    log_throughput(
+      const tbox::Pointer<tbox::Database>          &input_db,
+      const std::string                            &function_name,
+      const double                                  start_time,
+      const double                                  wait_time,
+      const double                                  n_network_bytes,
+      const std::vector<std::pair<double, double>> &work,
+      const std::vector<std::string>               &kernel_names,
+      const std::vector<std::string>               &surface_kernel_names,
+      const unsigned int                            n_accesses)
+    {
+      AssertDimension(work.size(),
+                      kernel_names.size() + surface_kernel_names.size());
+      const double elapsed_time   = MPI_Wtime() - start_time;
+      double       n_points       = 0.0;
+      double       n_memory_bytes = 0.0;
+      for (std::size_t i = 0; i < work.size(); ++i)
+        {
+          const std::string &kernel_name =
+            i < kernel_names.size() ?
+              kernel_names[i] :
+              surface_kernel_names[i - kernel_names.size()];
+          n_points += work[i].first;
+          n_memory_bytes += work[i].first * n_accesses * sizeof(double) *
+                            get_n_kernel_evaluations<spacedim>(kernel_name);
+        }
+
+      const std::vector<Utilities::MPI::MinMaxAvg> reduced =
+        Utilities::MPI::min_max_avg(
+          std::vector<double>{elapsed_time,
+                              std::max(elapsed_time - wait_time, 0.0),
+                              n_points,
+                              n_memory_bytes,
+                              n_network_bytes},
+          IBTK::IBTK_MPI::getCommunicator());
+      if (IBTK::IBTK_MPI::getRank() != 0)
+        return;
+
+      const double max_time          = std::max(reduced[0].max, 1e-300);
+      const double total_time        = std::max(reduced[0].sum, 1e-300);
+      const double compute_time      = std::max(reduced[1].sum, 1e-300);
+      const double memory_bandwidth  = reduced[3].sum / compute_time;
+      const double network_bandwidth = reduced[4].sum / total_time;
+
+      const double imbalance = (reduced[1].max - reduced[1].avg) / max_time;
+
+      const double peak_memory_bandwidth =
+        input_db->getDoubleWithDefault("peak_memory_bandwidth", 0.0);
+      const double peak_network_bandwidth =
+        input_db->getDoubleWithDefault("peak_network_bandwidth", 0.0);
+      auto log_bandwidth = [&](const double bandwidth, const double peak)
+      {
+        tbox::plog << bandwidth << " B/s";
+        if (peak > 0.0)
+          tbox::plog << " (" << 100.0 * bandwidth / peak << "% of peak)";
+      };
+
+      tbox::plog << "IFEDMethod::" << function_name << "(): "
+                 << reduced[2].sum / max_time << " points/s, memory ";
+      log_bandwidth(memory_bandwidth, peak_memory_bandwidth);
+      tbox::plog << ", network ";
+      log_bandwidth(network_bandwidth, peak_network_bandwidth);
+      tbox::plog << ", " << 100.0 * imbalance << "% of time lost to load "
+                 << "imbalance";
+
+      const std::vector<std::pair<double, std::string>> limits{
+        {imbalance, "load imbalance"},
+        {peak_memory_bandwidth > 0.0 ?
+           memory_bandwidth / peak_memory_bandwidth :
+           0.0,
+         "memory bandwidth"},
+        {peak_network_bandwidth > 0.0 ?
+           network_bandwidth / peak_network_bandwidth :
+           0.0,
+         "communication"}};
+      tbox::plog << "; likely limited by "
+                 << std::max_element(limits.begin(), limits.end())->second
+                 << std::endl;
+    }
+
+    /**
+     * Add the options enabled by the performance profile named by the
+     * <code>performance_profile</code> key of @p input_db, if any, to
+     * @p input_db and return it. Options which are already set are not
+     * changed.
+     */
+    tbox::Pointer<tbox::Database>
+    apply_performance_profile(tbox::Pointer<tbox::Database> input_db)
+    {
+      std::string profile =
+        input_db->getStringWithDefault("performance_profile", "DEFAULT");
+      std::transform(profile.begin(),
+                     profile.end(),
+                     profile.begin(),
+                     [](const unsigned char c) { return std::toupper(c); });
+      if (profile == "DEFAULT")
+        return input_db;
+      AssertThrow(profile == "THROUGHPUT",
+                  ExcMessage("Unknown performance profile " + profile));
+
+      const auto put_bool = [&](const std::string &key, const bool value)
+      {
+        if (!input_db->keyExists(key))
+          input_db->putBool(key, value);
+      };
+      const auto put_string =
+        [&](const std::string &key, const std::string &value)
+      {
+        if (!input_db->keyExists(key))
+          input_db->putString(key, value);
+      };
+      put_bool("use_matrix_free_stresses", true);
+      put_string("initial_guess_type", "INCREMENTAL_PROJECTION");
+      put_bool("sort_patch_cells", true);
+      put_bool("sort_spread_points", true);
+      put_bool("store_plan_weights", true);
+      put_string("scatter_backend", "PERSISTENT");
+      put_bool("sparse_workload_transfer", true);
+      put_bool("sparse_ghost_accumulation", true);
+      return input_db;
+    }
+
+    /**
+     * Return the database used to set up the secondary hierarchy's
+     * GriddingAlgorithm: i.e., the GriddingAlgorithm database in @p input_db
+     * with <code>largest_patch_size</code> replaced by
+     * <code>secondary_largest_patch_size</code>, if that key exists.
+     */
+    tbox::Pointer<tbox::Database>
+    get_secondary_gridding_db(const tbox::Pointer<tbox::Database> &input_db)
+    {
+      const std::string key = "secondary_largest_patch_size";
+      if (!input_db->keyExists(key))
+        return input_db->getDatabase("GriddingAlgorithm");
+
+      AssertThrow(input_db->getArraySize(key) == NDIM,
+                  ExcMessage("secondary_largest_patch_size should have one "
+                             "entry per coordinate direction."));
+      std::array<int, NDIM> largest_patch_size;
+      input_db->getIntegerArray(key, largest_patch_size.data(), NDIM);
+      for (const int size : largest_patch_size)
+        AssertThrow(size > 0,
+                    ExcMessage("secondary_largest_patch_size should be "
+                               "positive."));
+
+      tbox::Pointer<tbox::Database> gridding_db =
+        copy_database(input_db->getDatabase("GriddingAlgorithm"), "");
+      // use the same size on every level
+      gridding_db->putDatabase("largest_patch_size")
+        ->putIntegerArray("level_0", largest_patch_size.data(), NDIM);
+      return gridding_db;
+    }
+
+    /**
+     * Return, for each level number up to @p finest_ln, whether or not the
+     * level of @p secondary has the same layout as the level of @p primary
+     * (see have_same_layout()). Levels coarser than @p coarsest_ln are
+     * marked as not matching.
+     */
+    template <int spacedim>
+    std::vector<bool>
+    get_same_layout_levels(
+      const tbox::Pointer<hier::PatchHierarchy<spacedim>> &primary,
+      const tbox::Pointer<hier::PatchHierarchy<spacedim>> &secondary,
+      const int                                            coarsest_ln,
+      const int                                            finest_ln)
+    {
+      std::vector<bool> same_layout(finest_ln + 1, false);
+      for (int ln = coarsest_ln; ln <= finest_ln; ++ln)
+        same_layout[ln] = have_same_layout(primary->getPatchLevel(ln),
+                                           secondary->getPatchLevel(ln));
+      return same_layout;
+    }
+  } // namespace
+
   //
   // Initialization
   //
@@ -92,28 +1212,248 @@ namespace fdl
     std::vector<Part<dim - 1, spacedim>> &&input_surface_parts,
     std::vector<Part<dim, spacedim>>     &&input_parts,
     const bool                             register_for_restart)
+    : IFEDMethod<dim, spacedim>(object_name,
+                                input_input_db,
+                                std::move(input_surface_parts),
+                                std::move(input_parts),
+                                {},
+                                register_for_restart)
+  {}
+
+  template <int dim, int spacedim>
+  IFEDMethod<dim, spacedim>::IFEDMethod(
+    const std::string                     &object_name,
+    tbox::Pointer<tbox::Database>          input_input_db,
+    std::vector<Part<dim - 1, spacedim>> &&input_surface_parts,
+    std::vector<Part<dim, spacedim>>     &&input_parts,
+    std::vector<MarkerPoints<spacedim>>  &&input_marker_points,
+    const bool                             register_for_restart)
     : IFEDMethodBase<dim, spacedim>(object_name,
                                     std::move(input_surface_parts),
                                     std::move(input_parts),
+                                    std::move(input_marker_points),
                                     register_for_restart)
-    , input_db(copy_database(input_input_db))
+    , input_db(apply_performance_profile(copy_database(input_input_db)))
+    , use_displacement_regrid_policy(
+        input_db->getBoolWithDefault("use_displacement_regrid_policy", false))
+    , regrid_policy(input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0),
+                    input_db->getDoubleWithDefault("regrid_safety_factor", 1.0))
+    , regrid_displacement(std::numeric_limits<double>::quiet_NaN())
     , ghosts(0)
+    , interpolation_ghosts(0)
+    , spreading_ghosts(0)
     , secondary_hierarchy(object_name + "::secondary_hierarchy",
-                          input_db->getDatabase("GriddingAlgorithm"),
+                          get_secondary_gridding_db(input_db),
                           input_db->getDatabase("LoadBalancer"))
   {
-    const std::string interaction =
-      input_db->getStringWithDefault("interaction", "ELEMENTAL");
-    if (interaction == "ELEMENTAL")
+    this->incremental_bbox_update =
+      input_db->getBoolWithDefault("incremental_bbox_update", false);
+    this->bbox_update_tolerance =
+      input_db->getDoubleWithDefault("bbox_update_tolerance", 0.0);
+    AssertThrow(this->bbox_update_tolerance >= 0.0,
+                ExcMessage("bbox_update_tolerance should be nonnegative."));
+    this->bbox_encoding =
+      input_db->getBoolWithDefault("compress_bboxes", false) ?
+        BoundingBoxEncoding::Compressed :
+        BoundingBoxEncoding::Full;
+    this->node_shared_geometry =
+      input_db->getBoolWithDefault("node_shared_geometry", false);
+    AssertThrow(!this->node_shared_geometry || !this->incremental_bbox_update,
+                ExcMessage("node_shared_geometry and incremental_bbox_update "
+                           "cannot be used together."));
+    const int n_bbox_points_1d =
+      input_db->getIntegerWithDefault("n_bbox_points_1d", 0);
+    AssertThrow(n_bbox_points_1d >= 0,
+                ExcMessage("n_bbox_points_1d should be nonnegative."));
+    this->n_bbox_points_1d = n_bbox_points_1d;
+    this->nodal_bboxes =
+      input_db->getBoolWithDefault("nodal_bboxes", false);
+    this->restart_file_directory =
+      input_db->getStringWithDefault("restart_file_directory", "");
+    this->asynchronous_restart_files =
+      input_db->getBoolWithDefault("asynchronous_restart_files", false);
+    AssertThrow(!this->asynchronous_restart_files ||
+                  !this->restart_file_directory.empty(),
+                ExcMessage("asynchronous_restart_files requires "
+                           "restart_file_directory to be set."));
+    this->checkpoint_setup_data =
+      input_db->getBoolWithDefault("checkpoint_setup_data", false);
+    this->portable_restart_files =
+      input_db->getBoolWithDefault("portable_restart_files", false);
+    AssertThrow(!this->portable_restart_files ||
+                  !this->restart_file_directory.empty(),
+                ExcMessage("portable_restart_files requires "
+                           "restart_file_directory to be set."));
+    this->delta_restart_files =
+      input_db->getBoolWithDefault("delta_restart_files", false);
+    AssertThrow(!this->delta_restart_files ||
+                  !this->restart_file_directory.empty(),
+                ExcMessage("delta_restart_files requires "
+                           "restart_file_directory to be set."));
+    const int restart_keyframe_interval =
+      input_db->getIntegerWithDefault("restart_keyframe_interval", 10);
+    AssertThrow(restart_keyframe_interval >= 0,
+                ExcMessage("restart_keyframe_interval should be "
+                           "nonnegative."));
+    this->restart_keyframe_interval = restart_keyframe_interval;
+    AssertThrow(!this->checkpoint_setup_data ||
+                  !this->restart_file_directory.empty(),
+                ExcMessage("checkpoint_setup_data requires "
+                           "restart_file_directory to be set."));
+    check_part_communicators(this->parts, this->surface_parts);
+    if (input_db->getBoolWithDefault("threaded_mass_solves", false))
+      check_threaded_mass_solves(this->parts, this->surface_parts);
+    if (input_db->getBoolWithDefault("batched_mass_solves", false))
+      check_batched_mass_solves(
+        this->parts,
+        this->surface_parts,
+        input_db->getBoolWithDefault("threaded_mass_solves", false));
+    // Check the mass matrix type now instead of in the middle of a time step
+    if (get_mass_solver_settings(input_db).mixed_precision)
+      {
+        const auto log_fallback = [](const auto        &parts,
+                                     const std::string &kind) {
+          for (unsigned int i = 0; i < parts.size(); ++i)
+            if (!parts[i].supports_single_precision_mass_operator())
+              tbox::plog << "IFEDMethod::IFEDMethod(): " << kind << " part "
+                         << i << " does not support single precision mass "
+                         << "operators, so its mass matrix solves will be "
+                         << "done in double precision\n";
+        };
+        log_fallback(this->surface_parts, "surface");
+        log_fallback(this->parts, "volumetric");
+      }
+    const double cache_size =
+      input_db->getDoubleWithDefault("reference_values_cache_size", 0.0);
+    AssertThrow(cache_size >= 0.0,
+                ExcMessage("reference_values_cache_size should be "
+                           "nonnegative."));
+    if (cache_size > 0.0)
+      for (auto &part : this->parts)
+        part.setup_reference_values_cache(
+          static_cast<std::size_t>(cache_size * 1024.0 * 1024.0));
+    if (input_db->getBoolWithDefault("calibrate_workload", false))
+      {
+        const int min_n_steps =
+          input_db->getIntegerWithDefault("workload_calibration_min_steps",
+                                          10);
+        AssertThrow(min_n_steps > 0,
+                    ExcMessage("workload_calibration_min_steps should be "
+                               "positive."));
+        workload_calibration = std::make_unique<WorkloadCalibration>(
+          IBTK::IBTK_MPI::getCommunicator(), min_n_steps);
+      }
+    if (input_db->getBoolWithDefault("performance_counters", false))
+      this->performance_counters = std::make_unique<PerformanceCounters>(
+        IBTK::IBTK_MPI::getCommunicator(),
+        input_db->getStringWithDefault("performance_counters_file", ""));
+    this->trace_file = input_db->getStringWithDefault("trace_file", "");
+    if (!this->trace_file.empty())
+      {
+        const int n_steps = input_db->getIntegerWithDefault("trace_n_steps", 5);
+        AssertThrow(n_steps > 0,
+                    ExcMessage("trace_n_steps should be positive."));
+        this->trace_n_steps = n_steps;
+        this->tracer =
+          std::make_unique<Tracer>(IBTK::IBTK_MPI::getCommunicator());
+      }
+
+    // The interaction type is given either once or once per (surface) part,
+    // so that the cheaper nodal interaction can be used by the parts which are
+    // fine relative to the grid
+    auto get_interaction_types = [&](const std::string &key,
+                                     const std::size_t  n_collection,
+                                     const std::string &default_type)
+    {
+      std::vector<std::string> types(n_collection, default_type);
+      if (n_collection > 0 && input_db->keyExists(key))
+        {
+          const int n_values = input_db->getArraySize(key);
+          AssertThrow(n_values == 1 ||
+                        n_values == static_cast<int>(n_collection),
+                      ExcMessage("The number of values of " + key +
+                                 " should either be 1 or equal the number of "
+                                 "(surface) parts."));
+          std::vector<std::string> input_types(n_values);
+          input_db->getStringArray(key, input_types.data(), n_values);
+          for (unsigned int i = 0; i < n_collection; ++i)
+            types[i] = input_types[n_values == 1 ? 0 : i];
+        }
+      for (const std::string &type : types)
+        AssertThrow(type == "ELEMENTAL" || type == "NODAL",
+                    ExcMessage("unsupported interaction type " + type + "."));
+      return types;
+    };
+    const std::vector<std::string> part_interactions =
+      get_interaction_types("interaction", this->parts.size(), "ELEMENTAL");
+    // Surface parts use the same type as the parts unless specified otherwise
+    std::string default_surface_interaction = "ELEMENTAL";
+    if (input_db->keyExists("interaction") &&
+        input_db->getArraySize("interaction") == 1)
+      default_surface_interaction = input_db->getString("interaction");
+    const std::vector<std::string> surface_part_interactions =
+      get_interaction_types("surface_interaction",
+                            this->surface_parts.size(),
+                            default_surface_interaction);
+    for (const std::string &type : surface_part_interactions)
+      AssertThrow(type != "ELEMENTAL", ExcFDLNotImplemented());
+
+    const bool any_elemental =
+      std::find(part_interactions.begin(),
+                part_interactions.end(),
+                "ELEMENTAL") != part_interactions.end();
+    // IBFEMethod uses this value - lower values aren't guaranteed to work.
+    // If dx = dX then we can use a lower density.
+    const double default_density = 2.0;
+    // The interaction quadrature is chosen independently of the mechanics
+    // mesh, so parts with coarse, high-order elements may use denser or
+    // higher-order interaction point sets than other parts
+    std::vector<double> densities(this->parts.size(), default_density);
+    std::vector<int>    interaction_n_points_1D(this->parts.size(), 0);
+    if (this->parts.size() > 0 && input_db->keyExists("IB_point_density"))
+      {
+        const int n_values = input_db->getArraySize("IB_point_density");
+        AssertThrow(n_values == 1 ||
+                      n_values == static_cast<int>(this->parts.size()),
+                    ExcMessage("The number of values of IB_point_density "
+                               "should either be 1 or equal the number of "
+                               "parts."));
+        std::vector<double> input_values(n_values);
+        input_db->getDoubleArray("IB_point_density",
+                                 input_values.data(),
+                                 n_values);
+        for (unsigned int i = 0; i < this->parts.size(); ++i)
+          densities[i] = input_values[n_values == 1 ? 0 : i];
+      }
+    for (const double density : densities)
+      AssertThrow(density > 0.0,
+                  ExcMessage("IB_point_density should be positive."));
+    if (this->parts.size() > 0 &&
+        input_db->keyExists("interaction_n_points_1D"))
+      {
+        const int n_values = input_db->getArraySize("interaction_n_points_1D");
+        AssertThrow(n_values == 1 ||
+                      n_values == static_cast<int>(this->parts.size()),
+                    ExcMessage("The number of values of "
+                               "interaction_n_points_1D should either be 1 "
+                               "or equal the number of parts."));
+        std::vector<int> input_values(n_values);
+        input_db->getIntegerArray("interaction_n_points_1D",
+                                  input_values.data(),
+                                  n_values);
+        for (unsigned int i = 0; i < this->parts.size(); ++i)
+          interaction_n_points_1D[i] = input_values[n_values == 1 ? 0 : i];
+      }
+    for (const int n_points_1D : interaction_n_points_1D)
+      AssertThrow(n_points_1D >= 0,
+                  ExcMessage("interaction_n_points_1D should be "
+                             "nonnegative."));
+
+    // Default to minimum density:
+    auto density_kind = DensityKind::Minimum;
+    auto guess_type   = InitialGuessType::Projection;
+    if (any_elemental)
       {
-        AssertThrow(this->n_surface_parts() == 0, ExcFDLNotImplemented());
-        // IBFEMethod uses this value - lower values aren't guaranteed to work.
-        // If dx = dX then we can use a lower density.
-        const double density =
-          input_db->getDoubleWithDefault("IB_point_density", 2.0);
-
-        // Default to minimum density:
-        auto        density_kind = DensityKind::Minimum;
         std::string density_kind_string =
           input_db->getStringWithDefault("density_kind", "Minimum");
         std::transform(density_kind_string.begin(),
@@ -127,55 +1467,91 @@ namespace fdl
         else
           AssertThrow(false, ExcFDLNotImplemented());
 
-        auto init_elemental = [&](auto       &inters,
-                                  auto       &guess_1,
-                                  auto       &guess_2,
-                                  const auto &collection)
+        std::string guess_type_string =
+          input_db->getStringWithDefault("initial_guess_type", "PROJECTION");
+        std::transform(guess_type_string.begin(),
+                       guess_type_string.end(),
+                       guess_type_string.begin(),
+                       [](const unsigned char c) { return std::tolower(c); });
+        if (guess_type_string == "projection")
+          guess_type = InitialGuessType::Projection;
+        else if (guess_type_string == "incremental_projection")
+          guess_type = InitialGuessType::IncrementalProjection;
+        else if (guess_type_string == "linear_extrapolation")
+          guess_type = InitialGuessType::LinearExtrapolation;
+        else if (guess_type_string == "quadratic_extrapolation")
+          guess_type = InitialGuessType::QuadraticExtrapolation;
+        else if (guess_type_string == "periodic_projection")
+          guess_type = InitialGuessType::PeriodicProjection;
+        else
+          AssertThrow(false, ExcFDLNotImplemented());
+      }
+    const int n_guess_vectors =
+      input_db->getIntegerWithDefault("n_guess_vectors", 3);
+    double guess_period   = 0.0;
+    int    n_guess_phases = 0;
+    if (guess_type == InitialGuessType::PeriodicProjection)
+      {
+        AssertThrow(input_db->keyExists("guess_period"),
+                    ExcMessage("guess_period must be set in the input "
+                               "database when initial_guess_type is "
+                               "PERIODIC_PROJECTION."));
+        guess_period = input_db->getDouble("guess_period");
+        n_guess_phases = input_db->getIntegerWithDefault("n_guess_phases", 20);
+      }
+
+    auto init_interactions = [&](auto                           &inters,
+                                 auto                           &guess_1,
+                                 auto                           &guess_2,
+                                 const auto                     &collection,
+                                 const std::vector<std::string> &types)
+    {
+      constexpr int structdim =
+        std::remove_reference_t<decltype(collection[0])>::dimension;
+      for (unsigned int i = 0; i < collection.size(); ++i)
         {
-          constexpr int structdim =
-            std::remove_reference_t<decltype(collection[0])>::dimension;
-          for (unsigned int i = 0; i < collection.size(); ++i)
+          if (types[i] == "ELEMENTAL")
             {
+              // Only parts (not surface parts) support elemental interaction
+              Assert(structdim == dim, ExcFDLInternalError());
               const unsigned int n_points_1D =
-                collection[i].get_dof_handler().get_fe().tensor_degree() + 1;
+                interaction_n_points_1D[i] > 0 ?
+                  interaction_n_points_1D[i] :
+                  collection[i].get_dof_handler().get_fe().tensor_degree() +
+                    1;
               inters.emplace_back(
                 std::make_unique<ElementalInteraction<structdim, spacedim>>(
-                  n_points_1D, density, density_kind));
-              guess_1.emplace_back(
-                input_db->getIntegerWithDefault("n_guess_vectors", 3));
-              guess_2.emplace_back(
-                input_db->getIntegerWithDefault("n_guess_vectors", 3));
+                  n_points_1D, densities[i], density_kind));
             }
-        };
-        init_elemental(interactions,
-                       force_guesses,
-                       velocity_guesses,
-                       this->parts);
-        init_elemental(surface_interactions,
-                       surface_force_guesses,
-                       surface_velocity_guesses,
-                       this->surface_parts);
-      }
-    else if (interaction == "NODAL")
-      {
-        auto init_nodal = [&](auto &inters, const auto &collection)
-        {
-          constexpr int structdim =
-            std::remove_reference_t<decltype(collection[0])>::dimension;
-          for (unsigned int i = 0; i < collection.size(); ++i)
+          else
             inters.emplace_back(
               std::make_unique<NodalInteraction<structdim, spacedim>>());
-        };
-        init_nodal(interactions, this->parts);
-        init_nodal(surface_interactions, this->surface_parts);
-      }
-    else
-      {
-        AssertThrow(false,
-                    ExcMessage("unsupported interaction type " + interaction +
-                               "."));
-      }
-
+          // Nodal interactions never solve with the mass matrix but keep the
+          // guesses indexed by part number
+          guess_1.emplace_back(n_guess_vectors,
+                               guess_type,
+                               guess_period,
+                               n_guess_phases);
+          guess_2.emplace_back(n_guess_vectors,
+                               guess_type,
+                               guess_period,
+                               n_guess_phases);
+        }
+    };
+    init_interactions(interactions,
+                      force_guesses,
+                      velocity_guesses,
+                      this->parts,
+                      part_interactions);
+    init_interactions(surface_interactions,
+                      surface_force_guesses,
+                      surface_velocity_guesses,
+                      this->surface_parts,
+                      surface_part_interactions);
+
+    // Interaction points may be this many cells outside of their patches
+    const double ghost_cell_fraction =
+      input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0);
     auto do_kernel = [&](const std::string        &key,
                          const auto               &collection,
                          std::vector<std::string> &kernels)
@@ -204,18 +1580,123 @@ namespace fdl
               std::fill(kernels.begin() + 1, kernels.end(), kernels.front());
             }
 
-          // now that we know that, we know the ghost requirements
+          // now that we know that, we know the ghost requirements. Both
+          // operations currently use the same kernels and points.
           for (const std::string &kernel : kernels)
             {
               const int ghost_width =
-                IBTK::LEInteractor::getMinimumGhostWidth(kernel);
+                get_kernel_ghost_width(kernel, ghost_cell_fraction);
               for (int d = 0; d < spacedim; ++d)
-                ghosts[d] = std::max(ghosts[d], ghost_width);
+                {
+                  interpolation_ghosts[d] =
+                    std::max(interpolation_ghosts[d], ghost_width);
+                  spreading_ghosts[d] =
+                    std::max(spreading_ghosts[d], ghost_width);
+                }
             }
         }
     };
     do_kernel("IB_kernel", this->parts, ib_kernels);
     do_kernel("surface_IB_kernel", this->surface_parts, surface_ib_kernels);
+    do_kernel("marker_point_IB_kernel",
+              this->marker_points,
+              marker_point_ib_kernels);
+    marker_point_interactions.resize(this->marker_points.size());
+    for (int d = 0; d < spacedim; ++d)
+      ghosts[d] = std::max(interpolation_ghosts[d], spreading_ghosts[d]);
+
+    // Like the IB kernels, some integer options are either given once or once
+    // per (surface) part. Parts and then surface parts are stored in the same
+    // array.
+    auto do_per_part_integer = [&](const std::string &key,
+                                   const std::size_t  n_collection,
+                                   const unsigned int offset,
+                                   std::vector<int>  &values)
+    {
+      if (n_collection == 0 || !input_db->keyExists(key))
+        return;
+      const int n_values = input_db->getArraySize(key);
+      AssertThrow(n_values == 1 || n_values == static_cast<int>(n_collection),
+                  ExcMessage("The number of values of " + key +
+                             " should either be 1 or equal the number of "
+                             "(surface) parts."));
+      std::vector<int> input_values(n_values);
+      input_db->getIntegerArray(key, input_values.data(), n_values);
+      for (unsigned int i = 0; i < n_collection; ++i)
+        values[offset + i] = input_values[n_values == 1 ? 0 : i];
+    };
+    auto do_per_part_integers = [&](const std::string &key,
+                                    std::vector<int>  &values)
+    {
+      do_per_part_integer(key, this->parts.size(), 0, values);
+      do_per_part_integer("surface_" + key,
+                          this->surface_parts.size(),
+                          this->parts.size(),
+                          values);
+    };
+    do_per_part_integers("level_number", this->interaction_level_numbers);
+    // negative values mean the finest level
+    for (int &level_number : this->interaction_level_numbers)
+      if (level_number < 0)
+        level_number = std::numeric_limits<int>::max();
+    do_per_part_integers("tag_buffer", this->tag_buffers);
+    for (const int tag_buffer : this->tag_buffers)
+      AssertThrow(tag_buffer >= 0,
+                  ExcMessage("tag_buffer should be nonnegative."));
+    do_per_part_integers("n_force_subcycles", this->n_force_subcycles);
+    for (const int n_subcycles : this->n_force_subcycles)
+      AssertThrow(n_subcycles >= 1,
+                  ExcMessage("n_force_subcycles should be positive."));
+    // Each activation window is a pair of (start, end) times
+    auto do_activation_windows = [&](const std::string &prefix, auto &parts)
+    {
+      for (unsigned int i = 0; i < parts.size(); ++i)
+        {
+          const std::string key =
+            prefix + "activation_windows_" + std::to_string(i);
+          if (!input_db->keyExists(key))
+            continue;
+          const int n_values = input_db->getArraySize(key);
+          AssertThrow(n_values % 2 == 0,
+                      ExcMessage("The number of values of " + key +
+                                 " should be even."));
+          std::vector<double> times(n_values);
+          input_db->getDoubleArray(key, times.data(), n_values);
+          std::vector<std::pair<double, double>> windows;
+          for (int j = 0; j < n_values; j += 2)
+            windows.emplace_back(times[j], times[j + 1]);
+          parts[i].set_activation_windows(windows);
+        }
+    };
+    do_activation_windows("", this->parts);
+    do_activation_windows("surface_", this->surface_parts);
+    this->tag_with_quadrature_points =
+      input_db->getBoolWithDefault("tag_with_quadrature_points", false);
+    const int n_tag_points_1d =
+      input_db->getIntegerWithDefault("n_tag_points_1d", 0);
+    AssertThrow(n_tag_points_1d >= 0,
+                ExcMessage("n_tag_points_1d should be nonnegative."));
+    this->n_tag_points_1d = n_tag_points_1d;
+
+    std::string step_type =
+      input_db->getStringWithDefault("forward_euler_step_type",
+                                     "FORWARD_EULER");
+    std::transform(step_type.begin(),
+                   step_type.end(),
+                   step_type.begin(),
+                   [](const unsigned char c) { return std::tolower(c); });
+    AssertThrow(step_type == "forward_euler" || step_type == "ab2",
+                ExcMessage("forward_euler_step_type should be either "
+                           "FORWARD_EULER or AB2."));
+    this->use_ab2_step = step_type == "ab2";
+
+    this->structure_cfl_target =
+      input_db->getDoubleWithDefault("structure_cfl_target", 0.5);
+    AssertThrow(this->structure_cfl_target > 0.0,
+                ExcMessage("structure_cfl_target should be positive."));
+    this->max_dt_growth = input_db->getDoubleWithDefault("max_dt_growth", 1.1);
+    AssertThrow(this->max_dt_growth >= 1.0,
+                ExcMessage("max_dt_growth should be at least one."));
 
     auto set_timer = [&](const char *name)
     { return tbox::TimerManager::getManager()->getTimer(name); };
@@ -247,6 +1728,8 @@ namespace fdl
     t_spread_force = set_timer("fdl::IFEDMethod::spreadForce()");
     t_spread_force_start_barrier =
       set_timer("fdl::IFEDMethod::spreadForce()[start_barrier]");
+    t_spread_force_accumulate =
+      set_timer("fdl::IFEDMethod::spreadForce()[accumulate]");
     t_compute_lagrangian_fluid_source =
       set_timer("fdl::IFEDMethod::computeLagrangianFluidSource()");
     t_spread_fluid_source = set_timer("fdl::IFEDMethod::spreadFluidSource()");
@@ -287,9 +1770,14 @@ namespace fdl
                                                             init_data_time,
                                                             initial_time);
 
-    secondary_hierarchy.reinit(this->patch_hierarchy->getFinestLevelNumber(),
+    secondary_hierarchy.reinit(this->get_interaction_level_numbers().front(),
                                this->patch_hierarchy->getFinestLevelNumber(),
                                this->patch_hierarchy);
+    secondary_level_matches_primary = get_same_layout_levels(
+      this->patch_hierarchy,
+      secondary_hierarchy.getSecondaryHierarchy(),
+      this->get_interaction_level_numbers().front(),
+      this->patch_hierarchy->getFinestLevelNumber());
 
     reinit_interactions();
   }
@@ -316,35 +1804,183 @@ namespace fdl
       IBAMR_TIMER_STOP(t_interpolate_velocity_start_barrier);
     }
 #endif
+    check_ghost_width(u_data_index,
+                      interpolation_ghosts,
+                      "interpolateVelocity");
     IBAMR_TIMER_START(t_interpolate_velocity);
-    (void)u_synch_scheds;
-    (void)u_ghost_fill_scheds;
-
-    // Update the secondary hierarchy:
-    secondary_hierarchy.transferPrimaryToSecondary(
-      this->patch_hierarchy->getFinestLevelNumber(),
-      u_data_index,
-      u_data_index,
-      data_time,
-      this->d_ib_solver->getVelocityPhysBdryOp());
+    const double start_time          = MPI_Wtime();
+    const double start_scatter_wait  = get_total_scatter_wait_time();
+    const double start_scatter_bytes = get_total_scatter_bytes();
+
+    // Parts on coarser levels need the velocity under finer levels, so
+    // synchronize it first.
+    const std::vector<int> level_numbers =
+      this->get_interaction_level_numbers();
+    const int finest_ln = this->patch_hierarchy->getFinestLevelNumber();
+    for (int ln = finest_ln; ln > level_numbers.front(); --ln)
+      if (ln < static_cast<int>(u_synch_scheds.size()) && u_synch_scheds[ln])
+        u_synch_scheds[ln]->coarsenData();
+
+    // Update the secondary hierarchy. Levels with the same layout as the
+    // primary hierarchy share its velocity data, so we only need to fill
+    // ghost values on the primary hierarchy.
+    auto             hierarchy = secondary_hierarchy.getSecondaryHierarchy();
+    std::vector<int> aliased_level_numbers;
+    const bool       interpolate_from_primary =
+      input_db->getBoolWithDefault("interpolate_from_primary_hierarchy", true);
+    const bool restrict_velocity_fill =
+      input_db->getBoolWithDefault("restrict_velocity_fill", false);
+    for (const int ln : level_numbers)
+      {
+        if (restrict_velocity_fill)
+          {
+            // Only fill the patches which can interact with a part. The
+            // other patches are allocated but never read.
+            const RestrictedVelocityFill &fill =
+              get_restricted_velocity_fill(ln, u_data_index);
+            const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+              hierarchy->getPatchLevel(ln);
+            if (!level->checkAllocated(u_data_index))
+              level->allocatePatchData(u_data_index, data_time);
+            if (fill.schedule)
+              {
+                fill.level->allocatePatchData(u_data_index, data_time);
+                fill.schedule->fillData(data_time);
+                alias_patch_data(level,
+                                 fill.level,
+                                 fill.patch_numbers,
+                                 u_data_index);
+                // The secondary hierarchy now owns the data
+                fill.level->deallocatePatchData(u_data_index);
+              }
+            aliased_level_numbers.push_back(ln);
+          }
+        else if (interpolate_from_primary &&
+                 secondary_level_matches_primary[ln] &&
+                 ln < static_cast<int>(u_ghost_fill_scheds.size()) &&
+                 u_ghost_fill_scheds[ln])
+          {
+            u_ghost_fill_scheds[ln]->fillData(data_time);
+            alias_patch_data(hierarchy->getPatchLevel(ln),
+                             this->patch_hierarchy->getPatchLevel(ln),
+                             u_data_index);
+            aliased_level_numbers.push_back(ln);
+          }
+        else
+          {
+            // Levels which shared the primary hierarchy's data do not have
+            // their own after the interpolation is done
+            const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+              hierarchy->getPatchLevel(ln);
+            if (!level->checkAllocated(u_data_index))
+              level->allocatePatchData(u_data_index, data_time);
+            secondary_hierarchy.transferPrimaryToSecondary(
+              ln,
+              u_data_index,
+              u_data_index,
+              data_time,
+              this->d_ib_solver->getVelocityPhysBdryOp());
+          }
+      }
 
     IBAMR_TIMER_START(t_interpolate_velocity_rhs);
-    std::vector<MPI_Request> requests;
+    // Each part's (or surface part's) transaction only depends on its own
+    // communication, so we start every scatter here and then advance each
+    // transaction as soon as its own data arrives. This overlaps the
+    // communication of each part with the computations of the others.
+    // Similarly, each part's mass solve starts as soon as its right-hand side
+    // is ready.
+    const std::size_t  n_parts  = this->parts.size();
+    const std::size_t  n_solves = n_parts + this->surface_parts.size();
+    for (auto *guesses : {&velocity_guesses, &surface_velocity_guesses})
+      for (auto &guess : *guesses)
+        guess.set_time(data_time);
+    const MassSolverSettings settings = get_mass_solver_settings(input_db);
+    const bool               use_threads =
+      input_db->getBoolWithDefault("threaded_mass_solves", false);
+    const bool batch_solves =
+      !settings.lumped &&
+      input_db->getBoolWithDefault("batched_mass_solves", false);
+
+    std::vector<unsigned int> n_steps(n_solves);
+    MassSolves                solves(n_solves, use_threads);
+    TransactionScheduler      scheduler;
+    const std::vector<std::string> lane_names =
+      get_lane_names(n_parts, this->surface_parts.size());
+    // Inactive parts do not add transactions
+    const std::vector<std::string> transaction_names =
+      get_active_lane_names(lane_names, this->active_parts);
+    Tracer *const tracer = this->tracer.get();
+    if (tracer)
+      scheduler.set_tracer(*tracer, transaction_names);
+    // The mass solves may run inside the transactions, so time them
+    // separately to only count interaction work in the workload calibration
+    double solve_time = 0.0;
+    // Spreading at the same position can reuse the overlap position
+    const bool reuse_overlap_position =
+      input_db->getBoolWithDefault("reuse_overlap_position", true);
+
     // native to overlap:
-    auto scatter_start = [&](const auto &collection,
-                             const auto &interactions,
-                             const auto &kernels,
-                             const auto &vectors,
-                             auto       &transactions,
-                             auto       &rhs_vectors)
+    auto scatter_start = [&](const auto       &collection,
+                             const auto       &interactions,
+                             const auto       &kernels,
+                             auto             &vectors,
+                             auto             &guesses,
+                             auto             &rhs_vectors,
+                             auto             &solutions,
+                             auto             &batched_indices,
+                             const std::size_t offset)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
           const auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          rhs_vectors.emplace_back(part.get_partitioner());
-          transactions.emplace_back(
+          rhs_vectors.emplace_back(vectors.get_temporary_vector(i));
+          rhs_vectors[i] = 0.0;
+          solutions.emplace_back();
+          // Inactive parts are not moved by the fluid: their velocity is
+          // just the zero right-hand side vector
+          if (!this->part_is_active(offset + i))
+            continue;
+          // If projection is actually interpolation we have a lot less to do
+          std::function<void()> solve;
+          if (!interactions[i]->projection_is_interpolation())
+            {
+              solutions[i] = vectors.get_temporary_vector(i);
+              solutions[i] = 0.0;
+              // Batched solves run once every transaction has finished
+              if (batch_solves)
+                {
+                  batched_indices.push_back(i);
+                  solve = []() {};
+                }
+              else
+                solve = [&part,
+                         &guess    = guesses[i],
+                         &solution = solutions[i],
+                         &rhs      = rhs_vectors[i],
+                         &n_step   = n_steps[offset + i],
+                         &lane     = lane_names[offset + i],
+                         tracer,
+                         settings]()
+                {
+                  const double start = MPI_Wtime();
+                  n_step =
+                    solve_mass_system(part, settings, guess, solution, rhs);
+                  if (tracer)
+                    tracer->add_event(
+                      lane, "CG solve", "compute", start, MPI_Wtime());
+                };
+            }
+          else
+            solve = []() {};
+
+          if (reuse_overlap_position)
+            interactions[i]->set_position_state(
+              vectors.get_position_state(i, data_time));
+          scheduler.add_projection_rhs_transaction(
+            *interactions[i],
             interactions[i]->compute_projection_rhs_scatter_start(
               kernels[i],
               u_data_index,
@@ -352,159 +1988,156 @@ namespace fdl
               vectors.get_position(i, data_time),
               part.get_dof_handler(),
               part.get_mapping(),
-              rhs_vectors[i]));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
+              rhs_vectors[i]),
+            [&solves, &solve_time, offset, i, solve]()
+            {
+              IBAMR_TIMER_START(t_interpolate_velocity_solve);
+              const double start = MPI_Wtime();
+              solves.add(offset + i, solve);
+              solve_time += MPI_Wtime() - start;
+              IBAMR_TIMER_STOP(t_interpolate_velocity_solve);
+            });
         }
     };
-    auto scatter_finish = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        transactions[i] =
-          interactions[i]->compute_projection_rhs_scatter_finish(
-            std::move(transactions[i]));
-    };
     // we emplace_back so use a deque to keep pointers valid
-    std::vector<std::unique_ptr<TransactionBase>> transactions,
-      surface_transactions;
     std::deque<LinearAlgebra::distributed::Vector<double>> rhs_vecs,
-      surface_rhs_vecs;
+      surface_rhs_vecs, velocities, surface_velocities;
+    std::vector<unsigned int> batched_indices, surface_batched_indices;
     scatter_start(this->parts,
                   interactions,
                   ib_kernels,
                   this->part_vectors,
-                  transactions,
-                  rhs_vecs);
+                  velocity_guesses,
+                  rhs_vecs,
+                  velocities,
+                  batched_indices,
+                  0);
     scatter_start(this->surface_parts,
                   surface_interactions,
                   surface_ib_kernels,
                   this->surface_part_vectors,
-                  surface_transactions,
-                  surface_rhs_vecs);
-    int ierr =
-      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-    requests.resize(0);
-    scatter_finish(interactions, transactions);
-    scatter_finish(surface_interactions, surface_transactions);
-
-    // Compute:
-    auto compute_transaction = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        transactions[i] = interactions[i]->compute_projection_rhs_intermediate(
-          std::move(transactions[i]));
-    };
-    compute_transaction(interactions, transactions);
-    compute_transaction(surface_interactions, surface_transactions);
-
-    // Move back:
-    auto accumulate_start = [&](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        {
-          transactions[i] =
-            interactions[i]->compute_projection_rhs_accumulate_start(
-              std::move(transactions[i]));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
-        }
-    };
-    auto accumulate_finish = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        interactions[i]->compute_projection_rhs_accumulate_finish(
-          std::move(transactions[i]));
-    };
-    accumulate_start(interactions, transactions);
-    accumulate_start(surface_interactions, surface_transactions);
-    ierr = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-    requests.resize(0);
-    accumulate_finish(interactions, transactions);
-    accumulate_finish(surface_interactions, surface_transactions);
+                  surface_velocity_guesses,
+                  surface_rhs_vecs,
+                  surface_velocities,
+                  surface_batched_indices,
+                  n_parts);
+    scheduler.run();
+    // Marker points do not need a mass solve: every processor has every
+    // point, so we only need to sum the interpolated values
+    for (unsigned int i = 0; i < this->marker_points.size(); ++i)
+      {
+        Vector<double> velocity;
+        marker_point_interactions[i].interpolate(
+          marker_point_ib_kernels[i],
+          u_data_index,
+          this->get_marker_point_position(i, data_time),
+          velocity);
+        this->set_marker_point_velocity(i, data_time, std::move(velocity));
+      }
+    // Don't keep the primary hierarchy's data alive
+    for (const int ln : aliased_level_numbers)
+      hierarchy->getPatchLevel(ln)->deallocatePatchData(u_data_index);
+    if (input_db->getBoolWithDefault("log_transaction_times", false))
+      log_transaction_times("interpolateVelocity",
+                            scheduler,
+                            transaction_names);
+    if (workload_calibration)
+      workload_calibration->add_time(get_total_compute_time(scheduler) -
+                                     solve_time);
 
     IBAMR_TIMER_STOP(t_interpolate_velocity_rhs);
-    // We cannot start the linear solve without first finishing this, so use a
-    // barrier to keep the timers accurate
+    // We cannot finish without first finishing the solves, so use a barrier
+    // to keep the timers accurate
 #ifdef FDL_ENABLE_TIMER_BARRIERS
     {
       IBAMR_TIMER_START(t_interpolate_velocity_solve_start_barrier)
-      ierr = MPI_Barrier(IBTK::IBTK_MPI::getCommunicator());
+      const int ierr = MPI_Barrier(IBTK::IBTK_MPI::getCommunicator());
       AssertThrowMPI(ierr);
       IBAMR_TIMER_STOP(t_interpolate_velocity_solve_start_barrier)
     }
 #endif
 
-    // Project:
+    // Project (i.e., finish the solves started above):
     IBAMR_TIMER_START(t_interpolate_velocity_solve);
-    auto do_solve = [&](const auto &collection,
-                        const auto &interactions,
-                        auto       &vectors,
-                        auto       &guesses,
-                        auto       &rhs_vectors)
+    solves.wait();
+    auto batched_solve = [&](const auto                      &collection,
+                             const std::vector<unsigned int> &indices,
+                             auto                            &guesses,
+                             auto                            &solutions,
+                             auto                            &rhs_vectors,
+                             const std::size_t                offset)
     {
-      for (unsigned int i = 0; i < collection.size(); ++i)
+      const unsigned int n_step = solve_mass_systems(
+        collection, indices, settings, guesses, solutions, rhs_vectors, tracer);
+      for (const unsigned int i : indices)
+        n_steps[offset + i] = n_step;
+    };
+    batched_solve(
+      this->parts, batched_indices, velocity_guesses, velocities, rhs_vecs, 0);
+    batched_solve(this->surface_parts,
+                  surface_batched_indices,
+                  surface_velocity_guesses,
+                  surface_velocities,
+                  surface_rhs_vecs,
+                  n_parts);
+    auto finish_solve = [&](const auto       &interactions,
+                            auto             &vectors,
+                            auto             &rhs_vectors,
+                            auto             &solutions,
+                            const std::size_t offset)
+    {
+      for (unsigned int i = 0; i < interactions.size(); ++i)
         {
-          if (interactions[i]->projection_is_interpolation())
-            {
-              // If projection is actually interpolation we have a lot less to
-              // do
-              vectors.set_velocity(i, data_time, std::move(rhs_vectors[i]));
-            }
+          if (!this->part_is_active(offset + i) ||
+              interactions[i]->projection_is_interpolation())
+            vectors.set_velocity(i, data_time, std::move(rhs_vectors[i]));
           else
             {
-              const auto   &part = collection[i];
-              SolverControl control(
-                input_db->getIntegerWithDefault("solver_iterations", 100),
-                input_db->getDoubleWithDefault("solver_relative_tolerance",
-                                               1e-6) *
-                  rhs_vectors[i].l2_norm());
-              SolverCG<LinearAlgebra::distributed::Vector<double>> cg(control);
-              LinearAlgebra::distributed::Vector<double>           velocity(
-                part.get_partitioner());
-
-              // If we mess up the matrix-free implementation will fix our
-              // partitioner: make sure we catch that case here
-              Assert(velocity.get_partitioner() == part.get_partitioner(),
-                     ExcFDLInternalError());
-              guesses[i].guess(velocity, rhs_vectors[i]);
-              cg.solve(part.get_mass_operator(),
-                       velocity,
-                       rhs_vectors[i],
-                       part.get_mass_preconditioner());
-              guesses[i].submit(velocity, rhs_vectors[i]);
-              // Same
-              Assert(velocity.get_partitioner() == part.get_partitioner(),
-                     ExcFDLInternalError());
-              vectors.set_velocity(i, data_time, std::move(velocity));
-
-              if (input_db->getBoolWithDefault("log_solver_iterations", false))
+              vectors.set_velocity(i, data_time, std::move(solutions[i]));
+              vectors.recycle_vector(i, std::move(rhs_vectors[i]));
+              if (!settings.lumped &&
+                  input_db->getBoolWithDefault("log_solver_iterations", false))
                 {
                   tbox::plog << "IFEDMethod::interpolateVelocity(): "
                              << "SolverCG<> converged in "
-                             << control.last_step() << " steps." << std::endl;
+                             << n_steps[offset + i] << " steps." << std::endl;
                 }
             }
         }
     };
-    do_solve(this->parts,
-             interactions,
-             this->part_vectors,
-             velocity_guesses,
-             rhs_vecs);
-    do_solve(this->surface_parts,
-             surface_interactions,
-             this->surface_part_vectors,
-             surface_velocity_guesses,
-             surface_rhs_vecs);
+    finish_solve(interactions, this->part_vectors, rhs_vecs, velocities, 0);
+    finish_solve(surface_interactions,
+                 this->surface_part_vectors,
+                 surface_rhs_vecs,
+                 surface_velocities,
+                 n_parts);
     IBAMR_TIMER_STOP(t_interpolate_velocity_solve);
+    const double wait_time = scheduler.get_mpi_wait_time() +
+                             get_total_scatter_wait_time() - start_scatter_wait;
+    if (this->performance_counters)
+      add_phase_counters(*this->performance_counters,
+                         "interpolate",
+                         start_time,
+                         wait_time,
+                         interaction_work,
+                         n_steps,
+                         n_parts);
+    if (tracer)
+      tracer->add_event("IFEDMethod",
+                        "interpolateVelocity",
+                        "compute",
+                        start_time,
+                        MPI_Wtime());
+    if (input_db->getBoolWithDefault("log_throughput", false))
+      log_throughput<spacedim>(input_db,
+                               "interpolateVelocity",
+                               start_time,
+                               wait_time,
+                               get_total_scatter_bytes() - start_scatter_bytes,
+                               interaction_work,
+                               ib_kernels,
+                               surface_ib_kernels,
+                               1);
     IBAMR_TIMER_STOP(t_interpolate_velocity);
   }
 
@@ -516,7 +2149,7 @@ namespace fdl
     int                               f_data_index,
     IBTK::RobinPhysBdryPatchStrategy *f_phys_bdry_op,
     const std::vector<tbox::Pointer<xfer::RefineSchedule<spacedim>>>
-      & /*f_prolongation_scheds*/,
+          &f_prolongation_scheds,
     double data_time)
   {
 #ifdef FDL_ENABLE_TIMER_BARRIERS
@@ -527,30 +2160,54 @@ namespace fdl
       IBAMR_TIMER_STOP(t_spread_force_start_barrier);
     }
 #endif
+    check_ghost_width(f_data_index, spreading_ghosts, "spreadForce");
     IBAMR_TIMER_START(t_spread_force);
-    const int level_number = this->patch_hierarchy->getFinestLevelNumber();
+    const double start_time          = MPI_Wtime();
+    const double start_scatter_wait  = get_total_scatter_wait_time();
+    const double start_scatter_bytes = get_total_scatter_bytes();
+    const std::vector<int> level_numbers =
+      this->get_interaction_level_numbers();
+    const int finest_ln = this->patch_hierarchy->getFinestLevelNumber();
 
     std::shared_ptr<IBTK::SAMRAIDataCache> data_cache =
       secondary_hierarchy.getSAMRAIDataCache();
     auto       hierarchy = secondary_hierarchy.getSecondaryHierarchy();
     const auto f_scratch_data_index =
       data_cache->getCachedPatchDataIndex(f_data_index);
-    fill_all(hierarchy, f_scratch_data_index, level_number, level_number, 0.0);
-
-    std::vector<MPI_Request> requests;
+    fill_all(
+      hierarchy, f_scratch_data_index, level_numbers.front(), finest_ln, 0.0);
+
+    // As in interpolateVelocity(), advance each transaction as soon as its
+    // own communication finishes. The position is not scattered again if it
+    // has not changed since the last interpolation or spreading operation.
+    TransactionScheduler scheduler;
+    const bool           reuse_overlap_position =
+      input_db->getBoolWithDefault("reuse_overlap_position", true);
+    // Inactive parts do not spread force
+    const std::vector<std::string> transaction_names = get_active_lane_names(
+      get_lane_names(this->parts.size(), this->surface_parts.size()),
+      this->active_parts);
+    if (this->tracer)
+      scheduler.set_tracer(*this->tracer, transaction_names);
     // native to overlap:
-    auto scatter_start = [&](const auto &collection,
-                             const auto &interactions,
-                             const auto &kernels,
-                             const auto &vectors,
-                             auto       &transactions)
+    auto scatter_start = [&](const auto       &collection,
+                             const auto       &interactions,
+                             const auto       &kernels,
+                             const auto       &vectors,
+                             const std::size_t offset)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
           const auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          transactions.emplace_back(
+          if (!this->part_is_active(offset + i))
+            continue;
+          if (reuse_overlap_position)
+            interactions[i]->set_position_state(
+              vectors.get_position_state(i, data_time));
+          scheduler.add_spread_transaction(
+            *interactions[i],
             interactions[i]->compute_spread_scatter_start(
               kernels[i],
               f_scratch_data_index,
@@ -559,132 +2216,255 @@ namespace fdl
               part.get_mapping(),
               part.get_dof_handler(),
               vectors.get_force(i, data_time)));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
         }
     };
-    auto scatter_finish = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        transactions[i] = interactions[i]->compute_spread_scatter_finish(
-          std::move(transactions[i]));
-    };
-    std::vector<std::unique_ptr<TransactionBase>> transactions,
-      surface_transactions;
     scatter_start(
-      this->parts, interactions, ib_kernels, this->part_vectors, transactions);
+      this->parts, interactions, ib_kernels, this->part_vectors, 0);
     scatter_start(this->surface_parts,
                   surface_interactions,
                   surface_ib_kernels,
                   this->surface_part_vectors,
-                  surface_transactions);
-    int ierr =
-      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-    requests.resize(0);
-    scatter_finish(interactions, transactions);
-    scatter_finish(surface_interactions, surface_transactions);
-
-    // Compute:
-    auto compute_transaction = [&](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
+                  this->parts.size());
+    scheduler.run();
+    // Every processor has every marker point force, so spreading them does
+    // not communicate
+    for (unsigned int i = 0; i < this->marker_points.size(); ++i)
+      {
+        AssertIndexRange(i, marker_point_forces.size());
+        marker_point_interactions[i].spread(
+          marker_point_ib_kernels[i],
+          f_scratch_data_index,
+          this->get_marker_point_position(i, data_time),
+          marker_point_forces[i]);
+      }
+    if (input_db->getBoolWithDefault("log_transaction_times", false))
+      log_transaction_times("spreadForce", scheduler, transaction_names);
+    if (workload_calibration)
+      {
+        workload_calibration->add_time(get_total_compute_time(scheduler));
+        workload_calibration->finish_step();
+      }
+
+    tbox::Pointer<hier::Variable<spacedim>> f_var;
+    auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+    var_db->mapIndexToVariable(f_data_index, f_var);
+    accumulate_spread_ghost_data(f_var,
+                                 f_scratch_data_index,
+                                 f_phys_bdry_op,
+                                 data_time);
+
+    // Sum values back into the primary hierarchy. If both hierarchies have
+    // the same patches on the same processors (e.g., if there is little
+    // structural work, so the secondary hierarchy's load balancing produces
+    // the primary hierarchy's partitioning) then we can add directly into
+    // the primary force without zeroing scratch data and communicating.
+    auto f_primary_data_ops =
+      extract_hierarchy_data_ops(f_var, this->patch_hierarchy);
+    const auto f_primary_scratch_data_index =
+      this->eulerian_data_cache->getCachedPatchDataIndex(f_data_index);
+    for (const int ln : level_numbers)
+      {
+        const tbox::Pointer<hier::PatchLevel<spacedim>> primary_level =
+          this->patch_hierarchy->getPatchLevel(ln);
+        const tbox::Pointer<hier::PatchLevel<spacedim>> secondary_level =
+          hierarchy->getPatchLevel(ln);
+        if (secondary_level_matches_primary[ln])
+          {
+            for (typename hier::PatchLevel<spacedim>::Iterator p(
+                   primary_level);
+                 p;
+                 p++)
+              add_patch_data(
+                primary_level->getPatch(p())->getPatchData(f_data_index),
+                secondary_level->getPatch(p())->getPatchData(
+                  f_scratch_data_index));
+          }
+        else
+          {
+            f_primary_data_ops->resetLevels(ln, ln);
+            // we have to zero the ghost cells here since the scratch to
+            // primary communication does not touch them (but does overwrite
+            // the interior), so they may have junk
+            fill_all(this->patch_hierarchy,
+                     std::vector<int>{f_primary_scratch_data_index},
+                     ln,
+                     ln,
+                     0.0,
+                     true);
+            secondary_hierarchy.transferSecondaryToPrimary(
+              ln,
+              f_primary_scratch_data_index,
+              f_scratch_data_index,
+              data_time);
+            f_primary_data_ops->add(f_data_index,
+                                    f_data_index,
+                                    f_primary_scratch_data_index);
+          }
+      }
+
+    // Forces spread onto coarser levels also need to be present on the finer
+    // levels covering them. Like IBAMR, prolong them one level at a time:
+    // f_prolongation_scheds[ln] overwrites level ln with values prolonged
+    // from level ln - 1, so save (and then add back) the finer level's own
+    // values.
+    for (int ln = level_numbers.front() + 1; ln <= finest_ln; ++ln)
+      if (ln < static_cast<int>(f_prolongation_scheds.size()) &&
+          f_prolongation_scheds[ln])
         {
-          transactions[i] = interactions[i]->compute_spread_intermediate(
-            std::move(transactions[i]));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
+          f_primary_data_ops->resetLevels(ln, ln);
+          // fill_all() allocates the scratch data if necessary
+          fill_all(this->patch_hierarchy,
+                   f_primary_scratch_data_index,
+                   ln,
+                   ln,
+                   0.0);
+          f_primary_data_ops->copyData(f_primary_scratch_data_index,
+                                       f_data_index);
+          f_prolongation_scheds[ln]->fillData(data_time);
+          f_primary_data_ops->add(f_data_index,
+                                  f_data_index,
+                                  f_primary_scratch_data_index);
         }
-    };
-    compute_transaction(interactions, transactions);
-    compute_transaction(surface_interactions, surface_transactions);
-    ierr = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-    requests.resize(0);
-
-    // Collect:
-    auto collect_transaction = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        interactions[i]->compute_spread_finish(std::move(transactions[i]));
-    };
-    collect_transaction(interactions, transactions);
-    collect_transaction(surface_interactions, surface_transactions);
+    const double wait_time = scheduler.get_mpi_wait_time() +
+                             get_total_scatter_wait_time() - start_scatter_wait;
+    if (this->performance_counters)
+      add_phase_counters(*this->performance_counters,
+                         "spread",
+                         start_time,
+                         wait_time,
+                         interaction_work,
+                         {},
+                         this->parts.size());
+    if (this->performance_counters &&
+        input_db->getDoubleWithDefault("spread_cutoff", 0.0) > 0.0)
+      {
+        SpreadCutoffStatistics statistics;
+        auto collect_statistics = [&](auto &elemental_interaction)
+        {
+          const SpreadCutoffStatistics &stats =
+            elemental_interaction.get_spread_cutoff_statistics();
+          statistics.n_points += stats.n_points;
+          statistics.n_skipped_points += stats.n_skipped_points;
+          statistics.total_magnitude += stats.total_magnitude;
+          statistics.skipped_magnitude += stats.skipped_magnitude;
+          elemental_interaction.clear_spread_cutoff_statistics();
+        };
+        for (auto &interaction : interactions)
+          if (auto *elemental =
+                dynamic_cast<ElementalInteraction<dim, spacedim> *>(
+                  interaction.get()))
+            collect_statistics(*elemental);
+        for (auto &interaction : surface_interactions)
+          if (auto *elemental =
+                dynamic_cast<ElementalInteraction<dim - 1, spacedim> *>(
+                  interaction.get()))
+            collect_statistics(*elemental);
+        this->performance_counters->add("spread_cutoff_points",
+                                        statistics.n_points);
+        this->performance_counters->add("spread_cutoff_skipped_points",
+                                        statistics.n_skipped_points);
+        this->performance_counters->add("spread_cutoff_total_force",
+                                        statistics.total_magnitude);
+        this->performance_counters->add("spread_cutoff_skipped_force",
+                                        statistics.skipped_magnitude);
+      }
+    if (this->tracer)
+      this->tracer->add_event(
+        "IFEDMethod", "spreadForce", "compute", start_time, MPI_Wtime());
+    // spreading reads and writes the Eulerian force
+    if (input_db->getBoolWithDefault("log_throughput", false))
+      log_throughput<spacedim>(input_db,
+                               "spreadForce",
+                               start_time,
+                               wait_time,
+                               get_total_scatter_bytes() - start_scatter_bytes,
+                               interaction_work,
+                               ib_kernels,
+                               surface_ib_kernels,
+                               2);
+    IBAMR_TIMER_STOP(t_spread_force);
+  }
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::accumulate_spread_ghost_data(
+    const tbox::Pointer<hier::Variable<spacedim>> &f_var,
+    const int                                      f_scratch_data_index,
+    IBTK::RobinPhysBdryPatchStrategy              *f_phys_bdry_op,
+    const double                                   data_time)
+  {
+    IBAMR_TIMER_START(t_spread_force_accumulate);
+    const double           start = MPI_Wtime();
+    const std::vector<int> level_numbers =
+      this->get_interaction_level_numbers();
+    auto hierarchy = secondary_hierarchy.getSecondaryHierarchy();
 
     // Deal with force values spread outside the physical domain. Since these
     // are spread into ghost regions that don't correspond to actual degrees
     // of freedom they are ignored by the accumulation step - we have to
-    // handle this before we do that.
+    // handle this before we do that. Only patches touching the physical
+    // boundary have such ghost regions.
     if (f_phys_bdry_op)
       {
         f_phys_bdry_op->setPatchDataIndex(f_scratch_data_index);
-        tbox::Pointer<hier::PatchLevel<spacedim>> level =
-          hierarchy->getPatchLevel(level_number);
-        for (typename hier::PatchLevel<spacedim>::Iterator p(level); p; p++)
+        for (const int ln : level_numbers)
           {
-            const tbox::Pointer<hier::Patch<spacedim>> patch =
-              level->getPatch(p());
-            tbox::Pointer<hier::PatchData<spacedim>> f_data =
-              patch->getPatchData(f_scratch_data_index);
-            f_phys_bdry_op->accumulateFromPhysicalBoundaryData(
-              *patch, data_time, f_data->getGhostCellWidth());
+            const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+              hierarchy->getPatchLevel(ln);
+            for (typename hier::PatchLevel<spacedim>::Iterator p(level);
+                 p;
+                 p++)
+              {
+                const tbox::Pointer<hier::Patch<spacedim>> patch =
+                  level->getPatch(p());
+                if (!patch->getPatchGeometry()->getTouchesRegularBoundary())
+                  continue;
+                tbox::Pointer<hier::PatchData<spacedim>> f_data =
+                  patch->getPatchData(f_scratch_data_index);
+                f_phys_bdry_op->accumulateFromPhysicalBoundaryData(
+                  *patch, data_time, f_data->getGhostCellWidth());
+              }
           }
       }
 
-    tbox::Pointer<hier::Variable<spacedim>> f_var;
-    auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
-    var_db->mapIndexToVariable(f_data_index, f_var);
-    // Accumulate forces spread into patch ghost regions.
-    {
-      if (!ghost_data_accumulator)
-        {
-          // If we have multiple IBMethod objects we may end up with a wider
-          // ghost region than the one required by this class. Hence, set the
-          // ghost width by just picking whatever the data actually has at the
-          // moment.
-          const tbox::Pointer<hier::PatchLevel<spacedim>> level =
-            hierarchy->getPatchLevel(level_number);
-          const hier::IntVector<spacedim> gcw =
-            level->getPatchDescriptor()
-              ->getPatchDataFactory(f_scratch_data_index)
-              ->getGhostCellWidth();
-
-          ghost_data_accumulator.reset(new IBTK::SAMRAIGhostDataAccumulator(
-            hierarchy, f_var, gcw, level_number, level_number));
-        }
-      ghost_data_accumulator->accumulateGhostData(f_scratch_data_index);
-    }
+    // Accumulate forces spread into patch ghost regions. If we have multiple
+    // IBMethod objects we may end up with a wider ghost region than the one
+    // required by this class. Only the part of it into which our kernels
+    // actually spread (which, as checked above, the data has) needs to be
+    // accumulated.
+    if (input_db->getBoolWithDefault("sparse_ghost_accumulation", false))
+      accumulate_nonzero_ghost_data(hierarchy,
+                                    f_scratch_data_index,
+                                    spreading_ghosts,
+                                    level_numbers.front(),
+                                    level_numbers.back(),
+                                    IBTK::IBTK_MPI::getCommunicator());
+    else
+      {
+        if (!ghost_data_accumulator)
+          ghost_data_accumulator.reset(
+            new IBTK::SAMRAIGhostDataAccumulator(hierarchy,
+                                                 f_var,
+                                                 spreading_ghosts,
+                                                 level_numbers.front(),
+                                                 level_numbers.back()));
+        ghost_data_accumulator->accumulateGhostData(f_scratch_data_index);
+      }
+    if (this->tracer)
+      this->tracer->add_event(
+        "IFEDMethod", "accumulate ghost data", "mpi", start, MPI_Wtime());
+    IBAMR_TIMER_STOP(t_spread_force_accumulate);
+  }
 
-    // Sum values back into the primary hierarchy.
-    {
-      auto f_primary_data_ops =
-        extract_hierarchy_data_ops(f_var, this->patch_hierarchy);
-      f_primary_data_ops->resetLevels(level_number, level_number);
-      const auto f_primary_scratch_data_index =
-        this->eulerian_data_cache->getCachedPatchDataIndex(f_data_index);
-      // we have to zero everything here since the scratch to primary
-      // communication does not touch ghost cells, which may have junk
-      fill_all(this->patch_hierarchy,
-               f_primary_scratch_data_index,
-               level_number,
-               level_number,
-               0.0);
-      secondary_hierarchy.transferSecondaryToPrimary(
-        level_number,
-        f_primary_scratch_data_index,
-        f_scratch_data_index,
-        data_time);
-      f_primary_data_ops->add(f_data_index,
-                              f_data_index,
-                              f_primary_scratch_data_index);
-    }
-    IBAMR_TIMER_STOP(t_spread_force);
+  template <int dim, int spacedim>
+  double
+  IFEDMethod<dim, spacedim>::getMaxPointDisplacement() const
+  {
+    const double max_displacement =
+      IFEDMethodBase<dim, spacedim>::getMaxPointDisplacement();
+    if (use_displacement_regrid_policy)
+      return regrid_policy.get_budget_fraction(max_displacement);
+    return max_displacement;
   }
 
   //
@@ -704,19 +2484,45 @@ namespace fdl
     }
 #endif
     IBAMR_TIMER_START(t_compute_lagrangian_force);
-
-    unsigned int channel = 0;
-    auto         do_load =
-      [&](auto &collection, auto &vectors, auto &forces, auto &right_hand_sides)
+    const double start_time    = MPI_Wtime();
+    double       compress_time = 0.0;
+
+    const bool use_matrix_free_stresses =
+      input_db->getBoolWithDefault("use_matrix_free_stresses", false);
+    const int n_force_threads =
+      input_db->getIntegerWithDefault("n_force_threads", 1);
+    AssertThrow(n_force_threads > 0,
+                ExcMessage("n_force_threads must be positive."));
+    // Subcycling requires the positions at the start and end of the time
+    // step, which are available when computing the midpoint force.
+    const bool can_subcycle    = data_time == this->half_time;
+    auto       get_n_subcycles = [&](const std::size_t part_n)
+    { return can_subcycle ? this->n_force_subcycles[part_n] : 1; };
+
+    // Overlap communication with assembly: the ghost updates of every
+    // part's position start before any part is assembled and each part's
+    // load vector starts compressing as soon as it is assembled. The
+    // matrix-free stresses also overlap the compression with assembly (see
+    // compute_volumetric_pk1_load_vector()), in which case the load vector is
+    // already compressed. Each part i uses channel offset + i.
+    const std::size_t n_parts  = this->parts.size();
+    const std::size_t n_solves = n_parts + this->surface_parts.size();
+    std::vector<bool> rhs_is_compressed(n_solves, false);
+
+    auto do_load = [&](auto             &collection,
+                       auto             &vectors,
+                       auto             &forces,
+                       auto             &right_hand_sides,
+                       const std::size_t offset)
     {
       // Unlike velocity interpolation and force spreading we actually need
       // the ghost values in the native partitioning, so make sure they are
       // available
       IBAMR_TIMER_START(t_compute_lagrangian_force_position_ghost_update);
       for (unsigned int i = 0; i < collection.size(); ++i)
-        vectors.get_position(i, data_time).update_ghost_values_start(channel++);
-      for (unsigned int i = 0; i < collection.size(); ++i)
-        vectors.get_position(i, data_time).update_ghost_values_finish();
+        if (this->part_is_active(offset + i))
+          vectors.get_position(i, data_time)
+            .update_ghost_values_start(offset + i);
       IBAMR_TIMER_STOP(t_compute_lagrangian_force_position_ghost_update);
 
       for (unsigned int i = 0; i < collection.size(); ++i)
@@ -724,31 +2530,111 @@ namespace fdl
           const auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          forces.emplace_back(part.get_partitioner());
-          right_hand_sides.emplace_back(part.get_partitioner());
+          forces.emplace_back(vectors.get_temporary_vector(i));
+          forces[i] = 0.0;
+          right_hand_sides.emplace_back(vectors.get_temporary_vector(i));
+          right_hand_sides[i] = 0.0;
+          // Inactive parts have no force, so their load vector is zero
+          if (!this->part_is_active(offset + i))
+            {
+              rhs_is_compressed[offset + i] = true;
+              continue;
+            }
+          IBAMR_TIMER_START(t_compute_lagrangian_force_position_ghost_update);
+          vectors.get_position(i, data_time).update_ghost_values_finish();
+          IBAMR_TIMER_STOP(t_compute_lagrangian_force_position_ghost_update);
 
-          const auto &position = vectors.get_position(i, data_time);
           // The velocity isn't available at data_time so use current_time -
           // IBFEMethod does this too. This is always equal to the part's
           // current velocity and, by convention, has up-to-date ghost values.
-          const auto &velocity = part.get_velocity();
-          IBAMR_TIMER_START(t_compute_lagrangian_force_setup_force_and_strain);
-          for (auto &force : part.get_force_contributions())
-            force->setup_force(data_time, position, velocity);
-          for (auto &active_strain : part.get_active_strains())
-            active_strain->setup_strain(data_time);
-          IBAMR_TIMER_STOP(t_compute_lagrangian_force_setup_force_and_strain);
-
-          IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
-          compute_load_vector(part.get_dof_handler(),
-                              part.get_mapping(),
-                              part.get_force_contributions(),
-                              part.get_active_strains(),
-                              data_time,
-                              position,
-                              velocity,
-                              right_hand_sides[i]);
-          IBAMR_TIMER_STOP(t_compute_lagrangian_force_pk1);
+          const auto &velocity    = part.get_velocity();
+          const int   n_subcycles = get_n_subcycles(offset + i);
+          if (n_subcycles == 1)
+            {
+              const auto &position = vectors.get_position(i, data_time);
+              IBAMR_TIMER_START(
+                t_compute_lagrangian_force_setup_force_and_strain);
+              for (auto &force : part.get_force_contributions())
+                force->setup_force(data_time, position, velocity);
+              for (auto &active_strain : part.get_active_strains())
+                active_strain->setup_strain(data_time);
+              IBAMR_TIMER_STOP(
+                t_compute_lagrangian_force_setup_force_and_strain);
+
+              IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
+              rhs_is_compressed[offset + i] =
+                compute_part_load_vector(part,
+                                         use_matrix_free_stresses,
+                                         n_force_threads,
+                                         data_time,
+                                         position,
+                                         velocity,
+                                         right_hand_sides[i]);
+              IBAMR_TIMER_STOP(t_compute_lagrangian_force_pk1);
+            }
+          else
+            {
+              // Sum the load vectors at the midpoints of n_subcycles
+              // substeps, at which the position is interpolated linearly.
+              // The sum is averaged after compression so that the ghost
+              // contributions are averaged too.
+              const auto &current_position =
+                vectors.get_position(i, this->current_time);
+              const auto &new_position =
+                vectors.get_position(i, this->new_time);
+              auto substep_position = vectors.get_temporary_vector(i);
+              for (int k = 0; k < n_subcycles; ++k)
+                {
+                  const double s            = (k + 0.5) / n_subcycles;
+                  const double substep_time = this->current_time +
+                                              s * (this->new_time -
+                                                   this->current_time);
+                  substep_position.equ(1.0 - s, current_position);
+                  substep_position.add(s, new_position);
+                  substep_position.update_ghost_values();
+
+                  IBAMR_TIMER_START(
+                    t_compute_lagrangian_force_setup_force_and_strain);
+                  for (auto &force : part.get_force_contributions())
+                    force->setup_force(substep_time,
+                                       substep_position,
+                                       velocity);
+                  for (auto &active_strain : part.get_active_strains())
+                    active_strain->setup_strain(substep_time);
+                  IBAMR_TIMER_STOP(
+                    t_compute_lagrangian_force_setup_force_and_strain);
+
+                  IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
+                  rhs_is_compressed[offset + i] =
+                    compute_part_load_vector(part,
+                                             use_matrix_free_stresses,
+                                             n_force_threads,
+                                             substep_time,
+                                             substep_position,
+                                             velocity,
+                                             right_hand_sides[i]);
+                  IBAMR_TIMER_STOP(t_compute_lagrangian_force_pk1);
+
+                  // The last substep is finished along with the other parts
+                  // below
+                  if (k + 1 < n_subcycles)
+                    {
+                      for (auto &force : part.get_force_contributions())
+                        force->finish_force(substep_time);
+                      for (auto &active_strain : part.get_active_strains())
+                        active_strain->finish_strain(substep_time);
+                    }
+                }
+              vectors.recycle_vector(i, std::move(substep_position));
+            }
+
+          if (!rhs_is_compressed[offset + i])
+            {
+              IBAMR_TIMER_START(t_compute_lagrangian_force_compress_vector);
+              right_hand_sides[i].compress_start(offset + i,
+                                                 VectorOperation::add);
+              IBAMR_TIMER_STOP(t_compute_lagrangian_force_compress_vector);
+            }
         }
     };
     std::deque<LinearAlgebra::distributed::Vector<double>> part_forces,
@@ -756,65 +2642,174 @@ namespace fdl
     do_load(this->parts,
             this->part_vectors,
             part_forces,
-            part_right_hand_sides);
+            part_right_hand_sides,
+            0);
     do_load(this->surface_parts,
             this->surface_part_vectors,
             surface_part_forces,
-            surface_part_right_hand_sides);
-
-    IBAMR_TIMER_START(t_compute_lagrangian_force_compress_vector);
-    // Allow compression to overlap:
-    auto do_compress = [](auto &vectors)
+            surface_part_right_hand_sides,
+            n_parts);
+
+    // Allow compression to overlap with the solves: solve each part as soon
+    // as its right-hand side is ready.
+    for (auto *guesses : {&force_guesses, &surface_force_guesses})
+      for (auto &guess : *guesses)
+        guess.set_time(data_time);
+    const MassSolverSettings settings = get_mass_solver_settings(input_db);
+    const bool               use_threads =
+      input_db->getBoolWithDefault("threaded_mass_solves", false);
+    const bool batch_solves =
+      !settings.lumped &&
+      input_db->getBoolWithDefault("batched_mass_solves", false);
+
+    std::vector<unsigned int> n_steps(n_solves);
+    MassSolves                solves(n_solves, use_threads);
+    const std::vector<std::string> lane_names =
+      get_lane_names(n_parts, this->surface_parts.size());
+    Tracer *const tracer = this->tracer.get();
+
+    auto do_solve = [&](const auto       &collection,
+                        const auto       &interactions,
+                        auto             &force_guesses,
+                        auto             &forces,
+                        auto             &right_hand_sides,
+                        const std::size_t offset)
     {
-      for (unsigned int i = 0; i < vectors.size(); ++i)
-        vectors[i].compress_start(i, VectorOperation::add);
-      for (unsigned int i = 0; i < vectors.size(); ++i)
-        vectors[i].compress_finish(VectorOperation::add);
+      std::vector<unsigned int> batched_indices;
+      for (unsigned int i = 0; i < collection.size(); ++i)
+        {
+          if (!this->part_is_active(offset + i))
+            {
+              solves.add(offset + i, []() {});
+              continue;
+            }
+          IBAMR_TIMER_START(t_compute_lagrangian_force_compress_vector);
+          const double compress_start = MPI_Wtime();
+          if (!rhs_is_compressed[offset + i])
+            right_hand_sides[i].compress_finish(VectorOperation::add);
+          const int n_subcycles = get_n_subcycles(offset + i);
+          if (n_subcycles > 1)
+            right_hand_sides[i] *= 1.0 / n_subcycles;
+          const double compress_end = MPI_Wtime();
+          compress_time += compress_end - compress_start;
+          if (tracer)
+            tracer->add_event(lane_names[offset + i],
+                              "compress finish",
+                              "mpi",
+                              compress_start,
+                              compress_end);
+          IBAMR_TIMER_STOP(t_compute_lagrangian_force_compress_vector);
+
+          if (interactions[i]->projection_is_interpolation())
+            solves.add(offset + i, []() {});
+          else if (interactions[i]->spreads_weak_force())
+            {
+              // Spreading the weak force only requires the lumped mass
+              // matrix, which is cheap enough to apply here
+              MassSolverSettings lumped_settings = settings;
+              lumped_settings.lumped             = true;
+              solve_mass_system(collection[i],
+                                lumped_settings,
+                                force_guesses[i],
+                                forces[i],
+                                right_hand_sides[i]);
+              solves.add(offset + i, []() {});
+            }
+          else if (batch_solves)
+            {
+              // Solved below, once every right-hand side is ready
+              batched_indices.push_back(i);
+              solves.add(offset + i, []() {});
+            }
+          else
+            {
+              IBAMR_TIMER_START(t_compute_lagrangian_force_solve);
+              solves.add(offset + i,
+                         [&part     = collection[i],
+                          &guess    = force_guesses[i],
+                          &solution = forces[i],
+                          &rhs      = right_hand_sides[i],
+                          &n_step   = n_steps[offset + i],
+                          &lane     = lane_names[offset + i],
+                          tracer,
+                          settings]()
+                         {
+                           const double start = MPI_Wtime();
+                           n_step = solve_mass_system(
+                             part, settings, guess, solution, rhs);
+                           if (tracer)
+                             tracer->add_event(
+                               lane, "CG solve", "compute", start, MPI_Wtime());
+                         });
+              IBAMR_TIMER_STOP(t_compute_lagrangian_force_solve);
+            }
+        }
+
+      IBAMR_TIMER_START(t_compute_lagrangian_force_solve);
+      const unsigned int n_step = solve_mass_systems(collection,
+                                                     batched_indices,
+                                                     settings,
+                                                     force_guesses,
+                                                     forces,
+                                                     right_hand_sides,
+                                                     tracer);
+      for (const unsigned int i : batched_indices)
+        n_steps[offset + i] = n_step;
+      IBAMR_TIMER_STOP(t_compute_lagrangian_force_solve);
     };
-    do_compress(part_right_hand_sides);
-    do_compress(surface_part_right_hand_sides);
-    IBAMR_TIMER_STOP(t_compute_lagrangian_force_compress_vector);
-
-    // And do the actual solve:
-    auto do_solve = [&](const auto &collection,
-                        const auto &interactions,
-                        auto       &force_guesses,
-                        auto       &vectors,
-                        auto       &forces,
-                        auto       &right_hand_sides)
+    do_solve(this->parts,
+             interactions,
+             force_guesses,
+             part_forces,
+             part_right_hand_sides,
+             0);
+    do_solve(this->surface_parts,
+             surface_interactions,
+             surface_force_guesses,
+             surface_part_forces,
+             surface_part_right_hand_sides,
+             n_parts);
+    IBAMR_TIMER_START(t_compute_lagrangian_force_solve);
+    solves.wait();
+    IBAMR_TIMER_STOP(t_compute_lagrangian_force_solve);
+
+    auto finish_solve = [&](const auto       &collection,
+                            const auto       &interactions,
+                            auto             &vectors,
+                            auto             &forces,
+                            auto             &right_hand_sides,
+                            const std::size_t offset)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
           const auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
+          // Inactive parts did not set up their forces, so there is nothing
+          // to finish
+          if (!this->part_is_active(offset + i))
+            {
+              vectors.set_force(i, data_time, std::move(forces[i]));
+              vectors.recycle_vector(i, std::move(right_hand_sides[i]));
+              continue;
+            }
           if (interactions[i]->projection_is_interpolation())
             {
               vectors.set_force(i, data_time, std::move(right_hand_sides[i]));
+              vectors.recycle_vector(i, std::move(forces[i]));
             }
           else
             {
-              IBAMR_TIMER_START(t_compute_lagrangian_force_solve);
-              SolverControl control(
-                input_db->getIntegerWithDefault("solver_iterations", 100),
-                input_db->getDoubleWithDefault("solver_relative_tolerance",
-                                               1e-6) *
-                  right_hand_sides[i].l2_norm());
-              SolverCG<LinearAlgebra::distributed::Vector<double>> cg(control);
-              force_guesses[i].guess(forces[i], right_hand_sides[i]);
-              cg.solve(part.get_mass_operator(),
-                       forces[i],
-                       right_hand_sides[i],
-                       part.get_mass_preconditioner());
-              force_guesses[i].submit(forces[i], right_hand_sides[i]);
-              if (input_db->getBoolWithDefault("log_solver_iterations", false))
+              vectors.recycle_vector(i, std::move(right_hand_sides[i]));
+              if (!settings.lumped &&
+                  !interactions[i]->spreads_weak_force() &&
+                  input_db->getBoolWithDefault("log_solver_iterations", false))
                 {
                   tbox::plog << "IFEDMethod::computeLagrangianForce(): "
                              << "SolverCG<> converged in "
-                             << control.last_step() << " steps." << std::endl;
+                             << n_steps[offset + i] << " steps." << std::endl;
                 }
               vectors.set_force(i, data_time, std::move(forces[i]));
-              IBAMR_TIMER_STOP(t_compute_lagrangian_force_solve);
             }
           for (auto &force : part.get_force_contributions())
             force->finish_force(data_time);
@@ -822,18 +2817,38 @@ namespace fdl
             active_strain->finish_strain(data_time);
         }
     };
-    do_solve(this->parts,
-             interactions,
-             force_guesses,
-             this->part_vectors,
-             part_forces,
-             part_right_hand_sides);
-    do_solve(this->surface_parts,
-             surface_interactions,
-             surface_force_guesses,
-             this->surface_part_vectors,
-             surface_part_forces,
-             surface_part_right_hand_sides);
+    finish_solve(this->parts,
+                 interactions,
+                 this->part_vectors,
+                 part_forces,
+                 part_right_hand_sides,
+                 0);
+    finish_solve(this->surface_parts,
+                 surface_interactions,
+                 this->surface_part_vectors,
+                 surface_part_forces,
+                 surface_part_right_hand_sides,
+                 n_parts);
+    // The forces of marker points are nodal values, so there is nothing to
+    // solve
+    marker_point_forces.resize(this->marker_points.size());
+    for (unsigned int i = 0; i < this->marker_points.size(); ++i)
+      this->marker_points[i].compute_force(
+        this->get_marker_point_position(i, data_time), marker_point_forces[i]);
+    if (this->performance_counters)
+      add_phase_counters(*this->performance_counters,
+                         "force",
+                         start_time,
+                         compress_time,
+                         {},
+                         n_steps,
+                         n_parts);
+    if (tracer)
+      tracer->add_event("IFEDMethod",
+                        "computeLagrangianForce",
+                        "compute",
+                        start_time,
+                        MPI_Wtime());
     IBAMR_TIMER_STOP(t_compute_lagrangian_force);
   }
 
@@ -841,11 +2856,117 @@ namespace fdl
   // Data redistribution
   //
 
+  template <int dim, int spacedim>
+  const typename IFEDMethod<dim, spacedim>::RestrictedVelocityFill &
+  IFEDMethod<dim, spacedim>::get_restricted_velocity_fill(
+    const int level_number,
+    const int u_data_index)
+  {
+    for (const RestrictedVelocityFill &fill : restricted_velocity_fills)
+      if (fill.level_number == level_number && fill.data_index == u_data_index)
+        return fill;
+
+    RestrictedVelocityFill fill;
+    fill.level_number = level_number;
+    fill.data_index   = u_data_index;
+
+    // Every processor knows every box, so every processor computes the same
+    // patch numbers without communicating
+    const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+      secondary_hierarchy.getSecondaryHierarchy()->getPatchLevel(level_number);
+    const hier::BoxArray<spacedim> &boxes = level->getBoxes();
+    const int                       n_ghost_cells = int(std::ceil(
+      input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0)));
+    std::vector<BoundingBox<spacedim>> patch_bboxes;
+    for (int patch_n = 0; patch_n < boxes.getNumberOfBoxes(); ++patch_n)
+      {
+        hier::Box<spacedim> box = boxes[patch_n];
+        box.grow(hier::IntVector<spacedim>(n_ghost_cells));
+        patch_bboxes.push_back(box_to_bbox(box, level));
+      }
+    const auto rtree = pack_rtree_of_indices(patch_bboxes);
+
+    namespace bgi = boost::geometry::index;
+    std::vector<bool> selected_patches(patch_bboxes.size(), false);
+    const auto        select_patch = [&](const std::size_t patch_n)
+    {
+      AssertIndexRange(patch_n, selected_patches.size());
+      selected_patches[patch_n] = true;
+    };
+    const auto select_patches =
+      [&](const ArrayView<const BoundingBox<spacedim, float>> &cell_bboxes)
+    {
+      for (const auto &cell_bbox : cell_bboxes)
+        {
+          // the boxes are stored in single precision, so convert first
+          BoundingBox<spacedim> query_bbox;
+          query_bbox.get_boundary_points() = cell_bbox.get_boundary_points();
+          rtree.query(bgi::intersects(query_bbox),
+                      boost::make_function_output_iterator(select_patch));
+        }
+    };
+    for (unsigned int i = 0; i < this->parts.size(); ++i)
+      if (this->get_interaction_level_number(i) == level_number)
+        select_patches(this->get_global_active_cell_bboxes(i));
+    for (unsigned int i = 0; i < this->surface_parts.size(); ++i)
+      if (this->get_interaction_level_number(this->parts.size() + i) ==
+          level_number)
+        select_patches(this->get_surface_global_active_cell_bboxes(i));
+    if (level_number == this->patch_hierarchy->getFinestLevelNumber())
+      for (unsigned int i = 0; i < this->marker_points.size(); ++i)
+        for (const auto &point_bbox : this->get_marker_point_bboxes(i))
+          rtree.query(bgi::intersects(point_bbox),
+                      boost::make_function_output_iterator(select_patch));
+    for (unsigned int patch_n = 0; patch_n < selected_patches.size();
+         ++patch_n)
+      if (selected_patches[patch_n])
+        fill.patch_numbers.push_back(patch_n);
+
+    fill.level = make_patch_level_subset(level, fill.patch_numbers);
+    if (fill.patch_numbers.size() > 0)
+      {
+        // Like IBAMR's velocity ghost fill schedules, fill ghost regions
+        // from coarser levels with conservative linear refinement
+        auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+        tbox::Pointer<hier::Variable<spacedim>> u_var;
+        var_db->mapIndexToVariable(u_data_index, u_var);
+        xfer::RefineAlgorithm<spacedim> algorithm;
+        algorithm.registerRefine(
+          u_data_index,
+          u_data_index,
+          u_data_index,
+          this->patch_hierarchy->getGridGeometry()->lookupRefineOperator(
+            u_var, "CONSERVATIVE_LINEAR_REFINE"));
+        fill.schedule = algorithm.createSchedule(
+          fill.level,
+          this->patch_hierarchy->getPatchLevel(level_number),
+          level_number - 1,
+          this->patch_hierarchy,
+          this->d_ib_solver->getVelocityPhysBdryOp());
+      }
+
+    if (input_db->getBoolWithDefault("enable_logging", true) &&
+        IBTK::IBTK_MPI::getRank() == 0)
+      tbox::plog << "IFEDMethod::interpolateVelocity(): filling the velocity "
+                 << "on " << fill.patch_numbers.size() << " of "
+                 << boxes.getNumberOfBoxes() << " patches on level "
+                 << level_number << std::endl;
+    restricted_velocity_fills.push_back(std::move(fill));
+    return restricted_velocity_fills.back();
+  }
+
   template <int dim, int spacedim>
   void
   IFEDMethod<dim, spacedim>::reinit_interactions()
   {
-    auto do_reinit = [&](const auto &collection, auto &interactions)
+    // The patches of the secondary hierarchy (or the parts) may have changed
+    restricted_velocity_fills.clear();
+    auto do_reinit = [&](const auto                     &collection,
+                         auto                           &interactions,
+                         const std::vector<std::string> &kernels,
+                         const auto                     &get_bboxes,
+                         const auto                     &get_edge_lengths,
+                         const unsigned int              offset)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
@@ -855,62 +2976,209 @@ namespace fdl
           const auto &tria = dynamic_cast<
             const parallel::shared::Triangulation<structdim, spacedim> &>(
             part.get_triangulation());
-          const auto &dof_handler = part.get_dof_handler();
-          MappingFEField<structdim,
-                         spacedim,
-                         LinearAlgebra::distributed::Vector<double>>
-            mapping(dof_handler, part.get_position());
+          // These are shared with applyGradientDetector() - i.e., if we are
+          // regridding then they have already been computed.
           IBAMR_TIMER_START(t_reinit_interactions_bboxes);
-          const auto local_bboxes =
-            compute_cell_bboxes<structdim, spacedim, float>(dof_handler,
-                                                            mapping);
-          const auto global_bboxes =
-            collect_all_active_cell_bboxes(tria, local_bboxes);
+          const auto &global_bboxes = get_bboxes(i);
           IBAMR_TIMER_STOP(t_reinit_interactions_bboxes);
 
           IBAMR_TIMER_START(t_reinit_interactions_edges);
-          const auto local_edge_lengths = compute_longest_edge_lengths(
-            tria, mapping, QGauss<1>(dof_handler.get_fe().tensor_degree()));
-          const auto global_edge_lengths =
-            collect_longest_edge_lengths(tria, local_edge_lengths);
+          const auto &global_edge_lengths = get_edge_lengths(i);
           IBAMR_TIMER_STOP(t_reinit_interactions_edges);
 
           IBAMR_TIMER_START(t_reinit_interactions_objects);
-          // We already check that this has a valid value earlier on
-          const std::string interaction =
-            input_db->getStringWithDefault("interaction", "ELEMENTAL");
-          const int ln = this->patch_hierarchy->getFinestLevelNumber();
+          // Each part may use a different interaction type
+          auto *const nodal_interaction =
+            dynamic_cast<NodalInteraction<structdim, spacedim> *>(
+              interactions[i].get());
+          const int ln = this->get_interaction_level_number(offset + i);
 
           tbox::Pointer<tbox::Database> interaction_db =
             new tbox::InputDatabase("interaction");
-          // default database values are OK
-
-          if (interaction == "ELEMENTAL")
-            interactions[i]->reinit(interaction_db,
-                                    tria,
-                                    global_bboxes,
-                                    global_edge_lengths,
-                                    secondary_hierarchy.getSecondaryHierarchy(),
-                                    std::make_pair(ln, ln));
+          // default database values are OK, except for the ones we forward
+          interaction_db->putBool(
+            "use_interaction_plan",
+            input_db->getBoolWithDefault("use_interaction_plan", true));
+          interaction_db->putDouble(
+            "interaction_plan_tolerance",
+            input_db->getDoubleWithDefault("interaction_plan_tolerance", 0.0));
+          interaction_db->putDouble(
+            "interaction_plan_compression",
+            input_db->getDoubleWithDefault("interaction_plan_compression",
+                                           0.0));
+          interaction_db->putInteger(
+            "n_cached_interaction_plans",
+            input_db->getIntegerWithDefault("n_cached_interaction_plans", 1));
+          interaction_db->putBool(
+            "store_plan_weights",
+            input_db->getBoolWithDefault("store_plan_weights", false));
+          interaction_db->putBool(
+            "spread_weak_force",
+            input_db->getBoolWithDefault("spread_weak_force", false));
+          interaction_db->putDouble(
+            "quadrature_hysteresis",
+            input_db->getDoubleWithDefault("quadrature_hysteresis", 0.0));
+          const bool anisotropic_quadrature =
+            input_db->getBoolWithDefault("anisotropic_quadrature", false);
+          interaction_db->putBool("anisotropic_quadrature",
+                                  anisotropic_quadrature);
+          interaction_db->putInteger(
+            "n_spread_threads",
+            input_db->getIntegerWithDefault("n_spread_threads", 1));
+          interaction_db->putBool(
+            "sort_patch_cells",
+            input_db->getBoolWithDefault("sort_patch_cells", false));
+          interaction_db->putBool(
+            "sort_spread_points",
+            input_db->getBoolWithDefault("sort_spread_points", false));
+          interaction_db->putDouble(
+            "spread_cutoff",
+            input_db->getDoubleWithDefault("spread_cutoff", 0.0));
+          interaction_db->putInteger(
+            "n_interpolation_threads",
+            input_db->getIntegerWithDefault("n_interpolation_threads", 1));
+          interaction_db->putString(
+            "scatter_backend",
+            input_db->getStringWithDefault("scatter_backend",
+                                           "POINT_TO_POINT"));
+          interaction_db->putBool(
+            "single_precision_overlap",
+            input_db->getBoolWithDefault("single_precision_overlap", false));
+          interaction_db->putDouble(
+            "ghost_cell_fraction",
+            input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0));
+          interaction_db->putBool(
+            "distributed_bbox_exchange",
+            input_db->getBoolWithDefault("distributed_bbox_exchange", false));
+          interaction_db->putBool(
+            "pack_nodes", input_db->getBoolWithDefault("pack_nodes", false));
+          interaction_db->putString(
+            "interaction_cells",
+            input_db->getStringWithDefault("interaction_cells", "ALL"));
+          if (input_db->keyExists("interaction_material_ids"))
+            interaction_db->putIntegerArray(
+              "interaction_material_ids",
+              input_db->getIntegerArray("interaction_material_ids"));
+          AssertIndexRange(i, kernels.size());
+          if (workload_calibration &&
+              workload_calibration->has_coefficients())
+            {
+              interaction_db->putDouble(
+                "workload_point_weight",
+                workload_calibration->get_point_weight());
+              interaction_db->putDouble(
+                "workload_cell_weight",
+                workload_calibration->get_cell_weight());
+            }
           else
             {
-              dynamic_cast<NodalInteraction<structdim, spacedim> &>(
-                *interactions[i])
-                .reinit(interaction_db,
-                        tria,
-                        global_bboxes,
-                        secondary_hierarchy.getSecondaryHierarchy(),
-                        std::make_pair(ln, ln),
-                        part.get_dof_handler(),
-                        part.get_position());
+              interaction_db->putDouble(
+                "workload_point_weight",
+                get_workload_point_weight<spacedim>(input_db, kernels[i]));
+              interaction_db->putDouble(
+                "workload_cell_weight",
+                input_db->getDoubleWithDefault("workload_cell_weight", 0.0));
+            }
+
+          if (!nodal_interaction)
+            {
+              if (anisotropic_quadrature)
+                {
+                  // Like the edge lengths, measure the cells in the current
+                  // configuration
+                  IBAMR_TIMER_START(t_reinit_interactions_edges);
+                  MappingFEField<structdim,
+                                 spacedim,
+                                 LinearAlgebra::distributed::Vector<double>>
+                    mapping(part.get_dof_handler(), part.get_position());
+                  const auto local_lengths =
+                    compute_reference_direction_lengths(tria,
+                                                        mapping,
+                                                        QGauss<structdim>(2));
+                  std::array<std::vector<float>, structdim> lengths;
+                  for (unsigned int d = 0; d < structdim; ++d)
+                    lengths[d] =
+                      collect_longest_edge_lengths(tria, local_lengths[d]);
+                  IBAMR_TIMER_STOP(t_reinit_interactions_edges);
+                  dynamic_cast<ElementalInteraction<structdim, spacedim> &>(
+                    *interactions[i])
+                    .set_reference_direction_lengths(std::move(lengths));
+                }
+              interactions[i]->reinit(
+                interaction_db,
+                tria,
+                global_bboxes,
+                global_edge_lengths,
+                secondary_hierarchy.getSecondaryHierarchy(),
+                std::make_pair(ln, ln));
             }
+          else
+            nodal_interaction->reinit(
+              interaction_db,
+              tria,
+              global_bboxes,
+              secondary_hierarchy.getSecondaryHierarchy(),
+              std::make_pair(ln, ln),
+              part.get_dof_handler(),
+              part.get_position());
           // TODO - we should probably add a reinit() function that sets up the
           // DoFHandler we always need
           interactions[i]->add_dof_handler(part.get_dof_handler());
         }
     };
-    do_reinit(this->parts, interactions);
-    do_reinit(this->surface_parts, surface_interactions);
+    do_reinit(
+      this->parts,
+      interactions,
+      ib_kernels,
+      [&](const unsigned int i) {
+        return this->get_global_active_cell_bboxes(i);
+      },
+      [&](const unsigned int i) {
+        return this->get_global_longest_edge_lengths(i);
+      },
+      0);
+    do_reinit(
+      this->surface_parts,
+      surface_interactions,
+      surface_ib_kernels,
+      [&](const unsigned int i) {
+        return this->get_surface_global_active_cell_bboxes(i);
+      },
+      [&](const unsigned int i) {
+        return this->get_surface_global_longest_edge_lengths(i);
+      },
+      this->parts.size());
+    for (unsigned int i = 0; i < this->marker_points.size(); ++i)
+      marker_point_interactions[i].reinit(
+        input_db,
+        IBTK::IBTK_MPI::getCommunicator(),
+        secondary_hierarchy.getSecondaryHierarchy(),
+        this->patch_hierarchy->getFinestLevelNumber(),
+        this->marker_points[i].get_position());
+
+    interaction_work.clear();
+    if (workload_calibration || this->performance_counters ||
+        input_db->getBoolWithDefault("log_throughput", false))
+      {
+        auto add_work = [&](auto &interactions)
+        {
+          for (auto &interaction : interactions)
+            interaction_work.push_back(
+              interaction->count_local_interaction_work());
+        };
+        add_work(interactions);
+        add_work(surface_interactions);
+      }
+    if (workload_calibration)
+      {
+        std::pair<double, double> work(0.0, 0.0);
+        for (const auto &part_work : interaction_work)
+          {
+            work.first += part_work.first;
+            work.second += part_work.second;
+          }
+        workload_calibration->start_window(work.first, work.second);
+      }
     IBAMR_TIMER_STOP(t_reinit_interactions_objects);
   }
 
@@ -929,6 +3197,40 @@ namespace fdl
     // naught to do
     if (this->patch_hierarchy)
       {
+        // Save this for logging since the regrid positions are reset in
+        // endDataRedistribution()
+        regrid_displacement =
+          IFEDMethodBase<dim, spacedim>::getMaxPointDisplacement();
+
+        // Save these so that endDataRedistribution() can check whether or
+        // not regridding changed anything
+        previous_levels.clear();
+        for (int ln = 0; ln <= this->patch_hierarchy->getFinestLevelNumber();
+             ++ln)
+          previous_levels.push_back(this->patch_hierarchy->getPatchLevel(ln));
+
+        // Update the workload model before we compute the new workload
+        updated_workload_weights =
+          workload_calibration && workload_calibration->finish_window();
+        if (updated_workload_weights)
+          {
+            auto set_weights = [&](auto &interactions)
+            {
+              for (auto &interaction : interactions)
+                interaction->set_workload_weights(
+                  workload_calibration->get_point_weight(),
+                  workload_calibration->get_cell_weight());
+            };
+            set_weights(interactions);
+            set_weights(surface_interactions);
+            if (input_db->getBoolWithDefault("enable_logging", true) &&
+                IBTK::IBTK_MPI::getRank() == 0)
+              tbox::plog << "IFEDMethod::beginDataRedistribution(): "
+                         << "calibrated workload element weight = "
+                         << workload_calibration->get_cell_weight()
+                         << std::endl;
+          }
+
         // Weird things happen when we coarsen and refine if some levels are
         // not present, so fill them all in with zeros to start
         const int max_ln = this->patch_hierarchy->getFinestLevelNumber();
@@ -937,46 +3239,49 @@ namespace fdl
                  0,
                  max_ln);
 
-        // Start:
-        auto setup_transaction = [&](const auto &collection,
-                                     const auto &interactions,
-                                     auto       &transactions)
+        // Inactive parts do not contribute to the workload
+        TransactionScheduler           scheduler;
+        const std::vector<std::string> transaction_names =
+          get_active_lane_names(get_lane_names(this->parts.size(),
+                                               this->surface_parts.size()),
+                                this->active_parts);
+        if (this->tracer)
+          scheduler.set_tracer(*this->tracer, transaction_names);
+        auto setup_transaction = [&](const auto       &collection,
+                                     const auto       &interactions,
+                                     const std::size_t offset)
         {
           for (unsigned int i = 0; i < collection.size(); ++i)
             {
+              if (!this->part_is_active(offset + i))
+                continue;
               const auto &part = collection[i];
-              transactions.emplace_back(interactions[i]->add_workload_start(
-                lagrangian_workload_current_index,
-                part.get_position(),
-                part.get_dof_handler()));
+              scheduler.add_workload_transaction(
+                *interactions[i],
+                interactions[i]->add_workload_start(
+                  lagrangian_workload_current_index,
+                  part.get_position(),
+                  part.get_dof_handler()));
             }
         };
-        std::vector<std::unique_ptr<TransactionBase>> transactions,
-          surface_transactions;
-        setup_transaction(this->parts, interactions, transactions);
+        setup_transaction(this->parts, interactions, 0);
         setup_transaction(this->surface_parts,
                           surface_interactions,
-                          surface_transactions);
-
-        // Compute:
-        auto compute_transaction = [](auto &interactions, auto &transactions)
-        {
-          for (unsigned int i = 0; i < transactions.size(); ++i)
-            transactions[i] = interactions[i]->add_workload_intermediate(
-              std::move(transactions[i]));
-        };
-        compute_transaction(interactions, transactions);
-        compute_transaction(surface_interactions, surface_transactions);
-
-        // Finish:
-        auto finish_transaction =
-          [](const auto &interactions, auto &transactions)
-        {
-          for (unsigned int i = 0; i < transactions.size(); ++i)
-            interactions[i]->add_workload_finish(std::move(transactions[i]));
-        };
-        finish_transaction(interactions, transactions);
-        finish_transaction(surface_interactions, surface_transactions);
+                          this->parts.size());
+        scheduler.run();
+        for (unsigned int i = 0; i < this->marker_points.size(); ++i)
+          marker_point_interactions[i].add_workload(
+            lagrangian_workload_current_index,
+            this->marker_points[i].get_position(),
+            get_workload_point_weight<spacedim>(input_db,
+                                                marker_point_ib_kernels[i]));
+        if (this->performance_counters)
+          this->performance_counters->add("regrid_mpi_wait_time",
+                                          scheduler.get_mpi_wait_time());
+        if (input_db->getBoolWithDefault("log_transaction_times", false))
+          log_transaction_times("beginDataRedistribution",
+                                scheduler,
+                                transaction_names);
 
         // Move to primary hierarchy (we will read it back in
         // endDataRedistribution)
@@ -985,15 +3290,24 @@ namespace fdl
                  0,
                  max_ln);
 
-        secondary_hierarchy.transferSecondaryToPrimary(
-          max_ln,
-          lagrangian_workload_current_index,
-          lagrangian_workload_current_index,
-          0.0);
+        const bool sparse_workload_transfer =
+          input_db->getBoolWithDefault("sparse_workload_transfer", false);
+        for (const int ln : this->get_interaction_level_numbers())
+          {
+            if (sparse_workload_transfer)
+              add_nonzero_cell_data(
+                this->patch_hierarchy->getPatchLevel(ln),
+                secondary_hierarchy.getSecondaryHierarchy()->getPatchLevel(ln),
+                lagrangian_workload_current_index,
+                IBTK::IBTK_MPI::getCommunicator());
+            else
+              secondary_hierarchy.transferSecondaryToPrimary(
+                ln,
+                lagrangian_workload_current_index,
+                lagrangian_workload_current_index,
+                0.0);
+          }
       }
-
-    // Clear a few things that depend on the current hierarchy:
-    ghost_data_accumulator.reset();
     IBAMR_TIMER_STOP(t_begin_data_redistribution);
   }
 
@@ -1007,24 +3321,61 @@ namespace fdl
     // same as beginDataRedistribution
     if (this->patch_hierarchy)
       {
-        secondary_hierarchy.reinit(
-          this->patch_hierarchy->getFinestLevelNumber(),
-          this->patch_hierarchy->getFinestLevelNumber(),
-          this->patch_hierarchy,
-          lagrangian_workload_current_index);
+        // SAMRAI creates new patch levels when it regrids them, so the
+        // secondary hierarchy's transfer schedules (and everything set up on
+        // the secondary hierarchy) are still valid if and only if the levels
+        // we interact with are the same objects as before
+        const int coarsest_ln = this->get_interaction_level_numbers().front();
+        const int finest_ln   = this->patch_hierarchy->getFinestLevelNumber();
+        bool      same_levels = int(previous_levels.size()) == finest_ln + 1;
+        for (int ln = coarsest_ln; same_levels && ln <= finest_ln; ++ln)
+          same_levels = previous_levels[ln].getPointer() ==
+                        this->patch_hierarchy->getPatchLevel(ln).getPointer();
+        previous_levels.clear();
+
+        // If, in addition, nothing moved then the workload, and hence the
+        // secondary hierarchy and the interaction objects, are unchanged
+        const bool no_op_regrid = same_levels && regrid_displacement == 0.0 &&
+                                  !updated_workload_weights;
+        const bool reuse_secondary_hierarchy =
+          same_levels &&
+          (no_op_regrid ||
+           input_db->getBoolWithDefault("reuse_secondary_hierarchy", false));
+        if (input_db->getBoolWithDefault("enable_logging", true) &&
+            IBTK::IBTK_MPI::getRank() == 0 && reuse_secondary_hierarchy)
+          tbox::plog << "IFEDMethod::endDataRedistribution(): "
+                     << "reusing the secondary hierarchy"
+                     << (no_op_regrid ? " and interactions" : "") << std::endl;
+
+        if (!reuse_secondary_hierarchy)
+          {
+            // Clear a few things that depend on the current hierarchy:
+            ghost_data_accumulator.reset();
+            secondary_hierarchy.reinit(coarsest_ln,
+                                       finest_ln,
+                                       this->patch_hierarchy,
+                                       lagrangian_workload_current_index);
+            secondary_level_matches_primary = get_same_layout_levels(
+              this->patch_hierarchy,
+              secondary_hierarchy.getSecondaryHierarchy(),
+              coarsest_ln,
+              finest_ln);
+          }
 
-        reinit_interactions();
+        if (!no_op_regrid)
+          reinit_interactions();
 
         if (input_db->getBoolWithDefault("enable_logging", true) &&
             (this->started_time_integration ||
              (!this->started_time_integration &&
               !input_db->getBoolWithDefault("skip_initial_workload", false))))
           {
-            const int ln = this->patch_hierarchy->getFinestLevelNumber();
-            auto      secondary_ops = extract_hierarchy_data_ops(
+            auto secondary_ops = extract_hierarchy_data_ops(
               lagrangian_workload_var,
               secondary_hierarchy.getSecondaryHierarchy());
-            secondary_ops->resetLevels(ln, ln);
+            secondary_ops->resetLevels(
+              this->get_interaction_level_numbers().front(),
+              this->patch_hierarchy->getFinestLevelNumber());
             const double work =
               secondary_ops->L1Norm(lagrangian_workload_current_index,
                                     IBTK::invalid_index,
@@ -1050,9 +3401,38 @@ namespace fdl
                                               all_work.end(),
                                               0.0)
                            << std::endl;
+                if (input_db->getBoolWithDefault("log_regrid_displacement",
+                                                 false) &&
+                    !std::isnan(regrid_displacement))
+                  tbox::plog
+                    << "IFEDMethod::endDataRedistribution(): "
+                    << "maximum displacement since previous regrid = "
+                    << regrid_displacement << " (fraction of ghost region = "
+                    << regrid_policy.get_budget_fraction(regrid_displacement)
+                    << ")" << std::endl;
               }
           }
 
+        if (input_db->getBoolWithDefault("log_memory_consumption", false))
+          {
+            std::vector<double> n_bytes(4, 0.0);
+            for (const Part<dim, spacedim> &part : this->parts)
+              n_bytes[0] += part.memory_consumption();
+            for (const Part<dim - 1, spacedim> &part : this->surface_parts)
+              n_bytes[0] += part.memory_consumption();
+            n_bytes[1] = this->part_vectors.memory_consumption() +
+                         this->surface_part_vectors.memory_consumption();
+            for (const auto &interaction : interactions)
+              n_bytes[2] += interaction->memory_consumption();
+            for (const auto &interaction : surface_interactions)
+              n_bytes[2] += interaction->memory_consumption();
+            n_bytes[3] = n_bytes[0] + n_bytes[1] + n_bytes[2];
+            log_memory_consumption(
+              "endDataRedistribution",
+              {"parts", "part vectors", "interactions", "total"},
+              n_bytes);
+          }
+
         // IBTK::HierarchyIntegrator (which controls these data indices) will
         // exchange pointers between the new and current states during
         // timestepping. In particular: it will swap new and current,
@@ -1,23 +1,36 @@
 #include <fiddle/base/samrai_utilities.h>
 
 #include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/grid_utilities.h>
 
 #include <fiddle/interaction/ifed_method_base.h>
 #include <fiddle/interaction/interaction_utilities.h>
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/multithread_info.h>
+#include <deal.II/base/quadrature_lib.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
+#include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_fe_field.h>
 
+#include <deal.II/grid/filtered_iterator.h>
+
 #include <ibamr/ibamr_utilities.h>
 
 #include <ibtk/IBTK_MPI.h>
 
 #include <tbox/RestartManager.h>
+#include <tbox/Utilities.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <limits>
+#include <tuple>
 
 namespace
 {
@@ -35,6 +48,283 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    /**
+     * Update the bounding boxes and longest edge lengths of all active cells
+     * of @p part stored in @p cache. Both are computed from the same
+     * evaluation of the position at each cell's support points. Unless the
+     * bounding boxes are updated incrementally (in which case only the
+     * requested quantity is computed) both quantities are updated and
+     * communicated together. If @p node_shared is true then both are stored
+     * in memory shared between the processors of each node. If
+     * @p n_bbox_points_1d is positive then the bounding boxes are instead
+     * computed from the quadrature points of a Gauss rule with that many
+     * points per dimension. If @p nodal_bboxes is true then the support
+     * points are read directly from the position vector instead of being
+     * computed with a MappingFEField (see
+     * compute_cell_nodal_bboxes_and_longest_edge_lengths()).
+     */
+    template <int structdim, int spacedim, typename GeometryCache>
+    void
+    update_geometry_cache(const Part<structdim, spacedim> &part,
+                          const bool                       need_bboxes,
+                          const bool                       need_edge_lengths,
+                          const bool                       incremental,
+                          const double                     tolerance,
+                          const BoundingBoxEncoding        encoding,
+                          const bool                       node_shared,
+                          const unsigned int               n_bbox_points_1d,
+                          const bool                       nodal_bboxes,
+                          GeometryCache                   &cache)
+    {
+      const bool update_bboxes =
+        !cache.bboxes_valid && (need_bboxes || !incremental);
+      const bool update_edge_lengths =
+        !cache.edge_lengths_valid && (need_edge_lengths || !incremental);
+      if (!update_bboxes && !update_edge_lengths)
+        return;
+
+      MappingFEField<structdim,
+                     spacedim,
+                     LinearAlgebra::distributed::Vector<double>>
+           mapping(part.get_dof_handler(), part.get_position());
+      auto local_geometry =
+        nodal_bboxes ?
+          compute_cell_nodal_bboxes_and_longest_edge_lengths<structdim,
+                                                             spacedim,
+                                                             float>(
+            part.get_dof_handler(), part.get_position()) :
+          compute_cell_bboxes_and_longest_edge_lengths<structdim,
+                                                       spacedim,
+                                                       float>(
+            part.get_dof_handler(), mapping);
+      if (n_bbox_points_1d != 0)
+        local_geometry =
+          compute_cell_point_bboxes_and_longest_edge_lengths<structdim,
+                                                             spacedim,
+                                                             float>(
+            part.get_dof_handler(),
+            mapping,
+            QGauss<structdim>(n_bbox_points_1d),
+            std::move(local_geometry));
+      // Like most other things this only works with p::s::T now
+      const auto &tria = dynamic_cast<
+        const parallel::shared::Triangulation<structdim, spacedim> &>(
+        part.get_triangulation());
+      if (node_shared)
+        {
+          Assert(!incremental, ExcFDLInternalError());
+          std::tie(cache.shared_active_cell_bboxes,
+                   cache.shared_longest_edge_lengths) =
+            collect_shared_active_cell_bboxes_and_lengths(
+              tria, local_geometry.first, local_geometry.second);
+        }
+      else if (update_bboxes && update_edge_lengths && !incremental)
+        std::tie(cache.global_active_cell_bboxes,
+                 cache.global_longest_edge_lengths) =
+          collect_all_active_cell_bboxes_and_lengths(tria,
+                                                     local_geometry.first,
+                                                     local_geometry.second);
+      else
+        {
+          if (update_bboxes && incremental)
+            update_all_active_cell_bboxes(tria,
+                                          local_geometry.first,
+                                          cache.global_active_cell_bboxes,
+                                          tolerance,
+                                          encoding);
+          else if (update_bboxes)
+            cache.global_active_cell_bboxes =
+              collect_all_active_cell_bboxes(tria, local_geometry.first);
+          if (update_edge_lengths)
+            cache.global_longest_edge_lengths =
+              collect_longest_edge_lengths(tria, local_geometry.second);
+        }
+      if (update_bboxes)
+        cache.bboxes_valid = true;
+      if (update_edge_lengths)
+        cache.edge_lengths_valid = true;
+    }
+
+    /**
+     * Compute degenerate bounding boxes of the quadrature points (on all
+     * processors) of @p part, using a Gauss-type quadrature with
+     * @p n_points_1d points per dimension.
+     */
+    template <int structdim, int spacedim>
+    std::vector<BoundingBox<spacedim, float>>
+    compute_global_quadrature_points(const Part<structdim, spacedim> &part,
+                                     const unsigned int n_points_1d)
+    {
+      MappingFEField<structdim,
+                     spacedim,
+                     LinearAlgebra::distributed::Vector<double>>
+                 mapping(part.get_dof_handler(), part.get_position());
+      const FiniteElement<structdim, spacedim> &fe =
+        part.get_dof_handler().get_fe();
+      const Quadrature<structdim> quadrature =
+        fe.reference_cell().template get_gauss_type_quadrature<structdim>(
+          n_points_1d);
+      FEValues<structdim, spacedim> fe_values(mapping,
+                                              fe,
+                                              quadrature,
+                                              update_quadrature_points);
+
+      std::vector<BoundingBox<spacedim, float>> local_points;
+      for (const auto &cell :
+           part.get_dof_handler().active_cell_iterators() |
+             IteratorFilters::LocallyOwnedCell())
+        {
+          fe_values.reinit(cell);
+          for (const Point<spacedim> &q : fe_values.get_quadrature_points())
+            {
+              Point<spacedim, float> p;
+              for (unsigned int d = 0; d < spacedim; ++d)
+                p[d] = q[d];
+              local_points.emplace_back(std::make_pair(p, p));
+            }
+        }
+
+      std::vector<BoundingBox<spacedim, float>> global_points;
+      for (const auto &points :
+           Utilities::MPI::all_gather(part.get_communicator(), local_points))
+        global_points.insert(global_points.end(), points.begin(), points.end());
+      return global_points;
+    }
+
+    // Append the state of a part to a buffer in the same format used by
+    // Part::write_state().
+    template <int structdim, int spacedim>
+    void
+    stage_state(const Part<structdim, spacedim> &part,
+                std::vector<char>               &buffer)
+    {
+      const auto         &position = part.get_position();
+      const auto         &velocity = part.get_velocity();
+      const std::uint64_t n_values = position.locally_owned_size();
+      const std::size_t   offset   = buffer.size();
+      buffer.resize(offset + sizeof(n_values) + 2 * n_values * sizeof(double));
+
+      char *out = buffer.data() + offset;
+      std::memcpy(out, &n_values, sizeof(n_values));
+      out += sizeof(n_values);
+      std::memcpy(out, position.begin(), n_values * sizeof(double));
+      out += n_values * sizeof(double);
+      std::memcpy(out, velocity.begin(), n_values * sizeof(double));
+    }
+
+    /**
+     * Encode the contents of a delta-compressed restart file: either
+     * @p state itself (a keyframe) or, if @p reference is not empty, the
+     * bitwise XOR of @p state with @p reference, which is the state stored in
+     * the file @p reference_filename (relative to the directory of the new
+     * file). XORing the bits of nearly equal doubles gives mostly zero sign,
+     * exponent, and leading mantissa bits, so the compressed deltas are much
+     * smaller than the compressed values.
+     */
+    std::string
+    encode_restart_state(const std::vector<char> &state,
+                         const std::vector<char> &reference,
+                         const std::string       &reference_filename)
+    {
+      std::string data(state.begin(), state.end());
+      if (!reference.empty())
+        {
+          AssertDimension(reference.size(), state.size());
+          for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = char(static_cast<unsigned char>(data[i]) ^
+                           static_cast<unsigned char>(reference[i]));
+        }
+      const std::string compressed = Utilities::compress(data);
+
+      std::ostringstream  out;
+      const std::uint64_t name_size =
+        reference.empty() ? 0 : reference_filename.size();
+      const std::uint64_t compressed_size = compressed.size();
+      out.write(reinterpret_cast<const char *>(&name_size), sizeof(name_size));
+      out.write(reference_filename.data(), name_size);
+      out.write(reinterpret_cast<const char *>(&compressed_size),
+                sizeof(compressed_size));
+      out.write(compressed.data(), compressed_size);
+      return out.str();
+    }
+
+    /**
+     * Decode a file written by encode_restart_state() by first (recursively)
+     * decoding the file it references, if any. The chain of references ends
+     * at the previous keyframe.
+     */
+    std::string
+    decode_restart_state(const std::string &filename)
+    {
+      std::ifstream in(filename, std::ios::binary);
+      AssertThrow(in, ExcMessage("Unable to open restart file " + filename));
+      std::uint64_t name_size = 0;
+      in.read(reinterpret_cast<char *>(&name_size), sizeof(name_size));
+      std::string reference_filename(name_size, '\0');
+      in.read(&reference_filename[0], name_size);
+      std::uint64_t compressed_size = 0;
+      in.read(reinterpret_cast<char *>(&compressed_size),
+              sizeof(compressed_size));
+      std::string compressed(compressed_size, '\0');
+      in.read(&compressed[0], compressed_size);
+      AssertThrow(in, ExcMessage("Unable to read restart file " + filename));
+
+      std::string data = Utilities::decompress(compressed);
+      if (name_size > 0)
+        {
+          const std::size_t slash = filename.find_last_of('/');
+          const std::string directory =
+            slash == std::string::npos ? "" : filename.substr(0, slash + 1);
+          const std::string reference =
+            decode_restart_state(directory + reference_filename);
+          AssertThrow(reference.size() == data.size(),
+                      ExcMessage("The restart file " + filename +
+                                 " does not match the file it references."));
+          for (std::size_t i = 0; i < data.size(); ++i)
+            data[i] = char(static_cast<unsigned char>(data[i]) ^
+                           static_cast<unsigned char>(reference[i]));
+        }
+      return data;
+    }
+
+    /**
+     * Set @p dst to x + a u (+ b v, if @p v is not null) with a single pass
+     * over the locally owned entries instead of one pass per vector
+     * operation.
+     */
+    void
+    fused_update(LinearAlgebra::distributed::Vector<double>       &dst,
+                 const LinearAlgebra::distributed::Vector<double> &x,
+                 const double                                      a,
+                 const LinearAlgebra::distributed::Vector<double> &u,
+                 const double                                      b = 0.0,
+                 const LinearAlgebra::distributed::Vector<double> *v = nullptr)
+    {
+      const std::size_t n_values = dst.locally_owned_size();
+      AssertDimension(x.locally_owned_size(), n_values);
+      AssertDimension(u.locally_owned_size(), n_values);
+      double *const       d  = dst.begin();
+      const double *const xs = x.begin();
+      const double *const us = u.begin();
+      if (v)
+        {
+          AssertDimension(v->locally_owned_size(), n_values);
+          const double *const vs = v->begin();
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (std::size_t j = 0; j < n_values; ++j)
+            d[j] = xs[j] + a * us[j] + b * vs[j];
+        }
+      else
+        {
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (std::size_t j = 0; j < n_values; ++j)
+            d[j] = xs[j] + a * us[j];
+        }
+    }
+  } // namespace
+
   //
   // Initialization
   //
@@ -45,20 +335,63 @@ namespace fdl
     std::vector<Part<dim - 1, spacedim>> &&input_surface_parts,
     std::vector<Part<dim, spacedim>>     &&input_parts,
     const bool                             register_for_restart)
+    : IFEDMethodBase(object_name,
+                     std::move(input_surface_parts),
+                     std::move(input_parts),
+                     {},
+                     register_for_restart)
+  {}
+
+  template <int dim, int spacedim>
+  IFEDMethodBase<dim, spacedim>::IFEDMethodBase(
+    const std::string                     &object_name,
+    std::vector<Part<dim - 1, spacedim>> &&input_surface_parts,
+    std::vector<Part<dim, spacedim>>     &&input_parts,
+    std::vector<MarkerPoints<spacedim>>  &&input_marker_points,
+    const bool                             register_for_restart)
     : object_name(object_name)
     , register_for_restart(register_for_restart)
+    , n_restart_files_written(0)
+    , asynchronous_restart_files(false)
+    , checkpoint_setup_data(false)
+    , delta_restart_files(false)
+    , restart_keyframe_interval(10)
+    , portable_restart_files(false)
+    , n_restart_deltas(0)
     , started_time_integration(false)
     , current_time(std::numeric_limits<double>::signaling_NaN())
     , half_time(std::numeric_limits<double>::signaling_NaN())
     , new_time(std::numeric_limits<double>::signaling_NaN())
+    , regrid_start_time(0.0)
+    , trace_n_steps(0)
+    , n_traced_steps(0)
+    , tag_with_quadrature_points(false)
+    , n_tag_points_1d(0)
     , parts(std::move(input_parts))
     , surface_parts(std::move(input_surface_parts))
     , part_vectors(this->parts)
     , surface_part_vectors(this->surface_parts)
+    , marker_points(std::move(input_marker_points))
+    , use_ab2_step(false)
+    , previous_time_step_size(0.0)
+    , structure_cfl_target(0.5)
+    , max_dt_growth(1.1)
+    , max_velocity_over_dx(-1.0)
+    , incremental_bbox_update(false)
+    , bbox_update_tolerance(0.0)
+    , bbox_encoding(BoundingBoxEncoding::Full)
+    , node_shared_geometry(false)
+    , n_bbox_points_1d(0)
+    , nodal_bboxes(false)
   {
     // IBAMR does not support using threads so unconditionally disable them
     // here.
     MultithreadInfo::set_thread_limit(1);
+    interaction_level_numbers.resize(n_parts() + n_surface_parts(),
+                                     std::numeric_limits<int>::max());
+    tag_buffers.resize(n_parts() + n_surface_parts(), 0);
+    n_force_subcycles.resize(n_parts() + n_surface_parts(), 1);
+    active_parts.resize(n_parts() + n_surface_parts(), true);
 
     auto set_timer = [&](const char *name)
     { return tbox::TimerManager::getManager()->getTimer(name); };
@@ -105,8 +438,29 @@ namespace fdl
                       collection[i].load(iarchive, 0);
                     }
                 };
-                do_load(this->parts, "part_");
-                do_load(this->surface_parts, "surface_part_");
+                if (db->keyExists("restart_file_prefix"))
+                  {
+                    read_restart_file(db);
+                    // Don't overwrite the files from which we restarted
+                    n_restart_files_written =
+                      db->getInteger("n_restart_files_written");
+                  }
+                else
+                  {
+                    do_load(this->parts, "part_");
+                    do_load(this->surface_parts, "surface_part_");
+                  }
+                // Marker points are always stored in the database
+                for (unsigned int i = 0; i < marker_points.size(); ++i)
+                  {
+                    const std::string key =
+                      "marker_points_" + std::to_string(i);
+                    AssertThrow(db->keyExists(key),
+                                ExcMessage("Couldn't find key " + key +
+                                           " in the restart database"));
+                    std::istringstream in_str(load_binary(key, db));
+                    marker_points[i].read_state(in_str);
+                  }
               }
             else
               {
@@ -120,11 +474,18 @@ namespace fdl
 
     init_regrid_positions(positions_at_last_regrid, parts);
     init_regrid_positions(surface_positions_at_last_regrid, surface_parts);
+    for (const auto &points : marker_points)
+      marker_point_positions_at_last_regrid.push_back(points.get_position());
+
+    geometry_cache.resize(parts.size());
+    surface_geometry_cache.resize(surface_parts.size());
   }
 
   template <int dim, int spacedim>
   IFEDMethodBase<dim, spacedim>::~IFEDMethodBase()
   {
+    if (restart_write.valid())
+      restart_write.wait();
     if (register_for_restart)
       {
         tbox::RestartManager::getManager()->unregisterRestartItem(object_name);
@@ -143,16 +504,285 @@ namespace fdl
     const std::vector<tbox::Pointer<xfer::RefineSchedule<spacedim>>>
       & /*u_ghost_fill_scheds*/,
     int /*integrator_step*/,
-    double /*init_data_time*/,
+    double init_data_time,
     bool /*initial_time*/)
   {
     patch_hierarchy = hierarchy;
+    update_active_parts(init_data_time);
 
     eulerian_data_cache = std::make_shared<IBTK::SAMRAIDataCache>();
     eulerian_data_cache->setPatchHierarchy(hierarchy);
     eulerian_data_cache->resetLevels(0, hierarchy->getFinestLevelNumber());
   }
 
+  template <int dim, int spacedim>
+  void
+  IFEDMethodBase<dim, spacedim>::update_active_parts(const double time)
+  {
+    for (unsigned int i = 0; i < n_parts(); ++i)
+      active_parts[i] = parts[i].is_active(time);
+    for (unsigned int i = 0; i < n_surface_parts(); ++i)
+      active_parts[n_parts() + i] = surface_parts[i].is_active(time);
+  }
+
+  //
+  // Geometric data
+  //
+
+  template <int dim, int spacedim>
+  ArrayView<const BoundingBox<spacedim, float>>
+  IFEDMethodBase<dim, spacedim>::get_global_active_cell_bboxes(
+    const unsigned int part_n)
+  {
+    AssertIndexRange(part_n, n_parts());
+    auto &cache = geometry_cache[part_n];
+    update_geometry_cache(parts[part_n],
+                          true,
+                          false,
+                          incremental_bbox_update,
+                          bbox_update_tolerance,
+                          bbox_encoding,
+                          node_shared_geometry,
+                          n_bbox_points_1d,
+                          nodal_bboxes,
+                          cache);
+    if (node_shared_geometry)
+      return make_array_view(cache.shared_active_cell_bboxes);
+    return make_array_view(cache.global_active_cell_bboxes);
+  }
+
+  template <int dim, int spacedim>
+  ArrayView<const BoundingBox<spacedim, float>>
+  IFEDMethodBase<dim, spacedim>::get_surface_global_active_cell_bboxes(
+    const unsigned int surface_part_n)
+  {
+    AssertIndexRange(surface_part_n, n_surface_parts());
+    auto &cache = surface_geometry_cache[surface_part_n];
+    update_geometry_cache(surface_parts[surface_part_n],
+                          true,
+                          false,
+                          incremental_bbox_update,
+                          bbox_update_tolerance,
+                          bbox_encoding,
+                          node_shared_geometry,
+                          n_bbox_points_1d,
+                          nodal_bboxes,
+                          cache);
+    if (node_shared_geometry)
+      return make_array_view(cache.shared_active_cell_bboxes);
+    return make_array_view(cache.global_active_cell_bboxes);
+  }
+
+  template <int dim, int spacedim>
+  ArrayView<const float>
+  IFEDMethodBase<dim, spacedim>::get_global_longest_edge_lengths(
+    const unsigned int part_n)
+  {
+    AssertIndexRange(part_n, n_parts());
+    auto &cache = geometry_cache[part_n];
+    update_geometry_cache(parts[part_n],
+                          false,
+                          true,
+                          incremental_bbox_update,
+                          bbox_update_tolerance,
+                          bbox_encoding,
+                          node_shared_geometry,
+                          n_bbox_points_1d,
+                          nodal_bboxes,
+                          cache);
+    if (node_shared_geometry)
+      return make_array_view(cache.shared_longest_edge_lengths);
+    return make_array_view(cache.global_longest_edge_lengths);
+  }
+
+  template <int dim, int spacedim>
+  ArrayView<const float>
+  IFEDMethodBase<dim, spacedim>::get_surface_global_longest_edge_lengths(
+    const unsigned int surface_part_n)
+  {
+    AssertIndexRange(surface_part_n, n_surface_parts());
+    auto &cache = surface_geometry_cache[surface_part_n];
+    update_geometry_cache(surface_parts[surface_part_n],
+                          false,
+                          true,
+                          incremental_bbox_update,
+                          bbox_update_tolerance,
+                          bbox_encoding,
+                          node_shared_geometry,
+                          n_bbox_points_1d,
+                          nodal_bboxes,
+                          cache);
+    if (node_shared_geometry)
+      return make_array_view(cache.shared_longest_edge_lengths);
+    return make_array_view(cache.global_longest_edge_lengths);
+  }
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethodBase<dim, spacedim>::clear_geometry_cache()
+  {
+    auto do_clear = [&](std::vector<GeometryCache> &caches)
+    {
+      for (auto &cache : caches)
+        {
+          cache.bboxes_valid       = false;
+          cache.edge_lengths_valid = false;
+          cache.tag_points_valid   = false;
+          if (!incremental_bbox_update)
+            std::vector<BoundingBox<spacedim, float>>().swap(
+              cache.global_active_cell_bboxes);
+          std::vector<float>().swap(cache.global_longest_edge_lengths);
+          cache.shared_active_cell_bboxes.clear();
+          cache.shared_longest_edge_lengths.clear();
+          std::vector<BoundingBox<spacedim, float>>().swap(
+            cache.global_tag_points);
+        }
+    };
+    do_clear(geometry_cache);
+    do_clear(surface_geometry_cache);
+  }
+
+  template <int dim, int spacedim>
+  ArrayView<const BoundingBox<spacedim, float>>
+  IFEDMethodBase<dim, spacedim>::get_global_tag_bboxes(
+    const unsigned int part_n)
+  {
+    AssertIndexRange(part_n, n_parts());
+    if (!tag_with_quadrature_points)
+      return get_global_active_cell_bboxes(part_n);
+    auto &cache = geometry_cache[part_n];
+    if (!cache.tag_points_valid)
+      {
+        const auto &part = parts[part_n];
+        cache.global_tag_points = compute_global_quadrature_points(
+          part,
+          n_tag_points_1d == 0 ?
+            part.get_dof_handler().get_fe().tensor_degree() + 1 :
+            n_tag_points_1d);
+        cache.tag_points_valid = true;
+      }
+    return make_array_view(cache.global_tag_points);
+  }
+
+  template <int dim, int spacedim>
+  ArrayView<const BoundingBox<spacedim, float>>
+  IFEDMethodBase<dim, spacedim>::get_surface_global_tag_bboxes(
+    const unsigned int surface_part_n)
+  {
+    AssertIndexRange(surface_part_n, n_surface_parts());
+    if (!tag_with_quadrature_points)
+      return get_surface_global_active_cell_bboxes(surface_part_n);
+    auto &cache = surface_geometry_cache[surface_part_n];
+    if (!cache.tag_points_valid)
+      {
+        const auto &part = surface_parts[surface_part_n];
+        cache.global_tag_points = compute_global_quadrature_points(
+          part,
+          n_tag_points_1d == 0 ?
+            part.get_dof_handler().get_fe().tensor_degree() + 1 :
+            n_tag_points_1d);
+        cache.tag_points_valid = true;
+      }
+    return make_array_view(cache.global_tag_points);
+  }
+
+  template <int dim, int spacedim>
+  int
+  IFEDMethodBase<dim, spacedim>::get_interaction_level_number(
+    const unsigned int part_n) const
+  {
+    AssertIndexRange(part_n, interaction_level_numbers.size());
+    Assert(patch_hierarchy, ExcFDLInternalError());
+    return std::min(interaction_level_numbers[part_n],
+                    patch_hierarchy->getFinestLevelNumber());
+  }
+
+  template <int dim, int spacedim>
+  std::vector<int>
+  IFEDMethodBase<dim, spacedim>::get_interaction_level_numbers() const
+  {
+    std::vector<int> level_numbers;
+    for (unsigned int i = 0; i < interaction_level_numbers.size(); ++i)
+      level_numbers.push_back(get_interaction_level_number(i));
+    // Marker points always interact with the finest level
+    if (marker_points.size() > 0)
+      level_numbers.push_back(patch_hierarchy->getFinestLevelNumber());
+    std::sort(level_numbers.begin(), level_numbers.end());
+    level_numbers.erase(std::unique(level_numbers.begin(), level_numbers.end()),
+                        level_numbers.end());
+    if (level_numbers.empty())
+      level_numbers.push_back(patch_hierarchy->getFinestLevelNumber());
+    return level_numbers;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<BoundingBox<spacedim>>
+  IFEDMethodBase<dim, spacedim>::get_marker_point_bboxes(
+    const unsigned int marker_points_n) const
+  {
+    const MarkerPoints<spacedim> &points   = get_marker_points(marker_points_n);
+    const Vector<double>         &position = points.get_position();
+    std::vector<BoundingBox<spacedim>> bboxes;
+    bboxes.reserve(points.n_points());
+    for (std::size_t point_n = 0; point_n < points.n_points(); ++point_n)
+      {
+        Point<spacedim> point;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          point[d] = position[point_n * spacedim + d];
+        bboxes.emplace_back(std::make_pair(point, point));
+      }
+    return bboxes;
+  }
+
+  template <int dim, int spacedim>
+  const Vector<double> &
+  IFEDMethodBase<dim, spacedim>::get_marker_point_position(
+    const unsigned int marker_points_n,
+    const double       time)
+  {
+    AssertIndexRange(marker_points_n, n_marker_point_sets());
+    if (std::abs(time - current_time) < 1e-12)
+      return marker_points[marker_points_n].get_position();
+    AssertIndexRange(marker_points_n, marker_point_new_positions.size());
+    if (std::abs(time - new_time) < 1e-12)
+      return marker_point_new_positions[marker_points_n];
+    Assert(std::abs(time - half_time) < 1e-12, ExcFDLInternalError());
+    marker_point_half_positions.resize(n_marker_point_sets());
+    Vector<double> &half_position =
+      marker_point_half_positions[marker_points_n];
+    if (half_position.size() == 0)
+      {
+        half_position = marker_points[marker_points_n].get_position();
+        half_position.sadd(0.5,
+                           0.5,
+                           marker_point_new_positions[marker_points_n]);
+      }
+    return half_position;
+  }
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethodBase<dim, spacedim>::set_marker_point_velocity(
+    const unsigned int marker_points_n,
+    const double       time,
+    Vector<double>   &&velocity)
+  {
+    AssertIndexRange(marker_points_n, n_marker_point_sets());
+    if (std::abs(time - current_time) < 1e-12)
+      marker_points[marker_points_n].set_velocity(std::move(velocity));
+    else if (std::abs(time - half_time) < 1e-12)
+      {
+        marker_point_half_velocities.resize(n_marker_point_sets());
+        marker_point_half_velocities[marker_points_n].swap(velocity);
+      }
+    else
+      {
+        Assert(std::abs(time - new_time) < 1e-12, ExcFDLInternalError());
+        marker_point_new_velocities.resize(n_marker_point_sets());
+        marker_point_new_velocities[marker_points_n].swap(velocity);
+      }
+  }
+
   //
   // Data redistribution
   //
@@ -164,6 +794,7 @@ namespace fdl
     tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> /*gridding_alg*/)
   {
     IBAMR_TIMER_START(t_begin_data_redistribution);
+    regrid_start_time = MPI_Wtime();
     IBAMR_TIMER_STOP(t_begin_data_redistribution);
   }
 
@@ -182,6 +813,18 @@ namespace fdl
     };
     do_reset(this->positions_at_last_regrid, this->parts);
     do_reset(this->surface_positions_at_last_regrid, this->surface_parts);
+    for (unsigned int i = 0; i < marker_points.size(); ++i)
+      marker_point_positions_at_last_regrid[i] =
+        marker_points[i].get_position();
+    if (performance_counters)
+      {
+        performance_counters->add("regrids", 1.0);
+        performance_counters->add("regrid_time",
+                                  MPI_Wtime() - regrid_start_time);
+      }
+    if (tracer)
+      tracer->add_event(
+        "IFEDMethod", "regrid", "compute", regrid_start_time, MPI_Wtime());
     IBAMR_TIMER_STOP(t_end_data_redistribution);
   }
 
@@ -194,7 +837,11 @@ namespace fdl
   IFEDMethodBase<dim, spacedim>::getMaxPointDisplacement() const
   {
     IBAMR_TIMER_START(t_max_point_displacement);
-    double max_displacement = 0;
+    // Compute the maximum displacement and velocity together so that the
+    // time step estimate does not require another reduction
+    std::array<double, 2> max_values{{0.0, 0.0}};
+    double               &max_displacement = max_values[0];
+    double               &max_velocity     = max_values[1];
 
     auto max_op = [&](const auto &collection, const auto &regrid_positions)
     {
@@ -203,24 +850,69 @@ namespace fdl
           AssertDimension(collection.size(), regrid_positions.size());
           const auto &ref_position = regrid_positions[i];
           const auto &position     = collection[i].get_position();
+          const auto &velocity     = collection[i].get_velocity();
           const auto  local_size   = position.locally_owned_size();
           for (unsigned int j = 0; j < local_size; ++j)
             max_displacement = std::max(max_displacement,
                                         std::abs(ref_position.local_element(j) -
                                                  position.local_element(j)));
+          for (unsigned int j = 0; j < velocity.locally_owned_size(); ++j)
+            max_velocity =
+              std::max(max_velocity, std::abs(velocity.local_element(j)));
         }
     };
     max_op(this->parts, positions_at_last_regrid);
     max_op(this->surface_parts, surface_positions_at_last_regrid);
-    max_displacement =
-      Utilities::MPI::max(max_displacement, IBTK::IBTK_MPI::getCommunicator());
-
-    return max_displacement /
-           IBTK::get_min_patch_dx(
-             dynamic_cast<const hier::PatchLevel<spacedim> &>(
-               *patch_hierarchy->getPatchLevel(
-                 patch_hierarchy->getFinestLevelNumber())));
+    // Every processor has every marker point
+    for (unsigned int i = 0; i < marker_points.size(); ++i)
+      {
+        const Vector<double> &ref_position =
+          marker_point_positions_at_last_regrid[i];
+        const Vector<double> &position = marker_points[i].get_position();
+        for (unsigned int j = 0; j < position.size(); ++j)
+          max_displacement =
+            std::max(max_displacement,
+                     std::abs(ref_position[j] - position[j]));
+        const Vector<double> &velocity = marker_points[i].get_velocity();
+        for (unsigned int j = 0; j < velocity.size(); ++j)
+          max_velocity = std::max(max_velocity, std::abs(velocity[j]));
+      }
+    Utilities::MPI::max(ArrayView<const double>(max_values.data(),
+                                                max_values.size()),
+                        IBTK::IBTK_MPI::getCommunicator(),
+                        make_array_view(max_values));
+
+    const double dx = IBTK::get_min_patch_dx(
+      dynamic_cast<const hier::PatchLevel<spacedim> &>(
+        *patch_hierarchy->getPatchLevel(
+          patch_hierarchy->getFinestLevelNumber())));
+    max_velocity_over_dx = max_velocity / dx;
     IBAMR_TIMER_STOP(t_max_point_displacement);
+    return max_displacement / dx;
+  }
+
+  template <int dim, int spacedim>
+  double
+  IFEDMethodBase<dim, spacedim>::get_structure_cfl_number(
+    const double dt) const
+  {
+    AssertThrow(max_velocity_over_dx >= 0.0,
+                ExcMessage("The structure CFL number is only available after "
+                           "getMaxPointDisplacement() has been called."));
+    return max_velocity_over_dx * dt;
+  }
+
+  template <int dim, int spacedim>
+  double
+  IFEDMethodBase<dim, spacedim>::suggest_dt(const double current_dt) const
+  {
+    Assert(current_dt > 0.0, ExcMessage("The time step size must be positive."));
+    if (max_velocity_over_dx < 0.0)
+      return current_dt;
+    const double max_dt = max_dt_growth * current_dt;
+    if (max_velocity_over_dx == 0.0)
+      return max_dt;
+    return std::min(max_dt, structure_cfl_target / max_velocity_over_dx);
   }
 
   template <int dim, int spacedim>
@@ -234,38 +926,30 @@ namespace fdl
     bool /*uses_richardson_extrapolation_too*/)
   {
     IBAMR_TIMER_START(t_apply_gradient_detector);
-    // TODO: we should find a way to save the bboxes so they do not need to be
-    // computed for each level that needs tagging - conceivably this could
-    // happen in beginDataRedistribution() and the array can be cleared in
-    // endDataRedistribution()
-    auto do_tag = [&](const auto &collection)
-    {
-      for (const auto &part : collection)
-        {
-          constexpr int structdim =
-            std::remove_reference_t<decltype(collection[0])>::dimension;
-          MappingFEField<structdim,
-                         spacedim,
-                         LinearAlgebra::distributed::Vector<double>>
-                     mapping(part.get_dof_handler(), part.get_position());
-          const auto local_bboxes =
-            compute_cell_bboxes<structdim, spacedim, float>(
-              part.get_dof_handler(), mapping);
-          // Like most other things this only works with p::s::T now
-          const auto &tria = dynamic_cast<
-            const parallel::shared::Triangulation<structdim, spacedim> &>(
-            part.get_triangulation());
-          const auto global_bboxes =
-            collect_all_active_cell_bboxes(tria, local_bboxes);
-          tbox::Pointer<hier::PatchLevel<spacedim>> patch_level =
-            hierarchy->getPatchLevel(level_number);
-          Assert(patch_level, ExcNotImplemented());
-          tag_cells(global_bboxes, tag_index, patch_level);
-        }
-    };
-
-    do_tag(parts);
-    do_tag(surface_parts);
+    tbox::Pointer<hier::PatchLevel<spacedim>> patch_level =
+      hierarchy->getPatchLevel(level_number);
+    Assert(patch_level, ExcNotImplemented());
+    // The bounding boxes are only computed once per regrid (i.e., not once
+    // per level) since they are stored until the positions change.
+    // Parts which interact with coarser levels are not covered by any finer
+    // level.
+    // Inactive parts do not need to be resolved.
+    for (unsigned int i = 0; i < n_parts(); ++i)
+      if (part_is_active(i) && level_number < interaction_level_numbers[i])
+        tag_cells(get_global_tag_bboxes(i),
+                  tag_index,
+                  patch_level,
+                  tag_buffers[i]);
+    for (unsigned int i = 0; i < n_surface_parts(); ++i)
+      if (part_is_active(n_parts() + i) &&
+          level_number < interaction_level_numbers[n_parts() + i])
+        tag_cells(get_surface_global_tag_bboxes(i),
+                  tag_index,
+                  patch_level,
+                  tag_buffers[n_parts() + i]);
+    // Marker points interact with the finest level, so tag every level
+    for (unsigned int i = 0; i < n_marker_point_sets(); ++i)
+      tag_cells(get_marker_point_bboxes(i), tag_index, patch_level);
     IBAMR_TIMER_STOP(t_apply_gradient_detector);
   }
 
@@ -286,24 +970,33 @@ namespace fdl
     this->current_time = current_time;
     this->new_time     = new_time;
     this->half_time    = current_time + 0.5 * (new_time - current_time);
+    update_active_parts(current_time);
+    marker_point_new_positions.clear();
+    marker_point_half_positions.clear();
+    marker_point_half_velocities.clear();
+    marker_point_new_velocities.clear();
     IBAMR_TIMER_STOP(t_preprocess_integrate_data);
   }
 
   template <int dim, int spacedim>
   void
   IFEDMethodBase<dim, spacedim>::postprocessIntegrateData(
-    double /*current_time*/,
-    double /*new_time*/,
+    double current_time,
+    double new_time,
     int /*num_cycles*/)
   {
     IBAMR_TIMER_START(t_postprocess_integrate_data);
-    current_time = std::numeric_limits<double>::quiet_NaN();
-    new_time     = std::numeric_limits<double>::quiet_NaN();
-    half_time    = std::numeric_limits<double>::quiet_NaN();
+    this->current_time = std::numeric_limits<double>::quiet_NaN();
+    this->new_time     = std::numeric_limits<double>::quiet_NaN();
+    this->half_time    = std::numeric_limits<double>::quiet_NaN();
 
     // update positions and velocities:
     unsigned int channel = 0;
-    auto do_set = [&](auto &collection, auto &positions, auto &velocities)
+    auto do_set = [&](auto &collection,
+                      auto &vectors,
+                      auto &positions,
+                      auto &velocities,
+                      auto &previous_velocities)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
@@ -312,6 +1005,17 @@ namespace fdl
           part.get_position().update_ghost_values_start(channel++);
           part.set_velocity(std::move(velocities[i]));
           part.get_velocity().update_ghost_values_start(channel++);
+          // Part swaps in the new vectors, so these are the old position and
+          // velocity: keep their storage for the next time step (and, for
+          // the Adams-Bashforth method, keep the old velocity itself)
+          vectors.recycle_vector(i, std::move(positions[i]));
+          if (use_ab2_step)
+            {
+              previous_velocities.resize(collection.size());
+              previous_velocities[i].swap(velocities[i]);
+            }
+          if (velocities[i].size() > 0)
+            vectors.recycle_vector(i, std::move(velocities[i]));
         }
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
@@ -324,11 +1028,47 @@ namespace fdl
     auto new_velocities         = part_vectors.get_all_new_velocities();
     auto surface_new_positions  = surface_part_vectors.get_all_new_positions();
     auto surface_new_velocities = surface_part_vectors.get_all_new_velocities();
-    do_set(parts, new_positions, new_velocities);
-    do_set(surface_parts, surface_new_positions, surface_new_velocities);
+    do_set(parts,
+           part_vectors,
+           new_positions,
+           new_velocities,
+           previous_velocities);
+    do_set(surface_parts,
+           surface_part_vectors,
+           surface_new_positions,
+           surface_new_velocities,
+           surface_previous_velocities);
+    for (unsigned int i = 0; i < marker_points.size(); ++i)
+      {
+        AssertIndexRange(i, marker_point_new_positions.size());
+        marker_points[i].set_position(
+          std::move(marker_point_new_positions[i]));
+        if (i < marker_point_new_velocities.size() &&
+            marker_point_new_velocities[i].size() > 0)
+          marker_points[i].set_velocity(
+            std::move(marker_point_new_velocities[i]));
+        else if (i < marker_point_half_velocities.size() &&
+                 marker_point_half_velocities[i].size() > 0)
+          marker_points[i].set_velocity(
+            std::move(marker_point_half_velocities[i]));
+      }
+    marker_point_new_positions.clear();
+    marker_point_half_positions.clear();
+    marker_point_half_velocities.clear();
+    marker_point_new_velocities.clear();
+    previous_time_step_size = new_time - current_time;
+    clear_geometry_cache();
 
     part_vectors.end_time_step();
     surface_part_vectors.end_time_step();
+
+    if (performance_counters)
+      performance_counters->finish_step(new_time);
+    if (tracer && ++n_traced_steps == trace_n_steps)
+      {
+        tracer->write(trace_file);
+        tracer.reset();
+      }
     IBAMR_TIMER_STOP(t_postprocess_integrate_data);
   }
 
@@ -339,33 +1079,60 @@ namespace fdl
   {
     const double dt = new_time - current_time;
     Assert(this->current_time == current_time, ExcFDLNotImplemented());
-    auto do_step = [&](auto &collection, auto &vectors)
+    // Coefficients of the (variable step size) Adams-Bashforth method
+    const double ratio = dt / previous_time_step_size;
+    const double a     = dt * (1.0 + 0.5 * ratio);
+    const double b     = -dt * 0.5 * ratio;
+
+    auto do_step = [&](auto             &collection,
+                       auto             &vectors,
+                       auto             &previous_velocities,
+                       const std::size_t offset)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
           auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          // Set the position at the end time:
-          LinearAlgebra::distributed::Vector<double> new_position(
-            part.get_position());
-          new_position.set_ghost_state(false);
-          new_position.add(dt, part.get_velocity());
+          // Set the position at the end time. PartVectors computes the
+          // position at the half time from this if it is needed.
+          LinearAlgebra::distributed::Vector<double> new_position =
+            vectors.get_temporary_vector(i);
+          // Inactive parts do not move
+          if (!part_is_active(offset + i))
+            new_position = part.get_position();
+          // The first step (or the first step after a restart or a change in
+          // the partitioning) has no previous velocity, so it uses forward
+          // Euler
+          else if (use_ab2_step && i < previous_velocities.size() &&
+                   previous_velocities[i].get_partitioner() ==
+                     part.get_partitioner())
+            fused_update(new_position,
+                         part.get_position(),
+                         a,
+                         part.get_velocity(),
+                         b,
+                         &previous_velocities[i]);
+          else
+            fused_update(
+              new_position, part.get_position(), dt, part.get_velocity());
           vectors.set_position(i, new_time, std::move(new_position));
-
-          // Set the position at the half time:
-          LinearAlgebra::distributed::Vector<double> half_position(
-            part.get_partitioner());
-          half_position.set_ghost_state(false);
-          half_position.add(0.5,
-                            vectors.get_position(i, current_time),
-                            0.5,
-                            vectors.get_position(i, new_time));
-          vectors.set_position(i, half_time, std::move(half_position));
         }
     };
-    do_step(parts, part_vectors);
-    do_step(surface_parts, surface_part_vectors);
+    do_step(parts, part_vectors, previous_velocities, 0);
+    do_step(surface_parts,
+            surface_part_vectors,
+            surface_previous_velocities,
+            n_parts());
+    // Marker points do not store their previous velocities, so they use
+    // forward Euler even when the parts use AB2
+    marker_point_new_positions.resize(marker_points.size());
+    marker_point_half_positions.clear();
+    for (unsigned int i = 0; i < marker_points.size(); ++i)
+      {
+        marker_point_new_positions[i] = marker_points[i].get_position();
+        marker_point_new_positions[i].add(dt, marker_points[i].get_velocity());
+      }
   }
 
   template <int dim, int spacedim>
@@ -385,33 +1152,38 @@ namespace fdl
   {
     const double dt = new_time - current_time;
     Assert(this->current_time == current_time, ExcFDLNotImplemented());
-    auto do_step = [&](auto &collection, auto &vectors)
+    auto do_step =
+      [&](auto &collection, auto &vectors, const std::size_t offset)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
           auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          // Set the position at the end time:
-          LinearAlgebra::distributed::Vector<double> new_position(
-            part.get_position());
-          new_position.set_ghost_state(false);
-          new_position.add(dt, vectors.get_velocity(i, half_time));
+          // Set the position at the end time. PartVectors computes the
+          // position at the half time from this if it is needed.
+          LinearAlgebra::distributed::Vector<double> new_position =
+            vectors.get_temporary_vector(i);
+          if (!part_is_active(offset + i))
+            new_position = part.get_position();
+          else
+            fused_update(new_position,
+                         part.get_position(),
+                         dt,
+                         vectors.get_velocity(i, half_time));
           vectors.set_position(i, new_time, std::move(new_position));
-
-          // Set the position at the half time:
-          LinearAlgebra::distributed::Vector<double> half_position(
-            part.get_partitioner());
-          half_position.set_ghost_state(false);
-          half_position.add(0.5,
-                            vectors.get_position(i, current_time),
-                            0.5,
-                            vectors.get_position(i, new_time));
-          vectors.set_position(i, half_time, std::move(half_position));
         }
     };
-    do_step(parts, part_vectors);
-    do_step(surface_parts, surface_part_vectors);
+    do_step(parts, part_vectors, 0);
+    do_step(surface_parts, surface_part_vectors, n_parts());
+    marker_point_new_positions.resize(marker_points.size());
+    marker_point_half_positions.clear();
+    for (unsigned int i = 0; i < marker_points.size(); ++i)
+      {
+        AssertIndexRange(i, marker_point_half_velocities.size());
+        marker_point_new_positions[i] = marker_points[i].get_position();
+        marker_point_new_positions[i].add(dt, marker_point_half_velocities[i]);
+      }
   }
 
   template <int dim, int spacedim>
@@ -419,9 +1191,45 @@ namespace fdl
   IFEDMethodBase<dim, spacedim>::trapezoidalStep(double current_time,
                                                  double new_time)
   {
-    (void)current_time;
-    (void)new_time;
-    Assert(false, ExcFDLNotImplemented());
+    // With the velocity at the end time interpolated at the forward Euler
+    // position (as IBAMR does) this is Heun's method, i.e., SSP-RK2.
+    const double dt = new_time - current_time;
+    Assert(this->current_time == current_time, ExcFDLNotImplemented());
+    auto do_step =
+      [&](auto &collection, auto &vectors, const std::size_t offset)
+    {
+      for (unsigned int i = 0; i < collection.size(); ++i)
+        {
+          auto &part = collection[i];
+          AssertThrow(vectors.dimension == part.dimension,
+                      ExcFDLInternalError());
+          LinearAlgebra::distributed::Vector<double> new_position =
+            vectors.get_temporary_vector(i);
+          if (!part_is_active(offset + i))
+            new_position = part.get_position();
+          else
+            fused_update(new_position,
+                         part.get_position(),
+                         0.5 * dt,
+                         part.get_velocity(),
+                         0.5 * dt,
+                         &vectors.get_velocity(i, new_time));
+          vectors.set_position(i, new_time, std::move(new_position));
+        }
+    };
+    do_step(parts, part_vectors, 0);
+    do_step(surface_parts, surface_part_vectors, n_parts());
+    marker_point_new_positions.resize(marker_points.size());
+    marker_point_half_positions.clear();
+    for (unsigned int i = 0; i < marker_points.size(); ++i)
+      {
+        AssertIndexRange(i, marker_point_new_velocities.size());
+        marker_point_new_positions[i] = marker_points[i].get_position();
+        marker_point_new_positions[i].add(0.5 * dt,
+                                          marker_points[i].get_velocity(),
+                                          0.5 * dt,
+                                          marker_point_new_velocities[i]);
+      }
   }
 
   //
@@ -432,6 +1240,25 @@ namespace fdl
   void
   IFEDMethodBase<dim, spacedim>::putToDatabase(tbox::Pointer<tbox::Database> db)
   {
+    // Every processor has every marker point and these are small, so always
+    // store them in the database
+    for (unsigned int i = 0; i < marker_points.size(); ++i)
+      {
+        std::ostringstream out_str;
+        marker_points[i].write_state(out_str);
+        const std::string out = out_str.str();
+        save_binary("marker_points_" + std::to_string(i),
+                    out.c_str(),
+                    out.c_str() + out.size(),
+                    db);
+      }
+
+    if (!restart_file_directory.empty())
+      {
+        write_restart_file(db);
+        return;
+      }
+
     auto do_put = [&](auto &collection, const std::string &prefix)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
@@ -452,5 +1279,224 @@ namespace fdl
     do_put(surface_parts, "surface_part_");
   }
 
+  template <int dim, int spacedim>
+  void
+  IFEDMethodBase<dim, spacedim>::write_restart_file(
+    tbox::Pointer<tbox::Database> db)
+  {
+    const MPI_Comm     comm = IBTK::IBTK_MPI::getCommunicator();
+    const unsigned int rank = Utilities::MPI::this_mpi_process(comm);
+    // Only rank 0 creates the directory so everyone has to wait for it
+    tbox::Utilities::recursiveMkdir(restart_file_directory);
+    const int ierr = MPI_Barrier(comm);
+    AssertThrowMPI(ierr);
+
+    const std::string prefix =
+      restart_file_directory + "/" + object_name + "." +
+      Utilities::int_to_string(n_restart_files_written, 6);
+    const std::string filename =
+      prefix + "." + Utilities::int_to_string(rank, 6);
+    auto stage_states = [&](std::vector<char> &buffer)
+    {
+      if (portable_restart_files)
+        {
+          std::ostringstream out;
+          for (const auto &part : parts)
+            part.write_portable_state(out);
+          for (const auto &part : surface_parts)
+            part.write_portable_state(out);
+          const std::string states = out.str();
+          buffer.insert(buffer.end(), states.begin(), states.end());
+        }
+      else
+        {
+          for (const auto &part : parts)
+            stage_state(part, buffer);
+          for (const auto &part : surface_parts)
+            stage_state(part, buffer);
+        }
+    };
+
+    // With delta encoding the file is encoded before it is written
+    std::string encoded_state;
+    if (delta_restart_files)
+      {
+        std::vector<char> state;
+        stage_states(state);
+
+        const bool keyframe = previous_restart_state.size() != state.size() ||
+                              n_restart_deltas >= restart_keyframe_interval;
+        if (keyframe)
+          previous_restart_state.clear();
+        const std::size_t slash = previous_restart_filename.find_last_of('/');
+        encoded_state =
+          encode_restart_state(state,
+                               previous_restart_state,
+                               previous_restart_filename.substr(slash + 1));
+        n_restart_deltas          = keyframe ? 0 : n_restart_deltas + 1;
+        previous_restart_state    = std::move(state);
+        previous_restart_filename = filename;
+      }
+
+    if (asynchronous_restart_files)
+      {
+        // Copy the state into the buffer which is not being written (if any)
+        // so that we only have to wait for the previous write right before
+        // starting the next one.
+        auto &buffer = restart_buffers[n_restart_files_written % 2];
+        buffer.clear();
+        if (delta_restart_files)
+          buffer.assign(encoded_state.begin(), encoded_state.end());
+        else
+          stage_states(buffer);
+
+        if (restart_write.valid())
+          restart_write.get();
+        restart_write = std::async(
+          std::launch::async,
+          [&buffer, filename]()
+          {
+            // Write to a temporary file first so that a partially written
+            // file is never mistaken for a complete one
+            const std::string temp_filename = filename + ".tmp";
+            std::ofstream     out(temp_filename, std::ios::binary);
+            AssertThrow(out, ExcMessage("Unable to open " + temp_filename));
+            out.write(buffer.data(), buffer.size());
+            out.close();
+            AssertThrow(out, ExcMessage("Unable to write " + temp_filename));
+            const int ierr = std::rename(temp_filename.c_str(),
+                                         filename.c_str());
+            AssertThrow(ierr == 0,
+                        ExcMessage("Unable to rename " + temp_filename));
+          });
+      }
+    else
+      {
+        std::ofstream out(filename, std::ios::binary);
+        AssertThrow(out, ExcMessage("Unable to open " + filename));
+        if (delta_restart_files)
+          out.write(encoded_state.data(), encoded_state.size());
+        else if (portable_restart_files)
+          {
+            for (const auto &part : parts)
+              part.write_portable_state(out);
+            for (const auto &part : surface_parts)
+              part.write_portable_state(out);
+          }
+        else
+          {
+            for (const auto &part : parts)
+              part.write_state(out);
+            for (const auto &part : surface_parts)
+              part.write_state(out);
+          }
+        out.close();
+        AssertThrow(out, ExcMessage("Unable to write " + filename));
+      }
+
+    if (checkpoint_setup_data)
+      {
+        const std::string setup_filename =
+          prefix + ".setup." + Utilities::int_to_string(rank, 6);
+        std::ofstream out(setup_filename, std::ios::binary);
+        AssertThrow(out, ExcMessage("Unable to open " + setup_filename));
+        for (const auto &part : parts)
+          part.write_setup_data(out);
+        for (const auto &part : surface_parts)
+          part.write_setup_data(out);
+        out.close();
+        AssertThrow(out, ExcMessage("Unable to write " + setup_filename));
+      }
+
+    ++n_restart_files_written;
+    db->putString("restart_file_prefix", prefix);
+    db->putInteger("restart_file_n_processors",
+                   Utilities::MPI::n_mpi_processes(comm));
+    db->putInteger("n_restart_files_written", n_restart_files_written);
+    db->putBool("restart_file_has_setup_data", checkpoint_setup_data);
+    db->putBool("restart_file_is_delta_encoded", delta_restart_files);
+    db->putBool("restart_file_is_portable", portable_restart_files);
+  }
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethodBase<dim, spacedim>::read_restart_file(
+    tbox::Pointer<tbox::Database> db)
+  {
+    const MPI_Comm     comm    = IBTK::IBTK_MPI::getCommunicator();
+    const unsigned int rank    = Utilities::MPI::this_mpi_process(comm);
+    const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+    const int  n_old_procs = db->getInteger("restart_file_n_processors");
+    const bool portable =
+      db->getBoolWithDefault("restart_file_is_portable", false);
+    AssertThrow(portable || n_old_procs == int(n_procs),
+                ExcMessage("Restart files can only be read with the same "
+                           "number of processors with which they were "
+                           "written unless portable_restart_files is "
+                           "true."));
+
+    auto get_filename = [&](const unsigned int r)
+    {
+      return db->getString("restart_file_prefix") + "." +
+             Utilities::int_to_string(r, 6);
+    };
+    auto open_file = [&](const std::string &filename)
+    {
+      std::unique_ptr<std::istream> in;
+      if (db->getBoolWithDefault("restart_file_is_delta_encoded", false))
+        in = std::make_unique<std::istringstream>(
+          decode_restart_state(filename));
+      else
+        in = std::make_unique<std::ifstream>(filename, std::ios::binary);
+      AssertThrow(*in,
+                  ExcMessage("Unable to open restart file " + filename));
+      return in;
+    };
+
+    if (portable)
+      {
+        // Distribute the files written by the previous processors among the
+        // current ones: each part then sends its values to their owners.
+        std::vector<std::unique_ptr<std::istream>> files;
+        std::vector<std::istream *>                inputs;
+        for (unsigned int r = rank; r < static_cast<unsigned int>(n_old_procs);
+             r += n_procs)
+          {
+            files.emplace_back(open_file(get_filename(r)));
+            inputs.push_back(files.back().get());
+          }
+        for (auto &part : parts)
+          part.read_portable_state(inputs);
+        for (auto &part : surface_parts)
+          part.read_portable_state(inputs);
+      }
+    else
+      {
+        const std::unique_ptr<std::istream> in = open_file(get_filename(rank));
+        for (auto &part : parts)
+          part.read_state(*in);
+        for (auto &part : surface_parts)
+          part.read_state(*in);
+      }
+
+    // The setup data depends on the parallel data distribution, so it is only
+    // available with the same number of processors
+    if (db->getBoolWithDefault("restart_file_has_setup_data", false) &&
+        n_old_procs == int(n_procs))
+      {
+        const std::string setup_filename =
+          db->getString("restart_file_prefix") + ".setup." +
+          Utilities::int_to_string(rank, 6);
+        std::ifstream setup_in(setup_filename, std::ios::binary);
+        AssertThrow(setup_in,
+                    ExcMessage("Unable to open restart file " +
+                               setup_filename));
+        for (auto &part : parts)
+          part.read_setup_data(setup_in);
+        for (auto &part : surface_parts)
+          part.read_setup_data(setup_in);
+      }
+  }
+
   template class IFEDMethodBase<NDIM, NDIM>;
 } // namespace fdl
@@ -7,6 +7,7 @@
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 
 #include <deal.II/fe/fe_values.h>
@@ -18,7 +19,10 @@
 #include <ibtk/IndexUtilities.h>
 #include <ibtk/LEInteractor.h>
 
+#include <algorithm>
+#include <cctype>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace fdl
@@ -26,6 +30,162 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    template <int dim, int spacedim>
+    std::size_t
+    get_dof_handler_index(
+      const std::vector<SmartPointer<const DoFHandler<dim, spacedim>>>
+                                      &native_dof_handlers,
+      const DoFHandler<dim, spacedim> &native_dof_handler)
+    {
+      auto iter = std::find(native_dof_handlers.begin(),
+                            native_dof_handlers.end(),
+                            &native_dof_handler);
+      AssertThrow(iter != native_dof_handlers.end(),
+                  ExcMessage("The provided dof handler must already be "
+                             "registered with this class."));
+      return iter - native_dof_handlers.begin();
+    }
+
+    /**
+     * Determine which active cells of @p tria should interact, according to
+     * interaction_cells in @p input_db. Returns an empty vector if all cells
+     * interact.
+     */
+    template <int dim, int spacedim>
+    std::vector<bool>
+    select_interaction_cells(const tbox::Pointer<tbox::Database> &input_db,
+                             const Triangulation<dim, spacedim>  &tria)
+    {
+      std::string cells_string =
+        input_db->getStringWithDefault("interaction_cells", "ALL");
+      std::transform(cells_string.begin(),
+                     cells_string.end(),
+                     cells_string.begin(),
+                     [](const unsigned char c) { return std::tolower(c); });
+      if (cells_string == "all")
+        return {};
+
+      std::vector<bool> selected(tria.n_active_cells());
+      if (cells_string == "boundary")
+        {
+          for (const auto &cell : tria.active_cell_iterators())
+            selected[cell->active_cell_index()] = cell->at_boundary();
+        }
+      else if (cells_string == "material_ids")
+        {
+          const std::string key = "interaction_material_ids";
+          AssertThrow(input_db->keyExists(key),
+                      ExcMessage(key + " must be set in the input database "
+                                       "when interaction_cells is "
+                                       "MATERIAL_IDS."));
+          // values in SAMRAI databases are always arrays, possibly of
+          // length 1
+          std::vector<int> material_ids(input_db->getArraySize(key));
+          input_db->getIntegerArray(key,
+                                    material_ids.data(),
+                                    static_cast<int>(material_ids.size()));
+          std::sort(material_ids.begin(), material_ids.end());
+          for (const auto &cell : tria.active_cell_iterators())
+            selected[cell->active_cell_index()] =
+              std::binary_search(material_ids.begin(),
+                                 material_ids.end(),
+                                 int(cell->material_id()));
+        }
+      else
+        AssertThrow(false, ExcFDLNotImplemented());
+
+      return selected;
+    }
+
+    /**
+     * Determine whether or not two DoFHandlers on the same Triangulation use
+     * the same FE and assign the same DoFs to every cell. This function is
+     * collective.
+     */
+    template <int dim, int spacedim>
+    bool
+    have_same_dofs(const DoFHandler<dim, spacedim> &a,
+                   const DoFHandler<dim, spacedim> &b,
+                   const MPI_Comm                   communicator)
+    {
+      // These are the same on all processors
+      if (&a.get_triangulation() != &b.get_triangulation() ||
+          a.n_dofs() != b.n_dofs() ||
+          !(a.get_fe_collection() == b.get_fe_collection()))
+        return false;
+
+      bool same = a.locally_owned_dofs() == b.locally_owned_dofs();
+      std::vector<types::global_dof_index> a_dofs;
+      std::vector<types::global_dof_index> b_dofs;
+      for (const auto &a_cell : a.active_cell_iterators())
+        {
+          if (!same)
+            break;
+          if (!a_cell->is_locally_owned())
+            continue;
+          const typename DoFHandler<dim, spacedim>::active_cell_iterator
+            b_cell(&b.get_triangulation(),
+                   a_cell->level(),
+                   a_cell->index(),
+                   &b);
+          if (a_cell->active_fe_index() != b_cell->active_fe_index())
+            {
+              same = false;
+              break;
+            }
+          a_dofs.resize(a_cell->get_fe().dofs_per_cell);
+          b_dofs.resize(b_cell->get_fe().dofs_per_cell);
+          a_cell->get_dof_indices(a_dofs);
+          b_cell->get_dof_indices(b_dofs);
+          same = a_dofs == b_dofs;
+        }
+
+      return Utilities::MPI::min(int(same), communicator) == 1;
+    }
+
+    template <typename Number>
+    Scatter<Number>
+    pop_scatter(std::vector<std::vector<Scatter<Number>>>  &scatters,
+                const std::size_t                           index,
+                const std::vector<types::global_dof_index> &overlap_to_native,
+                const IndexSet                             &locally_owned_dofs,
+                const MPI_Comm                              communicator,
+                const ScatterBackend                        backend)
+    {
+      if (index >= scatters.size())
+        scatters.resize(index + 1);
+
+      std::vector<Scatter<Number>> &this_dh_scatters = scatters[index];
+      if (this_dh_scatters.size() > 0)
+        {
+          Scatter<Number> scatter = std::move(this_dh_scatters.back());
+          this_dh_scatters.pop_back();
+          return scatter;
+        }
+
+      Scatter<Number> scatter(overlap_to_native,
+                              locally_owned_dofs,
+                              communicator,
+                              backend);
+      return scatter;
+    }
+
+    template <typename Number>
+    void
+    push_scatter(std::vector<std::vector<Scatter<Number>>> &scatters,
+                 const std::size_t                          index,
+                 Scatter<Number>                          &&scatter)
+    {
+      // TODO - add some more checking here to verify that the given scatter
+      // corresponds to the given native_dof_handler
+      if (index >= scatters.size())
+        scatters.resize(index + 1);
+      scatters[index].emplace_back(std::move(scatter));
+    }
+  } // namespace
+
   std::vector<MPI_Request>
   TransactionBase::delegate_outstanding_requests()
   {
@@ -39,11 +199,20 @@ namespace fdl
     auto copy1 = position_scatter.delegate_outstanding_requests();
     auto copy2 = solution_scatter.delegate_outstanding_requests();
     auto copy3 = rhs_scatter.delegate_outstanding_requests();
+    auto copy4 = float_solution_scatter.delegate_outstanding_requests();
+    auto copy5 = float_rhs_scatter.delegate_outstanding_requests();
 
     std::vector<MPI_Request> result;
     result.insert(result.end(), copy1.begin(), copy1.end());
     result.insert(result.end(), copy2.begin(), copy2.end());
     result.insert(result.end(), copy3.begin(), copy3.end());
+    result.insert(result.end(), copy4.begin(), copy4.end());
+    result.insert(result.end(), copy5.begin(), copy5.end());
+    if (owner_check_request != MPI_REQUEST_NULL)
+      {
+        result.push_back(owner_check_request);
+        owner_check_request = MPI_REQUEST_NULL;
+      }
     return result;
   }
 
@@ -54,25 +223,59 @@ namespace fdl
     return position_scatter.delegate_outstanding_requests();
   }
 
+  template <int dim, int spacedim>
+  std::vector<MPI_Request>
+  MultiFieldTransaction<dim, spacedim>::delegate_outstanding_requests()
+  {
+    std::vector<MPI_Request> result =
+      position_scatter.delegate_outstanding_requests();
+    for (Scatter<double> &rhs_scatter : rhs_scatters)
+      {
+        const auto copy = rhs_scatter.delegate_outstanding_requests();
+        result.insert(result.end(), copy.begin(), copy.end());
+      }
+    for (Scatter<double> &solution_scatter : solution_scatters)
+      {
+        const auto copy = solution_scatter.delegate_outstanding_requests();
+        result.insert(result.end(), copy.begin(), copy.end());
+      }
+    return result;
+  }
+
   template <int dim, int spacedim>
   InteractionBase<dim, spacedim>::InteractionBase()
     : communicator(MPI_COMM_NULL)
     , level_numbers(
         {std::numeric_limits<int>::max(), std::numeric_limits<int>::max()})
+    , scatter_backend(ScatterBackend::PointToPoint)
+    , single_precision_overlap(false)
+    , workload_point_weight(1.0)
+    , workload_cell_weight(0.0)
+    , next_position_state(0)
+    , cached_position_state(0)
+    , cached_position_dof_handler(nullptr)
   {}
 
   template <int dim, int spacedim>
   InteractionBase<dim, spacedim>::InteractionBase(
     const tbox::Pointer<tbox::Database>                  &input_db,
     const parallel::shared::Triangulation<dim, spacedim> &n_tria,
-    const std::vector<BoundingBox<spacedim, float>> &global_active_cell_bboxes,
-    const std::vector<float>                        &global_active_cell_lengths,
-    tbox::Pointer<hier::PatchHierarchy<spacedim>>    p_hierarchy,
-    const std::pair<int, int>                       &l_numbers)
+    const ArrayView<const BoundingBox<spacedim, float>>
+      &global_active_cell_bboxes,
+    const ArrayView<const float>                  &global_active_cell_lengths,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>>  p_hierarchy,
+    const std::pair<int, int>                     &l_numbers)
     : communicator(MPI_COMM_NULL)
     , native_tria(&n_tria)
     , patch_hierarchy(p_hierarchy)
     , level_numbers(l_numbers)
+    , scatter_backend(ScatterBackend::PointToPoint)
+    , single_precision_overlap(false)
+    , workload_point_weight(1.0)
+    , workload_cell_weight(0.0)
+    , next_position_state(0)
+    , cached_position_state(0)
+    , cached_position_dof_handler(nullptr)
   {
     reinit(input_db,
            n_tria,
@@ -89,8 +292,9 @@ namespace fdl
   InteractionBase<dim, spacedim>::reinit(
     const tbox::Pointer<tbox::Database>                  &input_db,
     const parallel::shared::Triangulation<dim, spacedim> &n_tria,
-    const std::vector<BoundingBox<spacedim, float>> &global_active_cell_bboxes,
-    const std::vector<float> & /*global_active_cell_lengths*/,
+    const ArrayView<const BoundingBox<spacedim, float>>
+      &global_active_cell_bboxes,
+    const ArrayView<const float> & /*global_active_cell_lengths*/,
     tbox::Pointer<hier::PatchHierarchy<spacedim>> p_hierarchy,
     const std::pair<int, int>                    &l_numbers)
   {
@@ -119,8 +323,12 @@ namespace fdl
     patch_hierarchy = p_hierarchy;
     level_numbers   = l_numbers;
 
+    const bool distributed_bbox_exchange =
+      input_db->getBoolWithDefault("distributed_bbox_exchange", false);
+
     // Check inputs
-    Assert(global_active_cell_bboxes.size() == native_tria->n_active_cells(),
+    Assert(distributed_bbox_exchange ||
+             global_active_cell_bboxes.size() == native_tria->n_active_cells(),
            ExcMessage("There should be a bounding box for each active cell"));
     Assert(patch_hierarchy,
            ExcMessage("The provided pointer to a patch hierarchy should not be "
@@ -129,11 +337,56 @@ namespace fdl
            ExcMessage("The coarser level number should be first"));
     AssertIndexRange(l_numbers.second, patch_hierarchy->getNumberOfLevels());
 
-    // clear old dof info
+    // Keep the old dof info around: if the overlap triangulation does not
+    // change then add_dof_handler() can reuse it
+    previous_native_dof_handlers  = std::move(native_dof_handlers);
+    previous_overlap_dof_indices  = std::move(overlap_dof_indices);
+    previous_overlap_dof_handlers = std::move(overlap_dof_handlers);
+    previous_overlap_to_native_dof_translations =
+      std::move(overlap_to_native_dof_translations);
+    previous_scatters       = std::move(scatters);
+    previous_float_scatters = std::move(float_scatters);
     native_dof_handlers.clear();
+    overlap_dof_indices.clear();
     overlap_dof_handlers.clear();
     overlap_to_native_dof_translations.clear();
     scatters.clear();
+    float_scatters.clear();
+    transactions.clear();
+    // The overlap DoFs may change so we cannot reuse the position
+    next_position_state         = 0;
+    cached_position_state       = 0;
+    cached_position_dof_handler = nullptr;
+    single_precision_overlap =
+      input_db->getBoolWithDefault("single_precision_overlap", false);
+    workload_point_weight =
+      input_db->getDoubleWithDefault("workload_point_weight", 1.0);
+    workload_cell_weight =
+      input_db->getDoubleWithDefault("workload_cell_weight", 0.0);
+    AssertThrow(workload_point_weight >= 0.0 && workload_cell_weight >= 0.0,
+                ExcMessage("Workload weights should be nonnegative."));
+    {
+      const ScatterBackend old_scatter_backend = scatter_backend;
+      std::string          backend_string =
+        input_db->getStringWithDefault("scatter_backend", "POINT_TO_POINT");
+      std::transform(backend_string.begin(),
+                     backend_string.end(),
+                     backend_string.begin(),
+                     [](const unsigned char c) { return std::tolower(c); });
+      if (backend_string == "point_to_point")
+        scatter_backend = ScatterBackend::PointToPoint;
+      else if (backend_string == "persistent")
+        scatter_backend = ScatterBackend::Persistent;
+      else if (backend_string == "neighbor_collective")
+        scatter_backend = ScatterBackend::NeighborCollective;
+      else
+        AssertThrow(false, ExcFDLNotImplemented());
+      if (scatter_backend != old_scatter_backend)
+        {
+          previous_scatters.clear();
+          previous_float_scatters.clear();
+        }
+    }
 
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
     for (int ln = level_numbers.first; ln <= level_numbers.second; ++ln)
@@ -148,10 +401,96 @@ namespace fdl
       compute_patch_bboxes(patches,
                            input_db->getDoubleWithDefault("ghost_cell_fraction",
                                                           1.0));
-    BoxIntersectionPredicate<dim, spacedim> predicate(global_active_cell_bboxes,
-                                                      patch_bboxes,
-                                                      *native_tria);
-    overlap_tria.reinit(*native_tria, predicate);
+    const std::vector<bool> selected_cells =
+      select_interaction_cells(input_db, *native_tria);
+    const auto reinit_overlap_tria =
+      [&](const IntersectionPredicate<dim, spacedim> &all_cells_predicate)
+    {
+      std::unique_ptr<IntersectionPredicate<dim, spacedim>> subset_predicate;
+      if (selected_cells.size() > 0)
+        subset_predicate =
+          std::make_unique<SubsetIntersectionPredicate<dim, spacedim>>(
+            all_cells_predicate, selected_cells, *native_tria);
+      const IntersectionPredicate<dim, spacedim> &predicate =
+        subset_predicate ? *subset_predicate : all_cells_predicate;
+
+      const bool rebuild = overlap_tria.select_cells(*native_tria, predicate);
+      // Computing DoF translations is collective. Since each processor
+      // requests DoFs from the others we can only reuse them if no overlap
+      // triangulation changed.
+      if (Utilities::MPI::max(int(rebuild), communicator) == 1)
+        {
+          // The old overlap DoFHandlers must be destroyed before the
+          // triangulation is cleared
+          previous_native_dof_handlers.clear();
+          previous_overlap_dof_indices.clear();
+          previous_overlap_dof_handlers.clear();
+          previous_overlap_to_native_dof_translations.clear();
+          previous_scatters.clear();
+          previous_float_scatters.clear();
+          overlap_cell_exchange.reset();
+          if (rebuild)
+            overlap_tria.rebuild(predicate);
+        }
+    };
+
+    overlap_active_cell_bboxes.clear();
+    if (distributed_bbox_exchange)
+      {
+        // Only look up the bounding boxes we own so that, once the native
+        // triangulation is no longer replicated, the global array is no
+        // longer necessary
+        std::vector<BoundingBox<spacedim, float>> local_active_cell_bboxes;
+        for (const auto &cell : native_tria->active_cell_iterators())
+          if (cell->is_locally_owned())
+            {
+              AssertIndexRange(cell->active_cell_index(),
+                               global_active_cell_bboxes.size());
+              local_active_cell_bboxes.push_back(
+                global_active_cell_bboxes[cell->active_cell_index()]);
+            }
+        const auto cell_ids_and_bboxes =
+          exchange_intersecting_active_cell_bboxes(*native_tria,
+                                                   local_active_cell_bboxes,
+                                                   patch_bboxes,
+                                                   communicator);
+        std::vector<CellId> cell_ids;
+        for (const auto &pair : cell_ids_and_bboxes)
+          cell_ids.push_back(pair.first);
+        CellIdIntersectionPredicate<dim, spacedim> predicate(cell_ids,
+                                                             *native_tria);
+        reinit_overlap_tria(predicate);
+
+        // Both arrays are sorted by CellId
+        overlap_active_cell_bboxes.reserve(overlap_tria.n_active_cells());
+        for (const auto &cell : overlap_tria.active_cell_iterators())
+          {
+            // Artificial cells do not intersect anything, so they have no
+            // bounding boxes
+            if (cell->is_artificial())
+              {
+                overlap_active_cell_bboxes.emplace_back();
+                continue;
+              }
+            const CellId cell_id = overlap_tria.get_native_cell_id(cell);
+            const auto   it      = std::lower_bound(
+              cell_ids_and_bboxes.begin(),
+              cell_ids_and_bboxes.end(),
+              cell_id,
+              [](const auto &pair, const CellId &id) {
+                return pair.first < id;
+              });
+            Assert(it != cell_ids_and_bboxes.end() && it->first == cell_id,
+                   ExcFDLInternalError());
+            overlap_active_cell_bboxes.push_back(it->second);
+          }
+      }
+    else
+      {
+        BoxIntersectionPredicate<dim, spacedim> predicate(
+          global_active_cell_bboxes, patch_bboxes, *native_tria);
+        reinit_overlap_tria(predicate);
+      }
   }
 
 
@@ -166,6 +505,101 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  const OverlapCellExchange &
+  InteractionBase<dim, spacedim>::get_overlap_cell_exchange()
+  {
+    if (!overlap_cell_exchange)
+      overlap_cell_exchange = std::make_unique<OverlapCellExchange>(
+        compute_overlap_cell_exchange(overlap_tria));
+    return *overlap_cell_exchange;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::reuse_previous_dof_handler(
+    const DoFHandler<dim, spacedim> &native_dof_handler)
+  {
+    const auto find_previous = [&](const DoFHandler<dim, spacedim> *ptr)
+    {
+      return std::find(previous_native_dof_handlers.begin(),
+                       previous_native_dof_handlers.end(),
+                       ptr) -
+             previous_native_dof_handlers.begin();
+    };
+    const std::size_t previous_native_index =
+      find_previous(&native_dof_handler);
+    if (previous_native_index == previous_native_dof_handlers.size())
+      return false;
+    AssertIndexRange(previous_native_index,
+                     previous_overlap_dof_indices.size());
+    const std::size_t previous_index =
+      previous_overlap_dof_indices[previous_native_index];
+    AssertIndexRange(previous_index, previous_overlap_dof_handlers.size());
+    native_dof_handlers.emplace_back(&native_dof_handler);
+
+    // If the overlap data was shared with another DoFHandler which we already
+    // reused then share it again
+    if (!previous_overlap_dof_handlers[previous_index])
+      {
+        for (std::size_t i = 0; i + 1 < native_dof_handlers.size(); ++i)
+          {
+            const std::size_t other = find_previous(native_dof_handlers[i]);
+            if (other < previous_overlap_dof_indices.size() &&
+                previous_overlap_dof_indices[other] == previous_index)
+              {
+                overlap_dof_indices.push_back(overlap_dof_indices[i]);
+                return true;
+              }
+          }
+        Assert(false, ExcFDLInternalError());
+      }
+
+    const std::size_t index = overlap_dof_handlers.size();
+    overlap_dof_indices.push_back(index);
+    overlap_dof_handlers.emplace_back(
+      std::move(previous_overlap_dof_handlers[previous_index]));
+    overlap_to_native_dof_translations.emplace_back(
+      std::move(previous_overlap_to_native_dof_translations[previous_index]));
+
+    const auto reuse_scatters = [&](auto &old_scatters, auto &new_scatters)
+    {
+      if (previous_index < old_scatters.size())
+        {
+          if (index >= new_scatters.size())
+            new_scatters.resize(index + 1);
+          new_scatters[index] = std::move(old_scatters[previous_index]);
+        }
+    };
+    reuse_scatters(previous_scatters, scatters);
+    reuse_scatters(previous_float_scatters, float_scatters);
+
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::share_overlap_dof_handler(
+    const DoFHandler<dim, spacedim> &native_dof_handler)
+  {
+    for (std::size_t i = 0; i < native_dof_handlers.size(); ++i)
+      if (have_same_dofs(*native_dof_handlers[i],
+                         native_dof_handler,
+                         communicator))
+        {
+          native_dof_handlers.emplace_back(&native_dof_handler);
+          overlap_dof_indices.push_back(overlap_dof_indices[i]);
+          return true;
+        }
+    return false;
+  }
+
+
+
   template <int dim, int spacedim>
   DoFHandler<dim, spacedim> &
   InteractionBase<dim, spacedim>::get_overlap_dof_handler(
@@ -177,7 +611,8 @@ namespace fdl
     AssertThrow(iter != native_dof_handlers.end(),
                 ExcMessage("The provided dof handler must already be "
                            "registered with this class."));
-    return *overlap_dof_handlers[iter - native_dof_handlers.begin()];
+    const std::size_t index = iter - native_dof_handlers.begin();
+    return *overlap_dof_handlers[overlap_dof_indices[index]];
   }
 
 
@@ -193,7 +628,8 @@ namespace fdl
     AssertThrow(iter != native_dof_handlers.end(),
                 ExcMessage("The provided dof handler must already be "
                            "registered with this class."));
-    return *overlap_dof_handlers[iter - native_dof_handlers.begin()];
+    const std::size_t index = iter - native_dof_handlers.begin();
+    return *overlap_dof_handlers[overlap_dof_indices[index]];
   }
 
 
@@ -212,31 +648,49 @@ namespace fdl
   InteractionBase<dim, spacedim>::get_scatter(
     const DoFHandler<dim, spacedim> &native_dof_handler)
   {
-    auto iter = std::find(native_dof_handlers.begin(),
-                          native_dof_handlers.end(),
-                          &native_dof_handler);
-    AssertThrow(iter != native_dof_handlers.end(),
-                ExcMessage("The provided dof handler must already be "
-                           "registered with this class."));
+    const std::size_t index = overlap_dof_indices[get_dof_handler_index(
+      native_dof_handlers, native_dof_handler)];
+    Assert(index < overlap_to_native_dof_translations.size(),
+           ExcFDLInternalError());
+    return pop_scatter(scatters,
+                       index,
+                       overlap_to_native_dof_translations[index],
+                       native_dof_handler.locally_owned_dofs(),
+                       communicator,
+                       scatter_backend);
+  }
 
-    const std::size_t index = iter - native_dof_handlers.begin();
-    if (index >= scatters.size())
-      scatters.resize(index + 1);
 
-    std::vector<Scatter<double>> &this_dh_scatters = scatters[index];
-    if (this_dh_scatters.size() > 0)
-      {
-        Scatter<double> scatter = std::move(this_dh_scatters.back());
-        this_dh_scatters.pop_back();
-        return scatter;
-      }
 
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::return_scatter(
+    const DoFHandler<dim, spacedim> &native_dof_handler,
+    Scatter<double>                &&scatter)
+  {
+    push_scatter(scatters,
+                 overlap_dof_indices[get_dof_handler_index(
+                   native_dof_handlers, native_dof_handler)],
+                 std::move(scatter));
+  }
+
+
+
+  template <int dim, int spacedim>
+  Scatter<float>
+  InteractionBase<dim, spacedim>::get_float_scatter(
+    const DoFHandler<dim, spacedim> &native_dof_handler)
+  {
+    const std::size_t index = overlap_dof_indices[get_dof_handler_index(
+      native_dof_handlers, native_dof_handler)];
     Assert(index < overlap_to_native_dof_translations.size(),
            ExcFDLInternalError());
-    Scatter<double> scatter(overlap_to_native_dof_translations[index],
-                            native_dof_handler.locally_owned_dofs(),
-                            communicator);
-    return scatter;
+    return pop_scatter(float_scatters,
+                       index,
+                       overlap_to_native_dof_translations[index],
+                       native_dof_handler.locally_owned_dofs(),
+                       communicator,
+                       scatter_backend);
   }
 
 
@@ -245,22 +699,111 @@ namespace fdl
   void
   InteractionBase<dim, spacedim>::return_scatter(
     const DoFHandler<dim, spacedim> &native_dof_handler,
-    Scatter<double>                &&scatter)
+    Scatter<float>                 &&scatter)
   {
-    auto iter = std::find(native_dof_handlers.begin(),
-                          native_dof_handlers.end(),
-                          &native_dof_handler);
-    AssertThrow(iter != native_dof_handlers.end(),
-                ExcMessage("The provided dof handler must already be "
-                           "registered with this class."));
+    push_scatter(float_scatters,
+                 overlap_dof_indices[get_dof_handler_index(
+                   native_dof_handlers, native_dof_handler)],
+                 std::move(scatter));
+  }
 
-    // TODO - add some more checking here to verify that the given scatter
-    // corresponds to the given native_dof_handler
-    const std::size_t index = iter - native_dof_handlers.begin();
-    if (index >= scatters.size())
-      scatters.resize(index + 1);
-    std::vector<Scatter<double>> &this_dh_scatters = scatters[index];
-    this_dh_scatters.emplace_back(std::move(scatter));
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::set_position_state(
+    const std::uint64_t position_state)
+  {
+    next_position_state = position_state;
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename TransactionType>
+  void
+  InteractionBase<dim, spacedim>::start_position_scatter(
+    TransactionType &transaction)
+  {
+    transaction.position_state = next_position_state;
+    next_position_state        = 0;
+    transaction.position_is_cached =
+      transaction.position_state != 0 &&
+      transaction.position_state == cached_position_state &&
+      transaction.native_position_dof_handler == cached_position_dof_handler;
+
+    if (transaction.position_is_cached)
+      transaction.overlap_position = cached_overlap_position;
+    else
+      transaction.position_scatter.global_to_overlap_start(
+        *transaction.native_position, 0, transaction.overlap_position);
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename TransactionType>
+  void
+  InteractionBase<dim, spacedim>::finish_position_scatter(
+    TransactionType &transaction) const
+  {
+    if (transaction.position_is_cached)
+      return;
+
+    transaction.position_scatter.global_to_overlap_finish(
+      *transaction.native_position, transaction.overlap_position);
+    if (transaction.position_state != 0)
+      {
+        cached_position_state       = transaction.position_state;
+        cached_position_dof_handler = transaction.native_position_dof_handler;
+        cached_overlap_position     = transaction.overlap_position;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::unique_ptr<Transaction<dim, spacedim>>
+  InteractionBase<dim, spacedim>::get_transaction()
+  {
+    if (transactions.size() == 0)
+      return std::make_unique<Transaction<dim, spacedim>>();
+
+    std::unique_ptr<Transaction<dim, spacedim>> t_ptr =
+      std::move(transactions.back());
+    transactions.pop_back();
+    return t_ptr;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::return_transaction(
+    std::unique_ptr<TransactionBase> t_ptr)
+  {
+    auto *trans = dynamic_cast<Transaction<dim, spacedim> *>(t_ptr.get());
+    if (!trans)
+      return;
+
+    // Don't keep subscriptions to objects the caller may destroy
+    trans->native_position_dof_handler = nullptr;
+    trans->native_position             = nullptr;
+    trans->native_dof_handler          = nullptr;
+    trans->mapping                     = nullptr;
+    trans->native_rhs                  = nullptr;
+    trans->native_solution             = nullptr;
+    transactions.emplace_back(
+      static_cast<Transaction<dim, spacedim> *>(t_ptr.release()));
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::use_single_precision() const
+  {
+    return single_precision_overlap && supports_single_precision();
   }
 
 
@@ -276,9 +819,12 @@ namespace fdl
     const auto ptr = &native_dof_handler;
     if (std::find(native_dof_handlers.begin(),
                   native_dof_handlers.end(),
-                  ptr) == native_dof_handlers.end())
+                  ptr) == native_dof_handlers.end() &&
+        !reuse_previous_dof_handler(native_dof_handler) &&
+        !share_overlap_dof_handler(native_dof_handler))
       {
         native_dof_handlers.emplace_back(ptr);
+        overlap_dof_indices.push_back(overlap_dof_handlers.size());
         // TODO - implement a move ctor for DH in deal.II
         overlap_dof_handlers.emplace_back(
           std::make_unique<DoFHandler<dim, spacedim>>(overlap_tria));
@@ -288,6 +834,7 @@ namespace fdl
 
         std::vector<types::global_dof_index> overlap_to_native_dofs =
           compute_overlap_to_native_dof_translation(overlap_tria,
+                                                    get_overlap_cell_exchange(),
                                                     overlap_dof_handler,
                                                     native_dof_handler);
         overlap_to_native_dof_translations.emplace_back(
@@ -306,6 +853,15 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::spreads_weak_force() const
+  {
+    return false;
+  }
+
+
+
   template <int dim, int spacedim>
   std::unique_ptr<TransactionBase>
   InteractionBase<dim, spacedim>::compute_projection_rhs_scatter_start(
@@ -337,7 +893,7 @@ namespace fdl
     }
 #endif
 
-    auto t_ptr = std::make_unique<Transaction<dim, spacedim>>();
+    auto t_ptr = get_transaction();
 
     Transaction<dim, spacedim> &transaction = *t_ptr;
     // set up everything we will need later
@@ -355,9 +911,20 @@ namespace fdl
     transaction.native_dof_handler = &dof_handler;
     transaction.mapping            = &mapping;
     transaction.native_rhs         = &rhs;
-    transaction.overlap_rhs.reinit(
-      get_overlap_dof_handler(dof_handler).n_dofs());
-    transaction.rhs_scatter         = get_scatter(dof_handler);
+    transaction.single_precision   = use_single_precision();
+    if (transaction.single_precision)
+      {
+        transaction.float_native_vector.reinit(rhs.get_partitioner());
+        transaction.float_overlap_rhs.reinit(
+          get_overlap_dof_handler(dof_handler).n_dofs());
+        transaction.float_rhs_scatter = get_float_scatter(dof_handler);
+      }
+    else
+      {
+        transaction.overlap_rhs.reinit(
+          get_overlap_dof_handler(dof_handler).n_dofs());
+        transaction.rhs_scatter = get_scatter(dof_handler);
+      }
     transaction.rhs_scatter_back_op = this->get_rhs_scatter_type();
 
     // Setup state:
@@ -365,19 +932,115 @@ namespace fdl
     transaction.operation =
       Transaction<dim, spacedim>::Operation::Interpolation;
 
-    transaction.position_scatter.global_to_overlap_start(
-      *transaction.native_position, 0, transaction.overlap_position);
+    start_position_scatter(transaction);
 
     return t_ptr;
   }
 
 
 
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  InteractionBase<dim, spacedim>::compute_projection_rhs_scatter_start(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    const DoFHandler<dim, spacedim>                      &position_dof_handler,
+    const LinearAlgebra::distributed::Vector<double>     &position,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &rhs)
+  {
+    AssertThrow(supports_multiple_fields(),
+                ExcMessage("This interaction class does not support computing "
+                           "multiple projections in one transaction."));
+    const std::size_t n_fields = data_indices.size();
+    AssertThrow(dof_handlers.size() == n_fields &&
+                  mappings.size() == n_fields && rhs.size() == n_fields,
+                ExcMessage("Each field requires a data index, DoFHandler, "
+                           "Mapping, and rhs vector."));
+    AssertThrow(n_fields > 0, ExcMessage("At least one field is required."));
+
+    auto t_ptr = std::make_unique<MultiFieldTransaction<dim, spacedim>>();
+
+    MultiFieldTransaction<dim, spacedim> &transaction = *t_ptr;
+    transaction.kernel_name  = kernel_name;
+    transaction.data_indices = data_indices;
+
+    // Setup position info:
+    transaction.native_position_dof_handler = &position_dof_handler;
+    transaction.native_position             = &position;
+    transaction.overlap_position.reinit(
+      get_overlap_dof_handler(position_dof_handler).n_dofs());
+    transaction.position_scatter = get_scatter(position_dof_handler);
+
+    // Setup rhs info. Since MPI will write into the scatters we must size
+    // these arrays before starting any communication.
+    transaction.overlap_rhs.resize(n_fields);
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      {
+        Assert(dof_handlers[field_n] && mappings[field_n] && rhs[field_n],
+               ExcMessage("pointers should not be nullptr"));
+        transaction.native_dof_handlers.emplace_back(dof_handlers[field_n]);
+        transaction.mappings.emplace_back(mappings[field_n]);
+        transaction.native_rhs.emplace_back(rhs[field_n]);
+        transaction.overlap_rhs[field_n].reinit(
+          get_overlap_dof_handler(*dof_handlers[field_n]).n_dofs());
+        transaction.rhs_scatters.emplace_back(
+          get_scatter(*dof_handlers[field_n]));
+      }
+    transaction.rhs_scatter_back_op = this->get_rhs_scatter_type();
+
+    // Setup state:
+    transaction.next_state =
+      MultiFieldTransaction<dim, spacedim>::State::ScatterFinish;
+    transaction.operation =
+      MultiFieldTransaction<dim, spacedim>::Operation::Interpolation;
+
+    start_position_scatter(transaction);
+
+    return t_ptr;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::supports_multiple_fields() const
+  {
+    return false;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::supports_single_precision() const
+  {
+    return false;
+  }
+
+
+
   template <int dim, int spacedim>
   std::unique_ptr<TransactionBase>
   InteractionBase<dim, spacedim>::compute_projection_rhs_scatter_finish(
     std::unique_ptr<TransactionBase> t_ptr) const
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Interpolation),
+               ExcMessage("Transaction operation should be Interpolation"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::ScatterFinish),
+               ExcMessage("Transaction state should be ScatterFinish"));
+        finish_position_scatter(*multi_trans);
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::Intermediate;
+        return t_ptr;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Interpolation),
@@ -386,8 +1049,7 @@ namespace fdl
             Transaction<dim, spacedim>::State::ScatterFinish),
            ExcMessage("Transaction state should be ScatterFinish"));
 
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
+    finish_position_scatter(trans);
 
     trans.next_state = Transaction<dim, spacedim>::State::Intermediate;
 
@@ -401,6 +1063,20 @@ namespace fdl
   InteractionBase<dim, spacedim>::compute_projection_rhs_intermediate(
     std::unique_ptr<TransactionBase> t_ptr) const
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Interpolation),
+               ExcMessage("Transaction operation should be Interpolation"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::Intermediate),
+               ExcMessage("Transaction state should be Intermediate"));
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::AccumulateStart;
+        return t_ptr;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Interpolation),
@@ -423,6 +1099,30 @@ namespace fdl
   InteractionBase<dim, spacedim>::compute_projection_rhs_accumulate_start(
     std::unique_ptr<TransactionBase> t_ptr) const
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Interpolation),
+               ExcMessage("Transaction operation should be Interpolation"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::AccumulateStart),
+               ExcMessage("Transaction state should be AccumulateStart"));
+        // All of these scatters are active simultaneously on the same
+        // communicator so give each one its own channel
+        for (std::size_t field_n = 0;
+             field_n < multi_trans->rhs_scatters.size();
+             ++field_n)
+          multi_trans->rhs_scatters[field_n].overlap_to_global_start(
+            multi_trans->overlap_rhs[field_n],
+            multi_trans->rhs_scatter_back_op,
+            field_n,
+            *multi_trans->native_rhs[field_n]);
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::AccumulateFinish;
+        return t_ptr;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Interpolation),
@@ -433,10 +1133,17 @@ namespace fdl
 
     // This object cannot get here without the first scatter finishing so using
     // channel 0 again is fine
-    trans.rhs_scatter.overlap_to_global_start(trans.overlap_rhs,
-                                              trans.rhs_scatter_back_op,
-                                              0,
-                                              *trans.native_rhs);
+    if (trans.single_precision)
+      trans.float_rhs_scatter.overlap_to_global_start(
+        trans.float_overlap_rhs,
+        trans.rhs_scatter_back_op,
+        0,
+        trans.float_native_vector);
+    else
+      trans.rhs_scatter.overlap_to_global_start(trans.overlap_rhs,
+                                                trans.rhs_scatter_back_op,
+                                                0,
+                                                *trans.native_rhs);
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateFinish;
 
@@ -450,6 +1157,33 @@ namespace fdl
   InteractionBase<dim, spacedim>::compute_projection_rhs_accumulate_finish(
     std::unique_ptr<TransactionBase> t_ptr)
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Interpolation),
+               ExcMessage("Transaction operation should be Interpolation"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::AccumulateFinish),
+               ExcMessage("Transaction state should be AccumulateFinish"));
+        for (std::size_t field_n = 0;
+             field_n < multi_trans->rhs_scatters.size();
+             ++field_n)
+          {
+            multi_trans->rhs_scatters[field_n].overlap_to_global_finish(
+              multi_trans->overlap_rhs[field_n],
+              multi_trans->rhs_scatter_back_op,
+              *multi_trans->native_rhs[field_n]);
+            return_scatter(*multi_trans->native_dof_handlers[field_n],
+                           std::move(multi_trans->rhs_scatters[field_n]));
+          }
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::Done;
+        return_scatter(*multi_trans->native_position_dof_handler,
+                       std::move(multi_trans->position_scatter));
+        return;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Interpolation),
@@ -458,14 +1192,28 @@ namespace fdl
             Transaction<dim, spacedim>::State::AccumulateFinish),
            ExcMessage("Transaction state should be AccumulateFinish"));
 
-    trans.rhs_scatter.overlap_to_global_finish(trans.overlap_rhs,
-                                               trans.rhs_scatter_back_op,
-                                               *trans.native_rhs);
+    if (trans.single_precision)
+      {
+        trans.float_rhs_scatter.overlap_to_global_finish(
+          trans.float_overlap_rhs,
+          trans.rhs_scatter_back_op,
+          trans.float_native_vector);
+        *trans.native_rhs = trans.float_native_vector;
+      }
+    else
+      trans.rhs_scatter.overlap_to_global_finish(trans.overlap_rhs,
+                                                 trans.rhs_scatter_back_op,
+                                                 *trans.native_rhs);
     trans.next_state = Transaction<dim, spacedim>::State::Done;
 
     return_scatter(*trans.native_position_dof_handler,
                    std::move(trans.position_scatter));
-    return_scatter(*trans.native_dof_handler, std::move(trans.rhs_scatter));
+    if (trans.single_precision)
+      return_scatter(*trans.native_dof_handler,
+                     std::move(trans.float_rhs_scatter));
+    else
+      return_scatter(*trans.native_dof_handler, std::move(trans.rhs_scatter));
+    return_transaction(std::move(t_ptr));
   }
 
 
@@ -503,7 +1251,7 @@ namespace fdl
     }
 #endif
 
-    auto t_ptr = std::make_unique<Transaction<dim, spacedim>>();
+    auto t_ptr = get_transaction();
 
     Transaction<dim, spacedim> &transaction = *t_ptr;
     // set up everything we will need later
@@ -519,11 +1267,23 @@ namespace fdl
 
     // Setup solution info:
     transaction.native_dof_handler = &dof_handler;
-    transaction.solution_scatter   = get_scatter(dof_handler);
     transaction.mapping            = &mapping;
     transaction.native_solution    = &solution;
-    transaction.overlap_solution.reinit(
-      get_overlap_dof_handler(dof_handler).n_dofs());
+    transaction.single_precision   = use_single_precision();
+    if (transaction.single_precision)
+      {
+        transaction.float_solution_scatter = get_float_scatter(dof_handler);
+        transaction.float_native_vector.reinit(solution.get_partitioner());
+        transaction.float_native_vector = solution;
+        transaction.float_overlap_solution.reinit(
+          get_overlap_dof_handler(dof_handler).n_dofs());
+      }
+    else
+      {
+        transaction.solution_scatter = get_scatter(dof_handler);
+        transaction.overlap_solution.reinit(
+          get_overlap_dof_handler(dof_handler).n_dofs());
+      }
 
     // Setup state:
     transaction.next_state = Transaction<dim, spacedim>::State::ScatterFinish;
@@ -533,11 +1293,88 @@ namespace fdl
 
     // Since we set up our own communicator in this object we can fearlessly use
     // channels 0 and 1 to guarantee traffic is not accidentally mingled
-    transaction.position_scatter.global_to_overlap_start(
-      *transaction.native_position, 0, transaction.overlap_position);
+    start_position_scatter(transaction);
 
-    transaction.solution_scatter.global_to_overlap_start(
-      *transaction.native_solution, 1, transaction.overlap_solution);
+    if (transaction.single_precision)
+      transaction.float_solution_scatter.global_to_overlap_start(
+        transaction.float_native_vector,
+        1,
+        transaction.float_overlap_solution);
+    else
+      transaction.solution_scatter.global_to_overlap_start(
+        *transaction.native_solution, 1, transaction.overlap_solution);
+
+    return t_ptr;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  InteractionBase<dim, spacedim>::compute_spread_scatter_start(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    const LinearAlgebra::distributed::Vector<double>     &position,
+    const DoFHandler<dim, spacedim>                      &position_dof_handler,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &solutions)
+  {
+    AssertThrow(supports_multiple_fields(),
+                ExcMessage("This interaction class does not support spreading "
+                           "multiple fields in one transaction."));
+    const std::size_t n_fields = data_indices.size();
+    AssertThrow(dof_handlers.size() == n_fields &&
+                  mappings.size() == n_fields && solutions.size() == n_fields,
+                ExcMessage("Each field requires a data index, DoFHandler, "
+                           "Mapping, and solution vector."));
+    AssertThrow(n_fields > 0, ExcMessage("At least one field is required."));
+
+    auto t_ptr = std::make_unique<MultiFieldTransaction<dim, spacedim>>();
+
+    MultiFieldTransaction<dim, spacedim> &transaction = *t_ptr;
+    transaction.kernel_name  = kernel_name;
+    transaction.data_indices = data_indices;
+
+    // Setup position info:
+    transaction.native_position_dof_handler = &position_dof_handler;
+    transaction.native_position             = &position;
+    transaction.overlap_position.reinit(
+      get_overlap_dof_handler(position_dof_handler).n_dofs());
+    transaction.position_scatter = get_scatter(position_dof_handler);
+
+    // Setup solution info. Since MPI will write into the overlap vectors we
+    // must size these arrays before starting any communication.
+    transaction.overlap_solutions.resize(n_fields);
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      {
+        Assert(dof_handlers[field_n] && mappings[field_n] &&
+                 solutions[field_n],
+               ExcMessage("pointers should not be nullptr"));
+        transaction.native_dof_handlers.emplace_back(dof_handlers[field_n]);
+        transaction.mappings.emplace_back(mappings[field_n]);
+        transaction.native_solutions.emplace_back(solutions[field_n]);
+        transaction.overlap_solutions[field_n].reinit(
+          get_overlap_dof_handler(*dof_handlers[field_n]).n_dofs());
+        transaction.solution_scatters.emplace_back(
+          get_scatter(*dof_handlers[field_n]));
+      }
+
+    // Setup state:
+    transaction.next_state =
+      MultiFieldTransaction<dim, spacedim>::State::ScatterFinish;
+    transaction.operation =
+      MultiFieldTransaction<dim, spacedim>::Operation::Spreading;
+
+    // As with a single field, the position uses channel 0. All of the other
+    // scatters are active simultaneously so give each one its own channel.
+    start_position_scatter(transaction);
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      transaction.solution_scatters[field_n].global_to_overlap_start(
+        *transaction.native_solutions[field_n],
+        field_n + 1,
+        transaction.overlap_solutions[field_n]);
 
     return t_ptr;
   }
@@ -549,6 +1386,27 @@ namespace fdl
   InteractionBase<dim, spacedim>::compute_spread_scatter_finish(
     std::unique_ptr<TransactionBase> t_ptr) const
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Spreading),
+               ExcMessage("Transaction operation should be Spreading"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::ScatterFinish),
+               ExcMessage("Transaction state should be ScatterFinish"));
+        finish_position_scatter(*multi_trans);
+        for (std::size_t field_n = 0;
+             field_n < multi_trans->solution_scatters.size();
+             ++field_n)
+          multi_trans->solution_scatters[field_n].global_to_overlap_finish(
+            *multi_trans->native_solutions[field_n],
+            multi_trans->overlap_solutions[field_n]);
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::Intermediate;
+        return t_ptr;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Spreading),
@@ -557,10 +1415,13 @@ namespace fdl
             Transaction<dim, spacedim>::State::ScatterFinish),
            ExcMessage("Transaction state should be Intermediate"));
 
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
-    trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
-                                                    trans.overlap_solution);
+    finish_position_scatter(trans);
+    if (trans.single_precision)
+      trans.float_solution_scatter.global_to_overlap_finish(
+        trans.float_native_vector, trans.float_overlap_solution);
+    else
+      trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
+                                                      trans.overlap_solution);
 
     trans.next_state = Transaction<dim, spacedim>::State::Intermediate;
 
@@ -574,6 +1435,20 @@ namespace fdl
   InteractionBase<dim, spacedim>::compute_spread_intermediate(
     std::unique_ptr<TransactionBase> t_ptr)
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Spreading),
+               ExcMessage("Transaction operation should be Spreading"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::Intermediate),
+               ExcMessage("Transaction state should be Intermediate"));
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::AccumulateFinish;
+        return t_ptr;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Spreading),
@@ -582,8 +1457,7 @@ namespace fdl
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
 
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
+    finish_position_scatter(trans);
     trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
                                                     trans.overlap_solution);
 
@@ -601,6 +1475,27 @@ namespace fdl
   InteractionBase<dim, spacedim>::compute_spread_finish(
     std::unique_ptr<TransactionBase> t_ptr)
   {
+    if (auto *multi_trans =
+          dynamic_cast<MultiFieldTransaction<dim, spacedim> *>(t_ptr.get()))
+      {
+        Assert((multi_trans->operation ==
+                MultiFieldTransaction<dim, spacedim>::Operation::Spreading),
+               ExcMessage("Transaction operation should be Spreading"));
+        Assert((multi_trans->next_state ==
+                MultiFieldTransaction<dim, spacedim>::State::AccumulateFinish),
+               ExcMessage("Transaction state should be AccumulateFinish"));
+        multi_trans->next_state =
+          MultiFieldTransaction<dim, spacedim>::State::Done;
+        return_scatter(*multi_trans->native_position_dof_handler,
+                       std::move(multi_trans->position_scatter));
+        for (std::size_t field_n = 0;
+             field_n < multi_trans->solution_scatters.size();
+             ++field_n)
+          return_scatter(*multi_trans->native_dof_handlers[field_n],
+                         std::move(multi_trans->solution_scatters[field_n]));
+        return;
+      }
+
     auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
     Assert((trans.operation ==
             Transaction<dim, spacedim>::Operation::Spreading),
@@ -615,8 +1510,13 @@ namespace fdl
 
     return_scatter(*trans.native_position_dof_handler,
                    std::move(trans.position_scatter));
-    return_scatter(*trans.native_dof_handler,
-                   std::move(trans.solution_scatter));
+    if (trans.single_precision)
+      return_scatter(*trans.native_dof_handler,
+                     std::move(trans.float_solution_scatter));
+    else
+      return_scatter(*trans.native_dof_handler,
+                     std::move(trans.solution_scatter));
+    return_transaction(std::move(t_ptr));
   }
 
   template <int dim, int spacedim>
@@ -672,6 +1572,67 @@ namespace fdl
                          std::move(trans.position_scatter));
   }
 
+
+
+  template <int dim, int spacedim>
+  std::pair<double, double>
+  InteractionBase<dim, spacedim>::count_local_interaction_work()
+  {
+    return {0.0, 0.0};
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::set_workload_weights(
+    const double point_weight,
+    const double cell_weight)
+  {
+    AssertThrow(point_weight >= 0.0 && cell_weight >= 0.0,
+                ExcMessage("Workload weights should be nonnegative."));
+    workload_point_weight = point_weight;
+    workload_cell_weight  = cell_weight;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  InteractionBase<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t transaction_bytes = 0;
+    for (const auto &transaction : transactions)
+      transaction_bytes +=
+        sizeof(*transaction) +
+        transaction->overlap_position.memory_consumption() +
+        transaction->overlap_rhs.memory_consumption() +
+        transaction->overlap_solution.memory_consumption() +
+        transaction->float_native_vector.memory_consumption() +
+        transaction->float_overlap_rhs.memory_consumption() +
+        transaction->float_overlap_solution.memory_consumption();
+
+    const std::size_t n_bytes =
+      sizeof(*this) + overlap_tria.memory_consumption() +
+      overlap_active_cell_bboxes.capacity() *
+        sizeof(BoundingBox<spacedim, float>) +
+      MemoryConsumption::memory_consumption(overlap_dof_indices) +
+      MemoryConsumption::memory_consumption(overlap_dof_handlers) +
+      MemoryConsumption::memory_consumption(
+        overlap_to_native_dof_translations) +
+      MemoryConsumption::memory_consumption(scatters) +
+      MemoryConsumption::memory_consumption(float_scatters) +
+      MemoryConsumption::memory_consumption(previous_overlap_dof_indices) +
+      MemoryConsumption::memory_consumption(previous_overlap_dof_handlers) +
+      MemoryConsumption::memory_consumption(
+        previous_overlap_to_native_dof_translations) +
+      MemoryConsumption::memory_consumption(previous_scatters) +
+      MemoryConsumption::memory_consumption(previous_float_scatters) +
+      cached_overlap_position.memory_consumption() + transaction_bytes;
+
+    return n_bytes;
+  }
+
   // instantiations
 
   template class InteractionBase<NDIM - 1, NDIM>;
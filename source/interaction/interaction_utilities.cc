@@ -1,27 +1,42 @@
+#include <fiddle/base/hardware_counters.h>
 #include <fiddle/base/samrai_utilities.h>
 
 #include <fiddle/grid/box_utilities.h>
 #include <fiddle/grid/nodal_patch_map.h>
+#include <fiddle/grid/patch_intersection_map.h>
 #include <fiddle/grid/patch_map.h>
 
+#include <fiddle/interaction/ib_kernels.h>
 #include <fiddle/interaction/interaction_utilities.h>
 
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx17/optional.h>
 
 #include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe_field.h>
 
 #include <deal.II/numerics/rtree.h>
 
 #include <boost/container/small_vector.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
 
 #include <ibtk/IndexUtilities.h>
-#include <ibtk/LEInteractor.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
 #include <memory>
+#include <numeric>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace fdl
@@ -75,15 +90,1367 @@ namespace fdl
                  ExcMessage("Not enough quadrature rules"));
         }
     }
+
+    template <int dim, int spacedim>
+    void
+    check_plan(const InteractionPlan<dim, spacedim> &plan,
+               const PatchMap<dim, spacedim>        &patch_map)
+    {
+      (void)plan;
+      (void)patch_map;
+      Assert(plan.patch_q_points.size() == patch_map.size(),
+             ExcMessage("The interaction plan should have been computed with "
+                        "the provided PatchMap."));
+      Assert(plan.patch_cell_offsets.size() == patch_map.size(),
+             ExcMessage("The interaction plan should have been computed with "
+                        "the provided PatchMap."));
+    }
+
+    /**
+     * Number of cells in each work item of the threaded version of
+     * compute_projection_rhs(). Patches vary in cost by orders of magnitude
+     * (some contain a large part of a structure and most contain nothing), so
+     * splitting each patch into small pieces lets threads balance the work.
+     */
+    constexpr std::size_t interpolation_chunk_size = 32;
+
+    /**
+     * A contiguous range of cells of one patch.
+     */
+    struct InterpolationWorkItem
+    {
+      std::size_t patch_n;
+      std::size_t begin;
+      std::size_t end;
+    };
+
+    /**
+     * Class which sorts the points (and the values at those points) spread
+     * into a patch by the Eulerian cell containing them, so that the kernel
+     * writes to the patch data in (roughly) memory order instead of jumping
+     * around in it as the Lagrangian cells do.
+     *
+     * The cells of the patch box are numbered lexicographically, with the
+     * first coordinate running fastest, and the points are binned with a
+     * counting sort in O(n_points + n_cells) time. Points outside the patch
+     * box (i.e., in its ghost region) are binned with the nearest cell of the
+     * box. Points in the same cell keep their relative order so the result is
+     * deterministic.
+     */
+    template <int spacedim, typename value_type>
+    class EulerianCellSorter
+    {
+    public:
+      /**
+       * Sort @p points and @p values, i.e., set up sorted_points and
+       * sorted_values.
+       */
+      void
+      sort(const tbox::Pointer<hier::Patch<spacedim>> &patch,
+           const std::vector<Point<spacedim>>         &points,
+           const std::vector<value_type>              &values)
+      {
+        AssertDimension(points.size(), values.size());
+        const hier::Box<spacedim> &patch_box = patch->getBox();
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>>
+          patch_geom = patch->getPatchGeometry();
+        Assert(patch_geom, ExcMessage("Type mismatch"));
+
+        std::size_t n_cells = 1;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          n_cells *= patch_box.numberCells(d);
+        bin_offsets.assign(n_cells + 1, 0);
+        point_bins.resize(points.size());
+        for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+          {
+            const hier::Index<spacedim> i =
+              IBTK::IndexUtilities::getCellIndex(points[point_n],
+                                                 patch_geom,
+                                                 patch_box);
+            std::size_t bin    = 0;
+            std::size_t stride = 1;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                const int n_cells_d = patch_box.numberCells(d);
+                const int index =
+                  std::min(std::max(i(d) - patch_box.lower(d), 0),
+                           n_cells_d - 1);
+                bin += stride * index;
+                stride *= n_cells_d;
+              }
+            point_bins[point_n] = bin;
+            ++bin_offsets[bin + 1];
+          }
+        std::partial_sum(bin_offsets.begin(),
+                         bin_offsets.end(),
+                         bin_offsets.begin());
+
+        sorted_points.resize(points.size());
+        sorted_values.resize(values.size());
+        for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+          {
+            const std::size_t sorted_n = bin_offsets[point_bins[point_n]]++;
+            sorted_points[sorted_n]    = points[point_n];
+            sorted_values[sorted_n]    = values[point_n];
+          }
+      }
+
+      std::vector<Point<spacedim>> sorted_points;
+
+      std::vector<value_type> sorted_values;
+
+    private:
+      std::vector<std::size_t> point_bins;
+
+      std::vector<std::size_t> bin_offsets;
+    };
+
+    inline double
+    value_magnitude(const double value)
+    {
+      return std::abs(value);
+    }
+
+    template <int spacedim>
+    inline double
+    value_magnitude(const Tensor<1, spacedim> &value)
+    {
+      return value.norm();
+    }
+
+    template <typename value_type>
+    double
+    max_value_magnitude(const std::vector<value_type> &values)
+    {
+      double result = 0.0;
+      for (const value_type &value : values)
+        result = std::max(result, value_magnitude(value));
+      return result;
+    }
+
+    /**
+     * Class which removes the points whose values are smaller (in magnitude)
+     * than a threshold before spreading and records, in a
+     * SpreadCutoffStatistics object, what was removed. The kept points are in
+     * their original order.
+     */
+    template <int spacedim, typename value_type>
+    class SpreadCutoffFilter
+    {
+    public:
+      /**
+       * Filter @p points and @p values, i.e., set up kept_points and
+       * kept_values.
+       */
+      void
+      filter(const std::vector<Point<spacedim>> &points,
+             const std::vector<value_type>      &values,
+             const double                        threshold,
+             SpreadCutoffStatistics             &statistics)
+      {
+        AssertDimension(points.size(), values.size());
+        kept_points.clear();
+        kept_values.clear();
+        for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+          {
+            const double magnitude = value_magnitude(values[point_n]);
+            statistics.n_points += 1;
+            statistics.total_magnitude += magnitude;
+            if (magnitude < threshold)
+              {
+                statistics.n_skipped_points += 1;
+                statistics.skipped_magnitude += magnitude;
+              }
+            else
+              {
+                kept_points.push_back(points[point_n]);
+                kept_values.push_back(values[point_n]);
+              }
+          }
+      }
+
+      std::vector<Point<spacedim>> kept_points;
+
+      std::vector<value_type> kept_values;
+    };
+
+    /**
+     * Add the statistics of each patch to @p statistics, if it is not null.
+     */
+    void
+    add_spread_cutoff_statistics(
+      const std::vector<SpreadCutoffStatistics> &patch_statistics,
+      SpreadCutoffStatistics                    *statistics)
+    {
+      if (statistics == nullptr)
+        return;
+      for (const SpreadCutoffStatistics &patch : patch_statistics)
+        {
+          statistics->n_points += patch.n_points;
+          statistics->n_skipped_points += patch.n_skipped_points;
+          statistics->total_magnitude += patch.total_magnitude;
+          statistics->skipped_magnitude += patch.skipped_magnitude;
+        }
+    }
+
+    /**
+     * Add @p cell_rhs into @p rhs at the DoFs of @p cell. If possible, look
+     * up the DoF indices in @p dof_table (see PatchMap::get_dof_index_table())
+     * instead of through the cell iterator: otherwise use @p dof_indices as
+     * scratch space.
+     */
+    template <typename CellIterator, typename VectorType>
+    void
+    add_cell_rhs(const CellIterator                             &cell,
+                 const ArrayView<const types::global_dof_index> &dof_table,
+                 std::vector<types::global_dof_index>           &dof_indices,
+                 const Vector<double>                           &cell_rhs,
+                 VectorType                                     &rhs)
+    {
+      if (dof_table.size() > 0)
+        {
+          const std::size_t dofs_per_cell = cell_rhs.size();
+          rhs.add(dofs_per_cell,
+                  dof_table.data() + cell->active_cell_index() * dofs_per_cell,
+                  cell_rhs.begin());
+        }
+      else
+        {
+          cell->get_dof_indices(dof_indices);
+          rhs.add(dof_indices, cell_rhs);
+        }
+    }
+
+    /**
+     * Copy the values of @p solution at the DoFs of @p cell into
+     * @p cell_solution. Like add_cell_rhs(), this uses @p dof_table if
+     * possible.
+     */
+    template <typename CellIterator, typename VectorType>
+    void
+    get_cell_solution(const CellIterator                             &cell,
+                      const ArrayView<const types::global_dof_index> &dof_table,
+                      const VectorType                               &solution,
+                      std::vector<double> &cell_solution)
+    {
+      if (dof_table.size() > 0)
+        {
+          const std::size_t dofs_per_cell = cell_solution.size();
+          const types::global_dof_index *const cell_dofs =
+            dof_table.data() + cell->active_cell_index() * dofs_per_cell;
+          for (std::size_t i = 0; i < dofs_per_cell; ++i)
+            cell_solution[i] = solution[cell_dofs[i]];
+        }
+      else
+        cell->get_dof_values(solution,
+                             cell_solution.begin(),
+                             cell_solution.end());
+    }
+
+    /**
+     * Class which integrates values at quadrature points against the test
+     * functions of a finite element, i.e., computes cell right-hand sides.
+     *
+     * For FE_Q (or an FESystem of a single FE_Q) with tensor-product
+     * quadrature rules the test functions are applied with sum factorization,
+     * i.e., by contracting with the one-dimensional shape functions one
+     * coordinate direction at a time, in O(p^(dim + 1)) operations per cell
+     * and component. All other elements (e.g., simplices) use the standard
+     * O(dofs_per_cell * n_q_points) loop.
+     *
+     * The most common cases (Q1 and Q2 elements with one or spacedim
+     * components and two to six quadrature points in each direction) use sum
+     * factorization kernels with loop bounds known at compile time, which the
+     * compiler can unroll and vectorize. The kernel for each quadrature rule
+     * is chosen once, in the constructor.
+     */
+    template <int dim, int spacedim>
+    class CellRHSIntegrator
+    {
+    public:
+      CellRHSIntegrator(const FiniteElement<dim, spacedim> &fe,
+                        const std::vector<Quadrature<dim>> &quadratures)
+        : fe(&fe)
+        , n_dofs_1d(0)
+        , dof_components(fe.dofs_per_cell)
+        , dof_lexicographic_indices(fe.dofs_per_cell)
+      {
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          dof_components[i] = fe.system_to_component_index(i).first;
+
+        // Check that the element is supported:
+        shape_values_1d.resize(quadratures.size());
+        fixed_kernels.resize(quadratures.size(), nullptr);
+        if (fe.n_base_elements() != 1)
+          return;
+        const auto *fe_q =
+          dynamic_cast<const FE_Q<dim, spacedim> *>(&fe.base_element(0));
+        if (fe_q == nullptr)
+          return;
+
+        const unsigned int degree = fe_q->degree;
+        n_dofs_1d                 = degree + 1;
+        const std::vector<unsigned int> lexicographic_to_hierarchic =
+          FETools::lexicographic_to_hierarchic_numbering<dim>(degree);
+        std::vector<unsigned int> hierarchic_to_lexicographic(
+          lexicographic_to_hierarchic.size());
+        for (unsigned int i = 0; i < lexicographic_to_hierarchic.size(); ++i)
+          hierarchic_to_lexicographic[lexicographic_to_hierarchic[i]] = i;
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          dof_lexicographic_indices[i] =
+            hierarchic_to_lexicographic[fe.system_to_component_index(i).second];
+
+        // The first n_dofs_1d lexicographic support points are on the x-axis
+        std::vector<double> support_points_1d(n_dofs_1d);
+        for (unsigned int i = 0; i < n_dofs_1d; ++i)
+          support_points_1d[i] =
+            fe_q->get_unit_support_points()[lexicographic_to_hierarchic[i]][0];
+
+        for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+          {
+            const Quadrature<dim> &quad = quadratures[quad_n];
+            if (!quad.is_tensor_product())
+              continue;
+            const auto basis = quad.get_tensor_basis();
+            bool       is_symmetric = true;
+            for (unsigned int d = 1; d < dim; ++d)
+              is_symmetric = is_symmetric &&
+                             basis[d].get_points() == basis[0].get_points();
+            if (!is_symmetric)
+              continue;
+
+            // Evaluate the Lagrange polynomials at the quadrature points:
+            const unsigned int n_q_points_1d = basis[0].size();
+            std::vector<double> &values      = shape_values_1d[quad_n];
+            values.resize(n_dofs_1d * n_q_points_1d);
+            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+              for (unsigned int q = 0; q < n_q_points_1d; ++q)
+                {
+                  const double x     = basis[0].point(q)[0];
+                  double       value = 1.0;
+                  for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                    if (j != i)
+                      value *= (x - support_points_1d[j]) /
+                               (support_points_1d[i] - support_points_1d[j]);
+                  values[i * n_q_points_1d + q] = value;
+                }
+            fixed_kernels[quad_n] =
+              select_fixed_kernel(degree, n_q_points_1d, fe.n_components());
+          }
+      }
+
+      /**
+       * Flags required by the FEValues object passed to integrate() for a
+       * given quadrature rule.
+       */
+      UpdateFlags
+      get_update_flags(const unsigned int quad_index) const
+      {
+        AssertIndexRange(quad_index, shape_values_1d.size());
+        return shape_values_1d[quad_index].size() == 0 ?
+                 update_JxW_values | update_values :
+                 update_JxW_values;
+      }
+
+      /**
+       * Return whether or not the given quadrature rule uses sum
+       * factorization.
+       */
+      bool
+      uses_sum_factorization(const unsigned int quad_index) const
+      {
+        AssertIndexRange(quad_index, shape_values_1d.size());
+        return shape_values_1d[quad_index].size() != 0;
+      }
+
+      /**
+       * Compute the cell right-hand side.
+       *
+       * @param[in] values Values at quadrature points, numbered with the
+       * component index running fastest.
+       */
+      void
+      integrate(const unsigned int             quad_index,
+                const FEValues<dim, spacedim> &fe_values,
+                const double                  *values,
+                Vector<double>                &cell_rhs) const
+      {
+        const unsigned int n_q_points    = fe_values.n_quadrature_points;
+        const unsigned int n_components  = fe->n_components();
+        const unsigned int dofs_per_cell = dof_components.size();
+        AssertDimension(cell_rhs.size(), dofs_per_cell);
+
+        if (uses_sum_factorization(quad_index))
+          {
+            integrate(quad_index,
+                      n_q_points,
+                      fe_values.get_JxW_values().data(),
+                      values,
+                      cell_rhs);
+            return;
+          }
+
+        cell_rhs = 0.0;
+        for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+          {
+            const double JxW = fe_values.JxW(qp_n);
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              cell_rhs[i] += fe_values.shape_value(i, qp_n) *
+                             values[qp_n * n_components + dof_components[i]] *
+                             JxW;
+          }
+      }
+
+      /**
+       * Same as the other integrate() function, but with precomputed JxW
+       * values. Only available for quadrature rules which use sum
+       * factorization since those do not require any other data from an
+       * FEValues object.
+       */
+      void
+      integrate(const unsigned int quad_index,
+                const unsigned int n_q_points,
+                const double      *JxW,
+                const double      *values,
+                Vector<double>    &cell_rhs) const
+      {
+        Assert(uses_sum_factorization(quad_index), ExcFDLInternalError());
+        if (fixed_kernels[quad_index] != nullptr)
+          {
+            (this->*fixed_kernels[quad_index])(
+              quad_index, n_q_points, JxW, values, cell_rhs);
+            return;
+          }
+        const unsigned int n_components  = fe->n_components();
+        const unsigned int dofs_per_cell = dof_components.size();
+        AssertDimension(cell_rhs.size(), dofs_per_cell);
+        const std::vector<double> &shape_values = shape_values_1d[quad_index];
+
+        cell_rhs                         = 0.0;
+        const unsigned int n_q_points_1d = shape_values.size() / n_dofs_1d;
+        Assert(Utilities::fixed_power<dim>(n_q_points_1d) == n_q_points,
+               ExcFDLInternalError());
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            // scratch_0 stores the current partially contracted integrand:
+            scratch_0.resize(n_q_points);
+            for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+              scratch_0[qp_n] = values[qp_n * n_components + c] * JxW[qp_n];
+
+            // Contract in each direction. Directions before d have already
+            // been contracted (and have n_dofs_1d entries) whereas directions
+            // after d still have n_q_points_1d entries.
+            unsigned int n_before = 1;
+            unsigned int n_after  = n_q_points / n_q_points_1d;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                scratch_1.resize(n_before * n_dofs_1d * n_after);
+                for (unsigned int b = 0; b < n_after; ++b)
+                  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                    {
+                      const double *const shape =
+                        shape_values.data() + i * n_q_points_1d;
+                      double *const out =
+                        scratch_1.data() + n_before * (i + n_dofs_1d * b);
+                      const double *const in =
+                        scratch_0.data() + n_before * n_q_points_1d * b;
+                      for (unsigned int a = 0; a < n_before; ++a)
+                        out[a] = 0.0;
+                      for (unsigned int q = 0; q < n_q_points_1d; ++q)
+                        for (unsigned int a = 0; a < n_before; ++a)
+                          out[a] += shape[q] * in[a + n_before * q];
+                    }
+                scratch_0.swap(scratch_1);
+                n_before *= n_dofs_1d;
+                if (d + 1 < dim)
+                  n_after /= n_q_points_1d;
+              }
+
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              if (dof_components[i] == c)
+                cell_rhs[i] = scratch_0[dof_lexicographic_indices[i]];
+          }
+      }
+
+    private:
+      using FixedKernel = void (CellRHSIntegrator::*)(const unsigned int,
+                                                       const unsigned int,
+                                                       const double *,
+                                                       const double *,
+                                                       Vector<double> &) const;
+
+      /**
+       * Same as the sum factorization branch of integrate(), but with all loop
+       * bounds known at compile time.
+       */
+      template <int fe_degree, int n_q_points_1d, int n_components>
+      void
+      integrate_fixed(const unsigned int quad_index,
+                      const unsigned int n_q_points,
+                      const double      *JxW,
+                      const double      *values,
+                      Vector<double>    &cell_rhs) const
+      {
+        constexpr unsigned int n_dofs_1d_ = fe_degree + 1;
+        constexpr unsigned int n_points   = Utilities::pow(n_q_points_1d, dim);
+        // Intermediate contractions have a mix of DoF and quadrature point
+        // indices, so size the scratch arrays for the larger of the two
+        constexpr unsigned int n_scratch =
+          Utilities::pow(std::max<unsigned int>(n_dofs_1d_, n_q_points_1d),
+                         dim);
+        (void)n_q_points;
+        AssertDimension(n_q_points, n_points);
+        AssertDimension(cell_rhs.size(), dof_components.size());
+
+        std::array<double, n_dofs_1d_ * n_q_points_1d> shape;
+        std::copy_n(shape_values_1d[quad_index].begin(),
+                    shape.size(),
+                    shape.begin());
+
+        std::array<double, n_scratch> scratch_a;
+        std::array<double, n_scratch> scratch_b;
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            double *in  = scratch_a.data();
+            double *out = scratch_b.data();
+            for (unsigned int qp_n = 0; qp_n < n_points; ++qp_n)
+              in[qp_n] = values[qp_n * n_components + c] * JxW[qp_n];
+
+            unsigned int n_before = 1;
+            unsigned int n_after  = n_points / n_q_points_1d;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                for (unsigned int b = 0; b < n_after; ++b)
+                  for (unsigned int i = 0; i < n_dofs_1d_; ++i)
+                    {
+                      double *const out_i =
+                        out + n_before * (i + n_dofs_1d_ * b);
+                      const double *const in_b =
+                        in + n_before * n_q_points_1d * b;
+                      for (unsigned int a = 0; a < n_before; ++a)
+                        {
+                          double sum = 0.0;
+                          for (unsigned int q = 0; q < n_q_points_1d; ++q)
+                            sum += shape[i * n_q_points_1d + q] *
+                                   in_b[a + n_before * q];
+                          out_i[a] = sum;
+                        }
+                    }
+                std::swap(in, out);
+                n_before *= n_dofs_1d_;
+                if (d + 1 < dim)
+                  n_after /= n_q_points_1d;
+              }
+
+            for (unsigned int i = 0; i < dof_components.size(); ++i)
+              if (dof_components[i] == c)
+                cell_rhs[i] = in[dof_lexicographic_indices[i]];
+          }
+      }
+
+      /**
+       * Return the fixed-size kernel for the given parameters, or nullptr if
+       * there is none.
+       */
+      template <int fe_degree, int n_q_points_1d>
+      static FixedKernel
+      select_fixed_kernel(const unsigned int n_components)
+      {
+        if (n_components == 1)
+          return &CellRHSIntegrator::
+            integrate_fixed<fe_degree, n_q_points_1d, 1>;
+        else if (n_components == spacedim)
+          return &CellRHSIntegrator::
+            integrate_fixed<fe_degree, n_q_points_1d, spacedim>;
+        return nullptr;
+      }
+
+      template <int fe_degree>
+      static FixedKernel
+      select_fixed_kernel(const unsigned int n_q_points_1d,
+                          const unsigned int n_components)
+      {
+        switch (n_q_points_1d)
+          {
+            case 2:
+              return select_fixed_kernel<fe_degree, 2>(n_components);
+            case 3:
+              return select_fixed_kernel<fe_degree, 3>(n_components);
+            case 4:
+              return select_fixed_kernel<fe_degree, 4>(n_components);
+            case 5:
+              return select_fixed_kernel<fe_degree, 5>(n_components);
+            case 6:
+              return select_fixed_kernel<fe_degree, 6>(n_components);
+            default:
+              return nullptr;
+          }
+      }
+
+      static FixedKernel
+      select_fixed_kernel(const unsigned int degree,
+                          const unsigned int n_q_points_1d,
+                          const unsigned int n_components)
+      {
+        switch (degree)
+          {
+            case 1:
+              return select_fixed_kernel<1>(n_q_points_1d, n_components);
+            case 2:
+              return select_fixed_kernel<2>(n_q_points_1d, n_components);
+            default:
+              return nullptr;
+          }
+      }
+
+      const FiniteElement<dim, spacedim> *fe;
+
+      unsigned int n_dofs_1d;
+
+      std::vector<unsigned int> dof_components;
+
+      std::vector<unsigned int> dof_lexicographic_indices;
+
+      /**
+       * Values of the one-dimensional shape functions at the one-dimensional
+       * quadrature points, indexed by quadrature rule. Empty for quadrature
+       * rules which cannot use sum factorization.
+       */
+      std::vector<std::vector<double>> shape_values_1d;
+
+      /**
+       * Kernel with fixed loop bounds for each quadrature rule, or nullptr if
+       * there is none.
+       */
+      std::vector<FixedKernel> fixed_kernels;
+
+      mutable std::vector<double> scratch_0;
+
+      mutable std::vector<double> scratch_1;
+    };
+
+    /**
+     * Values of the shape functions of a primitive finite element at the
+     * points of each quadrature rule on the reference cell. The values of
+     * primitive shape functions do not depend on the mapping, so, if the JxW
+     * values are already known (see InteractionPlan::patch_JxW), these can be
+     * used to evaluate and integrate finite element fields without
+     * reinitializing an FEValues object on each cell.
+     */
+    template <int dim, int spacedim>
+    class ReferenceShapeValues
+    {
+    public:
+      ReferenceShapeValues(const FiniteElement<dim, spacedim> &fe,
+                           const std::vector<Quadrature<dim>> &quadratures)
+        : n_components(fe.n_components())
+        , dof_components(fe.dofs_per_cell)
+        , shape_values(quadratures.size())
+      {
+        Assert(fe.is_primitive(), ExcFDLNotImplemented());
+        const unsigned int dofs_per_cell = fe.dofs_per_cell;
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          dof_components[i] = fe.system_to_component_index(i).first;
+        for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+          {
+            const Quadrature<dim> &quad   = quadratures[quad_n];
+            std::vector<double>   &values = shape_values[quad_n];
+            values.resize(quad.size() * dofs_per_cell);
+            for (unsigned int q = 0; q < quad.size(); ++q)
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                values[q * dofs_per_cell + i] =
+                  fe.shape_value(i, quad.point(q));
+          }
+      }
+
+      /**
+       * Evaluate a finite element field at the quadrature points.
+       *
+       * @param[out] values Values at quadrature points, numbered with the
+       * component index running fastest.
+       */
+      void
+      evaluate(const unsigned int quad_index,
+               const double      *dof_values,
+               double            *values) const
+      {
+        AssertIndexRange(quad_index, shape_values.size());
+        const unsigned int         dofs_per_cell = dof_components.size();
+        const std::vector<double> &table         = shape_values[quad_index];
+        const unsigned int         n_q_points    = table.size() / dofs_per_cell;
+        std::fill(values, values + n_q_points * n_components, 0.0);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            values[q * n_components + dof_components[i]] +=
+              table[q * dofs_per_cell + i] * dof_values[i];
+      }
+
+      /**
+       * Compute a cell right-hand side, like CellRHSIntegrator::integrate().
+       */
+      void
+      integrate(const unsigned int quad_index,
+                const double      *JxW,
+                const double      *values,
+                Vector<double>    &cell_rhs) const
+      {
+        AssertIndexRange(quad_index, shape_values.size());
+        const unsigned int         dofs_per_cell = dof_components.size();
+        const std::vector<double> &table         = shape_values[quad_index];
+        const unsigned int         n_q_points    = table.size() / dofs_per_cell;
+        AssertDimension(cell_rhs.size(), dofs_per_cell);
+        cell_rhs = 0.0;
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            cell_rhs[i] += table[q * dofs_per_cell + i] *
+                           values[q * n_components + dof_components[i]] *
+                           JxW[q];
+      }
+
+    private:
+      unsigned int n_components;
+
+      std::vector<unsigned int> dof_components;
+
+      /**
+       * Shape function values indexed by quadrature rule. The values for
+       * quadrature point q and shape function i are stored at
+       * q * dofs_per_cell + i.
+       */
+      std::vector<std::vector<double>> shape_values;
+    };
+
+    /**
+     * Return whether or not the plan-based interaction functions can use
+     * precomputed JxW values and reference shape function values instead of
+     * FEValues.
+     */
+    template <int dim, int spacedim>
+    bool
+    use_plan_weights(const InteractionPlan<dim, spacedim> &plan,
+                     const FiniteElement<dim, spacedim>   &fe,
+                     const Mapping<dim, spacedim>         &mapping)
+    {
+      return plan.has_weights_for(mapping) && fe.is_primitive();
+    }
+  } // namespace
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionPlan<dim, spacedim>::empty() const
+  {
+    return patch_cell_offsets.size() == 0;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionPlan<dim, spacedim>::is_compressed() const
+  {
+    return !empty() &&
+           patch_q_point_representatives.size() == patch_cell_offsets.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionPlan<dim, spacedim>::is_valid_for(
+    const Vector<double> &new_position,
+    const double          tolerance) const
+  {
+    if (empty() || new_position.size() != position.size())
+      return false;
+    for (std::size_t i = 0; i < position.size(); ++i)
+      if (std::abs(new_position[i] - position[i]) > tolerance)
+        return false;
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionPlan<dim, spacedim>::has_weights_for(
+    const Mapping<dim, spacedim> &mapping) const
+  {
+    return weights_mapping == &mapping &&
+           patch_JxW.size() == patch_cell_offsets.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionPlan<dim, spacedim>::clear()
+  {
+    patch_q_points.clear();
+    patch_cell_offsets.clear();
+    position.reinit(0);
+    patch_JxW.clear();
+    weights_mapping = nullptr;
+    patch_compressed_q_points.clear();
+    patch_q_point_representatives.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  InteractionPlan<dim, spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) +
+           MemoryConsumption::memory_consumption(patch_q_points) +
+           MemoryConsumption::memory_consumption(patch_cell_offsets) +
+           position.memory_consumption() +
+           MemoryConsumption::memory_consumption(patch_JxW) +
+           MemoryConsumption::memory_consumption(patch_compressed_q_points) +
+           MemoryConsumption::memory_consumption(patch_q_point_representatives);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_interaction_plan(
+    const PatchMap<dim, spacedim>      &patch_map,
+    const DoFHandler<dim, spacedim>    &position_dof_handler,
+    const Vector<double>               &position,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    InteractionPlan<dim, spacedim>     &plan)
+  {
+    check_quadratures(quadrature_indices,
+                      quadratures,
+                      position_dof_handler.get_triangulation());
+    Assert(&patch_map.get_triangulation() ==
+             &position_dof_handler.get_triangulation(),
+           ExcMessage("The PatchMap and DoFHandler should use the same "
+                      "Triangulation."));
+
+    const MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+      position_dof_handler, position);
+    const FiniteElement<dim, spacedim> &fe = position_dof_handler.get_fe();
+    AssertDimension(fe.n_components(), spacedim);
+    // For primitive elements (e.g., FESystem(FE_Q(1), spacedim)) we can
+    // compute the quadrature points directly from the values of the shape
+    // functions on the reference cell. This is the same computation (in the
+    // same order) done by MappingFEField, but it avoids reinitializing an
+    // FEValues object on each cell.
+    std::unique_ptr<ReferenceShapeValues<dim, spacedim>> position_shape_values;
+    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
+      all_position_fe_values;
+    if (fe.is_primitive())
+      position_shape_values =
+        std::make_unique<ReferenceShapeValues<dim, spacedim>>(fe, quadratures);
+    else
+      for (const Quadrature<dim> &quad : quadratures)
+        all_position_fe_values.emplace_back(
+          std::make_unique<FEValues<dim, spacedim>>(
+            position_mapping, fe, quad, update_quadrature_points));
+    std::vector<double> cell_position(fe.dofs_per_cell);
+
+    plan.patch_q_points.resize(patch_map.size());
+    plan.patch_cell_offsets.resize(patch_map.size());
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        std::vector<Point<spacedim>> &q_points = plan.patch_q_points[patch_n];
+        std::vector<unsigned int> &offsets = plan.patch_cell_offsets[patch_n];
+        q_points.clear();
+        offsets.clear();
+        offsets.push_back(0);
+
+        auto       iter = patch_map.begin(patch_n, position_dof_handler);
+        const auto end  = patch_map.end(patch_n, position_dof_handler);
+        for (; iter != end; ++iter)
+          {
+            const auto cell = *iter;
+            const auto quad_index =
+              quadrature_indices[cell->active_cell_index()];
+            if (position_shape_values)
+              {
+                static_assert(sizeof(Point<spacedim>) ==
+                                sizeof(double) * spacedim,
+                              "Points should be packed");
+                cell->get_dof_values(position,
+                                     cell_position.begin(),
+                                     cell_position.end());
+                const std::size_t offset = q_points.size();
+                q_points.resize(offset + quadratures[quad_index].size());
+                position_shape_values->evaluate(
+                  quad_index,
+                  cell_position.data(),
+                  reinterpret_cast<double *>(q_points.data() + offset));
+              }
+            else
+              {
+                FEValues<dim, spacedim> &position_fe_values =
+                  *all_position_fe_values[quad_index];
+                position_fe_values.reinit(cell);
+                const std::vector<Point<spacedim>> &cell_q_points =
+                  position_fe_values.get_quadrature_points();
+                q_points.insert(q_points.end(),
+                                cell_q_points.begin(),
+                                cell_q_points.end());
+              }
+            offsets.push_back(q_points.size());
+          }
+      }
+
+    plan.position = position;
+    // The compressed points depend on the quadrature points
+    plan.patch_compressed_q_points.clear();
+    plan.patch_q_point_representatives.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_interaction_plan_weights(
+    const PatchMap<dim, spacedim>      &patch_map,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    InteractionPlan<dim, spacedim>     &plan)
+  {
+    check_quadratures(quadrature_indices,
+                      quadratures,
+                      dof_handler.get_triangulation());
+    check_plan(plan, patch_map);
+
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
+      all_fe_values;
+    for (const Quadrature<dim> &quad : quadratures)
+      all_fe_values.emplace_back(std::make_unique<FEValues<dim, spacedim>>(
+        mapping, fe, quad, update_JxW_values));
+
+    plan.patch_JxW.resize(patch_map.size());
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        std::vector<double> &JxW = plan.patch_JxW[patch_n];
+        JxW.clear();
+
+        auto       iter = patch_map.begin(patch_n, dof_handler);
+        const auto end  = patch_map.end(patch_n, dof_handler);
+        for (; iter != end; ++iter)
+          {
+            const auto cell = *iter;
+            const auto quad_index =
+              quadrature_indices[cell->active_cell_index()];
+            FEValues<dim, spacedim> &fe_values = *all_fe_values[quad_index];
+            fe_values.reinit(cell);
+            JxW.insert(JxW.end(),
+                       fe_values.get_JxW_values().begin(),
+                       fe_values.get_JxW_values().end());
+          }
+        Assert(JxW.size() == plan.patch_q_points[patch_n].size(),
+               ExcMessage("The interaction plan should have been computed "
+                          "with the provided PatchMap."));
+      }
+    plan.weights_mapping = &mapping;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compress_interaction_plan(const PatchMap<dim, spacedim>  &patch_map,
+                            const double                    tolerance,
+                            InteractionPlan<dim, spacedim> &plan)
+  {
+    check_plan(plan, patch_map);
+    AssertThrow(0.0 < tolerance && tolerance <= 1.0,
+                ExcMessage("The compression tolerance should be in (0, 1]."));
+
+    // Sub-cells are identified by their (possibly negative, for points in
+    // ghost regions) indices relative to the lower corner of the patch,
+    // packed into a single integer
+    constexpr unsigned int bits_per_dimension = 64 / spacedim;
+    constexpr std::int64_t index_offset = std::int64_t(1)
+                                          << (bits_per_dimension - 1);
+    std::unordered_map<std::uint64_t, unsigned int> representative_indices;
+    std::vector<unsigned int>                       n_represented;
+
+    plan.patch_compressed_q_points.resize(patch_map.size());
+    plan.patch_q_point_representatives.resize(patch_map.size());
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::vector<Point<spacedim>> &q_points =
+          plan.patch_q_points[patch_n];
+        std::vector<Point<spacedim>> &compressed_q_points =
+          plan.patch_compressed_q_points[patch_n];
+        std::vector<unsigned int> &representatives =
+          plan.patch_q_point_representatives[patch_n];
+        compressed_q_points.clear();
+        representatives.resize(q_points.size());
+        if (q_points.size() == 0)
+          continue;
+
+        const auto patch = patch_map.get_patch(patch_n);
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>>
+          patch_geom = patch->getPatchGeometry();
+        Assert(patch_geom, ExcMessage("Type mismatch"));
+        const double *const x_lower = patch_geom->getXLower();
+        const double *const dx      = patch_geom->getDx();
+
+        representative_indices.clear();
+        n_represented.clear();
+        for (std::size_t qp_n = 0; qp_n < q_points.size(); ++qp_n)
+          {
+            std::uint64_t key = 0;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                const std::int64_t index = static_cast<std::int64_t>(
+                  std::floor((q_points[qp_n][d] - x_lower[d]) /
+                             (tolerance * dx[d])));
+                Assert(std::abs(index) < index_offset, ExcFDLInternalError());
+                key = (key << bits_per_dimension) |
+                      static_cast<std::uint64_t>(index + index_offset);
+              }
+
+            // Number representatives in order of first appearance so that
+            // the result does not depend on the hash function
+            const auto pair =
+              representative_indices.emplace(key, compressed_q_points.size());
+            if (pair.second)
+              {
+                compressed_q_points.emplace_back();
+                n_represented.push_back(0);
+              }
+            const unsigned int representative = pair.first->second;
+            compressed_q_points[representative] += q_points[qp_n];
+            ++n_represented[representative];
+            representatives[qp_n] = representative;
+          }
+        for (std::size_t i = 0; i < compressed_q_points.size(); ++i)
+          compressed_q_points[i] /= n_represented[i];
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionOperator<dim, spacedim>::empty() const
+  {
+    return patch_column_offsets.size() == 0;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionOperator<dim, spacedim>::is_for(
+    const std::string               &kernel_name,
+    const int                        data_index,
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping) const
+  {
+    return this->kernel_name == kernel_name &&
+           this->data_index == data_index &&
+           this->dof_handler == &dof_handler && this->mapping == &mapping;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionOperator<dim, spacedim>::is_valid_for(
+    const Vector<double> &new_position,
+    const double          tolerance) const
+  {
+    if (empty() || new_position.size() != position.size())
+      return false;
+    for (std::size_t i = 0; i < position.size(); ++i)
+      if (std::abs(new_position[i] - position[i]) > tolerance)
+        return false;
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionOperator<dim, spacedim>::clear()
+  {
+    patch_column_offsets.clear();
+    patch_columns.clear();
+    patch_value_offsets.clear();
+    patch_values.clear();
+    component_dofs.clear();
+    kernel_name.clear();
+    data_index  = -1;
+    dof_handler = nullptr;
+    mapping     = nullptr;
+    position.reinit(0);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  InteractionOperator<dim, spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) +
+           MemoryConsumption::memory_consumption(patch_column_offsets) +
+           MemoryConsumption::memory_consumption(patch_columns) +
+           MemoryConsumption::memory_consumption(patch_value_offsets) +
+           MemoryConsumption::memory_consumption(patch_values) +
+           MemoryConsumption::memory_consumption(component_dofs) +
+           position.memory_consumption();
+  }
+
+
+
+  namespace
+  {
+    // Compute the rows of the interpolation operator of cell-centered or
+    // side-centered data at the provided points.
+    template <int spacedim>
+    bool
+    compute_operator_weights(
+      const std::string                          &kernel_name,
+      const int                                   data_index,
+      const tbox::Pointer<hier::Patch<spacedim>> &patch,
+      const std::vector<Point<spacedim>>         &points,
+      const unsigned int                          n_components,
+      std::vector<unsigned int>                  &row_offsets,
+      std::vector<int>                           &columns,
+      std::vector<double>                        &weights)
+    {
+      static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                    "Points should be packed");
+      const double *const positions =
+        reinterpret_cast<const double *>(points.data());
+      const tbox::Pointer<hier::PatchData<spacedim>> data =
+        patch->getPatchData(data_index);
+      const tbox::Pointer<pdat::CellData<spacedim, double>> cell_data = data;
+      const tbox::Pointer<pdat::SideData<spacedim, double>> side_data = data;
+      if (cell_data)
+        {
+          check_depth<spacedim>(cell_data, n_components);
+          return ib_compute_weights(positions,
+                                    points.size() * spacedim,
+                                    n_components,
+                                    cell_data,
+                                    patch,
+                                    patch->getBox(),
+                                    kernel_name,
+                                    row_offsets,
+                                    columns,
+                                    weights);
+        }
+      if (side_data)
+        {
+          check_depth<spacedim>(side_data, n_components);
+          return ib_compute_weights(positions,
+                                    points.size() * spacedim,
+                                    n_components,
+                                    side_data,
+                                    patch,
+                                    patch->getBox(),
+                                    kernel_name,
+                                    row_offsets,
+                                    columns,
+                                    weights);
+        }
+      return false;
+    }
+
+    // Get the start of the array of each component of cell-centered or
+    // side-centered data (see ib_compute_weights()).
+    template <int spacedim>
+    std::vector<double *>
+    get_component_pointers(const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                           const int          data_index,
+                           const unsigned int n_components)
+    {
+      Assert(patch->checkAllocated(data_index),
+             ExcMessage("unallocated data patch index"));
+      const tbox::Pointer<hier::PatchData<spacedim>> data =
+        patch->getPatchData(data_index);
+      const tbox::Pointer<pdat::CellData<spacedim, double>> cell_data = data;
+      const tbox::Pointer<pdat::SideData<spacedim, double>> side_data = data;
+      AssertThrow(cell_data || side_data, ExcFDLNotImplemented());
+
+      std::vector<double *> pointers;
+      for (unsigned int c = 0; c < n_components; ++c)
+        pointers.push_back(cell_data ? cell_data->getPointer(c) :
+                                       side_data->getPointer(c, 0));
+      return pointers;
+    }
   } // namespace
 
 
+
+  template <int dim, int spacedim>
+  void
+  compute_interaction_operator(
+    const std::string                    &kernel_name,
+    const int                             data_index,
+    const PatchMap<dim, spacedim>        &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    InteractionOperator<dim, spacedim>   &op)
+  {
+    HardwareCounterRegion region("fdl::compute_interaction_operator()");
+    check_quadratures(quadrature_indices,
+                      quadratures,
+                      dof_handler.get_triangulation());
+    check_plan(plan, patch_map);
+    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
+    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    const unsigned int                  n_components  = fe.n_components();
+    AssertThrow(fe.is_primitive() &&
+                  (n_components == 1 || n_components == spacedim),
+                ExcFDLNotImplemented());
+
+    op.clear();
+    op.kernel_name = kernel_name;
+    op.data_index  = data_index;
+    op.dof_handler = &dof_handler;
+    op.mapping     = &mapping;
+    op.position    = plan.position;
+    op.component_dofs.resize(n_components);
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      op.component_dofs[fe.system_to_component_index(i).first].push_back(i);
+
+    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
+      all_fe_values;
+    for (const Quadrature<dim> &quad : quadratures)
+      all_fe_values.emplace_back(std::make_unique<FEValues<dim, spacedim>>(
+        mapping, fe, quad, update_values | update_JxW_values));
+
+    std::vector<unsigned int> row_offsets;
+    std::vector<int>          columns;
+    std::vector<double>       weights;
+    std::vector<int>          cell_columns;
+
+    op.patch_column_offsets.resize(patch_map.size());
+    op.patch_columns.resize(patch_map.size());
+    op.patch_value_offsets.resize(patch_map.size());
+    op.patch_values.resize(patch_map.size());
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::vector<Point<spacedim>> &q_points =
+          plan.patch_q_points[patch_n];
+        const std::vector<unsigned int> &offsets =
+          plan.patch_cell_offsets[patch_n];
+        std::vector<unsigned int> &column_offsets =
+          op.patch_column_offsets[patch_n];
+        std::vector<int>         &patch_columns = op.patch_columns[patch_n];
+        std::vector<std::size_t> &value_offsets =
+          op.patch_value_offsets[patch_n];
+        std::vector<double> &values = op.patch_values[patch_n];
+        column_offsets.push_back(0);
+        value_offsets.push_back(0);
+        if (q_points.size() == 0)
+          continue;
+
+        auto patch = patch_map.get_patch(patch_n);
+        Assert(patch->checkAllocated(data_index),
+               ExcMessage("unallocated data patch index"));
+        row_offsets.assign(1, 0);
+        columns.clear();
+        weights.clear();
+        const bool has_weights = compute_operator_weights(kernel_name,
+                                                          data_index,
+                                                          patch,
+                                                          q_points,
+                                                          n_components,
+                                                          row_offsets,
+                                                          columns,
+                                                          weights);
+        AssertThrow(has_weights,
+                    ExcMessage("Interaction operators can only be computed "
+                               "for cell-centered or side-centered data, with "
+                               "kernels implemented by fiddle, on patches "
+                               "which do not touch periodic boundaries."));
+
+        auto       iter = patch_map.begin(patch_n, dof_handler);
+        const auto end  = patch_map.end(patch_n, dof_handler);
+        Assert(std::size_t(end - iter) + 1 == offsets.size(),
+               ExcMessage("The interaction plan should have been computed "
+                          "with the provided PatchMap."));
+        for (unsigned int cell_n = 0; iter != end; ++iter, ++cell_n)
+          {
+            const auto cell = *iter;
+            FEValues<dim, spacedim> &fe_values =
+              *all_fe_values[quadrature_indices[cell->active_cell_index()]];
+            fe_values.reinit(cell);
+            const unsigned int offset     = offsets[cell_n];
+            const unsigned int n_q_points = offsets[cell_n + 1] - offset;
+            Assert(n_q_points == fe_values.n_quadrature_points,
+                   ExcFDLInternalError());
+
+            for (unsigned int c = 0; c < n_components; ++c)
+              {
+                // Each block only stores the Eulerian DoFs which interact
+                // with at least one of the cell's quadrature points:
+                cell_columns.clear();
+                for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                  {
+                    const unsigned int row = (offset + qp) * n_components + c;
+                    cell_columns.insert(cell_columns.end(),
+                                        columns.begin() + row_offsets[row],
+                                        columns.begin() + row_offsets[row + 1]);
+                  }
+                std::sort(cell_columns.begin(), cell_columns.end());
+                cell_columns.erase(std::unique(cell_columns.begin(),
+                                               cell_columns.end()),
+                                   cell_columns.end());
+
+                const std::vector<unsigned int> &dofs = op.component_dofs[c];
+                const std::size_t n_columns = cell_columns.size();
+                const std::size_t start     = values.size();
+                values.resize(start + dofs.size() * n_columns, 0.0);
+                for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                  {
+                    const unsigned int row = (offset + qp) * n_components + c;
+                    for (unsigned int e = row_offsets[row];
+                         e < row_offsets[row + 1];
+                         ++e)
+                      {
+                        const std::size_t k =
+                          std::lower_bound(cell_columns.begin(),
+                                           cell_columns.end(),
+                                           columns[e]) -
+                          cell_columns.begin();
+                        const double weight = weights[e] * fe_values.JxW(qp);
+                        for (unsigned int r = 0; r < dofs.size(); ++r)
+                          values[start + r * n_columns + k] +=
+                            fe_values.shape_value(dofs[r], qp) * weight;
+                      }
+                  }
+
+                patch_columns.insert(patch_columns.end(),
+                                     cell_columns.begin(),
+                                     cell_columns.end());
+                column_offsets.push_back(patch_columns.size());
+                value_offsets.push_back(values.size());
+              }
+          }
+      }
+  }
+
+
+
   template <int spacedim, typename Number, typename Scalar>
   void
   tag_cells_internal(
-    const std::vector<BoundingBox<spacedim, Number>>          &bboxes,
+    const ArrayView<const BoundingBox<spacedim, Number>>      &bboxes,
     const int                                                  tag_index,
-    SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<spacedim>> &patch_level)
+    SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<spacedim>> &patch_level,
+    const int                                                  buffer)
   {
     // extract what we need for getCellIndex:
     const hier::IntVector<spacedim> ratio = patch_level->getRatio();
@@ -113,38 +1480,45 @@ namespace fdl
     const auto rtree = pack_rtree_of_indices(patch_bboxes);
 
     // loop over element bboxes...
-    for (const auto &bbox : bboxes)
+    for (const auto &input_bbox : bboxes)
       {
-        // and determine which patches each intersects.
-        namespace bgi = boost::geometry::index;
-        // TODO: this still allocates memory. We should use something else to
-        // avoid that, like boost::function_to_output_iterator or our own
-        // equivalent
-        for (const std::size_t patch_n :
-             rtree | bgi::adaptors::queried(bgi::intersects(bbox)))
+        BoundingBox<spacedim, Number> bbox = input_bbox;
+        if (buffer > 0)
           {
-            AssertIndexRange(patch_n, patches.size());
-
-            const hier::Index<spacedim> i_lower =
-              IBTK::IndexUtilities::getCellIndex(
-                bbox.get_boundary_points().first,
-                grid_geom->getXLower(),
-                grid_geom->getXUpper(),
-                dx.data(),
-                domain_box.lower(),
-                domain_box.upper());
-            const hier::Index<spacedim> i_upper =
-              IBTK::IndexUtilities::getCellIndex(
-                bbox.get_boundary_points().second,
-                grid_geom->getXLower(),
-                grid_geom->getXUpper(),
-                dx.data(),
-                domain_box.lower(),
-                domain_box.upper());
-            const hier::Box<spacedim> box(i_lower, i_upper);
-
-            tag_data[patch_n]->fillAll(Scalar(1), box);
+            auto points = input_bbox.get_boundary_points();
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                points.first[d] -= buffer * dx[d];
+                points.second[d] += buffer * dx[d];
+              }
+            bbox = BoundingBox<spacedim, Number>(points);
           }
+        const hier::Index<spacedim> i_lower =
+          IBTK::IndexUtilities::getCellIndex(bbox.get_boundary_points().first,
+                                             grid_geom->getXLower(),
+                                             grid_geom->getXUpper(),
+                                             dx.data(),
+                                             domain_box.lower(),
+                                             domain_box.upper());
+        const hier::Index<spacedim> i_upper =
+          IBTK::IndexUtilities::getCellIndex(bbox.get_boundary_points().second,
+                                             grid_geom->getXLower(),
+                                             grid_geom->getXUpper(),
+                                             dx.data(),
+                                             domain_box.lower(),
+                                             domain_box.upper());
+        const hier::Box<spacedim> box(i_lower, i_upper);
+
+        // and determine which patches each intersects. Use an output
+        // iterator (instead of the queried adaptor, which copies the results
+        // into a std::vector) so that this loop does not allocate any memory.
+        namespace bgi = boost::geometry::index;
+        const auto tag_patch = [&](const std::size_t patch_n) {
+          AssertIndexRange(patch_n, patches.size());
+          tag_data[patch_n]->fillAll(Scalar(1), box);
+        };
+        rtree.query(bgi::intersects(bbox),
+                    boost::make_function_output_iterator(tag_patch));
       }
   }
 
@@ -157,7 +1531,21 @@ namespace fdl
   tag_cells(
     const std::vector<BoundingBox<spacedim, Number>>          &bboxes,
     const int                                                  tag_index,
-    SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<spacedim>> &patch_level)
+    SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<spacedim>> &patch_level,
+    const int                                                  buffer)
+  {
+    tag_cells(make_array_view(bboxes), tag_index, patch_level, buffer);
+  }
+
+
+
+  template <int spacedim, typename Number>
+  void
+  tag_cells(
+    const ArrayView<const BoundingBox<spacedim, Number>>      &bboxes,
+    const int                                                  tag_index,
+    SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<spacedim>> &patch_level,
+    const int                                                  buffer)
   {
     // SAMRAI doesn't offer a way to dispatch on data type so we have to do it
     // ourselves
@@ -174,25 +1562,31 @@ namespace fdl
             const tbox::Pointer<hier::Patch<spacedim>> patch =
               patch_level->getPatch(p());
 
-            const tbox::Pointer<pdat::CellData<spacedim, int>> int_data =
-              patch->getPatchData(tag_index);
-            const tbox::Pointer<pdat::CellData<spacedim, float>> float_data =
-              patch->getPatchData(tag_index);
-            const tbox::Pointer<pdat::CellData<spacedim, double>> double_data =
-              patch->getPatchData(tag_index);
+            const PatchDataTypeInfo info =
+              get_patch_data_type_info(patch, tag_index);
+            const bool is_cell = info.patch_type == SAMRAIPatchType::Cell;
+            const bool int_data =
+              is_cell && info.field_type == SAMRAIFieldType::Int;
+            const bool float_data =
+              is_cell && info.field_type == SAMRAIFieldType::Float;
+            const bool double_data =
+              is_cell && info.field_type == SAMRAIFieldType::Double;
 
             if (int_data)
               tag_cells_internal<spacedim, Number, int>(bboxes,
                                                         tag_index,
-                                                        patch_level);
+                                                        patch_level,
+                                                        buffer);
             else if (float_data)
               tag_cells_internal<spacedim, Number, float>(bboxes,
                                                           tag_index,
-                                                          patch_level);
+                                                          patch_level,
+                                                          buffer);
             else if (double_data)
               tag_cells_internal<spacedim, Number, double>(bboxes,
                                                            tag_index,
-                                                           patch_level);
+                                                           patch_level,
+                                                           buffer);
             else
               Assert(false, ExcNotImplemented());
 
@@ -212,7 +1606,9 @@ namespace fdl
     PatchMap<dim, spacedim>            &patch_map,
     const Mapping<dim, spacedim>       &position_mapping,
     const std::vector<unsigned char>   &quadrature_indices,
-    const std::vector<Quadrature<dim>> &quadratures)
+    const std::vector<Quadrature<dim>> &quadratures,
+    const double                        point_weight,
+    const double                        cell_weight)
   {
     check_quadratures(quadrature_indices,
                       quadratures,
@@ -221,15 +1617,13 @@ namespace fdl
     // We probably don't need more than 16 quadrature rules
     boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
       all_position_fe_values;
-    // PatchMap only supports looping over DoFHandler iterators, so we need to
-    // make one and never use it explicitly
+    // We only need quadrature points, so FEValues does not need a
+    // DoFHandler, but it still needs a FiniteElement
     const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
     // No mixed meshes yet
     Assert(tria.get_reference_cells().size() == 1, ExcNotImplemented());
     const ReferenceCell reference_cell = tria.get_reference_cells().front();
     FE_Nothing<dim, spacedim> fe_nothing(reference_cell);
-    DoFHandler<dim, spacedim> dof_handler(tria);
-    dof_handler.distribute_dofs(fe_nothing);
     for (const Quadrature<dim> &quad : quadratures)
       {
         all_position_fe_values.emplace_back(
@@ -251,17 +1645,19 @@ namespace fdl
           patch->getPatchGeometry();
         Assert(patch_geom, ExcMessage("Type mismatch"));
 
-        auto       iter = patch_map.begin(patch_n, dof_handler);
-        const auto end  = patch_map.end(patch_n, dof_handler);
-        for (; iter != end; ++iter)
+        for (std::size_t cell_n = 0; cell_n < patch_map.n_cells(patch_n);
+             ++cell_n)
           {
-            const auto cell = *iter;
+            const auto cell = patch_map.get_cell(patch_n, cell_n);
             const auto quad_index =
               quadrature_indices[cell->active_cell_index()];
 
             FEValues<dim, spacedim> &position_fe_values =
               *all_position_fe_values[quad_index];
             position_fe_values.reinit(cell);
+            const Scalar q_point_weight =
+              point_weight +
+              cell_weight / position_fe_values.n_quadrature_points;
             for (const Point<spacedim> &q_point :
                  position_fe_values.get_quadrature_points())
               {
@@ -270,7 +1666,7 @@ namespace fdl
                                                      patch_geom,
                                                      patch_box);
                 if (patch_box.contains(i))
-                  (*qp_data)(i) += Scalar(1);
+                  (*qp_data)(i) += q_point_weight;
               }
           }
       }
@@ -284,7 +1680,9 @@ namespace fdl
                           PatchMap<dim, spacedim>          &patch_map,
                           const Mapping<dim, spacedim>     &position_mapping,
                           const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<dim>> &quadratures)
+                          const std::vector<Quadrature<dim>> &quadratures,
+                          const double                        point_weight,
+                          const double                        cell_weight)
   {
     // SAMRAI doesn't offer a way to dispatch on data type so we have to do it
     // ourselves
@@ -297,12 +1695,15 @@ namespace fdl
         const tbox::Pointer<hier::Patch<spacedim>> patch =
           patch_map.get_patch(0);
 
-        const tbox::Pointer<pdat::CellData<spacedim, int>> int_data =
-          patch->getPatchData(qp_data_index);
-        const tbox::Pointer<pdat::CellData<spacedim, float>> float_data =
-          patch->getPatchData(qp_data_index);
-        const tbox::Pointer<pdat::CellData<spacedim, double>> double_data =
-          patch->getPatchData(qp_data_index);
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch, qp_data_index);
+        const bool is_cell = info.patch_type == SAMRAIPatchType::Cell;
+        const bool int_data =
+          is_cell && info.field_type == SAMRAIFieldType::Int;
+        const bool float_data =
+          is_cell && info.field_type == SAMRAIFieldType::Float;
+        const bool double_data =
+          is_cell && info.field_type == SAMRAIFieldType::Double;
 
         if (int_data)
           count_quadrature_points_internal<dim, spacedim, int>(
@@ -310,21 +1711,27 @@ namespace fdl
             patch_map,
             position_mapping,
             quadrature_indices,
-            quadratures);
+            quadratures,
+            point_weight,
+            cell_weight);
         else if (float_data)
           count_quadrature_points_internal<dim, spacedim, float>(
             qp_data_index,
             patch_map,
             position_mapping,
             quadrature_indices,
-            quadratures);
+            quadratures,
+            point_weight,
+            cell_weight);
         else if (double_data)
           count_quadrature_points_internal<dim, spacedim, double>(
             qp_data_index,
             patch_map,
             position_mapping,
             quadrature_indices,
-            quadratures);
+            quadratures,
+            point_weight,
+            cell_weight);
         else
           Assert(false, ExcNotImplemented());
       }
@@ -332,12 +1739,108 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim, typename Scalar>
+  void
+  count_quadrature_points_plan_internal(
+    const int                             qp_data_index,
+    PatchMap<dim, spacedim>              &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const double                          point_weight,
+    const double                          cell_weight)
+  {
+    check_plan(plan, patch_map);
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::vector<Point<spacedim>> &q_points =
+          plan.patch_q_points[patch_n];
+        const std::vector<unsigned int> &offsets =
+          plan.patch_cell_offsets[patch_n];
+        if (q_points.size() == 0)
+          continue;
+
+        auto patch = patch_map.get_patch(patch_n);
+        Assert(patch->checkAllocated(qp_data_index),
+               ExcMessage("unallocated tag patch index"));
+        tbox::Pointer<pdat::CellData<spacedim, Scalar>> qp_data =
+          patch->getPatchData(qp_data_index);
+        Assert(qp_data, ExcMessage("Type mismatch"));
+        Assert(qp_data->getDepth() == 1, ExcMessage("depth should be 1"));
+        const hier::Box<spacedim> &patch_box = patch->getBox();
+        tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+          patch->getPatchGeometry();
+        Assert(patch_geom, ExcMessage("Type mismatch"));
+
+        for (std::size_t cell_n = 0; cell_n + 1 < offsets.size(); ++cell_n)
+          {
+            const unsigned int n_q_points =
+              offsets[cell_n + 1] - offsets[cell_n];
+            const Scalar q_point_weight =
+              point_weight + cell_weight / n_q_points;
+            for (unsigned int qp = offsets[cell_n]; qp < offsets[cell_n + 1];
+                 ++qp)
+              {
+                const hier::Index<spacedim> i =
+                  IBTK::IndexUtilities::getCellIndex(q_points[qp],
+                                                     patch_geom,
+                                                     patch_box);
+                if (patch_box.contains(i))
+                  (*qp_data)(i) += q_point_weight;
+              }
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  count_quadrature_points(const int                             qp_data_index,
+                          PatchMap<dim, spacedim>              &patch_map,
+                          const InteractionPlan<dim, spacedim> &plan,
+                          const double                          point_weight,
+                          const double                          cell_weight)
+  {
+    // Like above, dispatch on the data type ourselves
+    if (patch_map.size() == 0)
+      return;
+
+    const tbox::Pointer<hier::Patch<spacedim>> patch = patch_map.get_patch(0);
+
+    const PatchDataTypeInfo info =
+      get_patch_data_type_info(patch, qp_data_index);
+    const bool is_cell = info.patch_type == SAMRAIPatchType::Cell;
+    const bool int_data =
+      is_cell && info.field_type == SAMRAIFieldType::Int;
+    const bool float_data =
+      is_cell && info.field_type == SAMRAIFieldType::Float;
+    const bool double_data =
+      is_cell && info.field_type == SAMRAIFieldType::Double;
+
+    if (int_data)
+      count_quadrature_points_plan_internal<dim, spacedim, int>(
+        qp_data_index, patch_map, plan, point_weight, cell_weight);
+    else if (float_data)
+      count_quadrature_points_plan_internal<dim, spacedim, float>(
+        qp_data_index, patch_map, plan, point_weight, cell_weight);
+    else if (double_data)
+      count_quadrature_points_plan_internal<dim, spacedim, double>(
+        qp_data_index, patch_map, plan, point_weight, cell_weight);
+    else
+      Assert(false, ExcNotImplemented());
+  }
+
+
+
   template <int dim, int spacedim, typename Scalar>
   void
   count_nodes_internal(const int                     node_count_data_index,
                        NodalPatchMap<dim, spacedim> &nodal_patch_map,
-                       const Vector<double>         &position)
+                       const Vector<double>         &position,
+                       const double                  node_weight)
   {
+    std::vector<double>        position_buffer;
+    std::vector<int>           indices;
+    std::vector<unsigned char> inside;
     for (std::size_t patch_n = 0; patch_n < nodal_patch_map.size(); ++patch_n)
       {
         std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
@@ -348,35 +1851,39 @@ namespace fdl
                ExcMessage("unallocated node count patch index"));
         tbox::Pointer<pdat::CellData<spacedim, Scalar>> node_count_data =
           patch->getPatchData(node_count_data_index);
-        Assert(node_count_data, ExcMessage("Type mismatch"));
-        check_depth<spacedim>(node_count_data, 1);
-        const hier::Box<spacedim> &patch_box = patch->getBox();
-        tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
-          patch->getPatchGeometry();
-        Assert(patch_geom, ExcMessage("Type mismatch"));
-
-        for (auto it = dofs.begin_intervals(); it != dofs.end_intervals(); ++it)
-          {
-            const auto nodes_begin = *it->begin() / spacedim;
-            const auto n_nodes     = (it->end() - it->begin()) / spacedim;
-            const auto position_view =
-              make_array_view(position.begin() + nodes_begin * spacedim,
-                              position.begin() +
-                                (nodes_begin + n_nodes) * spacedim);
-            for (std::ptrdiff_t node_n = 0; node_n < n_nodes; ++node_n)
+        Assert(node_count_data, ExcMessage("Type mismatch"));
+        check_depth<spacedim>(node_count_data, 1);
+        const hier::Box<spacedim> &patch_box = patch->getBox();
+
+        const auto count = [&](const ArrayView<const double> &position_view)
+        {
+          compute_cell_indices(position_view, patch, indices);
+          contains(patch_box, indices, inside);
+          for (std::size_t node_n = 0; node_n < inside.size(); ++node_n)
+            if (inside[node_n])
               {
-                Point<spacedim> node;
+                hier::Index<spacedim> i;
                 for (unsigned int d = 0; d < spacedim; ++d)
-                  node[d] = position_view[spacedim * node_n + d];
-
-                const hier::Index<spacedim> i =
-                  IBTK::IndexUtilities::getCellIndex(node,
-                                                     patch_geom,
-                                                     patch_box);
-                if (patch_box.contains(i))
-                  (*node_count_data)(i) += Scalar(1);
+                  i(d) = indices[spacedim * node_n + d];
+                (*node_count_data)(i) += Scalar(node_weight);
               }
+        };
+
+        if (nodal_patch_map.packs_nodes() && dofs.n_intervals() > 1)
+          {
+            nodal_patch_map.pack(patch_n, position, position_buffer);
+            count(make_array_view(position_buffer));
           }
+        else
+          for (auto it = dofs.begin_intervals(); it != dofs.end_intervals();
+               ++it)
+            {
+              const auto nodes_begin = *it->begin() / spacedim;
+              const auto n_nodes     = (it->end() - it->begin()) / spacedim;
+              count(make_array_view(position.begin() + nodes_begin * spacedim,
+                                    position.begin() +
+                                      (nodes_begin + n_nodes) * spacedim));
+            }
       }
   }
 
@@ -386,7 +1893,8 @@ namespace fdl
   void
   count_nodes(const int                     node_count_data_index,
               NodalPatchMap<dim, spacedim> &nodal_patch_map,
-              const Vector<double>         &position)
+              const Vector<double>         &position,
+              const double                  node_weight)
   {
     // SAMRAI doesn't offer a way to dispatch on data type so we have to do it
     // ourselves
@@ -399,25 +1907,31 @@ namespace fdl
         const tbox::Pointer<hier::Patch<spacedim>> patch =
           nodal_patch_map[0].second;
 
-        const tbox::Pointer<pdat::CellData<spacedim, int>> int_data =
-          patch->getPatchData(node_count_data_index);
-        const tbox::Pointer<pdat::CellData<spacedim, float>> float_data =
-          patch->getPatchData(node_count_data_index);
-        const tbox::Pointer<pdat::CellData<spacedim, double>> double_data =
-          patch->getPatchData(node_count_data_index);
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch, node_count_data_index);
+        const bool is_cell = info.patch_type == SAMRAIPatchType::Cell;
+        const bool int_data =
+          is_cell && info.field_type == SAMRAIFieldType::Int;
+        const bool float_data =
+          is_cell && info.field_type == SAMRAIFieldType::Float;
+        const bool double_data =
+          is_cell && info.field_type == SAMRAIFieldType::Double;
 
         if (int_data)
           count_nodes_internal<dim, spacedim, int>(node_count_data_index,
                                                    nodal_patch_map,
-                                                   position);
+                                                   position,
+                                                   node_weight);
         else if (float_data)
           count_nodes_internal<dim, spacedim, float>(node_count_data_index,
                                                      nodal_patch_map,
-                                                     position);
+                                                     position,
+                                                     node_weight);
         else if (double_data)
           count_nodes_internal<dim, spacedim, double>(node_count_data_index,
                                                       nodal_patch_map,
-                                                      position);
+                                                      position,
+                                                      node_weight);
         else
           Assert(false, ExcFDLNotImplemented());
       }
@@ -425,7 +1939,235 @@ namespace fdl
 
 
 
-  template <int dim, int spacedim, typename patch_type>
+  /**
+   * Threaded version of compute_projection_rhs_internal().
+   *
+   * The work is done in four phases:
+   * <ol>
+   *   <li>the quadrature points of each work item (a chunk of the cells of a
+   *   patch) are computed,</li>
+   *   <li>the values at the quadrature points of each patch are interpolated
+   *   with a single call to ib_interpolate(),</li>
+   *   <li>the cell right-hand sides of each work item are computed, and</li>
+   *   <li>the cell right-hand sides are added into @p rhs.</li>
+   * </ol>
+   * Work items and patches are scheduled dynamically so threads which finish
+   * early take more work. SAMRAI's reference counting is not thread-safe so
+   * each patch is only ever accessed by one thread at a time: only the finite
+   * element computations are split into work items. The last phase adds the
+   * cell right-hand sides in the same order as the serial version so the
+   * result does not depend on the number of threads.
+   */
+  template <int dim, int spacedim, typename patch_type, typename Number>
+  void
+  compute_projection_rhs_threaded_internal(
+    const std::string                  &kernel_name,
+    const int                           data_index,
+    const PatchMap<dim, spacedim>      &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    Vector<Number>                     &rhs,
+    const unsigned int                  n_threads)
+  {
+    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
+    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    const unsigned int                  n_components  = fe.n_components();
+
+    const CellRHSIntegrator<dim, spacedim> integrator(fe, quadratures);
+
+    // Set up the work items and the offsets of each cell's quadrature points
+    // (indexed by cell number, counting cells of all patches in order):
+    std::vector<InterpolationWorkItem> work_items;
+    std::vector<std::size_t>           patch_cell_offsets(1, 0);
+    std::vector<std::size_t>           cell_q_offsets(1, 0);
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::size_t n_cells = patch_map.n_cells(patch_n);
+        for (std::size_t i = 0; i < n_cells; ++i)
+          {
+            const auto cell = patch_map.get_cell(patch_n, i);
+            cell_q_offsets.push_back(
+              cell_q_offsets.back() +
+              quadratures[quadrature_indices[cell->active_cell_index()]]
+                .size());
+          }
+        for (std::size_t begin = 0; begin < n_cells;
+             begin += interpolation_chunk_size)
+          work_items.push_back(
+            {patch_n,
+             begin,
+             std::min(begin + interpolation_chunk_size, n_cells)});
+        patch_cell_offsets.push_back(patch_cell_offsets.back() + n_cells);
+      }
+
+    // Interpolate on the most expensive patches first so that the cheap ones
+    // fill in the gaps at the end:
+    std::vector<unsigned int> patch_order(patch_map.size());
+    std::iota(patch_order.begin(), patch_order.end(), 0u);
+    const auto n_patch_points = [&](const unsigned int patch_n) {
+      return cell_q_offsets[patch_cell_offsets[patch_n + 1]] -
+             cell_q_offsets[patch_cell_offsets[patch_n]];
+    };
+    std::stable_sort(patch_order.begin(),
+                     patch_order.end(),
+                     [&](const unsigned int a, const unsigned int b) {
+                       return n_patch_points(a) > n_patch_points(b);
+                     });
+
+    std::vector<Point<spacedim>> q_points(cell_q_offsets.back());
+    std::vector<double>          q_values(n_components * cell_q_offsets.back());
+    std::vector<double>          cell_rhs_values(dofs_per_cell *
+                                        patch_cell_offsets.back());
+
+#ifdef _OPENMP
+#  pragma omp parallel num_threads(n_threads)
+#endif
+    {
+      HardwareCounterRegion region("fdl::compute_projection_rhs()");
+      // CellRHSIntegrator uses internal scratch space so each thread needs
+      // its own copy
+      const CellRHSIntegrator<dim, spacedim> thread_integrator(integrator);
+      boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>,
+                                     16>
+        all_position_fe_values;
+      boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>,
+                                     16>
+        all_rhs_fe_values;
+      for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+        {
+          all_position_fe_values.emplace_back(
+            std::make_unique<FEValues<dim, spacedim>>(
+              position_mapping,
+              fe,
+              quadratures[quad_n],
+              update_quadrature_points));
+          all_rhs_fe_values.emplace_back(
+            std::make_unique<FEValues<dim, spacedim>>(
+              mapping,
+              fe,
+              quadratures[quad_n],
+              thread_integrator.get_update_flags(quad_n)));
+        }
+      Vector<double> cell_rhs(dofs_per_cell);
+
+      // 1. Compute quadrature points:
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+      for (std::size_t item_n = 0; item_n < work_items.size(); ++item_n)
+        {
+          const InterpolationWorkItem &item = work_items[item_n];
+          auto iter = patch_map.begin(item.patch_n, dof_handler) + item.begin;
+          for (std::size_t i = item.begin; i < item.end; ++i, ++iter)
+            {
+              const auto cell = *iter;
+              FEValues<dim, spacedim> &position_fe_values =
+                *all_position_fe_values
+                  [quadrature_indices[cell->active_cell_index()]];
+              position_fe_values.reinit(cell);
+              const std::vector<Point<spacedim>> &cell_q_points =
+                position_fe_values.get_quadrature_points();
+              std::copy(cell_q_points.begin(),
+                        cell_q_points.end(),
+                        q_points.begin() +
+                          cell_q_offsets[patch_cell_offsets[item.patch_n] + i]);
+            }
+        }
+
+      // 2. Interpolate at quadrature points:
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+      for (unsigned int order_n = 0; order_n < patch_order.size(); ++order_n)
+        {
+          const unsigned int patch_n = patch_order[order_n];
+          const std::size_t  n_points = n_patch_points(patch_n);
+          if (n_points == 0)
+            continue;
+          auto patch = patch_map.get_patch(patch_n);
+          Assert(patch->checkAllocated(data_index),
+                 ExcMessage("unallocated data patch index"));
+          tbox::Pointer<patch_type> patch_data =
+            patch->getPatchData(data_index);
+          check_depth<spacedim>(patch_data, n_components);
+
+          static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                        "FORTRAN routines assume we are packed");
+          const std::size_t first_point =
+            cell_q_offsets[patch_cell_offsets[patch_n]];
+          const auto position_data =
+            reinterpret_cast<const double *>(q_points.data() + first_point);
+          double *const values_data =
+            q_values.data() + n_components * first_point;
+          ib_interpolate(values_data,
+                         n_components * n_points,
+                         n_components,
+                         position_data,
+                         spacedim * n_points,
+                         spacedim,
+                         patch_data,
+                         patch,
+                         patch->getBox(),
+                         kernel_name);
+        }
+
+      // 3. Compute cell right-hand sides:
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+      for (std::size_t item_n = 0; item_n < work_items.size(); ++item_n)
+        {
+          const InterpolationWorkItem &item = work_items[item_n];
+          auto iter = patch_map.begin(item.patch_n, dof_handler) + item.begin;
+          for (std::size_t i = item.begin; i < item.end; ++i, ++iter)
+            {
+              const auto cell = *iter;
+              const auto quad_index =
+                quadrature_indices[cell->active_cell_index()];
+              FEValues<dim, spacedim> &rhs_fe_values =
+                *all_rhs_fe_values[quad_index];
+              rhs_fe_values.reinit(cell);
+
+              const std::size_t cell_n = patch_cell_offsets[item.patch_n] + i;
+              thread_integrator.integrate(quad_index,
+                                          rhs_fe_values,
+                                          q_values.data() +
+                                            n_components *
+                                              cell_q_offsets[cell_n],
+                                          cell_rhs);
+              std::copy(cell_rhs.begin(),
+                        cell_rhs.end(),
+                        cell_rhs_values.begin() + dofs_per_cell * cell_n);
+            }
+        }
+    }
+
+    // 4. Add cell right-hand sides in the same order as the serial version:
+    const auto                           dof_table =
+      patch_map.get_dof_index_table(dof_handler);
+    Vector<double>                       cell_rhs(dofs_per_cell);
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        auto       iter = patch_map.begin(patch_n, dof_handler);
+        const auto end  = patch_map.end(patch_n, dof_handler);
+        for (std::size_t cell_n = patch_cell_offsets[patch_n]; iter != end;
+             ++iter, ++cell_n)
+          {
+            std::copy(cell_rhs_values.begin() + dofs_per_cell * cell_n,
+                      cell_rhs_values.begin() + dofs_per_cell * (cell_n + 1),
+                      cell_rhs.begin());
+            add_cell_rhs(*iter, dof_table, dof_indices, cell_rhs, rhs);
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim, typename patch_type, typename Number>
   void
   compute_projection_rhs_internal(
     const std::string                  &kernel_name,
@@ -436,13 +2178,35 @@ namespace fdl
     const std::vector<Quadrature<dim>> &quadratures,
     const DoFHandler<dim, spacedim>    &dof_handler,
     const Mapping<dim, spacedim>       &mapping,
-    Vector<double>                     &rhs)
+    Vector<Number>                     &rhs,
+    const unsigned int                  n_threads)
   {
     check_quadratures(quadrature_indices,
                       quadratures,
                       dof_handler.get_triangulation());
+    AssertThrow(n_threads > 0, ExcMessage("At least one thread is required."));
     const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
     const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    AssertThrow(fe.n_components() == 1 || fe.n_components() == spacedim,
+                ExcNotImplemented());
+#ifdef _OPENMP
+    if (n_threads > 1)
+      {
+        compute_projection_rhs_threaded_internal<dim, spacedim, patch_type>(
+          kernel_name,
+          data_index,
+          patch_map,
+          position_mapping,
+          quadrature_indices,
+          quadratures,
+          dof_handler,
+          mapping,
+          rhs,
+          n_threads);
+        return;
+      }
+#endif
+    HardwareCounterRegion region("fdl::compute_projection_rhs()");
     // TODO - do we need to assume something about the block structure of the
     // FE?
 
@@ -455,20 +2219,28 @@ namespace fdl
       all_position_fe_values;
     boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
       all_rhs_fe_values;
-    for (const Quadrature<dim> &quad : quadratures)
+    const CellRHSIntegrator<dim, spacedim> integrator(fe, quadratures);
+    for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
       {
         all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe, quad, update_quadrature_points));
+          std::make_unique<FEValues<dim, spacedim>>(position_mapping,
+                                                    fe,
+                                                    quadratures[quad_n],
+                                                    update_quadrature_points));
         all_rhs_fe_values.emplace_back(
           std::make_unique<FEValues<dim, spacedim>>(
-            mapping, fe, quad, update_JxW_values | update_values));
+            mapping,
+            fe,
+            quadratures[quad_n],
+            integrator.get_update_flags(quad_n)));
       }
 
     Vector<double>      cell_rhs(dofs_per_cell);
     std::vector<double> rhs_values;
 
     std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+
+    const auto dof_table = patch_map.get_dof_index_table(dof_handler);
     for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
       {
         auto patch = patch_map.get_patch(patch_n);
@@ -492,92 +2264,46 @@ namespace fdl
               *all_position_fe_values[quad_index];
             rhs_fe_values.reinit(cell);
             position_fe_values.reinit(cell);
-            rhs_values.resize(
-              position_fe_values.get_quadrature_points().size());
             Assert(rhs_fe_values.get_quadrature() ==
                      position_fe_values.get_quadrature(),
                    ExcFDLInternalError());
 
-            cell_rhs = 0.0;
-            cell->get_dof_indices(dof_indices);
             const std::vector<Point<spacedim>> &q_points =
               position_fe_values.get_quadrature_points();
             const unsigned int n_q_points = q_points.size();
             rhs_values.resize(fe.n_components() * n_q_points);
 
-
-            // Interpolate at quadrature points:
-#if 1
-            // Interpolate values from the patch. This LEInteractor call could
-            // be improved - we don't need to look up certain things on each
-            // element
+            // Interpolate values from the patch at the quadrature points:
             static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
                           "FORTRAN routines assume we are packed");
             const auto position_data =
               reinterpret_cast<const double *>(q_points.data());
 
             std::fill(rhs_values.begin(), rhs_values.end(), 0.0);
-            IBTK::LEInteractor::interpolate(rhs_values.data(),
-                                            rhs_values.size(),
-                                            fe.n_components(),
-                                            position_data,
-                                            q_points.size() * spacedim,
-                                            spacedim,
-                                            patch_data,
-                                            patch,
-                                            patch->getBox(),
-                                            kernel_name);
-#else
-            std::fill(rhs_values.begin(), rhs_values.end(), 1.0);
-#endif
-
-            for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
-              {
-                if (fe.n_components() == 1)
-                  {
-                    AssertIndexRange(qp_n, rhs_values.size());
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      {
-                        cell_rhs[i] += rhs_fe_values.shape_value(i, qp_n) *
-                                       rhs_values[qp_n] *
-                                       rhs_fe_values.JxW(qp_n);
-                      }
-                  }
-                else if (fe.n_components() == spacedim)
-                  {
-                    Tensor<1, spacedim> qp;
-                    for (unsigned int d = 0; d < spacedim; ++d)
-                      {
-                        AssertIndexRange(qp_n * spacedim + d,
-                                         rhs_values.size());
-                        qp[d] = rhs_values[qp_n * spacedim + d];
-                      }
-
-                    // TODO - this only works with primitive elements
-                    // TODO - perhaps its worth unrolling this loop?
-                    // dofs_per_cell is probably 12, 30, or 45.
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      {
-                        const unsigned int component =
-                          fe.system_to_component_index(i).first;
-                        cell_rhs[i] += rhs_fe_values.shape_value(i, qp_n) *
-                                       qp[component] * rhs_fe_values.JxW(qp_n);
-                      }
-                  }
-                else
-                  {
-                    Assert(false, ExcNotImplemented());
-                  }
-              }
-
-            rhs.add(dof_indices, cell_rhs);
+            ib_interpolate(rhs_values.data(),
+                           rhs_values.size(),
+                           fe.n_components(),
+                           position_data,
+                           q_points.size() * spacedim,
+                           spacedim,
+                           patch_data,
+                           patch,
+                           patch->getBox(),
+                           kernel_name);
+
+            integrator.integrate(quad_index,
+                                 rhs_fe_values,
+                                 rhs_values.data(),
+                                 cell_rhs);
+
+            add_cell_rhs(cell, dof_table, dof_indices, cell_rhs, rhs);
           }
       }
   }
 
 
 
-  template <int dim, int spacedim>
+  template <int dim, int spacedim, typename Number>
   void
   compute_projection_rhs(const std::string                  &kernel_name,
                          const int                           data_index,
@@ -587,19 +2313,20 @@ namespace fdl
                          const std::vector<Quadrature<dim>> &quadratures,
                          const DoFHandler<dim, spacedim>    &dof_handler,
                          const Mapping<dim, spacedim>       &mapping,
-                         Vector<double>                     &rhs)
+                         Vector<Number>                     &rhs,
+                         const unsigned int                  n_threads)
   {
 #define ARGUMENTS                                                           \
   kernel_name, data_index, patch_map, position_mapping, quadrature_indices, \
-    quadratures, dof_handler, mapping, rhs
+    quadratures, dof_handler, mapping, rhs, n_threads
     if (patch_map.size() != 0)
       {
-        auto patch_data = patch_map.get_patch(0)->getPatchData(data_index);
-        auto pair       = extract_types(patch_data);
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch_map.get_patch(0), data_index);
 
-        AssertThrow(pair.second == SAMRAIFieldType::Double,
+        AssertThrow(info.field_type == SAMRAIFieldType::Double,
                     ExcNotImplemented());
-        switch (pair.first)
+        switch (info.patch_type)
           {
             case SAMRAIPatchType::Edge:
               compute_projection_rhs_internal<dim,
@@ -630,7 +2357,530 @@ namespace fdl
               break;
           }
       }
-#undef ARGUMENTS
+#undef ARGUMENTS
+  }
+
+  template <int dim, int spacedim, typename patch_type, typename Number>
+  void
+  compute_projection_rhs_plan_internal(
+    const std::string                    &kernel_name,
+    const int                             data_index,
+    const PatchMap<dim, spacedim>        &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    Vector<Number>                       &rhs)
+  {
+    HardwareCounterRegion region("fdl::compute_projection_rhs()[plan]");
+    check_quadratures(quadrature_indices,
+                      quadratures,
+                      dof_handler.get_triangulation());
+    check_plan(plan, patch_map);
+    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
+    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    const unsigned int                  n_components  = fe.n_components();
+    AssertThrow(n_components == 1 || n_components == spacedim,
+                ExcFDLNotImplemented());
+
+    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
+      all_rhs_fe_values;
+    const CellRHSIntegrator<dim, spacedim> integrator(fe, quadratures);
+
+    // If possible, skip FEValues entirely:
+    std::unique_ptr<ReferenceShapeValues<dim, spacedim>> reference_values;
+    const bool use_weights = use_plan_weights(plan, fe, mapping);
+    if (use_weights)
+      reference_values =
+        std::make_unique<ReferenceShapeValues<dim, spacedim>>(fe, quadratures);
+    else
+      for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+        all_rhs_fe_values.emplace_back(
+          std::make_unique<FEValues<dim, spacedim>>(
+            mapping,
+            fe,
+            quadratures[quad_n],
+            integrator.get_update_flags(quad_n)));
+
+    Vector<double>                       cell_rhs(dofs_per_cell);
+    std::vector<double>                  rhs_values;
+    std::vector<double>                  compressed_values;
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+
+    const bool use_compression = plan.is_compressed();
+    const auto dof_table       = patch_map.get_dof_index_table(dof_handler);
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::vector<Point<spacedim>> &q_points =
+          plan.patch_q_points[patch_n];
+        const std::vector<unsigned int> &offsets =
+          plan.patch_cell_offsets[patch_n];
+        if (q_points.size() == 0)
+          continue;
+
+        auto patch = patch_map.get_patch(patch_n);
+        Assert(patch->checkAllocated(data_index),
+               ExcMessage("unallocated data patch index"));
+        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_index);
+        check_depth<spacedim>(patch_data, n_components);
+
+        // Interpolate at every quadrature point (or, with compression, every
+        // representative point) on the patch at once:
+        static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                      "FORTRAN routines assume we are packed");
+        const std::vector<Point<spacedim>> &interpolation_points =
+          use_compression ? plan.patch_compressed_q_points[patch_n] : q_points;
+        std::vector<double> &interpolated_values =
+          use_compression ? compressed_values : rhs_values;
+        interpolated_values.resize(n_components * interpolation_points.size());
+        std::fill(interpolated_values.begin(), interpolated_values.end(), 0.0);
+        ib_interpolate(
+          interpolated_values.data(),
+          interpolated_values.size(),
+          n_components,
+          reinterpret_cast<const double *>(interpolation_points.data()),
+          interpolation_points.size() * spacedim,
+          spacedim,
+          patch_data,
+          patch,
+          patch->getBox(),
+          kernel_name);
+        if (use_compression)
+          {
+            const std::vector<unsigned int> &representatives =
+              plan.patch_q_point_representatives[patch_n];
+            rhs_values.resize(n_components * q_points.size());
+            for (std::size_t qp_n = 0; qp_n < q_points.size(); ++qp_n)
+              for (unsigned int c = 0; c < n_components; ++c)
+                rhs_values[qp_n * n_components + c] =
+                  compressed_values[representatives[qp_n] * n_components + c];
+          }
+
+        auto       iter = patch_map.begin(patch_n, dof_handler);
+        const auto end  = patch_map.end(patch_n, dof_handler);
+        Assert(std::size_t(end - iter) + 1 == offsets.size(),
+               ExcMessage("The interaction plan should have been computed "
+                          "with the provided PatchMap."));
+        for (unsigned int cell_n = 0; iter != end; ++iter, ++cell_n)
+          {
+            const auto cell = *iter;
+            const auto quad_index =
+              quadrature_indices[cell->active_cell_index()];
+            const unsigned int offset     = offsets[cell_n];
+            const unsigned int n_q_points = offsets[cell_n + 1] - offset;
+            const double *const cell_values =
+              rhs_values.data() + offset * n_components;
+            if (use_weights)
+              {
+                const double *const JxW =
+                  plan.patch_JxW[patch_n].data() + offset;
+                if (integrator.uses_sum_factorization(quad_index))
+                  integrator.integrate(
+                    quad_index, n_q_points, JxW, cell_values, cell_rhs);
+                else
+                  reference_values->integrate(quad_index,
+                                              JxW,
+                                              cell_values,
+                                              cell_rhs);
+              }
+            else
+              {
+                FEValues<dim, spacedim> &rhs_fe_values =
+                  *all_rhs_fe_values[quad_index];
+                rhs_fe_values.reinit(cell);
+                Assert(n_q_points == rhs_fe_values.n_quadrature_points,
+                       ExcFDLInternalError());
+                integrator.integrate(quad_index,
+                                     rhs_fe_values,
+                                     cell_values,
+                                     cell_rhs);
+              }
+
+            add_cell_rhs(cell, dof_table, dof_indices, cell_rhs, rhs);
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim, typename Number>
+  void
+  compute_projection_rhs(const std::string                    &kernel_name,
+                         const int                             data_index,
+                         const PatchMap<dim, spacedim>        &patch_map,
+                         const InteractionPlan<dim, spacedim> &plan,
+                         const std::vector<unsigned char> &quadrature_indices,
+                         const std::vector<Quadrature<dim>> &quadratures,
+                         const DoFHandler<dim, spacedim>    &dof_handler,
+                         const Mapping<dim, spacedim>       &mapping,
+                         Vector<Number>                     &rhs)
+  {
+#define ARGUMENTS                                                            \
+  kernel_name, data_index, patch_map, plan, quadrature_indices, quadratures, \
+    dof_handler, mapping, rhs
+    if (patch_map.size() != 0)
+      {
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch_map.get_patch(0), data_index);
+
+        AssertThrow(info.field_type == SAMRAIFieldType::Double,
+                    ExcFDLNotImplemented());
+        switch (info.patch_type)
+          {
+            case SAMRAIPatchType::Edge:
+              compute_projection_rhs_plan_internal<
+                dim,
+                spacedim,
+                pdat::EdgeData<spacedim, double>>(ARGUMENTS);
+              break;
+
+            case SAMRAIPatchType::Cell:
+              compute_projection_rhs_plan_internal<
+                dim,
+                spacedim,
+                pdat::CellData<spacedim, double>>(ARGUMENTS);
+              break;
+
+            case SAMRAIPatchType::Side:
+              compute_projection_rhs_plan_internal<
+                dim,
+                spacedim,
+                pdat::SideData<spacedim, double>>(ARGUMENTS);
+              break;
+
+            case SAMRAIPatchType::Node:
+              compute_projection_rhs_plan_internal<
+                dim,
+                spacedim,
+                pdat::NodeData<spacedim, double>>(ARGUMENTS);
+              break;
+          }
+      }
+#undef ARGUMENTS
+  }
+
+  namespace
+  {
+    // Interpolate patch data, whatever its type, at the provided points.
+    template <int spacedim>
+    void
+    interpolate_at_points(const std::string                    &kernel_name,
+                          const int                             data_index,
+                          tbox::Pointer<hier::Patch<spacedim>> &patch,
+                          const std::vector<Point<spacedim>>   &points,
+                          const unsigned int                    n_components,
+                          std::vector<double>                  &values)
+    {
+      Assert(patch->checkAllocated(data_index),
+             ExcMessage("unallocated data patch index"));
+      static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                    "FORTRAN routines assume we are packed");
+      values.resize(n_components * points.size());
+      std::fill(values.begin(), values.end(), 0.0);
+
+      const tbox::Pointer<hier::PatchData<spacedim>> data =
+        patch->getPatchData(data_index);
+      const PatchDataTypeInfo info =
+        get_patch_data_type_info(patch, data_index);
+      AssertThrow(info.field_type == SAMRAIFieldType::Double,
+                  ExcFDLNotImplemented());
+#define ARGUMENTS                                                           \
+  values.data(), values.size(), n_components,                               \
+    reinterpret_cast<const double *>(points.data()),                        \
+    points.size() * spacedim, spacedim, patch_data, patch, patch->getBox(), \
+    kernel_name
+      switch (info.patch_type)
+        {
+          case SAMRAIPatchType::Edge:
+            {
+              tbox::Pointer<pdat::EdgeData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_interpolate(ARGUMENTS);
+              break;
+            }
+          case SAMRAIPatchType::Cell:
+            {
+              tbox::Pointer<pdat::CellData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_interpolate(ARGUMENTS);
+              break;
+            }
+          case SAMRAIPatchType::Side:
+            {
+              tbox::Pointer<pdat::SideData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_interpolate(ARGUMENTS);
+              break;
+            }
+          case SAMRAIPatchType::Node:
+            {
+              tbox::Pointer<pdat::NodeData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_interpolate(ARGUMENTS);
+              break;
+            }
+        }
+#undef ARGUMENTS
+    }
+  } // namespace
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_projection_rhs(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    const PatchMap<dim, spacedim>                        &patch_map,
+    const InteractionPlan<dim, spacedim>                 &plan,
+    const std::vector<unsigned char>                     &quadrature_indices,
+    const std::vector<Quadrature<dim>>                   &quadratures,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<Vector<double> *>                  &rhs)
+  {
+    const std::size_t n_fields = data_indices.size();
+    AssertThrow(dof_handlers.size() == n_fields &&
+                  mappings.size() == n_fields && rhs.size() == n_fields,
+                ExcMessage("Each field requires a data index, DoFHandler, "
+                           "Mapping, and rhs vector."));
+    if (n_fields == 0)
+      return;
+    check_plan(plan, patch_map);
+
+    // Set up FEValues objects. Fields which use the same FE and Mapping share
+    // them.
+    std::vector<unsigned int> field_to_fe_values(n_fields);
+    std::vector<std::vector<std::unique_ptr<FEValues<dim, spacedim>>>>
+                                   all_rhs_fe_values;
+    std::vector<std::unique_ptr<CellRHSIntegrator<dim, spacedim>>>
+      integrators;
+    // Groups which can use precomputed JxW values have no FEValues objects
+    std::vector<std::unique_ptr<ReferenceShapeValues<dim, spacedim>>>
+      all_reference_values;
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      {
+        Assert(dof_handlers[field_n] && mappings[field_n] && rhs[field_n],
+               ExcMessage("pointers should not be nullptr"));
+        const FiniteElement<dim, spacedim> &fe =
+          dof_handlers[field_n]->get_fe();
+        check_quadratures(quadrature_indices,
+                          quadratures,
+                          dof_handlers[field_n]->get_triangulation());
+        AssertThrow(fe.n_components() == 1 || fe.n_components() == spacedim,
+                    ExcFDLNotImplemented());
+
+        std::size_t other_n = 0;
+        for (; other_n < field_n; ++other_n)
+          if (dof_handlers[other_n]->get_fe() == fe &&
+              mappings[other_n] == mappings[field_n])
+            break;
+        if (other_n < field_n)
+          {
+            field_to_fe_values[field_n] = field_to_fe_values[other_n];
+            continue;
+          }
+
+        field_to_fe_values[field_n] = all_rhs_fe_values.size();
+        all_rhs_fe_values.emplace_back();
+        integrators.emplace_back(
+          std::make_unique<CellRHSIntegrator<dim, spacedim>>(fe, quadratures));
+        all_reference_values.emplace_back();
+        if (use_plan_weights(plan, fe, *mappings[field_n]))
+          all_reference_values.back() =
+            std::make_unique<ReferenceShapeValues<dim, spacedim>>(fe,
+                                                                  quadratures);
+        else
+          for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+            all_rhs_fe_values.back().emplace_back(
+              std::make_unique<FEValues<dim, spacedim>>(
+                *mappings[field_n],
+                fe,
+                quadratures[quad_n],
+                integrators.back()->get_update_flags(quad_n)));
+      }
+
+    std::vector<std::vector<double>>                  field_values(n_fields);
+    std::vector<Vector<double>>                       cell_rhs(n_fields);
+    std::vector<std::vector<types::global_dof_index>> dof_indices(n_fields);
+
+    std::vector<ArrayView<const types::global_dof_index>> dof_tables(n_fields);
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      {
+        const unsigned int dofs_per_cell =
+          dof_handlers[field_n]->get_fe().dofs_per_cell;
+        cell_rhs[field_n].reinit(dofs_per_cell);
+        dof_indices[field_n].resize(dofs_per_cell);
+        dof_tables[field_n] =
+          patch_map.get_dof_index_table(*dof_handlers[field_n]);
+      }
+    const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
+
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::vector<Point<spacedim>> &q_points =
+          plan.patch_q_points[patch_n];
+        const std::vector<unsigned int> &offsets =
+          plan.patch_cell_offsets[patch_n];
+        if (q_points.size() == 0)
+          continue;
+
+        // Interpolate every field at every quadrature point on the patch:
+        auto patch = patch_map.get_patch(patch_n);
+        for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+          interpolate_at_points(kernel_name,
+                                data_indices[field_n],
+                                patch,
+                                q_points,
+                                dof_handlers[field_n]->get_fe().n_components(),
+                                field_values[field_n]);
+
+        // Then assemble each field on each cell:
+        auto       iter = patch_map.begin(patch_n, *dof_handlers[0]);
+        const auto end  = patch_map.end(patch_n, *dof_handlers[0]);
+        Assert(std::size_t(end - iter) + 1 == offsets.size(),
+               ExcMessage("The interaction plan should have been computed "
+                          "with the provided PatchMap."));
+        for (unsigned int cell_n = 0; iter != end; ++iter, ++cell_n)
+          {
+            const auto         cell   = *iter;
+            const unsigned int offset = offsets[cell_n];
+            const unsigned int n_q_points = offsets[cell_n + 1] - offset;
+            const auto         quad_index =
+              quadrature_indices[cell->active_cell_index()];
+
+            // FEValues only needs to be reinitialized once per cell:
+            std::vector<bool> reinitialized(all_rhs_fe_values.size(), false);
+            for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+              {
+                const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                  field_cell(&tria,
+                             cell->level(),
+                             cell->index(),
+                             dof_handlers[field_n]);
+                const unsigned int fe_values_n = field_to_fe_values[field_n];
+                const unsigned int n_components =
+                  dof_handlers[field_n]->get_fe().n_components();
+                const double *const cell_values =
+                  field_values[field_n].data() + offset * n_components;
+                Vector<double> &field_cell_rhs = cell_rhs[field_n];
+                const CellRHSIntegrator<dim, spacedim> &integrator =
+                  *integrators[fe_values_n];
+                if (all_reference_values[fe_values_n])
+                  {
+                    const double *const JxW =
+                      plan.patch_JxW[patch_n].data() + offset;
+                    if (integrator.uses_sum_factorization(quad_index))
+                      integrator.integrate(quad_index,
+                                           n_q_points,
+                                           JxW,
+                                           cell_values,
+                                           field_cell_rhs);
+                    else
+                      all_reference_values[fe_values_n]->integrate(
+                        quad_index, JxW, cell_values, field_cell_rhs);
+                  }
+                else
+                  {
+                    FEValues<dim, spacedim> &rhs_fe_values =
+                      *all_rhs_fe_values[fe_values_n][quad_index];
+                    if (!reinitialized[fe_values_n])
+                      {
+                        rhs_fe_values.reinit(field_cell);
+                        reinitialized[fe_values_n] = true;
+                      }
+                    Assert(n_q_points == rhs_fe_values.n_quadrature_points,
+                           ExcFDLInternalError());
+                    integrator.integrate(quad_index,
+                                         rhs_fe_values,
+                                         cell_values,
+                                         field_cell_rhs);
+                  }
+
+                add_cell_rhs(field_cell,
+                             dof_tables[field_n],
+                             dof_indices[field_n],
+                             field_cell_rhs,
+                             *rhs[field_n]);
+              }
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim, typename Number>
+  void
+  compute_projection_rhs(const InteractionOperator<dim, spacedim> &op,
+                         const PatchMap<dim, spacedim>            &patch_map,
+                         Vector<Number>                           &rhs)
+  {
+    HardwareCounterRegion region("fdl::compute_projection_rhs()[operator]");
+    Assert(!op.empty(),
+           ExcMessage("The interaction operator should be computed first."));
+    Assert(op.patch_column_offsets.size() == patch_map.size(),
+           ExcMessage("The interaction operator should have been computed "
+                      "with the provided PatchMap."));
+    const DoFHandler<dim, spacedim> &dof_handler = *op.dof_handler;
+    const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+    const unsigned int n_components  = op.component_dofs.size();
+
+    Vector<double>                       cell_rhs(dofs_per_cell);
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+
+    const auto dof_table = patch_map.get_dof_index_table(dof_handler);
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::vector<int> &columns = op.patch_columns[patch_n];
+        if (columns.size() == 0)
+          continue;
+        const std::vector<unsigned int> &column_offsets =
+          op.patch_column_offsets[patch_n];
+        const std::vector<std::size_t> &value_offsets =
+          op.patch_value_offsets[patch_n];
+        const std::vector<double> &values = op.patch_values[patch_n];
+        const std::vector<double *> pointers =
+          get_component_pointers(patch_map.get_patch(patch_n),
+                                 op.data_index,
+                                 n_components);
+
+        auto       iter = patch_map.begin(patch_n, dof_handler);
+        const auto end  = patch_map.end(patch_n, dof_handler);
+        Assert(std::size_t(end - iter) * n_components + 1 ==
+                 column_offsets.size(),
+               ExcMessage("The interaction operator should have been computed "
+                          "with the provided PatchMap."));
+        for (unsigned int block_n = 0; iter != end; ++iter)
+          {
+            const auto cell = *iter;
+            for (unsigned int c = 0; c < n_components; ++c, ++block_n)
+              {
+                const std::vector<unsigned int> &dofs = op.component_dofs[c];
+                const int *const    block_columns =
+                  columns.data() + column_offsets[block_n];
+                const unsigned int  n_columns =
+                  column_offsets[block_n + 1] - column_offsets[block_n];
+                const double *const block =
+                  values.data() + value_offsets[block_n];
+                const double *const data = pointers[c];
+                for (unsigned int r = 0; r < dofs.size(); ++r)
+                  {
+                    const double *const row = block + r * n_columns;
+                    double              sum = 0.0;
+                    for (unsigned int k = 0; k < n_columns; ++k)
+                      sum += row[k] * data[block_columns[k]];
+                    cell_rhs[dofs[r]] = sum;
+                  }
+              }
+
+            add_cell_rhs(cell, dof_table, dof_indices, cell_rhs, rhs);
+          }
+      }
   }
 
   template <int dim, int spacedim, typename patch_type>
@@ -640,8 +2890,11 @@ namespace fdl
     const int                           data_index,
     const NodalPatchMap<dim, spacedim> &patch_map,
     const Vector<double>               &position,
-    Vector<double>                     &interpolated_values)
+    Vector<double>                     &interpolated_values,
+    const unsigned int                  n_threads,
+    const bool                          interpolate_from_owners)
   {
+    AssertThrow(n_threads > 0, ExcMessage("At least one thread is required."));
     // Early exit if there is nothing to do (otherwise the modulus operations
     // fail)
     if (position.size() == 0 || interpolated_values.size() == 0)
@@ -660,59 +2913,121 @@ namespace fdl
     const auto n_components =
       interpolated_values.size() / (position.size() / spacedim);
 
-    // For debugging (and tracking points that are truly outside the domain) we
-    // set all values to -DBL_MAX. If the points are in the domain they will get
-    // set to correct values later. The caller should decide what to do with
-    // values that do not get interpolated here (e.g., for points outside the
-    // domain the velocity should be zero).
+    // If we use owners then each node is interpolated by exactly one patch
+    // on one processor, so we start from zero and the caller can scatter with
+    // an add reduction. Nodes which are not interpolated (e.g., nodes outside
+    // the domain) are then zero.
     //
-    // We scatter with a max reduction to resolve any duplicated interpolated
-    // values.
+    // Otherwise, for debugging (and tracking points that are truly outside the
+    // domain) we set all values to -DBL_MAX. If the points are in the domain
+    // they will get set to correct values later. The caller should decide what
+    // to do with values that do not get interpolated here (e.g., for points
+    // outside the domain the velocity should be zero). In this case we scatter
+    // with a max reduction to resolve any duplicated interpolated values.
+    const bool use_owners = interpolate_from_owners && patch_map.has_owners();
     std::fill(interpolated_values.begin(),
               interpolated_values.end(),
-              std::numeric_limits<double>::lowest());
-
-    for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
-      {
-        std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
-          patch_map[patch_n];
-        const IndexSet                       &dofs  = p.first;
-        tbox::Pointer<hier::Patch<spacedim>> &patch = p.second;
-        Assert(patch->checkAllocated(data_index),
-               ExcMessage("unallocated data patch index"));
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_index);
-        Assert(patch_data, ExcMessage("Type mismatch"));
-        check_depth<spacedim>(patch_data, n_components);
+              use_owners ? 0.0 : std::numeric_limits<double>::lowest());
+
+    // With owners each node is interpolated by exactly one patch, so
+    // different patches write to different entries of interpolated_values
+    // and may be handled concurrently. Like compute_spread(), each patch is
+    // handled by exactly one thread (SAMRAI's reference counting is not
+    // thread-safe) so the result does not depend on the number of threads.
+    // Without owners patches may overlap, so always use one thread.
+#ifdef _OPENMP
+#  pragma omp parallel num_threads(n_threads) if (n_threads > 1 && use_owners)
+#endif
+    {
+      HardwareCounterRegion region("fdl::compute_nodal_interpolation()");
 
-        for (auto it = dofs.begin_intervals(); it != dofs.end_intervals(); ++it)
-          {
-            const auto nodes_begin = *it->begin() / spacedim;
-            const auto n_nodes     = (it->end() - it->begin()) / spacedim;
-            const auto position_view =
-              make_array_view(position.begin() + nodes_begin * spacedim,
-                              position.begin() +
-                                (nodes_begin + n_nodes) * spacedim);
-            Assert(position_view.size() % spacedim == 0, ExcFDLInternalError());
-            auto values_view =
-              make_array_view(interpolated_values.begin() +
-                                nodes_begin * n_components,
-                              interpolated_values.begin() +
-                                (nodes_begin + n_nodes) * n_components);
-            Assert(values_view.size() % n_components == 0,
-                   ExcFDLInternalError());
+      std::vector<double> position_buffer;
+      std::vector<double> values_buffer;
 
-            IBTK::LEInteractor::interpolate(values_view.data(),
-                                            values_view.size(),
-                                            n_components,
-                                            position_view.data(),
-                                            position_view.size(),
-                                            spacedim,
-                                            patch_data,
-                                            patch,
-                                            patch->getBox(),
-                                            kernel_name);
-          }
-      }
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+      for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        {
+          std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>>
+            p = patch_map[patch_n];
+          const IndexSet &dofs =
+            use_owners ? patch_map.get_owned_dofs(patch_n) : p.first;
+          tbox::Pointer<hier::Patch<spacedim>> &patch = p.second;
+          // Owned nodes may have moved out of their patch since the last
+          // regrid. The caller checks that they are still within one cell of
+          // it, so also interpolate in the first layer of ghost cells.
+          hier::Box<spacedim> box = patch->getBox();
+          if (use_owners)
+            box.grow(hier::IntVector<spacedim>(1));
+          Assert(patch->checkAllocated(data_index),
+                 ExcMessage("unallocated data patch index"));
+          tbox::Pointer<patch_type> patch_data =
+            patch->getPatchData(data_index);
+          Assert(patch_data, ExcMessage("Type mismatch"));
+          check_depth<spacedim>(patch_data, n_components);
+
+          // Gather fragmented patches into contiguous buffers so that we
+          // only call the kernel once. Values which are not interpolated keep
+          // their initial value, so we need to pack the values too.
+          if (patch_map.packs_nodes() && dofs.n_intervals() > 1)
+            {
+              patch_map.pack(patch_n, position, position_buffer, use_owners);
+              if (use_owners)
+                values_buffer.assign(position_buffer.size() / spacedim *
+                                       n_components,
+                                     0.0);
+              else
+                patch_map.pack(patch_n, interpolated_values, values_buffer);
+              ib_interpolate(values_buffer.data(),
+                             values_buffer.size(),
+                             n_components,
+                             position_buffer.data(),
+                             position_buffer.size(),
+                             spacedim,
+                             patch_data,
+                             patch,
+                             box,
+                             kernel_name);
+              patch_map.unpack(patch_n,
+                               values_buffer,
+                               interpolated_values,
+                               use_owners);
+              continue;
+            }
+
+          for (auto it = dofs.begin_intervals(); it != dofs.end_intervals();
+               ++it)
+            {
+              const auto nodes_begin = *it->begin() / spacedim;
+              const auto n_nodes     = (it->end() - it->begin()) / spacedim;
+              const auto position_view =
+                make_array_view(position.begin() + nodes_begin * spacedim,
+                                position.begin() +
+                                  (nodes_begin + n_nodes) * spacedim);
+              Assert(position_view.size() % spacedim == 0,
+                     ExcFDLInternalError());
+              auto values_view =
+                make_array_view(interpolated_values.begin() +
+                                  nodes_begin * n_components,
+                                interpolated_values.begin() +
+                                  (nodes_begin + n_nodes) * n_components);
+              Assert(values_view.size() % n_components == 0,
+                     ExcFDLInternalError());
+
+              ib_interpolate(values_view.data(),
+                             values_view.size(),
+                             n_components,
+                             position_view.data(),
+                             position_view.size(),
+                             spacedim,
+                             patch_data,
+                             patch,
+                             box,
+                             kernel_name);
+            }
+        }
+    }
   }
 
   template <int dim, int spacedim>
@@ -721,18 +3036,21 @@ namespace fdl
                               const int                           data_index,
                               const NodalPatchMap<dim, spacedim> &patch_map,
                               const Vector<double>               &position,
-                              Vector<double> &interpolated_values)
+                              Vector<double>     &interpolated_values,
+                              const unsigned int n_threads,
+                              const bool         use_owners)
   {
-#define ARGUMENTS \
-  kernel_name, data_index, patch_map, position, interpolated_values
+#define ARGUMENTS                                                    \
+  kernel_name, data_index, patch_map, position, interpolated_values, \
+    n_threads, use_owners
     if (patch_map.size() != 0)
       {
-        auto patch_data = patch_map[0].second->getPatchData(data_index);
-        auto pair       = extract_types(patch_data);
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch_map[0].second, data_index);
 
-        AssertThrow(pair.second == SAMRAIFieldType::Double,
+        AssertThrow(info.field_type == SAMRAIFieldType::Double,
                     ExcFDLNotImplemented());
-        switch (pair.first)
+        switch (info.patch_type)
           {
             case SAMRAIPatchType::Edge:
               compute_nodal_interpolation_internal<
@@ -800,7 +3118,11 @@ namespace fdl
                                                              values);
   }
 
-  template <int dim, int spacedim, typename value_type, typename patch_type>
+  template <int dim,
+            int spacedim,
+            typename value_type,
+            typename patch_type,
+            typename Number>
   void
   compute_spread_internal(const std::string                &kernel_name,
                           const int                         data_index,
@@ -810,110 +3132,233 @@ namespace fdl
                           const std::vector<Quadrature<dim>> &quadratures,
                           const DoFHandler<dim, spacedim>    &dof_handler,
                           const Mapping<dim, spacedim>       &mapping,
-                          const Vector<double>               &solution)
+                          const Vector<Number>               &solution,
+                          const unsigned int                  n_threads,
+                          const bool                          sort_points,
+                          const double                        spread_cutoff,
+                          SpreadCutoffStatistics             *statistics)
   {
     check_quadratures(quadrature_indices,
                       quadratures,
                       dof_handler.get_triangulation());
+    AssertThrow(n_threads > 0, ExcMessage("At least one thread is required."));
     const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
-
-    // We probably don't need more than 16 quadrature rules
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_position_fe_values;
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_solution_fe_values;
-    for (const Quadrature<dim> &quad : quadratures)
+    // the number of components is determined at run time so use a normal
+    // assertion
+    AssertThrow(sizeof(value_type) == sizeof(double) * fe.n_components(),
+                ExcMessage("FORTRAN routines assume we are packed"));
+
+    // With a cutoff we compute the values on every patch before spreading
+    // anything since the threshold depends on all of them:
+    const bool use_cutoff = spread_cutoff > 0.0;
+    std::vector<std::vector<Point<spacedim>>> cutoff_patch_points;
+    std::vector<std::vector<value_type>>      cutoff_patch_values;
+    std::vector<double>                       patch_max_magnitudes;
+    std::vector<SpreadCutoffStatistics>       patch_statistics;
+    if (use_cutoff)
       {
-        all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe, quad, update_quadrature_points));
-        all_solution_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            mapping, fe, quad, update_JxW_values | update_values));
+        cutoff_patch_points.resize(patch_map.size());
+        cutoff_patch_values.resize(patch_map.size());
+        patch_max_magnitudes.resize(patch_map.size(), 0.0);
+        patch_statistics.resize(patch_map.size());
       }
 
-    std::vector<value_type> cell_solution_values;
-    std::vector<double>     cell_solution(fe.dofs_per_cell);
+    // Patches do not share patch data (ghost regions are summed later by the
+    // caller) so different patches can be spread into concurrently. Each patch
+    // is always handled, in the same order, by exactly one thread, so the
+    // result does not depend on the number of threads.
+#ifdef _OPENMP
+#  pragma omp parallel num_threads(n_threads) if (n_threads > 1)
+#endif
+    {
+      HardwareCounterRegion region("fdl::compute_spread()");
+      // We probably don't need more than 16 quadrature rules
+      boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>,
+                                     16>
+        all_position_fe_values;
+      boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>,
+                                     16>
+        all_solution_fe_values;
+      for (const Quadrature<dim> &quad : quadratures)
+        {
+          all_position_fe_values.emplace_back(
+            std::make_unique<FEValues<dim, spacedim>>(
+              position_mapping, fe, quad, update_quadrature_points));
+          all_solution_fe_values.emplace_back(
+            std::make_unique<FEValues<dim, spacedim>>(
+              mapping, fe, quad, update_JxW_values | update_values));
+        }
 
-    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
-      {
-        auto patch = patch_map.get_patch(patch_n);
-        Assert(patch->checkAllocated(data_index),
-               ExcMessage("unallocated data patch index"));
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_index);
-        Assert(patch_data, ExcMessage("Type mismatch"));
-        check_depth<spacedim>(patch_data, fe.n_components());
+      std::vector<value_type>      cell_solution_values;
+      std::vector<double>          cell_solution(fe.dofs_per_cell);
+      std::vector<Point<spacedim>> patch_q_points;
+      std::vector<value_type>      patch_solution_values;
 
-        auto       iter = patch_map.begin(patch_n, dof_handler);
-        const auto end  = patch_map.end(patch_n, dof_handler);
-        for (; iter != end; ++iter)
-          {
-            const auto cell = *iter;
-            const auto quad_index =
-              quadrature_indices[cell->active_cell_index()];
+      EulerianCellSorter<spacedim, value_type> sorter;
+      SpreadCutoffFilter<spacedim, value_type> cutoff_filter;
 
-            // Reinitialize:
-            FEValues<dim, spacedim> &solution_fe_values =
-              *all_solution_fe_values[quad_index];
-            FEValues<dim, spacedim> &position_fe_values =
-              *all_position_fe_values[quad_index];
-            solution_fe_values.reinit(cell);
-            position_fe_values.reinit(cell);
-            Assert(solution_fe_values.get_quadrature() ==
-                     position_fe_values.get_quadrature(),
-                   ExcFDLInternalError());
+      const auto dof_table = patch_map.get_dof_index_table(dof_handler);
 
-            const std::vector<Point<spacedim>> &q_points =
-              position_fe_values.get_quadrature_points();
-            const unsigned int n_q_points = q_points.size();
-            cell_solution_values.resize(n_q_points);
-
-            // get forces:
-            std::fill(cell_solution_values.begin(),
-                      cell_solution_values.end(),
-                      value_type());
-            cell->get_dof_values(solution,
-                                 cell_solution.begin(),
-                                 cell_solution.end());
-            compute_values_generic(solution_fe_values,
-                                   cell_solution,
-                                   cell_solution_values);
-            for (unsigned int qp = 0; qp < n_q_points; ++qp)
-              cell_solution_values[qp] *= solution_fe_values.JxW(qp);
-
-            // TODO reimplement zeroExteriorValues here
-
-            // spread at quadrature points:
-            static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
-                          "FORTRAN routines assume we are packed");
-            const auto position_data =
-              reinterpret_cast<const double *>(q_points.data());
-            // the number of components is determined at run time so use a
-            // normal assertion
-            AssertThrow(sizeof(value_type) ==
-                          sizeof(double) * fe.n_components(),
-                        ExcMessage("FORTRAN routines assume we are packed"));
-            const auto solution_data =
-              reinterpret_cast<const double *>(cell_solution_values.data());
-
-            IBTK::LEInteractor::spread(patch_data,
-                                       solution_data,
-                                       cell_solution_values.size() *
-                                         fe.n_components(),
-                                       fe.n_components(),
-                                       position_data,
-                                       n_q_points * spacedim,
-                                       spacedim,
-                                       patch,
-                                       patch->getBox(),
-                                       kernel_name);
-          }
-      }
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+      for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        {
+          auto patch = patch_map.get_patch(patch_n);
+          Assert(patch->checkAllocated(data_index),
+                 ExcMessage("unallocated data patch index"));
+          tbox::Pointer<patch_type> patch_data =
+            patch->getPatchData(data_index);
+          Assert(patch_data, ExcMessage("Type mismatch"));
+          check_depth<spacedim>(patch_data, fe.n_components());
+
+          patch_q_points.clear();
+          patch_solution_values.clear();
+          auto       iter = patch_map.begin(patch_n, dof_handler);
+          const auto end  = patch_map.end(patch_n, dof_handler);
+          for (; iter != end; ++iter)
+            {
+              const auto cell = *iter;
+              const auto quad_index =
+                quadrature_indices[cell->active_cell_index()];
+
+              // Reinitialize:
+              FEValues<dim, spacedim> &solution_fe_values =
+                *all_solution_fe_values[quad_index];
+              FEValues<dim, spacedim> &position_fe_values =
+                *all_position_fe_values[quad_index];
+              solution_fe_values.reinit(cell);
+              position_fe_values.reinit(cell);
+              Assert(solution_fe_values.get_quadrature() ==
+                       position_fe_values.get_quadrature(),
+                     ExcFDLInternalError());
+
+              const std::vector<Point<spacedim>> &q_points =
+                position_fe_values.get_quadrature_points();
+              const unsigned int n_q_points = q_points.size();
+              cell_solution_values.resize(n_q_points);
+
+              // get forces:
+              std::fill(cell_solution_values.begin(),
+                        cell_solution_values.end(),
+                        value_type());
+              get_cell_solution(cell, dof_table, solution, cell_solution);
+              compute_values_generic(solution_fe_values,
+                                     cell_solution,
+                                     cell_solution_values);
+              for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                cell_solution_values[qp] *= solution_fe_values.JxW(qp);
+
+              // TODO reimplement zeroExteriorValues here
+
+              // If we sort (or apply a cutoff) then spread at every quadrature
+              // point on the patch at once:
+              if (sort_points || use_cutoff)
+                {
+                  patch_q_points.insert(patch_q_points.end(),
+                                        q_points.begin(),
+                                        q_points.end());
+                  patch_solution_values.insert(patch_solution_values.end(),
+                                               cell_solution_values.begin(),
+                                               cell_solution_values.end());
+                  continue;
+                }
+
+              // spread at quadrature points:
+              static_assert(sizeof(Point<spacedim>) ==
+                              sizeof(double) * spacedim,
+                            "FORTRAN routines assume we are packed");
+              const auto position_data =
+                reinterpret_cast<const double *>(q_points.data());
+              const auto solution_data =
+                reinterpret_cast<const double *>(cell_solution_values.data());
+
+              ib_spread(patch_data,
+                        solution_data,
+                        cell_solution_values.size() * fe.n_components(),
+                        fe.n_components(),
+                        position_data,
+                        n_q_points * spacedim,
+                        spacedim,
+                        patch,
+                        patch->getBox(),
+                        kernel_name);
+            }
+
+          if (use_cutoff)
+            {
+              patch_max_magnitudes[patch_n] =
+                max_value_magnitude(patch_solution_values);
+              cutoff_patch_points[patch_n].swap(patch_q_points);
+              cutoff_patch_values[patch_n].swap(patch_solution_values);
+            }
+          else if (sort_points && patch_q_points.size() > 0)
+            {
+              sorter.sort(patch, patch_q_points, patch_solution_values);
+              ib_spread(patch_data,
+                        reinterpret_cast<const double *>(
+                          sorter.sorted_values.data()),
+                        sorter.sorted_values.size() * fe.n_components(),
+                        fe.n_components(),
+                        reinterpret_cast<const double *>(
+                          sorter.sorted_points.data()),
+                        sorter.sorted_points.size() * spacedim,
+                        spacedim,
+                        patch,
+                        patch->getBox(),
+                        kernel_name);
+            }
+        }
+
+      if (use_cutoff)
+        {
+          // patch_max_magnitudes is complete after the implicit barrier at
+          // the end of the previous loop
+          const double threshold =
+            spread_cutoff * *std::max_element(patch_max_magnitudes.begin(),
+                                              patch_max_magnitudes.end());
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+          for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+            {
+              cutoff_filter.filter(cutoff_patch_points[patch_n],
+                                   cutoff_patch_values[patch_n],
+                                   threshold,
+                                   patch_statistics[patch_n]);
+              if (cutoff_filter.kept_points.size() == 0)
+                continue;
+
+              auto                      patch = patch_map.get_patch(patch_n);
+              tbox::Pointer<patch_type> patch_data =
+                patch->getPatchData(data_index);
+              if (sort_points)
+                sorter.sort(patch,
+                            cutoff_filter.kept_points,
+                            cutoff_filter.kept_values);
+              const std::vector<Point<spacedim>> &spread_points =
+                sort_points ? sorter.sorted_points : cutoff_filter.kept_points;
+              const std::vector<value_type> &spread_values =
+                sort_points ? sorter.sorted_values : cutoff_filter.kept_values;
+              ib_spread(patch_data,
+                        reinterpret_cast<const double *>(spread_values.data()),
+                        spread_values.size() * fe.n_components(),
+                        fe.n_components(),
+                        reinterpret_cast<const double *>(spread_points.data()),
+                        spread_points.size() * spacedim,
+                        spacedim,
+                        patch,
+                        patch->getBox(),
+                        kernel_name);
+            }
+        }
+    }
+    add_spread_cutoff_statistics(patch_statistics, statistics);
   }
 
 
 
-  template <int dim, int spacedim>
+  template <int dim, int spacedim, typename Number>
   void
   compute_spread(const std::string                  &kernel_name,
                  const int                           data_index,
@@ -923,22 +3368,29 @@ namespace fdl
                  const std::vector<Quadrature<dim>> &quadratures,
                  const DoFHandler<dim, spacedim>    &dof_handler,
                  const Mapping<dim, spacedim>       &mapping,
-                 const Vector<double>               &solution)
+                 const Vector<Number>               &solution,
+                 const unsigned int                  n_threads,
+                 const bool                          sort_points,
+                 const double                        spread_cutoff,
+                 SpreadCutoffStatistics             *statistics)
   {
+    AssertThrow(0.0 <= spread_cutoff && spread_cutoff < 1.0,
+                ExcMessage("The spread cutoff should be in [0, 1)."));
 #define ARGUMENTS                                                           \
   kernel_name, data_index, patch_map, position_mapping, quadrature_indices, \
-    quadratures, dof_handler, mapping, solution
+    quadratures, dof_handler, mapping, solution, n_threads, sort_points,    \
+    spread_cutoff, statistics
     if (patch_map.size() != 0)
       {
-        auto patch_data = patch_map.get_patch(0)->getPatchData(data_index);
-        auto pair       = extract_types(patch_data);
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch_map.get_patch(0), data_index);
 
-        AssertThrow(pair.second == SAMRAIFieldType::Double,
+        AssertThrow(info.field_type == SAMRAIFieldType::Double,
                     ExcNotImplemented());
-        switch (pair.first)
+        switch (info.patch_type)
           {
             case SAMRAIPatchType::Edge:
-              switch (extract_depth(patch_data))
+              switch (info.depth)
                 {
                   case 1:
                     compute_spread_internal<dim,
@@ -959,62 +3411,780 @@ namespace fdl
                 }
               break;
 
-            case SAMRAIPatchType::Cell:
-              switch (extract_depth(patch_data))
-                {
-                  case 1:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            double,
-                                            pdat::CellData<spacedim, double>>(
-                      ARGUMENTS);
-                    break;
-                  case spacedim:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            Tensor<1, spacedim>,
-                                            pdat::CellData<spacedim, double>>(
-                      ARGUMENTS);
-                    break;
-                  default:
-                    AssertThrow(false, ExcNotImplemented());
-                }
-              break;
+            case SAMRAIPatchType::Cell:
+              switch (info.depth)
+                {
+                  case 1:
+                    compute_spread_internal<dim,
+                                            spacedim,
+                                            double,
+                                            pdat::CellData<spacedim, double>>(
+                      ARGUMENTS);
+                    break;
+                  case spacedim:
+                    compute_spread_internal<dim,
+                                            spacedim,
+                                            Tensor<1, spacedim>,
+                                            pdat::CellData<spacedim, double>>(
+                      ARGUMENTS);
+                    break;
+                  default:
+                    AssertThrow(false, ExcNotImplemented());
+                }
+              break;
+
+            case SAMRAIPatchType::Side:
+              // We only support depth == 1 for side-centered
+              Assert(info.depth == 1, ExcFDLNotImplemented());
+              compute_spread_internal<dim,
+                                      spacedim,
+                                      Tensor<1, spacedim>,
+                                      pdat::SideData<spacedim, double>>(
+                ARGUMENTS);
+              break;
+
+            case SAMRAIPatchType::Node:
+              switch (info.depth)
+                {
+                  case 1:
+                    compute_spread_internal<dim,
+                                            spacedim,
+                                            double,
+                                            pdat::NodeData<spacedim, double>>(
+                      ARGUMENTS);
+                    break;
+                  case spacedim:
+                    compute_spread_internal<dim,
+                                            spacedim,
+                                            Tensor<1, spacedim>,
+                                            pdat::NodeData<spacedim, double>>(
+                      ARGUMENTS);
+                    break;
+                  default:
+                    AssertThrow(false, ExcNotImplemented());
+                }
+              break;
+          }
+      }
+#undef ARGUMENTS
+  }
+
+  template <int dim,
+            int spacedim,
+            typename value_type,
+            typename patch_type,
+            typename Number>
+  void
+  compute_spread_plan_internal(
+    const std::string                    &kernel_name,
+    const int                             data_index,
+    PatchMap<dim, spacedim>              &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    const Vector<Number>                 &solution,
+    const unsigned int                    n_threads,
+    const bool                            sort_points,
+    const double                          spread_cutoff,
+    SpreadCutoffStatistics               *statistics)
+  {
+    check_quadratures(quadrature_indices,
+                      quadratures,
+                      dof_handler.get_triangulation());
+    check_plan(plan, patch_map);
+    AssertThrow(n_threads > 0, ExcMessage("At least one thread is required."));
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    // the number of components is determined at run time so use a normal
+    // assertion
+    AssertThrow(sizeof(value_type) == sizeof(double) * fe.n_components(),
+                ExcMessage("FORTRAN routines assume we are packed"));
+
+    // If possible, skip FEValues entirely. The table is only read so it can be
+    // shared between threads.
+    std::unique_ptr<ReferenceShapeValues<dim, spacedim>> reference_values;
+    const bool use_weights = use_plan_weights(plan, fe, mapping);
+    if (use_weights)
+      reference_values =
+        std::make_unique<ReferenceShapeValues<dim, spacedim>>(fe, quadratures);
+
+    // As in compute_spread_internal(), with a cutoff we first compute the
+    // values on every patch. The points are stored in the plan.
+    const bool use_compression = plan.is_compressed();
+    const bool use_cutoff      = spread_cutoff > 0.0;
+    std::vector<std::vector<value_type>> cutoff_patch_values;
+    std::vector<double>                  patch_max_magnitudes;
+    std::vector<SpreadCutoffStatistics>  patch_statistics;
+    if (use_cutoff)
+      {
+        cutoff_patch_values.resize(patch_map.size());
+        patch_max_magnitudes.resize(patch_map.size(), 0.0);
+        patch_statistics.resize(patch_map.size());
+      }
+
+    // As in compute_spread_internal(), each patch is spread into by exactly
+    // one thread so this is both race-free and deterministic.
+#ifdef _OPENMP
+#  pragma omp parallel num_threads(n_threads) if (n_threads > 1)
+#endif
+    {
+      HardwareCounterRegion region("fdl::compute_spread()[plan]");
+      boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>,
+                                     16>
+        all_solution_fe_values;
+      if (!use_weights)
+        for (const Quadrature<dim> &quad : quadratures)
+          all_solution_fe_values.emplace_back(
+            std::make_unique<FEValues<dim, spacedim>>(
+              mapping, fe, quad, update_JxW_values | update_values));
+
+      std::vector<value_type> cell_solution_values;
+      std::vector<value_type> patch_solution_values;
+      std::vector<value_type> compressed_solution_values;
+      std::vector<double>     cell_solution(fe.dofs_per_cell);
+
+      EulerianCellSorter<spacedim, value_type> sorter;
+      SpreadCutoffFilter<spacedim, value_type> cutoff_filter;
+
+      const auto dof_table = patch_map.get_dof_index_table(dof_handler);
+
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+      for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        {
+          const std::vector<Point<spacedim>> &q_points =
+            plan.patch_q_points[patch_n];
+          const std::vector<unsigned int> &offsets =
+            plan.patch_cell_offsets[patch_n];
+          if (q_points.size() == 0)
+            continue;
+
+          auto patch = patch_map.get_patch(patch_n);
+          Assert(patch->checkAllocated(data_index),
+                 ExcMessage("unallocated data patch index"));
+          tbox::Pointer<patch_type> patch_data =
+            patch->getPatchData(data_index);
+          Assert(patch_data, ExcMessage("Type mismatch"));
+          check_depth<spacedim>(patch_data, fe.n_components());
+
+          // get forces on every cell of the patch:
+          patch_solution_values.resize(q_points.size());
+          auto       iter = patch_map.begin(patch_n, dof_handler);
+          const auto end  = patch_map.end(patch_n, dof_handler);
+          Assert(std::size_t(end - iter) + 1 == offsets.size(),
+                 ExcMessage("The interaction plan should have been computed "
+                            "with the provided PatchMap."));
+          for (unsigned int cell_n = 0; iter != end; ++iter, ++cell_n)
+            {
+              const auto cell = *iter;
+              const auto quad_index =
+                quadrature_indices[cell->active_cell_index()];
+              const unsigned int offset     = offsets[cell_n];
+              const unsigned int n_q_points = offsets[cell_n + 1] - offset;
+              get_cell_solution(cell, dof_table, solution, cell_solution);
+              if (use_weights)
+                {
+                  // value_type is packed (checked above) so we can write
+                  // components directly
+                  double *const values = reinterpret_cast<double *>(
+                    patch_solution_values.data() + offset);
+                  reference_values->evaluate(quad_index,
+                                             cell_solution.data(),
+                                             values);
+                  const double *const JxW =
+                    plan.patch_JxW[patch_n].data() + offset;
+                  const unsigned int n_components = fe.n_components();
+                  for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                    for (unsigned int c = 0; c < n_components; ++c)
+                      values[qp * n_components + c] *= JxW[qp];
+                  continue;
+                }
+
+              FEValues<dim, spacedim> &solution_fe_values =
+                *all_solution_fe_values[quad_index];
+              solution_fe_values.reinit(cell);
+              Assert(n_q_points == solution_fe_values.n_quadrature_points,
+                     ExcFDLInternalError());
+
+              cell_solution_values.resize(n_q_points);
+              std::fill(cell_solution_values.begin(),
+                        cell_solution_values.end(),
+                        value_type());
+              compute_values_generic(solution_fe_values,
+                                     cell_solution,
+                                     cell_solution_values);
+              for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                patch_solution_values[offset + qp] =
+                  cell_solution_values[qp] * solution_fe_values.JxW(qp);
+            }
+
+          // With compression, spread the sum of the values represented by
+          // each point:
+          if (use_compression)
+            {
+              const std::vector<unsigned int> &representatives =
+                plan.patch_q_point_representatives[patch_n];
+              compressed_solution_values.assign(
+                plan.patch_compressed_q_points[patch_n].size(), value_type());
+              for (std::size_t qp_n = 0; qp_n < q_points.size(); ++qp_n)
+                compressed_solution_values[representatives[qp_n]] +=
+                  patch_solution_values[qp_n];
+            }
+          const std::vector<Point<spacedim>> &patch_points =
+            use_compression ? plan.patch_compressed_q_points[patch_n] :
+                              q_points;
+          std::vector<value_type> &patch_values =
+            use_compression ? compressed_solution_values :
+                              patch_solution_values;
+          if (use_cutoff)
+            {
+              patch_max_magnitudes[patch_n] = max_value_magnitude(patch_values);
+              cutoff_patch_values[patch_n].swap(patch_values);
+              continue;
+            }
+
+          // spread at every point on the patch at once:
+          static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                        "FORTRAN routines assume we are packed");
+          if (sort_points)
+            sorter.sort(patch, patch_points, patch_values);
+          const std::vector<Point<spacedim>> &spread_points =
+            sort_points ? sorter.sorted_points : patch_points;
+          const std::vector<value_type> &spread_values =
+            sort_points ? sorter.sorted_values : patch_values;
+          ib_spread(patch_data,
+                    reinterpret_cast<const double *>(spread_values.data()),
+                    spread_values.size() * fe.n_components(),
+                    fe.n_components(),
+                    reinterpret_cast<const double *>(spread_points.data()),
+                    spread_points.size() * spacedim,
+                    spacedim,
+                    patch,
+                    patch->getBox(),
+                    kernel_name);
+        }
+
+      if (use_cutoff)
+        {
+          // patch_max_magnitudes is complete after the implicit barrier at
+          // the end of the previous loop
+          const double threshold =
+            spread_cutoff * *std::max_element(patch_max_magnitudes.begin(),
+                                              patch_max_magnitudes.end());
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+          for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+            {
+              const std::vector<Point<spacedim>> &patch_points =
+                use_compression ? plan.patch_compressed_q_points[patch_n] :
+                                  plan.patch_q_points[patch_n];
+              cutoff_filter.filter(patch_points,
+                                   cutoff_patch_values[patch_n],
+                                   threshold,
+                                   patch_statistics[patch_n]);
+              if (cutoff_filter.kept_points.size() == 0)
+                continue;
+
+              auto                      patch = patch_map.get_patch(patch_n);
+              tbox::Pointer<patch_type> patch_data =
+                patch->getPatchData(data_index);
+              if (sort_points)
+                sorter.sort(patch,
+                            cutoff_filter.kept_points,
+                            cutoff_filter.kept_values);
+              const std::vector<Point<spacedim>> &spread_points =
+                sort_points ? sorter.sorted_points : cutoff_filter.kept_points;
+              const std::vector<value_type> &spread_values =
+                sort_points ? sorter.sorted_values : cutoff_filter.kept_values;
+              ib_spread(patch_data,
+                        reinterpret_cast<const double *>(spread_values.data()),
+                        spread_values.size() * fe.n_components(),
+                        fe.n_components(),
+                        reinterpret_cast<const double *>(spread_points.data()),
+                        spread_points.size() * spacedim,
+                        spacedim,
+                        patch,
+                        patch->getBox(),
+                        kernel_name);
+            }
+        }
+    }
+    add_spread_cutoff_statistics(patch_statistics, statistics);
+  }
+
+
+
+  template <int dim, int spacedim, typename Number>
+  void
+  compute_spread(const std::string                    &kernel_name,
+                 const int                             data_index,
+                 PatchMap<dim, spacedim>              &patch_map,
+                 const InteractionPlan<dim, spacedim> &plan,
+                 const std::vector<unsigned char>     &quadrature_indices,
+                 const std::vector<Quadrature<dim>>   &quadratures,
+                 const DoFHandler<dim, spacedim>      &dof_handler,
+                 const Mapping<dim, spacedim>         &mapping,
+                 const Vector<Number>                 &solution,
+                 const unsigned int                    n_threads,
+                 const bool                            sort_points,
+                 const double                          spread_cutoff,
+                 SpreadCutoffStatistics               *statistics)
+  {
+    AssertThrow(0.0 <= spread_cutoff && spread_cutoff < 1.0,
+                ExcMessage("The spread cutoff should be in [0, 1)."));
+#define ARGUMENTS                                                            \
+  kernel_name, data_index, patch_map, plan, quadrature_indices, quadratures, \
+    dof_handler, mapping, solution, n_threads, sort_points, spread_cutoff,   \
+    statistics
+    if (patch_map.size() != 0)
+      {
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch_map.get_patch(0), data_index);
+
+        AssertThrow(info.field_type == SAMRAIFieldType::Double,
+                    ExcFDLNotImplemented());
+        const int depth = info.depth;
+        AssertThrow(depth == 1 || depth == spacedim, ExcFDLNotImplemented());
+        switch (info.patch_type)
+          {
+            case SAMRAIPatchType::Edge:
+              if (depth == 1)
+                compute_spread_plan_internal<dim,
+                                             spacedim,
+                                             double,
+                                             pdat::EdgeData<spacedim, double>>(
+                  ARGUMENTS);
+              else
+                compute_spread_plan_internal<dim,
+                                             spacedim,
+                                             Tensor<1, spacedim>,
+                                             pdat::EdgeData<spacedim, double>>(
+                  ARGUMENTS);
+              break;
+
+            case SAMRAIPatchType::Cell:
+              if (depth == 1)
+                compute_spread_plan_internal<dim,
+                                             spacedim,
+                                             double,
+                                             pdat::CellData<spacedim, double>>(
+                  ARGUMENTS);
+              else
+                compute_spread_plan_internal<dim,
+                                             spacedim,
+                                             Tensor<1, spacedim>,
+                                             pdat::CellData<spacedim, double>>(
+                  ARGUMENTS);
+              break;
+
+            case SAMRAIPatchType::Side:
+              // We only support depth == 1 for side-centered
+              Assert(depth == 1, ExcFDLNotImplemented());
+              compute_spread_plan_internal<dim,
+                                           spacedim,
+                                           Tensor<1, spacedim>,
+                                           pdat::SideData<spacedim, double>>(
+                ARGUMENTS);
+              break;
+
+            case SAMRAIPatchType::Node:
+              if (depth == 1)
+                compute_spread_plan_internal<dim,
+                                             spacedim,
+                                             double,
+                                             pdat::NodeData<spacedim, double>>(
+                  ARGUMENTS);
+              else
+                compute_spread_plan_internal<dim,
+                                             spacedim,
+                                             Tensor<1, spacedim>,
+                                             pdat::NodeData<spacedim, double>>(
+                  ARGUMENTS);
+              break;
+          }
+      }
+#undef ARGUMENTS
+  }
+
+  namespace
+  {
+    // Spread values at the provided points into patch data, whatever its
+    // type.
+    template <int spacedim>
+    void
+    spread_at_points(const std::string                          &kernel_name,
+                     const int                                   data_index,
+                     const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                     const std::vector<Point<spacedim>>         &points,
+                     const unsigned int                          n_components,
+                     const std::vector<double>                  &values)
+    {
+      Assert(patch->checkAllocated(data_index),
+             ExcMessage("unallocated data patch index"));
+      static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                    "FORTRAN routines assume we are packed");
+      AssertDimension(values.size(), n_components * points.size());
+
+      const tbox::Pointer<hier::PatchData<spacedim>> data =
+        patch->getPatchData(data_index);
+      const PatchDataTypeInfo info =
+        get_patch_data_type_info(patch, data_index);
+      AssertThrow(info.field_type == SAMRAIFieldType::Double,
+                  ExcFDLNotImplemented());
+#define ARGUMENTS                                                        \
+  values.data(), values.size(), n_components,                            \
+    reinterpret_cast<const double *>(points.data()),                     \
+    points.size() * spacedim, spacedim, patch, patch->getBox(), kernel_name
+      switch (info.patch_type)
+        {
+          case SAMRAIPatchType::Edge:
+            {
+              tbox::Pointer<pdat::EdgeData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_spread(patch_data, ARGUMENTS);
+              break;
+            }
+          case SAMRAIPatchType::Cell:
+            {
+              tbox::Pointer<pdat::CellData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_spread(patch_data, ARGUMENTS);
+              break;
+            }
+          case SAMRAIPatchType::Side:
+            {
+              tbox::Pointer<pdat::SideData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_spread(patch_data, ARGUMENTS);
+              break;
+            }
+          case SAMRAIPatchType::Node:
+            {
+              tbox::Pointer<pdat::NodeData<spacedim, double>> patch_data =
+                data;
+              check_depth<spacedim>(patch_data, n_components);
+              ib_spread(patch_data, ARGUMENTS);
+              break;
+            }
+        }
+#undef ARGUMENTS
+    }
+  } // namespace
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_spread(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    PatchMap<dim, spacedim>                              &patch_map,
+    const InteractionPlan<dim, spacedim>                 &plan,
+    const std::vector<unsigned char>                     &quadrature_indices,
+    const std::vector<Quadrature<dim>>                   &quadratures,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<const Vector<double> *>            &solutions)
+  {
+    const std::size_t n_fields = data_indices.size();
+    AssertThrow(dof_handlers.size() == n_fields &&
+                  mappings.size() == n_fields && solutions.size() == n_fields,
+                ExcMessage("Each field requires a data index, DoFHandler, "
+                           "Mapping, and solution vector."));
+    if (n_fields == 0)
+      return;
+    check_plan(plan, patch_map);
+
+    // Set up FEValues objects. Fields which use the same FE and Mapping share
+    // them.
+    std::vector<unsigned int> field_to_fe_values(n_fields);
+    std::vector<std::vector<std::unique_ptr<FEValues<dim, spacedim>>>>
+      all_solution_fe_values;
+    // Groups which can use precomputed JxW values have no FEValues objects
+    std::vector<std::unique_ptr<ReferenceShapeValues<dim, spacedim>>>
+      all_reference_values;
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      {
+        Assert(dof_handlers[field_n] && mappings[field_n] &&
+                 solutions[field_n],
+               ExcMessage("pointers should not be nullptr"));
+        const FiniteElement<dim, spacedim> &fe =
+          dof_handlers[field_n]->get_fe();
+        check_quadratures(quadrature_indices,
+                          quadratures,
+                          dof_handlers[field_n]->get_triangulation());
+        AssertThrow(fe.n_components() == 1 || fe.n_components() == spacedim,
+                    ExcFDLNotImplemented());
+
+        std::size_t other_n = 0;
+        for (; other_n < field_n; ++other_n)
+          if (dof_handlers[other_n]->get_fe() == fe &&
+              mappings[other_n] == mappings[field_n])
+            break;
+        if (other_n < field_n)
+          {
+            field_to_fe_values[field_n] = field_to_fe_values[other_n];
+            continue;
+          }
+
+        field_to_fe_values[field_n] = all_solution_fe_values.size();
+        all_solution_fe_values.emplace_back();
+        all_reference_values.emplace_back();
+        if (use_plan_weights(plan, fe, *mappings[field_n]))
+          all_reference_values.back() =
+            std::make_unique<ReferenceShapeValues<dim, spacedim>>(fe,
+                                                                  quadratures);
+        else
+          for (const Quadrature<dim> &quad : quadratures)
+            all_solution_fe_values.back().emplace_back(
+              std::make_unique<FEValues<dim, spacedim>>(
+                *mappings[field_n],
+                fe,
+                quad,
+                update_JxW_values | update_values));
+      }
+
+    std::vector<std::vector<double>> cell_solutions(n_fields);
+    std::vector<std::vector<double>> patch_values(n_fields);
+    std::vector<ArrayView<const types::global_dof_index>> dof_tables(n_fields);
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      {
+        cell_solutions[field_n].resize(
+          dof_handlers[field_n]->get_fe().dofs_per_cell);
+        dof_tables[field_n] =
+          patch_map.get_dof_index_table(*dof_handlers[field_n]);
+      }
+    std::vector<double>                 scalar_values;
+    std::vector<Tensor<1, spacedim>>    vector_values;
+    std::vector<double>                 compressed_values;
+    const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
+    const bool use_compression               = plan.is_compressed();
+
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const std::vector<Point<spacedim>> &q_points =
+          plan.patch_q_points[patch_n];
+        const std::vector<unsigned int> &offsets =
+          plan.patch_cell_offsets[patch_n];
+        if (q_points.size() == 0)
+          continue;
+
+        for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+          patch_values[field_n].resize(
+            q_points.size() * dof_handlers[field_n]->get_fe().n_components());
+
+        // Compute the values of every field (times JxW) on each cell:
+        auto       iter = patch_map.begin(patch_n, *dof_handlers[0]);
+        const auto end  = patch_map.end(patch_n, *dof_handlers[0]);
+        Assert(std::size_t(end - iter) + 1 == offsets.size(),
+               ExcMessage("The interaction plan should have been computed "
+                          "with the provided PatchMap."));
+        for (unsigned int cell_n = 0; iter != end; ++iter, ++cell_n)
+          {
+            const auto         cell       = *iter;
+            const unsigned int offset     = offsets[cell_n];
+            const unsigned int n_q_points = offsets[cell_n + 1] - offset;
+            const auto         quad_index =
+              quadrature_indices[cell->active_cell_index()];
+
+            // FEValues only needs to be reinitialized once per cell:
+            std::vector<bool> reinitialized(all_solution_fe_values.size(),
+                                            false);
+            for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+              {
+                const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                  field_cell(&tria,
+                             cell->level(),
+                             cell->index(),
+                             dof_handlers[field_n]);
+                const unsigned int fe_values_n = field_to_fe_values[field_n];
+                const unsigned int n_components =
+                  dof_handlers[field_n]->get_fe().n_components();
+                std::vector<double> &cell_solution = cell_solutions[field_n];
+                double *const        values =
+                  patch_values[field_n].data() + offset * n_components;
+                get_cell_solution(field_cell,
+                                  dof_tables[field_n],
+                                  *solutions[field_n],
+                                  cell_solution);
+                if (all_reference_values[fe_values_n])
+                  {
+                    all_reference_values[fe_values_n]->evaluate(
+                      quad_index, cell_solution.data(), values);
+                    const double *const JxW =
+                      plan.patch_JxW[patch_n].data() + offset;
+                    for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                      for (unsigned int c = 0; c < n_components; ++c)
+                        values[qp * n_components + c] *= JxW[qp];
+                    continue;
+                  }
+
+                FEValues<dim, spacedim> &solution_fe_values =
+                  *all_solution_fe_values[fe_values_n][quad_index];
+                if (!reinitialized[fe_values_n])
+                  {
+                    solution_fe_values.reinit(field_cell);
+                    reinitialized[fe_values_n] = true;
+                  }
+                Assert(n_q_points == solution_fe_values.n_quadrature_points,
+                       ExcFDLInternalError());
+                if (n_components == 1)
+                  {
+                    scalar_values.resize(n_q_points);
+                    compute_values_generic(solution_fe_values,
+                                           cell_solution,
+                                           scalar_values);
+                    for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                      values[qp] =
+                        scalar_values[qp] * solution_fe_values.JxW(qp);
+                  }
+                else
+                  {
+                    vector_values.resize(n_q_points);
+                    compute_values_generic(solution_fe_values,
+                                           cell_solution,
+                                           vector_values);
+                    for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                      for (unsigned int c = 0; c < n_components; ++c)
+                        values[qp * n_components + c] =
+                          vector_values[qp][c] * solution_fe_values.JxW(qp);
+                  }
+              }
+          }
+
+        // Then spread every field on the patch. As in the single-field
+        // version, with compression we spread the sum of the values
+        // represented by each point.
+        const auto patch = patch_map.get_patch(patch_n);
+        const std::vector<Point<spacedim>> &patch_points =
+          use_compression ? plan.patch_compressed_q_points[patch_n] :
+                            q_points;
+        for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+          {
+            const unsigned int n_components =
+              dof_handlers[field_n]->get_fe().n_components();
+            if (use_compression)
+              {
+                const std::vector<unsigned int> &representatives =
+                  plan.patch_q_point_representatives[patch_n];
+                compressed_values.assign(patch_points.size() * n_components,
+                                         0.0);
+                for (std::size_t qp_n = 0; qp_n < q_points.size(); ++qp_n)
+                  for (unsigned int c = 0; c < n_components; ++c)
+                    compressed_values[representatives[qp_n] * n_components +
+                                      c] +=
+                      patch_values[field_n][qp_n * n_components + c];
+              }
+            spread_at_points(kernel_name,
+                             data_indices[field_n],
+                             patch,
+                             patch_points,
+                             n_components,
+                             use_compression ? compressed_values :
+                                               patch_values[field_n]);
+          }
+      }
+  }
+
 
-            case SAMRAIPatchType::Side:
-              // We only support depth == 1 for side-centered
-              Assert(extract_depth(patch_data) == 1, ExcFDLNotImplemented());
-              compute_spread_internal<dim,
-                                      spacedim,
-                                      Tensor<1, spacedim>,
-                                      pdat::SideData<spacedim, double>>(
-                ARGUMENTS);
-              break;
 
-            case SAMRAIPatchType::Node:
-              switch (extract_depth(patch_data))
+  template <int dim, int spacedim, typename Number>
+  void
+  compute_spread(const InteractionOperator<dim, spacedim> &op,
+                 PatchMap<dim, spacedim>                  &patch_map,
+                 const Vector<Number>                     &solution,
+                 const unsigned int                        n_threads)
+  {
+    Assert(!op.empty(),
+           ExcMessage("The interaction operator should be computed first."));
+    Assert(op.patch_column_offsets.size() == patch_map.size(),
+           ExcMessage("The interaction operator should have been computed "
+                      "with the provided PatchMap."));
+    AssertThrow(n_threads > 0, ExcMessage("At least one thread is required."));
+    const DoFHandler<dim, spacedim> &dof_handler = *op.dof_handler;
+    const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+    const unsigned int n_components  = op.component_dofs.size();
+
+    // As in compute_spread_internal(), each patch is spread into by exactly
+    // one thread so this is both race-free and deterministic.
+#ifdef _OPENMP
+#  pragma omp parallel num_threads(n_threads) if (n_threads > 1)
+#endif
+    {
+      HardwareCounterRegion region("fdl::compute_spread()[operator]");
+      std::vector<double> cell_solution(dofs_per_cell);
+      std::vector<double> dof_values;
+
+      const auto dof_table = patch_map.get_dof_index_table(dof_handler);
+
+#ifdef _OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+      for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        {
+          const std::vector<int> &columns = op.patch_columns[patch_n];
+          if (columns.size() == 0)
+            continue;
+          const std::vector<unsigned int> &column_offsets =
+            op.patch_column_offsets[patch_n];
+          const std::vector<std::size_t> &value_offsets =
+            op.patch_value_offsets[patch_n];
+          const std::vector<double> &values = op.patch_values[patch_n];
+
+          auto patch = patch_map.get_patch(patch_n);
+          const std::vector<double *> pointers =
+            get_component_pointers(patch, op.data_index, n_components);
+
+          // Spreading preserves integrals, so we divide by the cell volume:
+          const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+            patch->getPatchGeometry();
+          double cell_volume = 1.0;
+          for (int d = 0; d < spacedim; ++d)
+            cell_volume *= pgeom->getDx()[d];
+          const double inverse_cell_volume = 1.0 / cell_volume;
+
+          auto       iter = patch_map.begin(patch_n, dof_handler);
+          const auto end  = patch_map.end(patch_n, dof_handler);
+          Assert(std::size_t(end - iter) * n_components + 1 ==
+                   column_offsets.size(),
+                 ExcMessage("The interaction operator should have been "
+                            "computed with the provided PatchMap."));
+          for (unsigned int block_n = 0; iter != end; ++iter)
+            {
+              const auto cell = *iter;
+              get_cell_solution(cell, dof_table, solution, cell_solution);
+              for (unsigned int c = 0; c < n_components; ++c, ++block_n)
                 {
-                  case 1:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            double,
-                                            pdat::NodeData<spacedim, double>>(
-                      ARGUMENTS);
-                    break;
-                  case spacedim:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            Tensor<1, spacedim>,
-                                            pdat::NodeData<spacedim, double>>(
-                      ARGUMENTS);
-                    break;
-                  default:
-                    AssertThrow(false, ExcNotImplemented());
+                  const std::vector<unsigned int> &dofs = op.component_dofs[c];
+                  dof_values.resize(dofs.size());
+                  for (unsigned int r = 0; r < dofs.size(); ++r)
+                    dof_values[r] =
+                      cell_solution[dofs[r]] * inverse_cell_volume;
+
+                  const int *const    block_columns =
+                    columns.data() + column_offsets[block_n];
+                  const unsigned int  n_columns =
+                    column_offsets[block_n + 1] - column_offsets[block_n];
+                  const double *const block =
+                    values.data() + value_offsets[block_n];
+                  double *const       data = pointers[c];
+                  for (unsigned int r = 0; r < dofs.size(); ++r)
+                    {
+                      const double *const row   = block + r * n_columns;
+                      const double        value = dof_values[r];
+                      for (unsigned int k = 0; k < n_columns; ++k)
+                        data[block_columns[k]] += row[k] * value;
+                    }
                 }
-              break;
-          }
-      }
-#undef ARGUMENTS
+            }
+        }
+    }
   }
 
   template <int dim, int spacedim, typename patch_type>
@@ -1025,6 +4195,7 @@ namespace fdl
                                 const Vector<double>         &position,
                                 const Vector<double>         &spread_values)
   {
+    HardwareCounterRegion region("fdl::compute_nodal_spread()");
     // Early exit if there is nothing to do (otherwise the modulus operations
     // fail)
     if (position.size() == 0 || spread_values.size() == 0)
@@ -1044,6 +4215,8 @@ namespace fdl
     const auto n_components =
       spread_values.size() / (position.size() / spacedim);
 
+    std::vector<double> position_buffer;
+    std::vector<double> values_buffer;
     for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
       {
         std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
@@ -1056,6 +4229,25 @@ namespace fdl
         Assert(patch_data, ExcMessage("Type mismatch"));
         check_depth<spacedim>(patch_data, n_components);
 
+        // Like compute_nodal_interpolation_internal(), do a single call for
+        // fragmented patches.
+        if (patch_map.packs_nodes() && dofs.n_intervals() > 1)
+          {
+            patch_map.pack(patch_n, position, position_buffer);
+            patch_map.pack(patch_n, spread_values, values_buffer);
+            ib_spread(patch_data,
+                      values_buffer.data(),
+                      values_buffer.size(),
+                      n_components,
+                      position_buffer.data(),
+                      position_buffer.size(),
+                      spacedim,
+                      patch,
+                      patch->getBox(),
+                      kernel_name);
+            continue;
+          }
+
         for (auto it = dofs.begin_intervals(); it != dofs.end_intervals(); ++it)
           {
             const auto nodes_begin = *it->begin() / spacedim;
@@ -1071,16 +4263,16 @@ namespace fdl
             Assert(values_view.size() % n_components == 0,
                    ExcFDLInternalError());
 
-            IBTK::LEInteractor::spread(patch_data,
-                                       values_view.data(),
-                                       values_view.size(),
-                                       n_components,
-                                       position_view.data(),
-                                       position_view.size(),
-                                       spacedim,
-                                       patch,
-                                       patch->getBox(),
-                                       kernel_name);
+            ib_spread(patch_data,
+                      values_view.data(),
+                      values_view.size(),
+                      n_components,
+                      position_view.data(),
+                      position_view.size(),
+                      spacedim,
+                      patch,
+                      patch->getBox(),
+                      kernel_name);
           }
       }
   }
@@ -1098,12 +4290,12 @@ namespace fdl
 #define ARGUMENTS kernel_name, data_index, patch_map, position, spread_values
     if (patch_map.size() != 0)
       {
-        auto patch_data = patch_map[0].second->getPatchData(data_index);
-        auto pair       = extract_types(patch_data);
+        const PatchDataTypeInfo info =
+          get_patch_data_type_info(patch_map[0].second, data_index);
 
-        AssertThrow(pair.second == SAMRAIFieldType::Double,
+        AssertThrow(info.field_type == SAMRAIFieldType::Double,
                     ExcFDLNotImplemented());
-        switch (pair.first)
+        switch (info.patch_type)
           {
             case SAMRAIPatchType::Edge:
               compute_nodal_spread_internal<dim,
@@ -1277,41 +4469,327 @@ namespace fdl
   }
 
 
+  template <int spacedim>
+  void
+  intersect_patch_with_simplex(
+    const std::array<Point<spacedim>, spacedim>  &simplex,
+    const tbox::Pointer<hier::Patch<spacedim>>   &patch,
+    const unsigned char                           cell_level,
+    const int                                     cell_index,
+    internal::PatchSingleIntersections<spacedim> &intersections)
+  {
+    static_assert(spacedim == 2 || spacedim == 3,
+                  "Only implemented for lines and triangles");
+    constexpr int  n_transverse = spacedim - 1;
+    constexpr auto eps          = std::numeric_limits<double>::epsilon();
+
+    const hier::Box<spacedim> &patch_box = patch->getBox();
+    const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+      patch->getPatchGeometry();
+    Assert(patch_geom, ExcMessage("Type mismatch"));
+    const double *const dx      = patch_geom->getDx();
+    const double *const x_lower = patch_geom->getXLower();
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        intersections.dx[d] = dx[d];
+        intersections.domain_x_lower[d] =
+          x_lower[d] - double(patch_box.lower(d)) * dx[d];
+      }
+
+    // Work in index coordinates, in which the center of the cell with index
+    // i is at i: then the lines are at integer transverse coordinates and
+    // the convex combination coefficients are fractional parts.
+    std::array<Point<spacedim>, spacedim> vertices;
+    Point<spacedim>                       vertex_min;
+    Point<spacedim>                       vertex_max;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        vertex_min[d] = std::numeric_limits<double>::max();
+        vertex_max[d] = std::numeric_limits<double>::lowest();
+      }
+    for (unsigned int n = 0; n < spacedim; ++n)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          vertices[n][d] =
+            (simplex[n][d] - intersections.domain_x_lower[d]) / dx[d] - 0.5;
+          vertex_min[d] = std::min(vertex_min[d], vertices[n][d]);
+          vertex_max[d] = std::max(vertex_max[d], vertices[n][d]);
+        }
+
+    // Per-patch bounding box cull and range of transverse indices.
+    std::array<int, spacedim> index_min;
+    std::array<int, spacedim> index_max;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        if (vertex_max[d] < patch_box.lower(d) ||
+            patch_box.upper(d) < vertex_min[d])
+          return;
+        index_min[d] =
+          std::max(int(std::ceil(vertex_min[d])), patch_box.lower(d));
+        index_max[d] =
+          std::min(int(std::floor(vertex_max[d])), patch_box.upper(d));
+      }
+
+    std::vector<double>        axial_coordinates;
+    std::vector<unsigned char> hits;
+    for (unsigned int axis = 0; axis < spacedim; ++axis)
+      {
+        // stencils along this axis connect cells lower(axis) through
+        // upper(axis)
+        if (patch_box.upper(axis) == patch_box.lower(axis))
+          continue;
+
+        std::array<unsigned int, n_transverse> transverse;
+        for (unsigned int d = 0, i = 0; d < spacedim; ++d)
+          if (d != axis)
+            transverse[i++] = d;
+        const unsigned int inner_axis = transverse[n_transverse - 1];
+
+        bool empty = false;
+        for (const unsigned int d : transverse)
+          empty = empty || index_max[d] < index_min[d];
+        if (empty)
+          continue;
+
+        // Möller-Trumbore setup: solve for the barycentric coordinates of
+        // the intersection point via the projection of the simplex onto the
+        // transverse plane.
+        Tensor<2, n_transverse> M;
+        Tensor<1, n_transverse> w;
+        double                  norm_product = 1.0;
+        for (unsigned int c = 0; c < n_transverse; ++c)
+          {
+            double column_norm_square = 0.0;
+            for (unsigned int r = 0; r < n_transverse; ++r)
+              {
+                M[r][c] =
+                  vertices[c + 1][transverse[r]] - vertices[0][transverse[r]];
+                column_norm_square += M[r][c] * M[r][c];
+              }
+            w[c] = vertices[c + 1][axis] - vertices[0][axis];
+            norm_product *= std::sqrt(column_norm_square);
+          }
+        // skip simplices parallel to this axis
+        if (std::abs(determinant(M)) <= eps * norm_product)
+          continue;
+        const Tensor<2, n_transverse> M_inv = invert(M);
+        // the axial coordinate of the intersection is also affine
+        const Tensor<1, n_transverse> g = transpose(M_inv) * w;
+
+        const int n_lines = index_max[inner_axis] - index_min[inner_axis] + 1;
+        axial_coordinates.resize(n_lines);
+        hits.resize(n_lines);
+
+        // In 2D there is only the inner loop.
+        const int outer_min = spacedim == 3 ? index_min[transverse[0]] : 0;
+        const int outer_max = spacedim == 3 ? index_max[transverse[0]] : 0;
+        for (int j = outer_min; j <= outer_max; ++j)
+          {
+            // Values of the barycentric coordinates and the axial coordinate
+            // at the first line and their increments between lines.
+            Tensor<1, n_transverse> y;
+            if (spacedim == 3)
+              y[0] = double(j) - vertices[0][transverse[0]];
+            y[n_transverse - 1] =
+              double(index_min[inner_axis]) - vertices[0][inner_axis];
+            const Tensor<1, n_transverse> lambda_0 = M_inv * y;
+            const double                  axial_0  = vertices[0][axis] + g * y;
+
+            Tensor<1, n_transverse> lambda_step;
+            for (unsigned int r = 0; r < n_transverse; ++r)
+              lambda_step[r] = M_inv[r][n_transverse - 1];
+            const double axial_step = g[n_transverse - 1];
+
+            DEAL_II_OPENMP_SIMD_PRAGMA
+            for (int k = 0; k < n_lines; ++k)
+              {
+                bool   inside = true;
+                double sum    = 0.0;
+                for (unsigned int r = 0; r < n_transverse; ++r)
+                  {
+                    const double lambda = lambda_0[r] + k * lambda_step[r];
+                    inside &= lambda >= -eps;
+                    sum += lambda;
+                  }
+                inside &= sum <= 1.0 + eps;
+
+                const double axial = axial_0 + k * axial_step;
+                inside &= double(patch_box.lower(axis)) <= axial;
+                inside &= axial <= double(patch_box.upper(axis));
+                axial_coordinates[k] = axial;
+                hits[k]              = inside;
+              }
+
+            for (int k = 0; k < n_lines; ++k)
+              if (hits[k])
+                {
+                  const double axial = axial_coordinates[k];
+                  const int    lower =
+                    std::min(int(std::floor(axial)), patch_box.upper(axis) - 1);
+
+                  hier::Index<spacedim> index;
+                  if (spacedim == 3)
+                    index(transverse[0]) = j;
+                  index(inner_axis) = index_min[inner_axis] + k;
+                  index(axis)       = lower;
+
+                  intersections.lower_indices.emplace_back(index);
+                  intersections.axes.push_back(axis);
+                  intersections.convex_coefficients.push_back(
+                    std::min(std::max(axial - lower, 0.0), 1.0));
+                  intersections.cell_level.push_back(cell_level);
+                  intersections.cell_index.push_back(cell_index);
+                }
+          }
+      }
+  }
+
+
   // instantiations
 
+  template struct InteractionPlan<NDIM - 1, NDIM>;
+  template struct InteractionPlan<NDIM, NDIM>;
+
+  template struct InteractionOperator<NDIM - 1, NDIM>;
+  template struct InteractionOperator<NDIM, NDIM>;
+
+  template void
+  compute_interaction_plan(
+    const PatchMap<NDIM - 1, NDIM>          &patch_map,
+    const DoFHandler<NDIM - 1, NDIM>        &position_dof_handler,
+    const Vector<double>                    &position,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    InteractionPlan<NDIM - 1, NDIM>         &plan);
+
+  template void
+  compute_interaction_plan(
+    const PatchMap<NDIM, NDIM>          &patch_map,
+    const DoFHandler<NDIM, NDIM>        &position_dof_handler,
+    const Vector<double>                &position,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    InteractionPlan<NDIM, NDIM>         &plan);
+
+  template void
+  compute_interaction_plan_weights(
+    const PatchMap<NDIM - 1, NDIM>          &patch_map,
+    const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+    const Mapping<NDIM - 1, NDIM>           &mapping,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    InteractionPlan<NDIM - 1, NDIM>         &plan);
+
+  template void
+  compute_interaction_plan_weights(
+    const PatchMap<NDIM, NDIM>          &patch_map,
+    const DoFHandler<NDIM, NDIM>        &dof_handler,
+    const Mapping<NDIM, NDIM>           &mapping,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    InteractionPlan<NDIM, NDIM>         &plan);
+
+  template void
+  compress_interaction_plan(const PatchMap<NDIM - 1, NDIM>  &patch_map,
+                            const double                     tolerance,
+                            InteractionPlan<NDIM - 1, NDIM> &plan);
+
+  template void
+  compress_interaction_plan(const PatchMap<NDIM, NDIM>  &patch_map,
+                            const double                 tolerance,
+                            InteractionPlan<NDIM, NDIM> &plan);
+
+  template void
+  compute_interaction_operator(
+    const std::string                       &kernel_name,
+    const int                                data_index,
+    const PatchMap<NDIM - 1, NDIM>          &patch_map,
+    const InteractionPlan<NDIM - 1, NDIM>   &plan,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+    const Mapping<NDIM - 1, NDIM>           &mapping,
+    InteractionOperator<NDIM - 1, NDIM>     &op);
+
+  template void
+  compute_interaction_operator(
+    const std::string                   &kernel_name,
+    const int                            data_index,
+    const PatchMap<NDIM, NDIM>          &patch_map,
+    const InteractionPlan<NDIM, NDIM>   &plan,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    const DoFHandler<NDIM, NDIM>        &dof_handler,
+    const Mapping<NDIM, NDIM>           &mapping,
+    InteractionOperator<NDIM, NDIM>     &op);
+
   template void
   tag_cells(const std::vector<BoundingBox<NDIM, float>>           &bboxes,
             const int                                              tag_index,
-            SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> &patch_level);
+            SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> &patch_level,
+            const int                                              buffer);
 
   template void
   tag_cells(const std::vector<BoundingBox<NDIM, double>>          &bboxes,
             const int                                              tag_index,
-            SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> &patch_level);
+            SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> &patch_level,
+            const int                                              buffer);
+
+  template void
+  tag_cells(const ArrayView<const BoundingBox<NDIM, float>>       &bboxes,
+            const int                                              tag_index,
+            SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> &patch_level,
+            const int                                              buffer);
+
+  template void
+  tag_cells(const ArrayView<const BoundingBox<NDIM, double>>      &bboxes,
+            const int                                              tag_index,
+            SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> &patch_level,
+            const int                                              buffer);
 
   template void
   count_quadrature_points(const int                         qp_data_index,
                           PatchMap<NDIM - 1, NDIM>         &patch_map,
                           const Mapping<NDIM - 1, NDIM>    &position_mapping,
                           const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<NDIM - 1>> &quadratures);
+                          const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                          const double,
+                          const double);
 
   template void
   count_quadrature_points(const int                         qp_data_index,
                           PatchMap<NDIM, NDIM>             &patch_map,
                           const Mapping<NDIM, NDIM>        &position_mapping,
                           const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<NDIM>> &quadratures);
+                          const std::vector<Quadrature<NDIM>> &quadratures,
+                          const double,
+                          const double);
+
+  template void
+  count_quadrature_points(const int                              qp_data_index,
+                          PatchMap<NDIM - 1, NDIM>              &patch_map,
+                          const InteractionPlan<NDIM - 1, NDIM> &plan,
+                          const double,
+                          const double);
+
+  template void
+  count_quadrature_points(const int                          qp_data_index,
+                          PatchMap<NDIM, NDIM>              &patch_map,
+                          const InteractionPlan<NDIM, NDIM> &plan,
+                          const double,
+                          const double);
 
   template void
   count_nodes(const int                      node_count_data_index,
               NodalPatchMap<NDIM - 1, NDIM> &nodal_patch_map,
-              const Vector<double>          &position);
+              const Vector<double>          &position,
+              const double);
 
   template void
   count_nodes(const int                  node_count_data_index,
               NodalPatchMap<NDIM, NDIM> &nodal_patch_map,
-              const Vector<double>      &position);
+              const Vector<double>      &position,
+              const double);
 
   template void
   compute_projection_rhs(const std::string                &kernel_name,
@@ -1322,7 +4800,32 @@ namespace fdl
                          const std::vector<Quadrature<NDIM - 1>> &quadratures,
                          const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
                          const Mapping<NDIM - 1, NDIM>           &mapping,
-                         Vector<double>                          &rhs);
+                         Vector<double>                          &rhs,
+                         const unsigned int                       n_threads);
+
+  template void
+  compute_projection_rhs(const std::string                &kernel_name,
+                         const int                         data_index,
+                         const PatchMap<NDIM - 1, NDIM>   &patch_map,
+                         const Mapping<NDIM - 1, NDIM>    &position_mapping,
+                         const std::vector<unsigned char> &quadrature_indices,
+                         const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                         const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+                         const Mapping<NDIM - 1, NDIM>           &mapping,
+                         Vector<float>                           &rhs,
+                         const unsigned int                       n_threads);
+
+  template void
+  compute_projection_rhs(const std::string                &kernel_name,
+                         const int                         data_index,
+                         const PatchMap<NDIM>             &patch_map,
+                         const Mapping<NDIM>              &position_mapping,
+                         const std::vector<unsigned char> &quadrature_indices,
+                         const std::vector<Quadrature<NDIM>> &quadratures,
+                         const DoFHandler<NDIM>              &dof_handler,
+                         const Mapping<NDIM>                 &mapping,
+                         Vector<double>                      &rhs,
+                         const unsigned int                   n_threads);
 
   template void
   compute_projection_rhs(const std::string                &kernel_name,
@@ -1333,14 +4836,105 @@ namespace fdl
                          const std::vector<Quadrature<NDIM>> &quadratures,
                          const DoFHandler<NDIM>              &dof_handler,
                          const Mapping<NDIM>                 &mapping,
+                         Vector<float>                       &rhs,
+                         const unsigned int                   n_threads);
+
+  template void
+  compute_projection_rhs(const std::string                     &kernel_name,
+                         const int                              data_index,
+                         const PatchMap<NDIM - 1, NDIM>        &patch_map,
+                         const InteractionPlan<NDIM - 1, NDIM> &plan,
+                         const std::vector<unsigned char> &quadrature_indices,
+                         const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                         const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+                         const Mapping<NDIM - 1, NDIM>           &mapping,
+                         Vector<double>                          &rhs);
+
+  template void
+  compute_projection_rhs(const std::string                     &kernel_name,
+                         const int                              data_index,
+                         const PatchMap<NDIM - 1, NDIM>        &patch_map,
+                         const InteractionPlan<NDIM - 1, NDIM> &plan,
+                         const std::vector<unsigned char> &quadrature_indices,
+                         const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                         const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+                         const Mapping<NDIM - 1, NDIM>           &mapping,
+                         Vector<float>                           &rhs);
+
+  template void
+  compute_projection_rhs(const std::string                 &kernel_name,
+                         const int                          data_index,
+                         const PatchMap<NDIM>              &patch_map,
+                         const InteractionPlan<NDIM, NDIM> &plan,
+                         const std::vector<unsigned char>  &quadrature_indices,
+                         const std::vector<Quadrature<NDIM>> &quadratures,
+                         const DoFHandler<NDIM>              &dof_handler,
+                         const Mapping<NDIM>                 &mapping,
                          Vector<double>                      &rhs);
 
+  template void
+  compute_projection_rhs(const std::string                 &kernel_name,
+                         const int                          data_index,
+                         const PatchMap<NDIM>              &patch_map,
+                         const InteractionPlan<NDIM, NDIM> &plan,
+                         const std::vector<unsigned char>  &quadrature_indices,
+                         const std::vector<Quadrature<NDIM>> &quadratures,
+                         const DoFHandler<NDIM>              &dof_handler,
+                         const Mapping<NDIM>                 &mapping,
+                         Vector<float>                       &rhs);
+
+  template void
+  compute_projection_rhs(
+    const std::string                                  &kernel_name,
+    const std::vector<int>                             &data_indices,
+    const PatchMap<NDIM - 1, NDIM>                     &patch_map,
+    const InteractionPlan<NDIM - 1, NDIM>              &plan,
+    const std::vector<unsigned char>                   &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>>            &quadratures,
+    const std::vector<const DoFHandler<NDIM - 1, NDIM> *> &dof_handlers,
+    const std::vector<const Mapping<NDIM - 1, NDIM> *> &mappings,
+    const std::vector<Vector<double> *>                &rhs);
+
+  template void
+  compute_projection_rhs(
+    const std::string                              &kernel_name,
+    const std::vector<int>                         &data_indices,
+    const PatchMap<NDIM, NDIM>                     &patch_map,
+    const InteractionPlan<NDIM, NDIM>              &plan,
+    const std::vector<unsigned char>               &quadrature_indices,
+    const std::vector<Quadrature<NDIM>>            &quadratures,
+    const std::vector<const DoFHandler<NDIM, NDIM> *> &dof_handlers,
+    const std::vector<const Mapping<NDIM, NDIM> *> &mappings,
+    const std::vector<Vector<double> *>            &rhs);
+
+  template void
+  compute_projection_rhs(const InteractionOperator<NDIM - 1, NDIM> &op,
+                         const PatchMap<NDIM - 1, NDIM>            &patch_map,
+                         Vector<double>                            &rhs);
+
+  template void
+  compute_projection_rhs(const InteractionOperator<NDIM - 1, NDIM> &op,
+                         const PatchMap<NDIM - 1, NDIM>            &patch_map,
+                         Vector<float>                             &rhs);
+
+  template void
+  compute_projection_rhs(const InteractionOperator<NDIM, NDIM> &op,
+                         const PatchMap<NDIM, NDIM>            &patch_map,
+                         Vector<double>                        &rhs);
+
+  template void
+  compute_projection_rhs(const InteractionOperator<NDIM, NDIM> &op,
+                         const PatchMap<NDIM, NDIM>            &patch_map,
+                         Vector<float>                         &rhs);
+
   template void
   compute_nodal_interpolation(const std::string                   &kernel_name,
                               const int                            data_index,
                               const NodalPatchMap<NDIM - 1, NDIM> &patch_map,
                               const Vector<double>                &position,
-                              Vector<double> &interpolated_values);
+                              Vector<double>     &interpolated_values,
+                              const unsigned int n_threads,
+                              const bool         use_owners);
 
 
   template void
@@ -1348,7 +4942,24 @@ namespace fdl
                               const int                        data_index,
                               const NodalPatchMap<NDIM, NDIM> &patch_map,
                               const Vector<double>            &position,
-                              Vector<double> &interpolated_values);
+                              Vector<double>     &interpolated_values,
+                              const unsigned int n_threads,
+                              const bool         use_owners);
+
+  template void
+  compute_spread(const std::string                       &kernel_name,
+                 const int                                data_index,
+                 PatchMap<NDIM - 1, NDIM>                &patch_map,
+                 const Mapping<NDIM - 1, NDIM>           &position_mapping,
+                 const std::vector<unsigned char>        &quadrature_indices,
+                 const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                 const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+                 const Mapping<NDIM - 1, NDIM>           &mapping,
+                 const Vector<double>                    &solution,
+                 const unsigned int                      n_threads,
+                 const bool                              sort_points,
+                 const double                            spread_cutoff,
+                 SpreadCutoffStatistics                  *statistics);
 
   template void
   compute_spread(const std::string                       &kernel_name,
@@ -1359,7 +4970,26 @@ namespace fdl
                  const std::vector<Quadrature<NDIM - 1>> &quadratures,
                  const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
                  const Mapping<NDIM - 1, NDIM>           &mapping,
-                 const Vector<double>                    &solution);
+                 const Vector<float>                     &solution,
+                 const unsigned int                      n_threads,
+                 const bool                              sort_points,
+                 const double                            spread_cutoff,
+                 SpreadCutoffStatistics                  *statistics);
+
+  template void
+  compute_spread(const std::string                   &kernel_name,
+                 const int                            data_index,
+                 PatchMap<NDIM, NDIM>                &patch_map,
+                 const Mapping<NDIM, NDIM>           &position_mapping,
+                 const std::vector<unsigned char>    &quadrature_indices,
+                 const std::vector<Quadrature<NDIM>> &quadratures,
+                 const DoFHandler<NDIM, NDIM>        &dof_handler,
+                 const Mapping<NDIM, NDIM>           &mapping,
+                 const Vector<double>                &solution,
+                 const unsigned int                  n_threads,
+                 const bool                          sort_points,
+                 const double                        spread_cutoff,
+                 SpreadCutoffStatistics              *statistics);
 
   template void
   compute_spread(const std::string                   &kernel_name,
@@ -1370,7 +5000,119 @@ namespace fdl
                  const std::vector<Quadrature<NDIM>> &quadratures,
                  const DoFHandler<NDIM, NDIM>        &dof_handler,
                  const Mapping<NDIM, NDIM>           &mapping,
-                 const Vector<double>                &solution);
+                 const Vector<float>                 &solution,
+                 const unsigned int                  n_threads,
+                 const bool                          sort_points,
+                 const double                        spread_cutoff,
+                 SpreadCutoffStatistics              *statistics);
+
+  template void
+  compute_spread(const std::string                       &kernel_name,
+                 const int                                data_index,
+                 PatchMap<NDIM - 1, NDIM>                &patch_map,
+                 const InteractionPlan<NDIM - 1, NDIM>   &plan,
+                 const std::vector<unsigned char>        &quadrature_indices,
+                 const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                 const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+                 const Mapping<NDIM - 1, NDIM>           &mapping,
+                 const Vector<double>                    &solution,
+                 const unsigned int                      n_threads,
+                 const bool                              sort_points,
+                 const double                            spread_cutoff,
+                 SpreadCutoffStatistics                  *statistics);
+
+  template void
+  compute_spread(const std::string                       &kernel_name,
+                 const int                                data_index,
+                 PatchMap<NDIM - 1, NDIM>                &patch_map,
+                 const InteractionPlan<NDIM - 1, NDIM>   &plan,
+                 const std::vector<unsigned char>        &quadrature_indices,
+                 const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                 const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+                 const Mapping<NDIM - 1, NDIM>           &mapping,
+                 const Vector<float>                     &solution,
+                 const unsigned int                      n_threads,
+                 const bool                              sort_points,
+                 const double                            spread_cutoff,
+                 SpreadCutoffStatistics                  *statistics);
+
+  template void
+  compute_spread(const std::string                   &kernel_name,
+                 const int                            data_index,
+                 PatchMap<NDIM, NDIM>                &patch_map,
+                 const InteractionPlan<NDIM, NDIM>   &plan,
+                 const std::vector<unsigned char>    &quadrature_indices,
+                 const std::vector<Quadrature<NDIM>> &quadratures,
+                 const DoFHandler<NDIM, NDIM>        &dof_handler,
+                 const Mapping<NDIM, NDIM>           &mapping,
+                 const Vector<double>                &solution,
+                 const unsigned int                  n_threads,
+                 const bool                          sort_points,
+                 const double                        spread_cutoff,
+                 SpreadCutoffStatistics              *statistics);
+
+  template void
+  compute_spread(const std::string                   &kernel_name,
+                 const int                            data_index,
+                 PatchMap<NDIM, NDIM>                &patch_map,
+                 const InteractionPlan<NDIM, NDIM>   &plan,
+                 const std::vector<unsigned char>    &quadrature_indices,
+                 const std::vector<Quadrature<NDIM>> &quadratures,
+                 const DoFHandler<NDIM, NDIM>        &dof_handler,
+                 const Mapping<NDIM, NDIM>           &mapping,
+                 const Vector<float>                 &solution,
+                 const unsigned int                  n_threads,
+                 const bool                          sort_points,
+                 const double                        spread_cutoff,
+                 SpreadCutoffStatistics              *statistics);
+
+  template void
+  compute_spread(
+    const std::string                                     &kernel_name,
+    const std::vector<int>                                &data_indices,
+    PatchMap<NDIM - 1, NDIM>                              &patch_map,
+    const InteractionPlan<NDIM - 1, NDIM>                 &plan,
+    const std::vector<unsigned char>                      &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>>               &quadratures,
+    const std::vector<const DoFHandler<NDIM - 1, NDIM> *> &dof_handlers,
+    const std::vector<const Mapping<NDIM - 1, NDIM> *>    &mappings,
+    const std::vector<const Vector<double> *>             &solutions);
+
+  template void
+  compute_spread(
+    const std::string                                 &kernel_name,
+    const std::vector<int>                            &data_indices,
+    PatchMap<NDIM, NDIM>                              &patch_map,
+    const InteractionPlan<NDIM, NDIM>                 &plan,
+    const std::vector<unsigned char>                  &quadrature_indices,
+    const std::vector<Quadrature<NDIM>>               &quadratures,
+    const std::vector<const DoFHandler<NDIM, NDIM> *> &dof_handlers,
+    const std::vector<const Mapping<NDIM, NDIM> *>    &mappings,
+    const std::vector<const Vector<double> *>         &solutions);
+
+  template void
+  compute_spread(const InteractionOperator<NDIM - 1, NDIM> &op,
+                 PatchMap<NDIM - 1, NDIM>                  &patch_map,
+                 const Vector<double>                      &solution,
+                 const unsigned int                         n_threads);
+
+  template void
+  compute_spread(const InteractionOperator<NDIM - 1, NDIM> &op,
+                 PatchMap<NDIM - 1, NDIM>                  &patch_map,
+                 const Vector<float>                       &solution,
+                 const unsigned int                         n_threads);
+
+  template void
+  compute_spread(const InteractionOperator<NDIM, NDIM> &op,
+                 PatchMap<NDIM, NDIM>                  &patch_map,
+                 const Vector<double>                  &solution,
+                 const unsigned int                     n_threads);
+
+  template void
+  compute_spread(const InteractionOperator<NDIM, NDIM> &op,
+                 PatchMap<NDIM, NDIM>                  &patch_map,
+                 const Vector<float>                   &solution,
+                 const unsigned int                     n_threads);
 
   template void
   compute_nodal_spread(const std::string             &kernel_name,
@@ -1393,4 +5135,12 @@ namespace fdl
     const Point<NDIM>                   &stencil_start,
     const double                        &stencil_width,
     const unsigned int                   stencil_axis);
+
+  template void
+  intersect_patch_with_simplex(
+    const std::array<Point<NDIM>, NDIM>      &simplex,
+    const tbox::Pointer<hier::Patch<NDIM>>   &patch,
+    const unsigned char                       cell_level,
+    const int                                 cell_index,
+    internal::PatchSingleIntersections<NDIM> &intersections);
 } // namespace fdl
@@ -0,0 +1,181 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/box_utilities.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+#include <fiddle/interaction/marker_point_interaction.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <CartesianPatchGeometry.h>
+#include <PatchHierarchy.h>
+#include <tbox/Database.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  template <int spacedim>
+  MarkerPointInteraction<spacedim>::MarkerPointInteraction()
+    : communicator(MPI_COMM_NULL)
+    , n_interpolation_threads(1)
+  {}
+
+  template <int spacedim>
+  MarkerPointInteraction<spacedim>::MarkerPointInteraction(
+    const tbox::Pointer<tbox::Database>          &input_db,
+    const MPI_Comm                                communicator,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const int                                     level_number,
+    const Vector<double>                         &position)
+    : MarkerPointInteraction()
+  {
+    reinit(input_db, communicator, patch_hierarchy, level_number, position);
+  }
+
+  template <int spacedim>
+  void
+  MarkerPointInteraction<spacedim>::reinit(
+    const tbox::Pointer<tbox::Database>          &input_db,
+    const MPI_Comm                                communicator,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const int                                     level_number,
+    const Vector<double>                         &position)
+  {
+    this->communicator = communicator;
+    const double ghost_cell_fraction =
+      input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0);
+    AssertThrow(ghost_cell_fraction > 0.0,
+                ExcMessage("Marker points require that ghost_cell_fraction "
+                           "be positive."));
+    const int n_threads =
+      input_db->getIntegerWithDefault("n_interpolation_threads", 1);
+    AssertThrow(n_threads > 0,
+                ExcMessage("The number of interpolation threads should be "
+                           "positive."));
+    n_interpolation_threads = n_threads;
+
+    const auto patch_level = patch_hierarchy->getPatchLevel(level_number);
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches =
+      extract_patches(patch_level);
+    std::vector<std::vector<BoundingBox<spacedim>>> owner_bboxes;
+    for (const auto &patch : patches)
+      owner_bboxes.push_back({box_to_bbox(patch->getBox(), patch_level)});
+
+    double patch_dx_min = std::numeric_limits<double>::max();
+    if (patches.size() > 0)
+      {
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
+          patches.back()->getPatchGeometry();
+        Assert(geometry, ExcFDLNotImplemented());
+        const double *const patch_dx = geometry->getDx();
+        patch_dx_min = *std::min_element(patch_dx, patch_dx + spacedim);
+      }
+    std::vector<std::vector<BoundingBox<spacedim>>> bboxes = owner_bboxes;
+    for (auto &vec : bboxes)
+      for (auto &box : vec)
+        box.extend(patch_dx_min * ghost_cell_fraction);
+    // Like NodalInteraction, make sure that points on the upper boundary of
+    // the domain are owned by some patch
+    for (auto &vec : owner_bboxes)
+      extend_boundary_bboxes(vec,
+                             patch_level,
+                             patch_dx_min * ghost_cell_fraction);
+
+    // The points are not numbered in any spatially coherent way, so always
+    // pack them
+    nodal_patch_map.reinit(patches, bboxes, position, true, owner_bboxes);
+  }
+
+  template <int spacedim>
+  void
+  MarkerPointInteraction<spacedim>::interpolate(
+    const std::string    &kernel_name,
+    const int             data_index,
+    const Vector<double> &position,
+    Vector<double>       &values) const
+  {
+    AssertThrow(communicator != MPI_COMM_NULL,
+                ExcMessage("This object has not been set up yet."));
+    values.reinit(position.size());
+    // Like NodalInteraction, owners can only interpolate points which are
+    // still within one cell of their patches
+    const std::size_t n_local_outside =
+      nodal_patch_map.has_owners() ?
+        nodal_patch_map.count_nodes_outside_owners(position) :
+        0;
+    const bool use_owners =
+      Utilities::MPI::sum(n_local_outside, communicator) == 0;
+    compute_nodal_interpolation(kernel_name,
+                                data_index,
+                                nodal_patch_map,
+                                position,
+                                values,
+                                n_interpolation_threads,
+                                use_owners);
+    const auto view = make_array_view(values.begin(), values.end());
+    if (use_owners)
+      {
+        // Each point is interpolated by at most one patch on one processor
+        // and is zero everywhere else
+        Utilities::MPI::sum(view, communicator, view);
+      }
+    else
+      {
+        // Values which were not interpolated anywhere are -DBL_MAX and
+        // correspond to points outside the level
+        Utilities::MPI::max(view, communicator, view);
+        for (double &value : values)
+          if (value == std::numeric_limits<double>::lowest())
+            value = 0.0;
+      }
+  }
+
+  template <int spacedim>
+  void
+  MarkerPointInteraction<spacedim>::spread(const std::string    &kernel_name,
+                                           const int             data_index,
+                                           const Vector<double> &position,
+                                           const Vector<double> &values)
+  {
+    compute_nodal_spread(
+      kernel_name, data_index, nodal_patch_map, position, values);
+  }
+
+  template <int spacedim>
+  void
+  MarkerPointInteraction<spacedim>::add_workload(const int workload_index,
+                                                 const Vector<double> &position,
+                                                 const double point_weight)
+  {
+    count_nodes(workload_index, nodal_patch_map, position, point_weight);
+  }
+
+  template <int spacedim>
+  std::size_t
+  MarkerPointInteraction<spacedim>::n_local_points() const
+  {
+    std::size_t n_points = 0;
+    if (nodal_patch_map.has_owners())
+      for (std::size_t patch_n = 0; patch_n < nodal_patch_map.size();
+           ++patch_n)
+        n_points += nodal_patch_map.get_owned_dofs(patch_n).n_elements() /
+                    spacedim;
+    return n_points;
+  }
+
+  template <int spacedim>
+  std::size_t
+  MarkerPointInteraction<spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) + nodal_patch_map.memory_consumption();
+  }
+
+  template class MarkerPointInteraction<NDIM>;
+} // namespace fdl
@@ -7,6 +7,9 @@
 
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+
 #include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_tools.h>
 
@@ -15,8 +18,11 @@
 #include <CartesianPatchGeometry.h>
 #include <PatchHierarchy.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cmath>
 #include <numeric>
+#include <string>
 
 namespace fdl
 {
@@ -57,17 +63,23 @@ namespace fdl
 
   template <int dim, int spacedim>
   NodalInteraction<dim, spacedim>::NodalInteraction()
+    : pack_nodes(false)
+    , interpolate_from_owners(false)
+    , n_interpolation_threads(1)
   {}
 
   template <int dim, int spacedim>
   NodalInteraction<dim, spacedim>::NodalInteraction(
     const tbox::Pointer<tbox::Database>                  &input_db,
     const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-    const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
+    const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
     tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
     const std::pair<int, int>                            &level_numbers,
     const DoFHandler<dim, spacedim>                      &position_dof_handler,
     const LinearAlgebra::distributed::Vector<double>     &position)
+    : pack_nodes(false)
+    , interpolate_from_owners(false)
+    , n_interpolation_threads(1)
   {
     reinit(input_db,
            native_tria,
@@ -83,8 +95,9 @@ namespace fdl
   NodalInteraction<dim, spacedim>::reinit(
     const tbox::Pointer<tbox::Database> & /*input_db*/,
     const parallel::shared::Triangulation<dim, spacedim> & /*native_tria*/,
-    const std::vector<BoundingBox<spacedim, float>> & /*active_cell_bboxes*/,
-    const std::vector<float> & /*active_cell_lengths*/,
+    const ArrayView<const BoundingBox<spacedim, float>> &
+    /*active_cell_bboxes*/,
+    const ArrayView<const float> & /*active_cell_lengths*/,
     tbox::Pointer<hier::PatchHierarchy<spacedim>> /*patch_hierarchy*/,
     const std::pair<int, int> & /*level_numbers*/)
   {
@@ -100,12 +113,22 @@ namespace fdl
   NodalInteraction<dim, spacedim>::reinit(
     const tbox::Pointer<tbox::Database>                  &input_db,
     const parallel::shared::Triangulation<dim, spacedim> &native_tria,
-    const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
+    const ArrayView<const BoundingBox<spacedim, float>>  &active_cell_bboxes,
     tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
     const std::pair<int, int>                            &level_numbers,
     const DoFHandler<dim, spacedim>                      &position_dof_handler,
     const LinearAlgebra::distributed::Vector<double>     &position)
   {
+    // Nodal interactions use every node of the overlap triangulation, so
+    // they cannot be restricted to a subset of the cells
+    std::string cells_string =
+      input_db->getStringWithDefault("interaction_cells", "ALL");
+    std::transform(cells_string.begin(),
+                   cells_string.end(),
+                   cells_string.begin(),
+                   [](const unsigned char c) { return std::tolower(c); });
+    AssertThrow(cells_string == "all", ExcFDLNotImplemented());
+
     // base class doesn't actually read this value
     std::vector<float> active_cell_lengths;
     InteractionBase<dim, spacedim>::reinit(input_db,
@@ -130,6 +153,15 @@ namespace fdl
 
     // This won't work correctly yet with no ghost cell fraction
     AssertThrow(ghost_cell_fraction > 0.0, ExcFDLNotImplemented());
+    pack_nodes = input_db->getBoolWithDefault("pack_nodes", false);
+    interpolate_from_owners =
+      input_db->getBoolWithDefault("interpolate_from_owners", false);
+    const int n_threads =
+      input_db->getIntegerWithDefault("n_interpolation_threads", 1);
+    AssertThrow(n_threads > 0,
+                ExcMessage("The number of interpolation threads should be "
+                           "positive."));
+    n_interpolation_threads = n_threads;
 
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
     std::vector<std::vector<BoundingBox<spacedim>>>   bboxes;
@@ -164,21 +196,34 @@ namespace fdl
         bboxes.back().push_back(box_to_bbox(patch->getBox(), patch_level));
       }
 
+    double patch_dx_min = std::numeric_limits<double>::max();
+    if (patches.size() > 0)
+      {
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
+          patches.back()->getPatchGeometry();
+        Assert(geometry, ExcFDLNotImplemented());
+        const double *const patch_dx = geometry->getDx();
+        patch_dx_min = *std::min_element(patch_dx, patch_dx + spacedim);
+      }
+
+    // Nodes are owned by the patch containing them, excluding ghost regions.
+    // Since owner boxes are half-open, nodes on the upper boundary of the
+    // domain would not be owned by any patch - hence, like the ghost regions
+    // below, extend boxes on the boundary of the domain outward.
+    std::vector<std::vector<BoundingBox<spacedim>>> owner_bboxes;
+    if (interpolate_from_owners)
+      {
+        owner_bboxes = bboxes;
+        for (auto &vec : owner_bboxes)
+          extend_boundary_bboxes(vec,
+                                 patch_level,
+                                 patch_dx_min * ghost_cell_fraction);
+      }
+
     // Increase all the boxes by the ghost cell fraction:
-    {
-      double patch_dx_min = std::numeric_limits<double>::max();
-      if (patches.size() > 0)
-        {
-          const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
-            patches.back()->getPatchGeometry();
-          Assert(geometry, ExcFDLNotImplemented());
-          const double *const patch_dx = geometry->getDx();
-          patch_dx_min = *std::min_element(patch_dx, patch_dx + spacedim);
-        }
-      for (auto &vec : bboxes)
-        for (auto &box : vec)
-          box.extend(patch_dx_min * ghost_cell_fraction);
-    }
+    for (auto &vec : bboxes)
+      for (auto &box : vec)
+        box.extend(patch_dx_min * ghost_cell_fraction);
 
     // Set up class members:
     {
@@ -188,12 +233,13 @@ namespace fdl
                &*this->native_dof_handlers[0] == &position_dof_handler,
              ExcFDLInternalError());
       nodal_patch_maps.push_back(std::make_shared<NodalPatchMap<dim, spacedim>>(
-        patches, bboxes, overlap_position));
+        patches, bboxes, overlap_position, pack_nodes, owner_bboxes));
 
       this->native_position_dof_handler = &position_dof_handler;
       this->overlap_position            = std::move(overlap_position);
       this->patches                     = std::move(patches);
       this->bboxes                      = std::move(bboxes);
+      this->owner_bboxes                = std::move(owner_bboxes);
     }
   }
 
@@ -215,9 +261,12 @@ namespace fdl
     const auto ptr = &native_dof_handler;
     if (std::find(this->native_dof_handlers.begin(),
                   this->native_dof_handlers.end(),
-                  ptr) == this->native_dof_handlers.end())
+                  ptr) == this->native_dof_handlers.end() &&
+        !this->reuse_previous_dof_handler(native_dof_handler) &&
+        !this->share_overlap_dof_handler(native_dof_handler))
       {
         this->native_dof_handlers.emplace_back(ptr);
+        this->overlap_dof_indices.push_back(this->overlap_dof_handlers.size());
         this->overlap_dof_handlers.emplace_back(
           std::make_unique<DoFHandler<dim, spacedim>>(this->overlap_tria));
         auto &overlap_dof_handler = *this->overlap_dof_handlers.back();
@@ -229,9 +278,11 @@ namespace fdl
         // to use the same numbering on each cell. Hence we have to call that
         // first and then combine it with the nodal renumbering.
         std::vector<types::global_dof_index> overlap_to_native_dofs =
-          compute_overlap_to_native_dof_translation(this->overlap_tria,
-                                                    overlap_dof_handler,
-                                                    native_dof_handler);
+          compute_overlap_to_native_dof_translation(
+            this->overlap_tria,
+            this->get_overlap_cell_exchange(),
+            overlap_dof_handler,
+            native_dof_handler);
 
         std::vector<types::global_dof_index> nodal_renumbering(
           overlap_dof_handler.n_dofs());
@@ -276,6 +327,97 @@ namespace fdl
   }
 
 
+  template <int dim, int spacedim>
+  const Vector<double> &
+  NodalInteraction<dim, spacedim>::get_nodes(
+    const Transaction<dim, spacedim> &trans,
+    Vector<double>                   &nodal_coordinates) const
+  {
+    const bool reuse_nodes =
+      trans.native_position_dof_handler->get_fe().base_element(0) ==
+      trans.native_dof_handler->get_fe().base_element(0);
+    if (reuse_nodes)
+      return trans.overlap_position;
+
+    nodal_coordinates = compute_nodes(
+      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
+      trans.overlap_position,
+      this->get_overlap_dof_handler(*trans.native_dof_handler));
+    return nodal_coordinates;
+  }
+
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  NodalInteraction<dim, spacedim>::compute_projection_rhs_scatter_start(
+    const std::string                                &kernel_name,
+    const int                                         data_idx,
+    const DoFHandler<dim, spacedim>                  &position_dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position,
+    const DoFHandler<dim, spacedim>                  &dof_handler,
+    const Mapping<dim, spacedim>                     &mapping,
+    LinearAlgebra::distributed::Vector<double>       &rhs)
+  {
+    auto t_ptr = InteractionBase<dim, spacedim>::
+      compute_projection_rhs_scatter_start(kernel_name,
+                                           data_idx,
+                                           position_dof_handler,
+                                           position,
+                                           dof_handler,
+                                           mapping,
+                                           rhs);
+    auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
+    trans.n_local_nodes_outside_owners = 0;
+    trans.n_nodes_outside_owners       = 0;
+    if (!interpolate_from_owners)
+      return t_ptr;
+
+    // Owners can only interpolate nodes which are still within one cell of
+    // their patches. Since this check requires the overlap position, finish
+    // the position scatter now: every processor calls this function for its
+    // parts in the same order, so this does not deadlock and the reduction is
+    // started in the same order everywhere.
+    t_ptr = InteractionBase<dim, spacedim>::
+      compute_projection_rhs_scatter_finish(std::move(t_ptr));
+    const NodalPatchMap<dim, spacedim> &patch_map =
+      get_nodal_patch_map(*trans.native_dof_handler);
+    if (patch_map.has_owners())
+      {
+        Vector<double> nodal_coordinates;
+        trans.n_local_nodes_outside_owners =
+          patch_map.count_nodes_outside_owners(
+            get_nodes(trans, nodal_coordinates));
+      }
+    const int ierr = MPI_Iallreduce(&trans.n_local_nodes_outside_owners,
+                                    &trans.n_nodes_outside_owners,
+                                    1,
+                                    MPI_UNSIGNED_LONG_LONG,
+                                    MPI_SUM,
+                                    this->communicator,
+                                    &trans.owner_check_request);
+    AssertThrowMPI(ierr);
+
+    return t_ptr;
+  }
+
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  NodalInteraction<dim, spacedim>::compute_projection_rhs_scatter_finish(
+    std::unique_ptr<TransactionBase> t_ptr) const
+  {
+    auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
+    // compute_projection_rhs_scatter_start() already finished the scatter
+    if (trans.operation ==
+          Transaction<dim, spacedim>::Operation::Interpolation &&
+        trans.next_state == Transaction<dim, spacedim>::State::Intermediate)
+      return t_ptr;
+
+    return InteractionBase<dim, spacedim>::
+      compute_projection_rhs_scatter_finish(std::move(t_ptr));
+  }
+
+
   template <int dim, int spacedim>
   std::unique_ptr<TransactionBase>
   NodalInteraction<dim, spacedim>::compute_projection_rhs_intermediate(
@@ -291,25 +433,35 @@ namespace fdl
 
     // If needed, convert the given position vector into the relevant nodal
     // one
-    const bool reuse_nodes =
-      trans.native_position_dof_handler->get_fe().base_element(0) ==
-      trans.native_dof_handler->get_fe().base_element(0);
-    Vector<double> nodal_coordinates;
-    if (!reuse_nodes)
+    Vector<double>        nodal_coordinates;
+    const Vector<double> &nodes = get_nodes(trans, nodal_coordinates);
+    const NodalPatchMap<dim, spacedim> &patch_map =
+      get_nodal_patch_map(*trans.native_dof_handler);
+
+    // If any node moved more than one cell from its owning patch (e.g.,
+    // because ghost_cell_fraction is larger than one) then fall back to
+    // interpolating on every patch and resolving duplicates with a max
+    // reduction. The request was already completed if it was delegated to a
+    // TransactionScheduler.
+    bool use_owners = false;
+    if (interpolate_from_owners)
       {
-        nodal_coordinates = compute_nodes(
-          this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-          trans.overlap_position,
-          this->get_overlap_dof_handler(*trans.native_dof_handler));
+        const int ierr =
+          MPI_Wait(&trans.owner_check_request, MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+        use_owners = trans.n_nodes_outside_owners == 0;
       }
+    trans.rhs_scatter_back_op =
+      use_owners ? VectorOperation::add : VectorOperation::max;
 
     // Actually do the work:
     compute_nodal_interpolation(trans.kernel_name,
                                 trans.current_data_idx,
-                                get_nodal_patch_map(*trans.native_dof_handler),
-                                reuse_nodes ? trans.overlap_position :
-                                              nodal_coordinates,
-                                trans.overlap_rhs);
+                                patch_map,
+                                nodes,
+                                trans.overlap_rhs,
+                                n_interpolation_threads,
+                                use_owners);
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateStart;
     return t_ptr;
@@ -336,25 +488,30 @@ namespace fdl
 
     // If nodes are outside the domain then their value is still -DBL_MAX (in
     // contrast, if a node moved from one patch to another, the max operation
-    // would have resolved the -DBL_MAX value). Hence we need to fix that here:
+    // would have resolved the -DBL_MAX value). Hence we need to fix that here.
+    // Values interpolated from owners are already zero in this case.
     //
     // TODO: if this takes a measurable amount of time to execute then it
     // would be better to only check DoFs which are within 1 cell of the
     // boundary as of the last regrid.
-    auto      &vec  = *trans.native_rhs;
-    const auto size = vec.locally_owned_size();
-    DEAL_II_OPENMP_SIMD_PRAGMA
-    for (types::global_dof_index i = 0; i < size; ++i)
+    if (trans.rhs_scatter_back_op == VectorOperation::max)
       {
-        double &v = vec.local_element(i);
-        if (v == std::numeric_limits<double>::lowest())
-          v = 0.0;
+        auto      &vec  = *trans.native_rhs;
+        const auto size = vec.locally_owned_size();
+        DEAL_II_OPENMP_SIMD_PRAGMA
+        for (types::global_dof_index i = 0; i < size; ++i)
+          {
+            double &v = vec.local_element(i);
+            if (v == std::numeric_limits<double>::lowest())
+              v = 0.0;
+          }
       }
 
     this->return_scatter(*trans.native_position_dof_handler,
                          std::move(trans.position_scatter));
     this->return_scatter(*trans.native_dof_handler,
                          std::move(trans.rhs_scatter));
+    this->return_transaction(std::move(t_ptr));
   }
 
 
@@ -436,7 +593,8 @@ namespace fdl
                 // TODO: casting away const is bad
                 const_cast<NodalPatchMap<dim, spacedim> &>(
                   get_nodal_patch_map(*trans.native_position_dof_handler)),
-                trans.overlap_position);
+                trans.overlap_position,
+                this->workload_point_weight);
 
     trans.next_state =
       WorkloadTransaction<dim, spacedim>::State::AccumulateFinish;
@@ -445,11 +603,31 @@ namespace fdl
   }
 
 
+  template <int dim, int spacedim>
+  std::pair<double, double>
+  NodalInteraction<dim, spacedim>::count_local_interaction_work()
+  {
+    double n_nodes = 0.0;
+    if (nodal_patch_maps.size() > 0 && nodal_patch_maps[0])
+      {
+        const NodalPatchMap<dim, spacedim> &nodal_patch_map =
+          *nodal_patch_maps[0];
+        for (std::size_t patch_n = 0; patch_n < nodal_patch_map.size();
+             ++patch_n)
+          n_nodes += nodal_patch_map[patch_n].first.n_elements() / spacedim;
+      }
+
+    return {n_nodes, 0.0};
+  }
+
+
+
   template <int dim, int spacedim>
   VectorOperation::values
   NodalInteraction<dim, spacedim>::get_rhs_scatter_type() const
   {
-    return VectorOperation::max;
+    return interpolate_from_owners ? VectorOperation::add :
+                                     VectorOperation::max;
   }
 
 
@@ -490,11 +668,31 @@ namespace fdl
         nodal_patch_maps[index] =
           std::make_shared<NodalPatchMap<dim, spacedim>>(patches,
                                                          bboxes,
-                                                         nodal_coordinates);
+                                                         nodal_coordinates,
+                                                         pack_nodes,
+                                                         owner_bboxes);
       }
     return *nodal_patch_maps[index];
   }
 
+  template <int dim, int spacedim>
+  std::size_t
+  NodalInteraction<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t n_bytes = InteractionBase<dim, spacedim>::memory_consumption() +
+                          overlap_position.memory_consumption() +
+                          patches.capacity() * sizeof(patches[0]);
+    for (const auto &patch_bboxes : bboxes)
+      n_bytes += patch_bboxes.capacity() * sizeof(BoundingBox<spacedim>);
+    for (const auto &patch_bboxes : owner_bboxes)
+      n_bytes += patch_bboxes.capacity() * sizeof(BoundingBox<spacedim>);
+    for (const auto &nodal_patch_map : nodal_patch_maps)
+      if (nodal_patch_map)
+        n_bytes += nodal_patch_map->memory_consumption();
+
+    return n_bytes;
+  }
+
   // instantiations
   template class NodalInteraction<NDIM - 1, NDIM>;
   template class NodalInteraction<NDIM, NDIM>;
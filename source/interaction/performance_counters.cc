@@ -0,0 +1,136 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/performance_counters.h>
+
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  PerformanceCounters::PerformanceCounters(const MPI_Comm    &communicator,
+                                           const std::string &filename)
+    : communicator(communicator)
+    , filename(filename)
+    , step_n(0)
+    , n_bytes_sent_at_step_start(get_total_scatter_bytes_sent())
+    , n_bytes_received_at_step_start(get_total_scatter_bytes_received())
+  {}
+
+
+
+  void
+  PerformanceCounters::add(const std::string &name, const double value)
+  {
+    current_counters[name] += value;
+  }
+
+
+
+  void
+  PerformanceCounters::finish_step(const double time)
+  {
+    const std::uint64_t n_bytes_sent     = get_total_scatter_bytes_sent();
+    const std::uint64_t n_bytes_received = get_total_scatter_bytes_received();
+    add("scatter_bytes_sent", n_bytes_sent - n_bytes_sent_at_step_start);
+    add("scatter_bytes_received",
+        n_bytes_received - n_bytes_received_at_step_start);
+    n_bytes_sent_at_step_start     = n_bytes_sent;
+    n_bytes_received_at_step_start = n_bytes_received;
+
+    step_counters.clear();
+    step_counters.swap(current_counters);
+    for (const auto &pair : step_counters)
+      total_counters[pair.first] += pair.second;
+    ++step_n;
+
+    if (filename.empty())
+      return;
+
+    std::vector<double> values;
+    for (const auto &pair : step_counters)
+      values.push_back(pair.second);
+    AssertThrow(Utilities::MPI::min(values.size(), communicator) ==
+                  Utilities::MPI::max(values.size(), communicator),
+                ExcMessage("Every processor must add the same counters."));
+    const std::vector<Utilities::MPI::MinMaxAvg> reduced =
+      Utilities::MPI::min_max_avg(values, communicator);
+
+    if (Utilities::MPI::this_mpi_process(communicator) == 0)
+      {
+        std::ofstream out(filename, std::ios_base::app);
+        out << std::setprecision(12) << "{\"step\": " << step_n
+            << ", \"time\": " << time << ", \"counters\": {";
+        std::size_t i = 0;
+        for (const auto &pair : step_counters)
+          {
+            out << (i == 0 ? "" : ", ") << '"' << pair.first << "\": {"
+                << "\"min\": " << reduced[i].min
+                << ", \"max\": " << reduced[i].max
+                << ", \"sum\": " << reduced[i].sum << '}';
+            ++i;
+          }
+        out << "}}\n";
+      }
+  }
+
+
+
+  double
+  PerformanceCounters::get(const std::string &name) const
+  {
+    const auto it = step_counters.find(name);
+    return it == step_counters.end() ? 0.0 : it->second;
+  }
+
+
+
+  void
+  PerformanceCounters::write_summary(std::ostream &out) const
+  {
+    std::vector<double> values;
+    std::size_t         name_width = 0;
+    for (const auto &pair : total_counters)
+      {
+        values.push_back(pair.second);
+        name_width = std::max(name_width, pair.first.size());
+      }
+    AssertThrow(Utilities::MPI::min(values.size(), communicator) ==
+                  Utilities::MPI::max(values.size(), communicator),
+                ExcMessage("Every processor must add the same counters."));
+    const std::vector<Utilities::MPI::MinMaxAvg> reduced =
+      Utilities::MPI::min_max_avg(values, communicator);
+
+    if (Utilities::MPI::this_mpi_process(communicator) != 0)
+      return;
+
+    const auto old_flags     = out.flags();
+    const auto old_precision = out.precision();
+    out << "Performance counters summed over " << step_n
+        << " time steps:\n"
+        << std::left << std::setw(name_width) << "counter" << std::right
+        << std::setw(14) << "min" << std::setw(14) << "mean" << std::setw(14)
+        << "max" << std::setw(11) << "imbalance" << '\n'
+        << std::setprecision(6);
+    std::size_t i = 0;
+    for (const auto &pair : total_counters)
+      {
+        const double imbalance =
+          reduced[i].avg > 0.0 ? reduced[i].max / reduced[i].avg : 1.0;
+        out << std::left << std::setw(name_width) << pair.first << std::right
+            << std::setw(14) << reduced[i].min << std::setw(14)
+            << reduced[i].avg << std::setw(14) << reduced[i].max
+            << std::setw(11) << imbalance << '\n';
+        ++i;
+      }
+    out.flags(old_flags);
+    out.precision(old_precision);
+  }
+} // namespace fdl
@@ -0,0 +1,265 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/transaction_scheduler.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <string>
+#include <utility>
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  std::size_t
+  TransactionScheduler::add_transaction(
+    std::unique_ptr<TransactionBase> transaction,
+    std::vector<Stage>               new_stages,
+    std::vector<std::string>         new_stage_names)
+  {
+    Assert(transaction, ExcMessage("The transaction should not be null"));
+    transactions.emplace_back(std::move(transaction));
+    for (std::size_t i = new_stage_names.size(); i < new_stages.size(); ++i)
+      new_stage_names.push_back("stage " + std::to_string(i));
+    stages.emplace_back(std::move(new_stages));
+    stage_names.emplace_back(std::move(new_stage_names));
+    wait_times.push_back(0.0);
+    compute_times.push_back(0.0);
+
+    return transactions.size() - 1;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  TransactionScheduler::add_projection_rhs_transaction(
+    InteractionBase<dim, spacedim>  &interaction,
+    std::unique_ptr<TransactionBase> transaction,
+    const std::function<void()>     &finished)
+  {
+    InteractionBase<dim, spacedim> *ptr = &interaction;
+    // scatter_finish() does not do any waiting since we already did it, so
+    // do it right before the actual computations
+    auto compute = [ptr](std::unique_ptr<TransactionBase> t_ptr)
+    {
+      t_ptr = ptr->compute_projection_rhs_scatter_finish(std::move(t_ptr));
+      t_ptr = ptr->compute_projection_rhs_intermediate(std::move(t_ptr));
+      return ptr->compute_projection_rhs_accumulate_start(std::move(t_ptr));
+    };
+    auto finish = [ptr, finished](std::unique_ptr<TransactionBase> t_ptr)
+    {
+      ptr->compute_projection_rhs_accumulate_finish(std::move(t_ptr));
+      if (finished)
+        finished();
+      return std::unique_ptr<TransactionBase>();
+    };
+
+    return add_transaction(std::move(transaction),
+                           {compute, finish},
+                           {"interpolate", "accumulate finish"});
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  TransactionScheduler::add_spread_transaction(
+    InteractionBase<dim, spacedim>  &interaction,
+    std::unique_ptr<TransactionBase> transaction)
+  {
+    InteractionBase<dim, spacedim> *ptr = &interaction;
+    auto compute = [ptr](std::unique_ptr<TransactionBase> t_ptr)
+    {
+      t_ptr = ptr->compute_spread_scatter_finish(std::move(t_ptr));
+      return ptr->compute_spread_intermediate(std::move(t_ptr));
+    };
+    auto finish = [ptr](std::unique_ptr<TransactionBase> t_ptr)
+    {
+      ptr->compute_spread_finish(std::move(t_ptr));
+      return std::unique_ptr<TransactionBase>();
+    };
+
+    return add_transaction(std::move(transaction),
+                           {compute, finish},
+                           {"spread", "spread finish"});
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  TransactionScheduler::add_workload_transaction(
+    InteractionBase<dim, spacedim>  &interaction,
+    std::unique_ptr<TransactionBase> transaction)
+  {
+    InteractionBase<dim, spacedim> *ptr = &interaction;
+    auto compute = [ptr](std::unique_ptr<TransactionBase> t_ptr)
+    { return ptr->add_workload_intermediate(std::move(t_ptr)); };
+    auto finish = [ptr](std::unique_ptr<TransactionBase> t_ptr)
+    {
+      ptr->add_workload_finish(std::move(t_ptr));
+      return std::unique_ptr<TransactionBase>();
+    };
+
+    return add_transaction(std::move(transaction),
+                           {compute, finish},
+                           {"workload", "workload finish"});
+  }
+
+
+
+  void
+  TransactionScheduler::set_tracer(
+    Tracer                         &new_tracer,
+    const std::vector<std::string> &new_transaction_names)
+  {
+    tracer            = &new_tracer;
+    transaction_names = new_transaction_names;
+  }
+
+
+
+  void
+  TransactionScheduler::run()
+  {
+    const std::size_t n_trans = transactions.size();
+
+    std::vector<MPI_Request>  requests;
+    std::vector<std::size_t>  owners;
+    std::vector<unsigned int> n_pending(n_trans);
+    std::vector<std::size_t>  next_stage(n_trans);
+    std::vector<double>       wait_start(n_trans);
+    if (tracer)
+      for (std::size_t i = transaction_names.size(); i < n_trans; ++i)
+        transaction_names.push_back("transaction " + std::to_string(i));
+    // Process transactions in the order they become ready
+    std::vector<std::size_t> ready;
+    std::size_t              ready_n = 0;
+
+    auto post_requests = [&](const std::size_t transaction_n)
+    {
+      for (const MPI_Request &request :
+           transactions[transaction_n]->delegate_outstanding_requests())
+        if (request != MPI_REQUEST_NULL)
+          {
+            requests.push_back(request);
+            owners.push_back(transaction_n);
+            ++n_pending[transaction_n];
+          }
+      wait_start[transaction_n] = MPI_Wtime();
+      if (n_pending[transaction_n] == 0)
+        ready.push_back(transaction_n);
+    };
+    for (std::size_t i = 0; i < n_trans; ++i)
+      {
+        Assert(transactions[i],
+               ExcMessage("Transactions can only be run once"));
+        post_requests(i);
+      }
+
+    std::size_t      n_remaining = n_trans;
+    std::vector<int> indices;
+    while (n_remaining > 0)
+      {
+        while (ready_n < ready.size())
+          {
+            const std::size_t transaction_n = ready[ready_n];
+            ++ready_n;
+            const double start = MPI_Wtime();
+            wait_times[transaction_n] += start - wait_start[transaction_n];
+
+            const std::size_t stage_n = next_stage[transaction_n];
+            auto             &stage   = stages[transaction_n][stage_n];
+            transactions[transaction_n] =
+              stage(std::move(transactions[transaction_n]));
+            ++next_stage[transaction_n];
+            const double end = MPI_Wtime();
+            compute_times[transaction_n] += end - start;
+            if (tracer)
+              {
+                tracer->add_event(transaction_names[transaction_n],
+                                  "wait",
+                                  "mpi",
+                                  wait_start[transaction_n],
+                                  start);
+                tracer->add_event(transaction_names[transaction_n],
+                                  stage_names[transaction_n][stage_n],
+                                  "compute",
+                                  start,
+                                  end);
+              }
+
+            if (next_stage[transaction_n] == stages[transaction_n].size())
+              {
+                transactions[transaction_n].reset();
+                --n_remaining;
+              }
+            else
+              {
+                AssertThrow(transactions[transaction_n],
+                            ExcMessage("Only the last stage of a transaction "
+                                       "may return nullptr"));
+                post_requests(transaction_n);
+              }
+          }
+        if (n_remaining == 0)
+          break;
+
+        // Completed requests are either set to MPI_REQUEST_NULL or (for
+        // persistent requests) made inactive, so MPI_Waitsome() will not
+        // return them again
+        indices.resize(requests.size());
+        int          n_completed = 0;
+        const double start       = MPI_Wtime();
+        const int    ierr        = MPI_Waitsome(requests.size(),
+                                                requests.data(),
+                                                &n_completed,
+                                                indices.data(),
+                                                MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+        const double end = MPI_Wtime();
+        mpi_wait_time += end - start;
+        if (tracer)
+          tracer->add_event("scheduler", "MPI_Waitsome", "mpi", start, end);
+        AssertThrow(n_completed != MPI_UNDEFINED, ExcFDLInternalError());
+        for (int i = 0; i < n_completed; ++i)
+          {
+            const std::size_t owner = owners[indices[i]];
+            Assert(n_pending[owner] > 0, ExcFDLInternalError());
+            if (--n_pending[owner] == 0)
+              ready.push_back(owner);
+          }
+      }
+  }
+
+  // instantiations
+
+  template std::size_t
+  TransactionScheduler::add_projection_rhs_transaction(
+    InteractionBase<NDIM - 1, NDIM> &,
+    std::unique_ptr<TransactionBase>,
+    const std::function<void()> &);
+  template std::size_t
+  TransactionScheduler::add_projection_rhs_transaction(
+    InteractionBase<NDIM, NDIM> &,
+    std::unique_ptr<TransactionBase>,
+    const std::function<void()> &);
+  template std::size_t
+  TransactionScheduler::add_spread_transaction(
+    InteractionBase<NDIM - 1, NDIM> &,
+    std::unique_ptr<TransactionBase>);
+  template std::size_t
+  TransactionScheduler::add_spread_transaction(
+    InteractionBase<NDIM, NDIM> &,
+    std::unique_ptr<TransactionBase>);
+  template std::size_t
+  TransactionScheduler::add_workload_transaction(
+    InteractionBase<NDIM - 1, NDIM> &,
+    std::unique_ptr<TransactionBase>);
+  template std::size_t
+  TransactionScheduler::add_workload_transaction(
+    InteractionBase<NDIM, NDIM> &,
+    std::unique_ptr<TransactionBase>);
+} // namespace fdl
@@ -0,0 +1,90 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/workload_calibration.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  WorkloadCalibration::WorkloadCalibration(const MPI_Comm    &communicator,
+                                           const unsigned int min_n_steps)
+    : communicator(communicator)
+    , min_n_steps(std::max(min_n_steps, 1u))
+    , window_n_points(0.0)
+    , window_n_cells(0.0)
+    , window_time(0.0)
+    , window_n_steps(0)
+    , sums{{0.0, 0.0, 0.0, 0.0, 0.0}}
+    , has_fit(false)
+    , cell_weight(0.0)
+  {}
+
+
+
+  void
+  WorkloadCalibration::start_window(const double n_points,
+                                    const double n_cells)
+  {
+    AssertThrow(n_points >= 0.0 && n_cells >= 0.0,
+                ExcMessage("The numbers of points and cells should be "
+                           "nonnegative."));
+    window_n_points = n_points;
+    window_n_cells  = n_cells;
+    window_time     = 0.0;
+    window_n_steps  = 0;
+  }
+
+
+
+  bool
+  WorkloadCalibration::finish_window()
+  {
+    // Every processor takes the same number of steps, so this is consistent
+    // across the communicator
+    const bool use_window = window_n_steps >= min_n_steps;
+    if (use_window)
+      {
+        const double P = window_n_points;
+        const double C = window_n_cells;
+        const double T = window_time / window_n_steps;
+
+        const double local_sums[5] = {P * P, P * C, C * C, P * T, C * T};
+        double       window_sums[5];
+        Utilities::MPI::sum(local_sums, communicator, window_sums);
+        for (unsigned int i = 0; i < sums.size(); ++i)
+          sums[i] += window_sums[i];
+      }
+    window_time    = 0.0;
+    window_n_steps = 0;
+    if (!use_window)
+      return false;
+
+    const double s_pp = sums[0];
+    const double s_pc = sums[1];
+    const double s_cc = sums[2];
+    const double s_pt = sums[3];
+    const double s_ct = sums[4];
+    if (s_pp <= 0.0)
+      return false;
+
+    // If the points and cells are (nearly) proportional on every processor
+    // then we cannot distinguish their costs, so keep the previous ratio.
+    const double determinant = s_pp * s_cc - s_pc * s_pc;
+    if (determinant <= 1e-12 * s_pp * s_cc)
+      return false;
+
+    const double c_p = (s_cc * s_pt - s_pc * s_ct) / determinant;
+    const double c_c = (s_pp * s_ct - s_pc * s_pt) / determinant;
+    if (!(c_p > 0.0) || !std::isfinite(c_c))
+      return false;
+
+    cell_weight = std::max(c_c / c_p, 0.0);
+    has_fit     = true;
+    return true;
+  }
+} // namespace fdl
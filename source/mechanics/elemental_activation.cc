@@ -0,0 +1,198 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/elemental_activation.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  namespace
+  {
+    /**
+     * Interpolate linearly between two snapshots stored with type Number.
+     */
+    template <typename Number>
+    void
+    interpolate_snapshots(const double            weight,
+                          const Number *const     lower_values,
+                          const Number *const     upper_values,
+                          const ArrayView<double> &activations)
+    {
+      const std::size_t n_cells = activations.size();
+      DEAL_II_OPENMP_SIMD_PRAGMA
+      for (std::size_t i = 0; i < n_cells; ++i)
+        activations[i] = (1.0 - weight) * double(lower_values[i]) +
+                         weight * double(upper_values[i]);
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  ElementalActivation<dim, spacedim>::ElementalActivation(
+    const std::string                  &filename,
+    const Triangulation<dim, spacedim> &tria,
+    const std::string                  &variable_name,
+    const std::vector<double>          &snapshot_times,
+    const double                        period,
+    const unsigned int                  n_buffers,
+    const bool                          use_single_precision)
+    : tria(&tria)
+    , reader(filename, tria, variable_name)
+    , snapshot_times(snapshot_times)
+    , period(period)
+    , single_precision(use_single_precision)
+    , buffered_snapshot_ns(n_buffers, numbers::invalid_unsigned_int)
+    , next_row(0)
+    , prefetched_snapshot_n(numbers::invalid_unsigned_int)
+  {
+    AssertThrow(snapshot_times.size() > 0,
+                ExcMessage("At least one snapshot is required."));
+    AssertThrow(std::is_sorted(snapshot_times.begin(), snapshot_times.end()),
+                ExcMessage("The snapshot times must be increasing."));
+    AssertThrow(period <= 0.0 ||
+                  snapshot_times.back() - snapshot_times.front() < period,
+                ExcMessage("The snapshots must fit inside one period."));
+    AssertThrow(n_buffers >= 2,
+                ExcMessage("At least two snapshots must be kept in memory."));
+
+    local_processor_min_cell_index =
+      std::numeric_limits<types::global_cell_index>::max();
+    unsigned int n_locally_owned_cells = 0;
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          local_processor_min_cell_index =
+            std::min(local_processor_min_cell_index,
+                     cell->global_active_cell_index());
+          ++n_locally_owned_cells;
+        }
+
+    if (single_precision)
+      single_buffered_snapshots.reinit(n_buffers, n_locally_owned_cells);
+    else
+      buffered_snapshots.reinit(n_buffers, n_locally_owned_cells);
+    activations.resize(n_locally_owned_cells);
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  ElementalActivation<dim, spacedim>::load_snapshot(
+    const unsigned int snapshot_n,
+    const unsigned int protected_snapshot_n)
+  {
+    for (unsigned int row = 0; row < buffered_snapshot_ns.size(); ++row)
+      if (buffered_snapshot_ns[row] == snapshot_n)
+        return row;
+
+    const unsigned int n_rows = buffered_snapshot_ns.size();
+    if (buffered_snapshot_ns[next_row] == protected_snapshot_n)
+      next_row = (next_row + 1) % n_rows;
+    const unsigned int row = next_row;
+    next_row               = (next_row + 1) % n_rows;
+
+    // ExodusII time steps start at 1. If a different snapshot was prefetched
+    // then the reader discards it.
+    Vector<double> cell_values(tria->n_active_cells());
+    reader.read(int(snapshot_n) + 1, cell_values);
+    prefetched_snapshot_n = numbers::invalid_unsigned_int;
+
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const auto cell_index =
+            cell->global_active_cell_index() - local_processor_min_cell_index;
+          const double value = cell_values[cell->active_cell_index()];
+          if (single_precision)
+            single_buffered_snapshots(row, cell_index) = float(value);
+          else
+            buffered_snapshots(row, cell_index) = value;
+        }
+    buffered_snapshot_ns[row] = snapshot_n;
+
+    return row;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ElementalActivation<dim, spacedim>::reinit(const double time)
+  {
+    const unsigned int n_snapshots = snapshot_times.size();
+    const double       first_time  = snapshot_times.front();
+    const double       last_time   = snapshot_times.back();
+
+    double t = time;
+    if (period > 0.0)
+      t -= period * std::floor((t - first_time) / period);
+
+    // Determine the two snapshots between which we interpolate
+    unsigned int lower_n = 0;
+    unsigned int upper_n = 0;
+    double       weight  = 0.0;
+    if (t >= last_time)
+      {
+        lower_n = n_snapshots - 1;
+        upper_n = period > 0.0 ? 0 : lower_n;
+        if (period > 0.0)
+          weight = (t - last_time) / (first_time + period - last_time);
+      }
+    else if (t < first_time)
+      {
+        // only possible without a period
+        lower_n = 0;
+        upper_n = 0;
+      }
+    else
+      {
+        lower_n = std::upper_bound(snapshot_times.begin(),
+                                   snapshot_times.end(),
+                                   t) -
+                  snapshot_times.begin() - 1;
+        upper_n = lower_n + 1;
+        weight  = (t - snapshot_times[lower_n]) /
+                 (snapshot_times[upper_n] - snapshot_times[lower_n]);
+      }
+    weight = std::min(std::max(weight, 0.0), 1.0);
+
+    const unsigned int lower_row = load_snapshot(lower_n, upper_n);
+    const unsigned int upper_row = load_snapshot(upper_n, lower_n);
+
+    // Start reading the next snapshot in the background
+    const unsigned int next_n = period > 0.0 ?
+                                  (upper_n + 1) % n_snapshots :
+                                  std::min(upper_n + 1, n_snapshots - 1);
+    if (prefetched_snapshot_n == numbers::invalid_unsigned_int &&
+        std::find(buffered_snapshot_ns.begin(),
+                  buffered_snapshot_ns.end(),
+                  next_n) == buffered_snapshot_ns.end())
+      {
+        reader.prefetch(int(next_n) + 1);
+        prefetched_snapshot_n = next_n;
+      }
+
+    if (activations.size() > 0)
+      {
+        if (single_precision)
+          interpolate_snapshots(weight,
+                                &single_buffered_snapshots(lower_row, 0),
+                                &single_buffered_snapshots(upper_row, 0),
+                                make_array_view(activations));
+        else
+          interpolate_snapshots(weight,
+                                &buffered_snapshots(lower_row, 0),
+                                &buffered_snapshots(upper_row, 0),
+                                make_array_view(activations));
+      }
+  }
+
+  template class ElementalActivation<NDIM - 1, NDIM>;
+  template class ElementalActivation<NDIM, NDIM>;
+} // namespace fdl
@@ -12,9 +12,26 @@ namespace fdl
   template <int dim, int spacedim>
   FiberNetwork<dim, spacedim>::FiberNetwork(
     const Triangulation<dim, spacedim>                  &tria,
-    const std::vector<std::vector<Tensor<1, spacedim>>> &fibers)
+    const std::vector<std::vector<Tensor<1, spacedim>>> &fibers,
+    const bool                                           use_single_precision)
+    : FiberNetwork(tria, 1, fibers, use_single_precision)
+  {}
+
+
+
+  template <int dim, int spacedim>
+  FiberNetwork<dim, spacedim>::FiberNetwork(
+    const Triangulation<dim, spacedim>                  &tria,
+    const unsigned int                                   n_quadrature_points,
+    const std::vector<std::vector<Tensor<1, spacedim>>> &fibers,
+    const bool                                           use_single_precision)
     : tria(&tria)
+    , n_q_points(n_quadrature_points)
+    , n_fields(fibers.size())
+    , single_precision(use_single_precision)
   {
+    AssertThrow(n_q_points > 0,
+                ExcMessage("There must be at least one quadrature point."));
     local_processor_min_cell_index =
       std::numeric_limits<types::global_cell_index>::max();
     unsigned int n_locally_owned_cells = 0;
@@ -28,15 +45,75 @@ namespace fdl
           ++n_locally_owned_cells;
         }
 
+    const std::size_t n_rows = std::size_t(n_locally_owned_cells) * n_q_points;
     for (const auto &fiber_vec : fibers)
-      AssertThrow(n_locally_owned_cells == fiber_vec.size(),
+      AssertThrow(n_rows == fiber_vec.size(),
                   ExcMessage("Not enough tensors in this vector"));
 
-    const auto n_fiber_networks = fibers.size();
-    this->fibers.reinit(n_locally_owned_cells, n_fiber_networks);
-    for (unsigned int j = 0; j < n_fiber_networks; ++j)
-      for (unsigned int i = 0; i < n_locally_owned_cells; ++i)
-        this->fibers(i, j) = fibers[j][i];
+    if (single_precision)
+      {
+        single_fibers.reinit(n_rows, n_fields);
+        for (unsigned int j = 0; j < n_fields; ++j)
+          for (std::size_t i = 0; i < n_rows; ++i)
+            single_fibers(i, j) = Tensor<1, spacedim, float>(fibers[j][i]);
+      }
+    else
+      {
+        this->fibers.reinit(n_rows, n_fields);
+        for (unsigned int j = 0; j < n_fields; ++j)
+          for (std::size_t i = 0; i < n_rows; ++i)
+            this->fibers(i, j) = fibers[j][i];
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  FiberNetwork<dim, spacedim>::setup_structure_tensors()
+  {
+    const unsigned int n_pairs = n_fields * (n_fields + 1) / 2;
+    if (single_precision)
+      {
+        // compute the products in double precision and then round them
+        const std::size_t n_rows = single_fibers.size(0);
+        single_structure_tensors.reinit(n_rows, n_pairs);
+        for (std::size_t row = 0; row < n_rows; ++row)
+          {
+            unsigned int pair_n = 0;
+            for (unsigned int i = 0; i < n_fields; ++i)
+              for (unsigned int j = i; j < n_fields; ++j, ++pair_n)
+                single_structure_tensors(row, pair_n) =
+                  SymmetricTensor<2, spacedim, float>(symmetrize(
+                    outer_product(Tensor<1, spacedim>(single_fibers(row, i)),
+                                  Tensor<1, spacedim>(single_fibers(row, j)))));
+          }
+      }
+    else
+      {
+        const std::size_t n_rows = fibers.size(0);
+        structure_tensors.reinit(n_rows, n_pairs);
+        for (std::size_t row = 0; row < n_rows; ++row)
+          {
+            unsigned int pair_n = 0;
+            for (unsigned int i = 0; i < n_fields; ++i)
+              for (unsigned int j = i; j < n_fields; ++j, ++pair_n)
+                structure_tensors(row, pair_n) =
+                  symmetrize(outer_product(fibers(row, i), fibers(row, j)));
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  FiberNetwork<dim, spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) + fibers.memory_consumption() +
+           single_fibers.memory_consumption() +
+           structure_tensors.memory_consumption() +
+           single_structure_tensors.memory_consumption();
   }
 
   template class FiberNetwork<NDIM - 1, NDIM>;
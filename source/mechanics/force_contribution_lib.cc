@@ -54,6 +54,38 @@ namespace fdl
 
       return result;
     }
+
+    /**
+     * Return whether or not a force contribution with the given material ids
+     * should be applied to cells with material id @p id.
+     */
+    inline bool
+    has_material_id(const std::vector<types::material_id> &ids,
+                    const types::material_id               id)
+    {
+      return ids.size() == 0 || std::binary_search(ids.begin(), ids.end(), id);
+    }
+
+    /**
+     * Compute a mask which is one on each lane corresponding to a cell with
+     * one of the given material ids (or to any cell, if @p ids is empty) and
+     * zero otherwise.
+     */
+    template <int dim, int spacedim>
+    VectorizedArray<double>
+    material_id_mask(
+      const std::vector<types::material_id> &ids,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+        &cells)
+    {
+      VectorizedArray<double> mask = 0.0;
+      for (unsigned int v = 0; v < cells.size(); ++v)
+        if (ids.size() == 0 ||
+            std::binary_search(ids.begin(), ids.end(), cells[v]->material_id()))
+          mask[v] = 1.0;
+      return mask;
+    }
   } // namespace
 
   //
@@ -67,6 +99,8 @@ namespace fdl
     const double             spring_constant)
     : ForceContribution<dim, spacedim, double>(quad)
     , spring_constant(spring_constant)
+    , single_precision_reference(false)
+    , has_active_boundary_faces(false)
   {}
 
   template <int dim, int spacedim, typename Number>
@@ -80,6 +114,8 @@ namespace fdl
     , spring_constant(spring_constant)
     , dof_handler(&dof_handler)
     , reference_position(reference_position)
+    , single_precision_reference(false)
+    , has_active_boundary_faces(false)
   {
     this->reference_position.update_ghost_values();
   }
@@ -92,8 +128,39 @@ namespace fdl
     Assert(dof_handler != nullptr,
            ExcMessage("This function is meaningless when there is no "
                       "DoFHandler attached to the force object."));
-    this->reference_position = reference_position;
-    this->reference_position.update_ghost_values();
+    if (single_precision_reference)
+      {
+        single_reference_position = reference_position;
+        single_reference_position.update_ghost_values();
+      }
+    else
+      {
+        this->reference_position = reference_position;
+        this->reference_position.update_ghost_values();
+      }
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  SpringForceBase<dim, spacedim, Number>::
+    set_single_precision_reference_position(const bool use_single_precision)
+  {
+    if (use_single_precision == single_precision_reference)
+      return;
+
+    if (use_single_precision)
+      {
+        single_reference_position = reference_position;
+        single_reference_position.update_ghost_values();
+        reference_position.reinit(0);
+      }
+    else
+      {
+        reference_position = single_reference_position;
+        reference_position.update_ghost_values();
+        single_reference_position.reinit(0);
+      }
+    single_precision_reference = use_single_precision;
   }
 
   template <int dim, int spacedim, typename Number>
@@ -119,6 +186,94 @@ namespace fdl
       return UpdateFlags::update_values;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  SpringForceBase<dim, spacedim, Number>::is_thread_safe() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  const std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              unsigned int>> *
+  SpringForceBase<dim, spacedim, Number>::get_active_boundary_faces() const
+  {
+    return has_active_boundary_faces ? &active_boundary_faces : nullptr;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  SpringForceBase<dim, spacedim, Number>::setup_active_boundary_faces(
+    const std::vector<types::boundary_id> &boundary_ids)
+  {
+    Assert(dof_handler != nullptr,
+           ExcMessage("This function requires a DoFHandler."));
+    has_active_boundary_faces = true;
+    active_boundary_faces.clear();
+    active_boundary_face_indices.clear();
+    active_boundary_face_dofs.clear();
+
+    std::vector<types::global_dof_index> cell_dofs(
+      dof_handler->get_fe().dofs_per_cell);
+    for (const auto &cell : dof_handler->active_cell_iterators())
+      if (cell->is_locally_owned() && cell->at_boundary())
+        for (const auto &face_n : cell->face_indices())
+          if (!cell->has_periodic_neighbor(face_n) &&
+              cell->face(face_n)->at_boundary() &&
+              (boundary_ids.size() == 0 ||
+               std::binary_search(boundary_ids.begin(),
+                                  boundary_ids.end(),
+                                  cell->face(face_n)->boundary_id())))
+            {
+              active_boundary_face_indices.emplace_back(
+                cell->face(face_n)->index(), active_boundary_faces.size());
+              active_boundary_faces.emplace_back(cell, face_n);
+              cell->get_dof_indices(cell_dofs);
+              active_boundary_face_dofs.insert(active_boundary_face_dofs.end(),
+                                               cell_dofs.begin(),
+                                               cell_dofs.end());
+            }
+    std::sort(active_boundary_face_indices.begin(),
+              active_boundary_face_indices.end());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  ArrayView<const types::global_dof_index>
+  SpringForceBase<dim, spacedim, Number>::get_boundary_face_dofs(
+    const FEValuesBase<dim, spacedim> &fe_values,
+    const typename Triangulation<dim, spacedim>::active_face_iterator &face,
+    Scratch &scratch) const
+  {
+    const unsigned int dofs_per_cell = fe_values.dofs_per_cell;
+    if (has_active_boundary_faces)
+      {
+        const auto it =
+          std::lower_bound(active_boundary_face_indices.begin(),
+                           active_boundary_face_indices.end(),
+                           std::make_pair(face->index(), 0u));
+        if (it != active_boundary_face_indices.end() &&
+            it->first == face->index())
+          {
+            const types::global_dof_index *dofs =
+              active_boundary_face_dofs.data() + it->second * dofs_per_cell;
+            return make_array_view(dofs, dofs + dofs_per_cell);
+          }
+      }
+
+    const auto cell = fe_values.get_cell();
+    const auto dof_cell =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator(
+        &dof_handler->get_triangulation(),
+        cell->level(),
+        cell->index(),
+        &*dof_handler);
+    scratch.cell_dofs.resize(dofs_per_cell);
+    dof_cell->get_dof_indices(scratch.cell_dofs);
+    return make_array_view(scratch.cell_dofs.data(),
+                           scratch.cell_dofs.data() + dofs_per_cell);
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   SpringForceBase<dim, spacedim, Number>::setup_force(
@@ -220,21 +375,22 @@ namespace fdl
                 cell->index(),
                 &*this->dof_handler);
 
-            this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-            dof_cell->get_dof_indices(this->scratch_cell_dofs);
-            this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-            this->scratch_qp_values.resize(fe_values.n_quadrature_points);
+            auto &scratch = this->scratch.get();
+            scratch.cell_dofs.resize(fe_values.dofs_per_cell);
+            dof_cell->get_dof_indices(scratch.cell_dofs);
+            scratch.dof_values.resize(fe_values.dofs_per_cell);
+            scratch.qp_values.resize(fe_values.n_quadrature_points);
 
             auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-            for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-              this->scratch_dof_values[i] =
+            for (unsigned int i = 0; i < scratch.cell_dofs.size(); ++i)
+              scratch.dof_values[i] =
                 this->spring_constant *
-                (this->reference_position[this->scratch_cell_dofs[i]] -
-                 (*this->current_position)[this->scratch_cell_dofs[i]]);
+                (this->get_reference_value(scratch.cell_dofs[i]) -
+                 (*this->current_position)[scratch.cell_dofs[i]]);
             extractor.get_function_values_from_local_dof_values(
-              this->scratch_dof_values, this->scratch_qp_values);
-            std::copy(this->scratch_qp_values.begin(),
-                      this->scratch_qp_values.end(),
+              scratch.dof_values, scratch.qp_values);
+            std::copy(scratch.qp_values.begin(),
+                      scratch.qp_values.end(),
                       forces.begin());
           }
       }
@@ -247,6 +403,15 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  SpringForce<dim, spacedim, Number>::is_active(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return has_material_id(material_ids, cell->material_id());
+  }
+
   //
   // BoundarySpringForce
   //
@@ -272,7 +437,9 @@ namespace fdl
                                              dof_handler,
                                              reference_position)
     , boundary_ids(setup_ids(boundary_ids))
-  {}
+  {
+    this->setup_active_boundary_faces(this->boundary_ids);
+  }
 
   template <int dim, int spacedim, typename Number>
   BoundarySpringForce<dim, spacedim, Number>::BoundarySpringForce(
@@ -288,7 +455,9 @@ namespace fdl
         dof_handler,
         do_interpolation(dof_handler, mapping, reference_position))
     , boundary_ids(setup_ids(boundary_ids))
-  {}
+  {
+    this->setup_active_boundary_faces(this->boundary_ids);
+  }
 
   template <int dim, int spacedim, typename Number>
   bool
@@ -297,6 +466,13 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  const std::vector<types::boundary_id> *
+  BoundarySpringForce<dim, spacedim, Number>::get_active_boundary_ids() const
+  {
+    return &boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   BoundarySpringForce<dim, spacedim, Number>::compute_boundary_force(
@@ -330,29 +506,23 @@ namespace fdl
           {
             const FEValuesBase<dim, spacedim> &fe_values =
               m_values.get_fe_values();
-            const auto cell = fe_values.get_cell();
-            const auto dof_cell =
-              typename DoFHandler<dim, spacedim>::active_cell_iterator(
-                &this->dof_handler->get_triangulation(),
-                cell->level(),
-                cell->index(),
-                &*this->dof_handler);
 
-            this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-            dof_cell->get_dof_indices(this->scratch_cell_dofs);
-            this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-            this->scratch_qp_values.resize(fe_values.n_quadrature_points);
+            auto      &scratch = this->scratch.get();
+            const auto cell_dofs =
+              this->get_boundary_face_dofs(fe_values, face, scratch);
+            scratch.dof_values.resize(fe_values.dofs_per_cell);
+            scratch.qp_values.resize(fe_values.n_quadrature_points);
 
             auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-            for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-              this->scratch_dof_values[i] =
+            for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+              scratch.dof_values[i] =
                 this->spring_constant *
-                (this->reference_position[this->scratch_cell_dofs[i]] -
-                 (*this->current_position)[this->scratch_cell_dofs[i]]);
+                (this->get_reference_value(cell_dofs[i]) -
+                 (*this->current_position)[cell_dofs[i]]);
             extractor.get_function_values_from_local_dof_values(
-              this->scratch_dof_values, this->scratch_qp_values);
-            std::copy(this->scratch_qp_values.begin(),
-                      this->scratch_qp_values.end(),
+              scratch.dof_values, scratch.qp_values);
+            std::copy(scratch.qp_values.begin(),
+                      scratch.qp_values.end(),
                       forces.begin());
           }
       }
@@ -369,7 +539,7 @@ namespace fdl
     const std::vector<types::material_id> &material_ids)
     : ForceContribution<dim, spacedim, double>(quad)
     , damping_constant(damping_constant)
-    , material_ids(material_ids)
+    , material_ids(setup_ids(material_ids))
   {}
 
   template <int dim, int spacedim, typename Number>
@@ -386,6 +556,22 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  DampingForce<dim, spacedim, Number>::is_active(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return has_material_id(material_ids, cell->material_id());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  DampingForce<dim, spacedim, Number>::is_thread_safe() const
+  {
+    return true;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   DampingForce<dim, spacedim, Number>::compute_volume_force(
@@ -447,6 +633,14 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  const std::vector<types::boundary_id> *
+  OrthogonalLinearLoadForce<dim, spacedim, Number>::get_active_boundary_ids()
+    const
+  {
+    return &boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   OrthogonalLinearLoadForce<dim, spacedim, Number>::compute_boundary_force(
@@ -519,7 +713,9 @@ namespace fdl
                                              reference_position)
     , damping_constant(damping_constant)
     , boundary_ids(setup_ids(boundary_ids))
-  {}
+  {
+    this->setup_active_boundary_faces(this->boundary_ids);
+  }
 
   template <int dim, int spacedim, typename Number>
   OrthogonalSpringDashpotForce<dim, spacedim, Number>::
@@ -538,7 +734,9 @@ namespace fdl
         do_interpolation(dof_handler, mapping, reference_position))
     , damping_constant(damping_constant)
     , boundary_ids(setup_ids(boundary_ids))
-  {}
+  {
+    this->setup_active_boundary_faces(this->boundary_ids);
+  }
 
   template <int dim, int spacedim, typename Number>
   MechanicsUpdateFlags
@@ -557,6 +755,14 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  const std::vector<types::boundary_id> *
+  OrthogonalSpringDashpotForce<dim, spacedim, Number>::get_active_boundary_ids()
+    const
+  {
+    return &boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   OrthogonalSpringDashpotForce<dim, spacedim, Number>::compute_boundary_force(
@@ -594,39 +800,33 @@ namespace fdl
           {
             const FEValuesBase<dim, spacedim> &fe_values =
               m_values.get_fe_values();
-            const auto cell = fe_values.get_cell();
-            const auto dof_cell =
-              typename DoFHandler<dim, spacedim>::active_cell_iterator(
-                &this->dof_handler->get_triangulation(),
-                cell->level(),
-                cell->index(),
-                &*this->dof_handler);
 
-            this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-            dof_cell->get_dof_indices(this->scratch_cell_dofs);
-            this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-            this->scratch_qp_values.resize(fe_values.n_quadrature_points);
+            auto      &scratch = this->scratch.get();
+            const auto cell_dofs =
+              this->get_boundary_face_dofs(fe_values, face, scratch);
+            scratch.dof_values.resize(fe_values.dofs_per_cell);
+            scratch.qp_values.resize(fe_values.n_quadrature_points);
 
             auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
 
-            for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-              this->scratch_dof_values[i] =
+            for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+              scratch.dof_values[i] =
                 this->spring_constant *
-                (this->reference_position[this->scratch_cell_dofs[i]] -
-                 (*this->current_position)[this->scratch_cell_dofs[i]]);
+                (this->get_reference_value(cell_dofs[i]) -
+                 (*this->current_position)[cell_dofs[i]]);
 
             extractor.get_function_values_from_local_dof_values(
-              this->scratch_dof_values, this->scratch_qp_values);
+              scratch.dof_values, scratch.qp_values);
 
-            for (unsigned int i = 0; i < this->scratch_qp_values.size(); ++i)
-              this->scratch_qp_values[i] =
+            for (unsigned int i = 0; i < scratch.qp_values.size(); ++i)
+              scratch.qp_values[i] =
                 m_values.get_deformed_normal_vectors()[i] *
-                (this->scratch_qp_values[i] -
+                (scratch.qp_values[i] -
                  this->damping_constant * m_values.get_velocity_values()[i]) *
                 m_values.get_deformed_normal_vectors()[i];
 
-            std::copy(this->scratch_qp_values.begin(),
-                      this->scratch_qp_values.end(),
+            std::copy(scratch.qp_values.begin(),
+                      scratch.qp_values.end(),
                       forces.begin());
           }
       }
@@ -664,33 +864,124 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::is_active(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return has_material_id(material_ids, cell->material_id());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::is_thread_safe() const
+  {
+    return true;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   ModifiedNeoHookeanStress<dim, spacedim, Number>::compute_stress(
+    const double                                                       time,
+    const MechanicsValues<dim, spacedim>                              &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    for (auto &stress : stresses)
+      stress = 0.0;
+    add_stress(time, m_values, cell, stresses, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::add_stress(
     const double /*time*/,
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> & /*scratch*/,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
   {
+    // the user specified a subset of material ids and we currently don't
+    // match - there is nothing to add
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
                             this->material_ids.end(),
                             cell->material_id()))
+      return;
+
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
       {
-        // the user specified a subset of material ids and we currently don't
-        // match - fill with zeros
-        for (auto &stress : stresses)
-          stress = 0.0;
+        stresses[qp_n] +=
+          shear_modulus * m_values.get_n23_det_FF()[qp_n] *
+          (m_values.get_FF()[qp_n] - m_values.get_first_invariant()[qp_n] /
+                                       3.0 * m_values.get_FF_inv_T()[qp_n]);
       }
-    else
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::has_vectorized_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim> &m_values,
+    const ArrayView<
+      const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                            &cells,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      stresses[qp_n] =
+        mask * shear_modulus * m_values.get_n23_det_FF()[qp_n] *
+        (m_values.get_FF()[qp_n] -
+         m_values.get_first_invariant()[qp_n] / 3.0 *
+           m_values.get_FF_inv_T()[qp_n]);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::has_stress_derivative() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::
+    compute_vectorized_stress_derivative(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                                    &cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &d_stresses)
+      const
+  {
+    AssertDimension(dFF.size(), d_stresses.size());
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    for (unsigned int qp_n = 0; qp_n < d_stresses.size(); ++qp_n)
       {
-        for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          {
-            stresses[qp_n] =
-              shear_modulus * m_values.get_n23_det_FF()[qp_n] *
-              (m_values.get_FF()[qp_n] - m_values.get_first_invariant()[qp_n] /
-                                           3.0 * m_values.get_FF_inv_T()[qp_n]);
-          }
+        const auto &FF       = m_values.get_FF()[qp_n];
+        const auto &FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        const auto &I1       = m_values.get_first_invariant()[qp_n];
+        // d(J^{-2/3}) = -2/3 J^{-2/3} FF^-T : dFF, dI1 = 2 FF : dFF, and
+        // d(FF^-T) = -FF^-T dFF^T FF^-T
+        const auto d_log_J = scalar_product(FF_inv_T, dFF[qp_n]);
+        const auto d_I1    = 2.0 * scalar_product(FF, dFF[qp_n]);
+        const Tensor<2, spacedim, VectorizedArray<double>> d_FF_inv_T =
+          -FF_inv_T * transpose(dFF[qp_n]) * FF_inv_T;
+        d_stresses[qp_n] =
+          mask * shear_modulus * m_values.get_n23_det_FF()[qp_n] *
+          (-2.0 / 3.0 * d_log_J * (FF - I1 / 3.0 * FF_inv_T) + dFF[qp_n] -
+           d_I1 / 3.0 * FF_inv_T - I1 / 3.0 * d_FF_inv_T);
       }
   }
 
@@ -730,40 +1021,101 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::is_active(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return has_material_id(material_ids, cell->material_id());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::is_thread_safe() const
+  {
+    return true;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   ModifiedMooneyRivlinStress<dim, spacedim, Number>::compute_stress(
+    const double                                                       time,
+    const MechanicsValues<dim, spacedim>                              &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    for (auto &stress : stresses)
+      stress = 0.0;
+    add_stress(time, m_values, cell, stresses, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::add_stress(
     const double /*time*/,
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> & /*scratch*/,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
   {
+    // the user specified a subset of material ids and we currently don't
+    // match - there is nothing to add
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
                             this->material_ids.end(),
                             cell->material_id()))
+      return;
+
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
       {
-        // the user specified a subset of material ids and we currently don't
-        // match - fill with zeros
-        for (auto &stress : stresses)
-          stress = 0.0;
+        const auto J_n23    = m_values.get_n23_det_FF()[qp_n];
+        const auto FF       = m_values.get_FF()[qp_n];
+        const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        const auto CC       = m_values.get_right_cauchy_green()[qp_n];
+        const auto I1       = m_values.get_first_invariant()[qp_n];
+        const auto I2       = m_values.get_second_invariant()[qp_n];
+
+        stresses[qp_n] +=
+          2.0 * material_constant_1 * J_n23 * (FF - I1 / 3.0 * FF_inv_T) +
+          2.0 * material_constant_2 * J_n23 * J_n23 *
+            (I1 * FF - FF * CC - 2.0 * I2 / 3.0 * FF_inv_T);
       }
-    else
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::has_vectorized_stress()
+    const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim> &m_values,
+    const ArrayView<
+      const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                            &cells,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
       {
-        for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          {
-            const auto J_n23    = m_values.get_n23_det_FF()[qp_n];
-            const auto FF       = m_values.get_FF()[qp_n];
-            const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
-            const auto CC       = m_values.get_right_cauchy_green()[qp_n];
-            const auto I1       = m_values.get_first_invariant()[qp_n];
-            const auto I2       = m_values.get_second_invariant()[qp_n];
-
-            stresses[qp_n] =
-              2.0 * material_constant_1 * J_n23 * (FF - I1 / 3.0 * FF_inv_T) +
-              2.0 * material_constant_2 * J_n23 * J_n23 *
-                (I1 * FF - FF * CC - 2.0 * I2 / 3.0 * FF_inv_T);
-          }
+        const auto J_n23    = m_values.get_n23_det_FF()[qp_n];
+        const auto FF       = m_values.get_FF()[qp_n];
+        const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        const auto CC       = m_values.get_right_cauchy_green()[qp_n];
+        const auto I1       = m_values.get_first_invariant()[qp_n];
+        const auto I2       = m_values.get_second_invariant()[qp_n];
+
+        stresses[qp_n] =
+          2.0 * material_constant_1 * J_n23 * (FF - I1 / 3.0 * FF_inv_T) +
+          2.0 * material_constant_2 * J_n23 * J_n23 *
+            (I1 * FF - FF * CC - 2.0 * I2 / 3.0 * FF_inv_T);
+        stresses[qp_n] *= mask;
       }
   }
 
@@ -799,34 +1151,122 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::is_active(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return has_material_id(material_ids, cell->material_id());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::is_thread_safe() const
+  {
+    return true;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   JLogJVolumetricEnergyStress<dim, spacedim, Number>::compute_stress(
+    const double                                                       time,
+    const MechanicsValues<dim, spacedim>                              &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    for (auto &stress : stresses)
+      stress = 0.0;
+    add_stress(time, m_values, cell, stresses, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::add_stress(
     const double /*time*/,
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> & /*scratch*/,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
   {
+    // the user specified a subset of material ids and we currently don't
+    // match - there is nothing to add
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
                             this->material_ids.end(),
                             cell->material_id()))
+      return;
+
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      stresses[qp_n] += bulk_modulus * m_values.get_det_FF()[qp_n] *
+                       m_values.get_log_det_FF()[qp_n] *
+                       m_values.get_FF_inv_T()[qp_n];
+  }
+
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::has_vectorized_stress()
+    const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim> &m_values,
+    const ArrayView<
+      const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                            &cells,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      stresses[qp_n] = mask * bulk_modulus * m_values.get_det_FF()[qp_n] *
+                       m_values.get_log_det_FF()[qp_n] *
+                       m_values.get_FF_inv_T()[qp_n];
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::has_stress_derivative()
+    const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::
+    compute_vectorized_stress_derivative(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                                    &cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &d_stresses)
+      const
+  {
+    AssertDimension(dFF.size(), d_stresses.size());
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    for (unsigned int qp_n = 0; qp_n < d_stresses.size(); ++qp_n)
       {
-        // the user specified a subset of material ids and we currently don't
-        // match - fill with zeros
-        for (auto &stress : stresses)
-          stress = 0.0;
-      }
-    else
-      {
-        for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          stresses[qp_n] = bulk_modulus * m_values.get_det_FF()[qp_n] *
-                           m_values.get_log_det_FF()[qp_n] *
-                           m_values.get_FF_inv_T()[qp_n];
+        const auto &FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        const auto &J        = m_values.get_det_FF()[qp_n];
+        const auto &log_J    = m_values.get_log_det_FF()[qp_n];
+        // dJ = J FF^-T : dFF and d(FF^-T) = -FF^-T dFF^T FF^-T
+        const auto d_log_J = scalar_product(FF_inv_T, dFF[qp_n]);
+        const Tensor<2, spacedim, VectorizedArray<double>> d_FF_inv_T =
+          -FF_inv_T * transpose(dFF[qp_n]) * FF_inv_T;
+        d_stresses[qp_n] =
+          mask * bulk_modulus * J *
+          ((log_J + 1.0) * d_log_J * FF_inv_T + log_J * d_FF_inv_T);
       }
   }
 
-
   //
   // LogarithmicVolumetricEnergyStress
   //
@@ -858,29 +1298,116 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::is_active(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return has_material_id(material_ids, cell->material_id());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::is_thread_safe()
+    const
+  {
+    return true;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::compute_stress(
+    const double                                                       time,
+    const MechanicsValues<dim, spacedim>                              &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    for (auto &stress : stresses)
+      stress = 0.0;
+    add_stress(time, m_values, cell, stresses, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::add_stress(
     const double /*time*/,
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> & /*scratch*/,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
   {
+    // the user specified a subset of material ids and we currently don't
+    // match - there is nothing to add
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
                             this->material_ids.end(),
                             cell->material_id()))
+      return;
+
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      stresses[qp_n] += bulk_modulus * m_values.get_log_det_FF()[qp_n] *
+                       m_values.get_FF_inv_T()[qp_n];
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    has_vectorized_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    compute_vectorized_stress(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                              &cells,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      stresses[qp_n] = mask * bulk_modulus * m_values.get_log_det_FF()[qp_n] *
+                       m_values.get_FF_inv_T()[qp_n];
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    has_stress_derivative() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    compute_vectorized_stress_derivative(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const ArrayView<
+        const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                                    &cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &d_stresses)
+      const
+  {
+    AssertDimension(dFF.size(), d_stresses.size());
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    for (unsigned int qp_n = 0; qp_n < d_stresses.size(); ++qp_n)
       {
-        // the user specified a subset of material ids and we currently don't
-        // match - fill with zeros
-        for (auto &stress : stresses)
-          stress = 0.0;
-      }
-    else
-      {
-        for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          stresses[qp_n] = bulk_modulus * m_values.get_log_det_FF()[qp_n] *
-                           m_values.get_FF_inv_T()[qp_n];
+        const auto &FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        // d(log J) = FF^-T : dFF and d(FF^-T) = -FF^-T dFF^T FF^-T
+        const auto d_log_J = scalar_product(FF_inv_T, dFF[qp_n]);
+        const Tensor<2, spacedim, VectorizedArray<double>> d_FF_inv_T =
+          -FF_inv_T * transpose(dFF[qp_n]) * FF_inv_T;
+        d_stresses[qp_n] =
+          mask * bulk_modulus *
+          (d_log_J * FF_inv_T + m_values.get_log_det_FF()[qp_n] * d_FF_inv_T);
       }
   }
 
@@ -940,74 +1467,194 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  HolzapfelOgdenStress<dim, spacedim, Number>::is_active(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return has_material_id(material_ids, cell->material_id());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  HolzapfelOgdenStress<dim, spacedim, Number>::is_thread_safe() const
+  {
+    return true;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   HolzapfelOgdenStress<dim, spacedim, Number>::compute_stress(
+    const double                                                       time,
+    const MechanicsValues<dim, spacedim>                              &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    for (auto &stress : stresses)
+      stress = 0.0;
+    add_stress(time, m_values, cell, stresses, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  HolzapfelOgdenStress<dim, spacedim, Number>::add_stress(
     const double /*time*/,
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, Number>> & /*scratch*/,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
   {
+    // the user specified a subset of material ids and we currently don't
+    // match - there is nothing to add
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
                             this->material_ids.end(),
                             cell->material_id()))
+      return;
+
+    const bool vary_fibers = fiber_network->n_quadrature_points() > 1;
+    Assert(!vary_fibers ||
+             fiber_network->n_quadrature_points() == stresses.size(),
+           ExcMessage("The fiber network should be defined at the same "
+                      "quadrature points as this force contribution."));
+    // cell specific fiber fields
+    Tensor<1, spacedim> fiber_f = fiber_network->get_fiber(cell, 0, index_f);
+    Tensor<1, spacedim> fiber_s = fiber_network->get_fiber(cell, 0, index_s);
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
       {
-        // the user specified a subset of material ids and we currently don't
-        // match - fill with zeros
-        for (auto &stress : stresses)
-          stress = 0.0;
-      }
-    else
-      {
-        const ArrayView<const Tensor<1, spacedim>> cell_fibers =
-          fiber_network->get_fibers(cell); // cell specific fiber fields
-        const auto fiber_f = cell_fibers[index_f];
-        const auto fiber_s = cell_fibers[index_s];
-        for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+        if (vary_fibers && qp_n > 0)
+          {
+            fiber_f = fiber_network->get_fiber(cell, qp_n, index_f);
+            fiber_s = fiber_network->get_fiber(cell, qp_n, index_s);
+          }
+        // convenience definitions
+        const auto &I1_bar = m_values.get_modified_first_invariant()[qp_n];
+        const auto &FF     = m_values.get_FF()[qp_n];
+        const auto &CC     = m_values.get_right_cauchy_green()[qp_n];
+        const auto &I1_bar_dFF =
+          m_values.get_modified_first_invariant_dFF()[qp_n];
+        // FF * fiber appears in every fiber term, so only compute it once
+        const auto FF_f = FF * fiber_f;
+        const auto FF_s = FF * fiber_s;
+
+        // stress contribution, isotropic term
+        stresses[qp_n] += 0.5 * a * std::exp(b * (I1_bar - 3.0)) * I1_bar_dFF;
+        // stress contribution, transversly isotropic term, fiber f
+        const double I4_f = I4_i(CC, fiber_f);
+        if (kappa_f != 0.0 || I4_f > 1.0)
+          {
+            const double E_f =
+              kappa_f * I1_bar + (1.0 - 3.0 * kappa_f) * I4_f - 1.0;
+            stresses[qp_n] +=
+              a_f * std::exp(b_f * E_f * E_f) * E_f *
+              (kappa_f * I1_bar_dFF +
+               (1.0 - 3.0 * kappa_f) * 2.0 * outer_product(FF_f, fiber_f));
+          }
+        // stress contribution, transversly isotropic term, fiber s
+        const double I4_s = I4_i(CC, fiber_s);
+        if (kappa_s != 0.0 || I4_s > 1.0)
           {
-            // convenience definitions
-            const auto I1_bar = m_values.get_modified_first_invariant()[qp_n];
-            const auto FF     = m_values.get_FF()[qp_n];
-            const auto CC     = m_values.get_right_cauchy_green()[qp_n];
-            const auto I1_bar_dFF =
-              m_values.get_modified_first_invariant_dFF()[qp_n];
-
-            // stress contribution, isotropic term
-            stresses[qp_n] =
-              0.5 * a * std::exp(b * (I1_bar - 3.0)) * I1_bar_dFF;
-            // stress contribution, transversly isotropic term, fiber f
-            const double I4_f = I4_i(CC, fiber_f);
-            if (kappa_f != 0.0 || I4_f > 1.0)
-              {
-                stresses[qp_n] +=
-                  a_f *
-                  std::exp(b_f * std::pow(kappa_f * I1_bar +
-                                            (1.0 - 3.0 * kappa_f) * I4_f - 1.0,
-                                          2)) *
-                  (kappa_f * I1_bar + (1.0 - 3.0 * kappa_f) * I4_f - 1.0) *
-                  (kappa_f * I1_bar_dFF +
-                   (1.0 - 3.0 * kappa_f) * dI4_i_dFF(FF, fiber_f));
-              }
-            // stress contribution, transversly isotropic term, fiber s
-            const double I4_s = I4_i(CC, fiber_s);
-            if (kappa_s != 0.0 || I4_s > 1.0)
-              {
-                stresses[qp_n] +=
-                  a_s *
-                  std::exp(b_s * std::pow(kappa_s * I1_bar +
-                                            (1.0 - 3.0 * kappa_s) * I4_s - 1.0,
-                                          2)) *
-                  (kappa_s * I1_bar + (1.0 - 3.0 * kappa_s) * I4_s - 1.0) *
-                  (kappa_s * I1_bar_dFF +
-                   (1.0 - 3.0 * kappa_s) * dI4_i_dFF(FF, fiber_s));
-              }
-            // stress contribution, orthotropic term, fibers f and s
-            stresses[qp_n] += a_fs * I8_ij(CC, fiber_f, fiber_s) *
-                              std::exp(b_fs * I8_ij(CC, fiber_f, fiber_s) *
-                                       I8_ij(CC, fiber_f, fiber_s)) *
-                              dI8_ij_dFF(FF, fiber_f, fiber_s);
+            const double E_s =
+              kappa_s * I1_bar + (1.0 - 3.0 * kappa_s) * I4_s - 1.0;
+            stresses[qp_n] +=
+              a_s * std::exp(b_s * E_s * E_s) * E_s *
+              (kappa_s * I1_bar_dFF +
+               (1.0 - 3.0 * kappa_s) * 2.0 * outer_product(FF_s, fiber_s));
           }
+        // stress contribution, orthotropic term, fibers f and s
+        const double I8_fs = FF_f * FF_s;
+        stresses[qp_n] += a_fs * I8_fs * std::exp(b_fs * I8_fs * I8_fs) *
+                          (outer_product(FF_s, fiber_f) +
+                           outer_product(FF_f, fiber_s));
+      }
+  }
+
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  HolzapfelOgdenStress<dim, spacedim, Number>::has_vectorized_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  HolzapfelOgdenStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim> &m_values,
+    const ArrayView<
+      const typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                                            &cells,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    const auto mask = material_id_mask<dim, spacedim>(material_ids, cells);
+    const bool vary_fibers = fiber_network->n_quadrature_points() > 1;
+    Assert(!vary_fibers ||
+             fiber_network->n_quadrature_points() == stresses.size(),
+           ExcMessage("The fiber network should be defined at the same "
+                      "quadrature points as this force contribution."));
+    // cell specific fiber fields. Lanes without cells have zero fibers.
+    Tensor<1, spacedim, VectorizedArray<double>> fiber_f;
+    Tensor<1, spacedim, VectorizedArray<double>> fiber_s;
+    auto gather_fibers = [&](const unsigned int qp_n)
+    {
+      for (unsigned int v = 0; v < cells.size(); ++v)
+        {
+          const Tensor<1, spacedim> cell_fiber_f =
+            fiber_network->get_fiber(cells[v], qp_n, index_f);
+          const Tensor<1, spacedim> cell_fiber_s =
+            fiber_network->get_fiber(cells[v], qp_n, index_s);
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              fiber_f[d][v] = cell_fiber_f[d];
+              fiber_s[d][v] = cell_fiber_s[d];
+            }
+        }
+    };
+    gather_fibers(0);
+
+    // The scalar version skips the fiber terms when a fiber is in compression
+    // (i.e., I4_i < 1) without dispersion. We cannot branch per lane so
+    // instead set I4_i = 1 in those lanes, which makes the fiber terms zero.
+    const VectorizedArray<double> one = 1.0;
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      {
+        if (vary_fibers && qp_n > 0)
+          gather_fibers(qp_n);
+        // convenience definitions
+        const auto &I1_bar = m_values.get_modified_first_invariant()[qp_n];
+        const auto &FF     = m_values.get_FF()[qp_n];
+        const auto &CC     = m_values.get_right_cauchy_green()[qp_n];
+        const auto &I1_bar_dFF =
+          m_values.get_modified_first_invariant_dFF()[qp_n];
+        const auto FF_f = FF * fiber_f;
+        const auto FF_s = FF * fiber_s;
+
+        // stress contribution, isotropic term
+        stresses[qp_n] = 0.5 * a * std::exp(b * (I1_bar - 3.0)) * I1_bar_dFF;
+        // stress contribution, transversly isotropic term, fiber f
+        const auto I4_f = kappa_f != 0.0 ? I4_i(CC, fiber_f) :
+                                           std::max(I4_i(CC, fiber_f), one);
+        const auto E_f = kappa_f * I1_bar + (1.0 - 3.0 * kappa_f) * I4_f - 1.0;
+        stresses[qp_n] +=
+          a_f * std::exp(b_f * E_f * E_f) * E_f *
+          (kappa_f * I1_bar_dFF +
+           (1.0 - 3.0 * kappa_f) * 2.0 * outer_product(FF_f, fiber_f));
+        // stress contribution, transversly isotropic term, fiber s
+        const auto I4_s = kappa_s != 0.0 ? I4_i(CC, fiber_s) :
+                                           std::max(I4_i(CC, fiber_s), one);
+        const auto E_s = kappa_s * I1_bar + (1.0 - 3.0 * kappa_s) * I4_s - 1.0;
+        stresses[qp_n] +=
+          a_s * std::exp(b_s * E_s * E_s) * E_s *
+          (kappa_s * I1_bar_dFF +
+           (1.0 - 3.0 * kappa_s) * 2.0 * outer_product(FF_s, fiber_s));
+        // stress contribution, orthotropic term, fibers f and s
+        const auto I8_fs = FF_f * FF_s;
+        stresses[qp_n] += a_fs * I8_fs * std::exp(b_fs * I8_fs * I8_fs) *
+                          (outer_product(FF_s, fiber_f) +
+                           outer_product(FF_f, fiber_s));
+        stresses[qp_n] *= mask;
       }
   }
 
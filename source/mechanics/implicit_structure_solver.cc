@@ -0,0 +1,225 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/implicit_structure_solver.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  namespace
+  {
+    /**
+     * Jacobian of the backward Euler step, i.e., mass_scale M + K.
+     */
+    template <int dim>
+    struct JacobianOperator
+    {
+      using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+      const MatrixFreeOperators::Base<dim> &mass_operator;
+
+      const double mass_scale;
+
+      const std::vector<std::unique_ptr<TangentStiffnessOperator<dim>>>
+        &tangent_operators;
+
+      void
+      vmult(VectorType &dst, const VectorType &src) const
+      {
+        if (mass_scale != 0.0)
+          {
+            mass_operator.vmult(dst, src);
+            dst *= mass_scale;
+          }
+        else
+          dst = 0.0;
+        for (const auto &tangent_operator : tangent_operators)
+          tangent_operator->vmult_add(dst, src);
+      }
+    };
+  } // namespace
+
+  template <int dim>
+  ImplicitStructureSolver<dim>::ImplicitStructureSolver(
+    const Part<dim>      &part,
+    const double          density,
+    const AdditionalData &additional_data)
+    : part(&part)
+    , density(density)
+    , additional_data(additional_data)
+    , n_krylov_iterations(0)
+  {
+    AssertThrow(density >= 0.0,
+                ExcMessage("The density must not be negative."));
+
+    const std::vector<ForceContribution<dim, dim> *> forces =
+      part.get_force_contributions();
+    for (unsigned int i = 0; i < forces.size(); ++i)
+      {
+        if (!forces[i]->is_stress())
+          continue;
+        const unsigned int index = part.get_matrix_free_quadrature_index(i);
+        AssertThrow(index != numbers::invalid_unsigned_int &&
+                      forces[i]->has_stress_derivative(),
+                    ExcMessage("Every stress must be computable with the "
+                               "MatrixFree object of the Part and implement "
+                               "compute_vectorized_stress_derivative()."));
+        const auto it = std::find(quadrature_indices.begin(),
+                                  quadrature_indices.end(),
+                                  index);
+        if (it == quadrature_indices.end())
+          {
+            quadrature_indices.push_back(index);
+            stresses.emplace_back();
+            stresses.back().push_back(forces[i]);
+          }
+        else
+          stresses[it - quadrature_indices.begin()].push_back(forces[i]);
+      }
+
+    for (unsigned int group_n = 0; group_n < quadrature_indices.size();
+         ++group_n)
+      tangent_operators.emplace_back(
+        std::make_unique<TangentStiffnessOperator<dim>>(
+          part.get_matrix_free(),
+          quadrature_indices[group_n],
+          stresses[group_n]));
+  }
+
+
+
+  template <int dim>
+  void
+  ImplicitStructureSolver<dim>::compute_residual(
+    const double      time,
+    const double      mass_scale,
+    const VectorType &position,
+    const VectorType &predicted_position,
+    const VectorType &load_vector,
+    VectorType       &residual) const
+  {
+    const MatrixFree<dim, double> &matrix_free = *part->get_matrix_free();
+    // mass_scale M (X - X_pred) - F(X) - G
+    if (mass_scale != 0.0)
+      {
+        VectorType difference;
+        matrix_free.initialize_dof_vector(difference);
+        difference.copy_locally_owned_data_from(position);
+        difference -= predicted_position;
+        part->get_mass_operator().vmult(residual, difference);
+        residual *= mass_scale;
+      }
+    else
+      residual = 0.0;
+
+    VectorType force;
+    matrix_free.initialize_dof_vector(force);
+    for (unsigned int group_n = 0; group_n < quadrature_indices.size();
+         ++group_n)
+      compute_volumetric_pk1_load_vector(matrix_free,
+                                         quadrature_indices[group_n],
+                                         stresses[group_n],
+                                         time,
+                                         position,
+                                         force);
+    residual -= force;
+    residual -= load_vector;
+  }
+
+
+
+  template <int dim>
+  unsigned int
+  ImplicitStructureSolver<dim>::step(const double      new_time,
+                                     const double      dt,
+                                     const VectorType &old_position,
+                                     const VectorType &old_velocity,
+                                     const VectorType &load_vector,
+                                     VectorType       &new_position)
+  {
+    AssertThrow(dt > 0.0, ExcMessage("The time step size must be positive."));
+    const MatrixFree<dim, double> &matrix_free = *part->get_matrix_free();
+    const double                   mass_scale  = density / (dt * dt);
+    n_krylov_iterations                        = 0;
+
+    // Start from the explicit prediction X^n + dt V^n
+    VectorType predicted_position;
+    matrix_free.initialize_dof_vector(predicted_position);
+    predicted_position.copy_locally_owned_data_from(old_position);
+    predicted_position.add(dt, old_velocity);
+    matrix_free.initialize_dof_vector(new_position);
+    new_position.copy_locally_owned_data_from(predicted_position);
+
+    VectorType residual;
+    VectorType update;
+    matrix_free.initialize_dof_vector(residual);
+    matrix_free.initialize_dof_vector(update);
+    compute_residual(new_time,
+                     mass_scale,
+                     new_position,
+                     predicted_position,
+                     load_vector,
+                     residual);
+    double       residual_norm = residual.l2_norm();
+    const double tolerance =
+      std::max(additional_data.absolute_tolerance,
+               additional_data.relative_tolerance * residual_norm);
+
+    const JacobianOperator<dim> jacobian{part->get_mass_operator(),
+                                         mass_scale,
+                                         tangent_operators};
+    unsigned int n_newton_iterations = 0;
+    while (residual_norm > tolerance)
+      {
+        AssertThrow(n_newton_iterations < additional_data.max_newton_iterations,
+                    ExcMessage("The Newton iterations of the implicit "
+                               "structure step did not converge."));
+        for (auto &tangent_operator : tangent_operators)
+          tangent_operator->reinit(new_time, new_position);
+
+        SolverControl control(additional_data.max_krylov_iterations,
+                              additional_data.krylov_relative_tolerance *
+                                residual_norm);
+        SolverGMRES<VectorType> gmres(control);
+        update = 0.0;
+        try
+          {
+            // The mass matrix dominates the Jacobian for small time steps
+            if (mass_scale != 0.0)
+              gmres.solve(jacobian,
+                          update,
+                          residual,
+                          part->get_mass_preconditioner());
+            else
+              gmres.solve(jacobian, update, residual, PreconditionIdentity());
+          }
+        catch (const SolverControl::NoConvergence &)
+          {
+            // an inexact correction is still useful: the Newton iteration
+            // checks the residual itself
+          }
+        n_krylov_iterations += control.last_step();
+
+        new_position -= update;
+        compute_residual(new_time,
+                         mass_scale,
+                         new_position,
+                         predicted_position,
+                         load_vector,
+                         residual);
+        residual_norm = residual.l2_norm();
+        ++n_newton_iterations;
+      }
+
+    return n_newton_iterations;
+  }
+
+  template class ImplicitStructureSolver<NDIM>;
+} // namespace fdl
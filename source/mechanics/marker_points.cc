@@ -0,0 +1,171 @@
+#include <fiddle/mechanics/marker_points.h>
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int spacedim>
+  MarkerPoints<spacedim>::MarkerPoints(
+    const std::vector<Point<spacedim>>             &points,
+    const std::vector<std::array<unsigned int, 2>> &edges,
+    const std::vector<double>                      &stiffnesses,
+    const std::vector<double>                      &rest_lengths)
+    : edges(edges)
+    , initial_position(points.size() * spacedim)
+    , position(points.size() * spacedim)
+    , velocity(points.size() * spacedim)
+  {
+    for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        initial_position[point_n * spacedim + d] = points[point_n][d];
+    position = initial_position;
+
+    for (const auto &edge : edges)
+      for (const unsigned int point_n : edge)
+        AssertThrow(point_n < points.size(),
+                    ExcMessage("Each edge should connect two existing "
+                               "points."));
+
+    AssertThrow(stiffnesses.size() == 1 || stiffnesses.size() == edges.size(),
+                ExcMessage("The number of stiffnesses should either be 1 or "
+                           "equal the number of edges."));
+    this->stiffnesses =
+      stiffnesses.size() == 1 ?
+        std::vector<double>(edges.size(), stiffnesses.front()) :
+        stiffnesses;
+
+    if (rest_lengths.empty())
+      for (const auto &edge : edges)
+        this->rest_lengths.push_back(
+          points[edge[0]].distance(points[edge[1]]));
+    else
+      {
+        AssertThrow(rest_lengths.size() == edges.size(),
+                    ExcMessage("The number of rest lengths should equal the "
+                               "number of edges."));
+        this->rest_lengths = rest_lengths;
+      }
+  }
+
+
+
+  template <int spacedim>
+  void
+  MarkerPoints<spacedim>::set_tethers(const std::vector<unsigned int> &point_ns,
+                                      const std::vector<double> &stiffnesses)
+  {
+    for (const unsigned int point_n : point_ns)
+      AssertThrow(point_n < n_points(),
+                  ExcMessage("Each tethered point should exist."));
+    AssertThrow(stiffnesses.size() == 1 ||
+                  stiffnesses.size() == point_ns.size(),
+                ExcMessage("The number of stiffnesses should either be 1 or "
+                           "equal the number of tethered points."));
+    tether_point_ns    = point_ns;
+    tether_stiffnesses = stiffnesses.size() == 1 ?
+                           std::vector<double>(point_ns.size(),
+                                               stiffnesses.front()) :
+                           stiffnesses;
+  }
+
+
+
+  template <int spacedim>
+  void
+  MarkerPoints<spacedim>::compute_force(const Vector<double> &position,
+                                        Vector<double>       &force) const
+  {
+    AssertDimension(position.size(), this->position.size());
+    force.reinit(position.size());
+    for (std::size_t edge_n = 0; edge_n < edges.size(); ++edge_n)
+      {
+        const unsigned int a = edges[edge_n][0] * spacedim;
+        const unsigned int b = edges[edge_n][1] * spacedim;
+        double             displacement[spacedim];
+        double             length = 0.0;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            displacement[d] = position[b + d] - position[a + d];
+            length += displacement[d] * displacement[d];
+          }
+        length = std::sqrt(length);
+        // Coincident points exert no force on each other
+        if (length == 0.0)
+          continue;
+        const double scale =
+          stiffnesses[edge_n] * (length - rest_lengths[edge_n]) / length;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            force[a + d] += scale * displacement[d];
+            force[b + d] -= scale * displacement[d];
+          }
+      }
+
+    for (std::size_t i = 0; i < tether_point_ns.size(); ++i)
+      {
+        const unsigned int a = tether_point_ns[i] * spacedim;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          force[a + d] += tether_stiffnesses[i] *
+                          (initial_position[a + d] - position[a + d]);
+      }
+  }
+
+
+
+  template <int spacedim>
+  void
+  MarkerPoints<spacedim>::write_state(std::ostream &out) const
+  {
+    const std::uint64_t n_values = position.size();
+    out.write(reinterpret_cast<const char *>(&n_values), sizeof(n_values));
+    for (const auto *vector : {&position, &velocity})
+      out.write(reinterpret_cast<const char *>(vector->begin()),
+                n_values * sizeof(double));
+    AssertThrow(out,
+                ExcMessage("Unable to write the state of the marker points."));
+  }
+
+
+
+  template <int spacedim>
+  void
+  MarkerPoints<spacedim>::read_state(std::istream &in)
+  {
+    std::uint64_t n_values = 0;
+    in.read(reinterpret_cast<char *>(&n_values), sizeof(n_values));
+    AssertThrow(in && n_values == position.size(),
+                ExcMessage("The stored state of the marker points does not "
+                           "match the current number of points."));
+    for (auto *vector : {&position, &velocity})
+      in.read(reinterpret_cast<char *>(vector->begin()),
+              n_values * sizeof(double));
+    AssertThrow(in,
+                ExcMessage("Unable to read the state of the marker points."));
+  }
+
+
+
+  template <int spacedim>
+  std::size_t
+  MarkerPoints<spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) + MemoryConsumption::memory_consumption(edges) +
+           MemoryConsumption::memory_consumption(stiffnesses) +
+           MemoryConsumption::memory_consumption(rest_lengths) +
+           MemoryConsumption::memory_consumption(tether_point_ns) +
+           MemoryConsumption::memory_consumption(tether_stiffnesses) +
+           initial_position.memory_consumption() +
+           position.memory_consumption() + velocity.memory_consumption();
+  }
+
+
+
+  template class MarkerPoints<NDIM>;
+} // namespace fdl
@@ -1,3 +1,5 @@
+#include <fiddle/base/hardware_counters.h>
+
 #include <fiddle/mechanics/mechanics_utilities.h>
 #include <fiddle/mechanics/mechanics_values.h>
 
@@ -10,13 +12,200 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/fe_evaluation.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace fdl
 {
   using namespace dealii;
 
+  namespace
+  {
+    /**
+     * Per-thread scratch data used by compute_load_vector(). If
+     * @p copy_fe_values is false then the scratch data uses @p group_fe_values
+     * directly and otherwise it uses its own copy of it.
+     */
+    template <int dim, int spacedim>
+    struct LoadVectorScratch
+    {
+      LoadVectorScratch(
+        FEValues<dim, spacedim>                          &group_fe_values,
+        const bool                                        copy_fe_values,
+        const LinearAlgebra::distributed::Vector<double> &current_position,
+        const LinearAlgebra::distributed::Vector<double> &current_velocity,
+        const MechanicsUpdateFlags                        me_flags)
+        : own_fe_values(copy_fe_values ?
+                          std::make_unique<FEValues<dim, spacedim>>(
+                            group_fe_values.get_mapping(),
+                            group_fe_values.get_fe(),
+                            group_fe_values.get_quadrature(),
+                            group_fe_values.get_update_flags()) :
+                          nullptr)
+        , fe_values(copy_fe_values ? *own_fe_values : group_fe_values)
+        , me_values(fe_values, current_position, current_velocity, me_flags)
+        , cell_dofs(fe_values.get_fe().dofs_per_cell)
+        , one_stress(fe_values.n_quadrature_points)
+        , accumulated_stresses(fe_values.n_quadrature_points)
+        , pull_accumulated_stresses_back(fe_values.n_quadrature_points)
+        , one_force(fe_values.n_quadrature_points)
+        , accumulated_forces(fe_values.n_quadrature_points)
+        , current_id(numbers::invalid_material_id)
+        , current_as(nullptr)
+      {}
+
+      std::unique_ptr<FEValues<dim, spacedim>> own_fe_values;
+
+      FEValues<dim, spacedim> &fe_values;
+
+      MechanicsValues<dim,
+                      spacedim,
+                      LinearAlgebra::distributed::Vector<double>>
+        me_values;
+
+      std::vector<types::global_dof_index> cell_dofs;
+
+      std::vector<Tensor<2, spacedim, double>> one_stress;
+
+      std::vector<Tensor<2, spacedim, double>> accumulated_stresses;
+
+      std::vector<Tensor<2, spacedim, double>> pull_accumulated_stresses_back;
+
+      std::vector<Tensor<1, spacedim, double>> one_force;
+
+      std::vector<Tensor<1, spacedim, double>> accumulated_forces;
+
+      std::vector<ForceContribution<dim, spacedim> *> cell_forces;
+
+      types::material_id current_id;
+
+      ActiveStrain<dim, spacedim> *current_as;
+    };
+
+    /**
+     * Compute the contributions of stresses with the shape function gradients
+     * stored in a ReferenceValuesCache instead of FEValues. Every active strain
+     * in @p as_map must have been set up with
+     * ActiveStrain::setup_cellwise_strain().
+     */
+    template <int dim, int spacedim>
+    void
+    compute_cached_stress_load_vector(
+      const ReferenceValuesCache<dim, spacedim>             &cache,
+      const unsigned int                                     quadrature_index,
+      const std::vector<ForceContribution<dim, spacedim> *> &stresses,
+      const std::map<types::material_id, ActiveStrain<dim, spacedim> *>
+                                                       &as_map,
+      const MechanicsUpdateFlags                        me_flags,
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &current_position,
+      LinearAlgebra::distributed::Vector<double>       &force_rhs)
+    {
+      const auto        &cells         = cache.get_cells();
+      const auto        &components    = cache.get_components();
+      const unsigned int dofs_per_cell = components.size();
+
+      MechanicsValues<dim, spacedim> me_values(me_flags);
+      std::vector<ForceContribution<dim, spacedim> *> cell_stresses;
+      std::vector<types::global_dof_index>            cell_dofs(dofs_per_cell);
+      std::vector<double>                             cell_rhs(dofs_per_cell);
+      std::vector<Tensor<2, spacedim>>                FF;
+      std::vector<Tensor<2, spacedim>>                one_stress;
+      std::vector<Tensor<2, spacedim>>                accumulated_stresses;
+
+      types::material_id           current_id = numbers::invalid_material_id;
+      ActiveStrain<dim, spacedim> *current_as = nullptr;
+      for (std::size_t cell_n = 0; cell_n < cells.size(); ++cell_n)
+        {
+          const auto &cell = cells[cell_n];
+          cell_stresses.clear();
+          for (auto *stress : stresses)
+            if (stress->is_active(cell))
+              cell_stresses.push_back(stress);
+          if (cell_stresses.size() == 0)
+            continue;
+
+          const ArrayView<const double> JxW_values =
+            cache.get_JxW_values(quadrature_index, cell_n);
+          const ArrayView<const Tensor<1, spacedim>> shape_gradients =
+            cache.get_shape_gradients(quadrature_index, cell_n);
+          const std::size_t n_q_points = JxW_values.size();
+          if (FF.size() != n_q_points)
+            {
+              FF.resize(n_q_points);
+              one_stress.resize(n_q_points);
+              accumulated_stresses.resize(n_q_points);
+            }
+
+          // FF = sum_i x_i grad phi_i, where only one row of each grad phi_i
+          // is nonzero
+          cell->get_dof_indices(cell_dofs);
+          std::fill(FF.begin(), FF.end(), Tensor<2, spacedim>());
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              const double       x_i       = current_position[cell_dofs[i]];
+              const unsigned int component = components[i];
+              for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                FF[qp_n][component] +=
+                  x_i * shape_gradients[i * n_q_points + qp_n];
+            }
+          if (as_map.size() > 0 && cell->material_id() != current_id)
+            {
+              current_id    = cell->material_id();
+              const auto it = as_map.find(current_id);
+              current_as    = it == as_map.end() ? nullptr : it->second;
+            }
+          if (current_as)
+            {
+              const Tensor<2, spacedim> &FF_A_inv =
+                current_as->get_cellwise_FF_A_inv(cell);
+              for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                FF[qp_n] = FF[qp_n] * FF_A_inv;
+            }
+          me_values.reinit(FF);
+
+          std::fill(accumulated_stresses.begin(),
+                    accumulated_stresses.end(),
+                    Tensor<2, spacedim>());
+          for (const auto *stress : cell_stresses)
+            {
+              auto scratch_stresses = make_array_view(one_stress);
+              auto view             = make_array_view(accumulated_stresses);
+              stress->add_stress(time, me_values, cell, scratch_stresses, view);
+            }
+          if (current_as)
+            {
+              const Tensor<2, spacedim> FF_A_inv_T =
+                transpose(current_as->get_cellwise_FF_A_inv(cell));
+
+              const double det_FF_A = current_as->get_cellwise_det_FF_A(cell);
+              for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                accumulated_stresses[qp_n] =
+                  det_FF_A * accumulated_stresses[qp_n] * FF_A_inv_T;
+            }
+
+          // -PP : grad phi dx
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              const unsigned int component = components[i];
+              double             value     = 0.0;
+              for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                value -= accumulated_stresses[qp_n][component] *
+                         shape_gradients[i * n_q_points + qp_n] *
+                         JxW_values[qp_n];
+              cell_rhs[i] = value;
+            }
+          force_rhs.add(cell_dofs, cell_rhs);
+        }
+    }
+  } // namespace
+
   template <int dim, int spacedim>
   void
   compute_volumetric_pk1_load_vector(
@@ -49,6 +238,116 @@ namespace fdl
 
 
 
+  template <int dim>
+  void
+  compute_volumetric_pk1_load_vector(
+    const MatrixFree<dim, double>                    &matrix_free,
+    const unsigned int                                quadrature_index,
+    const std::vector<ForceContribution<dim, dim> *> &stress_contributions,
+    const double                                      time,
+    const LinearAlgebra::distributed::Vector<double> &current_position,
+    LinearAlgebra::distributed::Vector<double>       &force_rhs)
+  {
+#ifdef DEBUG
+    for (const auto *p : stress_contributions)
+      {
+        Assert(p, ExcMessage("stresses should not be nullptr"));
+        Assert(p->is_stress(), ExcMessage("only valid for stresses"));
+        Assert(p->has_vectorized_stress(),
+               ExcMessage("only valid for vectorized stresses"));
+      }
+#endif
+    if (stress_contributions.size() == 0)
+      return;
+    HardwareCounterRegion region(
+      "fdl::compute_volumetric_pk1_load_vector()[matrix_free]");
+
+    using VectorizedArrayType = VectorizedArray<double>;
+    using VectorType          = LinearAlgebra::distributed::Vector<double>;
+    MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_FF;
+    for (const auto *stress : stress_contributions)
+      me_flags |= stress->get_mechanics_update_flags();
+
+    // cell_loop() visits the cells without ghost DoFs while the ghost values
+    // of the position are exchanged and compresses the load vector while it
+    // visits the remaining ones. A range may run on any thread so each one
+    // sets up its own scratch data.
+    const std::function<void(const MatrixFree<dim, double> &,
+                             VectorType &,
+                             const VectorType &,
+                             const std::pair<unsigned int, unsigned int> &)>
+      local_apply = [&](const MatrixFree<dim, double>               &data,
+                        VectorType                                  &dst,
+                        const VectorType                            &src,
+                        const std::pair<unsigned int, unsigned int> &range)
+    {
+      VectorizedMechanicsValues<dim> me_values(me_flags);
+
+      FEEvaluation<dim, -1, 0, dim, double> phi(data, 0, quadrature_index);
+      const unsigned int n_quadrature_points = phi.n_q_points;
+      std::vector<Tensor<2, dim, VectorizedArrayType>> FF(n_quadrature_points);
+      std::vector<Tensor<2, dim, VectorizedArrayType>> one_stress(
+        n_quadrature_points);
+      std::vector<Tensor<2, dim, VectorizedArrayType>> accumulated_stresses(
+        n_quadrature_points);
+      std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+      for (unsigned int batch_n = range.first; batch_n < range.second;
+           ++batch_n)
+        {
+          phi.reinit(batch_n);
+          const unsigned int n_filled =
+            data.n_active_entries_per_cell_batch(batch_n);
+          cells.clear();
+          for (unsigned int v = 0; v < n_filled; ++v)
+            {
+              const typename DoFHandler<dim>::active_cell_iterator cell =
+                data.get_cell_iterator(batch_n, v);
+              cells.emplace_back(cell);
+            }
+          const ArrayView<
+            const typename Triangulation<dim>::active_cell_iterator>
+            cells_view(cells.data(), cells.size());
+
+          phi.read_dof_values(src);
+          phi.evaluate(EvaluationFlags::gradients);
+          for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+            {
+              FF[qp_n] = phi.get_gradient(qp_n);
+              // lanes without cells are zero - use the identity instead
+              for (unsigned int v = n_filled; v < VectorizedArrayType::size();
+                   ++v)
+                for (unsigned int d = 0; d < dim; ++d)
+                  FF[qp_n][d][d][v] = 1.0;
+            }
+          me_values.reinit(FF);
+
+          std::fill(accumulated_stresses.begin(),
+                    accumulated_stresses.end(),
+                    Tensor<2, dim, VectorizedArrayType>());
+          for (const ForceContribution<dim, dim> *stress :
+               stress_contributions)
+            {
+              auto view = make_array_view(one_stress);
+              stress->compute_vectorized_stress(time,
+                                                me_values,
+                                                cells_view,
+                                                view);
+              for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                accumulated_stresses[qp_n] += one_stress[qp_n];
+            }
+
+          // -PP : grad phi dx
+          for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+            phi.submit_gradient(-accumulated_stresses[qp_n], qp_n);
+          phi.integrate(EvaluationFlags::gradients);
+          phi.distribute_local_to_global(dst);
+        }
+    };
+    matrix_free.cell_loop(local_apply, force_rhs, current_position);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   compute_volumetric_force_load_vector(
@@ -82,6 +381,89 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::vector<ForceContributionGroup<dim, spacedim>>
+  group_force_contributions(
+    const Mapping<dim, spacedim>                          &mapping,
+    const FiniteElement<dim, spacedim>                    &fe,
+    const std::vector<ForceContribution<dim, spacedim> *> &force_contributions)
+  {
+    std::vector<ForceContributionGroup<dim, spacedim>> groups;
+    for (auto *fc : force_contributions)
+      {
+        Assert(fc, ExcMessage("force contributions should not be nullptr"));
+        AssertThrow(fc->is_stress() || fc->is_volume_force() ||
+                      fc->is_boundary_force(),
+                    ExcFDLNotImplemented());
+        const auto same_quadrature =
+          [&](const ForceContributionGroup<dim, spacedim> &group)
+        {
+          const ForceContribution<dim, spacedim> &exemplar =
+            *group.forces.front();
+          if (fc->is_boundary_force())
+            return exemplar.is_boundary_force() &&
+                   exemplar.get_face_quadrature() == fc->get_face_quadrature();
+          else
+            return !exemplar.is_boundary_force() &&
+                   exemplar.get_cell_quadrature() == fc->get_cell_quadrature();
+        };
+        auto it = std::find_if(groups.begin(), groups.end(), same_quadrature);
+        if (it == groups.end())
+          {
+            groups.emplace_back();
+            it = groups.end() - 1;
+          }
+        it->forces.push_back(fc);
+      }
+
+    for (ForceContributionGroup<dim, spacedim> &group : groups)
+      {
+        // Collect common flags:
+        group.me_flags           = MechanicsUpdateFlags::update_nothing;
+        group.update_flags       = UpdateFlags::update_default;
+        group.has_boundary_faces = false;
+        for (const auto *fc : group.forces)
+          {
+            group.me_flags |= fc->get_mechanics_update_flags();
+            group.update_flags |= fc->get_update_flags();
+          }
+        group.update_flags |= compute_flag_dependencies(group.me_flags);
+
+        // Add the stuff we need when assembling too:
+        const ForceContribution<dim, spacedim> &exemplar = *group.forces[0];
+        if (exemplar.is_boundary_force())
+          {
+            group.update_flags |= update_values | update_JxW_values;
+            group.fe_face_values =
+              std::make_unique<FEFaceValues<dim, spacedim>>(
+                mapping,
+                fe,
+                exemplar.get_face_quadrature(),
+                group.update_flags);
+          }
+        else
+          {
+            group.update_flags |= update_JxW_values;
+            if (std::any_of(group.forces.begin(),
+                            group.forces.end(),
+                            [](const ForceContribution<dim, spacedim> *fc)
+                            { return fc->is_volume_force(); }))
+              group.update_flags |= update_values;
+            if (std::any_of(group.forces.begin(),
+                            group.forces.end(),
+                            [](const ForceContribution<dim, spacedim> *fc)
+                            { return fc->is_stress(); }))
+              group.update_flags |= update_gradients;
+            group.fe_values = std::make_unique<FEValues<dim, spacedim>>(
+              mapping, fe, exemplar.get_cell_quadrature(), group.update_flags);
+          }
+      }
+
+    return groups;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   compute_boundary_force_load_vector(
@@ -103,102 +485,141 @@ namespace fdl
       }
 #endif
 
-    // Batch forces by the quadrature rules they use
-    std::vector<ForceContribution<dim, spacedim> *> remaining_forces =
-      boundary_force_contributions;
-    while (remaining_forces.size() > 0)
-      {
-        auto                       exemplar_force = remaining_forces.front();
-        const Quadrature<dim - 1> &exemplar_quadrature =
-          exemplar_force->get_face_quadrature();
-        const auto next_group_start =
-          std::partition(remaining_forces.begin(),
-                         remaining_forces.end(),
-                         [&](const ForceContribution<dim, spacedim> *p) {
-                           return p->get_face_quadrature() ==
-                                  exemplar_quadrature;
-                         });
-
-        std::vector<ForceContribution<dim, spacedim> *> current_forces(
-          remaining_forces.begin(), next_group_start);
-        remaining_forces.erase(remaining_forces.begin(), next_group_start);
+    std::vector<ForceContributionGroup<dim, spacedim>> groups =
+      group_force_contributions(mapping,
+                                dof_handler.get_fe(),
+                                boundary_force_contributions);
+    compute_boundary_force_load_vector(dof_handler,
+                                       groups,
+                                       time,
+                                       current_position,
+                                       current_velocity,
+                                       force_rhs);
+  }
 
-        // Collect common flags:
-        MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
-        UpdateFlags          update_flags = UpdateFlags::update_default;
-        for (const auto *force : current_forces)
-          {
-            me_flags |= force->get_mechanics_update_flags();
-            update_flags |= force->get_update_flags();
-          }
-        update_flags |= compute_flag_dependencies(me_flags);
-        // Add the stuff we need here too:
-        update_flags |= update_values | update_JxW_values;
-        const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
 
-        FEFaceValues<dim, spacedim> fe_values(mapping,
-                                              fe,
-                                              exemplar_quadrature,
-                                              update_flags);
+
+  template <int dim, int spacedim>
+  void
+  compute_boundary_force_load_vector(
+    const DoFHandler<dim, spacedim>                    &dof_handler,
+    std::vector<ForceContributionGroup<dim, spacedim>> &force_groups,
+    const double                                        time,
+    const LinearAlgebra::distributed::Vector<double>   &current_position,
+    const LinearAlgebra::distributed::Vector<double>   &current_velocity,
+    LinearAlgebra::distributed::Vector<double>         &force_rhs)
+  {
+    for (ForceContributionGroup<dim, spacedim> &group : force_groups)
+      {
+        if (!group.fe_face_values)
+          continue;
+        const std::vector<ForceContribution<dim, spacedim> *> &current_forces =
+          group.forces;
+
+        FEFaceValues<dim, spacedim> &fe_values = *group.fe_face_values;
         MechanicsValues<dim,
                         spacedim,
                         LinearAlgebra::distributed::Vector<double>>
-          me_values(fe_values, current_position, current_velocity, me_flags);
+          me_values(fe_values,
+                    current_position,
+                    current_velocity,
+                    group.me_flags);
 
-        const unsigned int n_quadrature_points = exemplar_quadrature.size();
+        const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+        const unsigned int n_quadrature_points = fe_values.n_quadrature_points;
         std::vector<types::global_dof_index>     cell_dofs(fe.dofs_per_cell);
         std::vector<double>                      cell_rhs(fe.dofs_per_cell);
         std::vector<Tensor<1, spacedim, double>> one_force(n_quadrature_points);
         std::vector<Tensor<1, spacedim, double>> accumulated_forces(
           n_quadrature_points);
-        for (const auto &cell : dof_handler.active_cell_iterators())
-          if (cell->is_locally_owned() && cell->at_boundary())
-            for (const auto &face_n : cell->face_indices())
-              // only apply forces on physical boundaries
-              if (!cell->has_periodic_neighbor(face_n) &&
-                  cell->face(face_n)->at_boundary())
-                {
-                  cell->get_dof_indices(cell_dofs);
-                  fe_values.reinit(cell, face_n);
-                  me_values.reinit(cell);
-                  std::fill(accumulated_forces.begin(),
-                            accumulated_forces.end(),
-                            Tensor<1, spacedim, double>());
-                  std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
-                  auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-
-                  // Compute forces at quadrature points
-                  for (const ForceContribution<dim, spacedim> *fc :
-                       current_forces)
-                    {
-                      std::fill(one_force.begin(),
-                                one_force.end(),
-                                Tensor<1, spacedim, double>());
-                      auto view =
-                        make_array_view(one_force.begin(), one_force.end());
-                      fc->compute_boundary_force(time,
-                                                 me_values,
-                                                 cell->face(face_n),
-                                                 view);
-                      for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                           ++qp_n)
-                        accumulated_forces[qp_n] += one_force[qp_n];
-                    }
-
-                  // Assemble the RHS vector
-                  //
-                  // TODO - we could make this a lot faster by exploiting the
-                  // fact that we have primitive FEs most of the time
-                  for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                       ++qp_n)
-                    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                      // F . phi dx
-                      cell_rhs[i] += scalar_product(accumulated_forces[qp_n],
-                                                    extractor.value(i, qp_n)) *
-                                     fe_values.JxW(qp_n);
 
-                  force_rhs.add(cell_dofs, cell_rhs);
-                }
+        // If the group or every force knows the faces on which it is active
+        // then only visit those (in cell order, like the loop over all faces)
+        using FaceType =
+          std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                    unsigned int>;
+        const bool use_active_faces =
+          !group.has_boundary_faces &&
+          std::all_of(current_forces.begin(),
+                      current_forces.end(),
+                      [](const ForceContribution<dim, spacedim> *fc)
+                      { return fc->get_active_boundary_faces() != nullptr; });
+        std::vector<FaceType> local_faces;
+        if (use_active_faces)
+          {
+            for (const auto *fc : current_forces)
+              local_faces.insert(local_faces.end(),
+                                 fc->get_active_boundary_faces()->begin(),
+                                 fc->get_active_boundary_faces()->end());
+            const auto face_order = [](const FaceType &a, const FaceType &b)
+            {
+              return std::make_pair(a.first->active_cell_index(), a.second) <
+                     std::make_pair(b.first->active_cell_index(), b.second);
+            };
+            std::sort(local_faces.begin(), local_faces.end(), face_order);
+            local_faces.erase(std::unique(local_faces.begin(),
+                                          local_faces.end()),
+                              local_faces.end());
+          }
+        else if (!group.has_boundary_faces)
+          {
+            for (const auto &cell : dof_handler.active_cell_iterators())
+              if (cell->is_locally_owned() && cell->at_boundary())
+                for (const auto &face_n : cell->face_indices())
+                  // only apply forces on physical boundaries
+                  if (!cell->has_periodic_neighbor(face_n) &&
+                      cell->face(face_n)->at_boundary())
+                    local_faces.emplace_back(cell, face_n);
+          }
+        const std::vector<FaceType> &faces =
+          group.has_boundary_faces ? group.boundary_faces : local_faces;
+
+        for (const FaceType &face : faces)
+          {
+            const auto cell =
+              typename DoFHandler<dim, spacedim>::active_cell_iterator(
+                &dof_handler.get_triangulation(),
+                face.first->level(),
+                face.first->index(),
+                &dof_handler);
+            const unsigned int face_n = face.second;
+            cell->get_dof_indices(cell_dofs);
+            fe_values.reinit(cell, face_n);
+            me_values.reinit(cell);
+            std::fill(accumulated_forces.begin(),
+                      accumulated_forces.end(),
+                      Tensor<1, spacedim, double>());
+            std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
+            auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
+
+            // Compute forces at quadrature points
+            for (const ForceContribution<dim, spacedim> *fc : current_forces)
+              {
+                std::fill(one_force.begin(),
+                          one_force.end(),
+                          Tensor<1, spacedim, double>());
+                auto view = make_array_view(one_force.begin(), one_force.end());
+                fc->compute_boundary_force(time,
+                                           me_values,
+                                           cell->face(face_n),
+                                           view);
+                for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                  accumulated_forces[qp_n] += one_force[qp_n];
+              }
+
+            // Assemble the RHS vector
+            //
+            // TODO - we could make this a lot faster by exploiting the
+            // fact that we have primitive FEs most of the time
+            for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+              for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                // F . phi dx
+                cell_rhs[i] += scalar_product(accumulated_forces[qp_n],
+                                              extractor.value(i, qp_n)) *
+                               fe_values.JxW(qp_n);
+
+            force_rhs.add(cell_dofs, cell_rhs);
+          }
       }
   }
 
@@ -214,47 +635,49 @@ namespace fdl
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
-    LinearAlgebra::distributed::Vector<double>            &force_rhs)
+    LinearAlgebra::distributed::Vector<double>            &force_rhs,
+    const unsigned int                                     n_threads,
+    const ReferenceValuesCache<dim, spacedim>             *cache)
   {
-    for (const auto *p : force_contributions)
-      {
-        (void)p;
-        Assert(p, ExcMessage("force contributions should not be nullptr"));
-      }
+    std::vector<ForceContributionGroup<dim, spacedim>> groups =
+      group_force_contributions(mapping,
+                                dof_handler.get_fe(),
+                                force_contributions);
+    compute_load_vector(dof_handler,
+                        groups,
+                        active_strains,
+                        time,
+                        current_position,
+                        current_velocity,
+                        force_rhs,
+                        n_threads,
+                        cache);
+  }
 
-    std::vector<ForceContribution<dim, spacedim> *> stress_contributions;
-    std::vector<ForceContribution<dim, spacedim> *> volume_force_contributions;
-    std::vector<ForceContribution<dim, spacedim> *>
-      boundary_force_contributions;
 
-    for (auto *fc : force_contributions)
-      {
-        if (fc->is_stress())
-          stress_contributions.push_back(fc);
-        else if (fc->is_volume_force())
-          volume_force_contributions.push_back(fc);
-        else if (fc->is_boundary_force())
-          boundary_force_contributions.push_back(fc);
-        else
-          AssertThrow(false, ExcFDLNotImplemented());
-      }
 
+  template <int dim, int spacedim>
+  void
+  compute_load_vector(
+    const DoFHandler<dim, spacedim>                    &dof_handler,
+    std::vector<ForceContributionGroup<dim, spacedim>> &force_groups,
+    const std::vector<ActiveStrain<dim, spacedim> *>   &active_strains,
+    const double                                        time,
+    const LinearAlgebra::distributed::Vector<double>   &current_position,
+    const LinearAlgebra::distributed::Vector<double>   &current_velocity,
+    LinearAlgebra::distributed::Vector<double>         &force_rhs,
+    const unsigned int                                  n_threads,
+    const ReferenceValuesCache<dim, spacedim>          *cache)
+  {
+    AssertThrow(n_threads > 0, ExcMessage("At least one thread is required."));
     if (dim != spacedim)
-      AssertThrow(stress_contributions.size() == 0,
-                  ExcMessage("Stresses are not supported on codim 1 meshes."));
-
-    AssertThrow(stress_contributions.size() +
-                    volume_force_contributions.size() +
-                    boundary_force_contributions.size() ==
-                  force_contributions.size(),
-                ExcMessage("The forces must be partitioned into three parts."));
-
-    // Batch stresses by the quadrature rules they use
-    std::vector<ForceContribution<dim, spacedim> *> remaining_forces =
-      stress_contributions;
-    remaining_forces.insert(remaining_forces.end(),
-                            volume_force_contributions.begin(),
-                            volume_force_contributions.end());
+      for (const ForceContributionGroup<dim, spacedim> &group : force_groups)
+        AssertThrow(std::none_of(group.forces.begin(),
+                                 group.forces.end(),
+                                 [](const ForceContribution<dim, spacedim> *fc)
+                                 { return fc->is_stress(); }),
+                    ExcMessage(
+                      "Stresses are not supported on codim 1 meshes."));
 
     // convert the active strains into a map for easier lookup
     std::map<types::material_id, ActiveStrain<dim, spacedim> *> as_map;
@@ -271,172 +694,266 @@ namespace fdl
           }
       }
 
-    types::material_id           current_id = numbers::invalid_material_id;
-    ActiveStrain<dim, spacedim> *current_as = nullptr;
-    while (remaining_forces.size() > 0)
+    for (ForceContributionGroup<dim, spacedim> &group : force_groups)
       {
-        auto                   exemplar_force = remaining_forces.front();
-        const Quadrature<dim> &exemplar_quadrature =
-          exemplar_force->get_cell_quadrature();
-        const auto next_group_start =
-          std::partition(remaining_forces.begin(),
-                         remaining_forces.end(),
-                         [&](const ForceContribution<dim, spacedim> *p) {
-                           return p->get_cell_quadrature() ==
-                                  exemplar_quadrature;
-                         });
-
-        std::vector<ForceContribution<dim, spacedim> *> current_forces(
-          remaining_forces.begin(), next_group_start);
-        remaining_forces.erase(remaining_forces.begin(), next_group_start);
+        // the boundary stuff is totally different anyway
+        if (!group.fe_values)
+          continue;
+        const std::vector<ForceContribution<dim, spacedim> *> &current_forces =
+          group.forces;
+        const MechanicsUpdateFlags me_flags = group.me_flags;
+        const Quadrature<dim>     &exemplar_quadrature =
+          group.fe_values->get_quadrature();
 
-        // Collect common flags:
-        MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
-        UpdateFlags          update_flags = UpdateFlags::update_default;
-        for (const auto *stress : current_forces)
+        // Stresses which only depend on FF can use cached shape function
+        // gradients instead of FEValues. This is also possible with active
+        // strains if they are defined by a single tensor on each cell.
+        if (cache && std::all_of(active_strains.begin(),
+                                 active_strains.end(),
+                                 [](const ActiveStrain<dim, spacedim> *as)
+                                 { return as->has_cellwise_strain(); }))
           {
-            me_flags |= stress->get_mechanics_update_flags();
-            update_flags |= stress->get_update_flags();
+            const unsigned int quadrature_index =
+              cache->get_quadrature_index(exemplar_quadrature);
+            const UpdateFlags ff_flags = compute_flag_dependencies(me_flags);
+            const MechanicsUpdateFlags uncached_flags =
+              MechanicsUpdateFlags::update_position_values |
+              MechanicsUpdateFlags::update_velocity_values |
+              MechanicsUpdateFlags::update_deformed_normal_vectors;
+            const bool use_cache =
+              quadrature_index != numbers::invalid_unsigned_int &&
+              !(me_flags & uncached_flags) &&
+              std::all_of(current_forces.begin(),
+                          current_forces.end(),
+                          [&](const ForceContribution<dim, spacedim> *fc)
+                          {
+                            return fc->is_stress() &&
+                                   (fc->get_update_flags() | ff_flags) ==
+                                     ff_flags;
+                          });
+            if (use_cache)
+              {
+                compute_cached_stress_load_vector(*cache,
+                                                  quadrature_index,
+                                                  current_forces,
+                                                  as_map,
+                                                  me_flags,
+                                                  time,
+                                                  current_position,
+                                                  force_rhs);
+                continue;
+              }
           }
-        update_flags |= compute_flag_dependencies(me_flags);
-        // Add the stuff we need here too:
-        update_flags |= update_JxW_values;
-        if (std::any_of(current_forces.begin(),
-                        current_forces.end(),
-                        [](const ForceContribution<dim, spacedim> *fc)
-                        { return fc->is_volume_force(); }))
-          update_flags |= update_values;
-        if (std::any_of(current_forces.begin(),
-                        current_forces.end(),
-                        [](const ForceContribution<dim, spacedim> *fc)
-                        { return fc->is_stress(); }))
-          update_flags |= update_gradients;
 
         const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+        const unsigned int n_quadrature_points = exemplar_quadrature.size();
 
-        FEValues<dim, spacedim> fe_values(mapping,
-                                          fe,
-                                          exemplar_quadrature,
-                                          update_flags);
-        MechanicsValues<dim,
-                        spacedim,
-                        LinearAlgebra::distributed::Vector<double>>
-          me_values(fe_values, current_position, current_velocity, me_flags);
+        // Assemble the local contributions of a single cell into the given
+        // arrays. Returns whether or not any force is active on the cell.
+        auto assemble_cell =
+          [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                &cell,
+              LoadVectorScratch<dim, spacedim>         &scratch,
+              const ArrayView<types::global_dof_index> &cell_dofs,
+              const ArrayView<double>                  &cell_rhs)
+        {
+          // Skip cells on which none of the forces are active so that we
+          // don't compute FF, invariants, etc. on them
+          scratch.cell_forces.clear();
+          for (auto *fc : current_forces)
+            if (fc->is_active(cell))
+              scratch.cell_forces.push_back(fc);
+          if (scratch.cell_forces.size() == 0)
+            return false;
 
-        const unsigned int n_quadrature_points = exemplar_quadrature.size();
-        std::vector<types::global_dof_index>     cell_dofs(fe.dofs_per_cell);
-        std::vector<Tensor<2, spacedim, double>> one_stress(
-          n_quadrature_points);
-        std::vector<Tensor<2, spacedim, double>> accumulated_stresses(
-          n_quadrature_points);
-        std::vector<Tensor<2, spacedim, double>> pull_accumulated_stresses_back(
-          n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> one_force(n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> accumulated_forces(
-          n_quadrature_points);
-        std::vector<double> cell_rhs(fe.dofs_per_cell);
+          FEValues<dim, spacedim> &fe_values = scratch.fe_values;
+          auto                    &me_values = scratch.me_values;
+          auto &accumulated_stresses = scratch.accumulated_stresses;
+          auto &pull_accumulated_stresses_back =
+            scratch.pull_accumulated_stresses_back;
+          auto &accumulated_forces = scratch.accumulated_forces;
+
+          cell->get_dof_indices(scratch.cell_dofs);
+          std::copy(scratch.cell_dofs.begin(),
+                    scratch.cell_dofs.end(),
+                    cell_dofs.begin());
+          fe_values.reinit(cell);
+          if (active_strains.size() > 0 &&
+              cell->material_id() != scratch.current_id)
+            {
+              scratch.current_id = cell->material_id();
+              const auto it      = as_map.find(scratch.current_id);
+              scratch.current_as = it == as_map.end() ? nullptr : it->second;
+            }
+          ActiveStrain<dim, spacedim> *current_as = scratch.current_as;
+          if (current_as)
+            me_values.reinit(cell, *current_as);
+          else
+            me_values.reinit(cell);
+          std::fill(accumulated_stresses.begin(),
+                    accumulated_stresses.end(),
+                    Tensor<2, spacedim, double>());
+          std::fill(pull_accumulated_stresses_back.begin(),
+                    pull_accumulated_stresses_back.end(),
+                    Tensor<2, spacedim, double>());
+          std::fill(accumulated_forces.begin(),
+                    accumulated_forces.end(),
+                    Tensor<1, spacedim, double>());
+          std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
+          auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
+
+          bool touched_stress = false;
+          bool touched_force  = false;
+          for (const ForceContribution<dim, spacedim> *fc :
+               scratch.cell_forces)
+            {
+              if (fc->is_stress())
+                {
+                  touched_stress = true;
+                  auto scratch_stresses = make_array_view(scratch.one_stress);
+                  auto view = make_array_view(accumulated_stresses);
+                  fc->add_stress(time, me_values, cell, scratch_stresses, view);
+                }
+              else if (fc->is_volume_force())
+                {
+                  touched_force = true;
+                  std::fill(scratch.one_force.begin(),
+                            scratch.one_force.end(),
+                            Tensor<1, spacedim, double>());
+                  auto view = make_array_view(scratch.one_force);
+                  fc->compute_volume_force(time, me_values, cell, view);
+                  for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
+                       ++qp_n)
+                    accumulated_forces[qp_n] += scratch.one_force[qp_n];
+                }
+            }
+
+          if (touched_stress && current_as &&
+              current_as->has_cellwise_strain())
+            {
+              // Avoid the virtual function call when FF_A is known
+              const Tensor<2, spacedim> FF_A_inv_T =
+                transpose(current_as->get_cellwise_FF_A_inv(cell));
+
+              const double det_FF_A = current_as->get_cellwise_det_FF_A(cell);
+              for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                pull_accumulated_stresses_back[qp_n] =
+                  det_FF_A * accumulated_stresses[qp_n] * FF_A_inv_T;
+            }
+          else if (touched_stress && current_as)
+            {
+              auto view = make_array_view(pull_accumulated_stresses_back);
+              current_as->pull_stress_back(
+                cell, make_array_view(accumulated_stresses), view);
+            }
+          else
+            pull_accumulated_stresses_back.swap(accumulated_stresses);
+
+          // Assemble the RHS vector
+          //
+          // TODO - we could make this a lot faster by exploiting the
+          // fact that we have primitive FEs most of the time
+          for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+            {
+              if (touched_stress)
+                for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                  // -PP : grad phi dx
+                  cell_rhs[i] +=
+                    -1. *
+                    scalar_product(pull_accumulated_stresses_back[qp_n],
+                                   extractor.gradient(i, qp_n)) *
+                    fe_values.JxW(qp_n);
+              if (touched_force)
+                for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                  // F . phi dx
+                  cell_rhs[i] += scalar_product(accumulated_forces[qp_n],
+                                                extractor.value(i, qp_n)) *
+                                 fe_values.JxW(qp_n);
+            }
+
+          return true;
+        };
+
+        // Only use threads if every force permits it
+        const bool use_threads =
+          n_threads > 1 &&
+          std::all_of(current_forces.begin(),
+                      current_forces.end(),
+                      [](const ForceContribution<dim, spacedim> *fc)
+                      { return fc->is_thread_safe(); });
+
+        std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+          cells;
         for (const auto &cell : dof_handler.active_cell_iterators())
-          {
-            if (cell->is_locally_owned())
-              {
-                cell->get_dof_indices(cell_dofs);
-                fe_values.reinit(cell);
-                if (active_strains.size() > 0 &&
-                    cell->material_id() != current_id)
-                  {
-                    current_id = cell->material_id();
-                    current_as = as_map[current_id];
-                  }
-                if (current_as)
-                  me_values.reinit(cell, *current_as);
-                else
-                  me_values.reinit(cell);
-                std::fill(accumulated_stresses.begin(),
-                          accumulated_stresses.end(),
-                          Tensor<2, spacedim, double>());
-                std::fill(pull_accumulated_stresses_back.begin(),
-                          pull_accumulated_stresses_back.end(),
-                          Tensor<2, spacedim, double>());
-                std::fill(accumulated_forces.begin(),
-                          accumulated_forces.end(),
-                          Tensor<1, spacedim, double>());
-                std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
-                auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
+          if (cell->is_locally_owned())
+            cells.push_back(cell);
 
-                bool touched_stress = false;
-                bool touched_force  = false;
-                for (const ForceContribution<dim, spacedim> *fc :
-                     current_forces)
-                  {
-                    if (fc->is_stress())
-                      {
-                        touched_stress = true;
-                        std::fill(one_stress.begin(),
-                                  one_stress.end(),
-                                  Tensor<2, spacedim, double>());
-                        auto view =
-                          make_array_view(one_stress.begin(), one_stress.end());
-                        fc->compute_stress(time, me_values, cell, view);
-                        for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                             ++qp_n)
-                          accumulated_stresses[qp_n] += one_stress[qp_n];
-                      }
-                    else if (fc->is_volume_force())
-                      {
-                        touched_force = true;
-                        std::fill(one_force.begin(),
-                                  one_force.end(),
-                                  Tensor<1, spacedim, double>());
-                        auto view =
-                          make_array_view(one_force.begin(), one_force.end());
-                        fc->compute_volume_force(time, me_values, cell, view);
-                        for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                             ++qp_n)
-                          accumulated_forces[qp_n] += one_force[qp_n];
-                      }
-                  }
+        // Cells are assembled in blocks: the local contributions of each
+        // block are computed (possibly by several threads) and then added to
+        // force_rhs in cell order, so the result does not depend on the number
+        // of threads.
+        const std::size_t  block_size    = 256;
+        const std::size_t  n_cells       = cells.size();
+        const unsigned int dofs_per_cell = fe.dofs_per_cell;
 
-                if (touched_stress && current_as)
-                  {
-                    auto view = make_array_view(pull_accumulated_stresses_back);
-                    current_as->pull_stress_back(
-                      cell, make_array_view(accumulated_stresses), view);
-                  }
-                else
-                  pull_accumulated_stresses_back.swap(accumulated_stresses);
+        std::vector<types::global_dof_index> block_dofs(block_size *
+                                                        dofs_per_cell);
+        std::vector<double>        block_rhs(block_size * dofs_per_cell);
+        std::vector<unsigned char> block_touched(block_size);
+#ifdef _OPENMP
+#  pragma omp parallel num_threads(n_threads) if (use_threads)
+#endif
+        {
+          HardwareCounterRegion            region("fdl::compute_load_vector()");
+          // The group's FEValues object can only be used by one thread
+          LoadVectorScratch<dim, spacedim> scratch(*group.fe_values,
+                                                   use_threads,
+                                                   current_position,
+                                                   current_velocity,
+                                                   me_flags);
+          for (std::size_t block_start = 0; block_start < n_cells;
+               block_start += block_size)
+            {
+              const std::size_t block_end =
+                std::min(n_cells, block_start + block_size);
+#ifdef _OPENMP
+#  pragma omp for schedule(static)
+#endif
+              for (std::size_t cell_n = block_start; cell_n < block_end;
+                   ++cell_n)
+                {
+                  const std::size_t offset =
+                    (cell_n - block_start) * dofs_per_cell;
+                  block_touched[cell_n - block_start] = assemble_cell(
+                    cells[cell_n],
+                    scratch,
+                    make_array_view(block_dofs.begin() + offset,
+                                    block_dofs.begin() + offset +
+                                      dofs_per_cell),
+                    make_array_view(block_rhs.begin() + offset,
+                                    block_rhs.begin() + offset +
+                                      dofs_per_cell));
+                }
 
-                // Assemble the RHS vector
-                //
-                // TODO - we could make this a lot faster by exploiting the
-                // fact that we have primitive FEs most of the time
-                for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+#ifdef _OPENMP
+#  pragma omp single
+#endif
+              for (std::size_t cell_n = block_start; cell_n < block_end;
+                   ++cell_n)
+                if (block_touched[cell_n - block_start])
                   {
-                    if (touched_stress)
-                      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                        // -PP : grad phi dx
-                        cell_rhs[i] +=
-                          -1. *
-                          scalar_product(pull_accumulated_stresses_back[qp_n],
-                                         extractor.gradient(i, qp_n)) *
-                          fe_values.JxW(qp_n);
-                    if (touched_force)
-                      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                        // F . phi dx
-                        cell_rhs[i] +=
-                          scalar_product(accumulated_forces[qp_n],
-                                         extractor.value(i, qp_n)) *
-                          fe_values.JxW(qp_n);
+                    const std::size_t offset =
+                      (cell_n - block_start) * dofs_per_cell;
+                    force_rhs.add(dofs_per_cell,
+                                  block_dofs.data() + offset,
+                                  block_rhs.data() + offset);
                   }
-
-                force_rhs.add(cell_dofs, cell_rhs);
-              }
-          }
+            }
+        }
       }
 
-    // the boundary stuff is totally different anyway
     compute_boundary_force_load_vector(dof_handler,
-                                       mapping,
-                                       boundary_force_contributions,
+                                       force_groups,
                                        time,
                                        current_position,
                                        current_velocity,
@@ -465,6 +982,15 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> &,
     LinearAlgebra::distributed::Vector<double> &);
 
+  template void
+  compute_volumetric_pk1_load_vector<NDIM>(
+    const MatrixFree<NDIM, double> &,
+    const unsigned int,
+    const std::vector<ForceContribution<NDIM, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
+
   template void
   compute_volumetric_force_load_vector<NDIM - 1, NDIM>(
     const DoFHandler<NDIM - 1, NDIM> &,
@@ -514,7 +1040,9 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
-    LinearAlgebra::distributed::Vector<double> &);
+    LinearAlgebra::distributed::Vector<double> &,
+    const unsigned int,
+    const ReferenceValuesCache<NDIM - 1, NDIM> *);
 
   template void
   compute_load_vector<NDIM, NDIM>(
@@ -525,5 +1053,61 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &,
+    const unsigned int,
+    const ReferenceValuesCache<NDIM, NDIM> *);
+
+  template std::vector<ForceContributionGroup<NDIM - 1, NDIM>>
+  group_force_contributions(
+    const Mapping<NDIM - 1, NDIM> &,
+    const FiniteElement<NDIM - 1, NDIM> &,
+    const std::vector<ForceContribution<NDIM - 1, NDIM> *> &);
+
+  template void
+  compute_boundary_force_load_vector<NDIM - 1, NDIM>(
+    const DoFHandler<NDIM - 1, NDIM> &,
+    std::vector<ForceContributionGroup<NDIM - 1, NDIM>> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
     LinearAlgebra::distributed::Vector<double> &);
+
+  template void
+  compute_load_vector<NDIM - 1, NDIM>(
+    const DoFHandler<NDIM - 1, NDIM> &,
+    std::vector<ForceContributionGroup<NDIM - 1, NDIM>> &,
+    const std::vector<ActiveStrain<NDIM - 1, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &,
+    const unsigned int,
+    const ReferenceValuesCache<NDIM - 1, NDIM> *);
+
+  template std::vector<ForceContributionGroup<NDIM, NDIM>>
+  group_force_contributions(
+    const Mapping<NDIM, NDIM> &,
+    const FiniteElement<NDIM, NDIM> &,
+    const std::vector<ForceContribution<NDIM, NDIM> *> &);
+
+  template void
+  compute_boundary_force_load_vector<NDIM, NDIM>(
+    const DoFHandler<NDIM, NDIM> &,
+    std::vector<ForceContributionGroup<NDIM, NDIM>> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
+
+  template void
+  compute_load_vector<NDIM, NDIM>(
+    const DoFHandler<NDIM, NDIM> &,
+    std::vector<ForceContributionGroup<NDIM, NDIM>> &,
+    const std::vector<ActiveStrain<NDIM, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &,
+    const unsigned int,
+    const ReferenceValuesCache<NDIM, NDIM> *);
 } // namespace fdl
@@ -309,9 +309,20 @@ namespace fdl
         (*fe_values)[vec].get_function_gradients_from_local_dof_values(
           scratch_position_values, scratch_FF);
 
-        auto view = make_array_view(FF);
-        active_strain.push_deformation_gradient_forward(
-          cell, make_array_view(scratch_FF), view);
+        if (active_strain.has_cellwise_strain())
+          {
+            // Avoid the virtual function call when FF_A is known
+            const Tensor<2, spacedim> &FF_A_inv =
+              active_strain.get_cellwise_FF_A_inv(cell);
+            for (unsigned int q = 0; q < FF.size(); ++q)
+              FF[q] = scratch_FF[q] * FF_A_inv;
+          }
+        else
+          {
+            auto view = make_array_view(FF);
+            active_strain.push_deformation_gradient_forward(
+              cell, make_array_view(scratch_FF), view);
+          }
       }
 
     reinit_from_FF();
@@ -454,6 +465,143 @@ namespace fdl
   }
 
 
+  // VectorizedMechanicsValues
+
+  template <int dim, int spacedim>
+  VectorizedMechanicsValues<dim, spacedim>::VectorizedMechanicsValues(
+    const MechanicsUpdateFlags flags)
+    : update_flags(resolve_flag_dependencies(flags))
+  {
+    AssertThrow(!(update_flags & update_velocity_values),
+                ExcMessage("This class cannot be used to compute velocities."));
+    AssertThrow(!(update_flags & update_position_values),
+                ExcMessage("This class cannot be used to compute positions."));
+    AssertThrow(!(update_flags & update_deformed_normal_vectors),
+                ExcMessage("This class cannot be used to compute deformed "
+                           "normal vectors."));
+  }
+
+  template <int dim, int spacedim>
+  void
+  VectorizedMechanicsValues<dim, spacedim>::resize(const std::size_t size)
+  {
+    // basic terms dependent on the deformation gradient:
+    if (update_flags & MechanicsUpdateFlags::update_FF)
+      FF.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_FF_inv_T)
+      FF_inv_T.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_det_FF)
+      det_FF.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_n23_det_FF)
+      n23_det_FF.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_log_det_FF)
+      log_det_FF.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_right_cauchy_green)
+      right_cauchy_green.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_green)
+      green.resize(size);
+
+    // invariants:
+    if (update_flags & MechanicsUpdateFlags::update_first_invariant)
+      first_invariant.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_modified_first_invariant)
+      modified_first_invariant.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_second_invariant)
+      second_invariant.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_modified_second_invariant)
+      modified_second_invariant.resize(size);
+    if (update_flags & MechanicsUpdateFlags::update_third_invariant)
+      third_invariant.resize(size);
+
+    // derivatives of invariants:
+    if (update_flags & MechanicsUpdateFlags::update_first_invariant_dFF)
+      first_invariant_dFF.resize(size);
+    if (update_flags &
+        MechanicsUpdateFlags::update_modified_first_invariant_dFF)
+      modified_first_invariant_dFF.resize(size);
+  }
+
+  template <int dim, int spacedim>
+  void
+  VectorizedMechanicsValues<dim, spacedim>::reinit(
+    const std::vector<Tensor<2, spacedim, VectorizedArrayType>> &provided_FF)
+  {
+    if (provided_FF.size() != FF.size())
+      resize(provided_FF.size());
+
+    FF = provided_FF;
+
+    reinit_from_FF();
+  }
+
+  template <int dim, int spacedim>
+  void
+  VectorizedMechanicsValues<dim, spacedim>::reinit_from_FF()
+  {
+    // This is the same as MechanicsValues::reinit_from_FF() except that
+    // std::cbrt() is not available for VectorizedArray
+    for (unsigned int q = 0; q < FF.size(); ++q)
+      {
+        if (update_flags & update_FF_inv_T)
+          FF_inv_T[q] = transpose(invert(FF[q]));
+        if (update_flags & update_det_FF)
+          det_FF[q] = determinant(FF[q]);
+        if (update_flags & update_n23_det_FF)
+          n23_det_FF[q] = std::pow(1.0 / det_FF[q], 2.0 / 3.0);
+        if (update_flags & update_log_det_FF)
+          log_det_FF[q] = std::log(det_FF[q]);
+        if (update_flags & update_right_cauchy_green)
+          right_cauchy_green[q] = symmetrize(transpose(FF[q]) * FF[q]);
+        if (update_flags & update_green)
+          {
+            green[q] = right_cauchy_green[q];
+            for (unsigned int d = 0; d < spacedim; ++d)
+              green[q][d][d] -= 1.0;
+            green[q] *= 0.5;
+          }
+
+        // invariants
+        if (update_flags & update_first_invariant)
+          {
+            Assert(dim == 2 || dim == 3, ExcFDLInternalError());
+            first_invariant[q] = dealii::first_invariant(right_cauchy_green[q]);
+            if (dim == 2)
+              first_invariant[q] += 1.0;
+          }
+        if (update_flags & update_modified_first_invariant)
+          modified_first_invariant[q] = first_invariant[q] * n23_det_FF[q];
+        if (update_flags & update_second_invariant)
+          {
+            Assert(dim == 2 || dim == 3, ExcFDLInternalError());
+            second_invariant[q] =
+              dealii::second_invariant(right_cauchy_green[q]);
+            if (dim == 2)
+              second_invariant[q] += trace(right_cauchy_green[q]);
+          }
+        if (update_flags & update_modified_second_invariant)
+          modified_second_invariant[q] =
+            second_invariant[q] * n23_det_FF[q] * n23_det_FF[q];
+        if (update_flags & update_third_invariant)
+          {
+            if (dim == spacedim)
+              third_invariant[q] = det_FF[q] * det_FF[q];
+            else
+              third_invariant[q] =
+                dealii::third_invariant(right_cauchy_green[q]);
+          }
+
+        // derivatives of invariants
+        if (update_flags & update_first_invariant_dFF)
+          first_invariant_dFF[q] = 2.0 * FF[q];
+
+        if (update_flags & update_modified_first_invariant_dFF)
+          modified_first_invariant_dFF[q] =
+            2.0 * n23_det_FF[q] *
+            (FF[q] - (1.0 / 3.0) * first_invariant[q] * FF_inv_T[q]);
+      }
+  }
+
+
   template class MechanicsValues<NDIM - 1, NDIM, Vector<double>>;
   template class MechanicsValues<NDIM, NDIM, Vector<double>>;
 
@@ -464,6 +612,9 @@ namespace fdl
                                  NDIM,
                                  LinearAlgebra::distributed::Vector<double>>;
 
+  template class VectorizedMechanicsValues<NDIM - 1, NDIM>;
+  template class VectorizedMechanicsValues<NDIM, NDIM>;
+
   template void
   MechanicsValues<NDIM - 1, NDIM, Vector<double>>::reinit(
     const DoFHandler<NDIM - 1, NDIM>::active_cell_iterator &cell);
@@ -1,54 +1,459 @@
 #include <fiddle/mechanics/part.h>
 
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_tools.h>
 
 #include <deal.II/grid/reference_cell.h>
 
+#include <deal.II/lac/solver_control.h>
+
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/fe_evaluation.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
 #include <deal.II/numerics/vector_tools_interpolate.h>
 
 #include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <set>
+#include <tuple>
 
 namespace fdl
 {
   namespace internal
   {
     // matrix_free doesn't work with codim != 0 so we need a helper function
-    template <int dim>
+    template <int dim, typename Number>
     void
-    reinit_matrix_free(const Mapping<dim>              &mapping,
-                       const DoFHandler<dim>           &dof_handler,
-                       const AffineConstraints<double> &constraints,
-                       const Quadrature<dim>           &quadrature,
-                       MatrixFree<dim, double>         &matrix_free)
+    reinit_matrix_free(const Mapping<dim>                 &mapping,
+                       const DoFHandler<dim>              &dof_handler,
+                       const AffineConstraints<double>    &constraints,
+                       const std::vector<Quadrature<dim>> &quadratures,
+                       MatrixFree<dim, Number>            &matrix_free)
     {
-      matrix_free.reinit(mapping, dof_handler, constraints, quadrature);
+      matrix_free.reinit(mapping,
+                         std::vector<const DoFHandler<dim> *>{&dof_handler},
+                         std::vector<const AffineConstraints<double> *>{
+                           &constraints},
+                         quadratures,
+                         typename MatrixFree<dim, Number>::AdditionalData());
     }
 
-    template <int dim>
+    template <int dim, typename Number>
     void
     reinit_matrix_free(const Mapping<dim - 1, dim> &,
                        const DoFHandler<dim - 1, dim> &,
                        const AffineConstraints<double> &,
-                       const Quadrature<dim - 1> &,
-                       MatrixFree<dim - 1, double> &)
+                       const std::vector<Quadrature<dim - 1>> &,
+                       MatrixFree<dim - 1, Number> &)
     {
       // We shouldn't get here
       AssertThrow(false, ExcFDLInternalError());
     }
+
+    // Number of DoFs of a scalar simplex element
+    constexpr unsigned int
+    n_simplex_dofs(const int dim, const int degree)
+    {
+      return dim == 1 ? degree + 1 :
+             dim == 2 ? (degree + 1) * (degree + 2) / 2 :
+                        (degree + 1) * (degree + 2) * (degree + 3) / 6;
+    }
+
+    /**
+     * Mass operator for n_components copies of FE_SimplexP<dim>(degree) on
+     * affine cells.
+     *
+     * MatrixFree only evaluates simplex elements with run-time sizes, so
+     * MatrixFreeOperators::MassOperator evaluates and integrates at every
+     * quadrature point with run-time loop bounds. However, since the
+     * Jacobian of an affine cell is constant, each local mass matrix is just
+     * the reference cell's mass matrix times the ratio of the cell volumes.
+     * Hence this operator only does one small dense matrix-vector product (of
+     * compile-time size) per component on each cell.
+     *
+     * Like MassOperator, compute_diagonal() computes the lumped (i.e.,
+     * row-summed) diagonal. compute_cell_scales() must be called after
+     * initialize() and before using the operator.
+     */
+    template <int dim, int degree, int n_components>
+    class SimplexMassOperator
+      : public MatrixFreeOperators::
+          Base<dim, LinearAlgebra::distributed::Vector<double>>
+    {
+    public:
+      using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+      static constexpr unsigned int n_dofs = n_simplex_dofs(dim, degree);
+
+      /**
+       * Compute the reference mass matrix and the ratio of the volume of each
+       * cell to that of the reference cell.
+       */
+      void
+      compute_cell_scales()
+      {
+        Assert(this->data, ExcNotInitialized());
+        const MatrixFree<dim, double> &data = *this->data;
+        const auto &shape_info              = data.get_shape_info();
+        AssertThrow(shape_info.dofs_per_component_on_cell == n_dofs,
+                    ExcFDLInternalError());
+
+        // Reference mass matrix, in the order used by FEEvaluation:
+        const std::vector<unsigned int> &numbering =
+          shape_info.lexicographic_numbering;
+        const FiniteElement<dim> &fe =
+          data.get_dof_handler().get_fe().base_element(0);
+        const QGaussSimplex<dim> quadrature(degree + 1);
+        double                   reference_volume = 0.0;
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          reference_volume += quadrature.weight(q);
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          for (unsigned int j = 0; j < n_dofs; ++j)
+            {
+              double entry = 0.0;
+              for (unsigned int q = 0; q < quadrature.size(); ++q)
+                entry += fe.shape_value(numbering[i], quadrature.point(q)) *
+                         fe.shape_value(numbering[j], quadrature.point(q)) *
+                         quadrature.weight(q);
+              reference_mass_matrix[i * n_dofs + j] = entry;
+            }
+
+        FEEvaluation<dim, -1, 0, n_components, double> phi(data);
+        cell_scales.resize(data.n_cell_batches());
+        for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+          {
+            phi.reinit(cell);
+            VectorizedArray<double> volume = 0.0;
+            for (unsigned int q = 0; q < phi.n_q_points; ++q)
+              volume += phi.JxW(q);
+            cell_scales[cell] = volume / reference_volume;
+          }
+      }
+
+      virtual void
+      compute_diagonal() override
+      {
+        Assert(this->data, ExcNotInitialized());
+        const MatrixFree<dim, double> &data = *this->data;
+
+        // Same as MassOperator:
+        this->inverse_diagonal_entries.reset(new DiagonalMatrix<VectorType>());
+        this->diagonal_entries.reset(new DiagonalMatrix<VectorType>());
+        VectorType &inverse_diagonal =
+          this->inverse_diagonal_entries->get_vector();
+        VectorType &diagonal = this->diagonal_entries->get_vector();
+        data.initialize_dof_vector(inverse_diagonal);
+        data.initialize_dof_vector(diagonal);
+        inverse_diagonal = 1.0;
+        apply_add(diagonal, inverse_diagonal);
+
+        this->set_constrained_entries_to_one(diagonal);
+        inverse_diagonal = diagonal;
+        for (double &value : inverse_diagonal)
+          {
+            Assert(value > 0.0,
+                   ExcMessage("No diagonal entry in a positive definite "
+                              "operator should be zero"));
+            value = 1.0 / value;
+          }
+      }
+
+    protected:
+      virtual void
+      apply_add(VectorType &dst, const VectorType &src) const override
+      {
+        Assert(cell_scales.size() == this->data->n_cell_batches(),
+               ExcMessage("compute_cell_scales() must be called after "
+                          "initialize()"));
+        this->data->cell_loop(
+          &SimplexMassOperator::local_apply_cell, this, dst, src);
+      }
+
+      void
+      local_apply_cell(
+        const MatrixFree<dim, double>               &data,
+        VectorType                                  &dst,
+        const VectorType                            &src,
+        const std::pair<unsigned int, unsigned int> &cell_range) const
+      {
+        FEEvaluation<dim, -1, 0, n_components, double> phi(data);
+        std::array<VectorizedArray<double>, n_components * n_dofs> values;
+        for (unsigned int cell = cell_range.first; cell < cell_range.second;
+             ++cell)
+          {
+            phi.reinit(cell);
+            phi.read_dof_values(src);
+            VectorizedArray<double> *dof_values = phi.begin_dof_values();
+            for (unsigned int c = 0; c < n_components; ++c)
+              for (unsigned int i = 0; i < n_dofs; ++i)
+                {
+                  VectorizedArray<double> sum = 0.0;
+                  for (unsigned int j = 0; j < n_dofs; ++j)
+                    sum += reference_mass_matrix[i * n_dofs + j] *
+                           dof_values[c * n_dofs + j];
+                  values[c * n_dofs + i] = cell_scales[cell] * sum;
+                }
+            std::copy(values.begin(), values.end(), dof_values);
+            phi.distribute_local_to_global(dst);
+          }
+      }
+
+      std::array<double, n_dofs * n_dofs> reference_mass_matrix;
+
+      std::vector<VectorizedArray<double>> cell_scales;
+    };
+
+    /**
+     * Header of the data written by Part::write_setup_data().
+     */
+    struct SetupDataHeader
+    {
+      char          magic[8];
+      std::uint64_t version;
+      std::uint64_t key;
+      std::uint64_t has_mass_diagonal;
+      std::uint64_t n_values;
+    };
+
+    constexpr char setup_data_magic[8] = {
+      'F', 'D', 'L', 'S', 'E', 'T', 'U', 'P'};
+
+    constexpr std::uint64_t setup_data_version = 1;
+
+    /**
+     * FNV-1a hash of some bytes.
+     */
+    inline std::uint64_t
+    hash_bytes(const void *data, const std::size_t n_bytes, std::uint64_t hash)
+    {
+      const unsigned char *bytes = static_cast<const unsigned char *>(data);
+      for (std::size_t i = 0; i < n_bytes; ++i)
+        {
+          hash ^= bytes[i];
+          hash *= 1099511628211ull;
+        }
+      return hash;
+    }
+
+    /**
+     * Compute the key of the setup data of a Part. Unlike the state, the
+     * setup data depends on the DoF numbering and the parallel data
+     * distribution, so those are part of the key too.
+     */
+    template <int dim, int spacedim>
+    std::uint64_t
+    compute_setup_data_key(const DoFHandler<dim, spacedim> &dof_handler,
+                           const DoFRenumberingType         renumbering)
+    {
+      std::uint64_t hash = 14695981039346656037ull;
+      for (const auto &vertex : dof_handler.get_triangulation().get_vertices())
+        for (unsigned int d = 0; d < spacedim; ++d)
+          hash = hash_bytes(&vertex[d], sizeof(double), hash);
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        {
+          const types::subdomain_id subdomain_id = cell->subdomain_id();
+          hash = hash_bytes(&subdomain_id, sizeof(subdomain_id), hash);
+          for (const auto v : cell->vertex_indices())
+            {
+              const unsigned int vertex_index = cell->vertex_index(v);
+              hash = hash_bytes(&vertex_index, sizeof(vertex_index), hash);
+            }
+        }
+      const std::string fe_name = dof_handler.get_fe().get_name();
+      hash = hash_bytes(fe_name.data(), fe_name.size() + 1, hash);
+      hash = hash_bytes(&renumbering, sizeof(renumbering), hash);
+      const MPI_Comm comm = dof_handler.get_communicator();
+      const std::array<std::uint64_t, 4> sizes{
+        {Utilities::MPI::n_mpi_processes(comm),
+         Utilities::MPI::this_mpi_process(comm),
+         dof_handler.n_dofs(),
+         dof_handler.locally_owned_dofs().n_elements()}};
+      hash = hash_bytes(sizes.data(), sizes.size() * sizeof(sizes[0]), hash);
+
+      return hash;
+    }
+
+    // Set up a SimplexMassOperator, which needs one more step than
+    // MassOperator after initialize().
+    template <int dim, int degree, int n_components>
+    std::unique_ptr<MatrixFreeOperators::Base<dim>>
+    make_simplex_mass_operator(
+      const std::shared_ptr<const MatrixFree<dim, double>> &matrix_free)
+    {
+      auto mass_operator =
+        std::make_unique<SimplexMassOperator<dim, degree, n_components>>();
+      mass_operator->initialize(matrix_free);
+      mass_operator->compute_cell_scales();
+      return mass_operator;
+    }
+
+    // Number DoFs cell by cell, with the locally owned cells sorted along a
+    // Hilbert curve through their centers.
+    template <int dim, int spacedim>
+    void
+    renumber_hilbert(DoFHandler<dim, spacedim> &dof_handler)
+    {
+      std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+                                   cells;
+      std::vector<Point<spacedim>> centers;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            cells.push_back(cell);
+            centers.push_back(cell->center());
+          }
+
+      // pack_integers() needs to fit all coordinates into 64 bits
+      const int bits_per_dim = 64 / spacedim;
+      const std::vector<std::array<std::uint64_t, spacedim>> hilbert_indices =
+        Utilities::inverse_Hilbert_space_filling_curve(centers, bits_per_dim);
+      std::vector<std::pair<std::uint64_t, std::size_t>> keys;
+      for (std::size_t i = 0; i < cells.size(); ++i)
+        keys.emplace_back(
+          Utilities::pack_integers<spacedim>(hilbert_indices[i], bits_per_dim),
+          i);
+      std::sort(keys.begin(), keys.end());
+
+      std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+        sorted_cells;
+      for (const auto &key : keys)
+        sorted_cells.push_back(cells[key.second]);
+      DoFRenumbering::cell_wise(dof_handler, sorted_cells);
+    }
+
+    /**
+     * Number the DoFs in the order in which they first appear when looping
+     * over all active cells. Every processor stores every cell of a shared
+     * Triangulation, so this numbering is the same on every processor and
+     * does not depend on the parallel data distribution or the DoF
+     * renumbering. Returns the new index of each DoF.
+     */
+    template <int dim, int spacedim>
+    std::vector<types::global_dof_index>
+    compute_partition_independent_dof_indices(
+      const DoFHandler<dim, spacedim> &dof_handler)
+    {
+      std::vector<types::global_dof_index> new_indices(
+        dof_handler.n_dofs(), numbers::invalid_dof_index);
+      std::vector<types::global_dof_index> cell_dof_indices(
+        dof_handler.get_fe().n_dofs_per_cell());
+      types::global_dof_index n_numbered = 0;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        {
+          AssertThrow(!cell->is_artificial(),
+                      ExcMessage("Portable states require a Triangulation "
+                                 "without artificial cells."));
+          cell->get_dof_indices(cell_dof_indices);
+          for (const types::global_dof_index dof : cell_dof_indices)
+            if (new_indices[dof] == numbers::invalid_dof_index)
+              new_indices[dof] = n_numbered++;
+        }
+      AssertDimension(n_numbered, dof_handler.n_dofs());
+      return new_indices;
+    }
   } // namespace internal
 
+  template <int dim, typename Number>
+  MassPreconditioner<dim, Number>::MassPreconditioner()
+    : type(MassPreconditionerType::Jacobi)
+  {}
+
+  template <int dim, typename Number>
+  void
+  MassPreconditioner<dim, Number>::initialize(
+    const OperatorType          &mass_operator,
+    const MassPreconditionerType new_type,
+    const unsigned int           degree)
+  {
+    initialize(mass_operator,
+               mass_operator.get_matrix_diagonal_inverse(),
+               new_type,
+               degree);
+  }
+
+  template <int dim, typename Number>
+  void
+  MassPreconditioner<dim, Number>::initialize(
+    const OperatorType                                &mass_operator,
+    const std::shared_ptr<DiagonalMatrix<VectorType>> &new_inverse_diagonal,
+    const MassPreconditionerType                       new_type,
+    const unsigned int                                 degree)
+  {
+    AssertThrow(new_inverse_diagonal,
+                ExcMessage("The diagonal of the mass operator should be "
+                           "available."));
+    type             = new_type;
+    inverse_diagonal = new_inverse_diagonal;
+    switch (type)
+      {
+        case MassPreconditionerType::Jacobi:
+          break;
+        case MassPreconditionerType::Chebyshev:
+          {
+            AssertThrow(degree > 0,
+                        ExcMessage("The Chebyshev degree should be positive."));
+            typename decltype(chebyshev)::AdditionalData data;
+            data.preconditioner = inverse_diagonal;
+            data.degree         = degree;
+            // We use this as a preconditioner, not a smoother, so it should
+            // cover the whole spectrum of the (well-conditioned) mass matrix
+            data.smoothing_range     = 100.0;
+            data.eig_cg_n_iterations = 20;
+            chebyshev.initialize(mass_operator, data);
+            break;
+          }
+        default:
+          AssertThrow(false, ExcFDLNotImplemented());
+      }
+  }
+
+  template <int dim, typename Number>
+  void
+  MassPreconditioner<dim, Number>::vmult(VectorType       &dst,
+                                         const VectorType &src) const
+  {
+    switch (type)
+      {
+        case MassPreconditionerType::Jacobi:
+          inverse_diagonal->vmult(dst, src);
+          break;
+        case MassPreconditionerType::Chebyshev:
+          chebyshev.vmult(dst, src);
+          break;
+        default:
+          AssertThrow(false, ExcFDLNotImplemented());
+      }
+  }
+
   template <int dim, int spacedim>
   Part<dim, spacedim>::Part(
     std::shared_ptr<DoFHandler<dim, spacedim>> dh,
     std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
                               force_contributions,
     const Function<spacedim> &initial_position,
-    const Function<spacedim> &initial_velocity)
+    const Function<spacedim> &initial_velocity,
+    const DoFRenumberingType  renumbering)
     : Part(dh,
            std::move(force_contributions),
            {},
            initial_position,
-           initial_velocity)
+           initial_velocity,
+           renumbering)
   {}
 
   template <int dim, int spacedim>
@@ -58,12 +463,21 @@ namespace fdl
       force_contributions,
     std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains,
     const Function<spacedim>                                 &initial_position,
-    const Function<spacedim>                                 &initial_velocity)
+    const Function<spacedim>                                 &initial_velocity,
+    const DoFRenumberingType                                  renumbering)
     : tria(&dh->get_triangulation())
     , fe(dh->get_fe().clone())
     , dof_handler(dh)
+    , renumbering(renumbering)
+    , mass_preconditioner_degree(3)
+    , mass_preconditioner_type(MassPreconditionerType::Jacobi)
+    , mass_preconditioner_is_initialized(false)
+    , single_precision_mass_preconditioner_is_initialized(false)
+    , lumped_mass_is_positive(false)
     , force_contributions(std::move(force_contributions))
+    , reference_values_cache_max_bytes(0)
     , active_strains(std::move(active_strains))
+    , active(true)
   {
     for (const auto &f : this->force_contributions)
       AssertThrow(f != nullptr,
@@ -114,10 +528,124 @@ namespace fdl
                 ExcMessage("The finite element should have spacedim components "
                            "since it will represent the position, velocity and "
                            "force of the part."));
-    // Set up DoFs and finite element fields:
+    setup_dofs();
+    position.reinit(partitioner);
+    velocity.reinit(partitioner);
+
+    // finally, FE fields:
+    VectorTools::interpolate(*dof_handler, initial_position, position);
+    // The initial velocity is probably zero:
+    if (dynamic_cast<const Functions::ZeroFunction<dim> *>(&initial_velocity))
+      velocity = 0.0;
+    else
+      VectorTools::interpolate(*dof_handler, initial_velocity, velocity);
+
+    position.update_ghost_values();
+    velocity.update_ghost_values();
+  }
+
+  namespace
+  {
+    template <int dim, int spacedim>
+    std::shared_ptr<DoFHandler<dim, spacedim>>
+    setup_dof_handler(const Triangulation<dim, spacedim> &tria,
+                      const FiniteElement<dim, spacedim> &fe)
+    {
+      auto dof_handler = std::make_shared<DoFHandler<dim, spacedim>>(tria);
+      dof_handler->distribute_dofs(fe);
+      return dof_handler;
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  Part<dim, spacedim>::Part(
+    const Triangulation<dim, spacedim> &tria,
+    const FiniteElement<dim, spacedim> &fe,
+    std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+                              force_contributions,
+    const Function<spacedim> &initial_position,
+    const Function<spacedim> &initial_velocity,
+    const DoFRenumberingType  renumbering)
+    : Part(setup_dof_handler(tria, fe),
+           std::move(force_contributions),
+           {},
+           initial_position,
+           initial_velocity,
+           renumbering)
+  {}
+
+  template <int dim, int spacedim>
+  Part<dim, spacedim>::Part(
+    const Triangulation<dim, spacedim> &tria,
+    const FiniteElement<dim, spacedim> &fe,
+    std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+      force_contributions,
+    std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains,
+    const Function<spacedim>                                 &initial_position,
+    const Function<spacedim>                                 &initial_velocity,
+    const DoFRenumberingType                                  renumbering)
+    : Part(setup_dof_handler(tria, fe),
+           std::move(force_contributions),
+           std::move(active_strains),
+           initial_position,
+           initial_velocity,
+           renumbering)
+  {}
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::setup_dofs()
+  {
+    const auto &reference_cells = tria->get_reference_cells();
     dof_handler->distribute_dofs(*fe);
+    switch (renumbering)
+      {
+        case DoFRenumberingType::None:
+          break;
+        case DoFRenumberingType::CuthillMcKee:
+          DoFRenumbering::Cuthill_McKee(*dof_handler);
+          break;
+        case DoFRenumberingType::Hilbert:
+          internal::renumber_hilbert(*dof_handler);
+          break;
+        default:
+          AssertThrow(false, ExcFDLNotImplemented());
+      }
+    constraints.clear();
     constraints.close();
 
+    // Stresses with vectorized implementations which use tensor-product Gauss
+    // quadrature rules can be evaluated with the MatrixFree object, so set up
+    // the quadrature rules they need too. Pulling stresses back with active
+    // strains requires the scalar code path.
+    std::vector<Quadrature<dim>> matrix_free_quadratures = {quadrature};
+    matrix_free_quadrature_indices.assign(force_contributions.size(),
+                                          numbers::invalid_unsigned_int);
+    if (dim == spacedim && this->active_strains.size() == 0 &&
+        reference_cells.front() == ReferenceCells::get_hypercube<dim>())
+      for (unsigned int i = 0; i < force_contributions.size(); ++i)
+        {
+          const ForceContribution<dim, spacedim> &force =
+            *force_contributions[i];
+          if (!force.is_stress() || !force.has_vectorized_stress())
+            continue;
+          const Quadrature<dim> &stress_quadrature =
+            force.get_cell_quadrature();
+          const auto n_points_1D = static_cast<unsigned int>(
+            std::round(std::pow(stress_quadrature.size(), 1.0 / dim)));
+          const QGauss<dim> gauss(n_points_1D);
+          if (!(stress_quadrature == gauss))
+            continue;
+
+          const auto it = std::find(matrix_free_quadratures.begin(),
+                                    matrix_free_quadratures.end(),
+                                    gauss);
+          matrix_free_quadrature_indices[i] =
+            it - matrix_free_quadratures.begin();
+          if (it == matrix_free_quadratures.end())
+            matrix_free_quadratures.push_back(gauss);
+        }
+
     // A MatrixFree object sets up the partitioning on its own - use that to
     // avoid issues with p::s::T where there may not be artificial cells
     //
@@ -126,8 +654,11 @@ namespace fdl
     if (dim == spacedim)
       {
         // matrix-free is only implemented in codim 0
-        internal::reinit_matrix_free(
-          *mapping, *dof_handler, constraints, quadrature, *matrix_free);
+        internal::reinit_matrix_free(*mapping,
+                                     *dof_handler,
+                                     constraints,
+                                     matrix_free_quadratures,
+                                     *matrix_free);
         partitioner = matrix_free->get_vector_partitioner();
       }
     else
@@ -141,9 +672,6 @@ namespace fdl
           tria->get_communicator());
       }
 
-    position.reinit(partitioner);
-    velocity.reinit(partitioner);
-
     // Set up matrix free components:
     if (dim == spacedim)
       {
@@ -170,85 +698,282 @@ namespace fdl
                 default:
                   AssertThrow(false, ExcFDLNotImplemented());
               }
+            mass_operator->initialize(matrix_free);
           }
         else
           {
-            using namespace MatrixFreeOperators;
+            // The default mapping is affine on simplices
+            using namespace internal;
             switch (fe->tensor_degree())
               {
                 case 1:
-                  mass_operator.reset(new MassOperator<dim, -1, 0, dim>());
+                  mass_operator =
+                    make_simplex_mass_operator<dim, 1, dim>(matrix_free);
                   break;
                 case 2:
-                  mass_operator.reset(new MassOperator<dim, -1, 0, dim>());
+                  mass_operator =
+                    make_simplex_mass_operator<dim, 2, dim>(matrix_free);
                   break;
                 case 3:
-                  mass_operator.reset(new MassOperator<dim, -1, 0, dim>());
+                  mass_operator =
+                    make_simplex_mass_operator<dim, 3, dim>(matrix_free);
                   break;
                 default:
                   AssertThrow(false, ExcFDLNotImplemented());
               }
           }
-        mass_operator->initialize(matrix_free);
-        mass_operator->compute_diagonal();
-        mass_preconditioner.initialize(*mass_operator, 1.0);
+        // the diagonal is only computed if it is needed
+        mass_preconditioner_is_initialized = false;
+        mass_diagonal_inverse.reset();
+        single_precision_mass_operator.reset();
+        single_precision_matrix_free.reset();
+        single_precision_mass_preconditioner_is_initialized = false;
+
+        // The lumped mass matrix is cheap to set up (one operator
+        // evaluation) so always compute it. Row-sum lumping does not work
+        // with some elements (e.g., quadratic simplices), so keep track of
+        // that too.
+        LinearAlgebra::distributed::Vector<double> ones(partitioner);
+        ones = 1.0;
+        lumped_mass_inverse.reinit(partitioner);
+        mass_operator->vmult(lumped_mass_inverse, ones);
+        int all_positive = 1;
+        for (double &value : lumped_mass_inverse)
+          {
+            all_positive = all_positive && value > 0.0;
+            value        = value > 0.0 ? 1.0 / value : 0.0;
+          }
+        lumped_mass_is_positive =
+          Utilities::MPI::min(all_positive, tria->get_communicator()) == 1;
       }
 
-    // finally, FE fields:
-    VectorTools::interpolate(*dof_handler, initial_position, position);
-    // The initial velocity is probably zero:
-    if (dynamic_cast<const Functions::ZeroFunction<dim> *>(&initial_velocity))
-      velocity = 0.0;
-    else
-      VectorTools::interpolate(*dof_handler, initial_velocity, velocity);
+    // The matrix-free quadrature indices may have changed
+    setup_force_contribution_groups();
+  }
 
-    position.update_ghost_values();
-    velocity.update_ghost_values();
+
+
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  Part<dim, spacedim>::compute_cell_weights(
+    const double cell_cost,
+    const double active_strain_cost) const
+  {
+    AssertThrow(cell_cost >= 0.0 && active_strain_cost >= 0.0,
+                ExcMessage("The costs must not be negative."));
+    std::set<types::material_id> active_strain_ids;
+    for (const auto &as : active_strains)
+      for (const types::material_id m_id : as->get_material_ids())
+        active_strain_ids.insert(m_id);
+
+    std::vector<double> costs(tria->n_active_cells(), 0.0);
+    for (const auto &cell : tria->active_cell_iterators())
+      {
+        if (cell->is_artificial())
+          continue;
+        double &cost = costs[cell->active_cell_index()];
+        cost         = cell_cost;
+        const bool has_active_strain =
+          active_strain_ids.count(cell->material_id()) > 0;
+        for (const auto &force : force_contributions)
+          if (force->is_boundary_force())
+            {
+              const std::vector<types::boundary_id> *ids =
+                force->get_active_boundary_ids();
+              if (ids == nullptr || !cell->at_boundary())
+                continue;
+              const double face_cost =
+                force->get_cost() * force->get_face_quadrature().size();
+              for (const auto &face_n : cell->face_indices())
+                if (!cell->has_periodic_neighbor(face_n) &&
+                    cell->face(face_n)->at_boundary() &&
+                    (ids->size() == 0 ||
+                     std::binary_search(ids->begin(),
+                                        ids->end(),
+                                        cell->face(face_n)->boundary_id())))
+                  cost += face_cost;
+            }
+          else if (force->is_active(cell))
+            {
+              double qp_cost = force->get_cost();
+              if (force->is_stress() && has_active_strain)
+                qp_cost += active_strain_cost;
+              cost += qp_cost * force->get_cell_quadrature().size();
+            }
+      }
+
+    const double max_cost =
+      costs.size() == 0 ? 0.0 : *std::max_element(costs.begin(), costs.end());
+    std::vector<unsigned int> weights(costs.size(), 1u);
+    if (max_cost > 0.0)
+      for (std::size_t i = 0; i < costs.size(); ++i)
+        weights[i] =
+          std::max(1u,
+                   static_cast<unsigned int>(
+                     std::round(100.0 * costs[i] / max_cost)));
+
+    return weights;
   }
 
-  namespace
+
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::setup_force_contribution_groups()
   {
-    template <int dim, int spacedim>
-    std::shared_ptr<DoFHandler<dim, spacedim>>
-    setup_dof_handler(const Triangulation<dim, spacedim> &tria,
-                      const FiniteElement<dim, spacedim> &fe)
+    const std::vector<ForceContribution<dim, spacedim> *> forces =
+      get_force_contributions();
+    std::vector<ForceContribution<dim, spacedim> *> non_matrix_free_forces;
+    for (unsigned int i = 0; i < forces.size(); ++i)
+      if (matrix_free_quadrature_indices[i] == numbers::invalid_unsigned_int)
+        non_matrix_free_forces.push_back(forces[i]);
+
+    force_contribution_groups =
+      group_force_contributions(*mapping, dof_handler->get_fe(), forces);
+    non_matrix_free_force_contribution_groups =
+      group_force_contributions(*mapping,
+                                dof_handler->get_fe(),
+                                non_matrix_free_forces);
+
+    // Boundary forces are typically applied to a small part of the boundary,
+    // so find the locally owned faces of each boundary id used by a boundary
+    // force once instead of visiting every face whenever we compute forces.
+    std::set<types::boundary_id> used_boundary_ids;
+    bool                         use_all_boundary_ids = false;
+    for (const auto *force : forces)
+      if (force->is_boundary_force() && force->get_active_boundary_ids())
+        {
+          const std::vector<types::boundary_id> &ids =
+            *force->get_active_boundary_ids();
+          use_all_boundary_ids = use_all_boundary_ids || ids.size() == 0;
+          used_boundary_ids.insert(ids.begin(), ids.end());
+        }
+    if (!use_all_boundary_ids && used_boundary_ids.size() == 0)
+      return;
+
+    using FaceType =
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                unsigned int>;
+    std::map<types::boundary_id, std::vector<FaceType>> boundary_faces;
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->is_locally_owned() && cell->at_boundary())
+        for (const auto &face_n : cell->face_indices())
+          // only apply forces on physical boundaries
+          if (!cell->has_periodic_neighbor(face_n) &&
+              cell->face(face_n)->at_boundary())
+            {
+              const types::boundary_id id = cell->face(face_n)->boundary_id();
+              if (use_all_boundary_ids || used_boundary_ids.count(id) > 0)
+                boundary_faces[id].emplace_back(cell, face_n);
+            }
+
+    const auto face_order = [](const FaceType &a, const FaceType &b)
     {
-      auto dof_handler = std::make_shared<DoFHandler<dim, spacedim>>(tria);
-      dof_handler->distribute_dofs(fe);
-      return dof_handler;
-    }
-  } // namespace
+      return std::make_pair(a.first->active_cell_index(), a.second) <
+             std::make_pair(b.first->active_cell_index(), b.second);
+    };
+    const auto has_boundary_ids = [](const ForceContribution<dim, spacedim> *fc)
+    { return fc->get_active_boundary_ids() != nullptr; };
+    for (auto *groups : {&force_contribution_groups,
+                         &non_matrix_free_force_contribution_groups})
+      for (ForceContributionGroup<dim, spacedim> &group : *groups)
+        {
+          if (!group.fe_face_values || !std::all_of(group.forces.begin(),
+                                                    group.forces.end(),
+                                                    has_boundary_ids))
+            continue;
 
-  template <int dim, int spacedim>
-  Part<dim, spacedim>::Part(
-    const Triangulation<dim, spacedim> &tria,
-    const FiniteElement<dim, spacedim> &fe,
-    std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
-                              force_contributions,
-    const Function<spacedim> &initial_position,
-    const Function<spacedim> &initial_velocity)
-    : Part(setup_dof_handler(tria, fe),
-           std::move(force_contributions),
-           {},
-           initial_position,
-           initial_velocity)
-  {}
+          for (const auto *fc : group.forces)
+            {
+              const std::vector<types::boundary_id> &ids =
+                *fc->get_active_boundary_ids();
+              for (const auto &pair : boundary_faces)
+                if (ids.size() == 0 ||
+                    std::binary_search(ids.begin(), ids.end(), pair.first))
+                  group.boundary_faces.insert(group.boundary_faces.end(),
+                                              pair.second.begin(),
+                                              pair.second.end());
+            }
+          std::sort(group.boundary_faces.begin(),
+                    group.boundary_faces.end(),
+                    face_order);
+          group.boundary_faces.erase(std::unique(group.boundary_faces.begin(),
+                                                 group.boundary_faces.end()),
+                                     group.boundary_faces.end());
+          group.has_boundary_faces = true;
+        }
+  }
 
   template <int dim, int spacedim>
-  Part<dim, spacedim>::Part(
-    const Triangulation<dim, spacedim> &tria,
-    const FiniteElement<dim, spacedim> &fe,
-    std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
-      force_contributions,
-    std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains,
-    const Function<spacedim>                                 &initial_position,
-    const Function<spacedim>                                 &initial_velocity)
-    : Part(setup_dof_handler(tria, fe),
-           std::move(force_contributions),
-           std::move(active_strains),
-           initial_position,
-           initial_velocity)
-  {}
+  void
+  Part<dim, spacedim>::reinit_dofs()
+  {
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+    AssertThrow(dof_handler->n_dofs() == partitioner->size(),
+                ExcMessage("The DoFHandler should still use the old DoF "
+                           "numbering."));
+    const MPI_Comm comm = tria->get_communicator();
+
+    // Cells do not change, so the old DoF indices of each cell are still
+    // available: record them on the (new) locally owned cells.
+    const unsigned int dofs_per_cell = fe->n_dofs_per_cell();
+    std::vector<types::global_dof_index> old_dof_indices;
+    std::vector<types::global_dof_index> cell_dof_indices(dofs_per_cell);
+    for (const auto &cell : dof_handler->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cell->get_dof_indices(cell_dof_indices);
+          old_dof_indices.insert(old_dof_indices.end(),
+                                 cell_dof_indices.begin(),
+                                 cell_dof_indices.end());
+        }
+    const std::shared_ptr<const Utilities::MPI::Partitioner> old_partitioner =
+      partitioner;
+
+    setup_dofs();
+    reference_values_cache.reset();
+    if (reference_values_cache_max_bytes > 0)
+      setup_reference_values_cache(reference_values_cache_max_bytes);
+
+    // Every new locally owned DoF is on a new locally owned cell, so we can
+    // get all of their old values by ghosting the old vectors.
+    IndexSet needed_old_dofs(old_partitioner->size());
+    {
+      std::vector<types::global_dof_index> sorted_indices = old_dof_indices;
+      std::sort(sorted_indices.begin(), sorted_indices.end());
+      sorted_indices.erase(std::unique(sorted_indices.begin(),
+                                       sorted_indices.end()),
+                           sorted_indices.end());
+      needed_old_dofs.add_indices(sorted_indices.begin(),
+                                  sorted_indices.end());
+    }
+    const auto transfer_partitioner =
+      std::make_shared<Utilities::MPI::Partitioner>(
+        old_partitioner->locally_owned_range(), needed_old_dofs, comm);
+
+    for (VectorType *vector : {&position, &velocity})
+      {
+        VectorType old_vector(transfer_partitioner);
+        for (unsigned int i = 0; i < old_partitioner->locally_owned_size();
+             ++i)
+          old_vector.local_element(i) = vector->local_element(i);
+        old_vector.update_ghost_values();
+
+        vector->reinit(partitioner);
+        std::size_t cell_n = 0;
+        for (const auto &cell : dof_handler->active_cell_iterators())
+          if (cell->is_locally_owned())
+            {
+              cell->get_dof_indices(cell_dof_indices);
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                if (partitioner->in_local_range(cell_dof_indices[i]))
+                  (*vector)[cell_dof_indices[i]] =
+                    old_vector[old_dof_indices[cell_n * dofs_per_cell + i]];
+              ++cell_n;
+            }
+        vector->update_ghost_values();
+      }
+  }
 
   template <int dim, int spacedim>
   void
@@ -270,6 +995,215 @@ namespace fdl
     velocity.update_ghost_values();
   }
 
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::write_state(std::ostream &out) const
+  {
+    const std::uint64_t n_values = position.locally_owned_size();
+    out.write(reinterpret_cast<const char *>(&n_values), sizeof(n_values));
+    for (const auto *vector : {&position, &velocity})
+      out.write(reinterpret_cast<const char *>(vector->begin()),
+                n_values * sizeof(double));
+    AssertThrow(out, ExcMessage("Unable to write the state of the part."));
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::read_state(std::istream &in)
+  {
+    std::uint64_t n_values = 0;
+    in.read(reinterpret_cast<char *>(&n_values), sizeof(n_values));
+    AssertThrow(in && n_values == position.locally_owned_size(),
+                ExcMessage("The stored state of the part does not match the "
+                           "current parallel data distribution."));
+    for (auto *vector : {&position, &velocity})
+      in.read(reinterpret_cast<char *>(vector->begin()),
+              n_values * sizeof(double));
+    AssertThrow(in, ExcMessage("Unable to read the state of the part."));
+
+    position.update_ghost_values();
+    velocity.update_ghost_values();
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::write_portable_state(std::ostream &out) const
+  {
+    const std::vector<types::global_dof_index> portable_indices =
+      internal::compute_partition_independent_dof_indices(*dof_handler);
+    const std::uint64_t n_values = position.locally_owned_size();
+    std::vector<std::uint64_t> indices(n_values);
+    for (std::uint64_t i = 0; i < n_values; ++i)
+      indices[i] = portable_indices[partitioner->local_to_global(i)];
+
+    out.write(reinterpret_cast<const char *>(&n_values), sizeof(n_values));
+    out.write(reinterpret_cast<const char *>(indices.data()),
+              n_values * sizeof(std::uint64_t));
+    for (const auto *vector : {&position, &velocity})
+      out.write(reinterpret_cast<const char *>(vector->begin()),
+                n_values * sizeof(double));
+    AssertThrow(out, ExcMessage("Unable to write the state of the part."));
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::read_portable_state(
+    const std::vector<std::istream *> &inputs)
+  {
+    const MPI_Comm comm = tria->get_communicator();
+    // Map the portable DoF indices back to the current ones
+    const std::vector<types::global_dof_index> portable_indices =
+      internal::compute_partition_independent_dof_indices(*dof_handler);
+    std::vector<types::global_dof_index> current_indices(
+      portable_indices.size());
+    for (types::global_dof_index i = 0; i < portable_indices.size(); ++i)
+      current_indices[portable_indices[i]] = i;
+
+    // Intervals of DoFs owned by each processor, sorted by first DoF
+    std::vector<std::tuple<types::global_dof_index,
+                           types::global_dof_index,
+                           unsigned int>>
+                       owned_intervals;
+    const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+    const std::vector<IndexSet> all_owned_dofs =
+      Utilities::MPI::all_gather(comm, dof_handler->locally_owned_dofs());
+    for (unsigned int r = 0; r < n_procs; ++r)
+      for (auto interval = all_owned_dofs[r].begin_intervals();
+           interval != all_owned_dofs[r].end_intervals();
+           ++interval)
+        owned_intervals.emplace_back(*interval->begin(),
+                                     interval->last() + 1,
+                                     r);
+    std::sort(owned_intervals.begin(), owned_intervals.end());
+    auto get_owner = [&](const types::global_dof_index dof)
+    {
+      auto it = std::upper_bound(
+        owned_intervals.begin(),
+        owned_intervals.end(),
+        dof,
+        [](const types::global_dof_index a, const auto &interval)
+        { return a < std::get<0>(interval); });
+      Assert(it != owned_intervals.begin(), ExcFDLInternalError());
+      --it;
+      Assert(dof < std::get<1>(*it), ExcFDLInternalError());
+      return std::get<2>(*it);
+    };
+
+    // Read every stored value and send it (with its current index) to its
+    // owner in a single all-to-all exchange
+    using Entries =
+      std::pair<std::vector<types::global_dof_index>, std::vector<double>>;
+    std::map<unsigned int, Entries> entries_to_send;
+    for (std::istream *in : inputs)
+      {
+        Assert(in, ExcMessage("The streams should not be nullptr."));
+        std::uint64_t n_values = 0;
+        in->read(reinterpret_cast<char *>(&n_values), sizeof(n_values));
+        std::vector<std::uint64_t> indices(n_values);
+        std::vector<double>        values(2 * n_values);
+        in->read(reinterpret_cast<char *>(indices.data()),
+                 n_values * sizeof(std::uint64_t));
+        in->read(reinterpret_cast<char *>(values.data()),
+                 2 * n_values * sizeof(double));
+        AssertThrow(*in, ExcMessage("Unable to read the state of the part."));
+        for (std::uint64_t i = 0; i < n_values; ++i)
+          {
+            AssertThrow(indices[i] < current_indices.size(),
+                        ExcMessage("The stored state of the part does not "
+                                   "match its DoFs."));
+            const types::global_dof_index dof = current_indices[indices[i]];
+            Entries &entries = entries_to_send[get_owner(dof)];
+            entries.first.push_back(dof);
+            entries.second.push_back(values[i]);
+            entries.second.push_back(values[n_values + i]);
+          }
+      }
+
+    std::size_t n_received = 0;
+    for (const auto &pair : Utilities::MPI::some_to_some(comm, entries_to_send))
+      {
+        const Entries &entries = pair.second;
+        for (std::size_t i = 0; i < entries.first.size(); ++i)
+          {
+            position[entries.first[i]] = entries.second[2 * i];
+            velocity[entries.first[i]] = entries.second[2 * i + 1];
+          }
+        n_received += entries.first.size();
+      }
+    AssertThrow(n_received == position.locally_owned_size(),
+                ExcMessage("The stored state of the part does not contain "
+                           "every locally owned DoF."));
+
+    position.update_ghost_values();
+    velocity.update_ghost_values();
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::write_setup_data(std::ostream &out) const
+  {
+    internal::SetupDataHeader header;
+    std::copy(std::begin(internal::setup_data_magic),
+              std::end(internal::setup_data_magic),
+              std::begin(header.magic));
+    header.version = internal::setup_data_version;
+    header.key     = internal::compute_setup_data_key(*dof_handler,
+                                                      renumbering);
+    header.n_values =
+      mass_diagonal_inverse ?
+        mass_diagonal_inverse->get_vector().locally_owned_size() :
+        0;
+    header.has_mass_diagonal = bool(mass_diagonal_inverse);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (mass_diagonal_inverse)
+      out.write(reinterpret_cast<const char *>(
+                  mass_diagonal_inverse->get_vector().begin()),
+                header.n_values * sizeof(double));
+    AssertThrow(out, ExcMessage("Unable to write the setup data of the part."));
+  }
+
+
+  template <int dim, int spacedim>
+  bool
+  Part<dim, spacedim>::read_setup_data(std::istream &in)
+  {
+    internal::SetupDataHeader header;
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    AssertThrow(in &&
+                  std::equal(std::begin(internal::setup_data_magic),
+                             std::end(internal::setup_data_magic),
+                             std::begin(header.magic)) &&
+                  header.version == internal::setup_data_version,
+                ExcMessage("The setup data of the part is not valid."));
+    // Always read the values so that data written after this part's can
+    // still be read
+    std::vector<double> values(header.n_values);
+    in.read(reinterpret_cast<char *>(values.data()),
+            values.size() * sizeof(double));
+    AssertThrow(in, ExcMessage("Unable to read the setup data of the part."));
+
+    const bool matches =
+      dim == spacedim && header.has_mass_diagonal &&
+      header.key ==
+        internal::compute_setup_data_key(*dof_handler, renumbering) &&
+      header.n_values == dof_handler->locally_owned_dofs().n_elements();
+    if (Utilities::MPI::min(int(matches), tria->get_communicator()) == 0)
+      return false;
+
+    auto inverse_diagonal = std::make_shared<
+      DiagonalMatrix<LinearAlgebra::distributed::Vector<double>>>();
+    matrix_free->initialize_dof_vector(inverse_diagonal->get_vector());
+    std::copy(values.begin(),
+              values.end(),
+              inverse_diagonal->get_vector().begin());
+    mass_diagonal_inverse              = inverse_diagonal;
+    mass_preconditioner_is_initialized = false;
+    return true;
+  }
+
   template <int dim, int spacedim>
   template <class Archive>
   void
@@ -314,8 +1248,378 @@ namespace fdl
     std::unique_ptr<ForceContribution<dim, spacedim>> force)
   {
     force_contributions.push_back(std::move(force));
+    // we would have to set up the MatrixFree object again to evaluate this
+    // force with it
+    matrix_free_quadrature_indices.push_back(numbers::invalid_unsigned_int);
+    setup_force_contribution_groups();
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::setup_reference_values_cache(const std::size_t max_bytes)
+  {
+    reference_values_cache_max_bytes = max_bytes;
+    reference_values_cache =
+      std::make_unique<ReferenceValuesCache<dim, spacedim>>(*dof_handler,
+                                                            *mapping,
+                                                            max_bytes);
+    for (const auto &force : force_contributions)
+      if (force->is_stress())
+        reference_values_cache->add_quadrature(force->get_cell_quadrature());
+  }
+
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  Part<dim, spacedim>::solve_mass_systems(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &solutions,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                      &right_hand_sides,
+    const unsigned int max_steps,
+    const double       relative_tolerance) const
+  {
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+    AssertThrow(dim == spacedim, ExcFDLNotImplemented());
+    AssertThrow(solutions.size() == right_hand_sides.size(),
+                ExcMessage("There should be one solution per right-hand side"));
+    const std::size_t n_systems = solutions.size();
+    const MPI_Comm    comm      = partitioner->get_mpi_communicator();
+
+    // Only reduce over locally owned entries so that we can combine all the
+    // reductions of one step into a single collective operation
+    auto local_dot = [](const VectorType &a, const VectorType &b)
+    {
+      double result = 0.0;
+      for (unsigned int i = 0; i < a.locally_owned_size(); ++i)
+        result += a.local_element(i) * b.local_element(i);
+      return result;
+    };
+
+    std::vector<VectorType> residuals(n_systems);
+    std::vector<VectorType> preconditioned_residuals(n_systems);
+    std::vector<VectorType> directions(n_systems);
+    std::vector<VectorType> products(n_systems);
+    // For each system: r . r, r . z, and b . b
+    std::vector<double> reductions(3 * n_systems);
+    for (std::size_t k = 0; k < n_systems; ++k)
+      {
+        Assert(solutions[k] && right_hand_sides[k],
+               ExcMessage("The vectors should not be null"));
+        residuals[k].reinit(partitioner);
+        preconditioned_residuals[k].reinit(partitioner);
+        directions[k].reinit(partitioner);
+        products[k].reinit(partitioner);
+
+        mass_operator->vmult(residuals[k], *solutions[k]);
+        residuals[k].sadd(-1.0, 1.0, *right_hand_sides[k]);
+        get_mass_preconditioner().vmult(preconditioned_residuals[k],
+                                        residuals[k]);
+        directions[k] = preconditioned_residuals[k];
+
+        reductions[3 * k] = local_dot(residuals[k], residuals[k]);
+        reductions[3 * k + 1] =
+          local_dot(residuals[k], preconditioned_residuals[k]);
+        reductions[3 * k + 2] =
+          local_dot(*right_hand_sides[k], *right_hand_sides[k]);
+      }
+    reductions = Utilities::MPI::sum(reductions, comm);
+
+    std::vector<unsigned int> n_steps(n_systems);
+    std::vector<double>       tolerances(n_systems);
+    std::vector<double>       residual_norms(n_systems);
+    std::vector<double>       rz(n_systems);
+    std::vector<bool>         active(n_systems);
+    std::size_t               n_active = 0;
+    for (std::size_t k = 0; k < n_systems; ++k)
+      {
+        tolerances[k] =
+          relative_tolerance * std::sqrt(reductions[3 * k + 2]);
+        residual_norms[k] = std::sqrt(reductions[3 * k]);
+        rz[k]             = reductions[3 * k + 1];
+        // A zero right-hand side has a zero solution, which we would otherwise
+        // never converge to with a zero tolerance
+        if (reductions[3 * k + 2] == 0.0)
+          *solutions[k] = 0.0;
+        else
+          active[k] = residual_norms[k] > tolerances[k];
+        n_active += active[k];
+      }
+
+    // For each system: p . q, and then r . r and r . z
+    std::vector<double> pq(n_systems);
+    reductions.resize(2 * n_systems);
+    for (unsigned int step = 1; n_active > 0; ++step)
+      {
+        for (std::size_t k = 0; k < n_systems; ++k)
+          AssertThrow(!active[k] || step <= max_steps,
+                      SolverControl::NoConvergence(max_steps,
+                                                   residual_norms[k]));
+
+        std::fill(pq.begin(), pq.end(), 0.0);
+        for (std::size_t k = 0; k < n_systems; ++k)
+          if (active[k])
+            {
+              mass_operator->vmult(products[k], directions[k]);
+              pq[k] = local_dot(directions[k], products[k]);
+            }
+        pq = Utilities::MPI::sum(pq, comm);
+
+        std::fill(reductions.begin(), reductions.end(), 0.0);
+        for (std::size_t k = 0; k < n_systems; ++k)
+          if (active[k])
+            {
+              const double alpha = rz[k] / pq[k];
+              solutions[k]->add(alpha, directions[k]);
+              residuals[k].add(-alpha, products[k]);
+              mass_preconditioner.vmult(preconditioned_residuals[k],
+                                        residuals[k]);
+              reductions[2 * k] = local_dot(residuals[k], residuals[k]);
+              reductions[2 * k + 1] =
+                local_dot(residuals[k], preconditioned_residuals[k]);
+            }
+        reductions = Utilities::MPI::sum(reductions, comm);
+
+        for (std::size_t k = 0; k < n_systems; ++k)
+          if (active[k])
+            {
+              residual_norms[k] = std::sqrt(reductions[2 * k]);
+              if (residual_norms[k] <= tolerances[k])
+                {
+                  active[k]  = false;
+                  n_steps[k] = step;
+                  --n_active;
+                }
+              else
+                {
+                  const double beta = reductions[2 * k + 1] / rz[k];
+                  rz[k]             = reductions[2 * k + 1];
+                  directions[k].sadd(beta, 1.0, preconditioned_residuals[k]);
+                }
+            }
+      }
+
+    return n_steps;
   }
 
+  template <int dim, int spacedim>
+  const MassPreconditioner<dim> &
+  Part<dim, spacedim>::get_mass_preconditioner() const
+  {
+    AssertThrow(dim == spacedim, ExcFDLNotImplemented());
+    if (!mass_preconditioner_is_initialized)
+      {
+        if (!mass_diagonal_inverse)
+          {
+            mass_operator->compute_diagonal();
+            mass_diagonal_inverse =
+              mass_operator->get_matrix_diagonal_inverse();
+          }
+        mass_preconditioner.initialize(*mass_operator,
+                                       mass_diagonal_inverse,
+                                       mass_preconditioner_type,
+                                       mass_preconditioner_degree);
+        mass_preconditioner_is_initialized = true;
+      }
+    return mass_preconditioner;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  Part<dim, spacedim>::supports_single_precision_mass_operator() const
+  {
+    const unsigned int degree = dof_handler->get_fe().tensor_degree();
+    return dim == spacedim && tria->all_reference_cells_are_hyper_cube() &&
+           1 <= degree && degree <= 5;
+  }
+
+  template <int dim, int spacedim>
+  const MatrixFreeOperators::Base<dim,
+                                  LinearAlgebra::distributed::Vector<float>> &
+  Part<dim, spacedim>::get_single_precision_mass_operator() const
+  {
+    AssertThrow(supports_single_precision_mass_operator(),
+                ExcFDLNotImplemented());
+    if (!single_precision_mass_operator)
+      {
+        using VectorType = LinearAlgebra::distributed::Vector<float>;
+        // Only the quadrature used by the double precision mass operator is
+        // needed
+        single_precision_matrix_free =
+          std::make_shared<MatrixFree<dim, float>>();
+        internal::reinit_matrix_free(*mapping,
+                                     *dof_handler,
+                                     constraints,
+                                     std::vector<Quadrature<dim>>{quadrature},
+                                     *single_precision_matrix_free);
+
+        using namespace MatrixFreeOperators;
+        switch (dof_handler->get_fe().tensor_degree())
+          {
+            case 1:
+              single_precision_mass_operator.reset(
+                new MassOperator<dim, 1, 1 + 1, dim, VectorType>());
+              break;
+            case 2:
+              single_precision_mass_operator.reset(
+                new MassOperator<dim, 2, 2 + 1, dim, VectorType>());
+              break;
+            case 3:
+              single_precision_mass_operator.reset(
+                new MassOperator<dim, 3, 3 + 1, dim, VectorType>());
+              break;
+            case 4:
+              single_precision_mass_operator.reset(
+                new MassOperator<dim, 4, 4 + 1, dim, VectorType>());
+              break;
+            case 5:
+              single_precision_mass_operator.reset(
+                new MassOperator<dim, 5, 5 + 1, dim, VectorType>());
+              break;
+            default:
+              AssertThrow(false, ExcFDLNotImplemented());
+          }
+        single_precision_mass_operator->initialize(
+          single_precision_matrix_free);
+        single_precision_mass_operator->compute_diagonal();
+      }
+    return *single_precision_mass_operator;
+  }
+
+  template <int dim, int spacedim>
+  const MassPreconditioner<dim, float> &
+  Part<dim, spacedim>::get_single_precision_mass_preconditioner() const
+  {
+    const auto &float_operator = get_single_precision_mass_operator();
+    if (!single_precision_mass_preconditioner_is_initialized)
+      {
+        single_precision_mass_preconditioner.initialize(
+          float_operator,
+          mass_preconditioner_type,
+          mass_preconditioner_degree);
+        single_precision_mass_preconditioner_is_initialized = true;
+      }
+    return single_precision_mass_preconditioner;
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::set_mass_preconditioner(
+    const MassPreconditionerType type,
+    const unsigned int           degree)
+  {
+    AssertThrow(dim == spacedim, ExcFDLNotImplemented());
+    AssertThrow(type != MassPreconditionerType::Chebyshev || degree > 0,
+                ExcMessage("The Chebyshev degree should be positive."));
+    mass_preconditioner_type                            = type;
+    mass_preconditioner_degree                          = degree;
+    mass_preconditioner_is_initialized                  = false;
+    single_precision_mass_preconditioner_is_initialized = false;
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::set_activation_windows(
+    const std::vector<std::pair<double, double>> &windows)
+  {
+    for (const std::pair<double, double> &window : windows)
+      AssertThrow(window.first <= window.second,
+                  ExcMessage("Each activation window should start before it "
+                             "ends."));
+    activation_windows = windows;
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  Part<dim, spacedim>::memory_consumption() const
+  {
+    // The vectors already include their share of the partitioner, so it is not
+    // counted separately.
+    std::size_t n_bytes =
+      sizeof(*this) + fe->memory_consumption() +
+      dof_handler->memory_consumption() + constraints.memory_consumption() +
+      quadrature.memory_consumption() + mapping->memory_consumption() +
+      lumped_mass_inverse.memory_consumption() +
+      position.memory_consumption() + velocity.memory_consumption() +
+      MemoryConsumption::memory_consumption(matrix_free_quadrature_indices);
+    if (matrix_free)
+      n_bytes += matrix_free->memory_consumption();
+    if (mass_operator)
+      n_bytes += mass_operator->memory_consumption();
+    if (single_precision_matrix_free)
+      n_bytes += single_precision_matrix_free->memory_consumption();
+    if (single_precision_mass_operator)
+      n_bytes += single_precision_mass_operator->memory_consumption();
+    if (reference_values_cache)
+      n_bytes += reference_values_cache->memory_consumption();
+
+    return n_bytes;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<Part<dim, spacedim>>
+  setup_parts(
+    const std::vector<std::function<Part<dim, spacedim>()>> &part_factories,
+    const bool                                               use_threads,
+    std::vector<double>                                     *setup_times)
+  {
+    if (use_threads)
+      {
+        int       provided = 0;
+        const int ierr     = MPI_Query_thread(&provided);
+        AssertThrowMPI(ierr);
+        AssertThrow(provided == MPI_THREAD_MULTIPLE,
+                    ExcMessage("Setting up parts on separate threads requires "
+                               "MPI to be initialized with "
+                               "MPI_THREAD_MULTIPLE."));
+      }
+
+    // Part is not default-constructible, so set up each one in its own slot
+    // and move them into the output afterwards
+    const std::size_t n_parts = part_factories.size();
+    std::vector<std::unique_ptr<Part<dim, spacedim>>> new_parts(n_parts);
+    std::vector<double>                               times(n_parts);
+    const auto setup = [&](const std::size_t part_n)
+    {
+      const double start_time = MPI_Wtime();
+      new_parts[part_n] =
+        std::make_unique<Part<dim, spacedim>>(part_factories[part_n]());
+      times[part_n] = MPI_Wtime() - start_time;
+    };
+
+    if (use_threads)
+      {
+        Threads::TaskGroup<void> tasks;
+        for (std::size_t part_n = 0; part_n < n_parts; ++part_n)
+          tasks += Threads::new_task([&setup, part_n]() { setup(part_n); });
+        tasks.join_all();
+      }
+    else
+      for (std::size_t part_n = 0; part_n < n_parts; ++part_n)
+        setup(part_n);
+
+    std::vector<Part<dim, spacedim>> parts;
+    parts.reserve(n_parts);
+    for (auto &part : new_parts)
+      parts.emplace_back(std::move(*part));
+    if (setup_times)
+      *setup_times = std::move(times);
+
+    return parts;
+  }
+
+  template std::vector<Part<NDIM - 1, NDIM>>
+  setup_parts(const std::vector<std::function<Part<NDIM - 1, NDIM>()>> &,
+              const bool,
+              std::vector<double> *);
+
+  template std::vector<Part<NDIM, NDIM>>
+  setup_parts(const std::vector<std::function<Part<NDIM, NDIM>()>> &,
+              const bool,
+              std::vector<double> *);
+
+  template class MassPreconditioner<NDIM - 1, double>;
+  template class MassPreconditioner<NDIM, double>;
+  template class MassPreconditioner<NDIM - 1, float>;
+  template class MassPreconditioner<NDIM, float>;
   template class Part<NDIM - 1, NDIM>;
   template class Part<NDIM, NDIM>;
 } // namespace fdl
@@ -1,5 +1,7 @@
 #include <fiddle/mechanics/part_vectors.h>
 
+#include <deal.II/base/memory_consumption.h>
+
 namespace fdl
 {
   //
@@ -8,6 +10,8 @@ namespace fdl
   template <int dim, int spacedim>
   PartVectors<dim, spacedim>::PartVectors(
     const std::vector<Part<dim, spacedim>> &parts)
+    : last_position_state(0)
+    , spare_vectors(parts.size())
   {
     for (const auto &part : parts)
       this->parts.push_back(&part);
@@ -23,6 +27,11 @@ namespace fdl
     this->current_time = current_time;
     this->new_time     = new_time;
     this->half_time    = current_time + 0.5 * (new_time - current_time);
+
+    // The current positions may have been changed since the last time step
+    current_position_states.resize(parts.size());
+    for (std::uint64_t &state : current_position_states)
+      state = ++last_position_state;
   }
 
 
@@ -35,14 +44,64 @@ namespace fdl
     half_time    = std::numeric_limits<double>::signaling_NaN();
     new_time     = std::numeric_limits<double>::signaling_NaN();
 
-    half_positions.clear();
-    new_positions.clear();
-    half_velocities.clear();
-    new_velocities.clear();
+    // Rotate the vectors we no longer need into the set of spare vectors
+    // rather than freeing them so that the next time step can reuse them
+    auto do_recycle = [&](auto &vectors)
+    {
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        if (vectors[i].size() > 0)
+          recycle_vector(i, std::move(vectors[i]));
+      vectors.clear();
+    };
+    do_recycle(half_positions);
+    do_recycle(new_positions);
+    do_recycle(half_velocities);
+    do_recycle(new_velocities);
+    do_recycle(current_forces);
+    do_recycle(half_forces);
+    do_recycle(new_forces);
+
+    current_position_states.clear();
+    half_position_states.clear();
+    computed_half_positions.clear();
+    new_position_states.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  LinearAlgebra::distributed::Vector<double>
+  PartVectors<dim, spacedim>::get_temporary_vector(
+    const unsigned int part_n) const
+  {
+    AssertIndexRange(part_n, parts.size());
+    const auto &partitioner = parts[part_n]->get_partitioner();
+    auto       &spares      = spare_vectors[part_n];
+    while (!spares.empty())
+      {
+        LinearAlgebra::distributed::Vector<double> vector;
+        vector.swap(spares.back());
+        spares.pop_back();
+        // The mass solvers check that vectors use the part's partitioner
+        // (and not just a compatible one), so do the same here
+        if (vector.get_partitioner() == partitioner)
+          return vector;
+      }
 
-    current_forces.clear();
-    half_forces.clear();
-    new_forces.clear();
+    return LinearAlgebra::distributed::Vector<double>(partitioner);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PartVectors<dim, spacedim>::recycle_vector(
+    const unsigned int                           part_n,
+    LinearAlgebra::distributed::Vector<double> &&vector)
+  {
+    AssertIndexRange(part_n, parts.size());
+    vector.set_ghost_state(false);
+    spare_vectors[part_n].emplace_back(std::move(vector));
   }
 
 
@@ -84,6 +143,34 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  void
+  PartVectors<dim, spacedim>::compute_half_position(
+    const unsigned int part_n) const
+  {
+    // Position states are nonzero, so zero indicates that the half position
+    // has not been set or computed yet
+    if (part_n < half_position_states.size() &&
+        half_position_states[part_n] != 0)
+      return;
+    Assert(part_n < new_position_states.size() &&
+             new_position_states[part_n] != 0,
+           ExcVectorNotAvailable());
+
+    half_positions.resize(
+      std::max(std::size_t(part_n + 1), half_positions.size()));
+    half_position_states.resize(half_positions.size());
+    computed_half_positions.resize(half_positions.size());
+    computed_half_positions[part_n] = true;
+    auto &half_position = half_positions[part_n];
+    half_position = get_temporary_vector(part_n);
+    half_position.equ(0.5, parts[part_n]->get_position());
+    half_position.add(0.5, new_positions[part_n]);
+    half_position_states[part_n] = ++last_position_state;
+  }
+
+
+
   //
   // Vector access
   //
@@ -98,7 +185,7 @@ namespace fdl
         case TimeStep::Current:
           return parts[part_n]->get_position();
         case TimeStep::Half:
-          Assert(part_n < half_positions.size(), ExcVectorNotAvailable());
+          compute_half_position(part_n);
           return half_positions[part_n];
         case TimeStep::New:
           Assert(part_n < new_positions.size(), ExcVectorNotAvailable());
@@ -111,6 +198,32 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::uint64_t
+  PartVectors<dim, spacedim>::get_position_state(const unsigned int part_n,
+                                                 const double       time) const
+  {
+    AssertIndexRange(part_n, parts.size());
+    switch (get_time_step(time))
+      {
+        case TimeStep::Current:
+          Assert(part_n < current_position_states.size(),
+                 ExcVectorNotAvailable());
+          return current_position_states[part_n];
+        case TimeStep::Half:
+          compute_half_position(part_n);
+          return half_position_states[part_n];
+        case TimeStep::New:
+          Assert(part_n < new_position_states.size(), ExcVectorNotAvailable());
+          return new_position_states[part_n];
+      }
+
+    Assert(false, ExcFDLInternalError());
+    return 0;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   PartVectors<dim, spacedim>::set_position(
@@ -128,11 +241,28 @@ namespace fdl
           half_positions.resize(
             std::max(std::size_t(part_n + 1), half_positions.size()));
           half_positions[part_n].swap(position);
+          half_position_states.resize(half_positions.size());
+          half_position_states[part_n] = ++last_position_state;
+          computed_half_positions.resize(half_positions.size());
+          computed_half_positions[part_n] = false;
           return;
         case TimeStep::New:
           new_positions.resize(
             std::max(std::size_t(part_n + 1), new_positions.size()));
           new_positions[part_n].swap(position);
+          new_position_states.resize(new_positions.size());
+          new_position_states[part_n] = ++last_position_state;
+          // A half position computed from the old new position (e.g., by the
+          // predictor of the trapezoidal rule) is no longer valid
+          if (part_n < computed_half_positions.size() &&
+              computed_half_positions[part_n])
+            {
+              recycle_vector(part_n, std::move(half_positions[part_n]));
+              half_position_states[part_n]    = 0;
+              computed_half_positions[part_n] = false;
+            }
+          if (position.size() > 0)
+            recycle_vector(part_n, std::move(position));
           return;
       }
 
@@ -250,6 +380,24 @@ namespace fdl
     Assert(false, ExcFDLInternalError());
   }
 
+  template <int dim, int spacedim>
+  std::size_t
+  PartVectors<dim, spacedim>::memory_consumption() const
+  {
+    return sizeof(*this) + parts.capacity() * sizeof(parts[0]) +
+           MemoryConsumption::memory_consumption(current_forces) +
+           MemoryConsumption::memory_consumption(half_forces) +
+           MemoryConsumption::memory_consumption(new_forces) +
+           MemoryConsumption::memory_consumption(half_positions) +
+           MemoryConsumption::memory_consumption(new_positions) +
+           MemoryConsumption::memory_consumption(current_position_states) +
+           MemoryConsumption::memory_consumption(half_position_states) +
+           MemoryConsumption::memory_consumption(new_position_states) +
+           MemoryConsumption::memory_consumption(half_velocities) +
+           MemoryConsumption::memory_consumption(new_velocities) +
+           MemoryConsumption::memory_consumption(spare_vectors);
+  }
+
   template class PartVectors<NDIM - 1, NDIM>;
   template class PartVectors<NDIM, NDIM>;
 } // namespace fdl
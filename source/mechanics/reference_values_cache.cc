@@ -0,0 +1,113 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/reference_values_cache.h>
+
+#include <deal.II/fe/fe_values.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim, int spacedim>
+  ReferenceValuesCache<dim, spacedim>::ReferenceValuesCache(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping,
+    const std::size_t                max_bytes)
+    : dof_handler(&dof_handler)
+    , mapping(&mapping)
+    , max_bytes(max_bytes)
+  {
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.is_primitive() && fe.n_components() == spacedim,
+                ExcMessage("ReferenceValuesCache requires a primitive finite "
+                           "element with spacedim components."));
+
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        cells.push_back(cell);
+
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      components.push_back(fe.system_to_component_index(i).first);
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  ReferenceValuesCache<dim, spacedim>::add_quadrature(
+    const Quadrature<dim> &quadrature)
+  {
+    if (get_quadrature_index(quadrature) != numbers::invalid_unsigned_int)
+      return true;
+
+    const FiniteElement<dim, spacedim> &fe = dof_handler->get_fe();
+    const std::size_t n_q_points = quadrature.size();
+    const std::size_t n_values   = cells.size() * n_q_points;
+    const std::size_t n_bytes =
+      n_values * (sizeof(double) +
+                  fe.dofs_per_cell * sizeof(Tensor<1, spacedim>));
+    if (memory_consumption() + n_bytes > max_bytes)
+      return false;
+
+    Entry entry;
+    entry.quadrature = quadrature;
+    entry.JxW_values.resize(n_values);
+    entry.shape_gradients.resize(n_values * fe.dofs_per_cell);
+
+    FEValues<dim, spacedim> fe_values(*mapping,
+                                      fe,
+                                      quadrature,
+                                      update_gradients | update_JxW_values);
+    for (std::size_t cell_n = 0; cell_n < cells.size(); ++cell_n)
+      {
+        fe_values.reinit(cells[cell_n]);
+        std::copy(fe_values.get_JxW_values().begin(),
+                  fe_values.get_JxW_values().end(),
+                  entry.JxW_values.begin() + cell_n * n_q_points);
+
+        // Since the element is primitive each shape function has exactly one
+        // nonzero component, so we only need to store its gradient
+        auto gradients = entry.shape_gradients.begin() +
+                         cell_n * n_q_points * fe.dofs_per_cell;
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+            *gradients++ = fe_values.shape_grad(i, qp_n);
+      }
+
+    entries.emplace_back(std::move(entry));
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  ReferenceValuesCache<dim, spacedim>::get_quadrature_index(
+    const Quadrature<dim> &quadrature) const
+  {
+    for (unsigned int i = 0; i < entries.size(); ++i)
+      if (entries[i].quadrature == quadrature)
+        return i;
+
+    return numbers::invalid_unsigned_int;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  ReferenceValuesCache<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t n_bytes = 0;
+    for (const Entry &entry : entries)
+      n_bytes += entry.JxW_values.size() * sizeof(double) +
+                 entry.shape_gradients.size() * sizeof(Tensor<1, spacedim>);
+
+    return n_bytes;
+  }
+
+  template class ReferenceValuesCache<NDIM - 1, NDIM>;
+  template class ReferenceValuesCache<NDIM, NDIM>;
+} // namespace fdl
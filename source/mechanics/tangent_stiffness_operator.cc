@@ -0,0 +1,210 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/tangent_stiffness_operator.h>
+
+#include <deal.II/base/memory_consumption.h>
+
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/fe_evaluation.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <algorithm>
+#include <functional>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim>
+  TangentStiffnessOperator<dim>::TangentStiffnessOperator(
+    std::shared_ptr<const MatrixFree<dim, double>>    matrix_free,
+    const unsigned int                                quadrature_index,
+    const std::vector<ForceContribution<dim, dim> *> &stresses)
+    : matrix_free(matrix_free)
+    , quadrature_index(quadrature_index)
+    , stresses(stresses)
+    , me_flags(MechanicsUpdateFlags::update_FF)
+    , time(0.0)
+    , n_quadrature_points(0)
+  {
+    AssertThrow(this->matrix_free, ExcMessage("MatrixFree object is null."));
+    for (const auto *stress : this->stresses)
+      {
+        Assert(stress, ExcMessage("stresses should not be nullptr"));
+        AssertThrow(stress->is_stress() && stress->has_vectorized_stress() &&
+                      stress->has_stress_derivative(),
+                    ExcMessage("TangentStiffnessOperator requires vectorized "
+                               "stresses which implement "
+                               "compute_vectorized_stress_derivative()."));
+        me_flags |= stress->get_mechanics_update_flags();
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  TangentStiffnessOperator<dim>::reinit(const double      time,
+                                        const VectorType &position)
+  {
+    this->time = time;
+
+    // Like the matrix-free load vector, we need the ghost values of the
+    // position
+    VectorType ghosted_position;
+    matrix_free->initialize_dof_vector(ghosted_position);
+    ghosted_position.copy_locally_owned_data_from(position);
+    ghosted_position.update_ghost_values();
+
+    FEEvaluation<dim, -1, 0, dim, double> phi(*matrix_free,
+                                              0,
+                                              quadrature_index);
+    n_quadrature_points = phi.n_q_points;
+    FF.resize(matrix_free->n_cell_batches() * n_quadrature_points);
+    for (unsigned int batch_n = 0; batch_n < matrix_free->n_cell_batches();
+         ++batch_n)
+      {
+        phi.reinit(batch_n);
+        phi.read_dof_values(ghosted_position);
+        phi.evaluate(EvaluationFlags::gradients);
+        const unsigned int n_filled =
+          matrix_free->n_active_entries_per_cell_batch(batch_n);
+        for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+          {
+            auto &batch_FF = FF[batch_n * n_quadrature_points + qp_n];
+            batch_FF       = phi.get_gradient(qp_n);
+            // lanes without cells are zero - use the identity instead
+            for (unsigned int v = n_filled; v < VectorizedArray<double>::size();
+                 ++v)
+              for (unsigned int d = 0; d < dim; ++d)
+                batch_FF[d][d][v] = 1.0;
+          }
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  TangentStiffnessOperator<dim>::vmult(VectorType       &dst,
+                                       const VectorType &src) const
+  {
+    apply(dst, src, true);
+  }
+
+
+
+  template <int dim>
+  void
+  TangentStiffnessOperator<dim>::vmult_add(VectorType       &dst,
+                                           const VectorType &src) const
+  {
+    apply(dst, src, false);
+  }
+
+
+
+  template <int dim>
+  void
+  TangentStiffnessOperator<dim>::apply(VectorType       &result,
+                                       const VectorType &direction,
+                                       const bool        zero_result) const
+  {
+    Assert(FF.size() == matrix_free->n_cell_batches() * n_quadrature_points,
+           ExcMessage("reinit() must be called before vmult()."));
+    using VectorizedArrayType = VectorizedArray<double>;
+
+    const std::function<void(const MatrixFree<dim, double> &,
+                             VectorType &,
+                             const VectorType &,
+                             const std::pair<unsigned int, unsigned int> &)>
+      local_apply = [&](const MatrixFree<dim, double>               &data,
+                        VectorType                                  &dst,
+                        const VectorType                            &src,
+                        const std::pair<unsigned int, unsigned int> &range)
+    {
+      VectorizedMechanicsValues<dim> me_values(me_flags);
+
+      FEEvaluation<dim, -1, 0, dim, double> phi(data, 0, quadrature_index);
+      std::vector<Tensor<2, dim, VectorizedArrayType>> batch_FF(
+        n_quadrature_points);
+      std::vector<Tensor<2, dim, VectorizedArrayType>> dFF(
+        n_quadrature_points);
+      std::vector<Tensor<2, dim, VectorizedArrayType>> one_d_stress(
+        n_quadrature_points);
+      std::vector<Tensor<2, dim, VectorizedArrayType>> accumulated_d_stresses(
+        n_quadrature_points);
+      std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+      for (unsigned int batch_n = range.first; batch_n < range.second;
+           ++batch_n)
+        {
+          phi.reinit(batch_n);
+          const unsigned int n_filled =
+            data.n_active_entries_per_cell_batch(batch_n);
+          cells.clear();
+          for (unsigned int v = 0; v < n_filled; ++v)
+            {
+              const typename DoFHandler<dim>::active_cell_iterator cell =
+                data.get_cell_iterator(batch_n, v);
+              cells.emplace_back(cell);
+            }
+          const ArrayView<
+            const typename Triangulation<dim>::active_cell_iterator>
+            cells_view(cells.data(), cells.size());
+
+          std::copy(FF.begin() + batch_n * n_quadrature_points,
+                    FF.begin() + (batch_n + 1) * n_quadrature_points,
+                    batch_FF.begin());
+          me_values.reinit(batch_FF);
+
+          phi.read_dof_values(src);
+          phi.evaluate(EvaluationFlags::gradients);
+          for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+            dFF[qp_n] = phi.get_gradient(qp_n);
+          const ArrayView<const Tensor<2, dim, VectorizedArrayType>> dFF_view(
+            dFF.data(), dFF.size());
+
+          std::fill(accumulated_d_stresses.begin(),
+                    accumulated_d_stresses.end(),
+                    Tensor<2, dim, VectorizedArrayType>());
+          for (const ForceContribution<dim, dim> *stress : stresses)
+            {
+              auto view = make_array_view(one_d_stress);
+              stress->compute_vectorized_stress_derivative(
+                time, me_values, cells_view, dFF_view, view);
+              for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                accumulated_d_stresses[qp_n] += one_d_stress[qp_n];
+            }
+
+          // dPP : grad phi dx
+          for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+            phi.submit_gradient(accumulated_d_stresses[qp_n], qp_n);
+          phi.integrate(EvaluationFlags::gradients);
+          phi.distribute_local_to_global(dst);
+        }
+    };
+    matrix_free->cell_loop(local_apply, result, direction, zero_result);
+  }
+
+
+
+  template <int dim>
+  void
+  TangentStiffnessOperator<dim>::initialize_dof_vector(
+    VectorType &vector) const
+  {
+    matrix_free->initialize_dof_vector(vector);
+  }
+
+
+
+  template <int dim>
+  std::size_t
+  TangentStiffnessOperator<dim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(stresses) +
+           FF.memory_consumption();
+  }
+
+  template class TangentStiffnessOperator<NDIM>;
+} // namespace fdl
@@ -7,6 +7,7 @@
 
 #include <fiddle/postprocess/meter_base.h>
 
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 
 #include <deal.II/dofs/dof_tools.h>
@@ -21,14 +22,17 @@
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_tools.h>
 
+#include <deal.II/lac/vector.h>
+
 #include <deal.II/numerics/vector_tools_interpolate.h>
 #include <deal.II/numerics/vector_tools_mean_value.h>
 
-#include <ibtk/IndexUtilities.h>
-
+#include <BoxArray.h>
+#include <CartesianGridGeometry.h>
 #include <CartesianPatchGeometry.h>
 #include <tbox/InputManager.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -72,8 +76,10 @@ namespace fdl
     , meter_tria(tbox::SAMRAI_MPI::getCommunicator(),
                  Triangulation<dim, spacedim>::MeshSmoothing::none,
                  true)
+    , measure(0.0)
     , scalar_fe(std::make_unique<FE_SimplexP<dim, spacedim>>(1))
     , vector_fe(std::make_unique<FESystem<dim, spacedim>>(*scalar_fe, spacedim))
+    , checked_vertex_margin(0.0)
   {}
 
   template <int dim, int spacedim>
@@ -84,6 +90,8 @@ namespace fdl
     , meter_tria(tbox::SAMRAI_MPI::getCommunicator(),
                  Triangulation<dim, spacedim>::MeshSmoothing::none,
                  true)
+    , measure(0.0)
+    , checked_vertex_margin(0.0)
   {
     AssertThrow(!tria.has_hanging_nodes(), ExcFDLNotImplemented());
     GridGenerator::flatten_triangulation(tria, meter_tria);
@@ -147,6 +155,37 @@ namespace fdl
     identity_position.update_ghost_values();
   }
 
+  template <int dim, int spacedim>
+  void
+  MeterBase<dim, spacedim>::reinit_quadrature_data()
+  {
+    const unsigned int n_q_points = meter_quadrature.size();
+    shape_values.reinit(n_q_points, scalar_fe->dofs_per_cell);
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      for (unsigned int i = 0; i < scalar_fe->dofs_per_cell; ++i)
+        shape_values(q, i) =
+          scalar_fe->shape_value(i, meter_quadrature.point(q));
+
+    FEValues<dim, spacedim> fe_values(get_mapping(),
+                                      *scalar_fe,
+                                      meter_quadrature,
+                                      update_JxW_values);
+    JxW_values.clear();
+    double local_measure = 0.0;
+    for (const auto &cell : scalar_dof_handler.active_cell_iterators() |
+                              IteratorFilters::LocallyOwnedCell())
+      {
+        fe_values.reinit(cell);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            JxW_values.push_back(fe_values.JxW(q));
+            local_measure += fe_values.JxW(q);
+          }
+      }
+    measure =
+      Utilities::MPI::sum(local_measure, meter_tria.get_communicator());
+  }
+
   template <int dim, int spacedim>
   void
   MeterBase<dim, spacedim>::reinit_centroid()
@@ -267,6 +306,7 @@ namespace fdl
   MeterBase<dim, spacedim>::internal_reinit()
   {
     reinit_dofs();
+    reinit_quadrature_data();
     reinit_centroid();
     reinit_interaction();
   }
@@ -286,15 +326,8 @@ namespace fdl
     double value = 0.0;
     if (centroid_cell->is_locally_owned())
       {
-        Quadrature<dim> centroid_quad(ref_centroid);
-        const auto     &fe = get_scalar_dof_handler().get_fe();
-
-        FEValues<dim, spacedim> fe_values(get_mapping(),
-                                          fe,
-                                          centroid_quad,
-                                          update_values);
-        fe_values.reinit(centroid_cell);
-        const auto cell =
+        const auto &fe = get_scalar_dof_handler().get_fe();
+        const auto  cell =
           typename DoFHandler<dim, spacedim>::active_cell_iterator(
             &meter_tria,
             centroid_cell->level(),
@@ -303,8 +336,8 @@ namespace fdl
         std::vector<types::global_dof_index> cell_dofs(fe.dofs_per_cell);
         cell->get_dof_indices(cell_dofs);
         for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-          value +=
-            fe_values.shape_value(i, 0) * interpolated_data[cell_dofs[i]];
+          value += fe.shape_value(i, ref_centroid) *
+                   interpolated_data[cell_dofs[i]];
       }
 
     const int owning_rank =
@@ -325,11 +358,27 @@ namespace fdl
     const auto interpolated_data =
       interpolate_scalar_field(data_idx, kernel_name);
 
-    return VectorTools::compute_mean_value(get_mapping(),
-                                           get_scalar_dof_handler(),
-                                           meter_quadrature,
-                                           interpolated_data,
-                                           0);
+    const unsigned int n_q_points = meter_quadrature.size();
+    Vector<double>     cell_dof_values(scalar_fe->dofs_per_cell);
+    double             integral = 0.0;
+    std::size_t        offset   = 0;
+    for (const auto &cell : get_scalar_dof_handler().active_cell_iterators() |
+                              IteratorFilters::LocallyOwnedCell())
+      {
+        cell->get_dof_values(interpolated_data, cell_dof_values);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            double cell_value = 0.0;
+            for (unsigned int i = 0; i < cell_dof_values.size(); ++i)
+              cell_value += shape_values(q, i) * cell_dof_values[i];
+            integral += cell_value * JxW_values[offset + q];
+          }
+        offset += n_q_points;
+      }
+    Assert(offset == JxW_values.size(), ExcFDLInternalError());
+
+    return Utilities::MPI::sum(integral, meter_tria.get_communicator()) /
+           measure;
   }
 
   template <int dim, int spacedim>
@@ -376,28 +425,109 @@ namespace fdl
   bool
   MeterBase<dim, spacedim>::compute_vertices_inside_domain() const
   {
+    const std::vector<Point<spacedim>> &vertices =
+      get_triangulation().get_vertices();
+    std::vector<double> vertex_coordinates(vertices.size() * spacedim);
+    for (std::size_t vertex_n = 0; vertex_n < vertices.size(); ++vertex_n)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        vertex_coordinates[vertex_n * spacedim + d] = vertices[vertex_n][d];
+
+    // If every vertex was inside the domain last time then no vertex can have
+    // left if none moved further than the distance to the boundary
+    if (checked_vertex_margin > 0.0 &&
+        checked_vertex_coordinates.size() == vertex_coordinates.size())
+      {
+        double max_displacement = 0.0;
+        for (std::size_t i = 0; i < vertex_coordinates.size(); ++i)
+          max_displacement =
+            std::max(max_displacement,
+                     std::abs(vertex_coordinates[i] -
+                              checked_vertex_coordinates[i]));
+        if (max_displacement < checked_vertex_margin)
+          return true;
+      }
+
     tbox::Pointer<geom::CartesianGridGeometry<spacedim>> geom =
       patch_hierarchy->getGridGeometry();
     Assert(geom, ExcFDLInternalError());
-    tbox::Pointer<hier::PatchLevel<spacedim>> patch_level =
-      patch_hierarchy->getPatchLevel(0);
-    Assert(patch_level, ExcFDLInternalError());
-
+    const hier::BoxArray<spacedim> &domain = geom->getPhysicalDomain();
+
+    std::vector<int> indices;
+    compute_cell_indices(make_array_view(vertex_coordinates),
+                         geom->getXLower(),
+                         geom->getXUpper(),
+                         geom->getDx(),
+                         domain[0],
+                         indices);
     bool vertices_inside_domain = true;
-    for (const auto &vertex : get_triangulation().get_vertices())
+    if (domain.getNumberOfBoxes() == 1)
       {
-        const auto index =
-          IBTK::IndexUtilities::getCellIndex(vertex,
-                                             geom,
-                                             hier::IntVector<spacedim>(1));
+        std::vector<unsigned char> inside;
+        contains(domain[0], indices, inside);
         vertices_inside_domain =
-          vertices_inside_domain &&
-          patch_level->getPhysicalDomain().contains(index);
+          std::all_of(inside.begin(),
+                      inside.end(),
+                      [](const unsigned char c) { return c == 1; });
       }
+    else
+      for (std::size_t vertex_n = 0;
+           vertices_inside_domain && vertex_n < vertices.size();
+           ++vertex_n)
+        {
+          hier::Index<spacedim> index;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            index(d) = indices[vertex_n * spacedim + d];
+          vertices_inside_domain = domain.contains(index);
+        }
+
+    // Only a single box has a simple distance to the boundary
+    checked_vertex_margin = 0.0;
+    if (vertices_inside_domain && domain.getNumberOfBoxes() == 1)
+      {
+        double margin = std::numeric_limits<double>::max();
+        for (std::size_t vertex_n = 0; vertex_n < vertices.size(); ++vertex_n)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              const double x = vertex_coordinates[vertex_n * spacedim + d];
+              margin         = std::min(margin,
+                                std::min(x - geom->getXLower()[d],
+                                         geom->getXUpper()[d] - x));
+            }
+        checked_vertex_margin = std::max(margin, 0.0);
+      }
+    checked_vertex_coordinates = std::move(vertex_coordinates);
 
     return vertices_inside_domain;
   }
 
+  template <int dim, int spacedim>
+  std::size_t
+  MeterBase<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t n_bytes =
+      sizeof(*this) + meter_tria.memory_consumption() +
+      meter_quadrature.memory_consumption() +
+      shape_values.memory_consumption() +
+      MemoryConsumption::memory_consumption(JxW_values) +
+      scalar_dof_handler.memory_consumption() +
+      vector_dof_handler.memory_consumption() +
+      identity_position.memory_consumption() +
+      MemoryConsumption::memory_consumption(checked_vertex_coordinates);
+    if (meter_mapping)
+      n_bytes += meter_mapping->memory_consumption();
+    if (scalar_fe)
+      n_bytes += scalar_fe->memory_consumption();
+    if (vector_fe)
+      n_bytes += vector_fe->memory_consumption();
+    // vector_partitioner is already included in identity_position
+    if (scalar_partitioner)
+      n_bytes += scalar_partitioner->memory_consumption();
+    if (nodal_interaction)
+      n_bytes += nodal_interaction->memory_consumption();
+
+    return n_bytes;
+  }
+
   template class MeterBase<NDIM - 1, NDIM>;
   template class MeterBase<NDIM, NDIM>;
 } // namespace fdl
@@ -0,0 +1,426 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+
+#include <fiddle/interaction/nodal_interaction.h>
+
+#include <fiddle/postprocess/meter_collection.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <tbox/InputManager.h>
+
+#include <future>
+
+namespace fdl
+{
+  template <int dim, int spacedim>
+  MeterCollection<dim, spacedim>::MeterCollection(
+    const std::vector<const MeterBase<dim, spacedim> *> &meters,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>>        patch_hierarchy)
+    : meters(meters)
+    , patch_hierarchy(patch_hierarchy)
+    , collection_tria(tbox::SAMRAI_MPI::getCommunicator(),
+                      Triangulation<dim, spacedim>::MeshSmoothing::none,
+                      true)
+    , pending_has_scalar_values(false)
+    , pending_has_vector_values(false)
+  {
+    for (const MeterBase<dim, spacedim> *meter : meters)
+      Assert(meter, ExcMessage("pointers should not be nullptr"));
+    reinit();
+  }
+
+  template <int dim, int spacedim>
+  MeterCollection<dim, spacedim>::~MeterCollection()
+  {
+    // Don't leave a task running which uses this object
+    if (pending_local_values.valid())
+      pending_local_values.wait();
+  }
+
+  template <int dim, int spacedim>
+  void
+  MeterCollection<dim, spacedim>::reinit()
+  {
+    AssertThrow(!has_pending_values(),
+                ExcMessage("The collection cannot be reinitialized while a "
+                           "computation is in progress."));
+    AssertThrow(meters.size() > 0,
+                ExcMessage("At least one meter is required."));
+    const FiniteElement<dim, spacedim> &meter_fe =
+      meters[0]->get_scalar_dof_handler().get_fe();
+    for (const auto &meter : meters)
+      AssertThrow(meter->get_scalar_dof_handler().get_fe().get_name() ==
+                    meter_fe.get_name(),
+                  ExcMessage("All meters must use the same finite element."));
+
+    // Copy the meshes. Cells are created in the order in which they are
+    // provided, so the cells of meter m are in the range
+    // [cell_offsets[m], cell_offsets[m + 1]).
+    std::vector<Point<spacedim>> vertices;
+    std::vector<CellData<dim>>   cells;
+    std::vector<unsigned int>    cell_offsets;
+    for (unsigned int meter_n = 0; meter_n < meters.size(); ++meter_n)
+      {
+        const Triangulation<dim, spacedim> &meter_tria =
+          meters[meter_n]->get_triangulation();
+        AssertThrow(meter_tria.n_levels() == 1, ExcFDLNotImplemented());
+        cell_offsets.push_back(cells.size());
+        const unsigned int vertex_offset = vertices.size();
+        vertices.insert(vertices.end(),
+                        meter_tria.get_vertices().begin(),
+                        meter_tria.get_vertices().end());
+        for (const auto &cell : meter_tria.active_cell_iterators())
+          {
+            CellData<dim> cell_data(cell->n_vertices());
+            for (const unsigned int v : cell->vertex_indices())
+              cell_data.vertices[v] = vertex_offset + cell->vertex_index(v);
+            cell_data.material_id = meter_n;
+            cells.push_back(cell_data);
+          }
+      }
+    SubCellData subcell_data;
+    GridTools::delete_unused_vertices(vertices, cells, subcell_data);
+
+    // Objects using the old triangulation must be cleared first
+    nodal_interaction.reset();
+    scalar_dof_handler.clear();
+    vector_dof_handler.clear();
+    collection_tria.clear();
+    collection_tria.create_triangulation(vertices, cells, subcell_data);
+
+    // Set up FE data like MeterBase::reinit_dofs():
+    scalar_fe = meter_fe.clone();
+    vector_fe = std::make_unique<FESystem<dim, spacedim>>(*scalar_fe, spacedim);
+    collection_mapping = collection_tria.get_reference_cells()[0]
+                           .template get_default_mapping<dim, spacedim>(
+                             scalar_fe->tensor_degree());
+    if (collection_tria.all_reference_cells_are_simplex())
+      collection_quadrature =
+        QWitherdenVincentSimplex<dim>(scalar_fe->tensor_degree() + 1);
+    else
+      collection_quadrature = QGauss<dim>(scalar_fe->tensor_degree() + 1);
+
+    scalar_dof_handler.reinit(collection_tria);
+    scalar_dof_handler.distribute_dofs(*scalar_fe);
+    vector_dof_handler.reinit(collection_tria);
+    vector_dof_handler.distribute_dofs(*vector_fe);
+
+    const MPI_Comm comm = collection_tria.get_communicator();
+    {
+      IndexSet scalar_locally_relevant_dofs;
+      DoFTools::extract_locally_relevant_dofs(scalar_dof_handler,
+                                              scalar_locally_relevant_dofs);
+      scalar_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+        scalar_dof_handler.locally_owned_dofs(),
+        scalar_locally_relevant_dofs,
+        comm);
+
+      IndexSet vector_locally_relevant_dofs;
+      DoFTools::extract_locally_relevant_dofs(vector_dof_handler,
+                                              vector_locally_relevant_dofs);
+      vector_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+        vector_dof_handler.locally_owned_dofs(),
+        vector_locally_relevant_dofs,
+        comm);
+    }
+    identity_position.reinit(vector_partitioner);
+    VectorTools::interpolate(vector_dof_handler,
+                             Functions::IdentityFunction<spacedim>(),
+                             identity_position);
+    identity_position.update_ghost_values();
+
+    // Set up the measures and centroids:
+    {
+      FEValues<dim, spacedim> fe_values(*collection_mapping,
+                                        *scalar_fe,
+                                        collection_quadrature,
+                                        update_JxW_values);
+      std::vector<double>     local_measures(meters.size());
+      for (const auto &cell : collection_tria.active_cell_iterators() |
+                                IteratorFilters::LocallyOwnedCell())
+        {
+          fe_values.reinit(cell);
+          for (unsigned int q = 0; q < collection_quadrature.size(); ++q)
+            local_measures[cell->material_id()] += fe_values.JxW(q);
+        }
+      measures = Utilities::MPI::sum(local_measures, comm);
+    }
+    centroid_cells.clear();
+    ref_centroids.clear();
+    for (unsigned int meter_n = 0; meter_n < meters.size(); ++meter_n)
+      {
+        const auto centroid_pair = meters[meter_n]->get_centroid_cell();
+        centroid_cells.emplace_back(&collection_tria,
+                                    0,
+                                    cell_offsets[meter_n] +
+                                      centroid_pair.first->index(),
+                                    nullptr);
+        Assert(centroid_cells.back()->material_id() == meter_n,
+               ExcFDLInternalError());
+        ref_centroids.push_back(centroid_pair.second);
+      }
+
+    // Set up the interaction like MeterBase::reinit_interaction():
+    const auto local_bboxes =
+      compute_cell_bboxes<dim, spacedim, float>(vector_dof_handler,
+                                                *collection_mapping);
+    const auto all_bboxes =
+      collect_all_active_cell_bboxes(collection_tria, local_bboxes);
+    tbox::Pointer<tbox::Database> db =
+      new tbox::InputDatabase("meter_collection_db");
+    db->putDouble("ghost_cell_fraction", 1e-6);
+    nodal_interaction = std::make_unique<NodalInteraction<dim, spacedim>>(
+      db,
+      collection_tria,
+      all_bboxes,
+      patch_hierarchy,
+      std::make_pair(0, patch_hierarchy->getFinestLevelNumber()),
+      vector_dof_handler,
+      identity_position);
+    nodal_interaction->add_dof_handler(scalar_dof_handler);
+  }
+
+  template <int dim, int spacedim>
+  typename MeterCollection<dim, spacedim>::Values
+  MeterCollection<dim, spacedim>::compute_values(
+    const int          scalar_data_idx,
+    const int          vector_data_idx,
+    const std::string &kernel_name) const
+  {
+    AssertThrow(!has_pending_values(),
+                ExcMessage("compute_values() may not be called while an "
+                           "asynchronous computation is in progress."));
+    AssertThrow(vector_data_idx == -1 || dim == spacedim - 1,
+                ExcMessage("Fluxes can only be computed for codimension "
+                           "one meters."));
+    LinearAlgebra::distributed::Vector<double> scalar_data;
+    LinearAlgebra::distributed::Vector<double> vector_data;
+    if (vector_data_idx != -1)
+      vector_data =
+        interpolate(vector_data_idx, kernel_name, vector_dof_handler);
+    if (scalar_data_idx != -1)
+      scalar_data =
+        interpolate(scalar_data_idx, kernel_name, scalar_dof_handler);
+
+    const std::vector<double> values =
+      Utilities::MPI::sum(compute_local_values(scalar_data, vector_data),
+                          collection_tria.get_communicator());
+    return make_values(values, scalar_data_idx != -1, vector_data_idx != -1);
+  }
+
+  template <int dim, int spacedim>
+  void
+  MeterCollection<dim, spacedim>::compute_values_start(
+    const int          scalar_data_idx,
+    const int          vector_data_idx,
+    const std::string &kernel_name) const
+  {
+    AssertThrow(!has_pending_values(),
+                ExcMessage("Only one computation may be in progress at a "
+                           "time."));
+    AssertThrow(vector_data_idx == -1 || dim == spacedim - 1,
+                ExcMessage("Fluxes can only be computed for codimension "
+                           "one meters."));
+    pending_scalar_data.reinit(0);
+    pending_vector_data.reinit(0);
+    if (vector_data_idx != -1)
+      pending_vector_data =
+        interpolate(vector_data_idx, kernel_name, vector_dof_handler);
+    if (scalar_data_idx != -1)
+      pending_scalar_data =
+        interpolate(scalar_data_idx, kernel_name, scalar_dof_handler);
+    pending_has_scalar_values = scalar_data_idx != -1;
+    pending_has_vector_values = vector_data_idx != -1;
+
+    // The task only reads data which is not modified until
+    // compute_values_finish() is called
+    pending_local_values = std::async(std::launch::async,
+                                      [this]()
+                                      {
+                                        return compute_local_values(
+                                          pending_scalar_data,
+                                          pending_vector_data);
+                                      });
+  }
+
+  template <int dim, int spacedim>
+  typename MeterCollection<dim, spacedim>::Values
+  MeterCollection<dim, spacedim>::compute_values_finish() const
+  {
+    AssertThrow(has_pending_values(),
+                ExcMessage("compute_values_start() must be called before "
+                           "compute_values_finish()."));
+    const std::vector<double> values =
+      Utilities::MPI::sum(pending_local_values.get(),
+                          collection_tria.get_communicator());
+    pending_scalar_data.reinit(0);
+    pending_vector_data.reinit(0);
+    return make_values(values,
+                       pending_has_scalar_values,
+                       pending_has_vector_values);
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  MeterCollection<dim, spacedim>::compute_local_values(
+    const LinearAlgebra::distributed::Vector<double> &scalar_data,
+    const LinearAlgebra::distributed::Vector<double> &vector_data) const
+  {
+    const std::size_t n_meters = meters.size();
+    // Local contributions to the fluxes, integrals, and centroid values, in
+    // that order
+    std::vector<double> local_values(3 * n_meters);
+
+    if (vector_data.size() > 0)
+      {
+        FEValues<dim, spacedim> fe_values(*collection_mapping,
+                                          *vector_fe,
+                                          collection_quadrature,
+                                          update_normal_vectors |
+                                            update_values | update_JxW_values);
+        std::vector<Tensor<1, spacedim>> cell_values(
+          collection_quadrature.size());
+        for (const auto &cell : vector_dof_handler.active_cell_iterators() |
+                                  IteratorFilters::LocallyOwnedCell())
+          {
+            fe_values.reinit(cell);
+            fe_values[FEValuesExtractors::Vector(0)].get_function_values(
+              vector_data, cell_values);
+            double &flux = local_values[cell->material_id()];
+            for (unsigned int q = 0; q < collection_quadrature.size(); ++q)
+              flux +=
+                cell_values[q] * fe_values.normal_vector(q) * fe_values.JxW(q);
+          }
+      }
+
+    if (scalar_data.size() > 0)
+      {
+        FEValues<dim, spacedim> fe_values(*collection_mapping,
+                                          *scalar_fe,
+                                          collection_quadrature,
+                                          update_values | update_JxW_values);
+        std::vector<double>     cell_values(collection_quadrature.size());
+        for (const auto &cell : scalar_dof_handler.active_cell_iterators() |
+                                  IteratorFilters::LocallyOwnedCell())
+          {
+            fe_values.reinit(cell);
+            fe_values.get_function_values(scalar_data, cell_values);
+            double &integral = local_values[n_meters + cell->material_id()];
+            for (unsigned int q = 0; q < collection_quadrature.size(); ++q)
+              integral += cell_values[q] * fe_values.JxW(q);
+          }
+
+        // Exactly one processor owns each centroid cell so the sum is the
+        // value
+        std::vector<types::global_dof_index> cell_dofs(
+          scalar_fe->dofs_per_cell);
+        for (std::size_t meter_n = 0; meter_n < n_meters; ++meter_n)
+          if (centroid_cells[meter_n]->is_locally_owned())
+            {
+              const auto cell =
+                typename DoFHandler<dim, spacedim>::active_cell_iterator(
+                  &collection_tria,
+                  centroid_cells[meter_n]->level(),
+                  centroid_cells[meter_n]->index(),
+                  &scalar_dof_handler);
+              cell->get_dof_indices(cell_dofs);
+              double &value = local_values[2 * n_meters + meter_n];
+              for (unsigned int i = 0; i < scalar_fe->dofs_per_cell; ++i)
+                value += scalar_fe->shape_value(i, ref_centroids[meter_n]) *
+                         scalar_data[cell_dofs[i]];
+            }
+      }
+
+    return local_values;
+  }
+
+  template <int dim, int spacedim>
+  typename MeterCollection<dim, spacedim>::Values
+  MeterCollection<dim, spacedim>::make_values(
+    const std::vector<double> &values,
+    const bool                 has_scalar_values,
+    const bool                 has_vector_values) const
+  {
+    const std::size_t n_meters = meters.size();
+    Values            result;
+    if (has_vector_values)
+      result.fluxes.assign(values.begin(), values.begin() + n_meters);
+    if (has_scalar_values)
+      {
+        result.mean_values.resize(n_meters);
+        for (std::size_t meter_n = 0; meter_n < n_meters; ++meter_n)
+          result.mean_values[meter_n] =
+            values[n_meters + meter_n] / measures[meter_n];
+        result.centroid_values.assign(values.begin() + 2 * n_meters,
+                                      values.end());
+      }
+
+    return result;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  MeterCollection<dim, spacedim>::compute_fluxes(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    return compute_values(-1, data_idx, kernel_name).fluxes;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  MeterCollection<dim, spacedim>::compute_mean_values(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    return compute_values(data_idx, -1, kernel_name).mean_values;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  MeterCollection<dim, spacedim>::compute_centroid_values(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    return compute_values(data_idx, -1, kernel_name).centroid_values;
+  }
+
+  template <int dim, int spacedim>
+  LinearAlgebra::distributed::Vector<double>
+  MeterCollection<dim, spacedim>::interpolate(
+    const int                        data_idx,
+    const std::string               &kernel_name,
+    const DoFHandler<dim, spacedim> &dof_handler) const
+  {
+    LinearAlgebra::distributed::Vector<double> interpolated_data(
+      &dof_handler == &scalar_dof_handler ? scalar_partitioner :
+                                            vector_partitioner);
+    nodal_interaction->interpolate(kernel_name,
+                                   data_idx,
+                                   vector_dof_handler,
+                                   identity_position,
+                                   dof_handler,
+                                   *collection_mapping,
+                                   interpolated_data);
+    interpolated_data.update_ghost_values();
+
+    return interpolated_data;
+  }
+
+  template class MeterCollection<NDIM - 1, NDIM>;
+  template class MeterCollection<NDIM, NDIM>;
+} // namespace fdl
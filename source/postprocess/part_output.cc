@@ -0,0 +1,151 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/postprocess/part_output.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/mapping_fe_field.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <fstream>
+#include <memory>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim, int spacedim>
+  PartOutput<dim, spacedim>::PartOutput(
+    const std::string                  &directory,
+    const std::string                  &name,
+    const unsigned int                  n_subdivisions,
+    const DataOutBase::CompressionLevel compression_level)
+    : directory(directory)
+    , name(name)
+    , n_subdivisions(n_subdivisions)
+    , compression_level(compression_level)
+  {}
+
+  template <int dim, int spacedim>
+  PartOutput<dim, spacedim>::~PartOutput()
+  {
+    // Don't throw from a destructor
+    if (pending_write.valid())
+      pending_write.wait();
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartOutput<dim, spacedim>::wait()
+  {
+    if (pending_write.valid())
+      pending_write.get();
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartOutput<dim, spacedim>::write(
+    const Part<dim, spacedim> &part,
+    const unsigned int         output_n,
+    const double               time,
+    const std::vector<std::pair<std::string, const VectorType *>>
+      &additional_vectors)
+  {
+    // Copy everything which may change before the background task finishes.
+    // DataOut needs ghost values, so this is the only part which communicates.
+    struct Snapshot
+    {
+      VectorType                                      position;
+      VectorType                                      velocity;
+      std::vector<std::pair<std::string, VectorType>> additional_vectors;
+    };
+    auto snapshot = std::make_shared<Snapshot>();
+    auto copy     = [&](const VectorType &input, VectorType &output)
+    {
+      Assert(part.get_partitioner()->is_compatible(*input.get_partitioner()),
+             ExcMessage("The vectors should use the partitioner of the "
+                        "part."));
+      output.reinit(part.get_partitioner());
+      output.copy_locally_owned_data_from(input);
+      output.update_ghost_values();
+    };
+    copy(part.get_position(), snapshot->position);
+    copy(part.get_velocity(), snapshot->velocity);
+    for (const auto &pair : additional_vectors)
+      {
+        Assert(pair.second, ExcMessage("The vectors should not be nullptr."));
+        snapshot->additional_vectors.emplace_back(pair.first, VectorType());
+        copy(*pair.second, snapshot->additional_vectors.back().second);
+      }
+
+    const MPI_Comm     communicator = part.get_communicator();
+    const unsigned int rank    = Utilities::MPI::this_mpi_process(communicator);
+    const unsigned int n_procs = Utilities::MPI::n_mpi_processes(communicator);
+    const std::string  prefix =
+      name + "_" + Utilities::int_to_string(output_n, 5);
+    const auto piece_name = [prefix](const unsigned int r)
+    { return prefix + "." + Utilities::int_to_string(r, 4) + ".vtu"; };
+    if (rank == 0)
+      pvd_records.emplace_back(time, prefix + ".pvtu");
+
+    const unsigned int n_cell_subdivisions =
+      n_subdivisions == 0 ? part.get_dof_handler().get_fe().tensor_degree() :
+                            n_subdivisions;
+    DataOutBase::VtkFlags flags;
+    flags.time              = time;
+    flags.cycle             = output_n;
+    flags.compression_level = compression_level;
+
+    // Back-pressure: only start the next write once the previous one is done
+    wait();
+    pending_write = std::async(
+      std::launch::async,
+      [this,
+       &dof_handler = part.get_dof_handler(),
+       snapshot,
+       flags,
+       n_cell_subdivisions,
+       rank,
+       n_procs,
+       prefix,
+       piece_name,
+       pvd_records = pvd_records]()
+      {
+        DataOut<dim, spacedim> data_out;
+        data_out.attach_dof_handler(dof_handler);
+        data_out.add_data_vector(snapshot->velocity, "U");
+        for (const auto &pair : snapshot->additional_vectors)
+          data_out.add_data_vector(pair.second, pair.first);
+
+        const MappingFEField<dim, spacedim, VectorType> position_mapping(
+          dof_handler, snapshot->position);
+        data_out.build_patches(position_mapping,
+                               n_cell_subdivisions,
+                               DataOut<dim, spacedim>::curved_inner_cells);
+        data_out.set_flags(flags);
+
+        const std::string filename = directory + "/" + piece_name(rank);
+        std::ofstream     out(filename);
+        AssertThrow(out, ExcMessage("Unable to open " + filename));
+        data_out.write_vtu(out);
+
+        // The name of each piece only depends on the rank, so the records do
+        // not require any communication
+        if (rank == 0)
+          {
+            std::vector<std::string> piece_names;
+            for (unsigned int r = 0; r < n_procs; ++r)
+              piece_names.push_back(piece_name(r));
+            std::ofstream pvtu_out(directory + "/" + prefix + ".pvtu");
+            data_out.write_pvtu_record(pvtu_out, piece_names);
+            std::ofstream pvd_out(directory + "/" + name + ".pvd");
+            DataOutBase::write_pvd_record(pvd_out, pvd_records);
+          }
+      });
+  }
+
+  template class PartOutput<NDIM - 1, NDIM>;
+  template class PartOutput<NDIM, NDIM>;
+} // namespace fdl
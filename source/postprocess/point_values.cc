@@ -41,19 +41,58 @@ namespace fdl
     , remote_point_evaluation(1e-12, true)
   {}
 
+  template <int n_components, int dim, int spacedim>
+  void
+  PointValues<n_components, dim, spacedim>::reinit()
+  {
+    remote_point_evaluation.reinit(evaluation_points,
+                                   dof_handler->get_triangulation(),
+                                   *mapping);
+  }
+
+  template <int n_components, int dim, int spacedim>
+  void
+  PointValues<n_components, dim, spacedim>::reinit(
+    const std::vector<Point<spacedim>> &evaluation_points)
+  {
+    this->evaluation_points = evaluation_points;
+    reinit();
+  }
+
   template <int n_components, int dim, int spacedim>
   std::vector<Tensor<1, n_components>>
   PointValues<n_components, dim, spacedim>::evaluate(
     const LinearAlgebra::distributed::Vector<double> &vector) const
   {
-    auto result =
-      VectorTools::point_values<n_components>(*mapping,
-                                              *dof_handler,
-                                              vector,
-                                              evaluation_points,
-                                              remote_point_evaluation);
+    return std::move(evaluate({&vector})[0]);
+  }
+
+  template <int n_components, int dim, int spacedim>
+  std::vector<std::vector<Tensor<1, n_components>>>
+  PointValues<n_components, dim, spacedim>::evaluate(
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &vectors) const
+  {
+    // RemotePointEvaluation marks itself as not ready when the Triangulation
+    // changes, so this is consistent across processors
+    if (!remote_point_evaluation.is_ready())
+      remote_point_evaluation.reinit(evaluation_points,
+                                     dof_handler->get_triangulation(),
+                                     *mapping);
+
+    std::vector<std::vector<Tensor<1, n_components>>> results;
+    for (const auto *vector : vectors)
+      {
+        Assert(vector, ExcMessage("The vectors should not be nullptr."));
+        // Use the overload which does not redo the point search
+        auto result =
+          VectorTools::point_values<n_components>(remote_point_evaluation,
+                                                  *dof_handler,
+                                                  *vector);
+        results.emplace_back(convert(result));
+      }
 
-    return convert(result);
+    return results;
   }
 
 
@@ -13,12 +13,19 @@
 #include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_tools.h>
 
+#include <deal.II/lac/vector.h>
+
 #include <CartesianPatchGeometry.h>
 #include <PatchHierarchy.h>
 #include <PatchLevel.h>
 
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
 #include <cmath>
 #include <limits>
+#include <map>
+#include <utility>
 
 namespace fdl
 {
@@ -94,6 +101,31 @@ namespace fdl
       }
 #endif
 
+      template <int dim, int spacedim>
+      double
+      compute_min_cell_quality(const Triangulation<dim, spacedim> &tria)
+      {
+        double min_quality = 1.0;
+        if (dim == 2)
+          for (const auto &cell : tria.active_cell_iterators())
+            {
+              AssertThrow(cell->reference_cell() == ReferenceCells::Triangle,
+                          ExcFDLNotImplemented());
+              const Tensor<1, spacedim> e0 = cell->vertex(1) - cell->vertex(0);
+              const Tensor<1, spacedim> e1 = cell->vertex(2) - cell->vertex(0);
+              const Tensor<1, spacedim> e2 = cell->vertex(2) - cell->vertex(1);
+              const double              area =
+                0.5 * std::sqrt(std::max(e0.norm_square() * e1.norm_square() -
+                                           (e0 * e1) * (e0 * e1),
+                                         0.0));
+              const double sum_squares =
+                e0.norm_square() + e1.norm_square() + e2.norm_square();
+              min_quality = std::min(min_quality,
+                                     4.0 * std::sqrt(3.0) * area / sum_squares);
+            }
+        return min_quality;
+      }
+
       template <int spacedim>
       double
       compute_min_cell_width(
@@ -136,6 +168,12 @@ namespace fdl
         mapping,
         position_dof_handler,
         boundary_points))
+    , flux_request(MPI_REQUEST_NULL)
+    , local_flux(0.0)
+    , global_flux(0.0)
+    , use_incremental_reinit(false)
+    , min_cell_quality(0.0)
+    , n_boundary_points(0)
   {
     // TODO: assert congruity between position_dof_handler.get_communicator()
     // and SAMRAI_MPI::getCommunicator()
@@ -147,6 +185,12 @@ namespace fdl
     const Triangulation<dim - 1, spacedim>       &tria,
     tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy)
     : MeterBase<dim - 1, spacedim>(tria, patch_hierarchy)
+    , flux_request(MPI_REQUEST_NULL)
+    , local_flux(0.0)
+    , global_flux(0.0)
+    , use_incremental_reinit(false)
+    , min_cell_quality(0.0)
+    , n_boundary_points(0)
   {
     internal_reinit(false, {}, {}, false);
   }
@@ -157,13 +201,23 @@ namespace fdl
     const std::vector<Tensor<1, spacedim>>       &velocity,
     tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy)
     : MeterBase<dim - 1, spacedim>(patch_hierarchy)
+    , flux_request(MPI_REQUEST_NULL)
+    , local_flux(0.0)
+    , global_flux(0.0)
+    , use_incremental_reinit(false)
+    , min_cell_quality(0.0)
+    , n_boundary_points(0)
   {
     reinit(boundary_points, velocity);
   }
 
   template <int dim, int spacedim>
   SurfaceMeter<dim, spacedim>::~SurfaceMeter()
-  {}
+  {
+    // Don't leave a dangling request
+    if (flux_request != MPI_REQUEST_NULL)
+      MPI_Wait(&flux_request, MPI_STATUS_IGNORE);
+  }
 
   template <int dim, int spacedim>
   bool
@@ -172,6 +226,20 @@ namespace fdl
     return position_dof_handler != nullptr;
   }
 
+  template <int dim, int spacedim>
+  void
+  SurfaceMeter<dim, spacedim>::set_incremental_reinit(
+    const bool   use_incremental_reinit,
+    const double min_cell_quality)
+  {
+    AssertThrow(0.0 <= min_cell_quality && min_cell_quality <= 1.0,
+                ExcMessage("The minimum cell quality should be in [0, 1]."));
+    this->use_incremental_reinit = use_incremental_reinit;
+    this->min_cell_quality       = min_cell_quality;
+    if (!use_incremental_reinit)
+      serial_meter_tria.clear();
+  }
+
   template <int dim, int spacedim>
   void
   SurfaceMeter<dim, spacedim>::reinit(
@@ -183,16 +251,134 @@ namespace fdl
                       "set up without an underlying codimension zero "
                       "Triangulation."));
     // Reset the meter mesh according to the new position values:
-    const std::vector<Tensor<1, spacedim>> position_values =
-      point_values->evaluate(position);
-    const std::vector<Point<spacedim>> boundary_points(position_values.begin(),
-                                                       position_values.end());
-    const std::vector<Tensor<1, spacedim>> velocity_values =
-      point_values->evaluate(velocity);
+    const auto values = point_values->evaluate({&position, &velocity});
+    const std::vector<Point<spacedim>> boundary_points(values[0].begin(),
+                                                       values[0].end());
+    const std::vector<Tensor<1, spacedim>> &velocity_values = values[1];
 
     internal_reinit(true, boundary_points, velocity_values, false);
   }
 
+  template <int dim, int spacedim>
+  void
+  SurfaceMeter<dim, spacedim>::reinit(
+    const std::vector<SurfaceMeter<dim, spacedim> *> &meters,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &positions,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &velocities)
+  {
+    AssertDimension(meters.size(), positions.size());
+    AssertDimension(meters.size(), velocities.size());
+    const MPI_Comm     comm    = tbox::SAMRAI_MPI::getCommunicator();
+    const unsigned int rank    = Utilities::MPI::this_mpi_process(comm);
+    const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+    // Compute the new boundary points and, if possible, move the meshes.
+    // Everything here is done in the same order on every processor.
+    std::vector<std::vector<Point<spacedim>>>     all_boundary_points;
+    std::vector<std::vector<Tensor<1, spacedim>>> all_velocity_values;
+    std::vector<std::size_t>                      remeshed_meters;
+    std::map<std::size_t, Triangulation<dim - 1, spacedim>> local_trias;
+    // Each new mesh is sent as its vertex coordinates and the vertices of
+    // its cells, along with the index of the meter
+    using MeshData = std::pair<std::vector<double>, std::vector<unsigned int>>;
+    std::vector<std::pair<std::size_t, MeshData>> local_meshes;
+    for (std::size_t i = 0; i < meters.size(); ++i)
+      {
+        SurfaceMeter<dim, spacedim> &meter = *meters[i];
+        Assert(positions[i] && velocities[i],
+               ExcMessage("The vectors should not be nullptr."));
+        AssertThrow(meter.uses_codim_zero_mesh(),
+                    ExcMessage("All meters must be set up with finite "
+                               "element data."));
+        const auto values =
+          meter.point_values->evaluate({positions[i], velocities[i]});
+        all_boundary_points.emplace_back(values[0].begin(), values[0].end());
+        all_velocity_values.push_back(values[1]);
+        if (meter.move_tria(all_boundary_points.back(), false))
+          continue;
+
+        // Even processors which do not create the mesh need to participate
+        // in computing the cell width
+        const double dx =
+          internal::compute_min_cell_width(meter.patch_hierarchy);
+        if (remeshed_meters.size() % n_procs == rank)
+          {
+            Triangulation<dim - 1, spacedim> &serial_tria = local_trias[i];
+            meter.create_serial_tria(all_boundary_points.back(),
+                                     false,
+                                     dx,
+                                     serial_tria);
+
+            local_meshes.emplace_back(i, MeshData());
+            MeshData &mesh = local_meshes.back().second;
+            for (const Point<spacedim> &vertex : serial_tria.get_vertices())
+              for (unsigned int d = 0; d < spacedim; ++d)
+                mesh.first.push_back(vertex[d]);
+            for (const auto &cell : serial_tria.active_cell_iterators())
+              {
+                mesh.second.push_back(cell->n_vertices());
+                for (const unsigned int v : cell->vertex_indices())
+                  mesh.second.push_back(cell->vertex_index(v));
+              }
+          }
+        remeshed_meters.push_back(i);
+      }
+
+    if (remeshed_meters.size() > 0)
+      {
+        const auto all_meshes = Utilities::MPI::all_gather(comm, local_meshes);
+        for (const auto &meshes : all_meshes)
+          for (const auto &mesh : meshes)
+            {
+              const std::size_t i = mesh.first;
+              if (local_trias.find(i) == local_trias.end())
+                {
+                  const std::vector<double>       &coordinates =
+                    mesh.second.first;
+                  const std::vector<unsigned int> &cell_vertices =
+                    mesh.second.second;
+                  std::vector<Point<spacedim>> vertices(coordinates.size() /
+                                                        spacedim);
+                  for (std::size_t vertex_n = 0; vertex_n < vertices.size();
+                       ++vertex_n)
+                    for (unsigned int d = 0; d < spacedim; ++d)
+                      vertices[vertex_n][d] =
+                        coordinates[vertex_n * spacedim + d];
+
+                  std::vector<CellData<dim - 1>> cells;
+                  std::size_t                    offset = 0;
+                  while (offset < cell_vertices.size())
+                    {
+                      const unsigned int n_vertices = cell_vertices[offset++];
+                      cells.emplace_back(n_vertices);
+                      for (unsigned int v = 0; v < n_vertices; ++v)
+                        cells.back().vertices[v] = cell_vertices[offset++];
+                    }
+                  local_trias[i].create_triangulation(vertices,
+                                                      cells,
+                                                      SubCellData());
+                }
+            }
+
+        for (const std::size_t i : remeshed_meters)
+          {
+            Assert(local_trias.find(i) != local_trias.end(),
+                   ExcFDLInternalError());
+            meters[i]->set_tria(local_trias[i],
+                                all_boundary_points[i].size(),
+                                false);
+          }
+      }
+
+    for (std::size_t i = 0; i < meters.size(); ++i)
+      meters[i]->internal_reinit(false,
+                                 all_boundary_points[i],
+                                 all_velocity_values[i],
+                                 false);
+  }
+
   template <int dim, int spacedim>
   void
   SurfaceMeter<dim, spacedim>::reinit(
@@ -226,16 +412,71 @@ namespace fdl
     const bool                          place_additional_boundary_vertices)
   {
     const double dx = internal::compute_min_cell_width(this->patch_hierarchy);
-    const double target_element_area = std::pow(dx, dim - 1);
+    Triangulation<dim - 1, spacedim> serial_tria;
+    create_serial_tria(boundary_points,
+                       place_additional_boundary_vertices,
+                       dx,
+                       serial_tria);
+    set_tria(serial_tria,
+             boundary_points.size(),
+             place_additional_boundary_vertices);
+  }
 
-    this->meter_tria.clear();
+  template <int dim, int spacedim>
+  void
+  SurfaceMeter<dim, spacedim>::create_serial_tria(
+    const std::vector<Point<spacedim>> &boundary_points,
+    const bool                          place_additional_boundary_vertices,
+    const double                        dx,
+    Triangulation<dim - 1, spacedim>   &serial_tria) const
+  {
     Triangle::AdditionalData additional_data;
-    additional_data.target_element_area = target_element_area;
+    additional_data.target_element_area = std::pow(dx, dim - 1);
     additional_data.place_additional_boundary_vertices =
       place_additional_boundary_vertices;
-    internal::setup_meter_tria(boundary_points,
-                               this->meter_tria,
-                               additional_data);
+    serial_tria.clear();
+    internal::setup_meter_tria(boundary_points, serial_tria, additional_data);
+  }
+
+  template <int dim, int spacedim>
+  void
+  SurfaceMeter<dim, spacedim>::set_tria(
+    const Triangulation<dim - 1, spacedim> &serial_tria,
+    const std::size_t                       n_boundary_points,
+    const bool                              place_additional_boundary_vertices)
+  {
+    this->meter_tria.clear();
+    this->meter_tria.copy_triangulation(serial_tria);
+
+    this->n_boundary_points = n_boundary_points;
+    serial_meter_tria.clear();
+    if (use_incremental_reinit && spacedim == 3 &&
+        !place_additional_boundary_vertices)
+      serial_meter_tria.copy_triangulation(serial_tria);
+  }
+
+  template <int dim, int spacedim>
+  bool
+  SurfaceMeter<dim, spacedim>::move_tria(
+    const std::vector<Point<spacedim>> &boundary_points,
+    const bool                          place_additional_boundary_vertices)
+  {
+    // Every processor has the same serial Triangulation and the same points,
+    // so these checks are consistent across the communicator
+    if (!use_incremental_reinit || spacedim != 3 ||
+        place_additional_boundary_vertices ||
+        serial_meter_tria.n_active_cells() == 0 ||
+        boundary_points.size() != n_boundary_points)
+      return false;
+
+    fit_boundary_vertices(boundary_points, serial_meter_tria);
+    if (internal::compute_min_cell_quality(serial_meter_tria) <
+        min_cell_quality)
+      return false;
+
+    this->meter_tria.clear();
+    this->meter_tria.copy_triangulation(serial_meter_tria);
+    return true;
   }
 
   template <int dim, int spacedim>
@@ -246,9 +487,14 @@ namespace fdl
     const std::vector<Tensor<1, spacedim>> &velocity_values,
     const bool                              place_additional_boundary_vertices)
   {
-    if (reinit_tria)
+    if (reinit_tria &&
+        !move_tria(boundary_points, place_additional_boundary_vertices))
       this->reinit_tria(boundary_points, place_additional_boundary_vertices);
+    AssertThrow(flux_request == MPI_REQUEST_NULL,
+                ExcMessage("The meter cannot be reinitialized while a flux "
+                           "computation is in progress."));
     MeterBase<dim - 1, spacedim>::internal_reinit();
+    reinit_normal_data();
     reinit_mean_velocity(velocity_values);
   }
 
@@ -319,72 +565,113 @@ namespace fdl
   }
 
   template <int dim, int spacedim>
-  std::pair<double, Tensor<1, spacedim>>
-  SurfaceMeter<dim, spacedim>::compute_flux(
-    const int          data_idx,
-    const std::string &kernel_name) const
+  void
+  SurfaceMeter<dim, spacedim>::reinit_normal_data()
   {
-    const auto interpolated_data =
-      this->interpolate_vector_field(data_idx, kernel_name);
-
-    const auto                 &fe = this->get_vector_dof_handler().get_fe();
+    const unsigned int n_q_points = this->meter_quadrature.size();
+    const auto        &fe         = this->get_vector_dof_handler().get_fe();
     FEValues<dim - 1, spacedim> fe_values(this->get_mapping(),
                                           fe,
                                           this->meter_quadrature,
                                           update_normal_vectors |
-                                            update_values | update_JxW_values);
+                                            update_JxW_values);
 
-    std::vector<types::global_dof_index> cell_dofs(fe.dofs_per_cell);
-    std::vector<Tensor<1, spacedim>> cell_values(this->meter_quadrature.size());
-    double                           flux = 0.0;
-    Tensor<1, spacedim>              mean_normal;
+    normal_JxW_values.clear();
+    mean_normal = 0.0;
     for (const auto &cell :
          this->get_vector_dof_handler().active_cell_iterators() |
            IteratorFilters::LocallyOwnedCell())
       {
-        cell->get_dof_indices(cell_dofs);
         fe_values.reinit(cell);
-        fe_values[FEValuesExtractors::Vector(0)].get_function_values(
-          interpolated_data, cell_values);
-        for (unsigned int q = 0; q < this->meter_quadrature.size(); ++q)
+        for (unsigned int q = 0; q < n_q_points; ++q)
           {
-            flux +=
-              cell_values[q] * fe_values.normal_vector(q) * fe_values.JxW(q);
-            mean_normal += fe_values.normal_vector(q) * fe_values.JxW(q);
+            normal_JxW_values.push_back(fe_values.normal_vector(q) *
+                                        fe_values.JxW(q));
+            mean_normal += normal_JxW_values.back();
           }
       }
+    Assert(normal_JxW_values.size() == this->JxW_values.size(),
+           ExcFDLInternalError());
 
-    flux = Utilities::MPI::sum(flux, this->meter_tria.get_communicator());
     mean_normal =
       Utilities::MPI::sum(mean_normal, this->meter_tria.get_communicator());
     mean_normal /= mean_normal.norm();
-    return std::make_pair(flux, mean_normal);
   }
 
   template <int dim, int spacedim>
-  Tensor<1, spacedim>
-  SurfaceMeter<dim, spacedim>::compute_mean_normal_vector() const
+  std::pair<double, Tensor<1, spacedim>>
+  SurfaceMeter<dim, spacedim>::compute_flux(
+    const int          data_idx,
+    const std::string &kernel_name) const
   {
-    const auto                 &fe = this->get_vector_dof_handler().get_fe();
-    FEValues<dim - 1, spacedim> fe_values(this->get_mapping(),
-                                          fe,
-                                          this->meter_quadrature,
-                                          update_normal_vectors |
-                                            update_values | update_JxW_values);
+    compute_flux_start(data_idx, kernel_name);
+    return compute_flux_finish();
+  }
 
-    Tensor<1, spacedim> mean_normal;
+  template <int dim, int spacedim>
+  void
+  SurfaceMeter<dim, spacedim>::compute_flux_start(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    AssertThrow(flux_request == MPI_REQUEST_NULL,
+                ExcMessage("Only one flux computation may be in progress at "
+                           "a time."));
+    const auto interpolated_data =
+      this->interpolate_vector_field(data_idx, kernel_name);
+
+    const unsigned int n_q_points = this->meter_quadrature.size();
+    const auto        &fe         = this->get_vector_dof_handler().get_fe();
+    Vector<double>     cell_dof_values(fe.dofs_per_cell);
+    std::size_t        offset = 0;
+    local_flux                = 0.0;
     for (const auto &cell :
          this->get_vector_dof_handler().active_cell_iterators() |
            IteratorFilters::LocallyOwnedCell())
       {
-        fe_values.reinit(cell);
-        for (unsigned int q = 0; q < this->meter_quadrature.size(); ++q)
-          mean_normal += fe_values.normal_vector(q) * fe_values.JxW(q);
+        cell->get_dof_values(interpolated_data, cell_dof_values);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            Tensor<1, spacedim> cell_value;
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+              {
+                const auto component = fe.system_to_component_index(i);
+                cell_value[component.first] +=
+                  this->shape_values(q, component.second) *
+                  cell_dof_values[i];
+              }
+            local_flux += cell_value * normal_JxW_values[offset + q];
+          }
+        offset += n_q_points;
       }
+    Assert(offset == normal_JxW_values.size(), ExcFDLInternalError());
+
+    const int ierr = MPI_Iallreduce(&local_flux,
+                                    &global_flux,
+                                    1,
+                                    MPI_DOUBLE,
+                                    MPI_SUM,
+                                    this->meter_tria.get_communicator(),
+                                    &flux_request);
+    AssertThrowMPI(ierr);
+  }
 
-    mean_normal =
-      Utilities::MPI::sum(mean_normal, this->meter_tria.get_communicator());
-    mean_normal /= mean_normal.norm();
+  template <int dim, int spacedim>
+  std::pair<double, Tensor<1, spacedim>>
+  SurfaceMeter<dim, spacedim>::compute_flux_finish() const
+  {
+    AssertThrow(flux_request != MPI_REQUEST_NULL,
+                ExcMessage("compute_flux_start() must be called before "
+                           "compute_flux_finish()."));
+    const int ierr = MPI_Wait(&flux_request, MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+    return std::make_pair(global_flux, mean_normal);
+  }
+
+  template <int dim, int spacedim>
+  Tensor<1, spacedim>
+  SurfaceMeter<dim, spacedim>::compute_mean_normal_vector() const
+  {
     return mean_normal;
   }
 
@@ -1,17 +1,108 @@
 #include <fiddle/base/exceptions.h>
+#include <fiddle/base/hardware_counters.h>
 
 #include <fiddle/transfer/scatter.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi_tags.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <type_traits>
+
 namespace fdl
 {
   using namespace dealii;
 
+  namespace
+  {
+    template <typename T>
+    MPI_Datatype
+    get_mpi_type()
+    {
+      constexpr bool is_float  = std::is_same<T, float>::value;
+      constexpr bool is_double = std::is_same<T, double>::value;
+      static_assert(is_float || is_double, "Must be float or double");
+      return is_float ? MPI_FLOAT : MPI_DOUBLE;
+    }
+
+    // Scatters may be started concurrently (e.g., from the mass solver
+    // threads) so use atomics
+    std::atomic<std::uint64_t> total_n_bytes_sent(0);
+    std::atomic<std::uint64_t> total_n_bytes_received(0);
+
+    void
+    count_bytes(const std::uint64_t n_sent,
+                const std::uint64_t n_received,
+                std::uint64_t      &n_bytes_sent,
+                std::uint64_t      &n_bytes_received)
+    {
+      n_bytes_sent += n_sent;
+      n_bytes_received += n_received;
+      total_n_bytes_sent += n_sent;
+      total_n_bytes_received += n_received;
+    }
+
+    std::atomic<double> total_wait_time(0.0);
+
+    void
+    count_wait_time(const double start_time, double &wait_time)
+    {
+      const double time = MPI_Wtime() - start_time;
+      wait_time += time;
+      // std::atomic<double>::fetch_add() requires C++20
+      double old_total = total_wait_time.load();
+      while (!total_wait_time.compare_exchange_weak(old_total,
+                                                    old_total + time))
+        ;
+    }
+  } // namespace
+
+  std::uint64_t
+  get_total_scatter_bytes_sent()
+  {
+    return total_n_bytes_sent;
+  }
+
+  std::uint64_t
+  get_total_scatter_bytes_received()
+  {
+    return total_n_bytes_received;
+  }
+
+  double
+  get_total_scatter_wait_time()
+  {
+    return total_wait_time;
+  }
+
+  namespace
+  {
+    /**
+     * Append the entry (@p overlap_index, @p other_index) to @p runs, either
+     * by extending the last run or by starting a new one.
+     */
+    template <typename IndexRun>
+    void
+    add_to_runs(std::vector<IndexRun> &runs,
+                const unsigned int     overlap_index,
+                const unsigned int     other_index)
+    {
+      if (runs.size() > 0 &&
+          runs.back().overlap_start + runs.back().length == overlap_index &&
+          runs.back().other_start + runs.back().length == other_index)
+        ++runs.back().length;
+      else
+        runs.push_back({overlap_index, other_index, 1});
+    }
+  } // namespace
+
   IndexSet
   setup_ghost_dofs(const std::vector<types::global_dof_index> &overlap_dofs,
                    const IndexSet                             &local_dofs)
@@ -30,12 +121,19 @@ namespace fdl
   Scatter<T>::Scatter()
     : partitioner(std::make_shared<Utilities::MPI::Partitioner>())
     , n_overlap_dofs(0)
+    , n_bytes_sent(0)
+    , n_bytes_received(0)
+    , wait_time(0.0)
+    , backend(ScatterBackend::PointToPoint)
+    , export_graph_communicator(MPI_COMM_NULL)
+    , import_graph_communicator(MPI_COMM_NULL)
   {}
 
   template <typename T>
   Scatter<T>::Scatter(const std::vector<types::global_dof_index> &overlap_dofs,
                       const IndexSet                             &local_dofs,
-                      const MPI_Comm                             &communicator)
+                      const MPI_Comm                             &communicator,
+                      const ScatterBackend backend)
     : partitioner(std::make_shared<Utilities::MPI::Partitioner>(
         local_dofs,
         setup_ghost_dofs(overlap_dofs, local_dofs),
@@ -43,6 +141,12 @@ namespace fdl
     , n_overlap_dofs(overlap_dofs.size())
     , ghost_buffer(partitioner->n_ghost_indices())
     , import_buffer(partitioner->n_import_indices())
+    , n_bytes_sent(0)
+    , n_bytes_received(0)
+    , wait_time(0.0)
+    , backend(backend)
+    , export_graph_communicator(MPI_COMM_NULL)
+    , import_graph_communicator(MPI_COMM_NULL)
   {
     Assert(local_dofs.is_contiguous() == true,
            ExcMessage("The index set specified in local_dofs is not "
@@ -70,13 +174,246 @@ namespace fdl
     for (unsigned int i = 0; i < overlap_pairs.size(); ++i)
       {
         Assert(overlap_pairs[i].first == i, ExcFDLInternalError());
-        overlap_ghost_indices.push_back(overlap_pairs[i].second);
+        add_to_runs(ghost_runs, overlap_pairs[i].second, i);
       }
 
-    for (std::size_t i = 0; i < overlap_dofs.size(); ++i)
+    for (unsigned int i = 0; i < overlap_dofs.size(); ++i)
       if (partitioner->in_local_range(overlap_dofs[i]))
-        overlap_local_indices.emplace_back(
-          i, partitioner->global_to_local(overlap_dofs[i]));
+        add_to_runs(local_runs,
+                    i,
+                    partitioner->global_to_local(overlap_dofs[i]));
+
+    if (backend == ScatterBackend::NeighborCollective)
+      setup_graph_communicators();
+  }
+
+
+
+  template <typename T>
+  Scatter<T>::~Scatter()
+  {
+    free_persistent_requests();
+    free_graph_communicators();
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::setup_graph_communicators()
+  {
+    std::vector<int> ghost_ranks;
+    int              offset = 0;
+    for (const auto &target : partitioner->ghost_targets())
+      {
+        ghost_ranks.push_back(target.first);
+        ghost_counts.push_back(target.second);
+        ghost_offsets.push_back(offset);
+        offset += target.second;
+      }
+    AssertDimension(offset, ghost_buffer.size());
+
+    std::vector<int> import_ranks;
+    offset = 0;
+    for (const auto &target : partitioner->import_targets())
+      {
+        import_ranks.push_back(target.first);
+        import_counts.push_back(target.second);
+        import_offsets.push_back(offset);
+        offset += target.second;
+      }
+    AssertDimension(offset, import_buffer.size());
+
+    const MPI_Comm comm = partitioner->get_mpi_communicator();
+
+    // Global to overlap scatters receive ghost values from their owners and
+    // send locally owned values to processors which have them as ghosts:
+    int ierr = MPI_Dist_graph_create_adjacent(comm,
+                                              ghost_ranks.size(),
+                                              ghost_ranks.data(),
+                                              MPI_UNWEIGHTED,
+                                              import_ranks.size(),
+                                              import_ranks.data(),
+                                              MPI_UNWEIGHTED,
+                                              MPI_INFO_NULL,
+                                              false,
+                                              &export_graph_communicator);
+    AssertThrowMPI(ierr);
+    // and overlap to global scatters do the reverse:
+    ierr = MPI_Dist_graph_create_adjacent(comm,
+                                          import_ranks.size(),
+                                          import_ranks.data(),
+                                          MPI_UNWEIGHTED,
+                                          ghost_ranks.size(),
+                                          ghost_ranks.data(),
+                                          MPI_UNWEIGHTED,
+                                          MPI_INFO_NULL,
+                                          false,
+                                          &import_graph_communicator);
+    AssertThrowMPI(ierr);
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::free_graph_communicators()
+  {
+    int finalized = 0;
+    int ierr      = MPI_Finalized(&finalized);
+    AssertNothrow(ierr == 0, ExcMessage("MPI_Finalized() failed"));
+    if (finalized)
+      return;
+
+    for (MPI_Comm *comm :
+         {&export_graph_communicator, &import_graph_communicator})
+      if (*comm != MPI_COMM_NULL)
+        {
+          ierr = MPI_Comm_free(comm);
+          (void)ierr;
+          AssertNothrow(ierr == 0,
+                        ExcMessage("Unable to free an MPI communicator"));
+        }
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::free_persistent_requests()
+  {
+    int finalized = 0;
+    int ierr      = MPI_Finalized(&finalized);
+    AssertNothrow(ierr == 0, ExcMessage("MPI_Finalized() failed"));
+    // Nothing can be freed after MPI_Finalize() is called
+    if (finalized)
+      return;
+
+    for (auto *request_map : {&export_requests, &import_requests})
+      {
+        for (auto &pair : *request_map)
+          for (MPI_Request &request : pair.second)
+            if (request != MPI_REQUEST_NULL)
+              {
+                ierr = MPI_Request_free(&request);
+                (void)ierr;
+                AssertNothrow(ierr == 0,
+                              ExcMessage("Unable to free an MPI request"));
+              }
+        request_map->clear();
+      }
+  }
+
+
+
+  template <typename T>
+  std::vector<MPI_Request> &
+  Scatter<T>::get_export_requests(const unsigned int channel)
+  {
+    auto iter = export_requests.find(channel);
+    if (iter != export_requests.end())
+      return iter->second;
+
+    // Same tags as Partitioner, so that mixing persistent and non-persistent
+    // scatters does not change which messages match
+    const int tag =
+      Utilities::MPI::internal::Tags::partitioner_export_start + channel;
+    AssertIndexRange(tag,
+                     Utilities::MPI::internal::Tags::partitioner_export_end);
+    const MPI_Comm     comm     = partitioner->get_mpi_communicator();
+    const MPI_Datatype mpi_type = get_mpi_type<T>();
+
+    std::vector<MPI_Request> &new_requests = export_requests[channel];
+    // Receive ghost values from their owners:
+    std::size_t offset = 0;
+    for (const auto &target : partitioner->ghost_targets())
+      {
+        new_requests.emplace_back();
+        const int ierr = MPI_Recv_init(ghost_buffer.data() + offset,
+                                       target.second,
+                                       mpi_type,
+                                       target.first,
+                                       tag,
+                                       comm,
+                                       &new_requests.back());
+        AssertThrowMPI(ierr);
+        offset += target.second;
+      }
+    AssertDimension(offset, ghost_buffer.size());
+
+    // Send locally owned values to processors which have them as ghosts:
+    offset = 0;
+    for (const auto &target : partitioner->import_targets())
+      {
+        new_requests.emplace_back();
+        const int ierr = MPI_Send_init(import_buffer.data() + offset,
+                                       target.second,
+                                       mpi_type,
+                                       target.first,
+                                       tag,
+                                       comm,
+                                       &new_requests.back());
+        AssertThrowMPI(ierr);
+        offset += target.second;
+      }
+    AssertDimension(offset, import_buffer.size());
+
+    return new_requests;
+  }
+
+
+
+  template <typename T>
+  std::vector<MPI_Request> &
+  Scatter<T>::get_import_requests(const unsigned int channel)
+  {
+    auto iter = import_requests.find(channel);
+    if (iter != import_requests.end())
+      return iter->second;
+
+    const int tag =
+      Utilities::MPI::internal::Tags::partitioner_import_start + channel;
+    AssertIndexRange(tag,
+                     Utilities::MPI::internal::Tags::partitioner_import_end);
+    const MPI_Comm     comm     = partitioner->get_mpi_communicator();
+    const MPI_Datatype mpi_type = get_mpi_type<T>();
+
+    std::vector<MPI_Request> &new_requests = import_requests[channel];
+    // Receive contributions to locally owned values:
+    std::size_t offset = 0;
+    for (const auto &target : partitioner->import_targets())
+      {
+        new_requests.emplace_back();
+        const int ierr = MPI_Recv_init(import_buffer.data() + offset,
+                                       target.second,
+                                       mpi_type,
+                                       target.first,
+                                       tag,
+                                       comm,
+                                       &new_requests.back());
+        AssertThrowMPI(ierr);
+        offset += target.second;
+      }
+    AssertDimension(offset, import_buffer.size());
+
+    // Send ghost contributions to their owners:
+    offset = 0;
+    for (const auto &target : partitioner->ghost_targets())
+      {
+        new_requests.emplace_back();
+        const int ierr = MPI_Send_init(ghost_buffer.data() + offset,
+                                       target.second,
+                                       mpi_type,
+                                       target.first,
+                                       tag,
+                                       comm,
+                                       &new_requests.back());
+        AssertThrowMPI(ierr);
+        offset += target.second;
+      }
+    AssertDimension(offset, ghost_buffer.size());
+
+    return new_requests;
   }
 
 
@@ -119,11 +456,51 @@ namespace fdl
         Assert(false, ExcFDLNotImplemented());
       }
 
-    for (unsigned int i = 0; i < overlap_ghost_indices.size(); ++i)
-      ghost_buffer[i] = input[overlap_ghost_indices[i]];
-
-    for (const auto &pair : overlap_local_indices)
-      output.local_element(pair.second) = input[pair.first];
+    {
+      HardwareCounterRegion region(
+        "fdl::Scatter::overlap_to_global_start()[pack]");
+      const T *const input_values = input.begin();
+      for (const IndexRun &run : ghost_runs)
+        std::copy_n(input_values + run.overlap_start,
+                    run.length,
+                    ghost_buffer.data() + run.other_start);
+
+      for (const IndexRun &run : local_runs)
+        std::copy_n(input_values + run.overlap_start,
+                    run.length,
+                    output.get_values() + run.other_start);
+    }
+
+    count_bytes(ghost_buffer.size() * sizeof(T),
+                import_buffer.size() * sizeof(T),
+                n_bytes_sent,
+                n_bytes_received);
+    if (backend == ScatterBackend::Persistent)
+      {
+        requests = get_import_requests(channel);
+        if (requests.size() > 0)
+          {
+            const int ierr = MPI_Startall(requests.size(), requests.data());
+            AssertThrowMPI(ierr);
+          }
+        return;
+      }
+    else if (backend == ScatterBackend::NeighborCollective)
+      {
+        requests.resize(1);
+        const int ierr = MPI_Ineighbor_alltoallv(ghost_buffer.data(),
+                                                 ghost_counts.data(),
+                                                 ghost_offsets.data(),
+                                                 get_mpi_type<T>(),
+                                                 import_buffer.data(),
+                                                 import_counts.data(),
+                                                 import_offsets.data(),
+                                                 get_mpi_type<T>(),
+                                                 import_graph_communicator,
+                                                 &requests[0]);
+        AssertThrowMPI(ierr);
+        return;
+      }
 
     const VectorOperation::values actual_op =
       operation == VectorOperation::insert ? VectorOperation::max : operation;
@@ -155,12 +532,41 @@ namespace fdl
     const VectorOperation::values actual_op =
       operation == VectorOperation::insert ? VectorOperation::max : operation;
 
+    if (backend != ScatterBackend::PointToPoint)
+      {
+        // The requests may have been delegated (and completed) already, in
+        // which case these are all MPI_REQUEST_NULL
+        const double start_time = MPI_Wtime();
+        const int    ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+        count_wait_time(start_time, wait_time);
+        requests.clear();
+
+        HardwareCounterRegion region(
+          "fdl::Scatter::overlap_to_global_finish()[unpack]");
+        std::size_t offset = 0;
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i, ++offset)
+            {
+              T &value = output.local_element(i);
+              if (actual_op == VectorOperation::add)
+                value += import_buffer[offset];
+              else
+                value = std::max(value, import_buffer[offset]);
+            }
+        AssertDimension(offset, import_buffer.size());
+        return;
+      }
+
+    const double start_time = MPI_Wtime();
     partitioner->import_from_ghosted_array_finish<T>(
       actual_op,
       ArrayView<const T>(import_buffer.data(), import_buffer.size()),
       ArrayView<T>(output.get_values(), output.locally_owned_size()),
       ArrayView<T>(ghost_buffer.data(), ghost_buffer.size()),
       requests);
+    count_wait_time(start_time, wait_time);
   }
 
 
@@ -179,6 +585,40 @@ namespace fdl
            ExcMessage("The output vector should have the same number of dofs "
                       "as were provided to the constructor in local"));
 
+    if (backend != ScatterBackend::PointToPoint)
+      pack_import_buffer(input);
+
+    count_bytes(import_buffer.size() * sizeof(T),
+                ghost_buffer.size() * sizeof(T),
+                n_bytes_sent,
+                n_bytes_received);
+    if (backend == ScatterBackend::Persistent)
+      {
+        requests = get_export_requests(channel);
+        if (requests.size() > 0)
+          {
+            const int ierr = MPI_Startall(requests.size(), requests.data());
+            AssertThrowMPI(ierr);
+          }
+        return;
+      }
+    else if (backend == ScatterBackend::NeighborCollective)
+      {
+        requests.resize(1);
+        const int ierr = MPI_Ineighbor_alltoallv(import_buffer.data(),
+                                                 import_counts.data(),
+                                                 import_offsets.data(),
+                                                 get_mpi_type<T>(),
+                                                 ghost_buffer.data(),
+                                                 ghost_counts.data(),
+                                                 ghost_offsets.data(),
+                                                 get_mpi_type<T>(),
+                                                 export_graph_communicator,
+                                                 &requests[0]);
+        AssertThrowMPI(ierr);
+        return;
+      }
+
     partitioner->export_to_ghosted_array_start<T>(
       channel,
       ArrayView<const T>(input.get_values(), input.locally_owned_size()),
@@ -201,16 +641,84 @@ namespace fdl
            ExcMessage("The output vector should have the same number of dofs "
                       "as were provided to the constructor in local"));
 
-    partitioner->export_to_ghosted_array_finish(
-      ArrayView<T>(ghost_buffer.data(), ghost_buffer.size()), requests);
+    const double start_time = MPI_Wtime();
+    if (backend != ScatterBackend::PointToPoint)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+        requests.clear();
+      }
+    else
+      partitioner->export_to_ghosted_array_finish(
+        ArrayView<T>(ghost_buffer.data(), ghost_buffer.size()), requests);
+    count_wait_time(start_time, wait_time);
+
+    unpack_ghost_buffer(input, output);
+  }
 
-    for (unsigned int i = 0; i < overlap_ghost_indices.size(); ++i)
-      output[overlap_ghost_indices[i]] = ghost_buffer[i];
 
-    for (const auto &pair : overlap_local_indices)
-      output[pair.first] = input.local_element(pair.second);
+
+  template <typename T>
+  void
+  Scatter<T>::pack_import_buffer(
+    const LinearAlgebra::distributed::Vector<T> &input)
+  {
+    HardwareCounterRegion region(
+      "fdl::Scatter::global_to_overlap_start()[pack]");
+    std::size_t offset = 0;
+    for (const auto &range : partitioner->import_indices())
+      for (unsigned int i = range.first; i < range.second; ++i, ++offset)
+        import_buffer[offset] = input.local_element(i);
+    AssertDimension(offset, import_buffer.size());
   }
 
+
+
+  template <typename T>
+  void
+  Scatter<T>::unpack_ghost_buffer(
+    const LinearAlgebra::distributed::Vector<T> &input,
+    Vector<T>                                   &output)
+  {
+    HardwareCounterRegion region(
+      "fdl::Scatter::global_to_overlap_finish()[unpack]");
+    T *const output_values = output.begin();
+    for (const IndexRun &run : ghost_runs)
+      std::copy_n(ghost_buffer.data() + run.other_start,
+                  run.length,
+                  output_values + run.overlap_start);
+
+    for (const IndexRun &run : local_runs)
+      std::copy_n(input.get_values() + run.other_start,
+                  run.length,
+                  output_values + run.overlap_start);
+  }
+
+  template <typename T>
+  std::size_t
+  Scatter<T>::memory_consumption() const
+  {
+    std::size_t n_bytes =
+      sizeof(*this) + (partitioner ? partitioner->memory_consumption() : 0) +
+      ghost_runs.capacity() * sizeof(IndexRun) +
+      local_runs.capacity() * sizeof(IndexRun) +
+      ghost_buffer.memory_consumption() + import_buffer.memory_consumption() +
+      requests.capacity() * sizeof(MPI_Request) +
+      MemoryConsumption::memory_consumption(ghost_counts) +
+      MemoryConsumption::memory_consumption(ghost_offsets) +
+      MemoryConsumption::memory_consumption(import_counts) +
+      MemoryConsumption::memory_consumption(import_offsets);
+    for (const auto &pair : export_requests)
+      n_bytes += pair.second.capacity() * sizeof(MPI_Request);
+    for (const auto &pair : import_requests)
+      n_bytes += pair.second.capacity() * sizeof(MPI_Request);
+
+    return n_bytes;
+  }
+
+
+
   template <typename T>
   std::vector<MPI_Request>
   Scatter<T>::delegate_outstanding_requests()
@@ -220,6 +728,220 @@ namespace fdl
     return copy;
   }
 
+  namespace
+  {
+    using Targets = std::vector<std::pair<unsigned int, unsigned int>>;
+
+    /**
+     * Set up messages to or from other processors in which each message
+     * contains, in order, each Scatter's data for that processor. Here
+     * @p targets contains the ghost or import targets of each Scatter.
+     */
+    template <typename Messages, typename Segment>
+    void
+    setup_messages(const std::vector<const Targets *> &targets,
+                   Messages                           &messages)
+    {
+      std::map<int, std::vector<Segment>> rank_segments;
+      for (unsigned int scatter_n = 0; scatter_n < targets.size(); ++scatter_n)
+        {
+          unsigned int buffer_start = 0;
+          for (const auto &target : *targets[scatter_n])
+            {
+              rank_segments[target.first].push_back(
+                {scatter_n, buffer_start, target.second});
+              buffer_start += target.second;
+            }
+        }
+
+      messages.segment_offsets.push_back(0);
+      messages.buffer_offsets.push_back(0);
+      for (const auto &pair : rank_segments)
+        {
+          std::size_t length = 0;
+          for (const Segment &segment : pair.second)
+            length += segment.length;
+          messages.ranks.push_back(pair.first);
+          messages.segments.insert(messages.segments.end(),
+                                   pair.second.begin(),
+                                   pair.second.end());
+          messages.segment_offsets.push_back(messages.segments.size());
+          messages.buffer_offsets.push_back(messages.buffer_offsets.back() +
+                                            length);
+        }
+      messages.buffer.resize(messages.buffer_offsets.back());
+    }
+  } // namespace
+
+  template <typename T>
+  ScatterGroup<T>::ScatterGroup(const MPI_Comm                  &comm,
+                                const std::vector<Scatter<T> *> &scatters)
+    : scatters(scatters)
+    , communicator(Utilities::MPI::duplicate_communicator(comm))
+    , n_bytes_sent(0)
+    , n_bytes_received(0)
+    , wait_time(0.0)
+  {
+    std::vector<const Targets *> ghost_targets;
+    std::vector<const Targets *> import_targets;
+    for (const Scatter<T> *scatter : scatters)
+      {
+        Assert(scatter, ExcMessage("The Scatters must not be null."));
+#ifdef DEBUG
+        int       result = MPI_UNEQUAL;
+        const int ierr =
+          MPI_Comm_compare(communicator,
+                           scatter->partitioner->get_mpi_communicator(),
+                           &result);
+        AssertThrowMPI(ierr);
+        Assert(result == MPI_CONGRUENT,
+               ExcMessage("The Scatters must use communicators congruent to "
+                          "the one provided to this object."));
+#endif
+        ghost_targets.push_back(&scatter->partitioner->ghost_targets());
+        import_targets.push_back(&scatter->partitioner->import_targets());
+      }
+
+    setup_messages<Messages, Segment>(ghost_targets, receives);
+    setup_messages<Messages, Segment>(import_targets, sends);
+  }
+
+
+
+  template <typename T>
+  ScatterGroup<T>::~ScatterGroup()
+  {
+    Utilities::MPI::free_communicator(communicator);
+  }
+
+
+
+  template <typename T>
+  void
+  ScatterGroup<T>::global_to_overlap_start(
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs)
+  {
+    AssertDimension(inputs.size(), scatters.size());
+    Assert(requests.size() == 0,
+           ExcMessage("Only one scatter may be done at a time."));
+    for (unsigned int scatter_n = 0; scatter_n < scatters.size(); ++scatter_n)
+      scatters[scatter_n]->pack_import_buffer(*inputs[scatter_n]);
+
+    {
+      HardwareCounterRegion region(
+        "fdl::ScatterGroup::global_to_overlap_start()[pack]");
+      for (unsigned int message_n = 0; message_n < sends.ranks.size();
+           ++message_n)
+        {
+          T *buffer = sends.buffer.data() + sends.buffer_offsets[message_n];
+          for (std::size_t segment_n = sends.segment_offsets[message_n];
+               segment_n < sends.segment_offsets[message_n + 1];
+               ++segment_n)
+            {
+              const Segment    &segment = sends.segments[segment_n];
+              const Scatter<T> &scatter = *scatters[segment.scatter_n];
+              buffer = std::copy_n(scatter.import_buffer.data() +
+                                     segment.buffer_start,
+                                   segment.length,
+                                   buffer);
+            }
+        }
+    }
+
+    count_bytes(sends.buffer.size() * sizeof(T),
+                receives.buffer.size() * sizeof(T),
+                n_bytes_sent,
+                n_bytes_received);
+    requests.resize(receives.ranks.size() + sends.ranks.size());
+    // Since we use our own communicator we can use the same tag for every
+    // message
+    const int tag = Utilities::MPI::internal::Tags::partitioner_export_start;
+    for (unsigned int message_n = 0; message_n < receives.ranks.size();
+         ++message_n)
+      {
+        const std::size_t offset = receives.buffer_offsets[message_n];
+        const int         ierr =
+          MPI_Irecv(receives.buffer.data() + offset,
+                    receives.buffer_offsets[message_n + 1] - offset,
+                    get_mpi_type<T>(),
+                    receives.ranks[message_n],
+                    tag,
+                    communicator,
+                    &requests[message_n]);
+        AssertThrowMPI(ierr);
+      }
+    for (unsigned int message_n = 0; message_n < sends.ranks.size();
+         ++message_n)
+      {
+        const std::size_t offset = sends.buffer_offsets[message_n];
+        const int         ierr =
+          MPI_Isend(sends.buffer.data() + offset,
+                    sends.buffer_offsets[message_n + 1] - offset,
+                    get_mpi_type<T>(),
+                    sends.ranks[message_n],
+                    tag,
+                    communicator,
+                    &requests[receives.ranks.size() + message_n]);
+        AssertThrowMPI(ierr);
+      }
+  }
+
+
+
+  template <typename T>
+  void
+  ScatterGroup<T>::global_to_overlap_finish(
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs,
+    const std::vector<Vector<T> *>                                   &outputs)
+  {
+    AssertDimension(inputs.size(), scatters.size());
+    AssertDimension(outputs.size(), scatters.size());
+
+    const double start_time = MPI_Wtime();
+    if (requests.size() > 0)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+        requests.clear();
+      }
+    count_wait_time(start_time, wait_time);
+
+    {
+      HardwareCounterRegion region(
+        "fdl::ScatterGroup::global_to_overlap_finish()[unpack]");
+      for (unsigned int message_n = 0; message_n < receives.ranks.size();
+           ++message_n)
+        {
+          const T *buffer =
+            receives.buffer.data() + receives.buffer_offsets[message_n];
+          for (std::size_t segment_n = receives.segment_offsets[message_n];
+               segment_n < receives.segment_offsets[message_n + 1];
+               ++segment_n)
+            {
+              const Segment &segment = receives.segments[segment_n];
+              Scatter<T>    &scatter = *scatters[segment.scatter_n];
+              std::copy_n(buffer,
+                          segment.length,
+                          scatter.ghost_buffer.data() + segment.buffer_start);
+              buffer += segment.length;
+            }
+        }
+    }
+
+    for (unsigned int scatter_n = 0; scatter_n < scatters.size(); ++scatter_n)
+      {
+        Assert(outputs[scatter_n]->size() ==
+                 scatters[scatter_n]->n_overlap_dofs,
+               ExcMessage("output vector should be indexed by overlap dofs"));
+        scatters[scatter_n]->unpack_ghost_buffer(*inputs[scatter_n],
+                                                 *outputs[scatter_n]);
+      }
+  }
+
   template class Scatter<float>;
   template class Scatter<double>;
+
+  template class ScatterGroup<float>;
+  template class ScatterGroup<double>;
 } // namespace fdl
@@ -0,0 +1,131 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/SecondaryHierarchy.h>
+
+#include <CellData.h>
+#include <CellIterator.h>
+#include <CellVariable.h>
+#include <VariableDatabase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Test add_nonzero_cell_data() in the way
+// IFEDMethod::beginDataRedistribution() uses it: a sparse workload on a level
+// of a secondary hierarchy with a different layout is added to zeroed data on
+// the primary hierarchy. The result should match a normal transfer.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  auto      tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto      patch_hierarchy = std::get<0>(tuple);
+  const int ln              = patch_hierarchy->getFinestLevelNumber();
+  const tbox::Pointer<hier::PatchLevel<spacedim>> primary_level =
+    patch_hierarchy->getPatchLevel(ln);
+
+  IBTK::SecondaryHierarchy secondary_hierarchy(
+    "secondary_hierarchy",
+    input_db->getDatabase("SecondaryGriddingAlgorithm"),
+    input_db->getDatabase("LoadBalancer"));
+  secondary_hierarchy.reinit(ln, ln, patch_hierarchy);
+  const tbox::Pointer<hier::PatchLevel<spacedim>> secondary_level =
+    secondary_hierarchy.getSecondaryHierarchy()->getPatchLevel(ln);
+
+  // Like the Lagrangian workload: one value per cell
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  tbox::Pointer<pdat::CellVariable<spacedim, double>> workload_var =
+    new pdat::CellVariable<spacedim, double>("workload");
+  const int workload_idx =
+    var_db->registerVariableAndContext(workload_var,
+                                       var_db->getContext("sparse"));
+  const int dense_idx =
+    var_db->registerVariableAndContext(workload_var,
+                                       var_db->getContext("dense"));
+
+  // Only set a few values on the secondary level, some of which are in cells
+  // on the boundaries between patches
+  fdl::fill_all(secondary_hierarchy.getSecondaryHierarchy(),
+                workload_idx,
+                ln,
+                ln);
+  for (typename hier::PatchLevel<spacedim>::Iterator p(secondary_level); p;
+       p++)
+    {
+      const tbox::Pointer<pdat::CellData<spacedim, double>> data =
+        secondary_level->getPatch(p())->getPatchData(workload_idx);
+      for (pdat::CellIterator<spacedim> it(data->getBox()); it; it++)
+        if ((it()(0) + it()(1)) % 3 == 0 && it()(0) < 8)
+          (*data)(it(), 0) = 1 + it()(0) + 2 * it()(1);
+    }
+
+  fdl::fill_all(patch_hierarchy, workload_idx, ln, ln);
+  fdl::add_nonzero_cell_data(primary_level,
+                             secondary_level,
+                             workload_idx,
+                             mpi_comm);
+  fdl::fill_all(patch_hierarchy, dense_idx, ln, ln);
+  secondary_hierarchy.transferSecondaryToPrimary(ln,
+                                                 dense_idx,
+                                                 workload_idx,
+                                                 0.0);
+
+  double       max_difference = 0.0;
+  unsigned int n_nonzero      = 0;
+  for (typename hier::PatchLevel<spacedim>::Iterator p(primary_level); p; p++)
+    {
+      const tbox::Pointer<hier::Patch<spacedim>> patch =
+        primary_level->getPatch(p());
+      const tbox::Pointer<pdat::CellData<spacedim, double>> sparse_data =
+        patch->getPatchData(workload_idx);
+      const tbox::Pointer<pdat::CellData<spacedim, double>> dense_data =
+        patch->getPatchData(dense_idx);
+      for (pdat::CellIterator<spacedim> it(patch->getBox()); it; it++)
+        {
+          if ((*dense_data)(it(), 0) != 0.0)
+            ++n_nonzero;
+          max_difference =
+            std::max(max_difference,
+                     std::abs((*sparse_data)(it(), 0) -
+                              (*dense_data)(it(), 0)));
+        }
+    }
+  n_nonzero      = Utilities::MPI::sum(n_nonzero, mpi_comm);
+  max_difference = Utilities::MPI::max(max_difference, mpi_comm);
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "levels have the same layout = "
+             << (fdl::have_same_layout(primary_level, secondary_level) ? "yes" :
+                                                                         "no")
+             << '\n'
+             << "nonzero values = " << n_nonzero << '\n'
+             << "sparse difference = " << max_difference << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "add_nonzero_cell_data_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,114 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/SecondaryHierarchy.h>
+
+#include <CellData.h>
+#include <CellIterator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Test alias_patch_data() in the way IFEDMethod::interpolateVelocity() uses
+// it: a level of a secondary hierarchy with the same layout as the primary
+// hierarchy shares the primary data and then releases it. The primary data
+// should be unaffected and a later transfer to the secondary hierarchy should
+// still work.
+
+using namespace SAMRAI;
+
+template <int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  auto      tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto      patch_hierarchy = std::get<0>(tuple);
+  const int f_idx           = std::get<5>(tuple);
+  const int ln              = patch_hierarchy->getFinestLevelNumber();
+  const tbox::Pointer<hier::PatchLevel<spacedim>> primary_level =
+    patch_hierarchy->getPatchLevel(ln);
+
+  IBTK::SecondaryHierarchy secondary_hierarchy(
+    "secondary_hierarchy",
+    input_db->getDatabase("GriddingAlgorithm"),
+    input_db->getDatabase("LoadBalancer"));
+  secondary_hierarchy.reinit(ln, ln, patch_hierarchy);
+  const tbox::Pointer<hier::PatchLevel<spacedim>> secondary_level =
+    secondary_hierarchy.getSecondaryHierarchy()->getPatchLevel(ln);
+
+  std::ofstream output("output");
+  const bool    same_layout =
+    fdl::have_same_layout(primary_level, secondary_level);
+  output << "levels have the same layout = " << (same_layout ? "yes" : "no")
+         << '\n';
+  if (!same_layout)
+    return;
+
+  // Largest difference between the interior values on both levels
+  const auto max_difference = [&]() {
+    double difference = 0.0;
+    for (typename hier::PatchLevel<spacedim>::Iterator p(secondary_level); p;
+         p++)
+      {
+        const tbox::Pointer<pdat::CellData<spacedim, double>> primary_data =
+          primary_level->getPatch(p())->getPatchData(f_idx);
+        const tbox::Pointer<pdat::CellData<spacedim, double>> secondary_data =
+          secondary_level->getPatch(p())->getPatchData(f_idx);
+        for (pdat::CellIterator<spacedim> it(primary_data->getBox()); it; it++)
+          for (int d = 0; d < primary_data->getDepth(); ++d)
+            difference = std::max(difference,
+                                  std::abs((*primary_data)(it(), d) -
+                                           (*secondary_data)(it(), d)));
+      }
+    return difference;
+  };
+
+  fdl::alias_patch_data(secondary_level, primary_level, f_idx);
+  bool shares_data = true;
+  for (typename hier::PatchLevel<spacedim>::Iterator p(secondary_level); p;
+       p++)
+    shares_data =
+      shares_data &&
+      secondary_level->getPatch(p())->getPatchData(f_idx).getPointer() ==
+        primary_level->getPatch(p())->getPatchData(f_idx).getPointer();
+  output << "aliased data is shared = " << (shares_data ? "yes" : "no") << '\n'
+         << "aliased difference = " << max_difference() << '\n';
+
+  // Release the data like IFEDMethod does after interpolating
+  secondary_level->deallocatePatchData(f_idx);
+  output << "secondary data is allocated after deallocation = "
+         << (secondary_level->checkAllocated(f_idx) ? "yes" : "no") << '\n'
+         << "primary data is allocated after deallocation = "
+         << (primary_level->checkAllocated(f_idx) ? "yes" : "no") << '\n';
+
+  // A normal transfer into newly allocated (and zeroed) data
+  fdl::fill_all(secondary_hierarchy.getSecondaryHierarchy(), f_idx, ln, ln);
+  secondary_hierarchy.transferPrimaryToSecondary(
+    ln, f_idx, f_idx, 0.0, nullptr);
+  bool separate_data = true;
+  for (typename hier::PatchLevel<spacedim>::Iterator p(secondary_level); p;
+       p++)
+    separate_data =
+      separate_data &&
+      secondary_level->getPatch(p())->getPatchData(f_idx).getPointer() !=
+        primary_level->getPatch(p())->getPatchData(f_idx).getPointer();
+  output << "transferred data is separate = " << (separate_data ? "yes" : "no")
+         << '\n'
+         << "transfer difference = " << max_difference() << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "alias_patch_data_01.log");
+
+  test<2>(app_initializer);
+}
@@ -1,6 +1,7 @@
 #include <fiddle/base/exceptions.h>
 #include <fiddle/base/utilities.h>
 
+#include <cstdint>
 #include <fstream>
 
 void
@@ -52,6 +53,30 @@ test_not_printable(const std::vector<int> &input, std::ofstream &out)
   out << '\n';
 }
 
+// Large buffers exercise the vectorized code paths (if available).
+void
+test_large(const std::size_t size, std::ofstream &out)
+{
+  std::string   input(size, '\0');
+  std::uint32_t state = 42;
+  for (char &c : input)
+    {
+      state = 1664525u * state + 1013904223u;
+      c     = char(state >> 24);
+    }
+
+  const std::string base64 =
+    fdl::encode_base64(input.c_str(), input.c_str() + input.size());
+  const std::string output =
+    fdl::decode_base64(base64.c_str(), base64.c_str() + base64.size());
+
+  out << "size:        " << size << '\n';
+  out << "base64 size: " << base64.size() << '\n';
+  out << "start:       " << base64.substr(0, 32) << '\n';
+  out << "end:         " << base64.substr(base64.size() - 32) << '\n';
+  out << "same:        " << (input == output) << '\n';
+}
+
 int
 main()
 {
@@ -75,4 +100,7 @@ main()
   test_not_printable({0, 1, 2, 3, 4}, out);
   test_not_printable({0, 1, 2, 3, 4, 5}, out);
   test_not_printable({0, 1, 2, 3, 4, 5, 6}, out);
+
+  for (const std::size_t size : {100, 1000, 1 << 20, (1 << 20) + 1, 10000002})
+    test_large(size, out);
 }
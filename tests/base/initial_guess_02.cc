@@ -0,0 +1,118 @@
+#include <fiddle/base/initial_guess.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
+#include <fstream>
+
+// Test the other initial guess algorithms: the incremental projection should
+// compute the same guesses as the SVD-based one and the extrapolations should
+// be exact for polynomials of the right degree.
+
+int
+main()
+{
+  std::ofstream out("output");
+
+  using namespace dealii;
+
+  // Compare both projections with a fixed nonsymmetric operator, reusing the
+  // RHS vector (so that dot products are recycled) and storing fewer vectors
+  // than we submit (so that old vectors are removed)
+  {
+    const unsigned int size = 8;
+
+    auto apply_operator = [&](const Vector<double> &x)
+    {
+      Vector<double> y(size);
+      for (unsigned int i = 0; i < size; ++i)
+        {
+          y[i] = 4.0 * x[i];
+          if (i > 0)
+            y[i] -= x[i - 1];
+          if (i + 1 < size)
+            y[i] -= 2.0 * x[i + 1];
+        }
+      return y;
+    };
+
+    fdl::InitialGuess<Vector<double>> projection(
+      3, fdl::InitialGuessType::Projection);
+    fdl::InitialGuess<Vector<double>> incremental_projection(
+      3, fdl::InitialGuessType::IncrementalProjection);
+
+    Vector<double> rhs(size);
+    bool           guesses_match = true;
+    for (unsigned int step = 0; step < 8; ++step)
+      {
+        Vector<double> exact_solution(size);
+        for (unsigned int i = 0; i < size; ++i)
+          exact_solution[i] = std::sin(1.0 + 3.0 * i + 0.1 * step * step);
+        rhs = apply_operator(exact_solution);
+
+        Vector<double> guess_1(size);
+        Vector<double> guess_2(size);
+        projection.guess(guess_1, rhs);
+        incremental_projection.guess(guess_2, rhs);
+        guess_1 -= guess_2;
+        guesses_match = guesses_match &&
+                        guess_1.l2_norm() <= 1e-10 * exact_solution.l2_norm();
+
+        projection.submit(exact_solution, rhs);
+        incremental_projection.submit(exact_solution, rhs);
+      }
+    out << "incremental projection matches projection: " << guesses_match
+        << std::endl;
+  }
+
+  // Same as the second test in initial_guess.cc: repeated vectors should be
+  // skipped
+  {
+    fdl::InitialGuess<Vector<double>> guess(
+      3, fdl::InitialGuessType::IncrementalProjection);
+
+    for (unsigned int i = 0; i < 10; ++i)
+      {
+        Vector<double> solution(3);
+        Vector<double> rhs(3);
+
+        solution[0] = 1.0;
+        solution[1] = 1.0;
+        solution[2] = 1.0;
+
+        rhs[0] = 1.0;
+        rhs[1] = 1.0;
+
+        guess.submit(solution, rhs);
+      }
+
+    Vector<double> new_rhs(3);
+    new_rhs[0] = 1.0;
+    Vector<double> solution(3);
+    guess.guess(solution, new_rhs);
+
+    solution.print(out);
+  }
+
+  // Extrapolations
+  for (const auto type : {fdl::InitialGuessType::LinearExtrapolation,
+                          fdl::InitialGuessType::QuadraticExtrapolation})
+    {
+      const bool quadratic =
+        type == fdl::InitialGuessType::QuadraticExtrapolation;
+      fdl::InitialGuess<Vector<double>> guess(5, type);
+      Vector<double>                    rhs(3);
+      Vector<double>                    solution(3);
+      for (unsigned int step = 0; step < 5; ++step)
+        {
+          guess.guess(solution, rhs);
+          solution.print(out);
+
+          for (unsigned int i = 0; i < 3; ++i)
+            solution[i] = 1.0 + i * step + (quadratic ? step * step : 0.0);
+          guess.submit(solution, rhs);
+        }
+      guess.guess(solution, rhs);
+      solution.print(out);
+    }
+}
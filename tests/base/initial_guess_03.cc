@@ -0,0 +1,80 @@
+#include <fiddle/base/initial_guess.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
+#include <fstream>
+
+// Test the periodic projection: after the first period, each guess should be
+// exact since the solutions are periodic, whereas the normal projection (which
+// does not store enough vectors to span the solutions) is not.
+
+int
+main()
+{
+  std::ofstream out("output");
+
+  using namespace dealii;
+
+  const unsigned int size          = 8;
+  const double       period        = 1.0;
+  const unsigned int n_phases      = 4;
+  const unsigned int n_steps_cycle = 4;
+
+  auto apply_operator = [&](const Vector<double> &x)
+  {
+    Vector<double> y(size);
+    for (unsigned int i = 0; i < size; ++i)
+      {
+        y[i] = 4.0 * x[i];
+        if (i > 0)
+          y[i] -= x[i - 1];
+        if (i + 1 < size)
+          y[i] -= 2.0 * x[i + 1];
+      }
+    return y;
+  };
+
+  fdl::InitialGuess<Vector<double>> projection(
+    2, fdl::InitialGuessType::Projection);
+  fdl::InitialGuess<Vector<double>> periodic_projection(
+    2, fdl::InitialGuessType::PeriodicProjection, period, n_phases);
+
+  for (unsigned int period_n = 0; period_n < 3; ++period_n)
+    {
+      bool projection_exact          = true;
+      bool periodic_projection_exact = true;
+      for (unsigned int step = 0; step < n_steps_cycle; ++step)
+        {
+          // put each step in the middle of its phase interval
+          const double time =
+            period_n * period + (step + 0.5) * period / n_steps_cycle;
+          Vector<double> exact_solution(size);
+          for (unsigned int i = 0; i < size; ++i)
+            exact_solution[i] =
+              std::sin(1.0 + 3.0 * i + 2.0 * M_PI * time / period) +
+              std::cos(0.5 * i * i + 4.0 * M_PI * time / period);
+          const Vector<double> rhs = apply_operator(exact_solution);
+
+          Vector<double> guess_1(size);
+          Vector<double> guess_2(size);
+          projection.guess(guess_1, rhs);
+          periodic_projection.set_time(time);
+          periodic_projection.guess(guess_2, rhs);
+          guess_1 -= exact_solution;
+          guess_2 -= exact_solution;
+          const double tolerance = 1e-8 * exact_solution.l2_norm();
+          projection_exact =
+            projection_exact && guess_1.l2_norm() <= tolerance;
+          periodic_projection_exact =
+            periodic_projection_exact && guess_2.l2_norm() <= tolerance;
+
+          projection.submit(exact_solution, rhs);
+          periodic_projection.submit(exact_solution, rhs);
+        }
+      out << "period " << period_n
+          << ": projection exact: " << projection_exact
+          << ", periodic projection exact: " << periodic_projection_exact
+          << std::endl;
+    }
+}
@@ -0,0 +1,127 @@
+#include <fiddle/base/initial_guess.h>
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <utility>
+
+// Test the fused inner products of InitialGuess with distributed vectors: the
+// projections should compute the same guesses as a projection whose inner
+// products are each computed separately (i.e., with one reduction apiece).
+// Half of the submissions reuse the RHS passed to guess(), so that the
+// recycled inner products are also checked.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit     ibtk_init(argc, argv, MPI_COMM_WORLD);
+  const auto         mpi_comm = MPI_COMM_WORLD;
+  const unsigned int rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+  const unsigned int n_procs  = Utilities::MPI::n_mpi_processes(mpi_comm);
+
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  // Give each processor a different number of entries
+  const unsigned int size = 10 * n_procs + n_procs * (n_procs - 1) / 2;
+  IndexSet           locally_owned(size);
+  const unsigned int begin = 10 * rank + rank * (rank - 1) / 2;
+  locally_owned.add_range(begin, begin + 10 + rank);
+  locally_owned.compress();
+
+  const unsigned int            n_vectors = 3;
+  fdl::InitialGuess<VectorType> projection(n_vectors,
+                                           fdl::InitialGuessType::Projection);
+  fdl::InitialGuess<VectorType> incremental_projection(
+    n_vectors, fdl::InitialGuessType::IncrementalProjection);
+  // The vectors which should be stored by both projections
+  std::deque<std::pair<VectorType, VectorType>> submitted;
+
+  // Compute the guess by solving the normal equations with separately
+  // computed inner products
+  const auto reference_guess = [&](const VectorType &rhs)
+  {
+    const unsigned int k = submitted.size();
+    FullMatrix<double> correlation_matrix(k, k);
+    Vector<double>     inner_products(k);
+    for (unsigned int i = 0; i < k; ++i)
+      {
+        inner_products[i] = submitted[i].second * rhs;
+        for (unsigned int j = 0; j < k; ++j)
+          correlation_matrix(i, j) = submitted[i].second * submitted[j].second;
+      }
+    VectorType guess(locally_owned, mpi_comm);
+    if (k == 0)
+      return guess;
+    correlation_matrix.gauss_jordan();
+    Vector<double> coefficients(k);
+    correlation_matrix.vmult(coefficients, inner_products);
+    for (unsigned int i = 0; i < k; ++i)
+      guess.add(coefficients[i], submitted[i].first);
+    return guess;
+  };
+
+  bool projection_matches             = true;
+  bool incremental_projection_matches = true;
+  for (unsigned int step = 0; step < 8; ++step)
+    {
+      VectorType solution(locally_owned, mpi_comm);
+      VectorType rhs(locally_owned, mpi_comm);
+      for (const auto i : locally_owned)
+        {
+          solution[i] = std::sin(1.0 + 3.0 * i + 0.1 * step * step);
+          rhs[i]      = std::cos(2.0 * i + 0.3 * step) + 0.1 * step * i;
+        }
+
+      const VectorType reference = reference_guess(rhs);
+      VectorType       guess_1(locally_owned, mpi_comm);
+      VectorType       guess_2(locally_owned, mpi_comm);
+      projection.guess(guess_1, rhs);
+      incremental_projection.guess(guess_2, rhs);
+      guess_1 -= reference;
+      guess_2 -= reference;
+      // The first guess is zero
+      const double norm         = std::max(reference.l2_norm(), 1.0);
+      const double difference_1 = guess_1.l2_norm();
+      const double difference_2 = guess_2.l2_norm();
+      projection_matches = projection_matches && difference_1 <= 1e-10 * norm;
+      incremental_projection_matches =
+        incremental_projection_matches && difference_2 <= 1e-10 * norm;
+
+      if (step % 2 == 0)
+        {
+          projection.submit(solution, rhs);
+          incremental_projection.submit(solution, rhs);
+        }
+      else
+        {
+          // A copy is a different vector, so nothing is recycled
+          const VectorType rhs_copy(rhs);
+          projection.submit(solution, rhs_copy);
+          incremental_projection.submit(solution, rhs_copy);
+        }
+      submitted.emplace_back(solution, rhs);
+      if (submitted.size() > n_vectors)
+        submitted.pop_front();
+    }
+
+  if (rank == 0)
+    {
+      std::ofstream out("output");
+      out << "projection matches separate inner products: "
+          << projection_matches << '\n'
+          << "incremental projection matches separate inner products: "
+          << incremental_projection_matches << '\n';
+    }
+}
@@ -0,0 +1,41 @@
+#include <fiddle/base/phase_timings.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <string>
+
+// Test the output of PhaseTimings. The timers are never started so every
+// time is zero.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit     ibtk_init(argc, argv, MPI_COMM_WORLD);
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  fdl::PhaseTimings timings({{"a", {"test::a()"}},
+                             {"b", {"test::b()", "test::c()"}}},
+                            MPI_COMM_WORLD);
+  timings.start();
+  timings.stop(4);
+  timings.add_value("value", rank);
+  timings.add_value("n_cells", 10.0 * (rank + 1));
+  timings.write("timings");
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      for (const std::string filename : {"timings.csv", "timings.json"})
+        {
+          std::ifstream in(filename);
+          std::string   line;
+          while (std::getline(in, line))
+            output << line << '\n';
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include <fiddle/base/quadrature_family.h>
+
+#include <fiddle/grid/grid_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <set>
+
+// Verify that QGaussAnisotropicFamily picks the number of points in each
+// direction independently and that compute_reference_direction_lengths()
+// measures stretched and rotated cells correctly.
+
+using namespace dealii;
+
+void
+test_rule(const fdl::QGaussAnisotropicFamily<2> &family,
+          const std::array<double, 2>           &lagrangian_lengths,
+          std::ofstream                         &out)
+{
+  const std::array<unsigned char, 2> n_points =
+    family.get_n_points(0.125, lagrangian_lengths);
+  const Quadrature<2> quad = family.get_quadrature(n_points);
+
+  std::array<std::set<double>, 2> coordinates;
+  double                          weight_sum = 0.0;
+  for (unsigned int q = 0; q < quad.size(); ++q)
+    {
+      for (unsigned int d = 0; d < 2; ++d)
+        coordinates[d].insert(quad.point(q)[d]);
+      weight_sum += quad.weight(q);
+    }
+
+  out << "lagrangian lengths = " << lagrangian_lengths[0] << ", "
+      << lagrangian_lengths[1] << '\n'
+      << "number of points = " << int(n_points[0]) << ", "
+      << int(n_points[1]) << '\n'
+      << "quadrature size = " << quad.size() << '\n'
+      << "distinct coordinates = " << coordinates[0].size() << ", "
+      << coordinates[1].size() << '\n'
+      << "weights sum to one = "
+      << (std::abs(weight_sum - 1.0) < 1e-14 ? "yes" : "no") << '\n';
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+
+  // The Eulerian length is 0.125, so the number of points in each direction
+  // is the Lagrangian length divided by 0.125 (rounded up) or at least two
+  const fdl::QGaussAnisotropicFamily<2> family(2);
+  test_rule(family, {{1.0, 0.015625}}, out);
+  test_rule(family, {{0.25, 0.25}}, out);
+  test_rule(family, {{0.3, 0.5}}, out);
+
+  // Cells are 0.25 by 0.05, which rotating should not change
+  Triangulation<2> tria;
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            {4, 2},
+                                            Point<2>(),
+                                            Point<2>(1.0, 0.1));
+  GridTools::rotate(numbers::PI / 6.0, tria);
+  const MappingQ<2>                       mapping(1);
+  const std::array<std::vector<float>, 2> lengths =
+    fdl::compute_reference_direction_lengths(tria, mapping, QGauss<2>(2));
+  for (unsigned int d = 0; d < 2; ++d)
+    out << "cell lengths in direction " << d << " are in ["
+        << *std::min_element(lengths[d].begin(), lengths[d].end()) << ", "
+        << *std::max_element(lengths[d].begin(), lengths[d].end()) << "]\n";
+}
@@ -0,0 +1,49 @@
+#include <fiddle/base/quadrature_family.h>
+
+#include <fstream>
+
+// Verify that precomputed quadrature families pick the same rules as lazily
+// computed ones.
+
+template <typename Family>
+void
+test(const unsigned int min_points_1D, std::ofstream &out)
+{
+  Family lazy_family(min_points_1D, 1.5);
+  Family precomputed_family(min_points_1D, 1.5);
+  precomputed_family.precompute(0.1, 0.4);
+  // extending the table should work too
+  precomputed_family.precompute(0.1, 0.8);
+
+  bool same_indices = true;
+  bool same_rules   = true;
+  for (unsigned int i = 1; i <= 80; ++i)
+    {
+      const double        lagrangian_length = 0.01 * i;
+      const unsigned char lazy_index =
+        lazy_family.get_index(0.1, lagrangian_length);
+      const unsigned char precomputed_index =
+        precomputed_family.get_index(0.1, lagrangian_length);
+      same_indices = same_indices && lazy_index == precomputed_index;
+      same_rules =
+        same_rules && lazy_family[lazy_index].get_points() ==
+                        precomputed_family[precomputed_index].get_points();
+    }
+
+  out << "min points 1D " << min_points_1D << '\n'
+      << "  same indices: " << same_indices << '\n'
+      << "  same rules: " << same_rules << '\n';
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+  out << "QGaussFamily\n";
+  for (unsigned int min_points_1D = 1; min_points_1D < 4; ++min_points_1D)
+    test<fdl::QGaussFamily<2>>(min_points_1D, out);
+
+  out << "QWitherdenVincentSimplexFamily\n";
+  for (unsigned int min_points_1D = 1; min_points_1D < 4; ++min_points_1D)
+    test<fdl::QWitherdenVincentSimplexFamily<2>>(min_points_1D, out);
+}
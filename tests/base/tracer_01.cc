@@ -0,0 +1,47 @@
+#include <fiddle/base/tracer.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <string>
+
+// Test the output of Tracer. Event times are offsets from the start time
+// which are exactly representable so that the output is deterministic.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit     ibtk_init(argc, argv, MPI_COMM_WORLD);
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  fdl::Tracer  tracer(MPI_COMM_WORLD);
+  const double t0 = tracer.get_start_time();
+  tracer.add_event("part 0", "interpolate", "compute", t0, t0 + 0.25);
+  tracer.add_event("scheduler", "MPI_Waitsome", "mpi", t0 + 0.25, t0 + 0.5);
+  tracer.add_event("part 0", "wait", "mpi", t0 + 0.25, t0 + 0.5);
+  if (rank == 1)
+    tracer.add_event(
+      "surface part \"0\"", "CG solve", "compute", t0 + 0.5, t0 + 1.125);
+  tracer.write("trace.json");
+
+  // clear() discards all events but keeps the lanes
+  tracer.clear();
+  tracer.add_event("scheduler", "MPI_Waitsome", "mpi", t0 + 1.0, t0 + 1.5);
+  tracer.write("trace_2.json");
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      for (const std::string filename : {"trace.json", "trace_2.json"})
+        {
+          std::ifstream in(filename);
+          std::string   line;
+          while (std::getline(in, line))
+            output << line << '\n';
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/bounding_box.h>
+
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <vector>
+
+// Test that intersects() with a BoundingBoxBatch agrees with the scalar
+// intersects() and that converting boxes to a less precise type only ever
+// adds intersections.
+
+using namespace dealii;
+
+template <int spacedim>
+void
+test(std::ofstream &output)
+{
+  // Coordinates are multiples of 1/8, which floats represent exactly
+  std::mt19937 generator(42);
+  const auto random_bbox = [&]() {
+    std::pair<Point<spacedim>, Point<spacedim>> corners;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        const auto a = std::uint32_t(generator() % 64) / 8.0;
+        const auto b = std::uint32_t(generator() % 64) / 8.0;
+        corners.first[d]  = std::min(a, b);
+        corners.second[d] = std::max(a, b);
+      }
+    return BoundingBox<spacedim>(corners);
+  };
+
+  std::vector<BoundingBox<spacedim>> bboxes;
+  for (unsigned int i = 0; i < 101; ++i)
+    bboxes.push_back(random_bbox());
+  const fdl::BoundingBoxBatch<spacedim, float>  float_batch(bboxes);
+  const fdl::BoundingBoxBatch<spacedim, double> double_batch(bboxes);
+
+  unsigned int               n_hits       = 0;
+  bool                       float_match  = true;
+  bool                       double_match = true;
+  bool                       any_match    = true;
+  std::vector<unsigned char> float_result;
+  std::vector<unsigned char> double_result;
+  for (unsigned int j = 0; j < 50; ++j)
+    {
+      const BoundingBox<spacedim> bbox = random_bbox();
+      fdl::intersects(bbox, float_batch, float_result);
+      fdl::intersects(bbox, double_batch, double_result);
+      bool any = false;
+      for (std::size_t i = 0; i < bboxes.size(); ++i)
+        {
+          const bool hit = fdl::intersects(bbox, bboxes[i]);
+          n_hits += hit;
+          any = any || hit;
+          float_match  = float_match && hit == bool(float_result[i]);
+          double_match = double_match && hit == bool(double_result[i]);
+        }
+      any_match = any_match && float_result.size() == bboxes.size() &&
+                  any == fdl::intersects_any(bbox, float_batch) &&
+                  any == fdl::intersects_any(bbox, double_batch);
+    }
+
+  // Boxes which are separated by less than the precision of a float
+  std::pair<Point<spacedim>, Point<spacedim>> left_corners;
+  std::pair<Point<spacedim>, Point<spacedim>> right_corners;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    {
+      left_corners.second[d]  = 0.1;
+      right_corners.first[d]  = 0.1 + 1e-12;
+      right_corners.second[d] = 1.0;
+    }
+  const BoundingBox<spacedim> left(left_corners);
+  const std::vector<BoundingBox<spacedim>> right{
+    BoundingBox<spacedim>(right_corners)};
+  const fdl::BoundingBoxBatch<spacedim, float> float_right(right);
+  std::vector<unsigned char> close_result;
+  fdl::intersects(left, float_right, close_result);
+
+  output << "spacedim = " << spacedim << '\n'
+         << "found intersections = " << (n_hits > 0 ? "yes" : "no") << '\n'
+         << "float batch matches = " << (float_match ? "yes" : "no") << '\n'
+         << "double batch matches = " << (double_match ? "yes" : "no") << '\n'
+         << "intersects_any() matches = " << (any_match ? "yes" : "no")
+         << '\n'
+         << "separated boxes intersect = "
+         << (fdl::intersects(left, right[0]) ? "yes" : "no") << '\n'
+         << "separated boxes intersect in single precision = "
+         << (close_result[0] && fdl::intersects_any(left, float_right) ?
+               "yes" :
+               "no")
+         << '\n';
+}
+
+int
+main()
+{
+  std::ofstream output("output");
+  test<2>(output);
+  test<3>(output);
+}
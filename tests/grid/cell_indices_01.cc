@@ -0,0 +1,104 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IndexUtilities.h>
+
+#include <CartesianPatchGeometry.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that compute_cell_indices() and contains() match
+// IBTK::IndexUtilities::getCellIndex() and hier::Box::contains(), including
+// at cell and patch boundaries.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+
+  bool indices_match  = true;
+  bool contains_match = true;
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        patch_hierarchy->getPatchLevel(ln);
+      AssertThrow(level, fdl::ExcFDLInternalError());
+
+      for (typename hier::PatchLevel<spacedim>::Iterator p(level); p; p++)
+        {
+          const tbox::Pointer<hier::Patch<spacedim>> patch =
+            level->getPatch(p());
+          const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geom =
+            patch->getPatchGeometry();
+          AssertThrow(geom, fdl::ExcFDLInternalError());
+          const hier::Box<spacedim> &box = patch->getBox();
+
+          // Sample every quarter of a cell, starting and ending one cell
+          // outside of the patch, so that many points lie on cell faces.
+          std::vector<double> points;
+          const int           n_samples_x = 4 * box.numberCells(0) + 9;
+          const int           n_samples_y = 4 * box.numberCells(1) + 9;
+          for (int i = 0; i < n_samples_x; ++i)
+            for (int j = 0; j < n_samples_y; ++j)
+              {
+                points.push_back(geom->getXLower()[0] +
+                                 (i - 4) * geom->getDx()[0] / 4.0);
+                points.push_back(geom->getXLower()[1] +
+                                 (j - 4) * geom->getDx()[1] / 4.0);
+              }
+
+          std::vector<int>           indices;
+          std::vector<unsigned char> inside;
+          fdl::compute_cell_indices(make_array_view(points), patch, indices);
+          fdl::contains(box, indices, inside);
+          for (std::size_t point_n = 0; point_n < points.size() / spacedim;
+               ++point_n)
+            {
+              const Point<spacedim> point(points[2 * point_n],
+                                          points[2 * point_n + 1]);
+              const hier::Index<spacedim> index =
+                IBTK::IndexUtilities::getCellIndex(point, geom, box);
+              for (unsigned int d = 0; d < spacedim; ++d)
+                indices_match =
+                  indices_match && index(d) == indices[2 * point_n + d];
+              contains_match =
+                contains_match && box.contains(index) == bool(inside[point_n]);
+            }
+        }
+    }
+
+  indices_match  = Utilities::MPI::min(int(indices_match), mpi_comm);
+  contains_match = Utilities::MPI::min(int(contains_match), mpi_comm);
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "indices match: " << indices_match << '\n'
+             << "contains matches: " << contains_match << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
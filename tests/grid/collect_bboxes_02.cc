@@ -0,0 +1,131 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that update_all_active_cell_bboxes() produces boxes containing the
+// current ones with both encodings
+
+using namespace dealii;
+
+template <int spacedim, typename Number>
+BoundingBox<spacedim, Number>
+moved_bbox(const BoundingBox<spacedim> &input,
+           const unsigned int           active_cell_index,
+           const unsigned int           step)
+{
+  // move some cells a lot, some a little, and leave the rest alone
+  double shift = 0.0;
+  if (active_cell_index % 5 == 0)
+    shift = 0.1 * step;
+  else if (active_cell_index % 3 == 0)
+    shift = 1e-3 * step;
+
+  Point<spacedim, Number> p0;
+  Point<spacedim, Number> p1;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    {
+      p0[d] = input.get_boundary_points().first[d] + shift;
+      p1[d] = input.get_boundary_points().second[d] + shift;
+    }
+
+  return BoundingBox<spacedim, Number>(std::make_pair(p0, p1));
+}
+
+template <int spacedim, typename Number>
+void
+test(const double                   tolerance,
+     const fdl::BoundingBoxEncoding encoding,
+     std::ofstream                 &output)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  const auto partitioner =
+    parallel::shared::Triangulation<spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<spacedim> tria(mpi_comm,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(2);
+
+  std::vector<BoundingBox<spacedim, Number>> all_bboxes;
+  bool                                       all_contained = true;
+  bool                                       all_equal     = true;
+  for (unsigned int step = 0; step < 4; ++step)
+    {
+      std::vector<BoundingBox<spacedim, Number>> bboxes;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->is_locally_owned())
+          bboxes.emplace_back(moved_bbox<spacedim, Number>(
+            cell->bounding_box(), cell->active_cell_index(), step));
+
+      // the first call has nothing to update so it should do a full
+      // all-gather
+      fdl::update_all_active_cell_bboxes(
+        tria, bboxes, all_bboxes, tolerance, encoding);
+      AssertThrow(all_bboxes.size() == tria.n_active_cells(),
+                  ExcMessage("should have one bbox per cell"));
+
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          const auto bbox = moved_bbox<spacedim, Number>(
+            cell->bounding_box(), cell->active_cell_index(), step);
+          const auto &stored_bbox = all_bboxes[cell->active_cell_index()];
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              all_contained =
+                all_contained &&
+                stored_bbox.lower_bound(d) <= bbox.lower_bound(d) &&
+                bbox.upper_bound(d) <= stored_bbox.upper_bound(d);
+              all_equal = all_equal &&
+                          stored_bbox.lower_bound(d) == bbox.lower_bound(d) &&
+                          bbox.upper_bound(d) == stored_bbox.upper_bound(d);
+            }
+        }
+    }
+
+  all_contained = Utilities::MPI::min(int(all_contained), mpi_comm) == 1;
+  all_equal     = Utilities::MPI::min(int(all_equal), mpi_comm) == 1;
+  if (rank == 0)
+    {
+      output << "encoding = "
+             << (encoding == fdl::BoundingBoxEncoding::Full ? "Full" :
+                                                              "Compressed")
+             << " tolerance = " << tolerance << '\n'
+             << "  all boxes contain the current ones: " << all_contained
+             << '\n';
+      // With no tolerance and full precision we should get exactly the same
+      // result as collect_all_active_cell_bboxes()
+      if (encoding == fdl::BoundingBoxEncoding::Full && tolerance == 0.0)
+        output << "  all boxes are equal to the current ones: " << all_equal
+               << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  for (const auto encoding :
+       {fdl::BoundingBoxEncoding::Full, fdl::BoundingBoxEncoding::Compressed})
+    for (const double tolerance : {0.0, 1e-2})
+      {
+        test<2, float>(tolerance, encoding, output);
+        test<2, double>(tolerance, encoding, output);
+      }
+}
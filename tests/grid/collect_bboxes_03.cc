@@ -0,0 +1,94 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+#include <vector>
+
+#include "../tests.h"
+
+// Test that collect_shared_active_cell_bboxes_and_lengths() produces exactly
+// the same bounding boxes and edge lengths as
+// collect_all_active_cell_bboxes_and_lengths() on every processor.
+
+using namespace dealii;
+
+template <int spacedim>
+void
+test(std::ofstream &output)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  const auto partitioner =
+    parallel::shared::Triangulation<spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<spacedim> tria(mpi_comm,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(2);
+
+  std::vector<BoundingBox<spacedim, float>> local_bboxes;
+  std::vector<float>                        local_lengths;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        BoundingBox<spacedim, float> fbbox;
+        fbbox.get_boundary_points() =
+          cell->bounding_box().get_boundary_points();
+        local_bboxes.push_back(fbbox);
+        local_lengths.push_back(cell->diameter());
+      }
+
+  const auto all = fdl::collect_all_active_cell_bboxes_and_lengths(
+    tria, local_bboxes, local_lengths);
+  const auto shared = fdl::collect_shared_active_cell_bboxes_and_lengths(
+    tria, local_bboxes, local_lengths);
+
+  bool sizes_equal =
+    shared.first.size() == tria.n_active_cells() &&
+    shared.second.size() == tria.n_active_cells() &&
+    all.first.size() == tria.n_active_cells();
+  bool bboxes_equal  = sizes_equal;
+  bool lengths_equal = sizes_equal;
+  if (sizes_equal)
+    for (unsigned int i = 0; i < tria.n_active_cells(); ++i)
+      {
+        for (unsigned int d = 0; d < spacedim; ++d)
+          bboxes_equal =
+            bboxes_equal &&
+            shared.first[i].lower_bound(d) == all.first[i].lower_bound(d) &&
+            shared.first[i].upper_bound(d) == all.first[i].upper_bound(d);
+        lengths_equal = lengths_equal && shared.second[i] == all.second[i];
+      }
+
+  sizes_equal   = Utilities::MPI::min(int(sizes_equal), mpi_comm) == 1;
+  bboxes_equal  = Utilities::MPI::min(int(bboxes_equal), mpi_comm) == 1;
+  lengths_equal = Utilities::MPI::min(int(lengths_equal), mpi_comm) == 1;
+  if (rank == 0)
+    output << "spacedim = " << spacedim << '\n'
+           << "  one entry per cell = " << (sizes_equal ? "yes" : "no")
+           << '\n'
+           << "  bboxes match all-gather = " << (bboxes_equal ? "yes" : "no")
+           << '\n'
+           << "  lengths match all-gather = "
+           << (lengths_equal ? "yes" : "no") << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  test<2>(output);
+}
@@ -0,0 +1,118 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that exchange_intersecting_active_cell_bboxes() finds the same cells
+// as intersecting the patch boxes with all the replicated bounding boxes
+
+using namespace dealii;
+
+template <int spacedim, typename Number>
+void
+test(std::ofstream &output)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+  const auto n_procs  = Utilities::MPI::n_mpi_processes(mpi_comm);
+
+  const auto partitioner =
+    parallel::shared::Triangulation<spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<spacedim> tria(mpi_comm,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(3);
+
+  std::vector<BoundingBox<spacedim, Number>> local_bboxes;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        BoundingBox<spacedim, Number> bbox;
+        bbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+        local_bboxes.push_back(bbox);
+      }
+  const auto global_bboxes =
+    fdl::collect_all_active_cell_bboxes(tria, local_bboxes);
+
+  // Distribute some overlapping "patches" independently of the number of
+  // processors
+  std::vector<BoundingBox<spacedim>> patch_bboxes;
+  for (unsigned int i = 0; i < 8; ++i)
+    if (i % n_procs == rank)
+      {
+        Point<spacedim> p0;
+        Point<spacedim> p1;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            p0[d] = -1.0 + 0.25 * i + 0.1 * d;
+            p1[d] = p0[d] + 0.5;
+          }
+        patch_bboxes.emplace_back(std::make_pair(p0, p1));
+      }
+
+  const auto exchanged_bboxes =
+    fdl::exchange_intersecting_active_cell_bboxes(tria,
+                                                  local_bboxes,
+                                                  patch_bboxes,
+                                                  mpi_comm);
+
+  std::vector<std::pair<CellId, BoundingBox<spacedim, Number>>>
+    expected_bboxes;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const auto &bbox = global_bboxes[cell->active_cell_index()];
+      for (const auto &patch_bbox : patch_bboxes)
+        if (fdl::intersects(bbox, patch_bbox))
+          {
+            expected_bboxes.emplace_back(cell->id(), bbox);
+            break;
+          }
+    }
+  std::sort(expected_bboxes.begin(),
+            expected_bboxes.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  bool same_cells = exchanged_bboxes.size() == expected_bboxes.size();
+  bool same_boxes = same_cells;
+  for (std::size_t i = 0; same_cells && i < expected_bboxes.size(); ++i)
+    {
+      same_cells = same_cells &&
+                   exchanged_bboxes[i].first == expected_bboxes[i].first;
+      same_boxes = same_boxes &&
+                   exchanged_bboxes[i].second.get_boundary_points() ==
+                     expected_bboxes[i].second.get_boundary_points();
+    }
+
+  const auto n_cells =
+    Utilities::MPI::sum(exchanged_bboxes.size(), mpi_comm);
+  same_cells = Utilities::MPI::min(int(same_cells), mpi_comm) == 1;
+  same_boxes = Utilities::MPI::min(int(same_boxes), mpi_comm) == 1;
+  if (rank == 0)
+    output << "number of received cells is positive: " << (n_cells > 0)
+           << '\n'
+           << "same cells: " << same_cells << '\n'
+           << "same boxes: " << same_boxes << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  test<2, float>(output);
+  test<2, double>(output);
+}
@@ -122,6 +122,8 @@ main(int argc, char **argv)
 
   // Test a vector DoFHandler
   local_out << "\n\nvector DoFHandler\n\n";
+  bool cached_values_match  = true;
+  bool batched_values_match = true;
   {
     FESystem<2>   fe(*scalar_fe, 2);
     DoFHandler<2> dof_handler(tria);
@@ -132,6 +134,39 @@ main(int argc, char **argv)
     std::vector<std::string> var_names{std::string("X_0"), std::string("X_1")};
     fdl::read_dof_data(test_file, dof_handler, 1, var_names, position);
 
+    // Test the cache: the first call writes it and the second reads it
+    const std::string cache_file = exodus_prefix + ".cache";
+    for (unsigned int i = 0; i < 2; ++i)
+      {
+        LinearAlgebra::distributed::Vector<double> cached_position(
+          dof_handler.locally_owned_dofs(), comm);
+        fdl::read_dof_data(
+          test_file, dof_handler, 1, var_names, cached_position, cache_file);
+        cached_position -= position;
+        cached_values_match =
+          cached_values_match && cached_position.linfty_norm() == 0.0;
+      }
+
+    // Test reading several time steps at once and prefetching
+    std::vector<LinearAlgebra::distributed::Vector<double>> positions(
+      2,
+      LinearAlgebra::distributed::Vector<double>(
+        dof_handler.locally_owned_dofs(), comm));
+    fdl::read_dof_data(
+      test_file, dof_handler, std::vector<int>{1, 1}, var_names, positions);
+    {
+      fdl::DoFDataReader<2> reader(test_file, dof_handler, var_names);
+      reader.prefetch(1);
+      positions.emplace_back(dof_handler.locally_owned_dofs(), comm);
+      reader.read(1, positions.back());
+    }
+    for (auto &batched_position : positions)
+      {
+        batched_position -= position;
+        batched_values_match =
+          batched_values_match && batched_position.linfty_norm() == 0.0;
+      }
+
     DataOut<2> data_out;
     data_out.set_flags(flags);
     data_out.attach_dof_handler(dof_handler);
@@ -179,4 +214,9 @@ main(int argc, char **argv)
     output.open("output");
 
   print_strings_on_0(local_out.str(), comm, output);
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    {
+      output << "cached values match: " << cached_values_match << std::endl;
+      output << "batched values match: " << batched_values_match << std::endl;
+    }
 }
@@ -0,0 +1,108 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe_field.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the bounding boxes computed from the nodal values of the
+// position contain the curved cells and that the edge lengths match those
+// computed with a MappingFEField.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto                       partitioner =
+    parallel::shared::Triangulation<2>::Settings::partition_zorder;
+  parallel::shared::Triangulation<2> tria(MPI_COMM_WORLD,
+                                          {},
+                                          true,
+                                          partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(2);
+
+  std::ofstream output("output");
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    {
+      FESystem<2>   fe(FE_Q<2>(degree), 2);
+      DoFHandler<2> dof_handler(tria);
+      dof_handler.distribute_dofs(fe);
+
+      IndexSet locally_relevant_dofs;
+      DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                              locally_relevant_dofs);
+      LinearAlgebra::distributed::Vector<double> position(
+        dof_handler.locally_owned_dofs(),
+        locally_relevant_dofs,
+        MPI_COMM_WORLD);
+      VectorTools::get_position_vector(dof_handler, position);
+      position.update_ghost_values();
+
+      const auto nodal_geometry =
+        fdl::compute_cell_nodal_bboxes_and_longest_edge_lengths<2, 2, double>(
+          dof_handler, position);
+      MappingFEField<2, 2, LinearAlgebra::distributed::Vector<double>> mapping(
+        dof_handler, position);
+      const auto geometry =
+        fdl::compute_cell_bboxes_and_longest_edge_lengths<2, 2, double>(
+          dof_handler, mapping);
+      AssertThrow(nodal_geometry.first.size() == geometry.first.size(),
+                  ExcMessage("should have the same number of boxes"));
+
+      FEValues<2>  fe_values(mapping,
+                            fe,
+                            QIterated<2>(QTrapezoid<1>(), 32),
+                            update_quadrature_points);
+      bool         points_contained      = true;
+      bool         support_box_contained = true;
+      double       max_length_difference = 0.0;
+      unsigned int local_index           = 0;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            const auto &bbox = nodal_geometry.first[local_index];
+            fe_values.reinit(cell);
+            for (const Point<2> &point : fe_values.get_quadrature_points())
+              points_contained =
+                points_contained && bbox.point_inside(point, 1e-12);
+            const auto &support_points =
+              geometry.first[local_index].get_boundary_points();
+            support_box_contained =
+              support_box_contained &&
+              bbox.point_inside(support_points.first, 1e-12) &&
+              bbox.point_inside(support_points.second, 1e-12);
+            max_length_difference =
+              std::max<double>(max_length_difference,
+                               std::abs(nodal_geometry.second[local_index] -
+                                        geometry.second[local_index]));
+            ++local_index;
+          }
+
+      output << "degree = " << degree << '\n'
+             << "quadrature points contained = " << points_contained << '\n'
+             << "support point boxes contained = " << support_box_contained
+             << '\n'
+             << "edge lengths match = " << (max_length_difference < 1e-6)
+             << '\n';
+    }
+}
@@ -0,0 +1,68 @@
+#include <fiddle/grid/intersection_predicate.h>
+#include <fiddle/grid/overlap_tria.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+
+// verify that OverlapTriangulation is only rebuilt when the selected cells or
+// the native triangulation change
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto                       partitioner =
+    parallel::shared::Triangulation<2>::Settings::partition_zorder;
+  parallel::shared::Triangulation<2> shared_tria(MPI_COMM_WORLD,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+
+  GridGenerator::hyper_ball(shared_tria);
+  shared_tria.refine_global(2);
+
+  std::ofstream out("output");
+
+  const BoundingBox<2> bbox_1(std::make_pair(Point<2>(0.0, 0.0),
+                                             Point<2>(0.5, 0.5)));
+  const BoundingBox<2> bbox_2(std::make_pair(Point<2>(0.0, 0.0),
+                                             Point<2>(0.2, 0.2)));
+  const fdl::TriaIntersectionPredicate<2> predicate_1({bbox_1});
+  const fdl::TriaIntersectionPredicate<2> predicate_2({bbox_2});
+
+  fdl::OverlapTriangulation<2> overlap_tria;
+  out << "first reinit rebuilt: "
+      << overlap_tria.reinit(shared_tria, predicate_1) << '\n';
+  const auto n_active_cells = overlap_tria.n_active_cells();
+  out << "same cells rebuilt: "
+      << overlap_tria.reinit(shared_tria, predicate_1) << '\n';
+  out << "same number of cells: "
+      << (overlap_tria.n_active_cells() == n_active_cells) << '\n';
+  out << "different cells rebuilt: "
+      << overlap_tria.reinit(shared_tria, predicate_2) << '\n';
+  out << "fewer cells: " << (overlap_tria.n_active_cells() < n_active_cells)
+      << '\n';
+
+  // Selecting cells without rebuilding should not lose the fact that the
+  // triangulation is out of date
+  out << "select_cells() needs rebuild: "
+      << overlap_tria.select_cells(shared_tria, predicate_1) << '\n';
+  out << "select_cells() still needs rebuild: "
+      << overlap_tria.select_cells(shared_tria, predicate_2) << '\n';
+  overlap_tria.rebuild(predicate_2);
+  out << "after rebuild(): " << overlap_tria.reinit(shared_tria, predicate_2)
+      << '\n';
+
+  shared_tria.refine_global(1);
+  out << "refined native tria rebuilt: "
+      << overlap_tria.reinit(shared_tria, predicate_2) << '\n';
+  out << "fine cells: " << (overlap_tria.n_levels() == shared_tria.n_levels())
+      << '\n';
+}
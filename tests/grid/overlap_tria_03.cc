@@ -0,0 +1,61 @@
+#include <fiddle/grid/intersection_predicate.h>
+#include <fiddle/grid/overlap_tria.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+#include <vector>
+
+// verify that SubsetIntersectionPredicate restricts an OverlapTriangulation to
+// the selected cells
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto                       partitioner =
+    parallel::shared::Triangulation<2>::Settings::partition_zorder;
+  parallel::shared::Triangulation<2> shared_tria(MPI_COMM_WORLD,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+
+  GridGenerator::hyper_cube(shared_tria);
+  shared_tria.refine_global(2);
+
+  std::ofstream out("output");
+
+  // select everything
+  const BoundingBox<2> bbox(std::make_pair(Point<2>(-1.0, -1.0),
+                                           Point<2>(2.0, 2.0)));
+  const fdl::TriaIntersectionPredicate<2> all_predicate({bbox});
+
+  std::vector<bool> boundary_cells(shared_tria.n_active_cells());
+  for (const auto &cell : shared_tria.active_cell_iterators())
+    boundary_cells[cell->active_cell_index()] = cell->at_boundary();
+  const fdl::SubsetIntersectionPredicate<2> predicate(all_predicate,
+                                                      boundary_cells,
+                                                      shared_tria);
+
+  fdl::OverlapTriangulation<2> overlap_tria(shared_tria, predicate);
+
+  unsigned int n_locally_owned_cells = 0;
+  bool         all_at_boundary       = true;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        ++n_locally_owned_cells;
+        all_at_boundary =
+          all_at_boundary && overlap_tria.get_native_cell(cell)->at_boundary();
+      }
+
+  out << "number of native cells = " << shared_tria.n_active_cells() << '\n';
+  out << "number of locally owned cells = " << n_locally_owned_cells << '\n';
+  out << "all cells at boundary: " << all_at_boundary << '\n';
+}
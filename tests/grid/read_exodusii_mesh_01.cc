@@ -0,0 +1,74 @@
+#include <fiddle/grid/data_in.h>
+#include <fiddle/grid/grid_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+
+#include <fstream>
+
+// Test that read_exodusii_mesh() creates the same mesh and nodesets as GridIn
+// and extract_nodeset().
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  const MPI_Comm                   comm = MPI_COMM_WORLD;
+  Utilities::MPI::MPI_InitFinalize mpi_environment(argc, argv);
+
+  const std::string test_file = SOURCE_DIR "/two-nodesets.e";
+
+  parallel::shared::Triangulation<3> tria(comm);
+  const auto                         data =
+    fdl::read_exodusii_mesh(test_file, tria, std::vector<int>{42, 100});
+
+  parallel::shared::Triangulation<3> reference_tria(comm);
+  GridIn<3>                          grid_in(reference_tria);
+  const auto reference_data = grid_in.read_exodusii(test_file);
+
+  bool same_mesh = tria.n_active_cells() == reference_tria.n_active_cells() &&
+                   tria.n_vertices() == reference_tria.n_vertices();
+  for (unsigned int vertex_n = 0; same_mesh && vertex_n < tria.n_vertices();
+       ++vertex_n)
+    same_mesh = tria.get_vertices()[vertex_n] ==
+                reference_tria.get_vertices()[vertex_n];
+  for (auto cell = tria.begin_active(), reference_cell =
+                                          reference_tria.begin_active();
+       same_mesh && cell != tria.end();
+       ++cell, ++reference_cell)
+    {
+      same_mesh = cell->material_id() == reference_cell->material_id() &&
+                  cell->manifold_id() == reference_cell->manifold_id();
+      for (const unsigned int v : cell->vertex_indices())
+        same_mesh =
+          same_mesh && cell->vertex_index(v) == reference_cell->vertex_index(v);
+      for (const unsigned int f : cell->face_indices())
+        same_mesh = same_mesh && cell->face(f)->boundary_id() ==
+                                   reference_cell->face(f)->boundary_id();
+    }
+  const bool same_sidesets =
+    data.id_to_sideset_ids == reference_data.id_to_sideset_ids;
+
+  bool same_nodesets = data.nodesets.size() == 2;
+  for (unsigned int i = 0; same_nodesets && i < 2; ++i)
+    {
+      const auto reference_nodeset =
+        fdl::extract_nodeset<3>(test_file, i == 0 ? 42 : 100);
+      same_nodesets = data.nodesets[i] == reference_nodeset;
+    }
+
+  same_mesh     = Utilities::MPI::min(int(same_mesh), comm);
+  same_nodesets = Utilities::MPI::min(int(same_nodesets), comm);
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "same mesh: " << same_mesh << '\n'
+             << "same sidesets: " << same_sidesets << '\n'
+             << "same nodesets: " << same_nodesets << '\n';
+    }
+}
@@ -0,0 +1,156 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/box_utilities.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/IndexUtilities.h>
+
+#include <CartesianGridGeometry.h>
+#include <CellData.h>
+#include <CellIterator.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify cell tagging against a brute-force implementation which does not use
+// an rtree. benchmarks/tagging.cc times the same operation on a large mesh.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+void
+tag_cells_brute_force(
+  const std::vector<BoundingBox<spacedim, float>> &bboxes,
+  const int                                        tag_index,
+  tbox::Pointer<hier::PatchLevel<spacedim>>       &patch_level)
+{
+  const hier::IntVector<spacedim> ratio = patch_level->getRatio();
+  const tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geom =
+    patch_level->getGridGeometry();
+  const double *const          dx0 = grid_geom->getDx();
+  std::array<double, spacedim> dx;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    dx[d] = dx0[d] / double(ratio(d));
+  const auto domain_box =
+    hier::Box<spacedim>::refine(grid_geom->getPhysicalDomain()[0], ratio);
+
+  const auto patches      = fdl::extract_patches(patch_level);
+  const auto patch_bboxes = fdl::compute_patch_bboxes<spacedim, float>(patches);
+  for (unsigned int patch_n = 0; patch_n < patches.size(); ++patch_n)
+    {
+      tbox::Pointer<pdat::CellData<spacedim, double>> tag_data =
+        patches[patch_n]->getPatchData(tag_index);
+      for (const auto &bbox : bboxes)
+        if (patch_bboxes[patch_n].get_neighbor_type(bbox) !=
+            NeighborType::not_neighbors)
+          {
+            const hier::Index<spacedim> i_lower =
+              IBTK::IndexUtilities::getCellIndex(
+                bbox.get_boundary_points().first,
+                grid_geom->getXLower(),
+                grid_geom->getXUpper(),
+                dx.data(),
+                domain_box.lower(),
+                domain_box.upper());
+            const hier::Index<spacedim> i_upper =
+              IBTK::IndexUtilities::getCellIndex(
+                bbox.get_boundary_points().second,
+                grid_geom->getXLower(),
+                grid_geom->getXUpper(),
+                dx.data(),
+                domain_box.lower(),
+                domain_box.upper());
+            tag_data->fillAll(1.0, hier::Box<spacedim>(i_lower, i_upper));
+          }
+    }
+}
+
+template <int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+  auto test_db  = input_db->getDatabase("test");
+
+  const auto mpi_comm        = MPI_COMM_WORLD;
+  const auto rank            = Utilities::MPI::this_mpi_process(mpi_comm);
+  const auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  const auto patch_hierarchy = std::get<0>(tuple);
+  const int  reference_idx   = std::get<5>(tuple);
+  const int  tag_idx         = std::get<6>(tuple);
+
+  Triangulation<spacedim> tria;
+  GridGenerator::hyper_cube(tria, -0.5, 0.5);
+  tria.refine_global(
+    test_db->getIntegerWithDefault("n_global_refinements", 5));
+
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  cell_bboxes.reserve(tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const BoundingBox<spacedim>  box = cell->bounding_box();
+      BoundingBox<spacedim, float> fbox;
+      fbox.get_boundary_points().first  = box.get_boundary_points().first;
+      fbox.get_boundary_points().second = box.get_boundary_points().second;
+      cell_bboxes.push_back(fbox);
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    {
+      output.open("output");
+      output << "number of elements: " << tria.n_active_cells() << '\n';
+    }
+
+  bool all_equal = true;
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        patch_hierarchy->getPatchLevel(ln);
+      const auto patches = fdl::extract_patches(level);
+      for (auto &patch : patches)
+        {
+          fdl::fill_all(patch->getPatchData(reference_idx), 0);
+          fdl::fill_all(patch->getPatchData(tag_idx), 0);
+        }
+
+      fdl::tag_cells(cell_bboxes, tag_idx, level);
+      tag_cells_brute_force(cell_bboxes, reference_idx, level);
+
+      for (auto &patch : patches)
+        {
+          tbox::Pointer<pdat::CellData<spacedim, double>> reference_data =
+            patch->getPatchData(reference_idx);
+          tbox::Pointer<pdat::CellData<spacedim, double>> tag_data =
+            patch->getPatchData(tag_idx);
+          for (pdat::CellIterator<spacedim> it(tag_data->getGhostBox()); it;
+               it++)
+            all_equal =
+              all_equal && ((*tag_data)(it()) == (*reference_data)(it()));
+        }
+    }
+
+  all_equal = Utilities::MPI::min(int(all_equal), mpi_comm) == 1;
+  if (rank == 0)
+    output << "tagged cells match brute force: " << all_equal << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "tag_cells_02.log");
+
+  test<2>(app_initializer);
+}
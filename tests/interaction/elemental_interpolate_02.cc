@@ -0,0 +1,189 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/grid_utilities.h>
+
+#include <fiddle/interaction/elemental_interaction.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that ElementalInteraction computes nearly the same projection right-hand
+// sides when overlap vectors are stored in single precision
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim, typename Number1, typename Number2>
+dealii::BoundingBox<spacedim, Number1>
+convert(const dealii::BoundingBox<spacedim, Number2> &input)
+{
+  // We should get a better conversion constructor
+  dealii::Point<spacedim, Number1> p0;
+  dealii::Point<spacedim, Number1> p1;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    {
+      p0[d] = input.get_boundary_points().first[d];
+      p1[d] = input.get_boundary_points().second[d];
+    }
+
+  return dealii::BoundingBox<spacedim, Number1>(std::make_pair(p0, p1));
+}
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto          input_db       = app_initializer->getInputDatabase();
+  const int     n_F_components = get_n_f_components(input_db);
+  constexpr int fe_degree      = 1;
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  std::unique_ptr<FiniteElement<dim>> F_fe;
+  if (n_F_components == 1)
+    F_fe = std::make_unique<FE_Q<dim>>(fe_degree);
+  else
+    F_fe =
+      std::make_unique<FESystem<dim>>(FE_Q<dim>(fe_degree), n_F_components);
+  FESystem<dim> position_fe(FE_Q<dim>(fe_degree), dim);
+
+  DoFHandler<dim> position_dof_handler(native_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  DoFHandler<dim> F_dof_handler(native_tria);
+  F_dof_handler.distribute_dofs(*F_fe);
+  IndexSet locally_relevant_position_dofs;
+  DoFTools::extract_locally_relevant_dofs(position_dof_handler,
+                                          locally_relevant_position_dofs);
+  IndexSet locally_relevant_F_dofs;
+  DoFTools::extract_locally_relevant_dofs(F_dof_handler,
+                                          locally_relevant_F_dofs);
+
+  auto position_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    position_dof_handler.locally_owned_dofs(),
+    locally_relevant_position_dofs,
+    native_tria.get_communicator());
+  auto F_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    F_dof_handler.locally_owned_dofs(),
+    locally_relevant_F_dofs,
+    native_tria.get_communicator());
+
+  MappingQ1<dim> F_mapping;
+
+  LinearAlgebra::distributed::Vector<double> position(position_partitioner);
+  VectorTools::interpolate(position_dof_handler,
+                           Functions::IdentityFunction<dim>(),
+                           position);
+  LinearAlgebra::distributed::Vector<double> F_rhs(F_partitioner);
+  LinearAlgebra::distributed::Vector<double> float_F_rhs(F_partitioner);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  std::vector<BoundingBox<spacedim, float>> bboxes;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      bboxes.emplace_back(
+        convert<spacedim, float, double>(cell->bounding_box()));
+  const auto all_bboxes =
+    fdl::collect_all_active_cell_bboxes(native_tria, bboxes);
+  const auto local_edge_lengths =
+    fdl::compute_longest_edge_lengths(native_tria, F_mapping, QGauss<1>(2));
+  const auto all_edge_lengths =
+    fdl::collect_longest_edge_lengths(native_tria, local_edge_lengths);
+
+  auto compute_rhs = [&](LinearAlgebra::distributed::Vector<double> &rhs)
+  {
+    fdl::ElementalInteraction<dim, spacedim> interaction(
+      input_db,
+      native_tria,
+      all_bboxes,
+      all_edge_lengths,
+      patch_hierarchy,
+      std::make_pair(patch_hierarchy->getFinestLevelNumber(),
+                     patch_hierarchy->getFinestLevelNumber()),
+      fe_degree + 1,
+      1.0,
+      fdl::DensityKind::Minimum);
+    interaction.add_dof_handler(position_dof_handler);
+    interaction.add_dof_handler(F_dof_handler);
+
+    auto transaction =
+      interaction.compute_projection_rhs_scatter_start("BSPLINE_3",
+                                                       f_idx,
+                                                       position_dof_handler,
+                                                       position,
+                                                       F_dof_handler,
+                                                       F_mapping,
+                                                       rhs);
+    transaction =
+      interaction.compute_projection_rhs_scatter_finish(std::move(transaction));
+    transaction =
+      interaction.compute_projection_rhs_intermediate(std::move(transaction));
+    transaction = interaction.compute_projection_rhs_accumulate_start(
+      std::move(transaction));
+    interaction.compute_projection_rhs_accumulate_finish(
+      std::move(transaction));
+  };
+
+  compute_rhs(F_rhs);
+  input_db->putBool("single_precision_overlap", true);
+  compute_rhs(float_F_rhs);
+
+  // output:
+  float_F_rhs -= F_rhs;
+  const double relative_difference =
+    float_F_rhs.linfty_norm() / F_rhs.linfty_norm();
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "relative difference is small: "
+             << (relative_difference < 1e-6) << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<NDIM>(app_initializer);
+}
@@ -0,0 +1,215 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/interaction/ib_kernels.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/LEInteractor.h>
+#include <ibtk/muParserCartGridFunction.h>
+
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <SideData.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "../tests.h"
+
+// Verify that fiddle's kernels compute the same values as LEInteractor's on a
+// nonperiodic domain.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim, typename patch_type>
+void
+test_kernel(const std::string                            &kernel_name,
+            tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+            const int                                      f_idx,
+            const int                                      e_idx_0,
+            const int                                      e_idx_1,
+            const int                                      n_components,
+            std::ostream                                  &output)
+{
+  const auto rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  // Use the same random points on every patch for simplicity
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<double>                    unit_points(1000 * spacedim);
+  for (double &x : unit_points)
+    x = distribution(generator);
+
+  double     max_interpolation_difference = 0.0;
+  double     max_interpolation_value      = 0.0;
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  for (auto &patch : patches)
+    {
+      fdl::fill_all(patch->getPatchData(e_idx_0), 0.0);
+      fdl::fill_all(patch->getPatchData(e_idx_1), 0.0);
+
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+        patch->getPatchGeometry();
+      std::vector<double> points(unit_points.size());
+      for (std::size_t i = 0; i < points.size(); ++i)
+        {
+          const int d = i % spacedim;
+          points[i]   = pgeom->getXLower()[d] +
+                      (pgeom->getXUpper()[d] - pgeom->getXLower()[d]) *
+                        unit_points[i];
+        }
+
+      const std::size_t   n_values = (points.size() / spacedim) * n_components;
+      std::vector<double> values_0(n_values);
+      std::vector<double> values_1(n_values);
+      tbox::Pointer<patch_type> f_data = patch->getPatchData(f_idx);
+      IBTK::LEInteractor::interpolate(values_0.data(),
+                                      values_0.size(),
+                                      n_components,
+                                      points.data(),
+                                      points.size(),
+                                      spacedim,
+                                      f_data,
+                                      patch,
+                                      patch->getBox(),
+                                      kernel_name);
+      fdl::ib_interpolate(values_1.data(),
+                          values_1.size(),
+                          n_components,
+                          points.data(),
+                          points.size(),
+                          spacedim,
+                          f_data,
+                          patch,
+                          patch->getBox(),
+                          kernel_name);
+      for (std::size_t i = 0; i < n_values; ++i)
+        {
+          max_interpolation_difference =
+            std::max(max_interpolation_difference,
+                     std::abs(values_0[i] - values_1[i]));
+          max_interpolation_value =
+            std::max(max_interpolation_value, std::abs(values_0[i]));
+        }
+
+      // spread the interpolated values back:
+      tbox::Pointer<patch_type> e_data_0 = patch->getPatchData(e_idx_0);
+      tbox::Pointer<patch_type> e_data_1 = patch->getPatchData(e_idx_1);
+      IBTK::LEInteractor::spread(e_data_0,
+                                 values_0.data(),
+                                 values_0.size(),
+                                 n_components,
+                                 points.data(),
+                                 points.size(),
+                                 spacedim,
+                                 patch,
+                                 patch->getBox(),
+                                 kernel_name);
+      fdl::ib_spread(e_data_1,
+                     values_0.data(),
+                     values_0.size(),
+                     n_components,
+                     points.data(),
+                     points.size(),
+                     spacedim,
+                     patch,
+                     patch->getBox(),
+                     kernel_name);
+    }
+
+  tbox::Pointer<hier::Variable<spacedim>> f_var;
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  var_db->mapIndexToVariable(f_idx, f_var);
+  auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+  const double max_spread_value = ops->maxNorm(e_idx_0);
+  ops->subtract(e_idx_1, e_idx_1, e_idx_0);
+  const double max_spread_difference = ops->maxNorm(e_idx_1);
+
+  max_interpolation_difference =
+    Utilities::MPI::max(max_interpolation_difference, MPI_COMM_WORLD);
+  max_interpolation_value =
+    Utilities::MPI::max(max_interpolation_value, MPI_COMM_WORLD);
+  if (rank == 0)
+    {
+      output << kernel_name << '\n'
+             << "  relative interpolation difference < 1e-14: "
+             << (max_interpolation_difference <
+                 1e-14 * max_interpolation_value)
+             << '\n'
+             << "  relative spreading difference < 1e-14: "
+             << (max_spread_difference < 1e-14 * max_spread_value) << '\n';
+    }
+}
+
+template <int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  auto       test_db  = input_db->getDatabase("test");
+  const auto rank     = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  tbox::Pointer<hier::Variable<spacedim>> f_var;
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  var_db->mapIndexToVariable(f_idx, f_var);
+  const int e_idx_0 = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int e_idx_1 = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      patch_hierarchy->getPatchLevel(ln)->allocatePatchData(e_idx_0, 0.0);
+      patch_hierarchy->getPatchLevel(ln)->allocatePatchData(e_idx_1, 0.0);
+    }
+
+  IBTK::muParserCartGridFunction f_fcn("f",
+                                       test_db->getDatabase("f"),
+                                       patch_hierarchy->getGridGeometry());
+  f_fcn.setDataOnPatchHierarchy(f_idx, f_var, patch_hierarchy, 0.0);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  const int n_components = get_n_f_components(input_db);
+  for (const std::string kernel_name :
+       {"PIECEWISE_LINEAR", "IB_3", "IB_4", "BSPLINE_3", "BSPLINE_4"})
+    {
+      if (test_db->getStringWithDefault("f_data_type", "CELL") == "CELL")
+        test_kernel<spacedim, pdat::CellData<spacedim, double>>(kernel_name,
+                                                                patch_hierarchy,
+                                                                f_idx,
+                                                                e_idx_0,
+                                                                e_idx_1,
+                                                                n_components,
+                                                                output);
+      else
+        test_kernel<spacedim, pdat::SideData<spacedim, double>>(kernel_name,
+                                                                patch_hierarchy,
+                                                                f_idx,
+                                                                e_idx_0,
+                                                                e_idx_1,
+                                                                n_components,
+                                                                output);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,207 @@
+#include <fiddle/interaction/ifed_method.h>
+
+#include <deal.II/base/function_parser.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test runtime part activation: three balls sit next to a moving lid. The
+// first is always active, the second is only active in the window given by
+// activation_windows_1, and the third is switched off with
+// IFEDMethodBase::set_part_active(). Each part should only move while it is
+// active and should have zero velocity otherwise.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<dim>(), 0.07);
+  native_tria.refine_global(2);
+
+  // fiddle stuff:
+  constexpr unsigned int  n_parts = 3;
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), spacedim);
+  std::vector<fdl::Part<dim, spacedim>> parts;
+  for (unsigned int i = 0; i < n_parts; ++i)
+    {
+      // Put each ball next to the lid
+      FunctionParser<spacedim> initial_position(
+        "X_0 + " + std::to_string(0.2 + 0.3 * i) + "; X_1 + 0.9",
+        "",
+        "X_0,X_1");
+      parts.emplace_back(
+        native_tria,
+        fe,
+        std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>>(),
+        initial_position);
+    }
+  auto *ifed = new fdl::IFEDMethod<dim, spacedim>("ifed_method",
+                                                   input_db->getDatabase(
+                                                     "IFEDMethod"),
+                                                   std::move(parts));
+  ifed->set_part_active(2, false);
+  tbox::Pointer<IBAMR::IBStrategy> ib_method_ops = ifed;
+
+  // Create major algorithm and data objects that comprise the
+  // application.  These objects are configured from the input database
+  // and, if this is a restarted run, from the restart database.
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry",
+      app_initializer->getComponentDatabase("CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::LoadBalancer<spacedim>> load_balancer =
+    new mesh::LoadBalancer<spacedim>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::BergerRigoutsos<spacedim>> box_generator =
+    new mesh::BergerRigoutsos<spacedim>();
+
+  tbox::Pointer<IBAMR::INSHierarchyIntegrator> navier_stokes_integrator =
+    new IBAMR::INSStaggeredHierarchyIntegrator(
+      "INSStaggeredHierarchyIntegrator",
+      app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+
+  tbox::Pointer<IBAMR::IBHierarchyIntegrator> time_integrator =
+    new IBAMR::IBExplicitHierarchyIntegrator(
+      "IBHierarchyIntegrator",
+      app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+      ib_method_ops,
+      navier_stokes_integrator);
+  time_integrator->registerLoadBalancer(load_balancer);
+
+  tbox::Pointer<mesh::StandardTagAndInitialize<spacedim>> error_detector =
+    new mesh::StandardTagAndInitialize<spacedim>(
+      "StandardTagAndInitialize",
+      time_integrator,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+  tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          app_initializer->getComponentDatabase(
+                                            "GriddingAlgorithm"),
+                                          error_detector,
+                                          box_generator,
+                                          load_balancer);
+
+  std::vector<solv::RobinBcCoefStrategy<spacedim> *> u_bc_coefs(spacedim);
+  // Create Eulerian boundary condition specification objects.
+  for (int d = 0; d < spacedim; ++d)
+    {
+      const std::string bc_coefs_name = "u_bc_coefs_" + std::to_string(d);
+
+      const std::string bc_coefs_db_name =
+        "VelocityBcCoefs_" + std::to_string(d);
+
+      u_bc_coefs[d] =
+        new IBTK::muParserRobinBcCoefs(bc_coefs_name,
+                                       app_initializer->getComponentDatabase(
+                                         bc_coefs_db_name),
+                                       grid_geometry);
+    }
+  navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+
+  // Initialize hierarchy configuration and data on all patches.
+  time_integrator->initializePatchHierarchy(patch_hierarchy,
+                                            gridding_algorithm);
+
+  // Whether or not each part moved or had a nonzero velocity in a time step
+  // in which it was active or inactive
+  std::vector<bool> moved_while_active(n_parts);
+  std::vector<bool> moved_while_inactive(n_parts);
+  std::vector<bool> had_velocity_while_inactive(n_parts);
+
+  // Main time step loop.
+  double loop_time     = time_integrator->getIntegratorTime();
+  double loop_time_end = time_integrator->getEndTime();
+  while (!tbox::MathUtilities<double>::equalEps(loop_time, loop_time_end) &&
+         time_integrator->stepsRemaining())
+    {
+      loop_time = time_integrator->getIntegratorTime();
+
+      std::vector<LinearAlgebra::distributed::Vector<double>> old_positions;
+      for (unsigned int i = 0; i < n_parts; ++i)
+        old_positions.push_back(ifed->get_part(i).get_position());
+
+      const double dt = time_integrator->getMaximumTimeStepSize();
+      time_integrator->advanceHierarchy(dt);
+
+      for (unsigned int i = 0; i < n_parts; ++i)
+        {
+          const auto &part       = ifed->get_part(i);
+          auto        difference = part.get_position();
+          difference -= old_positions[i];
+          const bool moved = difference.linfty_norm() != 0.0;
+          if (part.is_active(loop_time))
+            moved_while_active[i] = moved_while_active[i] || moved;
+          else
+            {
+              moved_while_inactive[i] = moved_while_inactive[i] || moved;
+              had_velocity_while_inactive[i] =
+                had_velocity_while_inactive[i] ||
+                part.get_velocity().linfty_norm() != 0.0;
+            }
+        }
+      loop_time += dt;
+    }
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      for (unsigned int i = 0; i < n_parts; ++i)
+        output << "part " << i << " moved while active = "
+               << (moved_while_active[i] ? "yes" : "no") << '\n'
+               << "part " << i << " moved while inactive = "
+               << (moved_while_inactive[i] ? "yes" : "no") << '\n'
+               << "part " << i << " had a velocity while inactive = "
+               << (had_velocity_while_inactive[i] ? "yes" : "no") << '\n';
+    }
+
+  for (auto ptr : u_bc_coefs)
+    delete ptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_activation_01.log");
+
+  test<NDIM>(app_initializer);
+}
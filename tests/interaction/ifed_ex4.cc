@@ -1,3 +1,5 @@
+#include <fiddle/base/phase_timings.h>
+
 #include <fiddle/interaction/ifed_method.h>
 
 #include <fiddle/postprocess/surface_meter.h>
@@ -32,6 +34,8 @@
 #include <StandardTagAndInitialize.h>
 
 #include <fstream>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "../tests.h"
@@ -154,6 +158,20 @@ test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
   auto       test_db  = input_db->getDatabase("test");
   const auto mpi_comm = MPI_COMM_WORLD;
 
+  // In benchmark mode we run a fixed number of steps, write no output, and
+  // record the time spent in each phase of the computation. The timers have
+  // to be activated before any of the objects owning them are created.
+  const bool benchmark_mode = test_db->getBoolWithDefault("benchmark", false);
+  const int  n_warmup_steps =
+    test_db->getIntegerWithDefault("benchmark_n_warmup_steps", 2);
+  const int n_benchmark_steps =
+    test_db->getIntegerWithDefault("benchmark_n_steps", 20);
+  std::unique_ptr<fdl::PhaseTimings> phase_timings;
+  if (benchmark_mode)
+    phase_timings =
+      std::make_unique<fdl::PhaseTimings>(fdl::PhaseTimings::default_phases(),
+                                          mpi_comm);
+
   // setup deal.II stuff:
   const auto partitioner =
     parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
@@ -276,27 +294,31 @@ test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
   // Write out initial visualization data.
   int    iteration_num = time_integrator->getIntegratorStep();
   double loop_time     = time_integrator->getIntegratorTime();
-  time_integrator->setupPlotData();
-  visit_data_writer->writePlotData(patch_hierarchy, iteration_num, loop_time);
-  {
-    const auto  &part = ib_method_ops->get_part(0);
-    DataOut<dim> data_out;
-    data_out.attach_dof_handler(part.get_dof_handler());
-    data_out.add_data_vector(part.get_velocity(), "U");
-
-    MappingFEField<dim, spacedim, LinearAlgebra::distributed::Vector<double>>
-      position_mapping(part.get_dof_handler(), part.get_position());
-    data_out.build_patches(position_mapping);
-    data_out.write_vtu_with_pvtu_record(app_initializer->getVizDumpDirectory() +
-                                          "/",
-                                        "solution",
-                                        iteration_num,
-                                        mpi_comm,
-                                        8);
-  }
+  if (!benchmark_mode)
+    {
+      time_integrator->setupPlotData();
+      visit_data_writer->writePlotData(patch_hierarchy,
+                                       iteration_num,
+                                       loop_time);
+
+      const auto  &part = ib_method_ops->get_part(0);
+      DataOut<dim> data_out;
+      data_out.attach_dof_handler(part.get_dof_handler());
+      data_out.add_data_vector(part.get_velocity(), "U");
+
+      MappingFEField<dim, spacedim, LinearAlgebra::distributed::Vector<double>>
+        position_mapping(part.get_dof_handler(), part.get_position());
+      data_out.build_patches(position_mapping);
+      data_out.write_vtu_with_pvtu_record(
+        app_initializer->getVizDumpDirectory() + "/",
+        "solution",
+        iteration_num,
+        mpi_comm,
+        8);
+    }
 
   std::ofstream volume_stream;
-  if (IBTK::IBTK_MPI::getRank() == 0)
+  if (!benchmark_mode && IBTK::IBTK_MPI::getRank() == 0)
     {
       volume_stream.open("volume.curve",
                          std::ios_base::out | std::ios_base::trunc);
@@ -325,12 +347,19 @@ test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
                                                   patch_hierarchy);
     }
 
+  int       n_steps_taken = 0;
+  const int n_total_steps = n_warmup_steps + n_benchmark_steps;
+
   // Main time step loop.
   double loop_time_end = time_integrator->getEndTime();
   double dt            = 0.0;
   while (!tbox::MathUtilities<double>::equalEps(loop_time, loop_time_end) &&
-         time_integrator->stepsRemaining())
+         time_integrator->stepsRemaining() &&
+         (!benchmark_mode || n_steps_taken < n_total_steps))
     {
+      if (benchmark_mode && n_steps_taken == n_warmup_steps)
+        phase_timings->start();
+      ++n_steps_taken;
       iteration_num = time_integrator->getIntegratorStep();
       loop_time     = time_integrator->getIntegratorTime();
 
@@ -350,6 +379,8 @@ test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
       tbox::pout << "\n";
 
       iteration_num += 1;
+      if (benchmark_mode)
+        continue;
       const bool last_step = !time_integrator->stepsRemaining();
       if (last_step ||
           iteration_num % app_initializer->getVizDumpInterval() == 0)
@@ -494,6 +525,25 @@ test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
         }
     }
 
+  if (benchmark_mode)
+    {
+      AssertThrow(n_steps_taken == n_total_steps,
+                  ExcMessage("The simulation ended before the benchmark "
+                             "finished: increase END_TIME."));
+      phase_timings->stop(n_benchmark_steps);
+      phase_timings->add_value(
+        "n_lagrangian_cells_part_0",
+        ib_method_ops->get_part(0)
+          .get_triangulation()
+          .n_locally_owned_active_cells());
+      phase_timings->add_hierarchy_values(
+        patch_hierarchy,
+        ib_method_ops->get_lagrangian_workload_current_index());
+      phase_timings->write(
+        test_db->getStringWithDefault("benchmark_output_prefix",
+                                      "ifed_ex4-benchmark"));
+    }
+
   if (test_db->getBoolWithDefault("log_ends_of_fe_vectors", false))
     {
       const auto &part =
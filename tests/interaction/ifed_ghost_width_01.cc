@@ -0,0 +1,263 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/interaction/ifed_method.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/LEInteractor.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <HierarchySideDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <SideVariable.h>
+#include <StandardTagAndInitialize.h>
+#include <VariableDatabase.h>
+
+#include <array>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test the ghost widths required by IFEDMethod: with ghost_cell_fraction =
+// 2.5 the kernel needs two more ghost cells than usual. Spreading into data
+// with exactly that many ghost cells should give the same result as spreading
+// into data with more, and data with fewer should be rejected.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Give the test access to the Lagrangian force.
+template <int dim, int spacedim = dim>
+class TestIFEDMethod : public fdl::IFEDMethod<dim, spacedim>
+{
+public:
+  using fdl::IFEDMethod<dim, spacedim>::IFEDMethod;
+
+  // Compute the force at the start of the time step [t0, t1] so that it can
+  // be spread.
+  void
+  compute_force(const double t0, const double t1)
+  {
+    this->preprocessIntegrateData(t0, t1, 1);
+    this->computeLagrangianForce(t0);
+  }
+
+  // Discard the time step started by compute_force().
+  void
+  discard_time_step()
+  {
+    this->part_vectors.end_time_step();
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<dim>(0.5, 0.5), 0.2);
+  native_tria.refine_global(3);
+
+  // fiddle stuff: start from a deformed configuration so that the force is
+  // not zero
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), spacedim);
+  QGauss<dim>             quadrature(2);
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>> forces;
+  forces.emplace_back(
+    new fdl::ModifiedNeoHookeanStress<dim, spacedim>(quadrature, 1.0));
+  FunctionParser<spacedim> initial_position(
+    "X_0 + 0.1*X_1*X_1; X_1 - 0.05*X_0*X_1", "", "X_0,X_1");
+  std::vector<fdl::Part<dim, spacedim>> parts;
+  parts.emplace_back(native_tria, fe, std::move(forces), initial_position);
+  auto *ifed = new TestIFEDMethod<dim, spacedim>("ifed_method",
+                                                 input_db->getDatabase(
+                                                   "IFEDMethod"),
+                                                 std::move(parts));
+  tbox::Pointer<IBAMR::IBStrategy> ib_method_ops = ifed;
+
+  // Create major algorithm and data objects that comprise the
+  // application.  These objects are configured from the input database
+  // and, if this is a restarted run, from the restart database.
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry",
+      app_initializer->getComponentDatabase("CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::LoadBalancer<spacedim>> load_balancer =
+    new mesh::LoadBalancer<spacedim>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::BergerRigoutsos<spacedim>> box_generator =
+    new mesh::BergerRigoutsos<spacedim>();
+
+  tbox::Pointer<IBAMR::INSHierarchyIntegrator> navier_stokes_integrator =
+    new IBAMR::INSStaggeredHierarchyIntegrator(
+      "INSStaggeredHierarchyIntegrator",
+      app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+
+  tbox::Pointer<IBAMR::IBHierarchyIntegrator> time_integrator =
+    new IBAMR::IBExplicitHierarchyIntegrator(
+      "IBHierarchyIntegrator",
+      app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+      ib_method_ops,
+      navier_stokes_integrator);
+  time_integrator->registerLoadBalancer(load_balancer);
+
+  tbox::Pointer<mesh::StandardTagAndInitialize<spacedim>> error_detector =
+    new mesh::StandardTagAndInitialize<spacedim>(
+      "StandardTagAndInitialize",
+      time_integrator,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+  tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          app_initializer->getComponentDatabase(
+                                            "GriddingAlgorithm"),
+                                          error_detector,
+                                          box_generator,
+                                          load_balancer);
+
+  std::vector<solv::RobinBcCoefStrategy<spacedim> *> u_bc_coefs(spacedim);
+  // Create Eulerian boundary condition specification objects.
+  for (int d = 0; d < spacedim; ++d)
+    {
+      const std::string bc_coefs_name = "u_bc_coefs_" + std::to_string(d);
+
+      const std::string bc_coefs_db_name =
+        "VelocityBcCoefs_" + std::to_string(d);
+
+      u_bc_coefs[d] =
+        new IBTK::muParserRobinBcCoefs(bc_coefs_name,
+                                       app_initializer->getComponentDatabase(
+                                         bc_coefs_db_name),
+                                       grid_geometry);
+    }
+  navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+
+  // Eulerian data with exactly the required ghost width, a wider one, and a
+  // narrower one. These have to be registered before the hierarchy is set up.
+  const std::string kernel = input_db->getDatabase("IFEDMethod")
+                               ->getStringWithDefault("IB_kernel", "IB_4");
+  const double ghost_cell_fraction =
+    input_db->getDatabase("IFEDMethod")->getDouble("ghost_cell_fraction");
+  const int required_width =
+    IBTK::LEInteractor::getMinimumGhostWidth(kernel) +
+    int(std::ceil(ghost_cell_fraction)) - 1;
+  const std::array<int, 3> widths{
+    {required_width, required_width + 3, required_width - 1}};
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  std::array<int, 3> f_indices;
+  for (unsigned int i = 0; i < widths.size(); ++i)
+    {
+      tbox::Pointer<pdat::SideVariable<spacedim, double>> f_var =
+        new pdat::SideVariable<spacedim, double>("f_" +
+                                                 std::to_string(widths[i]));
+      f_indices[i] =
+        var_db->registerVariableAndContext(f_var,
+                                           var_db->getContext("test"),
+                                           hier::IntVector<spacedim>(
+                                             widths[i]));
+    }
+
+  // Initialize hierarchy configuration and data on all patches.
+  time_integrator->initializePatchHierarchy(patch_hierarchy,
+                                            gridding_algorithm);
+  fdl::fill_all(patch_hierarchy,
+                std::vector<int>(f_indices.begin(), f_indices.end()),
+                0,
+                patch_hierarchy->getFinestLevelNumber(),
+                0.0);
+
+  const hier::IntVector<spacedim> ghosts = ifed->getMinimumGhostCellWidth();
+  bool ghosts_match = true;
+  for (int d = 0; d < spacedim; ++d)
+    ghosts_match = ghosts_match && ghosts[d] == required_width;
+
+  const double t0 = time_integrator->getIntegratorTime();
+  const double t1 = t0 + time_integrator->getMaximumTimeStepSize();
+  ifed->compute_force(t0, t1);
+  ifed->spreadForce(f_indices[0], nullptr, {}, t0);
+  ifed->spreadForce(f_indices[1], nullptr, {}, t0);
+  bool spreading_rejected = false;
+  try
+    {
+      ifed->spreadForce(f_indices[2], nullptr, {}, t0);
+    }
+  catch (const std::exception &)
+    {
+      spreading_rejected = true;
+    }
+  bool interpolation_rejected = false;
+  try
+    {
+      ifed->interpolateVelocity(f_indices[2], {}, {}, t0);
+    }
+  catch (const std::exception &)
+    {
+      interpolation_rejected = true;
+    }
+  ifed->discard_time_step();
+
+  math::HierarchySideDataOpsReal<spacedim, double> f_ops(patch_hierarchy);
+  const double f_norm = f_ops.maxNorm(f_indices[1]);
+  f_ops.subtract(f_indices[0], f_indices[0], f_indices[1]);
+  const double difference = f_ops.maxNorm(f_indices[0]) / f_norm;
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "minimum ghost width includes ghost_cell_fraction = "
+             << (ghosts_match ? "yes" : "no") << '\n'
+             << "spreading with the minimum ghost width matches a wider one = "
+             << (f_norm > 0.0 && difference < 1e-14 ? "yes" : "no") << '\n'
+             << "spreading into a narrower ghost region is rejected = "
+             << (spreading_rejected ? "yes" : "no") << '\n'
+             << "interpolating from a narrower ghost region is rejected = "
+             << (interpolation_rejected ? "yes" : "no") << '\n';
+    }
+
+  for (auto ptr : u_bc_coefs)
+    delete ptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_ghost_width_01.log");
+
+  test<NDIM>(app_initializer);
+}
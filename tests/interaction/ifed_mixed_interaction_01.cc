@@ -0,0 +1,230 @@
+#include <fiddle/interaction/elemental_interaction.h>
+#include <fiddle/interaction/ifed_method.h>
+#include <fiddle/interaction/nodal_interaction.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserCartGridFunction.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <LoadBalancer.h>
+#include <SideVariable.h>
+#include <StandardTagAndInitialize.h>
+#include <VariableDatabase.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test choosing the interaction type per part: four copies of a ball use
+// ELEMENTAL, NODAL, NODAL, and ELEMENTAL interaction. Each part should have
+// the requested interaction object, the parts with the same type should
+// interpolate the same velocity, and the two types should interpolate
+// different velocities.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Give the test access to the interpolated velocities and to the interaction
+// objects.
+template <int dim, int spacedim = dim>
+class TestIFEDMethod : public fdl::IFEDMethod<dim, spacedim>
+{
+public:
+  using fdl::IFEDMethod<dim, spacedim>::IFEDMethod;
+
+  // Interpolate the velocity in @p u_idx at the start of the time step
+  // [t0, t1] and return it for each part. The time step is then discarded.
+  std::vector<LinearAlgebra::distributed::Vector<double>>
+  interpolate_velocity(const double t0, const double t1, const int u_idx)
+  {
+    this->preprocessIntegrateData(t0, t1, 1);
+    this->interpolateVelocity(u_idx, {}, {}, t0);
+    std::vector<LinearAlgebra::distributed::Vector<double>> velocities;
+    for (unsigned int part_n = 0; part_n < this->n_parts(); ++part_n)
+      velocities.push_back(this->part_vectors.get_velocity(part_n, t0));
+    this->part_vectors.end_time_step();
+    return velocities;
+  }
+
+  bool
+  uses_nodal_interaction(const unsigned int part_n) const
+  {
+    return dynamic_cast<const fdl::NodalInteraction<dim, spacedim> *>(
+             this->interactions[part_n].get()) != nullptr;
+  }
+
+  bool
+  uses_elemental_interaction(const unsigned int part_n) const
+  {
+    return dynamic_cast<const fdl::ElementalInteraction<dim, spacedim> *>(
+             this->interactions[part_n].get()) != nullptr;
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<dim>(0.5, 0.5), 0.2);
+  native_tria.refine_global(3);
+
+  // fiddle stuff:
+  constexpr unsigned int                n_parts = 4;
+  FESystem<dim, spacedim>               fe(FE_Q<dim, spacedim>(1), spacedim);
+  std::vector<fdl::Part<dim, spacedim>> parts;
+  for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+    parts.emplace_back(native_tria, fe);
+  auto *ifed = new TestIFEDMethod<dim, spacedim>("ifed_method",
+                                                 input_db->getDatabase(
+                                                   "IFEDMethod"),
+                                                 std::move(parts));
+  tbox::Pointer<IBAMR::IBStrategy> ib_method_ops = ifed;
+
+  // Create major algorithm and data objects that comprise the
+  // application.  These objects are configured from the input database
+  // and, if this is a restarted run, from the restart database.
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry",
+      app_initializer->getComponentDatabase("CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::LoadBalancer<spacedim>> load_balancer =
+    new mesh::LoadBalancer<spacedim>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::BergerRigoutsos<spacedim>> box_generator =
+    new mesh::BergerRigoutsos<spacedim>();
+
+  tbox::Pointer<IBAMR::INSHierarchyIntegrator> navier_stokes_integrator =
+    new IBAMR::INSStaggeredHierarchyIntegrator(
+      "INSStaggeredHierarchyIntegrator",
+      app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+
+  tbox::Pointer<IBAMR::IBHierarchyIntegrator> time_integrator =
+    new IBAMR::IBExplicitHierarchyIntegrator(
+      "IBHierarchyIntegrator",
+      app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+      ib_method_ops,
+      navier_stokes_integrator);
+  time_integrator->registerLoadBalancer(load_balancer);
+
+  tbox::Pointer<mesh::StandardTagAndInitialize<spacedim>> error_detector =
+    new mesh::StandardTagAndInitialize<spacedim>(
+      "StandardTagAndInitialize",
+      time_integrator,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+  tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          app_initializer->getComponentDatabase(
+                                            "GriddingAlgorithm"),
+                                          error_detector,
+                                          box_generator,
+                                          load_balancer);
+
+  std::vector<solv::RobinBcCoefStrategy<spacedim> *> u_bc_coefs(spacedim);
+  // Create Eulerian boundary condition specification objects.
+  for (int d = 0; d < spacedim; ++d)
+    {
+      const std::string bc_coefs_name = "u_bc_coefs_" + std::to_string(d);
+
+      const std::string bc_coefs_db_name =
+        "VelocityBcCoefs_" + std::to_string(d);
+
+      u_bc_coefs[d] =
+        new IBTK::muParserRobinBcCoefs(bc_coefs_name,
+                                       app_initializer->getComponentDatabase(
+                                         bc_coefs_db_name),
+                                       grid_geometry);
+    }
+  navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+
+  // The velocity, which has to be registered before the hierarchy is set up.
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  tbox::Pointer<pdat::SideVariable<spacedim, double>> u_var =
+    new pdat::SideVariable<spacedim, double>("u_test");
+  const int u_idx =
+    var_db->registerVariableAndContext(u_var,
+                                       var_db->getContext("test"),
+                                       hier::IntVector<spacedim>(4));
+
+  // Initialize hierarchy configuration and data on all patches.
+  time_integrator->initializePatchHierarchy(patch_hierarchy,
+                                            gridding_algorithm);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    patch_hierarchy->getPatchLevel(ln)->allocatePatchData(u_idx, 0.0);
+  IBTK::muParserCartGridFunction u_fcn("u",
+                                       input_db->getDatabase("u"),
+                                       grid_geometry);
+  u_fcn.setDataOnPatchHierarchy(u_idx, u_var, patch_hierarchy, 0.0);
+
+  const double t0         = time_integrator->getIntegratorTime();
+  const double t1         = t0 + time_integrator->getMaximumTimeStepSize();
+  const auto   velocities = ifed->interpolate_velocity(t0, t1, u_idx);
+
+  const auto relative_difference =
+    [&](const unsigned int part_m, const unsigned int part_n)
+  {
+    auto difference = velocities[part_m];
+    difference -= velocities[part_n];
+    return difference.linfty_norm() / velocities[part_n].linfty_norm();
+  };
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+        output << "part " << part_n << " uses nodal interaction = "
+               << (ifed->uses_nodal_interaction(part_n) ? "yes" : "no")
+               << '\n'
+               << "part " << part_n << " uses elemental interaction = "
+               << (ifed->uses_elemental_interaction(part_n) ? "yes" : "no")
+               << '\n';
+      output << "elemental parts interpolate the same velocity = "
+             << (relative_difference(0, 3) < 1e-14 ? "yes" : "no") << '\n'
+             << "nodal parts interpolate the same velocity = "
+             << (relative_difference(1, 2) < 1e-14 ? "yes" : "no") << '\n'
+             << "elemental and nodal velocities differ = "
+             << (relative_difference(0, 1) > 1e-8 ? "yes" : "no") << '\n';
+    }
+
+  for (auto ptr : u_bc_coefs)
+    delete ptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_mixed_interaction_01.log");
+
+  test<NDIM>(app_initializer);
+}
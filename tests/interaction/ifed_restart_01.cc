@@ -0,0 +1,143 @@
+#include <fiddle/interaction/ifed_method.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <tbox/MemoryDatabase.h>
+
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test that restart files written asynchronously are identical to the ones
+// written synchronously and that the second asynchronous write waits for the
+// first one to finish.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+std::string
+read_file(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+}
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  auto       ifed_db  = input_db->getDatabase("IFEDMethod");
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<dim>(0.5, 0.5), 0.2);
+  native_tria.refine_global(3);
+
+  // Use a nontrivial position and velocity so that the restart files contain
+  // more than the identity function and zeros
+  FESystem<dim, spacedim>  fe(FE_Q<dim, spacedim>(2), spacedim);
+  FunctionParser<spacedim> initial_position("X_0 + 0.1*X_1; X_1 - 0.05*X_0",
+                                            "",
+                                            "X_0,X_1");
+  FunctionParser<spacedim> initial_velocity("sin(X_1); cos(X_0)",
+                                            "",
+                                            "X_0,X_1");
+  const auto make_parts = [&]() {
+    std::vector<fdl::Part<dim, spacedim>> parts;
+    parts.emplace_back(
+      native_tria,
+      fe,
+      std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>>(),
+      initial_position,
+      initial_velocity);
+    return parts;
+  };
+
+  // Write two restart files with each method
+  const std::array<std::string, 2> directories{
+    {"synchronous_restart", "asynchronous_restart"}};
+  const auto get_filename = [&](const std::string &directory,
+                                const unsigned int n) {
+    return directory + "/ifed_method." + Utilities::int_to_string(n, 6) + "." +
+           Utilities::int_to_string(rank, 6);
+  };
+  bool first_write_finished = true;
+  for (unsigned int i = 0; i < directories.size(); ++i)
+    {
+      ifed_db->putString("restart_file_directory", directories[i]);
+      ifed_db->putBool("asynchronous_restart_files", i == 1);
+      tbox::Pointer<fdl::IFEDMethod<dim, spacedim>> ifed =
+        new fdl::IFEDMethod<dim, spacedim>("ifed_method",
+                                           ifed_db,
+                                           make_parts(),
+                                           false);
+      tbox::Pointer<tbox::Database> db0 = new tbox::MemoryDatabase("db0");
+      ifed->putToDatabase(db0);
+      tbox::Pointer<tbox::Database> db1 = new tbox::MemoryDatabase("db1");
+      ifed->putToDatabase(db1);
+      // The second write only starts after the first one finished and moved
+      // its temporary file into place
+      if (i == 1)
+        first_write_finished =
+          std::ifstream(get_filename(directories[i], 0)).good() &&
+          !std::ifstream(get_filename(directories[i], 0) + ".tmp").good();
+      // the destructor waits for the second write
+    }
+
+  std::array<bool, 2> files_match;
+  for (unsigned int n = 0; n < files_match.size(); ++n)
+    {
+      const std::string synchronous =
+        read_file(get_filename(directories[0], n));
+      const std::string asynchronous =
+        read_file(get_filename(directories[1], n));
+      files_match[n] = !synchronous.empty() && synchronous == asynchronous;
+      files_match[n] = Utilities::MPI::min(int(files_match[n]), mpi_comm) == 1;
+    }
+  first_write_finished =
+    Utilities::MPI::min(int(first_write_finished), mpi_comm) == 1;
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      for (unsigned int n = 0; n < files_match.size(); ++n)
+        output << "restart file " << n << " matches synchronous write = "
+               << (files_match[n] ? "yes" : "no") << '\n';
+      output << "first write finished before the second started = "
+             << (first_write_finished ? "yes" : "no") << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_restart_01.log");
+
+  test<NDIM>(app_initializer);
+}
@@ -0,0 +1,237 @@
+#include <fiddle/interaction/ifed_method.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test force subcycling: with a nonlinear stress, the force computed with
+// n_force_subcycles substeps should be the average of the forces at the
+// midpoints of the substeps, each of which is computed separately without
+// subcycling.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Give the test access to the forces, which are normally only used
+// internally to compute the Eulerian force.
+template <int dim, int spacedim = dim>
+class TestIFEDMethod : public fdl::IFEDMethod<dim, spacedim>
+{
+public:
+  using fdl::IFEDMethod<dim, spacedim>::IFEDMethod;
+
+  // Compute the force at the midpoint of the time step [t0, t1], at the end
+  // of which the part is at @p new_position, with @p n_subcycles substeps.
+  // The time step is then discarded so that the part does not move.
+  LinearAlgebra::distributed::Vector<double>
+  compute_midpoint_force(
+    const double                                      t0,
+    const double                                      t1,
+    const LinearAlgebra::distributed::Vector<double> &new_position,
+    const int                                         n_subcycles)
+  {
+    this->n_force_subcycles[0] = n_subcycles;
+    this->preprocessIntegrateData(t0, t1, 1);
+    this->part_vectors.set_position(0, t1, new_position);
+    const double half_time = this->half_time;
+    this->computeLagrangianForce(half_time);
+    LinearAlgebra::distributed::Vector<double> force =
+      this->part_vectors.get_force(0, half_time);
+    this->part_vectors.end_time_step();
+    return force;
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<dim>(0.5, 0.5), 0.2);
+  native_tria.refine_global(3);
+
+  // fiddle stuff:
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), spacedim);
+  QGauss<dim>             quadrature(2);
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>> forces;
+  forces.emplace_back(
+    new fdl::ModifiedNeoHookeanStress<dim, spacedim>(quadrature, 1.0));
+  std::vector<fdl::Part<dim, spacedim>> parts;
+  parts.emplace_back(native_tria, fe, std::move(forces));
+  auto *ifed = new TestIFEDMethod<dim, spacedim>("ifed_method",
+                                                 input_db->getDatabase(
+                                                   "IFEDMethod"),
+                                                 std::move(parts));
+  tbox::Pointer<IBAMR::IBStrategy> ib_method_ops = ifed;
+
+  // Create major algorithm and data objects that comprise the
+  // application.  These objects are configured from the input database
+  // and, if this is a restarted run, from the restart database.
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry",
+      app_initializer->getComponentDatabase("CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::LoadBalancer<spacedim>> load_balancer =
+    new mesh::LoadBalancer<spacedim>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::BergerRigoutsos<spacedim>> box_generator =
+    new mesh::BergerRigoutsos<spacedim>();
+
+  tbox::Pointer<IBAMR::INSHierarchyIntegrator> navier_stokes_integrator =
+    new IBAMR::INSStaggeredHierarchyIntegrator(
+      "INSStaggeredHierarchyIntegrator",
+      app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+
+  tbox::Pointer<IBAMR::IBHierarchyIntegrator> time_integrator =
+    new IBAMR::IBExplicitHierarchyIntegrator(
+      "IBHierarchyIntegrator",
+      app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+      ib_method_ops,
+      navier_stokes_integrator);
+  time_integrator->registerLoadBalancer(load_balancer);
+
+  tbox::Pointer<mesh::StandardTagAndInitialize<spacedim>> error_detector =
+    new mesh::StandardTagAndInitialize<spacedim>(
+      "StandardTagAndInitialize",
+      time_integrator,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+  tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          app_initializer->getComponentDatabase(
+                                            "GriddingAlgorithm"),
+                                          error_detector,
+                                          box_generator,
+                                          load_balancer);
+
+  std::vector<solv::RobinBcCoefStrategy<spacedim> *> u_bc_coefs(spacedim);
+  // Create Eulerian boundary condition specification objects.
+  for (int d = 0; d < spacedim; ++d)
+    {
+      const std::string bc_coefs_name = "u_bc_coefs_" + std::to_string(d);
+
+      const std::string bc_coefs_db_name =
+        "VelocityBcCoefs_" + std::to_string(d);
+
+      u_bc_coefs[d] =
+        new IBTK::muParserRobinBcCoefs(bc_coefs_name,
+                                       app_initializer->getComponentDatabase(
+                                         bc_coefs_db_name),
+                                       grid_geometry);
+    }
+  navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+
+  // Initialize hierarchy configuration and data on all patches.
+  time_integrator->initializePatchHierarchy(patch_hierarchy,
+                                            gridding_algorithm);
+
+  // Start and end positions of a time step: the end position is a nonuniform
+  // deformation, so the force is a nonlinear function of the position
+  const auto &part      = ifed->get_part(0);
+  const auto &x_current = part.get_position();
+  FunctionParser<spacedim> deformation("X_0 + 0.1*X_1*X_1; X_1 - 0.05*X_0*X_1",
+                                       "",
+                                       "X_0,X_1");
+  LinearAlgebra::distributed::Vector<double> x_new(part.get_partitioner());
+  VectorTools::interpolate(part.get_dof_handler(), deformation, x_new);
+  x_new.update_ghost_values();
+  const double t0 = time_integrator->getIntegratorTime();
+  const double t1 = t0 + time_integrator->getMaximumTimeStepSize();
+
+  const int  n_subcycles    = 4;
+  const auto midpoint_force = ifed->compute_midpoint_force(t0, t1, x_new, 1);
+  const auto subcycled_force =
+    ifed->compute_midpoint_force(t0, t1, x_new, n_subcycles);
+
+  // Compute the average of the forces at the substep positions
+  // x_s = (1 - s) x_current + s x_new by picking the end positions whose
+  // midpoints are x_s, i.e., 2 x_s - x_current.
+  LinearAlgebra::distributed::Vector<double> average_force(
+    part.get_partitioner());
+  for (int k = 0; k < n_subcycles; ++k)
+    {
+      const double s = (k + 0.5) / n_subcycles;
+      LinearAlgebra::distributed::Vector<double> end_position(
+        part.get_partitioner());
+      end_position.equ(1.0 - 2.0 * s, x_current);
+      end_position.add(2.0 * s, x_new);
+      end_position.update_ghost_values();
+      average_force.add(1.0 / n_subcycles,
+                        ifed->compute_midpoint_force(t0, t1, end_position, 1));
+    }
+
+  const auto relative_difference =
+    [](const LinearAlgebra::distributed::Vector<double> &a,
+       const LinearAlgebra::distributed::Vector<double> &b) {
+      LinearAlgebra::distributed::Vector<double> difference(a);
+      difference -= b;
+      return difference.linfty_norm() / b.linfty_norm();
+    };
+  const double average_difference =
+    relative_difference(subcycled_force, average_force);
+  const double midpoint_difference =
+    relative_difference(subcycled_force, midpoint_force);
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "subcycled force matches average of substep forces = "
+             << (average_difference < 1e-8 ? "yes" : "no") << '\n'
+             << "subcycled force differs from midpoint force = "
+             << (midpoint_difference > 1e-4 ? "yes" : "no") << '\n';
+    }
+
+  for (auto ptr : u_bc_coefs)
+    delete ptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_subcycling_01.log");
+
+  test<NDIM>(app_initializer);
+}
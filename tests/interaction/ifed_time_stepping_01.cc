@@ -0,0 +1,179 @@
+#include <fiddle/interaction/ifed_method.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test the AB2 forwardEulerStep() and trapezoidalStep() without an Eulerian
+// grid: the velocity at the end of each time step is set directly to
+// u(x) = x, which is exactly representable by the nodal velocity. Each update
+// is compared with the formula of the corresponding method applied to the
+// initial position.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Give the test access to the velocities which are normally interpolated from
+// the Eulerian grid.
+template <int dim, int spacedim = dim>
+class TestIFEDMethod : public fdl::IFEDMethod<dim, spacedim>
+{
+public:
+  using fdl::IFEDMethod<dim, spacedim>::IFEDMethod;
+
+  const LinearAlgebra::distributed::Vector<double> &
+  get_position(const double time) const
+  {
+    return this->part_vectors.get_position(0, time);
+  }
+
+  // Set the velocity at @p time to u(x) = x.
+  void
+  set_velocity_from_position(const double time)
+  {
+    this->part_vectors.set_velocity(0,
+                                    time,
+                                    this->part_vectors.get_position(0, time));
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  auto       ifed_db  = input_db->getDatabase("IFEDMethod");
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<dim>(0.5, 0.5), 0.2);
+  native_tria.refine_global(2);
+
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), spacedim);
+
+  const auto make_method = [&](const std::string &step_type) {
+    ifed_db->putString("forward_euler_step_type", step_type);
+    std::vector<fdl::Part<dim, spacedim>> parts;
+    parts.emplace_back(
+      native_tria,
+      fe,
+      std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>>(),
+      Functions::IdentityFunction<spacedim>(),
+      Functions::IdentityFunction<spacedim>());
+    return std::make_unique<TestIFEDMethod<dim, spacedim>>("ifed_method",
+                                                            ifed_db,
+                                                            std::move(parts),
+                                                            false);
+  };
+
+  // Relative difference between a computed position and x0 times a scalar.
+  const auto difference =
+    [](const LinearAlgebra::distributed::Vector<double> &position,
+       const LinearAlgebra::distributed::Vector<double> &x0,
+       const double                                      factor) {
+      LinearAlgebra::distributed::Vector<double> expected(x0);
+      expected *= factor;
+      const double norm = expected.linfty_norm();
+      expected -= position;
+      return expected.linfty_norm() / norm;
+    };
+  const double tolerance = 1e-14;
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  // AB2 with two different step sizes
+  {
+    auto         ifed = make_method("AB2");
+    const auto   x0   = ifed->get_part(0).get_position();
+    const double dt0  = 0.1;
+    const double dt1  = 0.05;
+    const double t0   = 0.0;
+    const double t1   = t0 + dt0;
+    const double t2   = t1 + dt1;
+
+    // The first step has no previous velocity and falls back to forward
+    // Euler: x1 = x0 + dt0 u0 = (1 + dt0) x0
+    ifed->preprocessIntegrateData(t0, t1, 1);
+    ifed->forwardEulerStep(t0, t1);
+    const double first_step = difference(ifed->get_position(t1), x0, 1 + dt0);
+    ifed->set_velocity_from_position(t1);
+    ifed->postprocessIntegrateData(t0, t1, 1);
+    if (rank == 0)
+      output << "first AB2 step is forward Euler = "
+             << (first_step < tolerance ? "yes" : "no") << '\n';
+
+    // x2 = x1 + dt1 (1 + r/2) u1 - dt1 r/2 u0, with r = dt1/dt0, u1 = x1, and
+    // u0 = x0
+    ifed->preprocessIntegrateData(t1, t2, 1);
+    ifed->forwardEulerStep(t1, t2);
+    const double r = dt1 / dt0;
+    const double second_step =
+      difference(ifed->get_position(t2),
+                 x0,
+                 (1 + dt0) * (1 + dt1 * (1 + 0.5 * r)) - 0.5 * dt1 * r);
+    ifed->set_velocity_from_position(t2);
+    ifed->postprocessIntegrateData(t1, t2, 1);
+    if (rank == 0)
+      output << "second AB2 step matches formula = "
+             << (second_step < tolerance ? "yes" : "no") << '\n';
+  }
+
+  // Trapezoidal step: IBAMR sets the velocity at the end time at the forward
+  // Euler position x* = (1 + dt) x0, so x1 = x0 + dt/2 (x0 + x*)
+  {
+    auto         ifed = make_method("FORWARD_EULER");
+    const auto   x0   = ifed->get_part(0).get_position();
+    const double dt   = 0.1;
+    const double t0   = 0.0;
+    const double t1   = t0 + dt;
+
+    ifed->preprocessIntegrateData(t0, t1, 1);
+    ifed->forwardEulerStep(t0, t1);
+    ifed->set_velocity_from_position(t1);
+    ifed->trapezoidalStep(t0, t1);
+    const double step =
+      difference(ifed->get_position(t1), x0, 1 + dt + 0.5 * dt * dt);
+    ifed->postprocessIntegrateData(t0, t1, 1);
+    const double final_step =
+      difference(ifed->get_part(0).get_position(), x0, 1 + dt + 0.5 * dt * dt);
+    if (rank == 0)
+      output << "trapezoidal step matches formula = "
+             << (step < tolerance && final_step < tolerance ? "yes" : "no")
+             << '\n';
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_time_stepping_01.log");
+
+  test<NDIM>(app_initializer);
+}
@@ -0,0 +1,278 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/box_utilities.h>
+
+#include <fiddle/interaction/ifed_method.h>
+
+#include <deal.II/base/bounding_box.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserCartGridFunction.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <BergerRigoutsos.h>
+#include <BoxArray.h>
+#include <CartesianGridGeometry.h>
+#include <LoadBalancer.h>
+#include <SideVariable.h>
+#include <StandardTagAndInitialize.h>
+#include <VariableDatabase.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test restrict_velocity_fill: interpolating the velocity to a small ball
+// after only filling the patches near it should give the same result as
+// interpolating after filling every patch. Only the patches near the ball
+// should be filled.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Give the test access to the interpolated velocity and to the patches
+// selected by restrict_velocity_fill.
+template <int dim, int spacedim = dim>
+class TestIFEDMethod : public fdl::IFEDMethod<dim, spacedim>
+{
+public:
+  using fdl::IFEDMethod<dim, spacedim>::IFEDMethod;
+
+  // Interpolate the velocity in @p u_idx at the start of the time step
+  // [t0, t1] and return it. The time step is then discarded.
+  LinearAlgebra::distributed::Vector<double>
+  interpolate_velocity(const double t0,
+                       const double t1,
+                       const int    u_idx,
+                       const bool   restrict_velocity_fill)
+  {
+    this->input_db->putBool("restrict_velocity_fill", restrict_velocity_fill);
+    this->preprocessIntegrateData(t0, t1, 1);
+    this->interpolateVelocity(u_idx, {}, {}, t0);
+    LinearAlgebra::distributed::Vector<double> velocity =
+      this->part_vectors.get_velocity(0, t0);
+    this->part_vectors.end_time_step();
+    return velocity;
+  }
+
+  // Whether or not each patch of level @p ln of the secondary hierarchy is
+  // filled by restrict_velocity_fill.
+  std::vector<bool>
+  get_filled_patches(const int ln, const int u_idx)
+  {
+    const auto &fill = this->get_restricted_velocity_fill(ln, u_idx);
+    std::vector<bool> filled(this->secondary_hierarchy.getSecondaryHierarchy()
+                               ->getPatchLevel(ln)
+                               ->getNumberOfPatches(),
+                             false);
+    for (const int patch_n : fill.patch_numbers)
+      filled[patch_n] = true;
+    return filled;
+  }
+
+  tbox::Pointer<hier::PatchLevel<spacedim>>
+  get_secondary_level(const int ln)
+  {
+    return this->secondary_hierarchy.getSecondaryHierarchy()->getPatchLevel(
+      ln);
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  // A small ball, so that it is only near a few patches
+  GridGenerator::hyper_ball(native_tria, Point<dim>(0.35, 0.35), 0.05);
+  native_tria.refine_global(3);
+
+  // fiddle stuff:
+  FESystem<dim, spacedim>               fe(FE_Q<dim, spacedim>(1), spacedim);
+  std::vector<fdl::Part<dim, spacedim>> parts;
+  parts.emplace_back(native_tria, fe);
+  auto *ifed = new TestIFEDMethod<dim, spacedim>("ifed_method",
+                                                 input_db->getDatabase(
+                                                   "IFEDMethod"),
+                                                 std::move(parts));
+  tbox::Pointer<IBAMR::IBStrategy> ib_method_ops = ifed;
+
+  // Create major algorithm and data objects that comprise the
+  // application.  These objects are configured from the input database
+  // and, if this is a restarted run, from the restart database.
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry",
+      app_initializer->getComponentDatabase("CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::LoadBalancer<spacedim>> load_balancer =
+    new mesh::LoadBalancer<spacedim>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::BergerRigoutsos<spacedim>> box_generator =
+    new mesh::BergerRigoutsos<spacedim>();
+
+  tbox::Pointer<IBAMR::INSHierarchyIntegrator> navier_stokes_integrator =
+    new IBAMR::INSStaggeredHierarchyIntegrator(
+      "INSStaggeredHierarchyIntegrator",
+      app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+
+  tbox::Pointer<IBAMR::IBHierarchyIntegrator> time_integrator =
+    new IBAMR::IBExplicitHierarchyIntegrator(
+      "IBHierarchyIntegrator",
+      app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+      ib_method_ops,
+      navier_stokes_integrator);
+  time_integrator->registerLoadBalancer(load_balancer);
+
+  tbox::Pointer<mesh::StandardTagAndInitialize<spacedim>> error_detector =
+    new mesh::StandardTagAndInitialize<spacedim>(
+      "StandardTagAndInitialize",
+      time_integrator,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+  tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          app_initializer->getComponentDatabase(
+                                            "GriddingAlgorithm"),
+                                          error_detector,
+                                          box_generator,
+                                          load_balancer);
+
+  std::vector<solv::RobinBcCoefStrategy<spacedim> *> u_bc_coefs(spacedim);
+  // Create Eulerian boundary condition specification objects.
+  for (int d = 0; d < spacedim; ++d)
+    {
+      const std::string bc_coefs_name = "u_bc_coefs_" + std::to_string(d);
+
+      const std::string bc_coefs_db_name =
+        "VelocityBcCoefs_" + std::to_string(d);
+
+      u_bc_coefs[d] =
+        new IBTK::muParserRobinBcCoefs(bc_coefs_name,
+                                       app_initializer->getComponentDatabase(
+                                         bc_coefs_db_name),
+                                       grid_geometry);
+    }
+  navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+
+  // The velocity, which has to be registered before the hierarchy is set up.
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  tbox::Pointer<pdat::SideVariable<spacedim, double>> u_var =
+    new pdat::SideVariable<spacedim, double>("u_test");
+  const int u_idx =
+    var_db->registerVariableAndContext(u_var,
+                                       var_db->getContext("test"),
+                                       hier::IntVector<spacedim>(4));
+
+  // Initialize hierarchy configuration and data on all patches.
+  time_integrator->initializePatchHierarchy(patch_hierarchy,
+                                            gridding_algorithm);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    patch_hierarchy->getPatchLevel(ln)->allocatePatchData(u_idx, 0.0);
+  IBTK::muParserCartGridFunction u_fcn("u",
+                                       input_db->getDatabase("u"),
+                                       grid_geometry);
+  u_fcn.setDataOnPatchHierarchy(u_idx, u_var, patch_hierarchy, 0.0);
+
+  const double t0 = time_integrator->getIntegratorTime();
+  const double t1 = t0 + time_integrator->getMaximumTimeStepSize();
+  const auto   full_velocity = ifed->interpolate_velocity(t0, t1, u_idx, false);
+  const auto   restricted_velocity =
+    ifed->interpolate_velocity(t0, t1, u_idx, true);
+  auto difference = restricted_velocity;
+  difference -= full_velocity;
+  const double relative_difference =
+    difference.linfty_norm() / full_velocity.linfty_norm();
+
+  // Check the filled patches against the bounding box of the whole ball:
+  // every filled patch, grown by one cell (i.e., ghost_cell_fraction), should
+  // intersect it, and every patch containing a vertex of the ball should be
+  // filled.
+  const int  ln     = patch_hierarchy->getFinestLevelNumber();
+  const auto filled = ifed->get_filled_patches(ln, u_idx);
+  const auto level  = ifed->get_secondary_level(ln);
+  const hier::BoxArray<spacedim> &boxes = level->getBoxes();
+  // The ball is not deformed, so its vertices are its current position
+  std::vector<Point<spacedim>> vertices;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    for (const unsigned int v : cell->vertex_indices())
+      vertices.push_back(cell->vertex(v));
+  const BoundingBox<spacedim> ball_bbox(vertices);
+  unsigned int n_filled                 = 0;
+  bool         filled_patches_are_near  = true;
+  bool         patches_with_ball_filled = true;
+  for (int patch_n = 0; patch_n < boxes.getNumberOfBoxes(); ++patch_n)
+    {
+      hier::Box<spacedim> box        = boxes[patch_n];
+      const auto          patch_bbox = fdl::box_to_bbox(box, level);
+      box.grow(hier::IntVector<spacedim>(1));
+      const auto grown_bbox = fdl::box_to_bbox(box, level);
+      if (filled[patch_n])
+        {
+          ++n_filled;
+          filled_patches_are_near =
+            filled_patches_are_near &&
+            grown_bbox.get_neighbor_type(ball_bbox) !=
+              NeighborType::not_neighbors;
+        }
+      else
+        for (const auto &vertex : vertices)
+          patches_with_ball_filled =
+            patches_with_ball_filled && !patch_bbox.point_inside(vertex);
+    }
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "restricted fill interpolates the same velocity = "
+             << (full_velocity.linfty_norm() > 0.0 &&
+                     relative_difference < 1e-14 ?
+                   "yes" :
+                   "no")
+             << '\n'
+             << "some patches are not filled = "
+             << (n_filled < boxes.getNumberOfBoxes() ? "yes" : "no") << '\n'
+             << "filled patches are near the ball = "
+             << (filled_patches_are_near ? "yes" : "no") << '\n'
+             << "patches containing the ball are filled = "
+             << (patches_with_ball_filled ? "yes" : "no") << '\n';
+    }
+
+  for (auto ptr : u_bc_coefs)
+    delete ptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_velocity_fill_01.log");
+
+  test<NDIM>(app_initializer);
+}
@@ -0,0 +1,254 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/interaction/ifed_method.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <HierarchySideDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <SideVariable.h>
+#include <StandardTagAndInitialize.h>
+#include <VariableDatabase.h>
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Test spread_weak_force: the force of an elemental part computed with it
+// should be the same as the one computed with mass_matrix_type = LUMPED and
+// spread in the usual (strong) form, and both should differ from the force
+// computed with the consistent mass matrix.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Give the test access to the Lagrangian force and to the options read when
+// the interactions are set up.
+template <int dim, int spacedim = dim>
+class TestIFEDMethod : public fdl::IFEDMethod<dim, spacedim>
+{
+public:
+  using fdl::IFEDMethod<dim, spacedim>::IFEDMethod;
+
+  // Set the mass matrix type and spread_weak_force and set up the
+  // interactions again so that they use the new value of the latter.
+  void
+  set_force_projection(const std::string &mass_matrix_type,
+                       const bool         spread_weak_force)
+  {
+    this->input_db->putString("mass_matrix_type", mass_matrix_type);
+    this->input_db->putBool("spread_weak_force", spread_weak_force);
+    this->reinit_interactions();
+  }
+
+  // Compute the force at the start of the time step [t0, t1], spread it into
+  // @p f_data_idx, and return it. The time step is then discarded.
+  LinearAlgebra::distributed::Vector<double>
+  compute_and_spread_force(const double t0, const double t1, const int f_idx)
+  {
+    this->preprocessIntegrateData(t0, t1, 1);
+    this->computeLagrangianForce(t0);
+    this->spreadForce(f_idx, nullptr, {}, t0);
+    LinearAlgebra::distributed::Vector<double> force =
+      this->part_vectors.get_force(0, t0);
+    this->part_vectors.end_time_step();
+    return force;
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<dim>(0.5, 0.5), 0.2);
+  native_tria.refine_global(3);
+
+  // fiddle stuff: start from a deformed configuration so that the force is
+  // not zero
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), spacedim);
+  QGauss<dim>             quadrature(2);
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>> forces;
+  forces.emplace_back(
+    new fdl::ModifiedNeoHookeanStress<dim, spacedim>(quadrature, 1.0));
+  FunctionParser<spacedim> initial_position(
+    "X_0 + 0.1*X_1*X_1; X_1 - 0.05*X_0*X_1", "", "X_0,X_1");
+  std::vector<fdl::Part<dim, spacedim>> parts;
+  parts.emplace_back(native_tria, fe, std::move(forces), initial_position);
+  auto *ifed = new TestIFEDMethod<dim, spacedim>("ifed_method",
+                                                 input_db->getDatabase(
+                                                   "IFEDMethod"),
+                                                 std::move(parts));
+  tbox::Pointer<IBAMR::IBStrategy> ib_method_ops = ifed;
+
+  // Create major algorithm and data objects that comprise the
+  // application.  These objects are configured from the input database
+  // and, if this is a restarted run, from the restart database.
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry",
+      app_initializer->getComponentDatabase("CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::LoadBalancer<spacedim>> load_balancer =
+    new mesh::LoadBalancer<spacedim>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::BergerRigoutsos<spacedim>> box_generator =
+    new mesh::BergerRigoutsos<spacedim>();
+
+  tbox::Pointer<IBAMR::INSHierarchyIntegrator> navier_stokes_integrator =
+    new IBAMR::INSStaggeredHierarchyIntegrator(
+      "INSStaggeredHierarchyIntegrator",
+      app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+
+  tbox::Pointer<IBAMR::IBHierarchyIntegrator> time_integrator =
+    new IBAMR::IBExplicitHierarchyIntegrator(
+      "IBHierarchyIntegrator",
+      app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+      ib_method_ops,
+      navier_stokes_integrator);
+  time_integrator->registerLoadBalancer(load_balancer);
+
+  tbox::Pointer<mesh::StandardTagAndInitialize<spacedim>> error_detector =
+    new mesh::StandardTagAndInitialize<spacedim>(
+      "StandardTagAndInitialize",
+      time_integrator,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+  tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          app_initializer->getComponentDatabase(
+                                            "GriddingAlgorithm"),
+                                          error_detector,
+                                          box_generator,
+                                          load_balancer);
+
+  std::vector<solv::RobinBcCoefStrategy<spacedim> *> u_bc_coefs(spacedim);
+  // Create Eulerian boundary condition specification objects.
+  for (int d = 0; d < spacedim; ++d)
+    {
+      const std::string bc_coefs_name = "u_bc_coefs_" + std::to_string(d);
+
+      const std::string bc_coefs_db_name =
+        "VelocityBcCoefs_" + std::to_string(d);
+
+      u_bc_coefs[d] =
+        new IBTK::muParserRobinBcCoefs(bc_coefs_name,
+                                       app_initializer->getComponentDatabase(
+                                         bc_coefs_db_name),
+                                       grid_geometry);
+    }
+  navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+
+  // One Eulerian force per way of computing the Lagrangian force. These have
+  // to be registered before the hierarchy is set up.
+  const std::array<std::string, 3> names{{"consistent", "lumped", "weak"}};
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  tbox::Pointer<pdat::SideVariable<spacedim, double>> f_var =
+    new pdat::SideVariable<spacedim, double>("f_test");
+  std::vector<int> f_indices(names.size());
+  for (unsigned int i = 0; i < names.size(); ++i)
+    f_indices[i] =
+      var_db->registerVariableAndContext(f_var,
+                                         var_db->getContext(names[i]),
+                                         hier::IntVector<spacedim>(4));
+
+  // Initialize hierarchy configuration and data on all patches.
+  time_integrator->initializePatchHierarchy(patch_hierarchy,
+                                            gridding_algorithm);
+  fdl::fill_all(patch_hierarchy,
+                f_indices,
+                0,
+                patch_hierarchy->getFinestLevelNumber(),
+                0.0);
+
+  const double t0 = time_integrator->getIntegratorTime();
+  const double t1 = t0 + time_integrator->getMaximumTimeStepSize();
+  std::vector<LinearAlgebra::distributed::Vector<double>> lagrangian_forces;
+  ifed->set_force_projection("CONSISTENT", false);
+  lagrangian_forces.push_back(
+    ifed->compute_and_spread_force(t0, t1, f_indices[0]));
+  ifed->set_force_projection("LUMPED", false);
+  lagrangian_forces.push_back(
+    ifed->compute_and_spread_force(t0, t1, f_indices[1]));
+  ifed->set_force_projection("CONSISTENT", true);
+  lagrangian_forces.push_back(
+    ifed->compute_and_spread_force(t0, t1, f_indices[2]));
+
+  const auto relative_difference =
+    [](const LinearAlgebra::distributed::Vector<double> &a,
+       const LinearAlgebra::distributed::Vector<double> &b) {
+      LinearAlgebra::distributed::Vector<double> difference(a);
+      difference -= b;
+      return difference.linfty_norm() / b.linfty_norm();
+    };
+  const double lumped_difference =
+    relative_difference(lagrangian_forces[2], lagrangian_forces[1]);
+  const double consistent_difference =
+    relative_difference(lagrangian_forces[2], lagrangian_forces[0]);
+
+  // The spread forces are also equal (and stored in the same patches)
+  math::HierarchySideDataOpsReal<spacedim, double> f_ops(patch_hierarchy);
+  const double lumped_norm = f_ops.maxNorm(f_indices[1]);
+  f_ops.subtract(f_indices[2], f_indices[2], f_indices[1]);
+  const double eulerian_difference = f_ops.maxNorm(f_indices[2]) / lumped_norm;
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "weak force matches lumped force = "
+             << (lumped_difference < 1e-14 ? "yes" : "no") << '\n'
+             << "weak force differs from consistent force = "
+             << (consistent_difference > 1e-4 ? "yes" : "no") << '\n'
+             << "spread weak force matches spread lumped force = "
+             << (lumped_norm > 0.0 && eulerian_difference < 1e-14 ? "yes" :
+                                                                    "no")
+             << '\n';
+    }
+
+  for (auto ptr : u_bc_coefs)
+    delete ptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ifed_weak_force_01.log");
+
+  test<NDIM>(app_initializer);
+}
@@ -0,0 +1,140 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/interaction_base.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Verify that InteractionBase shares overlap DoFHandlers between native
+// DoFHandlers with the same DoFs and reuses them when reinitialized with the
+// same overlap triangulation.
+
+template <int dim, int spacedim = dim>
+class TestInteraction : public fdl::InteractionBase<dim, spacedim>
+{
+public:
+  using fdl::InteractionBase<dim, spacedim>::InteractionBase;
+  using fdl::InteractionBase<dim, spacedim>::get_overlap_dof_handler;
+};
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.0625, 0.5, 2, 0.0);
+  native_tria.refine_global(3);
+
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+
+  const auto level_number = patch_hierarchy->getFinestLevelNumber();
+  TestInteraction<dim, spacedim> interaction(
+    input_db,
+    native_tria,
+    cell_bboxes,
+    {},
+    patch_hierarchy,
+    std::make_pair(level_number, level_number));
+
+  FESystem<dim>             position_fe(FE_Q<dim>(1), dim);
+  DoFHandler<dim, spacedim> position_dof_handler(native_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  DoFHandler<dim, spacedim> velocity_dof_handler(native_tria);
+  velocity_dof_handler.distribute_dofs(position_fe);
+
+  FESystem<dim>             F_fe(FE_DGQ<dim>(0), dim);
+  DoFHandler<dim, spacedim> F_dof_handler(native_tria);
+  F_dof_handler.distribute_dofs(F_fe);
+
+  interaction.add_dof_handler(position_dof_handler);
+  interaction.add_dof_handler(F_dof_handler);
+  interaction.add_dof_handler(velocity_dof_handler);
+
+  const DoFHandler<dim, spacedim> *overlap_position_dof_handler =
+    &interaction.get_overlap_dof_handler(position_dof_handler);
+  const DoFHandler<dim, spacedim> *overlap_F_dof_handler =
+    &interaction.get_overlap_dof_handler(F_dof_handler);
+  const bool same_fe_shared =
+    overlap_position_dof_handler ==
+    &interaction.get_overlap_dof_handler(velocity_dof_handler);
+  const bool different_fe_shared =
+    overlap_position_dof_handler == overlap_F_dof_handler;
+
+  // Nothing moved, so everything should be reused
+  interaction.reinit(input_db,
+                     native_tria,
+                     cell_bboxes,
+                     {},
+                     patch_hierarchy,
+                     std::make_pair(level_number, level_number));
+  interaction.add_dof_handler(velocity_dof_handler);
+  interaction.add_dof_handler(F_dof_handler);
+  interaction.add_dof_handler(position_dof_handler);
+  const bool reused =
+    overlap_position_dof_handler ==
+      &interaction.get_overlap_dof_handler(position_dof_handler) &&
+    overlap_position_dof_handler ==
+      &interaction.get_overlap_dof_handler(velocity_dof_handler) &&
+    overlap_F_dof_handler ==
+      &interaction.get_overlap_dof_handler(F_dof_handler);
+
+  const int all_same_fe_shared =
+    Utilities::MPI::min(int(same_fe_shared), mpi_comm);
+  const int all_different_fe_shared =
+    Utilities::MPI::max(int(different_fe_shared), mpi_comm);
+  const int all_reused = Utilities::MPI::min(int(reused), mpi_comm);
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "same FE shared: " << all_same_fe_shared << '\n'
+             << "different FE shared: " << all_different_fe_shared << '\n'
+             << "reused after reinit: " << all_reused << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "interaction_base_02.log");
+
+  test<2>(app_initializer);
+}
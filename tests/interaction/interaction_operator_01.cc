@@ -0,0 +1,207 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe_field.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that interpolation and spreading with an InteractionOperator give the
+// same results as with the InteractionPlan from which it was computed.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  // Use a curved position field so that the test does not only check affine
+  // mappings:
+  const FESystem<dim, spacedim> position_fe(FE_Q<dim, spacedim>(2), spacedim);
+  DoFHandler<dim, spacedim>     position_dof_handler(overlap_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  Vector<double> position(position_dof_handler.n_dofs());
+  VectorTools::interpolate(position_dof_handler,
+                           FunctionParser<spacedim>("1.1*x + 0.1*y*y;0.9*y"),
+                           position);
+  const MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+    position_dof_handler, position);
+
+  const std::vector<Quadrature<dim>> quadratures(
+    {QGauss<dim>(2), QGauss<dim>(3)});
+  std::vector<unsigned char> quadrature_indices;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    quadrature_indices.push_back(cell->active_cell_index() % 2);
+
+  fdl::InteractionPlan<dim, spacedim> plan;
+  fdl::compute_interaction_plan(patch_map,
+                                position_dof_handler,
+                                position,
+                                quadrature_indices,
+                                quadratures,
+                                plan);
+
+  const int n_F_components = get_n_f_components(input_db);
+  const FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), n_F_components);
+  DoFHandler<dim, spacedim>     F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(fe);
+  const MappingQ<dim, spacedim> F_map(1);
+
+  fdl::InteractionOperator<dim, spacedim> op;
+  fdl::compute_interaction_operator("BSPLINE_3",
+                                    f_idx,
+                                    patch_map,
+                                    plan,
+                                    quadrature_indices,
+                                    quadratures,
+                                    F_dof_handler,
+                                    F_map,
+                                    op);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  // interpolate:
+  {
+    Vector<double> F_plan_rhs(F_dof_handler.n_dofs());
+    fdl::compute_projection_rhs("BSPLINE_3",
+                                f_idx,
+                                patch_map,
+                                plan,
+                                quadrature_indices,
+                                quadratures,
+                                F_dof_handler,
+                                F_map,
+                                F_plan_rhs);
+    Vector<double> F_op_rhs(F_dof_handler.n_dofs());
+    fdl::compute_projection_rhs(op, patch_map, F_op_rhs);
+
+    // The operator sums the same terms in a different order, so the results
+    // are only equal up to roundoff
+    F_op_rhs -= F_plan_rhs;
+    const double max_difference =
+      Utilities::MPI::max(F_op_rhs.linfty_norm(), mpi_comm);
+    if (rank == 0)
+      output << "interpolation difference = " << max_difference << std::endl;
+  }
+
+  // spread:
+  {
+    auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+    SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+    var_db->mapIndexToVariable(f_idx, f_var);
+    const int e_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+    for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+      patch_hierarchy->getPatchLevel(ln)->allocatePatchData(e_idx, 0.0);
+    for (auto &patch : patches)
+      {
+        fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+        fdl::fill_all(patch->getPatchData(e_idx), 0.0);
+      }
+
+    Vector<double> F(F_dof_handler.n_dofs());
+    for (unsigned int i = 0; i < F.size(); ++i)
+      F[i] = std::sin(double(i));
+
+    fdl::compute_spread("BSPLINE_3",
+                        f_idx,
+                        patch_map,
+                        plan,
+                        quadrature_indices,
+                        quadratures,
+                        F_dof_handler,
+                        F_map,
+                        F);
+    // The operator spreads into the data index with which it was computed,
+    // so swap the results afterwards
+    for (auto &patch : patches)
+      {
+        patch->getPatchData(e_idx)->copy(*patch->getPatchData(f_idx));
+        fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+      }
+    fdl::compute_spread(op, patch_map, F);
+
+    auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+    ops->subtract(e_idx, e_idx, f_idx);
+    const double max_difference = ops->maxNorm(e_idx);
+    if (rank == 0)
+      output << "spreading difference = " << max_difference << std::endl;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,271 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe_field.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <CellData.h>
+#include <CellIterator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that compressing an InteractionPlan reduces the number of points,
+// preserves the total spread force, and changes the results of interpolation
+// and spreading by less with a smaller compression tolerance.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  // Use a curved position field so that the test does not only check affine
+  // mappings:
+  const FESystem<dim, spacedim> position_fe(FE_Q<dim, spacedim>(2), spacedim);
+  DoFHandler<dim, spacedim>     position_dof_handler(overlap_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  Vector<double> position(position_dof_handler.n_dofs());
+  VectorTools::interpolate(position_dof_handler,
+                           FunctionParser<spacedim>("1.1*x + 0.1*y*y;0.9*y"),
+                           position);
+  const MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+    position_dof_handler, position);
+
+  const std::vector<Quadrature<dim>> quadratures(
+    {QGauss<dim>(2), QGauss<dim>(3)});
+  std::vector<unsigned char> quadrature_indices;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    quadrature_indices.push_back(cell->active_cell_index() % 2);
+
+  fdl::InteractionPlan<dim, spacedim> plan;
+  fdl::compute_interaction_plan(patch_map,
+                                position_dof_handler,
+                                position,
+                                quadrature_indices,
+                                quadratures,
+                                plan);
+
+  const int n_F_components = get_n_f_components(input_db);
+  const FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), n_F_components);
+  DoFHandler<dim, spacedim>     F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(fe);
+  const MappingQ<dim, spacedim> F_map(1);
+
+  // Merge the quadrature points with two different tolerances
+  const std::vector<double> tolerances = {0.5, 0.125};
+  std::vector<fdl::InteractionPlan<dim, spacedim>> compressed_plans;
+  for (const double tolerance : tolerances)
+    {
+      compressed_plans.push_back(plan);
+      fdl::compress_interaction_plan(patch_map,
+                                     tolerance,
+                                     compressed_plans.back());
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  std::size_t n_q_points          = 0;
+  std::size_t n_compressed_points = 0;
+  for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+    {
+      n_q_points += plan.patch_q_points[patch_n].size();
+      n_compressed_points +=
+        compressed_plans[0].patch_compressed_q_points[patch_n].size();
+    }
+  n_q_points          = Utilities::MPI::sum(n_q_points, mpi_comm);
+  n_compressed_points = Utilities::MPI::sum(n_compressed_points, mpi_comm);
+  if (rank == 0)
+    output << "uncompressed plan is compressed = "
+           << (plan.is_compressed() ? "yes" : "no") << '\n'
+           << "compressed plan is compressed = "
+           << (compressed_plans[0].is_compressed() ? "yes" : "no") << '\n'
+           << "compression reduces the number of points = "
+           << (n_compressed_points < n_q_points ? "yes" : "no") << '\n';
+
+  // interpolate:
+  {
+    Vector<double> F_rhs(F_dof_handler.n_dofs());
+    fdl::compute_projection_rhs("BSPLINE_3",
+                                f_idx,
+                                patch_map,
+                                plan,
+                                quadrature_indices,
+                                quadratures,
+                                F_dof_handler,
+                                F_map,
+                                F_rhs);
+    const double norm = Utilities::MPI::max(F_rhs.linfty_norm(), mpi_comm);
+
+    std::vector<double> errors;
+    for (const auto &compressed_plan : compressed_plans)
+      {
+        Vector<double> F_compressed_rhs(F_dof_handler.n_dofs());
+        fdl::compute_projection_rhs("BSPLINE_3",
+                                    f_idx,
+                                    patch_map,
+                                    compressed_plan,
+                                    quadrature_indices,
+                                    quadratures,
+                                    F_dof_handler,
+                                    F_map,
+                                    F_compressed_rhs);
+        F_compressed_rhs -= F_rhs;
+        errors.push_back(
+          Utilities::MPI::max(F_compressed_rhs.linfty_norm(), mpi_comm) /
+          norm);
+      }
+    if (rank == 0)
+      output << "smaller tolerance interpolates more accurately = "
+             << (errors[1] < errors[0] ? "yes" : "no") << '\n';
+  }
+
+  // spread:
+  {
+    auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+    SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+    var_db->mapIndexToVariable(f_idx, f_var);
+    const int e_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+    for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+      patch_hierarchy->getPatchLevel(ln)->allocatePatchData(e_idx, 0.0);
+    auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+
+    // Sum of the spread values in every cell (including ghost cells), i.e.,
+    // the total spread force divided by the cell volume
+    const auto total = [&](const int data_idx) {
+      double result = 0.0;
+      for (auto &patch : patches)
+        {
+          const tbox::Pointer<pdat::CellData<spacedim, double>> data =
+            patch->getPatchData(data_idx);
+          for (pdat::CellIterator<spacedim> it(data->getGhostBox()); it; it++)
+            for (int d = 0; d < data->getDepth(); ++d)
+              result += (*data)(it(), d);
+        }
+      return Utilities::MPI::sum(result, mpi_comm);
+    };
+
+    Vector<double> F(F_dof_handler.n_dofs());
+    for (unsigned int i = 0; i < F.size(); ++i)
+      F[i] = 1.0 + std::sin(double(i));
+
+    for (auto &patch : patches)
+      fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+    fdl::compute_spread("BSPLINE_3",
+                        f_idx,
+                        patch_map,
+                        plan,
+                        quadrature_indices,
+                        quadratures,
+                        F_dof_handler,
+                        F_map,
+                        F);
+    const double        norm        = ops->maxNorm(f_idx);
+    const double        total_force = total(f_idx);
+    std::vector<double> errors;
+    double              max_total_difference = 0.0;
+    for (const auto &compressed_plan : compressed_plans)
+      {
+        for (auto &patch : patches)
+          fdl::fill_all(patch->getPatchData(e_idx), 0.0);
+        fdl::compute_spread("BSPLINE_3",
+                            e_idx,
+                            patch_map,
+                            compressed_plan,
+                            quadrature_indices,
+                            quadratures,
+                            F_dof_handler,
+                            F_map,
+                            F);
+        max_total_difference =
+          std::max(max_total_difference,
+                   std::abs(total(e_idx) - total_force) / total_force);
+        ops->subtract(e_idx, e_idx, f_idx);
+        errors.push_back(ops->maxNorm(e_idx) / norm);
+      }
+    if (rank == 0)
+      output << "compressed spreading preserves the total force = "
+             << (max_total_difference < 1e-12 ? "yes" : "no") << '\n'
+             << "smaller tolerance spreads more accurately = "
+             << (errors[1] < errors[0] ? "yes" : "no") << '\n';
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "interaction_plan_03.log");
+
+  test<2>(app_initializer);
+}
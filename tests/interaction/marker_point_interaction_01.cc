@@ -0,0 +1,144 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/interaction/marker_point_interaction.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/SAMRAIGhostDataAccumulator.h>
+
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <CellIterator.h>
+
+#include <array>
+#include <fstream>
+
+#include "../tests.h"
+
+// Test interpolation to and spreading from marker points, including points
+// which moved more than one cell after reinit() and a point on the upper
+// boundary of the domain.
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup SAMRAI stuff (its always the same):
+  auto       tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto       patch_hierarchy = std::get<0>(tuple);
+  auto       f_idx           = std::get<5>(tuple);
+  const int  level_number    = patch_hierarchy->getFinestLevelNumber();
+  const auto patches =
+    fdl::extract_patches(patch_hierarchy->getPatchLevel(level_number));
+
+  // The last point is on the upper boundary of the domain.
+  const std::vector<std::array<double, spacedim>> points = {
+    {{0.3, 0.4}}, {{0.55, 0.45}}, {{1.0, 0.5}}};
+  Vector<double> position(points.size() * spacedim);
+  for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      position[point_n * spacedim + d] = points[point_n][d];
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  fdl::MarkerPointInteraction<spacedim> interaction(
+    input_db, mpi_comm, patch_hierarchy, level_number, position);
+  const auto print_values = [&](const std::string    &label,
+                                const Vector<double> &values) {
+    if (rank == 0)
+      {
+        output << label << '\n';
+        for (std::size_t point_n = 0; point_n + 1 < points.size(); ++point_n)
+          output << "point " << point_n << ": "
+                 << values[point_n * spacedim + 0] << ", "
+                 << values[point_n * spacedim + 1] << '\n';
+      }
+  };
+
+  Vector<double> values;
+  interaction.interpolate("BSPLINE_3", f_idx, position, values);
+  print_values("interpolated values", values);
+  // The value at the last point depends on the extrapolation into the ghost
+  // cells, so only check that it was interpolated
+  if (rank == 0)
+    output << "point on the upper boundary interpolated = "
+           << (values[(points.size() - 1) * spacedim] != 0.0 ? "yes" : "no")
+           << '\n';
+
+  // Move the interior points by 2.5 cells: owners cannot interpolate these
+  // so this uses the max reduction instead
+  const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
+    patches.back()->getPatchGeometry();
+  const double   dx = geometry->getDx()[0];
+  Vector<double> moved_position(position);
+  for (std::size_t point_n = 0; point_n + 1 < points.size(); ++point_n)
+    moved_position[point_n * spacedim] += 2.5 * dx;
+  interaction.interpolate("BSPLINE_3", f_idx, moved_position, values);
+  print_values("interpolated values at moved points", values);
+
+  // Spread some forces from the interior points. Kernels sum to one, so the
+  // total force on the grid is the sum of the forces.
+  for (auto &patch : patches)
+    fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+  Vector<double> forces(position.size());
+  forces[0] = 1.0;
+  forces[1] = 2.0;
+  forces[2] = 3.0;
+  forces[3] = -1.0;
+  interaction.spread("BSPLINE_3", f_idx, position, forces);
+
+  tbox::Pointer<hier::Variable<spacedim>> f_var;
+  hier::VariableDatabase<spacedim>::getDatabase()->mapIndexToVariable(f_idx,
+                                                                      f_var);
+  IBTK::SAMRAIGhostDataAccumulator acc(patch_hierarchy,
+                                       f_var,
+                                       hier::IntVector<spacedim>(3),
+                                       level_number,
+                                       level_number);
+  acc.accumulateGhostData(f_idx);
+
+  std::array<double, spacedim> total_force{};
+  for (const auto &patch : patches)
+    {
+      const tbox::Pointer<pdat::CellData<spacedim, double>> f_data =
+        patch->getPatchData(f_idx);
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+        patch->getPatchGeometry();
+      double cell_volume = 1.0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        cell_volume *= pgeom->getDx()[d];
+      for (pdat::CellIterator<spacedim> it(patch->getBox()); it; it++)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          total_force[d] += (*f_data)(it(), d) * cell_volume;
+    }
+  for (unsigned int d = 0; d < spacedim; ++d)
+    total_force[d] = Utilities::MPI::sum(total_force[d], mpi_comm);
+  if (rank == 0)
+    output << "total spread force: " << total_force[0] << ", "
+           << total_force[1] << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "marker_point_interaction_01.log");
+
+  test<2>(app_initializer);
+}
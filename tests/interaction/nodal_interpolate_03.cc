@@ -0,0 +1,176 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/nodal_interaction.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <CartesianGridGeometry.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that interpolating from owners computes the same values as the max
+// reduction, including for nodes on the upper boundary of the domain and for
+// nodes which moved more than one cell since the interaction was set up.
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  const auto test_db = input_db->getDatabase("test");
+  GridGenerator::hyper_cube(native_tria,
+                            test_db->getDoubleWithDefault("left", 0.0),
+                            test_db->getDoubleWithDefault("right", 1.0));
+  native_tria.refine_global(
+    test_db->getIntegerWithDefault("n_global_refinements", 3));
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  FESystem<dim, spacedim>   position_fe(FE_Q<dim, spacedim>(1), spacedim);
+  DoFHandler<dim, spacedim> position_dof_handler(native_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+
+  IndexSet locally_relevant_position_dofs;
+  DoFTools::extract_locally_relevant_dofs(position_dof_handler,
+                                          locally_relevant_position_dofs);
+  auto position_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    position_dof_handler.locally_owned_dofs(),
+    locally_relevant_position_dofs,
+    mpi_comm);
+  LinearAlgebra::distributed::Vector<double> position(position_partitioner);
+  VectorTools::interpolate(position_dof_handler,
+                           Functions::IdentityFunction<spacedim>(),
+                           position);
+  position.update_ghost_values();
+
+  // Move every node by some number of cells in each coordinate direction
+  // after setting up the interaction:
+  const tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geom =
+    patch_hierarchy->getGridGeometry();
+  const double shift =
+    test_db->getDoubleWithDefault("shift", 0.0) * grid_geom->getDx()[0];
+  LinearAlgebra::distributed::Vector<double> shifted_position(
+    position_partitioner);
+  for (const auto dof : position_dof_handler.locally_owned_dofs())
+    shifted_position[dof] = position[dof] + shift;
+  shifted_position.update_ghost_values();
+
+  FE_Q<dim, spacedim>       F_fe(1);
+  DoFHandler<dim, spacedim> F_dof_handler(native_tria);
+  F_dof_handler.distribute_dofs(F_fe);
+  const MappingQ<dim, spacedim> F_mapping(1);
+
+  IndexSet locally_relevant_F_dofs;
+  DoFTools::extract_locally_relevant_dofs(F_dof_handler,
+                                          locally_relevant_F_dofs);
+  auto F_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    F_dof_handler.locally_owned_dofs(), locally_relevant_F_dofs, mpi_comm);
+
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+
+  const auto interpolate = [&](const bool interpolate_from_owners) {
+    input_db->putBool("interpolate_from_owners", interpolate_from_owners);
+    fdl::NodalInteraction<dim, spacedim> interaction(
+      input_db,
+      native_tria,
+      cell_bboxes,
+      patch_hierarchy,
+      std::make_pair(0, patch_hierarchy->getFinestLevelNumber()),
+      position_dof_handler,
+      position);
+    interaction.add_dof_handler(F_dof_handler);
+
+    LinearAlgebra::distributed::Vector<double> F(F_partitioner);
+    interaction.interpolate("BSPLINE_3",
+                            f_idx,
+                            position_dof_handler,
+                            shifted_position,
+                            F_dof_handler,
+                            F_mapping,
+                            F);
+    return F;
+  };
+  const LinearAlgebra::distributed::Vector<double> owners_F =
+    interpolate(true);
+  const LinearAlgebra::distributed::Vector<double> max_F = interpolate(false);
+
+  // The interpolated function is positive, so zero values were not
+  // interpolated. The max reduction does not interpolate nodes exactly on the
+  // upper boundary of the domain, so only compare the other values.
+  unsigned int n_owners_zero = 0;
+  double       max_difference = 0.0;
+  for (const auto dof : F_dof_handler.locally_owned_dofs())
+    {
+      if (owners_F[dof] == 0.0)
+        ++n_owners_zero;
+      if (max_F[dof] != 0.0)
+        max_difference =
+          std::max(max_difference, std::abs(owners_F[dof] - max_F[dof]));
+    }
+  n_owners_zero  = Utilities::MPI::sum(n_owners_zero, mpi_comm);
+  max_difference = Utilities::MPI::max(max_difference, mpi_comm);
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "number of nodes = " << F_dof_handler.n_dofs() << '\n'
+             << "nodes not interpolated from owners = " << n_owners_zero
+             << '\n'
+             << "owners match max reduction = "
+             << (max_difference < 1e-12 ? "yes" : "no") << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,227 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/nodal_interaction.h>
+#include <fiddle/interaction/transaction_scheduler.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <CartesianGridGeometry.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test interpolating from owners with two parts whose transactions are run by
+// a TransactionScheduler. The nodes of the second part moved more than one
+// cell since its interaction was set up, so it falls back to the max
+// reduction while the first part does not. The scheduler advances the
+// transactions in a different order on each processor, so this checks that
+// the two parts do not mix up their checks of whether or not the nodes are
+// still owned.
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+  const tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geom =
+    patch_hierarchy->getGridGeometry();
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  constexpr unsigned int n_parts = 2;
+  std::vector<std::unique_ptr<parallel::shared::Triangulation<dim, spacedim>>>
+    trias;
+  for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+    trias.emplace_back(
+      std::make_unique<parallel::shared::Triangulation<dim, spacedim>>(
+        mpi_comm, Triangulation<dim, spacedim>::none, false, partitioner));
+  GridGenerator::hyper_cube(*trias[0], 0.25, 0.75);
+  trias[0]->refine_global(3);
+  GridGenerator::hyper_ball(*trias[1], Point<spacedim>(0.5, 0.5), 0.2);
+  trias[1]->refine_global(3);
+  // Only the second part moves further than one cell
+  const std::array<double, n_parts> shifts{
+    {0.5 * grid_geom->getDx()[0], 2.5 * grid_geom->getDx()[0]}};
+
+  FESystem<dim, spacedim>       position_fe(FE_Q<dim, spacedim>(1), spacedim);
+  FE_Q<dim, spacedim>           F_fe(1);
+  const MappingQ<dim, spacedim> F_mapping(1);
+
+  std::vector<std::unique_ptr<DoFHandler<dim, spacedim>>> position_dof_handlers;
+  std::vector<std::unique_ptr<DoFHandler<dim, spacedim>>> F_dof_handlers;
+  std::vector<LinearAlgebra::distributed::Vector<double>> positions;
+  std::vector<LinearAlgebra::distributed::Vector<double>> shifted_positions;
+  std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>
+    F_partitioners;
+  std::vector<std::vector<BoundingBox<spacedim, float>>> cell_bboxes(n_parts);
+  for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+    {
+      position_dof_handlers.emplace_back(
+        std::make_unique<DoFHandler<dim, spacedim>>(*trias[part_n]));
+      position_dof_handlers[part_n]->distribute_dofs(position_fe);
+      IndexSet locally_relevant_position_dofs;
+      DoFTools::extract_locally_relevant_dofs(*position_dof_handlers[part_n],
+                                              locally_relevant_position_dofs);
+      auto position_partitioner =
+        std::make_shared<Utilities::MPI::Partitioner>(
+          position_dof_handlers[part_n]->locally_owned_dofs(),
+          locally_relevant_position_dofs,
+          mpi_comm);
+      positions.emplace_back(position_partitioner);
+      VectorTools::interpolate(*position_dof_handlers[part_n],
+                               Functions::IdentityFunction<spacedim>(),
+                               positions[part_n]);
+      positions[part_n].update_ghost_values();
+      shifted_positions.emplace_back(position_partitioner);
+      for (const auto dof : position_dof_handlers[part_n]->locally_owned_dofs())
+        shifted_positions[part_n][dof] =
+          positions[part_n][dof] + shifts[part_n];
+      shifted_positions[part_n].update_ghost_values();
+
+      F_dof_handlers.emplace_back(
+        std::make_unique<DoFHandler<dim, spacedim>>(*trias[part_n]));
+      F_dof_handlers[part_n]->distribute_dofs(F_fe);
+      IndexSet locally_relevant_F_dofs;
+      DoFTools::extract_locally_relevant_dofs(*F_dof_handlers[part_n],
+                                              locally_relevant_F_dofs);
+      F_partitioners.emplace_back(std::make_shared<Utilities::MPI::Partitioner>(
+        F_dof_handlers[part_n]->locally_owned_dofs(),
+        locally_relevant_F_dofs,
+        mpi_comm));
+
+      for (const auto &cell : trias[part_n]->active_cell_iterators())
+        {
+          BoundingBox<spacedim, float> fbbox;
+          fbbox.get_boundary_points() =
+            cell->bounding_box().get_boundary_points();
+          cell_bboxes[part_n].push_back(fbbox);
+        }
+    }
+
+  const auto setup_interactions = [&](const bool interpolate_from_owners) {
+    input_db->putBool("interpolate_from_owners", interpolate_from_owners);
+    std::vector<std::unique_ptr<fdl::NodalInteraction<dim, spacedim>>>
+      interactions;
+    for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+      {
+        interactions.emplace_back(
+          std::make_unique<fdl::NodalInteraction<dim, spacedim>>(
+            input_db,
+            *trias[part_n],
+            cell_bboxes[part_n],
+            patch_hierarchy,
+            std::make_pair(0, patch_hierarchy->getFinestLevelNumber()),
+            *position_dof_handlers[part_n],
+            positions[part_n]));
+        interactions[part_n]->add_dof_handler(*F_dof_handlers[part_n]);
+      }
+    return interactions;
+  };
+
+  // Interpolate from owners with the scheduler
+  auto owner_interactions = setup_interactions(true);
+  std::vector<LinearAlgebra::distributed::Vector<double>> owners_F;
+  for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+    owners_F.emplace_back(F_partitioners[part_n]);
+  fdl::TransactionScheduler scheduler;
+  for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+    scheduler.add_projection_rhs_transaction(
+      *owner_interactions[part_n],
+      owner_interactions[part_n]->compute_projection_rhs_scatter_start(
+        "BSPLINE_3",
+        f_idx,
+        *position_dof_handlers[part_n],
+        shifted_positions[part_n],
+        *F_dof_handlers[part_n],
+        F_mapping,
+        owners_F[part_n]));
+  scheduler.run();
+
+  // Interpolate each part separately with the max reduction
+  auto max_interactions = setup_interactions(false);
+  std::vector<LinearAlgebra::distributed::Vector<double>> max_F;
+  for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+    {
+      max_F.emplace_back(F_partitioners[part_n]);
+      max_interactions[part_n]->interpolate("BSPLINE_3",
+                                            f_idx,
+                                            *position_dof_handlers[part_n],
+                                            shifted_positions[part_n],
+                                            *F_dof_handlers[part_n],
+                                            F_mapping,
+                                            max_F[part_n]);
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  for (unsigned int part_n = 0; part_n < n_parts; ++part_n)
+    {
+      // The interpolated function is positive, so zero values were not
+      // interpolated
+      unsigned int n_zero         = 0;
+      double       max_difference = 0.0;
+      for (const auto dof : F_dof_handlers[part_n]->locally_owned_dofs())
+        {
+          if (owners_F[part_n][dof] == 0.0)
+            ++n_zero;
+          max_difference =
+            std::max(max_difference,
+                     std::abs(owners_F[part_n][dof] - max_F[part_n][dof]));
+        }
+      n_zero         = Utilities::MPI::sum(n_zero, mpi_comm);
+      max_difference = Utilities::MPI::max(max_difference, mpi_comm);
+      if (rank == 0)
+        output << "part " << part_n
+               << " nodes not interpolated = " << n_zero << '\n'
+               << "part " << part_n << " matches max reduction = "
+               << (max_difference < 1e-12 ? "yes" : "no") << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "nodal_interpolate_04.log");
+
+  test<2>(app_initializer);
+}
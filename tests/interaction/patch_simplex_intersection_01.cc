@@ -0,0 +1,149 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/patch_intersection_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <CartesianPatchGeometry.h>
+#include <CellIterator.h>
+
+#include <algorithm>
+#include <fstream>
+#include <tuple>
+
+#include "../tests.h"
+
+// Test that intersect_patch_with_simplex() finds the same intersections as
+// calling intersect_stencil_with_simplex() for every stencil of each patch.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  auto       test_db  = input_db->getDatabase("test");
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  auto       tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto       patch_hierarchy = std::get<0>(tuple);
+  const auto patches         = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+
+  Triangulation<spacedim - 1, spacedim> tria;
+  GridGenerator::hyper_sphere(
+    tria,
+    Point<spacedim>(test_db->getDouble("circle_center_x_coordinate"),
+                    test_db->getDouble("circle_center_y_coordinate")),
+    test_db->getDouble("circle_radius"));
+  tria.refine_global(test_db->getIntegerWithDefault("n_global_refinements", 4));
+
+  using Intersection = std::tuple<hier::Index<spacedim>, unsigned int, double>;
+  const auto index_less = [](const Intersection &a, const Intersection &b) {
+    for (unsigned int d = 0; d < spacedim; ++d)
+      if (std::get<0>(a)(d) != std::get<0>(b)(d))
+        return std::get<0>(a)(d) < std::get<0>(b)(d);
+    return std::get<1>(a) < std::get<1>(b);
+  };
+
+  unsigned int n_intersections = 0;
+  unsigned int n_mismatches    = 0;
+  double       max_difference  = 0.0;
+  for (const auto &patch : patches)
+    {
+      const hier::Box<spacedim> &box = patch->getBox();
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+        patch->getPatchGeometry();
+      const double *const dx      = pgeom->getDx();
+      const double *const x_lower = pgeom->getXLower();
+
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          std::array<Point<spacedim>, spacedim> simplex;
+          for (unsigned int v = 0; v < spacedim; ++v)
+            simplex[v] = cell->vertex(v);
+
+          fdl::internal::PatchSingleIntersections<spacedim> intersections;
+          fdl::intersect_patch_with_simplex<spacedim>(
+            simplex, patch, cell->level(), cell->index(), intersections);
+          std::vector<Intersection> batched;
+          for (std::size_t i = 0; i < intersections.axes.size(); ++i)
+            batched.emplace_back(intersections.lower_indices[i],
+                                 intersections.axes[i],
+                                 intersections.convex_coefficients[i]);
+
+          // Each stencil starts at a cell center and ends at the next cell
+          // center in the patch
+          std::vector<Intersection> scalar;
+          for (unsigned int axis = 0; axis < spacedim; ++axis)
+            for (pdat::CellIterator<spacedim> it(box); it; it++)
+              {
+                const hier::Index<spacedim> &index = it();
+                if (index(axis) == box.upper(axis))
+                  continue;
+                Point<spacedim> stencil_start;
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  stencil_start[d] =
+                    x_lower[d] + (index(d) - box.lower(d) + 0.5) * dx[d];
+                const auto convex_coefficient =
+                  fdl::intersect_stencil_with_simplex<spacedim - 1>(
+                    simplex, stencil_start, dx[axis], axis);
+                if (convex_coefficient && *convex_coefficient >= 0.0)
+                  scalar.emplace_back(index, axis, *convex_coefficient);
+              }
+
+          std::sort(batched.begin(), batched.end(), index_less);
+          std::sort(scalar.begin(), scalar.end(), index_less);
+          n_intersections += batched.size();
+          if (batched.size() != scalar.size())
+            {
+              ++n_mismatches;
+              continue;
+            }
+          for (std::size_t i = 0; i < batched.size(); ++i)
+            {
+              if (index_less(batched[i], scalar[i]) ||
+                  index_less(scalar[i], batched[i]))
+                ++n_mismatches;
+              else
+                max_difference =
+                  std::max(max_difference,
+                           std::abs(std::get<2>(batched[i]) -
+                                    std::get<2>(scalar[i])));
+            }
+        }
+    }
+  n_intersections = Utilities::MPI::sum(n_intersections, mpi_comm);
+  n_mismatches    = Utilities::MPI::sum(n_mismatches, mpi_comm);
+  max_difference  = Utilities::MPI::max(max_difference, mpi_comm);
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "found intersections = "
+             << (n_intersections > 0 ? "yes" : "no") << '\n'
+             << "batched intersections match scalar intersections = "
+             << (n_mismatches == 0 && max_difference < 1e-12 ? "yes" : "no")
+             << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "patch_simplex_intersection_01.log");
+
+  test<2>(app_initializer);
+}
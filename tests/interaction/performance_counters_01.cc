@@ -0,0 +1,96 @@
+#include <fiddle/interaction/performance_counters.h>
+
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+// Test PerformanceCounters: per-processor counters, totals, the bytes moved by
+// a Scatter in which every processor needs every dof, the JSON file, and the
+// summary
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 10;
+  const auto         n_dofs        = dofs_per_proc * n_procs;
+  IndexSet           local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+  std::vector<types::global_dof_index> overlap_dofs(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    overlap_dofs[i] = i;
+
+  LinearAlgebra::distributed::Vector<double> global(local_indices, comm);
+  Vector<double>                             overlap(n_dofs);
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm);
+
+  // counters are appended to the file, so remove it from a previous run
+  const std::string filename = "counters.jsonl";
+  if (rank == 0)
+    std::remove(filename.c_str());
+  const int ierr = MPI_Barrier(comm);
+  AssertThrowMPI(ierr);
+
+  fdl::PerformanceCounters counters(comm, filename);
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      counters.add("points", 10.0 * (rank + 1));
+      counters.add("points", 1.0);
+      counters.add("cg_iterations", step);
+      // only scatter in the second step
+      if (step == 1)
+        {
+          scatter.global_to_overlap_start(global, 0, overlap);
+          scatter.global_to_overlap_finish(global, overlap);
+        }
+      counters.finish_step(0.5 * (step + 1));
+    }
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n'
+      << "n_steps = " << counters.n_steps() << '\n'
+      << "scatter bytes sent = " << scatter.get_n_bytes_sent() << '\n'
+      << "scatter bytes received = " << scatter.get_n_bytes_received() << '\n'
+      << "missing counter = " << counters.get("missing") << '\n'
+      << "last step:\n";
+  for (const auto &pair : counters.get_step_counters())
+    out << "  " << pair.first << " = " << pair.second << '\n';
+  out << "total:\n";
+  for (const auto &pair : counters.get_total_counters())
+    out << "  " << pair.first << " = " << pair.second << '\n';
+
+  std::ostringstream summary;
+  counters.write_summary(summary);
+
+  const std::vector<std::string> all_out =
+    Utilities::MPI::gather(comm, out.str());
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      for (const auto &string : all_out)
+        output << string;
+
+      output << "JSON lines:\n";
+      std::ifstream json(filename);
+      output << json.rdbuf();
+
+      output << summary.str();
+    }
+}
@@ -0,0 +1,265 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/nodal_interaction.h>
+
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/part_vectors.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <CartesianGridGeometry.h>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test the overlap position cache of InteractionBase over a midpoint step:
+// spreading and interpolating at the half time step position should only
+// scatter it once and the cached position should be the same as a new
+// scatter. Changing the position or calling reinit() should invalidate the
+// cache.
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria, 0.25, 0.75);
+  native_tria.refine_global(3);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+  const auto level_numbers =
+    std::make_pair(0, patch_hierarchy->getFinestLevelNumber());
+
+  FESystem<dim, spacedim> position_fe(FE_Q<dim, spacedim>(1), spacedim);
+  std::vector<fdl::Part<dim, spacedim>> parts;
+  parts.emplace_back(native_tria, position_fe);
+  const DoFHandler<dim, spacedim> &position_dof_handler =
+    parts[0].get_dof_handler();
+
+  FE_Q<dim, spacedim>       F_fe(1);
+  DoFHandler<dim, spacedim> F_dof_handler(native_tria);
+  F_dof_handler.distribute_dofs(F_fe);
+  const MappingQ<dim, spacedim> F_mapping(1);
+  LinearAlgebra::distributed::Vector<double> F_rhs(
+    F_dof_handler.locally_owned_dofs(), mpi_comm);
+  LinearAlgebra::distributed::Vector<double> F_solution(
+    F_dof_handler.locally_owned_dofs(), mpi_comm);
+  F_solution = 1.0;
+
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+
+  fdl::NodalInteraction<dim, spacedim> interaction(input_db,
+                                                   native_tria,
+                                                   cell_bboxes,
+                                                   patch_hierarchy,
+                                                   level_numbers,
+                                                   position_dof_handler,
+                                                   parts[0].get_position());
+  interaction.add_dof_handler(F_dof_handler);
+
+  // Do a complete spreading or interpolation transaction at @p position and
+  // return whether or not it used the cached overlap position along with the
+  // overlap position
+  const auto do_transaction =
+    [&](const LinearAlgebra::distributed::Vector<double> &position,
+        const std::uint64_t                               position_state,
+        const bool                                        spread) {
+      interaction.set_position_state(position_state);
+      std::unique_ptr<fdl::TransactionBase> t_ptr;
+      if (spread)
+        {
+          t_ptr = interaction.compute_spread_scatter_start(
+            "BSPLINE_3",
+            f_idx,
+            position,
+            position_dof_handler,
+            F_mapping,
+            F_dof_handler,
+            F_solution);
+          t_ptr = interaction.compute_spread_scatter_finish(std::move(t_ptr));
+        }
+      else
+        {
+          t_ptr = interaction.compute_projection_rhs_scatter_start(
+            "BSPLINE_3",
+            f_idx,
+            position_dof_handler,
+            position,
+            F_dof_handler,
+            F_mapping,
+            F_rhs);
+          t_ptr =
+            interaction.compute_projection_rhs_scatter_finish(std::move(t_ptr));
+        }
+
+      const auto &trans =
+        dynamic_cast<const fdl::Transaction<dim, spacedim> &>(*t_ptr);
+      const auto result =
+        std::make_pair(trans.position_is_cached, trans.overlap_position);
+
+      if (spread)
+        {
+          t_ptr = interaction.compute_spread_intermediate(std::move(t_ptr));
+          interaction.compute_spread_finish(std::move(t_ptr));
+        }
+      else
+        {
+          t_ptr =
+            interaction.compute_projection_rhs_intermediate(std::move(t_ptr));
+          t_ptr = interaction.compute_projection_rhs_accumulate_start(
+            std::move(t_ptr));
+          interaction.compute_projection_rhs_accumulate_finish(
+            std::move(t_ptr));
+        }
+      return result;
+    };
+
+  // Combine results from every processor
+  const auto all = [&](const bool value) {
+    return Utilities::MPI::min(int(value), mpi_comm) == 1;
+  };
+  const auto any = [&](const bool value) {
+    return Utilities::MPI::max(int(value), mpi_comm) == 1;
+  };
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  // Set up a midpoint step in which the structure moves by half a cell
+  const double dt = 0.1;
+  const tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geom =
+    patch_hierarchy->getGridGeometry();
+  fdl::PartVectors<dim, spacedim> vectors(parts);
+  vectors.begin_time_step(0.0, dt);
+  LinearAlgebra::distributed::Vector<double> new_position(
+    parts[0].get_position());
+  new_position.add(0.5 * grid_geom->getDx()[0]);
+  vectors.set_position(0, dt, new_position);
+
+  const double        half_time  = 0.5 * dt;
+  const std::uint64_t half_state = vectors.get_position_state(0, half_time);
+  if (rank == 0)
+    output << "half position state is nonzero and stable = "
+           << (half_state != 0 &&
+                   half_state == vectors.get_position_state(0, half_time) ?
+                 "yes" :
+                 "no")
+           << '\n';
+
+  // Spread the force and then interpolate the velocity at the half time step
+  // position
+  const auto spread =
+    do_transaction(vectors.get_position(0, half_time), half_state, true);
+  const auto interpolate =
+    do_transaction(vectors.get_position(0, half_time), half_state, false);
+  // A transaction without a state always scatters
+  const auto fresh =
+    do_transaction(vectors.get_position(0, half_time), 0, false);
+  if (rank == 0)
+    output << "spreading used the cached position = "
+           << (any(spread.first) ? "yes" : "no") << '\n';
+  const bool interpolate_cached = all(interpolate.first);
+  const bool fresh_cached       = any(fresh.first);
+  const bool interpolate_matches =
+    all(interpolate.second == fresh.second && spread.second == fresh.second);
+  if (rank == 0)
+    output << "interpolation used the cached position = "
+           << (interpolate_cached ? "yes" : "no") << '\n'
+           << "transaction without a state used the cached position = "
+           << (fresh_cached ? "yes" : "no") << '\n'
+           << "cached position matches a new scatter = "
+           << (interpolate_matches ? "yes" : "no") << '\n';
+
+  // Changing the position changes its state, so the cache is not used
+  LinearAlgebra::distributed::Vector<double> moved_position(
+    vectors.get_position(0, half_time));
+  moved_position.add(0.25 * grid_geom->getDx()[0]);
+  vectors.set_position(0, half_time, moved_position);
+  const std::uint64_t moved_state = vectors.get_position_state(0, half_time);
+  const auto          moved =
+    do_transaction(vectors.get_position(0, half_time), moved_state, true);
+  const auto moved_fresh =
+    do_transaction(vectors.get_position(0, half_time), 0, true);
+  const bool moved_cached  = any(moved.first);
+  const bool moved_matches = all(moved.second == moved_fresh.second);
+  if (rank == 0)
+    output << "changed position state differs = "
+           << (moved_state != half_state ? "yes" : "no") << '\n'
+           << "changed position used the cached position = "
+           << (moved_cached ? "yes" : "no") << '\n'
+           << "changed position matches a new scatter = "
+           << (moved_matches ? "yes" : "no") << '\n';
+
+  // reinit() clears the cache even if the state is the same
+  interaction.reinit(input_db,
+                     native_tria,
+                     cell_bboxes,
+                     patch_hierarchy,
+                     level_numbers,
+                     position_dof_handler,
+                     parts[0].get_position());
+  interaction.add_dof_handler(F_dof_handler);
+  const auto after_reinit =
+    do_transaction(vectors.get_position(0, half_time), moved_state, false);
+  const auto after_reinit_again =
+    do_transaction(vectors.get_position(0, half_time), moved_state, true);
+  const bool reinit_cached       = any(after_reinit.first);
+  const bool reinit_again_cached = all(after_reinit_again.first);
+  if (rank == 0)
+    output << "first transaction after reinit() used the cached position = "
+           << (reinit_cached ? "yes" : "no") << '\n'
+           << "second transaction after reinit() used the cached position = "
+           << (reinit_again_cached ? "yes" : "no") << '\n';
+
+  vectors.end_time_step();
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "position_cache_01.log");
+
+  test<2>(app_initializer);
+}
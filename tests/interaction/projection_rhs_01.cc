@@ -0,0 +1,143 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the sum-factorized cell right-hand side computation for FE_Q
+// elements matches the standard one, which we get by converting the quadrature
+// into one which is not a tensor product.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  const MappingQ<dim, spacedim> position_mapping(1);
+  const MappingQ<dim, spacedim> F_map(1);
+  const int                     n_F_components = get_n_f_components(input_db);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    {
+      const FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(degree),
+                                       n_F_components);
+      DoFHandler<dim, spacedim>     F_dof_handler(overlap_tria);
+      F_dof_handler.distribute_dofs(fe);
+
+      const QGauss<dim>                tensor_quad(degree + 1);
+      const std::vector<unsigned char> quadrature_indices(
+        overlap_tria.n_active_cells());
+
+      Vector<double> F_rhs(F_dof_handler.n_dofs());
+      fdl::compute_projection_rhs("BSPLINE_3",
+                                  f_idx,
+                                  patch_map,
+                                  position_mapping,
+                                  quadrature_indices,
+                                  std::vector<Quadrature<dim>>{tensor_quad},
+                                  F_dof_handler,
+                                  F_map,
+                                  F_rhs);
+      Vector<double> F_general_rhs(F_dof_handler.n_dofs());
+      fdl::compute_projection_rhs(
+        "BSPLINE_3",
+        f_idx,
+        patch_map,
+        position_mapping,
+        quadrature_indices,
+        std::vector<Quadrature<dim>>{
+          Quadrature<dim>(tensor_quad.get_points(),
+                          tensor_quad.get_weights())},
+        F_dof_handler,
+        F_map,
+        F_general_rhs);
+
+      const double max_value =
+        Utilities::MPI::max(F_rhs.linfty_norm(), mpi_comm);
+      F_general_rhs -= F_rhs;
+      const double max_difference =
+        Utilities::MPI::max(F_general_rhs.linfty_norm(), mpi_comm);
+      if (rank == 0)
+        output << "degree = " << degree << " relative difference < 1e-14: "
+               << (max_difference <= 1e-14 * max_value) << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
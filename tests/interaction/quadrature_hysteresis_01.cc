@@ -0,0 +1,160 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/grid_utilities.h>
+
+#include <fiddle/interaction/elemental_interaction.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../tests.h"
+
+// Test quadrature_hysteresis in ElementalInteraction: scale the element
+// lengths to just past the first change of the quadrature rules. Without
+// hysteresis the rules should change, whereas with a hysteresis of 10% they
+// should not. A change of 20% should then change the rules in both cases.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto       input_db = app_initializer->getInputDatabase();
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<spacedim>(), 0.5);
+  native_tria.refine_global(3);
+
+  // setup SAMRAI stuff (its always the same):
+  auto      tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto      patch_hierarchy = std::get<0>(tuple);
+  const int ln              = patch_hierarchy->getFinestLevelNumber();
+
+  // The quadrature rules only depend on the element lengths, so we can
+  // change those without moving the mesh
+  std::vector<BoundingBox<spacedim, float>> bboxes;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        BoundingBox<spacedim, float> fbbox;
+        fbbox.get_boundary_points() =
+          cell->bounding_box().get_boundary_points();
+        bboxes.push_back(fbbox);
+      }
+  const auto all_bboxes =
+    fdl::collect_all_active_cell_bboxes(native_tria, bboxes);
+  const MappingQ<dim, spacedim> mapping(1);
+  const auto                    local_edge_lengths =
+    fdl::compute_longest_edge_lengths(native_tria, mapping, QGauss<1>(2));
+  const auto all_edge_lengths =
+    fdl::collect_longest_edge_lengths(native_tria, local_edge_lengths);
+
+  // Reinitialize with the element lengths scaled by @p scale and return the
+  // total number of interaction points
+  const auto count_points =
+    [&](fdl::ElementalInteraction<dim, spacedim> &interaction,
+        const double                              hysteresis,
+        const double                              scale)
+  {
+    std::vector<float> lengths(all_edge_lengths.begin(),
+                               all_edge_lengths.end());
+    for (float &length : lengths)
+      length *= scale;
+    input_db->putDouble("quadrature_hysteresis", hysteresis);
+    interaction.reinit(input_db,
+                       native_tria,
+                       all_bboxes,
+                       lengths,
+                       patch_hierarchy,
+                       std::make_pair(ln, ln));
+    return Utilities::MPI::sum(interaction.count_local_interaction_work().first,
+                               mpi_comm);
+  };
+  const auto make_interaction = [&]()
+  {
+    input_db->putDouble("quadrature_hysteresis", 0.0);
+    return std::make_unique<fdl::ElementalInteraction<dim, spacedim>>(
+      input_db,
+      native_tria,
+      all_bboxes,
+      all_edge_lengths,
+      patch_hierarchy,
+      std::make_pair(ln, ln),
+      2,
+      1.0,
+      fdl::DensityKind::Minimum);
+  };
+
+  // Find the first (small) scaling of the lengths which changes the rules
+  auto         reference     = make_interaction();
+  const double initial_count = count_points(*reference, 0.0, 1.0);
+  const double step          = 0.005;
+  double       scale         = 1.0;
+  while (scale < 2.0 && count_points(*reference, 0.0, scale) == initial_count)
+    scale += step;
+  const double before_scale = scale - step;
+  const double large_scale  = 1.2 * before_scale;
+  const double after_count  = count_points(*reference, 0.0, scale);
+  const double large_count  = count_points(*reference, 0.0, large_scale);
+
+  std::ofstream output;
+  if (rank == 0)
+    {
+      output.open("output");
+      output << "small scaling changes the rules = "
+             << (after_count != initial_count ? "yes" : "no") << '\n'
+             << "large scaling changes the rules = "
+             << (large_count != initial_count ? "yes" : "no") << '\n';
+    }
+
+  for (const double hysteresis : {0.0, 0.1})
+    {
+      // Choose the rules for the lengths just before the change
+      auto interaction = make_interaction();
+      count_points(*interaction, 0.0, before_scale);
+      const double small_change_count =
+        count_points(*interaction, hysteresis, scale);
+      const double large_change_count =
+        count_points(*interaction, hysteresis, large_scale);
+      if (rank == 0)
+        output << "hysteresis = " << hysteresis << '\n'
+               << "  small change keeps the rules = "
+               << (small_change_count == initial_count ? "yes" : "no") << '\n'
+               << "  large change matches the new rules = "
+               << (large_change_count == large_count ? "yes" : "no") << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "quadrature_hysteresis_01.log");
+
+  test<NDIM>(app_initializer);
+}
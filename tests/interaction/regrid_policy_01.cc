@@ -0,0 +1,25 @@
+#include <fiddle/interaction/regrid_policy.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+
+// Test DisplacementRegridPolicy
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  std::ofstream output("output");
+
+  const fdl::DisplacementRegridPolicy policy(2.0, 0.5);
+  output << "budget = " << policy.get_displacement_budget() << '\n';
+  for (const double displacement : {0.0, 0.5, 0.99, 1.0, 3.0})
+    output << "displacement = " << displacement
+           << " fraction = " << policy.get_budget_fraction(displacement)
+           << " regrid needed = " << policy.regrid_needed(displacement)
+           << '\n';
+}
@@ -0,0 +1,207 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <fiddle/transfer/overlap_partitioning_tools.h>
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/operators.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/SAMRAIGhostDataAccumulator.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <HierarchyCellDataOpsReal.h>
+#include <HierarchySideDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that accumulate_nonzero_ghost_data() matches
+// IBTK::SAMRAIGhostDataAccumulator
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  // Even though we are periodic in both directions we don't ever need to
+  // actually enforce this in the finite element code as far as spreading goes
+  native_tria.refine_global(std::log2(input_db->getInteger("N")));
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  for (auto &patch : patches)
+    fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+
+  // set up what we need for spreading:
+  const MappingQ<dim>                position_map(1);
+  const std::vector<Quadrature<dim>> quadratures({QGauss<dim>(2)});
+  const std::vector<unsigned char>   quadrature_indices(
+    overlap_tria.n_active_cells());
+
+  const int n_F_components = get_n_f_components(input_db);
+  // TODO - it would be nice to make this work with n_F_components = 1, but that
+  // messes up some MatrixFree implementation details
+  std::unique_ptr<FiniteElement<dim>> fe;
+  if (n_F_components == 1)
+    {
+      fe = std::make_unique<FE_Q<dim>>(1);
+    }
+  else
+    {
+      fe = std::make_unique<FESystem<dim>>(FE_Q<dim>(1), n_F_components);
+    }
+
+  DoFHandler<dim, spacedim> F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(*fe);
+  const MappingQ<dim, spacedim> F_map(1);
+
+  FunctionParser<spacedim> fp(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("f")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  Vector<double> F(F_dof_handler.n_dofs());
+  VectorTools::interpolate(F_map, F_dof_handler, fp, F);
+
+  fdl::compute_spread("BSPLINE_3",
+                      f_idx,
+                      patch_map,
+                      position_map,
+                      quadrature_indices,
+                      quadratures,
+                      F_dof_handler,
+                      F_map,
+                      F);
+
+  SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  var_db->mapIndexToVariable(f_idx, f_var);
+  const SAMRAI::hier::IntVector<spacedim> gcw(3);
+
+  // Copy everything, including ghost values, so that both accumulators start
+  // from the same data
+  const int g_idx     = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int e_idx     = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int finest_ln = patch_hierarchy->getFinestLevelNumber();
+  for (int ln = 0; ln <= finest_ln; ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(g_idx, 0.0);
+      level->allocatePatchData(e_idx, 0.0);
+      for (typename hier::PatchLevel<spacedim>::Iterator p(level); p; p++)
+        {
+          tbox::Pointer<hier::Patch<spacedim>> patch = level->getPatch(p());
+          fdl::fill_all(patch->getPatchData(g_idx), 0.0);
+          patch->getPatchData(g_idx)->copy(*patch->getPatchData(f_idx));
+        }
+    }
+
+  IBTK::SAMRAIGhostDataAccumulator acc(
+    patch_hierarchy, f_var, gcw, finest_ln, finest_ln);
+  acc.accumulateGhostData(f_idx);
+  fdl::accumulate_nonzero_ghost_data(
+    patch_hierarchy, g_idx, gcw, finest_ln, finest_ln, mpi_comm);
+
+  auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+  ops->subtract(e_idx, f_idx, g_idx);
+  const double max_norm       = ops->maxNorm(f_idx);
+  const double max_difference = ops->maxNorm(e_idx);
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "Number of elements: " << native_tria.n_active_cells()
+             << '\n';
+      output << "same values: " << (max_difference <= 1e-14 * max_norm)
+             << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
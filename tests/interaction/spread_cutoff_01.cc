@@ -0,0 +1,280 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe_field.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <CellIterator.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that compute_spread() with a spread cutoff skips the points with
+// small forces, records statistics, and changes the total force by no more
+// than the skipped magnitude. Also verify that the plan-based version skips
+// the same points.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  // Use a curved position field so that the test does not only check affine
+  // mappings:
+  const FESystem<dim, spacedim> position_fe(FE_Q<dim, spacedim>(2), spacedim);
+  DoFHandler<dim, spacedim>     position_dof_handler(overlap_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  Vector<double> position(position_dof_handler.n_dofs());
+  VectorTools::interpolate(position_dof_handler,
+                           FunctionParser<spacedim>("1.1*x + 0.1*y*y;0.9*y"),
+                           position);
+  const MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+    position_dof_handler, position);
+
+  const std::vector<Quadrature<dim>> quadratures(
+    {QGauss<dim>(2), QGauss<dim>(3)});
+  std::vector<unsigned char> quadrature_indices;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    quadrature_indices.push_back(cell->active_cell_index() % 2);
+
+  fdl::InteractionPlan<dim, spacedim> plan;
+  fdl::compute_interaction_plan(patch_map,
+                                position_dof_handler,
+                                position,
+                                quadrature_indices,
+                                quadratures,
+                                plan);
+
+  const int n_F_components = get_n_f_components(input_db);
+  const FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), n_F_components);
+  DoFHandler<dim, spacedim>     F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(fe);
+  const MappingQ<dim, spacedim> F_map(1);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+  var_db->mapIndexToVariable(f_idx, f_var);
+  const int e_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    patch_hierarchy->getPatchLevel(ln)->allocatePatchData(e_idx, 0.0);
+  auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+
+  // Total force spread into every cell (including ghost cells) of each patch
+  const auto total_force = [&](const int data_idx) {
+    double result = 0.0;
+    for (auto &patch : patches)
+      {
+        const tbox::Pointer<pdat::CellData<spacedim, double>> data =
+          patch->getPatchData(data_idx);
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+          patch->getPatchGeometry();
+        double cell_volume = 1.0;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          cell_volume *= pgeom->getDx()[d];
+        for (pdat::CellIterator<spacedim> it(data->getGhostBox()); it; it++)
+          for (int d = 0; d < data->getDepth(); ++d)
+            result += (*data)(it(), d) * cell_volume;
+      }
+    return Utilities::MPI::sum(result, mpi_comm);
+  };
+
+  const auto sum_statistics = [&](const fdl::SpreadCutoffStatistics &stats) {
+    fdl::SpreadCutoffStatistics result;
+    result.n_points = Utilities::MPI::sum(stats.n_points, mpi_comm);
+    result.n_skipped_points =
+      Utilities::MPI::sum(stats.n_skipped_points, mpi_comm);
+    result.total_magnitude =
+      Utilities::MPI::sum(stats.total_magnitude, mpi_comm);
+    result.skipped_magnitude =
+      Utilities::MPI::sum(stats.skipped_magnitude, mpi_comm);
+    return result;
+  };
+
+  // Only the right half of the part has a significant force
+  Vector<double> F(F_dof_handler.n_dofs());
+  VectorTools::interpolate(F_map,
+                           F_dof_handler,
+                           FunctionParser<spacedim>("x > 0 ? 1.0 : 1e-6"),
+                           F);
+
+  const auto spread = [&](const int                    data_idx,
+                          const bool                   use_plan,
+                          const double                 spread_cutoff,
+                          fdl::SpreadCutoffStatistics &statistics) {
+    for (auto &patch : patches)
+      fdl::fill_all(patch->getPatchData(data_idx), 0.0);
+    if (use_plan)
+      fdl::compute_spread("BSPLINE_3",
+                          data_idx,
+                          patch_map,
+                          plan,
+                          quadrature_indices,
+                          quadratures,
+                          F_dof_handler,
+                          F_map,
+                          F,
+                          1,
+                          false,
+                          spread_cutoff,
+                          &statistics);
+    else
+      fdl::compute_spread("BSPLINE_3",
+                          data_idx,
+                          patch_map,
+                          position_mapping,
+                          quadrature_indices,
+                          quadratures,
+                          F_dof_handler,
+                          F_map,
+                          F,
+                          1,
+                          false,
+                          spread_cutoff,
+                          &statistics);
+  };
+
+  // Without a cutoff nothing changes and nothing is recorded
+  fdl::SpreadCutoffStatistics no_cutoff_statistics;
+  spread(f_idx, false, 0.0, no_cutoff_statistics);
+  const double total = total_force(f_idx);
+  for (auto &patch : patches)
+    fdl::fill_all(patch->getPatchData(e_idx), 0.0);
+  fdl::compute_spread("BSPLINE_3",
+                      e_idx,
+                      patch_map,
+                      position_mapping,
+                      quadrature_indices,
+                      quadratures,
+                      F_dof_handler,
+                      F_map,
+                      F);
+  ops->subtract(e_idx, e_idx, f_idx);
+  no_cutoff_statistics = sum_statistics(no_cutoff_statistics);
+  if (rank == 0)
+    output << "spreading without a cutoff records statistics = "
+           << (no_cutoff_statistics.n_points > 0 ? "yes" : "no") << '\n'
+           << "spreading without a cutoff difference = "
+           << ops->maxNorm(e_idx) << '\n';
+
+  // With a cutoff the points on the left half are skipped
+  const double                spread_cutoff = 1e-3;
+  fdl::SpreadCutoffStatistics statistics;
+  spread(e_idx, false, spread_cutoff, statistics);
+  const double total_change = std::abs(total_force(e_idx) - total);
+  statistics                = sum_statistics(statistics);
+  if (rank == 0)
+    output << "skipped some points = "
+           << (statistics.n_skipped_points > 0 ? "yes" : "no") << '\n'
+           << "spread some points = "
+           << (statistics.n_skipped_points < statistics.n_points ? "yes" :
+                                                                   "no")
+           << '\n'
+           << "total force change is bounded by the skipped magnitude = "
+           << (total_change <= statistics.skipped_magnitude * (1.0 + 1e-10) ?
+                 "yes" :
+                 "no")
+           << '\n';
+
+  // The plan-based version should skip the same points
+  const int g_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    patch_hierarchy->getPatchLevel(ln)->allocatePatchData(g_idx, 0.0);
+  fdl::SpreadCutoffStatistics plan_statistics;
+  spread(g_idx, true, spread_cutoff, plan_statistics);
+  plan_statistics = sum_statistics(plan_statistics);
+  const double norm = ops->maxNorm(e_idx);
+  ops->subtract(g_idx, g_idx, e_idx);
+  if (rank == 0)
+    output << "plan-based spreading skipped the same points = "
+           << (plan_statistics.n_points == statistics.n_points &&
+                   plan_statistics.n_skipped_points ==
+                     statistics.n_skipped_points ?
+                 "yes" :
+                 "no")
+           << '\n'
+           << "plan-based spreading with a cutoff matches = "
+           << (ops->maxNorm(g_idx) <= 1e-12 * norm ? "yes" : "no") << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "spread_cutoff_01.log");
+
+  test<2>(app_initializer);
+}
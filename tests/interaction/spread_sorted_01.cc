@@ -0,0 +1,190 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe_field.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that sorting the quadrature points of each patch by Eulerian cell
+// before spreading (the sort_points argument of compute_spread()) only
+// changes the spread values by roundoff, both with and without an
+// InteractionPlan. Interpolation does not sort its points, so it is not
+// affected by this option.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria, Point<spacedim>(), 0.25);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<dim, spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<dim, spacedim> overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  // Use a curved position field so that many quadrature points share each
+  // Eulerian cell in a nontrivial order:
+  const FESystem<dim, spacedim> position_fe(FE_Q<dim, spacedim>(2), spacedim);
+  DoFHandler<dim, spacedim>     position_dof_handler(overlap_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  Vector<double> position(position_dof_handler.n_dofs());
+  VectorTools::interpolate(position_dof_handler,
+                           FunctionParser<spacedim>("1.1*x + 0.1*y*y;0.9*y"),
+                           position);
+  const MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+    position_dof_handler, position);
+
+  const std::vector<Quadrature<dim>> quadratures(
+    {QGauss<dim>(2), QGauss<dim>(3)});
+  std::vector<unsigned char> quadrature_indices;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    quadrature_indices.push_back(cell->active_cell_index() % 2);
+
+  fdl::InteractionPlan<dim, spacedim> plan;
+  fdl::compute_interaction_plan(patch_map,
+                                position_dof_handler,
+                                position,
+                                quadrature_indices,
+                                quadratures,
+                                plan);
+
+  const int n_F_components = get_n_f_components(
+    app_initializer->getInputDatabase());
+  const FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), n_F_components);
+  DoFHandler<dim, spacedim>     F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(fe);
+  const MappingQ<dim, spacedim> F_map(1);
+
+  Vector<double> F(F_dof_handler.n_dofs());
+  for (unsigned int i = 0; i < F.size(); ++i)
+    F[i] = std::sin(double(i));
+
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+  var_db->mapIndexToVariable(f_idx, f_var);
+  const int sorted_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int plan_idx   = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int sorted_plan_idx =
+    var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    for (const int idx : {sorted_idx, plan_idx, sorted_plan_idx})
+      patch_hierarchy->getPatchLevel(ln)->allocatePatchData(idx, 0.0);
+  for (auto &patch : patches)
+    for (const int idx : {f_idx, sorted_idx, plan_idx, sorted_plan_idx})
+      fdl::fill_all(patch->getPatchData(idx), 0.0);
+
+  for (const bool sort_points : {false, true})
+    {
+      fdl::compute_spread("BSPLINE_3",
+                          sort_points ? sorted_idx : f_idx,
+                          patch_map,
+                          position_mapping,
+                          quadrature_indices,
+                          quadratures,
+                          F_dof_handler,
+                          F_map,
+                          F,
+                          1,
+                          sort_points);
+      fdl::compute_spread("BSPLINE_3",
+                          sort_points ? sorted_plan_idx : plan_idx,
+                          patch_map,
+                          plan,
+                          quadrature_indices,
+                          quadratures,
+                          F_dof_handler,
+                          F_map,
+                          F,
+                          1,
+                          sort_points);
+    }
+
+  // Also compare the values spread into ghost regions, which are binned
+  // differently from the ones in the interior of each patch
+  auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+  const double spread_norm = ops->maxNorm(f_idx, false);
+  const double plan_norm   = ops->maxNorm(plan_idx, false);
+  ops->subtract(sorted_idx, sorted_idx, f_idx, false);
+  ops->subtract(sorted_plan_idx, sorted_plan_idx, plan_idx, false);
+  const double difference      = ops->maxNorm(sorted_idx, false);
+  const double plan_difference = ops->maxNorm(sorted_plan_idx, false);
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "spread something: "
+             << (spread_norm > 0.0 && plan_norm > 0.0) << '\n'
+             << "sorted spreading difference is small: "
+             << (difference <= 1e-12 * spread_norm) << '\n'
+             << "sorted plan spreading difference is small: "
+             << (plan_difference <= 1e-12 * plan_norm) << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "spread_sorted_01.log");
+
+  test<2, 2>(app_initializer);
+}
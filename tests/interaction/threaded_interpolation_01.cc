@@ -0,0 +1,233 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+#include <fiddle/interaction/nodal_interaction.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe_field.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <memory>
+
+#include "../tests.h"
+
+// Verify that threaded elemental and nodal interpolation are bitwise
+// identical to serial interpolation.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  // Use a curved position field so that the test does not only check affine
+  // mappings:
+  const FESystem<dim, spacedim> position_fe(FE_Q<dim, spacedim>(2), spacedim);
+  DoFHandler<dim, spacedim>     position_dof_handler(overlap_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  Vector<double> position(position_dof_handler.n_dofs());
+  VectorTools::interpolate(position_dof_handler,
+                           FunctionParser<spacedim>("1.1*x + 0.1*y*y;0.9*y"),
+                           position);
+  const MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+    position_dof_handler, position);
+
+  const std::vector<Quadrature<dim>> quadratures(
+    {QGauss<dim>(2), QGauss<dim>(3)});
+  std::vector<unsigned char> quadrature_indices;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    quadrature_indices.push_back(cell->active_cell_index() % 2);
+
+  const int n_F_components = get_n_f_components(input_db);
+  const FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), n_F_components);
+  DoFHandler<dim, spacedim>     F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(fe);
+  const MappingQ<dim, spacedim> F_map(1);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  // elemental interpolation:
+  {
+    Vector<double> F_rhs(F_dof_handler.n_dofs());
+    fdl::compute_projection_rhs("BSPLINE_3",
+                                f_idx,
+                                patch_map,
+                                position_mapping,
+                                quadrature_indices,
+                                quadratures,
+                                F_dof_handler,
+                                F_map,
+                                F_rhs);
+    Vector<double> F_threaded_rhs(F_dof_handler.n_dofs());
+    fdl::compute_projection_rhs("BSPLINE_3",
+                                f_idx,
+                                patch_map,
+                                position_mapping,
+                                quadrature_indices,
+                                quadratures,
+                                F_dof_handler,
+                                F_map,
+                                F_threaded_rhs,
+                                4);
+
+    F_threaded_rhs -= F_rhs;
+    const double max_difference =
+      Utilities::MPI::max(F_threaded_rhs.linfty_norm(), mpi_comm);
+    if (rank == 0)
+      output << "threaded elemental interpolation difference = "
+             << max_difference << std::endl;
+  }
+
+  // nodal interpolation, which is only threaded when interpolating from
+  // owners:
+  {
+    FESystem<dim, spacedim>   native_position_fe(FE_Q<dim, spacedim>(1),
+                                                 spacedim);
+    DoFHandler<dim, spacedim> native_position_dof_handler(native_tria);
+    native_position_dof_handler.distribute_dofs(native_position_fe);
+    IndexSet locally_relevant_position_dofs;
+    DoFTools::extract_locally_relevant_dofs(native_position_dof_handler,
+                                            locally_relevant_position_dofs);
+    LinearAlgebra::distributed::Vector<double> native_position(
+      native_position_dof_handler.locally_owned_dofs(),
+      locally_relevant_position_dofs,
+      mpi_comm);
+    VectorTools::interpolate(native_position_dof_handler,
+                             Functions::IdentityFunction<spacedim>(),
+                             native_position);
+    native_position.update_ghost_values();
+
+    FE_Q<dim, spacedim>       native_F_fe(1);
+    DoFHandler<dim, spacedim> native_F_dof_handler(native_tria);
+    native_F_dof_handler.distribute_dofs(native_F_fe);
+    IndexSet locally_relevant_F_dofs;
+    DoFTools::extract_locally_relevant_dofs(native_F_dof_handler,
+                                            locally_relevant_F_dofs);
+    auto F_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+      native_F_dof_handler.locally_owned_dofs(),
+      locally_relevant_F_dofs,
+      mpi_comm);
+
+    std::vector<BoundingBox<spacedim, float>> native_cell_bboxes;
+    for (const auto &cell : native_tria.active_cell_iterators())
+      {
+        BoundingBox<spacedim, float> fbbox;
+        fbbox.get_boundary_points() =
+          cell->bounding_box().get_boundary_points();
+        native_cell_bboxes.push_back(fbbox);
+      }
+
+    const auto interpolate = [&](const int n_interpolation_threads) {
+      input_db->putBool("interpolate_from_owners", true);
+      input_db->putInteger("n_interpolation_threads", n_interpolation_threads);
+      fdl::NodalInteraction<dim, spacedim> interaction(
+        input_db,
+        native_tria,
+        native_cell_bboxes,
+        patch_hierarchy,
+        std::make_pair(0, patch_hierarchy->getFinestLevelNumber()),
+        native_position_dof_handler,
+        native_position);
+      interaction.add_dof_handler(native_F_dof_handler);
+
+      LinearAlgebra::distributed::Vector<double> F(F_partitioner);
+      interaction.interpolate("BSPLINE_3",
+                              f_idx,
+                              native_position_dof_handler,
+                              native_position,
+                              native_F_dof_handler,
+                              F_map,
+                              F);
+      return F;
+    };
+    LinearAlgebra::distributed::Vector<double> F_threaded = interpolate(4);
+    const LinearAlgebra::distributed::Vector<double> F = interpolate(1);
+
+    const double norm = F.linfty_norm();
+    F_threaded -= F;
+    const double max_difference = F_threaded.linfty_norm();
+    if (rank == 0)
+      output << "nodal values are nonzero = " << (norm > 0.0 ? "yes" : "no")
+             << '\n'
+             << "threaded nodal interpolation difference = "
+             << max_difference << std::endl;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "threaded_interpolation_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,139 @@
+#include <fiddle/interaction/transaction_scheduler.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "../tests.h"
+
+// Verify that TransactionScheduler advances each transaction through all of
+// its stages, in order, once its own requests complete.
+
+// Transaction which passes values around a ring of processors
+struct RingTransaction : public fdl::TransactionBase
+{
+  int                      tag;
+  double                   send_value;
+  double                   recv_value;
+  std::vector<MPI_Request> requests;
+
+  void
+  start(const double value)
+  {
+    MPI_Comm   comm    = MPI_COMM_WORLD;
+    const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+    const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+    send_value         = value;
+    requests.resize(2);
+    int ierr = MPI_Irecv(&recv_value,
+                         1,
+                         MPI_DOUBLE,
+                         (rank + n_procs - 1) % n_procs,
+                         tag,
+                         comm,
+                         &requests[0]);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Isend(&send_value,
+                     1,
+                     MPI_DOUBLE,
+                     (rank + 1) % n_procs,
+                     tag,
+                     comm,
+                     &requests[1]);
+    AssertThrowMPI(ierr);
+  }
+
+  virtual std::vector<MPI_Request>
+  delegate_outstanding_requests() override
+  {
+    const auto copy = requests;
+    for (MPI_Request &request : requests)
+      request = MPI_REQUEST_NULL;
+    return copy;
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = Utilities::MPI::n_mpi_processes(comm);
+  const auto left    = (rank + n_procs - 1) % n_procs;
+  const auto left2   = (rank + 2 * n_procs - 2) % n_procs;
+
+  const unsigned int n_transactions = 5;
+
+  fdl::TransactionScheduler              scheduler;
+  std::vector<std::vector<unsigned int>> stages_run(n_transactions + 1);
+  bool                                   values_correct = true;
+  for (unsigned int t = 0; t < n_transactions; ++t)
+    {
+      auto transaction = std::make_unique<RingTransaction>();
+      transaction->tag = t;
+      transaction->start(1000.0 * t + rank);
+
+      auto first = [&, t](std::unique_ptr<fdl::TransactionBase> t_ptr)
+      {
+        auto &trans = dynamic_cast<RingTransaction &>(*t_ptr);
+        values_correct =
+          values_correct && trans.recv_value == 1000.0 * t + left;
+        stages_run[t].push_back(0);
+        // pass the value along
+        trans.start(trans.recv_value + 0.5);
+        return t_ptr;
+      };
+      auto second = [&, t](std::unique_ptr<fdl::TransactionBase> t_ptr)
+      {
+        auto &trans = dynamic_cast<RingTransaction &>(*t_ptr);
+        values_correct =
+          values_correct && trans.recv_value == 1000.0 * t + left2 + 0.5;
+        stages_run[t].push_back(1);
+        return std::unique_ptr<fdl::TransactionBase>();
+      };
+      scheduler.add_transaction(std::move(transaction), {first, second});
+    }
+
+  // Also check a transaction which does no communication
+  {
+    auto first = [&](std::unique_ptr<fdl::TransactionBase> t_ptr)
+    {
+      stages_run[n_transactions].push_back(0);
+      return t_ptr;
+    };
+    auto second = [&](std::unique_ptr<fdl::TransactionBase> t_ptr)
+    {
+      stages_run[n_transactions].push_back(1);
+      return std::unique_ptr<fdl::TransactionBase>();
+    };
+    scheduler.add_transaction(std::make_unique<fdl::TransactionBase>(),
+                              {first, second});
+  }
+
+  scheduler.run();
+
+  bool stages_correct = scheduler.n_transactions() == n_transactions + 1;
+  bool times_correct  = true;
+  for (unsigned int t = 0; t < n_transactions + 1; ++t)
+    {
+      stages_correct = stages_correct && stages_run[t].size() == 2 &&
+                       stages_run[t][0] == 0 && stages_run[t][1] == 1;
+      times_correct  = times_correct && scheduler.get_wait_time(t) >= 0.0 &&
+                       scheduler.get_compute_time(t) >= 0.0;
+    }
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  out << "values are correct : " << values_correct << std::endl;
+  out << "stages are correct : " << stages_correct << std::endl;
+  out << "times are correct : " << times_correct << std::endl;
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
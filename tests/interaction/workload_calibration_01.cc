@@ -0,0 +1,47 @@
+#include <fiddle/interaction/workload_calibration.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+
+// Test WorkloadCalibration with synthetic timings which are exactly
+// 2 * n_points + 10 * n_cells
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  std::ofstream output("output");
+
+  fdl::WorkloadCalibration calibration(MPI_COMM_WORLD, 2);
+  auto run_window = [&](const double       n_points,
+                        const double       n_cells,
+                        const unsigned int n_steps)
+  {
+    calibration.start_window(n_points, n_cells);
+    for (unsigned int step = 0; step < n_steps; ++step)
+      {
+        // split each step into two parts, like interpolation and spreading
+        calibration.add_time(n_points + 5.0 * n_cells);
+        calibration.add_time(n_points + 5.0 * n_cells);
+        calibration.finish_step();
+      }
+    const bool changed = calibration.finish_window();
+    output << "changed: " << changed
+           << " has coefficients: " << calibration.has_coefficients();
+    if (calibration.has_coefficients())
+      output << " point weight: " << calibration.get_point_weight()
+             << " cell weight: " << calibration.get_cell_weight();
+    output << '\n';
+  };
+
+  // the first window cannot determine two coefficients
+  run_window(100.0, 10.0, 3);
+  run_window(100.0, 20.0, 3);
+  // too short to be used
+  run_window(10.0, 100.0, 1);
+  run_window(50.0, 5.0, 4);
+}
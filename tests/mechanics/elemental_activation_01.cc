@@ -0,0 +1,130 @@
+#include <fiddle/grid/data_in.h>
+
+#include <fiddle/mechanics/elemental_activation.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_in.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include "../tests.h"
+
+// Verify that ElementalActivation interpolates the snapshots read by
+// read_elemental_data() linearly in time, both with and without a period,
+// when the time decreases, and in single precision.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const MPI_Comm                   comm = MPI_COMM_WORLD;
+
+  const auto partitioner =
+    parallel::shared::Triangulation<2>::Settings::partition_zorder;
+  parallel::shared::Triangulation<2> tria(comm, {}, true, partitioner);
+  const std::string test_file = SOURCE_DIR + std::string("../grid/q1.ex2");
+  GridIn<2>         grid_in(tria);
+  grid_in.read_exodusii(test_file);
+
+  // The file has 11 time steps: put them at times 0, 1, ..., 10
+  const unsigned int          n_snapshots = 11;
+  std::vector<double>         snapshot_times;
+  std::vector<Vector<double>> snapshots;
+  double                      max_value = 0.0;
+  for (unsigned int i = 0; i < n_snapshots; ++i)
+    {
+      snapshot_times.push_back(i);
+      snapshots.emplace_back(tria.n_active_cells());
+      fdl::read_elemental_data(test_file, tria, i + 1, "M", snapshots.back());
+      max_value = std::max(max_value, snapshots.back().linfty_norm());
+    }
+
+  // Largest difference, relative to the largest value, between the
+  // activation and (1 - weight) * snapshot lower_n + weight * snapshot upper_n
+  const auto difference = [&](const fdl::ElementalActivation<2> &activation,
+                              const unsigned int                 lower_n,
+                              const unsigned int                 upper_n,
+                              const double                       weight) {
+    double result = 0.0;
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const auto   index = cell->active_cell_index();
+          const double expected =
+            (1.0 - weight) * snapshots[lower_n][index] +
+            weight * snapshots[upper_n][index];
+          result = std::max(result,
+                            std::abs(activation.get_activation(cell) -
+                                     expected));
+        }
+    return Utilities::MPI::max(result, comm) /
+           (max_value > 0.0 ? max_value : 1.0);
+  };
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output");
+  const auto check = [&](const std::string &label,
+                          const double       value,
+                          const double       tolerance = 1e-12) {
+    if (Utilities::MPI::this_mpi_process(comm) == 0)
+      output << label << " = " << (value < tolerance ? "yes" : "no") << '\n';
+  };
+
+  // Without a period. Use three buffers so that going back in time does not
+  // reread snapshots.
+  {
+    fdl::ElementalActivation<2> activation(
+      test_file, tria, "M", snapshot_times, 0.0, 3);
+    activation.reinit(3.0);
+    check("matches a snapshot", difference(activation, 3, 3, 0.0));
+    activation.reinit(3.25);
+    check("interpolates between snapshots", difference(activation, 3, 4, 0.25));
+    activation.reinit(2.5);
+    check("interpolates after going back in time",
+          difference(activation, 2, 3, 0.5));
+    activation.reinit(-1.0);
+    check("uses the first snapshot before the first time",
+          difference(activation, 0, 0, 0.0));
+    activation.reinit(11.0);
+    check("uses the last snapshot after the last time",
+          difference(activation, 10, 10, 0.0));
+  }
+
+  // With a period of 12, so times between 10 and 12 interpolate between the
+  // last and first snapshots
+  {
+    fdl::ElementalActivation<2> activation(
+      test_file, tria, "M", snapshot_times, 12.0);
+    activation.reinit(15.25);
+    check("periodic activation interpolates between snapshots",
+          difference(activation, 3, 4, 0.25));
+    activation.reinit(-8.75);
+    check("periodic activation at negative times",
+          difference(activation, 3, 4, 0.25));
+    activation.reinit(11.0);
+    check("periodic activation wraps around",
+          difference(activation, 10, 0, 0.5));
+  }
+
+  // Single precision snapshots are interpolated in double precision
+  {
+    fdl::ElementalActivation<2> activation(
+      test_file, tria, "M", snapshot_times, 0.0, 2, true);
+    activation.reinit(3.25);
+    check("single precision activation interpolates between snapshots",
+          difference(activation, 3, 4, 0.25),
+          1e-6);
+  }
+}
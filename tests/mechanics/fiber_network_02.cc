@@ -0,0 +1,64 @@
+#include <fiddle/mechanics/fiber_network.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test fibers defined at quadrature points and the precomputed structure
+// tensors.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  constexpr int      dim        = 2;
+  const unsigned int n_q_points = 3;
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  std::vector<std::vector<Tensor<1, dim>>> fibers(2);
+  for (unsigned int i = 0; i < tria.n_active_cells(); ++i)
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      {
+        Tensor<1, dim> f, s;
+        f[0] = i;
+        f[1] = q;
+        s[0] = 1.0;
+        s[1] = 2.0 + q;
+        fibers[0].push_back(f);
+        fibers[1].push_back(s);
+      }
+
+  fdl::FiberNetwork<dim> fiber_network(tria, n_q_points, fibers);
+  fiber_network.setup_structure_tensors();
+
+  std::ofstream output("output");
+  output << "number of quadrature points = "
+         << fiber_network.n_quadrature_points() << '\n'
+         << "number of fiber fields = " << fiber_network.n_fiber_fields()
+         << '\n';
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      {
+        const auto q_fibers = fiber_network.get_fibers(cell, q);
+        output << cell->active_cell_index() << " " << q << " fibers: "
+               << q_fibers[0] << ", " << q_fibers[1] << '\n';
+        output << "  ff: " << fiber_network.get_structure_tensor(cell, 0, 0, q)
+               << '\n'
+               << "  fs: " << fiber_network.get_structure_tensor(cell, 0, 1, q)
+               << '\n'
+               << "  sf: " << fiber_network.get_structure_tensor(cell, 1, 0, q)
+               << '\n'
+               << "  ss: " << fiber_network.get_structure_tensor(cell, 1, 1, q)
+               << '\n';
+      }
+}
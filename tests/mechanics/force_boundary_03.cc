@@ -0,0 +1,116 @@
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that compute_load_vector() only visits the faces on which a boundary
+// spring force is active when the force precomputes them, and that doing so
+// does not change the load vector.
+
+using namespace dealii;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    if (component == 0)
+      return p[0] + 0.1 * std::sin(2.0 * p[1]);
+    return 1.1 * p[component] + 0.1 * p[0] * p[0];
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  constexpr int dim = 2;
+  const auto    partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::hyper_cube(tria, 0.0, 1.0, true);
+  tria.refine_global(3);
+
+  FESystem<dim>   fe(FE_Q<dim>(1), dim);
+  MappingQ<dim>   mapping(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto vector_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, mpi_comm);
+
+  LinearAlgebra::distributed::Vector<double> position(vector_partitioner),
+    velocity(vector_partitioner);
+  VectorTools::interpolate(mapping, dof_handler, Position<dim>(), position);
+  position.update_ghost_values();
+  velocity.update_ghost_values();
+
+  // With a linear mapping and a linear element the interpolated reference
+  // position is the reference configuration, so both forces are equal
+  const QGauss<dim - 1>                  quadrature(2);
+  const Functions::IdentityFunction<dim> identity;
+  fdl::BoundarySpringForce<dim>          spring(quadrature, 2.0, {1});
+  fdl::BoundarySpringForce<dim>          dof_spring(
+    quadrature, 2.0, dof_handler, mapping, identity, {1});
+
+  auto compute = [&](fdl::ForceContribution<dim> &force)
+  {
+    force.setup_force(0.0, position, velocity);
+    LinearAlgebra::distributed::Vector<double> force_rhs(vector_partitioner);
+    fdl::compute_load_vector(
+      dof_handler, mapping, {&force}, {}, 0.0, position, velocity, force_rhs);
+    force_rhs.compress(VectorOperation::add);
+    force.finish_force(0.0);
+    return force_rhs;
+  };
+
+  const auto all_faces_rhs    = compute(spring);
+  auto       active_faces_rhs = compute(dof_spring);
+  active_faces_rhs -= all_faces_rhs;
+  const double error =
+    active_faces_rhs.linfty_norm() / all_faces_rhs.linfty_norm();
+
+  const unsigned int n_active_faces = Utilities::MPI::sum(
+    static_cast<unsigned int>(dof_spring.get_active_boundary_faces()->size()),
+    mpi_comm);
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "all faces: "
+             << (spring.get_active_boundary_faces() == nullptr) << '\n'
+             << "number of active faces: " << n_active_faces << '\n'
+             << "load vectors match: " << (error < 1e-12) << '\n';
+    }
+}
@@ -0,0 +1,63 @@
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the lumped mass matrix sums to the area of the domain (times the
+// number of components).
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const unsigned int degree, std::ofstream &output)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::hyper_rectangle(tria, Point<dim>(), Point<dim>(2.0, 3.0));
+  tria.refine_global(3);
+  FESystem<dim> fe(FE_Q<dim>(degree), dim);
+
+  fdl::Part<dim> part(tria, fe);
+
+  const auto &lumped_mass_inverse = part.get_lumped_mass_inverse();
+  double      total_mass          = 0.0;
+  bool        all_positive        = true;
+  for (const double value : lumped_mass_inverse)
+    {
+      all_positive = all_positive && value > 0.0;
+      total_mass += 1.0 / value;
+    }
+  total_mass   = Utilities::MPI::sum(total_mass, mpi_comm);
+  all_positive = Utilities::MPI::min(int(all_positive), mpi_comm) == 1;
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    output << "degree = " << degree << '\n'
+           << "  all entries are positive: " << all_positive << '\n'
+           << "  total lumped mass: " << total_mass << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  for (const unsigned int degree : {1u, 2u})
+    test<2>(degree, output);
+}
@@ -0,0 +1,92 @@
+#include <fiddle/mechanics/marker_points.h>
+
+#include <deal.II/base/point.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// Test MarkerPoints forces and saving and loading their state
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "marker_points_01.log");
+
+  std::ofstream output("output");
+
+  // Two springs with rest lengths 1 and 2 and a tether on the second point
+  const std::vector<Point<2>> points = {Point<2>(0.0, 0.0),
+                                        Point<2>(1.0, 0.0),
+                                        Point<2>(0.0, 2.0)};
+  const std::vector<std::array<unsigned int, 2>> edges = {{{0, 1}}, {{0, 2}}};
+  fdl::MarkerPoints<2> marker_points(points, edges, {2.0, 3.0});
+  marker_points.set_tethers({1}, {5.0});
+  output << "number of points = " << marker_points.n_points() << '\n'
+         << "number of springs = " << marker_points.n_edges() << '\n';
+
+  const auto print = [&](const std::string &label, const Vector<double> &v) {
+    output << label << '\n';
+    for (unsigned int point_n = 0; point_n < marker_points.n_points();
+         ++point_n)
+      output << "point " << point_n << ": " << v[2 * point_n] << ", "
+             << v[2 * point_n + 1] << '\n';
+  };
+
+  Vector<double> force;
+  marker_points.compute_force(marker_points.get_position(), force);
+  print("force at the initial position", force);
+
+  // Stretch the first spring, compress the second, and move the tethered
+  // point
+  Vector<double> position(marker_points.get_position());
+  position[2] = 2.0;
+  position[5] = 1.0;
+  marker_points.compute_force(position, force);
+  print("force at the new position", force);
+
+  // Save and load the state:
+  Vector<double> velocity(position.size());
+  for (unsigned int i = 0; i < velocity.size(); ++i)
+    velocity[i] = 0.5 * i;
+  marker_points.set_position(Vector<double>(position));
+  marker_points.set_velocity(Vector<double>(velocity));
+  std::ostringstream out_str;
+  marker_points.write_state(out_str);
+
+  fdl::MarkerPoints<2> loaded_points(points, edges, {2.0, 3.0});
+  loaded_points.set_tethers({1}, {5.0});
+  std::istringstream in_str(out_str.str());
+  loaded_points.read_state(in_str);
+  print("loaded position", loaded_points.get_position());
+  print("loaded velocity", loaded_points.get_velocity());
+
+  // The tethers still use the initial position, not the loaded one
+  Vector<double> loaded_force;
+  loaded_points.compute_force(loaded_points.get_position(), loaded_force);
+  loaded_force -= force;
+  output << "loaded force matches = "
+         << (loaded_force.linfty_norm() == 0.0 ? "yes" : "no") << '\n';
+
+  // Loading a different number of points is an error
+  fdl::MarkerPoints<2> other_points({Point<2>(0.0, 0.0)}, {}, {1.0});
+  std::istringstream   other_in_str(out_str.str());
+  try
+    {
+      other_points.read_state(other_in_str);
+    }
+  catch (const std::exception &)
+    {
+      output << "loading a different number of points failed" << '\n';
+    }
+}
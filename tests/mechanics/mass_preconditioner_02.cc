@@ -0,0 +1,144 @@
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/lac/solver_cg.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the single precision mass operator and preconditioner solve the
+// same system as their double precision versions, that the single precision
+// preconditioner is the same type as the double precision one, and that
+// Part::supports_single_precision_mass_operator() excludes parts for which
+// they are not implemented.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  constexpr int dim = 2;
+  const auto    partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(3);
+  // Same as mass_preconditioner_01
+  GridTools::transform(
+    [](const Point<dim> &p)
+    { return Point<dim>(p[0] + 0.2 * std::sin(4.0 * p[1]), p[1]); },
+    tria);
+  FESystem<dim> fe(FE_Q<dim>(3), dim);
+
+  fdl::Part<dim> part(tria, fe);
+
+  LinearAlgebra::distributed::Vector<double> rhs(part.get_partitioner());
+  for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+    rhs.local_element(i) =
+      std::cos(2.0 + rhs.get_partitioner()->local_to_global(i));
+
+  auto solve = [&]()
+  {
+    LinearAlgebra::distributed::Vector<double> solution(
+      part.get_partitioner());
+    SolverControl control(1000, 1e-10 * rhs.l2_norm());
+    SolverCG<LinearAlgebra::distributed::Vector<double>> cg(control);
+    cg.solve(part.get_mass_operator(),
+             solution,
+             rhs,
+             part.get_mass_preconditioner());
+    return solution;
+  };
+
+  using FloatVectorType = LinearAlgebra::distributed::Vector<float>;
+  auto solve_float = [&]()
+  {
+    const auto &float_operator = part.get_single_precision_mass_operator();
+    FloatVectorType float_rhs, float_solution;
+    float_operator.initialize_dof_vector(float_rhs);
+    float_operator.initialize_dof_vector(float_solution);
+    for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+      float_rhs.local_element(i) = rhs.local_element(i);
+    SolverControl control(1000, 1e-5 * float_rhs.l2_norm());
+    SolverCG<FloatVectorType> cg(control);
+    cg.solve(float_operator,
+             float_solution,
+             float_rhs,
+             part.get_single_precision_mass_preconditioner());
+
+    LinearAlgebra::distributed::Vector<double> solution(
+      part.get_partitioner());
+    for (unsigned int i = 0; i < solution.locally_owned_size(); ++i)
+      solution.local_element(i) = float_solution.local_element(i);
+    return std::make_pair(solution, control.last_step());
+  };
+
+  const auto relative_difference =
+    [](const LinearAlgebra::distributed::Vector<double> &a,
+       const LinearAlgebra::distributed::Vector<double> &b)
+  {
+    auto difference = a;
+    difference -= b;
+    return difference.l2_norm() / a.l2_norm();
+  };
+
+  const auto jacobi       = solve();
+  const auto float_jacobi = solve_float();
+  part.set_mass_preconditioner(fdl::MassPreconditionerType::Chebyshev);
+  const auto chebyshev       = solve();
+  const auto float_chebyshev = solve_float();
+
+  // Parts which do not support single precision mass operators:
+  parallel::shared::Triangulation<dim> simplex_tria(mpi_comm,
+                                                    {},
+                                                    false,
+                                                    partitioner);
+  GridGenerator::subdivided_hyper_cube_with_simplices(simplex_tria, 4);
+  FESystem<dim>  simplex_fe(FE_SimplexP<dim>(1), dim);
+  fdl::Part<dim> simplex_part(simplex_tria, simplex_fe);
+
+  parallel::shared::Triangulation<dim - 1, dim> surface_tria(
+    mpi_comm,
+    {},
+    false,
+    parallel::shared::Triangulation<dim - 1, dim>::Settings::partition_zorder);
+  GridGenerator::hyper_sphere(surface_tria);
+  surface_tria.refine_global(3);
+  FESystem<dim - 1, dim> surface_fe(FE_Q<dim - 1, dim>(1), dim);
+  fdl::Part<dim - 1, dim> surface_part(surface_tria, surface_fe);
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "Jacobi solutions match: "
+             << (relative_difference(jacobi, float_jacobi.first) < 1e-3)
+             << '\n'
+             << "Chebyshev solutions match: "
+             << (relative_difference(chebyshev, float_chebyshev.first) < 1e-3)
+             << '\n'
+             << "single precision Chebyshev needs fewer iterations: "
+             << (float_chebyshev.second < float_jacobi.second) << '\n'
+             << "Q3 part supports single precision: "
+             << part.supports_single_precision_mass_operator() << '\n'
+             << "simplex part supports single precision: "
+             << simplex_part.supports_single_precision_mass_operator() << '\n'
+             << "surface part supports single precision: "
+             << surface_part.supports_single_precision_mass_operator()
+             << '\n';
+    }
+}
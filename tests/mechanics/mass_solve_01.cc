@@ -0,0 +1,107 @@
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/solver_cg.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that Part::solve_mass_systems() computes the same solutions as
+// SolverCG for several right-hand sides at once.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  constexpr int dim = 2;
+  const auto    partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(3);
+  FESystem<dim> fe(FE_Q<dim>(2), dim);
+
+  fdl::Part<dim> part(tria, fe);
+
+  const unsigned int                                      n_systems = 3;
+  std::vector<LinearAlgebra::distributed::Vector<double>> exact(n_systems);
+  std::vector<LinearAlgebra::distributed::Vector<double>> rhs(n_systems);
+  std::vector<LinearAlgebra::distributed::Vector<double>> solutions(n_systems);
+  for (unsigned int k = 0; k < n_systems; ++k)
+    {
+      exact[k].reinit(part.get_partitioner());
+      rhs[k].reinit(part.get_partitioner());
+      solutions[k].reinit(part.get_partitioner());
+      for (unsigned int i = 0; i < exact[k].locally_owned_size(); ++i)
+        exact[k].local_element(i) =
+          std::sin((k + 1.0) * exact[k].get_partitioner()->local_to_global(i));
+      part.get_mass_operator().vmult(rhs[k], exact[k]);
+    }
+  // Use a nonzero initial guess for one of the systems and a zero right-hand
+  // side for another
+  solutions[1] = 1.0;
+  exact[2]     = 0.0;
+  rhs[2]       = 0.0;
+
+  std::vector<LinearAlgebra::distributed::Vector<double> *>       ptrs;
+  std::vector<const LinearAlgebra::distributed::Vector<double> *> rhs_ptrs;
+  for (unsigned int k = 0; k < n_systems; ++k)
+    {
+      ptrs.push_back(&solutions[k]);
+      rhs_ptrs.push_back(&rhs[k]);
+    }
+  const double tolerance = 1e-10;
+  const auto   n_steps =
+    part.solve_mass_systems(ptrs, rhs_ptrs, 100, tolerance);
+
+  bool solutions_match = true;
+  bool steps_match     = true;
+  for (unsigned int k = 0; k < n_systems; ++k)
+    {
+      LinearAlgebra::distributed::Vector<double> reference(
+        part.get_partitioner());
+      if (k == 1)
+        reference = 1.0;
+      if (k == 2)
+        steps_match = steps_match && n_steps[k] == 0;
+      else
+        {
+          SolverControl control(100, tolerance * rhs[k].l2_norm());
+          SolverCG<LinearAlgebra::distributed::Vector<double>> cg(control);
+          cg.solve(part.get_mass_operator(),
+                   reference,
+                   rhs[k],
+                   part.get_mass_preconditioner());
+          // Allow for roundoff differences in the stopping criterion
+          steps_match =
+            steps_match && std::abs(int(control.last_step()) -
+                                    int(n_steps[k])) <= 1;
+        }
+
+      reference -= solutions[k];
+      solutions_match = solutions_match && reference.l2_norm() <= 1e-8;
+    }
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "solutions match SolverCG: " << solutions_match << '\n'
+             << "iteration counts are close to SolverCG: " << steps_match
+             << '\n';
+    }
+}
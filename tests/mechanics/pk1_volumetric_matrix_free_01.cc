@@ -0,0 +1,110 @@
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the matrix-free version of compute_volumetric_pk1_load_vector()
+// computes the same load vector as the FEValues-based version.
+
+using namespace dealii;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    if (component == 0)
+      return p[0] + 0.1 * std::sin(2.0 * p[1]);
+    return 1.2 * p[component] + 0.1 * p[0] * p[0];
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  constexpr int dim = 2;
+  const auto    partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  for (auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_material_id(1);
+  FESystem<dim> fe(FE_Q<dim>(2), dim);
+
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim>>> forces;
+  forces.emplace_back(
+    std::make_unique<fdl::ModifiedNeoHookeanStress<dim>>(QGauss<dim>(3), 2.0));
+  forces.emplace_back(std::make_unique<fdl::ModifiedNeoHookeanStress<dim>>(
+    QGauss<dim>(4), 1.0, std::vector<types::material_id>{1}));
+  fdl::Part<dim> part(tria, fe, std::move(forces), Position<dim>());
+
+  const auto stress_ptrs = part.get_force_contributions();
+  LinearAlgebra::distributed::Vector<double> position(part.get_partitioner()),
+    velocity(part.get_partitioner()), scalar_rhs(part.get_partitioner()),
+    matrix_free_rhs(part.get_partitioner());
+  position = part.get_position();
+  position.update_ghost_values();
+
+  fdl::compute_volumetric_pk1_load_vector(part.get_dof_handler(),
+                                          part.get_mapping(),
+                                          stress_ptrs,
+                                          {},
+                                          0.0,
+                                          position,
+                                          velocity,
+                                          scalar_rhs);
+  scalar_rhs.compress(VectorOperation::add);
+
+  bool all_vectorized = true;
+  for (unsigned int i = 0; i < stress_ptrs.size(); ++i)
+    {
+      const unsigned int index = part.get_matrix_free_quadrature_index(i);
+      all_vectorized = all_vectorized && index != numbers::invalid_unsigned_int;
+      if (index != numbers::invalid_unsigned_int)
+        fdl::compute_volumetric_pk1_load_vector(*part.get_matrix_free(),
+                                                index,
+                                                {stress_ptrs[i]},
+                                                0.0,
+                                                position,
+                                                matrix_free_rhs);
+    }
+  matrix_free_rhs.compress(VectorOperation::add);
+
+  auto difference = scalar_rhs;
+  difference -= matrix_free_rhs;
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "all stresses are vectorized: " << all_vectorized << '\n'
+             << "load vectors match: "
+             << (difference.l2_norm() < 1e-12 * scalar_rhs.l2_norm()) << '\n';
+    }
+}
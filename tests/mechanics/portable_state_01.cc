@@ -0,0 +1,113 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "../tests.h"
+
+// Test that a portable state can be read by a part with a different DoF
+// numbering and a different assignment of streams to processors.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(MPI_COMM_WORLD,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(3);
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(2), spacedim);
+
+  FunctionParser<spacedim> initial_position(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("position")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  FunctionParser<spacedim> initial_velocity(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("velocity")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  // set up fiddle stuff for the test:
+  fdl::Part<dim, spacedim> part_0(
+    native_tria, fe, {}, initial_position, initial_velocity);
+  // same values as part_0 but numbered differently
+  fdl::Part<dim, spacedim> part_1(native_tria,
+                                  fe,
+                                  {},
+                                  initial_position,
+                                  initial_velocity,
+                                  fdl::DoFRenumberingType::Hilbert);
+  fdl::Part<dim, spacedim> part_2(native_tria,
+                                  fe,
+                                  {},
+                                  Functions::ZeroFunction<spacedim>(spacedim),
+                                  Functions::ZeroFunction<spacedim>(spacedim),
+                                  fdl::DoFRenumberingType::Hilbert);
+
+  // and the test itself:
+  std::ostringstream out_str;
+  part_0.write_portable_state(out_str);
+
+  // Read everything on processor 0, as if the state was written by more
+  // processors than the ones reading it
+  const std::vector<std::string> states =
+    Utilities::MPI::gather(MPI_COMM_WORLD, out_str.str());
+  std::vector<std::istringstream> in_strs;
+  std::vector<std::istream *>     inputs;
+  for (const std::string &state : states)
+    in_strs.emplace_back(state);
+  for (auto &in_str : in_strs)
+    inputs.push_back(&in_str);
+  part_2.read_portable_state(inputs);
+
+  auto temp = part_1.get_position();
+  temp -= part_2.get_position();
+  auto temp1 = part_1.get_velocity();
+  temp1 -= part_2.get_velocity();
+
+  const double l2_diff_1 = temp.l2_norm();
+  const double l2_diff_2 = temp1.l2_norm();
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      std::ofstream output("output");
+      output << "position difference norm = " << l2_diff_1 << std::endl;
+      output << "velocity difference norm = " << l2_diff_2 << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,125 @@
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+#include <fiddle/mechanics/reference_values_cache.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that compute_load_vector() computes the same load vector with and
+// without a ReferenceValuesCache.
+
+using namespace dealii;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    if (component == 0)
+      return p[0] + 0.1 * std::sin(2.0 * p[1]);
+    return 1.1 * p[component] + 0.1 * p[0] * p[0];
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  constexpr int dim = 2;
+  const auto    partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(5);
+  for (auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_material_id(1);
+
+  FESystem<dim>   fe(FE_Q<dim>(2), dim);
+  MappingQ<dim>   mapping(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto vector_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, mpi_comm);
+
+  LinearAlgebra::distributed::Vector<double> position(vector_partitioner),
+    velocity(vector_partitioner);
+  VectorTools::interpolate(mapping, dof_handler, Position<dim>(), position);
+  position.update_ghost_values();
+  velocity.update_ghost_values();
+
+  const QGauss<dim>                     quadrature(3);
+  fdl::ModifiedNeoHookeanStress<dim>    stress(quadrature, 2.0);
+  fdl::JLogJVolumetricEnergyStress<dim> volumetric(quadrature, 4.0, {1});
+
+  std::vector<fdl::ForceContribution<dim> *> forces{&stress, &volumetric};
+  for (auto *force : forces)
+    force->setup_force(0.0, position, velocity);
+
+  fdl::ReferenceValuesCache<dim> cache(dof_handler, mapping, 1u << 30);
+  const bool                     cached = cache.add_quadrature(quadrature);
+  fdl::ReferenceValuesCache<dim> tiny_cache(dof_handler, mapping, 1024);
+  const bool tiny_cached = tiny_cache.add_quadrature(quadrature);
+
+  auto compute = [&](const fdl::ReferenceValuesCache<dim> *cache_ptr)
+  {
+    LinearAlgebra::distributed::Vector<double> force_rhs(vector_partitioner);
+    fdl::compute_load_vector(dof_handler,
+                             mapping,
+                             forces,
+                             {},
+                             0.0,
+                             position,
+                             velocity,
+                             force_rhs,
+                             1,
+                             cache_ptr);
+    force_rhs.compress(VectorOperation::add);
+    return force_rhs;
+  };
+
+  const auto uncached_rhs = compute(nullptr);
+  auto       cached_rhs   = compute(&cache);
+  cached_rhs -= uncached_rhs;
+  const double error = cached_rhs.linfty_norm() / uncached_rhs.linfty_norm();
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "cached: " << cached << '\n'
+             << "tiny cache cached: " << tiny_cached << '\n'
+             << "load vectors match: " << (error < 1e-12) << '\n';
+    }
+}
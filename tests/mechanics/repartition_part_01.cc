@@ -0,0 +1,116 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/grid_utilities.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_parser.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that the position and velocity of a Part do not change when it is
+// moved to a new partitioning
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm    = MPI_COMM_WORLD;
+  const auto n_procs     = Utilities::MPI::n_mpi_processes(mpi_comm);
+  const auto partitioner = parallel::shared::Triangulation<dim, spacedim>::
+    Settings::partition_custom_signal;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(3);
+  // Nothing sets the subdomain ids yet, so initially assign contiguous blocks
+  // of cells to each processor
+  const auto block_owner = [&](const unsigned int index)
+  {
+    return types::subdomain_id(index * n_procs /
+                               native_tria.n_active_cells());
+  };
+  std::vector<types::subdomain_id> new_owners(native_tria.n_active_cells());
+  for (unsigned int i = 0; i < new_owners.size(); ++i)
+    new_owners[i] = block_owner(i);
+  fdl::repartition_triangulation(native_tria, new_owners);
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(2), spacedim);
+
+  FunctionParser<spacedim> initial_position(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("position")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  FunctionParser<spacedim> initial_velocity(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("velocity")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  fdl::Part<dim, spacedim> part(
+    native_tria, fe, {}, initial_position, initial_velocity);
+
+  // Reverse the blocks:
+  for (unsigned int i = 0; i < new_owners.size(); ++i)
+    new_owners[i] = n_procs - 1 - block_owner(i);
+  fdl::repartition_triangulation(native_tria, new_owners);
+  part.reinit_dofs();
+
+  bool same_owners = true;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    same_owners = same_owners &&
+                  cell->subdomain_id() == new_owners[cell->active_cell_index()];
+
+  LinearAlgebra::distributed::Vector<double> position(part.get_partitioner());
+  VectorTools::interpolate(part.get_dof_handler(), initial_position, position);
+  position -= part.get_position();
+  LinearAlgebra::distributed::Vector<double> velocity(part.get_partitioner());
+  VectorTools::interpolate(part.get_dof_handler(), initial_velocity, velocity);
+  velocity -= part.get_velocity();
+
+  const double l2_1      = part.get_position().l2_norm();
+  const double l2_2      = part.get_velocity().l2_norm();
+  const double l2_diff_1 = position.l2_norm();
+  const double l2_diff_2 = velocity.l2_norm();
+  const bool   all_same_owners =
+    Utilities::MPI::min(int(same_owners), mpi_comm) == 1;
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "same owners = " << all_same_owners << std::endl;
+      output << "norm = " << l2_1 << std::endl;
+      output << "difference norm = " << l2_diff_1 << std::endl;
+      output << "norm = " << l2_2 << std::endl;
+      output << "difference norm = " << l2_diff_2 << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "repartition_part_01.log");
+
+  test<2>(app_initializer);
+}
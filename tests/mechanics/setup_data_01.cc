@@ -0,0 +1,114 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "../tests.h"
+
+// Test saving and restoring the setup data (i.e., the inverse diagonal of the
+// mass operator) of a Part: a Part on the same mesh should use the saved
+// diagonal and give the same preconditioner, whereas a Part on a different
+// mesh or data saved before the diagonal was computed should not be used.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> /*app_initializer*/)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(3);
+  parallel::shared::Triangulation<dim, spacedim> fine_tria(mpi_comm,
+                                                           {},
+                                                           false,
+                                                           partitioner);
+  GridGenerator::hyper_cube(fine_tria);
+  fine_tria.refine_global(4);
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(2), spacedim);
+
+  fdl::Part<dim, spacedim> part_0(native_tria, fe);
+  fdl::Part<dim, spacedim> part_1(native_tria, fe);
+  fdl::Part<dim, spacedim> part_2(native_tria, fe);
+  fdl::Part<dim, spacedim> fine_part(fine_tria, fe);
+
+  // Save the data both before and after the diagonal is computed
+  std::ostringstream out;
+  part_0.write_setup_data(out);
+  const auto &preconditioner_0 = part_0.get_mass_preconditioner();
+  part_0.write_setup_data(out);
+  const std::string setup_data = out.str();
+
+  // Parts which cannot use the data should still skip over it
+  std::istringstream in(setup_data);
+  const bool         used_empty_data = part_2.read_setup_data(in);
+  const bool         used_other_mesh = fine_part.read_setup_data(in);
+  std::istringstream in_again(setup_data);
+  part_1.read_setup_data(in_again);
+  const bool used_same_mesh = part_1.read_setup_data(in_again);
+
+  // Check that the restored diagonal is written in the same way
+  std::ostringstream out_1;
+  part_1.write_setup_data(out_1);
+  const bool same_data =
+    Utilities::MPI::min(int(out_1.str() ==
+                            setup_data.substr(setup_data.size() -
+                                              out_1.str().size())),
+                        mpi_comm) == 1;
+
+  auto src = part_0.get_position();
+  auto dst_0(src);
+  auto dst_1(src);
+  preconditioner_0.vmult(dst_0, src);
+  part_1.get_mass_preconditioner().vmult(dst_1, src);
+  dst_1 -= dst_0;
+  const double difference = dst_1.l2_norm() / dst_0.l2_norm();
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "data saved before computing the diagonal is used = "
+             << (used_empty_data ? "yes" : "no") << '\n'
+             << "data saved on another mesh is used = "
+             << (used_other_mesh ? "yes" : "no") << '\n'
+             << "data saved on the same mesh is used = "
+             << (used_same_mesh ? "yes" : "no") << '\n'
+             << "restored data is saved in the same way = "
+             << (same_data ? "yes" : "no") << '\n'
+             << "preconditioners match = "
+             << (difference == 0.0 ? "yes" : "no") << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "setup_data_01.log");
+
+  test<2>(app_initializer);
+}
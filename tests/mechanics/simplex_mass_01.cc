@@ -0,0 +1,87 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/operators.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the specialized simplex mass operator set up by Part computes
+// the same values as the generic matrix-free mass operator.
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const unsigned int degree, std::ofstream &output)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::subdivided_hyper_cube_with_simplices(tria, 4);
+  FESystem<dim> fe(FE_SimplexP<dim>(degree), dim);
+
+  fdl::Part<dim> part(tria, fe);
+
+  MatrixFreeOperators::MassOperator<dim, -1, 0, dim> reference_operator;
+  reference_operator.initialize(part.get_matrix_free());
+  reference_operator.compute_diagonal();
+
+  LinearAlgebra::distributed::Vector<double> src(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> dst(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> reference_dst(
+    part.get_partitioner());
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) =
+      std::sin(1.0 + src.get_partitioner()->local_to_global(i));
+  part.get_mass_operator().vmult(dst, src);
+  reference_operator.vmult(reference_dst, src);
+  reference_dst -= dst;
+  const double operator_error = reference_dst.l2_norm() / dst.l2_norm();
+
+  // the diagonal is computed along with the preconditioner
+  part.get_mass_preconditioner();
+  auto diagonal_error =
+    part.get_mass_operator().get_matrix_diagonal()->get_vector();
+  diagonal_error -= reference_operator.get_matrix_diagonal()->get_vector();
+  const double relative_diagonal_error =
+    diagonal_error.l2_norm() /
+    reference_operator.get_matrix_diagonal()->get_vector().l2_norm();
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    output << "degree = " << degree << '\n'
+           << "  operators match: " << (operator_error < 1e-12) << '\n'
+           << "  diagonals match: " << (relative_diagonal_error < 1e-12)
+           << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  // Quadratic simplices have nonpositive row sums, so the (lumped) diagonal
+  // is not defined for them
+  for (const unsigned int degree : {1u, 3u})
+    test<2>(degree, output);
+}
@@ -0,0 +1,159 @@
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../tests.h"
+
+// Verify that storing the spring reference position and the fibers in single
+// precision only changes the load vector by a rounding error.
+
+using namespace dealii;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    if (component == 0)
+      return p[0] + 0.1 * std::sin(2.0 * p[1]);
+    return 1.1 * p[component] + 0.1 * p[0] * p[0];
+  }
+};
+
+template <int spacedim>
+class Reference : public Function<spacedim>
+{
+public:
+  Reference()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    return p[component] + 0.01 * std::cos(3.0 * p[0] + p[1]);
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  constexpr int      dim = 2;
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(4);
+  // so that the vertices cannot be represented exactly with floats
+  GridTools::distort_random(0.25, tria);
+
+  FESystem<dim>   fe(FE_Q<dim>(2), dim);
+  MappingQ<dim>   mapping(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto vector_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, MPI_COMM_SELF);
+
+  LinearAlgebra::distributed::Vector<double> position(vector_partitioner),
+    velocity(vector_partitioner);
+  VectorTools::interpolate(mapping, dof_handler, Position<dim>(), position);
+  position.update_ghost_values();
+  velocity.update_ghost_values();
+
+  // Fibers at an angle which varies from cell to cell
+  std::vector<std::vector<Tensor<1, dim>>> fibers(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const double   angle = 0.3 + cell->center()[0] * cell->center()[1];
+      Tensor<1, dim> f;
+      f[0] = std::cos(angle);
+      f[1] = std::sin(angle);
+      Tensor<1, dim> s;
+      s[0] = -f[1];
+      s[1] = f[0];
+      fibers[0].push_back(f);
+      fibers[1].push_back(s);
+    }
+
+  const QGauss<dim> quadrature(3);
+
+  auto compute = [&](const bool use_single_precision)
+  {
+    auto fiber_network = std::make_shared<fdl::FiberNetwork<dim>>(
+      tria, fibers, use_single_precision);
+    fdl::HolzapfelOgdenStress<dim> stress(quadrature,
+                                          1.0, // a
+                                          1.0, // b
+                                          1.0, // a_f
+                                          1.0, // b_f
+                                          0.0, // kappa_f
+                                          0,   // index_f
+                                          1.0, // a_s
+                                          1.0, // b_s
+                                          0.0, // kappa_s
+                                          1,   // index_s
+                                          1.0, // a_fs
+                                          1.0, // b_fs
+                                          fiber_network);
+
+    fdl::SpringForce<dim> spring(
+      quadrature, 1.0, dof_handler, mapping, Reference<dim>());
+    spring.set_single_precision_reference_position(use_single_precision);
+
+    std::vector<fdl::ForceContribution<dim> *> forces{&stress, &spring};
+    for (auto *force : forces)
+      force->setup_force(0.0, position, velocity);
+
+    LinearAlgebra::distributed::Vector<double> force_rhs(vector_partitioner);
+    fdl::compute_load_vector(
+      dof_handler, mapping, forces, {}, 0.0, position, velocity, force_rhs);
+    force_rhs.compress(VectorOperation::add);
+    return force_rhs;
+  };
+
+  const auto double_rhs = compute(false);
+  auto       single_rhs = compute(true);
+  single_rhs -= double_rhs;
+  const double relative_difference =
+    single_rhs.linfty_norm() / double_rhs.linfty_norm();
+
+  std::ofstream output("output");
+  output << "single precision storage changes the load vector = "
+         << (relative_difference > 0.0 ? "yes" : "no") << '\n'
+         << "load vectors match within float tolerance = "
+         << (relative_difference < 1e-5 ? "yes" : "no") << '\n';
+}
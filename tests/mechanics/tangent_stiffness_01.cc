@@ -0,0 +1,150 @@
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/implicit_structure_solver.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/tangent_stiffness_operator.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that TangentStiffnessOperator computes the derivative of the load
+// vector (by comparing with a finite difference) and that
+// ImplicitStructureSolver solves the backward Euler equations.
+
+using namespace dealii;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    if (component == 0)
+      return p[0] + 0.1 * std::sin(2.0 * p[1]);
+    return 1.2 * p[component] + 0.1 * p[0] * p[0];
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  constexpr int dim = 2;
+  const auto    partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(mpi_comm, {}, false, partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  for (auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_material_id(1);
+  FESystem<dim> fe(FE_Q<dim>(2), dim);
+
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim>>> forces;
+  forces.emplace_back(
+    std::make_unique<fdl::ModifiedNeoHookeanStress<dim>>(QGauss<dim>(3), 2.0));
+  forces.emplace_back(std::make_unique<fdl::JLogJVolumetricEnergyStress<dim>>(
+    QGauss<dim>(3), 3.0, std::vector<types::material_id>{1}));
+  forces.emplace_back(
+    std::make_unique<fdl::LogarithmicVolumetricEnergyStress<dim>>(
+      QGauss<dim>(4), 1.5));
+  fdl::Part<dim> part(tria, fe, std::move(forces), Position<dim>());
+
+  const auto stress_ptrs = part.get_force_contributions();
+  using VectorType       = LinearAlgebra::distributed::Vector<double>;
+
+  // Compute the total load vector at a position
+  auto compute_load_vector = [&](const VectorType &position)
+  {
+    VectorType load(part.get_partitioner());
+    for (unsigned int i = 0; i < stress_ptrs.size(); ++i)
+      fdl::compute_volumetric_pk1_load_vector(
+        *part.get_matrix_free(),
+        part.get_matrix_free_quadrature_index(i),
+        {stress_ptrs[i]},
+        0.0,
+        position,
+        load);
+    return load;
+  };
+
+  VectorType position(part.get_partitioner());
+  VectorType direction(part.get_partitioner());
+  position = part.get_position();
+  for (const auto i : direction.locally_owned_elements())
+    direction[i] = std::sin(1.0 + i);
+
+  // Apply the tangent stiffness of each quadrature rule's stresses
+  VectorType tangent(part.get_partitioner());
+  for (unsigned int i = 0; i < stress_ptrs.size(); ++i)
+    {
+      fdl::TangentStiffnessOperator<dim> tangent_operator(
+        part.get_matrix_free(),
+        part.get_matrix_free_quadrature_index(i),
+        {stress_ptrs[i]});
+      tangent_operator.reinit(0.0, position);
+      tangent_operator.vmult_add(tangent, direction);
+    }
+
+  // -dF/dX dX with a centered difference
+  const double h              = 1e-6;
+  VectorType   plus_position  = position;
+  VectorType   minus_position = position;
+  plus_position.add(h, direction);
+  minus_position.add(-h, direction);
+  VectorType difference = compute_load_vector(minus_position);
+  difference -= compute_load_vector(plus_position);
+  difference /= 2.0 * h;
+  difference -= tangent;
+
+  // Take an implicit step from the initial position with zero velocity and
+  // no other forces and check the result
+  const double                      density = 2.0;
+  const double                      dt      = 0.5;
+  fdl::ImplicitStructureSolver<dim> solver(part, density);
+  VectorType                        velocity(part.get_partitioner());
+  VectorType                        load(part.get_partitioner());
+  VectorType                        new_position;
+  const unsigned int                n_newton_iterations =
+    solver.step(dt, dt, position, velocity, load, new_position);
+
+  VectorType displacement = new_position;
+  displacement -= position;
+  VectorType residual(part.get_partitioner());
+  part.get_mass_operator().vmult(residual, displacement);
+  residual *= density / (dt * dt);
+  residual -= compute_load_vector(new_position);
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output("output");
+      output << "tangent matches finite difference: "
+             << (difference.l2_norm() < 1e-6 * tangent.l2_norm()) << '\n'
+             << "implicit step converged: "
+             << (n_newton_iterations > 0 && n_newton_iterations < 10 &&
+                 residual.l2_norm() <
+                   1e-6 * compute_load_vector(position).l2_norm())
+             << '\n';
+    }
+}
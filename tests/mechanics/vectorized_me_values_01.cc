@@ -0,0 +1,223 @@
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
+
+// Verify that VectorizedMechanicsValues and the vectorized stresses compute
+// the same values as their scalar counterparts on every lane.
+
+using namespace dealii;
+
+using VA = VectorizedArray<double>;
+
+double
+difference(const VA &a, const double b, const unsigned int v)
+{
+  return std::abs(a[v] - b);
+}
+
+template <int dim>
+double
+difference(const Tensor<2, dim, VA> &a,
+           const Tensor<2, dim>     &b,
+           const unsigned int       v)
+{
+  double result = 0.0;
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = 0; j < dim; ++j)
+      result = std::max(result, std::abs(a[i][j][v] - b[i][j]));
+  return result;
+}
+
+template <int dim>
+double
+difference(const SymmetricTensor<2, dim, VA> &a,
+           const SymmetricTensor<2, dim>     &b,
+           const unsigned int                 v)
+{
+  double result = 0.0;
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = 0; j < dim; ++j)
+      result = std::max(result, std::abs(a[i][j][v] - b[i][j]));
+  return result;
+}
+
+int
+main()
+{
+  constexpr int      dim     = 2;
+  constexpr unsigned n_q     = 3;
+  const unsigned int n_lanes = VA::size();
+
+  std::ofstream output("output");
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  std::vector<std::vector<Tensor<1, dim>>> fibers(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      cell->set_material_id(cell->active_cell_index() % 2);
+      const double angle = 0.3 * cell->active_cell_index();
+      fibers[0].emplace_back(Point<dim>(std::cos(angle), std::sin(angle)));
+      fibers[1].emplace_back(Point<dim>(-std::sin(angle), std::cos(angle)));
+    }
+  auto fiber_network =
+    std::make_shared<const fdl::FiberNetwork<dim>>(tria, fibers);
+
+  const QGauss<dim> quad(2);
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim>>> stresses;
+  stresses.emplace_back(
+    std::make_unique<fdl::ModifiedNeoHookeanStress<dim>>(
+      quad, 2.0, std::vector<types::material_id>{1}));
+  stresses.emplace_back(
+    std::make_unique<fdl::ModifiedMooneyRivlinStress<dim>>(quad, 1.0, 0.5));
+  stresses.emplace_back(
+    std::make_unique<fdl::JLogJVolumetricEnergyStress<dim>>(quad, 3.0));
+  stresses.emplace_back(
+    std::make_unique<fdl::LogarithmicVolumetricEnergyStress<dim>>(quad, 3.0));
+  // no dispersion in the first fiber family, so that it is turned off in
+  // compression
+  stresses.emplace_back(std::make_unique<fdl::HolzapfelOgdenStress<dim>>(
+    quad,
+    1.0,
+    2.0,
+    1.0,
+    2.0,
+    0.0,
+    0,
+    0.5,
+    1.0,
+    0.1,
+    1,
+    0.3,
+    0.5,
+    fiber_network));
+
+  fdl::MechanicsUpdateFlags flags = fdl::update_nothing;
+  for (const auto &stress : stresses)
+    flags |= stress->get_mechanics_update_flags();
+  flags |= fdl::update_green | fdl::update_modified_second_invariant |
+           fdl::update_third_invariant | fdl::update_first_invariant_dFF;
+
+  fdl::MechanicsValues<dim>           me_values(flags);
+  fdl::VectorizedMechanicsValues<dim> vectorized_me_values(flags);
+
+  std::vector<Triangulation<dim>::active_cell_iterator> all_cells;
+  for (const auto &cell : tria.active_cell_iterators())
+    all_cells.push_back(cell);
+
+  double              values_difference = 0.0;
+  std::vector<double> stress_differences(stresses.size());
+  for (std::size_t batch_start = 0; batch_start < all_cells.size();
+       batch_start += n_lanes)
+    {
+      // leave the last lane empty to check partially filled batches
+      const std::size_t n_filled =
+        std::min<std::size_t>(std::max(n_lanes - 1, 1u),
+                              all_cells.size() - batch_start);
+      const ArrayView<const Triangulation<dim>::active_cell_iterator> cells(
+        all_cells.data() + batch_start, n_filled);
+
+      std::vector<Tensor<2, dim, VA>> FF(n_q);
+      for (unsigned int q = 0; q < n_q; ++q)
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          for (unsigned int i = 0; i < dim; ++i)
+            for (unsigned int j = 0; j < dim; ++j)
+              FF[q][i][j][v] =
+                (i == j ? 1.0 : 0.0) +
+                (v < n_filled ?
+                   0.2 * std::sin(1.0 + batch_start + 3 * v + 5 * q + 7 * i +
+                                  11 * j) :
+                   0.0);
+      vectorized_me_values.reinit(FF);
+
+      std::vector<std::vector<Tensor<2, dim, VA>>> vectorized_stresses(
+        stresses.size(), std::vector<Tensor<2, dim, VA>>(n_q));
+      for (unsigned int k = 0; k < stresses.size(); ++k)
+        {
+          AssertThrow(stresses[k]->has_vectorized_stress(),
+                      ExcInternalError());
+          ArrayView<Tensor<2, dim, VA>> view(vectorized_stresses[k]);
+          stresses[k]->compute_vectorized_stress(0.0,
+                                                 vectorized_me_values,
+                                                 cells,
+                                                 view);
+        }
+
+      for (unsigned int v = 0; v < n_filled; ++v)
+        {
+          std::vector<Tensor<2, dim>> lane_FF(n_q);
+          for (unsigned int q = 0; q < n_q; ++q)
+            for (unsigned int i = 0; i < dim; ++i)
+              for (unsigned int j = 0; j < dim; ++j)
+                lane_FF[q][i][j] = FF[q][i][j][v];
+          me_values.reinit(lane_FF);
+
+          auto check = [&](const auto &vectorized, const auto &scalar)
+          {
+            for (unsigned int q = 0; q < n_q; ++q)
+              values_difference =
+                std::max(values_difference,
+                         difference(vectorized[q], scalar[q], v));
+          };
+          const auto &vm = vectorized_me_values;
+          check(vm.get_FF_inv_T(), me_values.get_FF_inv_T());
+          check(vm.get_det_FF(), me_values.get_det_FF());
+          check(vm.get_n23_det_FF(), me_values.get_n23_det_FF());
+          check(vm.get_log_det_FF(), me_values.get_log_det_FF());
+          check(vm.get_right_cauchy_green(),
+                me_values.get_right_cauchy_green());
+          check(vm.get_green(), me_values.get_green());
+          check(vm.get_first_invariant(), me_values.get_first_invariant());
+          check(vm.get_modified_first_invariant(),
+                me_values.get_modified_first_invariant());
+          check(vm.get_second_invariant(), me_values.get_second_invariant());
+          check(vm.get_modified_second_invariant(),
+                me_values.get_modified_second_invariant());
+          check(vm.get_third_invariant(), me_values.get_third_invariant());
+          check(vm.get_first_invariant_dFF(),
+                me_values.get_first_invariant_dFF());
+          check(vm.get_modified_first_invariant_dFF(),
+                me_values.get_modified_first_invariant_dFF());
+
+          for (unsigned int k = 0; k < stresses.size(); ++k)
+            {
+              std::vector<Tensor<2, dim>> scalar_stresses(n_q);
+              ArrayView<Tensor<2, dim>>   view(scalar_stresses);
+              stresses[k]->compute_stress(0.0, me_values, cells[v], view);
+              for (unsigned int q = 0; q < n_q; ++q)
+                stress_differences[k] =
+                  std::max(stress_differences[k],
+                           difference(vectorized_stresses[k][q],
+                                      scalar_stresses[q],
+                                      v));
+            }
+        }
+
+      // lanes without cells should be zero
+      for (unsigned int k = 0; k < stresses.size(); ++k)
+        for (unsigned int v = n_filled; v < n_lanes; ++v)
+          for (unsigned int q = 0; q < n_q; ++q)
+            stress_differences[k] =
+              std::max(stress_differences[k],
+                       difference(vectorized_stresses[k][q],
+                                  Tensor<2, dim>(),
+                                  v));
+    }
+
+  output << "values match: " << (values_difference < 1e-12) << '\n';
+  for (unsigned int k = 0; k < stresses.size(); ++k)
+    output << "stress " << k << " matches: " << (stress_differences[k] < 1e-12)
+           << '\n';
+}
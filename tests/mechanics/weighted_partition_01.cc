@@ -0,0 +1,143 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/grid_utilities.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../tests.h"
+
+// Test partitioning a Part by the cost of computing its forces: a damping
+// force (with a relative cost of four) is only active on the left half of a
+// square, so the cells there should have much larger weights. The weighted
+// partition should be the same on every processor, should balance the
+// weights, and should be the partition of the Triangulation after
+// repartitioning.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> /*app_initializer*/)
+{
+  const auto mpi_comm    = MPI_COMM_WORLD;
+  const auto rank        = Utilities::MPI::this_mpi_process(mpi_comm);
+  const auto n_procs     = Utilities::MPI::n_mpi_processes(mpi_comm);
+  const auto partitioner = parallel::shared::Triangulation<dim, spacedim>::
+    Settings::partition_custom_signal;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(3);
+  // Nothing sets the subdomain ids yet, so initially assign contiguous blocks
+  // of cells to each processor
+  std::vector<types::subdomain_id> block_owners(native_tria.n_active_cells());
+  for (unsigned int i = 0; i < block_owners.size(); ++i)
+    block_owners[i] = types::subdomain_id(i * n_procs / block_owners.size());
+  fdl::repartition_triangulation(native_tria, block_owners);
+  for (const auto &cell : native_tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_material_id(1);
+
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), spacedim);
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>> forces;
+  forces.emplace_back(
+    new fdl::DampingForce<dim, spacedim>(QGauss<dim>(2), 1.0, {1}));
+  forces.back()->set_cost(4.0);
+  fdl::Part<dim, spacedim> part(native_tria, fe, std::move(forces));
+
+  // The cells with the force cost 1 + 4 * 4 = 17 and the others cost 1, which
+  // are scaled to 100 and round(100 / 17) = 6
+  const std::vector<unsigned int> weights = part.compute_cell_weights();
+  bool damped_weights_correct = true;
+  bool other_weights_correct  = true;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    if (cell->material_id() == 1)
+      damped_weights_correct =
+        damped_weights_correct && weights[cell->active_cell_index()] == 100;
+    else
+      other_weights_correct =
+        other_weights_correct && weights[cell->active_cell_index()] == 6;
+
+  const std::vector<types::subdomain_id> new_owners =
+    fdl::compute_weighted_owners(native_tria, weights);
+  const std::vector<types::subdomain_id> rank_0_owners =
+    Utilities::MPI::broadcast(mpi_comm, new_owners, 0);
+  const bool same_owners =
+    Utilities::MPI::min(int(new_owners == rank_0_owners), mpi_comm) == 1;
+
+  std::vector<unsigned int> loads(n_procs);
+  bool                      valid_owners = true;
+  for (unsigned int i = 0; i < new_owners.size(); ++i)
+    {
+      valid_owners = valid_owners && new_owners[i] < n_procs;
+      if (new_owners[i] < n_procs)
+        loads[new_owners[i]] += weights[i];
+    }
+  unsigned int total_load = 0;
+  for (const unsigned int load : loads)
+    total_load += load;
+  // Cells cannot be split, so allow one extra cell per processor on top of
+  // METIS' usual imbalance
+  const bool balanced =
+    *std::max_element(loads.begin(), loads.end()) <=
+    1.1 * total_load / n_procs + 100;
+  const bool every_processor_owns_a_cell =
+    *std::min_element(loads.begin(), loads.end()) > 0;
+
+  fdl::repartition_triangulation(native_tria, new_owners);
+  part.reinit_dofs();
+  bool has_new_owners = true;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    has_new_owners = has_new_owners && cell->subdomain_id() ==
+                                         new_owners[cell->active_cell_index()];
+  has_new_owners = Utilities::MPI::min(int(has_new_owners), mpi_comm) == 1;
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "weights of cells with the damping force are correct = "
+             << (damped_weights_correct ? "yes" : "no") << '\n'
+             << "weights of other cells are correct = "
+             << (other_weights_correct ? "yes" : "no") << '\n'
+             << "owners are the same on every processor = "
+             << (same_owners ? "yes" : "no") << '\n'
+             << "owners are valid = " << (valid_owners ? "yes" : "no") << '\n'
+             << "every processor owns a cell = "
+             << (every_processor_owns_a_cell ? "yes" : "no") << '\n'
+             << "partition is balanced = " << (balanced ? "yes" : "no") << '\n'
+             << "cells have their new owners = "
+             << (has_new_owners ? "yes" : "no") << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "weighted_partition_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,107 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/postprocess/meter_collection.h>
+#include <fiddle/postprocess/surface_meter.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <tbox/Pointer.h>
+
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that a MeterCollection computes the same values as its meters
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+  auto g_idx           = std::get<6>(tuple);
+
+  // Set up a few circular meters at different heights
+  const unsigned int n_points = 16;
+  std::vector<std::unique_ptr<fdl::SurfaceMeter<dim, spacedim>>> meters;
+  std::vector<const fdl::MeterBase<dim - 1, spacedim> *>         meter_ptrs;
+  for (const double z : {-0.2, 0.1, 0.4})
+    {
+      std::vector<Point<spacedim>> boundary_points(n_points);
+      for (unsigned int n = 0; n < n_points; ++n)
+        {
+          boundary_points[n][0] =
+            0.1 + 0.3 * std::cos(2.0 * numbers::PI * n / double(n_points));
+          boundary_points[n][1] =
+            0.3 * std::sin(2.0 * numbers::PI * n / double(n_points));
+          boundary_points[n][2] = z;
+        }
+      std::vector<Tensor<1, spacedim>> velocities(n_points);
+      meters.emplace_back(std::make_unique<fdl::SurfaceMeter<dim, spacedim>>(
+        boundary_points, velocities, patch_hierarchy));
+      meter_ptrs.push_back(meters.back().get());
+    }
+
+  fdl::MeterCollection<dim - 1, spacedim> collection(meter_ptrs,
+                                                     patch_hierarchy);
+  const auto values = collection.compute_values(g_idx, f_idx, "BSPLINE_3");
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  const double tolerance = 1e-12;
+  bool         same_fluxes = true;
+  bool         same_means  = true;
+  bool         same_values = true;
+  for (unsigned int meter_n = 0; meter_n < meters.size(); ++meter_n)
+    {
+      const auto &meter = *meters[meter_n];
+      same_fluxes =
+        same_fluxes &&
+        std::abs(values.fluxes[meter_n] -
+                 meter.compute_flux(f_idx, "BSPLINE_3").first) < tolerance;
+      same_means = same_means &&
+                   std::abs(values.mean_values[meter_n] -
+                            meter.compute_mean_value(g_idx, "BSPLINE_3")) <
+                     tolerance;
+      same_values =
+        same_values && std::abs(values.centroid_values[meter_n] -
+                                meter.compute_centroid_value(g_idx,
+                                                             "BSPLINE_3")) <
+                         tolerance;
+    }
+
+  if (rank == 0)
+    {
+      output << "number of meters = " << collection.size() << std::endl;
+      output << "same fluxes: " << same_fluxes << std::endl;
+      output << "same mean values: " << same_means << std::endl;
+      output << "same centroid values: " << same_values << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv);
+
+  test<3>(app_initializer);
+}
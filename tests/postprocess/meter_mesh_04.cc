@@ -0,0 +1,107 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/postprocess/surface_meter.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <tbox/Pointer.h>
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that incremental reinitialization moves the vertices of a meter mesh
+// instead of creating a new one
+
+std::vector<Point<3>>
+get_boundary_points(const double z, const double y_scale)
+{
+  const unsigned int    n_points = 16;
+  std::vector<Point<3>> boundary_points(n_points);
+  for (unsigned int n = 0; n < n_points; ++n)
+    {
+      boundary_points[n][0] =
+        0.1 + 0.3 * std::cos(2.0 * numbers::PI * n / double(n_points));
+      boundary_points[n][1] =
+        0.3 * y_scale * std::sin(2.0 * numbers::PI * n / double(n_points));
+      boundary_points[n][2] = z;
+    }
+  return boundary_points;
+}
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+
+  // The mesh is copied by the first reinit() after enabling incremental
+  // reinitialization
+  const auto                             boundary_points =
+    get_boundary_points(0.1, 1.0);
+  const std::vector<Tensor<1, spacedim>> velocities(boundary_points.size());
+  fdl::SurfaceMeter<dim, spacedim>       meter(boundary_points,
+                                         velocities,
+                                         patch_hierarchy);
+  meter.set_incremental_reinit(true);
+  meter.reinit(boundary_points, velocities);
+  const unsigned int n_vertices = meter.get_triangulation().n_vertices();
+
+  // Slightly move and deform the meter
+  const auto new_boundary_points = get_boundary_points(0.15, 0.9);
+  meter.reinit(new_boundary_points, velocities);
+
+  bool same_boundary_points = true;
+  for (unsigned int n = 0; n < new_boundary_points.size(); ++n)
+    same_boundary_points =
+      same_boundary_points &&
+      (meter.get_triangulation().get_vertices()[n] - new_boundary_points[n])
+          .norm() < 1e-12;
+
+  fdl::SurfaceMeter<dim, spacedim> other_meter(new_boundary_points,
+                                               velocities,
+                                               patch_hierarchy);
+
+  std::ofstream output;
+  if (rank == 0)
+    {
+      output.open("output");
+      output << "same number of vertices: "
+             << (meter.get_triangulation().n_vertices() == n_vertices)
+             << std::endl
+             << "same boundary points: " << same_boundary_points << std::endl
+             << "same normal vectors: "
+             << ((meter.compute_mean_normal_vector() -
+                  other_meter.compute_mean_normal_vector())
+                   .norm() < 1e-12)
+             << std::endl
+             << "same centroid z: "
+             << (std::abs(meter.get_centroid()[2] -
+                          other_meter.get_centroid()[2]) < 1e-12)
+             << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv);
+
+  test<3>(app_initializer);
+}
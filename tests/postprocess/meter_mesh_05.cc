@@ -0,0 +1,153 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/postprocess/surface_meter.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <memory>
+#include <set>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that reinitializing several meters at once gives the same meshes as
+// reinitializing each one separately
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+
+  // setup deal.II stuff
+  const auto mesh_partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> tria(mpi_comm,
+                                                      {},
+                                                      false,
+                                                      mesh_partitioner);
+  GridGenerator::hyper_ball(tria, Point<dim>(), 0.4);
+  tria.refine_global(2);
+
+  FESystem<dim, spacedim>   fe(FE_Q<dim, spacedim>(1), spacedim);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, mpi_comm);
+  MappingQ<dim, spacedim> mapping(1);
+
+  std::set<unsigned int> bounding_disk_vertex_indices;
+  for (const auto &face : tria.active_face_iterators())
+    if (face->at_boundary())
+      for (const unsigned int vertex_n : face->vertex_indices())
+        if (std::abs(face->vertex(vertex_n)[spacedim - 1]) < 1e-12)
+          bounding_disk_vertex_indices.insert(face->vertex_index(vertex_n));
+  std::vector<Point<spacedim>> bounding_disk_points;
+  for (const unsigned int vertex_n : bounding_disk_vertex_indices)
+    bounding_disk_points.push_back(tria.get_vertices()[vertex_n]);
+
+  // Each meter is moved by a different amount
+  const unsigned int n_meters = 5;
+  std::vector<LinearAlgebra::distributed::Vector<double>> positions;
+  LinearAlgebra::distributed::Vector<double>              velocity(partitioner);
+  for (unsigned int i = 0; i < n_meters; ++i)
+    {
+      positions.emplace_back(partitioner);
+      VectorTools::interpolate(mapping,
+                               dof_handler,
+                               Functions::IdentityFunction<spacedim>(),
+                               positions.back());
+      for (unsigned int j = 0; j < positions.back().locally_owned_size(); ++j)
+        positions.back().local_element(j) += 0.1 + 0.05 * i;
+      positions.back().update_ghost_values();
+    }
+  velocity.update_ghost_values();
+
+  std::vector<std::unique_ptr<fdl::SurfaceMeter<dim, spacedim>>> meters;
+  std::vector<std::unique_ptr<fdl::SurfaceMeter<dim, spacedim>>>
+    reference_meters;
+  for (unsigned int i = 0; i < n_meters; ++i)
+    for (auto *m : {&meters, &reference_meters})
+      m->emplace_back(
+        std::make_unique<fdl::SurfaceMeter<dim, spacedim>>(mapping,
+                                                           dof_handler,
+                                                           bounding_disk_points,
+                                                           patch_hierarchy,
+                                                           positions[0],
+                                                           velocity));
+
+  // Move every meter to its own position
+  std::vector<fdl::SurfaceMeter<dim, spacedim> *>                  ptrs;
+  std::vector<const LinearAlgebra::distributed::Vector<double> *> position_ptrs;
+  std::vector<const LinearAlgebra::distributed::Vector<double> *> velocity_ptrs;
+  for (unsigned int i = 0; i < n_meters; ++i)
+    {
+      ptrs.push_back(meters[i].get());
+      position_ptrs.push_back(&positions[i]);
+      velocity_ptrs.push_back(&velocity);
+      reference_meters[i]->reinit(positions[i], velocity);
+    }
+  fdl::SurfaceMeter<dim, spacedim>::reinit(ptrs, position_ptrs, velocity_ptrs);
+
+  bool same_meshes    = true;
+  bool same_centroids = true;
+  for (unsigned int i = 0; i < n_meters; ++i)
+    {
+      const auto &tria_1 = meters[i]->get_triangulation();
+      const auto &tria_2 = reference_meters[i]->get_triangulation();
+      same_meshes        = same_meshes &&
+                    tria_1.n_active_cells() == tria_2.n_active_cells() &&
+                    tria_1.n_vertices() == tria_2.n_vertices();
+      same_centroids =
+        same_centroids &&
+        (meters[i]->get_centroid() - reference_meters[i]->get_centroid())
+            .norm() < 1e-12;
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    {
+      output.open("output");
+      output << "same meshes: " << same_meshes << std::endl
+             << "same centroids: " << same_centroids << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv);
+
+  test<3>(app_initializer);
+}
@@ -0,0 +1,89 @@
+#include <fiddle/mechanics/part.h>
+
+#include <fiddle/postprocess/part_output.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+#include <string>
+
+#include "../tests.h"
+
+// Write a few outputs of a moving part in the background and verify that
+// every file and record is written.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto                       mpi_comm = MPI_COMM_WORLD;
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    output.open("output");
+
+  parallel::shared::Triangulation<2> tria(mpi_comm);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  FESystem<2>        fe(FE_Q<2>(2), 2);
+  fdl::Part<2>       part(tria, fe);
+  const unsigned int n_outputs = 3;
+  {
+    fdl::PartOutput<2> part_output(".", "part", 0);
+    for (unsigned int output_n = 0; output_n < n_outputs; ++output_n)
+      {
+        // move the part so that each write sees a different position
+        auto position = part.get_position();
+        position.add(0.1);
+        part.set_position(std::move(position));
+        auto velocity = part.get_velocity();
+        velocity      = double(output_n);
+        part.set_velocity(std::move(velocity));
+
+        part_output.write(part,
+                          output_n,
+                          0.5 * output_n,
+                          {{"X", &part.get_position()}});
+      }
+    part_output.wait();
+    output << "pending write after wait(): " << part_output.has_pending_write()
+           << '\n';
+  }
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      const unsigned int n_procs = Utilities::MPI::n_mpi_processes(mpi_comm);
+      for (unsigned int output_n = 0; output_n < n_outputs; ++output_n)
+        {
+          const std::string prefix =
+            "part_" + Utilities::int_to_string(output_n, 5);
+          bool all_pieces = true;
+          for (unsigned int r = 0; r < n_procs; ++r)
+            all_pieces =
+              all_pieces && std::ifstream(prefix + "." +
+                                          Utilities::int_to_string(r, 4) +
+                                          ".vtu")
+                              .good();
+          output << prefix << ".pvtu exists: "
+                 << std::ifstream(prefix + ".pvtu").good()
+                 << ", all pieces exist: " << all_pieces << '\n';
+        }
+
+      std::ifstream pvd("part.pvd");
+      std::string   line;
+      unsigned int  n_datasets = 0;
+      while (std::getline(pvd, line))
+        if (line.find("<DataSet") != std::string::npos)
+          ++n_datasets;
+      output << "datasets in part.pvd: " << n_datasets << '\n';
+    }
+}
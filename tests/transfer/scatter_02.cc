@@ -0,0 +1,93 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include "../tests.h"
+
+// Verify that scatters with persistent MPI requests compute the same values as
+// the default ones when they are reused several times and on several channels.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 100;
+  const unsigned int n_overlap_dofs_per_proc =
+    dofs_per_proc + 10 * (n_procs - 1);
+  const auto n_dofs = dofs_per_proc * n_procs;
+  IndexSet   local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  // Unlike scatter_01, overlap dofs may be duplicated here so that adding is
+  // not the same as inserting
+  std::vector<types::global_dof_index> overlap_dofs(n_overlap_dofs_per_proc);
+  for (unsigned int i = 0; i < n_overlap_dofs_per_proc; ++i)
+    overlap_dofs[i] = (41 * (n_overlap_dofs_per_proc * rank + i)) % n_dofs;
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm);
+  fdl::Scatter<double> persistent_scatter(overlap_dofs,
+                                          local_indices,
+                                          comm,
+                                          fdl::ScatterBackend::Persistent);
+
+  bool overlap_equal = true;
+  bool global_equal  = true;
+  for (unsigned int step = 0; step < 4; ++step)
+    {
+      const unsigned int channel = step % 2;
+
+      LinearAlgebra::distributed::Vector<double> global(local_indices, comm);
+      for (unsigned int i = 0; i < global.locally_owned_size(); ++i)
+        global.local_element(i) = (step + 1) * (rank * dofs_per_proc + i);
+
+      Vector<double> overlap(n_overlap_dofs_per_proc);
+      Vector<double> persistent_overlap(n_overlap_dofs_per_proc);
+      scatter.global_to_overlap_start(global, channel, overlap);
+      persistent_scatter.global_to_overlap_start(global,
+                                                 channel,
+                                                 persistent_overlap);
+      scatter.global_to_overlap_finish(global, overlap);
+      persistent_scatter.global_to_overlap_finish(global, persistent_overlap);
+      for (unsigned int i = 0; i < n_overlap_dofs_per_proc; ++i)
+        overlap_equal = overlap_equal && (overlap[i] == persistent_overlap[i]);
+
+      for (const auto operation :
+           {VectorOperation::insert, VectorOperation::add})
+        {
+          LinearAlgebra::distributed::Vector<double> global2(local_indices,
+                                                             comm);
+          LinearAlgebra::distributed::Vector<double> persistent_global2(
+            local_indices, comm);
+          scatter.overlap_to_global_start(overlap, operation, channel, global2);
+          persistent_scatter.overlap_to_global_start(persistent_overlap,
+                                                     operation,
+                                                     channel,
+                                                     persistent_global2);
+          scatter.overlap_to_global_finish(overlap, operation, global2);
+          persistent_scatter.overlap_to_global_finish(persistent_overlap,
+                                                      operation,
+                                                      persistent_global2);
+          for (unsigned int i = 0; i < dofs_per_proc; ++i)
+            global_equal =
+              global_equal &&
+              (global2.local_element(i) == persistent_global2.local_element(i));
+        }
+    }
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  out << "overlap vectors are equal : " << overlap_equal << std::endl;
+  out << "global vectors are equal : " << global_equal << std::endl;
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
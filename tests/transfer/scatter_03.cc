@@ -0,0 +1,124 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <memory>
+#include <set>
+
+#include "../tests.h"
+
+// Test ScatterGroup:
+// 1. verify that scattering several vectors at once gives the same overlap
+//    vectors as scattering each one separately
+// 2. verify that each processor sends one message per partner, regardless of
+//    the number of Scatters
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 100;
+  const unsigned int n_overlap_dofs_per_proc =
+    dofs_per_proc + 10 * (n_procs - 1);
+  const auto n_dofs = dofs_per_proc * n_procs;
+  IndexSet   local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  // same permutation as scatter_01
+  std::vector<types::global_dof_index> permuted_global_dofs;
+  types::global_dof_index              index = 0;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    {
+      permuted_global_dofs.push_back(index % n_dofs);
+      index += 41;
+    }
+
+  // Each Scatter uses a different, shifted, set of overlap dofs
+  const unsigned int n_scatters = 3;
+  const auto get_overlap_dofs =
+    [&](const unsigned int scatter_n, const unsigned int proc) {
+      const unsigned int start =
+        n_overlap_dofs_per_proc * proc + 17 * scatter_n;
+      std::vector<types::global_dof_index> overlap_dofs(
+        n_overlap_dofs_per_proc - 13 * scatter_n);
+      for (unsigned int i = 0; i < overlap_dofs.size(); ++i)
+        overlap_dofs[i] =
+          permuted_global_dofs[(start + i) % permuted_global_dofs.size()];
+      return overlap_dofs;
+    };
+
+  std::vector<std::unique_ptr<fdl::Scatter<double>>>     scatters;
+  std::vector<LinearAlgebra::distributed::Vector<double>> globals;
+  for (unsigned int scatter_n = 0; scatter_n < n_scatters; ++scatter_n)
+    {
+      scatters.emplace_back(std::make_unique<fdl::Scatter<double>>(
+        get_overlap_dofs(scatter_n, rank), local_indices, comm));
+      globals.emplace_back(local_indices, comm);
+      for (unsigned int i = 0; i < globals.back().locally_owned_size(); ++i)
+        globals.back().local_element(i) =
+          1000 * scatter_n + rank * dofs_per_proc + i;
+    }
+
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+  std::vector<fdl::Scatter<double> *> group_scatters;
+  std::vector<const VectorType *>     inputs;
+  std::vector<Vector<double>>         group_overlaps(n_scatters);
+  std::vector<Vector<double> *>       outputs;
+  for (unsigned int scatter_n = 0; scatter_n < n_scatters; ++scatter_n)
+    {
+      group_scatters.push_back(scatters[scatter_n].get());
+      group_overlaps[scatter_n].reinit(
+        get_overlap_dofs(scatter_n, rank).size());
+      inputs.push_back(&globals[scatter_n]);
+      outputs.push_back(&group_overlaps[scatter_n]);
+    }
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  {
+    fdl::ScatterGroup<double> group(comm, group_scatters);
+    // do it twice to check that the group can be reused
+    for (unsigned int iteration = 0; iteration < 2; ++iteration)
+      {
+        group.global_to_overlap_start(inputs);
+        group.global_to_overlap_finish(inputs, outputs);
+      }
+
+    bool overlaps_equal = true;
+    for (unsigned int scatter_n = 0; scatter_n < n_scatters; ++scatter_n)
+      {
+        Vector<double> overlap(group_overlaps[scatter_n].size());
+        scatters[scatter_n]->global_to_overlap_start(globals[scatter_n],
+                                                     0,
+                                                     overlap);
+        scatters[scatter_n]->global_to_overlap_finish(globals[scatter_n],
+                                                      overlap);
+        overlaps_equal =
+          overlaps_equal && (overlap == group_overlaps[scatter_n]);
+      }
+    out << "group overlap vectors are correct : " << overlaps_equal << '\n';
+
+    // Every other processor which needs at least one of our dofs for any
+    // scatter receives exactly one message from us
+    std::set<unsigned int> partners;
+    for (unsigned int proc = 0; proc < n_procs; ++proc)
+      for (unsigned int scatter_n = 0; scatter_n < n_scatters; ++scatter_n)
+        for (const auto dof : get_overlap_dofs(scatter_n, proc))
+          if (proc != rank && local_indices.is_element(dof))
+            partners.insert(proc);
+    out << "number of messages is correct : "
+        << (group.n_messages_sent() == partners.size()) << '\n';
+  }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}